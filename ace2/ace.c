@@ -27,7 +27,10 @@ void print_node_bdd(Abc_Ntk_t * ntk);
 void print_nodes(Vec_Ptr_t * nodes);
 int ace_calc_activity(Abc_Ntk_t * ntk, int num_vectors, char * clk_name);
 
-st__table * ace_info_hash_table;
+/* Activity info of the objects of ace_info_ntk, indexed by object id */
+Abc_Ntk_t * ace_info_ntk;
+Ace_Obj_Info_t * ace_info_array;
+int ace_info_array_size;
 
 void print_status(Abc_Ntk_t * ntk) {
 	int i;
@@ -306,10 +309,10 @@ int ace_calc_activity(Abc_Ntk_t * ntk, int num_vectors, char * clk_name) {
 }
 
 Ace_Obj_Info_t * Ace_ObjInfo(Abc_Obj_t * obj) {
-	Ace_Obj_Info_t * info;
+	int id = Abc_ObjId(obj);
 
-	if (st__lookup(ace_info_hash_table, (char *) obj, (char **) &info)) {
-		return info;
+	if (obj->pNtk == ace_info_ntk && id < ace_info_array_size) {
+		return &ace_info_array[id];
 	}
 	VTR_ASSERT(0);
     return NULL;
@@ -332,12 +335,10 @@ int main(int argc, char * argv[]) {
 	FILE * OUT_ACT = stdout;
 	ace_pi_format_t pi_format = ACE_CODED;
 	double p, d;
-	int i;
 	int depth;
 	int error = 0;
 	Abc_Frame_t * pAbc;
 	Abc_Ntk_t * ntk;
-	Abc_Obj_t * obj;
 	int seed = 0;
 
 	p = ACE_PI_STATIC_PROB;
@@ -374,15 +375,10 @@ int main(int argc, char * argv[]) {
 	// Alloc Aux Info Array
 
 	// Full Allocation
-	Ace_Obj_Info_t * info = (Ace_Obj_Info_t*) calloc(Abc_NtkObjNum(ntk), sizeof(Ace_Obj_Info_t));
-	ace_info_hash_table = st__init_table(st__ptrcmp, st__ptrhash);
-
-	int objNum = 0;
-	Abc_NtkForEachObj(ntk, obj, i)
-	{
-		st__insert(ace_info_hash_table, (char *) obj, (char *) &info[objNum]);
-		objNum++;
-	}
+	// (indexed by object id, instead of looking the objects up in a hash table)
+	ace_info_ntk = ntk;
+	ace_info_array_size = Abc_NtkObjNumMax(ntk);
+	ace_info_array = (Ace_Obj_Info_t*) calloc(ace_info_array_size, sizeof(Ace_Obj_Info_t));
 
 	// Check Depth
 	depth = ace_calc_network_depth(ntk);
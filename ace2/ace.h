@@ -31,6 +31,7 @@
 
 #define ACE_CHAR_BUFFER_SIZE 	4096
 #define ACE_NUM_VECTORS			5000
+#define ACE_MAX_BDD_CUT_SIZE	12	/* Nodes with more fanins get the switching activity found by simulation */
 
 typedef enum {
 	ACE_VEC, ACE_ACT, ACE_PD, ACE_CODED
@@ -60,7 +61,9 @@ typedef struct {
 	double prob1to0;
 } Ace_Obj_Info_t; /* Activity info for each node */
 
-extern st__table * ace_info_hash_table;
+extern Abc_Ntk_t * ace_info_ntk;
+extern Ace_Obj_Info_t * ace_info_array;
+extern int ace_info_array_size;
 
 Ace_Obj_Info_t * Ace_ObjInfo(Abc_Obj_t * obj);
 //static inline void 				Ace_InfoPtrSet(Abc_Obj_t * obj_ptr, Ace_Obj_Info_t* info_ptr)	{obj_ptr->pTemp = info_ptr;					}
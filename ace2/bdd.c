@@ -352,6 +352,13 @@ double ace_bdd_calc_switch_act(DdManager * mgr, Abc_Obj_t * obj,
 		return 0.5;
 	}
 
+	if (Vec_PtrSize(fanins) > ACE_MAX_BDD_CUT_SIZE) {
+		/* The estimation below enumerates the paths of the BDD, which is exponential
+		 * in the number of fanins: use the switching probability found by simulation */
+		VTR_ASSERT(info->status == ACE_SIM);
+		return info->switch_prob;
+	}
+
 	bdd = (DdNode*) obj->pData;
 	n0 = n1 = 0;
 	ace_bdd_count_paths(mgr, bdd, &n1, &n0);
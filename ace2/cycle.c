@@ -1,78 +1,139 @@
+#include <stdlib.h>
+
 #include "vtr_assert.h"
 
 #include "cycle.h"
 #include "ace.h"
-bool in_cycle(Abc_Ntk_t * ntk, int obj_id_to_find, Abc_Obj_t * starting_obj_ptr,
-		int flag);
 
-bool in_cycle(Abc_Ntk_t * ntk, int obj_id_to_find, Abc_Obj_t * starting_obj_ptr,
-		int flag) {
-	Ace_Obj_Info_t * info;
-	Abc_Obj_t * fanin_ptr;
+void mark_objects_in_cycles(Abc_Ntk_t * ntk, char * in_cycle);
+
+/*
+ * Marks (in_cycle[id] = 1) the objects of the network which are part of a cycle
+ * of the fanin graph, i.e. those in a strongly connected component of more than
+ * one object (or with a self loop).
+ *
+ * The components are found with an iterative version of Tarjan's algorithm, in
+ * time linear in the size of the network, instead of a depth first search from
+ * each latch (quadratic, and recursing as deep as the network).
+ */
+void mark_objects_in_cycles(Abc_Ntk_t * ntk, char * in_cycle) {
+	int num_objs = Abc_NtkObjNumMax(ntk);
+	int * index = (int*) malloc(num_objs * sizeof(int));
+	int * lowlink = (int*) malloc(num_objs * sizeof(int));
+	char * on_stack = (char*) calloc(num_objs, sizeof(char));
+	Vec_Int_t * component_stack = Vec_IntAlloc(0);
+	Vec_Int_t * dfs_objs = Vec_IntAlloc(0);
+	Vec_Int_t * dfs_fanins = Vec_IntAlloc(0); /* next fanin to visit of each dfs_objs */
+	Abc_Obj_t * root_ptr;
+	int next_index = 0;
 	int i;
 
-	info = Ace_ObjInfo(starting_obj_ptr);
-	if (info->flag == flag) {
-		return FALSE;
+	for (i = 0; i < num_objs; i++) {
+		index[i] = -1;
+		in_cycle[i] = 0;
 	}
-	info->flag = flag;
-
-	/*
-	 if (Abc_ObjType(starting_obj_ptr) == ABC_OBJ_PI)
-	 {
-	 return FALSE;
-	 }
-	 */
-
-	/* Don't think this is needed since ABC can traverse through a latch like any other node
-	 else if (Abc_ObjType(starting_obj_ptr) == ABC_OBJ_BO)
-	 {
-	 // Get BI of latch
-	 fanin_ptr = Abc_ObjFanin0(Abc_ObjFanin0(starting_obj_ptr));
-	 VTR_ASSERT(fanin_ptr);
-
-	 return (in_cycle(ntk, obj_id_to_find, fanin_ptr, flag));
-	 }
-	 */
-
-	Abc_ObjForEachFanin(starting_obj_ptr, fanin_ptr, i)
+
+	Abc_NtkForEachObj(ntk, root_ptr, i)
 	{
-		if (Abc_ObjId(fanin_ptr) == obj_id_to_find) {
-			return TRUE;
+		if (index[Abc_ObjId(root_ptr)] >= 0) {
+			continue;
 		}
-		if (in_cycle(ntk, obj_id_to_find, fanin_ptr, flag)) {
-			return TRUE;
+
+		int root_id = Abc_ObjId(root_ptr);
+		index[root_id] = lowlink[root_id] = next_index++;
+		on_stack[root_id] = 1;
+		Vec_IntPush(component_stack, root_id);
+		Vec_IntPush(dfs_objs, root_id);
+		Vec_IntPush(dfs_fanins, 0);
+
+		while (Vec_IntSize(dfs_objs)) {
+			int obj_id = Vec_IntEntryLast(dfs_objs);
+			int fanin_num = Vec_IntEntryLast(dfs_fanins);
+			Abc_Obj_t * obj_ptr = Abc_NtkObj(ntk, obj_id);
+
+			if (fanin_num < Abc_ObjFaninNum(obj_ptr)) {
+				/* Visit the next fanin */
+				int fanin_id = Abc_ObjFaninId(obj_ptr, fanin_num);
+				Vec_IntWriteEntry(dfs_fanins, Vec_IntSize(dfs_fanins) - 1, fanin_num + 1);
+
+				if (fanin_id == obj_id) {
+					in_cycle[obj_id] = 1;
+				} else if (index[fanin_id] < 0) {
+					index[fanin_id] = lowlink[fanin_id] = next_index++;
+					on_stack[fanin_id] = 1;
+					Vec_IntPush(component_stack, fanin_id);
+					Vec_IntPush(dfs_objs, fanin_id);
+					Vec_IntPush(dfs_fanins, 0);
+				} else if (on_stack[fanin_id] && index[fanin_id] < lowlink[obj_id]) {
+					lowlink[obj_id] = index[fanin_id];
+				}
+				continue;
+			}
+
+			/* All fanins visited */
+			Vec_IntPop(dfs_objs);
+			Vec_IntPop(dfs_fanins);
+			if (Vec_IntSize(dfs_objs)) {
+				int parent_id = Vec_IntEntryLast(dfs_objs);
+				if (lowlink[obj_id] < lowlink[parent_id]) {
+					lowlink[parent_id] = lowlink[obj_id];
+				}
+			}
+
+			if (lowlink[obj_id] == index[obj_id]) {
+				/* obj is the root of a component: pop it */
+				int component_size = 0;
+				int component_start;
+				for (component_start = Vec_IntSize(component_stack) - 1;; component_start--) {
+					component_size++;
+					if (Vec_IntEntry(component_stack, component_start) == obj_id) {
+						break;
+					}
+				}
+
+				int j;
+				for (j = component_start; j < Vec_IntSize(component_stack); j++) {
+					int member_id = Vec_IntEntry(component_stack, j);
+					on_stack[member_id] = 0;
+					if (component_size > 1) {
+						in_cycle[member_id] = 1;
+					}
+				}
+				Vec_IntShrink(component_stack, component_start);
+			}
 		}
 	}
 
-	return FALSE;
+	VTR_ASSERT(Vec_IntSize(component_stack) == 0);
+
+	Vec_IntFree(dfs_fanins);
+	Vec_IntFree(dfs_objs);
+	Vec_IntFree(component_stack);
+	free(on_stack);
+	free(lowlink);
+	free(index);
 }
 
 Vec_Ptr_t * latches_in_cycles(Abc_Ntk_t * ntk) {
 	Vec_Ptr_t * latches_in_cycles_vec;
-	Abc_Obj_t * obj_ptr;
 	Abc_Obj_t * latch_ptr;
 	int i;
-	Ace_Obj_Info_t * info;
-	int pass_num;
+	char * in_cycle;
 
 	// Initialize
 	latches_in_cycles_vec = Vec_PtrStart(0);
 
-	Abc_NtkForEachObj(ntk, obj_ptr, i)
-	{
-		info = Ace_ObjInfo(obj_ptr);
-		info->flag = -1;
-	}
+	in_cycle = (char*) malloc(Abc_NtkObjNumMax(ntk) * sizeof(char));
+	mark_objects_in_cycles(ntk, in_cycle);
 
-	pass_num = 0;
 	Abc_NtkForEachLatch(ntk, latch_ptr, i)
 	{
-		if (in_cycle(ntk, Abc_ObjId(latch_ptr), latch_ptr, pass_num)) {
+		if (in_cycle[Abc_ObjId(latch_ptr)]) {
 			Vec_PtrPush(latches_in_cycles_vec, latch_ptr);
 		}
-		pass_num++;
 	}
 
+	free(in_cycle);
+
 	return latches_in_cycles_vec;
 }
@@ -7,7 +7,7 @@
 #include "bdd/cudd/cuddInt.h"
 
 void get_pi_values(Abc_Ntk_t * ntk, Vec_Ptr_t * nodes, int cycle);
-int * getFaninValues(Abc_Obj_t * obj_ptr);
+bool getFaninValues(Abc_Obj_t * obj_ptr, int * faninValues);
 ace_status_t getFaninStatus(Abc_Obj_t * obj_ptr);
 void evaluate_circuit(Abc_Ntk_t * ntk, Vec_Ptr_t * node_vec, int cycle);
 void update_FFs(Abc_Ntk_t * ntk);
@@ -121,11 +121,11 @@ void get_pi_values(Abc_Ntk_t * ntk, Vec_Ptr_t * /*nodes*/, int cycle) {
 	}
 }
 
-int * getFaninValues(Abc_Obj_t * obj_ptr) {
+/* Fills faninValues (with room for all fanins), returns FALSE if the inputs haven't changed */
+bool getFaninValues(Abc_Obj_t * obj_ptr, int * faninValues) {
 	Abc_Obj_t * fanin;
 	int i;
 	Ace_Obj_Info_t * info;
-	int * faninValues;
 
 	Abc_ObjForEachFanin(obj_ptr, fanin, i)
 	{
@@ -140,17 +140,16 @@ int * getFaninValues(Abc_Obj_t * obj_ptr) {
 
 	if (i >= Abc_ObjFaninNum(obj_ptr)) {
 		// inputs haven't changed
-		return NULL;
+		return FALSE;
 	}
 
-	faninValues = (int*) malloc(Abc_ObjFaninNum(obj_ptr) * sizeof(int));
 	Abc_ObjForEachFanin(obj_ptr, fanin, i)
 	{
 		info = Ace_ObjInfo(fanin);
 		faninValues[i] = info->value;
 	}
 
-	return faninValues;
+	return TRUE;
 }
 
 ace_status_t getFaninStatus(Abc_Obj_t * obj_ptr) {
@@ -186,6 +185,9 @@ void evaluate_circuit(Abc_Ntk_t * ntk, Vec_Ptr_t * node_vec, int /*cycle*/) {
 	ace_status_t status;
 	DdNode * dd_node;
 
+	/* Shared by all nodes, instead of allocated for each evaluation */
+	faninValues = (int*) malloc(MAX(Abc_NtkGetFaninMax(ntk), 1) * sizeof(int));
+
 	Vec_PtrForEachEntry(Abc_Obj_t*, node_vec, obj, i)
 	{
 		info = Ace_ObjInfo(obj);
@@ -210,8 +212,8 @@ void evaluate_circuit(Abc_Ntk_t * ntk, Vec_Ptr_t * node_vec, int /*cycle*/) {
 				break;
 			case ACE_NEW:
 				if (Abc_ObjIsNode(obj)) {
-					faninValues = getFaninValues(obj);
-					VTR_ASSERT(faninValues);
+					bool changed = getFaninValues(obj, faninValues);
+					VTR_ASSERT(changed);
 					dd_node = Cudd_Eval((DdManager*) ntk->pManFunc, (DdNode*) obj->pData, faninValues);
 					VTR_ASSERT(Cudd_IsConstant(dd_node));
 					if (dd_node == Cudd_ReadOne((DdManager*) ntk->pManFunc)) {
@@ -221,7 +223,6 @@ void evaluate_circuit(Abc_Ntk_t * ntk, Vec_Ptr_t * node_vec, int /*cycle*/) {
 					} else {
 						VTR_ASSERT(0);
 					}
-					free(faninValues);
 				} else {
 					Ace_Obj_Info_t * fanin_info = Ace_ObjInfo(
 							Abc_ObjFanin0(obj));
@@ -250,6 +251,8 @@ void evaluate_circuit(Abc_Ntk_t * ntk, Vec_Ptr_t * node_vec, int /*cycle*/) {
 			break;
 		}
 	}
+
+	free(faninValues);
 }
 
 void update_FFs(Abc_Ntk_t * ntk) {
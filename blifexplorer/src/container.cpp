@@ -111,8 +111,10 @@ bool Container::addConnectionHash(QString start, QString end)
 //at the moment wire crossing is not considered
 void Container::arrangeContainer()
 {
+    myScene->setBulkUpdate(true);
     computeLayers();
     spreadLayers();
+    myScene->setBulkUpdate(false);
     myScene->setSceneRect(0,0,1000.0+400*maxlayer+maxcountPerLayer*50,1000.0+400*maxcountPerLayer);
 }
 
@@ -213,26 +215,43 @@ int Container::getMaxParentLayer(LogicUnit* node){
  * (function: copySimCyclesintoNodes)
  *-------------------------------------------------------------------------------------------*/
 void Container::copySimCyclesIntoNodes()
-{   //for each cycle which was simulated         //int value;
-    //int i;, copy the values into the nodes
-    int cycle;
-    for(cycle=0+simOffset;cycle<maxSimStep;cycle++){
-        QHash<QString, nnode_t *>::const_iterator blockIterator = odinTable.constBegin();
-
-        while(blockIterator != odinTable.constEnd()){
-             int value;
-             int i;
-             QString name = blockIterator.key();
-             LogicUnit* visNode = unithashtable[name];
-             nnode_t* node = blockIterator.value();
+{   //for each node, copy the values of each cycle which was simulated.
+    //The wires are updated once the values are in, see updateSimulationView
+    QHash<QString, nnode_t *>::const_iterator blockIterator = odinTable.constBegin();
+
+    while(blockIterator != odinTable.constEnd()){
+         int value;
+         int i, cycle;
+         QString name = blockIterator.key();
+         LogicUnit* visNode = unithashtable[name];
+         nnode_t* node = blockIterator.value();
+         for(cycle=0+simOffset;cycle<maxSimStep;cycle++){
              //for each output pin of the node update the current value
              for(i=0;i<node->num_output_pins;i++){
                  value = myOdin->getOutputValue(node, i, cycle);
                  visNode->setOutValue(i, value, cycle);
-                 visNode->updateWires();
              }
-             ++blockIterator;
-        }
+         }
+         ++blockIterator;
+    }
+}
+
+/*---------------------------------------------------------------------------------------------
+ * (function: updateSimulationView)
+ *-------------------------------------------------------------------------------------------*/
+//Updates the status of every wire once, after the values or the cycle of all the
+//nodes are set. The wires only schedule a repaint, so a whole simulation step is
+//drawn in a single frame.
+void Container::updateSimulationView()
+{
+    QHash<QString, nnode_t *>::const_iterator blockIterator = odinTable.constBegin();
+
+    while(blockIterator != odinTable.constEnd()){
+         LogicUnit* visNode = unithashtable.value(blockIterator.key());
+         if(visNode != NULL){
+             visNode->updateWireStatus();
+         }
+         ++blockIterator;
     }
 }
 
@@ -243,10 +262,13 @@ void Container::copySimCyclesIntoNodes()
 void Container::computeLayers()
 {
     QQueue<LogicUnit*> nodequeue;
+    //the units in the queue, to not search the queue for each child
+    QSet<LogicUnit*> queuedUnits;
     QHash<QString, LogicUnit*> donehashtable;
     for (int i = 0; i < myOdin->blifexplorer_netlist->num_top_input_nodes; i++){
         QString name = myOdin->blifexplorer_netlist->top_input_nodes[i]->name;
         nodequeue.enqueue(getReferenceToUnit(name));
+        queuedUnits.insert(getReferenceToUnit(name));
     }
 
     // Enqueue constant nodes.
@@ -257,6 +279,7 @@ void Container::computeLayers()
     for (int i = 0; i < num_constant_nodes; i++){
         QString name = constant_nodes[i]->name;
         nodequeue.enqueue(getReferenceToUnit(name));
+        queuedUnits.insert(getReferenceToUnit(name));
     }
 
     // go through the netlist. While doing so
@@ -265,6 +288,7 @@ void Container::computeLayers()
     int maxparent;
     while(!nodequeue.isEmpty()){
         node = nodequeue.dequeue();
+        queuedUnits.remove(node);
         //remember name of the node so it is not processed again
         QString nodeName(node->getName());
         //assign layer
@@ -290,27 +314,25 @@ void Container::computeLayers()
             QString kidName(nodeKid->name);
             LogicUnit* kidUnit = getReferenceToUnit(kidName);
 
-            bool inQueue = nodequeue.contains(kidUnit);
+            bool inQueue = queuedUnits.contains(kidUnit);
             bool done = donehashtable.contains(kidName);
 
             if(!inQueue && !done && parentsDone(kidUnit,donehashtable)){
                 nodequeue.enqueue(kidUnit);
+                queuedUnits.insert(kidUnit);
             }
         }
     }
     maxlayer++;
     /*Locate all outputs at the very end of the graph*/
     QHash<QString, LogicUnit*>::const_iterator blockIterator = unithashtable.constBegin();
-    for(int i = 0; i<=maxlayer;i++){
-        blockIterator = unithashtable.constBegin();
-        while(blockIterator != unithashtable.constEnd()){
-            LogicUnit* actUnit = blockIterator.value();
-            if(actUnit->getName().contains("top^out")){
-                actUnit->setLayer(maxlayer);
-            }
-
-            ++blockIterator;
+    while(blockIterator != unithashtable.constEnd()){
+        LogicUnit* actUnit = blockIterator.value();
+        if(actUnit->getName().contains("top^out")){
+            actUnit->setLayer(maxlayer);
         }
+
+        ++blockIterator;
     }
 
 }
@@ -320,28 +342,30 @@ void Container::computeLayers()
  *-------------------------------------------------------------------------------------------*/
 void Container::spreadLayers()
 {
+    //collect the visible units of each layer in a single pass over all the units
+    QVector< QList<LogicUnit*> > layerUnits(maxlayer+1);
     QHash<QString, LogicUnit*>::const_iterator blockIterator = unithashtable.constBegin();
+    while(blockIterator != unithashtable.constEnd()){
+        LogicUnit* actUnit = blockIterator.value();
+        if(actUnit->isVisible() && actUnit->getLayer() >= 0 && actUnit->getLayer() <= maxlayer){
+            layerUnits[actUnit->getLayer()].append(actUnit);
+        }
+        ++blockIterator;
+    }
+
     LogicUnit* lastUnit = NULL;
     int counter = 0;
     int offset = 200;
 
     for(int i = 0; i<=maxlayer;i++){
-        blockIterator = unithashtable.constBegin();
-
-        while(blockIterator != unithashtable.constEnd()){
-            LogicUnit* actUnit = blockIterator.value();
-            if(actUnit->isVisible()){
-                if(actUnit->getLayer()== i){
-                    actUnit->setPos(offset+15*counter,100.0+200*counter);
-                    actUnit->updateWires();
-                    lastUnit = actUnit;
-                    counter++;
-                }
-                if(maxcountPerLayer < counter){
-                    maxcountPerLayer = counter;
-                }
-            }
-            ++blockIterator;
+        foreach(LogicUnit* actUnit, layerUnits[i]){
+            actUnit->setPos(offset+15*counter,100.0+200*counter);
+            actUnit->updateWires();
+            lastUnit = actUnit;
+            counter++;
+        }
+        if(maxcountPerLayer < counter){
+            maxcountPerLayer = counter;
         }
         if(lastUnit!=NULL){
             offset = lastUnit->x()+200;
@@ -785,12 +809,15 @@ int Container::readInFileOdinOnly(){
     start = clock();
     //let odin ii parse in the file and return a hashtable of all nodes in the netlist
     startOdin();
+    //the spatial index of the scene is only built once all the items are in
+    myScene->setBulkUpdate(true);
     fprintf(stdout, "VISUALIZATION: Creating nodes...\n");
     //iterate through the hashtable and create all nodes based on the type
     myItemcount = createNodesFromOdin();
     fprintf(stdout, "VISUALIZATION: Creating Node connections...\n");
      //create connections
     cons = createConnectionsFromOdinIterate();
+    myScene->setBulkUpdate(false);
      if(myItemcount <= 0)
          return -1;
 
@@ -855,6 +882,7 @@ int Container::startSimulator()
     myOdin->setUpSimulation();
     maxSimStep = myOdin->simulateNextWave();
     copySimCyclesIntoNodes();
+    updateSimulationView();
     /*
     myOdin->simulateNextWave();
     myOdin->endSimulation();
@@ -868,6 +896,7 @@ int Container::simulateNextWave()
     simOffset = maxSimStep;
     maxSimStep = myOdin->simulateNextWave();
     copySimCyclesIntoNodes();
+    updateSimulationView();
 
     return success;
 }
@@ -959,7 +988,7 @@ void Container::showSimulationStep(int cycle)
         copySimCyclesIntoNodes();
     }
 
-    //visit each node and update the output status of each one of them
+    //visit each node and set its cycle, then update the output status of all of them
     QHash<QString, nnode_t *>::const_iterator blockIterator = odinTable.constBegin();
 
     while(blockIterator != odinTable.constEnd()){
@@ -968,6 +997,7 @@ void Container::showSimulationStep(int cycle)
          visNode->setCurrentCycle(cycle);
          ++blockIterator;
     }
+    updateSimulationView();
     //actSimStep = (simOffset+1)%64;
 }
 
@@ -977,22 +1007,20 @@ void Container::showSimulationStep(int cycle)
 Wire *Container::getConnectionBetween(QString nodeName, QString kidName)
 {
     Wire* result = NULL;
-    QHash<QString, Wire *> wires;
-    QHash<QString, LogicUnit *> hash =unithashtable;
-    QHash<QString, LogicUnit *>::const_iterator blockIterator = hash.constBegin();
-
-     while(blockIterator != unithashtable.constEnd()){
-         QString actName = blockIterator.key();
-         if(actName.compare(nodeName)==0){
-             LogicUnit* actUnit = blockIterator.value();
-             wires = actUnit->getOutConsHash();
-         }
-         ++blockIterator;
-     }
-
-     if(wires.contains(kidName)){
-        result = wires.value(kidName);
-     }
+    LogicUnit* actUnit = unithashtable.value(nodeName);
+    if(actUnit == NULL)
+        return result;
+
+    //the latest outgoing connection to the kid (as the hash of the outgoing
+    //connections keeps it), without hashing all the connections of the node
+    QList<Wire *> wires = actUnit->getAllCons();
+    for(int i = wires.count()-1; i>=0 && result == NULL; i--){
+        Wire* wire = wires.at(i);
+        if(wire->startUnit() == actUnit &&
+                wire->endUnit()->getName().compare(kidName)==0){
+            result = wire;
+        }
+    }
      return result;
 }
 
@@ -1042,16 +1070,12 @@ void Container::expandCollapse(QString modulename)
     //toggle module visibility
     module->setVisible(!module->isVisible());
 
-    QHash<QString, LogicUnit *> hash =unithashtable;
-    QHash<QString, LogicUnit *>::const_iterator blockIterator = hash.constBegin();
-
-     while(blockIterator != unithashtable.constEnd()){
-         LogicUnit* actNode = blockIterator.value();
+    //only visit the nodes of the module, which it knows as its partners
+    foreach(LogicUnit* actNode, module->getPartners()){
          if(actNode->hasModule &&
                  actNode->getModule()->getName().compare(modulename)==0){
             actNode->setVisible(makeAllVisible);
          }
-         ++blockIterator;
      }
      arrangeContainer();
 
@@ -81,6 +81,7 @@ private:
     bool parentsDone(LogicUnit *unit);
     int getMaxParentLayer(LogicUnit* node);
     void copySimCyclesIntoNodes();
+    void updateSimulationView();
     void assignToModule(QString actName);
     void assignNodeToModule(QString nodeName, QString moduleName);
 
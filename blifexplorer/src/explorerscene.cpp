@@ -280,5 +280,18 @@ bool ExplorerScene::addConnection(LogicUnit *startUnit, LogicUnit *endUnit)
     return true;
 }
 
-
-
+/*---------------------------------------------------------------------------------------------
+ * (function: setBulkUpdate)
+ *-------------------------------------------------------------------------------------------*/
+//The spatial index (BSP tree) of the scene finds the items for the hit tests
+//and the items to draw in the viewport. While a whole netlist is created or
+//laid out, it would be updated on every single change: turn it off during such
+//bulk changes, so that it is only built once they are done.
+void ExplorerScene::setBulkUpdate(bool value)
+{
+    if(value){
+        setItemIndexMethod(QGraphicsScene::NoIndex);
+    }else{
+        setItemIndexMethod(QGraphicsScene::BspTreeIndex);
+    }
+}
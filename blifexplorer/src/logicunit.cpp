@@ -24,6 +24,20 @@ OTHER DEALINGS IN THE SOFTWARE.
 #include "logicunit.h"
 #include "wire.h"
 
+/*---------------------------------------------------------------------------------------------
+ * (function: getUnitImage)
+ *-------------------------------------------------------------------------------------------*/
+//The image of each unit type is loaded from the resources once and shared by
+//all the units, instead of being loaded again on every paint of every unit
+static QImage getUnitImage(const QString &resource)
+{
+    static QHash<QString, QImage> images;
+    if(!images.contains(resource)){
+        images.insert(resource, QImage(resource));
+    }
+    return images.value(resource);
+}
+
 
 
 
@@ -152,8 +166,10 @@ void LogicUnit::addConnection(Wire *wire)
             wire->setNumber(myIncount);
             wire->setMaxNumber(myIncount);
         }
+        //only the new wire has to be placed (the inputs already moved
+        //by the new count are updated by setMaxNumber)
         wires.append(wire);
-        itemChange(QGraphicsPolygonItem::ItemPositionChange,QVariant(0));
+        wire->updatePosition();
     }else{//I am a Module
         if(wire->startUnit()->hasModule){
             //I am the start module
@@ -291,69 +307,76 @@ QVariant LogicUnit::itemChange(GraphicsItemChange change,
  *-------------------------------------------------------------------------------------------*/
 void LogicUnit::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget){
      QGraphicsPolygonItem::paint(painter,option,widget);
+
+    //When zoomed out this far, images and names can not be read anymore:
+    //only the outline of the unit is drawn
+    if(option->levelOfDetailFromTransform(painter->worldTransform()) < 0.2){
+        return;
+    }
+
 QImage image;
 
 //If a picture defines the shape, use the fullrect and draw invisible borders
 
     switch (myUnitType) {
     case And:
-        image.load(":/images/nodeTypes/AND.png");
+        image = getUnitImage(":/images/nodeTypes/AND.png");
         painter->drawImage(boundingRect(),image);
             break;
     case Nand:
-        image.load(":/images/nodeTypes/NAND.png");
+        image = getUnitImage(":/images/nodeTypes/NAND.png");
         painter->drawImage(boundingRect(),image);
             break;
     case Or:
-        image.load(":/images/nodeTypes/OR.png");
+        image = getUnitImage(":/images/nodeTypes/OR.png");
         painter->drawImage(boundingRect(),image);
             break;
     case Nor:
-        image.load(":/images/nodeTypes/NOR.png");
+        image = getUnitImage(":/images/nodeTypes/NOR.png");
         painter->drawImage(boundingRect(),image);
             break;
     case Xor:
-        image.load(":/images/nodeTypes/XOR.png");
+        image = getUnitImage(":/images/nodeTypes/XOR.png");
         painter->drawImage(boundingRect(),image);
             break;
     case Xnor:
-        image.load(":/images/nodeTypes/XNOR.png");
+        image = getUnitImage(":/images/nodeTypes/XNOR.png");
         painter->drawImage(boundingRect(),image);
             break;
     case Not:
-        image.load(":/images/nodeTypes/NOT.png");
+        image = getUnitImage(":/images/nodeTypes/NOT.png");
         painter->drawImage(boundingRect(),image);
             break;
     case MUX:
-        image.load(":/images/nodeTypes/MUX.png");
+        image = getUnitImage(":/images/nodeTypes/MUX.png");
         painter->drawImage(boundingRect(),image);
             break;
     case ADDER_FUNC:
-        image.load(":/images/nodeTypes/ADDER_FUNC.png");
+        image = getUnitImage(":/images/nodeTypes/ADDER_FUNC.png");
         painter->drawImage(boundingRect(),image);
             break;
     case CARRY_FUNC:
-        image.load(":/images/nodeTypes/CARRY_FUNC.png");
+        image = getUnitImage(":/images/nodeTypes/CARRY_FUNC.png");
         painter->drawImage(boundingRect(),image);
         break;
     case MEMORY:
-        image.load(":/images/nodeTypes/Hmemory.png");
+        image = getUnitImage(":/images/nodeTypes/Hmemory.png");
         painter->drawImage(boundingRect(),image);
         break;
     case Module:
-        image.load(":/images/nodeTypes/module.png");
+        image = getUnitImage(":/images/nodeTypes/module.png");
         painter->drawImage(boundingRect(),image);
         break;
     case MINUS:
-        image.load(":/images/nodeTypes/Hminus.png");
+        image = getUnitImage(":/images/nodeTypes/Hminus.png");
         painter->drawImage(boundingRect(),image);
         break;
     case ADD:
-        image.load(":/images/nodeTypes/Hadd.png");
+        image = getUnitImage(":/images/nodeTypes/Hadd.png");
         painter->drawImage(boundingRect(),image);
         break;
     case MULTIPLY:
-        image.load(":/images/nodeTypes/Hmult.png");
+        image = getUnitImage(":/images/nodeTypes/Hmult.png");
         painter->drawImage(boundingRect(),image);
         break;
     case LogicGate:
@@ -439,6 +462,20 @@ void LogicUnit::updateWires()
     }
 }
 
+/*---------------------------------------------------------------------------------------------
+ * (function: updateWireStatus)
+ *-------------------------------------------------------------------------------------------*/
+//Updates the status of the outgoing wires only. The status of a wire only depends
+//on the output value of its start unit, and its position does not change with
+//the simulated cycle.
+void LogicUnit::updateWireStatus()
+{
+    foreach(Wire *wire, wires){
+        if(wire->startUnit() == this)
+            wire->updateWireStatus();
+    }
+}
+
 /*---------------------------------------------------------------------------------------------
  * (function: setName)
  *-------------------------------------------------------------------------------------------*/
@@ -585,10 +622,10 @@ void LogicUnit::setHighlighted(bool value)
 /*---------------------------------------------------------------------------------------------
  * (function: setCurrentCycle)
  *-------------------------------------------------------------------------------------------*/
+//The wires are not updated here, see updateWireStatus
 void LogicUnit::setCurrentCycle(int cycle)
 {
     myCurrentCycle = cycle;
-    updateWires();
 }
 
 bool LogicUnit::isShown()
@@ -631,6 +668,14 @@ LogicUnit * LogicUnit::getModule()
     return moduleViewPartners.at(0);
 }
 
+/*
+  For a module, returns the nodes it contains
+*/
+QList<LogicUnit*> LogicUnit::getPartners()
+{
+    return moduleViewPartners;
+}
+
 int LogicUnit::getMaxOutNumber()
 {
     return outNodes.count();
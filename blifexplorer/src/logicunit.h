@@ -83,6 +83,7 @@ public:
     void setLayer(int layer);
     int getLayer();
     void updateWires();
+    void updateWireStatus();
     void setName(QString name);
     int getOutValue(int pinNumber);
     int setOutValue(int pinNumber, int value, int cycle);
@@ -99,6 +100,7 @@ public:
     void addPartner(LogicUnit* partner);
     bool hasModule;
     LogicUnit* getModule();
+    QList<LogicUnit*> getPartners();
     int getMaxOutNumber();
     int getMaxNumber();
     void showActivity();
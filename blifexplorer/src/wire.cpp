@@ -202,7 +202,8 @@ void Wire::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWid
     Q_UNUSED(widget);
 
     //if the modules collide, do not paint a connection
-    if(myStartUnit->collidesWithItem(myEndUnit))
+    //(the bounding rects are enough, and much cheaper than the shapes to intersect)
+    if(myStartUnit->collidesWithItem(myEndUnit, Qt::IntersectsItemBoundingRect))
     {
         return;
     }
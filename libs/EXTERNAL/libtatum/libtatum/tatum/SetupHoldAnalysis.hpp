@@ -110,6 +110,11 @@ class SetupHoldAnalysis : public GraphVisitor {
 #endif
         TimingTags::tag_range hold_node_slacks(const NodeId node_id) const { return hold_visitor_.hold_node_slacks(node_id); }
 
+        void set_domain_reachability(std::shared_ptr<const DomainReachability> domain_reachability) {
+            setup_visitor_.set_domain_reachability(domain_reachability);
+            hold_visitor_.set_domain_reachability(domain_reachability);
+        }
+
         SetupAnalysis& setup_visitor() { return setup_visitor_; }
         HoldAnalysis& hold_visitor() { return hold_visitor_; }
     private:
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cmath>
+#include <cstddef>
 #include <array>
 #include <iosfwd>
 
@@ -19,6 +20,9 @@
 //Required for aligned access with SSE
 # define TIME_MEM_ALIGN 4*sizeof(float)
 
+#elif TIME_VEC_WIDTH > 1
+# define TIME_MEM_ALIGN sizeof(float)
+
 #endif //TIME_VEC_WIDTH
 
 #if TIME_VEC_WIDTH > 1
@@ -27,6 +31,17 @@
 
 namespace tatum {
 
+/*
+ * A time value.
+ *
+ * With TIME_VEC_WIDTH > 1 each Time holds that many independent values (lanes),
+ * which all arithmetic operates on element-wise (and which the compiler can vectorize).
+ * This allows a single timing graph traversal to analyze several sets of delays at once
+ * (e.g. the delays of different timing corners, one per lane).
+ *
+ * Comparisons and value() refer to the first lane, which is used to select the
+ * origin nodes recorded in timing tags (i.e. timing paths are traced for the first lane).
+ */
 class Time {
     public:
         typedef float scalar_type;
@@ -37,9 +52,21 @@ class Time {
         explicit Time(const double time) { set_value(time); }
 
     public: //Accessors
-        ///The current time value
+        ///\returns The number of independent time values (lanes) held, see TIME_VEC_WIDTH
+        constexpr static size_t num_lanes() { return TIME_VEC_WIDTH; }
+
+        ///The current time value (of the first lane)
         scalar_type value() const;
 
+        ///The current time value of the specified lane
+        scalar_type lane_value(size_t lane) const;
+
+        ///The minimum time value across all lanes
+        scalar_type min_value() const;
+
+        ///The maximum time value across all lanes
+        scalar_type max_value() const;
+
         ///Indicates whether the current time value is valid
         bool valid() const;
 
@@ -52,14 +79,18 @@ class Time {
         operator scalar_type() const { return value(); }
 
     public: //Mutators
-        ///Set the current time value to time
+        ///Set the current time value (of all lanes) to time
         void set_value(scalar_type time);
 
+        ///Set the current time value of the specified lane to time
+        void set_lane_value(size_t lane, scalar_type time);
+
 
         Time& operator+=(const Time& rhs);
         Time& operator-=(const Time& rhs);
 
         friend bool operator==(const Time lhs, const Time rhs);
+        friend bool operator!=(const Time lhs, const Time rhs);
         friend bool operator<(const Time lhs, const Time rhs);
         friend bool operator>(const Time lhs, const Time rhs);
         friend Time operator-(const Time val);
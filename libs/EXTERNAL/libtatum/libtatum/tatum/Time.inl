@@ -49,8 +49,28 @@ namespace tatum {
         return *this;
     }
 
+    inline void Time::set_lane_value(size_t lane, scalar_type time) { time_[lane] = time; }
+
     inline Time::scalar_type Time::value() const { return time_[0]; }
 
+    inline Time::scalar_type Time::lane_value(size_t lane) const { return time_[lane]; }
+
+    inline Time::scalar_type Time::min_value() const {
+        scalar_type result = time_[0];
+        for(size_t i = 1; i < time_.size(); i++) {
+            result = (result < time_[i]) ? result : time_[i];
+        }
+        return result;
+    }
+
+    inline Time::scalar_type Time::max_value() const {
+        scalar_type result = time_[0];
+        for(size_t i = 1; i < time_.size(); i++) {
+            result = (result > time_[i]) ? result : time_[i];
+        }
+        return result;
+    }
+
     inline bool Time::valid() const {
         //This is a reduction with a function call inside,
         //so we can't vectorize easily
@@ -62,7 +82,11 @@ namespace tatum {
     }
 #else //Scalar case (TIME_VEC_WIDTH == 1)
     inline Time::scalar_type Time::value() const { return time_; }
+    inline Time::scalar_type Time::lane_value(size_t /*lane*/) const { return time_; }
+    inline Time::scalar_type Time::min_value() const { return time_; }
+    inline Time::scalar_type Time::max_value() const { return time_; }
     inline void Time::set_value(scalar_type time) { time_ = time; }
+    inline void Time::set_lane_value(size_t /*lane*/, scalar_type time) { time_ = time; }
     inline bool Time::valid() const { return !std::isnan(time_); }
 
     inline void Time::max(const Time& other) { time_ = std::max(time_, other.time_); }
@@ -77,16 +101,26 @@ namespace tatum {
  */
 
 #if TIME_VEC_WIDTH > 1
+inline bool operator==(const Time lhs, const Time rhs) {
+    return lhs.time_ == rhs.time_;
+}
+
+//Ordering is by the first lane (see Time)
+inline bool operator<(const Time lhs, const Time rhs) {
+    return lhs.time_[0] < rhs.time_[0];
+}
+
+inline bool operator>(const Time lhs, const Time rhs) {
+    return lhs.time_[0] > rhs.time_[0];
+}
+
 inline Time operator-(Time in) {
-    for(size_t i = 0; i < time_.size(); i++) {
+    for(size_t i = 0; i < in.time_.size(); i++) {
         in.time_[i] = -in.time_[i];
     }
     return in;
 }
 inline Time operator+(Time in) {
-    for(size_t i = 0; i < time_.size(); i++) {
-        in.time_[i] = +in.time_[i];
-    }
     return in;
 }
 #else //Scalar case (TIME_VEC_WIDTH == 1)
@@ -112,6 +146,10 @@ inline Time operator+(Time in) {
 }
 #endif //TIME_VEC_WIDTH
 
+inline bool operator!=(const Time lhs, const Time rhs) {
+    return !(lhs == rhs);
+}
+
 inline Time operator+(Time lhs, const Time& rhs) {
     return lhs += rhs;
 }
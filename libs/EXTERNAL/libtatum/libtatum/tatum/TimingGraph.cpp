@@ -2,16 +2,27 @@
 #include <iostream>
 #include <sstream>
 #include <map>
+#include <queue>
+#include <unordered_map>
 
 #include "tatum/util/tatum_assert.hpp"
 #include "tatum/base/loop_detect.hpp"
 #include "tatum/error.hpp"
 #include "tatum/TimingGraph.hpp"
 
-
+#if defined(TATUM_USE_TBB)
+# include <atomic>
+# include <tbb/enumerable_thread_specific.h>
+# include <tbb/parallel_for.h>
+# include <tbb/parallel_sort.h>
+#endif
 
 namespace tatum {
 
+//Graphs with fewer nodes are levelized and laid out serially, since the
+//parallel versions only pay off on large graphs
+constexpr size_t MIN_PARALLEL_LEVELIZE_NODES = 100000;
+
 
 //Builds a mapping from old to new ids by skipping values marked invalid
 template<typename Id>
@@ -194,6 +205,8 @@ NodeId TimingGraph::add_node(const NodeType type) {
     TATUM_ASSERT(node_types_.size() == node_out_edges_.size());
     TATUM_ASSERT(node_types_.size() == node_in_edges_.size());
 
+    modified_nodes_.push_back(node_id);
+
     //Return the ID of the added node
     return node_id;
 }
@@ -224,6 +237,9 @@ EdgeId TimingGraph::add_edge(const EdgeType type, const NodeId src_node, const N
     node_out_edges_[src_node].push_back(edge_id);
     node_in_edges_[sink_node].push_back(edge_id);
 
+    modified_nodes_.push_back(src_node);
+    modified_nodes_.push_back(sink_node);
+
     TATUM_ASSERT(edge_type(edge_id) == type);
     TATUM_ASSERT(edge_src_node(edge_id) == src_node);
     TATUM_ASSERT(edge_sink_node(edge_id) == sink_node);
@@ -239,21 +255,21 @@ void TimingGraph::remove_node(const NodeId node_id) {
     //Invalidate the levelization
     is_levelized_ = false;
 
-    //Invalidate all the references
-    for(EdgeId in_edge : node_in_edges(node_id)) {
-        if(!in_edge) continue;
-
+    //Invalidate all the references (copied, since removing an edge updates the node's edges)
+    std::vector<EdgeId> in_edges = node_in_edges_[node_id];
+    for(EdgeId in_edge : in_edges) {
         remove_edge(in_edge);
     }
 
-    for(EdgeId out_edge : node_out_edges(node_id)) {
-        if(!out_edge) continue;
-
+    std::vector<EdgeId> out_edges = node_out_edges_[node_id];
+    for(EdgeId out_edge : out_edges) {
         remove_edge(out_edge);
     }
 
     //Mark the node as invalid
     node_ids_[node_id] = NodeId::INVALID();
+
+    modified_nodes_.push_back(node_id);
 }
 
 void TimingGraph::remove_edge(const EdgeId edge_id) {
@@ -262,20 +278,26 @@ void TimingGraph::remove_edge(const EdgeId edge_id) {
     //Invalidate the levelization
     is_levelized_ = false;
 
-    //Invalidate the upstream node to edge references
+    //Remove the upstream node to edge references
+    //
+    //Note that the node edge lists are kept free of invalid references, so the graph can
+    //still be levelized and analyzed before the next compress()
     NodeId src_node = edge_src_node(edge_id);    
     auto iter_out = std::find(node_out_edges_[src_node].begin(), node_out_edges_[src_node].end(), edge_id);
     TATUM_ASSERT(iter_out != node_out_edges_[src_node].end());
-    *iter_out = EdgeId::INVALID();
+    node_out_edges_[src_node].erase(iter_out);
 
-    //Invalidate the downstream node to edge references
+    //Remove the downstream node to edge references
     NodeId sink_node = edge_sink_node(edge_id);    
     auto iter_in = std::find(node_in_edges_[sink_node].begin(), node_in_edges_[sink_node].end(), edge_id);
     TATUM_ASSERT(iter_in != node_in_edges_[sink_node].end());
-    *iter_in = EdgeId::INVALID();
+    node_in_edges_[sink_node].erase(iter_in);
 
     //Mark the edge invalid
     edge_ids_[edge_id] = EdgeId::INVALID();
+
+    modified_nodes_.push_back(src_node);
+    modified_nodes_.push_back(sink_node);
 }
 
 void TimingGraph::disable_edge(const EdgeId edge, bool disable) {
@@ -284,6 +306,9 @@ void TimingGraph::disable_edge(const EdgeId edge, bool disable) {
     if(edges_disabled_[edge] != disable) {
         //If we are changing edges the levelization is no longer valid
         is_levelized_ = false;
+
+        modified_nodes_.push_back(edge_src_node(edge));
+        modified_nodes_.push_back(edge_sink_node(edge));
     }
 
     //Update the edge's disabled flag
@@ -300,9 +325,19 @@ EdgeId TimingGraph::find_edge(const tatum::NodeId src_node, const tatum::NodeId
     TATUM_ASSERT(valid_node_id(src_node));
     TATUM_ASSERT(valid_node_id(sink_node));
 
-    for(EdgeId edge : node_out_edges(src_node)) {
-        if(edge_sink_node(edge) == sink_node) {
-            return edge;
+    //Search from whichever end has fewer edges: path tracing looks up edges
+    //from very high fanout nodes (e.g. clock net drivers) to single nodes
+    if(node_in_edges(sink_node).size() < node_out_edges(src_node).size()) {
+        for(EdgeId edge : node_in_edges(sink_node)) {
+            if(edge_src_node(edge) == src_node) {
+                return edge;
+            }
+        }
+    } else {
+        for(EdgeId edge : node_out_edges(src_node)) {
+            if(edge_sink_node(edge) == sink_node) {
+                return edge;
+            }
         }
     }
     return EdgeId::INVALID();
@@ -340,6 +375,53 @@ void TimingGraph::force_levelize() {
     primary_inputs_.clear();
     logical_outputs_.clear();
 
+    std::vector<NodeId> last_level;
+#if defined(TATUM_USE_TBB)
+    if(nodes().size() >= MIN_PARALLEL_LEVELIZE_NODES) {
+        last_level = levelize_nodes_parallel();
+    } else {
+        last_level = levelize_nodes();
+    }
+#else
+    last_level = levelize_nodes();
+#endif
+
+    //Add the last level to the end of the levelization
+    level_nodes_.emplace_back(last_level);
+    int level_idx = level_ids_.size();
+    level_ids_.emplace_back(level_idx);
+
+    //Add SINK type nodes in the last level to logical outputs
+    //Note that we only do this for sinks, since non-sink nodes may end up
+    //in the last level (e.g. due to breaking combinational loops)
+    auto is_sink = [this](NodeId id) {
+        return this->node_type(id) == NodeType::SINK;
+    };
+    std::copy_if(last_level.begin(), last_level.end(), std::back_inserter(logical_outputs_), is_sink);
+
+    //Build the reverse node-to-level look-up
+    node_levels_.resize(nodes().size());
+#if defined(TATUM_USE_TBB)
+    tbb::parallel_for(size_t(0), level_ids_.size(), [&](size_t ilevel) {
+        LevelId level(ilevel);
+        for(NodeId node : level_nodes_[level]) {
+            node_levels_[node] = level;
+        }
+    });
+#else
+    for (LevelId level : level_ids_) {
+        for(NodeId node : level_nodes_[level]) {
+            node_levels_[node] = level;
+        }
+    }
+#endif
+
+    //Mark the levelization as valid
+    is_levelized_ = true;
+    modified_nodes_.clear();
+}
+
+std::vector<NodeId> TimingGraph::levelize_nodes() {
     //Allocate space for the first level
     level_nodes_.resize(1);
 
@@ -350,6 +432,8 @@ void TimingGraph::force_levelize() {
     //Also initialize the first level (nodes with no fanin)
     std::vector<int> node_fanin_remaining(nodes().size());
     for(NodeId node_id : nodes()) {
+        if(!node_id) continue; //Removed
+
         size_t node_fanin = 0;
         for(EdgeId edge : node_in_edges(node_id)) {
             if(edge_disabled(edge)) continue;
@@ -429,29 +513,312 @@ void TimingGraph::force_levelize() {
         }
     }
 
-    //Add the last level to the end of the levelization
-    level_nodes_.emplace_back(last_level);
-    level_idx++;
+    return last_level;
+}
+
+#if defined(TATUM_USE_TBB)
+std::vector<NodeId> TimingGraph::levelize_nodes_parallel() {
+    //Produces exactly the same levels, in the same order, as levelize_nodes().
+    //
+    //The nodes of each level have their fan-out processed in parallel, atomically
+    //decrementing the fan-in count of the target nodes. A node completes once its
+    //count reaches zero, which happens in levelize_nodes() when it processes the last
+    //of its fan-in edges in its traversal order (nodes in level order, and the output
+    //edges of each node in order). Each node therefore records the largest traversal
+    //order key of its fan-in edges, by which the completed nodes are then sorted.
+    //Keys increase from level to level, so they never need to be reset.
+    const size_t num_nodes = nodes().size();
+    TATUM_ASSERT(num_nodes < (size_t(1) << 32));
+
+    std::vector<std::atomic<int>> node_fanin_remaining(num_nodes);
+    std::vector<std::atomic<uint64_t>> node_last_fanin_key(num_nodes);
+
+    tbb::parallel_for(size_t(0), num_nodes, [&](size_t inode) {
+        int node_fanin = 0;
+        NodeId node_id = node_ids_[NodeId(inode)];
+        if(node_id) {
+            for(EdgeId edge : node_in_edges(node_id)) {
+                if(edge_disabled(edge)) continue;
+                ++node_fanin;
+            }
+        }
+        node_fanin_remaining[inode].store(node_fanin, std::memory_order_relaxed);
+        node_last_fanin_key[inode].store(0, std::memory_order_relaxed);
+    });
+
+    //Initialize the first level (nodes with no fanin)
+    level_nodes_.resize(1);
+    for(NodeId node_id : nodes()) {
+        if(!node_id) continue; //Removed
+
+        if(node_fanin_remaining[size_t(node_id)].load(std::memory_order_relaxed) == 0) {
+            level_nodes_[LevelId(0)].push_back(node_id);
+
+            if (node_type(node_id) == NodeType::SOURCE) {
+                //See levelize_nodes()
+                primary_inputs_.push_back(node_id);
+            }
+        }
+    }
+
+    int level_idx = 0;
     level_ids_.emplace_back(level_idx);
 
-    //Add SINK type nodes in the last level to logical outputs
-    //Note that we only do this for sinks, since non-sink nodes may end up
-    //in the last level (e.g. due to breaking combinational loops)
-    auto is_sink = [this](NodeId id) {
-        return this->node_type(id) == NodeType::SINK;
+    std::vector<NodeId> last_level;
+
+    tbb::enumerable_thread_specific<std::vector<NodeId>> thread_completed_nodes;
+    size_t level_start = 0; //Traversal order of the first node of the current level
+    while(true) {
+        const std::vector<NodeId>& level_nodes = level_nodes_[LevelId(level_idx)];
+
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, level_nodes.size()), [&](const tbb::blocked_range<size_t>& range) {
+            std::vector<NodeId>& completed_nodes = thread_completed_nodes.local();
+
+            for(size_t inode = range.begin(); inode != range.end(); ++inode) {
+                const NodeId node_id = level_nodes[inode];
+                const uint64_t node_key = uint64_t(level_start + inode) << 32;
+
+                uint64_t iedge = 0;
+                for(EdgeId edge_id : node_out_edges(node_id)) {
+                    const uint64_t edge_key = node_key | iedge++;
+                    if(edge_disabled(edge_id)) continue;
+
+                    const size_t sink_node = size_t(edge_sink_node(edge_id));
+
+                    uint64_t last_key = node_last_fanin_key[sink_node].load(std::memory_order_relaxed);
+                    while(last_key < edge_key
+                          && !node_last_fanin_key[sink_node].compare_exchange_weak(last_key, edge_key, std::memory_order_relaxed)) {
+                    }
+
+                    //Decrement the fanin count
+                    int fanin_remaining = node_fanin_remaining[sink_node].fetch_sub(1, std::memory_order_acq_rel) - 1;
+                    TATUM_ASSERT(fanin_remaining >= 0);
+
+                    if(fanin_remaining == 0) {
+                        completed_nodes.push_back(NodeId(sink_node));
+                    }
+                }
+            }
+        });
+
+        std::vector<NodeId> completed_nodes;
+        for(std::vector<NodeId>& thread_nodes : thread_completed_nodes) {
+            completed_nodes.insert(completed_nodes.end(), thread_nodes.begin(), thread_nodes.end());
+            thread_nodes.clear();
+        }
+        tbb::parallel_sort(completed_nodes.begin(), completed_nodes.end(), [&](const NodeId lhs, const NodeId rhs) {
+            return node_last_fanin_key[size_t(lhs)].load(std::memory_order_relaxed)
+                   < node_last_fanin_key[size_t(rhs)].load(std::memory_order_relaxed);
+        });
+
+        level_start += level_nodes.size();
+
+        std::vector<NodeId> next_level;
+        for(NodeId node_id : completed_nodes) {
+            if(node_out_edges(node_id).size() != 0) {
+                next_level.push_back(node_id);
+            } else {
+                //No fan-out, see levelize_nodes()
+                last_level.push_back(node_id);
+            }
+        }
+
+        if(next_level.empty()) break; //If nothing was inserted we are finished
+
+        level_nodes_.emplace_back(std::move(next_level));
+        level_idx++;
+        level_ids_.emplace_back(level_idx);
+    }
+
+    return last_level;
+}
+#endif
+
+void TimingGraph::levelize_incremental() {
+    if(is_levelized_) {
+        modified_nodes_.clear();
+        return;
+    }
+
+    if(level_ids_.empty()) {
+        //No previous levelization to update
+        force_levelize();
+        return;
+    }
+
+    //The level of a node is 0 if it has no (active) fan-in, the last level if it has fan-in
+    //but no fan-out edges, and otherwise one more than the highest level of its fan-in
+    //(see force_levelize()).
+    //
+    //Starting from the modified nodes we re-evaluate the level of nodes in increasing
+    //level order, re-evaluating the fan-out of any node whose level changed. The levels
+    //of the rest of the graph are unaffected by the modifications.
+    constexpr size_t LAST_LEVEL = std::numeric_limits<size_t>::max();
+    constexpr size_t UNLEVELIZED = LAST_LEVEL - 1;
+    const size_t prev_last_level = level_ids_.size() - 1;
+
+    node_levels_.resize(nodes().size()); //New nodes are unlevelized
+
+    std::unordered_map<NodeId,size_t> new_levels; //Re-evaluated levels which changed
+    std::vector<NodeId> changed_nodes;
+
+    auto current_level = [&](const NodeId node) {
+        auto iter = new_levels.find(node);
+        if(iter != new_levels.end()) {
+            return iter->second;
+        }
+        const LevelId level = node_levels_[node];
+        if(!level) {
+            return UNLEVELIZED;
+        }
+        return (size_t(level) == prev_last_level) ? LAST_LEVEL : size_t(level);
     };
-    std::copy_if(last_level.begin(), last_level.end(), std::back_inserter(logical_outputs_), is_sink);
 
-    //Build the reverse node-to-level look-up
-    node_levels_.resize(nodes().size());
-    for (LevelId level : level_ids_) {
-        for(NodeId node : level_nodes_[level]) {
-            node_levels_[node] = level;
+    typedef std::pair<size_t,NodeId> LevelNode;
+    std::priority_queue<LevelNode,std::vector<LevelNode>,std::greater<LevelNode>> queue;
+    for(NodeId node : modified_nodes_) {
+        if(!node_ids_[node]) continue; //Removed
+
+        size_t level = current_level(node);
+        queue.emplace((level == LAST_LEVEL || level == UNLEVELIZED) ? 0 : level, node);
+    }
+
+    while(!queue.empty()) {
+        NodeId node = queue.top().second;
+        queue.pop();
+
+        bool has_fanin = false;
+        size_t max_fanin_level = 0;
+        for(EdgeId edge : node_in_edges(node)) {
+            if(edge_disabled(edge)) continue;
+            has_fanin = true;
+
+            size_t fanin_level = current_level(edge_src_node(edge));
+            if(fanin_level == LAST_LEVEL || fanin_level == UNLEVELIZED) {
+                //A modified node not yet re-evaluated, which will re-queue this node
+                continue;
+            }
+            max_fanin_level = std::max(max_fanin_level, fanin_level);
+        }
+
+        size_t level = 0;
+        if(!has_fanin) {
+            level = 0;
+        } else if(node_out_edges(node).size() == 0) {
+            level = LAST_LEVEL;
+        } else {
+            level = max_fanin_level + 1;
+
+            if(level >= nodes().size()) {
+                //Levels can only grow this large by going around a loop
+                force_levelize();
+                return;
+            }
+        }
+
+        if(level == current_level(node)) continue;
+
+        if(!new_levels.count(node)) {
+            changed_nodes.push_back(node);
+        }
+        new_levels[node] = level;
+
+        for(EdgeId edge : node_out_edges(node)) {
+            if(edge_disabled(edge)) continue;
+            queue.emplace(level + 1, edge_sink_node(edge));
+        }
+    }
+
+    //Removed nodes leave their level
+    for(NodeId node : modified_nodes_) {
+        if(!node_ids_[node] && node_levels_[node]) {
+            if(!new_levels.count(node)) {
+                changed_nodes.push_back(node);
+            }
+            new_levels[node] = UNLEVELIZED;
+        }
+    }
+
+    //Update the levelization, removing the moved nodes from their previous levels
+    //(one pass per affected level) before adding them to their new ones
+    std::vector<NodeId> last_level = std::move(level_nodes_[LevelId(prev_last_level)]);
+    level_nodes_.resize(prev_last_level);
+
+    std::sort(changed_nodes.begin(), changed_nodes.end()); //Deterministic order within levels
+
+    std::set<size_t> prev_levels;
+    for(NodeId node : changed_nodes) {
+        if(node_levels_[node]) {
+            prev_levels.insert(size_t(node_levels_[node]));
+        }
+    }
+    auto is_changed = [&](const NodeId node) {
+        return new_levels.count(node) > 0;
+    };
+    for(size_t level : prev_levels) {
+        auto& prev_level_nodes = (level == prev_last_level) ? last_level : level_nodes_[LevelId(level)];
+        prev_level_nodes.erase(std::remove_if(prev_level_nodes.begin(), prev_level_nodes.end(), is_changed),
+                               prev_level_nodes.end());
+    }
+
+    for(NodeId node : changed_nodes) {
+        size_t level = new_levels[node];
+        if(level == UNLEVELIZED) {
+            node_levels_[node] = LevelId::INVALID();
+        } else if(level == LAST_LEVEL) {
+            last_level.push_back(node);
+        } else {
+            if(level >= level_nodes_.size()) {
+                level_nodes_.resize(level + 1);
+            }
+            level_nodes_[LevelId(level)].push_back(node);
+            node_levels_[node] = LevelId(level);
+        }
+    }
+
+    //Drop any emptied trailing levels (the first level is always kept)
+    while(level_nodes_.size() > 1 && level_nodes_[LevelId(level_nodes_.size() - 1)].empty()) {
+        level_nodes_.resize(level_nodes_.size() - 1);
+    }
+
+    level_ids_.clear();
+    for(size_t level = 0; level < level_nodes_.size(); ++level) {
+        level_ids_.emplace_back(level);
+    }
+
+    //Add the last level back to the end of the levelization
+    LevelId last_level_id(level_nodes_.size());
+    if(size_t(last_level_id) != prev_last_level) {
+        for(NodeId node : last_level) {
+            node_levels_[node] = last_level_id;
+        }
+    } else {
+        for(NodeId node : changed_nodes) {
+            if(new_levels[node] == LAST_LEVEL) {
+                node_levels_[node] = last_level_id;
+            }
+        }
+    }
+    level_nodes_.emplace_back(std::move(last_level));
+    level_ids_.emplace_back(last_level_id);
+
+    //Update the primary inputs and logical outputs
+    primary_inputs_.erase(std::remove_if(primary_inputs_.begin(), primary_inputs_.end(), is_changed),
+                          primary_inputs_.end());
+    logical_outputs_.erase(std::remove_if(logical_outputs_.begin(), logical_outputs_.end(), is_changed),
+                           logical_outputs_.end());
+    for(NodeId node : changed_nodes) {
+        size_t level = new_levels[node];
+        if(level == 0 && node_type(node) == NodeType::SOURCE) {
+            primary_inputs_.push_back(node);
+        } else if(level == LAST_LEVEL && node_type(node) == NodeType::SINK) {
+            logical_outputs_.push_back(node);
         }
     }
 
     //Mark the levelization as valid
     is_levelized_ = true;
+    modified_nodes_.clear();
 }
 
 bool TimingGraph::validate() const {
@@ -479,6 +846,42 @@ GraphIdMaps TimingGraph::optimize_layout() {
 
 tatum::util::linear_map<EdgeId,EdgeId> TimingGraph::optimize_edge_layout() const {
     //Make all edges in a level be contiguous in memory
+#if defined(TATUM_USE_TBB)
+    if(nodes().size() >= MIN_PARALLEL_LEVELIZE_NODES) {
+        //Same order as below: the input edges of the nodes of each level, in level order.
+        //The position of each node's first edge is found by a prefix sum, after which
+        //the nodes are assigned their edges in parallel.
+        std::vector<NodeId> ordered_nodes;
+        ordered_nodes.reserve(nodes().size());
+        for(LevelId level_id : levels()) {
+            auto level = level_nodes(level_id);
+            ordered_nodes.insert(ordered_nodes.end(), level.begin(), level.end());
+        }
+
+        std::vector<size_t> node_first_edge(ordered_nodes.size() + 1);
+        tbb::parallel_for(size_t(0), ordered_nodes.size(), [&](size_t inode) {
+            node_first_edge[inode + 1] = node_in_edges(ordered_nodes[inode]).size();
+        });
+        for(size_t inode = 0; inode < ordered_nodes.size(); ++inode) {
+            node_first_edge[inode + 1] += node_first_edge[inode];
+        }
+
+        tatum::util::linear_map<EdgeId,EdgeId> orig_to_new_edge_id(edges().size());
+        tbb::parallel_for(size_t(0), ordered_nodes.size(), [&](size_t inode) {
+            size_t iedge = node_first_edge[inode];
+            for(EdgeId edge_id : node_in_edges(ordered_nodes[inode])) {
+                orig_to_new_edge_id[edge_id] = EdgeId(iedge++);
+            }
+        });
+
+        for(auto new_id : orig_to_new_edge_id) {
+            TATUM_ASSERT(new_id);
+        }
+        TATUM_ASSERT(node_first_edge.back() == edges().size());
+
+        return orig_to_new_edge_id;
+    }
+#endif
 
     //Determine the edges driven by each level of the graph
     std::vector<std::vector<EdgeId>> edge_levels;
@@ -530,6 +933,32 @@ tatum::util::linear_map<NodeId,NodeId> TimingGraph::optimize_node_layout() const
      */
     tatum::util::linear_map<NodeId,NodeId> orig_to_new_node_id(nodes().size());
 
+#if defined(TATUM_USE_TBB)
+    if(nodes().size() >= MIN_PARALLEL_LEVELIZE_NODES) {
+        //Same order as below, each level being renumbered in parallel from its first new id
+        std::vector<size_t> level_first_node;
+        size_t num_level_nodes = 0;
+        for(const LevelId level_id : levels()) {
+            level_first_node.push_back(num_level_nodes);
+            num_level_nodes += level_nodes(level_id).size();
+        }
+
+        tbb::parallel_for(size_t(0), level_first_node.size(), [&](size_t ilevel) {
+            size_t inode = level_first_node[ilevel];
+            for(const NodeId old_node_id : level_nodes(LevelId(ilevel))) {
+                orig_to_new_node_id[old_node_id] = NodeId(inode++);
+            }
+        });
+
+        for(auto new_id : orig_to_new_node_id) {
+            TATUM_ASSERT(new_id);
+        }
+        TATUM_ASSERT(num_level_nodes == nodes().size());
+
+        return orig_to_new_node_id;
+    }
+#endif
+
     //Determine the new order
     size_t inode = 0;
     for(const LevelId level_id : levels()) {
@@ -551,6 +980,11 @@ tatum::util::linear_map<NodeId,NodeId> TimingGraph::optimize_node_layout() const
 void TimingGraph::remap_nodes(const tatum::util::linear_map<NodeId,NodeId>& node_id_map) {
     is_levelized_ = false;
 
+    //The previous levelization refers to the old node ids
+    level_nodes_.clear();
+    level_ids_.clear();
+    modified_nodes_.clear();
+
     //Update values
     node_ids_ = clean_and_reorder_ids(node_id_map);
     node_types_ = clean_and_reorder_values(node_types_, node_id_map);
@@ -873,6 +1307,11 @@ std::vector<std::vector<NodeId>> identify_combinational_loops(const TimingGraph&
     return identify_strongly_connected_components(tg, MIN_LOOP_SCC_SIZE);
 }
 
+std::vector<std::vector<NodeId>> identify_combinational_loops(const TimingGraph& tg, TimingGraph::node_range from_nodes) {
+    constexpr size_t MIN_LOOP_SCC_SIZE = 2; //Any SCC of size >= 2 is a loop in the timing graph
+    return identify_strongly_connected_components(tg, std::vector<NodeId>(from_nodes.begin(), from_nodes.end()), MIN_LOOP_SCC_SIZE);
+}
+
 std::vector<NodeId> find_transitively_connected_nodes(const TimingGraph& tg, 
                                                       const std::vector<NodeId> through_nodes, 
                                                       size_t max_depth) {
@@ -52,6 +52,17 @@
  * and optimize_node_layout() member functions.  In the future (particularily if incremental modification
  * support is added), it may be a good idea apply these modifications automatically as needed.
  *
+ * Incremental Modification
+ * ==========================
+ * An existing (levelized) graph can be modified (e.g. after a netlist ECO) by adding, removing and
+ * disabling nodes and edges, and then re-levelized with levelize_incremental(), which only re-evaluates
+ * the levels of the nodes affected by the modifications.  Before re-levelizing, any combinational loops
+ * created by the modifications can be found with identify_combinational_loops(tg, tg.modified_nodes()),
+ * which only searches the fan-out of the modified nodes.
+ *
+ * Removed nodes and edges keep their (now invalid) IDs until compress() is called, and timing analyzers
+ * must be re-created for the modified graph.
+ *
  */
 #include <vector>
 #include <set>
@@ -175,6 +186,10 @@ class TimingGraph {
         //\returns A range containing all edges in the graph
         edge_range edges() const { return tatum::util::make_range(edge_ids_.begin(), edge_ids_.end()); }
 
+        //\returns A range containing the nodes modified (added, removed, or with edges added, removed or
+        //          disabled) since the graph was last levelized. May contain duplicates.
+        node_range modified_nodes() const { return tatum::util::make_range(modified_nodes_.begin(), modified_nodes_.end()); }
+
         //\returns A range containing all levels in the graph
         level_range levels() const { 
             TATUM_ASSERT_MSG(is_levelized_, "Timing graph must be levelized");
@@ -209,13 +224,13 @@ class TimingGraph {
 
         ///Removes a node (and it's associated edges) from the timing graph
         ///\param node_id The node to remove
-        ///\warning This will leave invalid ID references in the timing graph until compress() is called
+        ///\warning This will leave an invalid ID in nodes() until compress() is called
         ///\see add_node(), compress()
         void remove_node(const NodeId node_id);
 
         ///Removes an edge from the timing graph
         ///\param edge_id The edge to remove
-        ///\warning This will leave invalid ID references in the timing graph until compress() is called
+        ///\warning This will leave an invalid ID in edges() until compress() is called
         ///\see add_edge(), compress()
         void remove_edge(const EdgeId edge_id);
 
@@ -236,6 +251,15 @@ class TimingGraph {
         ///\post The primary outputs have been identified
         void levelize();
 
+        ///Levelizes the graph, re-evaluating only the levels of the nodes affected by the
+        ///modifications made since it was last levelized (see modified_nodes()).
+        ///Produces the same levels as levelize(), although nodes may be ordered differently
+        ///within a level. Falls back to levelize() if the graph was never levelized, or if the
+        ///modifications created a combinational loop.
+        ///\post The graph topologically ordered (i.e. the level of each node is known)
+        ///\post The primary outputs have been identified
+        void levelize_incremental();
+
         /*
          * Memory layout optimization operations
          */
@@ -264,6 +288,14 @@ class TimingGraph {
 
         void force_levelize();
 
+        ///Fills in the levels (except the last one) and primary inputs of a levelization
+        ///\returns The nodes of the last level
+        std::vector<NodeId> levelize_nodes();
+#if defined(TATUM_USE_TBB)
+        ///Parallel version of levelize_nodes(), producing exactly the same levels
+        std::vector<NodeId> levelize_nodes_parallel();
+#endif
+
         bool valid_node_id(const NodeId node_id) const;
         bool valid_edge_id(const EdgeId edge_id) const;
         bool valid_level_id(const LevelId level_id) const;
@@ -299,6 +331,7 @@ class TimingGraph {
         std::vector<NodeId> primary_inputs_; //Primary input nodes of the timing graph.
         std::vector<NodeId> logical_outputs_; //Logical output nodes of the timing graph.
         bool is_levelized_ = false; //Inidcates if the current levelization is valid
+        std::vector<NodeId> modified_nodes_; //Nodes modified since the last levelization
 
         bool allow_dangling_combinational_nodes_ = false;
 
@@ -307,6 +340,11 @@ class TimingGraph {
 //Returns the set of nodes (Strongly Connected Components) that form loops in the timing graph
 std::vector<std::vector<NodeId>> identify_combinational_loops(const TimingGraph& tg);
 
+//Returns the loops (as above) which are reachable from from_nodes. Since any loop created by
+//modifying the graph passes through a modified node, this finds the new loops (if any) after
+//incremental modifications from tg.modified_nodes(), without searching the whole graph.
+std::vector<std::vector<NodeId>> identify_combinational_loops(const TimingGraph& tg, TimingGraph::node_range from_nodes);
+
 //Returns the set of nodes transitively connected (either fanin or fanout) to nodes in through_nodes
 //up to max_depth (default infinite) hops away
 std::vector<NodeId> find_transitively_connected_nodes(const TimingGraph& tg, 
@@ -82,6 +82,10 @@ class TimingReporter {
         void report_unconstrained_hold(std::string filename, const tatum::HoldTimingAnalyzer& hold_analyzer) const;
         void report_unconstrained_hold(std::ostream& os, const tatum::HoldTimingAnalyzer& hold_analyzer) const;
 
+        //Reports a single path, as listed in the report_timing_*() reports (without its '#Path' header),
+        //so that callers can build reports incrementally
+        void report_timing_path(std::ostream& os, const TimingPath& path) const;
+
     private:
         struct PathSkew {
             NodeId launch_node;
@@ -98,8 +102,6 @@ class TimingReporter {
     private:
         void report_timing(std::ostream& os, const std::vector<TimingPath>& paths) const;
 
-        void report_timing_path(std::ostream& os, const TimingPath& path) const;
-
         void report_unconstrained(std::ostream& os, const NodeType type, const detail::TagRetriever& tag_retriever) const;
 
         void report_skew(std::ostream& os, const std::vector<SkewPath>& paths, TimingType timing_type) const;
@@ -1,4 +1,6 @@
 #pragma once
+#include <memory>
+
 #include "tatum/graph_walkers/SerialWalker.hpp"
 #include "tatum/HoldAnalysis.hpp"
 #include "tatum/analyzers/HoldTimingAnalyzer.hpp"
@@ -23,6 +25,7 @@ class FullHoldTimingAnalyzer : public HoldTimingAnalyzer {
             , delay_calculator_(delay_calculator)
             , hold_visitor_(timing_graph_.nodes().size(), timing_graph_.edges().size()) {
             validate_timing_graph_constraints(timing_graph_, timing_constraints_);
+            hold_visitor_.set_domain_reachability(std::make_shared<const DomainReachability>(timing_graph_, timing_constraints_));
 
             //Initialize profiling data
             graph_walker_.set_profiling_data("total_analysis_sec", 0.);
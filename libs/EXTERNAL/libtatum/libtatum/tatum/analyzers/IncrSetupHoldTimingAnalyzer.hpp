@@ -1,4 +1,12 @@
 #pragma once
+#include <algorithm>
+#include <limits>
+#include <memory>
+
+#ifdef TATUM_USE_TBB
+#include <tbb/concurrent_vector.h>
+#endif
+
 #include "tatum/graph_walkers/SerialWalker.hpp"
 #include "tatum/SetupHoldAnalysis.hpp"
 #include "tatum/analyzers/SetupHoldTimingAnalyzer.hpp"
@@ -12,6 +20,10 @@ namespace tatum { namespace detail {
  * This is an incremental analyzer, which will incrementally
  * update the timing graph based on edges which have been marked
  * as invalidated.
+ *
+ * With update_timing_pruned_hold() the hold analysis of the invalidated edges
+ * outside the fanin cones of the near-critical hold endpoints is deferred, and
+ * those edges are re-invalidated on the next update_timing().
  */
 template<class GraphWalker=SerialIncrWalker>
 class IncrSetupHoldTimingAnalyzer : public SetupHoldTimingAnalyzer {
@@ -23,12 +35,14 @@ class IncrSetupHoldTimingAnalyzer : public SetupHoldTimingAnalyzer {
             , delay_calculator_(delay_calculator)
             , setup_hold_visitor_(timing_graph_.nodes().size(), timing_graph_.edges().size()) {
             validate_timing_graph_constraints(timing_graph_, timing_constraints_);
+            setup_hold_visitor_.set_domain_reachability(std::make_shared<const DomainReachability>(timing_graph_, timing_constraints_));
 
             //Initialize profiling data
             graph_walker_.set_profiling_data("total_analysis_sec", 0.);
             graph_walker_.set_profiling_data("analysis_sec", 0.);
             graph_walker_.set_profiling_data("num_full_updates", 0.);
             graph_walker_.set_profiling_data("num_incr_updates", 0.);
+            graph_walker_.set_profiling_data("num_pruned_hold_updates", 0.);
         }
 
     protected:
@@ -36,6 +50,10 @@ class IncrSetupHoldTimingAnalyzer : public SetupHoldTimingAnalyzer {
         virtual void update_timing_impl() override {
             auto start_time = Clock::now();
 
+            restore_deferred_hold_edges();
+            pruned_invalidated_edges_.clear();
+            last_update_pruned_ = false;
+
             if (never_updated_) {
                 //Invalidate all edges
                 for (EdgeId edge : timing_graph_.edges()) {
@@ -68,6 +86,71 @@ class IncrSetupHoldTimingAnalyzer : public SetupHoldTimingAnalyzer {
             graph_walker_.set_profiling_data("num_incr_updates", graph_walker_.get_profiling_data("num_incr_updates") + 1);
 
             never_updated_ = false;
+
+            //The hold slacks changed, so the near-critical endpoints may have too
+            hold_cone_valid_ = false;
+        }
+
+        //Update setup timing, and hold timing only within the cones of the near-critical hold endpoints
+        virtual void update_timing_pruned_hold_impl(float hold_slack_threshold) override {
+            if (never_updated_) {
+                //Need a full hold analysis to know which endpoints are near-critical
+                update_timing_impl();
+                return;
+            }
+
+            auto start_time = Clock::now();
+
+            if (!hold_cone_valid_ || hold_cone_threshold_ != hold_slack_threshold) {
+                find_hold_cone(hold_slack_threshold);
+            }
+
+            //Hold: only the edges into the cones, the others are deferred to the next full update
+            graph_walker_.clear_invalidated_edges();
+            for (EdgeId edge : pruned_invalidated_edges_) {
+                if (in_hold_cone(timing_graph_.edge_sink_node(edge))) {
+                    graph_walker_.invalidate_edge(edge);
+                } else {
+                    defer_hold_edge(edge);
+                }
+            }
+
+            auto& hold_visitor = setup_hold_visitor_.hold_visitor();
+            graph_walker_.do_arrival_traversal(timing_graph_, timing_constraints_, delay_calculator_, hold_visitor);
+            graph_walker_.do_required_traversal(timing_graph_, timing_constraints_, delay_calculator_, hold_visitor);
+            graph_walker_.do_update_slack(timing_graph_, delay_calculator_, hold_visitor);
+
+            auto hold_modified_nodes = graph_walker_.modified_nodes();
+            pruned_modified_nodes_.assign(hold_modified_nodes.begin(), hold_modified_nodes.end());
+
+            //Setup: all the edges
+            graph_walker_.clear_invalidated_edges();
+            for (EdgeId edge : pruned_invalidated_edges_) {
+                graph_walker_.invalidate_edge(edge);
+            }
+
+            auto& setup_visitor = setup_hold_visitor_.setup_visitor();
+            graph_walker_.do_arrival_traversal(timing_graph_, timing_constraints_, delay_calculator_, setup_visitor);
+            graph_walker_.do_required_traversal(timing_graph_, timing_constraints_, delay_calculator_, setup_visitor);
+            graph_walker_.do_update_slack(timing_graph_, delay_calculator_, setup_visitor);
+
+            //Report the nodes modified by either traversal
+            auto setup_modified_nodes = graph_walker_.modified_nodes();
+            pruned_modified_nodes_.insert(pruned_modified_nodes_.end(), setup_modified_nodes.begin(), setup_modified_nodes.end());
+            std::sort(pruned_modified_nodes_.begin(), pruned_modified_nodes_.end());
+            pruned_modified_nodes_.erase(std::unique(pruned_modified_nodes_.begin(), pruned_modified_nodes_.end()), pruned_modified_nodes_.end());
+            last_update_pruned_ = true;
+
+            graph_walker_.clear_invalidated_edges();
+            pruned_invalidated_edges_.clear();
+
+            double analysis_sec = std::chrono::duration_cast<dsec>(Clock::now() - start_time).count();
+
+            //Record profiling data
+            double total_analysis_sec = analysis_sec + graph_walker_.get_profiling_data("total_analysis_sec");
+            graph_walker_.set_profiling_data("total_analysis_sec", total_analysis_sec);
+            graph_walker_.set_profiling_data("analysis_sec", analysis_sec);
+            graph_walker_.set_profiling_data("num_pruned_hold_updates", graph_walker_.get_profiling_data("num_pruned_hold_updates") + 1);
         }
 
         //Update only setup timing
@@ -87,6 +170,7 @@ class IncrSetupHoldTimingAnalyzer : public SetupHoldTimingAnalyzer {
         //Update only hold timing
         virtual void update_hold_timing_impl() override {
             TATUM_ASSERT(!never_updated_);
+            restore_deferred_hold_edges();
             auto& hold_visitor = setup_hold_visitor_.hold_visitor();
 
             //graph_walker_.do_arrival_pre_traversal(timing_graph_, timing_constraints_, hold_visitor);            
@@ -100,9 +184,15 @@ class IncrSetupHoldTimingAnalyzer : public SetupHoldTimingAnalyzer {
 
         virtual void invalidate_edge_impl(const EdgeId edge) override {
             graph_walker_.invalidate_edge(edge);
+
+            //Also recorded here, since a pruned update traverses them twice (possibly with duplicates)
+            pruned_invalidated_edges_.push_back(edge);
         }
 
         virtual node_range modified_nodes_impl() const override {
+            if (last_update_pruned_) {
+                return tatum::util::make_range(pruned_modified_nodes_.cbegin(), pruned_modified_nodes_.cend());
+            }
             return graph_walker_.modified_nodes();
         }
 
@@ -125,6 +215,64 @@ class IncrSetupHoldTimingAnalyzer : public SetupHoldTimingAnalyzer {
         TimingTags::tag_range hold_node_slacks_impl(NodeId node_id) const override { return setup_hold_visitor_.hold_node_slacks(node_id); }
 
     private:
+        //Re-invalidate the edges whose hold analysis was deferred, so the next traversal analyzes them
+        void restore_deferred_hold_edges() {
+            for (EdgeId edge : deferred_hold_edges_) {
+                graph_walker_.invalidate_edge(edge);
+            }
+            deferred_hold_edges_.clear();
+            hold_edge_deferred_.clear();
+        }
+
+        //Nodes added to the graph since the cones were found are conservatively in them
+        bool in_hold_cone(NodeId node) const {
+            return size_t(node) >= hold_cone_.size() || hold_cone_[node];
+        }
+
+        void defer_hold_edge(EdgeId edge) {
+            if (size_t(edge) >= hold_edge_deferred_.size()) {
+                hold_edge_deferred_.resize(size_t(edge) + 1, false);
+            }
+            if (hold_edge_deferred_[edge]) return;
+
+            hold_edge_deferred_[edge] = true;
+            deferred_hold_edges_.push_back(edge);
+        }
+
+        //Mark the fanin cones of the endpoints whose worst hold slack is below hold_slack_threshold
+        void find_hold_cone(float hold_slack_threshold) {
+            hold_cone_.clear();
+            hold_cone_.resize(timing_graph_.nodes().size(), false);
+
+            std::vector<NodeId> nodes_to_visit;
+            for (NodeId node : timing_graph_.logical_outputs()) {
+                float slack = std::numeric_limits<float>::infinity();
+                for (const TimingTag& tag : setup_hold_visitor_.hold_node_slacks(node)) {
+                    slack = std::min(slack, tag.time().min_value());
+                }
+                if (slack < hold_slack_threshold) {
+                    hold_cone_[node] = true;
+                    nodes_to_visit.push_back(node);
+                }
+            }
+
+            while (!nodes_to_visit.empty()) {
+                NodeId node = nodes_to_visit.back();
+                nodes_to_visit.pop_back();
+
+                for (EdgeId edge : timing_graph_.node_in_edges(node)) {
+                    NodeId src_node = timing_graph_.edge_src_node(edge);
+                    if (!hold_cone_[src_node]) {
+                        hold_cone_[src_node] = true;
+                        nodes_to_visit.push_back(src_node);
+                    }
+                }
+            }
+
+            hold_cone_threshold_ = hold_slack_threshold;
+            hold_cone_valid_ = true;
+        }
+
         const TimingGraph& timing_graph_;
         const TimingConstraints& timing_constraints_;
         const DelayCalculator& delay_calculator_;
@@ -133,6 +281,27 @@ class IncrSetupHoldTimingAnalyzer : public SetupHoldTimingAnalyzer {
 
         bool never_updated_ = true;
 
+        //Edges invalidated since the last update, as of the last pruned update
+        //(possibly with duplicates, and including those analyzed by update_setup/hold_timing())
+#ifdef TATUM_USE_TBB
+        tbb::concurrent_vector<EdgeId> pruned_invalidated_edges_;
+#else
+        std::vector<EdgeId> pruned_invalidated_edges_;
+#endif
+
+        //Invalidated edges whose hold analysis was deferred by pruned updates, and bitset for membership
+        std::vector<EdgeId> deferred_hold_edges_;
+        tatum::util::linear_map<EdgeId, bool> hold_edge_deferred_;
+
+        //Nodes in the fanin cones of the endpoints below hold_cone_threshold_ hold slack
+        tatum::util::linear_map<NodeId, bool> hold_cone_;
+        float hold_cone_threshold_ = std::numeric_limits<float>::quiet_NaN();
+        bool hold_cone_valid_ = false;
+
+        //Nodes modified by the last pruned update (either traversal)
+        std::vector<NodeId> pruned_modified_nodes_;
+        bool last_update_pruned_ = false;
+
         typedef std::chrono::duration<double> dsec;
         typedef std::chrono::high_resolution_clock Clock;
 };
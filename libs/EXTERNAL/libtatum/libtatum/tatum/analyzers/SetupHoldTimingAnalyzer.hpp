@@ -14,11 +14,23 @@ namespace tatum {
  * It implements both the SetupTimingAnalyzer and HoldTimingAnalyzer interfaces.
  */
 class SetupHoldTimingAnalyzer : public SetupTimingAnalyzer, public HoldTimingAnalyzer {
-    //Empty (all behaviour inherited)
-    //
     // Note that SetupTiminganalyzer and HoldTimingAnalyzer used virtual inheritance, so
     // there is no ambiguity when inheriting from both (there will be only one base class
     // instance).
+    public:
+        /**
+         * Update setup timing, but update hold timing only in the fanin cones of the
+         * endpoints whose hold slack was below hold_slack_threshold at the last
+         * update_timing(). Hold timing elsewhere is left as of that update: the delay
+         * changes outside of the cones are only analyzed for hold by the next
+         * update_timing().
+         *
+         * Analyzers which can not prune the hold analysis perform a full update_timing().
+         */
+        void update_timing_pruned_hold(float hold_slack_threshold) { update_timing_pruned_hold_impl(hold_slack_threshold); }
+
+    protected:
+        virtual void update_timing_pruned_hold_impl(float /*hold_slack_threshold*/) { update_timing_impl(); }
 };
 
 
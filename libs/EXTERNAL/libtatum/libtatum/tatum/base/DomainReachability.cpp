@@ -0,0 +1,120 @@
+#include "tatum/base/DomainReachability.hpp"
+
+#include "tatum/TimingGraph.hpp"
+#include "tatum/TimingConstraints.hpp"
+#include "tatum/util/tatum_assert.hpp"
+
+namespace tatum {
+
+DomainReachability::DomainReachability(const TimingGraph& tg, const TimingConstraints& tc) {
+    num_domains_ = tc.clock_domains().size();
+    if (num_domains_ <= 1) {
+        //Nothing worth pruning: leave the sets empty, so every query is conservative
+        num_domains_ = 0;
+        return;
+    }
+    num_words_ = (num_domains_ + WORD_BITS - 1) / WORD_BITS;
+
+    //The capture domains with a setup or hold constraint from each launch domain.
+    //Capture node specific constraints count for their domain pair, regardless of the node.
+    constrained_capture_domains_.resize(num_domains_ * num_words_, 0);
+    for (const auto& kv : tc.setup_constraints()) {
+        const DomainPair& domains = kv.first.domain_pair;
+        set_bit(&constrained_capture_domains_[size_t(domains.src_domain_id) * num_words_], size_t(domains.sink_domain_id));
+    }
+    for (const auto& kv : tc.hold_constraints()) {
+        const DomainPair& domains = kv.first.domain_pair;
+        set_bit(&constrained_capture_domains_[size_t(domains.src_domain_id) * num_words_], size_t(domains.sink_domain_id));
+    }
+
+    size_t num_nodes = tg.nodes().size();
+
+    //Forward pass: the clock domains reaching each node through the clock network, following
+    //the propagation of the clock tags (which stop at SOURCEs, and whose capture tags stop at SINKs)
+    std::vector<Word> clock_domains(num_nodes * num_words_, 0);
+    for (DomainId domain : tc.clock_domains()) {
+        NodeId source = tc.clock_domain_source_node(domain);
+        if (source && size_t(source) < num_nodes) { //Virtual clocks have no source
+            set_bit(&clock_domains[size_t(source) * num_words_], size_t(domain));
+        }
+    }
+    for (LevelId level : tg.levels()) {
+        for (NodeId node : tg.level_nodes(level)) {
+            const Word* node_clocks = &clock_domains[size_t(node) * num_words_];
+            for (EdgeId edge : tg.node_out_edges(node)) {
+                if (tg.edge_disabled(edge)) continue;
+
+                NodeId sink = tg.edge_sink_node(edge);
+                NodeType sink_type = tg.node_type(sink);
+                if (sink_type == NodeType::SOURCE || sink_type == NodeType::SINK) continue;
+
+                merge_bits(&clock_domains[size_t(sink) * num_words_], node_clocks);
+            }
+        }
+    }
+
+    //Backward pass: the capture domains of the endpoints in the data fanout of each node
+    //(data tags do not propagate out of clock pins)
+    node_capture_domains_.resize(num_nodes * num_words_, 0);
+
+    //Primary outputs are captured by the domains of their output constraints
+    for (DelayType delay_type : {DelayType::MAX, DelayType::MIN}) {
+        for (const auto& kv : tc.output_constraints(delay_type)) {
+            if (size_t(kv.first) < num_nodes && kv.second.domain) {
+                set_bit(&node_capture_domains_[size_t(kv.first) * num_words_], size_t(kv.second.domain));
+            }
+        }
+    }
+
+    for (LevelId level : tg.reversed_levels()) {
+        for (NodeId node : tg.level_nodes(level)) {
+            Word* node_captures = &node_capture_domains_[size_t(node) * num_words_];
+
+            NodeType node_type = tg.node_type(node);
+            if (node_type == NodeType::SINK) {
+                EdgeId clock_capture_edge = tg.node_clock_capture_edge(node);
+                if (clock_capture_edge) {
+                    //Captured by the clocks arriving at the FF clock pin
+                    NodeId clock_pin = tg.edge_src_node(clock_capture_edge);
+                    merge_bits(node_captures, &clock_domains[size_t(clock_pin) * num_words_]);
+                }
+            } else if (node_type == NodeType::CPIN) {
+                continue;
+            }
+
+            for (EdgeId edge : tg.node_out_edges(node)) {
+                if (tg.edge_disabled(edge)) continue;
+
+                merge_bits(node_captures, &node_capture_domains_[size_t(tg.edge_sink_node(edge)) * num_words_]);
+            }
+        }
+    }
+}
+
+bool DomainReachability::may_reach_constrained_capture(const NodeId node, const DomainId launch_domain) const {
+    TATUM_ASSERT_SAFE(launch_domain);
+
+    size_t inode = size_t(node);
+    size_t idomain = size_t(launch_domain);
+    if (inode * num_words_ >= node_capture_domains_.size() || idomain >= num_domains_) {
+        //Unknown node or domain (or no pruning)
+        return true;
+    }
+
+    const Word* captures = &node_capture_domains_[inode * num_words_];
+    const Word* constrained = &constrained_capture_domains_[idomain * num_words_];
+    for (size_t iword = 0; iword < num_words_; ++iword) {
+        if (captures[iword] & constrained[iword]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void DomainReachability::merge_bits(Word* to, const Word* from) const {
+    for (size_t iword = 0; iword < num_words_; ++iword) {
+        to[iword] |= from[iword];
+    }
+}
+
+} //namespace
@@ -0,0 +1,55 @@
+#ifndef TATUM_DOMAIN_REACHABILITY_HPP
+#define TATUM_DOMAIN_REACHABILITY_HPP
+#include <cstdint>
+#include <vector>
+
+#include "tatum/TimingGraphFwd.hpp"
+#include "tatum/TimingConstraintsFwd.hpp"
+
+namespace tatum {
+
+/** \class DomainReachability
+ *
+ * Records, for each node of a levelized timing graph, the set of capture clock domains
+ * of the timing endpoints (FF sinks and constrained primary outputs) in its data fanout.
+ *
+ * With many clock domains most launch/capture domain pairs are typically left unconstrained
+ * (e.g. false paths between unrelated clocks), yet the data arrival tags of every launch
+ * domain are propagated all the way to the endpoints, where only the constrained pairs get
+ * required times.  The analysis visitors use this class at the data launch points (FF
+ * sources and primary inputs) to drop the arrival tags whose launch domain has no constraint
+ * with any capture domain the node can reach, since they could never produce a slack.
+ *
+ * The sets are computed once from the timing graph and constraints at construction.
+ * Nodes added to the graph afterwards, and graphs with a single clock domain, are never
+ * pruned.  Edges disabled afterwards only shrink the true fanout, so the sets stay
+ * conservative.
+ */
+class DomainReachability {
+    public:
+        DomainReachability(const TimingGraph& tg, const TimingConstraints& tc);
+
+        ///\returns true if data launched at node by launch_domain may reach an endpoint
+        ///         whose capture domain has a setup or hold constraint with launch_domain
+        bool may_reach_constrained_capture(const NodeId node, const DomainId launch_domain) const;
+
+    private:
+        typedef uint64_t Word;
+        static constexpr size_t WORD_BITS = 64;
+
+        static void set_bit(Word* bits, size_t ibit) { bits[ibit / WORD_BITS] |= Word(1) << (ibit % WORD_BITS); }
+        void merge_bits(Word* to, const Word* from) const;
+
+        size_t num_domains_ = 0;
+        size_t num_words_ = 0; //Words per domain set
+
+        //[node*num_words_...] Capture domains reachable from each node
+        std::vector<Word> node_capture_domains_;
+
+        //[launch*num_words_...] Capture domains with a constraint from each launch domain
+        std::vector<Word> constrained_capture_domains_;
+};
+
+} //namespace
+
+#endif
@@ -42,6 +42,24 @@ std::vector<std::vector<NodeId>> identify_strongly_connected_components(const Ti
     return sccs;
 }
 
+//Returns the SCCs (exceeding min_size) reachable from from_nodes
+std::vector<std::vector<NodeId>> identify_strongly_connected_components(const TimingGraph& tg, const std::vector<NodeId>& from_nodes, size_t min_size) {
+    //Every SCC reachable from a node is found by the search started from it, so searching
+    //only from from_nodes visits just their transitive fan-out
+    int curr_index = 0;
+    std::stack<NodeId> stack;
+    tatum::util::linear_map<NodeId,NodeSccInfo> node_info(tg.nodes().size());
+    std::vector<std::vector<NodeId>> sccs;
+
+    for(NodeId node : from_nodes) {
+        if(node_info[node].index == -1) {
+            strongconnect(tg, node, curr_index, stack, node_info, sccs, min_size); 
+        }
+    }
+
+    return sccs;
+}
+
 
 void strongconnect(const TimingGraph& tg,
                    NodeId node, 
@@ -12,6 +12,10 @@ namespace tatum {
 //size >= min_size found in the timing graph
 std::vector<std::vector<NodeId>> identify_strongly_connected_components(const TimingGraph& tg, size_t min_size);
 
+//Returns the set of Strongly Connected Components with
+//size >= min_size which are reachable from from_nodes
+std::vector<std::vector<NodeId>> identify_strongly_connected_components(const TimingGraph& tg, const std::vector<NodeId>& from_nodes, size_t min_size);
+
 }
 
 #endif
@@ -1,11 +1,13 @@
 #ifndef TATUM_COMMON_ANALYSIS_VISITOR_HPP
 #define TATUM_COMMON_ANALYSIS_VISITOR_HPP
+#include <memory>
 #include "tatum/error.hpp"
 #include "tatum/TimingGraph.hpp"
 #include "tatum/TimingConstraints.hpp"
 #include "tatum/tags/TimingTags.hpp"
 #include "tatum/delay_calc/DelayCalculator.hpp"
 #include "tatum/graph_visitors/GraphVisitor.hpp"
+#include "tatum/base/DomainReachability.hpp"
 
 namespace tatum { namespace detail {
 
@@ -53,6 +55,10 @@ class CommonAnalysisVisitor : public GraphVisitor {
 
         bool do_slack_traverse_node(const TimingGraph& tg, const DelayCalculator& dc, const NodeId node) override;
 
+        ///Sets the domain reachability used to drop data arrival tags at launch points whose
+        ///launch domain can not reach a constrained capture domain (nullptr disables the pruning)
+        void set_domain_reachability(std::shared_ptr<const DomainReachability> domain_reachability) { domain_reachability_ = domain_reachability; }
+
     protected:
         AnalysisOps ops_;
 
@@ -73,6 +79,10 @@ class CommonAnalysisVisitor : public GraphVisitor {
 
         bool is_clock_data_launch_edge(const TimingGraph& tg, const EdgeId edge_id) const;
         bool is_clock_data_capture_edge(const TimingGraph& tg, const EdgeId edge_id) const;
+
+        bool should_launch_data(const NodeId node_id, const DomainId launch_domain) const;
+
+        std::shared_ptr<const DomainReachability> domain_reachability_;
 };
 
 /*
@@ -229,6 +239,13 @@ bool CommonAnalysisVisitor<AnalysisOps>::do_arrival_pre_traverse_node(const Timi
                 DomainId domain_id = tc.node_clock_domain(node_id);
                 TATUM_ASSERT(domain_id);
 
+                //The input is constrained, even if its data can not reach any capture domain
+                //constrained with its launch domain (in which case no tag is needed)
+                node_constrained = true;
+                if(!should_launch_data(node_id, domain_id)) {
+                    return node_constrained;
+                }
+
                 //The external clock may have latency
                 Time launch_source_latency = ops_.launch_source_latency(tc, domain_id);
 
@@ -246,8 +263,6 @@ bool CommonAnalysisVisitor<AnalysisOps>::do_arrival_pre_traverse_node(const Timi
                                                 TagType::DATA_ARRIVAL);
 
                 ops_.merge_arr_tags(node_id, input_tag);
-
-                node_constrained = true;
             }
         }
     }
@@ -350,6 +365,11 @@ bool CommonAnalysisVisitor<AnalysisOps>::do_arrival_traverse_edge(const TimingGr
             const Time launch_edge_delay = ops_.launch_clock_edge_delay(dc, tg, edge_id);
 
             for(const TimingTag& src_launch_clk_tag : src_launch_clk_tags) {
+                if(!should_launch_data(node_id, src_launch_clk_tag.launch_clock_domain())) {
+                    //No constrained capture domain downstream, the data tag would never get a slack
+                    continue;
+                }
+
                 //Convert clock launch into data arrival
                 TimingTag data_arr_tag = src_launch_clk_tag;
                 data_arr_tag.set_type(TagType::DATA_ARRIVAL);
@@ -703,6 +723,11 @@ bool CommonAnalysisVisitor<AnalysisOps>::should_propagate_data(const TimingGraph
     return false;
 }
 
+template<class AnalysisOps>
+bool CommonAnalysisVisitor<AnalysisOps>::should_launch_data(const NodeId node_id, const DomainId launch_domain) const {
+    return !domain_reachability_ || domain_reachability_->may_reach_constrained_capture(node_id, launch_domain);
+}
+
 template<class AnalysisOps>
 bool CommonAnalysisVisitor<AnalysisOps>::should_calculate_slack(const TimingTag& src_tag, const TimingTag& sink_tag) const {
     TATUM_ASSERT_SAFE(src_tag.type() == TagType::DATA_ARRIVAL && sink_tag.type() == TagType::DATA_REQUIRED);
@@ -9,3 +9,4 @@
 #include "graph_walkers/SerialIncrWalker.hpp"
 #include "graph_walkers/ParallelLevelizedWalker.hpp"
 #include "graph_walkers/ParallelWalker.hpp"
+#include "graph_walkers/ParallelIncrWalker.hpp"
@@ -0,0 +1,412 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+#ifdef TATUM_USE_TBB
+# include <tbb/concurrent_vector.h>
+# include <tbb/parallel_for_each.h>
+#endif
+
+#include "tatum/graph_walkers/TimingGraphWalker.hpp"
+#include "tatum/TimingGraph.hpp"
+#include "tatum/delay_calc/DelayCalculator.hpp"
+#include "tatum/graph_visitors/GraphVisitor.hpp"
+
+namespace tatum {
+
+/**
+ * A parallel graph walker which incrementally updates the timing graph
+ * based on invalidated edges.
+ *
+ * It follows the same approach as SerialIncrWalker (see there for the details
+ * of edge invalidation): the invalidated edges determine which nodes must be
+ * re-evaluated, and those are queued per-level for the arrival/required
+ * traversals. The nodes queued in each level are then processed in parallel
+ * using Thread Building Blocks (TBB), as in ParallelLevelizedWalker. Nodes
+ * which were not invalidated are skipped.
+ *
+ * Processing a node may queue its descendants (arrival traversal) or
+ * predecessors (required traversal), which are always in a level processed later.
+ * The queues are therefore only appended to by the level being processed,
+ * and all bookkeeping (queue membership, invalidated edges, modified nodes)
+ * uses atomic flags and concurrent vectors rather than locks.
+ *
+ * Edges may be invalidated concurrently (e.g. by several router threads):
+ * they are recorded in a concurrent vector and only de-duplicated when the
+ * next traversal starts.
+ *
+ * Since nodes within a level are processed in an arbitrary order, the set of
+ * modified nodes is sorted before the slack update, so that modified_nodes()
+ * is the same as with SerialIncrWalker.
+ *
+ * If TBB is not available it operates serially, and is equivalent to SerialIncrWalker.
+ *
+ * Note that this graph walker assumes that timing constraints aren't changed
+ * and so do_arrival_pre_traversal_impl() / do_required_pre_traversal_impl()
+ * should only be called once (on the first analysis)
+ */
+class ParallelIncrWalker : public TimingGraphWalker {
+    protected:
+        void invalidate_edge_impl(const EdgeId edge) override {
+            //Concurrently safe: duplicates are dropped in prepare_incr_update()
+            pending_invalidated_edges_.push_back(edge);
+        }
+
+        void clear_invalidated_edges_impl() override {
+            for (EdgeId edge : invalidated_edges_) {
+                edge_invalidated_[size_t(edge)] = false;
+            }
+            invalidated_edges_.clear();
+            pending_invalidated_edges_.clear();
+        }
+
+        node_range modified_nodes_impl() const override {
+            return tatum::util::make_range(nodes_modified_.cbegin(), nodes_modified_.cend());
+        }
+
+        void do_arrival_pre_traversal_impl(const TimingGraph& tg, const TimingConstraints& tc, GraphVisitor& visitor) override {
+            LevelId first_level = *tg.levels().begin();
+            auto nodes = tg.level_nodes(first_level);
+
+            std::atomic<size_t> num_unconstrained(0);
+            for_each(nodes.begin(), nodes.end(), [&](NodeId node_id) {
+                bool constrained = visitor.do_arrival_pre_traverse_node(tg, tc, node_id);
+
+                if(!constrained) {
+                    num_unconstrained.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+
+            num_unconstrained_startpoints_ = num_unconstrained;
+        }
+
+        void do_required_pre_traversal_impl(const TimingGraph& tg, const TimingConstraints& tc, GraphVisitor& visitor) override {
+            const auto& po = tg.logical_outputs();
+
+            std::atomic<size_t> num_unconstrained(0);
+            for_each(po.begin(), po.end(), [&](NodeId node_id) {
+                bool constrained = visitor.do_required_pre_traverse_node(tg, tc, node_id);
+
+                if(!constrained) {
+                    num_unconstrained.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+
+            num_unconstrained_endpoints_ = num_unconstrained;
+        }
+
+        void do_arrival_traversal_impl(const TimingGraph& tg, const TimingConstraints& tc, const DelayCalculator& dc, GraphVisitor& visitor) override {
+            prepare_incr_update(tg);
+
+            //The maximum level may grow as nodes are processed (but only beyond the current level)
+            for(int level_idx = incr_arr_update_.min_level; level_idx <= incr_arr_update_.max_level; ++level_idx) {
+                auto& level_nodes = incr_arr_update_.nodes_to_process[level_idx];
+                if (level_nodes.empty()) continue;
+
+                //Sorting the level nodes tends to help memory locality, since the
+                //timing graph is laid out in traversal order
+                std::sort(level_nodes.begin(), level_nodes.end());
+
+                for_each(level_nodes.begin(), level_nodes.end(), [&](NodeId node) {
+                    invalidate_node_for_arrival_traversal(node, tg, visitor);
+
+                    bool node_updated = visitor.do_arrival_traverse_node(tg, tc, dc, node);
+
+                    if (node_updated) {
+                        //Record that this node was updated, for later efficient slack update
+                        enqueue_modified_node(node);
+
+                        //Queue this node's downstream dependencies for updating
+                        for (EdgeId edge : tg.node_out_edges(node)) {
+                            NodeId snk_node = tg.edge_sink_node(edge);
+                            enqueue_arr_node(tg, snk_node, edge);
+                        }
+                    }
+                });
+            }
+        }
+
+        void do_required_traversal_impl(const TimingGraph& tg, const TimingConstraints& tc, const DelayCalculator& dc, GraphVisitor& visitor) override {
+            //The minimum level may shrink as nodes are processed (but only below the current level)
+            for(int level_idx = incr_req_update_.max_level; level_idx >= incr_req_update_.min_level; --level_idx) {
+                auto& level_nodes = incr_req_update_.nodes_to_process[level_idx];
+                if (level_nodes.empty()) continue;
+
+                std::sort(level_nodes.begin(), level_nodes.end());
+
+                for_each(level_nodes.begin(), level_nodes.end(), [&](NodeId node) {
+                    invalidate_node_for_required_traversal(node, tg, visitor);
+                    bool node_updated = visitor.do_required_traverse_node(tg, tc, dc, node);
+
+                    if (node_updated) {
+                        //Record that this node was updated, for later efficient slack update
+                        enqueue_modified_node(node);
+
+                        //Queue this node's upstream dependencies for updating
+                        for (EdgeId edge : tg.node_in_edges(node)) {
+                            NodeId src_node = tg.edge_src_node(edge);
+
+                            enqueue_req_node(tg, src_node, edge);
+                        }
+                    }
+                });
+            }
+        }
+
+        void do_update_slack_impl(const TimingGraph& tg, const DelayCalculator& dc, GraphVisitor& visitor) override {
+            nodes_modified_.assign(concurrent_nodes_modified_.begin(), concurrent_nodes_modified_.end());
+            std::sort(nodes_modified_.begin(), nodes_modified_.end());
+
+            for_each(nodes_modified_.begin(), nodes_modified_.end(), [&](NodeId node) {
+#ifdef TATUM_CALCULATE_EDGE_SLACKS
+                for (EdgeId edge : tg.node_in_edges(node)) {
+                    visitor.do_reset_edge(edge);
+                }
+#endif
+                visitor.do_reset_node_slack_tags(node);
+
+                visitor.do_slack_traverse_node(tg, dc, node);
+            });
+        }
+
+        void do_reset_impl(const TimingGraph& tg, GraphVisitor& visitor) override {
+            auto nodes = tg.nodes();
+            for_each(nodes.begin(), nodes.end(), [&](NodeId node_id) {
+                visitor.do_reset_node(node_id);
+            });
+#ifdef TATUM_CALCULATE_EDGE_SLACKS
+            auto edges = tg.edges();
+            for_each(edges.begin(), edges.end(), [&](EdgeId edge_id) {
+                visitor.do_reset_edge(edge_id);
+            });
+#endif
+        }
+
+        size_t num_unconstrained_startpoints_impl() const override { return num_unconstrained_startpoints_; }
+        size_t num_unconstrained_endpoints_impl() const override { return num_unconstrained_endpoints_; }
+
+    private:
+#ifdef TATUM_USE_TBB
+        template<class T>
+        using concurrent_vector = tbb::concurrent_vector<T>;
+#else
+        template<class T>
+        using concurrent_vector = std::vector<T>;
+#endif
+
+        ///Applies func to each element of [first, last), in parallel if TBB is available
+        template<class Iter, class Func>
+        static void for_each(Iter first, Iter last, const Func& func) {
+#ifdef TATUM_USE_TBB
+            tbb::parallel_for_each(first, last, func);
+#else
+            std::for_each(first, last, func);
+#endif
+        }
+
+        ///A flag per element, which can be set concurrently
+        class AtomicFlags {
+            public:
+                void resize(size_t size) {
+                    if (size == size_) return;
+                    flags_ = std::make_unique<std::atomic<bool>[]>(size);
+                    for (size_t i = 0; i < size; ++i) {
+                        flags_[i].store(false, std::memory_order_relaxed);
+                    }
+                    size_ = size;
+                }
+
+                bool test(size_t i) const { return flags_[i].load(std::memory_order_relaxed); }
+
+                ///Sets flag i, and returns whether it was already set
+                bool test_and_set(size_t i) {
+                    //Cheap check first, to avoid contended writes on frequently visited flags
+                    if (test(i)) return true;
+                    return flags_[i].exchange(true, std::memory_order_relaxed);
+                }
+
+                std::atomic<bool>& operator[](size_t i) { return flags_[i]; }
+
+            private:
+                std::unique_ptr<std::atomic<bool>[]> flags_;
+                size_t size_ = 0;
+        };
+
+        bool is_invalidated(EdgeId edge) const {
+            return edge_invalidated_.test(size_t(edge));
+        }
+
+        bool not_invalidated(EdgeId edge) const {
+            return !is_invalidated(edge);
+        }
+
+        void mark_invalidated(EdgeId edge) {
+            if (edge_invalidated_.test_and_set(size_t(edge))) return;
+
+            invalidated_edges_.push_back(edge);
+        }
+
+        void prepare_incr_update(const TimingGraph& tg) {
+            //Reset incremental traversal tracking data
+            clear_modified();
+            edge_invalidated_.resize(tg.edges().size());
+            node_is_modified_.resize(tg.nodes().size());
+            incr_arr_update_.reset(tg);
+            incr_req_update_.reset(tg);
+
+            //Process the externally invalidated edges to prepare for the incremental traversal
+            for_each(pending_invalidated_edges_.begin(), pending_invalidated_edges_.end(), [&](EdgeId edge) {
+                NodeId snk_node = tg.edge_sink_node(edge);
+                enqueue_arr_node(tg, snk_node, edge);
+
+                NodeId src_node = tg.edge_src_node(edge);
+                enqueue_req_node(tg, src_node, edge);
+            });
+            pending_invalidated_edges_.clear();
+        }
+
+        //Enqueues a node for arrival time processing which was invalidated by invalidated_edge
+        void enqueue_arr_node(const TimingGraph& tg, NodeId node, EdgeId invalidated_edge) {
+            mark_invalidated(invalidated_edge);
+            incr_arr_update_.enqueue_node(tg, node);
+        }
+
+        //Enqueues a node for required time processing which was invalidated by invalidated_edge
+        void enqueue_req_node(const TimingGraph& tg, NodeId node, EdgeId invalidated_edge) {
+            mark_invalidated(invalidated_edge);
+            incr_req_update_.enqueue_node(tg, node);
+        }
+
+        //Record the specified node as having been modified
+        void enqueue_modified_node(const NodeId node) {
+            if (node_is_modified_.test_and_set(size_t(node))) return;
+
+            concurrent_nodes_modified_.push_back(node);
+        }
+
+        void clear_modified() {
+            for (NodeId node : concurrent_nodes_modified_) {
+                node_is_modified_[size_t(node)] = false;
+            }
+            concurrent_nodes_modified_.clear();
+            nodes_modified_.clear();
+        }
+
+        void invalidate_node_for_arrival_traversal(const NodeId node, const TimingGraph& tg, GraphVisitor& visitor) {
+#ifdef TATUM_INCR_BLOCK_INVALIDATION
+            visitor.do_reset_node_arrival_tags(node);
+#else
+            //Edge invalidation (see SerialIncrWalker::invalidate_node_for_arrival_traversal())
+            for (EdgeId edge : tg.node_in_edges(node)) {
+                if (not_invalidated(edge)) continue;
+
+                NodeId src_node = tg.edge_src_node(edge);
+                visitor.do_reset_node_arrival_tags_from_origin(node, /*origin=*/src_node);
+
+                EdgeType edge_type = tg.edge_type(edge);
+                if (edge_type == EdgeType::PRIMITIVE_CLOCK_CAPTURE) {
+                    //Clock capture sets the data required times of the sink during the
+                    //arrival traversal: invalidate them, and queue the sink's predecessors
+                    //for the required traversal (which doesn't update the sink itself)
+                    visitor.do_reset_node_required_tags(node);
+
+                    for (EdgeId sink_in_edge : tg.node_in_edges(node)) {
+                        NodeId sink_src_node = tg.edge_src_node(sink_in_edge);
+                        enqueue_req_node(tg, sink_src_node, sink_in_edge);
+                    }
+                } else if (edge_type == EdgeType::PRIMITIVE_CLOCK_LAUNCH) {
+                    //On propagating to a SOURCE node, CLOCK_LAUNCH becomes DATA_ARRIVAL
+                    visitor.do_reset_node_arrival_tags(node);
+                }
+            }
+#endif
+        }
+
+        void invalidate_node_for_required_traversal(const NodeId node, const TimingGraph& tg, GraphVisitor& visitor) {
+#ifdef TATUM_INCR_BLOCK_INVALIDATION
+            visitor.do_reset_node_required_tags(node);
+#else
+            for (EdgeId edge : tg.node_out_edges(node)) {
+                if (not_invalidated(edge)) continue;
+
+                NodeId snk_node = tg.edge_sink_node(edge);
+                visitor.do_reset_node_required_tags_from_origin(node, /*origin=*/snk_node);
+            }
+#endif
+        }
+
+        /*
+         * Helper struct to record incremental traversal information.
+         * Nodes may be enqueued concurrently.
+         */
+        struct t_incr_traversal_update {
+            public:
+                //The nodes per-level which need to be updated/processed
+                std::vector<concurrent_vector<NodeId>> nodes_to_process;
+
+                //The range of levels which need to be updated
+                std::atomic<int> min_level{0};
+                std::atomic<int> max_level{0};
+
+                void enqueue_node(const TimingGraph& tg, NodeId node) {
+                    if (node_is_enqueued.test_and_set(size_t(node))) return;
+
+                    int level = size_t(tg.node_level(node));
+
+                    nodes_to_process[level].push_back(node);
+
+                    int curr_min = min_level.load(std::memory_order_relaxed);
+                    while (level < curr_min && !min_level.compare_exchange_weak(curr_min, level, std::memory_order_relaxed)) {
+                    }
+                    int curr_max = max_level.load(std::memory_order_relaxed);
+                    while (level > curr_max && !max_level.compare_exchange_weak(curr_max, level, std::memory_order_relaxed)) {
+                    }
+                }
+
+                //Clear the queues of the previous update (only the levels which were used),
+                //and size the lookups for tg
+                void reset(const TimingGraph& tg) {
+                    if (nodes_to_process.size() != tg.levels().size()) {
+                        nodes_to_process = std::vector<concurrent_vector<NodeId>>(tg.levels().size());
+                    } else {
+                        for (int level = min_level; level <= max_level; ++level) {
+                            for (NodeId node : nodes_to_process[level]) {
+                                node_is_enqueued[size_t(node)] = false;
+                            }
+                            nodes_to_process[level].clear();
+                        }
+                    }
+                    node_is_enqueued.resize(tg.nodes().size());
+
+                    min_level = int(size_t(*(tg.levels().end() - 1)));
+                    max_level = int(size_t(*tg.levels().begin()));
+                }
+
+            private:
+                //Bitset to record whether a node has already been enqueued
+                AtomicFlags node_is_enqueued;
+        };
+
+        //State info about the incremental arr/req updates
+        t_incr_traversal_update incr_arr_update_;
+        t_incr_traversal_update incr_req_update_;
+
+        //Edges invalidated through invalidate_edge() since the last traversal (possibly with duplicates)
+        concurrent_vector<EdgeId> pending_invalidated_edges_;
+
+        //Invalidated edges of the current update, and bitset for membership
+        concurrent_vector<EdgeId> invalidated_edges_;
+        AtomicFlags edge_invalidated_;
+
+        //Nodes which have been modified during timing update, and bitset for membership.
+        //They are collected concurrently, and copied (sorted) to nodes_modified_ for the slack update
+        concurrent_vector<NodeId> concurrent_nodes_modified_;
+        std::vector<NodeId> nodes_modified_;
+        AtomicFlags node_is_modified_;
+
+        size_t num_unconstrained_startpoints_ = 0;
+        size_t num_unconstrained_endpoints_ = 0;
+};
+
+} //namepsace
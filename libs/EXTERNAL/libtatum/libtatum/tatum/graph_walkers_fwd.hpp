@@ -4,10 +4,14 @@ namespace tatum {
 
 class SerialWalker;
 
+class SerialIncrWalker;
+
 class ParallelLevelizedWalker;
 
 ///The default parallel graph walker
 using ParallelWalker = ParallelLevelizedWalker;
 
+class ParallelIncrWalker;
+
 } //namespace
 
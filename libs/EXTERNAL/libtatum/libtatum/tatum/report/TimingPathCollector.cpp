@@ -3,8 +3,13 @@
 #include "tatum/report/TimingPathCollector.hpp"
 #include "tatum/report/TimingReportTagRetriever.hpp"
 #include "tatum/report/timing_path_tracing.hpp"
+#include <algorithm>
 #include <map>
 
+#if defined(TATUM_USE_TBB)
+# include <tbb/parallel_for.h>
+#endif
+
 namespace tatum {
 
 namespace detail {
@@ -33,26 +38,36 @@ std::vector<TimingPath> collect_worst_timing_paths(const TimingGraph& timing_gra
         }
     }
 
-    //Sort in ascending slack order so most negative slacks are first
+    //Select the npaths most critical end-points, sorted in ascending slack order so most
+    //negative slacks are first. Ties are broken by node and domains, so the order does
+    //not depend on the selection algorithm.
     auto ascending_slack_order = [](const TagNode& lhs, const TagNode& rhs) {
-        return lhs.tag.time() < rhs.tag.time();
+        if (lhs.tag.time() < rhs.tag.time()) return true;
+        if (rhs.tag.time() < lhs.tag.time()) return false;
+        if (lhs.node != rhs.node) return lhs.node < rhs.node;
+        if (lhs.tag.launch_clock_domain() != rhs.tag.launch_clock_domain()) return lhs.tag.launch_clock_domain() < rhs.tag.launch_clock_domain();
+        return lhs.tag.capture_clock_domain() < rhs.tag.capture_clock_domain();
     };
-    std::sort(tags_and_sinks.begin(), tags_and_sinks.end(), ascending_slack_order);
-
+    size_t num_paths = std::min(npaths, tags_and_sinks.size());
+    std::partial_sort(tags_and_sinks.begin(), tags_and_sinks.begin() + num_paths, tags_and_sinks.end(), ascending_slack_order);
 
-    //Trace the paths for each tag/node pair
-    // The the map will sort the nodes and tags from worst to best slack (i.e. ascending slack order),
-    // so the first pair is the most critical end-point
-    for(const auto& tag_node : tags_and_sinks) {
-        NodeId sink_node = tag_node.node;
-        TimingTag sink_tag = tag_node.tag;
+    //Trace the paths for each tag/node pair. Each path is traced independently
+    //(only reading the graph and tags), so they can be traced in parallel
+    paths.resize(num_paths);
+    auto trace_end_point_path = [&](size_t ipath) {
+        NodeId sink_node = tags_and_sinks[ipath].node;
+        TimingTag sink_tag = tags_and_sinks[ipath].tag;
 
-        TimingPath path = detail::trace_path(timing_graph, tag_retriever, sink_tag.launch_clock_domain(), sink_tag.capture_clock_domain(), sink_node); 
-
-        paths.push_back(path);
+        paths[ipath] = detail::trace_path(timing_graph, tag_retriever, sink_tag.launch_clock_domain(), sink_tag.capture_clock_domain(), sink_node);
+    };
 
-        if(paths.size() >= npaths) break;
+#if defined(TATUM_USE_TBB)
+    tbb::parallel_for(size_t(0), num_paths, trace_end_point_path);
+#else
+    for (size_t ipath = 0; ipath < num_paths; ++ipath) {
+        trace_end_point_path(ipath);
     }
+#endif
 
     return paths;
 }
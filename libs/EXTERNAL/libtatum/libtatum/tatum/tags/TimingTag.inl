@@ -60,6 +60,43 @@ inline bool TimingTag::update(const Time& new_time, const NodeId origin, const T
     return true; //Modified
 }
 
+#if TIME_VEC_WIDTH > 1
+inline bool TimingTag::max(const Time& new_time, const NodeId origin, const TimingTag& base_tag) {
+    if(!time().valid()) {
+        //No previous valid value existed
+        return update(new_time, origin, base_tag);
+    }
+
+    //Each lane is maxed independently, while the origin node
+    //follows the first lane (used for path tracing)
+    Time max_time = time();
+    max_time.max(new_time);
+    if(max_time == time()) {
+        return false; //No lane increased
+    }
+
+    NodeId max_origin = (new_time > time()) ? origin : origin_node();
+    return update(max_time, max_origin, base_tag);
+}
+
+inline bool TimingTag::min(const Time& new_time, const NodeId origin, const TimingTag& base_tag) {
+    if(!time().valid()) {
+        //No previous valid value existed
+        return update(new_time, origin, base_tag);
+    }
+
+    //Each lane is minned independently, while the origin node
+    //follows the first lane (used for path tracing)
+    Time min_time = time();
+    min_time.min(new_time);
+    if(min_time == time()) {
+        return false; //No lane decreased
+    }
+
+    NodeId min_origin = (new_time < time()) ? origin : origin_node();
+    return update(min_time, min_origin, base_tag);
+}
+#else //Scalar case (TIME_VEC_WIDTH == 1)
 inline bool TimingTag::max(const Time& new_time, const NodeId origin, const TimingTag& base_tag) {
     bool modified = false;
 
@@ -86,6 +123,7 @@ inline bool TimingTag::min(const Time& new_time, const NodeId origin, const Timi
 
     return modified;
 }
+#endif //TIME_VEC_WIDTH
 
 inline bool operator==(const TimingTag& lhs, const TimingTag& rhs) {
     return std::tie(lhs.time_, lhs.origin_node_, lhs.launch_clock_domain_, lhs.capture_clock_domain_, lhs.type_) 
@@ -24,6 +24,12 @@ namespace tatum {
  *
  * Note that to allow efficient iteration of tag ranges (by type) we ensure that tags of the
  * same type are adjacent in the storage vector (i.e. the vector is sorted by type)
+ *
+ * The tags are stored within the TimingTags object itself while they fit (INLINE_CAPACITY, which
+ * covers the arrival/required or launch/capture tag pair of a single clock domain), and only moved
+ * to a separately allocated array once they outgrow it (e.g. for nodes seeing several clock domains).
+ * Since the analyzers keep the TimingTags of all nodes in a single array, the tags of most nodes
+ * are then stored contiguously, and no allocation is required per node.
  */
 class TimingTags {
     public:
@@ -31,8 +37,8 @@ class TimingTags {
         class Iterator;
     private:
         //In practice the vast majority of nodes have only a handful of tags,
-        //so we reserve space for some to avoid costly memory allocations
-        constexpr static size_t DEFAULT_TAGS_TO_RESERVE = 3;
+        //so we store that many in the object itself to avoid costly memory allocations
+        constexpr static size_t INLINE_CAPACITY = 2;
         constexpr static size_t GROWTH_FACTOR = 2;
 
     public:
@@ -46,11 +52,11 @@ class TimingTags {
     public:
 
         //Constructors
-        TimingTags(size_t num_reserve=DEFAULT_TAGS_TO_RESERVE);
+        TimingTags(size_t num_reserve=INLINE_CAPACITY);
         TimingTags(const TimingTags&);
         TimingTags(TimingTags&&);
         TimingTags& operator=(TimingTags);
-        ~TimingTags() = default;
+        ~TimingTags();
         friend void swap(TimingTags& lhs, TimingTags& rhs);
 
         /*
@@ -164,6 +170,13 @@ class TimingTags {
 
         size_t capacity() const;
 
+        ///\returns true if the tags are stored in the object itself, false if in a separate allocation
+        bool is_inline() const;
+
+        ///\returns A pointer to the first tag of the storage
+        TimingTag* data();
+        const TimingTag* data() const;
+
         ///Finds a timing tag in the current set which matches tag
         ///\returns A pair of bool and iterator. 
         //          The bool is true if it is valid for iterator to be processed.
@@ -190,8 +203,9 @@ class TimingTags {
 
     private:
         //We don't expect many tags in a node so unsigned short's/unsigned char's
-        //should be more than sufficient. This also allows the class
-        //to be packed down to 16 bytes (8 for counters, 8 for pointer)
+        //should be more than sufficient. This also allows the counters to be
+        //packed down to 8 bytes, so the class is only 8 bytes larger than its
+        //inline tags (40 bytes in total with the default TimingTag layout)
         //
         //In its current configuration we can store at most:
         //  65536           total tags (size_ and capacity_)
@@ -201,12 +215,19 @@ class TimingTags {
         //  256             data required tags (num_data_required_tags_)
         //  (65536 - 4*256) slack tags (size_ - num_*)
         unsigned short size_ = 0;
-        unsigned short capacity_ = 0;
+        unsigned short capacity_ = INLINE_CAPACITY; //Never less than INLINE_CAPACITY, the tags are inline iff equal
         unsigned char num_clock_launch_tags_ = 0;
         unsigned char num_clock_capture_tags_ = 0;
         unsigned char num_data_arrival_tags_ = 0;
         unsigned char num_data_required_tags_ = 0;
-        std::unique_ptr<TimingTag[]> tags_;
+
+        //The tags themselves (while they fit), or the array they are allocated in.
+        //Tags are plain data, so either can be copied (or swapped) bytewise
+        union Storage {
+            alignas(TimingTag) unsigned char inline_tags[INLINE_CAPACITY * sizeof(TimingTag)];
+            TimingTag* heap_tags;
+        };
+        Storage storage_;
 
 };
 
@@ -66,6 +66,9 @@ struct Args {
     //Number of serial incremental runs to perform
     size_t num_serial_incr_runs = 10;
 
+    //Number of parallel incremental runs to perform
+    size_t num_parallel_incr_runs = 10;
+
     //What percentange of edges have delay changes
     //for each serial incremental run
     float edge_change_prob = 0.01;
@@ -151,6 +154,8 @@ void usage(std::string prog) {
     cout << "                                               (default " << default_args.num_serial_runs << ")\n";
     cout << "    --num_serial_incr NUM_SERIAL_INCR_RUNS:    Number of serial incremental runs to perform.\n";
     cout << "                                               (default " << default_args.num_serial_incr_runs << ")\n";
+    cout << "    --num_parallel_incr NUM_PARALLEL_INCR_RUNS:Number of parallel incremental runs to perform.\n";
+    cout << "                                               (default " << default_args.num_parallel_incr_runs << ")\n";
     cout << "    --num_parallel NUM_PARALLEL_RUNS:          Number of serial runs to perform.\n";
     cout << "                                               (default " << default_args.num_parallel_runs << ")\n";
     cout << "    --edge_change_prob EDGE_CHANGE_PROB:       Probability of an edge delay changing in a serial incremental run\n";
@@ -227,6 +232,8 @@ Args parse_args(int argc, char** argv) {
                     args.num_serial_runs = arg_val;
                 } else if (argv[i] == std::string("--num_serial_incr")) { 
                     args.num_serial_incr_runs = arg_val;
+                } else if (argv[i] == std::string("--num_parallel_incr")) { 
+                    args.num_parallel_incr_runs = arg_val;
                 } else if (argv[i] == std::string("--num_parallel")) { 
                     args.num_parallel_runs = arg_val;
                 } else if (argv[i] == std::string("--edge_change_prob")) { 
@@ -555,6 +562,7 @@ int main(int argc, char** argv) {
 
     std::cout << endl;
 
+    std::map<std::string,std::vector<double>> serial_incr_prof_data;
     if (args.num_serial_incr_runs) {
 
         std::shared_ptr<tatum::TimingAnalyzer> serial_incr_analyzer;
@@ -573,7 +581,6 @@ int main(int argc, char** argv) {
         auto serial_incr_hold_analyzer = std::dynamic_pointer_cast<tatum::HoldTimingAnalyzer>(serial_incr_analyzer);
 
         float serial_incr_verify_time = 0;
-        std::map<std::string,std::vector<double>> serial_incr_prof_data;
         {
             cout << "Running SerialIncr Analysis " << args.num_serial_incr_runs << " times" << endl;
 
@@ -639,6 +646,78 @@ int main(int argc, char** argv) {
         cout << endl << "Net SerialIncr Analysis elapsed time: " << serial_incr_analyzer->get_profiling_data("total_analysis_sec") << " sec over " << serial_incr_analyzer->get_profiling_data("num_full_updates") << " full updates" << endl;
     }
 
+    if (args.num_parallel_incr_runs) {
+        std::shared_ptr<tatum::TimingAnalyzer> parallel_incr_analyzer;
+        if (args.analysis_type == "setuphold") {
+            parallel_incr_analyzer = tatum::AnalyzerFactory<tatum::SetupHoldAnalysis,tatum::ParallelIncrWalker>::make(*timing_graph, *timing_constraints, *delay_calculator);
+        } else if (args.analysis_type == "setup") {
+            parallel_incr_analyzer = tatum::AnalyzerFactory<tatum::SetupAnalysis,tatum::ParallelIncrWalker>::make(*timing_graph, *timing_constraints, *delay_calculator);
+        } else if (args.analysis_type == "hold") {
+            parallel_incr_analyzer = tatum::AnalyzerFactory<tatum::HoldAnalysis,tatum::ParallelIncrWalker>::make(*timing_graph, *timing_constraints, *delay_calculator);
+        } else {
+            std::stringstream ss;
+            ss << "Unrecognized analysis type '" << args.analysis_type << "'";
+            cmd_error(argv[0], ss.str());
+        }
+
+        float parallel_incr_verify_time = 0;
+        std::map<std::string,std::vector<double>> parallel_incr_prof_data;
+        {
+            cout << "Running ParallelIncr Analysis " << args.num_parallel_incr_runs << " times" << endl;
+
+            //Analyze (the same sequence of edges is changed as for SerialIncr, since
+            //profile_incr() always seeds its random number generator the same way)
+            bool equivalent = profile_incr(args.num_parallel_incr_runs,
+                                           args.edge_change_prob,
+                                           args.verify,
+                                           *timing_graph,
+                                           parallel_incr_analyzer,
+                                           serial_analyzer,
+                                           *delay_calculator,
+                                           parallel_incr_prof_data);
+
+            if(!equivalent) {
+                cout << "Verification failed!\n";
+                exit_code = 1;
+            }
+
+            parallel_incr_verify_time += std::accumulate(parallel_incr_prof_data["verify_sec"].begin(), parallel_incr_prof_data["verify_sec"].end(), 0.);
+
+            cout << endl;
+            cout << "ParallelIncr Analysis took " << std::setprecision(6) << std::setw(6) << arithmean_skip_first(parallel_incr_prof_data["analysis_sec"])*args.num_parallel_incr_runs << " sec";
+            if(parallel_incr_prof_data["analysis_sec"].size() > 0) {
+                cout << " AVG: " << arithmean_skip_first(parallel_incr_prof_data["analysis_sec"]);
+                cout << " Median: " << median_skip_first(parallel_incr_prof_data["analysis_sec"]);
+                cout << " Min: " << *std::min_element(parallel_incr_prof_data["analysis_sec"].begin(), parallel_incr_prof_data["analysis_sec"].end());
+                cout << " Max: " << *std::max_element(parallel_incr_prof_data["analysis_sec"].begin(), parallel_incr_prof_data["analysis_sec"].end());
+            }
+            cout << endl;
+
+            cout << "\tArr     traversal Median: " << std::setprecision(6) << std::setw(6) << median_skip_first(parallel_incr_prof_data["arrival_traversal_sec"]) << " s";
+            cout << " (" << std::setprecision(2) << median_skip_first(parallel_incr_prof_data["arrival_traversal_sec"])/median_skip_first(parallel_incr_prof_data["analysis_sec"]) << ")" << endl;
+
+            cout << "\tReq     traversal Median: " << std::setprecision(6) << std::setw(6) << median_skip_first(parallel_incr_prof_data["required_traversal_sec"]) << " s";
+            cout << " (" << std::setprecision(2) << median_skip_first(parallel_incr_prof_data["required_traversal_sec"])/median_skip_first(parallel_incr_prof_data["analysis_sec"]) << ")" << endl;
+
+            cout << "\tUpdate slack      Median: " << std::setprecision(6) << std::setw(6) << median_skip_first(parallel_incr_prof_data["update_slack_sec"]) << " s";
+            cout << " (" << std::setprecision(2) << median_skip_first(parallel_incr_prof_data["update_slack_sec"])/median_skip_first(parallel_incr_prof_data["analysis_sec"]) << ")" << endl;
+
+            cout << "Verifying ParallelIncr Analysis took: " <<  parallel_incr_verify_time<< " sec" << endl;
+        }
+        cout << endl;
+
+        cout << "ParallelIncr Speed-Up: " << std::fixed << median(parallel_incr_prof_data["ref_analysis_sec"]) / median(parallel_incr_prof_data["analysis_sec"]) << "x" << endl;
+        cout << "\t    Arr-traversal: " << std::fixed << median(parallel_incr_prof_data["ref_arrival_traversal_sec"]) / median(parallel_incr_prof_data["arrival_traversal_sec"]) << "x" << endl;
+        cout << "\t    Req-traversal: " << std::fixed << median(parallel_incr_prof_data["ref_required_traversal_sec"]) / median(parallel_incr_prof_data["required_traversal_sec"]) << "x" << endl;
+        cout << "\t     Update-slack: " << std::fixed << median(parallel_incr_prof_data["ref_update_slack_sec"]) / median(parallel_incr_prof_data["update_slack_sec"]) << "x" << endl;
+        if (!serial_incr_prof_data["analysis_sec"].empty()) {
+            cout << "ParallelIncr Speed-Up over SerialIncr: " << std::fixed << median_skip_first(serial_incr_prof_data["analysis_sec"]) / median_skip_first(parallel_incr_prof_data["analysis_sec"]) << "x" << endl;
+        }
+        cout << endl;
+
+        cout << endl << "Net ParallelIncr Analysis elapsed time: " << parallel_incr_analyzer->get_profiling_data("total_analysis_sec") << " sec over " << parallel_incr_analyzer->get_profiling_data("num_full_updates") << " full updates" << endl;
+    }
+
     if (args.num_parallel_runs) {
         std::shared_ptr<tatum::TimingAnalyzer> parallel_analyzer;
         if (args.analysis_type == "setuphold") {
@@ -314,7 +314,6 @@ static void free_pb_graph(t_pb_graph_node* pb_graph_node) {
             if (pb_graph_node->input_pins[i][j].parent_pin_class)
                 delete[] pb_graph_node->input_pins[i][j].parent_pin_class;
         }
-        delete[] pb_graph_node->input_pins[i];
     }
     for (i = 0; i < pb_graph_node->num_output_ports; i++) {
         for (j = 0; j < pb_graph_node->num_output_pins[i]; j++) {
@@ -331,16 +330,16 @@ static void free_pb_graph(t_pb_graph_node* pb_graph_node) {
             if (pb_graph_node->output_pins[i][j].num_connectable_primitive_input_pins)
                 delete[] pb_graph_node->output_pins[i][j].num_connectable_primitive_input_pins;
         }
-        delete[] pb_graph_node->output_pins[i];
     }
     for (i = 0; i < pb_graph_node->num_clock_ports; i++) {
         for (j = 0; j < pb_graph_node->num_clock_pins[i]; j++) {
             if (pb_graph_node->clock_pins[i][j].parent_pin_class)
                 delete[] pb_graph_node->clock_pins[i][j].parent_pin_class;
         }
-        delete[] pb_graph_node->clock_pins[i];
     }
 
+    /* the pins of all ports are in a single array */
+    delete[] pb_graph_node->pins;
     delete[] pb_graph_node->input_pins;
     delete[] pb_graph_node->output_pins;
     delete[] pb_graph_node->clock_pins;
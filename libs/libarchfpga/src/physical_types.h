@@ -920,6 +920,13 @@ struct t_physical_tile_port {
  *
  * A logical block must correspond to at least one physical tile.
  */
+/** A connection from a pb_graph_pin, through one of its output edges, to a sink pin of that edge */
+struct t_pb_graph_pin_fanout {
+    uint32_t sink_pin;      ///<pin_count_in_cluster of the sink pin
+    uint32_t mode;          ///<index of the mode (in its parent pb_type) of the interconnect of the edge
+    t_pb_graph_edge* edge;  ///<the edge
+};
+
 struct t_logical_block_type {
     char* name = nullptr;
 
@@ -937,6 +944,11 @@ struct t_logical_block_type {
     std::vector<t_class> primitive_logical_class_inf;                                              /* primitive_logical_class_inf[class_logical_number] -> class */
     std::unordered_map<const t_pb_graph_node*, t_class_range> primitive_pb_graph_node_class_range; /* primitive_pb_graph_node_class_range[primitive_pb_graph_node ptr] -> class range for that primitive*/
 
+    /* Pin to pin connectivity of pb_graph_head in CSR form, with pins identified by their pin_count_in_cluster:
+     * the fanout of pin ipin is pb_pin_fanout[pb_pin_fanout_offsets[ipin]..pb_pin_fanout_offsets[ipin + 1]-1] */
+    std::vector<uint32_t> pb_pin_fanout_offsets; /* [0..total_pb_pins] */
+    std::vector<t_pb_graph_pin_fanout> pb_pin_fanout;
+
     // Is this t_logical_block_type empty?
     bool is_empty() const;
 };
@@ -1279,6 +1291,10 @@ class t_pb_graph_node {
     t_pb_graph_pin** output_pins; /* [0..num_output_ports-1] [0..num_port_pins-1]*/
     t_pb_graph_pin** clock_pins;  /* [0..num_clock_ports-1] [0..num_port_pins-1]*/
 
+    /* Storage of all the pins above, contiguous and in pin_count_in_cluster order:
+     * pins[ipin] has pin_count_in_cluster pin_num_range.low + ipin */
+    t_pb_graph_pin* pins = nullptr; /* [0..num_pins()-1] */
+
     int num_input_ports;
     int num_output_ports;
     int num_clock_ports;
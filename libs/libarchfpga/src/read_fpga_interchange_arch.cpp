@@ -6,7 +6,7 @@
 #ifdef VTR_ENABLE_CAPNPROTO
 
 #    include <algorithm>
-#    include <kj/std/iostream.h>
+#    include <future>
 #    include <limits>
 #    include <map>
 #    include <regex>
@@ -14,8 +14,8 @@
 #    include <stdlib.h>
 #    include <string>
 #    include <string.h>
-#    include <zlib.h>
-#    include <sstream>
+#    include <unordered_map>
+#    include <unordered_set>
 
 #    include "vtr_assert.h"
 #    include "vtr_digest.h"
@@ -23,6 +23,8 @@
 #    include "vtr_memory.h"
 #    include "vtr_util.h"
 
+#    include "interchange_message.h"
+
 #    include "arch_check.h"
 #    include "arch_error.h"
 #    include "arch_util.h"
@@ -35,7 +37,8 @@
  * and populate the various VTR architecture's internal data structures.
  *
  * The Device data is, by default, GZipped, hence the requirement of the ZLIB library to allow
- * for in-memory decompression of the input file.
+ * for in-memory decompression of the input file (see InterchangeMessage, which also reads
+ * uncompressed files in place).
  */
 
 using namespace DeviceResources;
@@ -280,9 +283,13 @@ struct ArchReader {
         , ltypes_(logical_types) {
         set_arch_file_name(arch_file);
 
-        for (std::string str : ar_.getStrList()) {
-            auto interned_string = arch_->strings.intern_string(vtr::string_view(str.c_str()));
-            arch_->interned_strings.push_back(interned_string);
+        auto str_list = ar_.getStrList();
+        strs_.reserve(str_list.size());
+        arch_->interned_strings.reserve(str_list.size());
+        for (auto text : str_list) {
+            vtr::string_view view(text.cStr(), text.size());
+            arch_->interned_strings.push_back(arch_->strings.intern_string(view));
+            strs_.emplace_back(text.cStr(), text.size());
         }
     }
 
@@ -342,11 +349,20 @@ struct ArchReader {
     std::unordered_map<uint32_t, std::set<t_bel_cell_mapping>> bel_cell_mappings_;
     std::unordered_map<std::string, int> segment_name_to_segment_idx;
 
+    // The device's strings, indexed by string id (decoding an interned string joins its parts, which is too slow for
+    // the many look-ups made while reading a large device)
+    std::vector<std::string> strs_;
+
+    // Names of the LUT cells, and of the LUT BELs of each site type (and of any site type), filled by process_luts()
+    std::unordered_set<std::string> lut_cell_names_;
+    std::unordered_map<std::string, std::unordered_set<std::string>> site_lut_bel_names_;
+    std::unordered_set<std::string> lut_bel_names_;
+
     // Utils
 
     /** @brief Returns the string corresponding to the given index */
-    std::string str(size_t idx) {
-        return arch_->interned_strings[idx].get(&arch_->strings);
+    const std::string& str(size_t idx) const {
+        return strs_[idx];
     }
 
     /** @brief Get the BEL count of a site depending on its category (e.g. logic or routing BELs) */
@@ -411,26 +427,15 @@ struct ArchReader {
     }
 
     /** @brief Returns true in case the input argument corresponds to the name of a LUT */
-    bool is_lut(std::string name, const std::string site = std::string()) {
-        for (auto cell : arch_->lut_cells)
-            if (cell.name == name)
-                return true;
-
-        for (const auto& it : arch_->lut_elements) {
-            if (!site.empty() && site != it.first) {
-                continue;
-            }
+    bool is_lut(const std::string& name, const std::string& site = std::string()) const {
+        if (lut_cell_names_.count(name))
+            return true;
 
-            for (const auto& lut_element : it.second) {
-                for (const auto& lut_bel : lut_element.lut_bels) {
-                    if (lut_bel.name == name) {
-                        return true;
-                    }
-                }
-            }
-        }
+        if (site.empty())
+            return lut_bel_names_.count(name) != 0;
 
-        return false;
+        auto it = site_lut_bel_names_.find(site);
+        return it != site_lut_bel_names_.end() && it->second.count(name) != 0;
     }
 
     t_lut_element* get_lut_element_for_bel(const std::string& site_type, const std::string& bel_name) {
@@ -754,12 +759,21 @@ struct ArchReader {
         auto tile_types = ar_.getTileTypeList();
         auto site_types = ar_.getSiteTypeList();
 
+        // The BELs and sites taken only depend on the site types, so each site type is processed once,
+        // rather than once per site instance of the device
+        std::vector<bool> site_type_processed(site_types.size(), false);
+
         for (auto tile : tiles) {
             auto tile_type = tile_types[tile.getType()];
 
             for (auto site : tile.getSites()) {
                 auto site_type_in_tile = tile_type.getSiteTypes()[site.getType()];
-                auto site_type = site_types[site_type_in_tile.getPrimaryType()];
+                uint32_t site_type_idx = site_type_in_tile.getPrimaryType();
+                if (site_type_processed[site_type_idx])
+                    continue;
+                site_type_processed[site_type_idx] = true;
+
+                auto site_type = site_types[site_type_idx];
 
                 bool found = false;
                 for (auto bel : site_type.getBels()) {
@@ -795,6 +809,7 @@ struct ArchReader {
             if (equation.isInitParam())
                 cell.init_param = equation.getInitParam().cStr();
 
+            lut_cell_names_.insert(cell.name);
             arch_->lut_cells.push_back(cell);
         }
 
@@ -815,6 +830,8 @@ struct ArchReader {
                     lut_bel.input_pins = ipins;
                     lut_bel.output_pin = bel.getOutputPin().cStr();
 
+                    site_lut_bel_names_[element.site_type].insert(lut_bel.name);
+                    lut_bel_names_.insert(lut_bel.name);
                     element.lut_bels.push_back(lut_bel);
                 }
 
@@ -2510,43 +2527,15 @@ void FPGAInterchangeReadArch(const char* FPGAInterchangeDeviceFile,
                              std::vector<t_physical_tile_type>& PhysicalTileTypes,
                              std::vector<t_logical_block_type>& LogicalBlockTypes) {
 #ifdef VTR_ENABLE_CAPNPROTO
-    // Decompress GZipped capnproto device file
-    gzFile file = gzopen(FPGAInterchangeDeviceFile, "r");
-    VTR_ASSERT(file != Z_NULL);
-
-    std::vector<uint8_t> output_data;
-    output_data.resize(4096);
-    std::stringstream sstream(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
-    while (true) {
-        int ret = gzread(file, output_data.data(), output_data.size());
-        VTR_ASSERT(ret >= 0);
-        if (ret > 0) {
-            sstream.write((const char*)output_data.data(), ret);
-            VTR_ASSERT(sstream);
-        } else {
-            VTR_ASSERT(ret == 0);
-            int error;
-            gzerror(file, &error);
-            VTR_ASSERT(error == Z_OK);
-            break;
-        }
-    }
-
-    VTR_ASSERT(gzclose(file) == Z_OK);
-
-    sstream.seekg(0);
-    kj::std::StdInputStream istream(sstream);
-
-    // Reader options
-    capnp::ReaderOptions reader_options;
-    reader_options.nestingLimit = std::numeric_limits<int>::max();
-    reader_options.traversalLimitInWords = std::numeric_limits<uint64_t>::max();
-
-    capnp::InputStreamMessageReader message_reader(istream, reader_options);
+    // The digest of the device file is computed while it is decompressed
+    std::future<std::string> architecture_id = std::async(std::launch::async, [&]() {
+        return vtr::secure_digest_file(FPGAInterchangeDeviceFile);
+    });
 
-    auto device_reader = message_reader.getRoot<DeviceResources::Device>();
+    InterchangeMessage message(FPGAInterchangeDeviceFile);
+    auto device_reader = message.getRoot<DeviceResources::Device>();
 
-    arch->architecture_id = vtr::strdup(vtr::secure_digest_file(FPGAInterchangeDeviceFile).c_str());
+    arch->architecture_id = vtr::strdup(architecture_id.get().c_str());
 
     ArchReader reader(arch, device_reader, FPGAInterchangeDeviceFile, PhysicalTileTypes, LogicalBlockTypes);
     reader.read_arch();
@@ -1,26 +1,253 @@
 /**
  * Lightweight logging tool.  Automatically prepend messages with prefixes and store in log file.
  *
+ * Messages are formatted by the calling thread and handed to a background writer
+ * thread through a lock-free queue, so that logging threads never wait on stdio
+ * (see log.h).
+ *
  * Author: Jason Luu
  * Date: Sept 5, 2014
  */
 
 #include <stdio.h>
 #include <stdarg.h> /* Allows for variable arguments, necessary for wrapping printf */
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
 #include "log.h"
 
 #define LOG_DEFAULT_FILE_NAME "output.log"
 
-static int log_warning = 0;
-static int log_error = 0;
+static std::atomic<int> log_warning(0);
+static std::atomic<int> log_error(0);
+static std::atomic<int> log_min_level(LOG_LEVEL_INFO);
 FILE* log_stream = nullptr;
 
+namespace {
+
+/* Where a message goes */
+enum e_log_dest {
+    LOG_DEST_STDOUT,         /* stdout only (direct messages) */
+    LOG_DEST_STDOUT_AND_LOG, /* stdout and the log file */
+    LOG_DEST_STDERR_AND_LOG, /* stderr and the log file */
+    LOG_DEST_FLUSH           /* not a message: flush everything before it, and wake up whoever waits for it */
+};
+
+/* A queued message, linked by the lock-free queue */
+struct t_log_msg {
+    std::atomic<t_log_msg*> next{nullptr};
+    e_log_dest dest = LOG_DEST_STDOUT;
+    std::string text;
+    bool* flushed = nullptr; /* LOG_DEST_FLUSH only: set (under flush_mutex) once flushed */
+};
+
+/*
+ * Multiple-producer single-consumer intrusive queue (D. Vyukov's): pushing is a single
+ * atomic exchange, so logging threads never block each other, and messages are written
+ * in the order they were pushed.
+ */
+class LogQueue {
+  public:
+    LogQueue()
+        : head_(&stub_)
+        , tail_(&stub_) {}
+
+    /* Any thread */
+    void push(t_log_msg* msg) {
+        msg->next.store(nullptr, std::memory_order_relaxed);
+        t_log_msg* prev = head_.exchange(msg, std::memory_order_acq_rel);
+        prev->next.store(msg, std::memory_order_release);
+    }
+
+    /* Writer thread only: returns nullptr if empty, or if the next message is still being pushed */
+    t_log_msg* pop() {
+        t_log_msg* tail = tail_;
+        t_log_msg* next = tail->next.load(std::memory_order_acquire);
+        if (tail == &stub_) {
+            if (!next) {
+                return nullptr;
+            }
+            tail_ = next;
+            tail = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+        if (next) {
+            tail_ = next;
+            return tail;
+        }
+        if (tail != head_.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        push(&stub_);
+        next = tail->next.load(std::memory_order_acquire);
+        if (next) {
+            tail_ = next;
+            return tail;
+        }
+        return nullptr;
+    }
+
+  private:
+    t_log_msg stub_;
+    std::atomic<t_log_msg*> head_;
+    t_log_msg* tail_;
+};
+
+/*
+ * Writes the queued messages in a background thread, flushing the streams once
+ * the queue is drained (instead of after every message).
+ */
+class LogWriter {
+  public:
+    LogWriter()
+        : thread_(&LogWriter::run, this) {}
+
+    ~LogWriter() {
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            stopping_ = true;
+        }
+        wake_cv_.notify_one();
+        thread_.join();
+    }
+
+    void push(t_log_msg* msg) {
+        num_pending_.fetch_add(1);
+        queue_.push(msg);
+        if (idle_.load()) {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            wake_cv_.notify_one();
+        }
+    }
+
+    /* Returns once every message pushed before by this thread is written and flushed */
+    void flush() {
+        bool flushed = false;
+        t_log_msg* marker = new t_log_msg;
+        marker->dest = LOG_DEST_FLUSH;
+        marker->flushed = &flushed;
+        push(marker);
+
+        std::unique_lock<std::mutex> lock(flush_mutex_);
+        flush_cv_.wait(lock, [&] { return flushed; });
+    }
+
+  private:
+    void run() {
+        bool unflushed = false;
+        while (true) {
+            t_log_msg* msg = queue_.pop();
+            if (!msg) {
+                if (unflushed) {
+                    flush_streams();
+                    unflushed = false;
+                }
+                if (num_pending_.load() > 0) {
+                    std::this_thread::yield(); /* a push is half done */
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(wake_mutex_);
+                if (stopping_ && num_pending_.load() == 0) {
+                    break;
+                }
+                idle_.store(true);
+                wake_cv_.wait(lock, [&] { return stopping_ || num_pending_.load() > 0; });
+                idle_.store(false);
+                continue;
+            }
+
+            if (msg->dest == LOG_DEST_FLUSH) {
+                flush_streams();
+                unflushed = false;
+                {
+                    std::lock_guard<std::mutex> lock(flush_mutex_);
+                    *msg->flushed = true;
+                }
+                flush_cv_.notify_all();
+            } else {
+                write_message(*msg);
+                unflushed = true;
+            }
+            delete msg;
+            num_pending_.fetch_sub(1);
+        }
+    }
+
+    void write_message(const t_log_msg& msg) {
+        if (msg.dest == LOG_DEST_STDERR_AND_LOG) {
+            fflush(stdout); /* keep stdout and stderr in order on a terminal */
+            fwrite(msg.text.data(), 1, msg.text.size(), stderr);
+        } else {
+            fwrite(msg.text.data(), 1, msg.text.size(), stdout);
+        }
+        if (msg.dest != LOG_DEST_STDOUT && log_stream) {
+            fwrite(msg.text.data(), 1, msg.text.size(), log_stream);
+        }
+    }
+
+    void flush_streams() {
+        fflush(stdout);
+        fflush(stderr);
+        if (log_stream) {
+            fflush(log_stream);
+        }
+    }
+
+    LogQueue queue_;
+    std::atomic<size_t> num_pending_{0}; /* pushed but not yet written */
+    std::atomic<bool> idle_{false};
+
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cv_;
+    bool stopping_ = false;
+
+    std::mutex flush_mutex_;
+    std::condition_variable flush_cv_;
+
+    std::thread thread_;
+};
+
+/* 0: not started, 1: running, 2: stopped (at exit; messages are then written directly) */
+std::atomic<int> writer_state(0);
+std::once_flag writer_once;
+
+struct LogWriterHolder {
+    LogWriter writer;
+
+    ~LogWriterHolder() {
+        writer_state.store(2);
+    }
+};
+
+LogWriter* get_writer() {
+    if (writer_state.load() == 2) {
+        return nullptr;
+    }
+    static LogWriterHolder* holder = nullptr;
+    std::call_once(writer_once, [] {
+        static LogWriterHolder instance; /* drained and joined at exit */
+        holder = &instance;
+        writer_state.store(1);
+    });
+    return writer_state.load() == 1 ? &holder->writer : nullptr;
+}
+
+} // namespace
+
 static void check_init();
+static void log_message(e_log_dest dest, const char* prefix, const char* message, va_list args);
 
 /* Set the output file of logger.
  * If different than current log file, close current log file and reopen to new log file
  */
 void log_set_output_file(const char* filename) {
+    log_flush(); /* the writer mustn't be writing to the old file */
+
     if (log_stream != nullptr) {
         fclose(log_stream);
     }
@@ -35,72 +262,103 @@ void log_set_output_file(const char* filename) {
     }
 }
 
+void log_set_level(e_log_level level) {
+    log_min_level.store(level);
+}
+
+bool log_level_enabled(e_log_level level) {
+    return level >= log_min_level.load(std::memory_order_relaxed);
+}
+
 void log_print_direct(const char* message, ...) {
+    if (!log_level_enabled(LOG_LEVEL_INFO)) return;
+
     va_list args;
     va_start(args, message);
-    vprintf(message, args);
+    log_message(LOG_DEST_STDOUT, nullptr, message, args);
     va_end(args);
 }
 
 void log_print_info(const char* message, ...) {
+    if (!log_level_enabled(LOG_LEVEL_INFO)) return;
+
     check_init(); /* Check if output log file setup, if not, then this function also sets it up */
 
     va_list args;
     va_start(args, message);
-    vprintf(message, args);
+    log_message(LOG_DEST_STDOUT_AND_LOG, nullptr, message, args);
     va_end(args);
-
-    if (log_stream) {
-        va_start(args, message); /* Must reset variable arguments so that they can be read again */
-        vfprintf(log_stream, message, args);
-        va_end(args);
-
-        fflush(log_stream);
-    }
 }
 
 void log_print_warning(const char* /*filename*/, unsigned int /*line_num*/, const char* message, ...) {
+    if (!log_level_enabled(LOG_LEVEL_WARNING)) return;
+
     check_init(); /* Check if output log file setup, if not, then this function also sets it up */
 
+    std::string prefix = "Warning " + std::to_string(++log_warning) + ": ";
+
     va_list args;
     va_start(args, message);
-    log_warning++;
-
-    printf("Warning %d: ", log_warning);
-    vprintf(message, args);
+    log_message(LOG_DEST_STDOUT_AND_LOG, prefix.c_str(), message, args);
     va_end(args);
-
-    if (log_stream) {
-        va_start(args, message); /* Must reset variable arguments so that they can be read again */
-        fprintf(log_stream, "Warning %d: ", log_warning);
-        vfprintf(log_stream, message, args);
-
-        va_end(args);
-        fflush(log_stream);
-    }
 }
 
 void log_print_error(const char* /*filename*/, unsigned int /*line_num*/, const char* message, ...) {
+    if (!log_level_enabled(LOG_LEVEL_ERROR)) return;
+
     check_init(); /* Check if output log file setup, if not, then this function also sets it up */
 
+    std::string prefix = "Error " + std::to_string(++log_error) + ": ";
+
     va_list args;
     va_start(args, message);
-    log_error++;
-
-    check_init();
-    fprintf(stderr, "Error %d: ", log_error);
-    vfprintf(stderr, message, args);
+    log_message(LOG_DEST_STDERR_AND_LOG, prefix.c_str(), message, args);
     va_end(args);
 
-    if (log_stream) {
-        va_start(args, message); /* Must reset variable arguments so that they can be read again */
-        fprintf(log_stream, "Error %d: ", log_error);
-        vfprintf(log_stream, message, args);
+    /* Errors usually precede an exit: make sure they (and everything before) are out */
+    log_flush();
+}
 
-        va_end(args);
+void log_flush() {
+    if (LogWriter* writer = get_writer()) {
+        writer->flush();
+    }
+}
+
+/**
+ * Formats a message (prepended with prefix, if any) and queues it for the writer thread,
+ * or writes it directly once the writer is stopped.
+ */
+static void log_message(e_log_dest dest, const char* prefix, const char* message, va_list args) {
+    t_log_msg* msg = new t_log_msg;
+    msg->dest = dest;
+    if (prefix) {
+        msg->text = prefix;
+    }
 
+    va_list args_copy;
+    va_copy(args_copy, args);
+    int len = vsnprintf(nullptr, 0, message, args_copy);
+    va_end(args_copy);
+    if (len > 0) {
+        size_t offset = msg->text.size();
+        msg->text.resize(offset + len + 1); /* vsnprintf writes the terminating null */
+        vsnprintf(&msg->text[offset], len + 1, message, args);
+        msg->text.resize(offset + len);
+    }
+
+    if (LogWriter* writer = get_writer()) {
+        writer->push(msg);
+        return;
+    }
+
+    FILE* out = (dest == LOG_DEST_STDERR_AND_LOG) ? stderr : stdout;
+    fwrite(msg->text.data(), 1, msg->text.size(), out);
+    if (dest != LOG_DEST_STDOUT && log_stream) {
+        fwrite(msg->text.data(), 1, msg->text.size(), log_stream);
         fflush(log_stream);
     }
+    delete msg;
 }
 
 /**
@@ -111,7 +369,9 @@ static void check_init() {
 }
 
 void log_close() {
+    log_flush();
     if (log_stream) {
         fclose(log_stream);
+        log_stream = nullptr;
     }
 }
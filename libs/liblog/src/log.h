@@ -3,6 +3,13 @@
  *
  * Init/Change name of log file using log_set_output_file, when done, call log_close
  *
+ * Messages are formatted by the calling thread (messages below the level set with
+ * log_set_level are dropped before being formatted), and written to stdout/stderr and the
+ * log file by a background thread, in the order they were logged. The output streams are
+ * only flushed once every queued message is written. Errors are flushed (with everything
+ * logged before them) before log_print_error returns; call log_flush to do the same before
+ * writing to stdout by other means.
+ *
  * Author: Jason Luu
  * Date: Sept 5, 2014
  */
@@ -10,13 +17,26 @@
 #ifndef LOG_H
 #define LOG_H
 
+enum e_log_level {
+    LOG_LEVEL_INFO = 0,
+    LOG_LEVEL_WARNING,
+    LOG_LEVEL_ERROR
+};
+
 void log_set_output_file(const char* filename);
 
+/* Drops the messages below level (info by default) */
+void log_set_level(e_log_level level);
+bool log_level_enabled(e_log_level level);
+
 void log_print_direct(const char* message, ...);
 void log_print_info(const char* message, ...);
 void log_print_warning(const char* filename, unsigned int line_num, const char* message, ...);
 void log_print_error(const char* filename, unsigned int line_num, const char* message, ...);
 
+/* Returns once every message logged before (by this thread) is written and flushed */
+void log_flush();
+
 void log_close();
 
 #endif
@@ -2,6 +2,9 @@
  * Test program for logger
  */
 
+#include <thread>
+#include <vector>
+
 #include "log.h"
 
 int main() {
@@ -13,6 +16,24 @@ int main() {
     log_print_warning(__FILE__, __LINE__, "Test warning on floating point arguments %g %g\n", a, b);
     log_print_error(__FILE__, __LINE__, "Test error on two variables %g %g \n\n", a - x, b + y);
 
+    /* Messages of each thread must come out in order */
+    std::vector<std::thread> threads;
+    for (int ithread = 0; ithread < 4; ithread++) {
+        threads.emplace_back([ithread] {
+            for (int imsg = 0; imsg < 3; imsg++) {
+                log_print_info("Thread %d message %d\n", ithread, imsg);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    log_flush();
+
+    log_set_level(LOG_LEVEL_WARNING);
+    log_print_info("Test filtered out info message [FAIL]\n");
+    log_set_level(LOG_LEVEL_INFO);
+
     log_print_info("Test complete\n");
     return 0;
 }
\ No newline at end of file
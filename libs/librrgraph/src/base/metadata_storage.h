@@ -59,6 +59,12 @@ class MetadataStorage {
         map_.clear();
     }
 
+    // Releases the capacity slack of the metadata added so far (e.g. once a
+    // rr graph file is loaded). The lookup is still built only when needed.
+    void shrink_to_fit() {
+        data_.shrink_to_fit();
+    }
+
     size_t size() const {
         check_for_map();
         return map_.size();
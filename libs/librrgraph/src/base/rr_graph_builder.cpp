@@ -3,6 +3,7 @@
 #include "vtr_time.h"
 #include <queue>
 #include <random>
+#include <tuple>
 //#include <algorithm>
 
 //#include "globals.h"
@@ -131,6 +132,14 @@ void RRGraphBuilder::reorder_nodes(e_rr_node_reorder_algorithm reorder_rr_graph_
     } else if (reorder_rr_graph_nodes_algorithm == RANDOM_SHUFFLE) {
         std::mt19937 g(reorder_rr_graph_nodes_seed);
         std::shuffle(src_order.begin(), src_order.end(), g);
+    } else if (reorder_rr_graph_nodes_algorithm == TILE_LOCATION) {
+        // Nodes of identical tiles end up at the same distance from each other,
+        // so their edges have the same sink offsets (see t_rr_graph_storage::tile_edges())
+        std::stable_sort(src_order.begin(), src_order.end(),
+                         [&](auto a, auto b) -> bool {
+                             return std::make_tuple(node_storage_.node_layer(a), node_storage_.node_xlow(a), node_storage_.node_ylow(a))
+                                    < std::make_tuple(node_storage_.node_layer(b), node_storage_.node_xlow(b), node_storage_.node_ylow(b));
+                         });
     }
     vtr::vector<RRNodeId, RRNodeId> dest_order(v_num);
     cur_idx = 0;
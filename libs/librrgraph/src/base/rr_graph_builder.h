@@ -346,6 +346,20 @@ class RRGraphBuilder {
         node_storage_.init_fan_in();
     }
 
+    /** @brief Pack each edge's sink node and switch into 32 bits to reduce memory usage.
+     * Should only be called once the rr-graph is complete (see t_rr_graph_storage::pack_edges()).
+     * @return false if the edges couldn't be packed (they are left unpacked). */
+    inline bool pack_edges() {
+        return node_storage_.pack_edges();
+    }
+
+    /** @brief Store the edges as edge patterns shared by the nodes of the fabric's repeated tiles.
+     * Should only be called once the rr-graph is complete (see t_rr_graph_storage::tile_edges()).
+     * @return false if this wouldn't save memory over pack_edges() (the edges are left unpacked). */
+    inline bool tile_edges() {
+        return node_storage_.tile_edges();
+    }
+
     /** @brief Disable the flags which would prevent adding adding extra-resources, when flat-routing
      * is enabled, to the RR Graph
      * @note
@@ -353,6 +367,7 @@ class RRGraphBuilder {
      * are already added. This function disables the flags which would prevent adding extra-resources to the RR Graph
      */
     inline void reset_rr_graph_flags() {
+        node_storage_.unpack_edges();
         node_storage_.edges_read_ = false;
         node_storage_.partitioned_ = false;
         node_storage_.remapped_edges_ = false;
@@ -5,6 +5,8 @@
 #include "vtr_error.h"
 
 #include <algorithm>
+#include <limits>
+#include <unordered_map>
 
 void t_rr_graph_storage::reserve_edges(size_t num_edges) {
     edge_src_node_.reserve(num_edges);
@@ -16,6 +18,7 @@ void t_rr_graph_storage::reserve_edges(size_t num_edges) {
 void t_rr_graph_storage::emplace_back_edge(RRNodeId src, RRNodeId dest, short edge_switch, bool remapped) {
     // Cannot mutate edges once edges have been read!
     VTR_ASSERT(!edges_read_);
+    VTR_ASSERT(!edges_packed_);
     edge_src_node_.emplace_back(src);
     edge_dest_node_.emplace_back(dest);
     edge_switch_.emplace_back(edge_switch);
@@ -29,6 +32,7 @@ constexpr size_t kEdgeToNodeRatio = 10;
 void t_rr_graph_storage::alloc_and_load_edges(const t_rr_edge_info_set* rr_edges_to_create) {
     // Cannot mutate edges once edges have been read!
     VTR_ASSERT(!edges_read_);
+    VTR_ASSERT(!edges_packed_);
 
     size_t required_size = edge_src_node_.size() + rr_edges_to_create->size();
     if (edge_src_node_.capacity() < required_size) {
@@ -405,6 +409,7 @@ bool t_rr_graph_storage::verify_first_edges() const {
 }
 
 void t_rr_graph_storage::init_fan_in() {
+    VTR_ASSERT(!edges_packed_);
     //Reset all fan-ins to zero
     edges_read_ = true;
     node_fan_in_.resize(node_storage_.size(), 0);
@@ -494,6 +499,7 @@ void t_rr_graph_storage::remap_rr_node_switch_indices(const t_arch_switch_fanin&
     edges_read_ = true;
 
     VTR_ASSERT(!remapped_edges_);
+    VTR_ASSERT(!edges_packed_);
     for (size_t i = 0; i < edge_src_node_.size(); ++i) {
         RREdgeId edge(i);
         if(edge_remapped_[edge]) {
@@ -528,6 +534,7 @@ void t_rr_graph_storage::partition_edges(const vtr::vector<RRSwitchId, t_rr_swit
     if (partitioned_) {
         return;
     }
+    VTR_ASSERT(!edges_packed_);
 
     edges_read_ = true;
     VTR_ASSERT(remapped_edges_);
@@ -536,10 +543,19 @@ void t_rr_graph_storage::partition_edges(const vtr::vector<RRSwitchId, t_rr_swit
     //    by assign_first_edges()
     //  - Edges within a source node have the configurable edges before the
     //    non-configurable edges.
-    std::stable_sort(
-        edge_sort_iterator(this, 0),
-        edge_sort_iterator(this, edge_src_node_.size()),
-        edge_compare_src_node_and_configurable_first(rr_switches));
+    //
+    // RR graphs written by VPR store their edges in this order already, so
+    // check for it first: this is linear, while the sort is O(E log E) and
+    // allocates a temporary buffer as large as the edge arrays.
+    if (!std::is_sorted(
+            edge_sort_iterator(this, 0),
+            edge_sort_iterator(this, edge_src_node_.size()),
+            edge_compare_src_node_and_configurable_first(rr_switches))) {
+        std::stable_sort(
+            edge_sort_iterator(this, 0),
+            edge_sort_iterator(this, edge_src_node_.size()),
+            edge_compare_src_node_and_configurable_first(rr_switches));
+    }
 
     partitioned_ = true;
 
@@ -554,7 +570,7 @@ t_edge_size t_rr_graph_storage::num_configurable_edges(RRNodeId id, const vtr::v
     auto first_id = size_t(node_first_edge_[id]);
     auto last_id = size_t((&node_first_edge_[id])[1]);
     for (size_t idx = first_id; idx < last_id; ++idx) {
-        auto switch_idx = edge_switch_[RREdgeId(idx)];
+        auto switch_idx = edge_switch(RREdgeId(idx));
         if (!rr_switches[RRSwitchId(switch_idx)].configurable()) {
             return idx - first_id;
         }
@@ -821,9 +837,181 @@ t_rr_graph_view t_rr_graph_storage::view() const {
         vtr::make_const_array_view_id(edge_src_node_),
         vtr::make_const_array_view_id(edge_dest_node_),
         vtr::make_const_array_view_id(edge_switch_),
+        vtr::make_const_array_view_id(edge_packed_),
+        edge_switch_bits_,
+        vtr::make_const_array_view_id(node_edge_pattern_),
+        vtr::array_view<const t_rr_edge_pattern_entry>(edge_pattern_.data(), edge_pattern_.size()),
+        vtr::array_view<const RRNodeId>(edge_block_src_node_.data(), edge_block_src_node_.size()),
         virtual_clock_network_root_idx_);
 }
 
+/** Number of bits needed to represent values up to and including max_value */
+static uint32_t bits_needed(size_t max_value) {
+    uint32_t bits = 0;
+    while (max_value >> bits) {
+        ++bits;
+    }
+    return bits;
+}
+
+bool t_rr_graph_storage::pack_edges() {
+    VTR_ASSERT(partitioned_);
+    VTR_ASSERT(remapped_edges_);
+    if (edges_packed_) {
+        return true;
+    }
+
+    size_t num_edges = edge_dest_node_.size();
+    VTR_ASSERT(edge_switch_.size() == num_edges);
+
+    short max_switch = 0;
+    for (short iswitch : edge_switch_) {
+        VTR_ASSERT(iswitch >= 0);
+        max_switch = std::max(max_switch, iswitch);
+    }
+
+    uint32_t switch_bits = bits_needed(max_switch);
+    uint32_t node_bits = bits_needed(node_storage_.empty() ? 0 : node_storage_.size() - 1);
+    if (switch_bits >= 32 || switch_bits + node_bits > 32) {
+        return false;
+    }
+
+    edge_packed_.resize(num_edges);
+    for (size_t i = 0; i < num_edges; i++) {
+        RREdgeId edge(i);
+        edge_packed_[edge] = (uint32_t(size_t(edge_dest_node_[edge])) << switch_bits) | uint32_t(edge_switch_[edge]);
+    }
+    edge_switch_bits_ = switch_bits;
+
+    // Release the unpacked storage
+    decltype(edge_src_node_)().swap(edge_src_node_);
+    decltype(edge_dest_node_)().swap(edge_dest_node_);
+    decltype(edge_switch_)().swap(edge_switch_);
+
+    edges_packed_ = true;
+    return true;
+}
+
+void t_rr_graph_storage::unpack_edges() {
+    if (!edges_packed_) {
+        return;
+    }
+
+    size_t num_edges = size_t(node_first_edge_.back());
+    edge_src_node_.resize(num_edges);
+    edge_dest_node_.resize(num_edges);
+    edge_switch_.resize(num_edges);
+    for (size_t inode = 0; inode < node_storage_.size(); inode++) {
+        RRNodeId src(inode);
+        for (RREdgeId edge : edge_range(src)) {
+            edge_src_node_[edge] = src;
+            edge_dest_node_[edge] = edge_sink_node(src, edge);
+            edge_switch_[edge] = edge_switch(src, edge);
+        }
+    }
+
+    decltype(edge_packed_)().swap(edge_packed_);
+    edge_switch_bits_ = 0;
+    decltype(node_edge_pattern_)().swap(node_edge_pattern_);
+    std::vector<t_rr_edge_pattern_entry>().swap(edge_pattern_);
+    std::vector<RRNodeId>().swap(edge_block_src_node_);
+    edges_packed_ = false;
+    edges_tiled_ = false;
+}
+
+bool t_rr_graph_storage::tile_edges() {
+    VTR_ASSERT(partitioned_);
+    VTR_ASSERT(remapped_edges_);
+    if (edges_packed_) {
+        return edges_tiled_;
+    }
+
+    size_t num_nodes = node_storage_.size();
+    size_t num_edges = edge_dest_node_.size();
+    VTR_ASSERT(edge_switch_.size() == num_edges);
+
+    // Find the distinct edge lists, relative to their source node. Lists are
+    // looked up by a hash of their entries, and compared entry by entry.
+    auto entries_hash = [](const t_rr_edge_pattern_entry* entries, size_t num_entries) {
+        size_t hash = num_entries;
+        for (size_t i = 0; i < num_entries; i++) {
+            hash = hash * 1000003 ^ (size_t(uint32_t(entries[i].sink_offset)) << 16 | uint16_t(entries[i].switch_id));
+        }
+        return hash;
+    };
+
+    decltype(node_edge_pattern_) node_edge_pattern(num_nodes, 0);
+    std::vector<t_rr_edge_pattern_entry> edge_pattern;
+    std::unordered_multimap<size_t, uint32_t> pattern_lookup;
+    std::vector<t_rr_edge_pattern_entry> entries;
+    for (size_t inode = 0; inode < num_nodes; inode++) {
+        RRNodeId src(inode);
+        entries.clear();
+        for (RREdgeId edge : edge_range(src)) {
+            int64_t sink_offset = int64_t(size_t(edge_dest_node_[edge])) - int64_t(inode);
+            VTR_ASSERT(sink_offset >= std::numeric_limits<int32_t>::min() && sink_offset <= std::numeric_limits<int32_t>::max());
+            entries.push_back({int32_t(sink_offset), edge_switch_[edge]});
+        }
+        if (entries.empty()) {
+            continue;
+        }
+
+        size_t hash = entries_hash(entries.data(), entries.size());
+        auto candidates = pattern_lookup.equal_range(hash);
+        auto match = std::find_if(candidates.first, candidates.second, [&](const std::pair<const size_t, uint32_t>& candidate) {
+            return std::equal(entries.begin(), entries.end(), edge_pattern.begin() + candidate.second,
+                              [](const t_rr_edge_pattern_entry& a, const t_rr_edge_pattern_entry& b) {
+                                  return a.sink_offset == b.sink_offset && a.switch_id == b.switch_id;
+                              });
+        });
+        if (match != candidates.second) {
+            node_edge_pattern[src] = match->second;
+        } else {
+            VTR_ASSERT(edge_pattern.size() <= std::numeric_limits<uint32_t>::max() - entries.size());
+            node_edge_pattern[src] = edge_pattern.size();
+            pattern_lookup.emplace(hash, edge_pattern.size());
+            edge_pattern.insert(edge_pattern.end(), entries.begin(), entries.end());
+        }
+    }
+
+    // Only keep the patterns if they take less memory than packing the edges
+    size_t num_blocks = (num_edges + RR_EDGE_SRC_BLOCK_SIZE - 1) / RR_EDGE_SRC_BLOCK_SIZE;
+    size_t tiled_bytes = num_nodes * sizeof(uint32_t)
+                         + edge_pattern.size() * sizeof(t_rr_edge_pattern_entry)
+                         + num_blocks * sizeof(RRNodeId);
+    if (tiled_bytes >= num_edges * sizeof(uint32_t)) {
+        return false;
+    }
+
+    std::vector<RRNodeId> edge_block_src_node(num_blocks);
+    for (size_t iblock = 0; iblock < num_blocks; iblock++) {
+        edge_block_src_node[iblock] = edge_src_node_[RREdgeId(iblock * RR_EDGE_SRC_BLOCK_SIZE)];
+    }
+
+    node_edge_pattern_ = std::move(node_edge_pattern);
+    edge_pattern_ = std::move(edge_pattern);
+    edge_pattern_.shrink_to_fit();
+    edge_block_src_node_ = std::move(edge_block_src_node);
+
+    // Release the unpacked storage
+    decltype(edge_src_node_)().swap(edge_src_node_);
+    decltype(edge_dest_node_)().swap(edge_dest_node_);
+    decltype(edge_switch_)().swap(edge_switch_);
+
+    edges_packed_ = true;
+    edges_tiled_ = true;
+    return true;
+}
+
+RRNodeId t_rr_graph_storage::packed_edge_src_node(RREdgeId edge) const {
+    // The owner of edge is the last node whose first edge is not after it. Nodes
+    // without edges share their first edge with the next node, so upper_bound
+    // skips over them.
+    auto next_node = std::upper_bound(node_first_edge_.begin(), node_first_edge_.end(), edge);
+    VTR_ASSERT_SAFE(next_node != node_first_edge_.begin());
+    return RRNodeId(std::distance(node_first_edge_.begin(), next_node) - 1);
+}
+
 // Given `order`, a vector mapping each RRNodeId to a new one (old -> new),
 // and `inverse_order`, its inverse (new -> old), update the t_rr_graph_storage
 // data structure to an isomorphic graph using the new RRNodeId's.
@@ -841,6 +1029,7 @@ t_rr_graph_view t_rr_graph_storage::view() const {
 void t_rr_graph_storage::reorder(const vtr::vector<RRNodeId, RRNodeId>& order,
                                  const vtr::vector<RRNodeId, RRNodeId>& inverse_order) {
     VTR_ASSERT(order.size() == inverse_order.size());
+    VTR_ASSERT(!edges_packed_);
     {
         auto old_node_storage = node_storage_;
 
@@ -886,4 +1075,26 @@ void t_rr_graph_storage::reorder(const vtr::vector<RRNodeId, RRNodeId>& order,
             node_fan_in_[order[RRNodeId(i)]] = old_node_fan_in[RRNodeId(i)];
         }
     }
+    {
+        auto old_node_layer = node_layer_;
+        for (size_t i = 0; i < node_layer_.size(); i++) {
+            node_layer_[order[RRNodeId(i)]] = old_node_layer[RRNodeId(i)];
+        }
+    }
+    {
+        auto old_node_ptc_twist_incr = node_ptc_twist_incr_;
+        for (size_t i = 0; i < node_ptc_twist_incr_.size(); i++) {
+            node_ptc_twist_incr_[order[RRNodeId(i)]] = old_node_ptc_twist_incr[RRNodeId(i)];
+        }
+    }
+    {
+        std::unordered_map<RRNodeId, std::string> old_node_name;
+        old_node_name.swap(node_name_);
+        for (auto& node_name : old_node_name) {
+            node_name_.emplace(order[node_name.first], std::move(node_name.second));
+        }
+        for (auto& clock_root : virtual_clock_network_root_idx_) {
+            clock_root.second = order[clock_root.second];
+        }
+    }
 }
@@ -13,6 +13,7 @@
 #include "rr_edge.h"
 #include "vtr_log.h"
 #include "vtr_memory.h"
+#include "vtr_memory_usage.h"
 #include "vtr_strong_id_range.h"
 #include "vtr_array_view.h"
 #include <iostream>
@@ -102,6 +103,19 @@ struct t_rr_node_ptc_data {
     } ptc_;
 };
 
+/* t_rr_edge_pattern_entry is one edge of a tiled edge pattern (see
+ * t_rr_graph_storage::tile_edges()): the sink node is given relative to the
+ * source node, so that the nodes of each tile of a regular fabric can share
+ * the same entries. */
+struct t_rr_edge_pattern_entry {
+    int32_t sink_offset; ///<Sink node id minus source node id
+    short switch_id;
+};
+
+/** Number of edges per entry of the tiled edges' source node table
+ *  (see t_rr_graph_storage::tile_edges()) */
+constexpr size_t RR_EDGE_SRC_BLOCK_SIZE = 64;
+
 class t_rr_graph_view;
 
 /**
@@ -400,20 +414,58 @@ class t_rr_graph_storage {
         return ret;
     }
 
-    /** @brief Get the source node for the specified edge. */
+    /** @brief Get the source node for the specified edge.
+     *
+     * Once the edges are packed (see pack_edges()) this is a binary search
+     * over the first edge of each node, so avoid it in inner loops.
+     */
     RRNodeId edge_src_node(const RREdgeId& edge) const {
         VTR_ASSERT_DEBUG(edge.is_valid());
+        if (edges_packed_) {
+            if (edges_tiled_) {
+                return tiled_edge_src_node(edge);
+            }
+            return packed_edge_src_node(edge);
+        }
         return edge_src_node_[edge];
     }
 
-    /** @brief Get the destination node for the specified edge. */
+    /** @brief Get the destination node for the specified edge.
+     *
+     * Once the edges are tiled (see tile_edges()) this first looks up the
+     * source node of the edge: prefer edge_sink_node(RRNodeId, RREdgeId)
+     * when the source node is known.
+     */
     RRNodeId edge_sink_node(const RREdgeId& edge) const {
         VTR_ASSERT_DEBUG(edge.is_valid());
+        if (edges_packed_) {
+            if (edges_tiled_) {
+                return edge_sink_node(tiled_edge_src_node(edge), edge);
+            }
+            return RRNodeId(edge_packed_[edge] >> edge_switch_bits_);
+        }
         return edge_dest_node_[edge];
     }
 
+    /** @brief Get the destination node for the specified edge of node src. */
+    RRNodeId edge_sink_node(const RRNodeId& src, const RREdgeId& edge) const {
+        if (edges_tiled_) {
+            return RRNodeId(size_t(src) + tiled_edge_entry(src, edge).sink_offset);
+        }
+        return edge_sink_node(edge);
+    }
+
     /** @brief Call the `apply` function with the edge id, source, and sink nodes of every edge. */
     void for_each_edge(std::function<void(RREdgeId, RRNodeId, RRNodeId)> apply) const {
+        if (edges_packed_) {
+            for (size_t inode = 0; inode < node_storage_.size(); inode++) {
+                RRNodeId src(inode);
+                for (RREdgeId edge : edge_range(src)) {
+                    apply(edge, src, edge_sink_node(src, edge));
+                }
+            }
+            return;
+        }
         for (size_t i = 0; i < edge_dest_node_.size(); i++) {
             RREdgeId edge(i);
             apply(edge, edge_src_node_[edge], edge_dest_node_[edge]);
@@ -426,21 +478,35 @@ class t_rr_graph_storage {
      * last_edge should be used.
      */
     RRNodeId edge_sink_node(const RRNodeId& id, t_edge_size iedge) const {
-        return edge_sink_node(edge_id(id, iedge));
+        return edge_sink_node(id, edge_id(id, iedge));
     }
 
     /** @brief Get the switch used for the specified edge. */
     short edge_switch(const RREdgeId& edge) const {
+        if (edges_packed_) {
+            if (edges_tiled_) {
+                return edge_switch(tiled_edge_src_node(edge), edge);
+            }
+            return edge_packed_[edge] & ((uint32_t(1) << edge_switch_bits_) - 1);
+        }
         return edge_switch_[edge];
     }
 
+    /** @brief Get the switch used for the specified edge of node src. */
+    short edge_switch(const RRNodeId& src, const RREdgeId& edge) const {
+        if (edges_tiled_) {
+            return tiled_edge_entry(src, edge).switch_id;
+        }
+        return edge_switch(edge);
+    }
+
     /** @brief Get the switch used for the iedge'th edge from specified RRNodeId.
      *
      * This method should generally not be used, and instead first_edge and
      * last_edge should be used.
      */
     short edge_switch(const RRNodeId& id, t_edge_size iedge) const {
-        return edge_switch(edge_id(id, iedge));
+        return edge_switch(id, edge_id(id, iedge));
     }
 
     /** @brief
@@ -545,9 +611,16 @@ class t_rr_graph_storage {
         edge_dest_node_.clear();
         edge_switch_.clear();
         edge_remapped_.clear();
+        edge_packed_.clear();
+        edge_switch_bits_ = 0;
+        node_edge_pattern_.clear();
+        edge_pattern_.clear();
+        edge_block_src_node_.clear();
         edges_read_ = false;
         partitioned_ = false;
         remapped_edges_ = false;
+        edges_packed_ = false;
+        edges_tiled_ = false;
     }
 
     /** @brief
@@ -560,6 +633,7 @@ class t_rr_graph_storage {
 
     /** @brief Clear edge_remap data structure, and then initialize it with the given value */
     void init_edge_remap(bool val) {
+        VTR_ASSERT(!edges_packed_);
         edge_remapped_.clear();
         edge_remapped_.resize(edge_switch_.size(), val);
     }
@@ -579,6 +653,113 @@ class t_rr_graph_storage {
         edge_dest_node_.shrink_to_fit();
         edge_switch_.shrink_to_fit();
         edge_remapped_.shrink_to_fit();
+        edge_packed_.shrink_to_fit();
+        node_edge_pattern_.shrink_to_fit();
+        edge_pattern_.shrink_to_fit();
+        edge_block_src_node_.shrink_to_fit();
+    }
+
+    /** @brief Returns the memory held by the node data (including their names and edge patterns) */
+    vtr::t_memory_usage node_memory_usage() const {
+        vtr::t_memory_usage usage;
+        usage += vtr::vector_memory_usage(node_storage_);
+        usage += vtr::vector_memory_usage(node_ptc_);
+        usage += vtr::vector_memory_usage(node_first_edge_);
+        usage += vtr::vector_memory_usage(node_fan_in_);
+        usage += vtr::vector_memory_usage(node_layer_);
+        usage += vtr::vector_memory_usage(node_ptc_twist_incr_);
+        usage += vtr::vector_memory_usage(node_edge_pattern_);
+        usage += vtr::hash_memory_usage(node_name_);
+        for (const auto& node_name : node_name_) {
+            usage.bytes += node_name.second.capacity();
+        }
+        return usage;
+    }
+
+    /** @brief Returns the memory held by the edge data (in whichever of the unpacked, packed or tiled forms they are) */
+    vtr::t_memory_usage edge_memory_usage() const {
+        vtr::t_memory_usage usage;
+        usage += vtr::vector_memory_usage(edge_src_node_);
+        usage += vtr::vector_memory_usage(edge_dest_node_);
+        usage += vtr::vector_memory_usage(edge_switch_);
+        usage += vtr::vector_memory_usage(edge_remapped_);
+        usage += vtr::vector_memory_usage(edge_packed_);
+        usage += vtr::vector_memory_usage(edge_pattern_);
+        usage += vtr::vector_memory_usage(edge_block_src_node_);
+        return usage;
+    }
+
+    /** @brief Pack the sink node and switch of every edge into a single 32-bit word.
+     *
+     * The sink node occupies the upper bits and the switch the lowest
+     * edge_switch_bits_ bits, with the bit widths chosen from the number of
+     * RR nodes and the largest switch id. This replaces the source node,
+     * sink node and switch arrays (10 bytes per edge) by 4 bytes per edge,
+     * while keeping O(1) random access to edge_sink_node and edge_switch.
+     * The source node of an edge is instead looked up from the first edge
+     * of each node.
+     *
+     * Edges can't be added, partitioned, remapped or reordered while packed;
+     * call unpack_edges() first.
+     *
+     * Only call this after partition_edges and remapping of the switches.
+     *
+     * @return false (leaving the edges unpacked) if a sink node and switch
+     * id don't fit in 32 bits together.
+     */
+    bool pack_edges();
+
+    /** @brief Store the edges as the edge patterns of the nodes of each tile.
+     *
+     * In a regular fabric, the nodes of each instance of a tile (or switch
+     * block) drive the same edges relative to their own id. The edges of each
+     * node are stored as a list of (sink node offset, switch) entries, and
+     * nodes with the same list share its entries: only the entry offset of
+     * each node is stored, and irregular nodes (e.g. at the fabric perimeter)
+     * get their own entries. RREdgeIds are unchanged.
+     *
+     * The sink node and switch of an edge are decoded from its source node
+     * (edge_sink_node(RRNodeId, RREdgeId)); when only the RREdgeId is known,
+     * the source node is first found from a table holding the source of
+     * every RR_EDGE_SRC_BLOCK_SIZE edges.
+     *
+     * Edges can't be added, partitioned, remapped or reordered while tiled
+     * (edges_packed() is set); call unpack_edges() first.
+     *
+     * Only call this after partition_edges and remapping of the switches.
+     *
+     * @return false (leaving the edges unpacked) if the edge patterns don't
+     * repeat enough to take less memory than pack_edges().
+     */
+    bool tile_edges();
+
+    /** @brief Restore the unpacked edge arrays, allowing the edges to be mutated again. */
+    void unpack_edges();
+
+    /** @brief Are the edges stored in packed (or tiled) form? (see pack_edges() and tile_edges()) */
+    bool edges_packed() const {
+        return edges_packed_;
+    }
+
+    /** @brief Are the edges stored as per-node edge patterns? (see tile_edges()) */
+    bool edges_tiled() const {
+        return edges_tiled_;
+    }
+
+    /** @brief Number of distinct edge pattern entries (see tile_edges()) */
+    size_t num_edge_pattern_entries() const {
+        return edge_pattern_.size();
+    }
+
+    /** @brief Bytes used to store the edges (excluding construction-only data) */
+    size_t edge_memory_bytes() const {
+        return edge_src_node_.capacity() * sizeof(RRNodeId)
+               + edge_dest_node_.capacity() * sizeof(RRNodeId)
+               + edge_switch_.capacity() * sizeof(short)
+               + edge_packed_.capacity() * sizeof(uint32_t)
+               + node_edge_pattern_.capacity() * sizeof(uint32_t)
+               + edge_pattern_.capacity() * sizeof(t_rr_edge_pattern_entry)
+               + edge_block_src_node_.capacity() * sizeof(RRNodeId);
     }
 
     /** @brief Append 1 more RR node to the RR graph.*/
@@ -792,6 +973,24 @@ class t_rr_graph_storage {
     /** @brief Verify that first_edge_ array correctly partitions rr edge data. */
     bool verify_first_edges() const;
 
+    /** @brief Find the source node of a packed edge from the first edge of each node. */
+    RRNodeId packed_edge_src_node(RREdgeId edge) const;
+
+    /** @brief Find the source node of a tiled edge (see tile_edges()) */
+    RRNodeId tiled_edge_src_node(RREdgeId edge) const {
+        RRNodeId src = edge_block_src_node_[size_t(edge) / RR_EDGE_SRC_BLOCK_SIZE];
+        while (!(edge < last_edge(src))) {
+            src = RRNodeId(size_t(src) + 1);
+        }
+        return src;
+    }
+
+    /** @brief Pattern entry of a tiled edge of node src */
+    const t_rr_edge_pattern_entry& tiled_edge_entry(RRNodeId src, RREdgeId edge) const {
+        VTR_ASSERT_DEBUG(!(edge < first_edge(src)) && edge < last_edge(src));
+        return edge_pattern_[node_edge_pattern_[src] + (size_t(edge) - size_t(first_edge(src)))];
+    }
+
     /*****************
      * Graph storage
      *
@@ -808,11 +1007,19 @@ class t_rr_graph_storage {
      *
      *****************/
 
+    /** @brief
+     * The largest arrays of the graph use vtr::large_array_allocator, so that
+     * they can be backed by huge pages and interleaved across NUMA nodes (see
+     * vtr::set_large_array_policy()).
+     */
+    template<typename K, typename V>
+    using large_vector = vtr::vector<K, V, vtr::large_array_allocator<V>>;
+
     /** @brief
      * storage_ stores the core RR node data used by the router and is **very**
      * hot.
      */
-    vtr::vector<RRNodeId, t_rr_node_data, vtr::aligned_allocator<t_rr_node_data>> node_storage_;
+    large_vector<RRNodeId, t_rr_node_data> node_storage_;
 
     /** @brief
      * The PTC data is cold data, and is generally not used during the inner
@@ -825,7 +1032,7 @@ class t_rr_graph_storage {
      * of this vector is always storage_.size() + 1, where the last value is
      * always equal to the number of edges in the final graph.
      */
-    vtr::vector<RRNodeId, RREdgeId> node_first_edge_;
+    large_vector<RRNodeId, RREdgeId> node_first_edge_;
 
     /** @brief Fan in counts for each RR node. */
     vtr::vector<RRNodeId, t_edge_size> node_fan_in_;
@@ -836,7 +1043,7 @@ class t_rr_graph_storage {
      * This data is also considered as a hot data since it is used in inner loop of router, but since it didn't fit nicely into t_rr_node_data due to alignment issues, we had to store it
      *in a separate vector.
      */
-    vtr::vector<RRNodeId, short> node_layer_;
+    large_vector<RRNodeId, short> node_layer_;
 
     /**
      * @brief Stores the assigned names for the RRNode IDs.
@@ -868,9 +1075,31 @@ class t_rr_graph_storage {
     vtr::vector<RRNodeId, short> node_ptc_twist_incr_;
 
     /** @brief Edge storage */
-    vtr::vector<RREdgeId, RRNodeId> edge_src_node_;
-    vtr::vector<RREdgeId, RRNodeId> edge_dest_node_;
-    vtr::vector<RREdgeId, short> edge_switch_;
+    large_vector<RREdgeId, RRNodeId> edge_src_node_;
+    large_vector<RREdgeId, RRNodeId> edge_dest_node_;
+    large_vector<RREdgeId, short> edge_switch_;
+
+    /** @brief
+     * Packed edge storage (see pack_edges()), used instead of edge_src_node_,
+     * edge_dest_node_ and edge_switch_ when edges_packed_ is set. This is
+     * **hot** data: the router decodes it for every edge it expands.
+     */
+    large_vector<RREdgeId, uint32_t> edge_packed_;
+
+    /** @brief Number of low bits of each edge_packed_ word holding the switch id */
+    uint32_t edge_switch_bits_;
+
+    /** @brief
+     * Tiled edge storage (see tile_edges()), used instead of edge_packed_
+     * when edges_tiled_ is set: the edges of a node are the entries of
+     * edge_pattern_ starting at node_edge_pattern_[node]. This is **hot**
+     * data.
+     */
+    large_vector<RRNodeId, uint32_t> node_edge_pattern_;
+    std::vector<t_rr_edge_pattern_entry> edge_pattern_;
+
+    /** @brief Source node of edge i * RR_EDGE_SRC_BLOCK_SIZE, for each i (tiled edges only) */
+    std::vector<RRNodeId> edge_block_src_node_;
 
     /** @brief
      * The delay of certain switches specified in the architecture file depends on the number of inputs of the edge's sink node (pins or tracks).
@@ -917,6 +1146,12 @@ class t_rr_graph_storage {
 
     /** @brief Set after partition_edges has been called. */
     bool partitioned_;
+
+    /** @brief Set after pack_edges or tile_edges has been called (and until unpack_edges is). */
+    bool edges_packed_;
+
+    /** @brief Set after tile_edges has been called (and until unpack_edges is). */
+    bool edges_tiled_;
 };
 
 /**
@@ -944,6 +1179,11 @@ class t_rr_graph_view {
         const vtr::array_view_id<RREdgeId, const RRNodeId> edge_src_node,
         const vtr::array_view_id<RREdgeId, const RRNodeId> edge_dest_node,
         const vtr::array_view_id<RREdgeId, const short> edge_switch,
+        const vtr::array_view_id<RREdgeId, const uint32_t> edge_packed,
+        uint32_t edge_switch_bits,
+        const vtr::array_view_id<RRNodeId, const uint32_t> node_edge_pattern,
+        const vtr::array_view<const t_rr_edge_pattern_entry> edge_pattern,
+        const vtr::array_view<const RRNodeId> edge_block_src_node,
         const std::unordered_map<std::string, RRNodeId>& virtual_clock_network_root_idx)
         : node_storage_(node_storage)
         , node_ptc_(node_ptc)
@@ -955,6 +1195,13 @@ class t_rr_graph_view {
         , edge_src_node_(edge_src_node)
         , edge_dest_node_(edge_dest_node)
         , edge_switch_(edge_switch)
+        , edge_packed_(edge_packed)
+        , edge_switch_bits_(edge_switch_bits)
+        , edges_packed_(!edge_packed.empty())
+        , node_edge_pattern_(node_edge_pattern)
+        , edge_pattern_(edge_pattern)
+        , edge_block_src_node_(edge_block_src_node)
+        , edges_tiled_(!node_edge_pattern.empty())
         , virtual_clock_network_root_idx_(virtual_clock_network_root_idx) {}
 
     /****************
@@ -1138,9 +1385,29 @@ class t_rr_graph_view {
      * @return The RRNodeId representing the destination node for the specified edge.
      */
     RRNodeId edge_sink_node(RREdgeId edge) const {
+        if (edges_tiled_) {
+            return edge_sink_node(tiled_edge_src_node(edge), edge);
+        }
+        if (edges_packed_) {
+            return RRNodeId(edge_packed_[edge] >> edge_switch_bits_);
+        }
         return edge_dest_node_[edge];
     }
 
+    /**
+     * @brief Get the destination node for the specified edge of node src.
+     *
+     * @details
+     * Equivalent to edge_sink_node(edge), but avoids looking up the source
+     * node of the edge when the edges are tiled (see t_rr_graph_storage::tile_edges()).
+     */
+    RRNodeId edge_sink_node(RRNodeId src, RREdgeId edge) const {
+        if (edges_tiled_) {
+            return RRNodeId(size_t(src) + tiled_edge_entry(src, edge).sink_offset);
+        }
+        return edge_sink_node(edge);
+    }
+
     /**
      * @brief Get the switch used for the specified edge.
      *
@@ -1151,9 +1418,29 @@ class t_rr_graph_view {
      * @return The switch index used for the specified edge.
      */
     short edge_switch(RREdgeId edge) const {
+        if (edges_tiled_) {
+            return edge_switch(tiled_edge_src_node(edge), edge);
+        }
+        if (edges_packed_) {
+            return edge_packed_[edge] & ((uint32_t(1) << edge_switch_bits_) - 1);
+        }
         return edge_switch_[edge];
     }
 
+    /**
+     * @brief Get the switch used for the specified edge of node src.
+     *
+     * @details
+     * Equivalent to edge_switch(edge), but avoids looking up the source
+     * node of the edge when the edges are tiled.
+     */
+    short edge_switch(RRNodeId src, RREdgeId edge) const {
+        if (edges_tiled_) {
+            return tiled_edge_entry(src, edge).switch_id;
+        }
+        return edge_switch(edge);
+    }
+
   private:
     RREdgeId first_edge(RRNodeId id) const {
         return node_first_edge_[id];
@@ -1163,6 +1450,18 @@ class t_rr_graph_view {
         return (&node_first_edge_[id])[1];
     }
 
+    RRNodeId tiled_edge_src_node(RREdgeId edge) const {
+        RRNodeId src = edge_block_src_node_[size_t(edge) / RR_EDGE_SRC_BLOCK_SIZE];
+        while (!(edge < last_edge(src))) {
+            src = RRNodeId(size_t(src) + 1);
+        }
+        return src;
+    }
+
+    const t_rr_edge_pattern_entry& tiled_edge_entry(RRNodeId src, RREdgeId edge) const {
+        return edge_pattern_[node_edge_pattern_[src] + (size_t(edge) - size_t(first_edge(src)))];
+    }
+
     vtr::array_view_id<RRNodeId, const t_rr_node_data> node_storage_;
     vtr::array_view_id<RRNodeId, const t_rr_node_ptc_data> node_ptc_;
     vtr::array_view_id<RRNodeId, const RREdgeId> node_first_edge_;
@@ -1173,6 +1472,13 @@ class t_rr_graph_view {
     vtr::array_view_id<RREdgeId, const RRNodeId> edge_src_node_;
     vtr::array_view_id<RREdgeId, const RRNodeId> edge_dest_node_;
     vtr::array_view_id<RREdgeId, const short> edge_switch_;
+    vtr::array_view_id<RREdgeId, const uint32_t> edge_packed_;
+    uint32_t edge_switch_bits_;
+    bool edges_packed_;
+    vtr::array_view_id<RRNodeId, const uint32_t> node_edge_pattern_;
+    vtr::array_view<const t_rr_edge_pattern_entry> edge_pattern_;
+    vtr::array_view<const RRNodeId> edge_block_src_node_;
+    bool edges_tiled_;
     const std::unordered_map<std::string, RRNodeId>& virtual_clock_network_root_idx_;
 
 };
@@ -57,6 +57,7 @@ enum e_rr_node_reorder_algorithm {
     DONT_REORDER,
     DEGREE_BFS,
     RANDOM_SHUFFLE,
+    TILE_LOCATION, ///<Group the nodes by (layer, xlow, ylow), keeping their order within a location
 };
 
 ///@brief Type used to express rr_node edge index.
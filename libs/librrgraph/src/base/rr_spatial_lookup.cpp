@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <limits>
+
 #include "vtr_assert.h"
 #include "rr_spatial_lookup.h"
 
@@ -45,37 +48,16 @@ RRNodeId RRSpatialLookup::find_node(int layer,
         std::swap(node_x, node_y);
     }
 
-    VTR_ASSERT_SAFE(4 == rr_node_indices_[type].ndims());
-
     /* Sanity check to ensure the layer, x, y, side and ptc are in range
      * - Return an valid id by searching in look-up when all the parameters are in range
      * - Return an invalid id if any out-of-range is detected
      */
-    if (size_t(type) >= rr_node_indices_.size()) {
-        return RRNodeId::INVALID();
-    }
-
-    if (size_t(layer) >= rr_node_indices_[type].dim_size(0)) {
-        return RRNodeId::INVALID();
-    }
-
-    if (node_x >= rr_node_indices_[type].dim_size(1)) {
-        return RRNodeId::INVALID();
-    }
-
-    if(node_y >= rr_node_indices_[type].dim_size(2)){
-        return RRNodeId::INVALID();
-    }
-
-    if (node_side >= rr_node_indices_[type].dim_size(3)) {
+    vtr::array_view<const int> nodes = node_list(type, layer, node_x, node_y, node_side);
+    if (size_t(ptc) >= nodes.size()) {
         return RRNodeId::INVALID();
     }
 
-    if (size_t(ptc) >= rr_node_indices_[type][layer][node_x][node_y][node_side].size()) {
-        return RRNodeId::INVALID();
-    }
-
-    return RRNodeId(rr_node_indices_[type][layer][node_x][node_y][node_side][ptc]);
+    return RRNodeId(nodes[ptc]);
 }
 
 std::vector<RRNodeId> RRSpatialLookup::find_nodes_in_range(int layer,
@@ -126,42 +108,22 @@ std::vector<RRNodeId> RRSpatialLookup::find_nodes(int layer,
         std::swap(node_x, node_y);
     }
 
-    VTR_ASSERT_SAFE(4 == rr_node_indices_[type].ndims());
-
     /* Sanity check to ensure the x, y, side are in range 
      * - Return a list of valid ids by searching in look-up when all the parameters are in range
      * - Return an empty list if any out-of-range is detected
      */
-    if (size_t(type) >= rr_node_indices_.size()) {
-        return nodes;
-    }
-
-    if (size_t(layer) >= rr_node_indices_[type].dim_size(0)) {
-        return nodes;
-    }
-
-    if (node_x >= rr_node_indices_[type].dim_size(1)) {
-        return nodes;
-    }
-
-    if(node_y >= rr_node_indices_[type].dim_size(2)){
-        return nodes;
-    }
-
-    if (side >= rr_node_indices_[type].dim_size(3)) {
-        return nodes;
-    }
+    vtr::array_view<const int> node_ids = node_list(type, layer, node_x, node_y, side);
 
     /* Reserve space to avoid memory fragmentation */
     size_t num_nodes = 0;
-    for (const auto& node : rr_node_indices_[type][layer][node_x][node_y][side]) {
+    for (const auto& node : node_ids) {
         if (RRNodeId(node)) {
             num_nodes++;
         }
     }
 
     nodes.reserve(num_nodes);
-    for (const auto& node : rr_node_indices_[type][layer][node_x][node_y][side]) {
+    for (const auto& node : node_ids) {
         if (RRNodeId(node)) {
             nodes.push_back(RRNodeId(node));
         }
@@ -241,6 +203,8 @@ void RRSpatialLookup::reserve_nodes(int layer,
                                     t_rr_type type,
                                     int num_nodes,
                                     e_side side) {
+    decompress();
+
     VTR_ASSERT_SAFE(4 == rr_node_indices_[type].ndims());
 
     /* For non-IPIN/OPIN nodes, the side should always be the TOP side which follows the convention in find_node() API! */
@@ -260,6 +224,8 @@ void RRSpatialLookup::add_node(RRNodeId node,
                                t_rr_type type,
                                int ptc,
                                e_side side) {
+    decompress();
+
     VTR_ASSERT(node.is_valid()); /* Must have a valid node id to be added */
     VTR_ASSERT_SAFE(4 == rr_node_indices_[type].ndims());
 
@@ -286,6 +252,8 @@ bool RRSpatialLookup::remove_node(RRNodeId node,
                                   t_rr_type type,
                                   int ptc,
                                   e_side side) {
+    decompress();
+
     VTR_ASSERT(node.is_valid());
     VTR_ASSERT_SAFE(4 == rr_node_indices_[type].ndims());
     VTR_ASSERT_SAFE(layer >= 0);
@@ -315,6 +283,8 @@ void RRSpatialLookup::mirror_nodes(const int layer,
                                    const vtr::Point<int>& des_coord,
                                    t_rr_type type,
                                    e_side side) {
+    decompress();
+
     VTR_ASSERT(SOURCE == type);
     resize_nodes(layer, des_coord.x(), des_coord.y(), type, side);
     rr_node_indices_[type][layer][des_coord.x()][des_coord.y()][side] = rr_node_indices_[type][layer][src_coord.x()][src_coord.y()][side];
@@ -325,6 +295,8 @@ void RRSpatialLookup::resize_nodes(int layer,
                                    int y,
                                    t_rr_type type,
                                    e_side side) {
+    decompress();
+
     /* Expand the fast look-up if the new node is out-of-range
      * This may seldom happen because the rr_graph building function
      * should ensure the fast look-up well organized  
@@ -346,6 +318,18 @@ void RRSpatialLookup::resize_nodes(int layer,
 }
 
 void RRSpatialLookup::reorder(const vtr::vector<RRNodeId, RRNodeId> dest_order) {
+    if (is_compressed_) {
+        // Each shared node list is held once, so it is updated once
+        for (auto& compressed : compressed_nodes_) {
+            for (int& node : compressed.nodes) {
+                if (node != OPEN) {
+                    node = size_t(dest_order[RRNodeId(node)]);
+                }
+            }
+        }
+        return;
+    }
+
     // update rr_node_indices, a map to optimize rr_index lookups
     for (auto& grid : rr_node_indices_) {
         for(size_t l = 0; l < grid.dim_size(0); l++) {
@@ -368,4 +352,132 @@ void RRSpatialLookup::clear() {
     for (auto& data : rr_node_indices_) {
         data.clear();
     }
+    for (auto& compressed : compressed_nodes_) {
+        compressed = t_compressed_nodes();
+    }
+    is_compressed_ = false;
+}
+
+void RRSpatialLookup::compress() {
+    if (is_compressed_) {
+        return;
+    }
+
+    for (size_t type = 0; type < rr_node_indices_.size(); ++type) {
+        auto& data = rr_node_indices_[type];
+        t_compressed_nodes& compressed = compressed_nodes_[type];
+
+        for (size_t dim = 0; dim < compressed.dim_sizes.size(); ++dim) {
+            compressed.dim_sizes[dim] = data.dim_size(dim);
+        }
+
+        size_t num_nodes = 0;
+        for (size_t i = 0; i < data.size(); ++i) {
+            num_nodes += data.get(i).size();
+        }
+        VTR_ASSERT(num_nodes <= std::numeric_limits<uint32_t>::max());
+
+        compressed.list_begins.resize(data.size());
+        compressed.list_sizes.resize(data.size());
+        compressed.nodes.reserve(num_nodes);
+
+        /* Locations are visited in (layer, x, y, side) order, so the neighbours below and
+         * to the left (the previous y and x in the same layer and side) are already packed */
+        const size_t x_stride = compressed.dim_sizes[2] * compressed.dim_sizes[3];
+        const size_t y_stride = compressed.dim_sizes[3];
+        for (size_t i = 0; i < data.size(); ++i) {
+            const std::vector<int>& nodes = data.get(i);
+            compressed.list_sizes[i] = nodes.size();
+
+            auto same_list = [&](size_t neighbour) {
+                return compressed.list_sizes[neighbour] == nodes.size()
+                       && std::equal(nodes.begin(), nodes.end(), compressed.nodes.begin() + compressed.list_begins[neighbour]);
+            };
+
+            size_t x = (i / x_stride) % compressed.dim_sizes[1];
+            size_t y = (i / y_stride) % compressed.dim_sizes[2];
+            if (!nodes.empty() && y > 0 && same_list(i - y_stride)) {
+                compressed.list_begins[i] = compressed.list_begins[i - y_stride];
+            } else if (!nodes.empty() && x > 0 && same_list(i - x_stride)) {
+                compressed.list_begins[i] = compressed.list_begins[i - x_stride];
+            } else {
+                compressed.list_begins[i] = compressed.nodes.size();
+                compressed.nodes.insert(compressed.nodes.end(), nodes.begin(), nodes.end());
+            }
+        }
+        compressed.nodes.shrink_to_fit();
+
+        data.clear();
+    }
+
+    is_compressed_ = true;
+}
+
+void RRSpatialLookup::decompress() {
+    if (!is_compressed_) {
+        return;
+    }
+
+    for (size_t type = 0; type < rr_node_indices_.size(); ++type) {
+        auto& data = rr_node_indices_[type];
+        t_compressed_nodes& compressed = compressed_nodes_[type];
+
+        if (!compressed.list_sizes.empty()) {
+            data.resize(compressed.dim_sizes);
+            for (size_t i = 0; i < data.size(); ++i) {
+                auto list_begin = compressed.nodes.begin() + compressed.list_begins[i];
+                data.get(i).assign(list_begin, list_begin + compressed.list_sizes[i]);
+            }
+        }
+
+        compressed = t_compressed_nodes();
+    }
+
+    is_compressed_ = false;
+}
+
+vtr::array_view<const int> RRSpatialLookup::node_list(t_rr_type type,
+                                                      size_t layer,
+                                                      size_t x,
+                                                      size_t y,
+                                                      size_t side) const {
+    if (size_t(type) >= rr_node_indices_.size()) {
+        return vtr::array_view<const int>();
+    }
+
+    if (is_compressed_) {
+        const t_compressed_nodes& compressed = compressed_nodes_[type];
+        const auto& dim_sizes = compressed.dim_sizes;
+        if (layer >= dim_sizes[0] || x >= dim_sizes[1] || y >= dim_sizes[2] || side >= dim_sizes[3]) {
+            return vtr::array_view<const int>();
+        }
+
+        size_t i = ((layer * dim_sizes[1] + x) * dim_sizes[2] + y) * dim_sizes[3] + side;
+        return vtr::array_view<const int>(compressed.nodes.data() + compressed.list_begins[i], compressed.list_sizes[i]);
+    }
+
+    const auto& data = rr_node_indices_[type];
+    VTR_ASSERT_SAFE(4 == data.ndims());
+    if (layer >= data.dim_size(0) || x >= data.dim_size(1) || y >= data.dim_size(2) || side >= data.dim_size(3)) {
+        return vtr::array_view<const int>();
+    }
+
+    const std::vector<int>& nodes = data[layer][x][y][side];
+    return vtr::array_view<const int>(nodes.data(), nodes.size());
+}
+
+vtr::t_memory_usage RRSpatialLookup::memory_usage() const {
+    vtr::t_memory_usage usage;
+    for (const auto& compressed : compressed_nodes_) {
+        usage += vtr::vector_memory_usage(compressed.list_begins);
+        usage += vtr::vector_memory_usage(compressed.list_sizes);
+        usage += vtr::vector_memory_usage(compressed.nodes);
+    }
+    for (const auto& data : rr_node_indices_) {
+        usage += vtr::matrix_memory_usage(data);
+        for (size_t i = 0; i < data.size(); ++i) {
+            usage += vtr::vector_memory_usage(data.get(i));
+        }
+    }
+    return usage;
 }
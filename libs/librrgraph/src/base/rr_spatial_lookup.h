@@ -14,8 +14,16 @@
  *
  *   - Update the look-up with new nodes
  *   - Find the id of a node with given information, e.g., x, y, type etc.
+ *
+ * Once the graph is built, the look-up can be compressed (see compress()) into flat arrays,
+ * which take a fraction of the memory of the per-location node lists used while building.
  */
+#include <array>
+#include <cstdint>
+
+#include "vtr_array_view.h"
 #include "vtr_geometry.h"
+#include "vtr_memory_usage.h"
 #include "vtr_vector.h"
 #include "physical_types.h"
 #include "rr_node_types.h"
@@ -275,6 +283,19 @@ class RRSpatialLookup {
     /** @brief Clear all the data inside */
     void clear();
 
+    /**
+     * @brief Compress the look-up into flat arrays, once no more nodes are expected to be added
+     *
+     * The node lists of all the locations are packed into a single array, and the locations with the same list
+     * as their neighbour below or to the left (e.g. the locations covered by a large block) share it.
+     * The accessors work the same on a compressed look-up; the mutators (other than reorder()) first
+     * decompress it, so they should not be used after compress() on a performance critical path.
+     */
+    void compress();
+
+    /** @brief Returns the memory held by the look-up (including the capacity slack of its node lists) */
+    vtr::t_memory_usage memory_usage() const;
+
     /* -- Internal data queries -- */
   private:
     /* An internal API to find all the nodes in a specific location with a given type
@@ -288,10 +309,35 @@ class RRSpatialLookup {
                                      t_rr_type type,
                                      e_side side = TOTAL_2D_SIDES[0]) const;
 
+    /* Returns the node list (indexed by ptc) at the given look-up coordinates, or an empty list if they are out of range.
+     * Unlike the public APIs, x and y are in the look-up convention (swapped for CHANX) */
+    vtr::array_view<const int> node_list(t_rr_type type,
+                                         size_t layer,
+                                         size_t x,
+                                         size_t y,
+                                         size_t side) const;
+
+    /* Restore the per-location node lists of a compressed look-up, so it can be modified */
+    void decompress();
+
     /* -- Internal data storage -- */
   private:
     /* Fast look-up: TODO: Should rework the data type. Currently it is based on a 3-dimensional array mater where some dimensions must always be accessed with a specific index. Such limitation should be overcome */
     t_rr_node_indices rr_node_indices_;
+
+    /* The look-up of a node type once compressed: the node list of location (layer, x, y, side) is
+     * nodes[list_begins[i], list_begins[i] + list_sizes[i]), with i the flat index of the location in a
+     * matrix of dimensions dim_sizes */
+    struct t_compressed_nodes {
+        std::array<size_t, 4> dim_sizes = {0, 0, 0, 0};
+        std::vector<uint32_t> list_begins;
+        std::vector<uint32_t> list_sizes;
+        std::vector<int> nodes;
+    };
+    std::array<t_compressed_nodes, NUM_RR_TYPES> compressed_nodes_;
+
+    /* Whether the look-up is held by compressed_nodes_ (rather than rr_node_indices_) */
+    bool is_compressed_ = false;
 };
 
 #endif
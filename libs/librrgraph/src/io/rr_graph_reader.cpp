@@ -1,7 +1,7 @@
 /* This function loads in a routing resource graph written in xml format
  * into vpr when the option --read_rr_graph <file name> is specified.
  * When it is not specified the build_rr_graph function is then called.
- * This is done using the libpugixml library. This is useful
+ * The XML file is streamed through (see rr_graph_xml_stream.h). This is useful
  * when specific routing resources should remain constant or when
  * some information left out in the architecture can be specified
  * in the routing resource graph. The routing resource graph file is
@@ -17,11 +17,14 @@
 
 #include "rr_graph_uxsdcxx_serializer.h"
 #include "rr_graph_uxsdcxx.h"
+#include "rr_graph_xml_stream.h"
 
 #include <fstream>
+#include <string>
 
+#include "vtr_digest.h"
 #include "vtr_time.h"
-#include "pugixml.hpp"
+#include "vtr_util.h"
 #include "pugixml_util.hpp"
 
 #ifdef VTR_ENABLE_CAPNPROTO
@@ -30,6 +33,28 @@
 #endif
 
 /************************ Subroutine definitions ****************************/
+
+#ifdef VTR_ENABLE_CAPNPROTO
+/* A binary rr graph which passed check_rr_graph() is recorded in a "<file>.checked" file
+ * next to it, holding the digest of the rr graph file and what the check depends on
+ * (architecture, grid and graph type). Loading the same unchanged rr graph file again for
+ * the same device then skips the check. */
+static std::string checked_rr_graph_record_name(const char* read_rr_graph_name) {
+    return std::string(read_rr_graph_name) + ".checked";
+}
+
+static std::string checked_rr_graph_record(const char* read_rr_graph_name,
+                                           const t_arch* arch,
+                                           const DeviceGrid& grid,
+                                           const t_graph_type graph_type,
+                                           bool is_flat) {
+    return vtr::string_fmt("%s arch=%s grid=%s:%zux%zux%d graph_type=%d flat=%d",
+                           vtr::secure_digest_file(read_rr_graph_name).c_str(),
+                           arch->architecture_id ? arch->architecture_id : "",
+                           grid.name().c_str(), grid.width(), grid.height(), grid.get_num_layers(),
+                           int(graph_type), int(is_flat));
+}
+#endif
 /* loads the given RR_graph file into the appropriate data structures
  * as specified by read_rr_graph_name. Set up correct routing data
  * structures as well*/
@@ -61,6 +86,21 @@ void load_rr_file(RRGraphBuilder* rr_graph_builder,
                   bool is_flat) {
     vtr::ScopedStartFinishTimer timer("Loading routing resource graph");
 
+#ifdef VTR_ENABLE_CAPNPROTO
+    std::string checked_record;
+    if (do_check_rr_graph && vtr::check_file_name_extension(read_rr_graph_name, ".bin")) {
+        checked_record = checked_rr_graph_record(read_rr_graph_name, arch, grid, graph_type, is_flat);
+
+        std::ifstream record_is(checked_rr_graph_record_name(read_rr_graph_name));
+        std::string previous_record;
+        if (std::getline(record_is, previous_record) && previous_record == checked_record) {
+            VTR_LOG("RR graph file '%s' unchanged since it was last checked, skipping check_rr_graph\n", read_rr_graph_name);
+            do_check_rr_graph = false;
+            checked_record.clear();
+        }
+    }
+#endif
+
     size_t num_segments = segment_inf.size();
     rr_graph_builder->reserve_segments(num_segments);
     for (size_t iseg = 0; iseg < num_segments; ++iseg) {
@@ -96,9 +136,7 @@ void load_rr_file(RRGraphBuilder* rr_graph_builder,
 
     if (vtr::check_file_name_extension(read_rr_graph_name, ".xml")) {
         try {
-            std::ifstream file(read_rr_graph_name);
-            void* context;
-            uxsd::load_rr_graph_xml(reader, context, read_rr_graph_name, file);
+            load_rr_graph_xml_stream(reader, read_rr_graph_name);
         } catch (pugiutil::XmlError& e) {
             vpr_throw(VPR_ERROR_ROUTE, read_rr_graph_name, e.line(), "%s", e.what());
         }
@@ -107,6 +145,12 @@ void load_rr_file(RRGraphBuilder* rr_graph_builder,
         MmapFile f(read_rr_graph_name);
         void* context;
         uxsd::load_rr_graph_capnp(reader, f.getData(), context, read_rr_graph_name);
+
+        //The rr graph passed the checks (best effort: the record is not written to read-only directories)
+        if (!checked_record.empty()) {
+            std::ofstream record_os(checked_rr_graph_record_name(read_rr_graph_name));
+            record_os << checked_record << "\n";
+        }
 #endif
     } else {
         VTR_LOG_WARN(
@@ -1801,6 +1801,11 @@ class RrGraphSerializer final : public uxsd::RrGraphBase<RrGraphContextTypes> {
         process_rr_node_indices();
 
         rr_graph_builder_->init_fan_in();
+
+        // The metadata is only looked up by a few tools (e.g. the bitstream generation), so
+        // leave it unsorted, but without the slack of its growth
+        rr_node_metadata_->shrink_to_fit();
+        rr_edge_metadata_->shrink_to_fit();
         
         std::vector<t_segment_inf> temp_rr_segs;
         temp_rr_segs.reserve(segment_inf_.size());
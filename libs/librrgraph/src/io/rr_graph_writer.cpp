@@ -12,6 +12,7 @@
 #include <limits>
 #include "rr_graph_uxsdcxx_serializer.h"
 #include "rr_graph_uxsdcxx.h"
+#include "rr_graph_xml_stream.h"
 #ifdef VTR_ENABLE_CAPNPROTO
 #    include "capnp/serialize.h"
 #    include "ndmatrix_serdes.h"
@@ -72,8 +73,12 @@ void write_rr_graph(RRGraphBuilder* rr_graph_builder,
         std::fstream fp;
         fp.open(file_name, std::fstream::out | std::fstream::trunc);
         fp.precision(std::numeric_limits<float>::max_digits10);
-        void* context;
-        uxsd::write_rr_graph_xml(reader, context, fp);
+        write_rr_graph_xml_parallel(reader,
+                                    *rr_graph_view,
+                                    rr_graph_builder->rr_node_metadata(),
+                                    rr_graph_builder->rr_edge_metadata(),
+                                    arch->strings,
+                                    fp);
 #ifdef VTR_ENABLE_CAPNPROTO
     } else if (vtr::check_file_name_extension(file_name, ".bin")) {
         ::capnp::MallocMessageBuilder builder;
@@ -0,0 +1,1190 @@
+#include "rr_graph_xml_stream.h"
+
+#include <algorithm>
+#include <bitset>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "pugixml.hpp"
+
+#include "rr_graph_uxsdcxx_serializer.h"
+#include "rr_graph_uxsdcxx.h"
+
+#include "vtr_assert.h"
+#include "vtr_util.h"
+
+namespace {
+
+/**
+ * @brief A pull parser of XML files
+ *
+ * The file is read in large blocks, and only the blocks holding the current event
+ * are kept in memory. The parser checks that the tags are well formed, but not that
+ * they are balanced: the loaders track the elements they are in.
+ */
+class XmlStreamParser {
+  public:
+    enum class e_event {
+        START_ELEMENT, ///<A start tag. An empty element (<a/>) is a START_ELEMENT followed by an END_ELEMENT
+        END_ELEMENT,
+        TEXT, ///<Character data (other than whitespace only) or a CDATA section
+        END_OF_FILE
+    };
+
+    XmlStreamParser(std::FILE* fp, const std::function<void(const char*)>* report_error)
+        : fp_(fp)
+        , report_error_(report_error)
+        , buffer_(2 * BLOCK_SIZE) {}
+
+    ///@brief Reads the next event. The strings of the previous event are invalidated
+    e_event next();
+
+    ///@brief Returns the name of the element of the current START_ELEMENT or END_ELEMENT
+    const char* name() const { return name_.c_str(); }
+
+    ///@brief Returns the number of attributes of the current START_ELEMENT
+    size_t num_attributes() const { return attributes_.size(); }
+    const char* attribute_name(size_t iattr) const { return &attribute_chars_[attributes_[iattr].first]; }
+    ///@brief Returns the value of an attribute, with the character and entity references replaced
+    const char* attribute_value(size_t iattr) const { return &attribute_chars_[attributes_[iattr].second]; }
+
+    ///@brief Returns the text of the current TEXT, with the character and entity references replaced
+    const char* text() const { return text_.c_str(); }
+
+    ///@brief Returns the line of the file where the current event starts
+    int line() const { return line_; }
+
+    /**
+     * @brief Returns the text of the element of the current START_ELEMENT, up to and including its end tag
+     *
+     * The end tag of the element becomes the current event.
+     */
+    std::string read_element();
+
+  private:
+    static constexpr size_t BLOCK_SIZE = 16 * 1024 * 1024;
+    static constexpr size_t NPOS = std::string::npos;
+
+    [[noreturn]] void error(const std::string& message) const {
+        uxsd::noreturn_report(report_error_, message.c_str());
+    }
+
+    ///@brief Reads the next block of the file, dropping the consumed part of the buffer (returns false at the end of the file)
+    bool read_block();
+
+    ///@brief Returns true if at least num_chars characters follow the current position, reading more of the file as needed
+    bool available(size_t num_chars);
+
+    ///@brief Returns true if prefix follows the current position
+    bool starts_with(const char* prefix);
+
+    ///@brief Returns the offset (from the current position) of the first occurrence of pattern at or after the offset from (or NPOS)
+    size_t find(const char* pattern, size_t from);
+
+    ///@brief Moves the current position num_chars characters forward
+    void consume(size_t num_chars);
+
+    void parse_start_tag();
+
+    std::FILE* fp_;
+    const std::function<void(const char*)>* report_error_;
+
+    std::vector<char> buffer_;
+    size_t pos_ = 0; ///<Current position in buffer_
+    size_t end_ = 0; ///<End of the data read in buffer_
+    bool eof_ = false;
+
+    int cur_line_ = 1; ///<Line of the current position
+    int line_ = 1;     ///<Line of the current event
+
+    std::string name_;
+    std::vector<std::pair<size_t, size_t>> attributes_; ///<Offsets of the names and values of the attributes in attribute_chars_
+    std::vector<char> attribute_chars_;
+    std::string text_;
+    bool pending_end_ = false; ///<The current START_ELEMENT is an empty element
+    size_t tag_start_ = 0;     ///<Position in buffer_ of the current start tag
+
+    bool capturing_ = false; ///<In read_element()
+    std::string capture_;
+    size_t capture_start_ = 0; ///<Position in buffer_ of the part of the element not copied to capture_ yet
+};
+
+bool is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+///@brief Appends the code point as UTF-8 to out
+template<typename Chars>
+void append_utf8(unsigned long code_point, Chars& out) {
+    if (code_point < 0x80) {
+        out.push_back(char(code_point));
+    } else if (code_point < 0x800) {
+        out.push_back(char(0xC0 | (code_point >> 6)));
+        out.push_back(char(0x80 | (code_point & 0x3F)));
+    } else if (code_point < 0x10000) {
+        out.push_back(char(0xE0 | (code_point >> 12)));
+        out.push_back(char(0x80 | ((code_point >> 6) & 0x3F)));
+        out.push_back(char(0x80 | (code_point & 0x3F)));
+    } else {
+        out.push_back(char(0xF0 | (code_point >> 18)));
+        out.push_back(char(0x80 | ((code_point >> 12) & 0x3F)));
+        out.push_back(char(0x80 | ((code_point >> 6) & 0x3F)));
+        out.push_back(char(0x80 | (code_point & 0x3F)));
+    }
+}
+
+/**
+ * @brief Appends the characters [begin, end) to out, replacing the character and entity references
+ *
+ * As in pugixml, the whitespace characters of attribute values are replaced by spaces,
+ * and unknown references are kept as they are.
+ */
+template<typename Chars>
+void append_decoded(const char* begin, const char* end, bool is_attribute, Chars& out) {
+    for (const char* p = begin; p != end;) {
+        if (*p != '&') {
+            out.push_back((is_attribute && is_space(*p)) ? ' ' : *p);
+            ++p;
+            continue;
+        }
+
+        const char* semicolon = std::find(p, std::min(p + 12, end), ';');
+        if (semicolon == std::min(p + 12, end)) {
+            out.push_back(*p++);
+            continue;
+        }
+
+        std::string reference(p + 1, semicolon);
+        if (reference == "lt") {
+            out.push_back('<');
+        } else if (reference == "gt") {
+            out.push_back('>');
+        } else if (reference == "amp") {
+            out.push_back('&');
+        } else if (reference == "quot") {
+            out.push_back('"');
+        } else if (reference == "apos") {
+            out.push_back('\'');
+        } else if (reference.size() > 1 && reference[0] == '#') {
+            bool is_hex = reference[1] == 'x';
+            char* number_end = nullptr;
+            unsigned long code_point = std::strtoul(reference.c_str() + (is_hex ? 2 : 1), &number_end, is_hex ? 16 : 10);
+            if (*number_end != '\0') {
+                out.push_back(*p++);
+                continue;
+            }
+            append_utf8(code_point, out);
+        } else {
+            out.push_back(*p++);
+            continue;
+        }
+        p = semicolon + 1;
+    }
+}
+
+bool XmlStreamParser::read_block() {
+    if (eof_) {
+        return false;
+    }
+
+    //Drop the consumed part of the buffer, keeping the part of the element being captured
+    if (capturing_) {
+        capture_.append(buffer_.data() + capture_start_, pos_ - capture_start_);
+        capture_start_ = 0;
+    }
+    std::memmove(buffer_.data(), buffer_.data() + pos_, end_ - pos_);
+    end_ -= pos_;
+    tag_start_ -= std::min(tag_start_, pos_);
+    pos_ = 0;
+
+    if (buffer_.size() - end_ < BLOCK_SIZE) {
+        //A single token longer than a block
+        buffer_.resize(end_ + BLOCK_SIZE);
+    }
+
+    size_t num_read = std::fread(buffer_.data() + end_, 1, buffer_.size() - end_, fp_);
+    if (num_read == 0) {
+        if (std::ferror(fp_)) {
+            error("Unable to read the file");
+        }
+        eof_ = true;
+        return false;
+    }
+    end_ += num_read;
+    return true;
+}
+
+bool XmlStreamParser::available(size_t num_chars) {
+    while (end_ - pos_ < num_chars) {
+        if (!read_block()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool XmlStreamParser::starts_with(const char* prefix) {
+    size_t length = std::strlen(prefix);
+    return available(length) && std::memcmp(buffer_.data() + pos_, prefix, length) == 0;
+}
+
+size_t XmlStreamParser::find(const char* pattern, size_t from) {
+    size_t length = std::strlen(pattern);
+    while (true) {
+        const char* begin = buffer_.data() + pos_ + std::min(from, end_ - pos_);
+        const char* end = buffer_.data() + end_;
+        const char* found = (length == 1) ? static_cast<const char*>(std::memchr(begin, pattern[0], end - begin))
+                                          : std::search(begin, end, pattern, pattern + length);
+        if (found && found != end) {
+            return found - (buffer_.data() + pos_);
+        }
+
+        //The last characters read may start an occurrence
+        size_t size = end_ - pos_;
+        if (size + 1 > length) {
+            from = std::max(from, size + 1 - length);
+        }
+        if (!read_block()) {
+            return NPOS;
+        }
+    }
+}
+
+void XmlStreamParser::consume(size_t num_chars) {
+    cur_line_ += std::count(buffer_.data() + pos_, buffer_.data() + pos_ + num_chars, '\n');
+    pos_ += num_chars;
+}
+
+XmlStreamParser::e_event XmlStreamParser::next() {
+    if (pending_end_) {
+        pending_end_ = false;
+        return e_event::END_ELEMENT;
+    }
+
+    while (true) {
+        if (!available(1)) {
+            return e_event::END_OF_FILE;
+        }
+
+        line_ = cur_line_;
+
+        if (buffer_[pos_] != '<') {
+            size_t length = find("<", 0);
+            if (length == NPOS) {
+                length = end_ - pos_;
+            }
+
+            const char* begin = buffer_.data() + pos_;
+            bool is_whitespace = std::all_of(begin, begin + length, is_space);
+            if (!is_whitespace) {
+                text_.clear();
+                append_decoded(begin, begin + length, false, text_);
+            }
+            consume(length);
+            if (is_whitespace) {
+                continue;
+            }
+            return e_event::TEXT;
+        }
+
+        if (starts_with("<!--")) {
+            size_t end = find("-->", 4);
+            if (end == NPOS) {
+                error("Unterminated comment");
+            }
+            consume(end + 3);
+        } else if (starts_with("<![CDATA[")) {
+            size_t end = find("]]>", 9);
+            if (end == NPOS) {
+                error("Unterminated CDATA section");
+            }
+            text_.assign(buffer_.data() + pos_ + 9, end - 9);
+            consume(end + 3);
+            return e_event::TEXT;
+        } else if (starts_with("<?")) {
+            size_t end = find("?>", 2);
+            if (end == NPOS) {
+                error("Unterminated processing instruction");
+            }
+            consume(end + 2);
+        } else if (starts_with("<!")) {
+            //Document type declaration (without an internal subset)
+            size_t end = find(">", 2);
+            if (end == NPOS) {
+                error("Unterminated declaration");
+            }
+            consume(end + 1);
+        } else if (starts_with("</")) {
+            size_t end = find(">", 2);
+            if (end == NPOS) {
+                error("Unterminated end tag");
+            }
+            const char* begin = buffer_.data() + pos_ + 2;
+            const char* name_end = begin + (end - 2);
+            while (name_end != begin && is_space(name_end[-1])) {
+                --name_end;
+            }
+            name_.assign(begin, name_end);
+            consume(end + 1);
+            return e_event::END_ELEMENT;
+        } else {
+            parse_start_tag();
+            return e_event::START_ELEMENT;
+        }
+    }
+}
+
+void XmlStreamParser::parse_start_tag() {
+    //Find the end of the tag (attribute values may contain '>')
+    size_t length = 1;
+    char quote = '\0';
+    while (true) {
+        if (pos_ + length == end_ && !read_block()) {
+            error("Unterminated start tag");
+        }
+        char c = buffer_[pos_ + length];
+        if (quote != '\0') {
+            if (c == quote) {
+                quote = '\0';
+            }
+        } else if (c == '"' || c == '\'') {
+            quote = c;
+        } else if (c == '>') {
+            break;
+        }
+        ++length;
+    }
+
+    const char* p = buffer_.data() + pos_ + 1;
+    const char* tag_end = buffer_.data() + pos_ + length;
+    bool is_empty = tag_end[-1] == '/';
+    if (is_empty) {
+        --tag_end;
+    }
+
+    const char* name_begin = p;
+    while (p != tag_end && !is_space(*p)) {
+        ++p;
+    }
+    if (p == name_begin) {
+        error("Invalid start tag");
+    }
+    name_.assign(name_begin, p);
+
+    attributes_.clear();
+    attribute_chars_.clear();
+    while (true) {
+        while (p != tag_end && is_space(*p)) {
+            ++p;
+        }
+        if (p == tag_end) {
+            break;
+        }
+
+        const char* attribute_begin = p;
+        while (p != tag_end && *p != '=' && !is_space(*p)) {
+            ++p;
+        }
+        size_t name_offset = attribute_chars_.size();
+        attribute_chars_.insert(attribute_chars_.end(), attribute_begin, p);
+        attribute_chars_.push_back('\0');
+
+        while (p != tag_end && is_space(*p)) {
+            ++p;
+        }
+        if (p == tag_end || *p != '=') {
+            error("Attribute " + std::string(&attribute_chars_[name_offset]) + " of <" + name_ + "> has no value");
+        }
+        ++p;
+        while (p != tag_end && is_space(*p)) {
+            ++p;
+        }
+        if (p == tag_end || (*p != '"' && *p != '\'')) {
+            error("Value of attribute " + std::string(&attribute_chars_[name_offset]) + " of <" + name_ + "> is not quoted");
+        }
+        const char* value_begin = p + 1;
+        const char* value_end = std::find(value_begin, tag_end, *p);
+        if (value_end == tag_end) {
+            error("Value of attribute " + std::string(&attribute_chars_[name_offset]) + " of <" + name_ + "> is not terminated");
+        }
+        size_t value_offset = attribute_chars_.size();
+        append_decoded(value_begin, value_end, true, attribute_chars_);
+        attribute_chars_.push_back('\0');
+        attributes_.emplace_back(name_offset, value_offset);
+
+        p = value_end + 1;
+    }
+
+    tag_start_ = pos_;
+    consume(length + 1);
+    pending_end_ = is_empty;
+}
+
+std::string XmlStreamParser::read_element() {
+    std::string element_name = name_;
+
+    capture_.clear();
+    capture_start_ = tag_start_;
+    capturing_ = true;
+    for (int depth = 1; depth > 0;) {
+        switch (next()) {
+            case e_event::START_ELEMENT:
+                ++depth;
+                break;
+            case e_event::END_ELEMENT:
+                --depth;
+                break;
+            case e_event::TEXT:
+                break;
+            case e_event::END_OF_FILE:
+                error("Unexpected end of file in <" + element_name + ">");
+        }
+    }
+    capture_.append(buffer_.data() + capture_start_, pos_ - capture_start_);
+    capturing_ = false;
+
+    return std::move(capture_);
+}
+
+/*
+ * Loading, through the same RrGraphSerializer calls as the uxsdcxx generated loader
+ */
+
+using t_report_error = const std::function<void(const char*)>*;
+
+///@brief Reads the next child element of <parent> (returns false at the end of <parent>)
+bool next_child(XmlStreamParser& parser, const char* parent, t_report_error report_error) {
+    switch (parser.next()) {
+        case XmlStreamParser::e_event::START_ELEMENT:
+            return true;
+        case XmlStreamParser::e_event::END_ELEMENT:
+            return false;
+        case XmlStreamParser::e_event::TEXT:
+            uxsd::noreturn_report(report_error, ("Unexpected text in <" + std::string(parent) + ">.").c_str());
+        case XmlStreamParser::e_event::END_OF_FILE:
+        default:
+            uxsd::noreturn_report(report_error, ("Unexpected end of file in <" + std::string(parent) + ">.").c_str());
+    }
+}
+
+///@brief Reads up to the end of the element <element>, which has no child elements, and returns its text
+std::string read_leaf(XmlStreamParser& parser, const char* element, t_report_error report_error) {
+    std::string text;
+    bool has_text = false;
+    while (true) {
+        switch (parser.next()) {
+            case XmlStreamParser::e_event::END_ELEMENT:
+                return text;
+            case XmlStreamParser::e_event::TEXT:
+                //As pugixml's child_value(), the first text of the element
+                if (!has_text) {
+                    text = parser.text();
+                    has_text = true;
+                }
+                break;
+            case XmlStreamParser::e_event::START_ELEMENT:
+                uxsd::noreturn_report(report_error, ("Unexpected child element in <" + std::string(element) + ">.").c_str());
+            case XmlStreamParser::e_event::END_OF_FILE:
+                uxsd::noreturn_report(report_error, ("Unexpected end of file in <" + std::string(element) + ">.").c_str());
+        }
+    }
+}
+
+void report_duplicate_attribute(const char* attribute, const char* element, t_report_error report_error) {
+    uxsd::noreturn_report(report_error, ("Duplicate attribute " + std::string(attribute) + " in <" + element + ">.").c_str());
+}
+
+void report_duplicate_element(const char* child, const char* element, t_report_error report_error) {
+    uxsd::noreturn_report(report_error, ("Duplicate element " + std::string(child) + " in <" + element + ">.").c_str());
+}
+
+void load_metadata(XmlStreamParser& parser, RrGraphSerializer& out, MetadataBind& context, t_report_error report_error) {
+    if (parser.num_attributes() != 0) {
+        uxsd::noreturn_report(report_error, "Unexpected attribute in <metadata>.");
+    }
+
+    //Collected first, so they can be preallocated
+    struct t_meta {
+        bool has_name = false;
+        std::string name;
+        std::string value;
+    };
+    std::vector<t_meta> metas;
+    while (next_child(parser, "metadata", report_error)) {
+        uxsd::lex_node_t_metadata(parser.name(), report_error);
+
+        t_meta meta;
+        for (size_t iattr = 0; iattr < parser.num_attributes(); ++iattr) {
+            switch (uxsd::lex_attr_t_meta(parser.attribute_name(iattr), report_error)) {
+                case uxsd::atok_t_meta::NAME:
+                    meta.has_name = true;
+                    meta.name = parser.attribute_value(iattr);
+                    break;
+                default:
+                    break; /* Not possible. */
+            }
+        }
+        meta.value = read_leaf(parser, "meta", report_error);
+        metas.push_back(std::move(meta));
+    }
+
+    out.preallocate_metadata_meta(context, metas.size());
+    for (const t_meta& meta : metas) {
+        auto child_context = out.add_metadata_meta(context);
+        if (meta.has_name) {
+            out.set_meta_name(meta.name.c_str(), child_context);
+        }
+        out.set_meta_value(meta.value.c_str(), child_context);
+        out.finish_metadata_meta(child_context);
+    }
+}
+
+void load_node_loc(XmlStreamParser& parser, RrGraphSerializer& out, int& context, t_report_error report_error) {
+    int ptc = 0;
+    int xhigh = 0;
+    int xlow = 0;
+    int yhigh = 0;
+    int ylow = 0;
+    std::bitset<8> astate = 0;
+    for (size_t iattr = 0; iattr < parser.num_attributes(); ++iattr) {
+        uxsd::atok_t_node_loc in = uxsd::lex_attr_t_node_loc(parser.attribute_name(iattr), report_error);
+        if (astate[(int)in]) {
+            report_duplicate_attribute(parser.attribute_name(iattr), "node_loc", report_error);
+        }
+        astate[(int)in] = 1;
+
+        const char* value = parser.attribute_value(iattr);
+        switch (in) {
+            case uxsd::atok_t_node_loc::PTC:
+                ptc = uxsd::load_int(value, report_error);
+                break;
+            case uxsd::atok_t_node_loc::XHIGH:
+                xhigh = uxsd::load_int(value, report_error);
+                break;
+            case uxsd::atok_t_node_loc::XLOW:
+                xlow = uxsd::load_int(value, report_error);
+                break;
+            case uxsd::atok_t_node_loc::YHIGH:
+                yhigh = uxsd::load_int(value, report_error);
+                break;
+            case uxsd::atok_t_node_loc::YLOW:
+                ylow = uxsd::load_int(value, report_error);
+                break;
+            default:
+                break; /* Set after element init */
+        }
+    }
+    std::bitset<8> test_astate = astate | std::bitset<8>(0b00001101);
+    if (!test_astate.all()) {
+        uxsd::attr_error(test_astate, uxsd::atok_lookup_t_node_loc, report_error);
+    }
+
+    auto child_context = out.init_node_loc(context, ptc, xhigh, xlow, yhigh, ylow);
+    for (size_t iattr = 0; iattr < parser.num_attributes(); ++iattr) {
+        const char* value = parser.attribute_value(iattr);
+        switch (uxsd::lex_attr_t_node_loc(parser.attribute_name(iattr), report_error)) {
+            case uxsd::atok_t_node_loc::LAYER:
+                out.set_node_loc_layer(uxsd::load_int(value, report_error), child_context);
+                break;
+            case uxsd::atok_t_node_loc::SIDE:
+                out.set_node_loc_side(uxsd::lex_enum_loc_side(value, true, report_error), child_context);
+                break;
+            case uxsd::atok_t_node_loc::TWIST:
+                out.set_node_loc_twist(uxsd::load_int(value, report_error), child_context);
+                break;
+            default:
+                break; /* Already set */
+        }
+    }
+    read_leaf(parser, "node_loc", report_error);
+    out.finish_node_loc(child_context);
+}
+
+void load_node_timing(XmlStreamParser& parser, RrGraphSerializer& out, int& context, t_report_error report_error) {
+    float C = 0.;
+    float R = 0.;
+    std::bitset<2> astate = 0;
+    for (size_t iattr = 0; iattr < parser.num_attributes(); ++iattr) {
+        uxsd::atok_t_node_timing in = uxsd::lex_attr_t_node_timing(parser.attribute_name(iattr), report_error);
+        if (astate[(int)in]) {
+            report_duplicate_attribute(parser.attribute_name(iattr), "node_timing", report_error);
+        }
+        astate[(int)in] = 1;
+
+        switch (in) {
+            case uxsd::atok_t_node_timing::C:
+                C = uxsd::load_float(parser.attribute_value(iattr), report_error);
+                break;
+            case uxsd::atok_t_node_timing::R:
+                R = uxsd::load_float(parser.attribute_value(iattr), report_error);
+                break;
+            default:
+                break; /* Not possible. */
+        }
+    }
+    if (!astate.all()) {
+        uxsd::attr_error(astate, uxsd::atok_lookup_t_node_timing, report_error);
+    }
+
+    auto child_context = out.init_node_timing(context, C, R);
+    read_leaf(parser, "node_timing", report_error);
+    out.finish_node_timing(child_context);
+}
+
+void load_node_segment(XmlStreamParser& parser, RrGraphSerializer& out, int& context, t_report_error report_error) {
+    int segment_id = 0;
+    std::bitset<1> astate = 0;
+    for (size_t iattr = 0; iattr < parser.num_attributes(); ++iattr) {
+        uxsd::atok_t_node_segment in = uxsd::lex_attr_t_node_segment(parser.attribute_name(iattr), report_error);
+        if (astate[(int)in]) {
+            report_duplicate_attribute(parser.attribute_name(iattr), "node_segment", report_error);
+        }
+        astate[(int)in] = 1;
+        segment_id = uxsd::load_int(parser.attribute_value(iattr), report_error);
+    }
+    if (!astate.all()) {
+        uxsd::attr_error(astate, uxsd::atok_lookup_t_node_segment, report_error);
+    }
+
+    auto child_context = out.init_node_segment(context, segment_id);
+    read_leaf(parser, "node_segment", report_error);
+    out.finish_node_segment(child_context);
+}
+
+void load_node(XmlStreamParser& parser, RrGraphSerializer& out, void*& context, t_report_error report_error) {
+    unsigned int capacity = 0;
+    unsigned int id = 0;
+    uxsd::enum_node_type type = uxsd::enum_node_type::UXSD_INVALID;
+    std::bitset<6> astate = 0;
+    for (size_t iattr = 0; iattr < parser.num_attributes(); ++iattr) {
+        uxsd::atok_t_node in = uxsd::lex_attr_t_node(parser.attribute_name(iattr), report_error);
+        if (astate[(int)in]) {
+            report_duplicate_attribute(parser.attribute_name(iattr), "node", report_error);
+        }
+        astate[(int)in] = 1;
+
+        const char* value = parser.attribute_value(iattr);
+        switch (in) {
+            case uxsd::atok_t_node::CAPACITY:
+                capacity = uxsd::load_unsigned_int(value, report_error);
+                break;
+            case uxsd::atok_t_node::ID:
+                id = uxsd::load_unsigned_int(value, report_error);
+                break;
+            case uxsd::atok_t_node::TYPE:
+                type = uxsd::lex_enum_node_type(value, true, report_error);
+                break;
+            default:
+                break; /* Set after element init */
+        }
+    }
+    std::bitset<6> test_astate = astate | std::bitset<6>(0b010110);
+    if (!test_astate.all()) {
+        uxsd::attr_error(test_astate, uxsd::atok_lookup_t_node, report_error);
+    }
+
+    auto child_context = out.add_rr_nodes_node(context, capacity, id, type);
+    for (size_t iattr = 0; iattr < parser.num_attributes(); ++iattr) {
+        const char* value = parser.attribute_value(iattr);
+        switch (uxsd::lex_attr_t_node(parser.attribute_name(iattr), report_error)) {
+            case uxsd::atok_t_node::CLK_RES_TYPE:
+                out.set_node_clk_res_type(uxsd::lex_enum_node_clk_res_type(value, true, report_error), child_context);
+                break;
+            case uxsd::atok_t_node::DIRECTION:
+                out.set_node_direction(uxsd::lex_enum_node_direction(value, true, report_error), child_context);
+                break;
+            case uxsd::atok_t_node::NAME:
+                out.set_node_name(value, child_context);
+                break;
+            default:
+                break; /* Already set */
+        }
+    }
+
+    std::bitset<4> gstate = 0;
+    while (next_child(parser, "node", report_error)) {
+        uxsd::gtok_t_node in = uxsd::lex_node_t_node(parser.name(), report_error);
+        if (gstate[(int)in]) {
+            report_duplicate_element(parser.name(), "node", report_error);
+        }
+        gstate[(int)in] = 1;
+
+        switch (in) {
+            case uxsd::gtok_t_node::LOC:
+                load_node_loc(parser, out, child_context, report_error);
+                break;
+            case uxsd::gtok_t_node::TIMING:
+                load_node_timing(parser, out, child_context, report_error);
+                break;
+            case uxsd::gtok_t_node::SEGMENT:
+                load_node_segment(parser, out, child_context, report_error);
+                break;
+            case uxsd::gtok_t_node::METADATA: {
+                auto metadata_context = out.init_node_metadata(child_context);
+                load_metadata(parser, out, metadata_context, report_error);
+                out.finish_node_metadata(metadata_context);
+                break;
+            }
+            default:
+                break; /* Not possible. */
+        }
+    }
+    std::bitset<4> test_gstate = gstate | std::bitset<4>(0b1110);
+    if (!test_gstate.all()) {
+        uxsd::all_error(test_gstate, uxsd::gtok_lookup_t_node, report_error);
+    }
+
+    out.finish_rr_nodes_node(child_context);
+}
+
+void load_rr_nodes(XmlStreamParser& parser, RrGraphSerializer& out, void*& context, t_report_error report_error) {
+    if (parser.num_attributes() != 0) {
+        uxsd::noreturn_report(report_error, "Unexpected attribute in <rr_nodes>.");
+    }
+
+    while (next_child(parser, "rr_nodes", report_error)) {
+        uxsd::lex_node_t_rr_nodes(parser.name(), report_error);
+        load_node(parser, out, context, report_error);
+    }
+}
+
+void load_edge(XmlStreamParser& parser, RrGraphSerializer& out, void*& context, t_report_error report_error) {
+    unsigned int sink_node = 0;
+    unsigned int src_node = 0;
+    unsigned int switch_id = 0;
+    std::bitset<3> astate = 0;
+    for (size_t iattr = 0; iattr < parser.num_attributes(); ++iattr) {
+        uxsd::atok_t_edge in = uxsd::lex_attr_t_edge(parser.attribute_name(iattr), report_error);
+        if (astate[(int)in]) {
+            report_duplicate_attribute(parser.attribute_name(iattr), "edge", report_error);
+        }
+        astate[(int)in] = 1;
+
+        const char* value = parser.attribute_value(iattr);
+        switch (in) {
+            case uxsd::atok_t_edge::SINK_NODE:
+                sink_node = uxsd::load_unsigned_int(value, report_error);
+                break;
+            case uxsd::atok_t_edge::SRC_NODE:
+                src_node = uxsd::load_unsigned_int(value, report_error);
+                break;
+            case uxsd::atok_t_edge::SWITCH_ID:
+                switch_id = uxsd::load_unsigned_int(value, report_error);
+                break;
+            default:
+                break; /* Not possible. */
+        }
+    }
+    if (!astate.all()) {
+        uxsd::attr_error(astate, uxsd::atok_lookup_t_edge, report_error);
+    }
+
+    auto child_context = out.add_rr_edges_edge(context, sink_node, src_node, switch_id);
+
+    std::bitset<1> gstate = 0;
+    while (next_child(parser, "edge", report_error)) {
+        uxsd::lex_node_t_edge(parser.name(), report_error);
+        if (gstate[0]) {
+            report_duplicate_element(parser.name(), "edge", report_error);
+        }
+        gstate[0] = 1;
+
+        auto metadata_context = out.init_edge_metadata(child_context);
+        load_metadata(parser, out, metadata_context, report_error);
+        out.finish_edge_metadata(metadata_context);
+    }
+
+    out.finish_rr_edges_edge(child_context);
+}
+
+void load_rr_edges(XmlStreamParser& parser, RrGraphSerializer& out, void*& context, t_report_error report_error) {
+    if (parser.num_attributes() != 0) {
+        uxsd::noreturn_report(report_error, "Unexpected attribute in <rr_edges>.");
+    }
+
+    while (next_child(parser, "rr_edges", report_error)) {
+        uxsd::lex_node_t_rr_edges(parser.name(), report_error);
+        load_edge(parser, out, context, report_error);
+    }
+}
+
+/**
+ * @brief Loads the (small) element of the current START_ELEMENT through a DOM
+ *
+ * load(root, report_error, offset_debug) is the uxsdcxx generated loader of the element.
+ */
+template<typename LoadFunction>
+void load_element_dom(XmlStreamParser& parser, RrGraphSerializer& out, const char* filename, const LoadFunction& load) {
+    int element_line = parser.line();
+    std::string element = parser.read_element();
+
+    ptrdiff_t offset_debug = 0;
+    std::function<void(const char*)> report_error = [&](const char* message) {
+        ptrdiff_t offset = std::min<ptrdiff_t>(std::max<ptrdiff_t>(offset_debug, 0), element.size());
+        int line = element_line + std::count(element.begin(), element.begin() + offset, '\n');
+        out.error_encountered(filename, line, message);
+        // If error_encountered didn't throw, throw now to unwind.
+        throw std::runtime_error(message);
+    };
+
+    pugi::xml_document doc;
+    pugi::xml_parse_result result = doc.load_buffer(element.data(), element.size());
+    if (!result) {
+        offset_debug = result.offset;
+        report_error((std::string("Unable to load XML file '") + filename + "', " + result.description()).c_str());
+    }
+
+    load(doc.first_child(), &report_error, &offset_debug);
+}
+
+void load_rr_graph(XmlStreamParser& parser, RrGraphSerializer& out, const char* filename, t_report_error report_error) {
+    void* context = nullptr;
+
+    for (size_t iattr = 0; iattr < parser.num_attributes(); ++iattr) {
+        const char* value = parser.attribute_value(iattr);
+        switch (uxsd::lex_attr_t_rr_graph(parser.attribute_name(iattr), report_error)) {
+            case uxsd::atok_t_rr_graph::TOOL_COMMENT:
+                out.set_rr_graph_tool_comment(value, context);
+                break;
+            case uxsd::atok_t_rr_graph::TOOL_NAME:
+                out.set_rr_graph_tool_name(value, context);
+                break;
+            case uxsd::atok_t_rr_graph::TOOL_VERSION:
+                out.set_rr_graph_tool_version(value, context);
+                break;
+            default:
+                break; /* Not possible. */
+        }
+    }
+
+    std::bitset<7> gstate = 0;
+    while (next_child(parser, "rr_graph", report_error)) {
+        uxsd::gtok_t_rr_graph in = uxsd::lex_node_t_rr_graph(parser.name(), report_error);
+        if (gstate[(int)in]) {
+            report_duplicate_element(parser.name(), "rr_graph", report_error);
+        }
+        gstate[(int)in] = 1;
+
+        switch (in) {
+            case uxsd::gtok_t_rr_graph::CHANNELS: {
+                auto child_context = out.init_rr_graph_channels(context);
+                load_element_dom(parser, out, filename, [&](const pugi::xml_node& root, t_report_error dom_report_error, ptrdiff_t* offset_debug) {
+                    uxsd::load_channels(root, out, child_context, dom_report_error, offset_debug);
+                });
+                out.finish_rr_graph_channels(child_context);
+                break;
+            }
+            case uxsd::gtok_t_rr_graph::SWITCHES: {
+                auto child_context = out.init_rr_graph_switches(context);
+                load_element_dom(parser, out, filename, [&](const pugi::xml_node& root, t_report_error dom_report_error, ptrdiff_t* offset_debug) {
+                    uxsd::load_switches(root, out, child_context, dom_report_error, offset_debug);
+                });
+                out.finish_rr_graph_switches(child_context);
+                break;
+            }
+            case uxsd::gtok_t_rr_graph::SEGMENTS: {
+                auto child_context = out.init_rr_graph_segments(context);
+                load_element_dom(parser, out, filename, [&](const pugi::xml_node& root, t_report_error dom_report_error, ptrdiff_t* offset_debug) {
+                    uxsd::load_segments(root, out, child_context, dom_report_error, offset_debug);
+                });
+                out.finish_rr_graph_segments(child_context);
+                break;
+            }
+            case uxsd::gtok_t_rr_graph::BLOCK_TYPES: {
+                auto child_context = out.init_rr_graph_block_types(context);
+                load_element_dom(parser, out, filename, [&](const pugi::xml_node& root, t_report_error dom_report_error, ptrdiff_t* offset_debug) {
+                    uxsd::load_block_types(root, out, child_context, dom_report_error, offset_debug);
+                });
+                out.finish_rr_graph_block_types(child_context);
+                break;
+            }
+            case uxsd::gtok_t_rr_graph::GRID: {
+                auto child_context = out.init_rr_graph_grid(context);
+                load_element_dom(parser, out, filename, [&](const pugi::xml_node& root, t_report_error dom_report_error, ptrdiff_t* offset_debug) {
+                    uxsd::load_grid_locs(root, out, child_context, dom_report_error, offset_debug);
+                });
+                out.finish_rr_graph_grid(child_context);
+                break;
+            }
+            case uxsd::gtok_t_rr_graph::RR_NODES: {
+                auto child_context = out.init_rr_graph_rr_nodes(context);
+                load_rr_nodes(parser, out, child_context, report_error);
+                out.finish_rr_graph_rr_nodes(child_context);
+                break;
+            }
+            case uxsd::gtok_t_rr_graph::RR_EDGES: {
+                auto child_context = out.init_rr_graph_rr_edges(context);
+                load_rr_edges(parser, out, child_context, report_error);
+                out.finish_rr_graph_rr_edges(child_context);
+                break;
+            }
+            default:
+                break; /* Not possible. */
+        }
+    }
+    if (!gstate.all()) {
+        uxsd::all_error(gstate, uxsd::gtok_lookup_t_rr_graph, report_error);
+    }
+}
+
+/*
+ * Writing
+ */
+
+///@brief Number of nodes formatted together by a worker thread
+constexpr size_t NODES_PER_CHUNK = 16384;
+
+///@brief Number of nodes whose edges are formatted together by a worker thread
+constexpr size_t EDGE_SOURCE_NODES_PER_CHUNK = 2048;
+
+/**
+ * @brief Writes the items [0..num_items-1] to os, formatting chunks of chunk_size items on worker threads
+ *
+ * format(chunk_os, begin, end) formats the items [begin, end) to chunk_os. The chunks are written
+ * in order, and only a few chunks per thread are held in memory at once.
+ */
+template<typename FormatFunction>
+void write_in_parallel(std::ostream& os, size_t num_items, size_t chunk_size, const FormatFunction& format) {
+    const std::ios_base::fmtflags flags = os.flags();
+    const std::streamsize precision = os.precision();
+    const size_t max_pending_chunks = 2 * std::max(1u, std::thread::hardware_concurrency());
+
+    std::deque<std::future<std::string>> pending_chunks;
+    size_t next_item = 0;
+    while (next_item < num_items || !pending_chunks.empty()) {
+        while (next_item < num_items && pending_chunks.size() < max_pending_chunks) {
+            size_t begin = next_item;
+            size_t end = std::min(begin + chunk_size, num_items);
+            pending_chunks.push_back(std::async(std::launch::async, [&format, flags, precision, begin, end]() {
+                std::ostringstream chunk_os;
+                chunk_os.flags(flags);
+                chunk_os.precision(precision);
+                format(chunk_os, begin, end);
+                return chunk_os.str();
+            }));
+            next_item = end;
+        }
+
+        std::string chunk = pending_chunks.front().get();
+        pending_chunks.pop_front();
+        os.write(chunk.data(), chunk.size());
+    }
+}
+
+/*
+ * The generated writer gets the metadata names and values through the serializer,
+ * which returns them in a shared buffer, so the workers read the metadata themselves.
+ */
+void write_metadata(const t_metadata_dict& metadata, const vtr::string_internment& strings, std::ostream& os) {
+    std::string name;
+    std::string value;
+
+    os << "<metadata>\n";
+    for (const auto& meta : metadata) {
+        VTR_ASSERT(meta.second.size() == 1);
+        meta.first.get(&strings, &name);
+        meta.second[0].as_string().get(&strings, &value);
+        os << "<meta name=\"" << name << "\">" << value << "</meta>\n";
+    }
+    os << "</metadata>\n";
+}
+
+void write_nodes(RrGraphSerializer& in,
+                 const MetadataStorage<int>& rr_node_metadata,
+                 const vtr::string_internment& strings,
+                 std::ostream& os,
+                 size_t begin,
+                 size_t end) {
+    void* context = nullptr;
+    for (size_t inode = begin; inode < end; ++inode) {
+        const t_rr_node node = in.get_rr_nodes_node(inode, context);
+
+        os << "<node";
+        os << " capacity=\"" << in.get_node_capacity(node) << "\"";
+        if ((bool)in.get_node_clk_res_type(node))
+            os << " clk_res_type=\"" << uxsd::lookup_node_clk_res_type[(int)in.get_node_clk_res_type(node)] << "\"";
+        if ((bool)in.get_node_direction(node))
+            os << " direction=\"" << uxsd::lookup_node_direction[(int)in.get_node_direction(node)] << "\"";
+        os << " id=\"" << in.get_node_id(node) << "\"";
+        if ((bool)in.get_node_name(node))
+            os << " name=\"" << in.get_node_name(node) << "\"";
+        os << " type=\"" << uxsd::lookup_node_type[(int)in.get_node_type(node)] << "\"";
+        os << ">";
+
+        os << "<loc";
+        os << " layer=\"" << in.get_node_loc_layer(node) << "\"";
+        os << " ptc=\"" << in.get_node_loc_ptc(node) << "\"";
+        if ((bool)in.get_node_loc_side(node))
+            os << " side=\"" << uxsd::lookup_loc_side[(int)in.get_node_loc_side(node)] << "\"";
+        if ((bool)in.get_node_loc_twist(node))
+            os << " twist=\"" << in.get_node_loc_twist(node) << "\"";
+        os << " xhigh=\"" << in.get_node_loc_xhigh(node) << "\"";
+        os << " xlow=\"" << in.get_node_loc_xlow(node) << "\"";
+        os << " yhigh=\"" << in.get_node_loc_yhigh(node) << "\"";
+        os << " ylow=\"" << in.get_node_loc_ylow(node) << "\"";
+        os << "/>\n";
+
+        if (in.has_node_timing(node)) {
+            os << "<timing";
+            os << " C=\"" << in.get_node_timing_C(node) << "\"";
+            os << " R=\"" << in.get_node_timing_R(node) << "\"";
+            os << "/>\n";
+        }
+
+        if (in.has_node_segment(node)) {
+            os << "<segment";
+            os << " segment_id=\"" << in.get_node_segment_segment_id(node) << "\"";
+            os << "/>\n";
+        }
+
+        auto metadata = rr_node_metadata.find(in.get_node_id(node));
+        if (metadata != rr_node_metadata.end()) {
+            write_metadata(metadata->second, strings, os);
+        }
+
+        os << "</node>\n";
+    }
+}
+
+void write_edges(const RRGraphView& rr_graph,
+                 const MetadataStorage<std::tuple<int, int, short>>& rr_edge_metadata,
+                 const vtr::string_internment& strings,
+                 std::ostream& os,
+                 size_t begin,
+                 size_t end) {
+    //In the order of the serializer's EdgeWalker: by source node, then by edge
+    for (size_t src_node = begin; src_node < end; ++src_node) {
+        RRNodeId src_node_id(src_node);
+        for (t_edge_size iedge = 0; iedge < rr_graph.num_edges(src_node_id); ++iedge) {
+            size_t sink_node = size_t(rr_graph.edge_sink_node(src_node_id, iedge));
+            short switch_id = rr_graph.edge_switch(src_node_id, iedge);
+
+            os << "<edge";
+            os << " sink_node=\"" << (unsigned int)sink_node << "\"";
+            os << " src_node=\"" << (unsigned int)src_node << "\"";
+            os << " switch_id=\"" << (unsigned int)switch_id << "\"";
+            os << ">";
+
+            auto metadata = rr_edge_metadata.find(std::make_tuple((int)src_node, (int)sink_node, switch_id));
+            if (metadata != rr_edge_metadata.end()) {
+                write_metadata(metadata->second, strings, os);
+            }
+
+            os << "</edge>\n";
+        }
+    }
+}
+
+} // namespace
+
+void load_rr_graph_xml_stream(RrGraphSerializer& reader, const char* filename) {
+    std::unique_ptr<std::FILE, int (*)(std::FILE*)> fp(vtr::fopen(filename, "rb"), std::fclose);
+
+    std::function<void(const char*)> report_error;
+    XmlStreamParser parser(fp.get(), &report_error);
+    report_error = [&](const char* message) {
+        reader.error_encountered(filename, parser.line(), message);
+        // If error_encountered didn't throw, throw now to unwind.
+        throw std::runtime_error(message);
+    };
+
+    reader.start_load(&report_error);
+
+    while (true) {
+        XmlStreamParser::e_event event = parser.next();
+        if (event == XmlStreamParser::e_event::END_OF_FILE) {
+            break;
+        } else if (event == XmlStreamParser::e_event::TEXT) {
+            report_error("Unexpected text outside of the root element");
+        } else if (event == XmlStreamParser::e_event::END_ELEMENT) {
+            report_error(("Unexpected end tag </" + std::string(parser.name()) + ">").c_str());
+        } else if (std::strcmp(parser.name(), "rr_graph") != 0) {
+            report_error(("Invalid root-level element " + std::string(parser.name())).c_str());
+        }
+
+        /* If errno is set up to this point, it messes with strtol errno checking. */
+        errno = 0;
+        load_rr_graph(parser, reader, filename, &report_error);
+    }
+
+    reader.finish_load();
+}
+
+void write_rr_graph_xml_parallel(RrGraphSerializer& writer,
+                                 const RRGraphView& rr_graph,
+                                 const MetadataStorage<int>& rr_node_metadata,
+                                 const MetadataStorage<std::tuple<int, int, short>>& rr_edge_metadata,
+                                 const vtr::string_internment& strings,
+                                 std::ostream& os) {
+    void* context = nullptr;
+
+    writer.start_write();
+    os << "<rr_graph";
+    if ((bool)writer.get_rr_graph_tool_comment(context))
+        os << " tool_comment=\"" << writer.get_rr_graph_tool_comment(context) << "\"";
+    if ((bool)writer.get_rr_graph_tool_name(context))
+        os << " tool_name=\"" << writer.get_rr_graph_tool_name(context) << "\"";
+    if ((bool)writer.get_rr_graph_tool_version(context))
+        os << " tool_version=\"" << writer.get_rr_graph_tool_version(context) << "\"";
+    os << ">\n";
+
+    {
+        auto child_context = writer.get_rr_graph_channels(context);
+        os << "<channels>\n";
+        uxsd::write_channels(writer, os, child_context);
+        os << "</channels>\n";
+    }
+    {
+        auto child_context = writer.get_rr_graph_switches(context);
+        os << "<switches>\n";
+        uxsd::write_switches(writer, os, child_context);
+        os << "</switches>\n";
+    }
+    {
+        auto child_context = writer.get_rr_graph_segments(context);
+        os << "<segments>\n";
+        uxsd::write_segments(writer, os, child_context);
+        os << "</segments>\n";
+    }
+    {
+        auto child_context = writer.get_rr_graph_block_types(context);
+        os << "<block_types>\n";
+        uxsd::write_block_types(writer, os, child_context);
+        os << "</block_types>\n";
+    }
+    {
+        auto child_context = writer.get_rr_graph_grid(context);
+        os << "<grid>\n";
+        uxsd::write_grid_locs(writer, os, child_context);
+        os << "</grid>\n";
+    }
+
+    //The metadata lookups are built on first use, so build them before the workers use them
+    rr_node_metadata.size();
+    rr_edge_metadata.size();
+
+    size_t num_nodes = writer.num_rr_nodes_node(context);
+
+    os << "<rr_nodes>\n";
+    write_in_parallel(os, num_nodes, NODES_PER_CHUNK, [&](std::ostream& chunk_os, size_t begin, size_t end) {
+        write_nodes(writer, rr_node_metadata, strings, chunk_os, begin, end);
+    });
+    os << "</rr_nodes>\n";
+
+    os << "<rr_edges>\n";
+    write_in_parallel(os, num_nodes, EDGE_SOURCE_NODES_PER_CHUNK, [&](std::ostream& chunk_os, size_t begin, size_t end) {
+        write_edges(rr_graph, rr_edge_metadata, strings, chunk_os, begin, end);
+    });
+    os << "</rr_edges>\n";
+
+    os << "</rr_graph>\n";
+    writer.finish_write();
+}
@@ -0,0 +1,47 @@
+#ifndef RR_GRAPH_XML_STREAM_H
+#define RR_GRAPH_XML_STREAM_H
+
+/*
+ * Streaming loading and parallel writing of rr graphs in the XML format
+ *
+ * The XML file of the rr graph of a large device is mostly its <rr_nodes> and
+ * <rr_edges> sections. The loader streams through the file rather than building
+ * the DOM of the whole file (which takes several times the size of the file),
+ * and the writer formats the nodes and edges on worker threads. */
+
+#include <iostream>
+#include <tuple>
+
+#include "physical_types.h"
+#include "metadata_storage.h"
+#include "rr_graph_view.h"
+#include "vtr_string_interning.h"
+
+class RrGraphSerializer;
+
+/**
+ * @brief Loads the rr graph in the XML file filename through reader
+ *
+ * The file is read in blocks by a pull parser: the nodes and edges are handed to
+ * reader as they are read, and only the other (small) sections of the file are
+ * parsed into a DOM, and loaded by the uxsdcxx generated functions. reader sees
+ * the same calls as from uxsd::load_rr_graph_xml(), except for the preallocations
+ * of the nodes and edges (whose numbers are only known once they are read).
+ */
+void load_rr_graph_xml_stream(RrGraphSerializer& reader, const char* filename);
+
+/**
+ * @brief Writes the rr graph of writer to os in the XML format
+ *
+ * The nodes and edges are formatted in chunks on worker threads, and the chunks
+ * are written in order, so the output is the same as from uxsd::write_rr_graph_xml().
+ * The output is formatted with the flags and precision of os.
+ */
+void write_rr_graph_xml_parallel(RrGraphSerializer& writer,
+                                 const RRGraphView& rr_graph,
+                                 const MetadataStorage<int>& rr_node_metadata,
+                                 const MetadataStorage<std::tuple<int, int, short>>& rr_edge_metadata,
+                                 const vtr::string_internment& strings,
+                                 std::ostream& os);
+
+#endif /* RR_GRAPH_XML_STREAM_H */
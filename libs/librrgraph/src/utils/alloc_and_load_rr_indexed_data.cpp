@@ -1,7 +1,11 @@
+#include <algorithm>
+#include <atomic>
 #include <cmath> /* Needed only for sqrt call (remove if sqrt removed) */
 #include <fstream>
+#include <future>
 #include <iomanip>
 #include <sstream>
+#include <thread>
 #include <queue> /* Needed for ortho_Cost_index calculation*/
 
 #include "alloc_and_load_rr_indexed_data.h"
@@ -33,6 +37,8 @@ static void calculate_average_switch(const RRGraphView& rr_graph, int inode, dou
 
 static void fixup_rr_indexed_data_T_values(vtr::vector<RRIndexedDataId, t_rr_indexed_data>& rr_indexed_data, size_t num_segment);
 
+static std::string rr_indexed_data_delays_key(const RRGraphView& rr_graph, const DeviceGrid& grid, const std::vector<t_segment_inf>& segment_inf_x, const std::vector<t_segment_inf>& segment_inf_y, size_t num_rr_indexed_data);
+
 static std::vector<size_t> count_rr_segment_types(const RRGraphView& rr_graph, const vtr::vector<RRIndexedDataId, t_rr_indexed_data>& rr_indexed_data);
 
 static void print_rr_index_info(const vtr::vector<RRIndexedDataId, t_rr_indexed_data>& rr_indexed_data, const char* fname, const std::vector<t_segment_inf>& segment_inf, size_t y_chan_cost_offset);
@@ -61,7 +67,8 @@ void alloc_and_load_rr_indexed_data(const RRGraphView& rr_graph,
                                     int wire_to_ipin_switch,
                                     enum e_base_cost_type base_cost_type,
                                     const bool echo_enabled,
-                                    const char* echo_file_name) {
+                                    const char* echo_file_name,
+                                    t_rr_indexed_data_delays* reusable_delays) {
     int length, i, index;
 
     (void)segment_inf;
@@ -140,9 +147,32 @@ void alloc_and_load_rr_indexed_data(const RRGraphView& rr_graph,
         rr_indexed_data[RRIndexedDataId(index)].seg_index = segment_inf_y[iseg - segment_inf_x.size()].seg_index;
     }
 
-    load_rr_indexed_data_T_values(rr_graph, rr_indexed_data);
+    std::string delays_key;
+    if (reusable_delays) {
+        delays_key = rr_indexed_data_delays_key(rr_graph, grid, segment_inf_x, segment_inf_y, rr_indexed_data.size());
+    }
+
+    if (reusable_delays && reusable_delays->key == delays_key) {
+        VTR_LOG("Reusing the wire delays of the rr indexed data of the previous rr graph\n");
+        for (size_t cost_index = CHANX_COST_INDEX_START; cost_index < rr_indexed_data.size(); cost_index++) {
+            auto& indexed_data = rr_indexed_data[RRIndexedDataId(cost_index)];
+            indexed_data.T_linear = reusable_delays->delays[cost_index][0];
+            indexed_data.T_quadratic = reusable_delays->delays[cost_index][1];
+            indexed_data.C_load = reusable_delays->delays[cost_index][2];
+        }
+    } else {
+        load_rr_indexed_data_T_values(rr_graph, rr_indexed_data);
+
+        fixup_rr_indexed_data_T_values(rr_indexed_data, total_num_segment);
 
-    fixup_rr_indexed_data_T_values(rr_indexed_data, total_num_segment);
+        if (reusable_delays) {
+            reusable_delays->key = delays_key;
+            reusable_delays->delays.clear();
+            for (const t_rr_indexed_data& indexed_data : rr_indexed_data) {
+                reusable_delays->delays.push_back({indexed_data.T_linear, indexed_data.T_quadratic, indexed_data.C_load});
+            }
+        }
+    }
 
     load_rr_indexed_data_base_costs(rr_graph, rr_indexed_data, base_cost_type, echo_enabled, echo_file_name);
 
@@ -490,6 +520,21 @@ static float get_delay_normalization_fac(const vtr::vector<RRIndexedDataId, t_rr
     return delay_norm_fac;
 }
 
+///@brief Number of nodes whose values load_rr_indexed_data_T_values() collects together on a worker thread
+constexpr size_t NODES_PER_CHUNK = 16384;
+
+///@brief The R, C and average fan-in switch values of a wire
+struct t_wire_values {
+    RRNodeId rr_id;
+    int num_switches;
+    float C;
+    float R;
+    float switch_R;
+    float switch_T;
+    float switch_Cinternal;
+    short buffered;
+};
+
 /*
  * Scans all the RR nodes of CHAN type getting the medians for their R and C values (delays)
  * as well as the delay data of all the nodes' switches, averaging them to find the following
@@ -529,57 +574,90 @@ static void load_rr_indexed_data_T_values(const RRGraphView& rr_graph,
      *
      * The median of R and C values for each cost index is assigned to the indexed
      * data.
+     *
+     * The values of chunks of nodes are collected on worker threads, and then
+     * gathered in node order.
      */
-    for (const RRNodeId& rr_id : rr_graph.nodes()) {
-        t_rr_type rr_type = rr_graph.node_type(rr_id);
+    const size_t num_nodes = rr_graph.num_nodes();
+    const size_t num_chunks = (num_nodes + NODES_PER_CHUNK - 1) / NODES_PER_CHUNK;
+    std::vector<std::vector<t_wire_values>> chunk_wire_values(num_chunks);
+
+    std::atomic<size_t> next_chunk(0);
+    auto collect_chunks = [&]() {
+        for (size_t ichunk = next_chunk++; ichunk < num_chunks; ichunk = next_chunk++) {
+            size_t end = std::min((ichunk + 1) * NODES_PER_CHUNK, num_nodes);
+            for (size_t inode = ichunk * NODES_PER_CHUNK; inode < end; ++inode) {
+                RRNodeId rr_id(inode);
+                t_rr_type rr_type = rr_graph.node_type(rr_id);
+
+                if (rr_type != CHANX && rr_type != CHANY) {
+                    continue;
+                }
 
-        if (rr_type != CHANX && rr_type != CHANY) {
-            continue;
+                /* get average switch parameters */
+                double avg_switch_R = 0;
+                double avg_switch_T = 0;
+                double avg_switch_Cinternal = 0;
+                int num_switches = 0;
+                short buffered = UNDEFINED;
+                calculate_average_switch(rr_graph, inode, avg_switch_R, avg_switch_T, avg_switch_Cinternal, num_switches, buffered, fan_in_list);
+
+                chunk_wire_values[ichunk].push_back({rr_id, num_switches,
+                                                     rr_graph.node_C(rr_id), rr_graph.node_R(rr_id),
+                                                     float(avg_switch_R), float(avg_switch_T), float(avg_switch_Cinternal),
+                                                     buffered});
+            }
         }
+    };
 
-        auto cost_index = rr_graph.node_cost_index(rr_id);
+    const size_t num_workers = std::min<size_t>(num_chunks, std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::future<void>> workers;
+    for (size_t iworker = 1; iworker < num_workers; ++iworker) {
+        workers.push_back(std::async(std::launch::async, collect_chunks));
+    }
+    collect_chunks();
+    for (auto& worker : workers) {
+        worker.get();
+    }
 
-        auto node_cords = rr_graph.node_coordinate_to_string(RRNodeId(rr_id));
+    for (const auto& wire_values : chunk_wire_values) {
+        for (const t_wire_values& wire : wire_values) {
+            RRNodeId rr_id = wire.rr_id;
+            auto cost_index = rr_graph.node_cost_index(rr_id);
 
-        /* get average switch parameters */
-        double avg_switch_R = 0;
-        double avg_switch_T = 0;
-        double avg_switch_Cinternal = 0;
-        int num_switches = 0;
-        short buffered = UNDEFINED;
-        calculate_average_switch(rr_graph, (size_t)rr_id, avg_switch_R, avg_switch_T, avg_switch_Cinternal, num_switches, buffered, fan_in_list);
+            if (wire.num_switches == 0) {
+                auto node_cords = rr_graph.node_coordinate_to_string(rr_id);
+                VTR_LOG_WARN("Node: %d with RR_type: %s  at Location:%s, had no out-going switches\n", rr_id,
+                             rr_graph.node_type_string(rr_id), node_cords.c_str());
+                continue;
+            }
+            VTR_ASSERT(wire.num_switches > 0);
 
-        if (num_switches == 0) {
-            VTR_LOG_WARN("Node: %d with RR_type: %s  at Location:%s, had no out-going switches\n", rr_id,
-                         rr_graph.node_type_string(rr_id), node_cords.c_str());
-            continue;
-        }
-        VTR_ASSERT(num_switches > 0);
-
-        num_nodes_of_index[cost_index]++;
-        C_total[cost_index].push_back(rr_graph.node_C(rr_id));
-        R_total[cost_index].push_back(rr_graph.node_R(rr_id));
-
-        switch_R_total[cost_index].push_back(avg_switch_R);
-        switch_T_total[cost_index].push_back(avg_switch_T);
-        switch_Cinternal_total[cost_index].push_back(avg_switch_Cinternal);
-        if (buffered == UNDEFINED) {
-            /* this segment does not have any outgoing edges to other general routing wires */
-            continue;
-        }
+            num_nodes_of_index[cost_index]++;
+            C_total[cost_index].push_back(wire.C);
+            R_total[cost_index].push_back(wire.R);
 
-        /* need to make sure all wire switches of a given wire segment type have the same 'buffered' value */
-        if (switches_buffered[cost_index] == UNDEFINED) {
-            switches_buffered[cost_index] = buffered;
-        } else {
-            if (switches_buffered[cost_index] != buffered) {
-                // If a previous buffering state is inconsistent with the current one,
-                // the node should be treated as buffered, as there are only two possible
-                // values for the buffering state (except for the UNDEFINED case).
-                //
-                // This means that at least one edge of this node has a buffered switch,
-                // which prevails over unbuffered ones.
-                switches_buffered[cost_index] = 1;
+            switch_R_total[cost_index].push_back(wire.switch_R);
+            switch_T_total[cost_index].push_back(wire.switch_T);
+            switch_Cinternal_total[cost_index].push_back(wire.switch_Cinternal);
+            if (wire.buffered == UNDEFINED) {
+                /* this segment does not have any outgoing edges to other general routing wires */
+                continue;
+            }
+
+            /* need to make sure all wire switches of a given wire segment type have the same 'buffered' value */
+            if (switches_buffered[cost_index] == UNDEFINED) {
+                switches_buffered[cost_index] = wire.buffered;
+            } else {
+                if (switches_buffered[cost_index] != wire.buffered) {
+                    // If a previous buffering state is inconsistent with the current one,
+                    // the node should be treated as buffered, as there are only two possible
+                    // values for the buffering state (except for the UNDEFINED case).
+                    //
+                    // This means that at least one edge of this node has a buffered switch,
+                    // which prevails over unbuffered ones.
+                    switches_buffered[cost_index] = 1;
+                }
             }
         }
     }
@@ -719,6 +797,28 @@ static void fixup_rr_indexed_data_T_values(vtr::vector<RRIndexedDataId, t_rr_ind
     }
 }
 
+/* Describes what the wire delays of the rr indexed data depend on, besides the channel widths */
+static std::string rr_indexed_data_delays_key(const RRGraphView& rr_graph,
+                                              const DeviceGrid& grid,
+                                              const std::vector<t_segment_inf>& segment_inf_x,
+                                              const std::vector<t_segment_inf>& segment_inf_y,
+                                              size_t num_rr_indexed_data) {
+    std::ostringstream key;
+    key << std::hexfloat;
+    key << grid.name() << ' ' << grid.width() << 'x' << grid.height() << 'x' << grid.get_num_layers()
+        << ' ' << num_rr_indexed_data << '\n';
+    for (const auto* segment_inf : {&segment_inf_x, &segment_inf_y}) {
+        for (const t_segment_inf& seg : *segment_inf) {
+            key << seg.seg_index << ' ' << seg.length << ' ' << seg.longline << ' ' << seg.Rmetal << ' ' << seg.Cmetal << '\n';
+        }
+    }
+    for (const t_rr_switch_inf& rr_switch : rr_graph.rr_switch()) {
+        key << rr_switch.R << ' ' << rr_switch.Cin << ' ' << rr_switch.Cinternal << ' ' << rr_switch.Tdel
+            << ' ' << int(rr_switch.type()) << '\n';
+    }
+    return key.str();
+}
+
 static void print_rr_index_info(const vtr::vector<RRIndexedDataId, t_rr_indexed_data>& rr_indexed_data,
                                 const char* fname,
                                 const std::vector<t_segment_inf>& segment_inf,
@@ -1,11 +1,36 @@
 #ifndef ALLOC_AND_LOAD_RR_INDEXED_DATA_H
 #define ALLOC_AND_LOAD_RR_INDEXED_DATA_H
 
+#include <array>
+#include <string>
+#include <vector>
+
 #include "rr_graph_view.h"
 #include "rr_node.h"
 #include "rr_graph_cost.h"
 #include "device_grid.h"
 
+/**
+ * @brief Wire delay values (T_linear, T_quadratic and C_load of each cost index) computed
+ *        by alloc_and_load_rr_indexed_data(), kept to be reused for a later rr graph
+ *
+ * The values are medians and modes of the R, C and fan-in switch values of all the wires
+ * of each type, which takes a walk over the whole rr graph. The rr graphs built for the
+ * channel widths tried by the minimum channel width search have the same wire segments and
+ * rr switches, and give (nearly) the same values, so those of the first one can be reused.
+ */
+struct t_rr_indexed_data_delays {
+    std::string key;                          ///<Describes the grid, segments and rr switches the delays were computed for (empty if none)
+    std::vector<std::array<float, 3>> delays; ///<[cost_index] T_linear, T_quadratic and C_load
+};
+
+/**
+ * @brief Allocates and loads rr_indexed_data
+ *
+ * If reusable_delays is given, the wire delays it holds are reused when they were computed
+ * for the same grid, segments and rr switches; otherwise the delays are computed, and
+ * stored in it for a later call.
+ */
 void alloc_and_load_rr_indexed_data(const RRGraphView& rr_graph,
                                     const DeviceGrid& grid,
                                     const std::vector<t_segment_inf>& segment_inf,
@@ -15,7 +40,8 @@ void alloc_and_load_rr_indexed_data(const RRGraphView& rr_graph,
                                     int wire_to_ipin_switch,
                                     enum e_base_cost_type base_cost_type,
                                     const bool echo_enabled,
-                                    const char* echo_file_name);
+                                    const char* echo_file_name,
+                                    t_rr_indexed_data_delays* reusable_delays = nullptr);
 
 std::vector<int> find_ortho_cost_index(const RRGraphView& rr_graph,
                                        const std::vector<t_segment_inf> segment_inf_x,
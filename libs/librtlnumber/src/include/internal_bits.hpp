@@ -367,127 +367,112 @@ static bit_value_t c_to_bit(char c) {
     return 0;
 }
 
-template<typename T>
-class BitFields {
+// #define DEBUG_V_BITS
+
+/*****
+ * the bits are stored as two planes of 64 bit words, so that operations can process
+ * them a word at a time. Each verilog bit is the pair (unknown, value) of its bits in
+ * the planes, which matches the bit_value_t encoding: 0 = 00, 1 = 01, x = 10, z = 11.
+ *
+ * The bits past the size, up to the end of the last word, keep the initial value,
+ * they are only observable through to_printable() and getc().
+ */
+class VerilogBits {
   private:
-    T bits = static_cast<T>(_All_x);
+    std::vector<uint64_t> value_plane;
+    std::vector<uint64_t> unknown_plane;
+    size_t bit_size = 0;
 
-    template<typename Addr_t>
-    size_t get_bit_location(Addr_t address) {
-        size_t current_address = static_cast<size_t>(address);
-        current_address %= this->size();
-        current_address <<= 1;
-        return current_address;
-    }
+    static constexpr size_t word_size = 64;
 
-  public:
-    BitFields(bit_value_t init_v) {
-        this->bits = static_cast<T>(
-            (_0 == init_v) ? _All_0 : (_1 == init_v) ? _All_1
-                                  : (_z == init_v)   ? _All_z
-                                                     : _All_x);
+    static size_t to_word(size_t address) {
+        return address / word_size;
     }
 
-    template<typename Addr_t>
-    bit_value_t get_bit(Addr_t address) {
-        auto result = this->bits >> this->get_bit_location(address);
-        result &= 0x3;
-
-        return static_cast<bit_value_t>(result);
+    static size_t to_offset(size_t address) {
+        return address % word_size;
     }
 
-    template<typename Addr_t>
-    void set_bit(Addr_t address, bit_value_t value) {
-        size_t real_address = this->get_bit_location(address);
-
-        T set_value = static_cast<T>(value);
-        set_value = static_cast<T>(set_value << real_address);
-
-        T mask = static_cast<T>(0x3);
-        mask = static_cast<T>(mask << real_address);
-        mask = static_cast<T>(~(mask));
-
-        this->bits = static_cast<T>(this->bits & mask);
-        this->bits = static_cast<T>(this->bits | set_value);
+    static size_t word_count_for(size_t data_size) {
+        return (data_size / word_size) + 1;
     }
 
     /**
-     * get 16 real bit (8 verilog bits) as 8 bit (char)
+     * mask of the bits of the given word that are part of the number
      */
-    template<typename Addr_t>
-    char get_as_char(Addr_t address) {
-        char value = 0;
-        for (size_t i = 0; i < 8; i++) {
-            value += (((this->get_bit((address * 8) + i)) ? 1 : 0) << i);
-        }
+    uint64_t word_mask(size_t word) const {
+        size_t first_bit = word * word_size;
+        if (first_bit + word_size <= this->bit_size)
+            return ~0ULL;
+        if (first_bit >= this->bit_size)
+            return 0ULL;
 
-        return value;
+        return (1ULL << (this->bit_size - first_bit)) - 1;
     }
 
-    static size_t size() {
-        return (sizeof(T) << 2); // 8 bit in a byte, 2 bits for a verilog bits = 4 bits in a byte, << 2 = sizeof x 4
-    }
-};
+    /**
+     * the 64 bits of a plane starting at bit 'address' (which may be unaligned),
+     * bits past the end of the plane read as 'fill'
+     */
+    static uint64_t get_plane_bits(const std::vector<uint64_t>& plane, size_t address, uint64_t fill) {
+        size_t word = to_word(address);
+        size_t offset = to_offset(address);
 
-// #define DEBUG_V_BITS
+        uint64_t low = (word < plane.size()) ? plane[word] : fill;
+        if (!offset)
+            return low;
 
-/*****
- * we use large array since we process the bits in chunks
- */
-class VerilogBits {
-  private:
-    std::vector<BitFields<veri_internal_bits_t>> bits;
-    size_t bit_size = 0;
+        uint64_t high = (word + 1 < plane.size()) ? plane[word + 1] : fill;
+        return (low >> offset) | (high << (word_size - offset));
+    }
 
-    size_t to_index(size_t address) {
-        return (address / BitFields<veri_internal_bits_t>::size());
+    /**
+     * sets the bits of 'mask' in bits [64 * word, 64 * word + 63] of the planes
+     */
+    void set_word_bits(size_t word, uint64_t mask, uint64_t value, uint64_t unknown) {
+        this->value_plane[word] = (this->value_plane[word] & ~mask) | (value & mask);
+        this->unknown_plane[word] = (this->unknown_plane[word] & ~mask) | (unknown & mask);
     }
 
-    size_t list_size() {
-        return this->bits.size();
+    /**
+     * sets the bits past the size to 0, the state of a number built from VerilogBits(size, _0)
+     */
+    void clear_unused_bits() {
+        size_t last_word = this->value_plane.size() - 1;
+        uint64_t mask = word_mask(last_word);
+        this->value_plane[last_word] &= mask;
+        this->unknown_plane[last_word] &= mask;
     }
 
   public:
     VerilogBits() {
         this->bit_size = 0;
-        this->bits = std::vector<BitSpace::BitFields<veri_internal_bits_t>>();
     }
 
     VerilogBits(size_t data_size, bit_value_t value_in) {
         this->bit_size = data_size;
-        this->bits = std::vector<BitSpace::BitFields<veri_internal_bits_t>>();
 
-        size_t bitfield_count = (this->bit_size / BitFields<veri_internal_bits_t>::size()) + 1;
+        if (_0 != value_in && _1 != value_in && _z != value_in)
+            value_in = _x;
 
-        for (size_t i = 0; i < bitfield_count; i++) {
-            this->bits.push_back(BitSpace::BitFields<veri_internal_bits_t>(value_in));
-        }
+        uint64_t value_word = (value_in & 0x1) ? ~0ULL : 0ULL;
+        uint64_t unknown_word = (value_in & 0x2) ? ~0ULL : 0ULL;
+
+        size_t word_count = word_count_for(this->bit_size);
+        this->value_plane.assign(word_count, value_word);
+        this->unknown_plane.assign(word_count, unknown_word);
     }
 
     VerilogBits(VerilogBits* other) {
         this->bit_size = other->size();
-        this->bits = other->get_internal_bitvector();
+        this->value_plane = other->value_plane;
+        this->unknown_plane = other->unknown_plane;
     }
 
     size_t size() {
         return this->bit_size;
     }
 
-    std::vector<BitFields<veri_internal_bits_t>> get_internal_bitvector() {
-        return this->bits;
-    }
-
-    BitFields<veri_internal_bits_t>* get_bitfield(size_t index) {
-#ifdef DEBUG_V_BITS
-        if (index >= this->bits.size()) {
-            std::cerr << "Bit array indexing out of bounds " << index << " but size is " << this->bit_size << std::endl;
-            std::abort();
-        }
-#endif
-
-        return (&this->bits[index]);
-    }
-
     bit_value_t get_bit(size_t address) {
 #ifdef DEBUG_V_BITS
         if (address >= this->bit_size) {
@@ -495,8 +480,11 @@ class VerilogBits {
             std::abort();
         }
 #endif
+        size_t word = to_word(address);
+        size_t offset = to_offset(address);
 
-        return (this->get_bitfield(to_index(address))->get_bit(address));
+        return static_cast<bit_value_t>((((this->unknown_plane[word] >> offset) & 0x1) << 1)
+                                        | ((this->value_plane[word] >> offset) & 0x1));
     }
 
     void set_bit(size_t address, bit_value_t value) {
@@ -506,14 +494,72 @@ class VerilogBits {
             std::abort();
         }
 #endif
-        (this->get_bitfield(to_index(address))->set_bit(address, value));
+        size_t word = to_word(address);
+        uint64_t mask = 1ULL << to_offset(address);
+
+        this->value_plane[word] = (value & 0x1) ? (this->value_plane[word] | mask) : (this->value_plane[word] & ~mask);
+        this->unknown_plane[word] = (value & 0x2) ? (this->unknown_plane[word] | mask) : (this->unknown_plane[word] & ~mask);
+    }
+
+    /**
+     * word access, for the operations with a fast path when there is no unknown bit:
+     * bits [64 * word, 64 * word + 63] of the value plane, the bits past the size read as 'pad' (_0 or _1)
+     */
+    uint64_t get_value_word(size_t word, bit_value_t pad) {
+        uint64_t pad_word = (pad == _1) ? ~0ULL : 0ULL;
+        if (word >= this->value_plane.size())
+            return pad_word;
+
+        uint64_t mask = word_mask(word);
+        return (this->value_plane[word] & mask) | (pad_word & ~mask);
+    }
+
+    /**
+     * sets bits [64 * word, 64 * word + 63] to the known bits 'value' (the bits past the size are left as is)
+     */
+    void set_value_word(size_t word, uint64_t value) {
+        set_word_bits(word, word_mask(word), value, 0ULL);
+    }
+
+    size_t word_count() {
+        return to_word(this->bit_size + word_size - 1);
+    }
+
+    /**
+     * copies 'count' bits of 'other' starting at 'from' to this, starting at 'to'
+     */
+    void copy_bits(VerilogBits& other, size_t from, size_t count, size_t to) {
+        while (count) {
+            size_t offset = to_offset(to);
+            size_t chunk = std::min(count, word_size - offset);
+            uint64_t mask = ((chunk == word_size) ? ~0ULL : ((1ULL << chunk) - 1)) << offset;
+
+            uint64_t value = get_plane_bits(other.value_plane, from, 0ULL) << offset;
+            uint64_t unknown = get_plane_bits(other.unknown_plane, from, 0ULL) << offset;
+            set_word_bits(to_word(to), mask, value, unknown);
+
+            from += chunk;
+            to += chunk;
+            count -= chunk;
+        }
+    }
+
+    /**
+     * get 8 verilog bits (the ones in the byte holding 'address') as a char
+     */
+    char get_as_char(size_t address) {
+        size_t first_bit = address - (address % 8);
+        uint64_t set_bits = get_plane_bits(this->value_plane, first_bit, 0ULL)
+                            | get_plane_bits(this->unknown_plane, first_bit, 0ULL);
+
+        return static_cast<char>(set_bits & 0xFF);
     }
 
     std::string to_printable() {
         std::string to_return = "";
 
         for (size_t i = 0; i < this->size(); i += 8) {
-            to_return.insert(0, 1, this->get_bitfield(to_index(i))->get_as_char(i));
+            to_return.insert(0, 1, this->get_as_char(i));
         }
 
         return to_return;
@@ -521,12 +567,12 @@ class VerilogBits {
 
     char getc() {
         size_t last_index = this->size() - 1;
-        return this->get_bitfield(to_index(last_index))->get_as_char(last_index);
+        return this->get_as_char(last_index);
     }
 
     bool has_unknown() {
-        for (size_t address = 0x0; address < this->size(); address++) {
-            if (is_unk[this->get_bit(address)])
+        for (size_t word = 0; word < this->word_count(); word++) {
+            if (this->unknown_plane[word] & word_mask(word))
                 return true;
         }
 
@@ -534,8 +580,9 @@ class VerilogBits {
     }
 
     bool is_only_z() {
-        for (size_t address = 0x0; address < this->size(); address++) {
-            if (!is_z_bit[this->get_bit(address)])
+        for (size_t word = 0; word < this->word_count(); word++) {
+            uint64_t mask = word_mask(word);
+            if ((this->unknown_plane[word] & this->value_plane[word] & mask) != mask)
                 return false;
         }
 
@@ -543,8 +590,9 @@ class VerilogBits {
     }
 
     bool is_only_x() {
-        for (size_t address = 0x0; address < this->size(); address++) {
-            if (!is_x_bit[this->get_bit(address)])
+        for (size_t word = 0; word < this->word_count(); word++) {
+            uint64_t mask = word_mask(word);
+            if ((this->unknown_plane[word] & ~this->value_plane[word] & mask) != mask)
                 return false;
         }
 
@@ -552,8 +600,8 @@ class VerilogBits {
     }
 
     bool is_true() {
-        for (size_t address = 0x0; address < this->size(); address++) {
-            if (is_one_bit[this->get_bit(address)])
+        for (size_t word = 0; word < this->word_count(); word++) {
+            if (this->value_plane[word] & ~this->unknown_plane[word] & word_mask(word))
                 return true;
         }
 
@@ -561,8 +609,8 @@ class VerilogBits {
     }
 
     bool is_false() {
-        for (size_t address = 0x0; address < this->size(); address++) {
-            if (!is_zero_bit[this->get_bit(address)])
+        for (size_t word = 0; word < this->word_count(); word++) {
+            if ((this->value_plane[word] | this->unknown_plane[word]) & word_mask(word))
                 return false;
         }
 
@@ -597,6 +645,20 @@ class VerilogBits {
     VerilogBits twos_complement(BitSpace::bit_value_t previous_carry) {
         VerilogBits other(this->bit_size, _0);
 
+        if ((previous_carry == _0 || previous_carry == _1) && !this->has_unknown()) {
+            /* fast path: ~bits + carry a word at a time */
+            uint64_t carry = previous_carry;
+            for (size_t word = 0; word < this->word_count(); word++) {
+                uint64_t not_word = ~this->value_plane[word];
+                uint64_t sum = not_word + carry;
+                carry = (sum < not_word) ? 1 : 0;
+                other.value_plane[word] = sum;
+            }
+            other.clear_unused_bits();
+
+            return other;
+        }
+
         for (size_t i = 0; i < this->size(); i++) {
             BitSpace::bit_value_t not_bit_i = BitSpace::l_not[this->get_bit(i)];
 
@@ -637,19 +699,10 @@ class VerilogBits {
             new_size = last_bit_id + 1;
         }
 
-        VerilogBits other(new_size, BitSpace::_0);
-
-        size_t i = 0;
+        VerilogBits other(new_size, pad);
 
-        while (i < this->size() && i < new_size) {
-            other.set_bit(i, this->get_bit(i));
-            i++;
-        }
-
-        while (i < new_size) {
-            other.set_bit(i, pad); /* <- ask Eve about it */
-            i++;
-        }
+        other.copy_bits(*this, 0, std::min(this->size(), new_size), 0);
+        other.clear_unused_bits();
 
         return other;
     }
@@ -663,8 +716,8 @@ class VerilogBits {
 
         VerilogBits other(new_size, BitSpace::_0);
 
-        for (size_t i = 0; i < new_size; i += 1) {
-            other.set_bit(i, this->get_bit(i % old_size));
+        for (size_t i = 0; i < n_times; i += 1) {
+            other.copy_bits(*this, 0, old_size, i * old_size);
         }
 
         return other;
@@ -1026,6 +1079,26 @@ class VNumber {
         this->bitstring.set_bit(index, val);
     }
 
+    /****
+     * word twiddling functions, for the operations with a fast path when there is no unknown bit
+     * words are 64 bits from the lsb, the bits past the msb read as the padding bit
+     */
+    size_t word_count() {
+        return this->bitstring.word_count();
+    }
+
+    uint64_t get_word_from_lsb(size_t index) {
+        return this->bitstring.get_value_word(index, this->get_padding_bit());
+    }
+
+    void set_word_from_lsb(size_t index, uint64_t val) {
+        this->bitstring.set_value_word(index, val);
+    }
+
+    void copy_bits_from_lsb(VNumber& other, size_t from, size_t count, size_t to) {
+        this->bitstring.copy_bits(other.bitstring, from, count, to);
+    }
+
     /***
      *  other
      */
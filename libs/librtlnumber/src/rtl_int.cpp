@@ -73,6 +73,24 @@ static compare_bit eval_op(VNumber& a_in, VNumber& b_in) {
     }
 
     size_t std_length = std::max(a.size(), b.size());
+
+    if (!a.has_unknown() && !b.has_unknown()) {
+        /* fast path: compare a word at a time from the msb */
+        size_t word_count = std::max(a.word_count(), b.word_count());
+        for (size_t i = word_count - 1; i < word_count; i--) {
+            uint64_t word_a = a.get_word_from_lsb(i);
+            uint64_t word_b = b.get_word_from_lsb(i);
+
+            if (word_a < word_b) {
+                return (!invert_result) ? LT_EVAL : GT_EVAL;
+            } else if (word_a > word_b) {
+                return (!invert_result) ? GT_EVAL : LT_EVAL;
+            }
+        }
+
+        return EQ_EVAL;
+    }
+
     bit_value_t pad_a = a.get_padding_bit();
     bit_value_t pad_b = b.get_padding_bit();
 
@@ -143,6 +161,24 @@ static VNumber sum_op(VNumber& a, VNumber& b, const bit_value_t& initial_carry,
     bit_value_t previous_carry = initial_carry;
     VNumber result(new_length, _0, is_addition_signed_operation, a.is_defined_size() && b.is_defined_size());
 
+    if (!a.has_unknown() && !b.has_unknown() && (initial_carry == _0 || initial_carry == _1)) {
+        /* fast path: add a word at a time */
+        uint64_t carry = initial_carry;
+        for (size_t i = 0; i < result.word_count(); i++) {
+            uint64_t word_a = a.get_word_from_lsb(i);
+            uint64_t sum = word_a + b.get_word_from_lsb(i);
+            uint64_t next_carry = (sum < word_a) ? 1 : 0;
+
+            sum += carry;
+            next_carry |= (sum < carry) ? 1 : 0;
+
+            result.set_word_from_lsb(i, sum);
+            carry = next_carry;
+        }
+
+        return result;
+    }
+
     for (size_t i = 0; i < new_length; i++) {
         bit_value_t bit_a = pad_a;
         if (i < a.size()) {
@@ -172,16 +208,14 @@ static VNumber shift_op(VNumber& a, int64_t b, bool sign_shift) {
         size_t u_b = static_cast<size_t>(-b);
         bit_value_t pad = (sign_shift) ? a.get_padding_bit() : BitSpace::_0;
         to_return = VNumber(a.size(), pad, sign_shift, a.is_defined_size());
-        for (size_t i = 0; i < (a.size() - u_b); i++) {
-            to_return.set_bit_from_lsb(i, a.get_bit_from_lsb(i + u_b));
+        if (u_b < a.size()) {
+            to_return.copy_bits_from_lsb(a, u_b, a.size() - u_b, 0);
         }
     } else {
         size_t u_b = static_cast<size_t>(b);
         bit_value_t pad = BitSpace::_0;
         to_return = VNumber((a.size() + u_b), pad, sign_shift, a.is_defined_size());
-        for (size_t i = 0; i < a.size(); i++) {
-            to_return.set_bit_from_lsb(i + u_b, a.get_bit_from_lsb(i));
-        }
+        to_return.copy_bits_from_lsb(a, 0, a.size(), u_b);
     }
     return to_return;
 }
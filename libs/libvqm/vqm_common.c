@@ -75,6 +75,7 @@ t_array_ref *assignment_list = NULL;
 t_array_ref *node_list = NULL;
 t_array_ref *pin_list = NULL;
 t_hash_table *pin_hash = NULL;
+t_hash_table *node_hash = NULL;
 t_node	*most_recently_used_node = NULL;
 
 /*  //Moved to vqm_common.h
@@ -92,6 +93,8 @@ char most_recent_error[ERROR_LENGTH];
 size_t hash_func(char* key, t_hash_table* hash_table);
 t_hash_elem* get_hash_entry(char* key, t_hash_table* hash_table);
 void insert_hash(char* key, size_t value, t_hash_table* hash_table);
+t_hash_table* allocate_hash_table(size_t num_elements);
+void free_hash_table(t_hash_table* hash_table);
 t_index_pass find_position_for_net_in_array_by_hash(char* name, t_array_ref *net_list);
 t_node_port_association *create_node_port_association(char *port_name, int port_index, t_pin_def *pin, int wire_index);
 /*******************************************************************************************/
@@ -119,6 +122,12 @@ void vqm_data_cleanup()
 		free(module_list);
 		module_list = NULL;
 	}
+	/* The hash tables only refer to names owned by the modules */
+	free_hash_table(pin_hash);
+	free_hash_table(node_hash);
+	pin_hash = NULL;
+	node_hash = NULL;
+
 	/* Set other reference lists to NULL */
 	module_list = NULL;
 	assignment_list = NULL;
@@ -310,6 +319,12 @@ void add_module(char *name, t_array_ref **pins, t_array_ref **assignments, t_arr
     append_array_element((intptr_t) (new_module), module_list);
 
 			//blah
+	/* The names of the next module are looked up in new lists */
+	free_hash_table(pin_hash);
+	free_hash_table(node_hash);
+	pin_hash = NULL;
+	node_hash = NULL;
+
 	/* Release previous association */
 	free(m_pins);
 	free(m_nodes);
@@ -352,13 +367,7 @@ t_pin_def *add_pin(char *name, int left, int right, t_pin_def_type type, t_parse
 
     /* Create the hash table for quick name -> pin_index lookup */
     if (pin_hash == NULL) {
-
-        pin_hash = (t_hash_table*) malloc(sizeof(t_hash_table));
-
-        //Allocate twice as many spaces in the hash table as is needed, this should prevent
-        //the table from becoming too full.
-        pin_hash->table = (t_hash_elem*) malloc(2*parse_info->number_of_pins*sizeof(t_hash_elem));
-        pin_hash->size = 2*parse_info->number_of_pins;
+        pin_hash = allocate_hash_table(parse_info->number_of_pins);
     }
 
     //Append the element, the position is one less thatn the size of the array
@@ -583,8 +592,15 @@ void add_node(char* type, char *name, t_array_ref **ports, t_parse_info* parse_i
 		node_list->pointer = (void**) malloc(parse_info->number_of_nodes * ELEMENT_SIZE);
 	}
 
+	/* Create the hash table for quick name -> node_index lookup */
+	if (node_hash == NULL)
+	{
+		node_hash = allocate_hash_table(parse_info->number_of_nodes);
+	}
+
 	/* Add node to the list */
-    append_array_element((intptr_t) my_node, node_list);
+    size_t position = append_array_element((intptr_t) my_node, node_list) - 1;
+    insert_hash(my_node->name, position, node_hash);
 
 	/* Set most recently used node */
 	most_recently_used_node = my_node;
@@ -636,27 +652,56 @@ t_pin_def *locate_net_by_name(char *name)
 }
 
 
-size_t hash_func(char* key, t_hash_table* hash_table)
-/* A hash function based on the key string, and
- * size of the hash table
+t_hash_table* allocate_hash_table(size_t num_elements)
+/* Allocate an empty hash table for num_elements elements
  */
 {
-    //VPRs hash function
+    t_hash_table* hash_table = (t_hash_table*) malloc(sizeof(t_hash_table));
+    VTR_ASSERT(hash_table != NULL);
 
-    int i;
-	int hash_val = 0, mult = 1;
+    //Allocate twice as many spaces in the hash table as is needed, this should prevent
+    //the table from becoming too full. The entries must start empty (NULL key and next).
+    hash_table->size = 2*num_elements + 1;
+    hash_table->table = (t_hash_elem*) calloc(hash_table->size, sizeof(t_hash_elem));
+    VTR_ASSERT(hash_table->table != NULL);
 
-	i = strlen(key);
-	for (i = strlen(key) - 1; i >= 0; i--) {
-		hash_val += mult * ((int) key[i]);
-		mult *= 7;
-	}
-	hash_val += (int) key[0];
-	hash_val %= hash_table->size;
+    return hash_table;
+}
 
-	hash_val = abs(hash_val);
+void free_hash_table(t_hash_table* hash_table)
+/* Free a hash table (but not its keys)
+ */
+{
+    if (hash_table == NULL) {
+        return;
+    }
 
-    return hash_val;
+    size_t index;
+    for(index = 0; index < hash_table->size; index++) {
+        t_hash_elem* entry = hash_table->table[index].next;
+        while(entry != NULL) {
+            t_hash_elem* next = entry->next;
+            free(entry);
+            entry = next;
+        }
+    }
+    free(hash_table->table);
+    free(hash_table);
+}
+
+size_t hash_func(char* key, t_hash_table* hash_table)
+/* A hash function based on the key string, and
+ * size of the hash table
+ */
+{
+    //FNV-1a, which spreads the many similar names of a netlist (e.g. "a~123", "a~124") well
+    uint64_t hash_val = 14695981039346656037ULL;
+    for (const char* c = key; *c != 0; c++) {
+        hash_val ^= (unsigned char) *c;
+        hash_val *= 1099511628211ULL;
+    }
+
+    return hash_val % hash_table->size;
 }
 
 t_hash_elem* get_hash_entry(char* key, t_hash_table* hash_table)
@@ -957,25 +1002,22 @@ t_array_ref *associate_identifier_with_port_name(t_identifier_pass *identifier,
 
 
 t_node *locate_node_by_name(char *name)
-/* Look through the list of nodes and find one with a matching name. If such a node is not
- * found then return NULL.
+/* Find the node with a matching name. If such a node is not found then return NULL.
  */
 {
-	size_t index;
 	t_node *result = NULL;
 
 	VTR_ASSERT(name != NULL);
 
-	/* Perform a linear search */
-	for(index = 0; index < node_list->array_size; index++)
+	if (node_hash == NULL)
 	{
-		t_node *temp_node = (t_node *) (node_list->pointer[index]);
+		return NULL;
+	}
 
-		if (strcmp(temp_node->name, name) == 0)
-		{
-			result = temp_node;
-			break;
-		}
+	t_hash_elem* entry = get_hash_entry(name, node_hash);
+	if (entry->key != NULL && strcmp(entry->key, name) == 0)
+	{
+		result = (t_node *) (node_list->pointer[entry->value]);
 	}
 
 	return result;
@@ -42,6 +42,7 @@ extern t_array_ref *assignment_list;
 extern t_array_ref *node_list;
 extern t_array_ref *pin_list;
 extern t_hash_table *pin_hash;
+extern t_hash_table *node_hash;
 
 /*******************************************************************************************/
 /****************************           DECLARATIONS             ***************************/
@@ -85,10 +86,14 @@ void free_port_association(void *pointer);
 
 extern t_node		*most_recently_used_node;
 extern char			most_recent_error[ERROR_LENGTH];
-extern char*		yytext;
 extern int			yylineno;
-extern FILE			*yyin;
 
 int			yyerror(t_parse_info* parse_info, const char *s);
-extern void 			yyrestart(FILE *input_file);
+
+/* The lexer (vqm_lexer.c) */
+int			vqm_lexer_open(const char *filename);
+void		vqm_lexer_rewind(t_boolean copy_strings);
+void		vqm_lexer_close(void);
+const char	*vqm_lexer_token_text(void);
+int			yylex(void);
 #endif
@@ -57,25 +57,21 @@ VQM_DLL_API t_module *vqm_parse_file(char *filename)
     parse_info->number_of_nodes = 0;
     parse_info->number_of_modules = 0;
 
-	yyin = fopen(filename,"r");
-	if (yyin != NULL)
+	if (vqm_lexer_open(filename) != 0)
 	{
-
-        //Initial pass to count items
-        printf("\tCounting Pass\n");
-		yyparse(parse_info);
-		if (module_list != NULL)
-		{
-			my_module = (t_module *) module_list->pointer[0];
-		}
-
-
-		fclose(yyin);
-	} else {
 		printf("ERROR: Could not open %s for counting pass.\n", filename);
 		exit(1);
 	}
 
+	//Initial pass to count items (the lexer does not copy the strings, which this pass does not use)
+	printf("\tCounting Pass\n");
+	vqm_lexer_rewind(T_FALSE);
+	yyparse(parse_info);
+	if (module_list != NULL)
+	{
+		my_module = (t_module *) module_list->pointer[0];
+	}
+
     //Next pass type
     parse_info->pass_type = ALLOCATE_PASS;
 
@@ -85,26 +81,18 @@ VQM_DLL_API t_module *vqm_parse_file(char *filename)
     printf("\t\t%d assignment(s)\n", parse_info->number_of_assignments);
     printf("\t\t%d node(s)\n", parse_info->number_of_nodes);
     printf("\t\t%d module(s)\n", parse_info->number_of_modules);
-	
-    yyin = fopen(filename,"r");
-	if (yyin != NULL)
-	{
-
-        //Initial pass to count items
-        printf("\tAllocating Pass\n");
-		yyparse(parse_info);
-		if (module_list != NULL)
-		{
-			my_module = (t_module *) module_list->pointer[0];
-		}
-
 
-		fclose(yyin);
-	} else {
-		printf("ERROR: Could not open %s for allocating pass.\n", filename);
-		exit(1);
+	//Second pass over the same (already loaded) file to build the netlist
+	printf("\tAllocating Pass\n");
+	vqm_lexer_rewind(T_TRUE);
+	yyparse(parse_info);
+	if (module_list != NULL)
+	{
+		my_module = (t_module *) module_list->pointer[0];
 	}
 
+	vqm_lexer_close();
+
     //Cleanup
     free(parse_info);
 	return my_module;
@@ -0,0 +1,523 @@
+// This file contains the lexer of the VQM parser.
+//
+// The VQM file is mapped in memory once and scanned by hand by each pass of the parser, rather
+// than read through stdio and scanned by a table driven flex lexer. It recognizes exactly the tokens
+// of the flex rules it replaces, where the longest match wins and ties go to the first rule:
+//
+//   ^[ \t]*\/\/[^\n\r]*(\n|\r\n)     skip one-line comments
+//   ^[ \t]*\(\*[^\n\r]*\*\)          skip synthesis attributes and directives
+//   [ \t]+  !  (\n|\r\n)             skip white spaces, the logical operator ! and empty lines
+//   module endmodule defparam assign TOKEN_MODULE ... TOKEN_ASSIGN
+//   input output inout wire          TOKEN_INPUT ... TOKEN_WIRE (value is the pin type)
+//   1'b0 1'b1 1'bz                   TOKEN_CONST_0 TOKEN_CONST_1 TOKEN_CONST_Z
+//   [a-zA-Z_][a-zA-Z_0-9$]*          TOKEN_REGULARID
+//   [-]?[1-9][0-9]*|0+               TOKEN_INTCONSTANT
+//   \\[^ ^\t^;]+                     TOKEN_ESCAPEDID (without the backslash)
+//   \"[^\"]*\"                       TOKEN_STRING (without the quotes)
+//   [1-9][0-9]*'[b|h][0-9|A-F]+      TOKEN_BITSTRING
+//   .                                the character itself
+//
+// The strings of the tokens are only allocated when the pass uses them (see vqm_lexer_rewind).
+//
+// NOTES/REVISIONS:
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+/*******************************************************************************************/
+/****************************             INCLUDES               ***************************/
+/*******************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h> // For vqm_parser.gen.h
+#include "vqm_dll.h"
+#include "vqm_parser.gen.h"
+#include "vqm_common.h"
+#include "vtr_assert.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*******************************************************************************************/
+/****************************           DECLARATIONS             ***************************/
+/*******************************************************************************************/
+
+int yylineno = 1;
+
+static const char	*lex_begin = NULL;		/* The file contents */
+static const char	*lex_end = NULL;
+static const char	*lex_pos = NULL;		/* Where the next token starts */
+static const char	*lex_token = NULL;		/* The last token returned (for error messages) */
+static size_t		lex_token_length = 0;
+static t_boolean	lex_copy_strings = T_TRUE;
+
+static void			*lex_mapping = NULL;	/* The memory mapping of the file, if mapped */
+static size_t		lex_mapping_size = 0;
+static char			*lex_buffer = NULL;		/* The file contents, if read */
+
+#define MAX_TOKEN_TEXT_LENGTH	256
+static char			lex_token_text[MAX_TOKEN_TEXT_LENGTH];
+
+static char *copy_token_string(const char *begin, const char *end);
+static int count_newlines(const char *begin, const char *end);
+static int lex_identifier(void);
+static int lex_number(void);
+static t_boolean skip_line_start_rule(void);
+
+/*******************************************************************************************/
+/****************************          IMPLEMENTATION            ***************************/
+/*******************************************************************************************/
+
+
+int vqm_lexer_open(const char *filename)
+/* Load the file to parse for the lexer. Return 0 on success. */
+{
+	vqm_lexer_close();
+
+#ifndef _WIN32
+	int fd = open(filename, O_RDONLY);
+	if (fd < 0)
+	{
+		return -1;
+	}
+
+	struct stat file_stat;
+	if (fstat(fd, &file_stat) != 0)
+	{
+		close(fd);
+		return -1;
+	}
+
+	if (file_stat.st_size > 0)
+	{
+		void *mapping = mmap(NULL, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (mapping != MAP_FAILED)
+		{
+			/* The passes read the file front to back */
+			madvise(mapping, file_stat.st_size, MADV_SEQUENTIAL);
+			close(fd);
+
+			lex_mapping = mapping;
+			lex_mapping_size = file_stat.st_size;
+			lex_begin = (const char *) mapping;
+			lex_end = lex_begin + lex_mapping_size;
+			vqm_lexer_rewind(T_TRUE);
+			return 0;
+		}
+	}
+	close(fd);
+#endif
+
+	/* Fall back to reading the whole file (e.g. on Windows, or if it can not be mapped) */
+	FILE *file = fopen(filename, "rb");
+	if (file == NULL)
+	{
+		return -1;
+	}
+
+	size_t size = 0;
+	size_t capacity = 1 << 20;
+	lex_buffer = (char *) malloc(capacity);
+	VTR_ASSERT(lex_buffer != NULL);
+	for (;;)
+	{
+		size += fread(lex_buffer + size, 1, capacity - size, file);
+		if (size < capacity)
+		{
+			break;
+		}
+		capacity *= 2;
+		lex_buffer = (char *) realloc(lex_buffer, capacity);
+		VTR_ASSERT(lex_buffer != NULL);
+	}
+	fclose(file);
+
+	lex_begin = lex_buffer;
+	lex_end = lex_buffer + size;
+	vqm_lexer_rewind(T_TRUE);
+	return 0;
+}
+
+
+void vqm_lexer_rewind(t_boolean copy_strings)
+/* Restart lexing from the beginning of the file. When copy_strings is T_FALSE the string
+ * tokens (identifiers, strings and bit strings) are returned with a NULL string, as
+ * the counting pass of the parser does not use them.
+ */
+{
+	lex_pos = lex_begin;
+	lex_token = lex_begin;
+	lex_token_length = 0;
+	lex_copy_strings = copy_strings;
+	yylineno = 1;
+}
+
+
+void vqm_lexer_close(void)
+/* Release the file contents. */
+{
+#ifndef _WIN32
+	if (lex_mapping != NULL)
+	{
+		munmap(lex_mapping, lex_mapping_size);
+	}
+#endif
+	free(lex_buffer);
+
+	lex_mapping = NULL;
+	lex_mapping_size = 0;
+	lex_buffer = NULL;
+	lex_begin = lex_end = lex_pos = lex_token = NULL;
+	lex_token_length = 0;
+}
+
+
+const char *vqm_lexer_token_text(void)
+/* Return the text of the last token returned by yylex (truncated if very long). */
+{
+	size_t length = lex_token_length;
+	if (length >= MAX_TOKEN_TEXT_LENGTH)
+	{
+		length = MAX_TOKEN_TEXT_LENGTH - 1;
+	}
+	if (length > 0)
+	{
+		memcpy(lex_token_text, lex_token, length);
+	}
+	lex_token_text[length] = 0;
+	return lex_token_text;
+}
+
+
+int yylex(void)
+/* Return the next token of the file, 0 at its end. */
+{
+	while (lex_pos < lex_end)
+	{
+		const char *p = lex_pos;
+		char c = *p;
+
+		/* The comments and attributes are only recognized at the start of a line */
+		if ((p == lex_begin || p[-1] == '\n') && skip_line_start_rule())
+		{
+			continue;
+		}
+
+		lex_token = p;
+		lex_token_length = 1;
+
+		if (c == ' ' || c == '\t')
+		{
+			/* skip white spaces */
+			while (lex_pos < lex_end && (*lex_pos == ' ' || *lex_pos == '\t'))
+			{
+				lex_pos++;
+			}
+			continue;
+		}
+		if (c == '!')
+		{
+			/* skip the logical operator ! applied on the input ports of the lut - this results in lut mask not being valid anoymore */
+			lex_pos++;
+			continue;
+		}
+		if (c == '\n' || (c == '\r' && p + 1 < lex_end && p[1] == '\n'))
+		{
+			/* skip empty lines */
+			lex_pos += (c == '\n') ? 1 : 2;
+			yylineno++;
+			continue;
+		}
+		if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_')
+		{
+			return lex_identifier();
+		}
+		if ((c >= '0' && c <= '9') || (c == '-' && p + 1 < lex_end && p[1] >= '1' && p[1] <= '9'))
+		{
+			return lex_number();
+		}
+		if (c == '\\')
+		{
+			const char *end = p + 1;
+			while (end < lex_end && *end != ' ' && *end != '^' && *end != '\t' && *end != ';')
+			{
+				end++;
+			}
+			if (end > p + 1)
+			{
+				lex_pos = end;
+				lex_token_length = end - p;
+				yylineno += count_newlines(p, end);
+				yylval.string = copy_token_string(p + 1, end);
+				return TOKEN_ESCAPEDID;
+			}
+		}
+		if (c == '"')
+		{
+			const char *end = (const char *) memchr(p + 1, '"', lex_end - (p + 1));
+			if (end != NULL)
+			{
+				lex_pos = end + 1;
+				lex_token_length = lex_pos - p;
+				yylineno += count_newlines(p, end);
+				yylval.string = copy_token_string(p + 1, end);
+				return TOKEN_STRING;
+			}
+		}
+
+		/* Any other character is returned as is */
+		lex_pos++;
+		return (int) c;
+	}
+
+	lex_token = lex_end;
+	lex_token_length = 0;
+	return 0;
+}
+
+
+static t_boolean skip_line_start_rule(void)
+/* At the start of a line, skip a one-line comment or a synthesis attribute (and the white
+ * spaces before it). Return T_FALSE if the line does not start with either.
+ */
+{
+	const char *p = lex_pos;
+	while (p < lex_end && (*p == ' ' || *p == '\t'))
+	{
+		p++;
+	}
+	if (lex_end - p < 2)
+	{
+		return T_FALSE;
+	}
+
+	/* The end of the line (the comments and attributes can not span lines) */
+	const char *line_end = p;
+	while (line_end < lex_end && *line_end != '\n' && *line_end != '\r')
+	{
+		line_end++;
+	}
+
+	if (p[0] == '/' && p[1] == '/')
+	{
+		/* skip one-line comments, with their end of line */
+		if (line_end + 1 < lex_end && line_end[0] == '\r' && line_end[1] == '\n')
+		{
+			lex_pos = line_end + 2;
+			yylineno++;
+		}
+		else if (line_end < lex_end && line_end[0] == '\n')
+		{
+			lex_pos = line_end + 1;
+			yylineno++;
+		}
+		else if (line_end == lex_end)
+		{
+			/* A comment on the last line */
+			lex_pos = line_end;
+		}
+		else
+		{
+			return T_FALSE;
+		}
+		return T_TRUE;
+	}
+
+	if (p[0] == '(' && p[1] == '*')
+	{
+		/* skip synthesis attributes and directives, up to the last *) of the line */
+		const char *end;
+		for (end = line_end; end >= p + 4; end--)
+		{
+			if (end[-2] == '*' && end[-1] == ')')
+			{
+				lex_pos = end;
+				return T_TRUE;
+			}
+		}
+	}
+	return T_FALSE;
+}
+
+
+static int lex_identifier(void)
+/* Lex a keyword or a regular identifier. */
+{
+	const char *p = lex_pos;
+	const char *end = p + 1;
+	while (end < lex_end && ((*end >= 'a' && *end <= 'z') || (*end >= 'A' && *end <= 'Z')
+							|| (*end >= '0' && *end <= '9') || *end == '_' || *end == '$'))
+	{
+		end++;
+	}
+	size_t length = end - p;
+	lex_pos = end;
+	lex_token_length = length;
+
+#define IS_KEYWORD(keyword)	(length == sizeof(keyword) - 1 && memcmp(p, keyword, length) == 0)
+	switch (p[0])
+	{
+		case 'm':
+			if (IS_KEYWORD("module")) return TOKEN_MODULE;
+			break;
+		case 'e':
+			if (IS_KEYWORD("endmodule")) return TOKEN_ENDMODULE;
+			break;
+		case 'd':
+			if (IS_KEYWORD("defparam")) return TOKEN_DEFPARAM;
+			break;
+		case 'a':
+			if (IS_KEYWORD("assign")) return TOKEN_ASSIGN;
+			break;
+		case 'i':
+			if (IS_KEYWORD("input"))
+			{
+				yylval.value = PIN_INPUT;
+				return TOKEN_INPUT;
+			}
+			if (IS_KEYWORD("inout"))
+			{
+				yylval.value = PIN_INOUT;
+				return TOKEN_INOUT;
+			}
+			break;
+		case 'o':
+			if (IS_KEYWORD("output"))
+			{
+				yylval.value = PIN_OUTPUT;
+				return TOKEN_OUTPUT;
+			}
+			break;
+		case 'w':
+			if (IS_KEYWORD("wire"))
+			{
+				yylval.value = PIN_WIRE;
+				return TOKEN_WIRE;
+			}
+			break;
+		default:
+			break;
+	}
+#undef IS_KEYWORD
+
+	yylval.string = copy_token_string(p, end);
+	return TOKEN_REGULARID;
+}
+
+
+static int lex_number(void)
+/* Lex an integer constant, a bit constant or a bit string. */
+{
+	const char *p = lex_pos;
+
+	if (*p == '0')
+	{
+		/* 0+ */
+		const char *end = p;
+		while (end < lex_end && *end == '0')
+		{
+			end++;
+		}
+		lex_pos = end;
+		lex_token_length = end - p;
+		yylval.value = 0;
+		return TOKEN_INTCONSTANT;
+	}
+
+	/* [-]?[1-9][0-9]* */
+	const char *digits_end = (*p == '-') ? p + 1 : p;
+	unsigned int value = 0; /* Wraps around on overflow (atoi's behaviour is undefined) */
+	while (digits_end < lex_end && *digits_end >= '0' && *digits_end <= '9')
+	{
+		value = value * 10 + (*digits_end - '0');
+		digits_end++;
+	}
+	size_t int_length = digits_end - p;
+
+	if (*p != '-')
+	{
+		/* 1'b0, 1'b1 and 1'bz win over a bit string of the same length */
+		if (lex_end - p >= 4 && p[0] == '1' && p[1] == '\'' && p[2] == 'b' && (p[3] == '0' || p[3] == '1' || p[3] == 'z'))
+		{
+			size_t bitstring_length = 0;
+			if (p[3] != 'z')
+			{
+				const char *end = p + 3;
+				while (end < lex_end && ((*end >= '0' && *end <= '9') || (*end >= 'A' && *end <= 'F') || *end == '|'))
+				{
+					end++;
+				}
+				bitstring_length = end - p;
+			}
+			if (bitstring_length <= 4)
+			{
+				lex_pos = p + 4;
+				lex_token_length = 4;
+				if (p[3] == 'z')
+				{
+					return TOKEN_CONST_Z;
+				}
+				yylval.value = p[3] - '0';
+				return (p[3] == '0') ? TOKEN_CONST_0 : TOKEN_CONST_1;
+			}
+		}
+
+		/* [1-9][0-9]*'[b|h][0-9|A-F]+ */
+		if (lex_end - digits_end >= 3 && digits_end[0] == '\''
+			&& (digits_end[1] == 'b' || digits_end[1] == 'h' || digits_end[1] == '|'))
+		{
+			const char *end = digits_end + 2;
+			while (end < lex_end && ((*end >= '0' && *end <= '9') || (*end >= 'A' && *end <= 'F') || *end == '|'))
+			{
+				end++;
+			}
+			if (end > digits_end + 2)
+			{
+				lex_pos = end;
+				lex_token_length = end - p;
+				yylval.string = copy_token_string(p, end);
+				return TOKEN_BITSTRING;
+			}
+		}
+	}
+
+	lex_pos = digits_end;
+	lex_token_length = int_length;
+	yylval.value = (*p == '-') ? -(int) value : (int) value;
+	return TOKEN_INTCONSTANT;
+}
+
+
+static char *copy_token_string(const char *begin, const char *end)
+/* Return a new (malloc'ed) copy of the string [begin, end), or NULL if the strings are not copied. */
+{
+	if (lex_copy_strings == T_FALSE)
+	{
+		return NULL;
+	}
+
+	size_t length = end - begin;
+	char *string = (char *) malloc(length + 1);
+	VTR_ASSERT(string != NULL);
+	memcpy(string, begin, length);
+	string[length] = 0;
+	return string;
+}
+
+
+static int count_newlines(const char *begin, const char *end)
+{
+	int count = 0;
+	for (; begin < end; begin++)
+	{
+		if (*begin == '\n')
+		{
+			count++;
+		}
+	}
+	return count;
+}
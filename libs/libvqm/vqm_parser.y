@@ -28,8 +28,6 @@
 #include <assert.h>
 #include "vqm_dll.h"
 #include "vqm_common.h"
-
-extern int yylex(void);
 %}
 
 /********************************************************/
@@ -747,7 +745,7 @@ PinType:	TOKEN_INPUT	{ $$ = $1; }
 
 int yyerror(t_parse_info* parse_info, const char *s)
 {
-	sprintf(most_recent_error, "%s occured at line %i: %s\r\n", s, yylineno, yytext);
+	snprintf(most_recent_error, ERROR_LENGTH, "%s occured at line %i: %s\r\n", s, yylineno, vqm_lexer_token_text());
 	return 0;
 }
 
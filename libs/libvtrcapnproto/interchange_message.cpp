@@ -0,0 +1,166 @@
+#include "interchange_message.h"
+
+#include <algorithm>
+#include <climits>
+#include <fstream>
+#include <limits>
+
+#include <zlib.h>
+
+#include "kj/io.h"
+
+#include "serdes_utils.h"
+#include "vtr_error.h"
+#include "vtr_util.h"
+
+///@brief Size of the blocks the compressed files are read in (and of zlib's input buffer)
+static constexpr size_t GZIP_BLOCK_SIZE = 16 * 1024 * 1024;
+
+///@brief Returns true if file starts with the gzip magic number
+static bool is_gzip_file(const std::string& file) {
+    std::ifstream ifs(file, std::ios::binary);
+    if (!ifs) {
+        throw vtr::VtrError(vtr::string_fmt("Failed to open interchange file '%s'", file.c_str()), __FILE__, __LINE__);
+    }
+
+    unsigned char magic[2] = {0, 0};
+    ifs.read(reinterpret_cast<char*>(magic), sizeof(magic));
+    return ifs && magic[0] == 0x1f && magic[1] == 0x8b;
+}
+
+/**
+ * @brief Returns the decompressed size of a gzip file, as recorded in its trailer
+ *
+ * The trailer records the size modulo 2^32 (of the last member only), so this is only a hint.
+ */
+static size_t gzip_size_hint(const std::string& file) {
+    std::ifstream ifs(file, std::ios::binary | std::ios::ate);
+    if (!ifs || ifs.tellg() < 4) {
+        return 0;
+    }
+
+    unsigned char isize[4];
+    ifs.seekg(-4, std::ios::end);
+    ifs.read(reinterpret_cast<char*>(isize), sizeof(isize));
+    if (!ifs) {
+        return 0;
+    }
+    return size_t(isize[0]) | (size_t(isize[1]) << 8) | (size_t(isize[2]) << 16) | (size_t(isize[3]) << 24);
+}
+
+///@brief Decompresses the gzip file into buffer (as capnp words), and returns its size in bytes
+static size_t read_gzip_file(const std::string& file, std::vector<uint64_t>& buffer) {
+    gzFile gz_file = gzopen(file.c_str(), "rb");
+    if (gz_file == Z_NULL) {
+        throw vtr::VtrError(vtr::string_fmt("Failed to open interchange file '%s'", file.c_str()), __FILE__, __LINE__);
+    }
+    gzbuffer(gz_file, GZIP_BLOCK_SIZE);
+
+    //Room for the message and a trailing partial block, so that a correct hint needs no reallocation
+    buffer.resize(gzip_size_hint(file) / sizeof(uint64_t) + GZIP_BLOCK_SIZE / sizeof(uint64_t));
+
+    size_t size = 0;
+    while (true) {
+        if (buffer.size() * sizeof(uint64_t) - size < GZIP_BLOCK_SIZE) {
+            buffer.resize(buffer.size() + std::max(buffer.size() / 2, GZIP_BLOCK_SIZE / sizeof(uint64_t)));
+        }
+
+        size_t num_bytes = std::min(buffer.size() * sizeof(uint64_t) - size, size_t(INT_MAX));
+        int ret = gzread(gz_file, reinterpret_cast<char*>(buffer.data()) + size, num_bytes);
+        if (ret < 0) {
+            int error;
+            std::string msg = gzerror(gz_file, &error);
+            gzclose(gz_file);
+            throw vtr::VtrError(vtr::string_fmt("Failed to decompress interchange file '%s': %s", file.c_str(), msg.c_str()), __FILE__, __LINE__);
+        }
+        if (ret == 0) {
+            break;
+        }
+        size += ret;
+    }
+
+    gzclose(gz_file);
+
+    buffer.resize((size + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+    buffer.shrink_to_fit();
+    return size;
+}
+
+InterchangeMessage::InterchangeMessage(const std::string& file) {
+    kj::ArrayPtr<const ::capnp::word> words;
+    if (is_gzip_file(file)) {
+        size_t size = read_gzip_file(file, buffer_);
+        if (size % sizeof(::capnp::word) != 0) {
+            throw vtr::VtrError(vtr::string_fmt("Interchange file '%s' is not a capnp message (its size is not a multiple of a word)", file.c_str()), __FILE__, __LINE__);
+        }
+        words = kj::arrayPtr(reinterpret_cast<const ::capnp::word*>(buffer_.data()), buffer_.size());
+    } else {
+        mmap_ = std::make_unique<MmapFile>(file);
+        words = mmap_->getData();
+    }
+
+    ::capnp::ReaderOptions reader_options;
+    reader_options.nestingLimit = std::numeric_limits<int>::max();
+    reader_options.traversalLimitInWords = std::numeric_limits<uint64_t>::max();
+
+    try {
+        reader_ = std::make_unique<::capnp::FlatArrayMessageReader>(words, reader_options);
+    } catch (kj::Exception& e) {
+        throw vtr::VtrError(e.getDescription().cStr(), e.getFile(), e.getLine());
+    }
+}
+
+/**
+ * @brief A kj output stream compressing to a gzip file
+ *
+ * The capnp writer hands over the segment table and then each segment, so the writes are large.
+ */
+class GzipOutputStream : public kj::OutputStream {
+  public:
+    GzipOutputStream(const std::string& file, gzFile gz_file)
+        : file_(file)
+        , gz_file_(gz_file) {}
+
+    void write(const void* buffer, size_t size) override {
+        const char* bytes = static_cast<const char*>(buffer);
+        while (size > 0) {
+            unsigned num_bytes = std::min(size, size_t(INT_MAX));
+            if (gzwrite(gz_file_, bytes, num_bytes) != int(num_bytes)) {
+                int error;
+                std::string msg = gzerror(gz_file_, &error);
+                throw vtr::VtrError(vtr::string_fmt("Failed to compress interchange file '%s': %s", file_.c_str(), msg.c_str()), __FILE__, __LINE__);
+            }
+            bytes += num_bytes;
+            size -= num_bytes;
+        }
+    }
+
+  private:
+    const std::string& file_;
+    gzFile gz_file_;
+};
+
+void write_interchange_message(const std::string& file, ::capnp::MessageBuilder& builder, bool compress) {
+    if (!compress) {
+        writeMessageToFile(file, &builder);
+        return;
+    }
+
+    gzFile gz_file = gzopen(file.c_str(), "wb");
+    if (gz_file == Z_NULL) {
+        throw vtr::VtrError(vtr::string_fmt("Failed to open interchange file '%s' for writing", file.c_str()), __FILE__, __LINE__);
+    }
+    gzbuffer(gz_file, GZIP_BLOCK_SIZE);
+
+    try {
+        GzipOutputStream stream(file, gz_file);
+        ::capnp::writeMessage(stream, builder);
+    } catch (...) {
+        gzclose(gz_file);
+        throw;
+    }
+
+    if (gzclose(gz_file) != Z_OK) {
+        throw vtr::VtrError(vtr::string_fmt("Failed to write interchange file '%s'", file.c_str()), __FILE__, __LINE__);
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef INTERCHANGE_MESSAGE_H_
+#define INTERCHANGE_MESSAGE_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "capnp/serialize.h"
+#include "mmap_file.h"
+
+/**
+ * @brief The message of an FPGA interchange file (e.g. a device resources or logical netlist file).
+ *
+ * Interchange files are capnp messages, usually gzip compressed:
+ *  - A compressed file is decompressed in large blocks straight into a single word aligned buffer
+ *    (sized up front from the gzip trailer), and the message is read in place from it.
+ *  - An uncompressed file (e.g. written by 'gunzip -k') is memory mapped and read in place, without
+ *    any copy, so it loads as fast as its pages can be mapped.
+ *
+ * The message is read with no nesting nor traversal limits, as interchange devices are very large.
+ * Throws a vtr::VtrError if the file can not be read.
+ */
+class InterchangeMessage {
+  public:
+    explicit InterchangeMessage(const std::string& file);
+
+    ///@brief Returns the root of the message, as a T (e.g. DeviceResources::Device)
+    template<typename T>
+    typename T::Reader getRoot() {
+        return reader_->getRoot<T>();
+    }
+
+  private:
+    std::vector<uint64_t> buffer_;   ///<The decompressed message (if the file is compressed)
+    std::unique_ptr<MmapFile> mmap_; ///<The mapped message (if the file is not compressed)
+    std::unique_ptr<::capnp::FlatArrayMessageReader> reader_;
+};
+
+/**
+ * @brief Writes a message to an FPGA interchange file (e.g. a physical netlist file).
+ *
+ * The message segments are streamed straight to the file (through zlib if compress is set, as
+ * interchange files usually are), without first being copied into a flat array.
+ * Throws a vtr::VtrError if the file can not be written.
+ */
+void write_interchange_message(const std::string& file, ::capnp::MessageBuilder& builder, bool compress);
+
+#endif /* INTERCHANGE_MESSAGE_H_ */
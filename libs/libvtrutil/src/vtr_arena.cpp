@@ -0,0 +1,64 @@
+#include "vtr_arena.h"
+
+#include <algorithm>
+
+#include "vtr_assert.h"
+
+namespace vtr {
+
+Arena::Arena(size_t initial_block_size)
+    : next_block_size_(std::max<size_t>(initial_block_size, 1)) {}
+
+Arena::~Arena() {
+    release();
+    ::operator delete(block_);
+}
+
+void Arena::release() {
+    //Keep the largest block and free the others
+    for (size_t i = 0; i < full_blocks_.size(); i++) {
+        if (full_block_sizes_[i] > block_size_) {
+            std::swap(full_blocks_[i], block_);
+            std::swap(full_block_sizes_[i], block_size_);
+        }
+    }
+    for (char* block : full_blocks_) {
+        ::operator delete(block);
+    }
+    full_blocks_.clear();
+    full_block_sizes_.clear();
+
+    used_ = 0;
+    bytes_allocated_ = 0;
+}
+
+size_t Arena::bytes_reserved() const {
+    size_t bytes = block_size_;
+    for (size_t block_size : full_block_sizes_) {
+        bytes += block_size;
+    }
+    return bytes;
+}
+
+void* Arena::allocate_from_new_block(size_t bytes, size_t alignment) {
+    VTR_ASSERT_MSG(alignment > 0 && (alignment & (alignment - 1)) == 0, "Alignment must be a power of 2");
+
+    //Large enough for the request even if the block start isn't suitably aligned
+    size_t block_size = std::max(next_block_size_, bytes + alignment);
+    char* block = static_cast<char*>(::operator new(block_size));
+    next_block_size_ = std::min(2 * next_block_size_, MAX_BLOCK_SIZE);
+
+    if (block_) {
+        full_blocks_.push_back(block_);
+        full_block_sizes_.push_back(block_size_);
+    }
+    block_ = block;
+    block_size_ = block_size;
+
+    size_t offset = align_offset(block_, 0, alignment);
+    used_ = offset + bytes;
+    bytes_allocated_ += bytes;
+    return block_ + offset;
+}
+
+} // namespace vtr
@@ -0,0 +1,182 @@
+#ifndef VTR_ARENA_H
+#define VTR_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include "vtr_vector.h"
+
+/**
+ * @file
+ * @brief A monotonic arena (bump allocator) and an STL allocator drawing from it.
+ *
+ * Overview
+ * ========
+ * Scratch data of a flow stage (e.g. per-net or per-block look-ups of the placer or router)
+ * is often made of many containers which all die together at the end of the stage. Allocating
+ * them from a vtr::Arena turns each allocation into a pointer bump, keeps the data of the stage
+ * together in a few large blocks, and frees it all at once with Arena::release(), instead of
+ * scattering (and fragmenting) the heap over long multi-stage runs.
+ *
+ * Containers use an arena through vtr::arena_allocator, which only holds a pointer to it: all
+ * containers of a given element type have the same type whatever arena (if any) they draw from.
+ * A default constructed arena_allocator (no arena) falls back to the global heap.
+ *
+ * For example:
+ *
+ *      vtr::Arena arena;
+ *
+ *      vtr::arena_vector<ClusterBlockId, float> costs(num_blocks, 0., vtr::arena_allocator<float>(&arena));
+ *      vtr::NdMatrix<int, 2, vtr::arena_allocator<int>> bins({10, 10}, 0, vtr::arena_allocator<int>(&arena));
+ *      ...
+ *      costs.clear(); //Containers must be destroyed/cleared before their arena is released
+ *      ...
+ *      arena.release(); //Frees everything at once
+ *
+ * Memory returned to an arena (e.g. by a growing vector) is only reclaimed by release(), so arenas
+ * are best suited to containers which are sized once, or grown with reserve().
+ *
+ * An Arena is not thread-safe: use one arena per thread.
+ */
+
+namespace vtr {
+
+class Arena {
+  public:
+    ///@brief Size of the first block allocated by default
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    ///@brief Blocks double in size each time the arena runs out of space, up to this size
+    static constexpr size_t MAX_BLOCK_SIZE = 64 * 1024 * 1024;
+
+    explicit Arena(size_t initial_block_size = DEFAULT_BLOCK_SIZE);
+    ~Arena();
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    ///@brief Returns 'bytes' bytes aligned to 'alignment' (a power of 2), valid until release()
+    void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t)) {
+        if (block_) {
+            size_t offset = align_offset(block_, used_, alignment);
+            if (offset <= block_size_ && bytes <= block_size_ - offset) {
+                used_ = offset + bytes;
+                bytes_allocated_ += bytes;
+                return block_ + offset;
+            }
+        }
+        return allocate_from_new_block(bytes, alignment);
+    }
+
+    /**
+     * @brief Frees everything allocated from the arena
+     *
+     * The largest block is kept to serve later allocations, so an arena released at the end
+     * of each iteration of a loop quickly stops allocating from the heap at all.
+     */
+    void release();
+
+    ///@brief Returns the number of bytes allocated since the last release()
+    size_t bytes_allocated() const { return bytes_allocated_; }
+
+    ///@brief Returns the number of bytes reserved from the heap
+    size_t bytes_reserved() const;
+
+  private:
+    ///@brief Returns the first offset from block at or after 'used' which is aligned to 'alignment'
+    static size_t align_offset(const char* block, size_t used, size_t alignment) {
+        uintptr_t addr = reinterpret_cast<uintptr_t>(block) + used;
+        return ((addr + alignment - 1) & ~uintptr_t(alignment - 1)) - reinterpret_cast<uintptr_t>(block);
+    }
+
+    void* allocate_from_new_block(size_t bytes, size_t alignment);
+
+    std::vector<char*> full_blocks_; //Blocks before the current one (freed by release())
+    std::vector<size_t> full_block_sizes_;
+    char* block_ = nullptr;          //Current block
+    size_t block_size_ = 0;
+    size_t used_ = 0; //Bytes used in the current block
+    size_t next_block_size_;
+    size_t bytes_allocated_ = 0;
+};
+
+/**
+ * @brief arena_allocator is a STL allocator that allocates from a vtr::Arena (or the heap if it has none)
+ *
+ * Deallocating is a no-op when allocating from an arena (see Arena::release()). Containers
+ * moved or swapped take their allocator (and therefore arena) along with their elements.
+ */
+template<class T>
+struct arena_allocator {
+    using value_type = T;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    template<class U>
+    struct rebind {
+        using other = arena_allocator<U>;
+    };
+
+    ///@brief Allocates from the heap
+    arena_allocator() noexcept = default;
+
+    ///@brief Allocates from arena_ptr (which must outlive the allocations)
+    explicit arena_allocator(Arena* arena_ptr) noexcept
+        : arena(arena_ptr) {}
+
+    template<class U>
+    arena_allocator(const arena_allocator<U>& other) noexcept
+        : arena(other.arena) {}
+
+    pointer allocate(size_type n, const void* /*hint*/ = 0) {
+        if (n > std::numeric_limits<size_type>::max() / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        if (arena) {
+            return static_cast<pointer>(arena->allocate(sizeof(T) * n, alignof(T)));
+        }
+        return static_cast<pointer>(::operator new(sizeof(T) * n));
+    }
+
+    void deallocate(T* p, size_type /*n*/) {
+        if (!arena) {
+            ::operator delete(p);
+        }
+    }
+
+    Arena* arena = nullptr;
+};
+
+/**
+ * @brief compare two arena_allocators.
+ *
+ * Allocators are the same (i.e. can free each other's memory) if they use the same arena.
+ */
+template<typename T, typename U>
+bool operator==(const arena_allocator<T>& lhs, const arena_allocator<U>& rhs) {
+    return lhs.arena == rhs.arena;
+}
+
+template<typename T, typename U>
+bool operator!=(const arena_allocator<T>& lhs, const arena_allocator<U>& rhs) {
+    return !(lhs == rhs);
+}
+
+///@brief A vtr::vector drawing from an arena
+template<typename K, typename V>
+using arena_vector = vector<K, V, arena_allocator<V>>;
+
+} // namespace vtr
+
+#endif
@@ -3,10 +3,13 @@
 #include <cstdio>  //fprintf, stderr
 #include <cstdlib> //abort
 
+#include "log.h"
+
 namespace vtr {
 namespace assert {
 
 void handle_assert(const char* expr, const char* file, unsigned int line, const char* function, const char* msg) {
+    log_flush(); //Write out the messages logged before the failure
     fprintf(stderr, "%s:%d", file, line);
     if (function) {
         fprintf(stderr, " %s:", function);
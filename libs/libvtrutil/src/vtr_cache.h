@@ -28,6 +28,11 @@ class Cache {
         }
     }
 
+    ///@brief Returns the cached value (if any), whatever its key.
+    const CacheValue* peek() const {
+        return value_.get();
+    }
+
     ///@brief Update the cache.
     const CacheValue* set(const CacheKey& key, std::unique_ptr<CacheValue> value) {
         key_ = key;
@@ -1,39 +1,324 @@
 #include "vtr_digest.h"
 #include "vtr_error.h"
 
-#include <iostream>
-#include <fstream>
+#include <algorithm>
 #include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
-#include "picosha2.h"
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#    define VTR_DIGEST_SHA_NI
+#    include <cpuid.h>
+#    include <immintrin.h>
+#endif
 
 namespace vtr {
 
+namespace {
+
+//Size of the chunks the files are read in
+constexpr size_t DIGEST_READ_SIZE = 1 << 20;
+
+constexpr size_t SHA256_BLOCK_SIZE = 64;
+
+alignas(16) constexpr uint32_t SHA256_K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+typedef void (*t_sha256_compress)(uint32_t state[8], const unsigned char* data, size_t num_blocks);
+
+inline uint32_t rotr(uint32_t x, int n) {
+    return (x >> n) | (x << (32 - n));
+}
+
+//Applies the SHA-256 compression function to num_blocks consecutive 64 byte blocks
+void sha256_compress_portable(uint32_t state[8], const unsigned char* data, size_t num_blocks) {
+    for (; num_blocks > 0; --num_blocks, data += SHA256_BLOCK_SIZE) {
+        uint32_t w[64];
+        for (int i = 0; i < 16; ++i) {
+            w[i] = (uint32_t(data[4 * i]) << 24) | (uint32_t(data[4 * i + 1]) << 16) | (uint32_t(data[4 * i + 2]) << 8) | uint32_t(data[4 * i + 3]);
+        }
+        for (int i = 16; i < 64; ++i) {
+            uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+        for (int i = 0; i < 64; ++i) {
+            uint32_t s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+            uint32_t ch = (e & f) ^ (~e & g);
+            uint32_t t1 = h + s1 + ch + SHA256_K[i] + w[i];
+            uint32_t s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+            uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+            uint32_t t2 = s0 + maj;
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+}
+
+#ifdef VTR_DIGEST_SHA_NI
+//Same as sha256_compress_portable(), with the x86 SHA extensions (SHA-NI)
+__attribute__((target("sha,sse4.1,ssse3"))) void sha256_compress_sha_ni(uint32_t state[8], const unsigned char* data, size_t num_blocks) {
+    const __m128i byte_swap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    //The SHA instructions work on the state words in the (A, B, E, F) and (C, D, G, H) order
+    __m128i tmp = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0]));
+    __m128i state1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4]));
+    tmp = _mm_shuffle_epi32(tmp, 0xB1);
+    state1 = _mm_shuffle_epi32(state1, 0x1B);
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+    for (; num_blocks > 0; --num_blocks, data += SHA256_BLOCK_SIZE) {
+        const __m128i abef = state0;
+        const __m128i cdgh = state1;
+
+        //The last 16 message schedule words, 4 by 4
+        __m128i msg[4];
+        for (int i = 0; i < 4; ++i) {
+            msg[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * i)), byte_swap);
+        }
+
+        //4 rounds at a time
+        for (int i = 0; i < 16; ++i) {
+            if (i >= 4) {
+                //W[t] = W[t - 16] + s0(W[t - 15]) + W[t - 7] + s1(W[t - 2])
+                __m128i w = _mm_sha256msg1_epu32(msg[i & 3], msg[(i + 1) & 3]);
+                w = _mm_add_epi32(w, _mm_alignr_epi8(msg[(i + 3) & 3], msg[(i + 2) & 3], 4));
+                msg[i & 3] = _mm_sha256msg2_epu32(w, msg[(i + 3) & 3]);
+            }
+            __m128i wk = _mm_add_epi32(msg[i & 3], _mm_load_si128(reinterpret_cast<const __m128i*>(&SHA256_K[4 * i])));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, wk);
+            wk = _mm_shuffle_epi32(wk, 0x0E);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, wk);
+        }
+
+        state0 = _mm_add_epi32(state0, abef);
+        state1 = _mm_add_epi32(state1, cdgh);
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);
+    state1 = _mm_shuffle_epi32(state1, 0xB1);
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+    state1 = _mm_alignr_epi8(state1, tmp, 8);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), state0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), state1);
+}
+
+bool cpu_has_sha_ni() {
+    unsigned eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+    const bool has_ssse3 = ecx & (1u << 9);
+    const bool has_sse41 = ecx & (1u << 19);
+
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+    const bool has_sha = ebx & (1u << 29);
+
+    return has_ssse3 && has_sse41 && has_sha;
+}
+#endif
+
+//The fastest compression function the CPU supports
+t_sha256_compress select_sha256_compress() {
+#ifdef VTR_DIGEST_SHA_NI
+    if (cpu_has_sha_ni()) {
+        return sha256_compress_sha_ni;
+    }
+#endif
+    return sha256_compress_portable;
+}
+
+///@brief Incremental SHA-256 (FIPS 180-4)
+class Sha256 {
+  public:
+    Sha256() {
+        static const t_sha256_compress compress = select_sha256_compress();
+        compress_ = compress;
+    }
+
+    void process(const unsigned char* data, size_t size) {
+        total_size_ += size;
+
+        //Complete the partial block first
+        if (buffer_size_ > 0) {
+            size_t num_copied = std::min(size, SHA256_BLOCK_SIZE - buffer_size_);
+            std::memcpy(buffer_.data() + buffer_size_, data, num_copied);
+            buffer_size_ += num_copied;
+            data += num_copied;
+            size -= num_copied;
+            if (buffer_size_ < SHA256_BLOCK_SIZE) {
+                return;
+            }
+            compress_(state_.data(), buffer_.data(), 1);
+            buffer_size_ = 0;
+        }
+
+        //Then the whole blocks, directly from the input
+        size_t num_blocks = size / SHA256_BLOCK_SIZE;
+        compress_(state_.data(), data, num_blocks);
+        data += num_blocks * SHA256_BLOCK_SIZE;
+        size -= num_blocks * SHA256_BLOCK_SIZE;
+
+        std::memcpy(buffer_.data(), data, size);
+        buffer_size_ = size;
+    }
+
+    ///@brief Pads the message and returns its digest as a (lower case) hex string
+    std::string finish() {
+        const uint64_t num_bits = total_size_ * 8;
+
+        //A 1 bit, zeros up to 56 bytes (mod 64), then the message length
+        std::array<unsigned char, 2 * SHA256_BLOCK_SIZE> padding = {};
+        padding[0] = 0x80;
+        size_t padding_size = (buffer_size_ < 56 ? 56 : 120) - buffer_size_;
+        for (int i = 0; i < 8; ++i) {
+            padding[padding_size + i] = (unsigned char)(num_bits >> (56 - 8 * i));
+        }
+        process(padding.data(), padding_size + 8);
+
+        static const char hex_digits[] = "0123456789abcdef";
+        std::string hex;
+        for (uint32_t word : state_) {
+            for (int shift = 28; shift >= 0; shift -= 4) {
+                hex.push_back(hex_digits[(word >> shift) & 0xf]);
+            }
+        }
+        return hex;
+    }
+
+  private:
+    t_sha256_compress compress_;
+    std::array<uint32_t, 8> state_ = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+    std::array<unsigned char, SHA256_BLOCK_SIZE> buffer_;
+    size_t buffer_size_ = 0;
+    uint64_t total_size_ = 0;
+};
+
+//Prefixing with the hash type should allow us to differentiate if the
+//hash type is ever changed in the future
+std::string format_digest(Sha256& hasher) {
+    return "SHA256:" + hasher.finish();
+}
+
+/*
+ * The digests of the files already digested, by path.
+ *
+ * VPR usually digests the files it writes (e.g. to record the placement id),
+ * then digests them again when they are read back, e.g. with --verify_file_digests,
+ * so a digest is reused if the size and modification time of the file are unchanged.
+ */
+struct t_file_digest {
+    uintmax_t size;
+    std::filesystem::file_time_type mtime;
+    std::string digest;
+};
+
+/*
+ * Whether a file last modified at mtime, and digested from digest_time on, could not
+ * have been modified again without changing its mtime (which a digest could then miss).
+ * Some file systems only store the modification times to the second (or two), so a file
+ * modified (again) during the second it was digested in would keep the same mtime.
+ */
+bool is_digest_reusable(std::filesystem::file_time_type mtime, std::filesystem::file_time_type digest_time) {
+    const auto since_epoch = mtime.time_since_epoch();
+    const bool coarse_mtime = since_epoch % std::chrono::seconds(1) == since_epoch.zero();
+    const auto margin = coarse_mtime ? std::chrono::seconds(2) : std::chrono::seconds(0);
+    return mtime + margin < digest_time;
+}
+
+std::mutex file_digests_mutex;
+std::unordered_map<std::string, t_file_digest> file_digests;
+
+} // namespace
+
 std::string secure_digest_file(const std::string& filepath) {
-    std::ifstream is(filepath);
-    if (!is) {
+    std::error_code size_error, mtime_error;
+    uintmax_t size = std::filesystem::file_size(filepath, size_error);
+    std::filesystem::file_time_type mtime = std::filesystem::last_write_time(filepath, mtime_error);
+    const bool cacheable = !size_error && !mtime_error;
+
+    if (cacheable) {
+        std::lock_guard<std::mutex> lock(file_digests_mutex);
+        auto it = file_digests.find(filepath);
+        if (it != file_digests.end() && it->second.size == size && it->second.mtime == mtime) {
+            return it->second.digest;
+        }
+    }
+
+    const std::filesystem::file_time_type digest_time = std::filesystem::file_time_type::clock::now();
+    std::unique_ptr<std::FILE, int (*)(std::FILE*)> file(std::fopen(filepath.c_str(), "rb"), std::fclose);
+    if (!file) {
         throw VtrError("Failed to open file", filepath);
     }
-    return secure_digest_stream(is);
+
+    //Read the file in large chunks, bypassing the stream buffers
+    Sha256 hasher;
+    std::vector<unsigned char> buf(DIGEST_READ_SIZE);
+    size_t num_read;
+    while ((num_read = std::fread(buf.data(), 1, buf.size(), file.get())) > 0) {
+        hasher.process(buf.data(), num_read);
+    }
+    if (std::ferror(file.get())) {
+        throw VtrError("Failed to read file", filepath);
+    }
+    std::string digest = format_digest(hasher);
+
+    if (cacheable && is_digest_reusable(mtime, digest_time)) {
+        std::lock_guard<std::mutex> lock(file_digests_mutex);
+        file_digests[filepath] = {size, mtime, digest};
+    }
+    return digest;
 }
 
 std::string secure_digest_stream(std::istream& is) {
     //Read the stream in chunks and calculate the SHA256 digest
-    picosha2::hash256_one_by_one hasher;
+    Sha256 hasher;
 
-    std::array<char, 1024> buf;
+    std::vector<char> buf(DIGEST_READ_SIZE);
     while (!is.eof()) {
         //Process a chunk
         is.read(buf.data(), buf.size());
-        hasher.process(buf.begin(), buf.begin() + is.gcount());
+        hasher.process(reinterpret_cast<const unsigned char*>(buf.data()), is.gcount());
     }
-    hasher.finish();
 
     //Return the digest as a hex string, prefixed with the hash type
-    //
-    //Prefixing with the hash type should allow us to differentiate if the
-    //hash type is ever changed in the future
-    return "SHA256:" + picosha2::get_hash_hex_string(hasher);
+    return format_digest(hasher);
 }
 
 } // namespace vtr
@@ -5,7 +5,12 @@
 
 namespace vtr {
 
-///@brief Generate a secure hash of the file at filepath
+/**
+ * @brief Generate a secure hash of the file at filepath
+ *
+ * The digest of a file is remembered, and reused while the size and
+ * modification time of the file are unchanged.
+ */
 std::string secure_digest_file(const std::string& filepath);
 
 ///@brief Generate a secure hash of a stream
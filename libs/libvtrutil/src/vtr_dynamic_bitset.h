@@ -1,10 +1,202 @@
 #ifndef VTR_DYNAMIC_BITSET
 #define VTR_DYNAMIC_BITSET
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <limits>
 #include <vector>
 
+#if defined(__SSE2__) || defined(__AVX2__)
+#    include <immintrin.h>
+#endif
+
+#include "vtr_assert.h"
+
 namespace vtr {
+
+namespace dynamic_bitset_impl {
+
+/*
+ * Word-level kernels of dynamic_bitset.
+ *
+ * The bitwise kernels process the storage 32 (AVX2) or 16 (SSE2) bytes at a
+ * time when the compiler targets those instruction sets, and finish with a
+ * loop over the remaining words. The reductions work on 64-bit words, for
+ * which the builtins compile to popcnt/tzcnt where available.
+ */
+
+///@brief Number of bytes processed at a time by the vector kernels
+#if defined(__AVX2__)
+constexpr size_t kVectorBytes = 32;
+#elif defined(__SSE2__)
+constexpr size_t kVectorBytes = 16;
+#else
+constexpr size_t kVectorBytes = 0;
+#endif
+
+enum class e_bitwise_op {
+    AND,
+    OR,
+    XOR,
+    AND_NOT
+};
+
+template<e_bitwise_op op, typename Storage>
+inline Storage apply_bitwise_op(Storage lhs, Storage rhs) {
+    switch (op) {
+        case e_bitwise_op::AND:
+            return lhs & rhs;
+        case e_bitwise_op::OR:
+            return lhs | rhs;
+        case e_bitwise_op::XOR:
+            return lhs ^ rhs;
+        case e_bitwise_op::AND_NOT:
+        default:
+            return lhs & ~rhs;
+    }
+}
+
+///@brief lhs[i] = lhs[i] op rhs[i] for i in [0, n)
+template<e_bitwise_op op, typename Storage>
+inline void bitwise_op(Storage* lhs, const Storage* rhs, size_t n) {
+    size_t i = 0;
+#if defined(__AVX2__) || defined(__SSE2__)
+    constexpr size_t kWordsPerVector = kVectorBytes / sizeof(Storage);
+    for (; i + kWordsPerVector <= n; i += kWordsPerVector) {
+#    if defined(__AVX2__)
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i));
+        switch (op) {
+            case e_bitwise_op::AND:
+                a = _mm256_and_si256(a, b);
+                break;
+            case e_bitwise_op::OR:
+                a = _mm256_or_si256(a, b);
+                break;
+            case e_bitwise_op::XOR:
+                a = _mm256_xor_si256(a, b);
+                break;
+            case e_bitwise_op::AND_NOT:
+                a = _mm256_andnot_si256(b, a);
+                break;
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lhs + i), a);
+#    else
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + i));
+        switch (op) {
+            case e_bitwise_op::AND:
+                a = _mm_and_si128(a, b);
+                break;
+            case e_bitwise_op::OR:
+                a = _mm_or_si128(a, b);
+                break;
+            case e_bitwise_op::XOR:
+                a = _mm_xor_si128(a, b);
+                break;
+            case e_bitwise_op::AND_NOT:
+                a = _mm_andnot_si128(b, a);
+                break;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lhs + i), a);
+#    endif
+    }
+#endif
+    for (; i < n; i++) {
+        lhs[i] = apply_bitwise_op<op>(lhs[i], rhs[i]);
+    }
+}
+
+///@brief Returns true if any word of [words, words + n) is non-zero
+template<typename Storage>
+inline bool any(const Storage* words, size_t n) {
+    size_t i = 0;
+#if defined(__AVX2__) || defined(__SSE2__)
+    constexpr size_t kWordsPerVector = kVectorBytes / sizeof(Storage);
+    for (; i + kWordsPerVector <= n; i += kWordsPerVector) {
+#    if defined(__AVX2__)
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+        if (!_mm256_testz_si256(a, a)) {
+            return true;
+        }
+#    else
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(a, _mm_setzero_si128())) != 0xFFFF) {
+            return true;
+        }
+#    endif
+    }
+#endif
+    for (; i < n; i++) {
+        if (words[i] != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+///@brief Returns true if lhs[i] & rhs[i] is non-zero for some i in [0, n)
+template<typename Storage>
+inline bool intersects(const Storage* lhs, const Storage* rhs, size_t n) {
+    size_t i = 0;
+#if defined(__AVX2__) || defined(__SSE2__)
+    constexpr size_t kWordsPerVector = kVectorBytes / sizeof(Storage);
+    for (; i + kWordsPerVector <= n; i += kWordsPerVector) {
+#    if defined(__AVX2__)
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i));
+        if (!_mm256_testz_si256(a, b)) {
+            return true;
+        }
+#    else
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(a, b), _mm_setzero_si128())) != 0xFFFF) {
+            return true;
+        }
+#    endif
+    }
+#endif
+    for (; i < n; i++) {
+        if ((lhs[i] & rhs[i]) != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename Storage>
+inline size_t popcount(Storage word) {
+    return __builtin_popcountll((unsigned long long)word);
+}
+
+template<typename Storage>
+inline size_t count_trailing_zeros(Storage word) {
+    return __builtin_ctzll((unsigned long long)word);
+}
+
+///@brief Returns the number of set bits in [words, words + n)
+template<typename Storage>
+inline size_t count(const Storage* words, size_t n) {
+    size_t out = 0;
+    size_t i = 0;
+    if (sizeof(Storage) < sizeof(uint64_t)) {
+        //Count 64 bits at a time (memcpy keeps this free of aliasing issues)
+        constexpr size_t kWordsPer64 = sizeof(uint64_t) / sizeof(Storage);
+        for (; i + kWordsPer64 <= n; i += kWordsPer64) {
+            uint64_t word;
+            std::memcpy(&word, words + i, sizeof(word));
+            out += __builtin_popcountll(word);
+        }
+    }
+    for (; i < n; i++) {
+        out += popcount(words[i]);
+    }
+    return out;
+}
+
+} // namespace dynamic_bitset_impl
 /**
  * @brief A container to represent a set of flags either they are set or reset 
  *
@@ -55,9 +247,9 @@ class dynamic_bitset {
         size_t index_value(index);
         VTR_ASSERT_SAFE(index_value < size());
         if (val) {
-            array_[index_value / kWidth] |= (1 << (index_value % kWidth));
+            array_[index_value / kWidth] |= (Storage(1) << (index_value % kWidth));
         } else {
-            array_[index_value / kWidth] &= ~(1u << (index_value % kWidth));
+            array_[index_value / kWidth] &= ~(Storage(1) << (index_value % kWidth));
         }
     }
 
@@ -65,31 +257,91 @@ class dynamic_bitset {
     bool get(Index index) const {
         size_t index_value(index);
         VTR_ASSERT_SAFE(index_value < size());
-        return (array_[index_value / kWidth] & (1u << (index_value % kWidth))) != 0;
+        return (array_[index_value / kWidth] & (Storage(1) << (index_value % kWidth))) != 0;
     }
 
     ///@brief Return count of set bits.
-    constexpr size_t count(void) const {
-        size_t out = 0;
-        for (auto x : array_)
-            out += __builtin_popcount(x);
-        return out;
+    size_t count(void) const {
+        return dynamic_bitset_impl::count(array_.data(), array_.size());
     }
 
-    ///@brief Bitwise OR with rhs. Truncate the operation if one operand is smaller.
-    constexpr dynamic_bitset<Index, Storage>& operator|=(const dynamic_bitset<Index, Storage>& x) {
+    ///@brief Return true if any bit is set.
+    bool any(void) const {
+        return dynamic_bitset_impl::any(array_.data(), array_.size());
+    }
+
+    ///@brief Return true if no bit is set.
+    bool none(void) const {
+        return !any();
+    }
+
+    ///@brief Return true if some bit is set in both this and rhs (without building their intersection).
+    bool intersects(const dynamic_bitset<Index, Storage>& x) const {
         size_t n = std::min(array_.size(), x.array_.size());
-        for (size_t i = 0; i < n; i++)
-            array_[i] |= x.array_[i];
-        return *this;
+        return dynamic_bitset_impl::intersects(array_.data(), x.array_.data(), n);
     }
 
-    ///@brief Bitwise AND with rhs. Truncate the operation if one operand is smaller.
-    constexpr dynamic_bitset<Index, Storage>& operator&=(const dynamic_bitset<Index, Storage>& x) {
+    ///@brief Return true if every bit set in this is also set in rhs. Bits beyond the size of rhs count as not set.
+    bool is_subset_of(const dynamic_bitset<Index, Storage>& x) const {
         size_t n = std::min(array_.size(), x.array_.size());
-        for (size_t i = 0; i < n; i++)
-            array_[i] &= x.array_[i];
-        return *this;
+        for (size_t i = 0; i < n; i++) {
+            if ((array_[i] & ~x.array_[i]) != 0) {
+                return false;
+            }
+        }
+        return !dynamic_bitset_impl::any(array_.data() + n, array_.size() - n);
+    }
+
+    ///@brief Return the index of the first set bit, or size() if none is set.
+    size_t find_first(void) const {
+        return find_from_word(0);
+    }
+
+    ///@brief Return the index of the first set bit after index, or size() if there is none.
+    size_t find_next(size_t index) const {
+        size_t next = index + 1;
+        if (next >= size()) {
+            return size();
+        }
+
+        size_t iword = next / kWidth;
+        Storage word = array_[iword] & (std::numeric_limits<Storage>::max() << (next % kWidth));
+        if (word != 0) {
+            return iword * kWidth + dynamic_bitset_impl::count_trailing_zeros(word);
+        }
+        return find_from_word(iword + 1);
+    }
+
+    ///@brief Call func(index) for each set bit, in increasing order of index.
+    template<typename Func>
+    void for_each_set_bit(Func func) const {
+        for (size_t iword = 0; iword < array_.size(); iword++) {
+            Storage word = array_[iword];
+            while (word != 0) {
+                func(iword * kWidth + dynamic_bitset_impl::count_trailing_zeros(word));
+                word &= word - 1; //Clear the lowest set bit
+            }
+        }
+    }
+
+    ///@brief Bitwise OR with rhs. Truncate the operation if one operand is smaller.
+    dynamic_bitset<Index, Storage>& operator|=(const dynamic_bitset<Index, Storage>& x) {
+        return apply<dynamic_bitset_impl::e_bitwise_op::OR>(x);
+    }
+
+    ///@brief Bitwise AND with rhs. Truncate the operation if one operand is smaller.
+    dynamic_bitset<Index, Storage>& operator&=(const dynamic_bitset<Index, Storage>& x) {
+        return apply<dynamic_bitset_impl::e_bitwise_op::AND>(x);
+    }
+
+    ///@brief Bitwise XOR with rhs. Truncate the operation if one operand is smaller.
+    dynamic_bitset<Index, Storage>& operator^=(const dynamic_bitset<Index, Storage>& x) {
+        return apply<dynamic_bitset_impl::e_bitwise_op::XOR>(x);
+    }
+
+    ///@brief Clear the bits set in rhs (this &= ~rhs, without building ~rhs). Truncate the operation if one operand is smaller.
+    dynamic_bitset<Index, Storage>& and_not(const dynamic_bitset<Index, Storage>& x) {
+        return apply<dynamic_bitset_impl::e_bitwise_op::AND_NOT>(x);
     }
 
     ///@brief Return inverted bitset.
@@ -102,6 +354,23 @@ class dynamic_bitset {
     }
 
   private:
+    template<dynamic_bitset_impl::e_bitwise_op op>
+    dynamic_bitset<Index, Storage>& apply(const dynamic_bitset<Index, Storage>& x) {
+        size_t n = std::min(array_.size(), x.array_.size());
+        dynamic_bitset_impl::bitwise_op<op>(array_.data(), x.array_.data(), n);
+        return *this;
+    }
+
+    ///@brief Return the index of the first set bit in the words from iword on, or size() if there is none.
+    size_t find_from_word(size_t iword) const {
+        for (; iword < array_.size(); iword++) {
+            if (array_[iword] != 0) {
+                return iword * kWidth + dynamic_bitset_impl::count_trailing_zeros(array_[iword]);
+            }
+        }
+        return size();
+    }
+
     std::vector<Storage> array_;
 };
 
@@ -3,6 +3,7 @@
 #include "vtr_util.h"
 #include "vtr_math.h"
 
+#include <algorithm>
 #include <string>
 #include <sstream>
 #include <iostream>
@@ -24,10 +25,11 @@ static int before_addition = 0;
 
 /*---- Functions for Parsing the Symbolic Formulas ----*/
 
-/* converts specified formula to a vector in reverse-polish notation */
-static void formula_to_rpn(const char* formula, const t_formula_data& mydata, vector<Formula_Object>& rpn_output, stack<Formula_Object>& op_stack, bool is_breakpoint);
+/* converts specified formula to a vector in reverse-polish notation. If var_names is not null, variables
+ * are not resolved: they are left as E_FML_VARIABLE objects indexing var_names instead */
+static void formula_to_rpn(const char* formula, const t_formula_data& mydata, vector<Formula_Object>& rpn_output, stack<Formula_Object>& op_stack, bool is_breakpoint, vector<string>* var_names = nullptr);
 
-static void get_formula_object(const char* ch, int& ichar, const t_formula_data& mydata, Formula_Object* fobj, bool is_breakpoint);
+static void get_formula_object(const char* ch, int& ichar, const t_formula_data& mydata, Formula_Object* fobj, bool is_breakpoint, vector<string>* var_names);
 
 /* returns integer specifying precedence of passed-in operator. higher integer
  * means higher precedence */
@@ -84,6 +86,19 @@ bool additional_assignment_op(int arg1, int arg2);
 /**** Function Implementations ****/
 /* returns integer result according to specified non-piece-wise formula and data */
 int FormulaParser::parse_formula(const std::string& formula, const t_formula_data& mydata, bool is_breakpoint) {
+    if (!is_breakpoint) {
+        auto iter = compiled_formulas_.find(formula);
+        if (iter == compiled_formulas_.end()) {
+            t_compiled_formula compiled;
+            formula_to_rpn(formula.c_str(), mydata, compiled.rpn, op_stack_, is_breakpoint, &compiled.var_names);
+            if (compiled.rpn.empty()) {
+                throw vtr::VtrError(vtr::string_fmt("parse_formula: empty formula '%s'\n", formula.c_str()), __FILE__, __LINE__);
+            }
+            iter = compiled_formulas_.emplace(formula, std::move(compiled)).first;
+        }
+        return evaluate_compiled_formula(iter->second, mydata);
+    }
+
     int result = -1;
 
     /* output in reverse-polish notation */
@@ -99,6 +114,38 @@ int FormulaParser::parse_formula(const std::string& formula, const t_formula_dat
     return result;
 }
 
+/* evaluates a compiled formula with a stack, resolving its variables from mydata */
+int FormulaParser::evaluate_compiled_formula(const t_compiled_formula& compiled, const t_formula_data& mydata) {
+    auto& eval_stack = eval_stack_;
+    eval_stack.clear();
+
+    for (const Formula_Object& fobj : compiled.rpn) {
+        if (E_FML_OPERATOR == fobj.type) {
+            if (eval_stack.size() < 2) {
+                throw vtr::VtrError(vtr::string_fmt("evaluate_compiled_formula(): operator '%s' is missing an operand\n", fobj.to_string().c_str()), __FILE__, __LINE__);
+            }
+            /* the result replaces the two arguments on the stack */
+            Formula_Object result;
+            result.type = E_FML_NUMBER;
+            result.data.num = apply_rpn_op(eval_stack[eval_stack.size() - 2], eval_stack.back(), fobj);
+            eval_stack.pop_back();
+            eval_stack.back() = result;
+        } else if (E_FML_VARIABLE == fobj.type) {
+            Formula_Object value;
+            value.type = E_FML_NUMBER;
+            value.data.num = mydata.get_var_value(compiled.var_names[fobj.data.num]);
+            eval_stack.push_back(value);
+        } else {
+            eval_stack.push_back(fobj);
+        }
+    }
+
+    if (eval_stack.size() != 1) {
+        throw vtr::VtrError(vtr::string_fmt("evaluate_compiled_formula(): found multiple numbers in formula, but no operator\n"), __FILE__, __LINE__);
+    }
+    return eval_stack.back().data.num;
+}
+
 /* EXPERIMENTAL:
  *
  * returns integer result according to specified piece-wise formula and data. the piecewise
@@ -225,7 +272,7 @@ static bool goto_next_char(int* str_ind, const string& pw_formula, char ch) {
 
 /* Parses the specified formula using a shunting yard algorithm (see wikipedia). The function's result
  * is stored in the rpn_output vector in reverse-polish notation */
-static void formula_to_rpn(const char* formula, const t_formula_data& mydata, vector<Formula_Object>& rpn_output, stack<Formula_Object>& op_stack, bool is_breakpoint) {
+static void formula_to_rpn(const char* formula, const t_formula_data& mydata, vector<Formula_Object>& rpn_output, stack<Formula_Object>& op_stack, bool is_breakpoint, vector<string>* var_names) {
     // Empty op_stack.
     while (!op_stack.empty()) {
         op_stack.pop();
@@ -246,7 +293,7 @@ static void formula_to_rpn(const char* formula, const t_formula_data& mydata, ve
             /* skip space */
         } else {
             /* parse the character */
-            get_formula_object(ch, ichar, mydata, &fobj, is_breakpoint);
+            get_formula_object(ch, ichar, mydata, &fobj, is_breakpoint, var_names);
             switch (fobj.type) {
                 case E_FML_NUMBER:
                     /* add to output vector */
@@ -293,7 +340,7 @@ static void formula_to_rpn(const char* formula, const t_formula_data& mydata, ve
  * which help determine which numeric value, if any, gets assigned to fobj
  * ichar is incremented by the corresponding count if the need to step through the
  * character array arises */
-static void get_formula_object(const char* ch, int& ichar, const t_formula_data& mydata, Formula_Object* fobj, bool is_breakpoint) {
+static void get_formula_object(const char* ch, int& ichar, const t_formula_data& mydata, Formula_Object* fobj, bool is_breakpoint, vector<string>* var_names) {
     /* the character can either be part of a number, or it can be an object like W, t, (, +, etc
      * here we have to account for both possibilities */
 
@@ -315,6 +362,14 @@ static void get_formula_object(const char* ch, int& ichar, const t_formula_data&
                 throw vtr::VtrError(vtr::string_fmt("in get_formula_object: recognized function: %s\n", var_name.c_str()), __FILE__, __LINE__);
             }
 
+        } else if (!is_breakpoint && var_names) {
+            //A variable, resolved when the formula is evaluated
+            fobj->type = E_FML_VARIABLE;
+            auto iter = std::find(var_names->begin(), var_names->end(), var_name);
+            fobj->data.num = iter - var_names->begin();
+            if (iter == var_names->end()) {
+                var_names->push_back(var_name);
+            }
         } else if (!is_breakpoint) {
             //A number
             fobj->type = E_FML_NUMBER;
@@ -2,6 +2,7 @@
 #define EXPR_EVAL_H
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <stack>
 #include <cstring>
@@ -213,7 +214,13 @@ class FormulaParser {
     FormulaParser(const FormulaParser&) = delete;
     FormulaParser& operator=(const FormulaParser&) = delete;
 
-    ///@brief returns integer result according to specified formula and data
+    /**
+     * @brief returns integer result according to specified formula and data
+     *
+     * Formulas (other than breakpoints) are converted to reverse-polish notation once
+     * per parser, with their variables left unresolved: evaluating the same formula
+     * again, with any variable values, does not parse it again.
+     */
     int parse_formula(const std::string& formula, const t_formula_data& mydata, bool is_breakpoint = false);
 
     ///@brief returns integer result according to specified piece-wise formula and data
@@ -223,8 +230,23 @@ class FormulaParser {
     static bool is_piecewise_formula(const char* formula);
 
   private:
+    ///@brief a formula in reverse-polish notation, whose variables are resolved when it is evaluated
+    struct t_compiled_formula {
+        std::vector<Formula_Object> rpn;    ///< variables are E_FML_VARIABLE objects whose data.num indexes var_names
+        std::vector<std::string> var_names; ///< names of the variables used by the formula
+    };
+
+    ///@brief returns integer result of a compiled formula, with the variable values of mydata
+    int evaluate_compiled_formula(const t_compiled_formula& compiled, const t_formula_data& mydata);
+
     std::vector<Formula_Object> rpn_output_;
 
+    ///@brief compiled formulas, by formula string
+    std::unordered_map<std::string, t_compiled_formula> compiled_formulas_;
+
+    // stack for evaluating compiled formulas
+    std::vector<Formula_Object> eval_stack_;
+
     // stack for handling operators and brackets in formula
     std::stack<Formula_Object> op_stack_;
 };
@@ -0,0 +1,442 @@
+#ifndef VTR_FLAT_HASH_MAP_H
+#define VTR_FLAT_HASH_MAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "vtr_strong_id.h"
+
+/**
+ * @file
+ * @brief An open-addressing hash map (nearly std::unordered_map compatible)
+ *
+ * Overview
+ * ========
+ * vtr::flat_hash_map stores its key-value pairs directly in one array of slots, probed linearly,
+ * next to an array of one control byte per slot. A control byte records whether its slot is
+ * empty, erased, or full, and for full slots 7 bits of the key's hash: a look-up only compares
+ * the keys whose hash bits match, and scans bytes which are contiguous in memory. Unlike
+ * std::unordered_map there's no per-element node allocation, and no pointer chasing on look-ups.
+ *
+ * Keys are hashed with vtr::flat_hash, which mixes std::hash (which is the identity for integers
+ * and pointers in common standard libraries, i.e. too regular for probing a power of 2 sized
+ * table). StrongId keys (dense integers) only need a multiply.
+ *
+ * The container deviates from the behaviour of std::unordered_map in the following important ways:
+ *    - Iterators, references and pointers to elements are invalidated by insertions which grow the
+ *      table (as for a std::vector), so don't keep references to values across insertions
+ *    - Erasing doesn't invalidate iterators, or references, to other elements
+ *    - The iteration order is unspecified, and differs from std::unordered_map's: only use it for
+ *      maps whose iteration order doesn't matter
+ *
+ * For example:
+ *
+ *      vtr::flat_hash_map<AtomNetId, int> num_feeds;
+ *      num_feeds[net_id]++;
+ *      ...
+ *      auto iter = num_feeds.find(net_id);
+ *      if (iter != num_feeds.end()) { ... }
+ */
+
+namespace vtr {
+
+///@brief Default hasher of flat_hash_map: std::hash with its bits mixed (murmur3 finalizer)
+template<class K>
+struct flat_hash {
+    std::size_t operator()(const K& key) const noexcept {
+        uint64_t h = std::hash<K>()(key);
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdu;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53u;
+        h ^= h >> 33;
+        return std::size_t(h);
+    }
+};
+
+/**
+ * @brief flat_hash specialization for StrongIds
+ *
+ * Ids are dense integers: multiplying by an odd constant spreads consecutive ids over distinct slots
+ * (the low bits, which select the slot), and fills the high bits (which are stored as a tag).
+ */
+template<typename tag, typename T, T sentinel>
+struct flat_hash<StrongId<tag, T, sentinel>> {
+    std::size_t operator()(const StrongId<tag, T, sentinel> id) const noexcept {
+        return std::size_t(uint64_t(std::size_t(id)) * 0x9e3779b97f4a7c15u);
+    }
+};
+
+template<class K, class V, class Hash = flat_hash<K>, class KeyEqual = std::equal_to<K>>
+class flat_hash_map {
+  public:
+    typedef K key_type;
+    typedef V mapped_type;
+    typedef std::pair<const K, V> value_type;
+    typedef Hash hasher;
+    typedef KeyEqual key_equal;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+  private:
+    template<bool Const>
+    class Iterator {
+      public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef typename flat_hash_map::value_type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef typename std::conditional<Const, const value_type*, value_type*>::type pointer;
+        typedef typename std::conditional<Const, const value_type&, value_type&>::type reference;
+        typedef typename std::conditional<Const, const flat_hash_map*, flat_hash_map*>::type map_pointer;
+
+        Iterator() = default;
+
+        Iterator(map_pointer map, size_t index)
+            : map_(map)
+            , index_(index) {
+            skip_free();
+        }
+
+        ///@brief Allow converting an iterator to a const_iterator
+        template<bool OtherConst, typename = typename std::enable_if<Const && !OtherConst>::type>
+        Iterator(const Iterator<OtherConst>& other)
+            : map_(other.map_)
+            , index_(other.index_) {}
+
+        reference operator*() const { return map_->slots_[index_]; }
+        pointer operator->() const { return &map_->slots_[index_]; }
+
+        Iterator& operator++() {
+            ++index_;
+            skip_free();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator prev = *this;
+            ++(*this);
+            return prev;
+        }
+
+        friend bool operator==(const Iterator& lhs, const Iterator& rhs) { return lhs.index_ == rhs.index_; }
+        friend bool operator!=(const Iterator& lhs, const Iterator& rhs) { return lhs.index_ != rhs.index_; }
+
+      private:
+        void skip_free() {
+            while (index_ < map_->capacity_ && !is_full(map_->ctrl_[index_])) {
+                ++index_;
+            }
+        }
+
+        map_pointer map_ = nullptr;
+        size_t index_ = 0;
+
+        friend class flat_hash_map;
+        template<bool>
+        friend class Iterator;
+    };
+
+  public:
+    typedef Iterator<false> iterator;
+    typedef Iterator<true> const_iterator;
+
+  public: //Constructors
+    flat_hash_map() = default;
+
+    ///@brief Constructs an empty map with room for at least num_elements without re-hashing
+    explicit flat_hash_map(size_type num_elements) {
+        reserve(num_elements);
+    }
+
+    flat_hash_map(std::initializer_list<value_type> init) {
+        reserve(init.size());
+        for (const value_type& value : init) {
+            insert(value);
+        }
+    }
+
+    flat_hash_map(const flat_hash_map& other)
+        : hash_(other.hash_)
+        , equal_(other.equal_) {
+        reserve(other.size());
+        for (const value_type& value : other) {
+            emplace_new(value.first, value);
+        }
+    }
+
+    flat_hash_map(flat_hash_map&& other) noexcept
+        : flat_hash_map() {
+        swap(*this, other);
+    }
+
+    flat_hash_map& operator=(flat_hash_map other) noexcept {
+        swap(*this, other);
+        return *this;
+    }
+
+    ~flat_hash_map() {
+        destroy_slots();
+    }
+
+  public: //Accessors
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, capacity_); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, capacity_); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    bool empty() const { return size_ == 0; }
+    size_type size() const { return size_; }
+
+    ///@brief Returns the number of slots
+    size_type capacity() const { return capacity_; }
+
+    iterator find(const key_type& key) {
+        return iterator(this, find_index(key));
+    }
+
+    const_iterator find(const key_type& key) const {
+        return const_iterator(this, find_index(key));
+    }
+
+    size_type count(const key_type& key) const {
+        return find_index(key) != capacity_ ? 1 : 0;
+    }
+
+    bool contains(const key_type& key) const {
+        return find_index(key) != capacity_;
+    }
+
+    ///@brief Returns the value of key (throws std::out_of_range if absent)
+    mapped_type& at(const key_type& key) {
+        size_t index = find_index(key);
+        if (index == capacity_) {
+            throw std::out_of_range("Key not found");
+        }
+        return slots_[index].second;
+    }
+
+    const mapped_type& at(const key_type& key) const {
+        return const_cast<flat_hash_map*>(this)->at(key);
+    }
+
+  public: //Mutators
+    ///@brief Returns the value of key, inserting a value-initialized one if absent
+    mapped_type& operator[](const key_type& key) {
+        return try_emplace(key).first->second;
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value) {
+        return try_emplace(value.first, value.second);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value) {
+        return try_emplace(value.first, std::move(value.second));
+    }
+
+    template<class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {
+        //The key has to be known to find its slot, so build the element first
+        value_type value(std::forward<Args>(args)...);
+        return try_emplace(value.first, std::move(value.second));
+    }
+
+    ///@brief Inserts (key, V(args...)) if key is absent, and returns an iterator to the value of key
+    template<class... Args>
+    std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args) {
+        size_t index = find_index(key);
+        if (index != capacity_) {
+            return {iterator(this, index), false};
+        }
+        index = emplace_new(key, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+        return {iterator(this, index), true};
+    }
+
+    ///@brief Erases key, and returns the number of elements erased (0 or 1)
+    size_type erase(const key_type& key) {
+        size_t index = find_index(key);
+        if (index == capacity_) {
+            return 0;
+        }
+        erase_index(index);
+        return 1;
+    }
+
+    ///@brief Erases the element at pos, and returns an iterator to the following element
+    iterator erase(const_iterator pos) {
+        erase_index(pos.index_);
+        return iterator(this, pos.index_ + 1);
+    }
+
+    void clear() {
+        for (size_t i = 0; i < capacity_; ++i) {
+            if (is_full(ctrl_[i])) {
+                slots_[i].~value_type();
+            }
+            ctrl_[i] = EMPTY;
+        }
+        size_ = 0;
+        num_erased_ = 0;
+    }
+
+    ///@brief Makes room for at least num_elements without re-hashing
+    void reserve(size_type num_elements) {
+        size_t new_capacity = MIN_CAPACITY;
+        while (max_load(new_capacity) < num_elements) {
+            new_capacity *= 2;
+        }
+        if (new_capacity > capacity_) {
+            rehash(new_capacity);
+        }
+    }
+
+    ///@brief Swap (this enables std::swap via ADL)
+    friend void swap(flat_hash_map& lhs, flat_hash_map& rhs) noexcept {
+        using std::swap;
+        swap(lhs.ctrl_, rhs.ctrl_);
+        swap(lhs.slots_, rhs.slots_);
+        swap(lhs.capacity_, rhs.capacity_);
+        swap(lhs.size_, rhs.size_);
+        swap(lhs.num_erased_, rhs.num_erased_);
+        swap(lhs.hash_, rhs.hash_);
+        swap(lhs.equal_, rhs.equal_);
+    }
+
+  private:
+    //Control bytes: full slots store 7 bits of their key's hash (0..127)
+    static constexpr int8_t EMPTY = -128;
+    static constexpr int8_t ERASED = -2;
+
+    static constexpr size_t MIN_CAPACITY = 8;
+
+    static bool is_full(int8_t ctrl) { return ctrl >= 0; }
+
+    static int8_t hash_tag(size_t hash) { return int8_t(uint64_t(hash) >> 57); }
+
+    //At most 3/4 of the slots are used (full or erased), which keeps linear probe sequences short
+    //(and ensures they always end on an empty slot)
+    static size_t max_load(size_t capacity) { return capacity - capacity / 4; }
+
+    //Returns the index of key's slot, or capacity_ if absent
+    size_t find_index(const key_type& key) const {
+        if (size_ == 0) {
+            return capacity_;
+        }
+        size_t hash = hash_(key);
+        int8_t tag = hash_tag(hash);
+        size_t mask = capacity_ - 1;
+        for (size_t index = hash & mask;; index = (index + 1) & mask) {
+            int8_t ctrl = ctrl_[index];
+            if (ctrl == tag && equal_(slots_[index].first, key)) {
+                return index;
+            }
+            if (ctrl == EMPTY) {
+                return capacity_;
+            }
+        }
+    }
+
+    //Constructs an element (from args) for key, which must be absent, and returns its index
+    template<class... Args>
+    size_t emplace_new(const key_type& key, Args&&... args) {
+        if (size_ + num_erased_ + 1 > max_load(capacity_)) {
+            //Grow if mostly full, otherwise only clean up the erased slots
+            rehash(size_ + 1 > capacity_ / 2 ? std::max(2 * capacity_, size_t(MIN_CAPACITY)) : capacity_);
+        }
+
+        size_t hash = hash_(key);
+        size_t index = free_index(hash);
+        ::new (static_cast<void*>(&slots_[index])) value_type(std::forward<Args>(args)...);
+        if (ctrl_[index] == ERASED) {
+            --num_erased_;
+        }
+        ctrl_[index] = hash_tag(hash);
+        ++size_;
+        return index;
+    }
+
+    //Returns the first free (empty or erased) slot on the probe sequence of hash
+    size_t free_index(size_t hash) const {
+        size_t mask = capacity_ - 1;
+        size_t index = hash & mask;
+        while (is_full(ctrl_[index])) {
+            index = (index + 1) & mask;
+        }
+        return index;
+    }
+
+    void erase_index(size_t index) {
+        slots_[index].~value_type();
+        //A slot followed by an empty one ends every probe sequence through it, so it can be
+        //marked empty again rather than erased
+        if (ctrl_[(index + 1) & (capacity_ - 1)] == EMPTY) {
+            ctrl_[index] = EMPTY;
+        } else {
+            ctrl_[index] = ERASED;
+            ++num_erased_;
+        }
+        --size_;
+    }
+
+    void rehash(size_t new_capacity) {
+        std::vector<int8_t> old_ctrl(new_capacity, int8_t(EMPTY));
+        std::swap(old_ctrl, ctrl_);
+        value_type* old_slots = slots_;
+        size_t old_capacity = capacity_;
+
+        slots_ = std::allocator<value_type>().allocate(new_capacity);
+        capacity_ = new_capacity;
+        size_ = 0;
+        num_erased_ = 0;
+
+        for (size_t i = 0; i < old_capacity; ++i) {
+            if (is_full(old_ctrl[i])) {
+                size_t hash = hash_(old_slots[i].first);
+                size_t index = free_index(hash);
+                ::new (static_cast<void*>(&slots_[index])) value_type(std::move(old_slots[i]));
+                ctrl_[index] = hash_tag(hash);
+                ++size_;
+                old_slots[i].~value_type();
+            }
+        }
+        if (old_slots) {
+            std::allocator<value_type>().deallocate(old_slots, old_capacity);
+        }
+    }
+
+    void destroy_slots() {
+        if (!slots_) {
+            return;
+        }
+        for (size_t i = 0; i < capacity_; ++i) {
+            if (is_full(ctrl_[i])) {
+                slots_[i].~value_type();
+            }
+        }
+        std::allocator<value_type>().deallocate(slots_, capacity_);
+        slots_ = nullptr;
+    }
+
+    std::vector<int8_t> ctrl_;     //[0..capacity_-1] Control bytes of the slots
+    value_type* slots_ = nullptr;  //[0..capacity_-1] Elements (only constructed in full slots)
+    size_t capacity_ = 0;          //Number of slots (0, or a power of 2)
+    size_t size_ = 0;              //Number of full slots
+    size_t num_erased_ = 0;        //Number of erased slots
+    Hash hash_;
+    KeyEqual equal_;
+};
+
+} // namespace vtr
+
+#endif
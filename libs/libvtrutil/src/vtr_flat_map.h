@@ -318,6 +318,9 @@ class flat_map {
     ///@brief Reserve a minimum capacity for the underlying vector
     void reserve(size_type n) { vec_.reserve(n); }
 
+    ///@brief Returns the capacity of the underlying vector
+    size_type capacity() const { return vec_.capacity(); }
+
     ///@brief Reduce the capacity of the underlying vector to fit its size
     void shrink_to_fit() { vec_.shrink_to_fit(); }
 
@@ -17,6 +17,10 @@ void set_log_file(const char* filename) {
     log_set_output_file(filename);
 }
 
+void flush_log() {
+    log_flush();
+}
+
 } // namespace vtr
 
 void add_warnings_to_suppress(std::string function_name) {
@@ -33,13 +37,18 @@ void set_noisy_warn_log_file(std::string log_file_name) {
 void print_or_suppress_warning(const char* pszFileName, unsigned int lineNum, const char* pszFuncName, const char* pszMessage, ...) {
     std::string function_name(pszFuncName);
 
+    auto result = warnings_to_suppress.find(function_name);
+    bool suppressed = result != warnings_to_suppress.end();
+    if (!suppressed && !log_level_enabled(LOG_LEVEL_WARNING)) {
+        return; //Don't format filtered out warnings
+    }
+
     va_list va_args;
     va_start(va_args, pszMessage);
     std::string msg = vtr::vstring_fmt(pszMessage, va_args);
     va_end(va_args);
 
-    auto result = warnings_to_suppress.find(function_name);
-    if (result == warnings_to_suppress.end()) {
+    if (!suppressed) {
         vtr::printf_warning(pszFileName, lineNum, msg.data());
     } else if (!noisy_warn_log_file.empty()) {
         std::ofstream log;
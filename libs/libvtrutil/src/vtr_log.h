@@ -140,6 +140,9 @@ extern PrintHandlerDirect printf_direct;
 
 void set_log_file(const char* filename);
 
+///@brief Returns once every message logged before is written out (log messages are written by a background thread)
+void flush_log();
+
 } // namespace vtr
 
 static std::unordered_set<std::string> warnings_to_suppress;
@@ -1,6 +1,12 @@
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
+#include <fstream>
 #include <math.h>
+#include <mutex>
+#include <string>
+#include <vector>
 
 #include "vtr_assert.h"
 #include "vtr_list.h"
@@ -15,6 +21,13 @@
 #    include <malloc.h>
 #endif
 
+#ifdef __linux__
+#    include <sys/mman.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#    include <linux/mempolicy.h>
+#endif
+
 namespace vtr {
 
 #ifndef __GLIBC__
@@ -175,4 +188,163 @@ void free_chunk_memory(t_chunk* chunk_info) {
     chunk_info->next_mem_loc_ptr = nullptr;
 }
 
+/*
+ * Large arrays
+ */
+
+namespace {
+
+std::atomic<e_huge_pages> large_array_huge_pages{e_huge_pages::OFF};
+std::atomic<bool> large_array_numa_interleave{false};
+
+constexpr size_t kHugePageBytes = size_t(2) << 20;
+
+size_t round_up_to_huge_page(size_t size) {
+    return (size + kHugePageBytes - 1) & ~(kHugePageBytes - 1);
+}
+
+void* allocate_small_array(size_t size, size_t alignment) {
+    void* data;
+    //posix_memalign requires at least the alignment of a pointer
+    if (vtr::memalign(&data, std::max(alignment, alignof(void*)), size) != 0) {
+        throw std::bad_alloc();
+    }
+    return data;
+}
+
+void free_small_array(void* ptr) {
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    vtr::free(ptr);
+#endif
+}
+
+#ifdef __linux__
+/**
+ * @brief Returns the mask of the online NUMA nodes (empty if there is only one)
+ *
+ * Parses /sys/devices/system/node/online, a list of ranges such as "0-1,4".
+ */
+const std::vector<unsigned long>& online_numa_nodes() {
+    static std::vector<unsigned long> nodemask;
+    static std::once_flag once;
+    std::call_once(once, []() {
+        std::ifstream is("/sys/devices/system/node/online");
+        std::string ranges;
+        if (!(is >> ranges)) return;
+
+        constexpr size_t kBitsPerWord = 8 * sizeof(unsigned long);
+        size_t num_nodes = 0;
+        for (size_t pos = 0; pos < ranges.size();) {
+            size_t end = ranges.find(',', pos);
+            if (end == std::string::npos) end = ranges.size();
+            std::string range = ranges.substr(pos, end - pos);
+            size_t dash = range.find('-');
+            size_t first = std::stoul(range.substr(0, dash));
+            size_t last = (dash == std::string::npos) ? first : std::stoul(range.substr(dash + 1));
+            for (size_t node = first; node <= last; ++node) {
+                if (nodemask.size() <= node / kBitsPerWord) nodemask.resize(node / kBitsPerWord + 1, 0);
+                nodemask[node / kBitsPerWord] |= 1ul << (node % kBitsPerWord);
+                ++num_nodes;
+            }
+            pos = end + 1;
+        }
+        if (num_nodes < 2) nodemask.clear();
+    });
+    return nodemask;
+}
+
+///@brief Maps size bytes (a multiple of kHugePageBytes) on a kHugePageBytes boundary
+void* map_huge_page_aligned(size_t size) {
+    //Over-map by a huge page, and unmap what lies outside the aligned region
+    size_t mapped_size = size + kHugePageBytes;
+    void* mapped = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapped == MAP_FAILED) {
+        return nullptr;
+    }
+
+    char* begin = static_cast<char*>(mapped);
+    char* aligned = reinterpret_cast<char*>(round_up_to_huge_page(reinterpret_cast<uintptr_t>(begin)));
+    if (aligned != begin) {
+        munmap(begin, aligned - begin);
+    }
+    size_t tail = (begin + mapped_size) - (aligned + size);
+    if (tail != 0) {
+        munmap(aligned + size, tail);
+    }
+    return aligned;
+}
+#endif
+
+} // namespace
+
+void set_large_array_policy(const t_large_array_policy& policy) {
+    large_array_huge_pages = policy.huge_pages;
+    large_array_numa_interleave = policy.numa_interleave;
+}
+
+t_large_array_policy large_array_policy() {
+    t_large_array_policy policy;
+    policy.huge_pages = large_array_huge_pages;
+    policy.numa_interleave = large_array_numa_interleave;
+    return policy;
+}
+
+void* allocate_large_array(size_t size, size_t alignment) {
+#ifdef __linux__
+    if (size >= kLargeArrayBytes) {
+        VTR_ASSERT(alignment <= kHugePageBytes);
+        size_t mapped_size = round_up_to_huge_page(size);
+        e_huge_pages huge_pages = large_array_huge_pages;
+
+        void* data = nullptr;
+        if (huge_pages == e_huge_pages::EXPLICIT) {
+            //Reserved huge pages are aligned by construction; when they are all used fall back to transparent ones
+            int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB;
+#    ifdef MAP_HUGE_SHIFT
+            flags |= 21 << MAP_HUGE_SHIFT; //2MB pages, whatever the default huge page size
+#    endif
+            data = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, flags, -1, 0);
+            if (data == MAP_FAILED) {
+                data = nullptr;
+                huge_pages = e_huge_pages::TRANSPARENT;
+            }
+        }
+        if (!data) {
+            data = map_huge_page_aligned(mapped_size);
+            if (!data) {
+                throw std::bad_alloc();
+            }
+#    ifdef MADV_HUGEPAGE
+            if (huge_pages == e_huge_pages::TRANSPARENT) {
+                madvise(data, mapped_size, MADV_HUGEPAGE); //Only a hint: the kernel may not support it
+            }
+#    endif
+        }
+
+        //The memory policy must be set before the pages are first touched
+        const std::vector<unsigned long>& nodemask = online_numa_nodes();
+        if (large_array_numa_interleave && !nodemask.empty()) {
+            syscall(SYS_mbind, data, mapped_size, MPOL_INTERLEAVE, nodemask.data(),
+                    nodemask.size() * 8 * sizeof(unsigned long), 0);
+        }
+        return data;
+    }
+#endif
+    return allocate_small_array(size, alignment);
+}
+
+void free_large_array(void* ptr, size_t size) {
+    if (!ptr) return;
+#ifdef __linux__
+    //Only depends on the size, so that changing the policy does not affect existing allocations
+    if (size >= kLargeArrayBytes) {
+        munmap(ptr, round_up_to_huge_page(size));
+        return;
+    }
+#endif
+    free_small_array(ptr);
+}
+
 } // namespace vtr
@@ -1,5 +1,6 @@
 #ifndef VTR_MEMORY_H
 #define VTR_MEMORY_H
+#include <algorithm>
 #include <cstddef>
 #include <cstdlib>
 #include <new>
@@ -33,6 +34,8 @@ struct t_linked_vptr; //Forward declaration
  * This structure is to keep track of chunks of memory that is being	
  * allocated to save overhead when allocating very small memory pieces. 
  * For a complete description, please see the comment in chunk_malloc
+ *
+ * New code should rather use vtr::Arena (vtr_arena.h), which also works with STL containers.
  */
 struct t_chunk {
     t_linked_vptr* chunk_ptr_head = nullptr;
@@ -100,15 +103,21 @@ inline int memalign(void** ptr_out, size_t align, size_t size) {
  */
 #define VTR_PREFETCH(addr, rw, locality) __builtin_prefetch(addr, rw, locality)
 
+///@brief Size of a cache line on the targeted platforms (x86 and ARM64)
+constexpr size_t kCacheLineBytes = 64;
+
 /**
  * @brief aligned_allocator is a STL allocator that allocates memory in an aligned fashion
  *
  * works if supported by the platform
+ *
+ * The memory is aligned on Alignment bytes (by default the alignment of T), e.g.
+ * aligned_allocator<float, kCacheLineBytes> aligns the elements on cache lines.
  * 
  * It is worth noting the C++20 std::allocator does aligned allocations, but
  * C++20 has poor support.
  */
-template<class T>
+template<class T, size_t Alignment = alignof(T)>
 struct aligned_allocator {
     using value_type = T;
     using pointer = T*;
@@ -118,9 +127,25 @@ struct aligned_allocator {
     using size_type = std::size_t;
     using difference_type = std::ptrdiff_t;
 
+    static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of 2");
+
+    ///@brief Alignment of the allocations (in bytes)
+    static constexpr size_t alignment = Alignment;
+
+    template<class U>
+    struct rebind {
+        using other = aligned_allocator<U, Alignment>;
+    };
+
+    aligned_allocator() noexcept = default;
+
+    template<class U>
+    aligned_allocator(const aligned_allocator<U, Alignment>&) noexcept {}
+
     pointer allocate(size_type n, const void* /*hint*/ = 0) {
         void* data;
-        int ret = vtr::memalign(&data, alignof(T), sizeof(T) * n);
+        //posix_memalign requires at least the alignment of a pointer
+        int ret = vtr::memalign(&data, std::max(Alignment, alignof(void*)), sizeof(T) * n);
         if (ret != 0) {
             throw std::bad_alloc();
         }
@@ -141,11 +166,97 @@ struct aligned_allocator {
  *
  * Since the allocator doesn't have any internal state, all allocators for a given type are the same.
  */
-template<typename T>
-bool operator==(const aligned_allocator<T>&, const aligned_allocator<T>&) {
+template<typename T, typename U, size_t Alignment>
+bool operator==(const aligned_allocator<T, Alignment>&, const aligned_allocator<U, Alignment>&) {
     return true;
 }
 
+template<typename T, typename U, size_t Alignment>
+bool operator!=(const aligned_allocator<T, Alignment>&, const aligned_allocator<U, Alignment>&) {
+    return false;
+}
+
+///@brief How large_array_allocator backs its large allocations
+enum class e_huge_pages {
+    OFF,         ///<Regular pages
+    TRANSPARENT, ///<Transparent huge pages (madvise), where the kernel allows them
+    EXPLICIT     ///<Reserved (hugetlbfs) 2MB pages, falling back to transparent huge pages when none are left
+};
+
+///@brief Placement of the allocations of large_array_allocator
+struct t_large_array_policy {
+    e_huge_pages huge_pages = e_huge_pages::OFF;
+    bool numa_interleave = false; ///<Interleave the pages of the allocations across the online NUMA nodes
+};
+
+///@brief Allocations from this size (in bytes) on are mapped by large_array_allocator, smaller ones come from the heap
+constexpr size_t kLargeArrayBytes = size_t(2) << 20;
+
+/**
+ * @brief Sets the placement of the allocations of large_array_allocator made from now on
+ *
+ * Should be set before building the data structures using it: existing allocations
+ * keep their placement, and can still be freed.
+ */
+void set_large_array_policy(const t_large_array_policy& policy);
+t_large_array_policy large_array_policy();
+
+/**
+ * @brief Allocates size bytes aligned on alignment bytes, following the large array policy
+ *
+ * Throws std::bad_alloc on failure. The memory must be freed with free_large_array() on the same size.
+ */
+void* allocate_large_array(size_t size, size_t alignment);
+void free_large_array(void* ptr, size_t size);
+
+/**
+ * @brief large_array_allocator is a STL allocator for the large, long-lived arrays of a flow (e.g. the RR graph)
+ *
+ * Allocations of kLargeArrayBytes or more are mapped directly on 2MB boundaries
+ * which, depending on the large array policy, are backed by huge pages (fewer TLB
+ * misses on random accesses) and interleaved across the NUMA nodes (so threads on
+ * every socket see the same average latency, rather than all the data sitting on the
+ * node of the thread that built it). By default they are plain mappings.
+ */
+template<class T>
+struct large_array_allocator {
+    using value_type = T;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    template<class U>
+    struct rebind {
+        using other = large_array_allocator<U>;
+    };
+
+    large_array_allocator() noexcept = default;
+
+    template<class U>
+    large_array_allocator(const large_array_allocator<U>&) noexcept {}
+
+    pointer allocate(size_type n, const void* /*hint*/ = 0) {
+        return static_cast<pointer>(allocate_large_array(sizeof(T) * n, alignof(T)));
+    }
+
+    void deallocate(T* p, size_type n) {
+        free_large_array(p, sizeof(T) * n);
+    }
+};
+
+template<typename T, typename U>
+bool operator==(const large_array_allocator<T>&, const large_array_allocator<U>&) {
+    return true;
+}
+
+template<typename T, typename U>
+bool operator!=(const large_array_allocator<T>&, const large_array_allocator<U>&) {
+    return false;
+}
+
 } // namespace vtr
 
 #endif
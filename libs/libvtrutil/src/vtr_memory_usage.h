@@ -0,0 +1,114 @@
+#ifndef VTR_MEMORY_USAGE_H
+#define VTR_MEMORY_USAGE_H
+/**
+ * @file
+ * @brief Accounting of the heap memory held by data structures
+ *
+ * The helpers below account for the buffers of the standard containers (and of the vtr containers built
+ * on them). Vector-like containers are accounted for by their capacity, so the part of it beyond their
+ * size (the capacity slack) is reported separately. The nodes of node-based containers (std::map,
+ * std::unordered_map, ...) are estimated, as their exact size depends on the standard library.
+ *
+ * Only the memory directly held by a container is accounted for: the heap memory owned by its elements
+ * (e.g. the buffer of a std::string element) must be added by the caller when it matters.
+ */
+
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace vtr {
+
+///@brief Heap memory held by a data structure
+struct t_memory_usage {
+    size_t bytes = 0;       ///<Allocated bytes
+    size_t slack_bytes = 0; ///<Allocated bytes which hold no element (included in bytes)
+
+    t_memory_usage& operator+=(const t_memory_usage& other) {
+        bytes += other.bytes;
+        slack_bytes += other.slack_bytes;
+        return *this;
+    }
+};
+
+///@brief The memory usage of a named data structure (e.g. a member of a context)
+struct t_named_memory_usage {
+    std::string name;
+    t_memory_usage usage;
+};
+
+///@brief Returns the memory of the buffer of a vector-like container (std::vector, vtr::vector, vtr::vector_map, ...)
+template<typename Container>
+t_memory_usage vector_memory_usage(const Container& container) {
+    using T = typename std::iterator_traits<typename Container::const_iterator>::value_type;
+
+    t_memory_usage usage;
+    if constexpr (std::is_same<T, bool>::value) {
+        //std::vector<bool> packs its elements as bits
+        usage.bytes = container.capacity() / 8;
+        usage.slack_bytes = (container.capacity() - container.size()) / 8;
+    } else {
+        usage.bytes = container.capacity() * sizeof(T);
+        usage.slack_bytes = (container.capacity() - container.size()) * sizeof(T);
+    }
+    return usage;
+}
+
+///@brief Returns the memory of a vector of vector-like containers, including the buffers of the inner containers
+template<typename Container>
+t_memory_usage nested_vector_memory_usage(const Container& container) {
+    t_memory_usage usage = vector_memory_usage(container);
+    for (const auto& inner : container) {
+        usage += vector_memory_usage(inner);
+    }
+    return usage;
+}
+
+///@brief Returns the memory of the elements of a vtr::Matrix/vtr::NdMatrix (but not of the heap memory they own)
+template<typename Matrix>
+t_memory_usage matrix_memory_usage(const Matrix& matrix) {
+    using T = typename std::decay<decltype(matrix.get(0))>::type;
+
+    t_memory_usage usage;
+    usage.bytes = matrix.capacity() * sizeof(T);
+    usage.slack_bytes = (matrix.capacity() - matrix.size()) * sizeof(T);
+    return usage;
+}
+
+///@brief Returns the heap memory of a string (none if it fits in the string's own short string buffer)
+inline t_memory_usage string_memory_usage(const std::string& str) {
+    t_memory_usage usage;
+    if (str.capacity() > std::string().capacity()) {
+        usage.bytes = str.capacity() + 1;
+        usage.slack_bytes = str.capacity() - str.size();
+    }
+    return usage;
+}
+
+///@brief Returns the estimated memory of a node-based hash container (std::unordered_map, std::unordered_set, ...)
+template<typename HashContainer>
+t_memory_usage hash_memory_usage(const HashContainer& container) {
+    using T = typename HashContainer::value_type;
+
+    //A bucket array of pointers, and a node (the element, the next pointer and the cached hash) per element
+    t_memory_usage usage;
+    usage.bytes = container.bucket_count() * sizeof(void*) + container.size() * (sizeof(T) + 2 * sizeof(void*));
+    return usage;
+}
+
+///@brief Returns the estimated memory of a node-based tree container (std::map, std::set, ...)
+template<typename TreeContainer>
+t_memory_usage tree_memory_usage(const TreeContainer& container) {
+    using T = typename TreeContainer::value_type;
+
+    //A node (the element, 3 pointers and the color) per element
+    t_memory_usage usage;
+    usage.bytes = container.size() * (sizeof(T) + 4 * sizeof(void*));
+    return usage;
+}
+
+} // namespace vtr
+
+#endif
@@ -3,11 +3,27 @@
 #include <algorithm>
 #include <array>
 #include <memory>
+#include <type_traits>
+#include <utility>
 
+#include "vtr_array_view.h"
 #include "vtr_assert.h"
+#include "vtr_memory.h"
 
 namespace vtr {
 
+namespace ndmatrix_impl {
+
+///@brief Alignment (in bytes) of the allocations of Allocator, 0 if it does not specify one
+template<typename Allocator, typename = void>
+struct allocator_alignment : std::integral_constant<size_t, 0> {};
+
+template<typename Allocator>
+struct allocator_alignment<Allocator, std::void_t<decltype(Allocator::alignment)>>
+    : std::integral_constant<size_t, Allocator::alignment> {};
+
+} // namespace ndmatrix_impl
+
 /**
  * @brief Proxy class for a sub-matrix of a NdMatrix class.
  * 
@@ -142,17 +158,40 @@ class NdMatrixProxy<T, 1> {
  * The indicies are calculated based on the dimensions to access the appropriate elements.
  * Since the indexing calculations are visible to the compiler at compile time they can be
  * optimized to be efficient.
+ *
+ * The elements are allocated with Allocator (e.g. vtr::arena_allocator, passed as the last
+ * constructor argument). Copies use the allocator of the copied matrix, and assigning or
+ * swapping matrices also exchanges their allocators.
+ *
+ * Aligned layout:
+ *
+ * When Allocator specifies an alignment larger than the elements (e.g.
+ * vtr::aligned_allocator<float, vtr::kCacheLineBytes>, see vtr::AlignedNdMatrix), the
+ * stride of the innermost rows is padded to a multiple of that alignment, so that every
+ * row starts on an aligned boundary. Combined with row(), this lets kernels process the
+ * innermost rows with (aligned) vector loads. The padding elements are value-initialized
+ * like the others, but are not part of size() and are skipped by the flat accessors.
  */
-template<typename T, size_t N>
+template<typename T, size_t N, typename Allocator = std::allocator<T>>
 class NdMatrixBase {
+    using alloc_traits = std::allocator_traits<Allocator>;
+
   public:
     static_assert(N >= 1, "Minimum dimension 1");
 
+    using allocator_type = Allocator;
+
     ///@brief An empty matrix (all dimensions size zero)
     NdMatrixBase() {
         clear();
     }
 
+    ///@brief An empty matrix (all dimensions size zero), which will allocate its elements with alloc
+    explicit NdMatrixBase(const Allocator& alloc)
+        : alloc_(alloc) {
+        clear();
+    }
+
     /**
      * @brief Specified dimension sizes:
      *
@@ -161,10 +200,15 @@ class NdMatrixBase {
      *      ...
      *      with optional fill value
      */
-    NdMatrixBase(std::array<size_t, N> dim_sizes, T value = T()) {
+    NdMatrixBase(std::array<size_t, N> dim_sizes, T value = T(), const Allocator& alloc = Allocator())
+        : alloc_(alloc) {
         resize(dim_sizes, value);
     }
 
+    ~NdMatrixBase() {
+        free_data();
+    }
+
   public: //Accessors
     ///@brief Returns the size of the matrix (number of elements)
     size_t size() const {
@@ -172,6 +216,15 @@ class NdMatrixBase {
         return size_;
     }
 
+    /**
+     * @brief Returns the number of elements the matrix has allocated storage for
+     *
+     * This includes the padding of the rows of an aligned layout.
+     */
+    size_t capacity() const {
+        return data_capacity_;
+    }
+
     ///@brief Returns true if there are no elements in the matrix
     bool empty() const {
         return size() == 0;
@@ -203,22 +256,46 @@ class NdMatrixBase {
         return dim_sizes_[i];
     }
 
-    ///@brief const Flat accessors of NdMatrix
+    ///@brief Returns the number of elements between the starts of consecutive innermost rows (at least dim_size(N - 1))
+    size_t row_stride() const {
+        return N == 1 ? dim_sizes_[0] : dim_strides_[N < 2 ? 0 : N - 2];
+    }
+
+    ///@brief const Flat accessors of NdMatrix (i in [0, size()), in row major order)
     const T& get(size_t i) const {
         VTR_ASSERT_SAFE(i < size_);
-        return data_[i];
+        return data_[storage_index(i)];
     }
 
     ///@brief Flat accessors of NdMatrix
     T& get(size_t i) {
         VTR_ASSERT_SAFE(i < size_);
-        return data_[i];
+        return data_[storage_index(i)];
+    }
+
+    /**
+     * @brief Returns the innermost row at the given indices of the N - 1 outer dimensions
+     *
+     * The row is contiguous (dim_size(N - 1) elements), and aligned with an aligned layout.
+     */
+    array_view<const T> row(std::array<size_t, N - 1> index) const {
+        return array_view<const T>(row_start(index), dim_sizes_[N - 1]);
+    }
+
+    ///@brief Returns the innermost row at the given indices of the N - 1 outer dimensions (mutable)
+    array_view<T> row(std::array<size_t, N - 1> index) {
+        return array_view<T>(const_cast<T*>(row_start(index)), dim_sizes_[N - 1]);
+    }
+
+    ///@brief Returns the allocator of the elements
+    allocator_type get_allocator() const {
+        return alloc_;
     }
 
   public: //Mutators
     ///@brief Set all elements to 'value'
     void fill(T value) {
-        std::fill(data_.get(), data_.get() + size(), value);
+        std::fill(data_, data_ + data_capacity_, value);
     }
 
     /**
@@ -230,21 +307,24 @@ class NdMatrixBase {
     void resize(std::array<size_t, N> dim_sizes, T value = T()) {
         dim_sizes_ = dim_sizes;
         size_ = calc_size();
-        alloc();
-        fill(value);
         if (size_ > 0) {
-            dim_strides_[0] = size_ / dim_sizes_[0];
-            for (size_t dim = 1; dim < N; ++dim) {
-                dim_strides_[dim] = dim_strides_[dim - 1] / dim_sizes_[dim];
+            dim_strides_[N - 1] = 1;
+            if (N >= 2) {
+                dim_strides_[N < 2 ? 0 : N - 2] = padded_row_size(dim_sizes_[N - 1]);
             }
+            for (size_t dim = N - 1; dim-- > 1;) {
+                dim_strides_[dim - 1] = dim_strides_[dim] * dim_sizes_[dim];
+            }
+            alloc(dim_strides_[0] * dim_sizes_[0], value);
         } else {
             dim_strides_.fill(0);
+            alloc(0, value);
         }
     }
 
     ///@brief Reset the matrix to size zero
     void clear() {
-        data_.reset(nullptr);
+        free_data();
         dim_sizes_.fill(0);
         dim_strides_.fill(0);
         size_ = 0;
@@ -253,13 +333,13 @@ class NdMatrixBase {
   public: //Lifetime management
     ///@brief Copy constructor
     NdMatrixBase(const NdMatrixBase& other)
-        : NdMatrixBase(other.dim_sizes_) {
-        std::copy(other.data_.get(), other.data_.get() + other.size(), data_.get());
+        : NdMatrixBase(other.dim_sizes_, T(), alloc_traits::select_on_container_copy_construction(other.alloc_)) {
+        std::copy(other.data_, other.data_ + other.data_capacity_, data_);
     }
 
     ///@brief Move constructor
     NdMatrixBase(NdMatrixBase&& other)
-        : NdMatrixBase() {
+        : NdMatrixBase(other.alloc_) {
         swap(*this, other);
     }
 
@@ -274,18 +354,79 @@ class NdMatrixBase {
     }
 
     ///@brief Swap two NdMatrixBase objects
-    friend void swap(NdMatrixBase<T, N>& m1, NdMatrixBase<T, N>& m2) {
+    friend void swap(NdMatrixBase& m1, NdMatrixBase& m2) {
         using std::swap;
         swap(m1.size_, m2.size_);
         swap(m1.dim_sizes_, m2.dim_sizes_);
         swap(m1.dim_strides_, m2.dim_strides_);
         swap(m1.data_, m2.data_);
+        swap(m1.data_capacity_, m2.data_capacity_);
+        swap(m1.alloc_, m2.alloc_); //Elements must be freed by the allocator which allocated them
     }
 
   private:
-    ///@brief Allocate space for all the elements
-    void alloc() {
-        data_ = std::make_unique<T[]>(size());
+    ///@brief Number of elements rows are padded to a multiple of so that they all start aligned
+    static constexpr size_t kRowAlignment = (ndmatrix_impl::allocator_alignment<Allocator>::value > sizeof(T)
+                                             && ndmatrix_impl::allocator_alignment<Allocator>::value % sizeof(T) == 0)
+                                                ? ndmatrix_impl::allocator_alignment<Allocator>::value / sizeof(T)
+                                                : 1;
+
+    static size_t padded_row_size(size_t row_size) {
+        return (row_size + kRowAlignment - 1) / kRowAlignment * kRowAlignment;
+    }
+
+    ///@brief Returns the index in data_ of the ith element in row major order
+    size_t storage_index(size_t i) const {
+        if (kRowAlignment == 1) {
+            return i;
+        }
+        size_t row_size = dim_sizes_[N - 1];
+        return i / row_size * row_stride() + i % row_size;
+    }
+
+    const T* row_start(const std::array<size_t, N - 1>& index) const {
+        size_t offset = 0;
+        for (size_t dim = 0; dim + 1 < N; ++dim) {
+            VTR_ASSERT_SAFE_MSG(index[dim] < dim_sizes_[dim], "Index out of range (above dimension maximum)");
+            offset += index[dim] * dim_strides_[dim];
+        }
+        return data_ + offset;
+    }
+
+    ///@brief Allocate space for num_elements elements, initialized to value
+    void alloc(size_t num_elements, const T& value) {
+        free_data();
+        if (num_elements == 0) {
+            return;
+        }
+
+        T* data = alloc_traits::allocate(alloc_, num_elements);
+        size_t num_constructed = 0;
+        try {
+            for (; num_constructed < num_elements; num_constructed++) {
+                alloc_traits::construct(alloc_, data + num_constructed, value);
+            }
+        } catch (...) {
+            for (size_t i = 0; i < num_constructed; i++) {
+                alloc_traits::destroy(alloc_, data + i);
+            }
+            alloc_traits::deallocate(alloc_, data, num_elements);
+            throw;
+        }
+        data_ = data;
+        data_capacity_ = num_elements;
+    }
+
+    ///@brief Destroys and frees all the elements
+    void free_data() {
+        if (data_) {
+            for (size_t i = 0; i < data_capacity_; i++) {
+                alloc_traits::destroy(alloc_, data_ + i);
+            }
+            alloc_traits::deallocate(alloc_, data_, data_capacity_);
+        }
+        data_ = nullptr;
+        data_capacity_ = 0;
     }
 
     ///@brief Returns the size of the matrix (number of elements) calculated from the current dimensions
@@ -302,7 +443,9 @@ class NdMatrixBase {
     size_t size_ = 0;
     std::array<size_t, N> dim_sizes_;
     std::array<size_t, N> dim_strides_;
-    std::unique_ptr<T[]> data_ = nullptr;
+    T* data_ = nullptr;
+    size_t data_capacity_ = 0; //Number of elements data_ was allocated (and constructed) with
+    Allocator alloc_;
 };
 
 /**
@@ -335,14 +478,14 @@ class NdMatrixBase {
  *       //Resizing an existing matrix (all elements set to value 88)
  *       m3.resize({15,55}, 88)
  */
-template<typename T, size_t N>
-class NdMatrix : public NdMatrixBase<T, N> {
+template<typename T, size_t N, typename Allocator = std::allocator<T>>
+class NdMatrix : public NdMatrixBase<T, N, Allocator> {
     //General case
     static_assert(N >= 2, "Minimum dimension 2");
 
   public:
     ///@brief Use the base constructors
-    using NdMatrixBase<T, N>::NdMatrixBase;
+    using NdMatrixBase<T, N, Allocator>::NdMatrixBase;
 
   public:
     /**
@@ -359,7 +502,7 @@ class NdMatrix : public NdMatrixBase<T, N> {
         return NdMatrixProxy<T, N - 1>(
             this->dim_sizes_.data() + 1,                        //Pass the dimension information
             this->dim_strides_.data() + 1,                      //Pass the stride for the next dimension
-            this->data_.get() + this->dim_strides_[0] * index); //Advance to index in this dimension
+            this->data_ + this->dim_strides_[0] * index); //Advance to index in this dimension
     }
 
     /**
@@ -369,7 +512,7 @@ class NdMatrix : public NdMatrixBase<T, N> {
      */
     NdMatrixProxy<T, N - 1> operator[](size_t index) {
         //Call the const version, since returned by value don't need to worry about const
-        return const_cast<const NdMatrix<T, N>*>(this)->operator[](index);
+        return const_cast<const NdMatrix*>(this)->operator[](index);
     }
 };
 
@@ -378,11 +521,11 @@ class NdMatrix : public NdMatrixBase<T, N> {
  *
  * This is considered a specialization for N=1
  */
-template<typename T>
-class NdMatrix<T, 1> : public NdMatrixBase<T, 1> {
+template<typename T, typename Allocator>
+class NdMatrix<T, 1, Allocator> : public NdMatrixBase<T, 1, Allocator> {
   public:
     ///@brief Use the base constructors
-    using NdMatrixBase<T, 1>::NdMatrixBase;
+    using NdMatrixBase<T, 1, Allocator>::NdMatrixBase;
 
   public:
     ///@brief Access an element (immutable)
@@ -397,7 +540,7 @@ class NdMatrix<T, 1> : public NdMatrixBase<T, 1> {
     ///@brief Access an element (mutable)
     T& operator[](size_t index) {
         //Call the const version, and cast away const-ness
-        return const_cast<T&>(const_cast<const NdMatrix<T, 1>*>(this)->operator[](index));
+        return const_cast<T&>(const_cast<const NdMatrix*>(this)->operator[](index));
     }
 };
 
@@ -405,5 +548,9 @@ class NdMatrix<T, 1> : public NdMatrixBase<T, 1> {
 template<typename T>
 using Matrix = NdMatrix<T, 2>;
 
+///@brief An NdMatrix with cache line aligned storage and innermost rows (see NdMatrixBase)
+template<typename T, size_t N>
+using AlignedNdMatrix = NdMatrix<T, N, aligned_allocator<T, kCacheLineBytes>>;
+
 } // namespace vtr
 #endif
@@ -0,0 +1,278 @@
+#include "vtr_profile.h"
+
+#include "vtr_rusage.h"
+#include "vtr_util.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace vtr {
+
+namespace {
+
+///@brief A phase recorded by the profiler
+struct t_phase_record {
+    std::string name;
+    int thread;
+    int depth;
+
+    double start_us; //Since the profiler was started
+    double wall_us;
+    double thread_cpu_sec;
+    double process_cpu_sec;
+    size_t num_allocations;
+    size_t allocation_bytes;
+    size_t rss;
+    long long delta_rss;
+    size_t max_rss;
+    size_t delta_max_rss;
+};
+
+constexpr double BYTE_TO_MIB = 1024 * 1024;
+
+std::atomic<bool> f_profiling{false};
+std::chrono::steady_clock::time_point f_profile_start;
+
+//Guards the records and the thread numbers
+std::mutex f_records_mutex;
+std::vector<t_phase_record> f_records;
+std::unordered_map<std::thread::id, int> f_thread_numbers;
+
+//Depth of the phases currently open in the calling thread
+thread_local int f_phase_depth = 0;
+
+//Counted by the allocation hook (any thread), so relaxed atomics
+std::atomic<size_t> f_num_allocations{0};
+std::atomic<size_t> f_allocation_bytes{0};
+
+///@brief Returns the number of the calling thread in the trace (the threads are numbered in the order they first record a phase)
+int thread_number() {
+    auto result = f_thread_numbers.emplace(std::this_thread::get_id(), f_thread_numbers.size());
+    return result.first->second;
+}
+
+///@brief Returns the string as a JSON string literal
+std::string json_string(const std::string& str) {
+    std::string json = "\"";
+    for (char c : str) {
+        if (c == '"' || c == '\\') {
+            json += '\\';
+            json += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            json += string_fmt("\\u%04x", c);
+        } else {
+            json += c;
+        }
+    }
+    json += "\"";
+    return json;
+}
+
+} // namespace
+
+void start_phase_profiling() {
+    std::lock_guard<std::mutex> lock(f_records_mutex);
+    f_records.clear();
+    f_thread_numbers.clear();
+    f_profile_start = std::chrono::steady_clock::now();
+    f_profiling = true;
+}
+
+void stop_phase_profiling() {
+    f_profiling = false;
+
+    std::lock_guard<std::mutex> lock(f_records_mutex);
+    f_records.clear();
+    f_thread_numbers.clear();
+}
+
+bool is_phase_profiling() {
+    return f_profiling;
+}
+
+void write_phase_profile(const std::string& filename) {
+    std::vector<t_phase_record> records;
+    size_t num_threads;
+    {
+        std::lock_guard<std::mutex> lock(f_records_mutex);
+        records = f_records;
+        num_threads = f_thread_numbers.size();
+    }
+
+    //Phases are recorded when they end, so the enclosing phases follow the ones they contain
+    std::stable_sort(records.begin(), records.end(), [](const t_phase_record& lhs, const t_phase_record& rhs) {
+        return lhs.start_us < rhs.start_us;
+    });
+
+    FILE* fp = vtr::fopen(filename.c_str(), "w");
+
+    fprintf(fp, "{\n");
+    fprintf(fp, "  \"displayTimeUnit\": \"ms\",\n");
+    fprintf(fp, "  \"traceEvents\": [\n");
+    fprintf(fp, "    {\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 0, \"args\": {\"name\": \"vtr\"}}");
+    for (size_t thread = 0; thread < num_threads; ++thread) {
+        fprintf(fp, ",\n    {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, \"tid\": %zu, \"args\": {\"name\": \"thread %zu\"}}",
+                thread, thread);
+    }
+
+    for (const t_phase_record& record : records) {
+        //The phase, as a complete event
+        fprintf(fp, ",\n    {\"name\": %s, \"cat\": \"phase\", \"ph\": \"X\", \"pid\": 0, \"tid\": %d, \"ts\": %.3f, \"dur\": %.3f, \"args\": {",
+                json_string(record.name).c_str(), record.thread, record.start_us, record.wall_us);
+        fprintf(fp, "\"depth\": %d, ", record.depth);
+        fprintf(fp, "\"thread_cpu_sec\": %.6f, \"process_cpu_sec\": %.6f, ", record.thread_cpu_sec, record.process_cpu_sec);
+        fprintf(fp, "\"num_allocations\": %zu, \"allocation_bytes\": %zu, ", record.num_allocations, record.allocation_bytes);
+        fprintf(fp, "\"rss_mib\": %.3f, \"delta_rss_mib\": %.3f, ", record.rss / BYTE_TO_MIB, record.delta_rss / BYTE_TO_MIB);
+        fprintf(fp, "\"max_rss_mib\": %.3f, \"delta_max_rss_mib\": %.3f}}", record.max_rss / BYTE_TO_MIB, record.delta_max_rss / BYTE_TO_MIB);
+
+        //The memory usage at the end of the phase, as a counter event (drawn as a graph over time)
+        fprintf(fp, ",\n    {\"name\": \"memory\", \"ph\": \"C\", \"pid\": 0, \"ts\": %.3f, \"args\": {\"rss_mib\": %.3f, \"max_rss_mib\": %.3f}}",
+                record.start_us + record.wall_us, record.rss / BYTE_TO_MIB, record.max_rss / BYTE_TO_MIB);
+    }
+
+    fprintf(fp, "\n  ]\n");
+    fprintf(fp, "}\n");
+
+    std::fclose(fp);
+}
+
+void record_allocation(size_t bytes) {
+    f_num_allocations.fetch_add(1, std::memory_order_relaxed);
+    f_allocation_bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+size_t num_recorded_allocations() {
+    return f_num_allocations.load(std::memory_order_relaxed);
+}
+
+size_t recorded_allocation_bytes() {
+    return f_allocation_bytes.load(std::memory_order_relaxed);
+}
+
+ScopedProfilePhase::ScopedProfilePhase(std::string name)
+    : name_(std::move(name))
+    , enabled_(is_phase_profiling()) {
+    if (!enabled_) {
+        return;
+    }
+
+    ++f_phase_depth;
+
+    start_ = clock::now();
+    thread_cpu_time_ = get_thread_cpu_time();
+    process_cpu_time_ = get_process_cpu_time();
+    num_allocations_ = num_recorded_allocations();
+    allocation_bytes_ = recorded_allocation_bytes();
+    rss_ = get_current_rss();
+    max_rss_ = get_max_rss();
+}
+
+ScopedProfilePhase::~ScopedProfilePhase() {
+    if (!enabled_) {
+        return;
+    }
+
+    --f_phase_depth;
+
+    auto end = clock::now();
+
+    t_phase_record record;
+    record.name = std::move(name_);
+    record.depth = f_phase_depth;
+    record.wall_us = std::chrono::duration<double, std::micro>(end - start_).count();
+    record.thread_cpu_sec = get_thread_cpu_time() - thread_cpu_time_;
+    record.process_cpu_sec = get_process_cpu_time() - process_cpu_time_;
+    record.num_allocations = num_recorded_allocations() - num_allocations_;
+    record.allocation_bytes = recorded_allocation_bytes() - allocation_bytes_;
+    record.rss = get_current_rss();
+    record.delta_rss = (long long)record.rss - (long long)rss_;
+    record.max_rss = get_max_rss();
+    record.delta_max_rss = record.max_rss - max_rss_;
+
+    std::lock_guard<std::mutex> lock(f_records_mutex);
+    if (!f_profiling || start_ < f_profile_start) {
+        //The profiler was stopped (or restarted) during the phase
+        return;
+    }
+    record.start_us = std::chrono::duration<double, std::micro>(start_ - f_profile_start).count();
+    record.thread = thread_number();
+    f_records.push_back(std::move(record));
+}
+
+} // namespace vtr
+
+#ifdef VTR_ENABLE_ALLOC_PROFILING
+/*
+ * Replacements of the global allocation functions, which count the allocations for the profiler.
+ *
+ * The array and nothrow forms forward to the plain operator new, and the aligned forms are left as is
+ * (they are paired with the default aligned operator delete).
+ */
+void* operator new(std::size_t size) {
+    vtr::record_allocation(size);
+
+    if (size == 0) {
+        size = 1;
+    }
+    while (true) {
+        void* ptr = std::malloc(size);
+        if (ptr) {
+            return ptr;
+        }
+
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return ::operator new(size);
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return ::operator new(size, std::nothrow);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
+#endif /* VTR_ENABLE_ALLOC_PROFILING */
@@ -0,0 +1,98 @@
+#ifndef VTR_PROFILE_H
+#define VTR_PROFILE_H
+/**
+ * @file
+ * @brief Hierarchical phase profiler
+ *
+ * Records the resource usage of (nested) phases of a run, and writes them in the Chrome trace event format
+ * (loadable in chrome://tracing, Perfetto or speedscope), so that the runs of two versions can be compared phase by phase.
+ *
+ * Every vtr::ScopedActionTimer (and so every vtr::ScopedStartFinishTimer/vtr::ScopedFinishTimer) is a phase,
+ * and other phases can be marked with a vtr::ScopedProfilePhase. For each phase the profiler records:
+ *  - the wall time,
+ *  - the CPU time of the thread which ran the phase, and of the whole process,
+ *  - the number and size of the heap allocations made (by any thread) during the phase,
+ *  - the current resident set size at the end of the phase, its change and the change of the peak resident set size.
+ *
+ * Allocations are only counted when VTR is built with VTR_ENABLE_ALLOC_PROFILING, which replaces the global
+ * operator new/delete by counting versions (see record_allocation()). Otherwise they are reported as zero.
+ *
+ * The profiler is disabled (and phases cost next to nothing) until start_phase_profiling() is called.
+ *
+ * For example:
+ *
+ *      vtr::start_phase_profiling();
+ *      {
+ *          vtr::ScopedStartFinishTimer timer("Placement");
+ *          {
+ *              vtr::ScopedProfilePhase phase("Initial placement");
+ *              //...
+ *          }
+ *      }
+ *      vtr::write_phase_profile("vpr_profile.json");
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+namespace vtr {
+
+///@brief Starts recording the phases (which start after this call)
+void start_phase_profiling();
+
+///@brief Stops recording phases, and discards the recorded ones
+void stop_phase_profiling();
+
+///@brief Returns true if phases are being recorded
+bool is_phase_profiling();
+
+///@brief Writes the phases recorded so far to the specified file, in the Chrome trace event (JSON) format
+void write_phase_profile(const std::string& filename);
+
+///@brief Counts a heap allocation of the specified size (called by the allocation hook)
+void record_allocation(size_t bytes);
+
+///@brief Returns the number of heap allocations counted so far
+size_t num_recorded_allocations();
+
+///@brief Returns the total size (in bytes) of the heap allocations counted so far
+size_t recorded_allocation_bytes();
+
+/**
+ * @brief Records the phase spanning the lifetime of the object (if the profiler is enabled when it is constructed)
+ *
+ * Phases constructed in the same thread nest in the order they are constructed.
+ */
+class ScopedProfilePhase {
+  public:
+    ScopedProfilePhase(std::string name);
+    ~ScopedProfilePhase();
+
+    ///@brief No copy
+    ScopedProfilePhase(ScopedProfilePhase&) = delete;
+    ScopedProfilePhase& operator=(ScopedProfilePhase&) = delete;
+
+    ///@brief No move
+    ScopedProfilePhase(ScopedProfilePhase&&) = delete;
+    ScopedProfilePhase& operator=(ScopedProfilePhase&&) = delete;
+
+  private:
+    using clock = std::chrono::steady_clock;
+
+    std::string name_;
+    bool enabled_;
+
+    //Usage at the start of the phase
+    std::chrono::time_point<clock> start_;
+    double thread_cpu_time_;
+    double process_cpu_time_;
+    size_t num_allocations_;
+    size_t allocation_bytes_;
+    size_t rss_;
+    size_t max_rss_;
+};
+
+} // namespace vtr
+
+#endif
@@ -88,4 +88,47 @@ float frand() {
 #endif
 }
 
+/*
+ * RandomNumberGenerator: xoshiro256** by D. Blackman and S. Vigna (public domain,
+ * https://prng.di.unimi.it/), seeded with splitmix64 as they recommend.
+ */
+
+static uint64_t splitmix64(uint64_t& x) {
+    uint64_t z = (x += 0x9e3779b97f4a7c15u);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9u;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebu;
+    return z ^ (z >> 31);
+}
+
+RandomNumberGenerator::RandomNumberGenerator(uint64_t seed) {
+    for (uint64_t& word : state_) {
+        word = splitmix64(seed);
+    }
+}
+
+RandomNumberGenerator RandomNumberGenerator::worker_stream(uint64_t seed, size_t worker) {
+    RandomNumberGenerator rng(seed);
+    for (size_t i = 0; i < worker; i++) {
+        rng.jump();
+    }
+    return rng;
+}
+
+void RandomNumberGenerator::jump() {
+    static constexpr uint64_t JUMP[] = {0x180ec6d33cfd0abau, 0xd5a61266f0c9392cu, 0xa9582618e03fc9aau, 0x39abdc4529b1661cu};
+
+    std::array<uint64_t, 4> jumped = {0, 0, 0, 0};
+    for (uint64_t jump_word : JUMP) {
+        for (int b = 0; b < 64; b++) {
+            if (jump_word & (uint64_t(1) << b)) {
+                for (size_t i = 0; i < jumped.size(); i++) {
+                    jumped[i] ^= state_[i];
+                }
+            }
+            next();
+        }
+    }
+    state_ = jumped;
+}
+
 } // namespace vtr
@@ -1,6 +1,9 @@
 #ifndef VTR_RANDOM_H
 #define VTR_RANDOM_H
 #include <algorithm> //For std::swap
+#include <array>
+#include <cstddef>
+#include <cstdint>
 
 namespace vtr {
 /*********************** Portable random number generators *******************/
@@ -41,5 +44,93 @@ void shuffle(Iter first, Iter last, RandState& rand_state) {
     }
 }
 
+/**
+ * @brief A fast pseudo-random number generator (xoshiro256**) with independent, reproducible streams
+ *
+ * Unlike the functions above, which share one global state, each RandomNumberGenerator owns its
+ * state, so workers of a parallel algorithm can each draw from their own. worker_stream() hands
+ * out per-worker generators derived from a single seed (e.g. --seed): stream i is the seeded
+ * generator jumped ahead i times by 2^128 draws, so streams never overlap and the numbers drawn
+ * by a worker don't depend on how many workers there are or how they are scheduled.
+ *
+ * The sequences are fully specified (no std:: distributions), and so are identical across
+ * compilers and platforms.
+ */
+class RandomNumberGenerator {
+  public:
+    ///@brief A generator seeded with seed (expanded to the full state with splitmix64)
+    explicit RandomNumberGenerator(uint64_t seed = 0);
+
+    ///@brief Returns the generator of the ith worker for a given seed
+    static RandomNumberGenerator worker_stream(uint64_t seed, size_t worker);
+
+    ///@brief Returns the next 64 random bits
+    uint64_t next() {
+        const uint64_t result = rotl(state_[1] * 5, 7) * 9;
+        const uint64_t t = state_[1] << 17;
+
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+
+        state_[2] ^= t;
+        state_[3] = rotl(state_[3], 45);
+
+        return result;
+    }
+
+    ///@brief Returns a uniformly distributed integer in [0..imax] (without modulo bias), imax >= 0
+    int irand(int imax) {
+        //Lemire's multiply-shift: the high half of x * range is in [0..range), and the few
+        //low halves which would make some values more likely than others are rejected
+        const uint32_t range = uint32_t(imax) + 1;
+        uint64_t m = uint64_t(next32()) * range;
+        uint32_t low = uint32_t(m);
+        if (low < range) {
+            const uint32_t threshold = uint32_t(-range) % range;
+            while (low < threshold) {
+                m = uint64_t(next32()) * range;
+                low = uint32_t(m);
+            }
+        }
+        return int(m >> 32);
+    }
+
+    ///@brief Returns a uniformly distributed float in [0..1)
+    float frand() {
+        return float(next() >> 40) * (1.f / float(uint64_t(1) << 24));
+    }
+
+    ///@brief Advances the generator by 2^128 draws
+    void jump();
+
+    ///@brief Returns the generator state (e.g. to checkpoint it)
+    const std::array<uint64_t, 4>& state() const { return state_; }
+
+    ///@brief Restores a state returned by state()
+    void set_state(const std::array<uint64_t, 4>& state) { state_ = state; }
+
+  private:
+    uint32_t next32() {
+        return uint32_t(next() >> 32);
+    }
+
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    std::array<uint64_t, 4> state_;
+};
+
+///@brief vtr::shuffle drawing from a RandomNumberGenerator
+template<typename Iter>
+void shuffle(Iter first, Iter last, RandomNumberGenerator& rng) {
+    for (auto i = (last - first) - 1; i > 0; --i) {
+        using std::swap;
+        swap(first[i], first[rng.irand(i)]);
+    }
+}
+
 } // namespace vtr
 #endif
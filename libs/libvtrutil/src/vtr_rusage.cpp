@@ -3,6 +3,9 @@
 #ifdef __unix__
 #    include <sys/time.h>
 #    include <sys/resource.h>
+#    include <time.h>
+#    include <unistd.h>
+#    include <cstdio>
 #endif
 
 namespace vtr {
@@ -27,4 +30,53 @@ size_t get_max_rss() {
     return max_rss;
 }
 
+///@brief Returns the current resident set size in bytes, or zero if unable to determine.
+size_t get_current_rss() {
+    size_t rss = 0;
+
+#ifdef __unix__
+    //The second field of statm is the number of resident pages (only available on Linux)
+    FILE* statm = std::fopen("/proc/self/statm", "r");
+    if (statm) {
+        unsigned long num_pages = 0;
+        unsigned long num_resident_pages = 0;
+        if (std::fscanf(statm, "%lu %lu", &num_pages, &num_resident_pages) == 2) {
+            rss = size_t(num_resident_pages) * size_t(sysconf(_SC_PAGESIZE));
+        }
+        std::fclose(statm);
+    }
+#endif
+
+    return rss;
+}
+
+#ifdef __unix__
+///@brief Returns the time of the specified CPU clock in seconds, or zero if unable to determine.
+static double get_cpu_clock_time(clockid_t clock_id) {
+    timespec time;
+    if (clock_gettime(clock_id, &time) != 0) {
+        return 0.;
+    }
+    return time.tv_sec + time.tv_nsec * 1e-9;
+}
+#endif
+
+///@brief Returns the CPU time (in seconds) used by the calling thread, or zero if unable to determine.
+double get_thread_cpu_time() {
+#ifdef __unix__
+    return get_cpu_clock_time(CLOCK_THREAD_CPUTIME_ID);
+#else
+    return 0.;
+#endif
+}
+
+///@brief Returns the CPU time (in seconds) used by all the threads of the process, or zero if unable to determine.
+double get_process_cpu_time() {
+#ifdef __unix__
+    return get_cpu_clock_time(CLOCK_PROCESS_CPUTIME_ID);
+#else
+    return 0.;
+#endif
+}
+
 } // namespace vtr
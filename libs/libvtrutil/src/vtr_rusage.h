@@ -6,6 +6,15 @@ namespace vtr {
 
 ///@brief Returns the maximum resident set size in bytes, or zero if unable to determine.
 size_t get_max_rss();
+
+///@brief Returns the current resident set size in bytes, or zero if unable to determine.
+size_t get_current_rss();
+
+///@brief Returns the CPU time (in seconds) used by the calling thread, or zero if unable to determine.
+double get_thread_cpu_time();
+
+///@brief Returns the CPU time (in seconds) used by all the threads of the process, or zero if unable to determine.
+double get_process_cpu_time();
 } // namespace vtr
 
 #endif
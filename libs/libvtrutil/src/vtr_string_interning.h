@@ -51,6 +51,9 @@
 #include <cstdint>
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <mutex>
+#include <string_view>
 
 #include "vtr_strong_id.h"
 #include "vtr_string_view.h"
@@ -339,9 +342,44 @@ inline bool operator<=(bound_interned_string lhs,
 
 /**
  * @brief  Storage of interned string, and object capable of generating new interned_string objects.
+ *
+ * intern_string and get_string may be called concurrently from several
+ * threads, e.g. by parallel readers of architecture or FASM data.  The id of a
+ * string part never changes once handed out, but when several threads intern
+ * new strings the ids they get depend on their interleaving.
  */
 class string_internment {
   public:
+    string_internment() = default;
+
+    string_internment(const string_internment& other) {
+        copy_from(other);
+    }
+
+    string_internment(string_internment&& other) noexcept {
+        swap(other);
+    }
+
+    string_internment& operator=(const string_internment& other) {
+        if (this != &other) {
+            clear();
+            copy_from(other);
+        }
+        return *this;
+    }
+
+    string_internment& operator=(string_internment&& other) noexcept {
+        if (this != &other) {
+            clear();
+            swap(other);
+        }
+        return *this;
+    }
+
+    ~string_internment() {
+        clear();
+    }
+
     /**
      * @brief Intern a string, and return a unique identifier to that string.
      *
@@ -387,34 +425,125 @@ class string_internment {
      * This method should not generally be called directly.
      */
     vtr::string_view get_string(StringId id) const {
-        auto& str = strings_[id];
+        const std::string& str = string_at(size_t(id));
         return vtr::string_view(str.data(), str.size());
     }
 
     ///@brief Number of unique string parts stored.
     size_t unique_strings() const {
-        return strings_.size();
+        return num_strings_.load(std::memory_order_acquire);
     }
 
   private:
     StringId intern_one_string(vtr::string_view view) {
-        temporary_.assign(view.begin(), view.end());
-        StringId next_id(strings_.size());
-        auto result = string_to_id_.insert(std::make_pair(temporary_, next_id));
-        if (result.second) {
-            strings_.push_back(std::move(temporary_));
+        std::string_view key(view.data(), view.size());
+        t_shard& shard = shards_[std::hash<std::string_view>()(key) % kNumShards];
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto iter = shard.string_to_id.find(key);
+        if (iter != shard.string_to_id.end()) {
+            return iter->second;
+        }
+
+        size_t next_id = num_strings_.fetch_add(1, std::memory_order_acq_rel);
+        std::string& str = allocate_string(next_id);
+        str.assign(view.begin(), view.end());
+
+        //The key views the stored string, which never moves
+        shard.string_to_id.emplace(std::string_view(str), StringId(next_id));
+        return StringId(next_id);
+    }
+
+    ///@brief Returns the chunk and the offset in the chunk of the string with the given id
+    static void locate_string(size_t id, size_t* chunk, size_t* offset) {
+        //Chunk c holds the ids [kFirstChunkSize * (2^c - 1), kFirstChunkSize * (2^(c+1) - 1))
+        size_t chunk_plus_one = id / kFirstChunkSize + 1;
+        *chunk = 0;
+        while (chunk_plus_one >>= 1) {
+            ++*chunk;
         }
+        *offset = id - kFirstChunkSize * ((size_t(1) << *chunk) - 1);
+    }
+
+    std::string& allocate_string(size_t id) {
+        size_t chunk, offset;
+        locate_string(id, &chunk, &offset);
+        if (chunk >= kNumChunks) {
+            throw std::runtime_error("Storage size exceeded.");
+        }
+
+        std::string* strings = chunks_[chunk].load(std::memory_order_acquire);
+        if (strings == nullptr) {
+            std::lock_guard<std::mutex> lock(chunks_mutex_);
+            strings = chunks_[chunk].load(std::memory_order_relaxed);
+            if (strings == nullptr) {
+                strings = new std::string[kFirstChunkSize << chunk];
+                chunks_[chunk].store(strings, std::memory_order_release);
+            }
+        }
+        return strings[offset];
+    }
+
+    const std::string& string_at(size_t id) const {
+        size_t chunk, offset;
+        locate_string(id, &chunk, &offset);
+        return chunks_[chunk].load(std::memory_order_acquire)[offset];
+    }
 
-        return result.first->second;
+    ///@brief Interns the strings of other with the same ids (other must not be modified meanwhile)
+    void copy_from(const string_internment& other) {
+        size_t num_strings = other.unique_strings();
+        for (size_t id = 0; id < num_strings; ++id) {
+            intern_one_string(other.get_string(StringId(id)));
+        }
     }
 
-    // FIXME: This storage scheme does store 2x memory for the strings storage,
-    // however it does avoid having to be concerned with what happens when
-    // strings_ resizes, so for a simplier initial implementation, this is the
-    // approach taken.
-    vtr::vector<StringId, std::string> strings_;
-    std::string temporary_;
-    std::unordered_map<std::string, StringId> string_to_id_;
+    void swap(string_internment& other) noexcept {
+        for (size_t chunk = 0; chunk < kNumChunks; ++chunk) {
+            chunks_[chunk].store(other.chunks_[chunk].exchange(chunks_[chunk].load()));
+        }
+        for (size_t ishard = 0; ishard < kNumShards; ++ishard) {
+            shards_[ishard].string_to_id.swap(other.shards_[ishard].string_to_id);
+        }
+        num_strings_.store(other.num_strings_.exchange(num_strings_.load()));
+    }
+
+    void clear() {
+        for (size_t ishard = 0; ishard < kNumShards; ++ishard) {
+            shards_[ishard].string_to_id.clear();
+        }
+        for (size_t chunk = 0; chunk < kNumChunks; ++chunk) {
+            delete[] chunks_[chunk].exchange(nullptr);
+        }
+        num_strings_.store(0);
+    }
+
+    /*
+     * The strings are stored in chunks of doubling sizes, allocated as they
+     * are needed, so that a stored string never moves: the lookup keys can
+     * view the stored strings, and get_string() can read them without a lock
+     * while other threads intern new strings.
+     */
+    static constexpr size_t kFirstChunkSize = 256;
+    static constexpr size_t kNumChunks = 17;
+    static_assert(kFirstChunkSize * ((size_t(1) << kNumChunks) - 1) >= (size_t(1) << (kBytesPerId * CHAR_BIT)),
+                  "Too few chunks to store all the string ids");
+
+    std::array<std::atomic<std::string*>, kNumChunks> chunks_ = {};
+    std::mutex chunks_mutex_;
+    std::atomic<size_t> num_strings_{0};
+
+    /*
+     * The lookup from string to id is split in shards by hash, each with its
+     * own lock, so that threads interning different strings rarely contend.
+     */
+    static constexpr size_t kNumShards = 64;
+
+    struct alignas(64) t_shard {
+        std::mutex mutex;
+        std::unordered_map<std::string_view, StringId> string_to_id;
+    };
+    std::array<t_shard, kNumShards> shards_;
 };
 
 /**
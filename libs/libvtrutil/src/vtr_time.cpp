@@ -33,7 +33,8 @@ float Timer::delta_max_rss_mib() const {
 ///@brief Constructor
 ScopedActionTimer::ScopedActionTimer(std::string action_str)
     : action_(std::move(action_str))
-    , depth_(f_timer_depth++) {
+    , depth_(f_timer_depth++)
+    , profile_phase_(action_) {
 }
 
 ///@brief Destructor
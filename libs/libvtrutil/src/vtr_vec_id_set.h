@@ -91,10 +91,17 @@ class vec_id_set {
         std::sort(vec_.begin(), vec_.end());
     }
 
-    ///@bried Clears the container
+    /**
+     * @brief Clears the container
+     *
+     * Only the membership bits of the contained elements are reset, so clearing costs
+     * O(size()) rather than O(largest id) and the bit-set doesn't need to regrow.
+     */
     void clear() {
+        for (T val : vec_) {
+            contained_[size_t(val)] = false;
+        }
         vec_.clear();
-        contained_.clear();
     }
 
   private:
@@ -39,17 +39,24 @@ namespace vtr {
  * As with a std::vector, it is the caller's responsibility to ensure there is sufficient space
  * when a given index/key before it is accessed. The exception to this are the find(), insert() and
  * update() methods which handle non-existing keys gracefully.
+ *
+ * The values are allocated with Allocator (e.g. vtr::arena_allocator, passed as the last
+ * constructor argument like for std::vector).
  */
 
-template<typename K, typename V, typename Sentinel = DefaultSentinel<V>>
+template<typename K, typename V, typename Sentinel = DefaultSentinel<V>, typename Allocator = std::allocator<V>>
 class vector_map {
+    using storage = std::vector<V, Allocator>;
+
   public: //Public types
-    typedef typename std::vector<V>::const_reference const_reference;
-    typedef typename std::vector<V>::reference reference;
+    typedef typename storage::const_reference const_reference;
+    typedef typename storage::reference reference;
+
+    typedef typename storage::iterator iterator;
+    typedef typename storage::const_iterator const_iterator;
+    typedef typename storage::const_reverse_iterator const_reverse_iterator;
 
-    typedef typename std::vector<V>::iterator iterator;
-    typedef typename std::vector<V>::const_iterator const_iterator;
-    typedef typename std::vector<V>::const_reverse_iterator const_reverse_iterator;
+    typedef typename storage::allocator_type allocator_type;
 
   public:
     ///@brief Constructor
@@ -160,12 +167,12 @@ class vector_map {
     void update(const K key, const V value) { insert(key, value); }
 
     ///@brief Swap (this enables std::swap via ADL)
-    friend void swap(vector_map<K, V>& x, vector_map<K, V>& y) {
+    friend void swap(vector_map& x, vector_map& y) {
         std::swap(x.vec_, y.vec_);
     }
 
   private:
-    std::vector<V> vec_;
+    storage vec_;
 };
 
 } // namespace vtr
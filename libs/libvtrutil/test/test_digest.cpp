@@ -0,0 +1,51 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "vtr_digest.h"
+#include "picosha2.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+static std::string digest_string(const std::string& str) {
+    std::istringstream is(str);
+    return vtr::secure_digest_stream(is);
+}
+
+TEST_CASE("secure_digest_stream", "[vtr_digest/secure_digest_stream]") {
+    SECTION("FIPS 180-2 examples") {
+        REQUIRE(digest_string("") == "SHA256:e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+        REQUIRE(digest_string("abc") == "SHA256:ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+        REQUIRE(digest_string("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq") == "SHA256:248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+        REQUIRE(digest_string(std::string(1000000, 'a')) == "SHA256:cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+    }
+
+    SECTION("Same as picosha2 across block boundaries") {
+        std::string str;
+        for (size_t size = 0; size < 300; ++size) {
+            REQUIRE(digest_string(str) == "SHA256:" + picosha2::hash256_hex_string(str));
+            str.push_back(char(size * 131 + 7));
+        }
+    }
+}
+
+TEST_CASE("secure_digest_file", "[vtr_digest/secure_digest_file]") {
+    const std::string filepath = "test_vtr_digest.tmp";
+
+    {
+        std::ofstream os(filepath);
+        os << "abc";
+    }
+    REQUIRE(vtr::secure_digest_file(filepath) == "SHA256:ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    REQUIRE(vtr::secure_digest_file(filepath) == "SHA256:ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+
+    //A rewritten file is digested again
+    {
+        std::ofstream os(filepath);
+        os << "abcd";
+    }
+    REQUIRE(vtr::secure_digest_file(filepath) == "SHA256:88d4266fd4e6338d13b845fcf289579d209c897823b9217da3e161936f031589");
+
+    std::remove(filepath.c_str());
+}
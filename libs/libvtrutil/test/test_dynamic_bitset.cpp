@@ -0,0 +1,92 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "vtr_dynamic_bitset.h"
+
+#include <cstdint>
+#include <vector>
+
+template<typename Storage>
+static void check_bitset_operations() {
+    //Large enough for the vector kernels and their scalar tails
+    const size_t num_bits = 1000;
+    vtr::dynamic_bitset<size_t, Storage> a(num_bits);
+    vtr::dynamic_bitset<size_t, Storage> b(num_bits);
+    std::vector<bool> ref_a(a.size()), ref_b(b.size());
+    for (size_t i = 0; i < num_bits; i++) {
+        ref_a[i] = (i % 3 == 0);
+        ref_b[i] = (i % 5 == 0) || i == 997;
+        a.set(i, ref_a[i]);
+        b.set(i, ref_b[i]);
+    }
+
+    {
+        //count, find and iteration
+        size_t ref_count = 0;
+        std::vector<size_t> ref_bits;
+        for (size_t i = 0; i < a.size(); i++) {
+            if (ref_a[i]) {
+                ref_count++;
+                ref_bits.push_back(i);
+            }
+        }
+        REQUIRE(a.count() == ref_count);
+
+        std::vector<size_t> bits;
+        a.for_each_set_bit([&](size_t i) { bits.push_back(i); });
+        REQUIRE(bits == ref_bits);
+
+        bits.clear();
+        for (size_t i = a.find_first(); i < a.size(); i = a.find_next(i)) {
+            bits.push_back(i);
+        }
+        REQUIRE(bits == ref_bits);
+    }
+
+    {
+        //bitwise operations
+        auto a_and = a;
+        a_and &= b;
+        auto a_or = a;
+        a_or |= b;
+        auto a_xor = a;
+        a_xor ^= b;
+        auto a_and_not = a;
+        a_and_not.and_not(b);
+        for (size_t i = 0; i < a.size(); i++) {
+            REQUIRE(a_and.get(i) == (ref_a[i] && ref_b[i]));
+            REQUIRE(a_or.get(i) == (ref_a[i] || ref_b[i]));
+            REQUIRE(a_xor.get(i) == (ref_a[i] != ref_b[i]));
+            REQUIRE(a_and_not.get(i) == (ref_a[i] && !ref_b[i]));
+        }
+
+        REQUIRE(a.intersects(b));
+        REQUIRE(!a_and_not.intersects(b));
+        REQUIRE(a_and.is_subset_of(a));
+        REQUIRE(!a.is_subset_of(a_and));
+    }
+
+    {
+        //empty and single bit
+        vtr::dynamic_bitset<size_t, Storage> c(num_bits);
+        REQUIRE(c.none());
+        REQUIRE(c.find_first() == c.size());
+        REQUIRE(!c.intersects(a));
+        REQUIRE(c.is_subset_of(a));
+
+        //The last bit, past the vector kernels
+        c.set(997, true);
+        REQUIRE(c.any());
+        REQUIRE(c.count() == 1);
+        REQUIRE(c.find_first() == 997);
+        REQUIRE(c.find_next(997) == c.size());
+        REQUIRE(c.intersects(b));
+        REQUIRE(!c.intersects(a));
+        REQUIRE(c.is_subset_of(b));
+    }
+}
+
+TEST_CASE("dynamic_bitset", "[vtr_dynamic_bitset/dynamic_bitset]") {
+    check_bitset_operations<unsigned int>();
+    check_bitset_operations<uint8_t>();
+    check_bitset_operations<uint64_t>();
+}
@@ -88,3 +88,20 @@ TEST_CASE("Function Expressions", "[vtr_expr_eval]") {
     REQUIRE(parser.parse_formula("gcd(20, 25)", vars) == 5);
     REQUIRE(parser.parse_formula("lcm(20, 25)", vars) == 100);
 }
+
+TEST_CASE("Repeated Expressions", "[vtr_expr_eval]") {
+    vtr::FormulaParser parser;
+    vtr::t_formula_data vars;
+
+    //Formulas are compiled once, and must pick up new variable values each time
+    for (int t = 0; t < 10; t++) {
+        vars.clear();
+        vars.set_var_value("W", 7);
+        vars.set_var_value("t", t);
+        REQUIRE(parser.parse_formula("(t + W - 1) % W", vars) == (t + 6) % 7);
+        REQUIRE(parser.parse_formula("max(t, W) - t * t", vars) == std::max(t, 7) - t * t);
+    }
+
+    vars.clear();
+    REQUIRE_THROWS(parser.parse_formula("(t + W - 1) % W", vars));
+}
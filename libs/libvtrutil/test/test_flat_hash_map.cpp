@@ -0,0 +1,82 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "vtr_flat_hash_map.h"
+#include "vtr_strong_id.h"
+
+#include <map>
+#include <string>
+
+struct test_id_tag;
+typedef vtr::StrongId<test_id_tag> TestId;
+
+TEST_CASE("flat_hash_map basics", "[vtr_flat_hash_map]") {
+    vtr::flat_hash_map<std::string, int> map;
+    REQUIRE(map.empty());
+    REQUIRE(map.find("a") == map.end());
+
+    map["a"] = 1;
+    map.insert({"b", 2});
+    map.emplace("c", 3);
+    auto ret = map.try_emplace("a", 10);
+    REQUIRE(!ret.second);
+    REQUIRE(ret.first->second == 1);
+
+    REQUIRE(map.size() == 3);
+    REQUIRE(map.at("b") == 2);
+    REQUIRE(map.count("c") == 1);
+    REQUIRE(map.count("d") == 0);
+    REQUIRE_THROWS_AS(map.at("d"), std::out_of_range);
+
+    REQUIRE(map.erase("b") == 1);
+    REQUIRE(map.erase("b") == 0);
+    REQUIRE(map.size() == 2);
+    REQUIRE(!map.contains("b"));
+
+    vtr::flat_hash_map<std::string, int> copy = map;
+    map.clear();
+    REQUIRE(map.empty());
+    REQUIRE(copy.size() == 2);
+    REQUIRE(copy["c"] == 3);
+}
+
+TEST_CASE("flat_hash_map matches std::map", "[vtr_flat_hash_map]") {
+    vtr::flat_hash_map<TestId, size_t> map;
+    std::map<TestId, size_t> ref;
+
+    //Interleave insertions and erasures, so look-ups probe past erased slots and the table re-hashes
+    for (size_t i = 0; i < 10000; i++) {
+        TestId id((i * 7919) % 3001);
+        if (i % 3 == 2) {
+            REQUIRE(map.erase(id) == ref.erase(id));
+        } else {
+            map[id] += i;
+            ref[id] += i;
+        }
+    }
+
+    REQUIRE(map.size() == ref.size());
+    for (const auto& kv : ref) {
+        auto iter = map.find(kv.first);
+        REQUIRE(iter != map.end());
+        REQUIRE(iter->second == kv.second);
+    }
+
+    size_t num_iterated = 0;
+    for (const auto& kv : map) {
+        REQUIRE(ref.at(kv.first) == kv.second);
+        num_iterated++;
+    }
+    REQUIRE(num_iterated == ref.size());
+
+    //Erasing while iterating
+    for (auto iter = map.begin(); iter != map.end();) {
+        if (size_t(iter->first) % 2 == 0) {
+            iter = map.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+    for (const auto& kv : ref) {
+        REQUIRE(map.contains(kv.first) == (size_t(kv.first) % 2 == 1));
+    }
+}
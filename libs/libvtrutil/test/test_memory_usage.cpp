@@ -0,0 +1,66 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "vtr_memory_usage.h"
+#include "vtr_ndmatrix.h"
+#include "vtr_strong_id.h"
+#include "vtr_vector.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct test_id_tag;
+typedef vtr::StrongId<test_id_tag> TestId;
+
+TEST_CASE("memory_usage", "[vtr_memory_usage]") {
+    SECTION("vectors count their capacity slack") {
+        std::vector<int> vec(10);
+        vec.reserve(16);
+        vtr::t_memory_usage usage = vtr::vector_memory_usage(vec);
+        REQUIRE(usage.bytes == vec.capacity() * sizeof(int));
+        REQUIRE(usage.slack_bytes == (vec.capacity() - 10) * sizeof(int));
+
+        vec.shrink_to_fit();
+        REQUIRE(vtr::vector_memory_usage(vec).slack_bytes == (vec.capacity() - vec.size()) * sizeof(int));
+    }
+
+    SECTION("vtr::vector") {
+        vtr::vector<TestId, double> vec(4);
+        vec.reserve(8);
+        vtr::t_memory_usage usage = vtr::vector_memory_usage(vec);
+        REQUIRE(usage.bytes == vec.capacity() * sizeof(double));
+        REQUIRE(usage.slack_bytes == (vec.capacity() - 4) * sizeof(double));
+    }
+
+    SECTION("nested vectors include the inner buffers") {
+        std::vector<std::vector<int>> vec(3, std::vector<int>(5));
+        vtr::t_memory_usage usage = vtr::nested_vector_memory_usage(vec);
+        size_t expected = vec.capacity() * sizeof(std::vector<int>);
+        for (const auto& inner : vec) {
+            expected += inner.capacity() * sizeof(int);
+        }
+        REQUIRE(usage.bytes == expected);
+    }
+
+    SECTION("matrices") {
+        vtr::NdMatrix<float, 3> matrix({2, 3, 4});
+        vtr::t_memory_usage usage = vtr::matrix_memory_usage(matrix);
+        REQUIRE(usage.bytes == matrix.capacity() * sizeof(float));
+        REQUIRE(usage.bytes >= 24 * sizeof(float));
+    }
+
+    SECTION("hash containers grow with their elements") {
+        std::unordered_map<int, int> map;
+        vtr::t_memory_usage empty_usage = vtr::hash_memory_usage(map);
+        for (int i = 0; i < 100; ++i) {
+            map[i] = i;
+        }
+        REQUIRE(vtr::hash_memory_usage(map).bytes >= empty_usage.bytes + 100 * sizeof(std::pair<const int, int>));
+    }
+
+    SECTION("short strings hold no heap memory") {
+        REQUIRE(vtr::string_memory_usage(std::string("a")).bytes == 0);
+        std::string long_str(1000, 'a');
+        REQUIRE(vtr::string_memory_usage(long_str).bytes > 1000);
+    }
+}
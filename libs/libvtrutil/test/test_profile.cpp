@@ -0,0 +1,74 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "vtr_profile.h"
+#include "vtr_time.h"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+static std::string read_file(const std::string& filename) {
+    std::ifstream file(filename);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+TEST_CASE("phase_profile", "[vtr_profile]") {
+    const std::string trace_file = "test_phase_profile.json";
+
+    SECTION("records nested phases") {
+        vtr::start_phase_profiling();
+        REQUIRE(vtr::is_phase_profiling());
+        {
+            vtr::ScopedProfilePhase outer("outer");
+            {
+                vtr::ScopedProfilePhase inner("inner \"quoted\"");
+            }
+        }
+        vtr::write_phase_profile(trace_file);
+        vtr::stop_phase_profiling();
+
+        std::string trace = read_file(trace_file);
+        REQUIRE(trace.find("\"traceEvents\"") != std::string::npos);
+        REQUIRE(trace.find("\"name\": \"outer\"") != std::string::npos);
+        REQUIRE(trace.find("\"name\": \"inner \\\"quoted\\\"\"") != std::string::npos);
+        REQUIRE(trace.find("\"depth\": 1") != std::string::npos);
+
+        //The enclosing phase starts first
+        REQUIRE(trace.find("\"name\": \"outer\"") < trace.find("\"name\": \"inner"));
+    }
+
+    SECTION("timers are phases") {
+        vtr::start_phase_profiling();
+        {
+            vtr::ScopedFinishTimer timer("timed action");
+            timer.quiet(true);
+        }
+        vtr::write_phase_profile(trace_file);
+        vtr::stop_phase_profiling();
+
+        REQUIRE(read_file(trace_file).find("\"name\": \"timed action\"") != std::string::npos);
+    }
+
+    SECTION("disabled") {
+        REQUIRE(!vtr::is_phase_profiling());
+        {
+            vtr::ScopedProfilePhase phase("not recorded");
+        }
+        vtr::write_phase_profile(trace_file);
+
+        REQUIRE(read_file(trace_file).find("not recorded") == std::string::npos);
+    }
+}
+
+TEST_CASE("record_allocation", "[vtr_profile]") {
+    size_t num_allocations = vtr::num_recorded_allocations();
+    size_t allocation_bytes = vtr::recorded_allocation_bytes();
+
+    vtr::record_allocation(64);
+
+    //Other allocations may be counted too, by the allocation hook
+    REQUIRE(vtr::num_recorded_allocations() >= num_allocations + 1);
+    REQUIRE(vtr::recorded_allocation_bytes() >= allocation_bytes + 64);
+}
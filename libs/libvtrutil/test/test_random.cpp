@@ -2,6 +2,7 @@
 
 #include "vtr_random.h"
 
+#include <algorithm>
 #include <vector>
 #include <iostream>
 
@@ -14,3 +15,65 @@ TEST_CASE("shuffle", "[vtr_random/shuffle]") {
     std::vector<int> numbers_shuffled_1 = {5, 2, 4, 1, 3};
     REQUIRE(numbers == numbers_shuffled_1);
 }
+
+TEST_CASE("RandomNumberGenerator", "[vtr_random/RandomNumberGenerator]") {
+    SECTION("xoshiro256** reference") {
+        vtr::RandomNumberGenerator rng;
+        rng.set_state({1, 2, 3, 4});
+        REQUIRE(rng.next() == 11520u);
+        REQUIRE(rng.next() == 0u);
+        REQUIRE(rng.next() == 1509978240u);
+    }
+
+    SECTION("reproducible") {
+        vtr::RandomNumberGenerator rng_1(42);
+        vtr::RandomNumberGenerator rng_2(42);
+        for (int i = 0; i < 100; i++) {
+            REQUIRE(rng_1.next() == rng_2.next());
+        }
+    }
+
+    SECTION("bounds") {
+        vtr::RandomNumberGenerator rng(1);
+        REQUIRE(rng.irand(0) == 0);
+
+        std::vector<int> counts(7, 0);
+        for (int i = 0; i < 7000; i++) {
+            int value = rng.irand(6);
+            REQUIRE(value >= 0);
+            REQUIRE(value <= 6);
+            counts[value]++;
+
+            float fvalue = rng.frand();
+            REQUIRE(fvalue >= 0.f);
+            REQUIRE(fvalue < 1.f);
+        }
+        for (int count : counts) {
+            REQUIRE(count > 0);
+        }
+    }
+
+    SECTION("worker streams") {
+        vtr::RandomNumberGenerator stream_0 = vtr::RandomNumberGenerator::worker_stream(7, 0);
+        vtr::RandomNumberGenerator stream_1 = vtr::RandomNumberGenerator::worker_stream(7, 1);
+        vtr::RandomNumberGenerator stream_1_again = vtr::RandomNumberGenerator::worker_stream(7, 1);
+
+        vtr::RandomNumberGenerator jumped(7);
+        jumped.jump();
+
+        REQUIRE(stream_0.state() == vtr::RandomNumberGenerator(7).state());
+        REQUIRE(stream_1.state() == jumped.state());
+        REQUIRE(stream_1.state() == stream_1_again.state());
+        REQUIRE(stream_0.next() != stream_1.next());
+    }
+
+    SECTION("shuffle") {
+        std::vector<int> numbers = {1, 2, 3, 4, 5};
+        vtr::RandomNumberGenerator rng(3);
+        vtr::shuffle(numbers.begin(), numbers.end(), rng);
+
+        std::vector<int> sorted = numbers;
+        std::sort(sorted.begin(), sorted.end());
+        REQUIRE(sorted == std::vector<int>({1, 2, 3, 4, 5}));
+    }
+}
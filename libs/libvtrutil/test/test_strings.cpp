@@ -3,6 +3,10 @@
 #include "vtr_string_view.h"
 #include "vtr_string_interning.h"
 
+#include <string>
+#include <thread>
+#include <vector>
+
 TEST_CASE("String view", "[vtr_string_view/string_view]") {
     vtr::string_view a("test");
     vtr::string_view b("test");
@@ -209,3 +213,46 @@ TEST_CASE("Split string internment", "[vtr_string_interning/string_internment]")
     test_internment_retreval(&internment, q, "e..f");
     test_internment_retreval(&internment, r, "e.");
 }
+
+TEST_CASE("Concurrent string internment", "[vtr_string_interning/string_internment]") {
+    vtr::string_internment internment;
+
+    const size_t num_threads = 8;
+    const size_t num_names = 4999; //Prime, so that every stride below visits all the names
+    std::vector<std::vector<vtr::interned_string>> interned(num_threads);
+
+    //All the threads intern the same names (in different orders)
+    std::vector<std::thread> threads;
+    for (size_t ithread = 0; ithread < num_threads; ++ithread) {
+        threads.emplace_back([&, ithread]() {
+            std::vector<vtr::interned_string>& strings = interned[ithread];
+            strings.resize(num_names, internment.intern_string(vtr::string_view("")));
+            for (size_t i = 0; i < num_names; ++i) {
+                size_t name = (i * (2 * ithread + 1)) % num_names;
+                std::string str = "TILE.CLB" + std::to_string(name % 7) + ".N" + std::to_string(name);
+                strings[name] = internment.intern_string(vtr::string_view(str.data(), str.size()));
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    //"", "TILE", "CLB0".."CLB6" and "N0".."N<num_names-1>"
+    REQUIRE(internment.unique_strings() == 1 + 1 + 7 + num_names);
+
+    std::string str;
+    for (size_t name = 0; name < num_names; ++name) {
+        for (size_t ithread = 1; ithread < num_threads; ++ithread) {
+            REQUIRE(interned[ithread][name] == interned[0][name]);
+        }
+        interned[0][name].get(&internment, &str);
+        REQUIRE(str == "TILE.CLB" + std::to_string(name % 7) + ".N" + std::to_string(name));
+    }
+
+    //Copies keep the ids
+    vtr::string_internment copy = internment;
+    REQUIRE(copy.unique_strings() == internment.unique_strings());
+    interned[0][42].get(&copy, &str);
+    REQUIRE(str == "TILE.CLB0.N42");
+}
@@ -1,8 +1,15 @@
 #include "catch2/catch_test_macros.hpp"
 
 #include "vtr_vector.h"
+#include "vtr_vector_map.h"
+#include "vtr_ndmatrix.h"
+#include "vtr_arena.h"
+#include "vtr_memory.h"
 #include "vtr_strong_id.h"
 
+#include <cstdint>
+#include <string>
+
 #include <ostream>
 
 struct test_tag;
@@ -55,3 +62,112 @@ TEST_CASE("Key Access", "[vtr_vector]") {
         ++i;
     }
 }
+
+TEST_CASE("Arena Allocation", "[vtr_vector]") {
+    vtr::Arena arena(256);
+
+    {
+        vtr::arena_vector<TestId, std::string> vec{vtr::arena_allocator<std::string>(&arena)};
+        vec.reserve(100);
+        for (int i = 0; i < 100; i++) {
+            vec.push_back(std::to_string(i));
+        }
+        REQUIRE(vec[TestId(42)] == "42");
+        REQUIRE(vec.get_allocator().arena == &arena);
+
+        vtr::vector_map<TestId, int, vtr::DefaultSentinel<int>, vtr::arena_allocator<int>> map{vtr::arena_allocator<int>(&arena)};
+        map.insert(TestId(3), 7);
+        REQUIRE(map.size() == 4);
+        REQUIRE(map[TestId(3)] == 7);
+
+        vtr::NdMatrix<int, 2, vtr::arena_allocator<int>> matrix({10, 20}, 5, vtr::arena_allocator<int>(&arena));
+        REQUIRE(matrix[9][19] == 5);
+
+        //Copies draw from the same arena
+        auto matrix_copy = matrix;
+        matrix_copy[0][0] = 1;
+        REQUIRE(matrix[0][0] == 5);
+        REQUIRE(matrix_copy.get_allocator() == matrix.get_allocator());
+
+        void* aligned = arena.allocate(8, 128);
+        REQUIRE(reinterpret_cast<uintptr_t>(aligned) % 128 == 0);
+
+        REQUIRE(arena.bytes_allocated() > 0);
+        REQUIRE(arena.bytes_reserved() >= arena.bytes_allocated());
+    }
+
+    //Only the largest block is kept
+    size_t reserved = arena.bytes_reserved();
+    arena.release();
+    REQUIRE(arena.bytes_allocated() == 0);
+    REQUIRE(arena.bytes_reserved() > 0);
+    REQUIRE(arena.bytes_reserved() <= reserved);
+
+    //Without an arena, allocations come from the heap
+    vtr::NdMatrix<int, 1, vtr::arena_allocator<int>> heap_matrix({4}, 2);
+    REQUIRE(heap_matrix[3] == 2);
+    REQUIRE(heap_matrix.get_allocator().arena == nullptr);
+}
+
+TEST_CASE("Aligned matrix layout", "[vtr_ndmatrix/NdMatrix]") {
+    //Rows of 5 floats, padded to 16 (a cache line)
+    vtr::AlignedNdMatrix<float, 3> matrix({3, 4, 5}, 1.f);
+    REQUIRE(matrix.size() == 60);
+    REQUIRE(matrix.row_stride() == 16);
+    REQUIRE(matrix.capacity() == 3 * 4 * 16);
+
+    for (size_t i = 0; i < 3; i++) {
+        for (size_t j = 0; j < 4; j++) {
+            vtr::array_view<float> row = matrix.row({i, j});
+            REQUIRE(row.size() == 5);
+            REQUIRE(reinterpret_cast<uintptr_t>(row.data()) % vtr::kCacheLineBytes == 0);
+            REQUIRE(row.data() == &matrix[i][j][0]);
+            for (size_t k = 0; k < 5; k++) {
+                row[k] = i * 100 + j * 10 + k;
+            }
+        }
+    }
+
+    //Flat accesses skip the padding
+    REQUIRE(matrix.get(0) == 0.f);
+    REQUIRE(matrix.get(5) == 10.f);
+    REQUIRE(matrix.get(59) == 234.f);
+
+    auto matrix_copy = matrix;
+    REQUIRE(matrix_copy[2][3][4] == 234.f);
+    REQUIRE(matrix_copy.row({1, 2})[3] == 123.f);
+
+    //The default layout is not padded
+    vtr::NdMatrix<float, 3> packed({3, 4, 5});
+    REQUIRE(packed.row_stride() == 5);
+    REQUIRE(packed.capacity() == 60);
+    REQUIRE(packed.row({1, 0}).data() == &packed.get(20));
+}
+
+TEST_CASE("Large array allocation", "[vtr_vector]") {
+    const vtr::t_large_array_policy default_policy = vtr::large_array_policy();
+
+    for (vtr::e_huge_pages huge_pages : {vtr::e_huge_pages::OFF, vtr::e_huge_pages::TRANSPARENT, vtr::e_huge_pages::EXPLICIT}) {
+        vtr::t_large_array_policy policy;
+        policy.huge_pages = huge_pages;
+        policy.numa_interleave = true;
+        vtr::set_large_array_policy(policy);
+
+        //Small vectors come from the heap, large ones are mapped on huge page boundaries
+        vtr::vector<TestId, double, vtr::large_array_allocator<double>> small(10, 1.);
+        vtr::vector<TestId, double, vtr::large_array_allocator<double>> large(vtr::kLargeArrayBytes / sizeof(double) + 1, 2.);
+        REQUIRE(small[TestId(9)] == 1.);
+        REQUIRE(large[TestId(large.size() - 1)] == 2.);
+#ifdef __linux__
+        REQUIRE(reinterpret_cast<uintptr_t>(large.data()) % vtr::kLargeArrayBytes == 0);
+#endif
+
+        //Regrowing moves between the heap and the mappings
+        small.resize(large.size(), 3.);
+        large.clear();
+        large.shrink_to_fit();
+        REQUIRE(small[TestId(small.size() - 1)] == 3.);
+    }
+
+    vtr::set_large_array_policy(default_policy);
+}
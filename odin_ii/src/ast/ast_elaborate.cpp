@@ -832,15 +832,8 @@ ast_node_t* build_hierarchy(ast_node_t* node, ast_node_t* parent, int index, sc_
 
                     int num_instances = module->types.module.size_module_instantiations;
                     char* new_instance_name = vtr::strdup(new_id.c_str());
-                    bool found = false;
-                    for (int i = 0; i < num_instances; i++) {
-                        ast_node_t* temp_instance_node = module->types.module.module_instantiations_instance[i];
-                        char* temp_instance_name = temp_instance_node->children[0]->identifier_node->types.identifier;
-                        if (strcmp(node->children[0]->identifier_node->types.identifier, temp_instance_name) == 0
-                            || strcmp(new_instance_name, temp_instance_name) == 0) {
-                            found = true;
-                        }
-                    }
+                    bool found = has_module_instance_named(this_ref, node->children[0]->identifier_node->types.identifier)
+                                 || has_module_instance_named(this_ref, new_instance_name);
 
                     if (found) {
                         vtr::free(new_instance_name);
@@ -1502,17 +1495,9 @@ ast_node_t* finalize_ast(ast_node_t* node, ast_node_t* parent, sc_hierarchy* loc
                     ast_node_t* module = this_ref->top_node;
                     oassert(module->type == MODULE);
 
-                    int num_instances = module->types.module.size_module_instantiations;
                     char* new_instance_name = vtr::strdup(new_id.c_str());
-                    bool found = false;
-                    for (int i = 0; i < num_instances; i++) {
-                        ast_node_t* temp_instance_node = module->types.module.module_instantiations_instance[i];
-                        char* temp_instance_name = temp_instance_node->children[0]->identifier_node->types.identifier;
-                        if (strcmp(node->children[0]->identifier_node->types.identifier, temp_instance_name) == 0
-                            || strcmp(new_instance_name, temp_instance_name) == 0) {
-                            found = true;
-                        }
-                    }
+                    bool found = has_module_instance_named(this_ref, node->children[0]->identifier_node->types.identifier)
+                                 || has_module_instance_named(this_ref, new_instance_name);
 
                     if (found) {
                         vtr::free(new_instance_name);
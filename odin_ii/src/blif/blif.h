@@ -32,8 +32,12 @@
 #include "odin_types.h"
 #include "hash_table.h"
 
+#include <string>
+#include <vector>
+
 #include "vtr_util.h"
 #include "vtr_memory.h"
+#include "vtr_flat_hash_map.h"
 
 #define TOKENS " \t\n"
 #define GND_NAME "gnd"
@@ -71,6 +75,13 @@ struct hard_block_model {
     hard_block_ports* output_ports;
 };
 
+// The order of the pins of a hard block instance, as listed on its .subckt line and once sorted
+struct hard_block_pin_order {
+    std::vector<std::string> names;
+    // sorted[i] is the index in names of the i-th pin in sorted order
+    std::vector<int> sorted;
+};
+
 // A cache structure for models.
 struct hard_block_models {
     hard_block_model** models;
@@ -96,6 +107,10 @@ extern FILE* file;
  * and we ought to use fgets to pass '\' and the line length are 
  * always fix and less than a const value
  * 
+ * The buffer is allocated on the first call and reused by the next ones
+ * (it must then be freed by the caller), rather than reallocating a
+ * READ_BLIF_BUFFER sized block for every line.
+ * 
  * @param buf buffer pointer
  * @param size buffer size (in the case of using fgets)
  * @param fd file stream
@@ -104,12 +119,9 @@ extern FILE* file;
  *---------------------------------------------------------------------------------------------*/
 inline char* getbline(char*& buf, size_t size, FILE* fd) {
     char* retval = NULL;
-    if (buf) {
-        vtr::free(buf);
-        buf = NULL;
-    }
+    if (!buf)
+        buf = (char*)vtr::malloc(READ_BLIF_BUFFER * sizeof(char));
 
-    buf = (char*)vtr::malloc(READ_BLIF_BUFFER * sizeof(char));
     retval = vtr::fgets(buf, size, fd);
 
     return (retval);
@@ -330,16 +342,26 @@ class blif {
         static long get_hard_block_pin_number(char* original_name);
         /**
          * ---------------------------------------------------------------------------------------------
-         * (function: compare_hard_block_pin_names)
-         * @brief Callback function for qsort which compares pin names
-         * of the form port_name[pin_number] primarily
-         * on the port_name, and on the pin_number if the port_names
-         * are identical.
-         * @param p1 pin name 1
-         * @param p2 pin name 2
+         * (function: sort_hard_block_pin_order)
+         * @brief Computes the order of pin names of the form
+         * port_name[pin_number], sorted primarily on the port_name,
+         * and on the pin_number if the port_names are identical.
+         * @param names list of pin names
+         * @param count number of pin names
+         * @return the indices of names in sorted order
+         * ---------------------------------------------------------------------------------------------
+         */
+        static std::vector<int> sort_hard_block_pin_order(char** names, int count);
+        /**
+         * ---------------------------------------------------------------------------------------------
+         * (function: sort_hard_block_pin_names)
+         * @brief Sorts pin names of the form port_name[pin_number]
+         * (see sort_hard_block_pin_order)
+         * @param names list of pin names
+         * @param count number of pin names
          * ---------------------------------------------------------------------------------------------
          */
-        static int compare_hard_block_pin_names(const void* p1, const void* p2);
+        static void sort_hard_block_pin_names(char** names, int count);
         /**
          * ---------------------------------------------------------------------------------------------
          * (function: get_hard_block_ports)
@@ -451,6 +473,23 @@ class blif {
         static void free_hard_block_ports(hard_block_ports* p);
 
       private:
+        /**
+         * ---------------------------------------------------------------------------------------------
+         * (function: sort_hard_block_instance_pins)
+         * @brief Sorts the pin names of a hard block instance like
+         * sort_hard_block_pin_names. The order is cached per subcircuit, and
+         * reused by the following instances of the subcircuit listing the
+         * same pins in the same order (i.e. most of them).
+         * @param subcircuit_name the name of the instance's subcircuit
+         * @param names list of pin names
+         * @param count number of pin names
+         * ---------------------------------------------------------------------------------------------
+         */
+        void sort_hard_block_instance_pins(const char* subcircuit_name, char** names, int count);
+
+        // Pin name orders of the hard block instances, by subcircuit name
+        vtr::flat_hash_map<std::string, hard_block_pin_order> instance_pin_orders;
+
         /**
          *---------------------------------------------------------------------------------------------
          * (function: resolve_signal_name_based_on_blif_type)
@@ -494,6 +533,13 @@ class blif {
         static bool warn_undriven(nnode_t* node, nnet_t* net);
         // TODO Uncomment this for In Outs
         //static void merge_with_inputs(nnode_t* node, long pin_idx);
+        /**
+         * ---------------------------------------------------------------------------------------------
+         * (function: net_driver_name)
+         * 	The function that returns the name of the driver of a given net
+         *---------------------------------------------------------------------------------------------
+         */
+        static std::string net_driver_name(nnode_t* node, nnet_t* net, long driver_idx);
         /**
          * ---------------------------------------------------------------------------------------------
          * (function: print_net_driver)
@@ -508,6 +554,13 @@ class blif {
          *---------------------------------------------------------------------------------------------
          */
         static void print_input_single_driver(FILE* out, nnode_t* node, long pin_idx);
+        /**
+         * ---------------------------------------------------------------------------------------------
+         * (function: output_pin_name)
+         * 	The function that returns the name of the output pin of a given node
+         *---------------------------------------------------------------------------------------------
+         */
+        static std::string output_pin_name(nnode_t* node);
         /**
          * ---------------------------------------------------------------------------------------------
          * (function: print_output_pin)
@@ -557,16 +610,37 @@ class blif {
         void output_node(nnode_t* node, short /*traverse_number*/, FILE* fp);
         /**
          * ---------------------------------------------------------------------------------------------
-         * (function: define_logical_function)
+         * (function: is_logic_node)
+         * 	whether the node is a logic function printed as a .names
+         * ---------------------------------------------------------------------------------------------
+         */
+        static bool is_logic_node(const nnode_t* node);
+        /**
+         * ---------------------------------------------------------------------------------------------
+         * (function: logic_node_cover)
+         * 	returns the bit map of a logic node
+         * ---------------------------------------------------------------------------------------------
+         */
+        static std::string logic_node_cover(nnode_t* node);
+        /**
+         * ---------------------------------------------------------------------------------------------
+         * (function: logical_function_cover)
          * ---------------------------------------------------------------------------------------------
          */
-        void define_logical_function(nnode_t* node, FILE* out);
+        static std::string logical_function_cover(nnode_t* node);
         /**
          * ---------------------------------------------------------------------------------------------
-         * (function: define_set_input_logical_function)
+         * (function: decoded_mux_cover)
          * ---------------------------------------------------------------------------------------------
          */
-        void define_set_input_logical_function(nnode_t* node, const char* bit_output, FILE* out);
+        static std::string decoded_mux_cover(nnode_t* node);
+        /**
+         * ---------------------------------------------------------------------------------------------
+         * (function: define_logic_node)
+         * 	print out the .names of a logic node
+         * ---------------------------------------------------------------------------------------------
+         */
+        void define_logic_node(nnode_t* node, FILE* out);
         /** 
          * ---------------------------------------------------------------------------------------------
          * (function: define_clock)
@@ -581,10 +655,21 @@ class blif {
         void define_ff(nnode_t* node, FILE* out);
         /**
          * ---------------------------------------------------------------------------------------------
-         * (function: define_decoded_mux)
+         * (function: output_logic_through_abc)
+         * 	Optimizes and maps the logic nodes with ABC in-process, and prints the mapped logic
          * ---------------------------------------------------------------------------------------------
          */
-        void define_decoded_mux(nnode_t* node, FILE* out);
+        void output_logic_through_abc(FILE* out, const netlist_t* netlist);
+        /**
+         * ---------------------------------------------------------------------------------------------
+         * (function: is_abc_logic_node)
+         * 	whether the node is handed to ABC by output_logic_through_abc
+         * ---------------------------------------------------------------------------------------------
+         */
+        static bool is_abc_logic_node(const nnode_t* node);
+
+        /* When set, output_node collects the logic nodes here instead of printing them */
+        std::vector<nnode_t*>* abc_logic_nodes = nullptr;
     };
 };
 
@@ -0,0 +1,288 @@
+/*
+ * Copyright 2023 CAS—Atlantic (University of New Brunswick, CASA)
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "odin_util.h"
+#include "odin_types.h"
+#include "odin_globals.h"
+#include "blif.h"
+
+#ifdef ODIN_USE_ABC
+#    include "base/abc/abc.h"
+#    include "base/main/main.h"
+#    include "base/cmd/cmd.h"
+#endif
+
+#ifdef ODIN_USE_ABC
+/**
+ * ---------------------------------------------------------------------------------------------
+ * (function: merge_duplicate_fanins)
+ *
+ * @brief merges the columns of the cover of the inputs driven by the same signal, as ABC does
+ * not allow a node to have the same fanin twice
+ *
+ * @param fanins the signals of the inputs, updated to the distinct signals
+ * @param cover the bit map of the inputs, updated to the bit map of the distinct signals
+ * ---------------------------------------------------------------------------------------------
+ */
+static void merge_duplicate_fanins(std::vector<std::string>& fanins, std::string& cover) {
+    std::vector<std::string> distinct_fanins;
+    std::vector<size_t> column; // [input] -> column of its signal in distinct_fanins
+    for (const std::string& fanin : fanins) {
+        size_t icol = 0;
+        while (icol < distinct_fanins.size() && distinct_fanins[icol] != fanin)
+            icol++;
+        if (icol == distinct_fanins.size())
+            distinct_fanins.push_back(fanin);
+        column.push_back(icol);
+    }
+
+    if (distinct_fanins.size() == fanins.size())
+        return;
+
+    std::string merged_cover;
+    size_t line_start = 0;
+    while (line_start < cover.size()) {
+        size_t line_end = cover.find('\n', line_start);
+        std::string cube(distinct_fanins.size(), '-');
+        bool empty_cube = false;
+        for (size_t i = 0; i < fanins.size(); i++) {
+            char literal = cover[line_start + i];
+            char& merged = cube[column[i]];
+            if (literal == '-')
+                continue;
+            if (merged != '-' && merged != literal)
+                empty_cube = true; // x & !x
+            merged = literal;
+        }
+        if (!empty_cube)
+            merged_cover += cube + cover.substr(line_start + fanins.size(), line_end + 1 - (line_start + fanins.size()));
+        line_start = line_end + 1;
+    }
+
+    if (merged_cover.empty()) {
+        /* the function is constant 0 */
+        distinct_fanins.clear();
+        merged_cover = " 0\n";
+    }
+
+    fanins = distinct_fanins;
+    cover = merged_cover;
+}
+#endif
+
+/**
+ * ---------------------------------------------------------------------------------------------
+ * (function: output_logic_through_abc)
+ *
+ * @brief Prints the netlist nodes other than the logic nodes as usual, and hands the logic
+ * nodes to ABC as a logic network, which is optimized and mapped in-process by the ABC
+ * script of --abc_script and printed back, without writing and parsing an intermediate BLIF.
+ *
+ * The latches, clocks and hard blocks are left out of ABC: the signals they drive are
+ * primary inputs of the ABC network, and the signals they (or the top level outputs) read
+ * are primary outputs named after the signals, so the mapped logic connects back to them.
+ *
+ * @param out the output blif file
+ * @param netlist pointer to the netlist
+ * ---------------------------------------------------------------------------------------------
+ */
+void blif::writer::output_logic_through_abc(FILE* out, const netlist_t* netlist) {
+#ifndef ODIN_USE_ABC
+    (void)out;
+    (void)netlist;
+    error_message(NETLIST, unknown_location, "%s", "--abc_script requires Odin-II to be built with ODIN_USE_ABC\n");
+#else
+    /* print the other nodes, and collect the logic nodes */
+    std::vector<nnode_t*> logic_nodes;
+    abc_logic_nodes = &logic_nodes;
+    depth_first_traversal_to_output(OUTPUT_TRAVERSE_VALUE, out, netlist);
+    abc_logic_nodes = NULL;
+
+    std::unordered_set<const nnode_t*> is_abc_node(logic_nodes.begin(), logic_nodes.end());
+
+    Abc_Start();
+    Abc_Frame_t* abc_frame = Abc_FrameGetGlobalFrame();
+
+    Abc_Ntk_t* ntk = Abc_NtkAlloc(ABC_NTK_LOGIC, ABC_FUNC_SOP, 1);
+    ntk->pName = Abc_UtilStrsav(netlist->identifier);
+
+    /* the ABC object driving each signal */
+    std::unordered_map<std::string, Abc_Obj_t*> signal_objs;
+
+    std::vector<Abc_Obj_t*> node_objs;
+    for (nnode_t* node : logic_nodes) {
+        Abc_Obj_t* obj = Abc_NtkCreateNode(ntk);
+        signal_objs[output_pin_name(node)] = obj;
+        node_objs.push_back(obj);
+    }
+
+    /* signals not driven by a logic node are constants, or primary inputs */
+    auto signal_obj = [&](const std::string& name) {
+        auto it = signal_objs.find(name);
+        if (it != signal_objs.end())
+            return it->second;
+
+        Abc_Obj_t* obj;
+        if (name == GND_NAME || name == HBPAD_NAME) {
+            obj = Abc_NtkCreateNodeConst0(ntk);
+        } else if (name == VCC_NAME) {
+            obj = Abc_NtkCreateNodeConst1(ntk);
+        } else {
+            obj = Abc_NtkCreatePi(ntk);
+            Abc_ObjAssignName(obj, const_cast<char*>(name.c_str()), NULL);
+        }
+        signal_objs[name] = obj;
+        return obj;
+    };
+
+    for (size_t i = 0; i < logic_nodes.size(); i++) {
+        nnode_t* node = logic_nodes[i];
+
+        std::vector<std::string> fanins;
+        for (int j = 0; j < node->num_input_pins; j++) {
+            nnet_t* net = node->input_pins[j]->net;
+            fanins.push_back(warn_undriven(node, net) ? std::string(HBPAD_NAME) : net_driver_name(node, net, 0));
+        }
+        std::string cover = logic_node_cover(node);
+        merge_duplicate_fanins(fanins, cover);
+
+        for (const std::string& fanin : fanins) {
+            Abc_ObjAddFanin(node_objs[i], signal_obj(fanin));
+        }
+        node_objs[i]->pData = Abc_SopRegister((Mem_Flex_t*)ntk->pManFunc, cover.c_str());
+
+        /* the signal is a primary output if it is read outside of the logic */
+        bool read_outside = false;
+        for (int j = 0; j < node->num_output_pins && !read_outside; j++) {
+            nnet_t* net = node->output_pins[j]->net;
+            for (int k = 0; net && k < net->num_fanout_pins && !read_outside; k++) {
+                npin_t* fanout = net->fanout_pins[k];
+                read_outside = fanout && fanout->node && !is_abc_node.count(fanout->node);
+            }
+        }
+        if (read_outside) {
+            Abc_Obj_t* po = Abc_NtkCreatePo(ntk);
+            Abc_ObjAddFanin(po, node_objs[i]);
+            Abc_ObjAssignName(po, const_cast<char*>(output_pin_name(node).c_str()), NULL);
+        }
+    }
+
+    if (!Abc_NtkCheck(ntk)) {
+        error_message(NETLIST, unknown_location, "%s", "The logic network handed to ABC is not valid.\n");
+    }
+
+    printf("ABC: optimizing and mapping %ld logic nodes (%d inputs, %d outputs) with '%s'\n",
+           (long)logic_nodes.size(), Abc_NtkPiNum(ntk), Abc_NtkPoNum(ntk), global_args.abc_script.value().c_str());
+
+    Abc_FrameReplaceCurrentNetwork(abc_frame, ntk);
+    if (Cmd_CommandExecute(abc_frame, global_args.abc_script.value().c_str())) {
+        error_message(NETLIST, unknown_location, "ABC script '%s' failed.\n", global_args.abc_script.value().c_str());
+    }
+
+    Abc_Ntk_t* mapped = Abc_FrameReadNtk(abc_frame);
+    if (mapped && Abc_NtkIsStrash(mapped)) {
+        mapped = Abc_NtkToLogic(mapped);
+        Abc_FrameReplaceCurrentNetwork(abc_frame, mapped);
+    }
+    if (!mapped || !Abc_NtkIsLogic(mapped) || !Abc_NtkToSop(mapped, -1, ABC_INFINITY)) {
+        error_message(NETLIST, unknown_location, "ABC script '%s' did not leave a logic network.\n", global_args.abc_script.value().c_str());
+    }
+
+    /* name the nodes: after the signal of the first output they drive, or after ABC's name */
+    std::unordered_map<Abc_Obj_t*, std::string> node_names;
+    Abc_Obj_t* obj;
+    int i;
+    Abc_NtkForEachPo(mapped, obj, i) {
+        Abc_Obj_t* driver = Abc_ObjFanin0(obj);
+        if (Abc_ObjIsNode(driver) && !node_names.count(driver))
+            node_names[driver] = Abc_ObjName(obj);
+    }
+    Abc_NtkForEachPi(mapped, obj, i) {
+        node_names[obj] = Abc_ObjName(obj);
+    }
+    Abc_NtkForEachNode(mapped, obj, i) {
+        if (!node_names.count(obj))
+            node_names[obj] = std::string("abc^") + Abc_ObjName(obj);
+    }
+
+    /* print the mapped logic */
+    Abc_NtkForEachNode(mapped, obj, i) {
+        fprintf(out, ".names");
+        Abc_Obj_t* fanin;
+        int k;
+        Abc_ObjForEachFanin(obj, fanin, k) {
+            fprintf(out, " %s", node_names[fanin].c_str());
+        }
+        fprintf(out, " %s\n", node_names[obj].c_str());
+
+        if (Abc_ObjFaninNum(obj) == 0) {
+            if (Abc_NodeIsConst1(obj))
+                fprintf(out, "1\n");
+        } else {
+            fprintf(out, "%s", (char*)obj->pData);
+        }
+        fprintf(out, "\n");
+    }
+
+    /* connect the outputs not named after their driver */
+    Abc_NtkForEachPo(mapped, obj, i) {
+        Abc_Obj_t* driver = Abc_ObjFanin0(obj);
+        if (node_names[driver] != Abc_ObjName(obj)) {
+            fprintf(out, ".names %s %s\n1 1\n\n", node_names[driver].c_str(), Abc_ObjName(obj));
+        }
+    }
+
+    printf("ABC: mapped logic has %d nodes\n", Abc_NtkNodeNum(mapped));
+
+    Abc_Stop();
+#endif
+}
+
+/**
+ * ---------------------------------------------------------------------------------------------
+ * (function: is_abc_logic_node)
+ *
+ * @brief whether the node is handed to ABC by output_logic_through_abc: a logic node whose
+ * inputs each have at most one driver (the implicit buffers of multiply driven inputs are
+ * left to print_dot_names_header)
+ *
+ * @param node pointer to the netlist node
+ * ---------------------------------------------------------------------------------------------
+ */
+bool blif::writer::is_abc_logic_node(const nnode_t* node) {
+    if (!is_logic_node(node) || node->num_output_pins != 1)
+        return false;
+
+    for (int i = 0; i < node->num_input_pins; i++) {
+        if (node->input_pins[i]->net->num_driver_pins > 1)
+            return false;
+    }
+    return true;
+}
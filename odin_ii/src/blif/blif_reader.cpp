@@ -23,6 +23,7 @@
  * OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 #include <cstdio>
@@ -70,6 +71,8 @@ blif::reader::reader() {
     if (file == NULL) {
         error_message(PARSE_ARGS, my_location, "cannot open file: %s\n", configuration.list_of_file_names[my_location.file].c_str());
     }
+    /* the file is read a character at a time: read it from the disk in large blocks */
+    setvbuf(file, NULL, _IOFBF, READ_BLIF_BUFFER);
     line_count = 0;
     num_lines = count_blif_lines();
 
@@ -299,7 +302,7 @@ void blif::reader::create_hard_block_nodes(hard_block_models* models) {
     hash_table* mapping_index = associate_names(mappings, names, count);
 
     // Sort the mappings.
-    qsort(mappings, count, sizeof(char*), compare_hard_block_pin_names);
+    sort_hard_block_instance_pins(subcircuit_name, mappings, count);
 
     for (i = 0; i < count; i++)
         vtr::free(names_parameters[i]);
@@ -822,8 +825,8 @@ hard_block_model* blif::reader::read_hard_block_model(char* name_subckt, hard_bl
         }
 
         // Sort the names.
-        qsort(model->inputs->names, model->inputs->count, sizeof(char*), compare_hard_block_pin_names);
-        qsort(model->outputs->names, model->outputs->count, sizeof(char*), compare_hard_block_pin_names);
+        sort_hard_block_pin_names(model->inputs->names, model->inputs->count);
+        sort_hard_block_pin_names(model->outputs->names, model->outputs->count);
 
         // Index the names.
         model->inputs->index = index_names(model->inputs->names, model->inputs->count);
@@ -1497,35 +1500,94 @@ long blif::reader::get_hard_block_pin_number(char* original_name) {
 
 /**
  * ---------------------------------------------------------------------------------------------
- * (function: compare_hard_block_pin_names)
+ * (function: sort_hard_block_pin_order)
  *
- * @brief Callback function for qsort which compares pin names
- * of the form port_name[pin_number] primarily
- * on the port_name, and on the pin_number if the port_names
- * are identical.
+ * @brief Computes the order of pin names of the form
+ * port_name[pin_number], sorted primarily on the port_name,
+ * and on the pin_number if the port_names are identical.
+ * Each name is parsed once, rather than at every comparison.
  *
- * @param p1 pin name 1
- * @param p2 pin name 2
+ * @param names list of pin names
+ * @param count number of pin names
+ *
+ * @return the indices of names in sorted order
  * ---------------------------------------------------------------------------------------------
  */
-int blif::reader::compare_hard_block_pin_names(const void* p1, const void* p2) {
-    char* name1 = *(char* const*)p1;
-    char* name2 = *(char* const*)p2;
-
-    char* port_name1 = get_hard_block_port_name(name1);
-    char* port_name2 = get_hard_block_port_name(name2);
-    int portname_difference = strcmp(port_name1, port_name2);
-    vtr::free(port_name1);
-    vtr::free(port_name2);
-
-    // If the portnames are the same, compare the pin numbers.
-    if (!portname_difference) {
-        int n1 = get_hard_block_pin_number(name1);
-        int n2 = get_hard_block_pin_number(name2);
-        return n1 - n2;
-    } else {
-        return portname_difference;
+std::vector<int> blif::reader::sort_hard_block_pin_order(char** names, int count) {
+    std::vector<std::string> port_names(count);
+    std::vector<long> pin_numbers(count);
+    for (int i = 0; i < count; i++) {
+        const char* bracket = strchr(names[i], '[');
+        port_names[i] = bracket ? std::string(names[i], bracket - names[i]) : std::string(names[i]);
+        pin_numbers[i] = get_hard_block_pin_number(names[i]);
+    }
+
+    std::vector<int> order(count);
+    for (int i = 0; i < count; i++)
+        order[i] = i;
+
+    std::stable_sort(order.begin(), order.end(), [&](int i1, int i2) {
+        int portname_difference = port_names[i1].compare(port_names[i2]);
+        if (portname_difference)
+            return portname_difference < 0;
+        return pin_numbers[i1] < pin_numbers[i2];
+    });
+
+    return order;
+}
+
+/**
+ * ---------------------------------------------------------------------------------------------
+ * (function: sort_hard_block_pin_names)
+ *
+ * @brief Sorts pin names of the form port_name[pin_number]
+ * (see sort_hard_block_pin_order)
+ *
+ * @param names list of pin names
+ * @param count number of pin names
+ * ---------------------------------------------------------------------------------------------
+ */
+void blif::reader::sort_hard_block_pin_names(char** names, int count) {
+    std::vector<int> order = sort_hard_block_pin_order(names, count);
+
+    std::vector<char*> sorted_names(count);
+    for (int i = 0; i < count; i++)
+        sorted_names[i] = names[order[i]];
+
+    std::copy(sorted_names.begin(), sorted_names.end(), names);
+}
+
+/**
+ * ---------------------------------------------------------------------------------------------
+ * (function: sort_hard_block_instance_pins)
+ *
+ * @brief Sorts the pin names of a hard block instance like
+ * sort_hard_block_pin_names. The order is cached per subcircuit, and
+ * reused by the following instances of the subcircuit listing the
+ * same pins in the same order (i.e. most of them).
+ *
+ * @param subcircuit_name the name of the instance's subcircuit
+ * @param names list of pin names
+ * @param count number of pin names
+ * ---------------------------------------------------------------------------------------------
+ */
+void blif::reader::sort_hard_block_instance_pins(const char* subcircuit_name, char** names, int count) {
+    hard_block_pin_order& pin_order = instance_pin_orders[subcircuit_name];
+
+    bool same_pins = (int)pin_order.names.size() == count;
+    for (int i = 0; same_pins && i < count; i++)
+        same_pins = (pin_order.names[i] == names[i]);
+
+    if (!same_pins) {
+        pin_order.names.assign(names, names + count);
+        pin_order.sorted = sort_hard_block_pin_order(names, count);
     }
+
+    std::vector<char*> sorted_names(count);
+    for (int i = 0; i < count; i++)
+        sorted_names[i] = names[pin_order.sorted[i]];
+
+    std::copy(sorted_names.begin(), sorted_names.end(), names);
 }
 
 /**
@@ -103,17 +103,16 @@ bool blif::writer::warn_undriven(nnode_t* node, nnet_t* net) {
 
 /**
  * ---------------------------------------------------------------------------------------------
- * (function: print_net_driver)
+ * (function: net_driver_name)
  * 
- * @brief The function that prints the driver of a given net
+ * @brief The function that returns the name of the driver of a given net
  *
- * @param out the output blif file
  * @param node pointer to the netlist node
  * @param net pointer to the net
  * @param driver_idx index of the driver pin
  *---------------------------------------------------------------------------------------------
  */
-void blif::writer::print_net_driver(FILE* out, nnode_t* node, nnet_t* net, long driver_idx) {
+std::string blif::writer::net_driver_name(nnode_t* node, nnet_t* net, long driver_idx) {
     oassert(driver_idx < net->num_driver_pins);
     npin_t* driver = net->driver_pins[driver_idx];
     if (!driver->node) {
@@ -122,21 +121,37 @@ void blif::writer::print_net_driver(FILE* out, nnode_t* node, nnet_t* net, long
                         "Net %s driving node %s is itself undriven.",
                         net->name, node->name);
 
-        fprintf(out, " %s", "unconn");
+        return "unconn";
     } else if (global_args.high_level_block.provenance() == argparse::Provenance::SPECIFIED
                && driver->node->related_ast_node != NULL) {
-        fprintf(out, " %s^^%i-%i",
-                driver->node->name,
-                driver->node->related_ast_node->far_tag,
-                driver->node->related_ast_node->high_number);
+        return vtr::string_fmt("%s^^%i-%i",
+                               driver->node->name,
+                               driver->node->related_ast_node->far_tag,
+                               driver->node->related_ast_node->high_number);
     } else {
         if (driver->name != NULL && ((driver->node->type == MULTIPLY) || (driver->node->type == HARD_IP) || (driver->node->type == MEMORY) || (driver->node->type == ADD) || (driver->node->type == MINUS))) {
-            fprintf(out, " %s", driver->name);
+            return driver->name;
         } else {
-            fprintf(out, " %s", driver->node->name);
+            return driver->node->name;
         }
     }
 }
+
+/**
+ * ---------------------------------------------------------------------------------------------
+ * (function: print_net_driver)
+ * 
+ * @brief The function that prints the driver of a given net
+ *
+ * @param out the output blif file
+ * @param node pointer to the netlist node
+ * @param net pointer to the net
+ * @param driver_idx index of the driver pin
+ *---------------------------------------------------------------------------------------------
+ */
+void blif::writer::print_net_driver(FILE* out, nnode_t* node, nnet_t* net, long driver_idx) {
+    fprintf(out, " %s", net_driver_name(node, net, driver_idx).c_str());
+}
 /**
  * ---------------------------------------------------------------------------------------------
  * (function: print_input_single_driver)
@@ -158,6 +173,25 @@ void blif::writer::print_input_single_driver(FILE* out, nnode_t* node, long pin_
         print_net_driver(out, node, net, 0);
     }
 }
+/**
+ * ---------------------------------------------------------------------------------------------
+ * (function: output_pin_name)
+ * 
+ * @brief The function that returns the name of the output pin of a given node
+ *
+ * @param node pointer to the netlist node
+ *---------------------------------------------------------------------------------------------
+ */
+std::string blif::writer::output_pin_name(nnode_t* node) {
+    if (node->related_ast_node != NULL
+        && global_args.high_level_block.provenance() == argparse::Provenance::SPECIFIED)
+        return vtr::string_fmt("%s^^%i-%i",
+                               node->name,
+                               node->related_ast_node->far_tag,
+                               node->related_ast_node->high_number);
+    else
+        return node->name;
+}
 /**
  * ---------------------------------------------------------------------------------------------
  * (function: print_output_pin)
@@ -170,14 +204,7 @@ void blif::writer::print_input_single_driver(FILE* out, nnode_t* node, long pin_
  */
 void blif::writer::print_output_pin(FILE* out, nnode_t* node) {
     /* now print the output */
-    if (node->related_ast_node != NULL
-        && global_args.high_level_block.provenance() == argparse::Provenance::SPECIFIED)
-        fprintf(out, " %s^^%i-%i",
-                node->name,
-                node->related_ast_node->far_tag,
-                node->related_ast_node->high_number);
-    else
-        fprintf(out, " %s", node->name);
+    fprintf(out, " %s", output_pin_name(node).c_str());
 }
 /**
  * ---------------------------------------------------------------------------------------------
@@ -302,7 +329,11 @@ void blif::writer::output_blif(FILE* out, const netlist_t* netlist) {
 
     /* traverse the internals of the flat net-list */
     if (configuration.output_file_type == file_type_e::BLIF) {
-        depth_first_traversal_to_output(OUTPUT_TRAVERSE_VALUE, out, netlist);
+        if (global_args.abc_script.provenance() == argparse::Provenance::SPECIFIED) {
+            output_logic_through_abc(out, netlist);
+        } else {
+            depth_first_traversal_to_output(OUTPUT_TRAVERSE_VALUE, out, netlist);
+        }
     } else {
         error_message(NETLIST, unknown_location, "%s", "Invalid output file type.");
     }
@@ -430,29 +461,23 @@ void blif::writer::depth_traverse_output_blif(nnode_t* node, uintptr_t traverse_
  * ---------------------------------------------------------------------------------------------
  */
 void blif::writer::output_node(nnode_t* node, short /*traverse_number*/, FILE* fp) {
+    if (abc_logic_nodes && is_abc_logic_node(node)) {
+        /* optimized and mapped by ABC (see output_logic_through_abc) */
+        abc_logic_nodes->push_back(node);
+        return;
+    }
+
     switch (node->type) {
         case GT:
-            define_set_input_logical_function(node, "100 1\n", fp);
-            oassert(node->num_input_pins == 3);
-            oassert(node->input_pins[2] != NULL);
-            break;
         case LT:
-            define_set_input_logical_function(node, "010 1\n", fp); // last input decides if this
             oassert(node->num_input_pins == 3);
             oassert(node->input_pins[2] != NULL);
+            define_logic_node(node, fp);
             break;
         case ADDER_FUNC:
-            define_set_input_logical_function(node, "001 1\n010 1\n100 1\n111 1\n", fp);
-            break;
         case CARRY_FUNC:
-            define_set_input_logical_function(node, "011 1\n101 1\n110 1\n111 1\n", fp);
-            break;
         case BITWISE_NOT:
-            define_set_input_logical_function(node, "0 1\n", fp);
-            break;
         case BUF_NODE:
-            define_set_input_logical_function(node, "1 1\n", fp);
-            break;
         case LOGICAL_AND:
         case LOGICAL_OR:
         case LOGICAL_XOR:
@@ -462,15 +487,9 @@ void blif::writer::output_node(nnode_t* node, short /*traverse_number*/, FILE* f
         case LOGICAL_EQUAL:
         case NOT_EQUAL:
         case LOGICAL_NOT:
-            define_logical_function(node, fp);
-            break;
-
         case MUX_2:
-            define_decoded_mux(node, fp);
-            break;
-
         case SMUX_2:
-            define_set_input_logical_function(node, "01- 1\n1-1 1\n", fp);
+            define_logic_node(node, fp);
             break;
 
         case FF_NODE:
@@ -533,28 +552,93 @@ void blif::writer::output_node(nnode_t* node, short /*traverse_number*/, FILE* f
 
 /**
  * ---------------------------------------------------------------------------------------------
- * (function: define_logical_function)
+ * (function: is_logic_node)
  * 
- * @brief print out the bit map of a logical function
+ * @brief whether the node is a logic function printed as a .names (see logic_node_cover)
  *
  * @param node pointer to the netlist node
- * @param out the output blif file
  * ---------------------------------------------------------------------------------------------
  */
-void blif::writer::define_logical_function(nnode_t* node, FILE* out) {
+bool blif::writer::is_logic_node(const nnode_t* node) {
+    switch (node->type) {
+        case GT:
+        case LT:
+        case ADDER_FUNC:
+        case CARRY_FUNC:
+        case BITWISE_NOT:
+        case BUF_NODE:
+        case LOGICAL_AND:
+        case LOGICAL_OR:
+        case LOGICAL_XOR:
+        case LOGICAL_XNOR:
+        case LOGICAL_NAND:
+        case LOGICAL_NOR:
+        case LOGICAL_EQUAL:
+        case NOT_EQUAL:
+        case LOGICAL_NOT:
+        case MUX_2:
+        case SMUX_2:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * ---------------------------------------------------------------------------------------------
+ * (function: logic_node_cover)
+ * 
+ * @brief returns the bit map of a logic node
+ *
+ * @param node pointer to the netlist node
+ * ---------------------------------------------------------------------------------------------
+ */
+std::string blif::writer::logic_node_cover(nnode_t* node) {
+    switch (node->type) {
+        case GT:
+            return "100 1\n";
+        case LT:
+            return "010 1\n"; // last input decides if this
+        case ADDER_FUNC:
+            return "001 1\n010 1\n100 1\n111 1\n";
+        case CARRY_FUNC:
+            return "011 1\n101 1\n110 1\n111 1\n";
+        case BITWISE_NOT:
+            return "0 1\n";
+        case BUF_NODE:
+            return "1 1\n";
+        case SMUX_2:
+            return "01- 1\n1-1 1\n";
+        case MUX_2:
+            return decoded_mux_cover(node);
+        default:
+            return logical_function_cover(node);
+    }
+}
+
+/**
+ * ---------------------------------------------------------------------------------------------
+ * (function: logical_function_cover)
+ * 
+ * @brief returns the bit map of a logical function
+ *
+ * @param node pointer to the netlist node
+ * ---------------------------------------------------------------------------------------------
+ */
+std::string blif::writer::logical_function_cover(nnode_t* node) {
     int i, j;
     char* temp_string;
 
-    print_dot_names_header(out, node);
+    std::string cover;
 
-    /* print out the blif definition of this gate */
+    /* the blif definition of this gate */
     switch (node->type) {
         case LOGICAL_AND: {
             /* generates: 111111 1 */
             for (i = 0; i < node->num_input_pins; i++) {
-                fprintf(out, "1");
+                cover += "1";
             }
-            fprintf(out, " 1\n");
+            cover += " 1\n";
             break;
         }
         case LOGICAL_OR: {
@@ -562,11 +646,11 @@ void blif::writer::define_logical_function(nnode_t* node, FILE* out) {
             for (i = 0; i < node->num_input_pins; i++) {
                 for (j = 0; j < node->num_input_pins; j++) {
                     if (i == j)
-                        fprintf(out, "1");
+                        cover += "1";
                     else
-                        fprintf(out, "-");
+                        cover += "-";
                 }
-                fprintf(out, " 1\n");
+                cover += " 1\n";
             }
             break;
         }
@@ -575,11 +659,11 @@ void blif::writer::define_logical_function(nnode_t* node, FILE* out) {
             for (i = 0; i < node->num_input_pins; i++) {
                 for (j = 0; j < node->num_input_pins; j++) {
                     if (i == j)
-                        fprintf(out, "0");
+                        cover += "0";
                     else
-                        fprintf(out, "-");
+                        cover += "-";
                 }
-                fprintf(out, " 1\n");
+                cover += " 1\n";
             }
             break;
         }
@@ -587,9 +671,9 @@ void blif::writer::define_logical_function(nnode_t* node, FILE* out) {
         case LOGICAL_NOR: {
             /* generates: 0000000 1 */
             for (i = 0; i < node->num_input_pins; i++) {
-                fprintf(out, "0");
+                cover += "0";
             }
-            fprintf(out, " 1\n");
+            cover += " 1\n";
             break;
         }
         case LOGICAL_EQUAL:
@@ -599,9 +683,9 @@ void blif::writer::define_logical_function(nnode_t* node, FILE* out) {
             for (i = 0; i < my_power(2, node->num_input_pins); i++) {
                 if ((i % 8 == 1) || (i % 8 == 2) || (i % 8 == 4) || (i % 8 == 7)) {
                     temp_string = convert_long_to_bit_string(i, node->num_input_pins);
-                    fprintf(out, "%s", temp_string);
+                    cover += temp_string;
                     vtr::free(temp_string);
-                    fprintf(out, " 1\n");
+                    cover += " 1\n";
                 }
             }
             break;
@@ -612,9 +696,9 @@ void blif::writer::define_logical_function(nnode_t* node, FILE* out) {
             for (i = 0; i < my_power(2, node->num_input_pins); i++) {
                 if ((i % 8 == 0) || (i % 8 == 3) || (i % 8 == 5) || (i % 8 == 6)) {
                     temp_string = convert_long_to_bit_string(i, node->num_input_pins);
-                    fprintf(out, "%s", temp_string);
+                    cover += temp_string;
                     vtr::free(temp_string);
-                    fprintf(out, " 1\n");
+                    cover += " 1\n";
                 }
             }
             break;
@@ -624,29 +708,26 @@ void blif::writer::define_logical_function(nnode_t* node, FILE* out) {
             break;
     }
 
-    fprintf(out, "\n");
+    return cover;
 }
 
 /** 
  * ---------------------------------------------------------------------------------------------
- * (function: define_set_input_logical_function)
+ * (function: define_logic_node)
  *
- * @brief print out the given bit map
+ * @brief print out the .names of a logic node
  *
  * @param node pointer to the netlist node
- * @param bit_output given bit map
  * @param out the output blif file
  * ---------------------------------------------------------------------------------------------
  */
-void blif::writer::define_set_input_logical_function(nnode_t* node, const char* bit_output, FILE* out) {
+void blif::writer::define_logic_node(nnode_t* node, FILE* out) {
     oassert(node->num_input_pins >= 1);
 
     print_dot_names_header(out, node);
 
     /* print out the blif definition of this gate */
-    if (bit_output != NULL) {
-        fprintf(out, "%s", bit_output);
-    }
+    fprintf(out, "%s", logic_node_cover(node).c_str());
     fprintf(out, "\n");
 }
 
@@ -714,32 +795,32 @@ void blif::writer::define_ff(nnode_t* node, FILE* out) {
 
 /**
  * ---------------------------------------------------------------------------------------------
- * (function: define_decoded_mux)
+ * (function: decoded_mux_cover)
  * 
- * @brief print out the decoded mux node record
+ * @brief returns the bit map of a decoded mux node
  *
  * @param node pointer to the netlist node
- * @param out the output blif file
  * ---------------------------------------------------------------------------------------------
  */
-void blif::writer::define_decoded_mux(nnode_t* node, FILE* out) {
+std::string blif::writer::decoded_mux_cover(nnode_t* node) {
     oassert(node->input_port_sizes[0] == node->input_port_sizes[1]);
-    print_dot_names_header(out, node);
+
+    std::string cover;
 
     /* generates: 1----- 1\n-1----- 1\n ... */
     for (long i = 0; i < node->input_port_sizes[0]; i++) {
         for (long j = 0; j < node->num_input_pins; j++) {
             if (i == j)
-                fprintf(out, "1");
+                cover += "1";
             else if (i + node->input_port_sizes[0] == j)
-                fprintf(out, "1");
+                cover += "1";
             else if (i > node->input_port_sizes[0])
-                fprintf(out, "0");
+                cover += "0";
             else
-                fprintf(out, "-");
+                cover += "-";
         }
-        fprintf(out, " 1\n");
+        cover += " 1\n";
     }
 
-    fprintf(out, "\n");
+    return cover;
 }
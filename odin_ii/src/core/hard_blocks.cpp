@@ -25,6 +25,8 @@
 
 #include <cstdio>
 #include <cstring>
+#include <string>
+#include <unordered_map>
 
 #include "odin_types.h"
 #include "odin_util.h"
@@ -35,7 +37,11 @@
 
 STRING_CACHE* hard_block_names = NULL;
 
+/* the input and output ports of each hard block model by name, filled on first lookup */
+static std::unordered_map<const t_model*, std::unordered_map<std::string, t_model_ports*>> hard_block_ports;
+
 void cache_hard_block_names();
+static t_model_ports* find_hard_block_port(t_model* hb, const char* pname);
 void register_hb_port_size(t_model_ports* hb_ports, int size);
 
 void register_hb_port_size(t_model_ports* hb_ports, int size) {
@@ -61,7 +67,9 @@ void cache_hard_block_names() {
     hard_block_names = sc_new_string_cache();
     while (hard_blocks) {
         int sc_spot = sc_add_string(hard_block_names, hard_blocks->name);
-        hard_block_names->data[sc_spot] = (void*)hard_blocks;
+        /* keep the first model of a name, as the list lookup would */
+        if (hard_block_names->data[sc_spot] == NULL)
+            hard_block_names->data[sc_spot] = (void*)hard_blocks;
         hard_blocks = hard_blocks->next;
     }
 }
@@ -107,13 +115,20 @@ void register_hard_blocks() {
 }
 
 void deregister_hard_blocks() {
-    sc_free_string_cache(hard_block_names);
+    hard_block_names = sc_free_string_cache(hard_block_names);
+    hard_block_ports.clear();
     return;
 }
 
 t_model* find_hard_block(const char* name) {
     t_model* hard_blocks;
 
+    /* once the hard blocks are registered, look them up by name */
+    if (hard_block_names) {
+        long sc_spot = sc_lookup_string(hard_block_names, name);
+        return (sc_spot == -1) ? NULL : (t_model*)hard_block_names->data[sc_spot];
+    }
+
     hard_blocks = Arch.models;
     while (hard_blocks)
         if (!strcmp(hard_blocks->name, name))
@@ -287,6 +302,28 @@ void instantiate_hard_block(nnode_t* node, short mark, netlist_t* /*netlist*/) {
     return;
 }
 
+/*
+ * Returns the input or output port of the hard block model with the given
+ * name, or NULL if it has none. The ports of each model are indexed on its
+ * first lookup, since every instance of a hard block looks up all of them.
+ */
+static t_model_ports* find_hard_block_port(t_model* hb, const char* pname) {
+    auto model_ports = hard_block_ports.find(hb);
+    if (model_ports == hard_block_ports.end()) {
+        model_ports = hard_block_ports.emplace(hb, std::unordered_map<std::string, t_model_ports*>()).first;
+        for (t_model_ports* ports : {hb->inputs, hb->outputs}) {
+            for (t_model_ports* tmp = ports; tmp != NULL; tmp = tmp->next) {
+                /* keep the first port of a name, inputs before outputs */
+                if (tmp->name != NULL)
+                    model_ports->second.emplace(tmp->name, tmp);
+            }
+        }
+    }
+
+    auto port = model_ports->second.find(pname);
+    return (port == model_ports->second.end()) ? NULL : port->second;
+}
+
 int hard_block_port_size(t_model* hb, char* pname) {
     t_model_ports* tmp;
 
@@ -301,21 +338,9 @@ int hard_block_port_size(t_model* hb, char* pname) {
         return -1;
     }
 
-    tmp = hb->inputs;
-    while (tmp != NULL)
-        if ((tmp->name != NULL) && (strcmp(tmp->name, pname) == 0))
-            return tmp->size;
-        else
-            tmp = tmp->next;
-
-    tmp = hb->outputs;
-    while (tmp != NULL)
-        if ((tmp->name != NULL) && (strcmp(tmp->name, pname) == 0))
-            return tmp->size;
-        else
-            tmp = tmp->next;
+    tmp = find_hard_block_port(hb, pname);
 
-    return 0;
+    return (tmp != NULL) ? tmp->size : 0;
 }
 
 enum PORTS
@@ -325,19 +350,7 @@ hard_block_port_direction(t_model* hb, char* pname) {
     if (hb == NULL)
         return ERR_PORT;
 
-    tmp = hb->inputs;
-    while (tmp != NULL)
-        if ((tmp->name != NULL) && (strcmp(tmp->name, pname) == 0))
-            return tmp->dir;
-        else
-            tmp = tmp->next;
-
-    tmp = hb->outputs;
-    while (tmp != NULL)
-        if ((tmp->name != NULL) && (strcmp(tmp->name, pname) == 0))
-            return tmp->dir;
-        else
-            tmp = tmp->next;
+    tmp = find_hard_block_port(hb, pname);
 
-    return ERR_PORT;
+    return (tmp != NULL) ? tmp->dir : ERR_PORT;
 }
@@ -25,6 +25,9 @@
 
 #include <cstring>
 #include <cmath>
+#include <algorithm>
+#include <map>
+#include <vector>
 
 #include "odin_globals.h"
 #include "odin_types.h"
@@ -49,6 +52,23 @@ t_linked_vptr* dp_memory_list;
 t_linked_vptr* split_list;
 t_linked_vptr* memory_port_size_list = NULL;
 
+/*
+ * The pin layout of one of the memories of a width split: the size of each
+ * of its ports, and for each of its pins the index of the pin of the
+ * original memory it takes, copied or moved over.
+ */
+struct memory_width_split_part_t {
+    std::vector<int> input_port_sizes;
+    std::vector<int> input_sources;
+    std::vector<bool> input_copied;
+    std::vector<int> output_port_sizes;
+    std::vector<int> output_sources;
+};
+typedef std::vector<memory_width_split_part_t> memory_width_split_t;
+
+/* width splits by memory model and shape (see get_memory_width_split) */
+static std::map<std::pair<t_model*, std::vector<int>>, memory_width_split_t> memory_width_splits;
+
 void copy_input_port_to_memory(nnode_t* node, signal_list_t* signals, const char* port_name);
 void copy_output_port_to_memory(nnode_t* node, signal_list_t* signals, const char* port_name);
 void pad_dp_memory_width(nnode_t* node, netlist_t* netlist);
@@ -605,6 +625,130 @@ void split_dp_memory_depth(nnode_t* node, int split_size) {
     split_dp_memory_depth(new_mem_node2, split_size);
 }
 
+/*
+ * Builds the pin layout of the width split of a memory with the given port
+ * sizes into memories of at most target_size data bits. The input ports in
+ * split_input_ports and every output port are divided between the memories,
+ * the other input ports are copied to all but the last memory, which takes
+ * the original pins.
+ */
+static memory_width_split_t build_memory_width_split(const std::vector<int>& input_port_sizes, const std::vector<int>& output_port_sizes, const std::vector<bool>& split_input_ports, int target_size) {
+    int data_port_size = -1;
+    for (size_t j = 0; j < input_port_sizes.size(); j++) {
+        if (split_input_ports[j]) {
+            oassert(data_port_size == -1 || data_port_size == input_port_sizes[j]);
+            data_port_size = input_port_sizes[j];
+        }
+    }
+    for (size_t j = 0; j < output_port_sizes.size(); j++)
+        oassert(output_port_sizes[j] == data_port_size);
+
+    int num_memories = ceil((double)data_port_size / (double)target_size);
+
+    memory_width_split_t split(num_memories);
+    for (int i = 0; i < num_memories; i++) {
+        memory_width_split_part_t& part = split[i];
+        int first_data_pin = i * target_size;
+        int num_data_pins = std::min(target_size, data_port_size - first_data_pin);
+
+        int old_index = 0;
+        for (size_t j = 0; j < input_port_sizes.size(); j++) {
+            if (split_input_ports[j]) {
+                // This memory's share of the data pins is moved over.
+                part.input_port_sizes.push_back(num_data_pins);
+                for (int k = 0; k < num_data_pins; k++) {
+                    part.input_sources.push_back(old_index + first_data_pin + k);
+                    part.input_copied.push_back(false);
+                }
+            } else {
+                // Copy pins for all but the last memory. the last one get the original pins moved to it.
+                part.input_port_sizes.push_back(input_port_sizes[j]);
+                for (int k = 0; k < input_port_sizes[j]; k++) {
+                    part.input_sources.push_back(old_index + k);
+                    part.input_copied.push_back(i < num_memories - 1);
+                }
+            }
+            old_index += input_port_sizes[j];
+        }
+
+        old_index = 0;
+        for (size_t j = 0; j < output_port_sizes.size(); j++) {
+            part.output_port_sizes.push_back(num_data_pins);
+            for (int k = 0; k < num_data_pins; k++)
+                part.output_sources.push_back(old_index + first_data_pin + k);
+            old_index += output_port_sizes[j];
+        }
+    }
+
+    return split;
+}
+
+/*
+ * Returns the width split of the given memory, built once per memory model,
+ * port shape and target size and shared by every memory of that shape.
+ */
+static const memory_width_split_t& get_memory_width_split(nnode_t* node, t_model* model, const std::vector<bool>& split_input_ports, int target_size) {
+    std::vector<int> input_port_sizes(node->input_port_sizes, node->input_port_sizes + node->num_input_port_sizes);
+    std::vector<int> output_port_sizes(node->output_port_sizes, node->output_port_sizes + node->num_output_port_sizes);
+
+    std::vector<int> shape;
+    shape.push_back(target_size);
+    for (size_t j = 0; j < input_port_sizes.size(); j++)
+        shape.push_back(split_input_ports[j] ? -input_port_sizes[j] - 1 : input_port_sizes[j]);
+    shape.push_back(-1);
+    shape.insert(shape.end(), output_port_sizes.begin(), output_port_sizes.end());
+
+    auto key = std::make_pair(model, shape);
+    auto found = memory_width_splits.find(key);
+    if (found == memory_width_splits.end())
+        found = memory_width_splits.emplace(key, build_memory_width_split(input_port_sizes, output_port_sizes, split_input_ports, target_size)).first;
+
+    return found->second;
+}
+
+/*
+ * Replaces the given memory by the memories of its width split,
+ * adding them to memory_list.
+ */
+static void stamp_memory_width_split(nnode_t* node, const memory_width_split_t& split, t_linked_vptr** memory_list) {
+    for (int i = 0; i < (int)split.size(); i++) {
+        const memory_width_split_part_t& part = split[i];
+
+        nnode_t* new_node = allocate_nnode(node->loc);
+        new_node->name = append_string(node->name, "-%d", i);
+        *memory_list = insert_in_vptr_list(*memory_list, new_node);
+
+        /* Copy properties from the original node */
+        new_node->type = node->type;
+        new_node->related_ast_node = node->related_ast_node;
+        new_node->traverse_visited = node->traverse_visited;
+        new_node->node_data = NULL;
+
+        for (size_t j = 0; j < part.input_port_sizes.size(); j++)
+            add_input_port_information(new_node, part.input_port_sizes[j]);
+        if (!part.input_sources.empty())
+            allocate_more_input_pins(new_node, part.input_sources.size());
+
+        for (size_t index = 0; index < part.input_sources.size(); index++) {
+            npin_t* pin = node->input_pins[part.input_sources[index]];
+            if (part.input_copied[index])
+                add_input_pin_to_node(new_node, copy_input_npin(pin), index);
+            else
+                remap_pin_to_new_node(pin, new_node, index);
+        }
+
+        for (size_t j = 0; j < part.output_port_sizes.size(); j++)
+            add_output_port_information(new_node, part.output_port_sizes[j]);
+        if (!part.output_sources.empty())
+            allocate_more_output_pins(new_node, part.output_sources.size());
+
+        for (size_t index = 0; index < part.output_sources.size(); index++)
+            remap_pin_to_new_node(node->output_pins[part.output_sources[index]], new_node, index);
+    }
+    // Free the original node.
+    free_nnode(node);
+}
+
 /*
  * Width-splits the given memory up into chunks the of the
  * width specified in the arch file.
@@ -614,86 +758,18 @@ void split_sp_memory_width(nnode_t* node, int target_size) {
     int data_port_number = get_input_port_index_from_mapping(node, port_name);
 
     oassert(data_port_number != -1);
+    oassert(node->num_output_port_sizes == 1);
 
     int data_port_size = node->input_port_sizes[data_port_number];
 
-    int num_memories = ceil((double)data_port_size / (double)target_size);
-
     if (data_port_size <= target_size) {
         // If we don't need to split, put the original node back.
         sp_memory_list = insert_in_vptr_list(sp_memory_list, node);
     } else {
-        int i;
-        int data_pins_moved = 0;
-        int output_pins_moved = 0;
-        for (i = 0; i < num_memories; i++) {
-            nnode_t* new_node = allocate_nnode(node->loc);
-            new_node->name = append_string(node->name, "-%d", i);
-            sp_memory_list = insert_in_vptr_list(sp_memory_list, new_node);
-
-            /* Copy properties from the original node */
-            new_node->type = node->type;
-            new_node->related_ast_node = node->related_ast_node;
-            new_node->traverse_visited = node->traverse_visited;
-            new_node->node_data = NULL;
-
-            int j;
-            for (j = 0; j < node->num_input_port_sizes; j++)
-                add_input_port_information(new_node, 0);
-
-            add_output_port_information(new_node, 0);
-
-            int index = 0;
-            int old_index = 0;
-            for (j = 0; j < node->num_input_port_sizes; j++) {
-                // Move this node's share of data pins out of the data port of the original node.
-                if (j == data_port_number) {
-                    // Skip over data pins we've already moved.
-                    old_index += data_pins_moved;
-                    int k;
-                    for (k = 0; k < target_size && data_pins_moved < data_port_size; k++) {
-                        allocate_more_input_pins(new_node, 1);
-                        new_node->input_port_sizes[j]++;
-                        remap_pin_to_new_node(node->input_pins[old_index], new_node, index);
-                        index++;
-                        old_index++;
-                        data_pins_moved++;
-                    }
-                    int remaining_data_pins = data_port_size - data_pins_moved;
-                    // Skip over pins we have yet to copy.
-                    old_index += remaining_data_pins;
-                } else {
-                    int k;
-                    for (k = 0; k < node->input_port_sizes[j]; k++) {
-                        allocate_more_input_pins(new_node, 1);
-                        new_node->input_port_sizes[j]++;
-                        // Copy pins for all but the last memory. the last one get the original pins moved to it.
-                        if (i < num_memories - 1)
-                            add_input_pin_to_node(new_node, copy_input_npin(node->input_pins[old_index]), index);
-                        else
-                            remap_pin_to_new_node(node->input_pins[old_index], new_node, index);
-                        index++;
-                        old_index++;
-                    }
-                }
-            }
+        std::vector<bool> split_input_ports(node->num_input_port_sizes, false);
+        split_input_ports[data_port_number] = true;
 
-            index = 0;
-            old_index = 0;
-            old_index += output_pins_moved;
-
-            int k;
-            for (k = 0; k < target_size && output_pins_moved < data_port_size; k++) {
-                allocate_more_output_pins(new_node, 1);
-                new_node->output_port_sizes[0]++;
-                remap_pin_to_new_node(node->output_pins[old_index], new_node, index);
-                index++;
-                old_index++;
-                output_pins_moved++;
-            }
-        }
-        // Free the original node.
-        free_nnode(node);
+        stamp_memory_width_split(node, get_memory_width_split(node, single_port_rams, split_input_ports, target_size), &sp_memory_list);
     }
 }
 
@@ -717,6 +793,7 @@ void split_dp_memory_width(nnode_t* node, int target_size) {
     oassert(data2_port_number != -1);
     oassert(out1_port_number != -1);
     oassert(out2_port_number != -1);
+    oassert(node->num_output_port_sizes == 2);
 
     int data1_port_size = node->input_port_sizes[data1_port_number];
     int data2_port_size = node->input_port_sizes[data2_port_number];
@@ -728,126 +805,15 @@ void split_dp_memory_width(nnode_t* node, int target_size) {
     oassert(out1_port_size == out2_port_size);
     oassert(data1_port_size == out1_port_size);
 
-    int num_memories = ceil((double)data1_port_size / (double)target_size);
-
     if (data1_port_size <= target_size) {
         // If we're not splitting, put the original memory node back.
         dp_memory_list = insert_in_vptr_list(dp_memory_list, node);
     } else {
-        int i;
-        int data1_pins_moved = 0;
-        int data2_pins_moved = 0;
-        int out1_pins_moved = 0;
-        int out2_pins_moved = 0;
-        for (i = 0; i < num_memories; i++) {
-            nnode_t* new_node = allocate_nnode(node->loc);
-            new_node->name = append_string(node->name, "-%d", i);
-            dp_memory_list = insert_in_vptr_list(dp_memory_list, new_node);
-
-            /* Copy properties from the original node */
-            new_node->type = node->type;
-            new_node->related_ast_node = node->related_ast_node;
-            new_node->traverse_visited = node->traverse_visited;
-            new_node->node_data = NULL;
-
-            int j;
-            for (j = 0; j < node->num_input_port_sizes; j++)
-                add_input_port_information(new_node, 0);
-
-            int index = 0;
-            int old_index = 0;
-            for (j = 0; j < node->num_input_port_sizes; j++) {
-                // Move this node's share of data pins out of the data port of the original node.
-                if (j == data1_port_number) {
-                    // Skip over data pins we've already moved.
-                    old_index += data1_pins_moved;
-                    int k;
-                    for (k = 0; k < target_size && data1_pins_moved < data1_port_size; k++) {
-                        allocate_more_input_pins(new_node, 1);
-                        new_node->input_port_sizes[j]++;
-                        remap_pin_to_new_node(node->input_pins[old_index], new_node, index);
-                        index++;
-                        old_index++;
-                        data1_pins_moved++;
-                    }
-                    int remaining_data_pins = data1_port_size - data1_pins_moved;
-                    // Skip over pins we have yet to copy.
-                    old_index += remaining_data_pins;
-                } else if (j == data2_port_number) {
-                    // Skip over data pins we've already moved.
-                    old_index += data2_pins_moved;
-                    int k;
-                    for (k = 0; k < target_size && data2_pins_moved < data2_port_size; k++) {
-                        allocate_more_input_pins(new_node, 1);
-                        new_node->input_port_sizes[j]++;
-                        remap_pin_to_new_node(node->input_pins[old_index], new_node, index);
-                        index++;
-                        old_index++;
-                        data2_pins_moved++;
-                    }
-                    int remaining_data_pins = data2_port_size - data2_pins_moved;
-                    // Skip over pins we have yet to copy.
-                    old_index += remaining_data_pins;
-                } else {
-                    int k;
-                    for (k = 0; k < node->input_port_sizes[j]; k++) {
-                        allocate_more_input_pins(new_node, 1);
-                        new_node->input_port_sizes[j]++;
-                        // Copy pins for all but the last memory. the last one get the original pins moved to it.
-                        if (i < num_memories - 1)
-                            add_input_pin_to_node(new_node, copy_input_npin(node->input_pins[old_index]), index);
-                        else
-                            remap_pin_to_new_node(node->input_pins[old_index], new_node, index);
-                        index++;
-                        old_index++;
-                    }
-                }
-            }
+        std::vector<bool> split_input_ports(node->num_input_port_sizes, false);
+        split_input_ports[data1_port_number] = true;
+        split_input_ports[data2_port_number] = true;
 
-            for (j = 0; j < node->num_output_port_sizes; j++)
-                add_output_port_information(new_node, 0);
-
-            index = 0;
-            old_index = 0;
-            for (j = 0; j < node->num_output_port_sizes; j++) {
-                // Move this node's share of data pins out of the data port of the original node.
-                if (j == out1_port_number) {
-                    // Skip over data pins we've already moved.
-                    old_index += out1_pins_moved;
-                    int k;
-                    for (k = 0; k < target_size && out1_pins_moved < out1_port_size; k++) {
-                        allocate_more_output_pins(new_node, 1);
-                        new_node->output_port_sizes[j]++;
-                        remap_pin_to_new_node(node->output_pins[old_index], new_node, index);
-                        index++;
-                        old_index++;
-                        out1_pins_moved++;
-                    }
-                    int remaining_pins = out1_port_size - out1_pins_moved;
-                    // Skip over pins we have yet to copy.
-                    old_index += remaining_pins;
-                } else if (j == out2_port_number) {
-                    // Skip over data pins we've already moved.
-                    old_index += out2_pins_moved;
-                    int k;
-                    for (k = 0; k < target_size && out2_pins_moved < out2_port_size; k++) {
-                        allocate_more_output_pins(new_node, 1);
-                        new_node->output_port_sizes[j]++;
-                        remap_pin_to_new_node(node->output_pins[old_index], new_node, index);
-                        index++;
-                        old_index++;
-                        out2_pins_moved++;
-                    }
-                    int remaining_pins = out2_port_size - out2_pins_moved;
-                    // Skip over pins we have yet to copy.
-                    old_index += remaining_pins;
-                } else {
-                    oassert(false);
-                }
-            }
-        }
-        // Free the original node.
-        free_nnode(node);
+        stamp_memory_width_split(node, get_memory_width_split(node, dual_port_rams, split_input_ports, target_size), &dp_memory_list);
     }
 }
 
@@ -1073,6 +1039,7 @@ void free_memory_lists() {
         sp_memory_list = delete_in_vptr_list(sp_memory_list);
     while (dp_memory_list != NULL)
         dp_memory_list = delete_in_vptr_list(dp_memory_list);
+    memory_width_splits.clear();
 }
 
 /*
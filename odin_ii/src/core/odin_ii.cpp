@@ -45,6 +45,7 @@
 #include "memories.h"
 #include "block_memories.h"
 #include "simulate_blif.h"
+#include "sim_vector_file.h"
 #include "netlist_visualizer.h"
 #include "adders.h"
 #include "netlist_statistic.h"
@@ -293,6 +294,26 @@ netlist_t* start_odin_ii(int argc, char** argv) {
         exit(ERROR_PARSE_ARGS);
     }
 
+    /* convert a binary vector file back to text, with nothing else to do */
+    if (global_args.sim_convert_vectors.provenance() == argparse::Provenance::SPECIFIED) {
+        std::string binary_file = global_args.sim_convert_vectors.value();
+        std::string text_file = binary_file;
+        if (text_file.size() > 4 && text_file.compare(text_file.size() - 4, 4, ".bin") == 0)
+            text_file.resize(text_file.size() - 4);
+        text_file += ".txt";
+
+        try {
+            convert_sim_vectors_to_text(binary_file.c_str(), text_file.c_str());
+        } catch (vtr::VtrError& vtr_error) {
+            printf("Odin Failed to convert the vector file %s with exit code:%d \n", vtr_error.what(), ERROR_OUTPUT);
+            exit(ERROR_OUTPUT);
+        }
+        printf("Converted %s to %s\n", binary_file.c_str(), text_file.c_str());
+
+        delete mixer;
+        return NULL;
+    }
+
     /* read the confirguration file .. get options presets the config values just in case theyr'e not read in with config file */
     if (global_args.config_file.provenance() == argparse::Provenance::SPECIFIED) {
         printf("Reading Configuration file\n");
@@ -526,6 +547,14 @@ void get_options(int argc, char** argv) {
         .help("Allow to overwrite the top level module that odin would use")
         .metavar("TOP_LEVEL_MODULE_NAME");
 
+    other_grp.add_argument(global_args.abc_script, "--abc_script")
+        .help(
+            "Optimize and map the logic of the output BLIF with this ABC script (e.g. 'resyn; resyn2; if -K 6; scleanup')"
+            " run in-process, instead of writing the logic to BLIF for a separate ABC run."
+            " Latches, clocks and hard blocks are kept as they are."
+            " Requires Odin-II to be built with ODIN_USE_ABC")
+        .metavar("ABC_SCRIPT");
+
     auto& rand_sim_grp = parser.add_argument_group("random simulation options");
 
     rand_sim_grp.add_argument(global_args.sim_num_test_vectors, "-g")
@@ -579,6 +608,24 @@ void get_options(int argc, char** argv) {
         .action(argparse::Action::STORE_TRUE)
         .metavar("BATCH FLAG");
 
+    other_sim_grp.add_argument(global_args.sim_bit_parallel, "--bit_parallel")
+        .help(
+            "Simulate combinational netlists (LUTs only) 64 cycles at a time, one per bit of a machine word.\n"
+            "Netlists with other nodes (e.g. flip-flops or memories) are simulated one cycle at a time")
+        .default_value("false")
+        .action(argparse::Action::STORE_TRUE);
+
+    other_sim_grp.add_argument(global_args.sim_binary_output, "--sim_binary_output")
+        .help(
+            "Write the output vectors bit-packed to " BINARY_OUTPUT_VECTOR_FILE_NAME " from a background thread, instead of as text.\n"
+            "They are only converted to " OUTPUT_VECTOR_FILE_NAME " to be verified (-T), or with --sim_convert_vectors")
+        .default_value("false")
+        .action(argparse::Action::STORE_TRUE);
+
+    other_sim_grp.add_argument(global_args.sim_convert_vectors, "--sim_convert_vectors")
+        .help("Convert the given binary vector file (see --sim_binary_output) to a text vector file, with a .txt extension instead of .bin")
+        .metavar("BINARY_VECTOR_FILE");
+
     other_sim_grp.add_argument(global_args.sim_directory, "--sim_dir")
         .help("Directory output for simulation")
         .default_value(DEFAULT_OUTPUT)
@@ -653,9 +700,10 @@ void get_options(int argc, char** argv) {
 
     //Check required options
     if (!only_one_is_true({
-            global_args.config_file.provenance() == argparse::Provenance::SPECIFIED, //have a config file
-            global_args.blif_file.provenance() == argparse::Provenance::SPECIFIED,   //have a BLIF file
-            global_args.input_files.value().size() > 0                               //have a Verilog input list
+            global_args.config_file.provenance() == argparse::Provenance::SPECIFIED,        //have a config file
+            global_args.blif_file.provenance() == argparse::Provenance::SPECIFIED,          //have a BLIF file
+            global_args.input_files.value().size() > 0,                                     //have a Verilog input list
+            global_args.sim_convert_vectors.provenance() == argparse::Provenance::SPECIFIED //have a vector file to convert
         })) {
         parser.print_usage();
         warning_message(PARSE_ARGS, unknown_location, "%s",
@@ -663,6 +711,7 @@ void get_options(int argc, char** argv) {
                             a config file(-c)\n\t\
                             a BLIF file(-b)\n\t\
                             a Verilog file(-v)\n\t\
+                            a binary vector file to convert(--sim_convert_vectors)\n\t\
                         Unless is used for infrastructure directly\n");
     }
 
@@ -723,6 +772,12 @@ void get_options(int argc, char** argv) {
     if (global_args.permissive.value()) {
         warning_message(PARSE_ARGS, unknown_location, "%s", "Permissive flag is ON. Undefined behaviour may occur\n");
     }
+
+#ifndef ODIN_USE_ABC
+    if (global_args.abc_script.provenance() == argparse::Provenance::SPECIFIED) {
+        error_message(PARSE_ARGS, unknown_location, "%s", "--abc_script requires Odin-II to be built with ODIN_USE_ABC\n");
+    }
+#endif
     if (global_args.mults_ratio >= 0.0 && global_args.mults_ratio <= 1.0) {
         delete mixer->_opts[MULTIPLY];
         mixer->_opts[MULTIPLY] = new MultsOpt(global_args.mults_ratio);
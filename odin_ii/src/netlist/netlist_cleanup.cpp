@@ -23,169 +23,255 @@
  * OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#include <algorithm>
 #include <cstdio>
 #include <cmath>
+#include <thread>
+#include <vector>
 
 #include "odin_types.h"
 #include "odin_globals.h"
+#include "netlist_utils.h"
 
 #include "vtr_util.h"
 #include "vtr_memory.h"
 
 bool coarsen_cleanup;
 
-/* Used in the nnode_t.node_data field to mark if the node was already visited
- * during a forward or backward sweep traversal or the removal phase */
-int _visited_forward, _visited_backward, _visited_removal;
-#define VISITED_FORWARD ((void*)&_visited_forward)
-#define VISITED_BACKWARD ((void*)&_visited_backward)
-#define VISITED_REMOVAL ((void*)&_visited_removal)
+/* Mark bits of the nnode_t.cleanup_marks field. The sweeps claim the nodes they
+ * visit with an atomic fetch_or, so that each node is visited exactly once even
+ * when the frontier is split between threads */
+#define CLEANUP_LIVE ((unsigned char)0x1)     // visited by the backward sweep, i.e. drives an output
+#define CLEANUP_SWEPT ((unsigned char)0x2)    // visited by the forward sweep
+#define CLEANUP_TOPLEVEL ((unsigned char)0x4) // one of the top-level nodes (GND, VCC, PAD or INPUT)
+#define CLEANUP_REMOVED ((unsigned char)0x8)  // detached from the netlist and to be freed
 
-/* Simple linked list of nodes structure */
-struct node_list_t {
-    nnode_t* node;
-    struct node_list_t* next;
-};
+/* Frontiers with fewer nodes than this are swept by the calling thread alone,
+ * as starting the other threads would cost more than it saves */
+#define MIN_PARALLEL_FRONTIER_SIZE 4096
 
-node_list_t useless_nodes;                       // List of the nodes to be removed
-node_list_t* removal_list_next = &useless_nodes; // Tail of the nodes to be removed
+std::vector<nnode_t*> useless_nodes; // List of the nodes to be removed
+std::vector<nnode_t*> addsub_nodes;  // List of the heads of the adder/subtractor chains
 
-node_list_t addsub_nodes;                              // List of the adder/subtractor nodes
-node_list_t* addsub_list_next = &addsub_nodes;         // Tail of the adder/subtractor node list
 long long num_removed_nodes[operation_list_END] = {0}; //List of removed nodes by type
 
 /* Function declarations */
-node_list_t* insert_node_list(node_list_t* node_list, nnode_t* node);
-void traverse_backward(nnode_t* node);
-void traverse_forward(nnode_t* node, int toplevel, int remove_me);
-void mark_output_dependencies(netlist_t* netlist);
-void identify_unused_nodes(netlist_t* netlist);
-void remove_unused_nodes(node_list_t* remove);
-void calculate_addsub_statistics(node_list_t* addsub);
+bool claim_node(nnode_t* node, unsigned char mark);
+template<typename Visit>
+std::vector<nnode_t*> sweep_netlist(std::vector<nnode_t*> frontier, Visit visit);
+void mark_output_dependencies(netlist_t* netlist, std::vector<nnode_t*>& visited);
+void identify_unused_nodes(netlist_t* netlist, std::vector<nnode_t*>& visited);
+void remove_unused_nodes(const std::vector<nnode_t*>& remove);
+void free_unused_nodes(netlist_t* netlist, const std::vector<nnode_t*>& remove);
+void calculate_addsub_statistics(const std::vector<nnode_t*>& addsub);
 void remove_unused_logic(netlist_t* netlist);
 void count_node_type(nnode_t* node);
 void report_removed_nodes(long long* node_list);
 
-node_list_t* insert_node_list(node_list_t* node_list, nnode_t* node) {
-    node_list->node = node;
-    node_list->next = (node_list_t*)vtr::calloc(1, sizeof(node_list_t));
-    return node_list->next;
+/* Sets the mark on the node, and returns whether it was not already set */
+bool claim_node(nnode_t* node, unsigned char mark) {
+    return !(node->cleanup_marks.fetch_or(mark) & mark);
 }
 
-/* Traverse the netlist backwards, moving from outputs to inputs */
-void traverse_backward(nnode_t* node) {
-    if (node->node_data == VISITED_BACKWARD) return; // Already visited
-    node->node_data = VISITED_BACKWARD;              // Mark as visited
-    int i;
-    for (i = 0; i < node->num_input_pins; i++) {
-        // ensure this net has a driver (i.e. skip undriven outputs)
-        for (int j = 0; j < node->input_pins[i]->net->num_driver_pins; j++) {
-            if (node->input_pins[i]->net->driver_pins[j]->node)
+/* Breadth-first sweep of the netlist from the (already claimed) frontier nodes.
+ * visit(node, thread_id, next) is called once per node of each frontier and
+ * appends the neighbours it claims to next, the frontier of the following step.
+ * Wide frontiers are split between threads, each visiting a contiguous slice.
+ * Returns every visited node, in the order of the frontiers */
+template<typename Visit>
+std::vector<nnode_t*> sweep_netlist(std::vector<nnode_t*> frontier, Visit visit) {
+    size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<nnode_t*> visited;
+    while (!frontier.empty()) {
+        visited.insert(visited.end(), frontier.begin(), frontier.end());
+
+        size_t num_threads = std::min(max_threads, std::max<size_t>(1, frontier.size() / MIN_PARALLEL_FRONTIER_SIZE));
+        std::vector<std::vector<nnode_t*>> next(num_threads);
+
+        auto visit_slice = [&](size_t id) {
+            size_t start = frontier.size() * id / num_threads;
+            size_t end = frontier.size() * (id + 1) / num_threads;
+            for (size_t i = start; i < end; i++)
+                visit(frontier[i], id, next[id]);
+        };
+
+        std::vector<std::thread> threads;
+        for (size_t id = 1; id < num_threads; id++)
+            threads.emplace_back(visit_slice, id);
+        visit_slice(0);
+        for (std::thread& thread : threads)
+            thread.join();
+
+        frontier.clear();
+        for (const std::vector<nnode_t*>& thread_next : next)
+            frontier.insert(frontier.end(), thread_next.begin(), thread_next.end());
+    }
+
+    return visited;
+}
+
+/* Start at each of the top level output nodes and traverse backwards to the inputs
+ * to determine which nodes have an effect on the outputs */
+void mark_output_dependencies(netlist_t* netlist, std::vector<nnode_t*>& visited) {
+    std::vector<nnode_t*> frontier;
+    for (int i = 0; i < netlist->num_top_output_nodes; i++) {
+        if (claim_node(netlist->top_output_nodes[i], CLEANUP_LIVE))
+            frontier.push_back(netlist->top_output_nodes[i]);
+    }
+
+    visited = sweep_netlist(frontier, [](nnode_t* node, size_t /*thread_id*/, std::vector<nnode_t*>& next) {
+        for (int i = 0; i < node->num_input_pins; i++) {
+            // ensure this net has a driver (i.e. skip undriven outputs)
+            nnet_t* net = node->input_pins[i]->net;
+            for (int j = 0; j < net->num_driver_pins; j++) {
                 // Visit the drivers of this node
-                traverse_backward(node->input_pins[i]->net->driver_pins[j]->node);
+                nnode_t* driver = net->driver_pins[j]->node;
+                if (driver && claim_node(driver, CLEANUP_LIVE))
+                    next.push_back(driver);
+            }
         }
-    }
+    });
 }
 
-/* Traverse the netlist forward, moving from inputs to outputs.
- * Adds nodes that do not affect any outputs to the useless_nodes list
- * Arguments:
- * 	node: the current node in the netlist
- * 	toplevel: are we at one of the top-level nodes? (GND, VCC, PAD or INPUT)
- * 	remove_me: should the current node be removed?
- * */
-void traverse_forward(nnode_t* node, int toplevel, int remove_me) {
-    if (node == NULL) return;                       // Shouldn't happen, but check just in case
-    if (node->node_data == VISITED_FORWARD) return; // Already visited, shouldn't happen anyway
-
-    /* We want to remove this node if either its parent was removed,
-     * or if it was not visited on the backwards sweep */
-    remove_me = remove_me || ((node->node_data != VISITED_BACKWARD) && (toplevel == false));
-
-    /* Mark this node as visited */
-    node->node_data = VISITED_FORWARD;
-
-    if (remove_me) {
-        /* Add this node to the list of nodes to remove */
-        removal_list_next = insert_node_list(removal_list_next, node);
-        count_node_type(node);
+/* Traverse the netlist forward from the top level inputs and special nodes
+ * (VCC, GND, PAD), moving from inputs to outputs. The nodes that were not visited
+ * by the backward sweep do not affect any outputs and are added to the
+ * useless_nodes list, and the heads of the adder/subtractor chains are added to
+ * the addsub_nodes list */
+void identify_unused_nodes(netlist_t* netlist, std::vector<nnode_t*>& visited) {
+    useless_nodes.clear();
+    addsub_nodes.clear();
+
+    std::vector<nnode_t*> frontier;
+    auto add_toplevel = [&](nnode_t* node) {
+        if (node == NULL) return; // Shouldn't happen, but check just in case
+        node->cleanup_marks.fetch_or(CLEANUP_TOPLEVEL);
+        if (claim_node(node, CLEANUP_SWEPT))
+            frontier.push_back(node);
+    };
+    add_toplevel(netlist->gnd_node);
+    add_toplevel(netlist->vcc_node);
+    add_toplevel(netlist->pad_node);
+    for (int i = 0; i < netlist->num_top_input_nodes; i++) {
+        add_toplevel(netlist->top_input_nodes[i]);
     }
 
-    if (node->type == ADD || node->type == MINUS) {
-        // check if adders/subtractors are starting using a global gnd/vcc node or a pad node
-        auto ADDER_START_NODE = PAD_NODE;
-        if (configuration.adder_cin_global) {
-            if (node->type == ADD)
-                ADDER_START_NODE = GND_NODE;
-            else
-                ADDER_START_NODE = VCC_NODE;
+    // check if adders/subtractors are starting using a global gnd/vcc node or a pad node
+    auto adder_start_node = [](nnode_t* node) {
+        if (!configuration.adder_cin_global)
+            return PAD_NODE;
+        return (node->type == ADD) ? GND_NODE : VCC_NODE;
+    };
+
+    size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::vector<nnode_t*>> thread_useless(max_threads);
+    std::vector<std::vector<nnode_t*>> thread_addsub(max_threads);
+
+    visited = sweep_netlist(frontier, [&](nnode_t* node, size_t thread_id, std::vector<nnode_t*>& next) {
+        /* A node only affects the outputs if it was visited on the backwards sweep,
+         * and so do all the nodes driving it: the fanout of a removed node is
+         * removed as well */
+        unsigned char marks = node->cleanup_marks.load();
+        if (!(marks & (CLEANUP_LIVE | CLEANUP_TOPLEVEL))) {
+            /* Add this node to the list of nodes to remove */
+            thread_useless[thread_id].push_back(node);
         }
-        oassert(node->input_pins[node->num_input_pins - 1]->net->num_driver_pins == 1);
-        /* Check if we've found the head of an adder or subtractor chain */
-        if (node->input_pins[node->num_input_pins - 1]->net->driver_pins[0]->node->type == ADDER_START_NODE) {
-            addsub_list_next = insert_node_list(addsub_list_next, node);
+
+        if (node->type == ADD || node->type == MINUS) {
+            oassert(node->input_pins[node->num_input_pins - 1]->net->num_driver_pins == 1);
+            /* Check if we've found the head of an adder or subtractor chain */
+            if (node->input_pins[node->num_input_pins - 1]->net->driver_pins[0]->node->type == adder_start_node(node)) {
+                thread_addsub[thread_id].push_back(node);
+            }
         }
-    }
 
-    /* Iterate through every fanout node */
-    int i, j;
-    for (i = 0; i < node->num_output_pins; i++) {
-        if (node->output_pins[i] && node->output_pins[i]->net) {
-            for (j = 0; j < node->output_pins[i]->net->num_fanout_pins; j++) {
-                if (node->output_pins[i]->net->fanout_pins[j]) {
-                    nnode_t* child = node->output_pins[i]->net->fanout_pins[j]->node;
-                    if (child) {
-                        /* If this child hasn't already been visited, visit it now */
-                        if (child->node_data != VISITED_FORWARD) {
-                            traverse_forward(child, false, remove_me);
-                        }
+        /* Iterate through every fanout node */
+        for (int i = 0; i < node->num_output_pins; i++) {
+            if (node->output_pins[i] && node->output_pins[i]->net) {
+                nnet_t* net = node->output_pins[i]->net;
+                for (int j = 0; j < net->num_fanout_pins; j++) {
+                    if (net->fanout_pins[j]) {
+                        nnode_t* child = net->fanout_pins[j]->node;
+                        /* If this child hasn't already been visited, visit it next */
+                        if (child && claim_node(child, CLEANUP_SWEPT))
+                            next.push_back(child);
                     }
                 }
             }
         }
+    });
+
+    /* The nodes are sorted so that the removal and the statistics don't depend on
+     * which thread visited them */
+    auto by_unique_id = [](const nnode_t* a, const nnode_t* b) {
+        return a->unique_id < b->unique_id;
+    };
+    for (size_t id = 0; id < max_threads; id++) {
+        useless_nodes.insert(useless_nodes.end(), thread_useless[id].begin(), thread_useless[id].end());
+        addsub_nodes.insert(addsub_nodes.end(), thread_addsub[id].begin(), thread_addsub[id].end());
     }
-}
+    std::sort(useless_nodes.begin(), useless_nodes.end(), by_unique_id);
+    std::sort(addsub_nodes.begin(), addsub_nodes.end(), by_unique_id);
 
-/* Start at each of the top level output nodes and traverse backwards to the inputs
- * to determine which nodes have an effect on the outputs */
-void mark_output_dependencies(netlist_t* netlist) {
-    int i;
-    for (i = 0; i < netlist->num_top_output_nodes; i++) {
-        traverse_backward(netlist->top_output_nodes[i]);
-    }
-}
-
-/* Traversed the netlist forward from the top level inputs and special nodes
- * (VCC, GND, PAD) */
-void identify_unused_nodes(netlist_t* netlist) {
-    useless_nodes.node = NULL;
-    useless_nodes.next = NULL;
-
-    addsub_nodes.node = NULL;
-    addsub_nodes.next = NULL;
-
-    traverse_forward(netlist->gnd_node, true, false);
-    traverse_forward(netlist->vcc_node, true, false);
-    traverse_forward(netlist->pad_node, true, false);
-    int i;
-    for (i = 0; i < netlist->num_top_input_nodes; i++) {
-        traverse_forward(netlist->top_input_nodes[i], true, false);
+    for (nnode_t* node : useless_nodes) {
+        node->cleanup_marks.fetch_or(CLEANUP_REMOVED);
+        count_node_type(node);
     }
 }
 
-/* Note: This does not actually free the unused logic, but simply detaches
- * it from the rest of the circuit */
-void remove_unused_nodes(node_list_t* remove) {
-    while (remove != NULL && remove->node != NULL) {
-        int i;
-        for (i = 0; i < remove->node->num_input_pins; i++) {
-            npin_t* input_pin = remove->node->input_pins[i];
+/* Detaches the unused logic from the rest of the circuit */
+void remove_unused_nodes(const std::vector<nnode_t*>& remove) {
+    for (nnode_t* node : remove) {
+        for (int i = 0; i < node->num_input_pins; i++) {
+            npin_t* input_pin = node->input_pins[i];
             /* Remove the fanout pin from the net */
             if (input_pin)
                 input_pin->net->fanout_pins[input_pin->pin_net_idx] = NULL;
         }
-        remove->node->node_data = VISITED_REMOVAL;
-        remove = remove->next;
+    }
+}
+
+/* Frees the detached unused logic at once. The nets driven by removed nodes only
+ * fan out to removed nodes, but may also be driven by live nodes, so the removed
+ * driver pins are taken off them first */
+void free_unused_nodes(netlist_t* netlist, const std::vector<nnode_t*>& remove) {
+    if (remove.empty())
+        return;
+
+    for (nnode_t* node : remove) {
+        for (int i = 0; i < node->num_output_pins; i++) {
+            npin_t* output_pin = node->output_pins[i];
+            if (!output_pin || !output_pin->net)
+                continue;
+
+            nnet_t* net = output_pin->net;
+            int num_driver_pins = 0;
+            for (int j = 0; j < net->num_driver_pins; j++) {
+                if (net->driver_pins[j] != output_pin) {
+                    net->driver_pins[num_driver_pins] = net->driver_pins[j];
+                    net->driver_pins[num_driver_pins]->pin_net_idx = num_driver_pins;
+                    num_driver_pins++;
+                }
+            }
+            net->num_driver_pins = num_driver_pins;
+        }
+    }
+
+    /* the netlist node lists must not keep the freed nodes */
+    auto remove_from_list = [](nnode_t** nodes, int& num_nodes) {
+        int num_kept = 0;
+        for (int i = 0; i < num_nodes; i++) {
+            if (!nodes[i] || !(nodes[i]->cleanup_marks.load() & CLEANUP_REMOVED))
+                nodes[num_kept++] = nodes[i];
+        }
+        num_nodes = num_kept;
+    };
+    remove_from_list(netlist->internal_nodes, netlist->num_internal_nodes);
+    remove_from_list(netlist->ff_nodes, netlist->num_ff_nodes);
+
+    for (nnode_t* node : remove) {
+        free_nnode(node);
     }
 }
 
@@ -204,13 +290,13 @@ double geomean_addsub_length = 0.0; // Geometric mean of add/sub chain length
 double sum_of_addsub_logs = 0.0;    // Sum of the logarithms of the add/sub chain lengths; used for geomean
 double total_addsub_chain_count = 0.0;
 
-void calculate_addsub_statistics(node_list_t* addsub) {
-    while (addsub != NULL && addsub->node != NULL) {
+void calculate_addsub_statistics(const std::vector<nnode_t*>& addsub) {
+    for (nnode_t* head : addsub) {
         int found_tail = false;
-        nnode_t* node = addsub->node;
+        nnode_t* node = head;
         int chain_depth = 0;
         while (!found_tail) {
-            if (node->node_data == VISITED_REMOVAL) {
+            if (node->cleanup_marks.load() & CLEANUP_REMOVED) {
                 found_tail = true;
                 break;
             }
@@ -237,8 +323,6 @@ void calculate_addsub_statistics(node_list_t* addsub) {
             sum_of_addsub_logs += log(chain_depth);
             total_addsub_chain_count += 1.0;
         }
-
-        addsub = addsub->next;
     }
     /* Calculate the geometric mean carry chain length */
     geomean_addsub_length = exp(sum_of_addsub_logs / total_addsub_chain_count);
@@ -302,7 +386,7 @@ void count_node_type(nnode_t* node) {
 
 void report_removed_nodes(long long* node_list) {
     // return if there is no removed logic
-    if (!useless_nodes.node)
+    if (useless_nodes.empty())
         return;
 
     warning_message(NETLIST, unknown_location, "%s", "Following unused node(s) removed from the netlist:\n");
@@ -318,9 +402,22 @@ void report_removed_nodes(long long* node_list) {
 
 /* Perform the backwards and forward sweeps and remove the unused nodes */
 void remove_unused_logic(netlist_t* netlist) {
-    mark_output_dependencies(netlist);
-    identify_unused_nodes(netlist);
-    remove_unused_nodes(&useless_nodes);
+    std::vector<nnode_t*> live_nodes;
+    std::vector<nnode_t*> swept_nodes;
+    mark_output_dependencies(netlist, live_nodes);
+    identify_unused_nodes(netlist, swept_nodes);
+    remove_unused_nodes(useless_nodes);
     if (global_args.all_warnings) report_removed_nodes(num_removed_nodes);
-    calculate_addsub_statistics(&addsub_nodes);
+    calculate_addsub_statistics(addsub_nodes);
+
+    /* clear the marks of the nodes left, in case the netlist is swept again */
+    for (nnode_t* node : live_nodes)
+        node->cleanup_marks = 0;
+    for (nnode_t* node : swept_nodes)
+        if (!(node->cleanup_marks.load() & CLEANUP_REMOVED))
+            node->cleanup_marks = 0;
+
+    free_unused_nodes(netlist, useless_nodes);
+    useless_nodes.clear();
+    addsub_nodes.clear();
 }
@@ -0,0 +1,156 @@
+/*
+ * Copyright 2023 CAS—Atlantic (University of New Brunswick, CASA)
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cstring>
+
+#include "odin_types.h"
+#include "odin_util.h"
+#include "netlist_storage.h"
+
+#include "vtr_memory.h"
+
+/* Every slot starts with a header pointing to its pool, so an object can be freed without knowing its netlist */
+#define POOL_HEADER_SIZE (sizeof(std::max_align_t))
+/* Slots of the first chunk; chunks double in size up to MAX_POOL_CHUNK_SLOTS */
+#define MIN_POOL_CHUNK_SLOTS 256
+#define MAX_POOL_CHUNK_SLOTS 65536
+
+static netlist_storage_t* default_storage = NULL;
+static netlist_storage_t* current_storage = NULL;
+
+/*---------------------------------------------------------------------------------------------
+ * (function: netlist_pool)
+ *-------------------------------------------------------------------------------------------*/
+netlist_pool::netlist_pool(size_t object_size)
+    : object_size_(object_size)
+    , chunk_slots_(MIN_POOL_CHUNK_SLOTS)
+    , free_list_(NULL)
+    , num_allocated_(0) {
+    oassert(object_size >= sizeof(void*));
+    slot_size_ = POOL_HEADER_SIZE + (object_size + POOL_HEADER_SIZE - 1) / POOL_HEADER_SIZE * POOL_HEADER_SIZE;
+}
+
+netlist_pool::~netlist_pool() {
+    release_all();
+}
+
+/*---------------------------------------------------------------------------------------------
+ * (function: add_chunk)
+ * 	Threads the slots of a new chunk on the free list
+ *-------------------------------------------------------------------------------------------*/
+void netlist_pool::add_chunk() {
+    char* chunk = (char*)vtr::malloc(slot_size_ * chunk_slots_);
+    chunks_.push_back(chunk);
+
+    for (size_t i = chunk_slots_; i-- > 0;) {
+        char* slot = chunk + i * slot_size_;
+        *(netlist_pool**)slot = this;
+        *(void**)(slot + POOL_HEADER_SIZE) = free_list_;
+        free_list_ = slot + POOL_HEADER_SIZE;
+    }
+
+    if (chunk_slots_ < MAX_POOL_CHUNK_SLOTS)
+        chunk_slots_ *= 2;
+}
+
+/*---------------------------------------------------------------------------------------------
+ * (function: allocate)
+ *-------------------------------------------------------------------------------------------*/
+void* netlist_pool::allocate() {
+    if (!free_list_)
+        add_chunk();
+
+    void* object = free_list_;
+    free_list_ = *(void**)object;
+    num_allocated_++;
+
+    memset(object, 0, object_size_);
+    return object;
+}
+
+/*---------------------------------------------------------------------------------------------
+ * (function: release)
+ *-------------------------------------------------------------------------------------------*/
+void netlist_pool::release(void* object) {
+    if (!object)
+        return;
+
+    netlist_pool* pool = *(netlist_pool**)((char*)object - POOL_HEADER_SIZE);
+    *(void**)object = pool->free_list_;
+    pool->free_list_ = object;
+    pool->num_allocated_--;
+}
+
+/*---------------------------------------------------------------------------------------------
+ * (function: release_all)
+ *-------------------------------------------------------------------------------------------*/
+void netlist_pool::release_all() {
+    for (char* chunk : chunks_)
+        vtr::free(chunk);
+
+    chunks_.clear();
+    free_list_ = NULL;
+    num_allocated_ = 0;
+    chunk_slots_ = MIN_POOL_CHUNK_SLOTS;
+}
+
+netlist_storage_t::netlist_storage_t()
+    : nodes(sizeof(nnode_t))
+    , pins(sizeof(npin_t))
+    , nets(sizeof(nnet_t)) {}
+
+/*---------------------------------------------------------------------------------------------
+ * (function: current_netlist_storage)
+ *-------------------------------------------------------------------------------------------*/
+netlist_storage_t* current_netlist_storage() {
+    if (!current_storage) {
+        if (!default_storage)
+            default_storage = new netlist_storage_t();
+
+        current_storage = default_storage;
+    }
+    return current_storage;
+}
+
+/*---------------------------------------------------------------------------------------------
+ * (function: new_netlist_storage)
+ *-------------------------------------------------------------------------------------------*/
+netlist_storage_t* new_netlist_storage() {
+    current_storage = new netlist_storage_t();
+    return current_storage;
+}
+
+/*---------------------------------------------------------------------------------------------
+ * (function: free_netlist_storage)
+ *-------------------------------------------------------------------------------------------*/
+void free_netlist_storage(netlist_storage_t* storage) {
+    if (!storage || storage == default_storage)
+        return;
+
+    if (current_storage == storage)
+        current_storage = NULL;
+
+    delete storage;
+}
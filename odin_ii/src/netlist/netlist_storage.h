@@ -0,0 +1,92 @@
+/*
+ * Copyright 2023 CAS—Atlantic (University of New Brunswick, CASA)
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef NETLIST_STORAGE_H
+#define NETLIST_STORAGE_H
+
+#include <cstddef>
+#include <vector>
+
+/*
+ * Netlist storage
+ *
+ * Netlist nodes, pins and nets are allocated from pools owned by the netlist being
+ * built, instead of one heap block each: allocating or freeing one is a free-list
+ * push/pop, objects of a netlist are packed together in large chunks, and freeing
+ * the netlist releases them all at once (see free_netlist()).
+ *
+ * Objects allocated while no netlist is being built come from a default storage which
+ * lives for the whole run.
+ */
+
+/* Fixed-size object pool */
+class netlist_pool {
+  public:
+    explicit netlist_pool(size_t object_size);
+    ~netlist_pool();
+
+    netlist_pool(const netlist_pool&) = delete;
+    netlist_pool& operator=(const netlist_pool&) = delete;
+
+    /* returns a zeroed object */
+    void* allocate();
+
+    /* returns an object from any pool to the pool it came from */
+    static void release(void* object);
+
+    /* frees every object of the pool at once (their destructors are not called) */
+    void release_all();
+
+    size_t num_allocated() const { return num_allocated_; }
+
+  private:
+    void add_chunk();
+
+    size_t slot_size_;
+    size_t object_size_;
+    size_t chunk_slots_;
+    std::vector<char*> chunks_;
+    void* free_list_;
+    size_t num_allocated_;
+};
+
+struct netlist_storage_t {
+    netlist_pool nodes;
+    netlist_pool pins;
+    netlist_pool nets;
+
+    netlist_storage_t();
+};
+
+/* the storage objects are currently allocated from */
+netlist_storage_t* current_netlist_storage();
+
+/* creates a new storage and allocates from it until it's freed */
+netlist_storage_t* new_netlist_storage();
+
+/* frees the storage and everything allocated from it */
+void free_netlist_storage(netlist_storage_t* storage);
+
+#endif
@@ -29,16 +29,52 @@
 #include "odin_types.h"
 #include "odin_globals.h"
 #include "netlist_utils.h"
+#include "netlist_storage.h"
 #include "odin_util.h"
 
 #include "vtr_util.h"
 #include "vtr_memory.h"
 
+/*---------------------------------------------------------------------------------------------
+ * (function: allocate_struct)
+ * 	Zeroed structure with a unique_id, from the given pool of the current netlist storage
+ *-------------------------------------------------------------------------------------------*/
+static void* allocate_struct(netlist_pool& pool) {
+    void* allocated = pool.allocate();
+    mark_unique_id(allocated);
+    return allocated;
+}
+
+/*---------------------------------------------------------------------------------------------
+ * (function: release_npin)
+ * 	Returns a pin to its pool (its strings must have been freed)
+ *-------------------------------------------------------------------------------------------*/
+static npin_t* release_npin(npin_t* to_free) {
+    if (to_free)
+        to_free->values.reset();
+
+    netlist_pool::release(to_free);
+    return NULL;
+}
+
+/*---------------------------------------------------------------------------------------------
+ * (function: grow_pin_array)
+ * 	Makes room for one more pin in an array of num_pins pins. Arrays grow by doubling,
+ *  so their capacity is the smallest power of 2 holding num_pins, and num_pins may only
+ *  shrink without reallocating.
+ *-------------------------------------------------------------------------------------------*/
+static npin_t** grow_pin_array(npin_t** pins, int num_pins) {
+    if (num_pins == 0 || (num_pins & (num_pins - 1)) == 0)
+        pins = (npin_t**)vtr::realloc(pins, sizeof(npin_t*) * (num_pins ? 2 * num_pins : 1));
+
+    return pins;
+}
+
 /*---------------------------------------------------------------------------------------------
  * (function: allocate_nnode)
  *-------------------------------------------------------------------------------------------*/
 nnode_t* allocate_nnode(loc_t loc) {
-    nnode_t* new_node = (nnode_t*)my_malloc_struct(sizeof(nnode_t));
+    nnode_t* new_node = (nnode_t*)allocate_struct(current_netlist_storage()->nodes);
 
     new_node->loc = loc;
     new_node->name = NULL;
@@ -46,6 +82,7 @@ nnode_t* allocate_nnode(loc_t loc) {
     new_node->bit_width = 0;
     new_node->related_ast_node = NULL;
     new_node->traverse_visited = -1;
+    new_node->cleanup_marks = 0;
 
     new_node->input_pins = NULL;
     new_node->num_input_pins = 0;
@@ -102,7 +139,7 @@ nnode_t* free_nnode(nnode_t* to_free) {
                 vtr::free(to_free->input_pins[i]->name);
                 to_free->input_pins[i]->name = NULL;
             }
-            to_free->input_pins[i] = (npin_t*)vtr::free(to_free->input_pins[i]);
+            to_free->input_pins[i] = release_npin(to_free->input_pins[i]);
         }
 
         to_free->input_pins = (npin_t**)vtr::free(to_free->input_pins);
@@ -112,7 +149,7 @@ nnode_t* free_nnode(nnode_t* to_free) {
                 vtr::free(to_free->output_pins[i]->name);
                 to_free->output_pins[i]->name = NULL;
             }
-            to_free->output_pins[i] = (npin_t*)vtr::free(to_free->output_pins[i]);
+            to_free->output_pins[i] = release_npin(to_free->output_pins[i]);
         }
 
         to_free->output_pins = (npin_t**)vtr::free(to_free->output_pins);
@@ -130,7 +167,8 @@ nnode_t* free_nnode(nnode_t* to_free) {
 
         /* now free the node */
     }
-    return (nnode_t*)vtr::free(to_free);
+    netlist_pool::release(to_free);
+    return NULL;
 }
 
 /*-------------------------------------------------------------------------
@@ -195,7 +233,7 @@ void add_input_port_information(nnode_t* node, int port_width) {
 npin_t* allocate_npin() {
     npin_t* new_pin;
 
-    new_pin = (npin_t*)my_malloc_struct(sizeof(npin_t));
+    new_pin = (npin_t*)allocate_struct(current_netlist_storage()->pins);
 
     new_pin->name = NULL;
     new_pin->type = NO_ID;
@@ -232,7 +270,7 @@ npin_t* free_npin(npin_t* to_free) {
 
         /* now free the pin */
     }
-    return (npin_t*)vtr::free(to_free);
+    return release_npin(to_free);
 }
 
 /*-------------------------------------------------------------------------
@@ -282,7 +320,7 @@ npin_t* copy_input_npin(npin_t* copy_pin) {
  * (function: allocate_nnet)
  *-------------------------------------------------------------------------------------------*/
 nnet_t* allocate_nnet() {
-    nnet_t* new_net = (nnet_t*)my_malloc_struct(sizeof(nnet_t));
+    nnet_t* new_net = (nnet_t*)allocate_struct(current_netlist_storage()->nets);
 
     new_net->name = NULL;
     new_net->driver_pins = NULL;
@@ -314,7 +352,8 @@ nnet_t* free_nnet(nnet_t* to_free) {
 
         /* now free the net */
     }
-    return (nnet_t*)vtr::free(to_free);
+    netlist_pool::release(to_free);
+    return NULL;
 }
 
 /*---------------------------------------------------------------------------
@@ -378,7 +417,7 @@ void add_fanout_pin_to_net(nnet_t* net, npin_t* pin) {
     oassert(pin != NULL);
     oassert(pin->type != OUTPUT);
     /* assumes the pin spots have been allocated and the pin */
-    net->fanout_pins = (npin_t**)vtr::realloc(net->fanout_pins, sizeof(npin_t*) * (net->num_fanout_pins + 1));
+    net->fanout_pins = grow_pin_array(net->fanout_pins, net->num_fanout_pins);
     net->fanout_pins[net->num_fanout_pins] = pin;
     net->num_fanout_pins++;
     /* record the node and pin spot in the pin */
@@ -410,8 +449,8 @@ void add_driver_pin_to_net(nnet_t* net, npin_t* pin) {
     oassert(pin != NULL);
     oassert(pin->type != INPUT);
     /* assumes the pin spots have been allocated and the pin */
+    net->driver_pins = grow_pin_array(net->driver_pins, net->num_driver_pins);
     net->num_driver_pins++;
-    net->driver_pins = (npin_t**)vtr::realloc(net->driver_pins, net->num_driver_pins * sizeof(npin_t*));
     net->driver_pins[net->num_driver_pins - 1] = pin;
     /* record the node and pin spot in the pin */
     pin->net = net;
@@ -1131,6 +1170,9 @@ netlist_t* allocate_netlist() {
     new_netlist->out_pins_sc = sc_new_string_cache();
     new_netlist->nodes_sc = sc_new_string_cache();
 
+    /* the nodes, pins and nets built from now on belong to this netlist */
+    new_netlist->storage = new_netlist_storage();
+
     return new_netlist;
 }
 
@@ -1144,6 +1186,10 @@ void free_netlist(netlist_t* to_free) {
     sc_free_string_cache(to_free->nets_sc);
     sc_free_string_cache(to_free->out_pins_sc);
     sc_free_string_cache(to_free->nodes_sc);
+
+    /* releases every node, pin and net built with the netlist at once */
+    free_netlist_storage(to_free->storage);
+    to_free->storage = NULL;
 }
 
 /*
@@ -0,0 +1,254 @@
+/*
+ * Copyright 2023 CAS—Atlantic (University of New Brunswick, CASA)
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "sim_vector_file.h"
+#include "simulate_blif.h"
+
+#include "vtr_util.h"
+
+/* Size of the blocks of cycles handed over to the writer thread, and of the chunks
+ * the converter reads and writes */
+#define SIM_VECTOR_BLOCK_SIZE (1 << 20)
+
+/* Number of blocks the simulation may get ahead of the writer thread */
+#define MAX_PENDING_SIM_VECTOR_BLOCKS 16
+
+static void put_u32(FILE* file, uint32_t value) {
+    uint8_t bytes[4] = {(uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24)};
+    if (fwrite(bytes, 1, 4, file) != 4)
+        error_message(SIMULATION, unknown_location, "%s", "Could not write to the binary vector file.");
+}
+
+static uint32_t get_u32(FILE* file, const char* file_name) {
+    uint8_t bytes[4];
+    if (fread(bytes, 1, 4, file) != 4)
+        error_message(SIMULATION, unknown_location, "Truncated binary vector file: %s", file_name);
+    return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+static size_t get_record_size(const std::vector<int>& num_pins) {
+    size_t total_pins = 0;
+    for (int line_pins : num_pins)
+        total_pins += line_pins;
+    return (2 * total_pins + 7) / 8;
+}
+
+void append_vector_value(std::string& buffer, const BitSpace::bit_value_t* values, int num_pins) {
+    static const char hex_digits[] = "0123456789abcdef";
+
+    bool unknown = false;
+    for (int j = 0; j < num_pins && !unknown; j++)
+        unknown = BitSpace::is_unk[values[j]];
+
+    if (unknown || num_pins == 1) {
+        for (int j = num_pins - 1; j >= 0; j--)
+            buffer += BitSpace::is_unk[values[j]] ? 'x' : (char)('0' + values[j]);
+    } else {
+        buffer += "0X";
+
+        int hex_digit = 0;
+        for (int j = num_pins - 1; j >= 0; j--) {
+            hex_digit += values[j] << j % 4;
+
+            if (!(j % 4)) {
+                buffer += hex_digits[hex_digit];
+                hex_digit = 0;
+            }
+        }
+    }
+}
+
+void convert_sim_vectors_to_text(const char* binary_file_name, const char* text_file_name) {
+    FILE* in = fopen(binary_file_name, "rb");
+    if (!in)
+        error_message(SIMULATION, unknown_location, "Could not open binary vector file: %s", binary_file_name);
+
+    char magic[sizeof(SIM_VECTOR_FILE_MAGIC) - 1];
+    if (fread(magic, 1, sizeof(magic), in) != sizeof(magic) || memcmp(magic, SIM_VECTOR_FILE_MAGIC, sizeof(magic)))
+        error_message(SIMULATION, unknown_location, "Not a binary vector file: %s", binary_file_name);
+
+    // The header, as written by write_vector_headers()
+    std::string buffer;
+    std::vector<int> num_pins(get_u32(in, binary_file_name));
+    for (size_t i = 0; i < num_pins.size(); i++) {
+        num_pins[i] = get_u32(in, binary_file_name);
+        std::string name(get_u32(in, binary_file_name), '\0');
+        if (fread(&name[0], 1, name.size(), in) != name.size())
+            error_message(SIMULATION, unknown_location, "Truncated binary vector file: %s", binary_file_name);
+
+        buffer += name;
+        buffer += (i + 1 < num_pins.size()) ? ' ' : '\n';
+    }
+    if (num_pins.empty())
+        buffer += '\n';
+
+    FILE* out = fopen(text_file_name, "w");
+    if (!out)
+        error_message(SIMULATION, unknown_location, "Could not create vector file: %s", text_file_name);
+
+    size_t record_size = get_record_size(num_pins);
+    std::vector<uint8_t> record(record_size);
+    std::vector<BitSpace::bit_value_t> values;
+    while (record_size && fread(record.data(), 1, record_size, in) == record_size) {
+        size_t value_idx = 0;
+        for (int line_pins : num_pins) {
+            values.resize(line_pins);
+            for (int j = 0; j < line_pins; j++, value_idx++)
+                values[j] = (record[value_idx / 4] >> (2 * (value_idx % 4))) & 0x3;
+
+            append_vector_value(buffer, values.data(), line_pins);
+            buffer += ' ';
+        }
+        buffer += '\n';
+
+        if (buffer.size() >= SIM_VECTOR_BLOCK_SIZE) {
+            fwrite(buffer.data(), 1, buffer.size(), out);
+            buffer.clear();
+        }
+    }
+    if (record_size && !feof(in))
+        error_message(SIMULATION, unknown_location, "Could not read binary vector file: %s", binary_file_name);
+
+    fwrite(buffer.data(), 1, buffer.size(), out);
+    fclose(out);
+    fclose(in);
+}
+
+sim_vector_writer::sim_vector_writer(const char* file_name, lines_t* l)
+    : lines_(l) {
+    file_ = fopen(file_name, "wb");
+    if (!file_)
+        error_message(SIMULATION, unknown_location, "Could not create binary vector file: %s", file_name);
+
+    fwrite(SIM_VECTOR_FILE_MAGIC, 1, sizeof(SIM_VECTOR_FILE_MAGIC) - 1, file_);
+    put_u32(file_, l->count);
+    std::vector<int> num_pins;
+    for (int i = 0; i < l->count; i++) {
+        num_pins.push_back(l->lines[i]->number_of_pins);
+        size_t name_length = strlen(l->lines[i]->name);
+        put_u32(file_, l->lines[i]->number_of_pins);
+        put_u32(file_, name_length);
+        fwrite(l->lines[i]->name, 1, name_length, file_);
+    }
+
+    record_size_ = get_record_size(num_pins);
+    cycles_per_block_ = std::max<size_t>(1, SIM_VECTOR_BLOCK_SIZE / std::max<size_t>(1, record_size_));
+    block_.reserve(cycles_per_block_ * record_size_);
+
+    thread_ = std::thread(&sim_vector_writer::run, this);
+}
+
+sim_vector_writer::~sim_vector_writer() {
+    if (file_)
+        stop_thread();
+}
+
+void sim_vector_writer::finish() {
+    if (!file_)
+        return;
+
+    hand_over_block();
+    stop_thread();
+
+    if (write_failed_)
+        error_message(SIMULATION, unknown_location, "%s", "Could not write to the binary vector file.");
+}
+
+/* Waits for the writer thread to write the blocks handed over, and closes the file */
+void sim_vector_writer::stop_thread() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    pending_cv_.notify_one();
+    thread_.join();
+
+    fclose(file_);
+    file_ = NULL;
+}
+
+void sim_vector_writer::write_cycle(int cycle) {
+    size_t start = block_.size();
+    block_.resize(start + record_size_, 0);
+
+    size_t value_idx = 0;
+    for (int i = 0; i < lines_->count; i++) {
+        line_t* line = lines_->lines[i];
+        for (int j = 0; j < line->number_of_pins; j++, value_idx++) {
+            BitSpace::bit_value_t value = get_pin_value(line->pins[j], cycle);
+            block_[start + value_idx / 4] |= (uint8_t)(value << (2 * (value_idx % 4)));
+        }
+    }
+
+    if (++num_block_cycles_ == cycles_per_block_)
+        hand_over_block();
+}
+
+/* Queues the packed cycles for the writer thread, waiting for it if it is too far behind */
+void sim_vector_writer::hand_over_block() {
+    if (block_.empty())
+        return;
+
+    std::vector<uint8_t> next_block;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        written_cv_.wait(lock, [&] { return pending_blocks_.size() < MAX_PENDING_SIM_VECTOR_BLOCKS; });
+        if (write_failed_)
+            error_message(SIMULATION, unknown_location, "%s", "Could not write to the binary vector file.");
+        pending_blocks_.push_back(std::move(block_));
+        if (!spare_blocks_.empty()) {
+            next_block = std::move(spare_blocks_.back());
+            spare_blocks_.pop_back();
+        }
+    }
+    pending_cv_.notify_one();
+
+    next_block.clear();
+    next_block.reserve(cycles_per_block_ * record_size_);
+    block_ = std::move(next_block);
+    num_block_cycles_ = 0;
+}
+
+void sim_vector_writer::run() {
+    while (true) {
+        std::vector<uint8_t> block;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            pending_cv_.wait(lock, [&] { return stopping_ || !pending_blocks_.empty(); });
+            if (pending_blocks_.empty())
+                return;
+            block = std::move(pending_blocks_.front());
+            pending_blocks_.pop_front();
+        }
+        written_cv_.notify_one();
+
+        // errors are reported by the simulation thread, as this one can't throw them
+        bool written = (fwrite(block.data(), 1, block.size(), file_) == block.size());
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        write_failed_ = write_failed_ || !written;
+        spare_blocks_.push_back(std::move(block));
+    }
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright 2023 CAS—Atlantic (University of New Brunswick, CASA)
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef SIM_VECTOR_FILE_H
+#define SIM_VECTOR_FILE_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "odin_types.h"
+
+struct lines_t;
+
+/*
+ * Binary simulation vector files
+ *
+ * Writing the vectors as text formats every pin of every cycle, which dominates the
+ * run time of long simulations. With --sim_binary_output the output vectors are
+ * instead packed into fixed-size cycle records and written by a background thread,
+ * and can be converted back to the text vector format afterwards.
+ *
+ * File layout (integers are little-endian):
+ *   SIM_VECTOR_FILE_MAGIC
+ *   uint32 number of lines
+ *   per line: uint32 number of pins, uint32 name length, name
+ *   per cycle: the 2-bit value (see BitSpace) of every pin of every line, in the order
+ *              of the lines and of their pins, packed 4 to a byte and padded to a byte
+ */
+#define SIM_VECTOR_FILE_MAGIC "ODINVEC1"
+#define BINARY_OUTPUT_VECTOR_FILE_NAME "output_vectors.bin"
+
+/* Formats the values of a line of num_pins pins (pin 0 first) as in the text vector
+ * files: in binary if any value is unknown or there is a single pin, in hex otherwise */
+void append_vector_value(std::string& buffer, const BitSpace::bit_value_t* values, int num_pins);
+
+/* Converts the binary vector file to a text vector file */
+void convert_sim_vectors_to_text(const char* binary_file_name, const char* text_file_name);
+
+/*
+ * Packs the values of the lines on each cycle and hands them over, in blocks of
+ * cycles, to a thread writing them to the binary vector file. The lines must not
+ * change once the writer is created.
+ */
+class sim_vector_writer {
+  public:
+    sim_vector_writer(const char* file_name, lines_t* l);
+
+    // Closes the file, without writing the cycles which were not handed over (see finish())
+    ~sim_vector_writer();
+
+    sim_vector_writer(const sim_vector_writer&) = delete;
+    sim_vector_writer& operator=(const sim_vector_writer&) = delete;
+
+    // Records the values of the lines on the given cycle (which follows the previous one)
+    void write_cycle(int cycle);
+
+    // Writes the cycles left and closes the file
+    void finish();
+
+  private:
+    void hand_over_block();
+    void stop_thread();
+    void run();
+
+    lines_t* lines_;
+    FILE* file_;
+    size_t record_size_;
+    size_t cycles_per_block_;
+
+    // Cycles being packed by the simulation thread
+    std::vector<uint8_t> block_;
+    size_t num_block_cycles_ = 0;
+
+    std::mutex mutex_;
+    std::condition_variable written_cv_; // signaled when the writer thread takes a block
+    std::condition_variable pending_cv_; // signaled when a block is handed over
+    std::deque<std::vector<uint8_t>> pending_blocks_;
+    std::vector<std::vector<uint8_t>> spare_blocks_;
+    bool stopping_ = false;
+    bool write_failed_ = false;
+
+    std::thread thread_;
+};
+
+#endif
@@ -29,9 +29,12 @@
 #include <string>
 #include <sstream>
 #include <dlfcn.h>
+#include <condition_variable>
+#include <mutex>
 #include <thread>
 
 #include "simulate_blif.h"
+#include "sim_vector_file.h"
 #include "odin_buffer.h"
 #include "odin_util.h"
 
@@ -114,6 +117,15 @@ static inline bool is_clock_node(nnode_t* node) {
 }
 
 static void simulate_cycle(int cycle, stages_t* s);
+static void apply_next_test_vector(sim_data_t* sim_data, int cycle);
+
+// Number of cycles simulated at once by bit-parallel simulation (see init_bit_parallel_simulation())
+#define BIT_PARALLEL_LANES 64
+
+struct bit_parallel_sim_t;
+static bit_parallel_sim_t* init_bit_parallel_simulation(sim_data_t* sim_data);
+static void simulate_bit_parallel_cycles(bit_parallel_sim_t* bp, sim_data_t* sim_data, int first_cycle, int num_cycles);
+static void free_bit_parallel_simulation(bit_parallel_sim_t* bp);
 static stages_t* simulate_first_cycle(netlist_t* netlist, int cycle, lines_t* output_lines);
 
 static stages_t* stage_ordered_nodes(nnode_t** ordered_nodes, int num_ordered_nodes);
@@ -133,6 +145,7 @@ static void compute_generic_node(nnode_t* node, int cycle);
 static void compute_add_node(nnode_t* node, int cycle);
 static void compute_unary_sub_node(nnode_t* node, int cycle);
 
+static void initialize_pin(npin_t* pin);
 static void update_pin_value(npin_t* pin, BitSpace::bit_value_t value, int cycle);
 static int get_pin_cycle(npin_t* pin);
 
@@ -179,6 +192,7 @@ static void write_vector_headers(FILE* file, lines_t* l);
 
 static void write_vector_to_file(lines_t* l, FILE* file, int cycle);
 static void write_cycle_to_file(lines_t* l, FILE* file, int cycle);
+static void write_output_cycle(sim_data_t* sim_data, int cycle);
 
 static void write_vector_to_modelsim_file(lines_t* l, FILE* modelsim_out, int cycle);
 static void write_cycle_to_modelsim_file(netlist_t* netlist, lines_t* l, FILE* modelsim_out, int cycle);
@@ -196,6 +210,105 @@ static nnode_t* print_update_trace(nnode_t* bottom_node, int cycle);
 int number_of_workers = 0;
 int num_of_clock = 0;
 
+/*
+ * A pool of simulation threads, which evaluate the nodes of a stage together.
+ *
+ * The threads are started once for the whole simulation (rather than for every
+ * stage of every cycle), and wait on a condition variable between stages. Each
+ * stage is split in contiguous chunks, one per thread (including the calling
+ * thread), and the caller returns once every chunk is computed, so the stages
+ * are still computed one after the other.
+ */
+class simulation_thread_pool {
+  public:
+    explicit simulation_thread_pool(int num_threads)
+        : num_threads_(num_threads) {
+        for (int id = 1; id < num_threads_; id++)
+            threads_.emplace_back(&simulation_thread_pool::run, this, id);
+    }
+
+    ~simulation_thread_pool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        start_cv_.notify_all();
+        for (auto& thread : threads_)
+            thread.join();
+    }
+
+    // Computes the given nodes (which mustn't depend on each other) for the given cycle.
+    void compute_stage(nnode_t** nodes, int num_nodes, int cycle) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            nodes_ = nodes;
+            num_nodes_ = num_nodes;
+            cycle_ = cycle;
+            num_pending_ = num_threads_ - 1;
+            generation_++;
+        }
+        start_cv_.notify_all();
+
+        compute_chunk(0);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_cv_.wait(lock, [&] { return num_pending_ == 0; });
+    }
+
+  private:
+    void run(int id) {
+        int seen_generation = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                start_cv_.wait(lock, [&] { return stopping_ || generation_ != seen_generation; });
+                if (stopping_)
+                    return;
+                seen_generation = generation_;
+            }
+
+            compute_chunk(id);
+
+            bool done;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                done = (--num_pending_ == 0);
+            }
+            if (done)
+                done_cv_.notify_one();
+        }
+    }
+
+    void compute_chunk(int id) {
+        int start = (int)((long)num_nodes_ * id / num_threads_);
+        int end = (int)((long)num_nodes_ * (id + 1) / num_threads_);
+        for (int j = start; j < end; j++)
+            if (nodes_[j])
+                compute_and_store_value(nodes_[j], cycle_);
+    }
+
+    int num_threads_;
+    std::vector<std::thread> threads_;
+
+    std::mutex mutex_;
+    std::condition_variable start_cv_;
+    std::condition_variable done_cv_;
+    int generation_ = 0;   // Incremented for each stage, to wake up the threads
+    int num_pending_ = 0;  // Number of threads still computing the current stage
+    bool stopping_ = false;
+
+    // Current stage (set under mutex_ before the threads are woken up)
+    nnode_t** nodes_ = nullptr;
+    int num_nodes_ = 0;
+    int cycle_ = 0;
+};
+
+// Stages with fewer nodes than this are computed by the calling thread alone,
+// as waking up the other threads would cost more than it saves.
+#define MIN_PARALLEL_STAGE_SIZE 64
+
+static simulation_thread_pool* sim_thread_pool = NULL;
+
 /*
  * Performs simulation.
  */
@@ -213,7 +326,18 @@ void simulate_netlist(netlist_t* netlist) {
 
     simulate_steps(sim_data, min_coverage);
 
-    fflush(sim_data->out);
+    if (sim_data->binary_out) {
+        sim_data->binary_out->finish();
+
+        // The verification reads the text output vectors
+        if (global_args.sim_vector_output_file.provenance() == argparse::Provenance::SPECIFIED) {
+            std::string sim_directory = global_args.sim_directory.value();
+            convert_sim_vectors_to_text((sim_directory + "/" + BINARY_OUTPUT_VECTOR_FILE_NAME).c_str(),
+                                        (sim_directory + "/" + OUTPUT_VECTOR_FILE_NAME).c_str());
+        }
+    } else {
+        fflush(sim_data->out);
+    }
     fprintf(sim_data->modelsim_out, "run %ld\n", sim_data->num_vectors * 100);
 
     printf("\n");
@@ -237,8 +361,10 @@ void simulate_netlist(netlist_t* netlist) {
  */
 sim_data_t* init_simulation(netlist_t* netlist) {
     number_of_workers = global_args.parralelized_simulation.value();
-    if (number_of_workers > 1)
+    if (number_of_workers > 1) {
         printf("Executing simulation with maximum of %d threads\n", number_of_workers);
+        sim_thread_pool = new simulation_thread_pool(number_of_workers);
+    }
 
     num_of_clock = 0;
 
@@ -248,12 +374,16 @@ sim_data_t* init_simulation(netlist_t* netlist) {
     printf("Beginning simulation. Output_files located @: %s\n", global_args.sim_directory.value().c_str());
     fflush(stdout);
 
-    // Open the output vector file.
-    char out_vec_file[BUFFER_MAX_SIZE] = {0};
-    odin_sprintf(out_vec_file, "%s/%s", global_args.sim_directory.value().c_str(), OUTPUT_VECTOR_FILE_NAME);
-    sim_data->out = fopen(out_vec_file, "w");
-    if (!sim_data->out)
-        error_message(SIMULATION, unknown_location, "%s\n", "Could not create output vector file.");
+    // Open the output vector file. (The binary one is created once the output lines are known.)
+    sim_data->out = NULL;
+    sim_data->binary_out = NULL;
+    if (!global_args.sim_binary_output) {
+        char out_vec_file[BUFFER_MAX_SIZE] = {0};
+        odin_sprintf(out_vec_file, "%s/%s", global_args.sim_directory.value().c_str(), OUTPUT_VECTOR_FILE_NAME);
+        sim_data->out = fopen(out_vec_file, "w");
+        if (!sim_data->out)
+            error_message(SIMULATION, unknown_location, "%s\n", "Could not create output vector file.");
+    }
 
     // Open the input vector file.
     char in_vec_file[BUFFER_MAX_SIZE] = {0};
@@ -334,6 +464,9 @@ sim_data_t* init_simulation(netlist_t* netlist) {
 }
 
 sim_data_t* terminate_simulation(sim_data_t* sim_data) {
+    delete sim_thread_pool;
+    sim_thread_pool = NULL;
+
     free_stages(sim_data->stages);
 
     fclose(sim_data->act_out);
@@ -346,7 +479,9 @@ sim_data_t* terminate_simulation(sim_data_t* sim_data) {
     if (sim_data->in)
         fclose(sim_data->in);
 
-    fclose(sim_data->out);
+    if (sim_data->out)
+        fclose(sim_data->out);
+    delete sim_data->binary_out;
     vtr::free(sim_data);
     sim_data = NULL;
     return sim_data;
@@ -360,11 +495,31 @@ void simulate_steps(sim_data_t* sim_data, double min_coverage) {
 
     int increment_vector_by = global_args.sim_num_test_vectors;
 
+    // Bit-parallel simulation simulates many cycles at once, so it can't stop as soon as a coverage is reached
+    bool bit_parallel = global_args.sim_bit_parallel && min_coverage <= 0.0;
+    if (global_args.sim_bit_parallel && !bit_parallel)
+        warning_message(SIMULATION, unknown_location, "%s", "Bit-parallel simulation isn't supported with a target coverage, simulating one cycle at a time");
+    bit_parallel_sim_t* bp = NULL;
+
     double current_coverage = 0.0;
     int cycle = 0;
     while (cycle < sim_data->num_vectors) {
         double wave_start_time = wall_time();
 
+        if (bp) {
+            int num_cycles = (int)std::min((long)BIT_PARALLEL_LANES, sim_data->num_vectors - cycle);
+
+            double simulation_start_time = wall_time();
+            simulate_bit_parallel_cycles(bp, sim_data, cycle, num_cycles);
+            sim_data->simulation_time += wall_time() - simulation_start_time;
+            sim_data->total_time += wall_time() - wave_start_time;
+
+            cycle += num_cycles;
+            progress_bar_position = print_progress_bar(
+                cycle / (double)(sim_data->num_vectors), progress_bar_position, progress_bar_length, sim_data->total_time);
+            continue;
+        }
+
         // if we target a minimum coverage keep generating
         if (min_coverage > 0.0) {
             if (cycle + 1 == sim_data->num_vectors) {
@@ -395,9 +550,13 @@ void simulate_steps(sim_data_t* sim_data, double min_coverage) {
         single_step(sim_data, cycle);
 
         // Print netlist-specific statistics.
-        if (!cycle)
+        if (!cycle) {
             print_netlist_stats(sim_data->stages, sim_data->num_vectors);
 
+            if (bit_parallel)
+                bp = init_bit_parallel_simulation(sim_data);
+        }
+
         sim_data->total_time += wall_time() - wave_start_time;
 
         // Delay drawing of the progress bar until the second wave to improve the accuracy of the ETA.
@@ -408,34 +567,17 @@ void simulate_steps(sim_data_t* sim_data, double min_coverage) {
 
         cycle++;
     }
+
+    free_bit_parallel_simulation(bp);
 }
 
 /**
  * single step sim
  */
 int single_step(sim_data_t* sim_data, int cycle) {
-    test_vector* v = NULL;
-    // Assign vectors to lines, either by reading or generating them.
-    // Every second cycle gets a new vector.
-
     double simulation_start_time = wall_time();
 
-    // Perform simulation
-    if (sim_data->in) {
-        char buffer[BUFFER_MAX_SIZE];
-
-        if (!get_next_vector(sim_data->in, buffer))
-            error_message(SIMULATION, unknown_location, "%s\n", "Could not read next vector.");
-
-        v = parse_test_vector(buffer);
-    } else {
-        v = generate_random_test_vector(cycle, sim_data);
-    }
-
-    add_test_vector_to_lines(v, sim_data->input_lines, cycle);
-    write_cycle_to_file(sim_data->input_lines, sim_data->in_out, cycle);
-    write_cycle_to_modelsim_file(sim_data->netlist, sim_data->input_lines, sim_data->modelsim_out, cycle);
-    free_test_vector(v);
+    apply_next_test_vector(sim_data, cycle);
 
     if (!cycle) {
         // The first cycle produces the stages, and adds additional
@@ -449,59 +591,426 @@ int single_step(sim_data_t* sim_data, int cycle) {
     } else {
         simulate_cycle(cycle, sim_data->stages);
     }
-    write_cycle_to_file(sim_data->output_lines, sim_data->out, cycle);
+    write_output_cycle(sim_data, cycle);
 
     sim_data->simulation_time += wall_time() - simulation_start_time;
 
     return cycle + 1;
 }
 
+/*
+ * Assigns the vector of the given cycle to the input lines, either by reading
+ * or generating it, and writes it to the input vector files.
+ */
+static void apply_next_test_vector(sim_data_t* sim_data, int cycle) {
+    test_vector* v = NULL;
+    if (sim_data->in) {
+        char buffer[BUFFER_MAX_SIZE];
+
+        if (!get_next_vector(sim_data->in, buffer))
+            error_message(SIMULATION, unknown_location, "%s\n", "Could not read next vector.");
+
+        v = parse_test_vector(buffer);
+    } else {
+        v = generate_random_test_vector(cycle, sim_data);
+    }
+
+    add_test_vector_to_lines(v, sim_data->input_lines, cycle);
+    write_cycle_to_file(sim_data->input_lines, sim_data->in_out, cycle);
+    write_cycle_to_modelsim_file(sim_data->netlist, sim_data->input_lines, sim_data->modelsim_out, cycle);
+    free_test_vector(v);
+}
+
 /*
  * This simulates a single cycle using the stages generated
  * during the first cycle.
  *
- * simulation computes a small number of cycles sequentially and
- * a small number in parallel. The minimum parallel and sequential time is
- * taken for each stage, and that stage is computed in parallel for all subsequent
- * cycles if speedup is observed.
+ * The nodes of a stage don't depend on each other, so large stages are
+ * computed in parallel by the simulation threads (if any), one stage after
+ * the other.
  */
+static void simulate_cycle(int cycle, stages_t* s) {
+    for (int i = 0; i < s->count; i++) {
+        if (sim_thread_pool && s->counts[i] >= MIN_PARALLEL_STAGE_SIZE) {
+            sim_thread_pool->compute_stage(s->stages[i], s->counts[i], cycle);
+        } else {
+            for (int j = 0; j < s->counts[i]; j++)
+                if (s->stages[i][j])
+                    compute_and_store_value(s->stages[i][j], cycle);
+        }
+    }
+}
+
+/*
+ * Bit-parallel simulation (--bit_parallel)
+ *
+ * Combinational netlists (LUTs, buffers, constants and I/Os only) don't carry
+ * any state from one cycle to the next, so the cycles are independent: after
+ * the first cycle, they are simulated BIT_PARALLEL_LANES at a time, one cycle
+ * per bit (lane) of a machine word.
+ *
+ * The 2-bit value of a net (see BitSpace::bit_value_t) is stored as two bit
+ * planes, lo (bit 0: set for 1 and z) and hi (bit 1: set for x and z), so nodes
+ * are evaluated for all the lanes with a few bitwise operations. The input
+ * vectors are read or generated, and the output vectors are written, one cycle
+ * at a time exactly as by the cycle by cycle simulation, so the output files
+ * are identical.
+ *
+ * The stages are compiled once into a flat program: an array of fixed-size
+ * instructions over the contiguous value planes (indexed by net slot), so that
+ * simulating a block of cycles is a single loop over the instructions, without
+ * any dispatch on node types or traversal of nodes, pins and bit maps.
+ */
+
+enum bp_opcode_t {
+    BP_LUT,   // out = the LUT of inputs [first_input..first_input+num_inputs-1] (see compute_bit_parallel_lut())
+    BP_BUF,   // out = in, with z buffered as x
+    BP_COPY,  // out = in
+    BP_CONST, // out = value
+};
+
+struct bp_instr_t {
+    bp_opcode_t op;
+    int out;                     // Output slot
+    int in;                      // Input slot (BP_BUF, BP_COPY)
+    int first_input;             // BP_LUT: first input slot in bit_parallel_sim_t::lut_inputs
+    int first_literal;           // BP_LUT: first literal of the first line in bit_parallel_sim_t::lut_literals
+    int num_inputs;              // BP_LUT
+    int num_lines;               // BP_LUT
+    bool invert;                 // BP_LUT: output 0 (rather than 1) on matching lines
+    BitSpace::bit_value_t value; // BP_CONST
+};
+
+// The output pins of a node, for toggle counts and coverage
+struct bp_coverage_node_t {
+    nnode_t* node;
+    int first_pin; // In bit_parallel_sim_t::coverage_pins
+    int num_pins;
+};
+
+struct bit_parallel_sim_t {
+    // [0..num_slots-1] Bit planes of the values of each net (one lane per cycle)
+    std::vector<uint64_t> lo;
+    std::vector<uint64_t> hi;
+    // [0..num_slots-1] Lane 0 or 1 holding the value of the cycle preceding the current block (for coverage)
+    std::vector<uint64_t> prev_lo;
+    std::vector<uint64_t> prev_hi;
+
+    // Compiled stages
+    std::vector<bp_instr_t> program;
+    std::vector<int> lut_inputs;
+    std::vector<char> lut_literals; // '0', '1' or '-' for each input of each line of each LUT
+
+    std::vector<bp_coverage_node_t> coverage_nodes;
+    std::vector<npin_t*> coverage_pins;
+    std::vector<int> coverage_slots;
+    std::vector<unsigned long> coverage_counts; // Toggle counts of coverage_pins, written back to them after each block
+
+    std::vector<std::pair<npin_t*, int>> input_pins;
+    std::vector<std::pair<npin_t*, int>> output_pins;
+
+    // Scratch areas
+    std::vector<uint64_t> toggles;
+    std::vector<uint64_t> lut_lo;
+    std::vector<uint64_t> lut_hi;
+};
 
-static void compute_and_store_part(int start, int end, int current_stage, stages_t* s, int cycle) {
-    for (int j = start; j >= 0 && j <= end && j < s->counts[current_stage]; j++)
-        if (s->stages[current_stage][j])
-            compute_and_store_value(s->stages[current_stage][j], cycle);
+static bool is_bit_parallel_node(nnode_t* node) {
+    if (is_clock_node(node))
+        return false;
+
+    switch (node->type) {
+        case GENERIC:
+        case BUF_NODE:
+        case INPUT_NODE:
+        case OUTPUT_NODE:
+        case GND_NODE:
+        case VCC_NODE:
+        case PAD_NODE:
+            return true;
+        default:
+            return false;
+    }
 }
 
-static void simulate_cycle(int cycle, stages_t* s) {
-    double total_run_time = 0;
+/*
+ * Sets up bit-parallel simulation after the first cycle (i.e. compiles the stages),
+ * or returns NULL (with a warning) if the netlist isn't supported.
+ */
+static bit_parallel_sim_t* init_bit_parallel_simulation(sim_data_t* sim_data) {
+    stages_t* s = sim_data->stages;
     for (int i = 0; i < s->count; i++) {
-        double time = wall_time();
+        for (int j = 0; j < s->counts[i]; j++) {
+            nnode_t* node = s->stages[i][j];
+            if (node && !is_bit_parallel_node(node)) {
+                warning_message(SIMULATION, node->loc, "Node %s can't be simulated in bit-parallel mode (only combinational netlists of LUTs can), simulating one cycle at a time", node->name);
+                return NULL;
+            }
+        }
+    }
 
-        std::vector<std::thread> workers;
-        int previous_end = 0;
+    bit_parallel_sim_t* bp = new bit_parallel_sim_t;
 
-        int nodes_per_thread = s->counts[i] / number_of_workers;
-        int remainder_nodes_per_thread = s->counts[i] % number_of_workers;
+    // Nets share their value buffer with all their pins: give each buffer a slot
+    std::unordered_map<atomic_buffer*, int> slots;
+    auto get_slot = [&](npin_t* pin) {
+        if (!pin->values)
+            initialize_pin(pin);
+        auto ret = slots.insert({pin->values.get(), (int)slots.size()});
+        if (ret.second) {
+            BitSpace::bit_value_t value = get_pin_value(pin, 0);
+            bp->prev_lo.push_back(value & 1);
+            bp->prev_hi.push_back((value >> 1) & 1);
+        }
+        return ret.first->second;
+    };
 
-        for (int id = 0; id < number_of_workers; id++) {
-            int start = previous_end;
-            int end = start + nodes_per_thread + ((remainder_nodes_per_thread > 0) ? 1 : 0);
+    for (int i = 0; i < s->count; i++) {
+        for (int j = 0; j < s->counts[i]; j++) {
+            nnode_t* node = s->stages[i][j];
+            if (!node)
+                continue;
+
+            bp_instr_t instr = bp_instr_t();
+            switch (node->type) {
+                case GENERIC: {
+                    instr.op = BP_LUT;
+                    instr.out = get_slot(node->output_pins[0]);
+                    instr.num_inputs = 0;
+                    while (node->bit_map[0][instr.num_inputs] != 0)
+                        instr.num_inputs++;
+                    instr.num_lines = node->bit_map_line_count;
+                    instr.invert = (node->generic_output != BitSpace::_1);
+
+                    instr.first_input = (int)bp->lut_inputs.size();
+                    for (int k = 0; k < instr.num_inputs; k++)
+                        bp->lut_inputs.push_back(get_slot(node->input_pins[k]));
+
+                    instr.first_literal = (int)bp->lut_literals.size();
+                    for (int line = 0; line < instr.num_lines; line++)
+                        bp->lut_literals.insert(bp->lut_literals.end(), node->bit_map[line], node->bit_map[line] + instr.num_inputs);
+                    break;
+                }
+                case BUF_NODE:
+                case OUTPUT_NODE:
+                    instr.op = (node->type == BUF_NODE) ? BP_BUF : BP_COPY;
+                    instr.out = get_slot(node->output_pins[0]);
+                    instr.in = get_slot(node->input_pins[0]);
+                    break;
+                case VCC_NODE:
+                case GND_NODE:
+                case PAD_NODE:
+                    instr.op = BP_CONST;
+                    instr.out = get_slot(node->output_pins[0]);
+                    instr.value = (node->type == VCC_NODE) ? BitSpace::_1 : BitSpace::_0;
+                    break;
+                case INPUT_NODE:
+                default:
+                    // Set from the input lines
+                    for (int k = 0; k < node->num_output_pins; k++)
+                        get_slot(node->output_pins[k]);
+                    instr.op = BP_COPY;
+                    instr.out = -1;
+                    break;
+            }
+            if (instr.out >= 0)
+                bp->program.push_back(instr);
+            if (instr.op == BP_LUT && instr.num_inputs > (int)bp->lut_lo.size()) {
+                bp->lut_lo.resize(instr.num_inputs);
+                bp->lut_hi.resize(instr.num_inputs);
+            }
 
-            remainder_nodes_per_thread -= 1;
-            previous_end = end + 1;
+            // Same as compute_and_store_value()
+            if (node->type == INPUT_NODE || node->type == GND_NODE || node->type == VCC_NODE || node->type == PAD_NODE) {
+                node->covered = true;
+            } else {
+                bp_coverage_node_t coverage_node = {node, (int)bp->coverage_pins.size(), (int)node->num_output_pins};
+                for (int k = 0; k < node->num_output_pins; k++) {
+                    bp->coverage_pins.push_back(node->output_pins[k]);
+                    bp->coverage_slots.push_back(get_slot(node->output_pins[k]));
+                    bp->coverage_counts.push_back(node->output_pins[k]->coverage);
+                }
+                bp->coverage_nodes.push_back(coverage_node);
+                if (node->num_output_pins > (long)bp->toggles.size())
+                    bp->toggles.resize(node->num_output_pins);
+            }
+        }
+    }
+    size_t num_node_slots = slots.size();
 
-            if ((end - start) > 0) {
-                if (id < number_of_workers - 1) // if child threads
-                    workers.push_back(std::thread(compute_and_store_part, start, end, i, s, cycle));
-                else
-                    compute_and_store_part(start, end, i, s, cycle);
+    for (int i = 0; i < sim_data->input_lines->count; i++) {
+        line_t* line = sim_data->input_lines->lines[i];
+        for (int j = 0; j < line->number_of_pins; j++)
+            bp->input_pins.push_back({line->pins[j], get_slot(line->pins[j])});
+    }
+
+    for (int i = 0; i < sim_data->output_lines->count; i++) {
+        line_t* line = sim_data->output_lines->lines[i];
+        for (int j = 0; j < line->number_of_pins; j++)
+            bp->output_pins.push_back({line->pins[j], get_slot(line->pins[j])});
+    }
+
+    if (slots.size() != num_node_slots) {
+        warning_message(SIMULATION, unknown_location, "%s", "Some simulation lines aren't connected to simulated nodes, simulating one cycle at a time");
+        delete bp;
+        return NULL;
+    }
+
+    // Nets which are neither computed nor inputs (e.g. undriven pins) keep their value of the first cycle
+    bp->lo.resize(slots.size());
+    bp->hi.resize(slots.size());
+    for (size_t i = 0; i < slots.size(); i++) {
+        bp->lo[i] = bp->prev_lo[i] ? ~(uint64_t)0 : 0;
+        bp->hi[i] = bp->prev_hi[i] ? ~(uint64_t)0 : 0;
+    }
+
+    return bp;
+}
+
+static void free_bit_parallel_simulation(bit_parallel_sim_t* bp) {
+    delete bp;
+}
+
+/*
+ * Computes a LUT for all the lanes, matching the lines of its bit map in order
+ * like compute_generic_node(): a lane is x if an unknown input is reached
+ * before any line matches.
+ */
+static void compute_bit_parallel_lut(bit_parallel_sim_t* bp, const bp_instr_t& instr) {
+    uint64_t* in_lo = bp->lut_lo.data();
+    uint64_t* in_hi = bp->lut_hi.data();
+    const int* inputs = &bp->lut_inputs[instr.first_input];
+    for (int j = 0; j < instr.num_inputs; j++) {
+        in_lo[j] = bp->lo[inputs[j]];
+        in_hi[j] = bp->hi[inputs[j]];
+    }
+
+    uint64_t found = 0;
+    uint64_t unknown = 0;
+    const char* literals = &bp->lut_literals[instr.first_literal];
+    for (int line = 0; line < instr.num_lines; line++, literals += instr.num_inputs) {
+        uint64_t alive = ~(found | unknown);
+        for (int j = 0; j < instr.num_inputs && alive; j++) {
+            unknown |= alive & in_hi[j];
+            alive &= ~in_hi[j];
+            if (literals[j] == '1')
+                alive &= in_lo[j];
+            else if (literals[j] == '0')
+                alive &= ~in_lo[j];
+        }
+        found |= alive;
+    }
+
+    uint64_t value = instr.invert ? ~found : found;
+    bp->lo[instr.out] = value & ~unknown;
+    bp->hi[instr.out] = unknown;
+}
+
+/*
+ * Updates the toggle counts and coverage of the nodes for the given lanes, like
+ * compute_and_store_value() does cycle by cycle.
+ */
+static void update_bit_parallel_coverage(bit_parallel_sim_t* bp, uint64_t lane_mask, int num_lanes) {
+    for (const bp_coverage_node_t& coverage_node : bp->coverage_nodes) {
+        unsigned long* counts = &bp->coverage_counts[coverage_node.first_pin];
+        const int* slots = &bp->coverage_slots[coverage_node.first_pin];
+        int num_pins = coverage_node.num_pins;
+
+        // A pin toggles if its value changed, from a known value
+        uint64_t* toggles = bp->toggles.data();
+        bool all_covered = true;
+        for (int i = 0; i < num_pins; i++) {
+            int slot = slots[i];
+            uint64_t prev_lo = (bp->lo[slot] << 1) | bp->prev_lo[slot];
+            uint64_t prev_hi = (bp->hi[slot] << 1) | bp->prev_hi[slot];
+            toggles[i] = ~prev_hi & ((bp->lo[slot] ^ prev_lo) | (bp->hi[slot] ^ prev_hi)) & lane_mask;
+            all_covered = all_covered && counts[i] >= 2;
+        }
+
+        bool covered = true;
+        if (all_covered) {
+            // Common case: no toggle can uncover the node anymore
+            for (int i = 0; i < num_pins; i++)
+                counts[i] += __builtin_popcountll(toggles[i]);
+        } else {
+            for (int lane = 0; lane < num_lanes; lane++) {
+                covered = true;
+                for (int i = 0; i < num_pins && covered; i++) {
+                    if ((toggles[i] >> lane) & 1) {
+                        counts[i]++;
+                        if (counts[i] < 2)
+                            covered = false;
+                    }
+                }
             }
         }
+        coverage_node.node->covered = covered;
+    }
+
+    for (size_t i = 0; i < bp->coverage_pins.size(); i++)
+        bp->coverage_pins[i]->coverage = bp->coverage_counts[i];
+}
 
-        for (auto& worker : workers)
-            worker.join();
+/*
+ * Simulates num_cycles (up to BIT_PARALLEL_LANES) cycles, from first_cycle.
+ */
+static void simulate_bit_parallel_cycles(bit_parallel_sim_t* bp, sim_data_t* sim_data, int first_cycle, int num_cycles) {
+    oassert(num_cycles > 0 && num_cycles <= BIT_PARALLEL_LANES);
+    uint64_t lane_mask = (num_cycles == BIT_PARALLEL_LANES) ? ~(uint64_t)0 : (((uint64_t)1 << num_cycles) - 1);
 
-        total_run_time += wall_time() - time;
+    // Inputs
+    for (auto& input_pin : bp->input_pins) {
+        bp->lo[input_pin.second] = 0;
+        bp->hi[input_pin.second] = 0;
+    }
+    for (int lane = 0; lane < num_cycles; lane++) {
+        int cycle = first_cycle + lane;
+        apply_next_test_vector(sim_data, cycle);
+
+        for (auto& input_pin : bp->input_pins) {
+            BitSpace::bit_value_t value = get_pin_value(input_pin.first, cycle);
+            bp->lo[input_pin.second] |= (uint64_t)(value & 1) << lane;
+            bp->hi[input_pin.second] |= (uint64_t)((value >> 1) & 1) << lane;
+        }
+    }
+
+    // Run the program
+    for (const bp_instr_t& instr : bp->program) {
+        switch (instr.op) {
+            case BP_LUT:
+                compute_bit_parallel_lut(bp, instr);
+                break;
+            case BP_BUF:
+                bp->lo[instr.out] = bp->lo[instr.in] & ~bp->hi[instr.in];
+                bp->hi[instr.out] = bp->hi[instr.in];
+                break;
+            case BP_COPY:
+                bp->lo[instr.out] = bp->lo[instr.in];
+                bp->hi[instr.out] = bp->hi[instr.in];
+                break;
+            case BP_CONST:
+                bp->lo[instr.out] = (instr.value & 1) ? ~(uint64_t)0 : 0;
+                bp->hi[instr.out] = (instr.value & 2) ? ~(uint64_t)0 : 0;
+                break;
+        }
+    }
+
+    update_bit_parallel_coverage(bp, lane_mask, num_cycles);
+
+    for (size_t i = 0; i < bp->lo.size(); i++) {
+        bp->prev_lo[i] = (bp->lo[i] >> (num_cycles - 1)) & 1;
+        bp->prev_hi[i] = (bp->hi[i] >> (num_cycles - 1)) & 1;
+    }
+
+    // Outputs
+    for (int lane = 0; lane < num_cycles; lane++) {
+        int cycle = first_cycle + lane;
+        for (auto& output_pin : bp->output_pins) {
+            int slot = output_pin.second;
+            BitSpace::bit_value_t value = (BitSpace::bit_value_t)(((bp->lo[slot] >> lane) & 1) | (((bp->hi[slot] >> lane) & 1) << 1));
+            update_pin_value(output_pin.first, value, cycle);
+        }
+        write_output_cycle(sim_data, cycle);
     }
 }
 
@@ -706,7 +1215,7 @@ static stages_t* stage_ordered_nodes(nnode_t** ordered_nodes, int num_ordered_no
         bool is_stage_child_of = false;
         if (!is_child_of_stage)
             for (int j = 0; j < num_children; j++)
-                if ((is_stage_child_of = (stage_nodes.find(node) != stage_nodes.end())))
+                if ((is_stage_child_of = (stage_nodes.find(children[j]) != stage_nodes.end())))
                     break;
 
         // Start a new stage if this node is related to any node in the current stage.
@@ -1619,12 +2128,19 @@ static void compute_generic_node(nnode_t* node, int cycle) {
     while (bit_map[0][lut_size] != 0)
         lut_size++;
 
+    // Read the inputs once (rather than once per line of the bit map), into a
+    // scratch buffer of this simulation thread
+    thread_local std::vector<BitSpace::bit_value_t> input_values;
+    input_values.resize(lut_size);
+    for (int j = 0; j < lut_size; j++)
+        input_values[j] = get_pin_value(node->input_pins[j], cycle);
+
     int found = 0;
     int i;
     for (i = 0; i < line_count_bitmap && (!found); i++) {
         int j;
         for (j = 0; j < lut_size; j++) {
-            BitSpace::bit_value_t value = get_pin_value(node->input_pins[j], cycle);
+            BitSpace::bit_value_t value = input_values[j];
             if (BitSpace::is_unk[value]) {
                 update_pin_value(node->output_pins[0], BitSpace::_x, cycle);
                 return;
@@ -2481,58 +2997,45 @@ static void write_cycle_to_file(lines_t* l, FILE* file, int cycle) {
     write_vector_to_file(l, file, cycle);
 }
 
+/*
+ * Writes a wave of output vectors, to the binary output vector file
+ * with --sim_binary_output.
+ */
+static void write_output_cycle(sim_data_t* sim_data, int cycle) {
+    if (!global_args.sim_binary_output) {
+        write_cycle_to_file(sim_data->output_lines, sim_data->out, cycle);
+        return;
+    }
+
+    if (!cycle) {
+        char out_vec_file[BUFFER_MAX_SIZE] = {0};
+        odin_sprintf(out_vec_file, "%s/%s", global_args.sim_directory.value().c_str(), BINARY_OUTPUT_VECTOR_FILE_NAME);
+        sim_data->binary_out = new sim_vector_writer(out_vec_file, sim_data->output_lines);
+    }
+    sim_data->binary_out->write_cycle(cycle);
+}
+
 /*
  * Writes all values in the given lines to a line in the given file
  * for the given cycle.
  */
 static void write_vector_to_file(lines_t* l, FILE* file, int cycle) {
-    std::stringstream buffer;
-    int i;
+    // Formatted as the binary vector files are converted back to text
+    std::string buffer;
+    std::vector<BitSpace::bit_value_t> values;
 
-    for (i = 0; i < l->count; i++) {
-        buffer.str(std::string());
+    for (int i = 0; i < l->count; i++) {
         line_t* line = l->lines[i];
-        int num_pins = line->number_of_pins;
-
-        if (line_has_unknown_pin(line, cycle) || num_pins == 1) {
-            int j;
-            for (j = num_pins - 1; j >= 0; j--) {
-                BitSpace::bit_value_t value = get_line_pin_value(line, j, cycle);
+        values.resize(line->number_of_pins);
+        for (int j = 0; j < line->number_of_pins; j++)
+            values[j] = get_line_pin_value(line, j, cycle);
 
-                if (BitSpace::is_unk[value]) {
-                    buffer << "x";
-                } else {
-                    buffer << std::dec << (int)value;
-                }
-            }
-            // If there are no known values, print a single capital X.
-            // (Only for testing. Breaks machine readability.)
-            //if (!known_values && num_pins > 1)
-            //	odin_sprintf(buffer, "X");
-        } else {
-            buffer << "0X";
-
-            int hex_digit = 0;
-            int j;
-            for (j = num_pins - 1; j >= 0; j--) {
-                BitSpace::bit_value_t value = get_line_pin_value(line, j, cycle);
-
-                hex_digit += value << j % 4;
-
-                if (!(j % 4)) {
-                    buffer << std::hex << hex_digit;
-                    hex_digit = 0;
-                }
-            }
-        }
-        buffer << " ";
-        // Expand the value to fill to space under the header. (Gets ugly sometimes.)
-        //while (strlen(buffer) < strlen(l->lines[i]->name))
-        //	strcat(buffer," ");
-
-        fprintf(file, "%s", buffer.str().c_str());
+        append_vector_value(buffer, values.data(), line->number_of_pins);
+        buffer += ' ';
     }
-    fprintf(file, "\n");
+    buffer += '\n';
+
+    fwrite(buffer.data(), 1, buffer.size(), file);
 }
 
 /*
@@ -56,6 +56,8 @@
 
 #define DEFAULT_CLOCK_NAME "GLOBAL_SIM_BASE_CLK"
 
+class sim_vector_writer;
+
 struct line_t {
     int number_of_pins;
     int max_number_of_pins;
@@ -116,6 +118,7 @@ struct sim_data_t {
     lines_t* input_lines;
     lines_t* output_lines;
     FILE* out;
+    sim_vector_writer* binary_out; // writes the output vectors instead of out with --sim_binary_output
     FILE* in_out;
     FILE* act_out;
     FILE* modelsim_out;
@@ -29,20 +29,21 @@
 #include <cstdlib>
 #include <cstdint>
 #include <string>
-#include <unordered_map>
-#include <string>
+
+#include "vtr_flat_hash_map.h"
 
 class hash_table {
   private:
-    std::unordered_map<std::string, void*> my_map;
+    // open addressing: look-ups of the (many) blif names probe a flat array instead of chasing bucket lists
+    vtr::flat_hash_map<std::string, void*> my_map;
 
   public:
     // Adds an item to the hashtable.
-    void add(std::string key, void* item);
+    void add(const std::string& key, void* item);
     // Removes an item from the hashtable. If the item is not present, a null pointer is returned.
-    void* remove(std::string key);
+    void* remove(const std::string& key);
     // Gets an item from the hashtable without removing it. If the item is not present, a null pointer is returned.
-    void* get(std::string key);
+    void* get(const std::string& key);
     // Check to see if the hashtable is empty.
     bool is_empty();
     // calls free on each item.
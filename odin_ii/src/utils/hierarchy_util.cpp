@@ -61,6 +61,9 @@ sc_hierarchy* init_sc_hierarchy() {
     hierarchy->local_symbol_table = NULL;
     hierarchy->num_local_symbol_table = 0;
 
+    hierarchy->module_instance_names_sc = NULL;
+    hierarchy->num_indexed_module_instances = 0;
+
     return hierarchy;
 }
 
@@ -148,6 +151,9 @@ void free_sc_hierarchy(sc_hierarchy* to_free) {
     to_free->local_symbol_table = (ast_node_t**)vtr::free(to_free->local_symbol_table);
     to_free->local_symbol_table_sc = sc_free_string_cache(to_free->local_symbol_table_sc);
 
+    to_free->module_instance_names_sc = sc_free_string_cache(to_free->module_instance_names_sc);
+    to_free->num_indexed_module_instances = 0;
+
     to_free->instance_name_prefix = (char*)vtr::free(to_free->instance_name_prefix);
     to_free->scope_id = (char*)vtr::free(to_free->scope_id);
 
@@ -161,6 +167,33 @@ void free_sc_hierarchy(sc_hierarchy* to_free) {
     vtr::free(to_free);
 }
 
+/*---------------------------------------------------------------------------
+ * (function: has_module_instance_named)
+ * 	Returns whether an instance named instance_name is registered in the module
+ *  at the top of module_ref. Instance names are indexed as they're registered,
+ *  instead of comparing against every instance of the module at each lookup.
+ *-------------------------------------------------------------------------*/
+bool has_module_instance_named(sc_hierarchy* module_ref, const char* instance_name) {
+    ast_node_t* module = module_ref->top_node;
+    oassert(module && module->type == MODULE);
+
+    int num_instances = module->types.module.size_module_instantiations;
+    if (!module_ref->module_instance_names_sc || module_ref->num_indexed_module_instances > num_instances) {
+        sc_free_string_cache(module_ref->module_instance_names_sc);
+        module_ref->module_instance_names_sc = sc_new_string_cache();
+        module_ref->num_indexed_module_instances = 0;
+    }
+
+    /* index the instances registered since the last lookup */
+    for (int i = module_ref->num_indexed_module_instances; i < num_instances; i++) {
+        ast_node_t* instance = module->types.module.module_instantiations_instance[i];
+        sc_add_string(module_ref->module_instance_names_sc, instance->children[0]->identifier_node->types.identifier);
+    }
+    module_ref->num_indexed_module_instances = num_instances;
+
+    return sc_lookup_string(module_ref->module_instance_names_sc, instance_name) != -1;
+}
+
 /*---------------------------------------------------------------------------
  * (function: resolve_hierarchical_name_reference)
  *-------------------------------------------------------------------------*/
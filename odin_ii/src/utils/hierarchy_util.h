@@ -55,11 +55,16 @@ struct sc_hierarchy {
     int num_block_children;
 
     int num_unnamed_genblks;
+
+    /* index of the names of the instances registered in top_node's module_instantiations_instance */
+    STRING_CACHE* module_instance_names_sc;
+    int num_indexed_module_instances;
 };
 
 sc_hierarchy* init_sc_hierarchy();
 sc_hierarchy* copy_sc_hierarchy(sc_hierarchy* to_copy);
 void free_sc_hierarchy(sc_hierarchy* to_free);
 ast_node_t* resolve_hierarchical_name_reference(sc_hierarchy* local_ref, char* identifier);
+bool has_module_instance_named(sc_hierarchy* module_ref, const char* instance_name);
 
 #endif
\ No newline at end of file
@@ -75,6 +75,7 @@ struct nnode_t;
 struct npin_t;
 struct nnet_t;
 struct netlist_t;
+struct netlist_storage_t;
 
 /* the global arguments of the software */
 struct global_args_t {
@@ -96,6 +97,8 @@ struct global_args_t {
 
     argparse::ArgValue<std::string> top_level_module_name; // force the name of the top level module desired
 
+    argparse::ArgValue<std::string> abc_script; // ABC script optimizing and mapping the output logic in-process
+
     argparse::ArgValue<bool> write_netlist_as_dot;
     argparse::ArgValue<bool> write_ast_as_dot;
     argparse::ArgValue<bool> all_warnings;
@@ -137,6 +140,12 @@ struct global_args_t {
 
     argparse::ArgValue<int> parralelized_simulation;
     argparse::ArgValue<bool> parralelized_simulation_in_batch;
+    // Simulate many cycles of a combinational netlist at once, one per bit of a machine word
+    argparse::ArgValue<bool> sim_bit_parallel;
+    // Write the output vectors bit-packed, from a background thread
+    argparse::ArgValue<bool> sim_binary_output;
+    // Binary vector file to convert back to the text vector format
+    argparse::ArgValue<std::string> sim_convert_vectors;
     // deprecated since this should be defined when compiled
     argparse::ArgValue<int> sim_initial_value;
     // The seed for creating random simulation vector
@@ -528,6 +537,7 @@ struct nnode_t {
     ast_node_t* related_ast_node; // the abstract syntax node that made this node
 
     uintptr_t traverse_visited; // a way to mark if we've visited yet
+    std::atomic<unsigned char> cleanup_marks; // mark bits of the unused logic removal (see netlist_cleanup.cpp)
     stat_t stat;
 
     npin_t** input_pins; // the input pins
@@ -686,6 +696,8 @@ struct netlist_t {
     STRING_CACHE* out_pins_sc;
     STRING_CACHE* nodes_sc;
 
+    netlist_storage_t* storage; // pools the nodes, pins and nets built with the netlist come from
+
     long long num_of_type[operation_list_END];
     long long num_of_node;
     long long num_logic_element;
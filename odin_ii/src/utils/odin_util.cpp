@@ -673,22 +673,31 @@ std::string make_simple_name(char* input, const char* flatten_string, char flatt
 }
 
 /*-----------------------------------------------------------------------
- * (function: my_malloc_struct )
+ * (function: mark_unique_id )
+ * 	Stamps the unique_id (first member) of a newly allocated structure
  *-----------------------------------------------------------------*/
-void* my_malloc_struct(long bytes_to_alloc) {
-    void* allocated = vtr::calloc(1, bytes_to_alloc);
+void mark_unique_id(void* allocated) {
     static long int m_id = 0;
 
     // ways to stop the execution at the point when a specific structure is built...note it needs to be m_id - 1 ... it's unique_id in most data structures
     //oassert(m_id != 193);
 
+    *((long int*)allocated) = m_id++;
+}
+
+/*-----------------------------------------------------------------------
+ * (function: my_malloc_struct )
+ *-----------------------------------------------------------------*/
+void* my_malloc_struct(long bytes_to_alloc) {
+    void* allocated = vtr::calloc(1, bytes_to_alloc);
+
     if (allocated == NULL) {
         fprintf(stderr, "MEMORY FAILURE\n");
         oassert(0);
     }
 
     /* mark the unique_id */
-    *((long int*)allocated) = m_id++;
+    mark_unique_id(allocated);
 
     return allocated;
 }
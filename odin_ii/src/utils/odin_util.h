@@ -65,6 +65,7 @@ long int pow2(int to_the_power);
 
 std::string make_simple_name(char* input, const char* flatten_string, char flatten_char);
 
+void mark_unique_id(void* allocated);
 void* my_malloc_struct(long bytes_to_alloc);
 
 void reverse_string(char* token, int length);
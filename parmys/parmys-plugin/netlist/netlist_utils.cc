@@ -364,6 +364,20 @@ void add_input_pin_to_node(nnode_t *node, npin_t *pin, int pin_idx)
     pin->pin_node_idx = pin_idx;
 }
 
+/*---------------------------------------------------------------------------------------------
+ * (function: grow_pin_array)
+ * 	Makes room for one more pin in an array of num_pins pins. Arrays grow by doubling,
+ *  so their capacity is the smallest power of 2 holding num_pins, and num_pins may only
+ *  shrink without reallocating.
+ *-------------------------------------------------------------------------------------------*/
+static npin_t **grow_pin_array(npin_t **pins, int num_pins)
+{
+    if (num_pins == 0 || (num_pins & (num_pins - 1)) == 0)
+        pins = (npin_t **)vtr::realloc(pins, sizeof(npin_t *) * (num_pins ? 2 * num_pins : 1));
+
+    return pins;
+}
+
 /*---------------------------------------------------------------------------------------------
  * (function: add_a_input_pin_to_spot_idx)
  *-------------------------------------------------------------------------------------------*/
@@ -373,7 +387,7 @@ void add_fanout_pin_to_net(nnet_t *net, npin_t *pin)
     oassert(pin != NULL);
     oassert(pin->type != OUTPUT);
     /* assumes the pin spots have been allocated and the pin */
-    net->fanout_pins = (npin_t **)vtr::realloc(net->fanout_pins, sizeof(npin_t *) * (net->num_fanout_pins + 1));
+    net->fanout_pins = grow_pin_array(net->fanout_pins, net->num_fanout_pins);
     net->fanout_pins[net->num_fanout_pins] = pin;
     net->num_fanout_pins++;
     /* record the node and pin spot in the pin */
@@ -407,8 +421,8 @@ void add_driver_pin_to_net(nnet_t *net, npin_t *pin)
     oassert(pin != NULL);
     oassert(pin->type != INPUT);
     /* assumes the pin spots have been allocated and the pin */
+    net->driver_pins = grow_pin_array(net->driver_pins, net->num_driver_pins);
     net->num_driver_pins++;
-    net->driver_pins = (npin_t **)vtr::realloc(net->driver_pins, net->num_driver_pins * sizeof(npin_t *));
     net->driver_pins[net->num_driver_pins - 1] = pin;
     /* record the node and pin spot in the pin */
     pin->net = net;
@@ -824,7 +838,7 @@ signal_list_t *prune_signal(signal_list_t *signalsvar, long signal_width, long p
  *-------------------------------------------------------------------------------------------*/
 void add_pin_to_signal_list(signal_list_t *list, npin_t *pin)
 {
-    list->pins = (npin_t **)vtr::realloc(list->pins, sizeof(npin_t *) * (list->count + 1));
+    list->pins = grow_pin_array(list->pins, list->count);
     list->pins[list->count] = pin;
     list->count++;
 }
@@ -48,6 +48,7 @@
 #include "subtractor.h"
 
 #include "ast_util.h"
+#include "parmys_cache.h"
 #include "parmys_update.h"
 #include "parmys_utils.h"
 
@@ -834,6 +835,155 @@ struct ParMYSPass : public Pass {
 
     static void log_time(double time) { log("%.1fms", time * 1000); }
 
+    /*
+     * Synthesizes the (flattened) design with Odin-II and replaces it by the partially mapped netlist
+     */
+    static void synthesize(RTLIL::Design *design, bool flag_visualize)
+    {
+        std::string DEFAULT_OUTPUT(".");
+
+        log("--------------------------------------------------------------------\n");
+        log("Creating Odin-II Netlist from Design\n");
+
+        std::vector<Bbox> black_boxes;
+
+        for (auto bb_module : design->modules()) {
+            if (bb_module->get_bool_attribute(ID::blackbox)) {
+
+                Bbox bb;
+
+                bb.name = str(bb_module->name);
+
+                std::map<int, RTLIL::Wire *> inputs, outputs;
+
+                for (auto wire : bb_module->wires()) {
+                    if (wire->port_input)
+                        inputs[wire->port_id] = wire;
+                    if (wire->port_output)
+                        outputs[wire->port_id] = wire;
+                }
+
+                for (auto &it : inputs) {
+                    RTLIL::Wire *wire = it.second;
+                    for (int i = 0; i < wire->width; i++)
+                        bb.inputs.push_back(str(RTLIL::SigSpec(wire, i)));
+                }
+
+                for (auto &it : outputs) {
+                    RTLIL::Wire *wire = it.second;
+                    for (int i = 0; i < wire->width; i++)
+                        bb.outputs.push_back(str(RTLIL::SigSpec(wire, i)));
+                }
+
+                black_boxes.push_back(bb);
+            }
+        }
+
+        netlist_t *transformed = to_netlist(design->top_module(), design);
+
+        double synthesis_time = wall_time();
+
+        log("--------------------------------------------------------------------\n");
+        log("High-level Synthesis Begin\n");
+
+        /* Performing elaboration for input digital circuits */
+        try {
+            elaborate(transformed);
+            log("Successful Elaboration of the design by Odin-II\n");
+            if (flag_visualize) {
+                graphVizOutputNetlist(DEFAULT_OUTPUT, "netlist.elaborated.net", 111, transformed);
+                log("Successful visualization of the elaborated netlist\n");
+            }
+        } catch (vtr::VtrError &vtr_error) {
+            log_error("Odin-II Failed to parse Verilog / load BLIF file: %s with exit code:%d \n", vtr_error.what(), ERROR_ELABORATION);
+        }
+
+        /* Performing netlist optimizations */
+        try {
+            optimization(transformed);
+            log("Successful Optimization of netlist by Odin-II\n");
+            if (flag_visualize) {
+                graphVizOutputNetlist(DEFAULT_OUTPUT, "netlist.optimized.net", 222, transformed);
+                log("Successful visualization of the optimized netlist\n");
+            }
+        } catch (vtr::VtrError &vtr_error) {
+            log_error("Odin-II Failed to perform netlist optimization %s with exit code:%d \n", vtr_error.what(), ERROR_OPTIMIZATION);
+        }
+
+        /* Performaing partial tech. map to the target device */
+        try {
+            techmap(transformed);
+            log("Successful Partial Technology Mapping by Odin-II\n");
+            if (flag_visualize) {
+                graphVizOutputNetlist(DEFAULT_OUTPUT, "netlist.mapped.net", 333, transformed);
+                log("Successful visualization of the mapped netlist\n");
+            }
+        } catch (vtr::VtrError &vtr_error) {
+            log_error("Odin-II Failed to perform partial mapping to target device %s with exit code:%d \n", vtr_error.what(), ERROR_TECHMAP);
+        }
+
+        synthesis_time = wall_time() - synthesis_time;
+
+        log("\nTotal Synthesis Time: ");
+        log_time(synthesis_time);
+        log("\n--------------------------------------------------------------------\n");
+        report(transformed);
+        log("\n--------------------------------------------------------------------\n");
+
+        log("Updating the Design\n");
+        Pass::call(design, "delete");
+
+        for (auto module : design->modules()) {
+            design->remove(module);
+        }
+
+        for (auto bb_module : black_boxes) {
+            Module *module = nullptr;
+            hashlib::dict<IdString, std::pair<int, bool>> wideports_cache;
+
+            module = new Module;
+            module->name = RTLIL::escape_id(bb_module.name);
+
+            if (design->module(module->name)) {
+                log_error("Duplicate definition of module %s!\n", log_id(module->name));
+            }
+
+            design->add(module);
+
+            for (auto b_wire : bb_module.inputs) {
+                RTLIL::Wire *wire = to_wire(b_wire, module);
+                wire->port_input = true;
+                std::pair<RTLIL::IdString, int> wp = wideports_split(RTLIL::unescape_id(b_wire));
+                if (!wp.first.empty() && wp.second >= 0) {
+                    wideports_cache[wp.first].first = std::max(wideports_cache[wp.first].first, wp.second + 1);
+                    wideports_cache[wp.first].second = true;
+                }
+            }
+
+            for (auto b_wire : bb_module.outputs) {
+                RTLIL::Wire *wire = to_wire(RTLIL::unescape_id(b_wire), module);
+                wire->port_output = true;
+                std::pair<RTLIL::IdString, int> wp = wideports_split(RTLIL::unescape_id(b_wire));
+                if (!wp.first.empty() && wp.second >= 0) {
+                    wideports_cache[wp.first].first = std::max(wideports_cache[wp.first].first, wp.second + 1);
+                    wideports_cache[wp.first].second = false;
+                }
+            }
+
+            handle_wideports_cache(&wideports_cache, module);
+
+            module->fixup_ports();
+            wideports_cache.clear();
+
+            module->attributes[ID::blackbox] = RTLIL::Const(1);
+        }
+
+        update_design(design, transformed);
+
+        free_netlist(transformed);
+        vtr::free(transformed);
+    }
+
     ParMYSPass() : Pass("parmys", "odin_ii partial mapper for Yosys") {}
     void help() override
     {
@@ -862,6 +1012,10 @@ struct ParMYSPass : public Pass {
         log("    -viz\n");
         log("        visualizes the netlist at 3 different stages: elaborated, optimized, and mapped.\n");
         log("\n");
+        log("    -cache CACHE_DIRECTORY\n");
+        log("        reuses the netlist synthesized by an earlier run from the same design, architecture,\n");
+        log("        configuration and options, stored in CACHE_DIRECTORY (created if needed), unless -viz is given\n");
+        log("\n");
     }
     void execute(std::vector<std::string> args, RTLIL::Design *design) override
     {
@@ -873,7 +1027,7 @@ struct ParMYSPass : public Pass {
         std::string arch_file_path;
         std::string config_file_path;
         std::string top_module_name;
-        std::string DEFAULT_OUTPUT(".");
+        std::string cache_dir;
 
         global_args.exact_mults = -1;
         global_args.mults_ratio = -1.0;
@@ -906,6 +1060,10 @@ struct ParMYSPass : public Pass {
                 flag_visualize = true;
                 continue;
             }
+            if (args[argidx] == "-cache" && argidx + 1 < args.size()) {
+                cache_dir = args[++argidx];
+                continue;
+            }
             if (args[argidx] == "-nopass") {
                 flag_no_pass = true;
                 continue;
@@ -1009,144 +1167,20 @@ struct ParMYSPass : public Pass {
 
         design->sort();
 
-        log("--------------------------------------------------------------------\n");
-        log("Creating Odin-II Netlist from Design\n");
-
-        std::vector<Bbox> black_boxes;
-
-        for (auto bb_module : design->modules()) {
-            if (bb_module->get_bool_attribute(ID::blackbox)) {
-
-                Bbox bb;
-
-                bb.name = str(bb_module->name);
-
-                std::map<int, RTLIL::Wire *> inputs, outputs;
-
-                for (auto wire : bb_module->wires()) {
-                    if (wire->port_input)
-                        inputs[wire->port_id] = wire;
-                    if (wire->port_output)
-                        outputs[wire->port_id] = wire;
-                }
-
-                for (auto &it : inputs) {
-                    RTLIL::Wire *wire = it.second;
-                    for (int i = 0; i < wire->width; i++)
-                        bb.inputs.push_back(str(RTLIL::SigSpec(wire, i)));
-                }
-
-                for (auto &it : outputs) {
-                    RTLIL::Wire *wire = it.second;
-                    for (int i = 0; i < wire->width; i++)
-                        bb.outputs.push_back(str(RTLIL::SigSpec(wire, i)));
-                }
-
-                black_boxes.push_back(bb);
-            }
+        std::string cache_file;
+        if (!cache_dir.empty()) {
+            std::vector<std::string> input_files = {flag_arch_file ? arch_file_path : "", flag_config_file ? config_file_path : ""};
+            std::string options = stringf("exact_mults=%d mults_ratio=%f lut_size=%d", global_args.exact_mults, global_args.mults_ratio, physical_lut_size);
+            cache_file = parmys_cache_file(cache_dir, parmys_cache_key(design, input_files, options));
         }
 
-        netlist_t *transformed = to_netlist(design->top_module(), design);
-
-        double synthesis_time = wall_time();
-
-        log("--------------------------------------------------------------------\n");
-        log("High-level Synthesis Begin\n");
-
-        /* Performing elaboration for input digital circuits */
-        try {
-            elaborate(transformed);
-            log("Successful Elaboration of the design by Odin-II\n");
-            if (flag_visualize) {
-                graphVizOutputNetlist(DEFAULT_OUTPUT, "netlist.elaborated.net", 111, transformed);
-                log("Successful visualization of the elaborated netlist\n");
-            }
-        } catch (vtr::VtrError &vtr_error) {
-            log_error("Odin-II Failed to parse Verilog / load BLIF file: %s with exit code:%d \n", vtr_error.what(), ERROR_ELABORATION);
-        }
+        if (cache_file.empty() || flag_visualize || !parmys_cache_load(design, cache_file)) {
+            synthesize(design, flag_visualize);
 
-        /* Performing netlist optimizations */
-        try {
-            optimization(transformed);
-            log("Successful Optimization of netlist by Odin-II\n");
-            if (flag_visualize) {
-                graphVizOutputNetlist(DEFAULT_OUTPUT, "netlist.optimized.net", 222, transformed);
-                log("Successful visualization of the optimized netlist\n");
-            }
-        } catch (vtr::VtrError &vtr_error) {
-            log_error("Odin-II Failed to perform netlist optimization %s with exit code:%d \n", vtr_error.what(), ERROR_OPTIMIZATION);
+            if (!cache_file.empty())
+                parmys_cache_store(design, cache_file);
         }
 
-        /* Performaing partial tech. map to the target device */
-        try {
-            techmap(transformed);
-            log("Successful Partial Technology Mapping by Odin-II\n");
-            if (flag_visualize) {
-                graphVizOutputNetlist(DEFAULT_OUTPUT, "netlist.mapped.net", 333, transformed);
-                log("Successful visualization of the mapped netlist\n");
-            }
-        } catch (vtr::VtrError &vtr_error) {
-            log_error("Odin-II Failed to perform partial mapping to target device %s with exit code:%d \n", vtr_error.what(), ERROR_TECHMAP);
-        }
-
-        synthesis_time = wall_time() - synthesis_time;
-
-        log("\nTotal Synthesis Time: ");
-        log_time(synthesis_time);
-        log("\n--------------------------------------------------------------------\n");
-        report(transformed);
-        log("\n--------------------------------------------------------------------\n");
-
-        log("Updating the Design\n");
-        Pass::call(design, "delete");
-
-        for (auto module : design->modules()) {
-            design->remove(module);
-        }
-
-        for (auto bb_module : black_boxes) {
-            Module *module = nullptr;
-            hashlib::dict<IdString, std::pair<int, bool>> wideports_cache;
-
-            module = new Module;
-            module->name = RTLIL::escape_id(bb_module.name);
-
-            if (design->module(module->name)) {
-                log_error("Duplicate definition of module %s!\n", log_id(module->name));
-            }
-
-            design->add(module);
-
-            for (auto b_wire : bb_module.inputs) {
-                RTLIL::Wire *wire = to_wire(b_wire, module);
-                wire->port_input = true;
-                std::pair<RTLIL::IdString, int> wp = wideports_split(RTLIL::unescape_id(b_wire));
-                if (!wp.first.empty() && wp.second >= 0) {
-                    wideports_cache[wp.first].first = std::max(wideports_cache[wp.first].first, wp.second + 1);
-                    wideports_cache[wp.first].second = true;
-                }
-            }
-
-            for (auto b_wire : bb_module.outputs) {
-                RTLIL::Wire *wire = to_wire(RTLIL::unescape_id(b_wire), module);
-                wire->port_output = true;
-                std::pair<RTLIL::IdString, int> wp = wideports_split(RTLIL::unescape_id(b_wire));
-                if (!wp.first.empty() && wp.second >= 0) {
-                    wideports_cache[wp.first].first = std::max(wideports_cache[wp.first].first, wp.second + 1);
-                    wideports_cache[wp.first].second = false;
-                }
-            }
-
-            handle_wideports_cache(&wideports_cache, module);
-
-            module->fixup_ports();
-            wideports_cache.clear();
-
-            module->attributes[ID::blackbox] = RTLIL::Const(1);
-        }
-
-        update_design(design, transformed);
-
         if (!flag_no_pass) {
             if (top_module_name.empty()) {
                 Pass::call(design, "hierarchy -check -auto-top -purge_lib");
@@ -1157,8 +1191,6 @@ struct ParMYSPass : public Pass {
 
         log("--------------------------------------------------------------------\n");
 
-        free_netlist(transformed);
-
         if (Arch.models) {
             free_arch(&Arch);
             Arch.models = nullptr;
@@ -1167,8 +1199,6 @@ struct ParMYSPass : public Pass {
         free_type_descriptors(logical_block_types);
         free_type_descriptors(physical_tile_types);
 
-        vtr::free(transformed);
-
         if (one_string) {
             vtr::free(one_string);
         }
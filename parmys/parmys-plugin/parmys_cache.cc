@@ -0,0 +1,117 @@
+/*
+ * Copyright 2022 CAS—Atlantic (University of New Brunswick, CASA)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "kernel/yosys.h"
+
+#include "backends/rtlil/rtlil_backend.h"
+#include "libs/sha1/sha1.h"
+
+#include <fstream>
+#include <unistd.h>
+#include <sstream>
+
+#include "parmys_cache.h"
+
+USING_YOSYS_NAMESPACE
+
+/* bump it whenever parmys changes the netlists it produces, to invalidate the caches */
+#define PARMYS_CACHE_VERSION "parmys-cache-1"
+
+/*---------------------------------------------------------------------------------------------
+ * (function: parmys_cache_key)
+ * 	SHA1 of the design (as RTLIL), of the content of the input files and of the options
+ *-------------------------------------------------------------------------------------------*/
+std::string parmys_cache_key(Design *design, const std::vector<std::string> &input_files, const std::string &options)
+{
+    SHA1 checksum;
+    checksum.update(PARMYS_CACHE_VERSION "\n");
+
+    std::ostringstream rtlil;
+    RTLIL_BACKEND::dump_design(rtlil, design, false);
+    checksum.update(rtlil.str());
+
+    for (const std::string &input_file : input_files) {
+        checksum.update("\nfile:" + (input_file.empty() ? std::string("none") : SHA1::from_file(input_file)));
+    }
+
+    checksum.update("\noptions:" + options);
+
+    return checksum.final();
+}
+
+/*---------------------------------------------------------------------------------------------
+ * (function: parmys_cache_file)
+ *-------------------------------------------------------------------------------------------*/
+std::string parmys_cache_file(const std::string &cache_dir, const std::string &key) { return cache_dir + "/" + key + ".il"; }
+
+/*---------------------------------------------------------------------------------------------
+ * (function: parmys_cache_load)
+ * 	Replaces the design by the cached one, returns false (leaving the design as is) on a miss
+ *-------------------------------------------------------------------------------------------*/
+bool parmys_cache_load(Design *design, const std::string &cache_file)
+{
+    if (!check_file_exists(cache_file))
+        return false;
+
+    log("Loading the synthesized design from cache file %s\n", cache_file.c_str());
+
+    Pass::call(design, "delete");
+
+    for (auto module : design->modules()) {
+        design->remove(module);
+    }
+
+    Pass::call(design, std::vector<std::string>{"read_rtlil", cache_file});
+
+    return true;
+}
+
+/*---------------------------------------------------------------------------------------------
+ * (function: parmys_cache_store)
+ * 	Writes the design to the cache, through a temporary file so that concurrent runs
+ *  never read a partially written cache file
+ *-------------------------------------------------------------------------------------------*/
+void parmys_cache_store(Design *design, const std::string &cache_file)
+{
+    std::string cache_dir = cache_file.substr(0, cache_file.find_last_of('/'));
+    if (!check_file_exists(cache_dir) && !create_directory(cache_dir)) {
+        log_warning("Could not create the parmys cache directory %s, the design is not cached\n", cache_dir.c_str());
+        return;
+    }
+
+    std::string temp_file = cache_file + stringf(".%d.tmp", getpid());
+    {
+        std::ofstream out(temp_file);
+        if (out.good()) {
+            RTLIL_BACKEND::dump_design(out, design, false);
+        }
+        if (!out.good()) {
+            log_warning("Could not write the parmys cache file %s, the design is not cached\n", temp_file.c_str());
+            out.close();
+            remove(temp_file.c_str());
+            return;
+        }
+    }
+
+    if (rename(temp_file.c_str(), cache_file.c_str()) != 0) {
+        log_warning("Could not write the parmys cache file %s, the design is not cached\n", cache_file.c_str());
+        remove(temp_file.c_str());
+        return;
+    }
+
+    log("Stored the synthesized design in cache file %s\n", cache_file.c_str());
+}
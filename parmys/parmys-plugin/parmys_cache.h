@@ -0,0 +1,39 @@
+/*
+ * Copyright 2022 CAS—Atlantic (University of New Brunswick, CASA)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef _PARMYS_CACHE_HPP_
+#define _PARMYS_CACHE_HPP_
+
+#include "kernel/yosys.h"
+
+#include <string>
+#include <vector>
+
+USING_YOSYS_NAMESPACE
+
+/*
+ * Cache of the designs synthesized by parmys, addressed by the content of their input:
+ * the (flattened) design handed to parmys, the configuration and architecture files and
+ * the options changing the synthesis. A design synthesized before is reloaded from the
+ * cache instead of being synthesized again.
+ */
+std::string parmys_cache_key(Design *design, const std::vector<std::string> &input_files, const std::string &options);
+std::string parmys_cache_file(const std::string &cache_dir, const std::string &key);
+bool parmys_cache_load(Design *design, const std::string &cache_file);
+void parmys_cache_store(Design *design, const std::string &cache_file);
+
+#endif //_PARMYS_CACHE_HPP_
@@ -21,20 +21,22 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <string>
-#include <unordered_map>
+
+#include "vtr_flat_hash_map.h"
 
 class Hashtable
 {
   private:
-    std::unordered_map<std::string, void *> my_map;
+    // open addressing: look-ups of the (many) net and node names probe a flat array instead of chasing bucket lists
+    vtr::flat_hash_map<std::string, void *> my_map;
 
   public:
     // Adds an item to the hashtable.
-    void add(std::string key, void *item);
+    void add(const std::string &key, void *item);
     // Removes an item from the hashtable. If the item is not present, a null pointer is returned.
-    void *remove(std::string key);
+    void *remove(const std::string &key);
     // Gets an item from the hashtable without removing it. If the item is not present, a null pointer is returned.
-    void *get(std::string key);
+    void *get(const std::string &key);
     // Check to see if the hashtable is empty.
     bool is_empty();
     // calls free on each item.
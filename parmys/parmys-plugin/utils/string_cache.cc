@@ -17,90 +17,138 @@
  */
 #include "string_cache.h"
 #include "vtr_memory.h"
-#include "vtr_util.h"
 #include <stdio.h>
 #include <string.h>
 
-unsigned long string_hash(STRING_CACHE *sc, const char *string);
-void generate_sc_hash(STRING_CACHE *sc);
+/* the strings are copied into blocks of at least this many bytes */
+#define SC_STRING_BLOCK_SIZE 65536
+/* initial number of slots of the table, a power of two */
+#define SC_INITIAL_NUM_SLOTS 256
 
-unsigned long string_hash(STRING_CACHE *sc, const char *string)
+struct sc_string_block_t {
+    sc_string_block_t *next;
+    long used;
+    long capacity;
+    /* followed by the capacity bytes of the block */
+};
+
+static unsigned long string_hash(const char *string, long *length);
+static long find_slot(STRING_CACHE *sc, const char *string, unsigned long hash);
+static void grow_slots(STRING_CACHE *sc);
+static char *copy_string(STRING_CACHE *sc, const char *string, long length);
+
+/*
+ * FNV-1a hash of the string, also returning its length
+ */
+static unsigned long string_hash(const char *string, long *length)
 {
-    long a, mod, mul;
-
-    a = 0;
-    mod = sc->mod;
-    mul = sc->mul;
-    for (int i = 0; string[i]; i++)
-        a = (a * mul + (unsigned char)string[i]) % mod;
-    return a;
+    unsigned long hash = 14695981039346656037UL;
+    long i;
+    for (i = 0; string[i]; i++) {
+        hash ^= (unsigned char)string[i];
+        hash *= 1099511628211UL;
+    }
+    *length = i;
+    return hash;
 }
 
-void generate_sc_hash(STRING_CACHE *sc)
+/*
+ * Returns the slot holding the given string, or the empty slot
+ * where it would be inserted
+ */
+static long find_slot(STRING_CACHE *sc, const char *string, unsigned long hash)
 {
-    long hash;
+    long mask = sc->num_slots - 1;
+    long slot = hash & mask;
+    while (sc->slots[slot] != -1) {
+        long i = sc->slots[slot];
+        if (sc->string_hash[i] == hash && !strcmp(sc->string[i], string))
+            break;
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
 
-    if (sc->string_hash != NULL)
-        vtr::free(sc->string_hash);
-    if (sc->next_string != NULL)
-        vtr::free(sc->next_string);
-    sc->string_hash_size = sc->size * 2 + 11;
-    sc->string_hash = (long *)sc_do_alloc(sc->string_hash_size, sizeof(long));
-    sc->next_string = (long *)sc_do_alloc(sc->size, sizeof(long));
-    memset(sc->string_hash, 0xff, sc->string_hash_size * sizeof(long));
-    memset(sc->next_string, 0xff, sc->size * sizeof(long));
+/*
+ * Doubles the number of slots of the table, placing the strings
+ * back by their stored hashes
+ */
+static void grow_slots(STRING_CACHE *sc)
+{
+    vtr::free(sc->slots);
+    sc->num_slots *= 2;
+    sc->slots = (long *)sc_do_alloc(sc->num_slots, sizeof(long));
+    memset(sc->slots, 0xff, sc->num_slots * sizeof(long));
+
+    long mask = sc->num_slots - 1;
     for (long i = 0; i < sc->free; i++) {
-        hash = string_hash(sc, sc->string[i]) % sc->string_hash_size;
-        sc->next_string[i] = sc->string_hash[hash];
-        sc->string_hash[hash] = i;
+        long slot = sc->string_hash[i] & mask;
+        while (sc->slots[slot] != -1)
+            slot = (slot + 1) & mask;
+        sc->slots[slot] = i;
     }
 }
 
+/*
+ * Copies the string into the storage of the cache
+ */
+static char *copy_string(STRING_CACHE *sc, const char *string, long length)
+{
+    sc_string_block_t *block = sc->blocks;
+    if (block == NULL || block->used + length + 1 > block->capacity) {
+        long capacity = (length + 1 > SC_STRING_BLOCK_SIZE) ? length + 1 : SC_STRING_BLOCK_SIZE;
+        block = (sc_string_block_t *)vtr::malloc(sizeof(sc_string_block_t) + capacity);
+        block->next = sc->blocks;
+        block->used = 0;
+        block->capacity = capacity;
+        sc->blocks = block;
+    }
+
+    char *copy = (char *)(block + 1) + block->used;
+    memcpy(copy, string, length + 1);
+    block->used += length + 1;
+    return copy;
+}
+
 STRING_CACHE *sc_new_string_cache(void)
 {
     STRING_CACHE *sc;
 
     sc = (STRING_CACHE *)sc_do_alloc(1, sizeof(STRING_CACHE));
     sc->size = 100;
-    sc->string_hash_size = 0;
-    sc->string_hash = NULL;
-    sc->next_string = NULL;
     sc->free = 0;
     sc->string = (char **)sc_do_alloc(sc->size, sizeof(char *));
     sc->data = (void **)sc_do_alloc(sc->size, sizeof(void *));
-    sc->mod = 834535547;
-    sc->mul = 247999;
-    generate_sc_hash(sc);
+    sc->string_hash = (unsigned long *)sc_do_alloc(sc->size, sizeof(unsigned long));
+    sc->num_slots = SC_INITIAL_NUM_SLOTS;
+    sc->slots = (long *)sc_do_alloc(sc->num_slots, sizeof(long));
+    memset(sc->slots, 0xff, sc->num_slots * sizeof(long));
+    sc->blocks = NULL;
     return sc;
 }
 
 long sc_lookup_string(STRING_CACHE *sc, const char *string)
 {
-    long i, hash;
-
     if (sc == NULL) {
         return -1;
     } else {
-        hash = string_hash(sc, string) % sc->string_hash_size;
-        i = sc->string_hash[hash];
-        while (i >= 0) {
-            if (!strcmp(sc->string[i], string))
-                return i;
-            i = sc->next_string[i];
-        }
-        return -1;
+        long length;
+        unsigned long hash = string_hash(string, &length);
+        return sc->slots[find_slot(sc, string, hash)];
     }
 }
 
 long sc_add_string(STRING_CACHE *sc, const char *string)
 {
     long i;
-    long hash;
+    long length;
     void *a;
 
-    i = sc_lookup_string(sc, string);
-    if (i >= 0)
-        return i;
+    unsigned long hash = string_hash(string, &length);
+    long slot = find_slot(sc, string, hash);
+    if (sc->slots[slot] != -1)
+        return sc->slots[slot];
+
     if (sc->free >= sc->size) {
         sc->size = sc->size * 2 + 10;
 
@@ -116,15 +164,25 @@ long sc_add_string(STRING_CACHE *sc, const char *string)
         vtr::free(sc->data);
         sc->data = (void **)a;
 
-        generate_sc_hash(sc);
+        a = sc_do_alloc(sc->size, sizeof(unsigned long));
+        if (sc->free > 0)
+            memcpy(a, sc->string_hash, sc->free * sizeof(unsigned long));
+        vtr::free(sc->string_hash);
+        sc->string_hash = (unsigned long *)a;
+    }
+
+    /* keep the table at most half full */
+    if (2 * (sc->free + 1) > sc->num_slots) {
+        grow_slots(sc);
+        slot = find_slot(sc, string, hash);
     }
+
     i = sc->free;
     sc->free++;
-    sc->string[i] = vtr::strdup(string);
+    sc->string[i] = copy_string(sc, string, length);
     sc->data[i] = NULL;
-    hash = string_hash(sc, string) % sc->string_hash_size;
-    sc->next_string[i] = sc->string_hash[hash];
-    sc->string_hash[hash] = i;
+    sc->string_hash[i] = hash;
+    sc->slots[slot] = i;
     return i;
 }
 
@@ -147,13 +205,13 @@ void *sc_do_alloc(long a, long b)
 STRING_CACHE *sc_free_string_cache(STRING_CACHE *sc)
 {
     if (sc != NULL) {
+        while (sc->blocks != NULL) {
+            sc_string_block_t *block = sc->blocks;
+            sc->blocks = block->next;
+            vtr::free(block);
+        }
+
         if (sc->string != NULL) {
-            for (long i = 0; i < sc->free; i++) {
-                if (sc->string[i] != NULL) {
-                    vtr::free(sc->string[i]);
-                }
-                sc->string[i] = NULL;
-            }
             vtr::free(sc->string);
         }
         sc->string = NULL;
@@ -168,10 +226,10 @@ STRING_CACHE *sc_free_string_cache(STRING_CACHE *sc)
         }
         sc->string_hash = NULL;
 
-        if (sc->next_string != NULL) {
-            vtr::free(sc->next_string);
+        if (sc->slots != NULL) {
+            vtr::free(sc->slots);
         }
-        sc->next_string = NULL;
+        sc->slots = NULL;
 
         vtr::free(sc);
     }
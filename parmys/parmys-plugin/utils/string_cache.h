@@ -18,16 +18,22 @@
 #ifndef _STRING_CACHE_H_
 #define _STRING_CACHE_H_
 
+/* a chunk of the storage of the cached strings */
+struct sc_string_block_t;
+
 struct STRING_CACHE {
     long size;
-    long string_hash_size;
     long free;
-    long mod;
-    long mul;
     char **string;
     void **data;
-    long *string_hash;
-    long *next_string;
+
+    /* open addressing table of the string indexes, probed linearly, -1 for empty slots */
+    long num_slots;
+    long *slots;
+    /* hash of each string, compared before the strings and reused when the table grows */
+    unsigned long *string_hash;
+    /* the strings are copied into large blocks rather than allocated one by one */
+    sc_string_block_t *blocks;
 };
 
 /* creates the hash where it is indexed by a string and the void ** holds the data */
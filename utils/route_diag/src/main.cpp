@@ -100,6 +100,7 @@ static void do_one_route(const Netlist<>& net_list,
                                                   router_opts.lookahead_type,
                                                   router_opts.write_router_lookahead,
                                                   router_opts.read_router_lookahead,
+                                                  router_opts.timing_model_cache_dir,
                                                   segment_inf,
                                                   is_flat);
 
@@ -139,7 +140,7 @@ static void do_one_route(const Netlist<>& net_list,
         tree.print();
         VTR_LOG("\n");
 
-        VTR_ASSERT_MSG(route_ctx.rr_node_route_inf[tree.root().inode].occ() <= rr_graph.node_capacity(tree.root().inode), "SOURCE should never be congested");
+        VTR_ASSERT_MSG(route_ctx.rr_node_cong_inf[tree.root().inode].occ() <= rr_graph.node_capacity(tree.root().inode), "SOURCE should never be congested");
     } else {
         VTR_LOG("Routing failed");
     }
@@ -165,6 +166,7 @@ static void profile_source(const Netlist<>& net_list,
                                                   router_opts.lookahead_type,
                                                   router_opts.write_router_lookahead,
                                                   router_opts.read_router_lookahead,
+                                                  router_opts.timing_model_cache_dir,
                                                   segment_inf,
                                                   is_flat);
     RouterDelayProfiler profiler(net_list, router_lookahead.get(), is_flat);
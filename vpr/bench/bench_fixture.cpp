@@ -0,0 +1,115 @@
+#include "bench_fixture.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include "vpr_api.h"
+#include "vpr_error.h"
+#include "vpr_signal_handler.h"
+#include "vtr_random.h"
+
+namespace bench {
+
+static constexpr size_t kNumLuts = 400;
+static constexpr size_t kNumInputs = 32;
+static constexpr uint64_t kCircuitSeed = 1;
+
+//LUT inputs are picked among the last kLocality signals
+static constexpr size_t kLocality = 64;
+
+void write_bench_circuit(const std::string& filename, size_t num_luts, size_t num_inputs, uint64_t seed) {
+    vtr::RandomNumberGenerator rng(seed);
+
+    std::vector<std::string> signals;
+    std::vector<bool> signal_used;
+    std::stringstream inputs;
+    for (size_t i = 0; i < num_inputs; ++i) {
+        signals.push_back("in" + std::to_string(i));
+        signal_used.push_back(false);
+        inputs << " " << signals.back();
+    }
+
+    std::stringstream logic;
+    for (size_t i = 0; i < num_luts; ++i) {
+        size_t window_begin = signals.size() - std::min(signals.size(), kLocality);
+        size_t window_size = signals.size() - window_begin;
+        size_t lut_size = std::min<size_t>(2 + rng.irand(4), window_size);
+
+        //Pick distinct inputs
+        std::vector<size_t> lut_inputs;
+        while (lut_inputs.size() < lut_size) {
+            size_t isignal = window_begin + rng.irand(window_size - 1);
+            if (std::find(lut_inputs.begin(), lut_inputs.end(), isignal) == lut_inputs.end()) {
+                lut_inputs.push_back(isignal);
+            }
+        }
+
+        std::string lut_output = "n" + std::to_string(i);
+        logic << ".names";
+        for (size_t isignal : lut_inputs) {
+            logic << " " << signals[isignal];
+            signal_used[isignal] = true;
+        }
+        logic << " " << lut_output << "\n";
+        logic << std::string(lut_size, '1') << " 1\n";
+
+        signals.push_back(lut_output);
+        signal_used.push_back(false);
+
+        if (rng.irand(3) == 0) {
+            std::string latch_output = "q" + std::to_string(i);
+            logic << ".latch " << lut_output << " " << latch_output << " re clk 0\n";
+            signal_used.back() = true;
+
+            signals.push_back(latch_output);
+            signal_used.push_back(false);
+        }
+    }
+
+    //Drive an output with every signal which is not used, so that nothing is swept away
+    std::stringstream outputs;
+    for (size_t isignal = num_inputs; isignal < signals.size(); ++isignal) {
+        if (!signal_used[isignal]) {
+            outputs << " out_" << signals[isignal];
+            logic << ".names " << signals[isignal] << " out_" << signals[isignal] << "\n";
+            logic << "1 1\n";
+        }
+    }
+
+    std::ofstream file(filename);
+    file << ".model bench\n";
+    file << ".inputs" << inputs.str() << " clk\n";
+    file << ".outputs" << outputs.str() << "\n";
+    file << logic.str();
+    file << ".end\n";
+
+    if (!file) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER, "Failed to write the benchmark circuit '%s'\n", filename.c_str());
+    }
+}
+
+BenchDesign::BenchDesign(const std::vector<std::string>& stage_args) {
+    write_bench_circuit(kCircuitFile, kNumLuts, kNumInputs, kCircuitSeed);
+
+    std::vector<const char*> argv = {
+        "bench_vpr",
+        kArchFile,
+        kCircuitFile,
+        "--route_chan_width", kChanWidth,
+        "--seed", "1"};
+    for (const std::string& arg : stage_args) {
+        argv.push_back(arg.c_str());
+    }
+
+    vpr_install_signal_handler();
+    vpr_init(argv.size(), argv.data(), &options_, &vpr_setup_, &arch_);
+
+    flow_succeeded_ = vpr_flow(vpr_setup_, arch_);
+}
+
+BenchDesign::~BenchDesign() {
+    vpr_free_all(arch_, vpr_setup_);
+}
+
+} // namespace bench
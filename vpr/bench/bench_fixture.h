@@ -0,0 +1,68 @@
+#ifndef BENCH_FIXTURE_H
+#define BENCH_FIXTURE_H
+
+/**
+ * @file
+ * @brief Fixtures shared by the VPR kernel microbenchmarks
+ *
+ * Every benchmark runs on the same small, fixed design: a seeded random circuit (see write_bench_circuit())
+ * implemented on the k6_frac_N10_mem32K_40nm architecture at a fixed channel width, so the results of
+ * two VPR versions (or two runs) are comparable.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "physical_types.h"
+#include "read_options.h"
+#include "vpr_types.h"
+
+namespace bench {
+
+constexpr const char kArchFile[] = "../../vtr_flow/arch/timing/k6_frac_N10_mem32K_40nm.xml";
+constexpr const char kCircuitFile[] = "bench_circuit.eblif";
+constexpr const char kChanWidth[] = "100";
+
+/**
+ * @brief Writes a random circuit of num_luts LUTs (of 2 to 6 inputs), about a quarter of which are latched
+ *
+ * Each LUT reads signals produced shortly before it, so the circuit has some locality (and the placer and router
+ * something to optimize). The circuit only depends on its parameters.
+ */
+void write_bench_circuit(const std::string& filename, size_t num_luts, size_t num_inputs, uint64_t seed);
+
+/**
+ * @brief The benchmark circuit run through the VPR flow, which is freed when the object is destroyed
+ *
+ * VPR keeps its state in the global context, so only one BenchDesign may exist at a time.
+ */
+class BenchDesign {
+  public:
+    /**
+     * @param stage_args The stages of the flow to run (e.g. {"--pack", "--place"}), and any other options.
+     *                   With no stage options all of them (packing, placement, routing and analysis) are run.
+     */
+    explicit BenchDesign(const std::vector<std::string>& stage_args = {});
+    ~BenchDesign();
+
+    BenchDesign(const BenchDesign&) = delete;
+    BenchDesign& operator=(const BenchDesign&) = delete;
+
+    ///@brief Returns true if the flow implemented the design
+    bool flow_succeeded() const { return flow_succeeded_; }
+
+    t_vpr_setup& vpr_setup() { return vpr_setup_; }
+    t_arch& arch() { return arch_; }
+
+  private:
+    t_options options_;
+    t_arch arch_;
+    t_vpr_setup vpr_setup_;
+    bool flow_succeeded_ = false;
+};
+
+} // namespace bench
+
+#endif /* BENCH_FIXTURE_H */
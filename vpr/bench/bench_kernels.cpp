@@ -0,0 +1,242 @@
+/**
+ * @file
+ * @brief Microbenchmarks of the core VPR kernels
+ *
+ * Run with e.g.
+ *
+ *      bench_vpr --reporter xml::out=bench_vpr.xml
+ *
+ * to get the results in a machine readable form (one <BenchmarkResults> element, with the mean, standard
+ * deviation and outliers of the samples, per benchmark) which can be tracked from version to version.
+ * A group of kernels is selected by its tag, e.g. bench_vpr "[route]".
+ */
+
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+
+#include "bench_fixture.h"
+
+#include "AnalysisDelayCalculator.h"
+#include "concrete_timing_info.h"
+#include "connection_router.h"
+#include "globals.h"
+#include "heap_type.h"
+#include "net_delay.h"
+#include "route_net.h"
+#include "router_lookahead.h"
+#include "vpr_api.h"
+#include "vpr_net_pins_matrix.h"
+#include "vtr_random.h"
+
+namespace {
+
+// Number of items pushed to (and popped from) the heaps
+static constexpr size_t kNumHeapItems = 100000;
+
+// Number of connections routed (and looked up in the lookahead)
+static constexpr size_t kMaxConnections = 500;
+
+// The (source, sink) rr nodes of the connections of the routed netlist
+static std::vector<std::pair<RRNodeId, RRNodeId>> routed_connections(size_t max_connections) {
+    const auto& route_ctx = g_vpr_ctx.routing();
+
+    std::vector<std::pair<RRNodeId, RRNodeId>> connections;
+    for (const auto& net_terminals : route_ctx.net_rr_terminals) {
+        for (size_t ipin = 1; ipin < net_terminals.size() && connections.size() < max_connections; ++ipin) {
+            connections.emplace_back(net_terminals[0], net_terminals[ipin]);
+        }
+    }
+    return connections;
+}
+
+// The cost parameters of a connection of the given criticality
+static t_conn_cost_params connection_cost_params(const t_router_opts& router_opts, float criticality) {
+    t_conn_cost_params cost_params;
+    cost_params.criticality = criticality;
+    cost_params.astar_fac = router_opts.astar_fac;
+    cost_params.astar_offset = router_opts.astar_offset;
+    cost_params.bend_cost = router_opts.bend_cost;
+    return cost_params;
+}
+
+TEST_CASE("heap_operations", "[bench][route]") {
+    bench::BenchDesign design({"--pack"});
+    REQUIRE(design.flow_succeeded());
+    vpr_create_device_grid(design.vpr_setup(), design.arch());
+    const DeviceGrid& grid = g_vpr_ctx.device().grid;
+
+    // The costs of a wavefront grow as the search proceeds
+    vtr::RandomNumberGenerator rng(1);
+    std::vector<float> costs(kNumHeapItems);
+    for (size_t i = 0; i < kNumHeapItems; ++i) {
+        costs[i] = i * 1e-12 + rng.frand() * 1e-9;
+    }
+
+    const std::vector<std::pair<e_heap_type, const char*>> heaps = {
+        {e_heap_type::BINARY_HEAP, "binary"},
+        {e_heap_type::FOUR_ARY_HEAP, "four_ary"},
+        {e_heap_type::EIGHT_ARY_HEAP, "eight_ary"},
+        {e_heap_type::RADIX_HEAP, "radix"},
+        {e_heap_type::BUCKET_HEAP_APPROXIMATION, "bucket"}};
+
+    for (const auto& heap_type : heaps) {
+        std::unique_ptr<HeapInterface> heap = make_heap(heap_type.first);
+        heap->init_heap(grid);
+
+        BENCHMARK(std::string(heap_type.second) + " heap: push and pop " + std::to_string(kNumHeapItems) + " items") {
+            for (size_t i = 0; i < costs.size(); ++i) {
+                t_heap* item = heap->alloc();
+                item->cost = costs[i];
+                item->index = RRNodeId(i);
+                heap->add_to_heap(item);
+            }
+
+            float cost_sum = 0.;
+            while (!heap->is_empty_heap()) {
+                t_heap* item = heap->get_heap_head();
+                cost_sum += item->cost;
+                heap->free(item);
+            }
+            return cost_sum;
+        };
+
+        heap->free_all_memory();
+    }
+}
+
+TEST_CASE("rr_graph", "[bench][route]") {
+    bench::BenchDesign design({"--pack"});
+    REQUIRE(design.flow_succeeded());
+
+    t_vpr_setup& vpr_setup = design.vpr_setup();
+    vpr_create_device_grid(vpr_setup, design.arch());
+    vpr_setup_clock_networks(vpr_setup, design.arch());
+    int chan_width = vpr_setup.RouterOpts.fixed_channel_width;
+
+    BENCHMARK("build the rr graph") {
+        vpr_create_rr_graph(vpr_setup, design.arch(), chan_width, false);
+        return g_vpr_ctx.device().rr_graph.num_nodes();
+    };
+
+    // Write the graph once, then benchmark loading it back
+    const std::string rr_graph_file = "bench_rr_graph.xml";
+    vpr_setup.RoutingArch.write_rr_graph_filename = rr_graph_file;
+    vpr_create_rr_graph(vpr_setup, design.arch(), chan_width, false);
+    vpr_setup.RoutingArch.write_rr_graph_filename.clear();
+    vpr_setup.RoutingArch.read_rr_graph_filename = rr_graph_file;
+
+    BENCHMARK("load the rr graph (xml)") {
+        vpr_create_rr_graph(vpr_setup, design.arch(), chan_width, false);
+        return g_vpr_ctx.device().rr_graph.num_nodes();
+    };
+}
+
+TEST_CASE("placement", "[bench][place]") {
+    // Place with a reduced effort, so a sample takes a fraction of a second
+    bench::BenchDesign design({"--pack", "--place", "--inner_num", "0.5"});
+    REQUIRE(design.flow_succeeded());
+
+    const Netlist<>& net_list = (const Netlist<>&)g_vpr_ctx.clustering().clb_nlist;
+
+    // The annealer's moves (try_swap(): propose, evaluate the cost deltas, commit or revert) dominate the placement time
+    BENCHMARK("anneal (inner_num 0.5, timing driven)") {
+        vpr_place(net_list, design.vpr_setup(), design.arch());
+        return g_vpr_ctx.placement().placement_id;
+    };
+}
+
+TEST_CASE("routed_design", "[bench][route][timing]") {
+    bench::BenchDesign design;
+    REQUIRE(design.flow_succeeded());
+
+    t_vpr_setup& vpr_setup = design.vpr_setup();
+    const t_router_opts& router_opts = vpr_setup.RouterOpts;
+    const auto& device_ctx = g_vpr_ctx.device();
+
+    auto connections = routed_connections(kMaxConnections);
+    REQUIRE(!connections.empty());
+
+    const RouterLookahead* router_lookahead = get_cached_router_lookahead(vpr_setup.RoutingArch,
+                                                                          router_opts.lookahead_type,
+                                                                          router_opts.write_router_lookahead,
+                                                                          router_opts.read_router_lookahead,
+                                                                          router_opts.timing_model_cache_dir,
+                                                                          vpr_setup.Segments,
+                                                                          /*is_flat=*/false);
+
+    t_conn_cost_params cost_params = connection_cost_params(router_opts, router_opts.max_criticality);
+
+    BENCHMARK("lookahead: expected cost of " + std::to_string(connections.size()) + " connections") {
+        float cost_sum = 0.;
+        for (const auto& connection : connections) {
+            cost_sum += router_lookahead->get_expected_cost(connection.first, connection.second, cost_params, 0.);
+        }
+        return cost_sum;
+    };
+
+    // Each connection is routed on its own, over the congestion of the final routing
+    update_rr_base_costs(1);
+
+    t_bb bounding_box;
+    bounding_box.xmin = 0;
+    bounding_box.xmax = device_ctx.grid.width() + 1;
+    bounding_box.ymin = 0;
+    bounding_box.ymax = device_ctx.grid.height() + 1;
+    bounding_box.layer_min = 0;
+    bounding_box.layer_max = device_ctx.grid.get_num_layers() - 1;
+
+    auto router = make_connection_router(router_opts.router_heap,
+                                         device_ctx.grid,
+                                         *router_lookahead,
+                                         device_ctx.rr_graph.rr_nodes(),
+                                         &device_ctx.rr_graph,
+                                         device_ctx.rr_rc_data,
+                                         device_ctx.rr_graph.rr_switch(),
+                                         g_vpr_ctx.mutable_routing().rr_node_route_inf,
+                                         /*is_flat=*/false);
+
+    std::unordered_map<RRNodeId, int> no_choking_spots;
+    ConnectionParameters conn_params(ParentNetId::INVALID(), -1, false, no_choking_spots);
+
+    BENCHMARK("router: route " + std::to_string(connections.size()) + " connections") {
+        RouterStats router_stats;
+        size_t num_routed = 0;
+        for (const auto& connection : connections) {
+            RouteTree tree(connection.first);
+
+            bool found_path;
+            std::tie(found_path, std::ignore, std::ignore) = router->timing_driven_route_connection_from_route_tree(tree.root(),
+                                                                                                                 connection.second,
+                                                                                                                 cost_params,
+                                                                                                                 bounding_box,
+                                                                                                                 router_stats,
+                                                                                                                 conn_params);
+            num_routed += found_path;
+            router->reset_path_costs();
+        }
+        return num_routed;
+    };
+
+    // Timing analysis of the routed design
+    const Netlist<>& net_list = (const Netlist<>&)g_vpr_ctx.clustering().clb_nlist;
+    NetPinsMatrix<float> net_delay = make_net_pins_matrix<float>(net_list);
+    load_net_delay_from_routing(net_list, net_delay);
+
+    const auto& atom_ctx = g_vpr_ctx.atom();
+    auto analysis_delay_calc = std::make_shared<AnalysisDelayCalculator>(atom_ctx.nlist, atom_ctx.lookup, net_delay, /*is_flat=*/false);
+    auto timing_info = make_setup_hold_timing_info(analysis_delay_calc, e_timing_update_type::FULL);
+
+    BENCHMARK("tatum: setup and hold analysis (full update)") {
+        timing_info->update();
+        return timing_info->setup_worst_negative_slack();
+    };
+}
+
+} // namespace
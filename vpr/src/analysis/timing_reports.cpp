@@ -19,10 +19,21 @@ void generate_setup_timing_stats(const std::string& prefix,
                                  bool is_flat,
                                  const BlkLocRegistry& blk_loc_registry) {
     auto& timing_ctx = g_vpr_ctx.timing();
-    auto& atom_ctx = g_vpr_ctx.atom();
 
     print_setup_timing_summary(*timing_ctx.constraints, *timing_info.setup_analyzer(), "Final ", analysis_opts.write_timing_summary);
 
+    write_setup_timing_reports(prefix, timing_info, delay_calc, analysis_opts, is_flat, blk_loc_registry);
+}
+
+void write_setup_timing_reports(const std::string& prefix,
+                                const SetupTimingInfo& timing_info,
+                                const AnalysisDelayCalculator& delay_calc,
+                                const t_analysis_opts& analysis_opts,
+                                bool is_flat,
+                                const BlkLocRegistry& blk_loc_registry) {
+    auto& timing_ctx = g_vpr_ctx.timing();
+    auto& atom_ctx = g_vpr_ctx.atom();
+
     VprTimingGraphResolver resolver(atom_ctx.nlist, atom_ctx.lookup, *timing_ctx.graph, delay_calc, is_flat, blk_loc_registry);
     resolver.set_detail_level(analysis_opts.timing_report_detail);
 
@@ -44,10 +55,21 @@ void generate_hold_timing_stats(const std::string& prefix,
                                 bool is_flat,
                                 const BlkLocRegistry& blk_loc_registry) {
     auto& timing_ctx = g_vpr_ctx.timing();
-    auto& atom_ctx = g_vpr_ctx.atom();
 
     print_hold_timing_summary(*timing_ctx.constraints, *timing_info.hold_analyzer(), "Final ");
 
+    write_hold_timing_reports(prefix, timing_info, delay_calc, analysis_opts, is_flat, blk_loc_registry);
+}
+
+void write_hold_timing_reports(const std::string& prefix,
+                               const HoldTimingInfo& timing_info,
+                               const AnalysisDelayCalculator& delay_calc,
+                               const t_analysis_opts& analysis_opts,
+                               bool is_flat,
+                               const BlkLocRegistry& blk_loc_registry) {
+    auto& timing_ctx = g_vpr_ctx.timing();
+    auto& atom_ctx = g_vpr_ctx.atom();
+
     VprTimingGraphResolver resolver(atom_ctx.nlist, atom_ctx.lookup, *timing_ctx.graph, delay_calc, is_flat, blk_loc_registry);
     resolver.set_detail_level(analysis_opts.timing_report_detail);
 
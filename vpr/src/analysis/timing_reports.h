@@ -7,6 +7,8 @@
 
 class BlkLocRegistry;
 
+//Print the final setup timing summary and write the setup timing reports
+
 void generate_setup_timing_stats(const std::string& prefix,
                                  const SetupTimingInfo& timing_info,
                                  const AnalysisDelayCalculator& delay_calc,
@@ -14,6 +16,16 @@ void generate_setup_timing_stats(const std::string& prefix,
                                  bool is_flat,
                                  const BlkLocRegistry& blk_loc_registry);
 
+//Write the setup timing, skew and unconstrained timing reports (without printing
+//anything, so it can run concurrently with other reports)
+void write_setup_timing_reports(const std::string& prefix,
+                                const SetupTimingInfo& timing_info,
+                                const AnalysisDelayCalculator& delay_calc,
+                                const t_analysis_opts& report_detail,
+                                bool is_flat,
+                                const BlkLocRegistry& blk_loc_registry);
+
+//Print the final hold timing summary and write the hold timing reports
 void generate_hold_timing_stats(const std::string& prefix,
                                 const HoldTimingInfo& timing_info,
                                 const AnalysisDelayCalculator& delay_calc,
@@ -21,4 +33,12 @@ void generate_hold_timing_stats(const std::string& prefix,
                                 bool is_flat,
                                 const BlkLocRegistry& blk_loc_registry);
 
+//Write the hold timing, skew and unconstrained timing reports (without printing anything)
+void write_hold_timing_reports(const std::string& prefix,
+                               const HoldTimingInfo& timing_info,
+                               const AnalysisDelayCalculator& delay_calc,
+                               const t_analysis_opts& report_detail,
+                               bool is_flat,
+                               const BlkLocRegistry& blk_loc_registry);
+
 #endif
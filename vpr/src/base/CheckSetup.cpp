@@ -6,6 +6,7 @@
 #include "echo_files.h"
 #include "read_xml_arch_file.h"
 #include "CheckSetup.h"
+#include "timing_model_cache.h"
 
 void CheckSetup(const t_packer_opts& PackerOpts,
                 const t_placer_opts& PlacerOpts,
@@ -44,6 +45,22 @@ void CheckSetup(const t_packer_opts& PackerOpts,
             "This is allowed, but strange, and circuit speed will suffer.\n");
     }
 
+    if (!RouterOpts.timing_model_cache_dir.empty()
+        && !router_lookahead_is_cacheable(RouterOpts.lookahead_type)
+        && !place_delay_model_is_cacheable(PlacerOpts.delay_model_type)) {
+        VTR_LOG_WARN(
+            "A timing model cache directory was specified, but neither the router lookahead "
+            "nor the placement delay model can be cached in this configuration; only the power technology properties "
+            "(with --power) may be.\n");
+    }
+
+    if (PlacerOpts.delay_model_type == PlaceDelayModelType::DELTA_LAZY
+        && PlacerOpts.place_delta_delay_matrix_calculation_method == e_place_delta_delay_algorithm::DIJKSTRA_EXPANSION) {
+        VTR_LOG_WARN(
+            "The lazy placement delay model routes each sampled connection on its own; "
+            "--place_delta_delay_matrix_calculation_method dijkstra is ignored.\n");
+    }
+
     if (!Timing.timing_analysis_enabled
         && (PlacerOpts.place_algorithm.is_timing_driven())) {
         /* May work, not tested */
@@ -56,6 +73,35 @@ void CheckSetup(const t_packer_opts& PackerOpts,
                         "A block location file requires that placement is enabled.\n");
     }
 
+    if (PlacerOpts.place_move_batch_size < 1) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "The placer move batch size (%d) must be at least 1.\n",
+                        PlacerOpts.place_move_batch_size);
+    }
+
+    if (PlacerOpts.place_move_candidates < 1) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "The number of placer move candidates (%d) must be at least 1.\n",
+                        PlacerOpts.place_move_candidates);
+    }
+
+    if (PlacerOpts.place_multilevel_levels < 0) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "The number of multilevel placement levels (%d) must not be negative.\n",
+                        PlacerOpts.place_multilevel_levels);
+    }
+
+    if (PlacerOpts.place_multilevel_temps < 1) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "The number of temperatures of each multilevel placement level (%d) must be at least 1.\n",
+                        PlacerOpts.place_multilevel_temps);
+    }
+
+    if (PlacerOpts.place_seeds < 1) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "The number of placement seeds (%d) must be at least 1.\n",
+                        PlacerOpts.place_seeds);
+    }
     if (PlacerOpts.place_algorithm.is_timing_driven() &&
         PlacerOpts.place_static_move_prob.size() > NUM_PL_MOVE_TYPES) {
         VPR_FATAL_ERROR(VPR_ERROR_OTHER,
@@ -119,7 +165,12 @@ void CheckSetup(const t_packer_opts& PackerOpts,
         }
     }
 
-    if (ServerOpts.is_server_mode_enabled) {
+    if (ServerOpts.is_server_mode_enabled && ServerOpts.is_daemon_mode_enabled) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "Server mode (--server) and daemon mode (--daemon) can not be used together.\n");
+    }
+
+    if (ServerOpts.is_server_mode_enabled || ServerOpts.is_daemon_mode_enabled) {
         if (ServerOpts.port_num < DYMANIC_PORT_RANGE_MIN || ServerOpts.port_num > DYNAMIC_PORT_RANGE_MAX) {
                 VPR_FATAL_ERROR(VPR_ERROR_OTHER,
                                 "Specified server port number `--port %d` is out of range [%d-%d]. Please specify a port number within that range.\n",
@@ -26,12 +26,16 @@
 
 #define MAX_SIZE_FACTOR 10000
 
+//Number of auto-sized devices kept for reuse (see create_device_grid())
+#define AUTO_SIZED_GRID_CACHE_SIZE 4
+
 using vtr::FormulaParser;
 using vtr::t_formula_data;
 
 static DeviceGrid auto_size_device_grid(const std::vector<t_grid_def>& grid_layouts, const std::map<t_logical_block_type_ptr, size_t>& minimum_instance_counts, float maximum_device_utilization);
 static std::vector<t_logical_block_type_ptr> grid_overused_resources(const DeviceGrid& grid, std::map<t_logical_block_type_ptr, size_t> instance_counts);
 static bool grid_satisfies_instance_counts(const DeviceGrid& grid, const std::map<t_logical_block_type_ptr, size_t>& instance_counts, float maximum_utilization);
+static float instance_area(const std::map<t_logical_block_type_ptr, size_t>& instance_counts);
 static DeviceGrid build_device_grid(const t_grid_def& grid_def, size_t width, size_t height, bool warn_out_of_range = true, const std::vector<t_logical_block_type_ptr>& limiting_resources = std::vector<t_logical_block_type_ptr>());
 
 static void CheckGrid(const DeviceGrid& grid);
@@ -45,13 +49,43 @@ static void set_grid_block_type(int priority,
                                 vtr::NdMatrix<int, 3>& grid_priorities,
                                 const t_metadata_dict* meta);
 
+/*
+ * The auto-sized devices built most recently. The flow sizes the device for the same
+ * resource requirements several times (e.g. at the end of packing, then for placement),
+ * so the devices are reused rather than rebuilt.
+ */
+struct t_auto_sized_grid {
+    const std::vector<t_grid_def>* grid_layouts;
+    std::map<t_logical_block_type_ptr, size_t> minimum_instance_counts;
+    float target_device_utilization;
+    DeviceGrid grid;
+};
+static std::vector<t_auto_sized_grid> auto_sized_grids;
+
 ///@brief Create the device grid based on resource requirements
 DeviceGrid create_device_grid(const std::string& layout_name, const std::vector<t_grid_def>& grid_layouts, const std::map<t_logical_block_type_ptr, size_t>& minimum_instance_counts, float target_device_utilization) {
     if (layout_name == "auto") {
+        auto is_same_request = [&](const t_auto_sized_grid& auto_sized_grid) {
+            return auto_sized_grid.grid_layouts == &grid_layouts
+                   && auto_sized_grid.target_device_utilization == target_device_utilization
+                   && auto_sized_grid.minimum_instance_counts == minimum_instance_counts;
+        };
+        auto iter = std::find_if(auto_sized_grids.begin(), auto_sized_grids.end(), is_same_request);
+        if (iter != auto_sized_grids.end()) {
+            return iter->grid;
+        }
+
         //Auto-size the device
         //
         //Note that we treat the target device utilization as a maximum
-        return auto_size_device_grid(grid_layouts, minimum_instance_counts, target_device_utilization);
+        DeviceGrid grid = auto_size_device_grid(grid_layouts, minimum_instance_counts, target_device_utilization);
+
+        if (auto_sized_grids.size() == AUTO_SIZED_GRID_CACHE_SIZE) {
+            auto_sized_grids.erase(auto_sized_grids.begin());
+        }
+        auto_sized_grids.push_back({&grid_layouts, minimum_instance_counts, target_device_utilization, grid});
+
+        return grid;
     } else {
         //Use the specified device
 
@@ -174,42 +208,96 @@ static DeviceGrid auto_size_device_grid(const std::vector<t_grid_def>& grid_layo
         const auto& grid_def = *auto_layout_itr;
         VTR_ASSERT(grid_def.aspect_ratio >= 0.);
 
+        //Scale opposite dimension to match aspect ratio
+        auto grid_height = [&](size_t width) {
+            return size_t(vtr::nint(width / grid_def.aspect_ratio));
+        };
+
         //Initial size is num_layers x 3 x 3, the smallest possible while avoiding
         //start before end location issues with <perimeter> location
-        //specifications
-        size_t width = 3;
-        size_t height = 3;
-        std::vector<t_logical_block_type_ptr> limiting_resources;
-        size_t grid_size = 0;
-        do {
-            //Scale opposite dimension to match aspect ratio
-            height = vtr::nint(width / grid_def.aspect_ratio);
+        //specifications.
+        //
+        //The grid tiles cover at most num_layers x width x height tile units, so any
+        //smaller device would exceed the maximum utilization: start from the first one
+        //which may not
+        float min_instance_area = instance_area(minimum_instance_counts);
+        size_t num_layers = grid_def.layers.size();
+        size_t min_width = 3;
+        while (min_width * grid_height(min_width) < max_size
+               && min_instance_area / float(num_layers * min_width * grid_height(min_width)) > maximum_device_utilization) {
+            ++min_width;
+        }
+
+        //The largest width tried (the first whose grid size reaches max_size)
+        size_t max_width = min_width;
+        while (max_width * grid_height(max_width) < max_size) {
+            ++max_width;
+        }
 
+        //The widths tried so far (each device is built once)
+        struct t_tried_width {
+            bool fits = false;
+            std::vector<t_logical_block_type_ptr> overused_resources;
+        };
+        std::map<size_t, t_tried_width> tried_widths;
+        auto try_width = [&](size_t width) {
+            auto iter = tried_widths.find(width);
+            if (iter == tried_widths.end()) {
 #ifdef VERBOSE
-            VTR_LOG("Grid size: %zu x %zu (AR: %.2f) \n", width, height, float(width) / height);
+                VTR_LOG("Grid size: %zu x %zu (AR: %.2f) \n", width, grid_height(width), float(width) / grid_height(width));
 #endif
 
-            //Build the device
-            // Don't warn about out-of-range specifications since these can
-            // occur (harmlessly) at small device dimensions
-            grid = build_device_grid(grid_def, width, height, false, limiting_resources);
+                //Build the device
+                // Don't warn about out-of-range specifications since these can
+                // occur (harmlessly) at small device dimensions
+                DeviceGrid candidate_grid = build_device_grid(grid_def, width, grid_height(width), false);
 
-            //Check if it satisfies the block counts
-            if (grid_satisfies_instance_counts(grid, minimum_instance_counts, maximum_device_utilization)) {
-                //Re-build the grid at the final size with out-of-range
-                grid = build_device_grid(grid_def, width, height, false, limiting_resources);
-                return grid;
+                t_tried_width tried_width;
+                tried_width.fits = grid_satisfies_instance_counts(candidate_grid, minimum_instance_counts, maximum_device_utilization);
+                if (!tried_width.fits) {
+                    tried_width.overused_resources = grid_overused_resources(candidate_grid, minimum_instance_counts);
+                }
+                iter = tried_widths.emplace(width, std::move(tried_width)).first;
             }
+            return iter->second.fits;
+        };
 
-            limiting_resources = grid_overused_resources(grid, minimum_instance_counts);
-
-            //Determine grid size
-            grid_size = width * height;
+        //Grow the width by doubling steps until the device fits...
+        size_t failing_width = min_width - 1;
+        size_t fitting_width = 0;
+        for (size_t step = 1;; step *= 2) {
+            size_t width = std::min(failing_width + step, max_width);
+            if (try_width(width)) {
+                fitting_width = width;
+                break;
+            }
+            failing_width = width;
+            if (width == max_width) {
+                break;
+            }
+        }
 
-            //Increase the grid size
-            width++;
+        if (fitting_width != 0) {
+            //...then bisect down to the smallest fitting width (the resources grow with
+            //the device size, so the larger widths fit too)
+            while (fitting_width - failing_width > 1) {
+                size_t width = failing_width + (fitting_width - failing_width) / 2;
+                if (try_width(width)) {
+                    fitting_width = width;
+                } else {
+                    failing_width = width;
+                }
+            }
 
-        } while (grid_size < max_size);
+            //Build the grid at the final size, with the resources which limited the
+            //next smaller size
+            std::vector<t_logical_block_type_ptr> limiting_resources;
+            if (fitting_width > 3) {
+                try_width(fitting_width - 1);
+                limiting_resources = tried_widths[fitting_width - 1].overused_resources;
+            }
+            return build_device_grid(grid_def, fitting_width, grid_height(fitting_width), false, limiting_resources);
+        }
 
         //Maximum device size reached
         VPR_FATAL_ERROR(VPR_ERROR_OTHER,
@@ -755,6 +843,31 @@ static void CheckGrid(const DeviceGrid& grid) {
     }
 }
 
+///@brief Returns the area (in tile units) of the block instances
+static float instance_area(const std::map<t_logical_block_type_ptr, size_t>& instance_counts) {
+    float area = 0.;
+    for (auto& kv : instance_counts) {
+        if (is_empty_type(kv.first)) {
+            continue;
+        }
+
+        t_physical_tile_type_ptr type = pick_physical_type(kv.first);
+
+        size_t count = kv.second;
+
+        float type_area = type->width * type->height;
+
+        //Instances of multi-capaicty blocks take up less space
+        if (type->capacity != 0) {
+            type_area /= type->capacity;
+        }
+
+        area += type_area * count;
+    }
+
+    return area;
+}
+
 float calculate_device_utilization(const DeviceGrid& grid, const std::map<t_logical_block_type_ptr, size_t>& instance_counts) {
     //Record the resources of the grid
     std::map<t_physical_tile_type_ptr, size_t> grid_resources;
@@ -782,32 +895,15 @@ float calculate_device_utilization(const DeviceGrid& grid, const std::map<t_logi
         grid_area += type_area * count;
     }
 
-    //Determine the area of instances in tile units
-    float instance_area = 0.;
-    for (auto& kv : instance_counts) {
-        if (is_empty_type(kv.first)) {
-            continue;
-        }
-
-        t_physical_tile_type_ptr type = pick_physical_type(kv.first);
-
-        size_t count = kv.second;
-
-        float type_area = type->width * type->height;
-
-        //Instances of multi-capaicty blocks take up less space
-        if (type->capacity != 0) {
-            type_area /= type->capacity;
-        }
-
-        instance_area += type_area * count;
-    }
-
-    float utilization = instance_area / grid_area;
+    float utilization = instance_area(instance_counts) / grid_area;
 
     return utilization;
 }
 
+void clear_auto_sized_grids() {
+    auto_sized_grids.clear();
+}
+
 size_t count_grid_tiles(const DeviceGrid& grid) {
     return grid.get_num_layers() * grid.width() * grid.height();
 }
@@ -16,6 +16,7 @@ class DeviceGrid;
 
 ///@brief Find the device satisfying the specified minimum resources
 /// minimum_instance_counts and target_device_utilization are not required when specifying a fixed layout
+/// The last few auto-sized devices are kept, and returned again for the same resources (see clear_auto_sized_grids())
 DeviceGrid create_device_grid(const std::string& layout_name,
                               const std::vector<t_grid_def>& grid_layouts,
                               const std::map<t_logical_block_type_ptr, size_t>& minimum_instance_counts = {},
@@ -27,6 +28,9 @@ DeviceGrid create_device_grid(const std::string& layout_name,
                               size_t min_width,
                               size_t min_height);
 
+///@brief Drop the auto-sized devices kept by create_device_grid() (e.g. once the architecture is freed)
+void clear_auto_sized_grids();
+
 /**
  * @brief Calculate the device utilization
  *
@@ -2,6 +2,7 @@
 #include <vector>
 #include <sstream>
 #include <list>
+#include <algorithm>
 
 #include "vtr_assert.h"
 #include "vtr_util.h"
@@ -42,6 +43,7 @@ static void SetupServerOpts(const t_options& Options,
                             t_server_opts* ServerOpts);
 static void SetupRoutingArch(const t_arch& Arch, t_det_routing_arch* RoutingArch);
 static void SetupTiming(const t_options& Options, const bool TimingEnabled, t_timing_inf* Timing);
+static tatum::Time get_corner_delay_scale(const std::vector<float>& scales, const char* option_name);
 static void SetupSwitches(const t_arch& Arch,
                           t_det_routing_arch* RoutingArch,
                           const t_arch_switch_inf* ArchSwitches,
@@ -103,7 +105,7 @@ void SetupVPR(const t_options* Options,
               t_noc_opts* NocOpts,
               t_server_opts* ServerOpts,
               t_det_routing_arch* RoutingArch,
-              std::vector<t_lb_type_rr_node>** PackerRRGraphs,
+              t_lb_type_rr_graph** PackerRRGraphs,
               std::vector<t_segment_inf>& Segments,
               t_timing_inf* Timing,
               bool* ShowGraphics,
@@ -131,6 +133,8 @@ void SetupVPR(const t_options* Options,
     FileNameOpts->FlatPlaceFile = Options->FlatPlaceFile;
     FileNameOpts->PlaceFile = Options->PlaceFile;
     FileNameOpts->RouteFile = Options->RouteFile;
+    FileNameOpts->FPGAInterchangePhysicalFile = Options->write_interchange_physical_netlist;
+    FileNameOpts->compress_fpga_interchange_physical_file = Options->interchange_physical_netlist_gzip;
     FileNameOpts->ActFile = Options->ActFile;
     FileNameOpts->PowerFile = Options->PowerFile;
     FileNameOpts->CmosTechFile = Options->CmosTechFile;
@@ -139,10 +143,19 @@ void SetupVPR(const t_options* Options,
     FileNameOpts->write_vpr_constraints_file = Options->write_vpr_constraints_file;
     FileNameOpts->write_constraints_file = Options->write_constraints_file;
     FileNameOpts->write_flat_place_file = Options->write_flat_place_file;
+    FileNameOpts->write_place_binary_file = Options->write_place_binary_file;
     FileNameOpts->write_block_usage = Options->write_block_usage;
+    FileNameOpts->read_netlist_snapshot = Options->read_netlist_snapshot;
+    FileNameOpts->write_netlist_snapshot = Options->write_netlist_snapshot;
+    FileNameOpts->write_phase_trace = Options->write_phase_trace;
 
     FileNameOpts->verify_file_digests = Options->verify_file_digests;
 
+    if (!FileNameOpts->FPGAInterchangePhysicalFile.empty() && Options->arch_format != e_arch_format::FPGAInterchange) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "--write_interchange_physical_netlist requires an FPGA interchange device (--arch_format fpga-interchange)\n");
+    }
+
     SetupNetlistOpts(*Options, *NetlistOpts);
     SetupPlacerOpts(*Options, PlacerOpts);
     SetupAnnealSched(*Options, AnnealSched);
@@ -235,6 +248,7 @@ void SetupVPR(const t_options* Options,
     RoutingArch->write_rr_graph_filename = Options->write_rr_graph_file;
     RoutingArch->read_rr_graph_filename = Options->read_rr_graph_file;
 
+    device_ctx.inter_cluster_prog_routing_resources.clear();
     for (auto has_global_routing : Arch->layer_global_routing) {
         device_ctx.inter_cluster_prog_routing_resources.emplace_back(has_global_routing);
     }
@@ -286,6 +300,17 @@ void SetupVPR(const t_options* Options,
         }
     }
 
+    //A netlist snapshot already holds the packed netlist
+    if (!FileNameOpts->read_netlist_snapshot.empty()) {
+        if (PackerOpts->load_flat_placement) {
+            VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                            "A netlist snapshot can not be read when legalizing a flat placement\n");
+        }
+        if (PackerOpts->doPacking == STAGE_DO) {
+            PackerOpts->doPacking = STAGE_LOAD;
+        }
+    }
+
     ShowSetup(*vpr_setup);
 
     /* init global variables */
@@ -296,7 +321,12 @@ void SetupVPR(const t_options* Options,
 
     {
         vtr::ScopedStartFinishTimer t("Building complex block graph");
-        alloc_and_load_all_pb_graphs(PowerOpts->do_power, RouterOpts->flat_routing);
+        //The pb graphs of an architecture set up before (e.g. by a previous VPR daemon job) are kept
+        bool has_pb_graphs = std::any_of(device_ctx.logical_block_types.begin(), device_ctx.logical_block_types.end(),
+                                         [](const t_logical_block_type& type) { return type.pb_graph_head != nullptr; });
+        if (readArchFile || !has_pb_graphs) {
+            alloc_and_load_all_pb_graphs(PowerOpts->do_power, RouterOpts->flat_routing);
+        }
         *PackerRRGraphs = alloc_and_load_all_lb_type_rr_graph();
     }
 
@@ -326,6 +356,8 @@ void SetupVPR(const t_options* Options,
 
     *SaveGraphics = Options->save_graphics;
     *GraphicsCommands = Options->graphics_commands;
+    vpr_setup->SnapshotImagePrefix = Options->save_snapshot_images;
+    vpr_setup->SnapshotImageInterval = Options->snapshot_image_interval;
 
     if (getEchoEnabled() && isEchoFileEnabled(E_ECHO_ARCH)) {
         EchoArch(getEchoFileName(E_ECHO_ARCH), device_ctx.physical_tile_types, device_ctx.logical_block_types, Arch);
@@ -341,6 +373,35 @@ static void SetupTiming(const t_options& Options, const bool TimingEnabled, t_ti
 
     Timing->timing_analysis_enabled = TimingEnabled;
     Timing->SDCFile = Options.SDCFile;
+    Timing->corner_logic_delay_scales = Options.timing_corner_logic_delay_scale.value();
+    Timing->corner_routing_delay_scales = Options.timing_corner_routing_delay_scale.value();
+
+    auto& timing_ctx = g_vpr_ctx.mutable_timing();
+    timing_ctx.corner_logic_delay_scale = get_corner_delay_scale(Timing->corner_logic_delay_scales, "timing_corner_logic_delay_scale");
+    timing_ctx.corner_routing_delay_scale = get_corner_delay_scale(Timing->corner_routing_delay_scales, "timing_corner_routing_delay_scale");
+}
+
+/**
+ * @brief Converts the delay scale factors of each timing corner to the tatum::Time
+ *        lanes the corners are analyzed in.
+ */
+static tatum::Time get_corner_delay_scale(const std::vector<float>& scales, const char* option_name) {
+    constexpr size_t num_corners = tatum::Time::num_lanes();
+    if (scales.size() != 1 && scales.size() != num_corners) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "%s must specify 1 or %zu scale factor(s) (VPR was built with TATUM_TIME_VEC_WIDTH=%zu timing corners), but %zu were specified.\n",
+                        option_name, num_corners, num_corners, scales.size());
+    }
+
+    tatum::Time corner_scale;
+    for (size_t icorner = 0; icorner < num_corners; ++icorner) {
+        float scale = scales[scales.size() == 1 ? 0 : icorner];
+        if (!(scale > 0.)) {
+            VPR_FATAL_ERROR(VPR_ERROR_OTHER, "%s scale factors must be greater than 0.\n", option_name);
+        }
+        corner_scale.set_lane_value(icorner, scale);
+    }
+    return corner_scale;
 }
 
 /**
@@ -425,12 +486,14 @@ static void SetupRouterOpts(const t_options& Options, t_router_opts* RouterOpts)
     RouterOpts->astar_fac = Options.astar_fac;
     RouterOpts->astar_offset = Options.astar_offset;
     RouterOpts->router_profiler_astar_fac = Options.router_profiler_astar_fac;
+    RouterOpts->router_profiler_bidirectional_search = Options.router_profiler_bidirectional_search;
     RouterOpts->bb_factor = Options.bb_factor;
     RouterOpts->criticality_exp = Options.criticality_exp;
     RouterOpts->max_criticality = Options.max_criticality;
     RouterOpts->max_router_iterations = Options.max_router_iterations;
     RouterOpts->init_wirelength_abort_threshold = Options.router_init_wirelength_abort_threshold;
     RouterOpts->min_incremental_reroute_fanout = Options.min_incremental_reroute_fanout;
+    RouterOpts->incremental_reroute_overuse_threshold = Options.incremental_reroute_overuse_threshold;
     RouterOpts->incr_reroute_delay_ripup = Options.incr_reroute_delay_ripup;
     RouterOpts->pres_fac_mult = Options.pres_fac_mult;
     RouterOpts->max_pres_fac = Options.max_pres_fac;
@@ -445,13 +508,21 @@ static void SetupRouterOpts(const t_options& Options, t_router_opts* RouterOpts)
     RouterOpts->switch_usage_analysis = Options.full_stats;
 
     RouterOpts->verify_binary_search = Options.verify_binary_search;
+    RouterOpts->binary_search_warm_start = Options.binary_search_warm_start;
     RouterOpts->router_algorithm = Options.RouterAlgorithm;
+    RouterOpts->router_optimistic_concurrency = Options.router_optimistic_concurrency;
+    RouterOpts->router_deterministic = Options.router_deterministic;
+    if (RouterOpts->router_deterministic && RouterOpts->router_optimistic_concurrency) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER, "router_deterministic is not compatible with router_optimistic_concurrency.\n");
+    }
     RouterOpts->fixed_channel_width = Options.RouteChanWidth;
     RouterOpts->min_channel_width_hint = Options.min_route_chan_width_hint;
     RouterOpts->read_rr_edge_metadata = Options.read_rr_edge_metadata;
     RouterOpts->reorder_rr_graph_nodes_algorithm = Options.reorder_rr_graph_nodes_algorithm;
     RouterOpts->reorder_rr_graph_nodes_threshold = Options.reorder_rr_graph_nodes_threshold;
     RouterOpts->reorder_rr_graph_nodes_seed = Options.reorder_rr_graph_nodes_seed;
+    RouterOpts->compress_rr_graph_edges = Options.compress_rr_graph_edges;
+    RouterOpts->reuse_rr_indexed_data_delays = Options.reuse_rr_indexed_data_delays;
 
     RouterOpts->initial_pres_fac = Options.initial_pres_fac;
     RouterOpts->base_cost_type = Options.base_cost_type;
@@ -468,26 +539,54 @@ static void SetupRouterOpts(const t_options& Options, t_router_opts* RouterOpts)
     RouterOpts->route_bb_update = Options.route_bb_update;
     RouterOpts->clock_modeling = Options.clock_modeling;
     RouterOpts->two_stage_clock_routing = Options.two_stage_clock_routing;
+    RouterOpts->dedicated_clock_sink_routing = Options.dedicated_clock_sink_routing;
     RouterOpts->high_fanout_threshold = Options.router_high_fanout_threshold;
     RouterOpts->high_fanout_max_slope = Options.router_high_fanout_max_slope;
+    RouterOpts->high_fanout_batch_criticality = Options.router_high_fanout_batch_criticality;
     RouterOpts->router_debug_net = Options.router_debug_net;
     RouterOpts->router_debug_sink_rr = Options.router_debug_sink_rr;
     RouterOpts->router_debug_iteration = Options.router_debug_iteration;
     RouterOpts->lookahead_type = Options.router_lookahead_type;
+    RouterOpts->lookahead_correction = Options.router_lookahead_correction;
+    RouterOpts->global_route_guides = Options.router_global_route_guides;
     RouterOpts->max_convergence_count = Options.router_max_convergence_count;
     RouterOpts->reconvergence_cpd_threshold = Options.router_reconvergence_cpd_threshold;
     RouterOpts->initial_timing = Options.router_initial_timing;
     RouterOpts->update_lower_bound_delays = Options.router_update_lower_bound_delays;
+    RouterOpts->hold_full_update_interval = Options.router_hold_full_update_interval;
+    RouterOpts->hold_prune_slack = Options.router_hold_prune_slack;
     RouterOpts->first_iteration_timing_report_file = Options.router_first_iteration_timing_report_file;
     RouterOpts->strict_checks = Options.strict_checks;
 
     RouterOpts->write_router_lookahead = Options.write_router_lookahead;
     RouterOpts->read_router_lookahead = Options.read_router_lookahead;
+    RouterOpts->timing_model_cache_dir = Options.timing_model_cache_dir;
 
     RouterOpts->write_intra_cluster_router_lookahead = Options.write_intra_cluster_router_lookahead;
     RouterOpts->read_intra_cluster_router_lookahead = Options.read_intra_cluster_router_lookahead;
 
+    RouterOpts->write_route_checkpoint = Options.write_route_checkpoint;
+    RouterOpts->route_checkpoint_interval = Options.route_checkpoint_interval;
+    RouterOpts->route_resume = Options.route_resume;
+    if (RouterOpts->route_checkpoint_interval < 1) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER, "route_checkpoint_interval must be at least 1.\n");
+    }
+    if (!RouterOpts->route_resume.empty() && RouterOpts->fixed_channel_width == NO_FIXED_CHANNEL_WIDTH) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER, "route_resume requires a fixed channel width (route_chan_width).\n");
+    }
+
+    RouterOpts->router_phase_profile = Options.router_phase_profile;
+    RouterOpts->router_phase_profile_hw_counters = Options.router_phase_profile_hw_counters;
+
     RouterOpts->router_heap = Options.router_heap;
+
+    //Must be set before the RR graph is built
+    RouterOpts->rr_graph_huge_pages = Options.rr_graph_huge_pages;
+    RouterOpts->rr_graph_numa_interleave = Options.rr_graph_numa_interleave;
+    vtr::t_large_array_policy large_array_policy;
+    large_array_policy.huge_pages = RouterOpts->rr_graph_huge_pages;
+    large_array_policy.numa_interleave = RouterOpts->rr_graph_numa_interleave;
+    vtr::set_large_array_policy(large_array_policy);
     RouterOpts->exit_after_first_routing_iteration = Options.exit_after_first_routing_iteration;
 
     RouterOpts->check_route = Options.check_route;
@@ -592,6 +691,8 @@ void SetupPackerOpts(const t_options& Options,
     PackerOpts->transitive_fanout_threshold = Options.pack_transitive_fanout_threshold;
     PackerOpts->feasible_block_array_size = Options.pack_feasible_block_array_size;
     PackerOpts->use_attraction_groups = Options.use_attraction_groups;
+    PackerOpts->repack_overfull_regions_only = Options.pack_repack_overfull_regions_only;
+    PackerOpts->incremental_pack_file = Options.incremental_pack_file;
 
     //TODO: document?
     PackerOpts->inter_cluster_net_delay = 1.0; /* DEFAULT */
@@ -601,6 +702,7 @@ void SetupPackerOpts(const t_options& Options,
     PackerOpts->device_layout = Options.device_layout;
 
     PackerOpts->timing_update_type = Options.timing_update_type;
+    PackerOpts->timing_update_interval = Options.pack_timing_update_interval;
     PackerOpts->pack_num_moves = Options.pack_num_moves;
     PackerOpts->pack_move_type = Options.pack_move_type;
 }
@@ -666,6 +768,17 @@ static void SetupPlacerOpts(const t_options& Options, t_placer_opts* PlacerOpts)
     PlacerOpts->post_place_timing_report_file = Options.post_place_timing_report_file;
 
     PlacerOpts->rlim_escape_fraction = Options.place_rlim_escape_fraction;
+    PlacerOpts->place_move_batch_size = Options.place_move_batch_size;
+    PlacerOpts->place_move_candidates = Options.place_move_candidates;
+    PlacerOpts->place_multilevel_levels = Options.place_multilevel_levels;
+    PlacerOpts->place_multilevel_temps = Options.place_multilevel_temps;
+    PlacerOpts->place_seeds = Options.place_seeds;
+    PlacerOpts->place_checkpoint_file = Options.place_checkpoint_file;
+    PlacerOpts->place_resume_file = Options.place_resume_file;
+    PlacerOpts->place_anneal_telemetry_file = Options.place_anneal_telemetry_file;
+    PlacerOpts->place_anneal_schedule_model_file = Options.place_anneal_schedule_model_file;
+    PlacerOpts->place_congestion_weight = Options.place_congestion_weight;
+    PlacerOpts->place_congestion_util_threshold = Options.place_congestion_util_threshold;
     PlacerOpts->move_stats_file = Options.place_move_stats_file;
     PlacerOpts->placement_saves_per_temperature = Options.placement_saves_per_temperature;
     PlacerOpts->place_delta_delay_matrix_calculation_method = Options.place_delta_delay_matrix_calculation_method;
@@ -720,6 +833,7 @@ static void SetupAnalysisOpts(const t_options& Options, t_analysis_opts& analysi
 
     analysis_opts.post_synth_netlist_unconn_input_handling = Options.post_synth_netlist_unconn_input_handling;
     analysis_opts.post_synth_netlist_unconn_output_handling = Options.post_synth_netlist_unconn_output_handling;
+    analysis_opts.post_synth_netlist_compress = Options.post_synth_netlist_compress;
 
     analysis_opts.timing_update_type = Options.timing_update_type;
     analysis_opts.write_timing_summary = Options.write_timing_summary;
@@ -769,6 +883,8 @@ static void SetupNocOpts(const t_options& Options, t_noc_opts* NocOpts) {
         NocOpts->noc_sat_routing_num_workers = (int)Options.num_workers;
     }
     NocOpts->noc_sat_routing_log_search_progress = Options.noc_sat_routing_log_search_progress;
+    NocOpts->noc_reject_deadlocking_moves = Options.noc_reject_deadlocking_moves;
+    NocOpts->noc_initial_placement_restarts = Options.noc_initial_placement_restarts;
     NocOpts->noc_placement_file_name = Options.noc_placement_file_name;
 
 
@@ -776,6 +892,7 @@ static void SetupNocOpts(const t_options& Options, t_noc_opts* NocOpts) {
 
 static void SetupServerOpts(const t_options& Options, t_server_opts* ServerOpts) {
     ServerOpts->is_server_mode_enabled = Options.is_server_mode_enabled;
+    ServerOpts->is_daemon_mode_enabled = Options.is_daemon_mode_enabled;
     ServerOpts->port_num = Options.server_port_num;
 }
 
@@ -22,7 +22,7 @@ void SetupVPR(const t_options* Options,
               t_noc_opts* NocOpts,
               t_server_opts* ServerOpts,
               t_det_routing_arch* RoutingArch,
-              std::vector<t_lb_type_rr_node>** PackerRRGraphs,
+              t_lb_type_rr_graph** PackerRRGraphs,
               std::vector<t_segment_inf>& Segments,
               t_timing_inf* Timing,
               bool* ShowGraphics,
@@ -32,11 +32,26 @@ void ShowSetup(const t_vpr_setup& vpr_setup) {
     VTR_LOG("Circuit placement file: %s\n", vpr_setup.FileNameOpts.PlaceFile.c_str());
     VTR_LOG("Circuit routing file: %s\n", vpr_setup.FileNameOpts.RouteFile.c_str());
     VTR_LOG("Circuit SDC file: %s\n", vpr_setup.Timing.SDCFile.c_str());
+    if (vpr_setup.TimingEnabled) {
+        VTR_LOG("Timing corner logic delay scales:");
+        for (float scale : vpr_setup.Timing.corner_logic_delay_scales) {
+            VTR_LOG(" %g", scale);
+        }
+        VTR_LOG("\n");
+        VTR_LOG("Timing corner routing delay scales:");
+        for (float scale : vpr_setup.Timing.corner_routing_delay_scales) {
+            VTR_LOG(" %g", scale);
+        }
+        VTR_LOG("\n");
+    }
     if (vpr_setup.FileNameOpts.read_vpr_constraints_file.empty()) {
         VTR_LOG("Vpr floorplanning constraints file: not specified\n");
     } else {
         VTR_LOG("Vpr floorplanning constraints file: %s\n", vpr_setup.FileNameOpts.read_vpr_constraints_file.c_str());
     }
+    if (!vpr_setup.FileNameOpts.read_netlist_snapshot.empty()) {
+        VTR_LOG("Netlist snapshot file: %s\n", vpr_setup.FileNameOpts.read_netlist_snapshot.c_str());
+    }
     VTR_LOG("\n");
 
     VTR_LOG("Packer: %s\n", (vpr_setup.PackerOpts.doPacking ? "ENABLED" : "DISABLED"));
@@ -175,6 +190,7 @@ void writeClusteredNetlistStats(const std::string& block_usage_filename) {
 
     // Print out the human readable version to stdout
 
+    vtr::flush_log(); //Logged messages are written asynchronously: keep them before the stats
     stats.write(ClusteredNetlistStats::OutputFormat::HumanReadable, std::cout);
 
     if (!block_usage_filename.empty()) {
@@ -280,6 +296,10 @@ static void ShowRouterOpts(const t_router_opts& RouterOpts) {
                     break;
             }
     }
+    if (RouterOpts.router_algorithm == PARALLEL) {
+        VTR_LOG("RouterOpts.router_optimistic_concurrency: %s\n", RouterOpts.router_optimistic_concurrency ? "true" : "false");
+        VTR_LOG("RouterOpts.router_deterministic: %s\n", RouterOpts.router_deterministic ? "true" : "false");
+    }
 
     VTR_LOG("RouterOpts.base_cost_type: ");
     switch (RouterOpts.base_cost_type) {
@@ -360,6 +380,9 @@ static void ShowRouterOpts(const t_router_opts& RouterOpts) {
             case e_check_route_option::FULL:
                 VTR_LOG("FULL\n");
                 break;
+            case e_check_route_option::INCREMENTAL:
+                VTR_LOG("INCREMENTAL\n");
+                break;
             default:
                 VPR_FATAL_ERROR(VPR_ERROR_UNKNOWN, "Unknown check_route value\n");
         }
@@ -374,16 +397,28 @@ static void ShowRouterOpts(const t_router_opts& RouterOpts) {
     VTR_LOG("RouterOpts.max_pres_fac: %f\n", RouterOpts.max_pres_fac);
     VTR_LOG("RouterOpts.max_router_iterations: %d\n", RouterOpts.max_router_iterations);
     VTR_LOG("RouterOpts.min_incremental_reroute_fanout: %d\n", RouterOpts.min_incremental_reroute_fanout);
+    VTR_LOG("RouterOpts.incremental_reroute_overuse_threshold: %d\n", RouterOpts.incremental_reroute_overuse_threshold);
     VTR_LOG("RouterOpts.do_check_rr_graph: %s\n", RouterOpts.do_check_rr_graph ? "true" : "false");
     VTR_LOG("RouterOpts.verify_binary_search: %s\n", RouterOpts.verify_binary_search ? "true" : "false");
+    VTR_LOG("RouterOpts.binary_search_warm_start: %s\n", RouterOpts.binary_search_warm_start ? "true" : "false");
     VTR_LOG("RouterOpts.min_channel_width_hint: %d\n", RouterOpts.min_channel_width_hint);
     VTR_LOG("RouterOpts.read_rr_edge_metadata: %s\n", RouterOpts.read_rr_edge_metadata ? "true" : "false");
     VTR_LOG("RouterOpts.exit_after_first_routing_iteration: %s\n", RouterOpts.exit_after_first_routing_iteration ? "true" : "false");
+    if (!RouterOpts.write_route_checkpoint.empty()) {
+        VTR_LOG("RouterOpts.write_route_checkpoint: %s (every %d iterations)\n", RouterOpts.write_route_checkpoint.c_str(), RouterOpts.route_checkpoint_interval);
+    }
+    if (!RouterOpts.route_resume.empty()) {
+        VTR_LOG("RouterOpts.route_resume: %s\n", RouterOpts.route_resume.c_str());
+    }
+    if (!RouterOpts.router_phase_profile.empty()) {
+        VTR_LOG("RouterOpts.router_phase_profile: %s (hardware counters: %s)\n", RouterOpts.router_phase_profile.c_str(), RouterOpts.router_phase_profile_hw_counters ? "on" : "off");
+    }
 
     if (TIMING_DRIVEN == RouterOpts.router_algorithm) {
         VTR_LOG("RouterOpts.astar_fac: %f\n", RouterOpts.astar_fac);
         VTR_LOG("RouterOpts.astar_offset: %f\n", RouterOpts.astar_offset);
         VTR_LOG("RouterOpts.router_profiler_astar_fac: %f\n", RouterOpts.router_profiler_astar_fac);
+        VTR_LOG("RouterOpts.router_profiler_bidirectional_search: %s\n", RouterOpts.router_profiler_bidirectional_search ? "true" : "false");
         VTR_LOG("RouterOpts.criticality_exp: %f\n", RouterOpts.criticality_exp);
         VTR_LOG("RouterOpts.max_criticality: %f\n", RouterOpts.max_criticality);
         VTR_LOG("RouterOpts.init_wirelength_abort_threshold: %f\n", RouterOpts.init_wirelength_abort_threshold);
@@ -398,12 +433,15 @@ static void ShowRouterOpts(const t_router_opts& RouterOpts) {
         VTR_LOG("RouterOpts.save_routing_per_iteration: %s\n", RouterOpts.save_routing_per_iteration ? "true" : "false");
         VTR_LOG("RouterOpts.congested_routing_iteration_threshold_frac: %f\n", RouterOpts.congested_routing_iteration_threshold_frac);
         VTR_LOG("RouterOpts.high_fanout_threshold: %d\n", RouterOpts.high_fanout_threshold);
+        VTR_LOG("RouterOpts.high_fanout_batch_criticality: %f\n", RouterOpts.high_fanout_batch_criticality);
         VTR_LOG("RouterOpts.router_debug_net: %d\n", RouterOpts.router_debug_net);
         VTR_LOG("RouterOpts.router_debug_sink_rr: %d\n", RouterOpts.router_debug_sink_rr);
         VTR_LOG("RouterOpts.router_debug_iteration: %d\n", RouterOpts.router_debug_iteration);
         VTR_LOG("RouterOpts.max_convergence_count: %d\n", RouterOpts.max_convergence_count);
         VTR_LOG("RouterOpts.reconvergence_cpd_threshold: %f\n", RouterOpts.reconvergence_cpd_threshold);
         VTR_LOG("RouterOpts.update_lower_bound_delays: %s\n", RouterOpts.update_lower_bound_delays ? "true" : "false");
+        VTR_LOG("RouterOpts.hold_full_update_interval: %d\n", RouterOpts.hold_full_update_interval);
+        VTR_LOG("RouterOpts.hold_prune_slack: %g\n", RouterOpts.hold_prune_slack);
         VTR_LOG("RouterOpts.first_iteration_timing_report_file: %s\n", RouterOpts.first_iteration_timing_report_file.c_str());
 
         VTR_LOG("RouterOpts.route_bb_update: ");
@@ -429,6 +467,9 @@ static void ShowRouterOpts(const t_router_opts& RouterOpts) {
             case e_router_lookahead::COMPRESSED_MAP:
                 VTR_LOG("COMPRESSED_MAP\n");
                 break;
+            case e_router_lookahead::QUANTIZED_MAP:
+                VTR_LOG("QUANTIZED_MAP\n");
+                break;
             case e_router_lookahead::EXTENDED_MAP:
                 VTR_LOG("EXTENDED_MAP\n");
                 break;
@@ -438,6 +479,8 @@ static void ShowRouterOpts(const t_router_opts& RouterOpts) {
             default:
                 VPR_FATAL_ERROR(VPR_ERROR_UNKNOWN, "Unknown lookahead_type\n");
         }
+        VTR_LOG("RouterOpts.lookahead_correction: %s\n", RouterOpts.lookahead_correction ? "on" : "off");
+        VTR_LOG("RouterOpts.global_route_guides: %s\n", RouterOpts.global_route_guides ? "on" : "off");
 
         VTR_LOG("RouterOpts.initial_timing: ");
         switch (RouterOpts.initial_timing) {
@@ -465,9 +508,31 @@ static void ShowRouterOpts(const t_router_opts& RouterOpts) {
             case e_heap_type::BUCKET_HEAP_APPROXIMATION:
                 VTR_LOG("BUCKET_HEAP_APPROXIMATION\n");
                 break;
+            case e_heap_type::RADIX_HEAP:
+                VTR_LOG("RADIX_HEAP\n");
+                break;
+            case e_heap_type::EIGHT_ARY_HEAP:
+                VTR_LOG("EIGHT_ARY_HEAP\n");
+                break;
             default:
                 VPR_FATAL_ERROR(VPR_ERROR_UNKNOWN, "Unknown router_heap\n");
         }
+
+        VTR_LOG("RouterOpts.rr_graph_huge_pages: ");
+        switch (RouterOpts.rr_graph_huge_pages) {
+            case vtr::e_huge_pages::OFF:
+                VTR_LOG("OFF\n");
+                break;
+            case vtr::e_huge_pages::TRANSPARENT:
+                VTR_LOG("TRANSPARENT\n");
+                break;
+            case vtr::e_huge_pages::EXPLICIT:
+                VTR_LOG("EXPLICIT\n");
+                break;
+            default:
+                VPR_FATAL_ERROR(VPR_ERROR_UNKNOWN, "Unknown rr_graph_huge_pages\n");
+        }
+        VTR_LOG("RouterOpts.rr_graph_numa_interleave: %s\n", RouterOpts.rr_graph_numa_interleave ? "true" : "false");
     }
 
     if (DETAILED == RouterOpts.route_type) {
@@ -567,13 +632,24 @@ static void ShowPlacerOpts(const t_placer_opts& PlacerOpts,
                 VPR_FATAL_ERROR(VPR_ERROR_UNKNOWN, "Unknown delay_model_reducer\n");
             VTR_LOG("PlacerOpts.delay_model_reducer: %s\n", e_reducer_strings[(size_t)PlacerOpts.delay_model_reducer].c_str());
 
-            std::string place_delay_model_strings[3] = {"SIMPLE", "DELTA", "DELTA_OVERRIDE"};
-            if ((size_t)PlacerOpts.delay_model_type > 2)
+            std::string place_delay_model_strings[4] = {"SIMPLE", "DELTA", "DELTA_OVERRIDE", "DELTA_LAZY"};
+            if ((size_t)PlacerOpts.delay_model_type > 3)
                 VPR_FATAL_ERROR(VPR_ERROR_UNKNOWN, "Unknown delay_model_type\n");
             VTR_LOG("PlacerOpts.delay_model_type: %s\n", place_delay_model_strings[(size_t)PlacerOpts.delay_model_type].c_str());
         }
 
         VTR_LOG("PlacerOpts.rlim_escape_fraction: %f\n", PlacerOpts.rlim_escape_fraction);
+        VTR_LOG("PlacerOpts.place_move_batch_size: %d\n", PlacerOpts.place_move_batch_size);
+        VTR_LOG("PlacerOpts.place_move_candidates: %d\n", PlacerOpts.place_move_candidates);
+        VTR_LOG("PlacerOpts.place_multilevel_levels: %d\n", PlacerOpts.place_multilevel_levels);
+        VTR_LOG("PlacerOpts.place_multilevel_temps: %d\n", PlacerOpts.place_multilevel_temps);
+        VTR_LOG("PlacerOpts.place_seeds: %d\n", PlacerOpts.place_seeds);
+        VTR_LOG("PlacerOpts.place_checkpoint_file: %s\n", PlacerOpts.place_checkpoint_file.c_str());
+        VTR_LOG("PlacerOpts.place_resume_file: %s\n", PlacerOpts.place_resume_file.c_str());
+        VTR_LOG("PlacerOpts.place_anneal_telemetry_file: %s\n", PlacerOpts.place_anneal_telemetry_file.c_str());
+        VTR_LOG("PlacerOpts.place_anneal_schedule_model_file: %s\n", PlacerOpts.place_anneal_schedule_model_file.c_str());
+        VTR_LOG("PlacerOpts.place_congestion_weight: %f\n", PlacerOpts.place_congestion_weight);
+        VTR_LOG("PlacerOpts.place_congestion_util_threshold: %f\n", PlacerOpts.place_congestion_util_threshold);
         VTR_LOG("PlacerOpts.move_stats_file: %s\n", PlacerOpts.move_stats_file.c_str());
         VTR_LOG("PlacerOpts.placement_saves_per_temperature: %d\n", PlacerOpts.placement_saves_per_temperature);
 
@@ -672,6 +748,7 @@ static void ShowAnalysisOpts(const t_analysis_opts& AnalysisOpts) {
                 VPR_FATAL_ERROR(VPR_ERROR_UNKNOWN, "Unknown post_synth_netlist_unconn_handling\n");
         }
     }
+    VTR_LOG("AnalysisOpts.post_synth_netlist_compress: %s\n", AnalysisOpts.post_synth_netlist_compress ? "true" : "false");
     VTR_LOG("\n");
 }
 
@@ -716,8 +793,12 @@ static void ShowPackerOpts(const t_packer_opts& PackerOpts) {
     VTR_LOG("PackerOpts.hill_climbing_flag: %s", (PackerOpts.hill_climbing_flag ? "true\n" : "false\n"));
     VTR_LOG("PackerOpts.inter_cluster_net_delay: %f\n", PackerOpts.inter_cluster_net_delay);
     VTR_LOG("PackerOpts.timing_driven: %s", (PackerOpts.timing_driven ? "true\n" : "false\n"));
+    VTR_LOG("PackerOpts.timing_update_interval: %d\n", PackerOpts.timing_update_interval);
+    VTR_LOG("PackerOpts.repack_overfull_regions_only: %s", (PackerOpts.repack_overfull_regions_only ? "true\n" : "false\n"));
     VTR_LOG("PackerOpts.target_external_pin_util: %s", vtr::join(PackerOpts.target_external_pin_util, " ").c_str());
     VTR_LOG("\n");
+    VTR_LOG("PackerOpts.incremental_pack_file: %s", PackerOpts.incremental_pack_file.empty() ? "off" : PackerOpts.incremental_pack_file.c_str());
+    VTR_LOG("\n");
     VTR_LOG("\n");
 }
 
@@ -734,6 +815,8 @@ static void ShowNocOpts(const t_noc_opts& NocOpts) {
     VTR_LOG("NocOpts.noc_sat_routing_latency_overrun_weighting: %d\n", NocOpts.noc_sat_routing_latency_overrun_weighting);
     VTR_LOG("NocOpts.noc_sat_routing_congestion_weighting: %d\n", NocOpts.noc_sat_routing_congestion_weighting);
     VTR_LOG("NocOpts.noc_sat_routing_num_workers: %d\n", NocOpts.noc_sat_routing_num_workers);
+    VTR_LOG("NocOpts.noc_reject_deadlocking_moves: %s\n", NocOpts.noc_reject_deadlocking_moves ? "on" : "off");
+    VTR_LOG("NocOpts.noc_initial_placement_restarts: %d\n", NocOpts.noc_initial_placement_restarts);
     VTR_LOG("NocOpts.noc_routing_algorithm: %s\n", NocOpts.noc_placement_file_name.c_str());
     VTR_LOG("\n");
 }
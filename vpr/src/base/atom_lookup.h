@@ -5,6 +5,7 @@
 #include <unordered_map>
 
 #include "vtr_bimap.h"
+#include "vtr_flat_hash_map.h"
 #include "vtr_vector_map.h"
 #include "vtr_range.h"
 
@@ -54,7 +55,12 @@ class AtomLookup {
     ///@brief Returns the pb graph pin associated with the specified atom pin
     const t_pb_graph_pin* atom_pin_pb_graph_pin(AtomPinId atom_pin) const;
 
-    ///@brief Sets the mapping between an atom pin and pb graph pin
+    /**
+     * @brief Sets the mapping between an atom pin and pb graph pin
+     *
+     * Re-binding pins which are already mapped doesn't resize the look-up, so it may be
+     * done concurrently for different pins (e.g. by the post-routing fix-up of each cluster).
+     */
     void set_atom_pin_pb_graph_pin(AtomPinId atom_pin, const t_pb_graph_pin* gpin);
 
     /*
@@ -106,7 +112,7 @@ class AtomLookup {
 
   private: //Types
   private:
-    vtr::bimap<AtomBlockId, const t_pb*, vtr::linear_map, std::unordered_map> atom_to_pb_;
+    vtr::bimap<AtomBlockId, const t_pb*, vtr::linear_map, vtr::flat_hash_map> atom_to_pb_;
 
     vtr::vector_map<AtomPinId, const t_pb_graph_pin*> atom_pin_to_pb_graph_pin_;
 
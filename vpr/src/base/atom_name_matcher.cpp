@@ -0,0 +1,115 @@
+#include "atom_name_matcher.h"
+
+#include <algorithm>
+#include <cstring>
+#include <regex>
+#include <unordered_map>
+
+#ifdef VPR_USE_TBB
+#    include <tbb/parallel_for.h>
+#endif
+
+AtomNameMatcher::AtomNameMatcher(const AtomNetlist& netlist)
+    : netlist_(netlist) {}
+
+std::vector<std::vector<AtomBlockId>> AtomNameMatcher::match(const std::vector<std::string>& patterns) {
+    //Floorplans often repeat the same patterns across partitions, so resolve each distinct pattern once
+    std::unordered_map<std::string, size_t> unique_pattern_index;
+    std::vector<const std::string*> unique_patterns;
+    std::vector<size_t> pattern_index(patterns.size());
+    bool needs_index = false;
+    for (size_t i = 0; i < patterns.size(); ++i) {
+        auto result = unique_pattern_index.emplace(patterns[i], unique_patterns.size());
+        if (result.second) {
+            unique_patterns.push_back(&patterns[i]);
+            if (!netlist_.find_block(patterns[i]) && !regex_literal_prefix(patterns[i]).empty()) {
+                needs_index = true;
+            }
+        }
+        pattern_index[i] = result.first->second;
+    }
+
+    //The index is shared (read only) by the workers, so build it beforehand
+    if (needs_index && sorted_names_.empty()) {
+        sorted_names_.reserve(netlist_.blocks().size());
+        for (AtomBlockId blk_id : netlist_.blocks()) {
+            sorted_names_.emplace_back(netlist_.block_name(blk_id), blk_id);
+        }
+        std::sort(sorted_names_.begin(), sorted_names_.end());
+    }
+
+    std::vector<std::vector<AtomBlockId>> unique_matches(unique_patterns.size());
+    auto match_unique_pattern = [&](size_t i) {
+        unique_matches[i] = match_pattern(*unique_patterns[i]);
+    };
+#ifdef VPR_USE_TBB
+    tbb::parallel_for(size_t(0), unique_patterns.size(), match_unique_pattern);
+#else
+    for (size_t i = 0; i < unique_patterns.size(); ++i) {
+        match_unique_pattern(i);
+    }
+#endif
+
+    std::vector<std::vector<AtomBlockId>> matches(patterns.size());
+    for (size_t i = 0; i < patterns.size(); ++i) {
+        matches[i] = unique_matches[pattern_index[i]];
+    }
+    return matches;
+}
+
+std::vector<AtomBlockId> AtomNameMatcher::match_pattern(const std::string& pattern) const {
+    //A specific atom name
+    AtomBlockId blk_id = netlist_.find_block(pattern);
+    if (blk_id) {
+        return {blk_id};
+    }
+
+    //Otherwise a regular expression
+    const std::regex name_regex(pattern);
+    std::vector<AtomBlockId> matched_atoms;
+
+    std::string prefix = regex_literal_prefix(pattern);
+    if (!prefix.empty()) {
+        //Only the names starting with the prefix can match
+        auto begin = std::lower_bound(sorted_names_.begin(), sorted_names_.end(), prefix,
+                                      [](const std::pair<std::string, AtomBlockId>& entry, const std::string& value) {
+                                          return entry.first < value;
+                                      });
+        for (auto it = begin; it != sorted_names_.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it) {
+            if (std::regex_search(it->first, name_regex)) {
+                matched_atoms.push_back(it->second);
+            }
+        }
+        std::sort(matched_atoms.begin(), matched_atoms.end());
+    } else {
+        for (AtomBlockId candidate : netlist_.blocks()) {
+            if (std::regex_search(netlist_.block_name(candidate), name_regex)) {
+                matched_atoms.push_back(candidate);
+            }
+        }
+    }
+
+    return matched_atoms;
+}
+
+std::string regex_literal_prefix(const std::string& pattern) {
+    //An alternative may not be anchored, or may start differently
+    if (pattern.empty() || pattern[0] != '^' || pattern.find('|') != std::string::npos) {
+        return std::string();
+    }
+
+    std::string prefix;
+    for (size_t i = 1; i < pattern.size(); ++i) {
+        char c = pattern[i];
+        if (std::strchr(".[]()*+?{}|\\^$", c)) {
+            break;
+        }
+
+        //A character followed by a quantifier which allows it to be absent is not part of every match
+        if (i + 1 < pattern.size() && std::strchr("*?{", pattern[i + 1])) {
+            break;
+        }
+        prefix += c;
+    }
+    return prefix;
+}
@@ -0,0 +1,50 @@
+#ifndef ATOM_NAME_MATCHER_H
+#define ATOM_NAME_MATCHER_H
+
+/**
+ * @file
+ * @brief Resolution of the atom name patterns of constraints files.
+ *
+ * A pattern is either the exact name of an atom, or a regular expression
+ * (std::regex, ECMAScript syntax) matched with std::regex_search against the
+ * names of all the atoms. Resolving the patterns of a large floorplan one at a
+ * time against every atom is slow, so the matcher resolves a whole batch of
+ * patterns at once (in parallel when VPR is built with TBB), and narrows the
+ * atoms a regular expression anchored with a literal prefix (e.g. "^core_0/.*")
+ * is matched against with a sorted index of the atom names.
+ */
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "atom_netlist.h"
+
+class AtomNameMatcher {
+  public:
+    explicit AtomNameMatcher(const AtomNetlist& netlist);
+
+    /**
+     * @brief Returns the atoms matched by each of the patterns, in the order of
+     *        their ids (i.e. the order of AtomNetlist::blocks()).
+     *
+     * An empty list is returned for a pattern which matches no atom.
+     */
+    std::vector<std::vector<AtomBlockId>> match(const std::vector<std::string>& patterns);
+
+  private:
+    std::vector<AtomBlockId> match_pattern(const std::string& pattern) const;
+
+    const AtomNetlist& netlist_;
+
+    ///@brief The (name, id) of every atom, sorted by name. Built on first use.
+    std::vector<std::pair<std::string, AtomBlockId>> sorted_names_;
+};
+
+/**
+ * @brief Returns the literal text a match of the regular expression pattern must
+ *        start with (empty if the pattern is not anchored at the start of the name).
+ */
+std::string regex_literal_prefix(const std::string& pattern);
+
+#endif /* ATOM_NAME_MATCHER_H */
@@ -292,6 +292,32 @@ void AtomNetlist::shrink_to_fit_impl() {
     port_models_.shrink_to_fit();
 }
 
+vtr::t_memory_usage AtomNetlist::memory_usage_impl() const {
+    vtr::t_memory_usage usage;
+
+    //Block data
+    usage += vtr::vector_memory_usage(block_models_);
+    usage += vtr::vector_memory_usage(block_truth_tables_);
+    for (const TruthTable& truth_table : block_truth_tables_) {
+        usage += vtr::nested_vector_memory_usage(truth_table);
+    }
+
+    //Port data
+    usage += vtr::vector_memory_usage(port_models_);
+
+    //Net aliases
+    usage += vtr::hash_memory_usage(net_aliases_map_);
+    for (const auto& net_aliases : net_aliases_map_) {
+        usage += vtr::string_memory_usage(net_aliases.first);
+        usage += vtr::hash_memory_usage(net_aliases.second);
+        for (const std::string& alias : net_aliases.second) {
+            usage += vtr::string_memory_usage(alias);
+        }
+    }
+
+    return usage;
+}
+
 /*
  *
  * Sanity Checks
@@ -250,6 +250,7 @@ class AtomNetlist : public Netlist<AtomBlockId, AtomPortId, AtomPinId, AtomNetId
 
     ///@brief Shrinks internal data structures to required size to reduce memory consumption
     void shrink_to_fit_impl() override;
+    vtr::t_memory_usage memory_usage_impl() const override;
 
     /*
      * Sanity checks
@@ -23,6 +23,9 @@ int infer_and_mark_constant_pins(AtomNetlist& netlist, e_const_gen_inference con
 ///@brief Marks all primtive output pins which have no combinationally connected inputs as constant pins
 int mark_undriven_primitive_outputs_as_constant(AtomNetlist& netlist, int verbosity);
 
+///@brief Marks the output pins of blk which have no combinationally connected inputs as constant pins
+int mark_undriven_block_outputs_as_constant(AtomNetlist& netlist, AtomBlockId blk, int verbosity);
+
 ///@brief Marks all primtive output pins of blk which have only constant inputs as constant pins
 int infer_and_mark_block_pins_constant(AtomNetlist& netlist, AtomBlockId blk, e_const_gen_inference const_gen_inference_method, int verbosity);
 int infer_and_mark_block_combinational_outputs_constant(AtomNetlist& netlist, AtomBlockId blk, e_const_gen_inference const_gen_inference_method, int verbosity);
@@ -38,6 +41,7 @@ bool is_buffer_lut(const AtomNetlist& netlist, const AtomBlockId blk);
 bool is_removable_block(const AtomNetlist& netlist, const AtomBlockId blk, std::string* reason = nullptr);
 bool is_removable_input(const AtomNetlist& netlist, const AtomBlockId blk, std::string* reason = nullptr);
 bool is_removable_output(const AtomNetlist& netlist, const AtomBlockId blk, std::string* reason = nullptr);
+bool is_constant_primary_output(const AtomNetlist& netlist, const AtomBlockId blk);
 
 /**
  * @brief   Attempts to remove the specified buffer LUT blk from the netlist.
@@ -433,55 +437,62 @@ int mark_constant_generators(AtomNetlist& netlist, e_const_gen_inference const_g
 }
 
 int mark_undriven_primitive_outputs_as_constant(AtomNetlist& netlist, int verbosity) {
+    size_t num_pins_marked_constant = 0;
+
+    for (AtomBlockId blk : netlist.blocks()) {
+        if (!blk) continue;
+
+        num_pins_marked_constant += mark_undriven_block_outputs_as_constant(netlist, blk, verbosity);
+    }
+
+    return num_pins_marked_constant;
+}
+
+int mark_undriven_block_outputs_as_constant(AtomNetlist& netlist, AtomBlockId blk, int verbosity) {
     //For each model/primtiive we know the set of internal timing edges.
     //
     //If there is not upstream pin/net driving *any* of an outputs timing edges
     //we assume that pin is a constant.
 
-    size_t num_pins_marked_constant = 0;
-
-    for (AtomBlockId blk : netlist.blocks()) {
-        if (!blk) continue;
+    //Don't mark primary I/Os as constants
+    if (netlist.block_type(blk) != AtomBlockType::BLOCK) return 0;
 
-        //Don't mark primary I/Os as constants
-        if (netlist.block_type(blk) != AtomBlockType::BLOCK) continue;
+    int num_pins_marked_constant = 0;
+    for (AtomPortId output_port : netlist.block_output_ports(blk)) {
+        const t_model_ports* model_port = netlist.port_model(output_port);
 
-        for (AtomPortId output_port : netlist.block_output_ports(blk)) {
-            const t_model_ports* model_port = netlist.port_model(output_port);
+        //Don't mark sequential or clock generator ports as constants
+        if (!model_port->clock.empty() || model_port->is_clock) continue;
 
-            //Don't mark sequential or clock generator ports as constants
-            if (!model_port->clock.empty() || model_port->is_clock) continue;
+        //Find the upstream combinationally connected ports
+        std::vector<AtomPortId> upstream_ports = find_combinationally_connected_input_ports(netlist, output_port);
 
-            //Find the upstream combinationally connected ports
-            std::vector<AtomPortId> upstream_ports = find_combinationally_connected_input_ports(netlist, output_port);
+        //Check if any of the 'upstream' input pins have connected nets
+        //
+        //Note that we only check to see whether they are *connected* not whether they are non-constant.
+        //Inference of pins as constant generators from upstream *constant nets* is handled elsewhere.
+        bool has_connected_inputs = false;
+        for (AtomPortId input_port : upstream_ports) {
+            for (AtomPinId input_pin : netlist.port_pins(input_port)) {
+                AtomNetId input_net = netlist.pin_net(input_pin);
 
-            //Check if any of the 'upstream' input pins have connected nets
-            //
-            //Note that we only check to see whether they are *connected* not whether they are non-constant.
-            //Inference of pins as constant generators from upstream *constant nets* is handled elsewhere.
-            bool has_connected_inputs = false;
-            for (AtomPortId input_port : upstream_ports) {
-                for (AtomPinId input_pin : netlist.port_pins(input_port)) {
-                    AtomNetId input_net = netlist.pin_net(input_pin);
-
-                    if (input_net) {
-                        has_connected_inputs = true;
-                        break;
-                    }
+                if (input_net) {
+                    has_connected_inputs = true;
+                    break;
                 }
             }
+        }
 
-            if (!has_connected_inputs) {
-                //The current output port has no inputs driving the primitive's internal
-                //timing edges. Therefore we treat all its pins as constant generators.
-                for (AtomPinId output_pin : netlist.port_pins(output_port)) {
-                    if (netlist.pin_is_constant(output_pin)) continue;
+        if (!has_connected_inputs) {
+            //The current output port has no inputs driving the primitive's internal
+            //timing edges. Therefore we treat all its pins as constant generators.
+            for (AtomPinId output_pin : netlist.port_pins(output_port)) {
+                if (netlist.pin_is_constant(output_pin)) continue;
 
-                    VTR_LOGV(verbosity > 1, "Marking pin '%s' as constant since it has no combinationally connected inputs\n",
-                             netlist.pin_name(output_pin).c_str());
-                    netlist.set_pin_is_constant(output_pin, true);
-                    ++num_pins_marked_constant;
-                }
+                VTR_LOGV(verbosity > 1, "Marking pin '%s' as constant since it has no combinationally connected inputs\n",
+                         netlist.pin_name(output_pin).c_str());
+                netlist.set_pin_is_constant(output_pin, true);
+                ++num_pins_marked_constant;
             }
         }
     }
@@ -960,34 +971,129 @@ bool is_removable_output(const AtomNetlist& netlist, const AtomBlockId blk_id, s
     return true;
 }
 
+bool is_constant_primary_output(const AtomNetlist& netlist, const AtomBlockId blk_id) {
+    if (netlist.block_type(blk_id) != AtomBlockType::OUTPAD) return false;
+
+    VTR_ASSERT(netlist.block_output_pins(blk_id).size() == 0);
+    VTR_ASSERT(netlist.block_clock_pins(blk_id).size() == 0);
+
+    for (AtomPinId pin_id : netlist.block_input_pins(blk_id)) {
+        AtomNetId net_id = netlist.pin_net(pin_id);
+
+        if (net_id && !netlist.net_is_constant(net_id)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 size_t sweep_constant_primary_outputs(AtomNetlist& netlist, int verbosity) {
     size_t removed_count = 0;
     for (AtomBlockId blk_id : netlist.blocks()) {
         if (!blk_id) continue;
 
-        if (netlist.block_type(blk_id) == AtomBlockType::OUTPAD) {
-            VTR_ASSERT(netlist.block_output_pins(blk_id).size() == 0);
-            VTR_ASSERT(netlist.block_clock_pins(blk_id).size() == 0);
+        if (is_constant_primary_output(netlist, blk_id)) {
+            //All inputs are constant, so we should remove this output
+            VTR_LOGV_WARN(verbosity > 2, "Sweeping constant primary output '%s'\n", netlist.block_name(blk_id).c_str());
+            netlist.remove_block(blk_id);
+            removed_count++;
+        }
+    }
+    return removed_count;
+}
 
-            bool all_inputs_are_const = true;
-            for (AtomPinId pin_id : netlist.block_input_pins(blk_id)) {
-                AtomNetId net_id = netlist.pin_net(pin_id);
+/**
+ * @brief The blocks and nets sweep_iterative() has still to (re-)check
+ *
+ * Sweeping a block or a net (or marking a pin constant) can only make its
+ * neighbours removable (or constant), so after checking everything once only
+ * the neighbours of what changed are checked again.
+ */
+class SweepWorklist {
+  public:
+    explicit SweepWorklist(const AtomNetlist& netlist)
+        : netlist_(netlist)
+        , block_queued_(netlist.blocks().size(), false)
+        , net_queued_(netlist.nets().size(), false) {
+        for (AtomBlockId blk_id : netlist.blocks()) {
+            add_block(blk_id);
+        }
+        for (AtomNetId net_id : netlist.nets()) {
+            add_net(net_id);
+        }
+    }
 
-                if (net_id && !netlist.net_is_constant(net_id)) {
-                    all_inputs_are_const = false;
-                    break;
-                }
-            }
+    bool empty() const { return blocks_.empty() && nets_.empty(); }
+
+    bool has_blocks() const { return !blocks_.empty(); }
+
+    AtomBlockId pop_block() {
+        AtomBlockId blk_id = blocks_.back();
+        blocks_.pop_back();
+        block_queued_[blk_id] = false;
+        return blk_id;
+    }
+
+    AtomNetId pop_net() {
+        AtomNetId net_id = nets_.back();
+        nets_.pop_back();
+        net_queued_[net_id] = false;
+        return net_id;
+    }
+
+    void add_block(AtomBlockId blk_id) {
+        if (blk_id && !block_queued_[blk_id]) {
+            block_queued_[blk_id] = true;
+            blocks_.push_back(blk_id);
+        }
+    }
+
+    void add_net(AtomNetId net_id) {
+        if (net_id && !net_queued_[net_id]) {
+            net_queued_[net_id] = true;
+            nets_.push_back(net_id);
+        }
+    }
+
+    ///@brief Adds the driver and sink blocks of net_id
+    void add_net_blocks(AtomNetId net_id) {
+        for (AtomPinId pin_id : netlist_.net_pins(net_id)) {
+            if (pin_id) add_block(netlist_.pin_block(pin_id));
+        }
+    }
+
+    ///@brief Adds the sink blocks of the nets driven by blk_id
+    void add_fanout_blocks(AtomBlockId blk_id) {
+        for (AtomPinId pin_id : netlist_.block_output_pins(blk_id)) {
+            AtomNetId net_id = netlist_.pin_net(pin_id);
+            if (!net_id) continue;
 
-            if (all_inputs_are_const) {
-                //All inputs are constant, so we should remove this output
-                VTR_LOGV_WARN(verbosity > 2, "Sweeping constant primary output '%s'\n", netlist.block_name(blk_id).c_str());
-                netlist.remove_block(blk_id);
-                removed_count++;
+            for (AtomPinId sink_pin_id : netlist_.net_sinks(net_id)) {
+                add_block(netlist_.pin_block(sink_pin_id));
             }
         }
     }
-    return removed_count;
+
+  private:
+    const AtomNetlist& netlist_;
+    std::vector<AtomBlockId> blocks_;
+    std::vector<AtomNetId> nets_;
+    vtr::vector<AtomBlockId, bool> block_queued_;
+    vtr::vector<AtomNetId, bool> net_queued_;
+};
+
+///@brief Removes blk_id from the netlist, and queues its nets (which lost a pin) to be checked
+static void remove_swept_block(AtomNetlist& netlist, AtomBlockId blk_id, SweepWorklist& worklist) {
+    std::vector<AtomNetId> blk_nets;
+    for (AtomPinId pin_id : netlist.block_pins(blk_id)) {
+        blk_nets.push_back(netlist.pin_net(pin_id));
+    }
+
+    netlist.remove_block(blk_id);
+
+    for (AtomNetId net_id : blk_nets) {
+        worklist.add_net(net_id);
+    }
 }
 
 size_t sweep_iterative(AtomNetlist& netlist,
@@ -1004,55 +1110,71 @@ size_t sweep_iterative(AtomNetlist& netlist,
     size_t constant_outputs_swept = 0;
     size_t constant_generators_marked = 0;
 
-    //We perform multiple passes of sweeping, since sweeping something may
-    //enable more things to be swept afterward.
+    //Sweeping something may enable more things to be swept afterward, and
+    //marking a pin constant may reveal more constant pins and outputs downstream.
     //
-    //We keep sweeping until nothing else is removed
-    size_t pass_dangling_nets_swept;
-    size_t pass_dangling_blocks_swept;
-    size_t pass_dangling_inputs_swept;
-    size_t pass_dangling_outputs_swept;
-    size_t pass_constant_outputs_swept;
-    size_t pass_constant_generators_marked;
-    do {
-        pass_dangling_nets_swept = 0;
-        pass_dangling_blocks_swept = 0;
-        pass_dangling_inputs_swept = 0;
-        pass_dangling_outputs_swept = 0;
-        pass_constant_outputs_swept = 0;
-        pass_constant_generators_marked = 0;
-
-        if (should_sweep_ios) {
-            pass_dangling_inputs_swept += sweep_inputs(netlist, verbosity);
-            pass_dangling_outputs_swept += sweep_outputs(netlist, verbosity);
-        }
-
-        if (should_sweep_blocks) {
-            pass_dangling_blocks_swept += sweep_blocks(netlist, verbosity);
-        }
-
-        if (should_sweep_nets) {
-            pass_dangling_nets_swept += sweep_nets(netlist, verbosity);
-        }
+    //Rather than repeatedly sweeping the whole netlist until nothing else is removed,
+    //we check every block and net once, and then only re-check the neighbours of
+    //the blocks and nets removed (or pins marked constant), until nothing is left to check.
+    SweepWorklist worklist(netlist);
+    while (!worklist.empty()) {
+        if (worklist.has_blocks()) {
+            AtomBlockId blk_id = worklist.pop_block();
+            if (!netlist.valid_block_id(blk_id)) continue;
+
+            AtomBlockType type = netlist.block_type(blk_id);
+            std::string reason;
+            if (type == AtomBlockType::INPAD) {
+                if (should_sweep_ios && is_removable_input(netlist, blk_id, &reason)) {
+                    VTR_LOGV_WARN(verbosity > 1, "Primary input '%s' will be swept (%s)\n", netlist.block_name(blk_id).c_str(), reason.c_str());
+                    remove_swept_block(netlist, blk_id, worklist);
+                    ++dangling_inputs_swept;
+                }
+            } else if (type == AtomBlockType::OUTPAD) {
+                if (should_sweep_ios && is_removable_output(netlist, blk_id, &reason)) {
+                    VTR_LOGV_WARN(verbosity > 1, "Primary output '%s' will be swept (%s)\n", netlist.block_name(blk_id).c_str(), reason.c_str());
+                    remove_swept_block(netlist, blk_id, worklist);
+                    ++dangling_outputs_swept;
+                } else if (should_sweep_constant_primary_outputs && is_constant_primary_output(netlist, blk_id)) {
+                    VTR_LOGV_WARN(verbosity > 2, "Sweeping constant primary output '%s'\n", netlist.block_name(blk_id).c_str());
+                    remove_swept_block(netlist, blk_id, worklist);
+                    ++constant_outputs_swept;
+                }
+            } else {
+                if (should_sweep_blocks && is_removable_block(netlist, blk_id, &reason)) {
+                    VTR_LOGV_WARN(verbosity > 1, "Block '%s' will be swept (%s)\n", netlist.block_name(blk_id).c_str(), reason.c_str());
+                    remove_swept_block(netlist, blk_id, worklist);
+                    ++dangling_blocks_swept;
+                } else {
+                    int num_pins_marked = mark_undriven_block_outputs_as_constant(netlist, blk_id, verbosity)
+                                          + infer_and_mark_block_pins_constant(netlist, blk_id, const_gen_inference_method, verbosity);
+                    if (num_pins_marked > 0) {
+                        //The blocks downstream may now have constant inputs
+                        worklist.add_fanout_blocks(blk_id);
+                        constant_generators_marked += num_pins_marked;
+                    }
+                }
+            }
+        } else {
+            AtomNetId net_id = worklist.pop_net();
+            if (!should_sweep_nets || !netlist.valid_net_id(net_id)) continue;
 
-        if (should_sweep_constant_primary_outputs) {
-            pass_constant_outputs_swept += sweep_constant_primary_outputs(netlist, verbosity);
+            bool no_driver = !netlist.net_driver(net_id);
+            bool no_sinks = netlist.net_sinks(net_id).size() == 0;
+            if (no_driver) {
+                VTR_LOGV_WARN(verbosity > 1, "Net '%s' has no driver and will be removed\n", netlist.net_name(net_id).c_str());
+            }
+            if (no_sinks) {
+                VTR_LOGV_WARN(verbosity > 1, "Net '%s' has no sinks and will be removed\n", netlist.net_name(net_id).c_str());
+            }
+            if (no_driver || no_sinks) {
+                //The driver may now have no fanout, and the sinks no fanin
+                worklist.add_net_blocks(net_id);
+                netlist.remove_net(net_id);
+                ++dangling_nets_swept;
+            }
         }
-
-        pass_constant_generators_marked += mark_constant_generators(netlist, const_gen_inference_method, verbosity);
-
-        dangling_nets_swept += pass_dangling_nets_swept;
-        dangling_blocks_swept += pass_dangling_blocks_swept;
-        dangling_inputs_swept += pass_dangling_inputs_swept;
-        dangling_outputs_swept += pass_dangling_outputs_swept;
-        constant_outputs_swept += pass_constant_outputs_swept;
-        constant_generators_marked += pass_constant_generators_marked;
-    } while (pass_dangling_nets_swept != 0
-             || pass_dangling_blocks_swept != 0
-             || pass_dangling_inputs_swept != 0
-             || pass_dangling_outputs_swept != 0
-             || pass_constant_outputs_swept != 0
-             || pass_constant_generators_marked != 0);
+    }
 
     VTR_LOGV(verbosity > 0, "Swept input(s)      : %zu\n", dangling_inputs_swept);
     VTR_LOGV(verbosity > 0, "Swept output(s)     : %zu (%zu dangling, %zu constant)\n",
@@ -25,9 +25,12 @@ void absorb_buffer_luts(AtomNetlist& netlist, int verbosity);
  */
 
 /**
- * @brief Repeatedly sweeps the netlist removing blocks and nets
- *        until nothing more can be swept. If sweep_ios is true also sweeps
- *        primary-inputs and primary-outputs
+ * @brief Sweeps the netlist removing blocks and nets (and marking constant
+ *        generators) until nothing more can be swept. If sweep_ios is true
+ *        also sweeps primary-inputs and primary-outputs
+ *
+ * After a first look at every block and net, only the neighbours of what was
+ * swept (or marked constant) are looked at again, rather than the whole netlist.
  */
 size_t sweep_iterative(AtomNetlist& netlist,
                        bool should_sweep_dangling_ios,
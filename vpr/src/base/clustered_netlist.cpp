@@ -247,6 +247,24 @@ void ClusteredNetlist::shrink_to_fit_impl() {
     //Net data
 }
 
+vtr::t_memory_usage ClusteredNetlist::memory_usage_impl() const {
+    vtr::t_memory_usage usage;
+
+    //Block data (the pb hierarchies the blocks point to are not included)
+    usage += vtr::vector_memory_usage(block_pbs_);
+    usage += vtr::vector_memory_usage(block_types_);
+    usage += vtr::nested_vector_memory_usage(block_logical_pins_);
+    usage += vtr::hash_memory_usage(blocks_per_type_);
+    for (const auto& type_blocks : blocks_per_type_) {
+        usage += vtr::vector_memory_usage(type_blocks.second);
+    }
+
+    //Pin data
+    usage += vtr::vector_memory_usage(pin_logical_index_);
+
+    return usage;
+}
+
 /*
  *
  * Sanity Checks
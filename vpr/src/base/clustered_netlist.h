@@ -296,6 +296,7 @@ class ClusteredNetlist : public Netlist<ClusterBlockId, ClusterPortId, ClusterPi
 
     ///@brief Shrinks internal data structures to required size to reduce memory consumption
     void shrink_to_fit_impl() override;
+    vtr::t_memory_usage memory_usage_impl() const override;
 
     /*
      * Component removal
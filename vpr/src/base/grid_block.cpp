@@ -3,6 +3,19 @@
 
 #include "globals.h"
 
+void GridBlock::initialized_grid_block_at_location(const t_physical_tile_loc& loc, int num_sub_tiles) {
+    const auto& device_grid = g_vpr_ctx.device().grid;
+    t_grid_blocks& tile_blocks = grid_blocks_[loc.layer_num][loc.x][loc.y];
+
+    VTR_ASSERT(tile_blocks.blocks.empty());
+    tile_blocks.blocks.resize(num_sub_tiles, ClusterBlockId::INVALID());
+    tile_blocks.is_tile_root = device_grid.get_width_offset(loc) == 0 && device_grid.get_height_offset(loc) == 0;
+
+    if (tile_blocks.is_tile_root && num_sub_tiles > 0) {
+        update_num_empty_sub_tiles(loc.layer_num, loc.x, loc.y, num_sub_tiles);
+    }
+}
+
 void GridBlock::zero_initialize() {
     auto& device_ctx = g_vpr_ctx.device();
 
@@ -56,4 +69,11 @@ int GridBlock::decrement_usage(const t_physical_tile_loc& loc) {
     return updated_usage;
 }
 
-
+vtr::t_memory_usage GridBlock::memory_usage() const {
+    vtr::t_memory_usage usage = vtr::matrix_memory_usage(grid_blocks_);
+    for (size_t i = 0; i < grid_blocks_.size(); ++i) {
+        usage += vtr::vector_memory_usage(grid_blocks_.get(i).blocks);
+    }
+    usage += vtr::matrix_memory_usage(num_empty_sub_tiles_tree_);
+    return usage;
+}
@@ -4,7 +4,9 @@
 #include "clustered_netlist_fwd.h"
 #include "physical_types.h"
 #include "vpr_types.h"
+#include "vtr_memory_usage.h"
 
+#include <algorithm>
 #include <vector>
 
 ///@brief Stores the clustered blocks placed at a particular grid location
@@ -18,6 +20,9 @@ struct t_grid_blocks {
      */
     std::vector<ClusterBlockId> blocks;
 
+    ///@brief Whether this location is the root (bottom left corner) of its tile, whose empty sub tiles GridBlock indexes
+    bool is_tile_root = false;
+
     /**
      * @brief Test if a subtile at a grid location is occupied by a block.
      *
@@ -36,14 +41,25 @@ class GridBlock {
 
     GridBlock(size_t width, size_t height, size_t layers) {
         grid_blocks_.resize({layers, width, height});
+        num_empty_sub_tiles_tree_.resize({layers, width, height + 1}, 0);
     }
 
-    inline void initialized_grid_block_at_location(const t_physical_tile_loc& loc, int num_sub_tiles) {
-        grid_blocks_[loc.layer_num][loc.x][loc.y].blocks.resize(num_sub_tiles, ClusterBlockId::INVALID());
-    }
+    /**
+     * @brief Allocates the (empty) sub tiles of a grid location
+     *
+     * Only the empty sub tiles of the tile roots (locations with no width/height offset) are
+     * counted by num_empty_sub_tiles_in_column().
+     */
+    void initialized_grid_block_at_location(const t_physical_tile_loc& loc, int num_sub_tiles);
 
     inline void set_block_at_location(const t_pl_loc& loc, ClusterBlockId blk_id) {
-        grid_blocks_[loc.layer][loc.x][loc.y].blocks[loc.sub_tile] = blk_id;
+        t_grid_blocks& tile_blocks = grid_blocks_[loc.layer][loc.x][loc.y];
+        ClusterBlockId& sub_tile_block = tile_blocks.blocks[loc.sub_tile];
+
+        if (tile_blocks.is_tile_root && (sub_tile_block == ClusterBlockId::INVALID()) != (blk_id == ClusterBlockId::INVALID())) {
+            update_num_empty_sub_tiles(loc.layer, loc.x, loc.y, blk_id == ClusterBlockId::INVALID() ? 1 : -1);
+        }
+        sub_tile_block = blk_id;
     }
 
     inline ClusterBlockId block_at_location(const t_pl_loc& loc) const {
@@ -66,8 +82,22 @@ class GridBlock {
         return grid_blocks_[loc.layer_num][loc.x][loc.y].subtile_empty(sub_tile);
     }
 
+    /**
+     * @brief Returns the number of empty sub tiles of the tiles rooted in column x of a layer
+     * between rows ymin and ymax (inclusive), in O(log(grid height)).
+     *
+     * Used to skip the parts of the grid which have no room left without probing them location by location.
+     */
+    int num_empty_sub_tiles_in_column(int layer_num, int x, int ymin, int ymax) const {
+        if (ymin > ymax) {
+            return 0;
+        }
+        return num_empty_sub_tiles_below(layer_num, x, ymax + 1) - num_empty_sub_tiles_below(layer_num, x, ymin);
+    }
+
     inline void clear() {
         grid_blocks_.clear();
+        num_empty_sub_tiles_tree_.clear();
     }
 
     /**
@@ -85,8 +115,36 @@ class GridBlock {
 
     int decrement_usage(const t_physical_tile_loc& loc);
 
+    ///@brief Returns the memory held by the grid blocks (including the block lists of each location)
+    vtr::t_memory_usage memory_usage() const;
+
   private:
+    ///@brief Adds delta to the number of empty sub tiles at (x, y) of layer_num
+    inline void update_num_empty_sub_tiles(int layer_num, int x, int y, int delta) {
+        auto column_tree = num_empty_sub_tiles_tree_[layer_num][x];
+        const int tree_size = (int)num_empty_sub_tiles_tree_.dim_size(2);
+        for (int i = y + 1; i < tree_size; i += i & -i) {
+            column_tree[i] += delta;
+        }
+    }
+
+    ///@brief Returns the number of empty sub tiles in the rows of column x of layer_num below y
+    inline int num_empty_sub_tiles_below(int layer_num, int x, int y) const {
+        auto column_tree = num_empty_sub_tiles_tree_[layer_num][x];
+        int num_empty = 0;
+        for (int i = std::min(y, (int)num_empty_sub_tiles_tree_.dim_size(2) - 1); i > 0; i -= i & -i) {
+            num_empty += column_tree[i];
+        }
+        return num_empty;
+    }
+
     vtr::NdMatrix<t_grid_blocks, 3> grid_blocks_;
+
+    /**
+     * @brief Fenwick (binary indexed) trees of the number of empty tile root sub tiles in each column,
+     * over the rows shifted by one: [0..layers-1][0..width-1][1..height]
+     */
+    vtr::NdMatrix<int, 3> num_empty_sub_tiles_tree_;
 };
 
 #endif //VTR_GRID_BLOCK_H
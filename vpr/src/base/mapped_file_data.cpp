@@ -0,0 +1,71 @@
+#include "mapped_file_data.h"
+
+#include <cstdio>
+
+#ifndef _WIN32
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+MappedFileData::MappedFileData(const char* filename) {
+#ifndef _WIN32
+    int fd = open(filename, O_RDONLY);
+    if (fd >= 0) {
+        struct stat file_stat;
+        if (fstat(fd, &file_stat) == 0) {
+            size_ = file_stat.st_size;
+            opened_ = true;
+            if (size_ > 0) {
+                void* mapped = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (mapped != MAP_FAILED) {
+                    madvise(mapped, size_, MADV_SEQUENTIAL);
+                    mapped_ = mapped;
+                    data_ = static_cast<const char*>(mapped);
+                }
+            }
+        }
+        close(fd);
+        if (mapped_ || size_ == 0) {
+            return;
+        }
+    }
+#endif
+    //Fall back to reading the whole file
+    std::FILE* infile = std::fopen(filename, "rb");
+    if (!infile) {
+        opened_ = false;
+        return;
+    }
+    opened_ = true;
+    std::fseek(infile, 0, SEEK_END);
+    buffer_.resize(std::ftell(infile));
+    std::fseek(infile, 0, SEEK_SET);
+    size_ = std::fread(&buffer_[0], 1, buffer_.size(), infile);
+    std::fclose(infile);
+    data_ = buffer_.data();
+}
+
+MappedFileData::~MappedFileData() {
+#ifndef _WIN32
+    if (mapped_) {
+        munmap(mapped_, size_);
+    }
+#endif
+}
+
+void MappedFileData::release_until(size_t end) {
+#ifndef _WIN32
+    if (mapped_) {
+        size_t page_size = sysconf(_SC_PAGESIZE);
+        size_t release_bytes = (end / page_size) * page_size;
+        if (release_bytes > released_bytes_) {
+            madvise(static_cast<char*>(mapped_) + released_bytes_, release_bytes - released_bytes_, MADV_DONTNEED);
+            released_bytes_ = release_bytes;
+        }
+    }
+#else
+    (void)end;
+#endif
+}
@@ -0,0 +1,35 @@
+#ifndef MAPPED_FILE_DATA_H
+#define MAPPED_FILE_DATA_H
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief The contents of a file, memory mapped where possible (or read into
+ *        memory otherwise), for the readers of large text files.
+ */
+class MappedFileData {
+  public:
+    explicit MappedFileData(const char* filename);
+    ~MappedFileData();
+
+    MappedFileData(const MappedFileData&) = delete;
+    MappedFileData& operator=(const MappedFileData&) = delete;
+
+    bool is_open() const { return opened_; }
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+    ///@brief Hint that [0, end) has been parsed and will not be read again
+    void release_until(size_t end);
+
+  private:
+    bool opened_ = false;
+    const char* data_ = "";
+    size_t size_ = 0;
+    void* mapped_ = nullptr;
+    size_t released_bytes_ = 0;
+    std::string buffer_;
+};
+
+#endif
@@ -0,0 +1,41 @@
+#include "memory_usage_report.h"
+
+#include "globals.h"
+#include "vtr_log.h"
+#include "vtr_rusage.h"
+
+constexpr double BYTE_TO_MIB = 1024 * 1024;
+
+///@brief Prints one row of the memory usage table
+static void print_memory_usage_row(const char* context, const char* structure, const vtr::t_memory_usage& usage) {
+    VTR_LOG("  %-14s %-38s %10.2f %10.2f\n", context, structure, usage.bytes / BYTE_TO_MIB, usage.slack_bytes / BYTE_TO_MIB);
+}
+
+void report_memory_usage(const std::string& stage) {
+    const std::pair<const char*, std::vector<vtr::t_named_memory_usage>> context_usages[] = {
+        {"Atom", g_vpr_ctx.atom().memory_usage()},
+        {"Clustering", g_vpr_ctx.clustering().memory_usage()},
+        {"Device", g_vpr_ctx.device().memory_usage()},
+        {"Placement", g_vpr_ctx.placement().memory_usage()},
+        {"Routing", g_vpr_ctx.routing().memory_usage()},
+        {"Timing", g_vpr_ctx.timing().memory_usage()},
+        {"Floorplanning", g_vpr_ctx.floorplanning().memory_usage()}};
+
+    VTR_LOG("\n");
+    VTR_LOG("Memory usage after %s:\n", stage.c_str());
+    VTR_LOG("  %-14s %-38s %10s %10s\n", "Context", "Structure", "MiB", "Slack MiB");
+    VTR_LOG("  %-14s %-38s %10s %10s\n", "-------", "---------", "---", "---------");
+
+    vtr::t_memory_usage total_usage;
+    for (const auto& context_usage : context_usages) {
+        for (const vtr::t_named_memory_usage& usage : context_usage.second) {
+            print_memory_usage_row(context_usage.first, usage.name.c_str(), usage.usage);
+            total_usage += usage.usage;
+        }
+    }
+
+    VTR_LOG("  %-14s %-38s %10s %10s\n", "-------", "---------", "---", "---------");
+    print_memory_usage_row("Total", "", total_usage);
+    VTR_LOG("  Current RSS: %.2f MiB, peak RSS: %.2f MiB\n", vtr::get_current_rss() / BYTE_TO_MIB, vtr::get_max_rss() / BYTE_TO_MIB);
+    VTR_LOG("\n");
+}
@@ -0,0 +1,14 @@
+#ifndef VPR_MEMORY_USAGE_REPORT_H
+#define VPR_MEMORY_USAGE_REPORT_H
+
+#include <string>
+
+/**
+ * @brief Prints the memory held by the main data structures of each context (see the contexts' memory_usage()),
+ *        with the capacity slack of their vectors, and the current resident set size of VPR.
+ *
+ * @param stage The stage (e.g. "Placement") after which the report is printed
+ */
+void report_memory_usage(const std::string& stage);
+
+#endif
@@ -418,6 +418,7 @@
 #include <unordered_map>
 #include "vtr_range.h"
 #include "vtr_logic.h"
+#include "vtr_memory_usage.h"
 #include "vtr_vector_map.h"
 
 #include "logic_types.h"
@@ -504,6 +505,9 @@ class Netlist {
     ///@brief Item counts and container info (for debugging)
     void print_stats() const;
 
+    ///@brief Returns the memory held by the netlist (including the data of derived netlists)
+    vtr::t_memory_usage memory_usage() const;
+
     /*
      * Blocks
      */
@@ -1080,6 +1084,7 @@ class Netlist {
     //The functions follow the Non-Virtual Interface (NVI) idiom, and
     //are called from this class in their respective non-impl() functions.
     virtual void shrink_to_fit_impl() {}
+    virtual vtr::t_memory_usage memory_usage_impl() const { return vtr::t_memory_usage(); }
 
     virtual bool validate_block_sizes_impl(size_t /*num_blocks*/) const { return true; }
     virtual bool validate_port_sizes_impl(size_t /*num_ports*/) const { return true; }
@@ -4,6 +4,10 @@
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vpr_error.h"
+
+#ifdef VPR_USE_TBB
+#    include <tbb/parallel_for_each.h>
+#endif
 /*
  *
  * NetlistIdRemapper class implementation
@@ -91,6 +95,73 @@ void Netlist<BlockId, PortId, PinId, NetId>::print_stats() const {
     VTR_LOG("Strings %zu capacity/size: %.2f\n", string_ids_.size(), float(string_ids_.capacity()) / string_ids_.size());
 }
 
+template<typename BlockId, typename PortId, typename PinId, typename NetId>
+vtr::t_memory_usage Netlist<BlockId, PortId, PinId, NetId>::memory_usage() const {
+    vtr::t_memory_usage usage;
+
+    //Block data
+    usage += vtr::vector_memory_usage(block_ids_);
+    usage += vtr::vector_memory_usage(block_names_);
+    usage += vtr::nested_vector_memory_usage(block_ports_);
+    usage += vtr::vector_memory_usage(block_num_input_ports_);
+    usage += vtr::vector_memory_usage(block_num_output_ports_);
+    usage += vtr::vector_memory_usage(block_num_clock_ports_);
+    usage += vtr::nested_vector_memory_usage(block_pins_);
+    usage += vtr::vector_memory_usage(block_num_input_pins_);
+    usage += vtr::vector_memory_usage(block_num_output_pins_);
+    usage += vtr::vector_memory_usage(block_num_clock_pins_);
+    usage += vtr::vector_memory_usage(block_params_);
+    for (const auto& params : block_params_) {
+        usage += vtr::hash_memory_usage(params);
+    }
+    usage += vtr::vector_memory_usage(block_attrs_);
+    for (const auto& attrs : block_attrs_) {
+        usage += vtr::hash_memory_usage(attrs);
+    }
+
+    //Port data
+    usage += vtr::vector_memory_usage(port_ids_);
+    usage += vtr::vector_memory_usage(port_names_);
+    usage += vtr::vector_memory_usage(port_blocks_);
+    usage += vtr::nested_vector_memory_usage(port_pins_);
+    usage += vtr::vector_memory_usage(port_widths_);
+    usage += vtr::vector_memory_usage(port_types_);
+
+    //Pin data
+    usage += vtr::vector_memory_usage(pin_ids_);
+    usage += vtr::vector_memory_usage(pin_ports_);
+    usage += vtr::vector_memory_usage(pin_port_bits_);
+    usage += vtr::vector_memory_usage(pin_nets_);
+    usage += vtr::vector_memory_usage(pin_net_indices_);
+    usage += vtr::vector_memory_usage(pin_is_constant_);
+
+    //Net data
+    usage += vtr::vector_memory_usage(net_ids_);
+    usage += vtr::vector_memory_usage(net_names_);
+    usage += vtr::nested_vector_memory_usage(net_pins_);
+    usage += vtr::vector_memory_usage(net_is_ignored_);
+    usage += vtr::vector_memory_usage(net_is_global_);
+
+    //String data
+    usage += vtr::vector_memory_usage(string_ids_);
+    usage += vtr::vector_memory_usage(strings_);
+    for (const std::string& str : strings_) {
+        usage += vtr::string_memory_usage(str);
+    }
+
+    //Fast lookups (the strings are counted twice, as the look-up holds copies)
+    usage += vtr::vector_memory_usage(block_name_to_block_id_);
+    usage += vtr::vector_memory_usage(net_name_to_net_id_);
+    usage += vtr::hash_memory_usage(string_to_string_id_);
+    for (const auto& kv : string_to_string_id_) {
+        usage += vtr::string_memory_usage(kv.first);
+    }
+
+    usage += memory_usage_impl();
+
+    return usage;
+}
+
 /*
  *
  * Blocks
@@ -1303,7 +1374,9 @@ template<typename BlockId, typename PortId, typename PinId, typename NetId>
 void Netlist<BlockId, PortId, PinId, NetId>::rebuild_block_refs(const vtr::vector_map<PinId, PinId>& pin_id_map,
                                                                 const vtr::vector_map<PortId, PortId>& port_id_map) {
     //Update the pin id references held by blocks
-    for (auto blk_id : blocks()) {
+    //
+    //Each block only updates its own references, so the blocks are updated in parallel
+    auto rebuild_refs = [&](BlockId blk_id) {
         //Before update the references, we need to know how many are valid,
         //so we can also update the numbers of input/output/clock pins
 
@@ -1338,7 +1411,14 @@ void Netlist<BlockId, PortId, PinId, NetId>::rebuild_block_refs(const vtr::vecto
 
         VTR_ASSERT_SAFE_MSG(all_valid(blk_ports), "All Ids should be valid");
         VTR_ASSERT(blk_ports.size() == size_t(block_num_input_ports_[blk_id] + block_num_output_ports_[blk_id] + block_num_clock_ports_[blk_id]));
+    };
+#ifdef VPR_USE_TBB
+    tbb::parallel_for_each(blocks().begin(), blocks().end(), rebuild_refs);
+#else
+    for (auto blk_id : blocks()) {
+        rebuild_refs(blk_id);
     }
+#endif
 
     rebuild_block_refs_impl(pin_id_map, port_id_map);
 
@@ -1354,10 +1434,17 @@ void Netlist<BlockId, PortId, PinId, NetId>::rebuild_port_refs(const vtr::vector
 
     VTR_ASSERT(port_blocks_.size() == port_ids_.size());
 
-    for (auto& pin_collection : port_pins_) {
+    auto update_port_pins = [&](std::vector<PinId>& pin_collection) {
         pin_collection = update_valid_refs(pin_collection, pin_id_map);
         VTR_ASSERT_SAFE_MSG(all_valid(pin_collection), "All Ids should be valid");
+    };
+#ifdef VPR_USE_TBB
+    tbb::parallel_for_each(port_pins_.begin(), port_pins_.end(), update_port_pins);
+#else
+    for (auto& pin_collection : port_pins_) {
+        update_port_pins(pin_collection);
     }
+#endif
 
     rebuild_port_refs_impl(block_id_map, pin_id_map);
 
@@ -1382,13 +1469,22 @@ void Netlist<BlockId, PortId, PinId, NetId>::rebuild_pin_refs(const vtr::vector_
     //were removed)
     //
     //Note that for this to work correctly, the net references must have already been re-built!
-    for (auto net : nets()) {
+    //
+    //Each pin is on a single net, so the nets are handled in parallel
+    auto rebuild_net_indices = [&](NetId net) {
         int i = 0;
         for (auto pin : net_pins(net)) {
             pin_net_indices_[pin] = i;
             ++i;
         }
+    };
+#ifdef VPR_USE_TBB
+    tbb::parallel_for_each(nets().begin(), nets().end(), rebuild_net_indices);
+#else
+    for (auto net : nets()) {
+        rebuild_net_indices(net);
     }
+#endif
 
     rebuild_pin_refs_impl(port_id_map, net_id_map);
 
@@ -1398,13 +1494,20 @@ void Netlist<BlockId, PortId, PinId, NetId>::rebuild_pin_refs(const vtr::vector_
 template<typename BlockId, typename PortId, typename PinId, typename NetId>
 void Netlist<BlockId, PortId, PinId, NetId>::rebuild_net_refs(const vtr::vector_map<PinId, PinId>& pin_id_map) {
     //Update pin references held by nets
-    for (auto& pin_collection : net_pins_) {
+    auto update_net_pins = [&](std::vector<PinId>& pin_collection) {
         //We take special care to preserve the driver index, since an INVALID id is used
         //to indicate an undriven net it should not be dropped during the update
         pin_collection = update_valid_refs(pin_collection, pin_id_map, {NET_DRIVER_INDEX});
 
         VTR_ASSERT_SAFE_MSG(all_valid(pin_collection), "All sinks should be valid");
+    };
+#ifdef VPR_USE_TBB
+    tbb::parallel_for_each(net_pins_.begin(), net_pins_.end(), update_net_pins);
+#else
+    for (auto& pin_collection : net_pins_) {
+        update_net_pins(pin_collection);
     }
+#endif
 
     rebuild_net_refs_impl(pin_id_map);
 
@@ -0,0 +1,566 @@
+#include "netlist_snapshot.h"
+
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_memory.h"
+#include "vtr_time.h"
+#include "vtr_util.h"
+
+#include "globals.h"
+#include "read_netlist.h"
+#include "vpr_error.h"
+#include "vpr_utils.h"
+
+#ifdef VTR_ENABLE_CAPNPROTO
+#    include "capnp/serialize.h"
+#    include "netlist_snapshot.capnp.h"
+#    include "mmap_file.h"
+#    include "serdes_utils.h"
+#endif /* VTR_ENABLE_CAPNPROTO */
+
+/*
+ * Functions below are for when VTR_ENABLE_CAPNPROTO is disabled; an error is thrown instead.
+ */
+#ifndef VTR_ENABLE_CAPNPROTO
+
+#    define DISABLE_ERROR                              \
+        "is disable because VTR_ENABLE_CAPNPROTO=OFF." \
+        "Re-compile with CMake option VTR_ENABLE_CAPNPROTO=ON to enable."
+
+void write_netlist_snapshot(const std::string& /*file*/,
+                            const AtomNetlist& /*atom_nlist*/,
+                            const ClusteredNetlist& /*clb_nlist*/,
+                            const t_arch& /*arch*/) {
+    VPR_FATAL_ERROR(VPR_ERROR_OTHER, "write_netlist_snapshot " DISABLE_ERROR);
+}
+
+AtomNetlist read_atom_netlist_snapshot(const std::string& /*file*/,
+                                       const t_model* /*user_models*/,
+                                       const t_model* /*library_models*/) {
+    VPR_FATAL_ERROR(VPR_ERROR_OTHER, "read_atom_netlist_snapshot " DISABLE_ERROR);
+}
+
+ClusteredNetlist read_clustered_netlist_snapshot(const std::string& /*file*/,
+                                                 const t_arch* /*arch*/,
+                                                 bool /*verify_file_digests*/,
+                                                 int /*verbosity*/) {
+    VPR_FATAL_ERROR(VPR_ERROR_OTHER, "read_clustered_netlist_snapshot " DISABLE_ERROR);
+}
+
+#else /* VTR_ENABLE_CAPNPROTO */
+
+/******** File-scope types ********/
+
+///@brief A pb of a cluster being written, and where it sits below its parent
+struct t_snapshot_pb {
+    const t_pb* pb;
+    int parent;
+    int child_type;
+    int instance;
+};
+
+/******** File-scope function declarations ********/
+
+static void write_atom_netlist(VprAtomNetlist::Builder out, const AtomNetlist& atom_nlist);
+
+static void write_cluster(VprCluster::Builder out, const ClusteredNetlist& clb_nlist, ClusterBlockId blk_id);
+
+static void write_pin_rotations(VprPb::Builder out, const t_pb* pb);
+
+static const t_model* find_snapshot_model(const std::string& name,
+                                          const t_model* user_models,
+                                          const t_model* library_models);
+
+static void load_cluster_pins(const t_pb_graph_node* pb_graph_node,
+                              std::vector<const t_pb_graph_pin*>& cluster_pins);
+
+static void alloc_child_pbs(t_pb* pb);
+
+static void read_cluster(VprCluster::Reader in,
+                         ClusteredNetlist& clb_nlist,
+                         std::vector<std::vector<const t_pb_graph_pin*>>& cluster_pins);
+
+/******** Function definitions ********/
+
+void write_netlist_snapshot(const std::string& file,
+                            const AtomNetlist& atom_nlist,
+                            const ClusteredNetlist& clb_nlist,
+                            const t_arch& arch) {
+    vtr::ScopedStartFinishTimer timer("Write netlist snapshot");
+
+    if (!atom_nlist.is_compressed() || !clb_nlist.is_compressed()) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER, "Netlists must be compressed to write a netlist snapshot\n");
+    }
+
+    ::capnp::MallocMessageBuilder builder;
+    auto snapshot = builder.initRoot<VprNetlistSnapshot>();
+
+    write_atom_netlist(snapshot.initAtomNetlist(), atom_nlist);
+
+    auto clustered = snapshot.initClusteredNetlist();
+    clustered.setName(clb_nlist.netlist_name().c_str());
+    clustered.setId(clb_nlist.netlist_id().c_str());
+    clustered.setArchitectureId(arch.architecture_id);
+
+    auto clusters = clustered.initClusters(clb_nlist.blocks().size());
+    for (ClusterBlockId blk_id : clb_nlist.blocks()) {
+        write_cluster(clusters[size_t(blk_id)], clb_nlist, blk_id);
+    }
+
+    writeMessageToFile(file, &builder);
+}
+
+AtomNetlist read_atom_netlist_snapshot(const std::string& file,
+                                       const t_model* user_models,
+                                       const t_model* library_models) {
+    vtr::ScopedStartFinishTimer timer("Load atom netlist snapshot");
+
+    MmapFile f(file);
+    ::capnp::FlatArrayMessageReader reader(f.getData(), default_large_capnp_opts());
+    auto in = reader.getRoot<VprNetlistSnapshot>().getAtomNetlist();
+
+    AtomNetlist atom_nlist(in.getName().cStr(), in.getId().cStr());
+    atom_nlist.set_block_types(find_snapshot_model(MODEL_INPUT, user_models, library_models),
+                               find_snapshot_model(MODEL_OUTPUT, user_models, library_models));
+
+    //Blocks
+    std::unordered_map<std::string, const t_model*> models;
+    for (auto block : in.getBlocks()) {
+        std::string model_name = block.getModel().cStr();
+        auto model_iter = models.find(model_name);
+        if (model_iter == models.end()) {
+            model_iter = models.emplace(model_name, find_snapshot_model(model_name, user_models, library_models)).first;
+        }
+
+        AtomNetlist::TruthTable truth_table;
+        truth_table.reserve(block.getTruthTable().size());
+        for (auto row : block.getTruthTable()) {
+            truth_table.emplace_back();
+            truth_table.back().reserve(row.size());
+            for (uint8_t value : row) {
+                truth_table.back().push_back(static_cast<vtr::LogicValue>(value));
+            }
+        }
+
+        AtomBlockId blk_id = atom_nlist.create_block(block.getName().cStr(), model_iter->second, truth_table);
+        for (auto attr : block.getAttrs()) {
+            atom_nlist.set_block_attr(blk_id, attr.getName().cStr(), attr.getValue().cStr());
+        }
+        for (auto param : block.getParams()) {
+            atom_nlist.set_block_param(blk_id, param.getName().cStr(), param.getValue().cStr());
+        }
+    }
+    VTR_ASSERT(atom_nlist.blocks().size() == in.getBlocks().size());
+
+    //Ports
+    for (auto port : in.getPorts()) {
+        AtomBlockId blk_id(port.getBlock());
+        const t_model_ports* model_port = find_model_port(atom_nlist.block_model(blk_id), port.getModelPort().cStr());
+        atom_nlist.create_port(blk_id, model_port);
+    }
+    VTR_ASSERT(atom_nlist.ports().size() == in.getPorts().size());
+
+    //Nets (created before their pins, so they keep their ids)
+    for (auto net : in.getNets()) {
+        AtomNetId net_id = atom_nlist.create_net(net.getName().cStr());
+        atom_nlist.set_net_is_global(net_id, net.getIsGlobal());
+        atom_nlist.set_net_is_ignored(net_id, net.getIsIgnored());
+    }
+    VTR_ASSERT(atom_nlist.nets().size() == in.getNets().size());
+
+    //Pins
+    for (auto pin : in.getPins()) {
+        atom_nlist.create_pin(AtomPortId(pin.getPort()),
+                              pin.getPortBit(),
+                              AtomNetId(pin.getNet()),
+                              pin.getIsDriver() ? PinType::DRIVER : PinType::SINK,
+                              pin.getIsConstant());
+    }
+    VTR_ASSERT(atom_nlist.pins().size() == in.getPins().size());
+
+    //Net aliases (which may refer to nets of the original netlist which were removed)
+    for (auto net : in.getNets()) {
+        for (auto alias : net.getAliases()) {
+            atom_nlist.add_net_alias(net.getName().cStr(), alias.cStr());
+        }
+    }
+
+    atom_nlist.verify();
+
+    VTR_LOG("Loaded atom netlist '%s' from snapshot '%s' (%zu blocks, %zu nets)\n",
+            atom_nlist.netlist_name().c_str(), file.c_str(), atom_nlist.blocks().size(), atom_nlist.nets().size());
+
+    return atom_nlist;
+}
+
+ClusteredNetlist read_clustered_netlist_snapshot(const std::string& file,
+                                                 const t_arch* arch,
+                                                 bool verify_file_digests,
+                                                 int verbosity) {
+    vtr::ScopedStartFinishTimer timer("Load clustered netlist snapshot");
+
+    auto& atom_ctx = g_vpr_ctx.mutable_atom();
+    const auto& device_ctx = g_vpr_ctx.device();
+
+    MmapFile f(file);
+    ::capnp::FlatArrayMessageReader reader(f.getData(), default_large_capnp_opts());
+    auto snapshot = reader.getRoot<VprNetlistSnapshot>();
+    auto in = snapshot.getClusteredNetlist();
+
+    //As for .net files, the snapshot must match the loaded architecture and atom netlist
+    std::vector<std::string> mismatches;
+    if (in.getArchitectureId() != arch->architecture_id) {
+        mismatches.push_back(vtr::string_fmt("Netlist snapshot was generated from a different architecture file"
+                                             " (loaded architecture ID: %s, snapshot architecture ID: %s)",
+                                             arch->architecture_id, in.getArchitectureId().cStr()));
+    }
+    if (snapshot.getAtomNetlist().getId() != atom_ctx.nlist.netlist_id().c_str()) {
+        mismatches.push_back(vtr::string_fmt("Netlist snapshot was generated from a different atom netlist"
+                                             " (loaded atom netlist ID: %s, snapshot atom netlist ID: %s)",
+                                             atom_ctx.nlist.netlist_id().c_str(), snapshot.getAtomNetlist().getId().cStr()));
+    }
+    for (const std::string& msg : mismatches) {
+        if (verify_file_digests) {
+            vpr_throw(VPR_ERROR_NET_F, file.c_str(), 0, msg.c_str());
+        } else {
+            VTR_LOGF_WARN(file.c_str(), 0, "%s\n", msg.c_str());
+        }
+    }
+
+    ClusteredNetlist clb_nlist(in.getName().cStr(), in.getId().cStr());
+
+    //Reset atom/pb mapping (it is reloaded from the snapshot)
+    for (auto blk_id : atom_ctx.nlist.blocks()) {
+        atom_ctx.lookup.set_atom_pb(blk_id, nullptr);
+    }
+
+    //Cluster pins by pin_count_in_cluster for each logical block type, loaded on first use
+    std::vector<std::vector<const t_pb_graph_pin*>> cluster_pins(device_ctx.logical_block_types.size());
+
+    for (auto cluster : in.getClusters()) {
+        read_cluster(cluster, clb_nlist, cluster_pins);
+    }
+
+    finish_loading_clustered_netlist(clb_nlist, verbosity);
+
+    VTR_LOG("Loaded %zu clusters from snapshot '%s'\n", clb_nlist.blocks().size(), file.c_str());
+
+    return clb_nlist;
+}
+
+static void write_atom_netlist(VprAtomNetlist::Builder out, const AtomNetlist& atom_nlist) {
+    out.setName(atom_nlist.netlist_name().c_str());
+    out.setId(atom_nlist.netlist_id().c_str());
+
+    auto blocks = out.initBlocks(atom_nlist.blocks().size());
+    for (AtomBlockId blk_id : atom_nlist.blocks()) {
+        auto block = blocks[size_t(blk_id)];
+        block.setName(atom_nlist.block_name(blk_id).c_str());
+        block.setModel(atom_nlist.block_model(blk_id)->name);
+
+        const AtomNetlist::TruthTable& truth_table = atom_nlist.block_truth_table(blk_id);
+        auto rows = block.initTruthTable(truth_table.size());
+        for (size_t irow = 0; irow < truth_table.size(); irow++) {
+            auto row = rows.init(irow, truth_table[irow].size());
+            for (size_t ival = 0; ival < truth_table[irow].size(); ival++) {
+                row.set(ival, static_cast<uint8_t>(truth_table[irow][ival]));
+            }
+        }
+
+        auto attrs = block.initAttrs(atom_nlist.block_attrs(blk_id).size());
+        size_t iattr = 0;
+        for (const auto& attr : atom_nlist.block_attrs(blk_id)) {
+            attrs[iattr].setName(attr.first.c_str());
+            attrs[iattr].setValue(attr.second.c_str());
+            iattr++;
+        }
+
+        auto params = block.initParams(atom_nlist.block_params(blk_id).size());
+        size_t iparam = 0;
+        for (const auto& param : atom_nlist.block_params(blk_id)) {
+            params[iparam].setName(param.first.c_str());
+            params[iparam].setValue(param.second.c_str());
+            iparam++;
+        }
+    }
+
+    auto ports = out.initPorts(atom_nlist.ports().size());
+    for (AtomPortId port_id : atom_nlist.ports()) {
+        auto port = ports[size_t(port_id)];
+        port.setBlock(size_t(atom_nlist.port_block(port_id)));
+        port.setModelPort(atom_nlist.port_model(port_id)->name);
+    }
+
+    auto pins = out.initPins(atom_nlist.pins().size());
+    for (AtomPinId pin_id : atom_nlist.pins()) {
+        auto pin = pins[size_t(pin_id)];
+        pin.setPort(size_t(atom_nlist.pin_port(pin_id)));
+        pin.setPortBit(atom_nlist.pin_port_bit(pin_id));
+        pin.setNet(size_t(atom_nlist.pin_net(pin_id)));
+        pin.setIsDriver(atom_nlist.pin_type(pin_id) == PinType::DRIVER);
+        pin.setIsConstant(atom_nlist.pin_is_constant(pin_id));
+    }
+
+    auto nets = out.initNets(atom_nlist.nets().size());
+    for (AtomNetId net_id : atom_nlist.nets()) {
+        auto net = nets[size_t(net_id)];
+        const std::string& net_name = atom_nlist.net_name(net_id);
+        net.setName(net_name.c_str());
+        net.setIsGlobal(atom_nlist.net_is_global(net_id));
+        net.setIsIgnored(atom_nlist.net_is_ignored(net_id));
+
+        //A net without aliases is its own (only) alias
+        std::unordered_set<std::string> aliases = atom_nlist.net_aliases(net_name);
+        if (aliases.size() != 1 || !aliases.count(net_name)) {
+            auto net_aliases = net.initAliases(aliases.size());
+            size_t ialias = 0;
+            for (const std::string& alias : aliases) {
+                net_aliases.set(ialias++, alias.c_str());
+            }
+        }
+    }
+}
+
+static void write_cluster(VprCluster::Builder out, const ClusteredNetlist& clb_nlist, ClusterBlockId blk_id) {
+    const auto& atom_lookup = g_vpr_ctx.atom().lookup;
+
+    out.setName(clb_nlist.block_name(blk_id).c_str());
+    out.setLogicalType(clb_nlist.block_type(blk_id)->index);
+
+    //Collect the pbs of the cluster (breadth first, so parents come before their children)
+    const t_pb* root_pb = clb_nlist.block_pb(blk_id);
+    std::vector<t_snapshot_pb> snapshot_pbs = {{root_pb, OPEN, 0, 0}};
+    for (size_t ipb = 0; ipb < snapshot_pbs.size(); ipb++) {
+        const t_pb* pb = snapshot_pbs[ipb].pb;
+        if (pb->child_pbs == nullptr) {
+            continue;
+        }
+
+        const t_mode* mode = &pb->pb_graph_node->pb_type->modes[pb->mode];
+        for (int ichild_type = 0; ichild_type < mode->num_pb_type_children; ichild_type++) {
+            for (int inst = 0; inst < mode->pb_type_children[ichild_type].num_pb; inst++) {
+                const t_pb* child_pb = &pb->child_pbs[ichild_type][inst];
+                if (child_pb->pb_graph_node != nullptr) {
+                    snapshot_pbs.push_back({child_pb, int(ipb), ichild_type, inst});
+                }
+            }
+        }
+    }
+
+    auto pbs = out.initPbs(snapshot_pbs.size());
+    for (size_t ipb = 0; ipb < snapshot_pbs.size(); ipb++) {
+        const t_pb* pb = snapshot_pbs[ipb].pb;
+        auto out_pb = pbs[ipb];
+        out_pb.setParent(snapshot_pbs[ipb].parent);
+        out_pb.setChildType(snapshot_pbs[ipb].child_type);
+        out_pb.setInstance(snapshot_pbs[ipb].instance);
+        if (pb->name != nullptr) {
+            out_pb.setName(pb->name);
+        }
+        out_pb.setMode(pb->mode);
+
+        bool is_used = pb == root_pb || pb->parent_pb != nullptr;
+        out_pb.setIsUsed(is_used);
+
+        AtomBlockId atom_blk_id = atom_lookup.pb_atom(pb);
+        out_pb.setAtomBlock(atom_blk_id ? int(size_t(atom_blk_id)) : OPEN);
+
+        if (is_used && pb->is_primitive()) {
+            write_pin_rotations(out_pb, pb);
+        }
+    }
+
+    auto pb_routes = out.initPbRoutes(root_pb->pb_route.size());
+    size_t iroute = 0;
+    for (const auto& pin_route : root_pb->pb_route) {
+        const t_pb_route& route = pin_route.second;
+        auto out_route = pb_routes[iroute++];
+        out_route.setPin(pin_route.first);
+        out_route.setAtomNet(route.atom_net_id ? int(size_t(route.atom_net_id)) : OPEN);
+        out_route.setDriverPin(route.driver_pb_pin_id);
+        auto sinks = out_route.initSinkPins(route.sink_pb_pin_ids.size());
+        for (size_t isink = 0; isink < route.sink_pb_pin_ids.size(); isink++) {
+            sinks.set(isink, route.sink_pb_pin_ids[isink]);
+        }
+        out_route.setGraphPin(route.pb_graph_pin ? route.pb_graph_pin->pin_count_in_cluster : OPEN);
+    }
+}
+
+///@brief Record the primitive pins of pb which were rotated to a different atom pin
+static void write_pin_rotations(VprPb::Builder out, const t_pb* pb) {
+    const t_pb_graph_node* gnode = pb->pb_graph_node;
+
+    std::vector<std::pair<int, int>> rotations;
+    auto add_port_rotations = [&](t_pb_graph_pin** pins, int num_ports, int* num_pins) {
+        for (int iport = 0; iport < num_ports; iport++) {
+            for (int ipin = 0; ipin < num_pins[iport]; ipin++) {
+                const t_pb_graph_pin* gpin = &pins[iport][ipin];
+                BitIndex atom_pin_bit = pb->atom_pin_bit_index(gpin);
+                if (atom_pin_bit != BitIndex(gpin->pin_number)) {
+                    rotations.emplace_back(gpin->pin_count_in_cluster, atom_pin_bit);
+                }
+            }
+        }
+    };
+    add_port_rotations(gnode->input_pins, gnode->num_input_ports, gnode->num_input_pins);
+    add_port_rotations(gnode->output_pins, gnode->num_output_ports, gnode->num_output_pins);
+    add_port_rotations(gnode->clock_pins, gnode->num_clock_ports, gnode->num_clock_pins);
+
+    if (rotations.empty()) {
+        return;
+    }
+
+    auto out_rotations = out.initPinRotations(rotations.size());
+    for (size_t irot = 0; irot < rotations.size(); irot++) {
+        out_rotations[irot].setPin(rotations[irot].first);
+        out_rotations[irot].setAtomPinBit(rotations[irot].second);
+    }
+}
+
+static const t_model* find_snapshot_model(const std::string& name,
+                                          const t_model* user_models,
+                                          const t_model* library_models) {
+    const t_model* model = find_model(user_models, name, false);
+    if (!model) {
+        model = find_model(library_models, name, false);
+    }
+    if (!model) {
+        VPR_FATAL_ERROR(VPR_ERROR_ATOM_NETLIST,
+                        "Failed to find matching architecture model for '%s' of the netlist snapshot\n",
+                        name.c_str());
+    }
+    return model;
+}
+
+///@brief Index every pin below pb_graph_node by its pin_count_in_cluster
+static void load_cluster_pins(const t_pb_graph_node* pb_graph_node,
+                              std::vector<const t_pb_graph_pin*>& cluster_pins) {
+    auto add_port_pins = [&](t_pb_graph_pin** pins, int num_ports, int* num_pins) {
+        for (int iport = 0; iport < num_ports; iport++) {
+            for (int ipin = 0; ipin < num_pins[iport]; ipin++) {
+                const t_pb_graph_pin* gpin = &pins[iport][ipin];
+                VTR_ASSERT(gpin->pin_count_in_cluster < int(cluster_pins.size()));
+                cluster_pins[gpin->pin_count_in_cluster] = gpin;
+            }
+        }
+    };
+    add_port_pins(pb_graph_node->input_pins, pb_graph_node->num_input_ports, pb_graph_node->num_input_pins);
+    add_port_pins(pb_graph_node->output_pins, pb_graph_node->num_output_ports, pb_graph_node->num_output_pins);
+    add_port_pins(pb_graph_node->clock_pins, pb_graph_node->num_clock_ports, pb_graph_node->num_clock_pins);
+
+    const t_pb_type* pb_type = pb_graph_node->pb_type;
+    for (int imode = 0; imode < pb_type->num_modes; imode++) {
+        for (int ichild_type = 0; ichild_type < pb_type->modes[imode].num_pb_type_children; ichild_type++) {
+            for (int inst = 0; inst < pb_type->modes[imode].pb_type_children[ichild_type].num_pb; inst++) {
+                load_cluster_pins(&pb_graph_node->child_pb_graph_nodes[imode][ichild_type][inst], cluster_pins);
+            }
+        }
+    }
+}
+
+///@brief Allocate the children of a used, non-primitive pb (as the .net file loader does)
+static void alloc_child_pbs(t_pb* pb) {
+    const t_pb_type* pb_type = pb->pb_graph_node->pb_type;
+    if (pb_type->num_modes == 0) {
+        return;
+    }
+
+    const t_mode* mode = &pb_type->modes[pb->mode];
+    pb->child_pbs = new t_pb*[mode->num_pb_type_children];
+    for (int ichild_type = 0; ichild_type < mode->num_pb_type_children; ichild_type++) {
+        pb->child_pbs[ichild_type] = new t_pb[mode->pb_type_children[ichild_type].num_pb];
+    }
+}
+
+static void read_cluster(VprCluster::Reader in,
+                         ClusteredNetlist& clb_nlist,
+                         std::vector<std::vector<const t_pb_graph_pin*>>& cluster_pins) {
+    auto& atom_ctx = g_vpr_ctx.mutable_atom();
+    const auto& device_ctx = g_vpr_ctx.device();
+
+    int type_index = in.getLogicalType();
+    VTR_ASSERT(type_index >= 0 && size_t(type_index) < device_ctx.logical_block_types.size());
+    t_logical_block_type_ptr type = &device_ctx.logical_block_types[type_index];
+
+    std::vector<const t_pb_graph_pin*>& type_pins = cluster_pins[type_index];
+    if (type_pins.empty()) {
+        type_pins.resize(type->pb_graph_head->total_pb_pins, nullptr);
+        load_cluster_pins(type->pb_graph_head, type_pins);
+    }
+
+    auto in_pbs = in.getPbs();
+    VTR_ASSERT(in_pbs.size() > 0 && in_pbs[0].getParent() == OPEN);
+
+    std::vector<t_pb*> pbs(in_pbs.size(), nullptr);
+    for (size_t ipb = 0; ipb < in_pbs.size(); ipb++) {
+        auto in_pb = in_pbs[ipb];
+
+        t_pb* pb = nullptr;
+        if (ipb == 0) {
+            pb = new t_pb;
+            pb->name = vtr::strdup(in.getName().cStr());
+            pb->pb_graph_node = type->pb_graph_head;
+            ClusterBlockId blk_id = clb_nlist.create_block(pb->name, pb, type);
+            VTR_ASSERT(size_t(blk_id) + 1 == clb_nlist.blocks().size());
+        } else {
+            int parent_index = in_pb.getParent();
+            VTR_ASSERT(parent_index >= 0 && size_t(parent_index) < ipb);
+            t_pb* parent_pb = pbs[parent_index];
+            VTR_ASSERT(parent_pb->child_pbs != nullptr);
+
+            pb = &parent_pb->child_pbs[in_pb.getChildType()][in_pb.getInstance()];
+            pb->pb_graph_node = &parent_pb->pb_graph_node->child_pb_graph_nodes[parent_pb->mode][in_pb.getChildType()][in_pb.getInstance()];
+            if (in_pb.hasName()) {
+                pb->name = vtr::strdup(in_pb.getName().cStr());
+            }
+            if (in_pb.getIsUsed()) {
+                pb->parent_pb = parent_pb;
+            }
+        }
+        pb->mode = in_pb.getMode();
+        pbs[ipb] = pb;
+
+        if (!in_pb.getIsUsed()) {
+            continue;
+        }
+        alloc_child_pbs(pb);
+
+        if (in_pb.getAtomBlock() != OPEN) {
+            AtomBlockId atom_blk_id(in_pb.getAtomBlock());
+            VTR_ASSERT(atom_ctx.nlist.valid_block_id(atom_blk_id));
+            atom_ctx.lookup.set_atom_pb(atom_blk_id, pb);
+            atom_ctx.lookup.set_atom_clb(atom_blk_id, ClusterBlockId(clb_nlist.blocks().size() - 1));
+        }
+
+        for (auto rotation : in_pb.getPinRotations()) {
+            pb->set_atom_pin_bit_index(type_pins[rotation.getPin()], rotation.getAtomPinBit());
+        }
+    }
+
+    std::vector<std::pair<int, t_pb_route>> pb_routes;
+    pb_routes.reserve(in.getPbRoutes().size());
+    for (auto in_route : in.getPbRoutes()) {
+        t_pb_route route;
+        if (in_route.getAtomNet() != OPEN) {
+            route.atom_net_id = AtomNetId(in_route.getAtomNet());
+        }
+        route.driver_pb_pin_id = in_route.getDriverPin();
+        route.sink_pb_pin_ids.reserve(in_route.getSinkPins().size());
+        for (int sink_pin : in_route.getSinkPins()) {
+            route.sink_pb_pin_ids.push_back(sink_pin);
+        }
+        if (in_route.getGraphPin() != OPEN) {
+            route.pb_graph_pin = type_pins[in_route.getGraphPin()];
+        }
+        pb_routes.emplace_back(in_route.getPin(), std::move(route));
+    }
+    pbs[0]->pb_route = vtr::make_flat_map2(std::move(pb_routes));
+}
+
+#endif /* VTR_ENABLE_CAPNPROTO */
@@ -0,0 +1,49 @@
+#ifndef NETLIST_SNAPSHOT_H
+#define NETLIST_SNAPSHOT_H
+
+/**
+ * @file
+ * @brief Binary (Cap'n Proto) snapshots of the atom and clustered netlists.
+ *
+ * A snapshot is written once the packing has been loaded, and holds the atom
+ * netlist, the clustered netlist and the pb hierarchy and intra-block routing
+ * of every cluster. Reading it back (by memory mapping the file) replaces
+ * parsing and cleaning the circuit and parsing the .net file, so later stages
+ * (e.g. placement or routing only) can be re-run quickly.
+ *
+ * The atom netlist is restored with the same block, port, pin and net ids,
+ * and the clustered netlist is rebuilt from the same pbs as the .net file
+ * loader would, so the same atom lookups result.
+ *
+ * Snapshots require VPR to be built with Cap'n Proto support.
+ */
+
+#include <string>
+
+#include "atom_netlist.h"
+#include "clustered_netlist.h"
+
+///@brief Write the atom and clustered netlists of the current packing to file
+void write_netlist_snapshot(const std::string& file,
+                            const AtomNetlist& atom_nlist,
+                            const ClusteredNetlist& clb_nlist,
+                            const t_arch& arch);
+
+///@brief Read the atom netlist of a netlist snapshot
+AtomNetlist read_atom_netlist_snapshot(const std::string& file,
+                                       const t_model* user_models,
+                                       const t_model* library_models);
+
+/**
+ * @brief Read the clustered netlist of a netlist snapshot, and load the atom
+ *        lookups of the (already loaded) atom netlist
+ *
+ * As with read_netlist(), the snapshot must have been generated for the loaded
+ * architecture (an error if verify_file_digests is set, otherwise a warning).
+ */
+ClusteredNetlist read_clustered_netlist_snapshot(const std::string& file,
+                                                 const t_arch* arch,
+                                                 bool verify_file_digests,
+                                                 int verbosity);
+
+#endif /* NETLIST_SNAPSHOT_H */
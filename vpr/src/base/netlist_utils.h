@@ -2,7 +2,16 @@
 #define NETLIST_UTILS_H
 
 #include "vtr_vector_map.h"
+#include <algorithm>
 #include <set>
+#include <type_traits>
+
+#ifdef VPR_USE_TBB
+#    include <tbb/blocked_range.h>
+#    include <tbb/parallel_for.h>
+#    include <tbb/parallel_reduce.h>
+#    include <tbb/parallel_scan.h>
+#endif
 
 /*
  *
@@ -37,10 +46,33 @@ bool all_valid(const Container& values) {
     return true;
 }
 
-///@brief Builds a mapping from old to new ids by skipping values marked invalid
+/**
+ * @brief Builds a mapping from old to new ids by skipping values marked invalid
+ *
+ * The new id of a valid id is the number of valid ids before it, which with
+ * VPR_USE_TBB is computed for all the ids in parallel as a prefix sum.
+ */
 template<typename Id>
 vtr::vector_map<Id, Id> compress_ids(const vtr::vector_map<Id, Id>& ids) {
     vtr::vector_map<Id, Id> id_map(ids.size());
+#ifdef VPR_USE_TBB
+    tbb::parallel_scan(
+        tbb::blocked_range<size_t>(0, ids.size()), size_t(0),
+        [&](const tbb::blocked_range<size_t>& range, size_t num_valid, bool is_final_scan) {
+            for (size_t i = range.begin(); i != range.end(); ++i) {
+                Id id = ids[Id(i)];
+                if (id) {
+                    //Valid
+                    if (is_final_scan) {
+                        id_map[id] = Id(num_valid);
+                    }
+                    ++num_valid;
+                }
+            }
+            return num_valid;
+        },
+        [](size_t lhs, size_t rhs) { return lhs + rhs; });
+#else
     size_t i = 0;
     for (auto id : ids) {
         if (id) {
@@ -49,10 +81,30 @@ vtr::vector_map<Id, Id> compress_ids(const vtr::vector_map<Id, Id>& ids) {
             ++i;
         }
     }
+#endif
 
     return id_map;
 }
 
+#ifdef VPR_USE_TBB
+///@brief Returns the number of new ids defined by 'id_map' (i.e. one past the largest valid new id)
+template<typename Id>
+size_t num_new_ids(const vtr::vector_map<Id, Id>& id_map) {
+    return tbb::parallel_reduce(
+        tbb::blocked_range<size_t>(0, id_map.size()), size_t(0),
+        [&](const tbb::blocked_range<size_t>& range, size_t num_ids) {
+            for (size_t i = range.begin(); i != range.end(); ++i) {
+                Id new_id = id_map[Id(i)];
+                if (new_id) {
+                    num_ids = std::max(num_ids, size_t(new_id) + 1);
+                }
+            }
+            return num_ids;
+        },
+        [](size_t lhs, size_t rhs) { return std::max(lhs, rhs); });
+}
+#endif
+
 /**
  * @brief Returns a vector based on 'values', which has had entries
  *        dropped & re-ordered according according to 'id_map'.
@@ -67,6 +119,25 @@ template<typename Id, typename T>
 vtr::vector_map<Id, T> clean_and_reorder_values(const vtr::vector_map<Id, T>& values, const vtr::vector_map<Id, Id>& id_map) {
     VTR_ASSERT(values.size() == id_map.size());
 
+#ifdef VPR_USE_TBB
+    //Each value moves to its own new location, so they are moved in parallel
+    //(except for packed bools, which can not be written concurrently)
+    if constexpr (!std::is_same<T, bool>::value) {
+        vtr::vector_map<Id, T> result(num_new_ids(id_map));
+
+        tbb::parallel_for(size_t(0), values.size(), [&](size_t cur_idx) {
+            Id old_id = Id(cur_idx);
+
+            Id new_id = id_map[old_id];
+            if (new_id) {
+                result[new_id] = values[old_id];
+            }
+        });
+
+        return result;
+    }
+#endif
+
     //Allocate space for the values that will not be dropped
     vtr::vector_map<Id, T> result;
 
@@ -93,6 +164,16 @@ template<typename Id>
 vtr::vector_map<Id, Id> clean_and_reorder_ids(const vtr::vector_map<Id, Id>& id_map) {
     //For IDs, the values are the new id's stored in the map
 
+#ifdef VPR_USE_TBB
+    vtr::vector_map<Id, Id> result(num_new_ids(id_map));
+
+    tbb::parallel_for(size_t(0), id_map.size(), [&](size_t cur_idx) {
+        Id new_id = id_map[Id(cur_idx)];
+        if (new_id) {
+            result[new_id] = new_id;
+        }
+    });
+#else
     //Allocate a new vector to store the values that have been not dropped
     vtr::vector_map<Id, Id> result;
 
@@ -105,6 +186,7 @@ vtr::vector_map<Id, Id> clean_and_reorder_ids(const vtr::vector_map<Id, Id>& id_
             result.insert(new_id, new_id);
         }
     }
+#endif
 
     return result;
 }
@@ -132,6 +214,15 @@ size_t count_valid_refs(R range, const vtr::vector_map<Id, Id>& id_map) {
  */
 template<typename Container, typename ValId>
 Container update_all_refs(const Container& values, const vtr::vector_map<ValId, ValId>& id_map) {
+#ifdef VPR_USE_TBB
+    Container updated(values.size());
+
+    auto updated_begin = updated.begin();
+    auto values_begin = values.begin();
+    tbb::parallel_for(size_t(0), values.size(), [&](size_t i) {
+        updated_begin[i] = id_map[values_begin[i]];
+    });
+#else
     Container updated;
 
     for (ValId orig_val : values) {
@@ -140,6 +231,7 @@ Container update_all_refs(const Container& values, const vtr::vector_map<ValId,
         //The original item exists in the new mapping
         updated.emplace_back(new_val);
     }
+#endif
 
     return updated;
 }
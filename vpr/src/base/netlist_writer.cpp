@@ -11,6 +11,14 @@
 #include <unordered_set>
 #include <cmath>
 #include <regex>
+#include <array>
+
+#include <zlib.h>
+
+#if defined(VPR_USE_TBB)
+#    include <tbb/parallel_for.h>
+#    include <tbb/task_arena.h>
+#endif
 
 #include "vtr_assert.h"
 #include "vtr_util.h"
@@ -65,6 +73,11 @@
  * methods setting up file-level global information (I/Os, net declarations etc.) and then ask each Instance to
  * print itself in the appropriate format to the appropriate file.
  *
+ * The cell instances, which make up most of the output of large designs, are printed in chunks of consecutive
+ * instances, in parallel when VPR is built with TBB, and the chunks are then written out in order (see
+ * NetlistWriterVisitor::print_cell_instances()).  The output is the same as if they were printed one after the
+ * other.  With --post_synth_netlist_compress the files are written gzip compressed as they are produced.
+ *
  * Name Escaping
  * =============
  * One of the challenges in generating netlists is producing consistent naming of netlist elements.
@@ -101,6 +114,12 @@
 //      - string: port name of the associated source clock pin of the sequential port
 typedef std::pair<double, std::string> sequential_port_delay_pair;
 
+///@brief Number of consecutive cell instances printed together (as one task) to a buffer
+constexpr size_t INSTANCE_CHUNK_SIZE = 2048;
+
+///@brief Number of instance chunks printed (in parallel) before their buffers are written out
+constexpr size_t INSTANCE_CHUNK_BATCH_SIZE = 64;
+
 /*enum class PortType {
  * IN,
  * OUT,
@@ -961,13 +980,17 @@ class NetlistWriterVisitor : public NetlistVisitor {
             }
         }
 
-        //All the cell instances (to an internal buffer for now)
-        std::stringstream instances_ss;
+        //All the cell instances (to internal buffers for now, since the unconnected wires they use are declared first)
+        std::vector<std::string> instance_chunks;
 
-        size_t unconn_count = 0;
-        for (auto& inst : cell_instances_) {
-            inst->print_verilog(instances_ss, unconn_count, depth + 1);
-        }
+        size_t unconn_count = print_cell_instances(
+            0,
+            [&](Instance& inst, std::ostream& os, size_t& inst_unconn_count) {
+                inst.print_verilog(os, inst_unconn_count, depth + 1);
+            },
+            [&](std::string&& chunk) {
+                instance_chunks.push_back(std::move(chunk));
+            });
 
         //Unconnected wires declarations
         if (unconn_count) {
@@ -982,7 +1005,10 @@ class NetlistWriterVisitor : public NetlistVisitor {
         //All the cell instances
         verilog_os_ << "\n";
         verilog_os_ << indent(depth + 1) << "//Cell instances\n";
-        verilog_os_ << instances_ss.str();
+        for (std::string& chunk : instance_chunks) {
+            verilog_os_ << chunk;
+            std::string().swap(chunk);
+        }
 
         verilog_os_ << "\n";
         verilog_os_ << indent(depth) << "endmodule\n";
@@ -1033,10 +1059,14 @@ class NetlistWriterVisitor : public NetlistVisitor {
         //The cells
         blif_os_ << "\n";
         blif_os_ << indent(depth) << "#Cell instances\n";
-        size_t unconn_count = 0;
-        for (auto& inst : cell_instances_) {
-            inst->print_blif(blif_os_, unconn_count);
-        }
+        print_cell_instances(
+            0,
+            [](Instance& inst, std::ostream& os, size_t& unconn_count) {
+                inst.print_blif(os, unconn_count);
+            },
+            [&](std::string&& chunk) {
+                blif_os_ << chunk;
+            });
 
         blif_os_ << "\n";
         blif_os_ << indent(depth) << ".end\n";
@@ -1086,13 +1116,90 @@ class NetlistWriterVisitor : public NetlistVisitor {
         }
 
         //Cells
-        for (const auto& inst : cell_instances_) {
-            inst->print_sdf(sdf_os_, depth + 1);
-        }
+        print_cell_instances(
+            0,
+            [&](Instance& inst, std::ostream& os, size_t& /*unconn_count*/) {
+                inst.print_sdf(os, depth + 1);
+            },
+            [&](std::string&& chunk) {
+                sdf_os_ << chunk;
+            });
 
         sdf_os_ << indent(depth) << ")\n";
     }
 
+    /**
+     * @brief Prints all the cell instances, and passes their output to write_chunk() in instance order
+     *
+     * Each chunk of INSTANCE_CHUNK_SIZE consecutive instances is printed (with print_inst(inst, os, unconn_count))
+     * to its own buffer, which is then handed to write_chunk().  With TBB the chunks of a batch are printed in
+     * parallel: the unconnected nets are still numbered in instance order, by printing each chunk with its nets
+     * numbered from 0, and printing it again from its actual first number if it created any.  Only a batch of
+     * chunks is buffered at a time, unless write_chunk() keeps them.
+     *
+     *   @param unconn_count  Number of the first unconnected net created
+     *   @return The number following the last unconnected net created
+     */
+    template<typename PrintInst, typename WriteChunk>
+    size_t print_cell_instances(size_t unconn_count, PrintInst print_inst, WriteChunk write_chunk) {
+        size_t num_chunks = (cell_instances_.size() + INSTANCE_CHUNK_SIZE - 1) / INSTANCE_CHUNK_SIZE;
+
+        std::vector<std::string> chunk_texts;
+        std::vector<size_t> chunk_unconn_counts;
+
+        for (size_t first_chunk = 0; first_chunk < num_chunks; first_chunk += INSTANCE_CHUNK_BATCH_SIZE) {
+            size_t num_batch_chunks = std::min(INSTANCE_CHUNK_BATCH_SIZE, num_chunks - first_chunk);
+            chunk_texts.assign(num_batch_chunks, std::string());
+            chunk_unconn_counts.assign(num_batch_chunks, 0);
+
+            //Prints a chunk (batch relative) with its unconnected nets numbered from first_unconn
+            auto print_chunk = [&](size_t ichunk, size_t first_unconn) {
+                size_t begin = (first_chunk + ichunk) * INSTANCE_CHUNK_SIZE;
+                size_t end = std::min(begin + INSTANCE_CHUNK_SIZE, cell_instances_.size());
+
+                std::ostringstream os;
+                size_t chunk_unconn_count = first_unconn;
+                for (size_t iinst = begin; iinst < end; ++iinst) {
+                    print_inst(*cell_instances_[iinst], os, chunk_unconn_count);
+                }
+                chunk_texts[ichunk] = os.str();
+                chunk_unconn_counts[ichunk] = chunk_unconn_count - first_unconn;
+            };
+
+#if defined(VPR_USE_TBB)
+            if (tbb::this_task_arena::max_concurrency() > 1) {
+                tbb::parallel_for(size_t(0), num_batch_chunks, [&](size_t ichunk) {
+                    print_chunk(ichunk, 0);
+                });
+
+                //Re-number the chunks which created unconnected nets, but were not the first ones to
+                std::vector<std::pair<size_t, size_t>> renumbered_chunks;
+                for (size_t ichunk = 0; ichunk < num_batch_chunks; ++ichunk) {
+                    if (chunk_unconn_counts[ichunk] > 0 && unconn_count > 0) {
+                        renumbered_chunks.emplace_back(ichunk, unconn_count);
+                    }
+                    unconn_count += chunk_unconn_counts[ichunk];
+                }
+                tbb::parallel_for(size_t(0), renumbered_chunks.size(), [&](size_t i) {
+                    print_chunk(renumbered_chunks[i].first, renumbered_chunks[i].second);
+                });
+            } else
+#endif
+            {
+                for (size_t ichunk = 0; ichunk < num_batch_chunks; ++ichunk) {
+                    print_chunk(ichunk, unconn_count);
+                    unconn_count += chunk_unconn_counts[ichunk];
+                }
+            }
+
+            for (std::string& chunk_text : chunk_texts) {
+                write_chunk(std::move(chunk_text));
+            }
+        }
+
+        return unconn_count;
+    }
+
     /**
      * @brief Returns the name of a circuit-level Input/Output
      *
@@ -2306,23 +2413,108 @@ class MergedNetlistWriterVisitor : public NetlistWriterVisitor {
     }
 };
 
+///@brief A stream buffer which gzip compresses what is written to it into a file
+class GzipFileBuf : public std::streambuf {
+  public:
+    GzipFileBuf(const std::string& filename)
+        : file_(gzopen(filename.c_str(), "wb")) {
+        setp(buffer_.data(), buffer_.data() + buffer_.size());
+    }
+
+    ~GzipFileBuf() override {
+        if (file_) {
+            flush_buffer();
+            gzclose(file_);
+        }
+    }
+
+    //Non copyable/assignable/moveable
+    GzipFileBuf(const GzipFileBuf& other) = delete;
+    GzipFileBuf& operator=(const GzipFileBuf& rhs) = delete;
+
+    bool is_open() const { return file_ != nullptr; }
+
+  protected:
+    int_type overflow(int_type c) override {
+        if (!flush_buffer()) {
+            return traits_type::eof();
+        }
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(c);
+            pbump(1);
+        }
+        return traits_type::not_eof(c);
+    }
+
+    int sync() override {
+        return flush_buffer() ? 0 : -1;
+    }
+
+  private:
+    ///@brief Compresses the buffered characters to the file, returns false on failure
+    bool flush_buffer() {
+        int num_chars = pptr() - pbase();
+        if (num_chars > 0) {
+            if (!file_ || gzwrite(file_, pbase(), num_chars) != num_chars) {
+                return false;
+            }
+            pbump(-num_chars);
+        }
+        return true;
+    }
+
+    gzFile file_;
+    std::array<char, 1 << 16> buffer_;
+};
+
+///@brief An output file stream, which is gzip compressed if requested
+class NetlistOutputFile : public std::ostream {
+  public:
+    NetlistOutputFile(const std::string& filename, bool compress)
+        : std::ostream(nullptr) {
+        if (compress) {
+            gzip_buf_ = std::make_unique<GzipFileBuf>(filename);
+            if (!gzip_buf_->is_open()) {
+                VPR_FATAL_ERROR(VPR_ERROR_IMPL_NETLIST_WRITER, "Failed to open '%s' for writing\n", filename.c_str());
+            }
+            rdbuf(gzip_buf_.get());
+        } else {
+            file_buf_.open(filename, std::ios::out);
+            rdbuf(&file_buf_);
+        }
+    }
+
+    ~NetlistOutputFile() override {
+        flush();
+    }
+
+  private:
+    std::filebuf file_buf_;
+    std::unique_ptr<GzipFileBuf> gzip_buf_;
+};
+
+///@brief Returns the name of a netlist writer output file, with a .gz suffix if it is compressed
+std::string netlist_output_filename(const std::string& filename, const t_analysis_opts& opts) {
+    return opts.post_synth_netlist_compress ? filename + ".gz" : filename;
+}
+
 //
 // Externally Accessible Functions
 //
 
 ///@brief Main routine for this file. See netlist_writer.h for details.
 void netlist_writer(const std::string basename, std::shared_ptr<const AnalysisDelayCalculator> delay_calc, struct t_analysis_opts opts) {
-    std::string verilog_filename = basename + "_post_synthesis.v";
-    std::string blif_filename = basename + "_post_synthesis.blif";
-    std::string sdf_filename = basename + "_post_synthesis.sdf";
+    std::string verilog_filename = netlist_output_filename(basename + "_post_synthesis.v", opts);
+    std::string blif_filename = netlist_output_filename(basename + "_post_synthesis.blif", opts);
+    std::string sdf_filename = netlist_output_filename(basename + "_post_synthesis.sdf", opts);
 
     VTR_LOG("Writing Implementation Netlist: %s\n", verilog_filename.c_str());
     VTR_LOG("Writing Implementation Netlist: %s\n", blif_filename.c_str());
     VTR_LOG("Writing Implementation SDF    : %s\n", sdf_filename.c_str());
 
-    std::ofstream verilog_os(verilog_filename);
-    std::ofstream blif_os(blif_filename);
-    std::ofstream sdf_os(sdf_filename);
+    NetlistOutputFile verilog_os(verilog_filename, opts.post_synth_netlist_compress);
+    NetlistOutputFile blif_os(blif_filename, opts.post_synth_netlist_compress);
+    NetlistOutputFile sdf_os(sdf_filename, opts.post_synth_netlist_compress);
 
     NetlistWriterVisitor visitor(verilog_os, blif_os, sdf_os, delay_calc, opts);
 
@@ -2333,11 +2525,11 @@ void netlist_writer(const std::string basename, std::shared_ptr<const AnalysisDe
 
 ///@brief Main routine for this file. See netlist_writer.h for details.
 void merged_netlist_writer(const std::string basename, std::shared_ptr<const AnalysisDelayCalculator> delay_calc, struct t_analysis_opts opts) {
-    std::string verilog_filename = basename + "_merged_post_implementation.v";
+    std::string verilog_filename = netlist_output_filename(basename + "_merged_post_implementation.v", opts);
 
     VTR_LOG("Writing Implementation Netlist: %s\n", verilog_filename.c_str());
 
-    std::ofstream verilog_os(verilog_filename);
+    NetlistOutputFile verilog_os(verilog_filename, opts.post_synth_netlist_compress);
     // Don't write blif and sdf, pass dummy streams
     std::ofstream blif_os;
     std::ofstream sdf_os;
@@ -30,23 +30,23 @@ void TracebackCompat::traceback_to_route_tree_x(t_trace* trace, RouteTree& tree,
     const auto& rr_graph = device_ctx.rr_graph;
     RRNodeId inode = RRNodeId(trace->index);
 
-    RouteTreeNode* new_node = new RouteTreeNode(inode, parent_switch, parent);
-    tree.add_node(parent, new_node);
-    new_node->net_pin_index = trace->net_pin_index;
-    new_node->R_upstream = std::numeric_limits<float>::quiet_NaN();
-    new_node->C_downstream = std::numeric_limits<float>::quiet_NaN();
-    new_node->Tdel = std::numeric_limits<float>::quiet_NaN();
+    RouteTreeNode new_node_value(inode, parent_switch);
+    new_node_value.net_pin_index = trace->net_pin_index;
+    new_node_value.R_upstream = std::numeric_limits<float>::quiet_NaN();
+    new_node_value.C_downstream = std::numeric_limits<float>::quiet_NaN();
+    new_node_value.Tdel = std::numeric_limits<float>::quiet_NaN();
     auto node_type = rr_graph.node_type(inode);
     if (node_type == IPIN || node_type == SINK)
-        new_node->re_expand = false;
+        new_node_value.re_expand = false;
     else
-        new_node->re_expand = true;
+        new_node_value.re_expand = true;
+    RouteTreeNode* new_node = tree.add_node(parent, new_node_value);
 
     if (rr_graph.node_type(inode) == SINK) {
         /* The traceback returns to the previous branch point if there is more than one SINK, otherwise we are at the last SINK */
         if (trace->next) {
             RRNodeId next_rr_node = RRNodeId(trace->next->index);
-            RouteTreeNode* branch = tree._rr_node_to_rt_node.at(next_rr_node);
+            RouteTreeNode* branch = tree._pool->get(tree._rr_node_to_rt_node.at(next_rr_node));
             VTR_ASSERT(trace->next->next);
             traceback_to_route_tree_x(trace->next->next, tree, branch, RRSwitchId(trace->next->iswitch));
         }
@@ -130,7 +130,7 @@ void print_traceback(const t_trace* trace) {
             VTR_LOG("*"); //Reached non-configurably
         }
 
-        if (route_ctx.rr_node_route_inf[inode].occ() > rr_graph.node_capacity(inode)) {
+        if (route_ctx.rr_node_cong_inf[inode].occ() > rr_graph.node_capacity(inode)) {
             VTR_LOG(" x"); //Overused
         }
         VTR_LOG("\n");
@@ -0,0 +1,509 @@
+#include "parallel_blif_parse.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#ifdef VPR_USE_TBB
+#    include <tbb/parallel_for.h>
+#endif
+
+#include "vtr_assert.h"
+#include "vtr_util.h"
+
+#include "mapped_file_data.h"
+
+namespace {
+
+///@brief Number of chunks tokenized together before their statements are parsed
+constexpr size_t BLIF_PARSE_WINDOW_CHUNKS = 64;
+
+/**
+ * @brief A logical line: the tokens of one statement or .names cover row,
+ *        with line continuations joined and comments removed.
+ *
+ *      lineno      : line (within the chunk, from 0) on which the logical line ends
+ *      first_token : index of the first token of the line in its chunk's tokens
+ *      num_tokens  : number of tokens of the line
+ */
+struct t_blif_line {
+    int lineno;
+    size_t first_token;
+    size_t num_tokens;
+};
+
+/**
+ * @brief A range of the file which starts and ends at logical line
+ *        boundaries, and its tokens.
+ *
+ * The tokens point into the file data, so they remain valid for as long as
+ * the file is open.
+ */
+struct t_blif_chunk {
+    size_t begin = 0;
+    size_t end = 0;
+
+    int num_newlines = 0;
+    std::vector<std::string_view> tokens;
+    std::vector<t_blif_line> lines;
+
+    ///@brief First lexical error in the chunk (if error_msg is not empty)
+    int error_lineno = 0;
+    std::string error_near_text;
+    std::string error_msg;
+};
+
+inline bool is_blif_space(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+///@brief Returns the length of the end of line at p (0 if there is none)
+inline size_t blif_endl_length(const char* p, const char* end) {
+    if (p < end && *p == '\n') {
+        return 1;
+    }
+    if (p + 1 < end && p[0] == '\r' && p[1] == '\n') {
+        return 2;
+    }
+    return 0;
+}
+
+/**
+ * @brief Split the file into chunks of roughly chunk_bytes each, which start
+ *        and end at logical line boundaries.
+ *
+ * A line ending in a backslash may be continued on the following line, so a
+ * chunk only ends after a line which does not.
+ */
+std::vector<t_blif_chunk> split_blif_chunks(const char* data, size_t size, size_t chunk_bytes) {
+    std::vector<t_blif_chunk> chunks;
+
+    size_t begin = 0;
+    while (begin < size) {
+        size_t end = std::min(size, begin + std::max<size_t>(chunk_bytes, 1));
+        while (end < size) {
+            const char* newline = static_cast<const char*>(std::memchr(data + end, '\n', size - end));
+            if (!newline) {
+                end = size;
+                break;
+            }
+            end = newline - data + 1;
+
+            size_t last = newline - data;
+            if (last > begin && data[last - 1] == '\r') {
+                --last;
+            }
+            if (last == begin || data[last - 1] != '\\') {
+                break;
+            }
+        }
+
+        t_blif_chunk chunk;
+        chunk.begin = begin;
+        chunk.end = end;
+        chunks.push_back(std::move(chunk));
+        begin = end;
+    }
+
+    return chunks;
+}
+
+/**
+ * @brief Split a chunk into logical lines of tokens.
+ *
+ * The tokens are the same as those of the libblifparse lexer: unquoted strings,
+ * quoted strings (including their quotes) and '='. Comments run from a '#' at
+ * the start of a token to the end of the line.
+ */
+void tokenize_blif_chunk(const char* data, t_blif_chunk& chunk) {
+    const char* p = data + chunk.begin;
+    const char* end = data + chunk.end;
+
+    int lineno = 0;
+    size_t line_first_token = 0;
+
+    auto end_line = [&]() {
+        size_t num_tokens = chunk.tokens.size() - line_first_token;
+        if (num_tokens > 0) {
+            chunk.lines.push_back({lineno, line_first_token, num_tokens});
+        }
+        line_first_token = chunk.tokens.size();
+    };
+
+    auto set_error = [&](const char* near_text, size_t near_text_len, const char* msg) {
+        if (chunk.error_msg.empty()) {
+            chunk.error_lineno = lineno;
+            chunk.error_near_text.assign(near_text, near_text_len);
+            chunk.error_msg = msg;
+        }
+    };
+
+    while (p < end) {
+        char c = *p;
+        if (c == '\n') {
+            end_line();
+            ++lineno;
+            ++p;
+        } else if (is_blif_space(c)) {
+            ++p;
+        } else if (c == '#') {
+            //Comment to the end of the line
+            while (p < end && *p != '\n') {
+                ++p;
+            }
+        } else if (c == '\\' && blif_endl_length(p + 1, end) > 0) {
+            //Line continuation
+            p += 1 + blif_endl_length(p + 1, end);
+            ++lineno;
+        } else if (c == '=') {
+            chunk.tokens.emplace_back(p, 1);
+            ++p;
+        } else if (c == '"') {
+            //Quoted string, which may not span lines
+            const char* close = p + 1;
+            while (close < end && *close != '"' && *close != '\n' && *close != '\r') {
+                ++close;
+            }
+            if (close < end && *close == '"') {
+                chunk.tokens.emplace_back(p, close + 1 - p);
+                p = close + 1;
+            } else {
+                set_error(p, 1, "Unrecognized character");
+                p = close;
+            }
+        } else {
+            const char* token_begin = p;
+            while (p < end && !is_blif_space(*p) && *p != '\n' && *p != '=' && *p != '"'
+                   && !(*p == '\\' && blif_endl_length(p + 1, end) > 0)) {
+                ++p;
+            }
+            chunk.tokens.emplace_back(token_begin, p - token_begin);
+        }
+    }
+    end_line();
+
+    chunk.num_newlines = lineno;
+}
+
+/**
+ * @brief Parses the logical lines of the file, in order, into calls to the
+ *        callback.
+ */
+class BlifStatementParser {
+  public:
+    explicit BlifStatementParser(blifparse::Callback& callback)
+        : callback_(callback) {}
+
+    ///@brief Parse one logical line. Returns false on a syntax error.
+    bool parse_line(const std::string_view* tokens, size_t num_tokens, int lineno) {
+        VTR_ASSERT(num_tokens > 0);
+        std::string_view keyword = tokens[0];
+
+        if (keyword.empty() || keyword[0] != '.') {
+            if (in_names_) {
+                return parse_cover_row(tokens, num_tokens, lineno);
+            }
+            return syntax_error(lineno, keyword);
+        }
+
+        //Any statement ends the single-output cover of a preceeding .names
+        flush_names();
+
+        const std::string_view* args = tokens + 1;
+        size_t num_args = num_tokens - 1;
+
+        if (keyword == ".names") {
+            if (num_args > 0 && has_eq(args, num_args)) {
+                return syntax_error(lineno, "=");
+            }
+            in_names_ = true;
+            names_lineno_ = lineno;
+            names_nets_ = to_strings(args, num_args);
+            names_cover_.clear();
+        } else if (keyword == ".subckt") {
+            if (num_args == 0 || (num_args - 1) % 3 != 0) {
+                return syntax_error(lineno, keyword);
+            }
+            std::vector<std::string> ports;
+            std::vector<std::string> nets;
+            for (size_t i = 1; i < num_args; i += 3) {
+                if (is_eq(args[i]) || !is_eq(args[i + 1]) || is_eq(args[i + 2])) {
+                    return syntax_error(lineno, args[i]);
+                }
+                ports.emplace_back(args[i]);
+                nets.emplace_back(args[i + 2]);
+            }
+            callback_.lineno(lineno);
+            callback_.subckt(std::string(args[0]), std::move(ports), std::move(nets));
+        } else if (keyword == ".latch") {
+            return parse_latch(args, num_args, lineno);
+        } else if (keyword == ".inputs" || keyword == ".outputs") {
+            if (has_eq(args, num_args)) {
+                return syntax_error(lineno, "=");
+            }
+            callback_.lineno(lineno);
+            if (keyword == ".inputs") {
+                callback_.inputs(to_strings(args, num_args));
+            } else {
+                callback_.outputs(to_strings(args, num_args));
+            }
+        } else if (keyword == ".model") {
+            if (num_args != 1 || is_eq(args[0])) {
+                return syntax_error(lineno, keyword);
+            }
+            callback_.lineno(lineno);
+            callback_.begin_model(std::string(args[0]));
+        } else if (keyword == ".end" || keyword == ".blackbox") {
+            if (num_args != 0) {
+                return syntax_error(lineno, args[0]);
+            }
+            callback_.lineno(lineno);
+            if (keyword == ".end") {
+                callback_.end_model();
+            } else {
+                callback_.blackbox();
+            }
+        } else if (keyword == ".conn") {
+            if (num_args != 2 || has_eq(args, num_args)) {
+                return syntax_error(lineno, keyword);
+            }
+            callback_.lineno(lineno);
+            callback_.conn(std::string(args[0]), std::string(args[1]));
+        } else if (keyword == ".cname") {
+            if (num_args != 1 || is_eq(args[0])) {
+                return syntax_error(lineno, keyword);
+            }
+            callback_.lineno(lineno);
+            callback_.cname(std::string(args[0]));
+        } else if (keyword == ".attr" || keyword == ".param") {
+            if (num_args < 1 || num_args > 2 || has_eq(args, num_args)) {
+                return syntax_error(lineno, keyword);
+            }
+            std::string name(args[0]);
+            std::string value = num_args == 2 ? std::string(args[1]) : std::string();
+            callback_.lineno(lineno);
+            if (keyword == ".attr") {
+                callback_.attr(std::move(name), std::move(value));
+            } else {
+                callback_.param(std::move(name), std::move(value));
+            }
+        } else {
+            return syntax_error(lineno, keyword);
+        }
+        return true;
+    }
+
+    ///@brief Complete parsing at the end of the file
+    void finish() {
+        flush_names();
+    }
+
+    ///@brief Report an error found while tokenizing
+    void lexical_error(int lineno, const std::string& near_text, const std::string& msg) {
+        flush_names();
+        callback_.parse_error(lineno, near_text, msg);
+    }
+
+  private:
+    static bool is_eq(std::string_view token) {
+        return token == "=";
+    }
+
+    static bool has_eq(const std::string_view* tokens, size_t num_tokens) {
+        return std::any_of(tokens, tokens + num_tokens, is_eq);
+    }
+
+    static std::vector<std::string> to_strings(const std::string_view* tokens, size_t num_tokens) {
+        return std::vector<std::string>(tokens, tokens + num_tokens);
+    }
+
+    bool syntax_error(int lineno, std::string_view near_text) {
+        callback_.parse_error(lineno, std::string(near_text), "syntax error");
+        return false;
+    }
+
+    bool parse_cover_row(const std::string_view* tokens, size_t num_tokens, int lineno) {
+        std::vector<blifparse::LogicValue> row;
+        row.reserve(names_nets_.size());
+        for (size_t itoken = 0; itoken < num_tokens; ++itoken) {
+            for (char c : tokens[itoken]) {
+                if (c == '0') {
+                    row.push_back(blifparse::LogicValue::FALSE);
+                } else if (c == '1') {
+                    row.push_back(blifparse::LogicValue::TRUE);
+                } else if (c == '-') {
+                    row.push_back(blifparse::LogicValue::DONT_CARE);
+                } else {
+                    callback_.parse_error(lineno, std::string(1, c), "Unrecognized character");
+                    return false;
+                }
+            }
+        }
+
+        if (row.size() != names_nets_.size()) {
+            callback_.parse_error(lineno, std::string(tokens[num_tokens - 1]),
+                                  vtr::string_fmt("Mismatched .names single-output cover row."
+                                                  " names connected to %zu net(s), but cover row has %zu element(s)",
+                                                  names_nets_.size(), row.size()));
+        }
+        names_cover_.push_back(std::move(row));
+        return true;
+    }
+
+    bool parse_latch(const std::string_view* args, size_t num_args, int lineno) {
+        if (num_args < 2 || num_args > 5 || has_eq(args, num_args)) {
+            return syntax_error(lineno, ".latch");
+        }
+
+        blifparse::LatchType type = blifparse::LatchType::UNSPECIFIED;
+        std::string control;
+        blifparse::LogicValue init = blifparse::LogicValue::UNKOWN;
+
+        size_t iarg = 2;
+        if (num_args >= 4) {
+            if (!parse_latch_type(args[iarg], type)) {
+                return syntax_error(lineno, args[iarg]);
+            }
+            ++iarg;
+            if (args[iarg] != "NIL") {
+                control = std::string(args[iarg]);
+            }
+            ++iarg;
+        }
+        if (iarg < num_args) {
+            if (!parse_latch_init(args[iarg], init)) {
+                return syntax_error(lineno, args[iarg]);
+            }
+            ++iarg;
+        }
+        if (iarg != num_args) {
+            return syntax_error(lineno, args[iarg]);
+        }
+
+        callback_.lineno(lineno);
+        callback_.latch(std::string(args[0]), std::string(args[1]), type, std::move(control), init);
+        return true;
+    }
+
+    static bool parse_latch_type(std::string_view token, blifparse::LatchType& type) {
+        if (token == "fe") {
+            type = blifparse::LatchType::FALLING_EDGE;
+        } else if (token == "re") {
+            type = blifparse::LatchType::RISING_EDGE;
+        } else if (token == "ah") {
+            type = blifparse::LatchType::ACTIVE_HIGH;
+        } else if (token == "al") {
+            type = blifparse::LatchType::ACTIVE_LOW;
+        } else if (token == "as") {
+            type = blifparse::LatchType::ASYNCHRONOUS;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    static bool parse_latch_init(std::string_view token, blifparse::LogicValue& init) {
+        if (token == "0") {
+            init = blifparse::LogicValue::FALSE;
+        } else if (token == "1") {
+            init = blifparse::LogicValue::TRUE;
+        } else if (token == "2") {
+            init = blifparse::LogicValue::DONT_CARE;
+        } else if (token == "3") {
+            init = blifparse::LogicValue::UNKOWN;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    void flush_names() {
+        if (!in_names_) {
+            return;
+        }
+        in_names_ = false;
+        callback_.lineno(names_lineno_);
+        callback_.names(std::move(names_nets_), std::move(names_cover_));
+        names_nets_.clear();
+        names_cover_.clear();
+    }
+
+    blifparse::Callback& callback_;
+
+    //The .names whose single-output cover is being read
+    bool in_names_ = false;
+    int names_lineno_ = 0;
+    std::vector<std::string> names_nets_;
+    std::vector<std::vector<blifparse::LogicValue>> names_cover_;
+};
+
+} // namespace
+
+void parallel_blif_parse_filename(const char* filename,
+                                  blifparse::Callback& callback,
+                                  size_t chunk_bytes) {
+    MappedFileData file(filename);
+    if (!file.is_open()) {
+        callback.parse_error(0, "", vtr::string_fmt("Could not open file '%s'.\n", filename));
+        return;
+    }
+
+    callback.start_parse();
+    callback.filename(filename);
+
+    std::vector<t_blif_chunk> chunks = split_blif_chunks(file.data(), file.size(), chunk_bytes);
+
+    BlifStatementParser parser(callback);
+    bool parsed = true;
+    int first_lineno = 1; //Line number of the start of the current chunk
+    for (size_t window_begin = 0; window_begin < chunks.size() && parsed; window_begin += BLIF_PARSE_WINDOW_CHUNKS) {
+        size_t window_end = std::min(chunks.size(), window_begin + BLIF_PARSE_WINDOW_CHUNKS);
+
+        //Tokenize the chunks of the window independently...
+#ifdef VPR_USE_TBB
+        tbb::parallel_for(window_begin, window_end, [&](size_t ichunk) {
+            tokenize_blif_chunk(file.data(), chunks[ichunk]);
+        });
+#else
+        for (size_t ichunk = window_begin; ichunk < window_end; ++ichunk) {
+            tokenize_blif_chunk(file.data(), chunks[ichunk]);
+        }
+#endif
+
+        //...then parse their statements in file order
+        for (size_t ichunk = window_begin; ichunk < window_end && parsed; ++ichunk) {
+            t_blif_chunk& chunk = chunks[ichunk];
+            for (const t_blif_line& line : chunk.lines) {
+                if (!chunk.error_msg.empty() && line.lineno >= chunk.error_lineno) {
+                    break;
+                }
+                parsed = parser.parse_line(chunk.tokens.data() + line.first_token, line.num_tokens, first_lineno + line.lineno);
+                if (!parsed) {
+                    break;
+                }
+            }
+            if (parsed && !chunk.error_msg.empty()) {
+                parser.lexical_error(first_lineno + chunk.error_lineno, chunk.error_near_text, chunk.error_msg);
+                parsed = false;
+            }
+            first_lineno += chunk.num_newlines;
+
+            //Free the chunk's tokens, and let the OS drop the pages of the file
+            //which have been parsed
+            chunk = t_blif_chunk();
+        }
+        file.release_until(window_end < chunks.size() ? chunks[window_end].begin : file.size());
+    }
+
+    if (parsed) {
+        parser.finish();
+    } else {
+        callback.parse_error(0, "", "File failed to parse.\n");
+    }
+
+    callback.finish_parse();
+}
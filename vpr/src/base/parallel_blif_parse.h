@@ -0,0 +1,36 @@
+#ifndef PARALLEL_BLIF_PARSE_H
+#define PARALLEL_BLIF_PARSE_H
+
+/**
+ * @file
+ * @brief A BLIF/EBLIF reader for very large netlists.
+ *
+ * The file is memory mapped and split into chunks at line boundaries. The
+ * chunks are tokenized in parallel (when VPR is built with TBB), a window of
+ * chunks at a time so that the tokens of only part of the file are in memory
+ * at once. The tokenized statements are then passed, in file order, to the
+ * same blifparse::Callback interface used by libblifparse, so the netlist is
+ * built exactly as it would be by blifparse::blif_parse_filename().
+ */
+
+#include <cstddef>
+
+#include "blifparse.hpp"
+
+///@brief Default number of bytes of the file tokenized by one task
+constexpr size_t DEFAULT_BLIF_PARSE_CHUNK_BYTES = 1 << 20;
+
+/**
+ * @brief Parse the BLIF/EBLIF file filename, calling the callback for every
+ *        statement in file order.
+ *
+ *  @param filename     The file to parse.
+ *  @param callback     Receives the parsed statements (and any errors).
+ *  @param chunk_bytes  Approximate size, in bytes, of the chunks the file is
+ *                      split into for parallel tokenization.
+ */
+void parallel_blif_parse_filename(const char* filename,
+                                  blifparse::Callback& callback,
+                                  size_t chunk_bytes = DEFAULT_BLIF_PARSE_CHUNK_BYTES);
+
+#endif /* PARALLEL_BLIF_PARSE_H */
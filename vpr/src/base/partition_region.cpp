@@ -3,6 +3,7 @@
 #include "region.h"
 #include "globals.h"
 
+#include <algorithm>
 #include <utility>
 
 void PartitionRegion::add_to_part_region(Region region) {
@@ -38,6 +39,69 @@ bool PartitionRegion::is_loc_in_part_reg(const t_pl_loc& loc) const {
     return is_in_pr;
 }
 
+PartitionRegionIndex::PartitionRegionIndex(const PartitionRegion& pr) {
+    for (const Region& region : pr.get_regions()) {
+        if (!region.empty()) {
+            regions_.push_back(region);
+        }
+    }
+
+    if (regions_.empty()) {
+        return;
+    }
+
+    // regions are added to the columns in this order, so each column's regions are sorted by lowest y
+    std::stable_sort(regions_.begin(), regions_.end(), [](const Region& lhs, const Region& rhs) {
+        return lhs.get_rect().ymin() < rhs.get_rect().ymin();
+    });
+
+    xmin_ = regions_[0].get_rect().xmin();
+    int xmax = regions_[0].get_rect().xmax();
+    for (const Region& region : regions_) {
+        xmin_ = std::min(xmin_, region.get_rect().xmin());
+        xmax = std::max(xmax, region.get_rect().xmax());
+    }
+
+    // count the regions of each column, then fill them in
+    const int num_columns = xmax - xmin_ + 1;
+    column_first_.resize(num_columns + 1, 0);
+    for (const Region& region : regions_) {
+        for (int x = region.get_rect().xmin(); x <= region.get_rect().xmax(); x++) {
+            column_first_[x - xmin_ + 1]++;
+        }
+    }
+    for (int column = 0; column < num_columns; column++) {
+        column_first_[column + 1] += column_first_[column];
+    }
+
+    column_regions_.resize(column_first_[num_columns]);
+    std::vector<int> column_next(column_first_.begin(), column_first_.end() - 1);
+    for (int iregion = 0; iregion < (int)regions_.size(); iregion++) {
+        for (int x = regions_[iregion].get_rect().xmin(); x <= regions_[iregion].get_rect().xmax(); x++) {
+            column_regions_[column_next[x - xmin_]++] = iregion;
+        }
+    }
+}
+
+bool PartitionRegionIndex::is_loc_in_part_reg(const t_pl_loc& loc) const {
+    const int column = loc.x - xmin_;
+    if (column < 0 || column + 1 >= (int)column_first_.size()) {
+        return false;
+    }
+
+    for (int i = column_first_[column]; i < column_first_[column + 1]; i++) {
+        const Region& region = regions_[column_regions_[i]];
+        if (region.get_rect().ymin() > loc.y) {
+            break; // neither this region nor the next ones reach down to loc
+        }
+        if (region.is_loc_in_reg(loc)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 PartitionRegion intersection(const PartitionRegion& cluster_pr, const PartitionRegion& new_pr) {
     /**for N regions in part_region and M in the calling object you can get anywhere from
      * 0 to M*N regions in the resulting vector. Only intersection regions with non-zero area rectangles and
@@ -64,6 +64,32 @@ class PartitionRegion {
     std::vector<Region> regions; ///< union of rectangular regions that a partition can be placed in
 };
 
+/**
+ * @brief A spatial index of the regions of a PartitionRegion
+ *
+ * Answers PartitionRegion::is_loc_in_part_reg() without scanning all the regions, which matters
+ * for PartitionRegions made of many regions. For each grid column within the x extent of the regions,
+ * the index stores the regions covering the column, sorted by their lowest y. A look-up only checks
+ * the regions covering the location's column, up to the first one starting above the location.
+ */
+class PartitionRegionIndex {
+  public:
+    PartitionRegionIndex() = default;
+
+    explicit PartitionRegionIndex(const PartitionRegion& pr);
+
+    ///@brief Same as PartitionRegion::is_loc_in_part_reg() for the indexed PartitionRegion
+    bool is_loc_in_part_reg(const t_pl_loc& loc) const;
+
+  private:
+    std::vector<Region> regions_; ///< the (non-empty) regions, sorted by lowest y
+    int xmin_ = 0;                ///< the lowest x of the regions (i.e. of the first indexed column)
+
+    ///@brief The regions covering each column are column_regions_[column_first_[x - xmin_]..column_first_[x - xmin_ + 1]-1]
+    std::vector<int> column_first_;
+    std::vector<int> column_regions_;
+};
+
 ///@brief used to print data from a PartitionRegion
 void print_partition_region(FILE* fp, const PartitionRegion& pr);
 
@@ -22,6 +22,7 @@
 #include "read_place.h"
 #include "read_route.h"
 #include "route.h"
+#include "route_warm_start.h"
 #include "route_export.h"
 #include "draw.h"
 #include "stats.h"
@@ -70,6 +71,7 @@ int binary_search_place_and_route(const Netlist<>& placement_net_list,
                                   const std::shared_ptr<RoutingDelayCalculator>& delay_calc,
                                   bool is_flat) {
     vtr::vector<ParentNetId, vtr::optional<RouteTree>> best_routing; /* Saves the best routing found so far. */
+    RoutingWarmStart warm_start;                                     /* Routing of the previous attempt, if warm-starting */
     int current, low, high, final;
     bool success, prev_success, prev2_success, Fc_clipped = false;
     bool using_minw_hint = false;
@@ -206,7 +208,13 @@ int binary_search_place_and_route(const Netlist<>& placement_net_list,
                         arch->Directs,
                         arch->num_directs,
                         (attempt_count == 0) ? ScreenUpdatePriority::MAJOR : ScreenUpdatePriority::MINOR,
-                        is_flat);
+                        is_flat,
+                        warm_start.empty() ? nullptr : &warm_start);
+
+        /* Re-placing changes the nets' terminals: only warm-start from the same placement */
+        if (router_opts.binary_search_warm_start && placer_opts.place_freq != PLACE_ALWAYS) {
+            warm_start.save(router_net_list);
+        }
 
         attempt_count++;
         fflush(stdout);
@@ -347,7 +355,12 @@ int binary_search_place_and_route(const Netlist<>& placement_net_list,
                             arch->Directs,
                             arch->num_directs,
                             ScreenUpdatePriority::MINOR,
-                            is_flat);
+                            is_flat,
+                            warm_start.empty() ? nullptr : &warm_start);
+
+            if (router_opts.binary_search_warm_start && placer_opts.place_freq != PLACE_ALWAYS) {
+                warm_start.save(router_net_list);
+            }
 
             if (success && !Fc_clipped) {
                 final = current;
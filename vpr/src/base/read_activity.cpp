@@ -1,4 +1,5 @@
 #include <cstring>
+#include <string>
 
 #include "read_activity.h"
 
@@ -8,10 +9,13 @@
 #include "vpr_error.h"
 
 #include "atom_netlist.h"
+#include "mapped_file_data.h"
 
-static bool add_activity_to_net(const AtomNetlist& netlist, std::unordered_map<AtomNetId, t_net_power>& atom_net_power, char* net_name, float probability, float density);
+static bool add_activity_to_net(const AtomNetlist& netlist, vtr::vector<AtomNetId, t_net_power>& atom_net_power, const std::string& net_name, float probability, float density);
 
-static bool add_activity_to_net(const AtomNetlist& netlist, std::unordered_map<AtomNetId, t_net_power>& atom_net_power, char* net_name, float probability, float density) {
+static bool is_activity_token_char(char c);
+
+static bool add_activity_to_net(const AtomNetlist& netlist, vtr::vector<AtomNetId, t_net_power>& atom_net_power, const std::string& net_name, float probability, float density) {
     AtomNetId net_id = netlist.find_net(net_name);
     if (net_id) {
         atom_net_power[net_id].probability = probability;
@@ -21,42 +25,63 @@ static bool add_activity_to_net(const AtomNetlist& netlist, std::unordered_map<A
 
     VTR_LOG_WARN(
         "Net %s found in activity file, but it does not exist in the .blif file.\n",
-        net_name);
+        net_name.c_str());
     return true;
 }
 
-std::unordered_map<AtomNetId, t_net_power> read_activity(const AtomNetlist& netlist, const char* activity_file) {
-    char buf[vtr::bufsize];
-    char* ptr;
-    char* word1;
-    char* word2;
-    char* word3;
-
-    FILE* act_file_hdl;
+static bool is_activity_token_char(char c) {
+    return !std::strchr(TOKENS "\r", c);
+}
 
-    std::unordered_map<AtomNetId, t_net_power> atom_net_power;
+vtr::vector<AtomNetId, t_net_power> read_activity(const AtomNetlist& netlist, const char* activity_file) {
+    vtr::vector<AtomNetId, t_net_power> atom_net_power(netlist.nets().size(), t_net_power{-1.0, -1.0});
 
-    for (auto net_id : netlist.nets()) {
-        atom_net_power[net_id].probability = -1.0;
-        atom_net_power[net_id].density = -1.0;
-    }
-
-    act_file_hdl = vtr::fopen(activity_file, "r");
-    if (act_file_hdl == nullptr) {
+    /* The file is mapped and scanned in place: each line holds a net name, its *
+     * probability and its density.                                             */
+    MappedFileData act_file(activity_file);
+    if (!act_file.is_open()) {
         VPR_FATAL_ERROR(VPR_ERROR_BLIF_F,
                         "Error: could not open activity file: %s\n", activity_file);
     }
 
-    ptr = vtr::fgets(buf, vtr::bufsize, act_file_hdl);
-    while (ptr != nullptr) {
-        word1 = strtok(buf, TOKENS);
-        word2 = strtok(nullptr, TOKENS);
-        word3 = strtok(nullptr, TOKENS);
-        add_activity_to_net(netlist, atom_net_power, word1, vtr::atof(word2), vtr::atof(word3));
+    const char* ptr = act_file.data();
+    const char* end = ptr + act_file.size();
+
+    //Reused across the lines, so the tokens are copied without reallocating
+    std::string words[3];
+
+    int lineno = 0;
+    while (ptr < end) {
+        const char* line_end = static_cast<const char*>(std::memchr(ptr, '\n', end - ptr));
+        if (!line_end) {
+            line_end = end;
+        }
+        ++lineno;
+
+        size_t num_words = 0;
+        while (ptr < line_end && num_words < 3) {
+            while (ptr < line_end && !is_activity_token_char(*ptr)) {
+                ++ptr;
+            }
+            const char* word_begin = ptr;
+            while (ptr < line_end && is_activity_token_char(*ptr)) {
+                ++ptr;
+            }
+            if (ptr != word_begin) {
+                words[num_words++].assign(word_begin, ptr);
+            }
+        }
+
+        if (num_words == 3) {
+            add_activity_to_net(netlist, atom_net_power, words[0], vtr::atof(words[1]), vtr::atof(words[2]));
+        } else if (num_words != 0) {
+            VPR_FATAL_ERROR(VPR_ERROR_BLIF_F,
+                            "Error: line %d of activity file %s does not have a net name, probability and density\n",
+                            lineno, activity_file);
+        }
 
-        ptr = vtr::fgets(buf, vtr::bufsize, act_file_hdl);
+        ptr = line_end + 1;
     }
-    fclose(act_file_hdl);
 
     /* Make sure all nets have an activity value */
     for (auto net_id : netlist.nets()) {
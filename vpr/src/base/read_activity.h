@@ -1,10 +1,12 @@
 #ifndef READ_ACTIVITY_H
 #define READ_ACTIVITY_H
-#include <unordered_map>
+
+#include "vtr_vector.h"
 
 #include "atom_netlist_fwd.h"
 #include "vpr_types.h"
 
-std::unordered_map<AtomNetId, t_net_power> read_activity(const AtomNetlist& netlist, const char* activity_file);
+///@brief Reads the signal probability and transition density of each atom net from an ACE activity file
+vtr::vector<AtomNetId, t_net_power> read_activity(const AtomNetlist& netlist, const char* activity_file);
 
 #endif
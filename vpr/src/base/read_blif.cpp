@@ -6,7 +6,8 @@
  * hierarchical) netlist in Berkely Logic Interchange Format (BLIF) file, and
  * builds a netlist data structure (AtomNetlist) from it.
  *
- * BLIF text parsing is handled by the blifparse library, while this file is responsible
+ * BLIF text parsing is handled by parallel_blif_parse (which tokenizes large files in
+ * parallel, and otherwise behaves as the blifparse library), while this file is responsible
  * for creating the netlist data structure.
  *
  * The main object of interest is the BlifAllocCallback struct, which implements the
@@ -38,6 +39,7 @@
 #include "arch_types.h"
 #include "echo_files.h"
 #include "hash.h"
+#include "parallel_blif_parse.h"
 
 vtr::LogicValue to_vtr_logic_value(blifparse::LogicValue);
 
@@ -745,7 +747,7 @@ AtomNetlist read_blif(e_circuit_format circuit_format,
     std::string netlist_id = vtr::secure_digest_file(blif_file);
 
     BlifAllocCallback alloc_callback(circuit_format, netlist, netlist_id, user_models, library_models);
-    blifparse::blif_parse_filename(blif_file, alloc_callback);
+    parallel_blif_parse_filename(blif_file, alloc_callback);
 
     return netlist;
 }
@@ -14,19 +14,16 @@
 #ifdef VTR_ENABLE_CAPNPROTO
 
 #    include <cmath>
+#    include <future>
 #    include <limits>
-#    include <kj/std/iostream.h>
 #    include <regex>
 #    include <string>
 #    include <unordered_map>
 #    include <unordered_set>
-#    include <zlib.h>
 #    include <iostream>
-#    include <sstream>
 
 #    include "LogicalNetlist.capnp.h"
-#    include "capnp/serialize.h"
-#    include "capnp/serialize-packed.h"
+#    include "interchange_message.h"
 
 #    include "vtr_assert.h"
 #    include "vtr_hash.h"
@@ -62,6 +59,7 @@ struct NetlistReader {
         outpad_model_ = find_model(MODEL_OUTPUT);
         main_netlist_.set_block_types(inpad_model_, outpad_model_);
 
+        prepare_cell_decls();
         prepare_port_net_maps();
 
         VTR_LOG("Reading IOs...\n");
@@ -85,18 +83,83 @@ struct NetlistReader {
 
     LogicalNetlist::Netlist::CellInstance::Reader top_cell_instance_;
 
-    std::unordered_map<size_t, std::unordered_map<std::pair<size_t, size_t>, std::string, vtr::hash_pair>> port_net_maps_;
+    /** @brief What the reader needs to know about a cell declaration, so that the cells of the instances are looked up by index rather than by name */
+    struct t_cell_decl_info {
+        bool is_gnd = false;
+        bool is_vcc = false;
 
-    /** @brief Preprocesses the port net maps, populating the port_net_maps_ hash map to be later accessed for faster lookups */
-    void prepare_port_net_maps() {
-        auto inst_list = nr_.getInstList();
+        bool is_lut = false;
+        int lut_width = 0;
+        std::string lut_init_param;
+
+        const t_model* model = nullptr; ///<Architecture model of the cell, found on first use (see cell_model())
+    };
+    std::vector<t_cell_decl_info> cell_decls_; ///<[0..num_cell_decls-1]
+
+    /** @brief The connection of a port bit of an instance to a net */
+    struct t_port_net {
+        size_t port;
+        size_t bit;
+        size_t net_name; ///<String index of the net name (or GND_NET_NAME/VCC_NET_NAME)
+    };
+    static constexpr size_t GND_NET_NAME = std::numeric_limits<size_t>::max();
+    static constexpr size_t VCC_NET_NAME = std::numeric_limits<size_t>::max() - 1;
+
+    std::vector<std::vector<t_port_net>> port_net_maps_; ///<[0..num_insts-1] -> connections of the instance, in netlist order
+
+    /** @brief Preprocesses the cell declarations, populating cell_decls_ */
+    void prepare_cell_decls() {
         auto decl_list = nr_.getCellDecls();
         auto str_list = nr_.getStrList();
+
+        cell_decls_.resize(decl_list.size());
+        for (size_t idecl = 0; idecl < decl_list.size(); ++idecl) {
+            std::string name = str_list[decl_list[idecl].getName()];
+            t_cell_decl_info& info = cell_decls_[idecl];
+
+            info.is_gnd = name == arch_.gnd_cell.first;
+            info.is_vcc = name == arch_.vcc_cell.first;
+            std::tie(info.is_lut, info.lut_width, info.lut_init_param) = is_lut_cell(name);
+        }
+    }
+
+    /** @brief Returns the architecture model of the cell declaration */
+    const t_model* cell_model(size_t cell_decl) {
+        t_cell_decl_info& info = cell_decls_[cell_decl];
+        if (!info.model) {
+            info.model = find_model(nr_.getStrList()[nr_.getCellDecls()[cell_decl].getName()]);
+        }
+        return info.model;
+    }
+
+    /** @brief Returns the name of the net of a t_port_net */
+    std::string net_name(size_t net_name_idx) {
+        if (net_name_idx == GND_NET_NAME)
+            return arch_.gnd_net;
+        if (net_name_idx == VCC_NET_NAME)
+            return arch_.vcc_net;
+        return nr_.getStrList()[net_name_idx];
+    }
+
+    /** @brief Returns the connection of the port bit of an instance (nullptr if unconnected) */
+    const t_port_net* find_port_net(size_t inst, size_t port, size_t bit) const {
+        for (const t_port_net& port_net : port_net_maps_[inst]) {
+            if (port_net.port == port && port_net.bit == bit)
+                return &port_net;
+        }
+        return nullptr;
+    }
+
+    /** @brief Preprocesses the port net maps, populating port_net_maps_ to be later accessed for faster lookups */
+    void prepare_port_net_maps() {
+        auto inst_list = nr_.getInstList();
         auto port_list = nr_.getPortList();
         auto top_cell = nr_.getCellList()[nr_.getTopInst().getCell()];
 
+        port_net_maps_.resize(inst_list.size());
+
         for (auto net : top_cell.getNets()) {
-            std::string net_name = str_list[net.getName()];
+            size_t net_name = net.getName();
 
             // Rename constant nets to their correct name based on the device architecture
             // database
@@ -106,11 +169,11 @@ struct NetlistReader {
 
                 auto port_inst = port.getInst();
                 auto cell = inst_list[port_inst].getCell();
-                if (str_list[decl_list[cell].getName()] == arch_.gnd_cell.first)
-                    net_name = arch_.gnd_net;
+                if (cell_decls_[cell].is_gnd)
+                    net_name = GND_NET_NAME;
 
-                if (str_list[decl_list[cell].getName()] == arch_.vcc_cell.first)
-                    net_name = arch_.vcc_net;
+                if (cell_decls_[cell].is_vcc)
+                    net_name = VCC_NET_NAME;
             }
 
             for (auto port : net.getPortInsts()) {
@@ -129,12 +192,9 @@ struct NetlistReader {
 
                 port_bit = start < end ? port_bit : bus_size - port_bit;
 
-                auto pair = std::make_pair(port_idx, port_bit);
-                std::unordered_map<std::pair<size_t, size_t>, std::string, vtr::hash_pair> map{{pair, net_name}};
-
-                auto result = port_net_maps_.emplace(inst, map);
-                if (!result.second)
-                    result.first->second.emplace(pair, net_name);
+                // The first connection of a port bit is kept
+                if (!find_port_net(inst, port_idx, port_bit))
+                    port_net_maps_[inst].push_back({port_idx, port_bit, net_name});
             }
         }
     }
@@ -202,26 +262,22 @@ struct NetlistReader {
         auto port_list = nr_.getPortList();
         auto str_list = nr_.getStrList();
 
-        std::vector<std::tuple<size_t, int, std::string>> insts;
+        std::vector<size_t> insts;
         for (auto cell_inst : top_cell.getInsts()) {
-            auto cell = decl_list[inst_list[cell_inst].getCell()];
-
-            bool is_lut;
-            int width;
-            std::string init_param;
-            std::tie(is_lut, width, init_param) = is_lut_cell(str_list[cell.getName()]);
-
-            if (!is_lut)
-                continue;
-
-            insts.emplace_back(cell_inst, width, init_param);
+            if (cell_decls_[inst_list[cell_inst].getCell()].is_lut)
+                insts.push_back(cell_inst);
         }
 
-        for (auto inst : insts) {
-            size_t inst_idx;
-            int lut_width;
-            std::string init_param;
-            std::tie(inst_idx, lut_width, init_param) = inst;
+        const std::regex vhex_regex("[0-9]+'h([0-9A-Z]+)");
+        const std::regex vbit_regex("[0-9]+'b([0-9]+)");
+        const std::regex chex_regex("0x([0-9A-Za-z]+)");
+        const std::regex cbit_regex("0b([0-9]+)");
+        const std::regex bit_regex("[0-1]+");
+
+        for (size_t inst_idx : insts) {
+            const t_cell_decl_info& cell_decl = cell_decls_[inst_list[inst_idx].getCell()];
+            int lut_width = cell_decl.lut_width;
+            const std::string& init_param = cell_decl.lut_init_param;
 
             std::string inst_name = str_list[inst_list[inst_idx].getName()];
 
@@ -233,11 +289,6 @@ struct NetlistReader {
 
                 // TODO: export this to a library function to have generic parameter decoding
                 if (entry.which() == LogicalNetlist::Netlist::PropertyMap::Entry::TEXT_VALUE) {
-                    const std::regex vhex_regex("[0-9]+'h([0-9A-Z]+)");
-                    const std::regex vbit_regex("[0-9]+'b([0-9]+)");
-                    const std::regex chex_regex("0x([0-9A-Za-z]+)");
-                    const std::regex cbit_regex("0b([0-9]+)");
-                    const std::regex bit_regex("[0-1]+");
                     std::string init_str = str_list[entry.getTextValue()];
                     std::smatch regex_matches;
 
@@ -323,16 +374,13 @@ struct NetlistReader {
             AtomPortId oport_id = main_netlist_.create_port(blk_id, blk_model->outputs);
 
             auto cell_lib = decl_list[inst_list[inst_idx].getCell()];
-            auto port_net_map = port_net_maps_.at(inst_idx);
             int inum = 0;
             for (auto port : cell_lib.getPorts()) {
-                std::pair<size_t, size_t> pair{port, 0};
-
-                if (port_net_map.find(pair) == port_net_map.end())
+                const t_port_net* port_net = find_port_net(inst_idx, port, 0);
+                if (!port_net)
                     continue;
 
-                auto net_name = port_net_map.at(pair);
-                AtomNetId net_id = main_netlist_.create_net(net_name);
+                AtomNetId net_id = main_netlist_.create_net(net_name(port_net->net_name));
 
                 auto dir = port_list[port].getDir();
                 switch (dir) {
@@ -352,19 +400,13 @@ struct NetlistReader {
 
     void read_blocks() {
         auto top_cell = nr_.getCellList()[nr_.getTopInst().getCell()];
-        auto decl_list = nr_.getCellDecls();
         auto inst_list = nr_.getInstList();
         auto port_list = nr_.getPortList();
         auto str_list = nr_.getStrList();
 
         std::vector<std::pair<size_t, size_t>> insts;
         for (auto cell_inst : top_cell.getInsts()) {
-            auto cell = decl_list[inst_list[cell_inst].getCell()];
-
-            bool is_lut;
-            std::tie(is_lut, std::ignore, std::ignore) = is_lut_cell(str_list[cell.getName()]);
-
-            if (!is_lut)
+            if (!cell_decls_[inst_list[cell_inst].getCell()].is_lut)
                 insts.emplace_back(cell_inst, inst_list[cell_inst].getCell());
         }
 
@@ -372,8 +414,7 @@ struct NetlistReader {
             auto inst_idx = inst_pair.first;
             auto cell_idx = inst_pair.second;
 
-            auto model_name = str_list[decl_list[cell_idx].getName()];
-            const t_model* blk_model = find_model(model_name);
+            const t_model* blk_model = cell_model(cell_idx);
 
             std::string inst_name = str_list[inst_list[inst_idx].getName()];
             VTR_ASSERT(inst_name.empty() == 0);
@@ -388,12 +429,10 @@ struct NetlistReader {
                           inst_name.c_str(), conflicting_model->name, blk_model->name);
             }
 
-            auto port_net_map = port_net_maps_.at(inst_idx);
-
-            auto cell = decl_list[inst_list[inst_idx].getCell()];
-            if (str_list[cell.getName()] == arch_.vcc_cell.first)
+            const t_cell_decl_info& cell_decl = cell_decls_[cell_idx];
+            if (cell_decl.is_vcc)
                 inst_name = arch_.vcc_cell.first;
-            else if (str_list[cell.getName()] == arch_.gnd_cell.first)
+            else if (cell_decl.is_gnd)
                 inst_name = arch_.gnd_cell.first;
 
             if (main_netlist_.find_block(inst_name))
@@ -403,15 +442,17 @@ struct NetlistReader {
             blk_id = main_netlist_.create_block(inst_name, blk_model);
 
             std::unordered_set<AtomPortId> added_ports;
-            for (auto port_net : port_net_map) {
-                auto port_idx = port_net.first.first;
-                auto port_bit = port_net.first.second;
+            for (const t_port_net& port_net : port_net_maps_[inst_idx]) {
+                auto port_idx = port_net.port;
+                auto port_bit = port_net.bit;
 
-                auto net_name = port_net.second;
+                std::string net_name;
                 if (inst_name == arch_.vcc_cell.first)
                     net_name = arch_.vcc_net;
                 else if (inst_name == arch_.gnd_cell.first)
                     net_name = arch_.gnd_net;
+                else
+                    net_name = this->net_name(port_net.net_name);
 
                 auto port = port_list[port_idx];
                 auto port_name = str_list[port.getName()];
@@ -431,7 +472,7 @@ struct NetlistReader {
                 AtomPortId port_id = main_netlist_.create_port(blk_id, model_port);
 
                 //Make the net
-                AtomNetId net_id = main_netlist_.create_net(std::string(net_name));
+                AtomNetId net_id = main_netlist_.create_net(net_name);
 
                 //Make the pin
                 main_netlist_.create_pin(port_id, port_bit, net_id, pin_type);
@@ -530,45 +571,16 @@ AtomNetlist read_interchange_netlist(const char* ic_netlist_file,
                                      t_arch& arch) {
 #ifdef VTR_ENABLE_CAPNPROTO
     AtomNetlist netlist;
-    std::string netlist_id = vtr::secure_digest_file(ic_netlist_file);
-
-    // Decompress GZipped capnproto device file
-    gzFile file = gzopen(ic_netlist_file, "r");
-    VTR_ASSERT(file != Z_NULL);
-
-    std::vector<uint8_t> output_data;
-    output_data.resize(4096);
-    std::stringstream sstream(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
-    while (true) {
-        int ret = gzread(file, output_data.data(), output_data.size());
-        VTR_ASSERT(ret >= 0);
-        if (ret > 0) {
-            sstream.write((const char*)output_data.data(), ret);
-            VTR_ASSERT(sstream);
-        } else {
-            VTR_ASSERT(ret == 0);
-            int error;
-            gzerror(file, &error);
-            VTR_ASSERT(error == Z_OK);
-            break;
-        }
-    }
-
-    VTR_ASSERT(gzclose(file) == Z_OK);
-
-    sstream.seekg(0);
-    kj::std::StdInputStream istream(sstream);
-
-    // Reader options
-    capnp::ReaderOptions reader_options;
-    reader_options.nestingLimit = std::numeric_limits<int>::max();
-    reader_options.traversalLimitInWords = std::numeric_limits<uint64_t>::max();
 
-    capnp::InputStreamMessageReader message_reader(istream, reader_options);
+    // The digest of the netlist file is computed while it is decompressed
+    std::future<std::string> netlist_id = std::async(std::launch::async, [&]() {
+        return vtr::secure_digest_file(ic_netlist_file);
+    });
 
-    auto netlist_reader = message_reader.getRoot<LogicalNetlist::Netlist>();
+    InterchangeMessage message(ic_netlist_file);
+    auto netlist_reader = message.getRoot<LogicalNetlist::Netlist>();
 
-    NetlistReader reader(netlist, netlist_reader, netlist_id, ic_netlist_file, arch);
+    NetlistReader reader(netlist, netlist_reader, netlist_id.get(), ic_netlist_file, arch);
 
     return netlist;
 
@@ -61,6 +61,8 @@ static t_pb_routes alloc_pb_route(t_pb_graph_node* pb_graph_node);
 
 static void load_atom_pin_mapping(const ClusteredNetlist& clb_nlist);
 
+static void create_cluster_ports(ClusteredNetlist& clb_nlist, const ClusterBlockId blk_id);
+
 /**
  * @brief Initializes the clb_nlist with info from a netlist
  *
@@ -196,18 +198,7 @@ ClusteredNetlist read_netlist(const char* net_file,
         VTR_ASSERT(num_primitives >= 0);
         VTR_ASSERT(static_cast<size_t>(num_primitives) == atom_ctx.nlist.blocks().size());
 
-        /* Error check */
-        for (auto blk_id : atom_ctx.nlist.blocks()) {
-            if (atom_ctx.lookup.atom_pb(blk_id) == nullptr) {
-                VPR_FATAL_ERROR(VPR_ERROR_NET_F,
-                                ".blif file and .net file do not match, .net file missing atom %s.\n",
-                                atom_ctx.nlist.block_name(blk_id).c_str());
-            }
-        }
-        /* TODO: Add additional check to make sure net connections match */
-        mark_constant_generators(clb_nlist, verbosity);
-
-        load_external_nets_and_cb(clb_nlist);
+        finish_loading_clustered_netlist(clb_nlist, verbosity);
     } catch (pugiutil::XmlError& e) {
         vpr_throw(VPR_ERROR_NET_F, e.filename_c_str(), e.line(),
                   "Error loading post-pack netlist (%s)", e.what());
@@ -216,6 +207,51 @@ ClusteredNetlist read_netlist(const char* net_file,
     /* TODO: create this function later
      * check_top_IO_matches_IO_blocks(circuit_inputs, circuit_outputs, circuit_clocks, blist, bcount); */
 
+    clock_t end = clock();
+
+    VTR_LOG("Finished loading packed FPGA netlist file (took %g seconds).\n", (float)(end - begin) / CLOCKS_PER_SEC);
+
+    size_t num_pb_route_used = 0;
+    size_t num_pb_route_alloc = 0;
+    size_t num_pb_pins = 0;
+    for (auto clb : clb_nlist.blocks()) {
+        t_pb* pb = clb_nlist.block_pb(clb);
+
+        for (int ipin = 0; ipin < pb->pb_graph_node->total_pb_pins; ++ipin) {
+            if (pb->pb_route.count(ipin)) {
+                ++num_pb_route_alloc;
+                if (pb->pb_route[ipin].atom_net_id) {
+                    ++num_pb_route_used;
+                }
+            }
+            ++num_pb_pins;
+        }
+    }
+
+    return clb_nlist;
+}
+
+void finish_loading_clustered_netlist(ClusteredNetlist& clb_nlist, int verbosity) {
+    auto& atom_ctx = g_vpr_ctx.mutable_atom();
+
+    /* Error check */
+    for (auto blk_id : atom_ctx.nlist.blocks()) {
+        if (atom_ctx.lookup.atom_pb(blk_id) == nullptr) {
+            VPR_FATAL_ERROR(VPR_ERROR_NET_F,
+                            ".blif file and .net file do not match, .net file missing atom %s.\n",
+                            atom_ctx.nlist.block_name(blk_id).c_str());
+        }
+    }
+    /* TODO: Add additional check to make sure net connections match */
+    mark_constant_generators(clb_nlist, verbosity);
+
+    //Create the ports in the clb_nlist for each top-level pb
+    for (auto blk_id : clb_nlist.blocks()) {
+        create_cluster_ports(clb_nlist, blk_id);
+    }
+
+    load_external_nets_and_cb(clb_nlist);
+
     /* load mapping between external nets and all nets */
     for (auto net_id : atom_ctx.nlist.nets()) {
         atom_ctx.lookup.set_atom_clb_net(net_id, ClusterNetId::INVALID());
@@ -232,7 +268,6 @@ ClusteredNetlist read_netlist(const char* net_file,
     /* We have to make set the following variables after the mapping between cluster nets and atom nets
      * is created
      */
-    const AtomNetlist atom_nlist = g_vpr_ctx.atom().nlist;
     for (auto clb_net : clb_nlist.nets()) {
         AtomNetId atom_net = atom_ctx.lookup.atom_net(clb_net);
         VTR_ASSERT(atom_net != AtomNetId::INVALID());
@@ -246,29 +281,32 @@ ClusteredNetlist read_netlist(const char* net_file,
 
     /* load mapping between atom pins and pb_graph_pins */
     load_atom_pin_mapping(clb_nlist);
+}
 
-    clock_t end = clock();
-
-    VTR_LOG("Finished loading packed FPGA netlist file (took %g seconds).\n", (float)(end - begin) / CLOCKS_PER_SEC);
-
-    size_t num_pb_route_used = 0;
-    size_t num_pb_route_alloc = 0;
-    size_t num_pb_pins = 0;
-    for (auto clb : clb_nlist.blocks()) {
-        t_pb* pb = clb_nlist.block_pb(clb);
+/**
+ * @brief Creates the ports of a clustered block from its pb_type,
+ *        ordered inputs, outputs then clocks
+ */
+static void create_cluster_ports(ClusteredNetlist& clb_nlist, const ClusterBlockId blk_id) {
+    const t_pb_type* pb_type = clb_nlist.block_type(blk_id)->pb_type;
 
-        for (int ipin = 0; ipin < pb->pb_graph_node->total_pb_pins; ++ipin) {
-            if (pb->pb_route.count(ipin)) {
-                ++num_pb_route_alloc;
-                if (pb->pb_route[ipin].atom_net_id) {
-                    ++num_pb_route_used;
-                }
-            }
-            ++num_pb_pins;
+    for (int i = 0; i < pb_type->num_ports; i++) {
+        if (!pb_type->ports[i].is_clock && pb_type->ports[i].type == IN_PORT) {
+            clb_nlist.create_port(blk_id, pb_type->ports[i].name, pb_type->ports[i].num_pins, PortType::INPUT);
+        }
+    }
+    for (int i = 0; i < pb_type->num_ports; i++) {
+        if (pb_type->ports[i].type == OUT_PORT) {
+            clb_nlist.create_port(blk_id, pb_type->ports[i].name, pb_type->ports[i].num_pins, PortType::OUTPUT);
+        }
+    }
+    for (int i = 0; i < pb_type->num_ports; i++) {
+        if (pb_type->ports[i].is_clock && pb_type->ports[i].type == IN_PORT) {
+            clb_nlist.create_port(blk_id, pb_type->ports[i].name, pb_type->ports[i].num_pins, PortType::CLOCK);
         }
     }
 
-    return clb_nlist;
+    VTR_ASSERT(clb_nlist.block_ports(blk_id).size() == (unsigned)pb_type->num_ports);
 }
 
 /**
@@ -418,54 +456,11 @@ static void processPb(pugi::xml_node Parent, const ClusterBlockId index, t_pb* p
     auto clocks = pugiutil::get_single_child(Parent, "clocks", loc_data);
     processPorts(clocks, pb, pb_route, loc_data);
 
-    int num_in_ports = 0;
-    int begin_out_port;
-    int end_out_port;
-    int begin_clock_port;
-    int end_clock_port;
-
-    {
-        int num_out_ports = 0;
-        int num_clock_ports = 0;
-        for (i = 0; i < pb->pb_graph_node->pb_type->num_ports; i++) {
-            if (pb->pb_graph_node->pb_type->ports[i].is_clock
-                && pb->pb_graph_node->pb_type->ports[i].type == IN_PORT) {
-                num_clock_ports++;
-            } else if (!pb->pb_graph_node->pb_type->ports[i].is_clock
-                       && pb->pb_graph_node->pb_type->ports[i].type == IN_PORT) {
-                num_in_ports++;
-            } else {
-                VTR_ASSERT(pb->pb_graph_node->pb_type->ports[i].type == OUT_PORT);
-                num_out_ports++;
-            }
-        }
-
-        begin_out_port = num_in_ports;
-        end_out_port = begin_out_port + num_out_ports;
-        begin_clock_port = end_out_port;
-        end_clock_port = begin_clock_port + num_clock_ports;
-    }
-
     auto attrs = pugiutil::get_single_child(Parent, "attributes", loc_data, pugiutil::OPTIONAL);
     auto params = pugiutil::get_single_child(Parent, "parameters", loc_data, pugiutil::OPTIONAL);
 
     pb_type = pb->pb_graph_node->pb_type;
 
-    //Create the ports in the clb_nlist for the top-level pb
-    if (pb->is_root()) {
-        for (i = 0; i < num_in_ports; i++) {
-            clb_nlist->create_port(index, pb_type->ports[i].name, pb_type->ports[i].num_pins, PortType::INPUT);
-        }
-        for (i = begin_out_port; i < end_out_port; i++) {
-            clb_nlist->create_port(index, pb_type->ports[i].name, pb_type->ports[i].num_pins, PortType::OUTPUT);
-        }
-        for (i = begin_clock_port; i < end_clock_port; i++) {
-            clb_nlist->create_port(index, pb_type->ports[i].name, pb_type->ports[i].num_pins, PortType::CLOCK);
-        }
-
-        VTR_ASSERT(clb_nlist->block_ports(index).size() == (unsigned)pb_type->num_ports);
-    }
-
     if (pb_type->num_modes == 0) {
         /* A primitive type */
         AtomBlockId blk_id = atom_ctx.nlist.find_block(pb->name);
@@ -17,6 +17,15 @@ ClusteredNetlist read_netlist(const char* net_file,
                               bool verify_file_digests,
                               int verbosity);
 
+/**
+ * @brief Completes loading a clustered netlist whose blocks (and their pb
+ *        hierarchies and intra-block routing) have been created
+ *
+ * Creates the ports, pins and nets of the clustered blocks, and loads the
+ * atom lookups which depend on them.
+ */
+void finish_loading_clustered_netlist(ClusteredNetlist& clb_nlist, int verbosity);
+
 void set_atom_pin_mapping(const ClusteredNetlist& clb_nlist,
                           const AtomBlockId atom_blk,
                           const AtomPortId atom_port,
@@ -28,6 +28,28 @@ t_options read_options(int argc, const char** argv) {
     return args;
 }
 
+t_options read_options_throw(int argc, const char** argv) {
+    t_options args = t_options(); //Explicitly initialize for zero initialization
+
+    auto parser = create_arg_parser(argv[0], args);
+
+    try {
+        parser.parse_args_throw(argc, argv);
+    } catch (const argparse::ArgParseHelp&) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER, "Help was requested instead of a VPR run\n");
+    } catch (const argparse::ArgParseVersion&) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER, "The version was requested instead of a VPR run\n");
+    } catch (const argparse::ArgParseError& e) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER, "%s\n", e.what());
+    }
+
+    set_conditional_defaults(args);
+
+    verify_args(args);
+
+    return args;
+}
+
 struct ParseOnOff {
     ConvertedValue<bool> from_str(std::string str) {
         std::transform(str.begin(), str.end(), str.begin(), ::tolower);
@@ -210,6 +232,8 @@ struct ParseNodeReorderAlgorithm {
             conv_value.set_value(DEGREE_BFS);
         else if (str == "random_shuffle")
             conv_value.set_value(RANDOM_SHUFFLE);
+        else if (str == "tile")
+            conv_value.set_value(TILE_LOCATION);
         else {
             std::stringstream msg;
             msg << "Invalid conversion from '" << str << "' to e_rr_node_reorder_algorithm (expected one of: " << argparse::join(default_choices(), ", ") << ")";
@@ -224,15 +248,17 @@ struct ParseNodeReorderAlgorithm {
             conv_value.set_value("none");
         else if (val == DEGREE_BFS)
             conv_value.set_value("degree_bfs");
-        else {
-            VTR_ASSERT(val == RANDOM_SHUFFLE);
+        else if (val == RANDOM_SHUFFLE)
             conv_value.set_value("random_shuffle");
+        else {
+            VTR_ASSERT(val == TILE_LOCATION);
+            conv_value.set_value("tile");
         }
         return conv_value;
     }
 
     std::vector<std::string> default_choices() {
-        return {"none", "degree_bfs", "random_shuffle"};
+        return {"none", "degree_bfs", "random_shuffle", "tile"};
     }
 };
 
@@ -911,6 +937,8 @@ struct ParseRouterLookahead {
             conv_value.set_value(e_router_lookahead::MAP);
         else if (str == "compressed_map")
             conv_value.set_value(e_router_lookahead::COMPRESSED_MAP);
+        else if (str == "quantized_map")
+            conv_value.set_value(e_router_lookahead::QUANTIZED_MAP);
         else if (str == "extended_map")
             conv_value.set_value(e_router_lookahead::EXTENDED_MAP);
         else {
@@ -932,6 +960,8 @@ struct ParseRouterLookahead {
             conv_value.set_value("map");
         } else if (val == e_router_lookahead::COMPRESSED_MAP) {
             conv_value.set_value("compressed_map");
+        } else if (val == e_router_lookahead::QUANTIZED_MAP) {
+            conv_value.set_value("quantized_map");
         } else {
             VTR_ASSERT(val == e_router_lookahead::EXTENDED_MAP);
             conv_value.set_value("extended_map");
@@ -940,7 +970,7 @@ struct ParseRouterLookahead {
     }
 
     std::vector<std::string> default_choices() {
-        return {"classic", "map", "compressed_map", "extended_map"};
+        return {"classic", "map", "compressed_map", "quantized_map", "extended_map"};
     }
 };
 
@@ -953,6 +983,8 @@ struct ParsePlaceDelayModel {
             conv_value.set_value(PlaceDelayModelType::DELTA);
         else if (str == "delta_override")
             conv_value.set_value(PlaceDelayModelType::DELTA_OVERRIDE);
+        else if (str == "delta_lazy")
+            conv_value.set_value(PlaceDelayModelType::DELTA_LAZY);
         else {
             std::stringstream msg;
             msg << "Invalid conversion from '" << str << "' to PlaceDelayModelType (expected one of: " << argparse::join(default_choices(), ", ") << ")";
@@ -969,6 +1001,8 @@ struct ParsePlaceDelayModel {
             conv_value.set_value("delta");
         else if (val == PlaceDelayModelType::DELTA_OVERRIDE)
             conv_value.set_value("delta_override");
+        else if (val == PlaceDelayModelType::DELTA_LAZY)
+            conv_value.set_value("delta_lazy");
         else {
             std::stringstream msg;
             msg << "Unrecognized PlaceDelayModelType";
@@ -978,7 +1012,7 @@ struct ParsePlaceDelayModel {
     }
 
     std::vector<std::string> default_choices() {
-        return {"simple", "delta", "delta_override"};
+        return {"simple", "delta", "delta_override", "delta_lazy"};
     }
 };
 
@@ -1056,6 +1090,76 @@ struct ParseRouterFirstIterTiming {
     }
 };
 
+struct ParseRREdgeCompression {
+    ConvertedValue<e_rr_edge_compression> from_str(const std::string& str) {
+        ConvertedValue<e_rr_edge_compression> conv_value;
+        if (str == "off")
+            conv_value.set_value(e_rr_edge_compression::NONE);
+        else if (str == "on")
+            conv_value.set_value(e_rr_edge_compression::PACKED);
+        else if (str == "tiled")
+            conv_value.set_value(e_rr_edge_compression::TILED);
+        else {
+            std::stringstream msg;
+            msg << "Invalid conversion from '" << str << "' to e_rr_edge_compression (expected one of: " << argparse::join(default_choices(), ", ") << ")";
+            conv_value.set_error(msg.str());
+        }
+        return conv_value;
+    }
+
+    ConvertedValue<std::string> to_str(e_rr_edge_compression val) {
+        ConvertedValue<std::string> conv_value;
+        if (val == e_rr_edge_compression::NONE)
+            conv_value.set_value("off");
+        else if (val == e_rr_edge_compression::PACKED)
+            conv_value.set_value("on");
+        else {
+            VTR_ASSERT(val == e_rr_edge_compression::TILED);
+            conv_value.set_value("tiled");
+        }
+        return conv_value;
+    }
+
+    std::vector<std::string> default_choices() {
+        return {"off", "on", "tiled"};
+    }
+};
+
+struct ParseHugePages {
+    ConvertedValue<vtr::e_huge_pages> from_str(const std::string& str) {
+        ConvertedValue<vtr::e_huge_pages> conv_value;
+        if (str == "off")
+            conv_value.set_value(vtr::e_huge_pages::OFF);
+        else if (str == "transparent")
+            conv_value.set_value(vtr::e_huge_pages::TRANSPARENT);
+        else if (str == "explicit")
+            conv_value.set_value(vtr::e_huge_pages::EXPLICIT);
+        else {
+            std::stringstream msg;
+            msg << "Invalid conversion from '" << str << "' to e_huge_pages (expected one of: " << argparse::join(default_choices(), ", ") << ")";
+            conv_value.set_error(msg.str());
+        }
+        return conv_value;
+    }
+
+    ConvertedValue<std::string> to_str(vtr::e_huge_pages val) {
+        ConvertedValue<std::string> conv_value;
+        if (val == vtr::e_huge_pages::OFF)
+            conv_value.set_value("off");
+        else if (val == vtr::e_huge_pages::TRANSPARENT)
+            conv_value.set_value("transparent");
+        else {
+            VTR_ASSERT(val == vtr::e_huge_pages::EXPLICIT);
+            conv_value.set_value("explicit");
+        }
+        return conv_value;
+    }
+
+    std::vector<std::string> default_choices() {
+        return {"off", "transparent", "explicit"};
+    }
+};
+
 struct ParseRouterHeap {
     ConvertedValue<e_heap_type> from_str(const std::string& str) {
         ConvertedValue<e_heap_type> conv_value;
@@ -1065,6 +1169,10 @@ struct ParseRouterHeap {
             conv_value.set_value(e_heap_type::FOUR_ARY_HEAP);
         else if (str == "bucket")
             conv_value.set_value(e_heap_type::BUCKET_HEAP_APPROXIMATION);
+        else if (str == "radix")
+            conv_value.set_value(e_heap_type::RADIX_HEAP);
+        else if (str == "eight_ary")
+            conv_value.set_value(e_heap_type::EIGHT_ARY_HEAP);
         else {
             std::stringstream msg;
             msg << "Invalid conversion from '" << str << "' to e_heap_type (expected one of: " << argparse::join(default_choices(), ", ") << ")";
@@ -1079,15 +1187,19 @@ struct ParseRouterHeap {
             conv_value.set_value("binary");
         else if (val == e_heap_type::FOUR_ARY_HEAP)
             conv_value.set_value("four_ary");
-        else {
-            VTR_ASSERT(val == e_heap_type::BUCKET_HEAP_APPROXIMATION);
+        else if (val == e_heap_type::BUCKET_HEAP_APPROXIMATION)
             conv_value.set_value("bucket");
+        else if (val == e_heap_type::RADIX_HEAP)
+            conv_value.set_value("radix");
+        else {
+            VTR_ASSERT(val == e_heap_type::EIGHT_ARY_HEAP);
+            conv_value.set_value("eight_ary");
         }
         return conv_value;
     }
 
     std::vector<std::string> default_choices() {
-        return {"binary", "four_ary", "bucket"};
+        return {"binary", "four_ary", "bucket", "radix", "eight_ary"};
     }
 };
 
@@ -1100,6 +1212,8 @@ struct ParseCheckRoute {
             conv_value.set_value(e_check_route_option::QUICK);
         else if (str == "full")
             conv_value.set_value(e_check_route_option::FULL);
+        else if (str == "incremental")
+            conv_value.set_value(e_check_route_option::INCREMENTAL);
         else {
             std::stringstream msg;
             msg << "Invalid conversion from '" << str << "' to e_check_route_option (expected one of: " << argparse::join(default_choices(), ", ") << ")";
@@ -1114,15 +1228,17 @@ struct ParseCheckRoute {
             conv_value.set_value("off");
         else if (val == e_check_route_option::QUICK)
             conv_value.set_value("quick");
-        else {
-            VTR_ASSERT(val == e_check_route_option::FULL);
+        else if (val == e_check_route_option::FULL)
             conv_value.set_value("full");
+        else {
+            VTR_ASSERT(val == e_check_route_option::INCREMENTAL);
+            conv_value.set_value("incremental");
         }
         return conv_value;
     }
 
     std::vector<std::string> default_choices() {
-        return {"off", "quick", "full"};
+        return {"off", "quick", "full", "incremental"};
     }
 };
 
@@ -1166,6 +1282,8 @@ struct ParseTimingUpdateType {
             conv_value.set_value(e_timing_update_type::FULL);
         else if (str == "incremental")
             conv_value.set_value(e_timing_update_type::INCREMENTAL);
+        else if (str == "parallel_incremental")
+            conv_value.set_value(e_timing_update_type::PARALLEL_INCREMENTAL);
         else {
             std::stringstream msg;
             msg << "Invalid conversion from '" << str << "' to e_timing_update_type (expected one of: " << argparse::join(default_choices(), ", ") << ")";
@@ -1178,8 +1296,10 @@ struct ParseTimingUpdateType {
         ConvertedValue<std::string> conv_value;
         if (val == e_timing_update_type::AUTO)
             conv_value.set_value("auto");
-        if (val == e_timing_update_type::FULL)
+        else if (val == e_timing_update_type::FULL)
             conv_value.set_value("full");
+        else if (val == e_timing_update_type::PARALLEL_INCREMENTAL)
+            conv_value.set_value("parallel_incremental");
         else {
             VTR_ASSERT(val == e_timing_update_type::INCREMENTAL);
             conv_value.set_value("incremental");
@@ -1188,7 +1308,7 @@ struct ParseTimingUpdateType {
     }
 
     std::vector<std::string> default_choices() {
-        return {"auto", "full", "incremental"};
+        return {"auto", "full", "incremental", "parallel_incremental"};
     }
 };
 
@@ -1421,6 +1541,24 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
             "   this option are invoked.\n")
         .default_value("");
 
+    gfx_grp.add_argument(args.save_snapshot_images, "--save_snapshot_images")
+        .help(
+            "Saves PNG images of the placement (and of the routing utilization) at the end of"
+            " placement and routing, to <prefix>_place.png and <prefix>_route.png."
+            " Unlike --save_graphics, the images are drawn by a background thread without GTK/X11"
+            " (only cairo is required), so they can be saved in headless runs without slowing the flow down."
+            " Disabled if empty")
+        .default_value("")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    gfx_grp.add_argument(args.snapshot_image_interval, "--snapshot_image_interval")
+        .help(
+            "With --save_snapshot_images, also saves an image every this many annealing temperatures"
+            " (<prefix>_place_temp_<i>.png) and router iterations (<prefix>_route_iter_<i>.png)."
+            " 0 only saves the images of the end of each stage")
+        .default_value("0")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     auto& gen_grp = parser.add_argument_group("general options");
 
     gen_grp.add_argument(args.show_help, "--help", "-h")
@@ -1461,10 +1599,31 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
             " * full: Full timing updates are performed (may be faster \n"
             "         if circuit timing has changed significantly)\n"
             " * incr: Incremental timing updates are performed (may be \n"
-            "         faster in the face of smaller circuit timing changes)\n")
+            "         faster in the face of smaller circuit timing changes)\n"
+            " * parallel_incremental: Incremental timing updates, with the\n"
+            "         nodes of each timing graph level updated in parallel\n")
         .default_value("auto")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    gen_grp.add_argument(args.timing_corner_logic_delay_scale, "--timing_corner_logic_delay_scale")
+        .help(
+            "Scale factor applied to the logic (primitive and intra-cluster) delays of each timing corner."
+            " Each corner is analyzed in a lane of the timing analyzer's time values, so VPR must be built"
+            " with TATUM_TIME_VEC_WIDTH set to the number of corners. A single value applies to all corners."
+            " Timing-driven optimizations use the worst criticality across corners, while timing reports"
+            " and summaries are for the first corner.")
+        .nargs('+')
+        .default_value({"1.0"})
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    gen_grp.add_argument(args.timing_corner_routing_delay_scale, "--timing_corner_routing_delay_scale")
+        .help(
+            "Scale factor applied to the routing (inter-cluster) delays of each timing corner."
+            " See --timing_corner_logic_delay_scale.")
+        .nargs('+')
+        .default_value({"1.0"})
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     gen_grp.add_argument<bool, ParseOnOff>(args.CreateEchoFile, "--echo_file")
         .help(
             "Generate echo files of key internal data structures."
@@ -1517,11 +1676,37 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .action(argparse::Action::STORE_TRUE)
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    gen_grp.add_argument<bool, ParseOnOff>(args.dedicated_clock_sink_routing, "--dedicated_clock_sink_routing")
+        .help(
+            "With --two_stage_clock_routing, routes the second stage of clock nets by walking the dedicated"
+            " clock network (its ribs and spines) back from each sink to the part of the network the net"
+            " already uses, instead of a general search from the clock network source."
+            " Sinks the clock network does not reach are routed through general routing.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     gen_grp.add_argument<bool, ParseOnOff>(args.exit_before_pack, "--exit_before_pack")
         .help("Causes VPR to exit before packing starts (useful for statistics collection)")
         .default_value("off")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    gen_grp.add_argument<bool, ParseOnOff>(args.overlap_device_creation, "--overlap_device_creation")
+        .help(
+            "Builds the device grid, the routing resource graph and the router lookahead on a background thread"
+            " while a previous packing (.net file) loads, e.g. with --place or --route but not --pack, instead of after it."
+            " Only applies when the packing is loaded, the device is fixed (--device) and the channel width is"
+            " fixed (--route_chan_width); otherwise the device is created after packing as usual.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    gen_grp.add_argument<bool, ParseOnOff>(args.report_memory_usage, "--report_memory_usage")
+        .help(
+            "Prints, after each stage (packing, placement, routing and analysis), a table of the memory held by the"
+            " main data structures of VPR (routing resource graph, router lookahead, timing graph, route trees, pb graphs, ...),"
+            " including the unused capacity of their vectors, and the current resident set size.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     gen_grp.add_argument<bool, ParseOnOff>(args.strict_checks, "--strict_checks")
         .help(
             "Controls whether VPR enforces some consistency checks strictly (as errors) or treats them as warnings."
@@ -1608,7 +1793,7 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .show_in(argparse::ShowIn::HELP_ONLY);
 
     file_grp.add_argument(args.RouteFile, "--route_file")
-        .help("Path to routing file")
+        .help("Path to routing file (written/read in a compact binary format if its name ends with .bin)")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
     file_grp.add_argument(args.SDCFile, "--sdc_file")
@@ -1656,6 +1841,13 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
             "VPR's (or reconstructed external) placement solution in flat placement file format; this file lists cluster and intra-cluster placement coordinates for each atom and can be used to reconstruct a clustering and placement solution.")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    file_grp.add_argument(args.write_place_binary_file, "--write_place_binary")
+        .help(
+            "Writes the final placement to the specified file in a compact binary format, which --place_file"
+            " (recognizing the format from its contents) loads much faster than a text placement file.")
+        .metavar("PLACE_FILE")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     file_grp.add_argument(args.read_router_lookahead, "--read_router_lookahead")
         .help(
             "Reads the lookahead data from the specified file instead of computing it.")
@@ -1682,6 +1874,98 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .help("Writes the placement delay lookup to the specified file.")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    file_grp.add_argument(args.timing_model_cache_dir, "--timing_model_cache_dir")
+        .help(
+            "Directory used to cache the router lookahead, placement delay model and power technology properties between runs."
+            " Entries are keyed by a digest of their inputs (architecture, device, technology file and relevant options),"
+            " and are only used when no explicit --read_router_lookahead / --read_placement_delay_lookup"
+            " file is given. Requires VPR to be built with Cap'n Proto support."
+            " The map router lookahead is also stored in a memory-mapped format, which concurrent VPR runs"
+            " sharing the directory attach to (sharing a single copy of it) instead of loading their own."
+            " An empty value disables the cache.")
+        .default_value("")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    file_grp.add_argument(args.read_netlist_snapshot, "--read_netlist_snapshot")
+        .help(
+            "Reads the atom and packed netlists from the specified netlist snapshot (written by --write_netlist_snapshot)"
+            " instead of the circuit and .net files. Packing is always loaded from the snapshot."
+            " Requires VPR to be built with Cap'n Proto support.")
+        .metavar("SNAPSHOT_FILE")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    file_grp.add_argument(args.write_netlist_snapshot, "--write_netlist_snapshot")
+        .help(
+            "Writes the atom and packed netlists to the specified binary snapshot file once the packing is loaded,"
+            " so later runs can skip reading the circuit and .net files."
+            " Requires VPR to be built with Cap'n Proto support.")
+        .metavar("SNAPSHOT_FILE")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    file_grp.add_argument(args.write_interchange_physical_netlist, "--write_interchange_physical_netlist")
+        .help(
+            "Writes the placement and routing to the specified FPGA interchange physical netlist once the circuit"
+            " is routed. Each net is written from its driver site pin to stubs at its sink site pins, for the"
+            " downstream tools to route through the device PIPs."
+            " Requires an FPGA interchange device (--arch_format fpga-interchange) and VPR to be built with Cap'n Proto support.")
+        .metavar("PHYS_FILE")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    file_grp.add_argument<bool, ParseOnOff>(args.interchange_physical_netlist_gzip, "--interchange_physical_netlist_gzip")
+        .help("Whether the --write_interchange_physical_netlist file is gzip compressed")
+        .default_value("on")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    file_grp.add_argument(args.write_route_checkpoint, "--write_route_checkpoint")
+        .help(
+            "Writes the router state (routing, congestion costs and iteration state) to the specified binary"
+            " checkpoint file after every --route_checkpoint_interval routing iterations, so an interrupted"
+            " routing run can be continued with --route_resume."
+            " Requires VPR to be built with Cap'n Proto support.")
+        .metavar("CHECKPOINT_FILE")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    file_grp.add_argument(args.route_checkpoint_interval, "--route_checkpoint_interval")
+        .help("Number of routing iterations between the router checkpoints written by --write_route_checkpoint")
+        .default_value("1")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    file_grp.add_argument(args.route_resume, "--route_resume")
+        .help(
+            "Resumes routing from the specified router checkpoint (written by --write_route_checkpoint),"
+            " continuing with the routing iteration after the one checkpointed."
+            " The checkpoint must have been written for the same netlist, placement, architecture and"
+            " channel width, so a fixed channel width (--route_chan_width) is required."
+            " Requires VPR to be built with Cap'n Proto support.")
+        .metavar("CHECKPOINT_FILE")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    file_grp.add_argument(args.router_phase_profile, "--router_phase_profile")
+        .help(
+            "Writes the time each router thread spends on lookahead queries, heap operations,"
+            " node cost evaluation, route tree updates and timing analysis to the specified file,"
+            " as one JSON object (line) per routing iteration."
+            " Requires VPR to be built with VPR_ROUTER_PHASE_PROFILING.")
+        .metavar("JSON_FILE")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    file_grp.add_argument<bool, ParseOnOff>(args.router_phase_profile_hw_counters, "--router_phase_profile_hw_counters")
+        .help(
+            "Adds the cycles, instructions (and IPC) and cache misses of each router thread to"
+            " the --router_phase_profile of each iteration, read from perf_event hardware counters"
+            " (Linux only; counters which can't be opened, e.g. due to perf_event_paranoid, are reported as null).")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    file_grp.add_argument(args.write_phase_trace, "--write_phase_trace")
+        .help(
+            "Writes the wall time, thread and process CPU time, memory usage (current and peak RSS) and heap allocations"
+            " of each (nested) phase of the flow (packing, placement, routing, analysis and the steps they time)"
+            " to the specified file, in the Chrome trace event format (viewable in chrome://tracing or Perfetto)."
+            " Allocations are only counted if VTR is built with VTR_ENABLE_ALLOC_PROFILING.")
+        .metavar("JSON_FILE")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     file_grp.add_argument(args.out_file_prefix, "--outfile_prefix")
         .help("Prefix for output files")
         .show_in(argparse::ShowIn::HELP_ONLY);
@@ -1891,12 +2175,33 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .default_value("on")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    pack_grp.add_argument<bool, ParseOnOff>(args.pack_repack_overfull_regions_only, "--pack_repack_overfull_regions_only")
+        .help(
+            "When floorplan regions are overfull after a packing iteration, keep the clusters"
+            " away from the overfull regions and only re-pack the atoms of the clusters"
+            " constrained to them, and of the clusters they connect to (through nets of at most"
+            " --pack_transitive_fanout_threshold sinks). Otherwise the whole netlist is re-packed.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     pack_grp.add_argument(args.pack_num_moves, "--pack_num_moves")
         .help(
             "The number of moves that can be tried in packing stage")
         .default_value("100000")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    pack_grp.add_argument(args.pack_timing_update_interval, "--pack_timing_update_interval")
+        .help(
+            "Number of clusters after which timing driven clustering updates its timing analysis."
+            " The connections within the clusters closed since the last update no longer get"
+            " the inter-cluster net delay, and only the timing they affect is re-analyzed"
+            " (with incremental timing updates, see --timing_update_type)."
+            " With a criticality based --cluster_seed_type, the remaining seeds are then"
+            " reordered by their updated criticality."
+            " 0 keeps the initial timing analysis throughout clustering.")
+        .default_value("0")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     pack_grp.add_argument(args.pack_move_type, "--pack_move_type")
         .help(
             "The move type used in packing."
@@ -1904,6 +2209,15 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .default_value("semiDirectedSwap")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    pack_grp.add_argument(args.incremental_pack_file, "--incremental_pack_file")
+        .help(
+            "A packed netlist (.net) file from a previous packing of this design."
+            " Clusters whose atoms are unchanged (by name and connected nets) are"
+            " re-legalized and reused as is; only the remaining atoms are re-packed."
+            " An empty value packs from scratch.")
+        .default_value("")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     auto& place_grp = parser.add_argument_group("placement options");
 
     place_grp.add_argument(args.Seed, "--seed")
@@ -2039,6 +2353,109 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .default_value("0.0")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    place_grp.add_argument(args.place_move_batch_size, "--place_move_batch_size")
+        .help(
+            "The number of moves the annealer proposes at once against the same placement."
+            " The costs of the moves of a batch are evaluated concurrently using the threads"
+            " set by --num_workers, and the moves are then accepted or rejected in order"
+            " (moves invalidated by an earlier accepted move of the batch are re-evaluated or aborted)."
+            " Only used by the bounding_box and criticality_timing placement algorithms without NoC placement."
+            " A value of 1 runs the regular serial annealer.")
+        .default_value("1")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    place_grp.add_argument(args.place_move_candidates, "--place_move_candidates")
+        .help(
+            "The number of candidate locations the serial annealer tries for the block of each move."
+            " The proposed move and moves of the same block to random locations within the region limit"
+            " are costed against the current placement, and only the one with the lowest estimated cost"
+            " goes through the regular acceptance test."
+            " Only used by the bounding_box and criticality_timing placement algorithms without NoC placement."
+            " A value of 1 only evaluates the proposed move.")
+        .default_value("1")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    place_grp.add_argument(args.place_multilevel_levels, "--place_multilevel_levels")
+        .help(
+            "The number of coarsening levels of the multilevel annealer."
+            " Each level pairs up the groups of blocks of the previous level which are the most strongly connected,"
+            " and the moves of the anneal at a level move whole groups."
+            " The anneal starts at the coarsest level and uncoarsens one level every --place_multilevel_temps temperatures,"
+            " with proportionally fewer moves per temperature at the coarse levels."
+            " Not used with NoC placement or when resuming an anneal."
+            " A value of 0 anneals the flat netlist only.")
+        .default_value("0")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    place_grp.add_argument(args.place_multilevel_temps, "--place_multilevel_temps")
+        .help("The number of temperatures the multilevel annealer spends at each coarse level (see --place_multilevel_levels).")
+        .default_value("5")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    place_grp.add_argument(args.place_seeds, "--place_seeds")
+        .help(
+            "The number of placements to run, with seeds --seed, --seed + 1, etc."
+            " The device, timing graph and placement delay model are built once and shared by all of them."
+            " The placement with the lowest estimated critical path delay (or bounding box cost"
+            " if the placement is not timing driven) is kept and written out."
+            " Not supported with NoC placement.")
+        .default_value("1")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    place_grp.add_argument(args.place_checkpoint_file, "--place_checkpoint_file")
+        .help(
+            "File to write the state of the anneal to at the start of each temperature:"
+            " the block locations, temperature, range limit and RL agent state (a compact binary file)."
+            " An interrupted placement can then be resumed from that temperature with --place_resume.")
+        .default_value("")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    place_grp.add_argument(args.place_resume_file, "--place_resume")
+        .help(
+            "Resumes the anneal from a file written by --place_checkpoint_file, at the temperature it was saved."
+            " VPR must be run with the same netlist, architecture and placer options."
+            " Not supported with NoC placement or --place_seeds.")
+        .default_value("")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    place_grp.add_argument(args.place_anneal_telemetry_file, "--place_anneal_telemetry_file")
+        .help(
+            "CSV file to write the annealing state of each temperature to"
+            " (temperature, alpha, success rate, range limit, criticality exponent,"
+            " move limit, costs, critical path delay and run time).")
+        .default_value("")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    place_grp.add_argument(args.place_anneal_schedule_model_file, "--place_anneal_schedule_model")
+        .help(
+            "Anneal schedule model, fitted on the telemetry (--place_anneal_telemetry_file) of previous runs."
+            " Each line is '<num_blocks> <window> <min_improvement> <max_success_rate>', and the line whose number"
+            " of clustered blocks is the closest to the design's is used: once the success rate is below"
+            " max_success_rate, the anneal ends when neither the bounding box nor the timing cost improved"
+            " by more than min_improvement (relative) over the last window temperatures.")
+        .default_value("")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    place_grp.add_argument(args.place_congestion_weight, "--place_congestion_weight")
+        .help(
+            "Weight of the routing congestion cost in the placement cost."
+            " The routing demand of each net is estimated by spreading its wirelength uniformly over its bounding box (RUDY),"
+            " and the congestion cost of a net is its wirelength weighted by the average utilization its bounding box"
+            " exceeds --place_congestion_util_threshold by."
+            " The congestion cost is normalized like the bounding box cost, and the utilization it is computed against"
+            " is refreshed at each temperature."
+            " Disables --place_move_batch_size and --place_move_candidates, whose moves are costed without it."
+            " A value of 0 disables the congestion cost.")
+        .default_value("0.0")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    place_grp.add_argument(args.place_congestion_util_threshold, "--place_congestion_util_threshold")
+        .help(
+            "Estimated channel utilization (routing demand over channel width) above which"
+            " a channel is considered congested by --place_congestion_weight.")
+        .default_value("1.0")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     place_grp.add_argument(args.place_move_stats_file, "--place_move_stats")
         .help(
             "File to write detailed placer move statistics to")
@@ -2140,8 +2557,10 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
     place_grp.add_argument(args.place_reward_fun, "--place_reward_fun")
         .help(
             "The reward function used by placement RL agent."
-            "The available values are: basic, nonPenalizing_basic, runtime_aware, WLbiased_runtime_aware"
-            "The latter two are only available for timing-driven placement.")
+            "The available values are: basic, nonPenalizing_basic, runtime_aware, WLbiased_runtime_aware, cost_per_time. "
+            "runtime_aware and WLbiased_runtime_aware are only available for timing-driven placement. "
+            "cost_per_time rewards the cost improvement per microsecond spent evaluating the move type (as measured"
+            " during placement, so the placement is not reproducible from run to run).")
         .default_value("WLbiased_runtime_aware")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
@@ -2280,7 +2699,8 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
             "Valid options:\n"
             " * 'simple' uses map router lookahead\n"
             " * 'delta' uses differences in position only\n"
-            " * 'delta_override' uses differences in position with overrides for direct connects\n")
+            " * 'delta_override' uses differences in position with overrides for direct connects\n"
+            " * 'delta_lazy' is 'delta', computing each delay on its first use (only a coarse sample is computed up front)\n")
         .default_value("simple")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
@@ -2429,6 +2849,15 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .default_value("off")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    route_grp.add_argument<bool, ParseOnOff>(args.binary_search_warm_start, "--binary_search_warm_start")
+        .help(
+            "During the minimum channel width search, start routing each channel width from"
+            " the routing found at the previous one (keeping the connections whose routing"
+            " resources still exist) rather than from scratch. The routing predictor then"
+            " gives up on a channel width after fewer routing iterations.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     route_grp.add_argument<e_router_algorithm, ParseRouterAlgorithm>(args.RouterAlgorithm, "--router_algorithm")
         .help(
             "Specifies the router algorithm to use.\n"
@@ -2439,11 +2868,43 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .choices({"parallel", "parallel_decomp", "timing_driven"})
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    route_grp.add_argument<bool, ParseOnOff>(args.router_optimistic_concurrency, "--router_optimistic_concurrency")
+        .help(
+            "With the parallel router, route the nets whose bounding boxes cross a partition"
+            " cutline concurrently with each other and with the partitions on either side,"
+            " instead of serially before them. Nets may then use the same routing resource"
+            " at the same time: this shows up as congestion and is resolved in later iterations."
+            " Shortens the serial part of each iteration, but the routing is no longer"
+            " deterministic.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    route_grp.add_argument<bool, ParseOnOff>(args.router_deterministic, "--router_deterministic")
+        .help(
+            "With the parallel routers, make the routing the same for any --num_workers and"
+            " from run to run: the partitions of the nets are balanced by the routing work"
+            " (heap pops) of each net rather than its routing time, for a fixed number of"
+            " threads, and the results of the partitions are combined in a fixed order."
+            " Partitions may then be less balanced on the actual threads."
+            " Not compatible with --router_optimistic_concurrency.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     route_grp.add_argument(args.min_incremental_reroute_fanout, "--min_incremental_reroute_fanout")
         .help("The net fanout threshold above which nets will be re-routed incrementally.")
         .default_value("16")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    route_grp.add_argument(args.incremental_reroute_overuse_threshold, "--incremental_reroute_overuse_threshold")
+        .help(
+            "Once the number of overused routing resources drops to this value or below,"
+            " nets of any fanout are re-routed incrementally: only the connections whose"
+            " routing passes through an overused resource are ripped up and re-routed."
+            " (Below this, late routing iterations take time proportional to the overuse"
+            " rather than to the netlist size.) A negative value disables this.")
+        .default_value("-1")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     route_grp.add_argument<bool, ParseOnOff>(args.exit_after_first_routing_iteration, "--exit_after_first_routing_iteration")
         .help("Causes VPR to exit after the first routing iteration (useful for saving graphics)")
         .default_value("off")
@@ -2464,9 +2925,10 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
             "Specifies the node reordering algorithm to use.\n"
             " * none: don't reorder nodes\n"
             " * degree_bfs: sort by degree and then by BFS\n"
-            " * random_shuffle: a random shuffle\n")
+            " * random_shuffle: a random shuffle\n"
+            " * tile: group the nodes by location (makes edge tiling more effective)\n")
         .default_value("none")
-        .choices({"none", "degree_bfs", "random_shuffle"})
+        .choices({"none", "degree_bfs", "random_shuffle", "tile"})
         .show_in(argparse::ShowIn::HELP_ONLY);
 
     route_grp.add_argument(args.reorder_rr_graph_nodes_threshold, "--reorder_rr_graph_nodes_threshold")
@@ -2481,6 +2943,30 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .default_value("1")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    route_grp.add_argument<e_rr_edge_compression, ParseRREdgeCompression>(args.compress_rr_graph_edges, "--compress_rr_graph_edges")
+        .help(
+            "Once the RR graph is built, compress its edges to reduce RR graph memory usage:\n"
+            " * off: 10 bytes per edge\n"
+            " * on: store each edge's sink node and switch packed into 32 bits, at the cost of a slower"
+            " lookup of an edge's source node\n"
+            " * tiled: store the edges of each node as offsets from the node, shared by the nodes of all"
+            " the repeated tiles of the fabric (irregular nodes keep their own edges). Edges are decoded"
+            " from their source node. Unless --reorder_rr_graph_nodes_algorithm is set, the nodes of"
+            " generated RR graphs are reordered by location first. Falls back to 'on' if this doesn't"
+            " take less memory.\n")
+        .default_value("off")
+        .choices({"off", "on", "tiled"})
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    route_grp.add_argument<bool, ParseOnOff>(args.reuse_rr_indexed_data_delays, "--reuse_rr_indexed_data_delays")
+        .help(
+            "When an RR graph is built for another channel width (e.g. during the minimum channel width search),"
+            " reuse the wire delay estimates (T_linear, T_quadratic, C_load) computed from the previous RR graph"
+            " if it has the same grid, wire segments and RR switches, instead of walking the new RR graph."
+            " The estimates of different channel widths may differ slightly.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     route_grp.add_argument<bool, ParseOnOff>(args.flat_routing, "--flat_routing")
         .help("Enable VPR's flat routing (routing the nets from the source primitive to the destination primitive)")
         .default_value("off")
@@ -2516,6 +3002,14 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .default_value("1.2")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    route_timing_grp.add_argument<bool, ParseOnOff>(args.router_profiler_bidirectional_search, "--router_profiler_bidirectional_search")
+        .help(
+            "Whether router delay profiling searches from both the source and the sink of each connection,"
+            " stopping where the searches meet. This reduces the number of nodes explored on long connections."
+            " Path delays are costed as if each switch saw no upstream resistance (exact for buffered switches).")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     route_timing_grp.add_argument(args.astar_offset, "--astar_offset")
         .help(
             "Controls the directedness of the timing-driven router's exploration."
@@ -2620,6 +3114,17 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .default_value("0.1")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    route_timing_grp.add_argument<float>(args.router_high_fanout_batch_criticality, "--router_high_fanout_batch_criticality")
+        .help(
+            "Sinks of high fanout nets with a criticality up to this value are routed in spatial batches"
+            " (sinks sharing a region of the net's bounding box are routed one after another, and regions"
+            " are visited in a serpentine order) instead of in decreasing criticality order."
+            " Each sink then finds earlier routing close by, which keeps its search small."
+            " More critical sinks are still routed first, by criticality."
+            " A negative value disables batching.")
+        .default_value("-1")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     route_timing_grp.add_argument<e_router_lookahead, ParseRouterLookahead>(args.router_lookahead_type, "--router_lookahead")
         .help(
             "Controls what lookahead the router uses to calculate cost of completing a connection.\n"
@@ -2628,6 +3133,8 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
             " * map: An advanced lookahead which accounts for diverse wire type\n"
             " * compressed_map: The algorithm is similar to map lookahead with the exception of sparse sampling of the chip"
             " to reduce the run-time to build the router lookahead and also its memory footprint\n"
+            " * quantized_map: The map lookahead, with its delays and congestions stored as 16-bit values (with a scale\n"
+            "                  per wire type) to divide its memory footprint by 3, at the cost of a small estimation error\n"
             " * extended_map: A more advanced and extended lookahead which accounts for a more\n"
             "                 exhaustive node sampling method\n"
             "\n"
@@ -2638,6 +3145,26 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .default_value("map")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    route_timing_grp.add_argument<bool, ParseOnOff>(args.router_lookahead_correction, "--router_lookahead_correction")
+        .help(
+            "Learn a correction of the router lookahead while routing: the lookahead estimates from the wires"
+            " of each connection routed are compared to the actual costs of its path, and between routing"
+            " iterations the expected costs of wires are scaled by the ratio observed for their wire type and"
+            " distance to the sink. As congestion costs grow, this keeps the lookahead from under-estimating"
+            " them, which reduces the nodes expanded per connection in late iterations.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    route_timing_grp.add_argument<bool, ParseOnOff>(args.router_global_route_guides, "--router_global_route_guides")
+        .help(
+            "Before the first routing iteration, globally route the nets on a coarse grid of the device"
+            " (cells of a few tiles, with the capacities of the channels between them), negotiating"
+            " congestion between the nets. Each connection of the first iteration is then searched within"
+            " the corridor of its global route, falling back to the net bounding box when no path is found"
+            " there. This shrinks the wavefronts of the first iteration and spreads its congestion.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     route_timing_grp.add_argument(args.router_max_convergence_count, "--router_max_convergence_count")
         .help(
             "Controls how many times the router is allowed to converge to a legal routing before halting."
@@ -2673,6 +3200,24 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .default_value("on")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    route_timing_grp.add_argument(args.router_hold_full_update_interval, "--router_hold_full_update_interval")
+        .help(
+            "Number of router timing updates between full hold analyses."
+            " The other updates analyze setup fully, but hold only in the fanin of the endpoints"
+            " whose hold slack was below --router_hold_prune_slack at the last full hold analysis;"
+            " the other delay changes are analyzed for hold at the next full analysis."
+            " Only incremental timing updates (see --timing_update_type) can prune hold analysis."
+            " Values of 0 or 1 analyze hold fully on every update.")
+        .default_value("1")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    route_timing_grp.add_argument(args.router_hold_prune_slack, "--router_hold_prune_slack")
+        .help(
+            "Hold slack (in seconds) below which an endpoint has its hold timing re-analyzed"
+            " between full hold analyses (see --router_hold_full_update_interval)")
+        .default_value("1e-10")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     route_timing_grp.add_argument<e_heap_type, ParseRouterHeap>(args.router_heap, "--router_heap")
         .help(
             "Controls what type of heap to use for timing driven router.\n"
@@ -2681,10 +3226,36 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
             " * bucket: A bucket heap approximation is used. The bucket heap\n"
             " *         is faster because it is only a heap approximation.\n"
             " *         Testing has shown the approximation results in\n"
-            " *         similar QoR with less CPU work.\n")
+            " *         similar QoR with less CPU work.\n"
+            " * radix: An exact radix heap is used. It pops nodes in the same\n"
+            " *        cost order as the binary and four_ary heaps, but with\n"
+            " *        O(1) insertion and cheaper extraction on large heaps.\n"
+            " * eight_ary: An eight_ary heap of 8-byte elements is used. It pops\n"
+            " *            nodes in the same cost order as the four_ary heap,\n"
+            " *            with the children of each node on one cache line.\n")
         .default_value("four_ary")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    route_timing_grp.add_argument<vtr::e_huge_pages, ParseHugePages>(args.rr_graph_huge_pages, "--rr_graph_huge_pages")
+        .help(
+            "Controls the pages backing the large arrays of the RR graph (nodes and edges).\n"
+            " * off: Regular pages are used.\n"
+            " * transparent: The arrays are aligned on 2MB and marked for\n"
+            " *              transparent huge pages, if the kernel allows them.\n"
+            " * explicit: Reserved 2MB huge pages (vm.nr_hugepages) are used,\n"
+            " *           falling back to transparent ones when none are left.\n"
+            "Huge pages reduce the TLB misses of the router on large devices.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    route_timing_grp.add_argument<bool, ParseOnOff>(args.rr_graph_numa_interleave, "--rr_graph_numa_interleave")
+        .help(
+            "Interleaves the pages of the large arrays of the RR graph across the NUMA nodes,"
+            " so that router threads on every socket see the same memory latency"
+            " rather than the graph sitting on the node of the thread that built it.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     route_timing_grp.add_argument(args.router_first_iteration_timing_report_file, "--router_first_iter_timing_report")
         .help("Name of the post first routing iteration timing report file (not generated if unspecified)")
         .default_value("")
@@ -2697,10 +3268,13 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
 
     route_timing_grp.add_argument<e_check_route_option, ParseCheckRoute>(args.check_route, "--check_route")
         .help(
-            "Options to run check route in three different modes.\n"
+            "Options to run check route in four different modes.\n"
             " * off    : check route is completely disabled.\n"
             " * quick  : runs check route with slow checks disabled.\n"
-            " * full   : runs the full check route step.\n")
+            " * full   : runs the full check route step.\n"
+            " * incremental : runs the full check route step, but only on\n"
+            " *               the nets whose routing changed since it was\n"
+            " *               last checked (e.g. by a previous full check).\n")
         .default_value("full")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
@@ -2814,6 +3388,13 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .default_value("unconnected")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    analysis_grp.add_argument<bool, ParseOnOff>(args.post_synth_netlist_compress, "--post_synth_netlist_compress")
+        .help(
+            "Writes the post-implementation netlists and SDF gzip compressed,"
+            " with a '.gz' suffix added to their file names")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     analysis_grp.add_argument(args.write_timing_summary, "--write_timing_summary")
         .help("Writes implemented design final timing summary to the specified JSON, XML or TXT file.")
         .show_in(argparse::ShowIn::HELP_ONLY);
@@ -2962,6 +3543,24 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .default_value("off")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    noc_grp.add_argument<bool, ParseOnOff>(args.noc_reject_deadlocking_moves, "--noc_reject_deadlocking_moves")
+        .help(
+            "Reject the placement moves that make the traffic flow routes deadlock-prone, i.e. create a cycle "
+            "in their channel dependency graph. The graph is updated incrementally as traffic flows are re-routed. "
+            "Useful with routing algorithms that are not deadlock-free by construction (e.g. bfs_routing). "
+            "It has no effect if the initial traffic flow routes already have cyclic dependencies.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    noc_grp.add_argument<int>(args.noc_initial_placement_restarts, "--noc_initial_placement_restarts")
+        .help(
+            "The number of independent runs of the simulated annealing that places the NoC routers before "
+            "the other blocks. The first run starts from the initial random placement, the others from "
+            "different random placements, and the placement with the lowest NoC cost is kept. "
+            "The runs are done in parallel when VPR is built with multithreading support.")
+        .default_value("4")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     noc_grp.add_argument<std::string>(args.noc_placement_file_name, "--noc_placement_file_name")
         .help(
             "Name of the output file that contains the NoC placement information."
@@ -2978,6 +3577,16 @@ argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_optio
         .action(argparse::Action::STORE_TRUE)
         .default_value("off");
 
+    server_grp.add_argument<bool, ParseOnOff>(args.is_daemon_mode_enabled, "--daemon")
+        .help(
+            "Run as a daemon serving batch jobs on the --port."
+            " After implementing the circuit of its command line, VPR keeps the architecture, the device"
+            " (grid and routing resource graph) and the router lookahead resident, and implements the circuit"
+            " of each RUN_JOB request (its 'vpr_args' option holds the circuit and options, as on the command"
+            " line but without the architecture) one at a time, resetting only the per-design state between jobs.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     server_grp.add_argument<int>(args.server_port_num, "--port")
         .help("Server port number.")
         .default_value("60555")
@@ -3092,7 +3701,7 @@ void set_conditional_defaults(t_options& args) {
 
     // If MAP Router lookahead is not used, we cannot use simple place delay lookup
     if (args.place_delay_model.provenance() != Provenance::SPECIFIED) {
-        if (args.router_lookahead_type != e_router_lookahead::MAP) {
+        if (args.router_lookahead_type != e_router_lookahead::MAP && args.router_lookahead_type != e_router_lookahead::QUANTIZED_MAP) {
             args.place_delay_model.set(PlaceDelayModelType::DELTA, Provenance::INFERRED);
         }
     }
@@ -3101,9 +3710,10 @@ void set_conditional_defaults(t_options& args) {
     // If you are running WLdriven placement, the RL reward function should be
     // either basic or nonPenalizing basic
     if (args.RL_agent_placement && (args.PlaceAlgorithm == BOUNDING_BOX_PLACE || !args.timing_analysis)) {
-        if (args.place_reward_fun.value() != "basic" && args.place_reward_fun.value() != "nonPenalizing_basic") {
+        if (args.place_reward_fun.value() != "basic" && args.place_reward_fun.value() != "nonPenalizing_basic"
+            && args.place_reward_fun.value() != "cost_per_time") {
             VTR_LOG_WARN(
-                "To use RLPlace for WLdriven placements, the reward function should be basic or nonPenalizing_basic.\n"
+                "To use RLPlace for WLdriven placements, the reward function should be basic, nonPenalizing_basic or cost_per_time.\n"
                 "you can specify the reward function using --place_reward_fun.\n"
                 "Setting the placement reward function to \"basic\"\n");
             args.place_reward_fun.set("basic", Provenance::INFERRED);
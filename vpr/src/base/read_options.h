@@ -34,18 +34,35 @@ struct t_options {
     argparse::ArgValue<std::string> write_vpr_constraints_file;
     argparse::ArgValue<std::string> write_constraints_file;
     argparse::ArgValue<std::string> write_flat_place_file;
+    argparse::ArgValue<std::string> write_place_binary_file;
 
     argparse::ArgValue<std::string> write_placement_delay_lookup;
     argparse::ArgValue<std::string> read_placement_delay_lookup;
 
     argparse::ArgValue<std::string> write_router_lookahead;
     argparse::ArgValue<std::string> read_router_lookahead;
+    argparse::ArgValue<std::string> timing_model_cache_dir;
 
     argparse::ArgValue<std::string> write_intra_cluster_router_lookahead;
     argparse::ArgValue<std::string> read_intra_cluster_router_lookahead;
 
     argparse::ArgValue<std::string> write_block_usage;
 
+    argparse::ArgValue<std::string> read_netlist_snapshot;
+    argparse::ArgValue<std::string> write_netlist_snapshot;
+
+    argparse::ArgValue<std::string> write_interchange_physical_netlist;
+    argparse::ArgValue<bool> interchange_physical_netlist_gzip;
+
+    argparse::ArgValue<std::string> write_route_checkpoint;
+    argparse::ArgValue<int> route_checkpoint_interval;
+    argparse::ArgValue<std::string> route_resume;
+
+    argparse::ArgValue<std::string> router_phase_profile;
+    argparse::ArgValue<bool> router_phase_profile_hw_counters;
+
+    argparse::ArgValue<std::string> write_phase_trace;
+
     /* Stage Options */
     argparse::ArgValue<bool> do_packing;
     argparse::ArgValue<bool> do_legalize;
@@ -59,6 +76,8 @@ struct t_options {
     argparse::ArgValue<int> GraphPause;
     argparse::ArgValue<bool> save_graphics;
     argparse::ArgValue<std::string> graphics_commands;
+    argparse::ArgValue<std::string> save_snapshot_images;
+    argparse::ArgValue<int> snapshot_image_interval;
 
     /* General options */
     argparse::ArgValue<bool> show_help;
@@ -66,6 +85,8 @@ struct t_options {
     argparse::ArgValue<size_t> num_workers;
     argparse::ArgValue<bool> timing_analysis;
     argparse::ArgValue<e_timing_update_type> timing_update_type;
+    argparse::ArgValue<std::vector<float>> timing_corner_logic_delay_scale;
+    argparse::ArgValue<std::vector<float>> timing_corner_routing_delay_scale;
     argparse::ArgValue<bool> CreateEchoFile;
     argparse::ArgValue<bool> verify_file_digests;
     argparse::ArgValue<std::string> device_layout;
@@ -73,7 +94,10 @@ struct t_options {
     argparse::ArgValue<e_constant_net_method> constant_net_method;
     argparse::ArgValue<e_clock_modeling> clock_modeling;
     argparse::ArgValue<bool> two_stage_clock_routing;
+    argparse::ArgValue<bool> dedicated_clock_sink_routing;
     argparse::ArgValue<bool> exit_before_pack;
+    argparse::ArgValue<bool> overlap_device_creation;
+    argparse::ArgValue<bool> report_memory_usage;
     argparse::ArgValue<bool> strict_checks;
     argparse::ArgValue<std::string> disable_errors;
     argparse::ArgValue<std::string> suppress_warnings;
@@ -82,6 +106,7 @@ struct t_options {
 
     /* Server options */
     argparse::ArgValue<bool> is_server_mode_enabled;
+    argparse::ArgValue<bool> is_daemon_mode_enabled;
     argparse::ArgValue<int> server_port_num;
 
     /* Atom netlist options */
@@ -109,8 +134,11 @@ struct t_options {
     argparse::ArgValue<std::vector<std::string>> pack_high_fanout_threshold;
     argparse::ArgValue<int> pack_verbosity;
     argparse::ArgValue<bool> use_attraction_groups;
+    argparse::ArgValue<bool> pack_repack_overfull_regions_only;
     argparse::ArgValue<int> pack_num_moves;
+    argparse::ArgValue<int> pack_timing_update_interval;
     argparse::ArgValue<std::string> pack_move_type;
+    argparse::ArgValue<std::string> incremental_pack_file;
     /* Placement options */
     argparse::ArgValue<int> Seed;
     argparse::ArgValue<bool> ShowPlaceTiming;
@@ -129,6 +157,17 @@ struct t_options {
     argparse::ArgValue<e_pad_loc_type> pad_loc_type;
     argparse::ArgValue<int> PlaceChanWidth;
     argparse::ArgValue<float> place_rlim_escape_fraction;
+    argparse::ArgValue<int> place_move_batch_size;
+    argparse::ArgValue<int> place_move_candidates;
+    argparse::ArgValue<int> place_multilevel_levels;
+    argparse::ArgValue<int> place_multilevel_temps;
+    argparse::ArgValue<int> place_seeds;
+    argparse::ArgValue<std::string> place_checkpoint_file;
+    argparse::ArgValue<std::string> place_resume_file;
+    argparse::ArgValue<std::string> place_anneal_telemetry_file;
+    argparse::ArgValue<std::string> place_anneal_schedule_model_file;
+    argparse::ArgValue<float> place_congestion_weight;
+    argparse::ArgValue<float> place_congestion_util_threshold;
     argparse::ArgValue<std::string> place_move_stats_file;
     argparse::ArgValue<int> placement_saves_per_temperature;
     argparse::ArgValue<e_place_effort_scaling> place_effort_scaling;
@@ -172,6 +211,8 @@ struct t_options {
     argparse::ArgValue<int> noc_sat_routing_congestion_weighting_factor;
     argparse::ArgValue<int> noc_sat_routing_num_workers;
     argparse::ArgValue<bool> noc_sat_routing_log_search_progress;
+    argparse::ArgValue<bool> noc_reject_deadlocking_moves;
+    argparse::ArgValue<int> noc_initial_placement_restarts;
     argparse::ArgValue<std::string> noc_placement_file_name;
 
     /* Timing-driven placement options only */
@@ -206,8 +247,12 @@ struct t_options {
     argparse::ArgValue<int> RouteChanWidth;
     argparse::ArgValue<int> min_route_chan_width_hint; ///<Hint to binary search router about what the min chan width is
     argparse::ArgValue<bool> verify_binary_search;
+    argparse::ArgValue<bool> binary_search_warm_start;
     argparse::ArgValue<e_router_algorithm> RouterAlgorithm;
+    argparse::ArgValue<bool> router_optimistic_concurrency;
+    argparse::ArgValue<bool> router_deterministic;
     argparse::ArgValue<int> min_incremental_reroute_fanout;
+    argparse::ArgValue<int> incremental_reroute_overuse_threshold;
     argparse::ArgValue<bool> read_rr_edge_metadata;
     argparse::ArgValue<bool> exit_after_first_routing_iteration;
     argparse::ArgValue<e_check_route_option> check_route;
@@ -216,6 +261,8 @@ struct t_options {
     argparse::ArgValue<e_rr_node_reorder_algorithm> reorder_rr_graph_nodes_algorithm;
     argparse::ArgValue<int> reorder_rr_graph_nodes_threshold;
     argparse::ArgValue<int> reorder_rr_graph_nodes_seed;
+    argparse::ArgValue<e_rr_edge_compression> compress_rr_graph_edges;
+    argparse::ArgValue<bool> reuse_rr_indexed_data_delays;
     argparse::ArgValue<bool> flat_routing;
     argparse::ArgValue<bool> has_choking_spot;
     argparse::ArgValue<int> route_verbosity;
@@ -225,6 +272,7 @@ struct t_options {
     argparse::ArgValue<float> astar_fac;
     argparse::ArgValue<float> astar_offset;
     argparse::ArgValue<float> router_profiler_astar_fac;
+    argparse::ArgValue<bool> router_profiler_bidirectional_search;
     argparse::ArgValue<float> max_criticality;
     argparse::ArgValue<float> criticality_exp;
     argparse::ArgValue<float> router_init_wirelength_abort_threshold;
@@ -236,16 +284,23 @@ struct t_options {
     argparse::ArgValue<e_route_bb_update> route_bb_update;
     argparse::ArgValue<int> router_high_fanout_threshold;
     argparse::ArgValue<float> router_high_fanout_max_slope;
+    argparse::ArgValue<float> router_high_fanout_batch_criticality;
     argparse::ArgValue<int> router_debug_net;
     argparse::ArgValue<int> router_debug_sink_rr;
     argparse::ArgValue<int> router_debug_iteration;
     argparse::ArgValue<e_router_lookahead> router_lookahead_type;
+    argparse::ArgValue<bool> router_lookahead_correction;
+    argparse::ArgValue<bool> router_global_route_guides;
     argparse::ArgValue<int> router_max_convergence_count;
     argparse::ArgValue<float> router_reconvergence_cpd_threshold;
     argparse::ArgValue<bool> router_update_lower_bound_delays;
+    argparse::ArgValue<int> router_hold_full_update_interval;
+    argparse::ArgValue<float> router_hold_prune_slack;
     argparse::ArgValue<std::string> router_first_iteration_timing_report_file;
     argparse::ArgValue<e_router_initial_timing> router_initial_timing;
     argparse::ArgValue<e_heap_type> router_heap;
+    argparse::ArgValue<vtr::e_huge_pages> rr_graph_huge_pages;
+    argparse::ArgValue<bool> rr_graph_numa_interleave;
 
     /* Analysis options */
     argparse::ArgValue<bool> full_stats;
@@ -257,11 +312,14 @@ struct t_options {
     argparse::ArgValue<std::string> echo_dot_timing_graph_node;
     argparse::ArgValue<e_post_synth_netlist_unconn_handling> post_synth_netlist_unconn_input_handling;
     argparse::ArgValue<e_post_synth_netlist_unconn_handling> post_synth_netlist_unconn_output_handling;
+    argparse::ArgValue<bool> post_synth_netlist_compress;
     argparse::ArgValue<std::string> write_timing_summary;
 };
 
 argparse::ArgumentParser create_arg_parser(const std::string& prog_name, t_options& args);
 t_options read_options(int argc, const char** argv);
+///@brief Like read_options(), but throws a VprError on invalid arguments (or a help/version request) instead of exiting
+t_options read_options_throw(int argc, const char** argv);
 void set_conditional_defaults(t_options& args);
 bool verify_args(const t_options& args);
 
@@ -1,6 +1,7 @@
 #include <cstdio>
 #include <cstring>
 #include <fstream>
+#include <sstream>
 
 #include "vtr_util.h"
 #include "vtr_log.h"
@@ -15,6 +16,10 @@
 #include "read_xml_arch_file.h"
 #include "place_util.h"
 
+#ifdef VPR_USE_TBB
+#    include <tbb/parallel_for.h>
+#endif
+
 static void read_place_header(std::ifstream& placement_file,
                               const char* net_file,
                               const char* place_file,
@@ -26,11 +31,25 @@ static std::string read_place_body(std::ifstream& placement_file,
                                    const char* place_file,
                                    bool is_place_file);
 
+static bool is_binary_place_file(const char* place_file);
+
+static std::string read_binary_place(const char* net_file,
+                                     const char* place_file,
+                                     BlkLocRegistry& blk_loc_registry,
+                                     bool verify_file_digests,
+                                     const DeviceGrid& grid);
+
+static std::string block_names_digest();
+
 std::string read_place(const char* net_file,
                        const char* place_file,
                        BlkLocRegistry& blk_loc_registry,
                        bool verify_file_digests,
                        const DeviceGrid& grid) {
+    if (is_binary_place_file(place_file)) {
+        return read_binary_place(net_file, place_file, blk_loc_registry, verify_file_digests, grid);
+    }
+
     std::ifstream fstream(place_file);
     if (!fstream) {
         VPR_FATAL_ERROR(VPR_ERROR_PLACE_F,
@@ -197,6 +216,85 @@ static void read_place_header(std::ifstream& placement_file,
     }
 }
 
+/**
+ * @brief Returns the cluster of block_name, which is the name of either a cluster or an atom
+ *        (ClusterBlockId::INVALID() if there is no such block).
+ */
+static ClusterBlockId find_place_file_block(const std::string& block_name) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& atom_ctx = g_vpr_ctx.atom();
+
+    ClusterBlockId blk_id = cluster_ctx.clb_nlist.find_block(block_name);
+
+    //If block name is not found in cluster netlist check if it is in atom netlist
+    if (blk_id == ClusterBlockId::INVALID()) {
+        AtomBlockId atom_blk_id = atom_ctx.nlist.find_block(block_name);
+
+        if (atom_blk_id != AtomBlockId::INVALID()) {
+            blk_id = atom_ctx.lookup.atom_clb(atom_blk_id); //getting the ClusterBlockId of the cluster that the atom is in
+        }
+    }
+
+    return blk_id;
+}
+
+/**
+ * @brief Places blk_id at loc, as read from a place or constraints file (entry c_block_name).
+ *
+ * A block may be listed several times (e.g. through several of its atoms), but only at the same location.
+ */
+static void load_block_location(ClusterBlockId blk_id,
+                                const t_pl_loc& loc,
+                                const char* c_block_name,
+                                vtr::vector_map<ClusterBlockId, int>& seen_blocks,
+                                BlkLocRegistry& blk_loc_registry,
+                                bool is_place_file) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& block_locs = blk_loc_registry.mutable_block_locs();
+
+    //Check if block is listed multiple times with conflicting locations in constraints file
+    if (seen_blocks[blk_id] > 0) {
+        if (loc != block_locs[blk_id].loc) {
+            std::string cluster_name = cluster_ctx.clb_nlist.block_name(blk_id);
+            VPR_THROW(VPR_ERROR_PLACE,
+                      "The location of cluster %s (#%d) is specified %d times in the constraints file with conflicting locations. \n"
+                      "Its location was last specified with block %s. \n",
+                      cluster_name.c_str(), blk_id, seen_blocks[blk_id] + 1, c_block_name);
+        }
+    }
+
+    if (seen_blocks[blk_id] == 0) {
+        if (is_place_file && block_locs[blk_id].is_fixed) {
+            const t_pl_loc& constraint_loc = block_locs[blk_id].loc;
+            if (loc != constraint_loc) {
+                VPR_THROW(VPR_ERROR_PLACE,
+                "The new location assigned to cluster #%d is (%d,%d,%d,%d), which is inconsistent with the location specified in the constraint file (%d,%d,%d,%d).",
+                blk_id, loc.x, loc.y, loc.layer, loc.sub_tile, constraint_loc.x, constraint_loc.y, constraint_loc.layer, constraint_loc.sub_tile);
+            }
+        }
+        blk_loc_registry.set_block_location(blk_id, loc);
+    }
+
+    //need to lock down blocks if it is a constraints file
+    if (!is_place_file) {
+        block_locs[blk_id].is_fixed = true;
+    }
+
+    //mark the block as seen
+    seen_blocks[blk_id]++;
+}
+
+///@brief Checks that the location of every block was read from the place file
+static void check_all_blocks_read(const vtr::vector_map<ClusterBlockId, int>& seen_blocks) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+
+    for (ClusterBlockId block_id : cluster_ctx.clb_nlist.blocks()) {
+        if (seen_blocks[block_id] == 0) {
+            VPR_THROW(VPR_ERROR_PLACE, "Block %d has not been read from the place file. \n", block_id);
+        }
+    }
+}
+
 /**
  * This function reads either the body of a placement file or a constraints file.
  * A constraints file is in the same format as a placement file, but without the first two header lines.
@@ -210,8 +308,6 @@ static std::string read_place_body(std::ifstream& placement_file,
                                    const char* place_file,
                                    bool is_place_file) {
     auto& cluster_ctx = g_vpr_ctx.clustering();
-    auto& atom_ctx = g_vpr_ctx.atom();
-    auto& block_locs = blk_loc_registry.mutable_block_locs();
 
     std::string line;
     int lineno = 0;
@@ -268,35 +364,10 @@ static std::string read_place_body(std::ifstream& placement_file,
                 block_layer = 0;
             }
 
-            //c-style block name needed for printing block name in error messages
-            char const* c_block_name = block_name.c_str();
-
-            ClusterBlockId blk_id = cluster_ctx.clb_nlist.find_block(block_name);
-
-            //If block name is not found in cluster netlist check if it is in atom netlist
+            ClusterBlockId blk_id = find_place_file_block(block_name);
             if (blk_id == ClusterBlockId::INVALID()) {
-                AtomBlockId atom_blk_id = atom_ctx.nlist.find_block(block_name);
-
-                if (atom_blk_id == AtomBlockId::INVALID()) {
-                    VTR_LOG_WARN("Block %s has an invalid name and it is going to be skipped.\n", c_block_name);
-                    continue;
-                } else {
-                    blk_id = atom_ctx.lookup.atom_clb(atom_blk_id); //getting the ClusterBlockId of the cluster that the atom is in
-                }
-            }
-
-            //Check if block is listed multiple times with conflicting locations in constraints file
-            if (seen_blocks[blk_id] > 0) {
-                if (block_x != block_locs[blk_id].loc.x ||
-                    block_y != block_locs[blk_id].loc.y ||
-                    sub_tile_index != block_locs[blk_id].loc.sub_tile ||
-                    block_layer != block_locs[blk_id].loc.layer) {
-                    std::string cluster_name = cluster_ctx.clb_nlist.block_name(blk_id);
-                    VPR_THROW(VPR_ERROR_PLACE,
-                              "The location of cluster %s (#%d) is specified %d times in the constraints file with conflicting locations. \n"
-                              "Its location was last specified with block %s. \n",
-                              cluster_name.c_str(), blk_id, seen_blocks[blk_id] + 1, c_block_name);
-                }
+                VTR_LOG_WARN("Block %s has an invalid name and it is going to be skipped.\n", block_name.c_str());
+                continue;
             }
 
             t_pl_loc loc;
@@ -305,25 +376,7 @@ static std::string read_place_body(std::ifstream& placement_file,
             loc.sub_tile = sub_tile_index;
             loc.layer = block_layer;
 
-            if (seen_blocks[blk_id] == 0) {
-                if (is_place_file && block_locs[blk_id].is_fixed) {
-                    const t_pl_loc& constraint_loc = block_locs[blk_id].loc;
-                    if (loc != constraint_loc) {
-                        VPR_THROW(VPR_ERROR_PLACE,
-                        "The new location assigned to cluster #%d is (%d,%d,%d,%d), which is inconsistent with the location specified in the constraint file (%d,%d,%d,%d).",
-                        blk_id, loc.x, loc.y, loc.layer, loc.sub_tile, constraint_loc.x, constraint_loc.y, constraint_loc.layer, constraint_loc.sub_tile);
-                    }
-                }
-                blk_loc_registry.set_block_location(blk_id, loc);
-            }
-
-            //need to lock down blocks if it is a constraints file
-            if (!is_place_file) {
-                block_locs[blk_id].is_fixed = true;
-            }
-
-            //mark the block as seen
-            seen_blocks[blk_id]++;
+            load_block_location(blk_id, loc, block_name.c_str(), seen_blocks, blk_loc_registry, is_place_file);
 
         } else {
             //Unrecognized
@@ -336,11 +389,7 @@ static std::string read_place_body(std::ifstream& placement_file,
     //For place files, check that all blocks have been read
     //For constraints files, not all blocks need to be read
     if (is_place_file) {
-        for (ClusterBlockId block_id : cluster_ctx.clb_nlist.blocks()) {
-            if (seen_blocks[block_id] == 0) {
-                VPR_THROW(VPR_ERROR_PLACE, "Block %d has not been read from the place file. \n", block_id);
-            }
-        }
+        check_all_blocks_read(seen_blocks);
     }
 
     //Want to make a hash for place file to be used during routing for error checking
@@ -401,3 +450,253 @@ std::string print_place(const char* net_file,
     //Calculate the ID of the placement
     return vtr::secure_digest_file(place_file);
 }
+
+/*
+ * Binary placement files (written by print_place_binary())
+ *
+ * A binary placement file stores the location of each cluster in ClusterBlockId order, followed
+ * by the name of each cluster (the name to ID preimage table). If the digest of the cluster
+ * names recorded in the file matches the loaded netlist, the ID of each location is its index,
+ * and no block name needs to be looked up. Otherwise the block names are looked up (in
+ * parallel) as for text placement files. All values are in the native byte order:
+ *
+ *   char[8]  magic ("VPRPLACE")
+ *   uint32   format version
+ *   string   netlist file, netlist ID
+ *   uint32   grid width, grid height
+ *   string   digest of the cluster names
+ *   uint64   number of clusters
+ *   int32[4] per cluster: x, y, sub tile, layer
+ *   string   per cluster: name
+ *
+ * where each string is a uint32 length followed by its characters.
+ */
+static constexpr char BINARY_PLACE_MAGIC[8] = {'V', 'P', 'R', 'P', 'L', 'A', 'C', 'E'};
+static constexpr uint32_t BINARY_PLACE_VERSION = 1;
+
+namespace {
+///@brief Reads the values of a binary placement file loaded in memory, throwing if the file is truncated
+class BinaryPlaceReader {
+  public:
+    BinaryPlaceReader(const std::vector<char>& data, const char* filename)
+        : data_(data)
+        , filename_(filename) {}
+
+    template<typename T>
+    T read() {
+        T value;
+        std::memcpy(&value, skip(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    std::string read_string() {
+        uint32_t size = read<uint32_t>();
+        return std::string(skip(size), size);
+    }
+
+    ///@brief Returns a pointer to the next num_bytes bytes, and moves past them
+    const char* skip(size_t num_bytes) {
+        if (num_bytes > data_.size() - pos_) {
+            vpr_throw(VPR_ERROR_PLACE_F, filename_, 0, "Binary placement file is truncated");
+        }
+        const char* bytes = data_.data() + pos_;
+        pos_ += num_bytes;
+        return bytes;
+    }
+
+  private:
+    const std::vector<char>& data_;
+    const char* filename_;
+    size_t pos_ = 0;
+};
+
+template<typename T>
+void write_binary(std::ofstream& os, const T& value) {
+    os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void write_binary_string(std::ofstream& os, const std::string& str) {
+    write_binary(os, uint32_t(str.size()));
+    os.write(str.data(), str.size());
+}
+} // namespace
+
+///@brief Returns true if place_file starts with the magic of binary placement files
+static bool is_binary_place_file(const char* place_file) {
+    std::ifstream is(place_file, std::ios::binary);
+    char magic[sizeof(BINARY_PLACE_MAGIC)];
+    return is.read(magic, sizeof(magic)) && std::memcmp(magic, BINARY_PLACE_MAGIC, sizeof(magic)) == 0;
+}
+
+///@brief Digest of the names of the clusters, in ClusterBlockId order
+static std::string block_names_digest() {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+
+    std::stringstream names;
+    for (ClusterBlockId blk_id : cluster_ctx.clb_nlist.blocks()) {
+        names << cluster_ctx.clb_nlist.block_name(blk_id) << '\n';
+    }
+    return vtr::secure_digest_stream(names);
+}
+
+static std::string read_binary_place(const char* net_file,
+                                     const char* place_file,
+                                     BlkLocRegistry& blk_loc_registry,
+                                     bool verify_file_digests,
+                                     const DeviceGrid& grid) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+
+    VTR_LOG("Reading binary placement file %s.\n", place_file);
+    VTR_LOG("\n");
+
+    std::ifstream is(place_file, std::ios::binary | std::ios::ate);
+    if (!is) {
+        VPR_FATAL_ERROR(VPR_ERROR_PLACE_F,
+                        "'%s' - Cannot open place file.\n",
+                        place_file);
+    }
+    std::vector<char> data(is.tellg());
+    is.seekg(0);
+    is.read(data.data(), data.size());
+    is.close();
+
+    BinaryPlaceReader reader(data, place_file);
+    reader.skip(sizeof(BINARY_PLACE_MAGIC));
+    if (reader.read<uint32_t>() != BINARY_PLACE_VERSION) {
+        vpr_throw(VPR_ERROR_PLACE_F, place_file, 0, "Unsupported binary placement file version");
+    }
+
+    //Check that the netlist and device used to generate this placement match the ones loaded
+    std::string place_netlist_file = reader.read_string();
+    std::string place_netlist_id = reader.read_string();
+    if (place_netlist_id != cluster_ctx.clb_nlist.netlist_id()) {
+        auto msg = vtr::string_fmt(
+            "The packed netlist file that generated placement (File: '%s' ID: '%s')"
+            " does not match current netlist (File: '%s' ID: '%s')",
+            place_netlist_file.c_str(), place_netlist_id.c_str(),
+            net_file, cluster_ctx.clb_nlist.netlist_id().c_str());
+        if (verify_file_digests) {
+            msg += " To ignore the packed netlist mismatch, use '--verify_file_digests off' command line option.";
+            vpr_throw(VPR_ERROR_PLACE_F, place_file, 0, msg.c_str());
+        } else {
+            VTR_LOG_WARN("%s\n", msg.c_str());
+            VTR_LOG_WARN("The packed netlist mismatch is ignored because"
+                         "--verify_file_digests command line option is off.");
+        }
+    }
+
+    size_t place_file_width = reader.read<uint32_t>();
+    size_t place_file_height = reader.read<uint32_t>();
+    if (grid.width() != place_file_width || grid.height() != place_file_height) {
+        auto msg = vtr::string_fmt(
+            "Current FPGA size (%d x %d) is different from size when placement generated (%d x %d)",
+            grid.width(), grid.height(), place_file_width, place_file_height);
+        if (verify_file_digests) {
+            msg += " To ignore this size mismatch, use '--verify_file_digests off' command line option.";
+            vpr_throw(VPR_ERROR_PLACE_F, place_file, 0, msg.c_str());
+        } else {
+            VTR_LOG_WARN("%s\n", msg.c_str());
+            VTR_LOG_WARN("The FPGA size mismatch is ignored because"
+                         "--verify_file_digests command line option is off.");
+        }
+    }
+
+    std::string place_names_digest = reader.read_string();
+    size_t num_blocks = reader.read<uint64_t>();
+    const char* locs = reader.skip(num_blocks * 4 * sizeof(int32_t));
+    std::vector<std::string> block_names(num_blocks);
+    for (std::string& block_name : block_names) {
+        block_name = reader.read_string();
+    }
+
+    //Map each location of the file to its cluster: directly if the clusters are the same (and
+    //in the same order) as when the placement was written, through their names otherwise
+    std::vector<ClusterBlockId> file_blocks(num_blocks);
+    if (num_blocks == cluster_ctx.clb_nlist.blocks().size() && place_names_digest == block_names_digest()) {
+        for (size_t iblk = 0; iblk < num_blocks; iblk++) {
+            file_blocks[iblk] = ClusterBlockId(iblk);
+        }
+    } else {
+        auto find_file_block = [&](size_t iblk) {
+            file_blocks[iblk] = find_place_file_block(block_names[iblk]);
+        };
+#ifdef VPR_USE_TBB
+        tbb::parallel_for(size_t(0), num_blocks, find_file_block);
+#else
+        for (size_t iblk = 0; iblk < num_blocks; iblk++) {
+            find_file_block(iblk);
+        }
+#endif
+    }
+
+    //used to count how many times a block has been seen in the place file so duplicate blocks can be detected
+    vtr::vector_map<ClusterBlockId, int> seen_blocks;
+    for (ClusterBlockId block_id : cluster_ctx.clb_nlist.blocks()) {
+        seen_blocks.insert(block_id, 0);
+    }
+
+    for (size_t iblk = 0; iblk < num_blocks; iblk++) {
+        if (file_blocks[iblk] == ClusterBlockId::INVALID()) {
+            VTR_LOG_WARN("Block %s has an invalid name and it is going to be skipped.\n", block_names[iblk].c_str());
+            continue;
+        }
+
+        int32_t loc_values[4];
+        std::memcpy(loc_values, locs + iblk * sizeof(loc_values), sizeof(loc_values));
+        t_pl_loc loc(loc_values[0], loc_values[1], loc_values[2], loc_values[3]);
+
+        load_block_location(file_blocks[iblk], loc, block_names[iblk].c_str(), seen_blocks, blk_loc_registry, true);
+    }
+
+    check_all_blocks_read(seen_blocks);
+
+    VTR_LOG("Successfully read %s.\n", place_file);
+    VTR_LOG("\n");
+
+    //Want to make a hash for place file to be used during routing for error checking
+    return vtr::secure_digest_file(place_file);
+}
+
+std::string print_place_binary(const char* net_file,
+                               const char* net_id,
+                               const char* place_file,
+                               const vtr::vector_map<ClusterBlockId, t_block_loc>& block_locs) {
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+
+    std::ofstream os(place_file, std::ios::binary);
+    if (!os) {
+        VPR_FATAL_ERROR(VPR_ERROR_PLACE_F,
+                        "'%s' - Cannot open place file for writing.\n",
+                        place_file);
+    }
+
+    os.write(BINARY_PLACE_MAGIC, sizeof(BINARY_PLACE_MAGIC));
+    write_binary(os, BINARY_PLACE_VERSION);
+    write_binary_string(os, net_file);
+    write_binary_string(os, net_id);
+    write_binary(os, uint32_t(device_ctx.grid.width()));
+    write_binary(os, uint32_t(device_ctx.grid.height()));
+    write_binary_string(os, block_names_digest());
+
+    size_t num_blocks = block_locs.empty() ? 0 : cluster_ctx.clb_nlist.blocks().size(); //Only if placement exists
+    write_binary(os, uint64_t(num_blocks));
+    for (size_t iblk = 0; iblk < num_blocks; iblk++) {
+        const t_pl_loc& loc = block_locs[ClusterBlockId(iblk)].loc;
+        int32_t loc_values[4] = {loc.x, loc.y, loc.sub_tile, loc.layer};
+        os.write(reinterpret_cast<const char*>(loc_values), sizeof(loc_values));
+    }
+    for (size_t iblk = 0; iblk < num_blocks; iblk++) {
+        write_binary_string(os, cluster_ctx.clb_nlist.block_name(ClusterBlockId(iblk)));
+    }
+
+    if (!os) {
+        VPR_FATAL_ERROR(VPR_ERROR_PLACE_F,
+                        "'%s' - Failed to write place file.\n",
+                        place_file);
+    }
+    os.close();
+
+    //Calculate the ID of the placement
+    return vtr::secure_digest_file(place_file);
+}
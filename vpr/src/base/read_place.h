@@ -43,4 +43,16 @@ std::string print_place(const char* net_file,
                         const vtr::vector_map<ClusterBlockId, t_block_loc>& block_locs,
                         bool is_place_file = true);
 
+/**
+ * This function prints out a placement in the binary placement file format, which read_place()
+ * recognizes from the magic bytes at its start. The file stores the locations in ClusterBlockId
+ * order, with a table of the block names and a digest of them, so that loading it into the same
+ * netlist needs no block name lookups.
+ * @return The digest of the written file.
+ */
+std::string print_place_binary(const char* net_file,
+                               const char* net_id,
+                               const char* place_file,
+                               const vtr::vector_map<ClusterBlockId, t_block_loc>& block_locs);
+
 #endif
@@ -50,7 +50,16 @@
 
 #include "old_traceback.h"
 
+#ifdef VPR_USE_TBB
+#    include <tbb/parallel_for_each.h>
+#endif
+
 /*************Functions local to this module*************/
+static void read_text_route(const Netlist<>& router_net_list, const char* route_file, const t_router_opts& router_opts, bool verify_file_digests, bool is_flat);
+static void read_binary_route(const Netlist<>& router_net_list, const char* route_file, const t_router_opts& router_opts, bool verify_file_digests, bool is_flat);
+static void print_binary_route(const Netlist<>& net_list, const char* route_file, bool is_flat);
+static uint64_t rr_graph_digest();
+static uint64_t netlist_digest(const Netlist<>& net_list);
 static void process_route(const Netlist<>& net_list, std::ifstream& fp, const char* filename, int& lineno, bool is_flat);
 static void process_nodes(const Netlist<>& net_list, std::ifstream& fp, ClusterNetId inet, const char* filename, int& lineno);
 static void process_nets(const Netlist<>& net_list, std::ifstream& fp, ClusterNetId inet, std::string name, std::vector<std::string> input_tokens, const char* filename, int& lineno, bool is_flat);
@@ -71,11 +80,51 @@ void print_route(const Netlist<>& net_list, FILE* fp, bool is_flat);
  */
 bool read_route(const char* route_file, const t_router_opts& router_opts, bool verify_file_digests, bool is_flat) {
     auto& device_ctx = g_vpr_ctx.mutable_device();
-    auto& place_ctx = g_vpr_ctx.placement();
     bool flat_router = router_opts.flat_routing;
+    const Netlist<>& router_net_list = (flat_router) ? (const Netlist<>&)g_vpr_ctx.atom().nlist : (const Netlist<>&)g_vpr_ctx.clustering().clb_nlist;
+
     /* Begin parsing the file */
     VTR_LOG("Begin loading FPGA routing file.\n");
 
+    if (vtr::check_file_name_extension(route_file, ".bin")) {
+        read_binary_route(router_net_list, route_file, router_opts, verify_file_digests, is_flat);
+    } else {
+        read_text_route(router_net_list, route_file, router_opts, verify_file_digests, is_flat);
+    }
+
+    /*Correctly set up the clb opins*/
+    FourAryHeap small_heap;
+    small_heap.init_heap(device_ctx.grid);
+    if (!flat_router) {
+        reserve_locally_used_opins(&small_heap, router_opts.initial_pres_fac,
+                                   router_opts.acc_fac, false, flat_router);
+    }
+    recompute_occupancy_from_scratch(router_net_list,
+                                     flat_router);
+
+    /* Note: This pres_fac is not necessarily correct since it isn't the first routing iteration*/
+    OveruseInfo overuse_info(device_ctx.rr_graph.num_nodes());
+    pathfinder_update_acc_cost_and_overuse_info(router_opts.acc_fac, overuse_info);
+    if (!flat_router) {
+        reserve_locally_used_opins(&small_heap, router_opts.initial_pres_fac,
+                                   router_opts.acc_fac, true, flat_router);
+    }
+
+    /* Finished loading in the routing, now check it*/
+    recompute_occupancy_from_scratch(router_net_list,
+                                     flat_router);
+    bool is_feasible = feasible_routing();
+
+    VTR_LOG("Finished loading route file\n");
+
+    return is_feasible;
+}
+
+///@brief Reads a text .route file (as written by print_route())
+static void read_text_route(const Netlist<>& router_net_list, const char* route_file, const t_router_opts& router_opts, bool verify_file_digests, bool is_flat) {
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& place_ctx = g_vpr_ctx.placement();
+
     std::string header_str;
 
     std::ifstream fp;
@@ -106,11 +155,10 @@ bool read_route(const char* route_file, const t_router_opts& router_opts, bool v
 
     /*Allocate necessary routing structures*/
     alloc_and_load_rr_node_route_structs();
-    const Netlist<>& router_net_list = (flat_router) ? (const Netlist<>&)g_vpr_ctx.atom().nlist : (const Netlist<>&)g_vpr_ctx.clustering().clb_nlist;
     init_route_structs(router_net_list,
                        router_opts.bb_factor,
                        router_opts.has_choking_spot,
-                       flat_router);
+                       router_opts.flat_routing);
 
     /*Check dimensions*/
     std::getline(fp, header_str);
@@ -127,33 +175,6 @@ bool read_route(const char* route_file, const t_router_opts& router_opts, bool v
     process_route(router_net_list, fp, route_file, lineno, is_flat);
 
     fp.close();
-
-    /*Correctly set up the clb opins*/
-    FourAryHeap small_heap;
-    small_heap.init_heap(device_ctx.grid);
-    if (!flat_router) {
-        reserve_locally_used_opins(&small_heap, router_opts.initial_pres_fac,
-                                   router_opts.acc_fac, false, flat_router);
-    }
-    recompute_occupancy_from_scratch(router_net_list,
-                                     flat_router);
-
-    /* Note: This pres_fac is not necessarily correct since it isn't the first routing iteration*/
-    OveruseInfo overuse_info(device_ctx.rr_graph.num_nodes());
-    pathfinder_update_acc_cost_and_overuse_info(router_opts.acc_fac, overuse_info);
-    if (!flat_router) {
-        reserve_locally_used_opins(&small_heap, router_opts.initial_pres_fac,
-                                   router_opts.acc_fac, true, flat_router);
-    }
-
-    /* Finished loading in the routing, now check it*/
-    recompute_occupancy_from_scratch(router_net_list,
-                                     flat_router);
-    bool is_feasible = feasible_routing();
-
-    VTR_LOG("Finished loading route file\n");
-
-    return is_feasible;
 }
 
 ///@brief Walks through every net and add the routing appropriately
@@ -701,13 +722,22 @@ void print_route(const Netlist<>& net_list,
                  const char* placement_file,
                  const char* route_file,
                  bool is_flat) {
+    auto& route_ctx = g_vpr_ctx.mutable_routing();
+
+    if (vtr::check_file_name_extension(route_file, ".bin")) {
+        print_binary_route(net_list, route_file, is_flat);
+
+        //Save the digest of the route file
+        route_ctx.routing_id = vtr::secure_digest_file(route_file);
+        return;
+    }
+
     FILE* fp;
 
     fp = fopen(route_file, "w");
 
     auto& place_ctx = g_vpr_ctx.placement();
     auto& device_ctx = g_vpr_ctx.device();
-    auto& route_ctx = g_vpr_ctx.mutable_routing();
 
     fprintf(fp, "Placement_File: %s Placement_ID: %s\n", placement_file, place_ctx.placement_id.c_str());
 
@@ -721,3 +751,322 @@ void print_route(const Netlist<>& net_list,
     //Save the digest of the route file
     route_ctx.routing_id = vtr::secure_digest_file(route_file);
 }
+
+/*
+ * Binary .route files (route files whose name ends with .bin)
+ *
+ * The binary format stores the traceback of each net as raw RRNodeId/switch/net pin index
+ * records, so that loading it needs no parsing nor look-up of the nodes by coordinates. It is
+ * only meant to be read back with the same netlist, placement and RR graph (which is checked
+ * through their digests). All values are in the native byte order:
+ *
+ *   char[8]  magic ("VPRROUTE")
+ *   uint32   format version
+ *   uint32   length of the placement ID, followed by the placement ID
+ *   uint32   grid width, grid height
+ *   uint8    is_flat
+ *   uint64   number of RR nodes, RR graph digest
+ *   uint64   number of nets, netlist digest
+ *   for each net (in order):
+ *     uint8    flags (BINARY_ROUTE_NET_GLOBAL, BINARY_ROUTE_NET_ROUTED)
+ *     uint32   number of traceback elements
+ *     int32[3] per traceback element: RR node, net pin index, switch
+ */
+static constexpr char BINARY_ROUTE_MAGIC[8] = {'V', 'P', 'R', 'R', 'O', 'U', 'T', 'E'};
+static constexpr uint32_t BINARY_ROUTE_VERSION = 1;
+static constexpr uint8_t BINARY_ROUTE_NET_GLOBAL = 0x1;
+static constexpr uint8_t BINARY_ROUTE_NET_ROUTED = 0x2;
+
+namespace {
+///@brief A traceback element of a binary .route file
+struct t_binary_trace {
+    int32_t index;
+    int32_t net_pin_index;
+    int32_t iswitch;
+};
+static_assert(sizeof(t_binary_trace) == 3 * sizeof(int32_t), "Binary traceback elements should not be padded");
+
+///@brief Reads the values of a binary .route file loaded in memory, throwing if the file is truncated
+class BinaryRouteReader {
+  public:
+    BinaryRouteReader(const std::vector<char>& data, const char* filename)
+        : data_(data)
+        , filename_(filename) {}
+
+    template<typename T>
+    T read() {
+        T value;
+        std::memcpy(&value, skip(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    ///@brief Returns a pointer to the next num_bytes bytes, and moves past them
+    const char* skip(size_t num_bytes) {
+        if (num_bytes > data_.size() - pos_) {
+            vpr_throw(VPR_ERROR_ROUTE, filename_, 0, "Binary routing file is truncated");
+        }
+        const char* bytes = data_.data() + pos_;
+        pos_ += num_bytes;
+        return bytes;
+    }
+
+    bool at_end() const { return pos_ == data_.size(); }
+
+  private:
+    const std::vector<char>& data_;
+    const char* filename_;
+    size_t pos_ = 0;
+};
+
+template<typename T>
+void write_binary(std::ofstream& os, const T& value) {
+    os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+} // namespace
+
+///@brief FNV-1a hash of the values
+static void digest_combine(uint64_t& digest, uint64_t value) {
+    for (int ibyte = 0; ibyte < 8; ibyte++) {
+        digest ^= (value >> (8 * ibyte)) & 0xff;
+        digest *= 0x100000001b3ull;
+    }
+}
+
+///@brief Digest of the RR graph nodes (type, location, ptc and number of edges)
+static uint64_t rr_graph_digest() {
+    const auto& rr_graph = g_vpr_ctx.device().rr_graph;
+
+    uint64_t digest = 0xcbf29ce484222325ull;
+    digest_combine(digest, rr_graph.num_nodes());
+    digest_combine(digest, rr_graph.num_rr_switches());
+    for (RRNodeId inode : rr_graph.nodes()) {
+        digest_combine(digest, rr_graph.node_type(inode));
+        digest_combine(digest, rr_graph.node_layer(inode));
+        digest_combine(digest, rr_graph.node_xlow(inode));
+        digest_combine(digest, rr_graph.node_ylow(inode));
+        digest_combine(digest, rr_graph.node_xhigh(inode));
+        digest_combine(digest, rr_graph.node_yhigh(inode));
+        digest_combine(digest, rr_graph.node_ptc_num(inode));
+        digest_combine(digest, rr_graph.num_edges(inode));
+    }
+    return digest;
+}
+
+///@brief Digest of the net names and number of pins
+static uint64_t netlist_digest(const Netlist<>& net_list) {
+    uint64_t digest = 0xcbf29ce484222325ull;
+    for (auto net_id : net_list.nets()) {
+        digest_combine(digest, std::hash<std::string>()(net_list.net_name(net_id)));
+        digest_combine(digest, net_list.net_pins(net_id).size());
+    }
+    return digest;
+}
+
+static void print_binary_route(const Netlist<>& net_list, const char* route_file, bool is_flat) {
+    const auto& device_ctx = g_vpr_ctx.device();
+    const auto& place_ctx = g_vpr_ctx.placement();
+    const auto& route_ctx = g_vpr_ctx.routing();
+
+    std::ofstream os(route_file, std::ios::binary);
+    if (!os) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Failed to open binary routing file '%s' for writing\n", route_file);
+    }
+
+    os.write(BINARY_ROUTE_MAGIC, sizeof(BINARY_ROUTE_MAGIC));
+    write_binary(os, BINARY_ROUTE_VERSION);
+    write_binary(os, uint32_t(place_ctx.placement_id.size()));
+    os.write(place_ctx.placement_id.data(), place_ctx.placement_id.size());
+    write_binary(os, uint32_t(device_ctx.grid.width()));
+    write_binary(os, uint32_t(device_ctx.grid.height()));
+    write_binary(os, uint8_t(is_flat));
+    write_binary(os, uint64_t(device_ctx.rr_graph.num_nodes()));
+    write_binary(os, rr_graph_digest());
+    write_binary(os, uint64_t(net_list.nets().size()));
+    write_binary(os, netlist_digest(net_list));
+
+    std::vector<t_binary_trace> binary_trace;
+    for (auto net_id : net_list.nets()) {
+        uint8_t flags = 0;
+        if (net_list.net_is_ignored(net_id)) {
+            flags |= BINARY_ROUTE_NET_GLOBAL;
+        }
+
+        binary_trace.clear();
+        if (!route_ctx.route_trees.empty() && route_ctx.route_trees[net_id]) {
+            flags |= BINARY_ROUTE_NET_ROUTED;
+
+            t_trace* head = TracebackCompat::traceback_from_route_tree(route_ctx.route_trees[net_id].value());
+            for (t_trace* tptr = head; tptr != nullptr; tptr = tptr->next) {
+                binary_trace.push_back({tptr->index, tptr->net_pin_index, tptr->iswitch});
+            }
+            free_traceback(head);
+        }
+
+        write_binary(os, flags);
+        write_binary(os, uint32_t(binary_trace.size()));
+        os.write(reinterpret_cast<const char*>(binary_trace.data()), binary_trace.size() * sizeof(t_binary_trace));
+    }
+
+    if (!os) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Failed to write binary routing file '%s'\n", route_file);
+    }
+}
+
+static void read_binary_route(const Netlist<>& router_net_list, const char* route_file, const t_router_opts& router_opts, bool verify_file_digests, bool is_flat) {
+    const auto& device_ctx = g_vpr_ctx.device();
+    const auto& rr_graph = device_ctx.rr_graph;
+    const auto& place_ctx = g_vpr_ctx.placement();
+    auto& route_ctx = g_vpr_ctx.mutable_routing();
+
+    std::ifstream is(route_file, std::ios::binary | std::ios::ate);
+    if (!is) {
+        vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
+                  "Cannot open %s routing file", route_file);
+    }
+    std::vector<char> data(is.tellg());
+    is.seekg(0);
+    is.read(data.data(), data.size());
+    is.close();
+
+    BinaryRouteReader reader(data, route_file);
+
+    /* Check that the file matches the netlist, placement and RR graph */
+    if (std::memcmp(reader.skip(sizeof(BINARY_ROUTE_MAGIC)), BINARY_ROUTE_MAGIC, sizeof(BINARY_ROUTE_MAGIC)) != 0
+        || reader.read<uint32_t>() != BINARY_ROUTE_VERSION) {
+        vpr_throw(VPR_ERROR_ROUTE, route_file, 0, "Not a binary routing file (or of an unsupported version)");
+    }
+
+    uint32_t placement_id_size = reader.read<uint32_t>();
+    std::string placement_id(reader.skip(placement_id_size), placement_id_size);
+    if (placement_id != place_ctx.placement_id) {
+        auto msg = vtr::string_fmt(
+            "The placement of the routing file does not match the loaded placement (ID %s != %s)",
+            placement_id.c_str(), place_ctx.placement_id.c_str());
+        if (verify_file_digests) {
+            vpr_throw(VPR_ERROR_ROUTE, route_file, 0, msg.c_str());
+        } else {
+            VTR_LOG_WARN("%s\n", msg.c_str());
+        }
+    }
+
+    uint32_t width = reader.read<uint32_t>();
+    uint32_t height = reader.read<uint32_t>();
+    if (width != device_ctx.grid.width() || height != device_ctx.grid.height()) {
+        vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
+                  "Device dimensions %ux%u specified in the routing file does not match given %zux%zu",
+                  width, height, device_ctx.grid.width(), device_ctx.grid.height());
+    }
+
+    if (reader.read<uint8_t>() != is_flat) {
+        vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
+                  "The routing file was%s created with flat routing; re-run vpr %s the --flat_routing option",
+                  is_flat ? " not" : "", is_flat ? "without" : "with");
+    }
+
+    uint64_t num_rr_nodes = reader.read<uint64_t>();
+    uint64_t file_rr_graph_digest = reader.read<uint64_t>();
+    if (num_rr_nodes != rr_graph.num_nodes() || file_rr_graph_digest != rr_graph_digest()) {
+        vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
+                  "The RR graph of the routing file (%lu nodes) does not match the RR graph (%zu nodes)",
+                  num_rr_nodes, rr_graph.num_nodes());
+    }
+
+    uint64_t num_nets = reader.read<uint64_t>();
+    uint64_t file_netlist_digest = reader.read<uint64_t>();
+    if (num_nets != router_net_list.nets().size() || file_netlist_digest != netlist_digest(router_net_list)) {
+        vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
+                  "The nets of the routing file (%lu nets) do not match the netlist (%zu nets)",
+                  num_nets, router_net_list.nets().size());
+    }
+
+    /*Allocate necessary routing structures*/
+    alloc_and_load_rr_node_route_structs();
+    init_route_structs(router_net_list,
+                       router_opts.bb_factor,
+                       router_opts.has_choking_spot,
+                       router_opts.flat_routing);
+
+    /* Find the traceback of each net */
+    std::vector<std::pair<const char*, uint32_t>> net_traces(num_nets, {nullptr, 0});
+    for (auto net_id : router_net_list.nets()) {
+        uint8_t flags = reader.read<uint8_t>();
+        uint32_t num_elems = reader.read<uint32_t>();
+        net_traces[size_t(net_id)] = {reader.skip(num_elems * sizeof(t_binary_trace)), num_elems};
+
+        bool is_global = flags & BINARY_ROUTE_NET_GLOBAL;
+        if (is_global && !router_net_list.net_is_ignored(net_id)) {
+            vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
+                      "Net %lu should be a global net", size_t(net_id));
+        } else if (!is_global && router_net_list.net_is_ignored(net_id)) {
+            VTR_LOG_WARN("Net %lu (%s) is marked as global in the netlist, but is non-global in the .route file\n", size_t(net_id), router_net_list.net_name(net_id).c_str());
+        }
+
+        if (!(flags & BINARY_ROUTE_NET_ROUTED)) {
+            net_traces[size_t(net_id)].first = nullptr;
+        }
+    }
+    if (!reader.at_end()) {
+        vpr_throw(VPR_ERROR_ROUTE, route_file, 0, "Unexpected data at the end of the binary routing file");
+    }
+
+    /* Build the route tree of each net; the nets are independent, so they are loaded in parallel */
+    auto load_net = [&](ParentNetId net_id) {
+        auto [elems, num_elems] = net_traces[size_t(net_id)];
+        if (elems == nullptr || num_elems == 0) {
+            return;
+        }
+
+        std::vector<t_trace> trace(num_elems);
+        RRNodeId prev_node(-1);
+        for (size_t ielem = 0; ielem < num_elems; ielem++) {
+            t_binary_trace elem;
+            std::memcpy(&elem, elems + ielem * sizeof(t_binary_trace), sizeof(elem));
+
+            if (elem.index < 0 || size_t(elem.index) >= rr_graph.num_nodes()) {
+                vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
+                          "Node %d of net %lu is out of the RR graph", elem.index, size_t(net_id));
+            }
+            RRNodeId rr_node(elem.index);
+
+            /*First node needs to be source. It is isolated to correctly set heap head.*/
+            if (ielem == 0 && rr_graph.node_type(rr_node) != SOURCE) {
+                vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
+                          "First node in routing of net %lu has to be a source type", size_t(net_id));
+            }
+
+            /* Check for connectivity, this throws an exception when a dangling net is encountered in the routing file */
+            if (!check_rr_graph_connectivity(prev_node, rr_node)) {
+                vpr_throw(VPR_ERROR_ROUTE, route_file, 0, "Dangling branch at net %lu, nodes %d -> %d", size_t(net_id), prev_node, rr_node);
+            }
+            prev_node = rr_node;
+
+            if (elem.net_pin_index < OPEN || elem.net_pin_index >= int(router_net_list.net_pins(net_id).size())
+                || (rr_graph.node_type(rr_node) != SINK && elem.net_pin_index != OPEN)) {
+                vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
+                          "Node %d of net %lu has an invalid net pin index %d", elem.index, size_t(net_id), elem.net_pin_index);
+            }
+
+            if (elem.iswitch != OPEN && (elem.iswitch < 0 || size_t(elem.iswitch) >= rr_graph.num_rr_switches())) {
+                vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
+                          "Node %d of net %lu has an invalid switch %d", elem.index, size_t(net_id), elem.iswitch);
+            }
+
+            trace[ielem].index = elem.index;
+            trace[ielem].net_pin_index = elem.net_pin_index;
+            trace[ielem].iswitch = elem.iswitch;
+            trace[ielem].next = (ielem + 1 < num_elems) ? &trace[ielem + 1] : nullptr;
+        }
+
+        /* Convert to route_tree after reading */
+        VTR_ASSERT(validate_traceback(trace.data()));
+        route_ctx.route_trees[net_id] = TracebackCompat::traceback_to_route_tree(trace.data());
+    };
+
+#ifdef VPR_USE_TBB
+    tbb::parallel_for_each(router_net_list.nets().begin(), router_net_list.nets().end(), load_net);
+#else
+    for (auto net_id : router_net_list.nets()) {
+        load_net(net_id);
+    }
+#endif
+}
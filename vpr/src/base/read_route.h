@@ -3,6 +3,10 @@
  * @brief Functions to read/write a .route file, which contains a serialized routing state.
  *
  * This is used to perform --analysis only
+ *
+ * Route files whose name ends with .bin are in a compact binary format (see read_route.cpp),
+ * which loads much faster than the text format, but is only valid for the RR graph, netlist
+ * and placement it was written with.
  */
 
 #ifndef READ_ROUTE_H
@@ -25,8 +25,34 @@
 #include "timing_util.h"
 #include "tatum/TimingReporter.hpp"
 
+#ifdef VPR_USE_TBB
+#    include <tbb/combinable.h>
+#    include <tbb/enumerable_thread_specific.h>
+#    include <tbb/parallel_for_each.h>
+#endif
+
 /********************** Subroutines local to this module *********************/
 
+///@brief Bends, wirelength and segment totals and maxima over the routed nets
+struct t_length_and_bends {
+    int max_bends = 0;
+    int total_bends = 0;
+    int max_length = 0;
+    int total_length = 0;
+    int max_segments = 0;
+    int total_segments = 0;
+    int num_global_nets = 0;
+    int num_clb_opins_reserved = 0;
+    int num_absorbed_nets = 0;
+
+    void add_net(const Netlist<>& net_list, ParentNetId net_id, bool is_flat);
+    void combine(const t_length_and_bends& rhs);
+};
+
+static void add_net_channel_occupancy(ParentNetId net_id,
+                                      vtr::Matrix<int>& chanx_occ,
+                                      vtr::Matrix<int>& chany_occ);
+
 static void load_channel_occupancies(const Netlist<>& net_list,
                                      vtr::Matrix<int>& chanx_occ,
                                      vtr::Matrix<int>& chany_occ);
@@ -118,41 +144,34 @@ void routing_stats(const Netlist<>& net_list,
  *        and net length in the routing.
  */
 void length_and_bends_stats(const Netlist<>& net_list, bool is_flat) {
-    int max_bends = 0;
-    int total_bends = 0;
-    int max_length = 0;
-    int total_length = 0;
-    int max_segments = 0;
-    int total_segments = 0;
-    int num_global_nets = 0;
-    int num_clb_opins_reserved = 0;
-    int num_absorbed_nets = 0;
-
+    /* The nets are independent: each thread accumulates the stats of its nets, *
+     * and the per-thread stats are combined at the end.                        */
+#ifdef VPR_USE_TBB
+    tbb::combinable<t_length_and_bends> thread_stats;
+    tbb::parallel_for_each(net_list.nets().begin(), net_list.nets().end(), [&](ParentNetId net_id) {
+        thread_stats.local().add_net(net_list, net_id, is_flat);
+    });
+
+    t_length_and_bends stats;
+    thread_stats.combine_each([&](const t_length_and_bends& local_stats) {
+        stats.combine(local_stats);
+    });
+#else
+    t_length_and_bends stats;
     for (auto net_id : net_list.nets()) {
-        if (!net_list.net_is_ignored(net_id) && net_list.net_sinks(net_id).size() != 0) { /* Globals don't count. */
-            int bends, length, segments;
-            bool is_absorbed;
-            get_num_bends_and_length(net_id, &bends, &length, &segments, &is_absorbed);
-
-            total_bends += bends;
-            max_bends = std::max(bends, max_bends);
-
-            total_length += length;
-            max_length = std::max(length, max_length);
-
-            total_segments += segments;
-            max_segments = std::max(segments, max_segments);
-
-            if (is_absorbed) {
-                num_absorbed_nets++;
-            }
-        } else if (net_list.net_is_ignored(net_id)) {
-            num_global_nets++;
-        } else if (!is_flat) {
-            /* If flat_routing is enabled, we don't need to count the number of reserved opins*/
-            num_clb_opins_reserved++;
-        }
+        stats.add_net(net_list, net_id, is_flat);
     }
+#endif
+
+    int max_bends = stats.max_bends;
+    int total_bends = stats.total_bends;
+    int max_length = stats.max_length;
+    int total_length = stats.total_length;
+    int max_segments = stats.max_segments;
+    int total_segments = stats.total_segments;
+    int num_global_nets = stats.num_global_nets;
+    int num_clb_opins_reserved = stats.num_clb_opins_reserved;
+    int num_absorbed_nets = stats.num_absorbed_nets;
 
     float av_bends = (float)total_bends / (float)((int)net_list.nets().size() - num_global_nets);
     VTR_LOG("\n");
@@ -176,6 +195,45 @@ void length_and_bends_stats(const Netlist<>& net_list, bool is_flat) {
     VTR_LOG("Total number of nets absorbed: %d\n", num_absorbed_nets);
 }
 
+///@brief Adds the bends, length and segments of net_id's routing to the stats
+void t_length_and_bends::add_net(const Netlist<>& net_list, ParentNetId net_id, bool is_flat) {
+    if (!net_list.net_is_ignored(net_id) && net_list.net_sinks(net_id).size() != 0) { /* Globals don't count. */
+        int bends, length, segments;
+        bool is_absorbed;
+        get_num_bends_and_length(net_id, &bends, &length, &segments, &is_absorbed);
+
+        total_bends += bends;
+        max_bends = std::max(bends, max_bends);
+
+        total_length += length;
+        max_length = std::max(length, max_length);
+
+        total_segments += segments;
+        max_segments = std::max(segments, max_segments);
+
+        if (is_absorbed) {
+            num_absorbed_nets++;
+        }
+    } else if (net_list.net_is_ignored(net_id)) {
+        num_global_nets++;
+    } else if (!is_flat) {
+        /* If flat_routing is enabled, we don't need to count the number of reserved opins*/
+        num_clb_opins_reserved++;
+    }
+}
+
+void t_length_and_bends::combine(const t_length_and_bends& rhs) {
+    max_bends = std::max(max_bends, rhs.max_bends);
+    total_bends += rhs.total_bends;
+    max_length = std::max(max_length, rhs.max_length);
+    total_length += rhs.total_length;
+    max_segments = std::max(max_segments, rhs.max_segments);
+    total_segments += rhs.total_segments;
+    num_global_nets += rhs.num_global_nets;
+    num_clb_opins_reserved += rhs.num_clb_opins_reserved;
+    num_absorbed_nets += rhs.num_absorbed_nets;
+}
+
 ///@brief Determines how many tracks are used in each channel.
 static void get_channel_occupancy_stats(const Netlist<>& net_list, bool /***/) {
     auto& device_ctx = g_vpr_ctx.device();
@@ -240,37 +298,70 @@ static void get_channel_occupancy_stats(const Netlist<>& net_list, bool /***/) {
 static void load_channel_occupancies(const Netlist<>& net_list,
                                      vtr::Matrix<int>& chanx_occ,
                                      vtr::Matrix<int>& chany_occ) {
-    auto& device_ctx = g_vpr_ctx.device();
-    const auto& rr_graph = device_ctx.rr_graph;
-    auto& route_ctx = g_vpr_ctx.routing();
-
     /* First set the occupancy of everything to zero. */
     chanx_occ.fill(0);
     chany_occ.fill(0);
 
-    /* Now go through each net and count the tracks and pins used everywhere */
+    /* Now go through each net and count the tracks and pins used everywhere. *
+     * In parallel, each thread counts its nets in its own matrices, which     *
+     * are summed at the end.                                                  */
+#ifdef VPR_USE_TBB
+    tbb::enumerable_thread_specific<std::pair<vtr::Matrix<int>, vtr::Matrix<int>>> thread_occ(std::make_pair(chanx_occ, chany_occ));
+    tbb::parallel_for_each(net_list.nets().begin(), net_list.nets().end(), [&](ParentNetId net_id) {
+        /* Skip global and empty nets. */
+        if (net_list.net_is_ignored(net_id) && net_list.net_sinks(net_id).size() != 0)
+            return;
+
+        auto& local_occ = thread_occ.local();
+        add_net_channel_occupancy(net_id, local_occ.first, local_occ.second);
+    });
+
+    for (const auto& local_occ : thread_occ) {
+        for (size_t i = 0; i < chanx_occ.dim_size(0); i++) {
+            for (size_t j = 0; j < chanx_occ.dim_size(1); j++) {
+                chanx_occ[i][j] += local_occ.first[i][j];
+            }
+        }
+        for (size_t i = 0; i < chany_occ.dim_size(0); i++) {
+            for (size_t j = 0; j < chany_occ.dim_size(1); j++) {
+                chany_occ[i][j] += local_occ.second[i][j];
+            }
+        }
+    }
+#else
     for (auto net_id : net_list.nets()) {
         /* Skip global and empty nets. */
         if (net_list.net_is_ignored(net_id) && net_list.net_sinks(net_id).size() != 0)
             continue;
 
-        auto& tree = route_ctx.route_trees[net_id];
-        if (!tree)
-            continue;
+        add_net_channel_occupancy(net_id, chanx_occ, chany_occ);
+    }
+#endif
+}
 
-        for (auto& rt_node : tree.value().all_nodes()) {
-            RRNodeId inode = rt_node.inode;
-            t_rr_type rr_type = rr_graph.node_type(inode);
-
-            if (rr_type == CHANX) {
-                int j = rr_graph.node_ylow(inode);
-                for (int i = rr_graph.node_xlow(inode); i <= rr_graph.node_xhigh(inode); i++)
-                    chanx_occ[i][j]++;
-            } else if (rr_type == CHANY) {
-                int i = rr_graph.node_xlow(inode);
-                for (int j = rr_graph.node_ylow(inode); j <= rr_graph.node_yhigh(inode); j++)
-                    chany_occ[i][j]++;
-            }
+///@brief Adds the tracks used by net_id's routing to the channel occupancies
+static void add_net_channel_occupancy(ParentNetId net_id,
+                                      vtr::Matrix<int>& chanx_occ,
+                                      vtr::Matrix<int>& chany_occ) {
+    const auto& rr_graph = g_vpr_ctx.device().rr_graph;
+    auto& route_ctx = g_vpr_ctx.routing();
+
+    auto& tree = route_ctx.route_trees[net_id];
+    if (!tree)
+        return;
+
+    for (auto& rt_node : tree.value().all_nodes()) {
+        RRNodeId inode = rt_node.inode;
+        t_rr_type rr_type = rr_graph.node_type(inode);
+
+        if (rr_type == CHANX) {
+            int j = rr_graph.node_ylow(inode);
+            for (int i = rr_graph.node_xlow(inode); i <= rr_graph.node_xhigh(inode); i++)
+                chanx_occ[i][j]++;
+        } else if (rr_type == CHANY) {
+            int i = rr_graph.node_xlow(inode);
+            for (int j = rr_graph.node_ylow(inode); j <= rr_graph.node_yhigh(inode); j++)
+                chany_occ[i][j]++;
         }
     }
 }
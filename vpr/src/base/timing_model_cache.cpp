@@ -0,0 +1,276 @@
+#include "timing_model_cache.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+
+#include "vtr_digest.h"
+#include "vtr_log.h"
+
+#include "globals.h"
+
+namespace fs = std::filesystem;
+
+///@brief Maximum number of entries kept in a cache directory before the least recently used ones are evicted
+static constexpr size_t MAX_TIMING_MODEL_CACHE_ENTRIES = 32;
+
+///@brief Extension (and therefore serialization format) of cache entries
+static constexpr const char* TIMING_MODEL_CACHE_EXTENSION = ".capnp";
+
+///@brief Extension of the memory-mapped cache entries
+static constexpr const char* TIMING_MODEL_CACHE_MAPPED_EXTENSION = ".mmap";
+
+/******** File-scope function declarations ********/
+
+static void write_device_cache_key(std::ostream& os,
+                                   const std::vector<t_segment_inf>& segment_inf,
+                                   bool is_flat);
+
+static std::string digest_cache_key(const std::ostringstream& key);
+
+static void evict_stale_cache_entries(const fs::path& cache_dir);
+
+/******** Function definitions ********/
+
+std::string router_lookahead_cache_key(e_router_lookahead lookahead_type,
+                                       const std::vector<t_segment_inf>& segment_inf,
+                                       bool is_flat) {
+    std::ostringstream key;
+    key << "router_lookahead " << int(lookahead_type) << "\n";
+    write_device_cache_key(key, segment_inf, is_flat);
+    return digest_cache_key(key);
+}
+
+std::string place_delay_model_cache_key(const t_placer_opts& placer_opts,
+                                        const t_router_opts& router_opts,
+                                        const std::vector<t_segment_inf>& segment_inf,
+                                        bool is_flat) {
+    std::ostringstream key;
+    key << std::hexfloat;
+    key << "place_delay_model " << int(placer_opts.delay_model_type)
+        << " " << int(placer_opts.delay_model_reducer)
+        << " " << int(placer_opts.place_delta_delay_matrix_calculation_method)
+        << " " << placer_opts.delay_offset
+        << " " << placer_opts.delay_ramp_delta_threshold
+        << " " << placer_opts.delay_ramp_slope
+        << " '" << placer_opts.allowed_tiles_for_delay_model << "'\n";
+
+    //The delay model is profiled with the router lookahead and router cost parameters
+    key << "router " << int(router_opts.lookahead_type)
+        << " " << int(router_opts.route_type)
+        << " " << router_opts.fixed_channel_width
+        << " " << router_opts.astar_fac
+        << " " << router_opts.astar_offset
+        << " " << router_opts.router_profiler_astar_fac
+        << " " << router_opts.router_profiler_bidirectional_search
+        << " " << router_opts.bend_cost
+        << " '" << router_opts.read_router_lookahead << "'\n";
+
+    write_device_cache_key(key, segment_inf, is_flat);
+    return digest_cache_key(key);
+}
+
+std::string power_tech_cache_key(const std::string& tech_filepath) {
+    std::ifstream tech_file(tech_filepath, std::ios::binary);
+    if (!tech_file) {
+        return "";
+    }
+
+    //The technology properties only depend on the file contents
+    std::ostringstream key;
+    key << "power_tech\n"
+        << tech_file.rdbuf();
+    return digest_cache_key(key);
+}
+
+bool router_lookahead_is_cacheable(e_router_lookahead lookahead_type) {
+#ifdef VTR_ENABLE_CAPNPROTO
+    //Only the map lookahead (quantized or not) supports a complete capnp round-trip
+    return lookahead_type == e_router_lookahead::MAP || lookahead_type == e_router_lookahead::QUANTIZED_MAP;
+#else
+    (void)lookahead_type;
+    return false;
+#endif
+}
+
+bool place_delay_model_is_cacheable(PlaceDelayModelType delay_model_type) {
+#ifdef VTR_ENABLE_CAPNPROTO
+    return delay_model_type == PlaceDelayModelType::DELTA
+           || delay_model_type == PlaceDelayModelType::DELTA_OVERRIDE
+           || delay_model_type == PlaceDelayModelType::DELTA_LAZY;
+#else
+    (void)delay_model_type;
+    return false;
+#endif
+}
+
+bool power_tech_is_cacheable() {
+#ifdef VTR_ENABLE_CAPNPROTO
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::string timing_model_cache_entry(const std::string& cache_dir,
+                                     const std::string& kind,
+                                     const std::string& key) {
+    return (fs::path(cache_dir) / (kind + "_" + key + TIMING_MODEL_CACHE_EXTENSION)).string();
+}
+
+std::string timing_model_cache_mapped_entry(const std::string& cache_dir,
+                                            const std::string& kind,
+                                            const std::string& key) {
+    return (fs::path(cache_dir) / (kind + "_" + key + TIMING_MODEL_CACHE_MAPPED_EXTENSION)).string();
+}
+
+bool timing_model_cache_lookup(const std::string& entry) {
+    std::error_code ec;
+    if (!fs::is_regular_file(entry, ec)) {
+        return false;
+    }
+
+    //Mark the entry as recently used; failing to do so only affects eviction order
+    fs::last_write_time(entry, fs::file_time_type::clock::now(), ec);
+    return true;
+}
+
+void timing_model_cache_store(const std::string& entry,
+                              const std::function<void(const std::string&)>& write_fn) {
+    fs::path entry_path(entry);
+    fs::path cache_dir = entry_path.parent_path();
+
+    std::error_code ec;
+    fs::create_directories(cache_dir, ec);
+    if (ec) {
+        VTR_LOG_WARN("Unable to create timing model cache directory '%s': %s\n",
+                     cache_dir.string().c_str(), ec.message().c_str());
+        return;
+    }
+
+    //Write to a process-unique temporary name so concurrent writers never
+    //clobber each other, then atomically move the complete file into place
+    std::ostringstream tmp_name;
+    tmp_name << entry_path.stem().string() << ".tmp" << std::hex << std::hash<std::string>()(entry + std::to_string(fs::file_time_type::clock::now().time_since_epoch().count()))
+             << entry_path.extension().string();
+    fs::path tmp_path = cache_dir / tmp_name.str();
+
+    try {
+        write_fn(tmp_path.string());
+    } catch (...) {
+        fs::remove(tmp_path, ec);
+        throw;
+    }
+
+    fs::rename(tmp_path, entry_path, ec);
+    if (ec) {
+        VTR_LOG_WARN("Unable to store timing model cache entry '%s': %s\n",
+                     entry.c_str(), ec.message().c_str());
+        fs::remove(tmp_path, ec);
+        return;
+    }
+
+    evict_stale_cache_entries(cache_dir);
+}
+
+void timing_model_cache_remove(const std::string& entry) {
+    std::error_code ec;
+    fs::remove(entry, ec);
+}
+
+/******** File-scope function definitions ********/
+
+static void write_device_cache_key(std::ostream& os,
+                                   const std::vector<t_segment_inf>& segment_inf,
+                                   bool is_flat) {
+    const auto& device_ctx = g_vpr_ctx.device();
+    const auto& rr_graph = device_ctx.rr_graph;
+
+    os << std::hexfloat;
+    os << "arch " << device_ctx.arch->architecture_id << "\n";
+    os << "flat " << is_flat << "\n";
+    os << "grid '" << device_ctx.grid.name() << "' " << device_ctx.grid.width()
+       << " " << device_ctx.grid.height() << " " << device_ctx.grid.get_num_layers() << "\n";
+
+    const t_chan_width& chan_width = device_ctx.chan_width;
+    os << "chan_width " << chan_width.max << " " << chan_width.x_min << " " << chan_width.x_max
+       << " " << chan_width.y_min << " " << chan_width.y_max << "\n";
+
+    //An RR graph loaded from file may differ from the one built from the architecture.
+    //Identify it by name, size and modification time rather than by re-hashing its contents.
+    if (!device_ctx.read_rr_graph_filename.empty()) {
+        std::error_code ec;
+        auto size = fs::file_size(device_ctx.read_rr_graph_filename, ec);
+        auto mtime = fs::last_write_time(device_ctx.read_rr_graph_filename, ec);
+        os << "rr_graph_file '" << device_ctx.read_rr_graph_filename << "' " << size
+           << " " << mtime.time_since_epoch().count() << "\n";
+    }
+    os << "rr_nodes " << rr_graph.num_nodes() << "\n";
+
+    for (const t_segment_inf& seg : segment_inf) {
+        os << "segment '" << seg.name << "' " << seg.frequency << " " << seg.length
+           << " " << seg.arch_wire_switch << " " << seg.arch_opin_switch
+           << " " << seg.arch_wire_switch_dec << " " << seg.arch_opin_switch_dec
+           << " " << seg.arch_opin_between_dice_switch
+           << " " << seg.frac_cb << " " << seg.frac_sb << " " << seg.longline
+           << " " << seg.Rmetal << " " << seg.Cmetal
+           << " " << int(seg.directionality) << " " << int(seg.parallel_axis)
+           << " " << int(seg.res_type) << "\n";
+    }
+
+    for (size_t iswitch = 0; iswitch < rr_graph.num_rr_switches(); ++iswitch) {
+        const t_rr_switch_inf& sw = rr_graph.rr_switch_inf(RRSwitchId(iswitch));
+        os << "switch '" << sw.name << "' " << sw.R << " " << sw.Cin << " " << sw.Cout
+           << " " << sw.Cinternal << " " << sw.Tdel << " " << int(sw.type()) << "\n";
+    }
+
+    for (const t_rr_indexed_data& data : device_ctx.rr_indexed_data) {
+        os << "cost_index " << data.base_cost << " " << data.ortho_cost_index
+           << " " << data.seg_index << " " << data.inv_length << " " << data.T_linear
+           << " " << data.T_quadratic << " " << data.C_load << "\n";
+    }
+}
+
+static std::string digest_cache_key(const std::ostringstream& key) {
+    std::istringstream is(key.str());
+    std::string digest = vtr::secure_digest_stream(is);
+
+    //Strip the hash type prefix (e.g. 'SHA256:') so the digest can be used in file names
+    auto pos = digest.find(':');
+    if (pos != std::string::npos) {
+        digest = digest.substr(pos + 1);
+    }
+    return digest;
+}
+
+static void evict_stale_cache_entries(const fs::path& cache_dir) {
+    std::vector<std::pair<fs::file_time_type, fs::path>> entries;
+
+    std::error_code ec;
+    for (const auto& dir_entry : fs::directory_iterator(cache_dir, ec)) {
+        std::error_code entry_ec;
+        if (!dir_entry.is_regular_file(entry_ec)) continue;
+        if (dir_entry.path().extension() != TIMING_MODEL_CACHE_EXTENSION
+            && dir_entry.path().extension() != TIMING_MODEL_CACHE_MAPPED_EXTENSION) continue;
+        //Leave other writers' in-flight temporaries alone
+        if (dir_entry.path().stem().extension().string().rfind(".tmp", 0) == 0) continue;
+
+        auto mtime = dir_entry.last_write_time(entry_ec);
+        if (entry_ec) continue;
+        entries.emplace_back(mtime, dir_entry.path());
+    }
+
+    if (entries.size() <= MAX_TIMING_MODEL_CACHE_ENTRIES) {
+        return;
+    }
+
+    //Evict least recently used entries first
+    std::sort(entries.begin(), entries.end());
+    size_t num_evict = entries.size() - MAX_TIMING_MODEL_CACHE_ENTRIES;
+    for (size_t i = 0; i < num_evict; ++i) {
+        //Another process may already have removed it; that is fine
+        fs::remove(entries[i].second, ec);
+    }
+}
@@ -0,0 +1,90 @@
+#ifndef VPR_TIMING_MODEL_CACHE_H
+#define VPR_TIMING_MODEL_CACHE_H
+
+/**
+ * @file
+ * @brief Persistent on-disk cache for the router lookahead, the placement
+ *        delay model and the power technology properties.
+ *
+ * Computing these models dominates start-up time on large devices, and their
+ * result only depends on the device (architecture, grid, channel width, RR graph
+ * switch and segment data) and a handful of options. Each cache entry is stored
+ * as <cache_dir>/<kind>_<digest><extension>, where the digest is a SHA256 hash
+ * over everything the model depends on. A stale entry can therefore never be
+ * picked up: any change to the inputs produces a different file name.
+ *
+ * Entries are written to a temporary file and renamed into place, so concurrent
+ * VPR runs sharing a cache directory never observe partially written entries.
+ * Reading an entry refreshes its modification time, and the least recently used
+ * entries are evicted once the directory holds more than a fixed number of them.
+ * Since storing or evicting an entry only replaces or unlinks its directory entry,
+ * processes which memory map an entry keep a consistent view of it meanwhile.
+ */
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "vpr_types.h"
+
+///@brief Returns the digest identifying the router lookahead inputs of the current device
+std::string router_lookahead_cache_key(e_router_lookahead lookahead_type,
+                                       const std::vector<t_segment_inf>& segment_inf,
+                                       bool is_flat);
+
+///@brief Returns the digest identifying the placement delay model inputs of the current device
+std::string place_delay_model_cache_key(const t_placer_opts& placer_opts,
+                                        const t_router_opts& router_opts,
+                                        const std::vector<t_segment_inf>& segment_inf,
+                                        bool is_flat);
+
+///@brief Returns the digest identifying a power technology (cmos tech behavior) file, or an empty string if it can't be read
+std::string power_tech_cache_key(const std::string& tech_filepath);
+
+///@brief Returns true if lookahead_type can be stored in the on-disk cache in this build
+bool router_lookahead_is_cacheable(e_router_lookahead lookahead_type);
+
+///@brief Returns true if delay_model_type can be stored in the on-disk cache in this build
+bool place_delay_model_is_cacheable(PlaceDelayModelType delay_model_type);
+
+///@brief Returns true if the power technology properties can be stored in the on-disk cache in this build
+bool power_tech_is_cacheable();
+
+///@brief Returns the path of the cache entry of the given kind and key inside cache_dir
+std::string timing_model_cache_entry(const std::string& cache_dir,
+                                     const std::string& kind,
+                                     const std::string& key);
+
+/**
+ * @brief Returns the path of the memory-mapped cache entry of the given kind and key inside cache_dir
+ *
+ * Memory-mapped entries hold tables in the native layout they are queried in (e.g. see
+ * RouterLookahead::read_shared()) rather than a capnp message, so they are not portable
+ * across hosts, and are told apart by their extension.
+ */
+std::string timing_model_cache_mapped_entry(const std::string& cache_dir,
+                                            const std::string& kind,
+                                            const std::string& key);
+
+/**
+ * @brief Returns true if the cache entry exists.
+ *
+ * A hit refreshes the entry's modification time so it is evicted last.
+ */
+bool timing_model_cache_lookup(const std::string& entry);
+
+/**
+ * @brief Stores a cache entry.
+ *
+ * write_fn is called with a temporary file name (with the same extension as entry)
+ * which is atomically renamed to entry once written. Stale entries are then evicted.
+ * Filesystem failures are reported as warnings, since a missing cache entry only
+ * costs run-time.
+ */
+void timing_model_cache_store(const std::string& entry,
+                              const std::function<void(const std::string&)>& write_fn);
+
+///@brief Removes a (e.g. unreadable) cache entry
+void timing_model_cache_remove(const std::string& entry);
+
+#endif
@@ -14,6 +14,8 @@
 #include <cstdio>
 #include <cstring>
 #include <cmath>
+#include <functional>
+#include <future>
 
 #include "cluster_util.h"
 #include "vpr_context.h"
@@ -22,15 +24,19 @@
 #include "vtr_log.h"
 #include "vtr_version.h"
 #include "vtr_time.h"
+#include "vtr_profile.h"
 
 #include "vpr_types.h"
 #include "vpr_utils.h"
 #include "globals.h"
 #include "atom_netlist.h"
 #include "read_netlist.h"
+#include "netlist_snapshot.h"
+#include "write_interchange_physical_netlist.h"
 #include "check_netlist.h"
 #include "read_blif.h"
 #include "draw.h"
+#include "snapshot_render.h"
 #include "place_and_route.h"
 #include "pack.h"
 #include "place.h"
@@ -40,6 +46,7 @@
 #include "read_xml_noc_traffic_flows_file.h"
 #include "noc_routing_algorithm_creator.h"
 #include "stats.h"
+#include "memory_usage_report.h"
 #include "read_options.h"
 #include "echo_files.h"
 #include "SetupVPR.h"
@@ -106,6 +113,9 @@ static void free_complex_block_types();
 static void free_device(const t_det_routing_arch& routing_arch);
 static void free_circuit();
 
+static std::map<t_logical_block_type_ptr, size_t> count_netlist_type_instances();
+static void report_device_grid(const t_vpr_setup& vpr_setup);
+
 static void get_intercluster_switch_fanin_estimates(const t_vpr_setup& vpr_setup,
                                                     const t_arch& arch,
                                                     const int wire_segment_length,
@@ -176,6 +186,11 @@ void vpr_init(const int argc, const char** argv, t_options* options, t_vpr_setup
     /* Read in user options */
     *options = read_options(argc, argv);
 
+    //Record the phases of the flow from here on (i.e. including reading the architecture and circuit)
+    if (!options->write_phase_trace.value().empty()) {
+        vtr::start_phase_profiling();
+    }
+
     //Print out the arguments passed to VPR.
     //This provides a reference in the log file to exactly
     //how VPR was run, aiding in re-producibility
@@ -191,7 +206,7 @@ void vpr_init(const int argc, const char** argv, t_options* options, t_vpr_setup
  * 2. Read Circuit
  * 3. Sanity check all three
  */
-void vpr_init_with_options(const t_options* options, t_vpr_setup* vpr_setup, t_arch* arch) {
+void vpr_init_with_options(const t_options* options, t_vpr_setup* vpr_setup, t_arch* arch, bool read_arch) {
     //Set the number of parallel workers
     // We determine the number of workers in the following order:
     //  1. An explicitly specified command-line argument
@@ -235,6 +250,8 @@ void vpr_init_with_options(const t_options* options, t_vpr_setup* vpr_setup, t_a
     vpr_setup->clock_modeling = options->clock_modeling;
     vpr_setup->two_stage_clock_routing = options->two_stage_clock_routing;
     vpr_setup->exit_before_pack = options->exit_before_pack;
+    vpr_setup->overlap_device_creation = options->overlap_device_creation;
+    vpr_setup->report_memory_usage = options->report_memory_usage;
     vpr_setup->num_workers = num_workers;
 
     VTR_LOG("\n");
@@ -274,10 +291,10 @@ void vpr_init_with_options(const t_options* options, t_vpr_setup* vpr_setup, t_a
         add_warnings_to_suppress(func_name);
     }
 
-    /* Read in arch and circuit */
+    /* Read in arch (unless already read) and circuit */
     SetupVPR(options,
              vpr_setup->TimingEnabled,
-             true,
+             read_arch,
              &vpr_setup->FileNameOpts,
              arch,
              &vpr_setup->user_models,
@@ -314,9 +331,15 @@ void vpr_init_with_options(const t_options* options, t_vpr_setup* vpr_setup, t_a
     /* flush any messages to user still in stdout that hasn't gotten displayed */
     fflush(stdout);
 
-    /* Read blif file and sweep unused components */
+    /* Read blif file and sweep unused components (or the already processed netlist snapshot) */
     auto& atom_ctx = g_vpr_ctx.mutable_atom();
-    atom_ctx.nlist = read_and_process_circuit(options->circuit_format, *vpr_setup, *arch);
+    if (!vpr_setup->FileNameOpts.read_netlist_snapshot.empty()) {
+        atom_ctx.nlist = read_atom_netlist_snapshot(vpr_setup->FileNameOpts.read_netlist_snapshot,
+                                                    vpr_setup->user_models,
+                                                    vpr_setup->library_models);
+    } else {
+        atom_ctx.nlist = read_and_process_circuit(options->circuit_format, *vpr_setup, *arch);
+    }
 
     if (vpr_setup->PowerOpts.do_power) {
         //Load the net activity file for power estimation
@@ -377,17 +400,43 @@ bool vpr_flow(t_vpr_setup& vpr_setup, t_arch& arch) {
     tbb::global_control c(tbb::global_control::max_allowed_parallelism, vpr_setup.num_workers);
 #endif
 
+    //Packing which is loaded leaves the device context alone, so a device (of fixed size and channel width) can be
+    //built while the packing loads
+    bool overlap_device_creation = vpr_setup.overlap_device_creation && vpr_can_overlap_device_creation(vpr_setup);
+    std::future<void> device_creation;
+    if (overlap_device_creation) {
+        VTR_LOG("Creating the device while the packing loads\n");
+        device_creation = std::async(std::launch::async, [&]() {
+            vpr_create_fixed_device(vpr_setup, arch);
+        });
+    }
+
     { //Pack
         bool pack_success = vpr_pack_flow(vpr_setup, arch);
 
+        if (overlap_device_creation) {
+            //Rethrows any error of the device creation
+            device_creation.get();
+        }
+
+        if (vpr_setup.report_memory_usage) {
+            report_memory_usage("packing");
+        }
+
         if (!pack_success) {
             return false; //Unimplementable
         }
     }
 
-    // For the time being, we decided to create the flat graph after placement is done. Thus, the is_flat parameter for this function
-    //, since it is called before routing, should be false.
-    vpr_create_device(vpr_setup, arch, false);
+    if (overlap_device_creation) {
+        //The parts of the device creation which depend on the clustered netlist
+        report_device_grid(vpr_setup);
+        vpr_setup_noc(vpr_setup, arch);
+    } else {
+        // For the time being, we decided to create the flat graph after placement is done. Thus, the is_flat parameter for this function
+        //, since it is called before routing, should be false.
+        vpr_create_device(vpr_setup, arch, false);
+    }
 
     // TODO: Placer still assumes that cluster net list is used - graphics can not work with flat routing yet
     vpr_init_graphics(vpr_setup, arch, false);
@@ -398,6 +447,10 @@ bool vpr_flow(t_vpr_setup& vpr_setup, t_arch& arch) {
         const auto& placement_net_list = (const Netlist<>&)g_vpr_ctx.clustering().clb_nlist;
         bool place_success = vpr_place_flow(placement_net_list, vpr_setup, arch);
 
+        if (vpr_setup.report_memory_usage) {
+            report_memory_usage("placement");
+        }
+
         if (!place_success) {
             return false; //Unimplementable
         }
@@ -407,9 +460,17 @@ bool vpr_flow(t_vpr_setup& vpr_setup, t_arch& arch) {
     RouteStatus route_status;
     { //Route
         route_status = vpr_route_flow(router_net_list, vpr_setup, arch, is_flat);
+
+        if (vpr_setup.report_memory_usage) {
+            report_memory_usage("routing");
+        }
     }
     { //Analysis
         vpr_analysis_flow(router_net_list, vpr_setup, arch, route_status, is_flat);
+
+        if (vpr_setup.report_memory_usage) {
+            report_memory_usage("analysis");
+        }
     }
 
     //close the graphics
@@ -439,7 +500,6 @@ void vpr_create_device(t_vpr_setup& vpr_setup, const t_arch& arch, bool is_flat)
 void vpr_create_device_grid(const t_vpr_setup& vpr_setup, const t_arch& Arch) {
     vtr::ScopedStartFinishTimer timer("Build Device Grid");
     /* Read in netlist file for placement and routing */
-    auto& cluster_ctx = g_vpr_ctx.clustering();
     auto& device_ctx = g_vpr_ctx.mutable_device();
 
     device_ctx.arch = &Arch;
@@ -448,20 +508,80 @@ void vpr_create_device_grid(const t_vpr_setup& vpr_setup, const t_arch& Arch) {
      *Load the device grid
      */
 
-    //Record the resource requirement
-    std::map<t_logical_block_type_ptr, size_t> num_type_instances;
-    for (auto blk_id : cluster_ctx.clb_nlist.blocks()) {
-        num_type_instances[cluster_ctx.clb_nlist.block_type(blk_id)]++;
-    }
-
     //Build the device
     float target_device_utilization = vpr_setup.PackerOpts.target_device_utilization;
-    device_ctx.grid = create_device_grid(vpr_setup.device_layout, Arch.grid_layouts, num_type_instances, target_device_utilization);
+    device_ctx.grid = create_device_grid(vpr_setup.device_layout, Arch.grid_layouts, count_netlist_type_instances(), target_device_utilization);
 
     VTR_ASSERT_MSG(device_ctx.grid.get_num_layers() <= MAX_NUM_LAYERS,
                    "Number of layers should be less than MAX_NUM_LAYERS. "
                    "If you need more layers, please increase the value of MAX_NUM_LAYERS in vpr_types.h");
 
+    report_device_grid(vpr_setup);
+}
+
+bool vpr_can_overlap_device_creation(const t_vpr_setup& vpr_setup) {
+    //Packing (unlike loading a packing) builds device grids of its own
+    bool loads_packing = vpr_setup.PackerOpts.doPacking == STAGE_LOAD && !vpr_setup.PackerOpts.load_flat_placement;
+
+    //An auto-sized grid depends on the clustered netlist, and the rr graph is only built for a fixed channel width.
+    //The flat rr graph depends on the placement.
+    return loads_packing
+           && vpr_setup.device_layout != "auto"
+           && vpr_setup.PlacerOpts.place_chan_width != NO_FIXED_CHANNEL_WIDTH;
+}
+
+void vpr_create_fixed_device(t_vpr_setup& vpr_setup, const t_arch& arch) {
+    vtr::ScopedStartFinishTimer timer("Create Device");
+    VTR_ASSERT(vpr_can_overlap_device_creation(vpr_setup));
+
+    {
+        vtr::ScopedStartFinishTimer grid_timer("Build Device Grid");
+        auto& device_ctx = g_vpr_ctx.mutable_device();
+
+        device_ctx.arch = &arch;
+        device_ctx.grid = create_device_grid(vpr_setup.device_layout, arch.grid_layouts);
+
+        VTR_ASSERT_MSG(device_ctx.grid.get_num_layers() <= MAX_NUM_LAYERS,
+                       "Number of layers should be less than MAX_NUM_LAYERS. "
+                       "If you need more layers, please increase the value of MAX_NUM_LAYERS in vpr_types.h");
+    }
+
+    vpr_setup_clock_networks(vpr_setup, arch);
+
+    vpr_create_rr_graph(vpr_setup, arch, vpr_setup.PlacerOpts.place_chan_width, false);
+
+    //Prime the lookahead cache the placer would otherwise compute (see vpr_place())
+    if (vpr_setup.PlacerOpts.place_algorithm.is_timing_driven()) {
+        get_cached_router_lookahead(
+            vpr_setup.RoutingArch,
+            vpr_setup.RouterOpts.lookahead_type,
+            vpr_setup.RouterOpts.write_router_lookahead,
+            vpr_setup.RouterOpts.read_router_lookahead,
+            vpr_setup.RouterOpts.timing_model_cache_dir,
+            vpr_setup.Segments,
+            false);
+    }
+}
+
+///@brief Counts the clustered netlist blocks of each logical block type (the resource requirement of the device)
+static std::map<t_logical_block_type_ptr, size_t> count_netlist_type_instances() {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+
+    std::map<t_logical_block_type_ptr, size_t> num_type_instances;
+    for (auto blk_id : cluster_ctx.clb_nlist.blocks()) {
+        num_type_instances[cluster_ctx.clb_nlist.block_type(blk_id)]++;
+    }
+    return num_type_instances;
+}
+
+///@brief Reports the size of the device grid, and the resources the clustered netlist uses
+static void report_device_grid(const t_vpr_setup& vpr_setup) {
+    auto& device_ctx = g_vpr_ctx.device();
+
+    //Record the resource requirement
+    std::map<t_logical_block_type_ptr, size_t> num_type_instances = count_netlist_type_instances();
+    float target_device_utilization = vpr_setup.PackerOpts.target_device_utilization;
+
     /*
      *Report on the device
      */
@@ -704,10 +824,24 @@ void vpr_load_packing(t_vpr_setup& vpr_setup, const t_arch& arch) {
     cluster_ctx.post_routing_clb_pin_nets.clear();
     cluster_ctx.pre_routing_net_pin_mapping.clear();
 
-    cluster_ctx.clb_nlist = read_netlist(vpr_setup.FileNameOpts.NetFile.c_str(),
-                                         &arch,
-                                         vpr_setup.FileNameOpts.verify_file_digests,
-                                         vpr_setup.PackerOpts.pack_verbosity);
+    if (!vpr_setup.FileNameOpts.read_netlist_snapshot.empty()) {
+        cluster_ctx.clb_nlist = read_clustered_netlist_snapshot(vpr_setup.FileNameOpts.read_netlist_snapshot,
+                                                                &arch,
+                                                                vpr_setup.FileNameOpts.verify_file_digests,
+                                                                vpr_setup.PackerOpts.pack_verbosity);
+    } else {
+        cluster_ctx.clb_nlist = read_netlist(vpr_setup.FileNameOpts.NetFile.c_str(),
+                                             &arch,
+                                             vpr_setup.FileNameOpts.verify_file_digests,
+                                             vpr_setup.PackerOpts.pack_verbosity);
+    }
+
+    if (!vpr_setup.FileNameOpts.write_netlist_snapshot.empty()) {
+        write_netlist_snapshot(vpr_setup.FileNameOpts.write_netlist_snapshot,
+                               atom_ctx.nlist,
+                               cluster_ctx.clb_nlist,
+                               arch);
+    }
 
     /* Load the mapping between clusters and their atoms */
     init_clb_atoms_lookup(cluster_ctx.atoms_lookup, atom_ctx, cluster_ctx.clb_nlist);
@@ -790,6 +924,15 @@ bool vpr_place_flow(const Netlist<>& net_list, t_vpr_setup& vpr_setup, const t_a
         print_flat_placement(vpr_setup.FileNameOpts.write_flat_place_file.c_str());
     }
 
+    // Write out a binary placement file if the option is specified
+    if (!filename_opts.write_place_binary_file.empty()) {
+        const auto& cluster_ctx = g_vpr_ctx.clustering();
+        print_place_binary(filename_opts.NetFile.c_str(),
+                           cluster_ctx.clb_nlist.netlist_id().c_str(),
+                           filename_opts.write_place_binary_file.c_str(),
+                           g_vpr_ctx.placement().block_locs());
+    }
+
     return true;
 }
 
@@ -804,6 +947,7 @@ void vpr_place(const Netlist<>& net_list, t_vpr_setup& vpr_setup, const t_arch&
             vpr_setup.RouterOpts.lookahead_type,
             vpr_setup.RouterOpts.write_router_lookahead,
             vpr_setup.RouterOpts.read_router_lookahead,
+            vpr_setup.RouterOpts.timing_model_cache_dir,
             vpr_setup.Segments,
             is_flat);
     }
@@ -891,6 +1035,8 @@ RouteStatus vpr_route_flow(const Netlist<>& net_list,
             if (g_vpr_ctx.server().gate_io.is_running()) {
                 g_vpr_ctx.mutable_server().timing_info = timing_info;
                 g_vpr_ctx.mutable_server().routing_delay_calc = routing_delay_calc;
+                // process the requests received before the timing info was available
+                server::schedule_update(&application);
             }
 #endif /* NO_SERVER */
         } else {
@@ -942,6 +1088,14 @@ RouteStatus vpr_route_flow(const Netlist<>& net_list,
                         is_flat);
             get_serial_num(net_list);
 
+            if (!filename_opts.FPGAInterchangePhysicalFile.empty()) {
+                write_interchange_physical_netlist(filename_opts.FPGAInterchangePhysicalFile,
+                                                   filename_opts.ArchFile,
+                                                   net_list,
+                                                   arch,
+                                                   filename_opts.compress_fpga_interchange_physical_file);
+            }
+
             //Update status
             VTR_LOG("Circuit successfully routed with a channel width factor of %d.\n", route_status.chan_width());
             graphics_msg = vtr::string_fmt("Routing succeeded with a channel width factor of %d.\n", route_status.chan_width());
@@ -1000,6 +1154,7 @@ RouteStatus vpr_route_fixed_W(const Netlist<>& net_list,
         vpr_setup.RouterOpts.lookahead_type,
         vpr_setup.RouterOpts.write_router_lookahead,
         vpr_setup.RouterOpts.read_router_lookahead,
+        vpr_setup.RouterOpts.timing_model_cache_dir,
         vpr_setup.Segments,
         is_flat);
 
@@ -1109,8 +1264,10 @@ void vpr_create_rr_graph(t_vpr_setup& vpr_setup, const t_arch& arch, int chan_wi
 
     int warnings = 0;
 
-    //Clean-up any previous RR graph
-    free_rr_graph();
+    //Clean-up any previous RR graph (create_rr_graph() frees a reused one if the channel widths differ)
+    if (!vpr_setup.reuse_rr_graph) {
+        free_rr_graph();
+    }
 
     //Create the RR graph
     create_rr_graph(graph_type,
@@ -1134,16 +1291,18 @@ void vpr_init_graphics(const t_vpr_setup& vpr_setup, const t_arch& arch, bool is
                         vpr_setup.GraphicsCommands, is_flat);
     if (vpr_setup.ShowGraphics || vpr_setup.SaveGraphics || !vpr_setup.GraphicsCommands.empty())
         alloc_draw_structs(&arch);
+
+    /* Headless snapshot images don't need any of the above */
+    init_snapshot_images(vpr_setup.SnapshotImagePrefix, vpr_setup.SnapshotImageInterval);
 }
 
 void vpr_init_server(const t_vpr_setup& vpr_setup) {
 #ifndef NO_SERVER
     if (vpr_setup.ServerOpts.is_server_mode_enabled) {
-        /* Set up a server and its callback to be triggered at 100ms intervals by the timer's timeout event. */
+        /* Set up a server, its callback being scheduled in the main loop each time client requests are received. */
         server::GateIO& gate_io = g_vpr_ctx.mutable_server().gate_io;
         if (!gate_io.is_running()) {
-            gate_io.start(vpr_setup.ServerOpts.port_num);
-            g_timeout_add(/*interval_ms*/ 100, server::update, &application);
+            gate_io.start(vpr_setup.ServerOpts.port_num, []() { server::schedule_update(&application); });
         }
     }
 #else
@@ -1154,6 +1313,7 @@ void vpr_init_server(const t_vpr_setup& vpr_setup) {
 void vpr_close_graphics(const t_vpr_setup& /*vpr_setup*/) {
     /* Close down X Display */
     free_draw_structs();
+    finish_snapshot_images();
 }
 
 /**
@@ -1262,6 +1422,8 @@ void free_device(const t_det_routing_arch& /*routing_arch*/) {
 
     device_ctx.all_sw_inf.clear();
 
+    clear_auto_sized_grids();
+
     free_complex_block_types();
 }
 
@@ -1302,7 +1464,9 @@ static void free_routing() {
     routing_ctx.rr_blk_source.clear();
     routing_ctx.rr_blk_source.clear();
     routing_ctx.rr_node_route_inf.clear();
+    routing_ctx.rr_node_cong_inf.clear();
     routing_ctx.net_status.clear();
+    routing_ctx.verified_route_tree_fingerprints.clear();
     routing_ctx.route_bb.clear();
 }
 
@@ -1324,8 +1488,57 @@ void vpr_free_vpr_data_structures(t_arch& Arch,
     free_noc();
 }
 
+void vpr_free_design(t_vpr_setup& vpr_setup) {
+    if (vpr_setup.RouterOpts.doRouting) {
+        free_route_structs();
+    }
+    free_all_lb_type_rr_graph(vpr_setup.PackerRRGraph);
+    vpr_setup.PackerRRGraph = nullptr;
+    free_circuit();
+    free_placement();
+    free_routing();
+    free_atoms();
+
+    auto& cluster_ctx = g_vpr_ctx.mutable_clustering();
+    cluster_ctx.atoms_lookup.clear();
+    cluster_ctx.post_routing_clb_pin_nets.clear();
+    cluster_ctx.pre_routing_net_pin_mapping.clear();
+
+    auto& routing_ctx = g_vpr_ctx.mutable_routing();
+    routing_ctx.constraints = UserRouteConstraints();
+
+    auto& timing_ctx = g_vpr_ctx.mutable_timing();
+    timing_ctx.graph.reset();
+    timing_ctx.constraints.reset();
+    timing_ctx.stats = t_timing_analysis_profile_info();
+
+    auto& floorplanning_ctx = g_vpr_ctx.mutable_floorplanning();
+    floorplanning_ctx.constraints = UserPlaceConstraints();
+    floorplanning_ctx.cluster_constraints.clear();
+    floorplanning_ctx.compressed_cluster_constraints.clear();
+    floorplanning_ctx.cluster_constraints_index_ids.clear();
+    floorplanning_ctx.cluster_constraints_indices.clear();
+    floorplanning_ctx.overfull_partition_regions.clear();
+
+    //The clock networks are set up again with the device of the next design
+    auto& device_ctx = g_vpr_ctx.mutable_device();
+    device_ctx.clock_networks.clear();
+    device_ctx.clock_connections.clear();
+
+    //The intra-cluster resources of the flat rr graph depend on the placement
+    if (device_ctx.rr_graph_is_flat) {
+        free_rr_graph();
+    }
+}
+
 void vpr_free_all(t_arch& Arch,
                   t_vpr_setup& vpr_setup) {
+    if (vtr::is_phase_profiling() && !vpr_setup.FileNameOpts.write_phase_trace.empty()) {
+        vtr::write_phase_profile(vpr_setup.FileNameOpts.write_phase_trace);
+        VTR_LOG("Wrote the phase trace to %s\n", vpr_setup.FileNameOpts.write_phase_trace.c_str());
+        vtr::stop_phase_profiling();
+    }
+
     free_rr_graph();
     if (vpr_setup.RouterOpts.doRouting) {
         free_route_structs();
@@ -1360,7 +1573,7 @@ void vpr_setup_vpr(t_options* Options,
                    t_noc_opts* NocOpts,
                    t_server_opts* ServerOpts,
                    t_det_routing_arch* RoutingArch,
-                   std::vector<t_lb_type_rr_node>** PackerRRGraph,
+                   t_lb_type_rr_graph** PackerRRGraph,
                    std::vector<t_segment_inf>& Segments,
                    t_timing_inf* Timing,
                    bool* ShowGraphics,
@@ -1491,26 +1704,31 @@ void vpr_analysis(const Netlist<>& net_list,
         VPR_FATAL_ERROR(VPR_ERROR_ANALYSIS, "No routing loaded -- can not perform post-routing analysis");
     }
 
-    routing_stats(net_list,
-                  vpr_setup.RouterOpts.full_stats,
-                  vpr_setup.RouterOpts.route_type,
-                  vpr_setup.Segments,
-                  vpr_setup.RoutingArch.R_minW_nmos,
-                  vpr_setup.RoutingArch.R_minW_pmos,
-                  Arch.grid_logic_tile_area,
-                  vpr_setup.RoutingArch.directionality,
-                  vpr_setup.RoutingArch.wire_to_rr_ipin_switch,
-                  is_flat);
+    NetPinsMatrix<float> net_delay;
+    std::shared_ptr<AnalysisDelayCalculator> analysis_delay_calc;
+    std::unique_ptr<SetupHoldTimingInfo> timing_info;
+
+    //The reports only read the final implementation. With several workers, the ones which
+    //only write files run as tasks while those which print to the log run here (keeping the
+    //log in order). Declared after the timing analysis they read, so that on an error the
+    //tasks are waited for (by the futures' destructors) before it is destroyed.
+    std::vector<std::future<void>> report_tasks;
+    auto run_report = [&](std::function<void()> report) {
+        if (vpr_setup.num_workers > 1) {
+            report_tasks.push_back(std::async(std::launch::async, std::move(report)));
+        } else {
+            report();
+        }
+    };
 
     if (vpr_setup.TimingEnabled) {
         //Load the net delays
-
-        NetPinsMatrix<float> net_delay = make_net_pins_matrix<float>(net_list);
+        net_delay = make_net_pins_matrix<float>(net_list);
         load_net_delay_from_routing(net_list, net_delay);
 
         //Do final timing analysis
-        auto analysis_delay_calc = std::make_shared<AnalysisDelayCalculator>(atom_ctx.nlist, atom_ctx.lookup, net_delay, vpr_setup.RouterOpts.flat_routing);
-        auto timing_info = make_setup_hold_timing_info(analysis_delay_calc, vpr_setup.AnalysisOpts.timing_update_type);
+        analysis_delay_calc = std::make_shared<AnalysisDelayCalculator>(atom_ctx.nlist, atom_ctx.lookup, net_delay, vpr_setup.RouterOpts.flat_routing);
+        timing_info = make_setup_hold_timing_info(analysis_delay_calc, vpr_setup.AnalysisOpts.timing_update_type);
         timing_info->update();
 
         if (isEchoFileEnabled(E_ECHO_ANALYSIS_TIMING_GRAPH)) {
@@ -1519,22 +1737,48 @@ void vpr_analysis(const Netlist<>& net_list,
                               *timing_ctx.graph, *timing_ctx.constraints, *analysis_delay_calc, timing_info->analyzer());
         }
 
+        //Timing reports
+        run_report([&]() {
+            write_hold_timing_reports(/*prefix=*/"", *timing_info, *analysis_delay_calc,
+                                      vpr_setup.AnalysisOpts, vpr_setup.RouterOpts.flat_routing, blk_loc_registry);
+        });
+        run_report([&]() {
+            write_setup_timing_reports(/*prefix=*/"", *timing_info, *analysis_delay_calc,
+                                       vpr_setup.AnalysisOpts, vpr_setup.RouterOpts.flat_routing, blk_loc_registry);
+        });
+    }
+
+    routing_stats(net_list,
+                  vpr_setup.RouterOpts.full_stats,
+                  vpr_setup.RouterOpts.route_type,
+                  vpr_setup.Segments,
+                  vpr_setup.RoutingArch.R_minW_nmos,
+                  vpr_setup.RoutingArch.R_minW_pmos,
+                  Arch.grid_logic_tile_area,
+                  vpr_setup.RoutingArch.directionality,
+                  vpr_setup.RoutingArch.wire_to_rr_ipin_switch,
+                  is_flat);
+
+    if (vpr_setup.TimingEnabled) {
         //Timing stats
+        auto& timing_ctx = g_vpr_ctx.timing();
         VTR_LOG("\n");
-        generate_hold_timing_stats(/*prefix=*/"", *timing_info, *analysis_delay_calc,
-                                   vpr_setup.AnalysisOpts, vpr_setup.RouterOpts.flat_routing, blk_loc_registry);
-        generate_setup_timing_stats(/*prefix=*/"", *timing_info, *analysis_delay_calc,
-                                    vpr_setup.AnalysisOpts, vpr_setup.RouterOpts.flat_routing, blk_loc_registry);
+        print_hold_timing_summary(*timing_ctx.constraints, *timing_info->hold_analyzer(), "Final ");
+        print_setup_timing_summary(*timing_ctx.constraints, *timing_info->setup_analyzer(), "Final ", vpr_setup.AnalysisOpts.write_timing_summary);
 
         //Write the post-synthesis netlist
         if (vpr_setup.AnalysisOpts.gen_post_synthesis_netlist) {
-            netlist_writer(atom_ctx.nlist.netlist_name(), analysis_delay_calc,
-                           vpr_setup.AnalysisOpts);
+            run_report([&]() {
+                netlist_writer(atom_ctx.nlist.netlist_name(), analysis_delay_calc,
+                               vpr_setup.AnalysisOpts);
+            });
         }
 
         //Write the post-implementation merged netlist
         if (vpr_setup.AnalysisOpts.gen_post_implementation_merged_netlist) {
-            merged_netlist_writer(atom_ctx.nlist.netlist_name(), analysis_delay_calc, vpr_setup.AnalysisOpts);
+            run_report([&]() {
+                merged_netlist_writer(atom_ctx.nlist.netlist_name(), analysis_delay_calc, vpr_setup.AnalysisOpts);
+            });
         }
 
         //Do power analysis
@@ -1543,6 +1787,11 @@ void vpr_analysis(const Netlist<>& net_list,
             vpr_power_estimation(vpr_setup, Arch, *timing_info, route_status);
         }
     }
+
+    //Rethrows any error of the report tasks
+    for (std::future<void>& report_task : report_tasks) {
+        report_task.get();
+    }
 }
 
 /**
@@ -1580,7 +1829,8 @@ void vpr_power_estimation(const t_vpr_setup& vpr_setup,
 
     /* Initialize the power module */
     bool power_error = power_init(vpr_setup.FileNameOpts.PowerFile.c_str(),
-                                  vpr_setup.FileNameOpts.CmosTechFile.c_str(), &Arch, &vpr_setup.RoutingArch);
+                                  vpr_setup.FileNameOpts.CmosTechFile.c_str(), &Arch, &vpr_setup.RoutingArch,
+                                  vpr_setup.RouterOpts.timing_model_cache_dir);
     if (power_error) {
         VTR_LOG_ERROR("Power initialization failed.\n");
     }
@@ -46,7 +46,7 @@
  */
 void vpr_init(const int argc, const char** argv, t_options* options, t_vpr_setup* vpr_setup, t_arch* arch);
 void vpr_initialize_logging();
-void vpr_init_with_options(const t_options* options, t_vpr_setup* vpr_setup, t_arch* arch);
+void vpr_init_with_options(const t_options* options, t_vpr_setup* vpr_setup, t_arch* arch, bool read_arch = true);
 
 bool vpr_flow(t_vpr_setup& vpr_setup, t_arch& arch); //Run the VPR CAD flow
 
@@ -138,6 +138,26 @@ void vpr_create_device(t_vpr_setup& vpr_setup, const t_arch& Arch, bool is_flat)
 ///@brief Create the device grid
 void vpr_create_device_grid(const t_vpr_setup& vpr_setup, const t_arch& Arch);
 
+/**
+ * @brief Returns whether the device can be created while the packing loads
+ *
+ * True if the packing is loaded (rather than packed, which builds device grids of its own), and both the
+ * device grid (--device) and the channel width (--route_chan_width) are fixed, so neither depends on the
+ * clustered netlist.
+ */
+bool vpr_can_overlap_device_creation(const t_vpr_setup& vpr_setup);
+
+/**
+ * @brief Create the parts of the device which do not depend on the clustered netlist
+ *
+ * Builds the fixed size device grid, the clock networks, the rr graph at the fixed channel width and (for
+ * timing driven placement) the router lookahead. Only touches the device and routing contexts, so it may
+ * run concurrently with vpr_load_packing(). The grid report and the NoC (whose traffic flows name
+ * clustered blocks) remain to be set up once the packing is loaded.
+ * @attention Requires vpr_can_overlap_device_creation()
+ */
+void vpr_create_fixed_device(t_vpr_setup& vpr_setup, const t_arch& arch);
+
 ///@brief Create routing graph at specified channel width
 void vpr_create_rr_graph(t_vpr_setup& vpr_setup, const t_arch& arch, int chan_width, bool is_flat);
 
@@ -152,6 +172,15 @@ void vpr_setup_noc(const t_vpr_setup& vpr_setup, const t_arch& arch);
 void vpr_setup_noc_routing_algorithm(const std::string& noc_routing_algorithm_name);
 
 void vpr_free_vpr_data_structures(t_arch& Arch, t_vpr_setup& vpr_setup);
+
+/**
+ * @brief Frees the data structures of the design implemented with vpr_setup, so that another design can be implemented
+ *
+ * Resets the atom, clustering, placement, routing (except the router lookahead cache), timing and floorplanning contexts,
+ * but keeps the architecture and the device context (the grid, and the rr graph unless it is flat, since the flat rr graph
+ * depends on the placement).
+ */
+void vpr_free_design(t_vpr_setup& vpr_setup);
 void vpr_free_all(t_arch& Arch,
                   t_vpr_setup& vpr_setup);
 
@@ -184,7 +213,7 @@ void vpr_setup_vpr(t_options* Options,
                    t_noc_opts* NocOpts,
                    t_server_opts* ServerOpts,
                    t_det_routing_arch* RoutingArch,
-                   std::vector<t_lb_type_rr_node>** PackerRRGraph,
+                   t_lb_type_rr_graph** PackerRRGraph,
                    std::vector<t_segment_inf>& Segments,
                    t_timing_inf* Timing,
                    bool* ShowGraphics,
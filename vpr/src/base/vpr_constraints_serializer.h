@@ -1,6 +1,7 @@
 #ifndef VPR_CONSTRAINTS_SERIALIZER_H_
 #define VPR_CONSTRAINTS_SERIALIZER_H_
 
+#include "atom_name_matcher.h"
 #include "region.h"
 #include "vpr_constraints.h"
 #include "partition.h"
@@ -122,6 +123,32 @@ class VprConstraintsSerializer final : public uxsd::VprConstraintsBase<VprConstr
         loaded_route_constraint.second.reset();
     }
 
+    //constrains the atoms matched by the atom names and regular expressions read in to their partitions
+    void resolve_atom_patterns() {
+        std::vector<std::string> patterns;
+        patterns.reserve(atom_patterns_.size());
+        for (const auto& atom_pattern : atom_patterns_) {
+            patterns.push_back(atom_pattern.first);
+        }
+
+        AtomNameMatcher matcher(g_vpr_ctx.atom().nlist);
+        std::vector<std::vector<AtomBlockId>> matched_atoms = matcher.match(patterns);
+
+        //Applied in file order, so an atom matched for several partitions ends up in the last one
+        for (size_t i = 0; i < atom_patterns_.size(); ++i) {
+            /*If no atoms were found that matched the name, the name is invalid.
+             */
+            if (matched_atoms[i].empty()) {
+                VTR_LOG_WARN("Atom %s was not found, skipping atom.\n", atom_patterns_[i].first.c_str());
+            }
+
+            for (AtomBlockId atom : matched_atoms[i]) {
+                constraints_.mutable_place_constraints().add_constrained_atom(atom, atom_patterns_[i].second);
+            }
+        }
+        atom_patterns_.clear();
+    }
+
     /** Generated for complex type "add_atom":
      * <xs:complexType name="add_atom">
      *   <xs:attribute name="name_pattern" type="xs:string" use="required" />
@@ -134,42 +161,12 @@ class VprConstraintsSerializer final : public uxsd::VprConstraintsBase<VprConstr
     }
 
     virtual inline void set_add_atom_name_pattern(const char* name_pattern, void*& /*ctx*/) final {
-        auto& atom_ctx = g_vpr_ctx.atom();
-        std::string atom_name = name_pattern;
-
-        auto atom_name_regex = std::regex(atom_name);
-
-        atoms_.clear();
-
-        atom_id_ = atom_ctx.nlist.find_block(name_pattern);
-
         /* The constraints file may either provide a specific atom name or a regex.
-         * If the a valid atom ID is found for the atom name, then a specific atom name
-         * must have been read in from the file. The if condition checks for this case.
-         * The else statement checks for atoms that may match a regex.
-         * This code may get slow if many regexes are given in the file.
-         */
-        if (atom_id_ != AtomBlockId::INVALID()) {
-            atoms_.push_back(atom_id_);
-        } else {
-            /*If the atom name returns an invalid ID, it might be a regular expression, so loop through the atoms blocks
-             * and see if any block names match atom_name_regex.
-             */
-            for (auto block_id : atom_ctx.nlist.blocks()) {
-                auto block_name = atom_ctx.nlist.block_name(block_id);
-
-                if (std::regex_search(block_name, atom_name_regex)) {
-                    atoms_.push_back(block_id);
-                }
-            }
-        }
-
-        /*If the atoms_ vector is empty by this point, no atoms were found that matched the name,
-         * so the name is invalid.
+         * Matching the regexes against every atom one at a time is slow for large
+         * floorplans, so the patterns are only recorded here, and are all resolved
+         * together (see resolve_atom_patterns()) once the partitions are read.
          */
-        if (atoms_.empty()) {
-            VTR_LOG_WARN("Atom %s was not found, skipping atom.\n", name_pattern);
-        }
+        atom_patterns_.push_back({name_pattern, PartitionId(num_partitions_)});
     }
 
     /** Generated for complex type "add_region":
@@ -250,13 +247,7 @@ class VprConstraintsSerializer final : public uxsd::VprConstraintsBase<VprConstr
         return nullptr;
     }
 
-    virtual inline void finish_partition_add_atom(void*& /*ctx*/) final {
-        PartitionId part_id(num_partitions_);
-
-        for (auto atom : atoms_) {
-            constraints_.mutable_place_constraints().add_constrained_atom(atom, part_id);
-        }
-    }
+    virtual inline void finish_partition_add_atom(void*& /*ctx*/) final {}
 
     virtual inline size_t num_partition_add_atom(partition_info& part_info) final {
         return part_info.atoms.size();
@@ -483,6 +474,7 @@ class VprConstraintsSerializer final : public uxsd::VprConstraintsBase<VprConstr
     }
 
     virtual inline void finish_vpr_constraints_partition_list(void*& /*ctx*/) final {
+        resolve_atom_patterns();
     }
 
     virtual inline void* get_vpr_constraints_partition_list(void*& /*ctx*/) final {
@@ -524,9 +516,8 @@ class VprConstraintsSerializer final : public uxsd::VprConstraintsBase<VprConstr
     //used to count the number of partitions read in from the file
     int num_partitions_ = 0;
 
-    //used when reading in atom names and regular expressions for atoms
-    AtomBlockId atom_id_;
-    std::vector<AtomBlockId> atoms_;
+    //the atom names and regular expressions read in, with the partition they were given for
+    std::vector<std::pair<std::string, PartitionId>> atom_patterns_;
 };
 
 #endif /* VPR_CONSTRAINTS_SERIALIZER_H_ */
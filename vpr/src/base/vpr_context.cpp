@@ -0,0 +1,202 @@
+#include "vpr_context.h"
+
+#include <unordered_set>
+
+/*
+ * Memory usage accounting of the contexts (see report_memory_usage())
+ */
+
+///@brief Adds the memory held by the pb graph nodes under pb_graph_node (including it) to usage
+static void add_pb_graph_memory_usage(const t_pb_graph_node* pb_graph_node,
+                                      std::unordered_set<const t_pb_graph_edge*>& edges,
+                                      vtr::t_memory_usage& usage) {
+    usage.bytes += sizeof(t_pb_graph_node);
+    usage.bytes += pb_graph_node->num_pins() * sizeof(t_pb_graph_pin);
+
+    auto add_port_pins = [&](t_pb_graph_pin** port_pins, const int* num_port_pins, int num_ports) {
+        for (int iport = 0; iport < num_ports; ++iport) {
+            for (int ipin = 0; ipin < num_port_pins[iport]; ++ipin) {
+                const t_pb_graph_pin& pin = port_pins[iport][ipin];
+                usage += vtr::vector_memory_usage(pin.input_edges);
+                usage += vtr::vector_memory_usage(pin.output_edges);
+                usage += vtr::hash_memory_usage(pin.sink_pin_edge_idx_map);
+
+                //Each edge is held by the pins it connects, so count it once
+                for (const t_pb_graph_edge* edge : pin.output_edges) {
+                    if (edges.insert(edge).second) {
+                        usage.bytes += sizeof(t_pb_graph_edge);
+                        usage.bytes += (edge->num_input_pins + edge->num_output_pins) * sizeof(t_pb_graph_pin*);
+                    }
+                }
+            }
+        }
+    };
+    add_port_pins(pb_graph_node->input_pins, pb_graph_node->num_input_pins, pb_graph_node->num_input_ports);
+    add_port_pins(pb_graph_node->output_pins, pb_graph_node->num_output_pins, pb_graph_node->num_output_ports);
+    add_port_pins(pb_graph_node->clock_pins, pb_graph_node->num_clock_pins, pb_graph_node->num_clock_ports);
+
+    const t_pb_type* pb_type = pb_graph_node->pb_type;
+    for (int imode = 0; imode < pb_type->num_modes; ++imode) {
+        const t_mode& mode = pb_type->modes[imode];
+        for (int ichild = 0; ichild < mode.num_pb_type_children; ++ichild) {
+            for (int ipb = 0; ipb < mode.pb_type_children[ichild].num_pb; ++ipb) {
+                add_pb_graph_memory_usage(&pb_graph_node->child_pb_graph_nodes[imode][ichild][ipb], edges, usage);
+            }
+        }
+    }
+}
+
+std::vector<vtr::t_named_memory_usage> AtomContext::memory_usage() const {
+    return {{"nlist", nlist.memory_usage()}};
+}
+
+std::vector<vtr::t_named_memory_usage> TimingContext::memory_usage() const {
+    vtr::t_memory_usage graph_usage;
+    if (graph) {
+        //Estimated from the sizes of the graph, as tatum doesn't expose its storage
+        size_t num_nodes = graph->nodes().size();
+        size_t num_edges = graph->edges().size();
+        graph_usage.bytes = num_nodes * (2 * sizeof(tatum::NodeId) + sizeof(tatum::NodeType) + 2 * sizeof(std::vector<tatum::EdgeId>) + sizeof(tatum::LevelId))
+                            + num_edges * (3 * sizeof(tatum::EdgeId) + sizeof(tatum::EdgeType) + 2 * sizeof(tatum::NodeId))
+                            + num_edges / 8
+                            + graph->levels().size() * (sizeof(tatum::LevelId) + sizeof(std::vector<tatum::NodeId>));
+    }
+    return {{"graph (estimate)", graph_usage}};
+}
+
+std::vector<vtr::t_named_memory_usage> DeviceContext::memory_usage() const {
+    std::vector<vtr::t_named_memory_usage> usages;
+
+    const t_rr_graph_storage& rr_nodes = rr_graph.rr_nodes();
+    usages.push_back({"rr_graph nodes", rr_nodes.node_memory_usage()});
+    usages.push_back({"rr_graph edges", rr_nodes.edge_memory_usage()});
+    usages.push_back({"rr_graph node lookup", rr_graph.node_lookup().memory_usage()});
+    usages.push_back({"rr_indexed_data", vtr::vector_memory_usage(rr_indexed_data)});
+    usages.push_back({"rr_rc_data", vtr::vector_memory_usage(rr_rc_data)});
+
+    vtr::t_memory_usage non_config_usage = vtr::nested_vector_memory_usage(rr_non_config_node_sets);
+    non_config_usage += vtr::hash_memory_usage(rr_node_to_non_config_node_set);
+    usages.push_back({"rr_non_config_node_sets", non_config_usage});
+
+    vtr::t_memory_usage pb_graph_usage;
+    std::unordered_set<const t_pb_graph_edge*> pb_graph_edges;
+    for (const t_logical_block_type& type : logical_block_types) {
+        if (type.pb_graph_head) {
+            add_pb_graph_memory_usage(type.pb_graph_head, pb_graph_edges, pb_graph_usage);
+        }
+    }
+    usages.push_back({"pb_graph", pb_graph_usage});
+
+    return usages;
+}
+
+std::vector<vtr::t_named_memory_usage> ClusteringContext::memory_usage() const {
+    vtr::t_memory_usage atoms_lookup_usage = vtr::vector_memory_usage(atoms_lookup);
+    for (const auto& cluster_atoms : atoms_lookup) {
+        atoms_lookup_usage += vtr::hash_memory_usage(cluster_atoms);
+    }
+
+    return {{"clb_nlist", clb_nlist.memory_usage()},
+            {"atoms_lookup", atoms_lookup_usage}};
+}
+
+std::vector<vtr::t_named_memory_usage> PlacementContext::memory_usage() const {
+    std::vector<vtr::t_named_memory_usage> usages;
+
+    //Accessed directly, as the location variables are locked during placement
+    usages.push_back({"block_locs", vtr::vector_memory_usage(blk_loc_registry_.block_locs())});
+    usages.push_back({"grid_blocks", blk_loc_registry_.grid_blocks().memory_usage()});
+    usages.push_back({"physical_pins", vtr::vector_memory_usage(blk_loc_registry_.physical_pins())});
+
+    vtr::t_memory_usage macros_usage = vtr::vector_memory_usage(pl_macros);
+    for (const t_pl_macro& pl_macro : pl_macros) {
+        macros_usage += vtr::vector_memory_usage(pl_macro.members);
+    }
+    usages.push_back({"pl_macros", macros_usage});
+
+    vtr::t_memory_usage movable_blocks_usage = vtr::vector_memory_usage(movable_blocks);
+    movable_blocks_usage += vtr::nested_vector_memory_usage(movable_blocks_per_type);
+    usages.push_back({"movable_blocks", movable_blocks_usage});
+
+    vtr::t_memory_usage compressed_grids_usage = vtr::vector_memory_usage(compressed_block_grids);
+    for (const t_compressed_block_grid& compressed_grid : compressed_block_grids) {
+        compressed_grids_usage += vtr::nested_vector_memory_usage(compressed_grid.compressed_to_grid_x);
+        compressed_grids_usage += vtr::nested_vector_memory_usage(compressed_grid.compressed_to_grid_y);
+        compressed_grids_usage += vtr::vector_memory_usage(compressed_grid.compressed_to_grid_layer);
+        for (const auto& layer_grid : compressed_grid.grid) {
+            compressed_grids_usage += vtr::nested_vector_memory_usage(layer_grid);
+        }
+        compressed_grids_usage += vtr::vector_memory_usage(compressed_grid.num_blocks_below);
+        for (const auto& layer_num_blocks_below : compressed_grid.num_blocks_below) {
+            compressed_grids_usage += vtr::matrix_memory_usage(layer_num_blocks_below);
+        }
+        compressed_grids_usage += vtr::nested_vector_memory_usage(compressed_grid.grid_x_to_compressed_x_approx);
+        compressed_grids_usage += vtr::nested_vector_memory_usage(compressed_grid.grid_y_to_compressed_y_approx);
+        compressed_grids_usage += vtr::nested_vector_memory_usage(compressed_grid.compatible_sub_tiles_for_tile);
+    }
+    usages.push_back({"compressed_block_grids", compressed_grids_usage});
+
+    return usages;
+}
+
+std::vector<vtr::t_named_memory_usage> RoutingContext::memory_usage() const {
+    std::vector<vtr::t_named_memory_usage> usages;
+
+    vtr::t_memory_usage route_trees_usage = vtr::vector_memory_usage(route_trees);
+    for (const auto& route_tree : route_trees) {
+        if (route_tree) {
+            route_trees_usage += route_tree->memory_usage();
+        }
+    }
+    usages.push_back({"route_trees", route_trees_usage});
+
+    vtr::t_memory_usage trace_nodes_usage = vtr::vector_memory_usage(trace_nodes);
+    for (const auto& net_trace_nodes : trace_nodes) {
+        trace_nodes_usage += vtr::hash_memory_usage(net_trace_nodes);
+    }
+    usages.push_back({"trace_nodes", trace_nodes_usage});
+
+    vtr::t_memory_usage terminals_usage = vtr::nested_vector_memory_usage(net_rr_terminals);
+    terminals_usage += vtr::nested_vector_memory_usage(rr_blk_source);
+    terminals_usage += vtr::vector_memory_usage(net_terminal_groups);
+    for (const auto& net_groups : net_terminal_groups) {
+        terminals_usage += vtr::nested_vector_memory_usage(net_groups);
+    }
+    terminals_usage += vtr::nested_vector_memory_usage(net_terminal_group_num);
+    usages.push_back({"net terminals", terminals_usage});
+
+    usages.push_back({"rr_node_route_inf", vtr::vector_memory_usage(rr_node_route_inf)});
+    usages.push_back({"rr_node_cong_inf", vtr::vector_memory_usage(rr_node_cong_inf)});
+
+    vtr::t_memory_usage net_data_usage = vtr::vector_memory_usage(is_clock_net);
+    net_data_usage += vtr::vector_memory_usage(verified_route_tree_fingerprints);
+    net_data_usage += vtr::vector_memory_usage(route_bb);
+    net_data_usage.bytes += non_configurable_bitset.size() / 8;
+    usages.push_back({"per net/node flags and bounding boxes", net_data_usage});
+
+    vtr::t_memory_usage lookahead_usage;
+    if (const RouterLookahead* router_lookahead = cached_router_lookahead_.peek()) {
+        lookahead_usage = router_lookahead->memory_usage();
+    }
+    usages.push_back({"router lookahead", lookahead_usage});
+
+    return usages;
+}
+
+std::vector<vtr::t_named_memory_usage> FloorplanningContext::memory_usage() const {
+    vtr::t_memory_usage constraints_usage = vtr::vector_memory_usage(cluster_constraints);
+    for (const PartitionRegion& pr : cluster_constraints) {
+        constraints_usage += vtr::vector_memory_usage(pr.get_regions());
+    }
+
+    vtr::t_memory_usage compressed_constraints_usage = vtr::vector_memory_usage(compressed_cluster_constraints);
+    for (const auto& layer_constraints : compressed_cluster_constraints) {
+        compressed_constraints_usage += vtr::vector_memory_usage(layer_constraints);
+        for (const PartitionRegion& pr : layer_constraints) {
+            compressed_constraints_usage += vtr::vector_memory_usage(pr.get_regions());
+        }
+    }
+
+    return {{"cluster_constraints", constraints_usage},
+            {"compressed_cluster_constraints", compressed_constraints_usage}};
+}
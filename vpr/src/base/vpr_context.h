@@ -7,6 +7,7 @@
 
 #include "prepack.h"
 #include "vpr_types.h"
+#include "vtr_memory_usage.h"
 #include "vtr_ndmatrix.h"
 #include "vtr_optional.h"
 #include "vtr_vector.h"
@@ -18,6 +19,7 @@
 #include "rr_graph_builder.h"
 #include "rr_node.h"
 #include "rr_rc_data.h"
+#include "alloc_and_load_rr_indexed_data.h"
 #include "tatum/TimingGraph.hpp"
 #include "tatum/TimingConstraints.hpp"
 #include "power.h"
@@ -27,7 +29,10 @@
 #include "clock_connection_builders.h"
 #include "route_tree.h"
 #include "router_lookahead.h"
+#include "router_lookahead_correction.h"
+#include "global_route.h"
 #include "place_macro.h"
+#include "place_macro_footprints.h"
 #include "compressed_grid.h"
 #include "metadata_storage.h"
 #include "vpr_constraints.h"
@@ -79,6 +84,9 @@ struct AtomContext : public Context {
 
     /// @brief Mappings to/from the Atom Netlist to physically described .blif models
     AtomLookup lookup;
+
+    ///@brief Returns the memory held by the main data structures of this context
+    std::vector<vtr::t_named_memory_usage> memory_usage() const;
 };
 
 /**
@@ -106,10 +114,24 @@ struct TimingContext : public Context {
      */
     std::shared_ptr<tatum::TimingConstraints> constraints;
 
+    /**
+     * @brief Scale factors of the logic (primitive and intra-cluster) and routing (inter-cluster)
+     * delays, for each timing corner.
+     *
+     * Each lane of a tatum::Time (see TIME_VEC_WIDTH) holds the timing of one corner, so
+     * the delay calculators produce the delays of all corners at once, and each timing
+     * analysis computes the arrival/required times and slacks of all corners.
+     */
+    tatum::Time corner_logic_delay_scale = tatum::Time(1.);
+    tatum::Time corner_routing_delay_scale = tatum::Time(1.);
+
     t_timing_analysis_profile_info stats;
 
     /* Represents whether or not VPR should fail if timing constraints aren't met. */
     bool terminate_if_timing_fails = false;
+
+    ///@brief Returns the memory held by the main data structures of this context
+    std::vector<vtr::t_named_memory_usage> memory_usage() const;
 };
 
 namespace std {
@@ -184,6 +206,9 @@ struct DeviceContext : public Context {
 
     vtr::vector<RRIndexedDataId, t_rr_indexed_data> rr_indexed_data; // [0 .. num_rr_indexed_data-1]
 
+    ///@brief Wire delays of rr_indexed_data, reused by the rr graphs of later channel widths with --reuse_rr_indexed_data_delays
+    t_rr_indexed_data_delays rr_indexed_data_delays;
+
     ///@brief Fly-weighted Resistance/Capacitance data for RR Nodes
     std::vector<t_rr_rc_data> rr_rc_data;
 
@@ -248,6 +273,9 @@ struct DeviceContext : public Context {
      * Place Related
      *******************************************************************/
     enum e_pad_loc_type pad_loc_type;
+
+    ///@brief Returns the memory held by the main data structures of this context
+    std::vector<vtr::t_named_memory_usage> memory_usage() const;
 };
 
 /**
@@ -268,7 +296,7 @@ struct PowerContext : public Context {
     vtr::vector<ClusterNetId, t_net_power> clb_net_power;
 
     ///@brief Atom net power info
-    std::unordered_map<AtomNetId, t_net_power> atom_net_power;
+    vtr::vector<AtomNetId, t_net_power> atom_net_power;
     t_power_components by_component;
 };
 
@@ -300,6 +328,9 @@ struct ClusteringContext : public Context {
     ///        clustered block [0 .. num_clustered_blocks-1]
     /// This is populated when the packing is loaded.
     vtr::vector<ClusterBlockId, std::unordered_set<AtomBlockId>> atoms_lookup;
+
+    ///@brief Returns the memory held by the main data structures of this context
+    std::vector<vtr::t_named_memory_usage> memory_usage() const;
 };
 
 /**
@@ -365,6 +396,9 @@ struct PlacementContext : public Context {
     ///@brief The pl_macros array stores all the placement macros (usually carry chains).
     std::vector<t_pl_macro> pl_macros;
 
+    ///@brief The legal head locations of the placement macros during the anneal (see PlaceMacroFootprints)
+    PlaceMacroFootprints macro_footprints;
+
     ///@brief Stores ClusterBlockId of all movable clustered blocks (blocks that are not locked down to a single location)
     std::vector<ClusterBlockId> movable_blocks;
 
@@ -398,6 +432,9 @@ struct PlacementContext : public Context {
      * it would mean that per-layer bounding box is used. For the 2D architecture, the cube bounding box would be used.
      */
     bool cube_bb = false;
+
+    ///@brief Returns the memory held by the main data structures of this context
+    std::vector<vtr::t_named_memory_usage> memory_usage() const;
 };
 
 /**
@@ -418,7 +455,9 @@ struct RoutingContext : public Context {
 
     vtr::vector<ParentBlockId, std::vector<RRNodeId>> rr_blk_source; /* [0..num_blocks-1][0..num_class-1] */
 
-    vtr::vector<RRNodeId, t_rr_node_route_inf> rr_node_route_inf; /* [0..device_ctx.num_rr_nodes-1] */
+    vtr::vector<RRNodeId, t_rr_node_route_inf> rr_node_route_inf; /* [0..device_ctx.num_rr_nodes-1] Search state of the serial router */
+
+    vtr::vector<RRNodeId, t_rr_node_cong_inf> rr_node_cong_inf; /* [0..device_ctx.num_rr_nodes-1] */
 
     vtr::vector<ParentNetId, std::vector<std::vector<int>>> net_terminal_groups;
 
@@ -438,6 +477,15 @@ struct RoutingContext : public Context {
     ///@brief Information about current routing status of each net
     t_net_routing_status net_status;
 
+    /**
+     * @brief Fingerprint of the routing of each net when check_route() last verified it (0 if never)
+     *
+     * Lets an incremental check_route() skip the nets whose routing is unchanged. Cleared when the
+     * routing structures of a new rr graph are allocated, since the same route tree may not be
+     * legal in another rr graph.
+     */
+    vtr::vector<ParentNetId, size_t> verified_route_tree_fingerprints;
+
     ///@brief Limits area within which each net must be routed.
     vtr::vector<ParentNetId, t_bb> route_bb; /* [0..cluster_ctx.clb_nlist.nets().size()-1]*/
 
@@ -462,10 +510,27 @@ struct RoutingContext : public Context {
                RouterLookahead>
         cached_router_lookahead_;
 
+    /**
+     * @brief Correction of the router lookahead learnt from the routing (see LookaheadCorrection)
+     *
+     * Only enabled (and updated between the iterations) by the router with --router_lookahead_correction.
+     */
+    LookaheadCorrection lookahead_correction;
+
+    /**
+     * @brief Corridors of the connections from a global routing of the nets (see GlobalRouteGuides)
+     *
+     * Only enabled (for the first routing iteration) by the router with --router_global_route_guides.
+     */
+    GlobalRouteGuides global_route_guides;
+
     /**
      * @brief User specified routing constraints
      */
     UserRouteConstraints constraints;
+
+    ///@brief Returns the memory held by the main data structures of this context
+    std::vector<vtr::t_named_memory_usage> memory_usage() const;
 };
 
 /**
@@ -516,7 +581,20 @@ struct FloorplanningContext : public Context {
      */
     std::vector<vtr::vector<ClusterBlockId, PartitionRegion>> compressed_cluster_constraints;
 
+    /**
+     * @brief Spatial indices of the cluster constraints made of many regions, used by cluster_floorplanning_legal()
+     *
+     * cluster_constraints_index_ids[blk_id] is the index in cluster_constraints_indices of the index of
+     * cluster_constraints[blk_id] (which is shared by the clusters with the same constraints), OPEN
+     * if the cluster's constraints are not indexed. Built with the compressed cluster constraints.
+     */
+    vtr::vector<ClusterBlockId, int> cluster_constraints_index_ids;
+    std::vector<PartitionRegionIndex> cluster_constraints_indices;
+
     std::vector<PartitionRegion> overfull_partition_regions;
+
+    ///@brief Returns the memory held by the main data structures of this context
+    std::vector<vtr::t_named_memory_usage> memory_usage() const;
 };
 
 /**
@@ -587,6 +665,15 @@ struct ServerContext : public Context {
      */
     std::vector<tatum::TimingPath> crit_paths;
 
+    /**
+     * @brief Stores the sections of the last critical path report sent to each client (see server::split_crit_path_report()),
+     * and the options it was generated with, indexed by client id (see server::Task::client_id()).
+     *
+     * A delta response to the next request of the client with the same options only sends the paths that changed since.
+     */
+    std::unordered_map<int, std::vector<std::string>> crit_path_report_sections;
+    std::unordered_map<int, std::string> crit_path_report_options;
+
     /**
      * @brief Stores the selected critical path elements.
      *
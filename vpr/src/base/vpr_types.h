@@ -24,6 +24,7 @@
 #ifndef VPR_TYPES_H
 #define VPR_TYPES_H
 
+#include <atomic>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
@@ -37,6 +38,7 @@
 #include "heap_type.h"
 
 #include "vtr_assert.h"
+#include "vtr_memory.h"
 #include "vtr_ndmatrix.h"
 #include "vtr_vector.h"
 #include "vtr_util.h"
@@ -118,6 +120,8 @@ enum class e_router_lookahead {
     MAP,
     ///@brief Similar to MAP, but use a sparse sampling of the chip
     COMPRESSED_MAP,
+    ///@brief MAP, with its wire lookahead quantized to 16-bit delays and congestions to reduce its memory footprint
+    QUANTIZED_MAP,
     ///@brief Lookahead with a more extensive node sampling method
     EXTENDED_MAP,
     ///@brief A no-operation lookahead which always returns zero
@@ -134,6 +138,13 @@ enum class e_router_initial_timing {
     LOOKAHEAD
 };
 
+///@brief How the RR graph edges are stored once the graph is built
+enum class e_rr_edge_compression {
+    NONE,   ///<Separate source node, sink node and switch arrays
+    PACKED, ///<Sink node and switch packed into 32 bits per edge (t_rr_graph_storage::pack_edges())
+    TILED   ///<Edge lists shared between the repeated tiles of the fabric (t_rr_graph_storage::tile_edges())
+};
+
 enum class e_const_gen_inference {
     NONE,    ///<No constant generator inference
     COMB,    ///<Only combinational constant generator inference
@@ -155,7 +166,8 @@ enum class e_balance_block_type_util {
 enum class e_check_route_option {
     OFF,
     QUICK,
-    FULL
+    FULL,
+    INCREMENTAL ///<FULL checks, but only of the nets whose routing changed since they were last checked
 };
 
 ///@brief Selection algorithm for selecting next seed
@@ -443,11 +455,14 @@ struct t_timing_inf {
     bool timing_analysis_enabled;
     float C_ipin_cblock;
     std::string SDCFile;
+    std::vector<float> corner_logic_delay_scales;   ///<Scale factor of the logic (primitive and intra-cluster) delays of each timing corner
+    std::vector<float> corner_routing_delay_scales; ///<Scale factor of the routing (inter-cluster) delays of each timing corner
 };
 
 enum class e_timing_update_type {
     FULL,
     INCREMENTAL,
+    PARALLEL_INCREMENTAL, ///<Incremental, processing each level of the update in parallel
     AUTO
 };
 
@@ -750,7 +765,8 @@ struct t_file_name_opts {
     std::string FlatPlaceFile;
     std::string PlaceFile;
     std::string RouteFile;
-    std::string FPGAInterchangePhysicalFile;
+    std::string FPGAInterchangePhysicalFile; ///<Physical netlist written once routed (FPGA interchange devices only)
+    bool compress_fpga_interchange_physical_file = true;
     std::string ActFile;
     std::string PowerFile;
     std::string CmosTechFile;
@@ -759,7 +775,11 @@ struct t_file_name_opts {
     std::string write_vpr_constraints_file;
     std::string write_constraints_file;
     std::string write_flat_place_file;
+    std::string write_place_binary_file;
     std::string write_block_usage;
+    std::string read_netlist_snapshot;
+    std::string write_netlist_snapshot;
+    std::string write_phase_trace; ///<Chrome trace of the phases of the flow (see vtr_profile.h), written by vpr_free_all()
     bool verify_file_digests;
 };
 
@@ -820,10 +840,13 @@ struct t_packer_opts {
     enum e_packer_algorithm packer_algorithm;
     std::string device_layout;
     e_timing_update_type timing_update_type;
+    int timing_update_interval;
     bool use_attraction_groups;
+    bool repack_overfull_regions_only;
     int pack_num_moves;
     std::string pack_move_type;
     bool load_flat_placement;
+    std::string incremental_pack_file;
 };
 
 /**
@@ -978,6 +1001,7 @@ enum class PlaceDelayModelType {
     SIMPLE,
     DELTA,          ///<Delta x/y based delay model
     DELTA_OVERRIDE, ///<Delta x/y based delay model with special case delay overrides
+    DELTA_LAZY,     ///<Delta x/y based delay model computed on demand
 };
 
 enum class e_reducer {
@@ -1059,7 +1083,43 @@ enum class e_move_type;
  *   @param place_constraint_subtile
  *              True if subtiles should be specified when printing floorplan
  *              constraints. False if not.
- *
+ *   @param place_move_batch_size
+ *              Number of moves proposed and evaluated together (concurrently
+ *              when VPR is built with TBB) by the annealer. 1 runs the
+ *              regular serial annealer.
+ *   @param place_move_candidates
+ *              Number of candidate locations the serial annealer tries for the
+ *              block of each move, keeping the one with the lowest estimated
+ *              cost. 1 evaluates the proposed move only.
+ *   @param place_multilevel_levels
+ *              Number of coarsening levels of the multilevel annealer, whose
+ *              moves move groups of connected blocks at the coarse levels.
+ *              0 anneals the flat netlist only.
+ *   @param place_multilevel_temps
+ *              Number of temperatures the multilevel annealer spends at each
+ *              coarse level before uncoarsening.
+ *   @param place_seeds
+ *              Number of seeds (seed, seed+1, ...) the circuit is placed with.
+ *              The device, timing graph and placement delay model are shared
+ *              by all of them, and only the best placement is kept.
+ *   @param place_checkpoint_file
+ *              File the anneal state (placement, temperature, range limit and RL
+ *              agent state) is written to at the start of each temperature,
+ *              empty if none.
+ *   @param place_resume_file
+ *              Anneal checkpoint file to resume the anneal from, empty if none.
+ *   @param place_anneal_telemetry_file
+ *              CSV file the annealing state and costs of each temperature are
+ *              written to, empty if none.
+ *   @param place_anneal_schedule_model_file
+ *              Anneal schedule model (fitted on the telemetry of previous runs)
+ *              used to end the anneal once it stops improving, empty if none.
+ *   @param place_congestion_weight
+ *              Weight of the estimated routing congestion (RUDY) cost in the
+ *              placement cost. 0 disables the congestion cost.
+ *   @param place_congestion_util_threshold
+ *              Estimated channel utilization above which a channel is
+ *              considered congested by the congestion cost.
  *
  */
 struct t_placer_opts {
@@ -1081,6 +1141,17 @@ struct t_placer_opts {
     float td_place_exp_last;
     e_stage_action doPlacement;
     float rlim_escape_fraction;
+    int place_move_batch_size;
+    int place_move_candidates;
+    int place_multilevel_levels;
+    int place_multilevel_temps;
+    int place_seeds;
+    std::string place_checkpoint_file;
+    std::string place_resume_file;
+    std::string place_anneal_telemetry_file;
+    std::string place_anneal_schedule_model_file;
+    float place_congestion_weight;
+    float place_congestion_util_threshold;
     std::string move_stats_file;
     int placement_saves_per_temperature;
     e_place_effort_scaling effort_scaling;
@@ -1158,6 +1229,10 @@ struct t_placer_opts {
  * min_incremental_reroute_fanout: Minimum fanout a net needs to have       *
  *              for incremental reroute to be applied to it through route   *
  *              tree pruning. Larger circuits should get larger thresholds  *
+ * incremental_reroute_overuse_threshold: Once at most this many RR nodes   *
+ *              are overused, nets of any fanout are rerouted incrementally *
+ *              (only connections through overused nodes are ripped up).    *
+ *              Negative disables.                                          *
  * bb_factor:  Linear distance a route can go outside the net bounding      *
  *             box.                                                         *
  * route_type:  GLOBAL or DETAILED.                                         *
@@ -1167,6 +1242,13 @@ struct t_placer_opts {
  *                       on channel width.                                  *
  * router_algorithm:  TIMING_DRIVEN or PARALLEL.  Selects the desired       *
  * routing algorithm.                                                       *
+ * router_optimistic_concurrency: With the PARALLEL router, route nets      *
+ *              with overlapping bounding boxes concurrently instead of     *
+ *              serially. Conflicts are resolved as congestion in later     *
+ *              iterations. Not deterministic.                              *
+ * router_deterministic: With the PARALLEL and PARALLEL_DECOMP routers,     *
+ *              make the routing independent of the number of threads and  *
+ *              their timing.                                               *
  * base_cost_type: Specifies how to compute the base cost of each type of   *
  *                 rr_node.  DELAY_NORMALIZED -> base_cost = "demand"       *
  *                 x average delay to route past 1 CLB.  DEMAND_ONLY ->     *
@@ -1261,20 +1343,25 @@ struct t_router_opts {
     float bend_cost;
     int max_router_iterations;
     int min_incremental_reroute_fanout;
+    int incremental_reroute_overuse_threshold;
     e_incr_reroute_delay_ripup incr_reroute_delay_ripup;
     int bb_factor;
     enum e_route_type route_type;
     int fixed_channel_width;
     int min_channel_width_hint; ///<Hint to binary search of what the minimum channel width is
     enum e_router_algorithm router_algorithm;
+    bool router_optimistic_concurrency;
+    bool router_deterministic;
     enum e_base_cost_type base_cost_type;
     float astar_fac;
     float astar_offset;
     float router_profiler_astar_fac;
+    bool router_profiler_bidirectional_search;
     float max_criticality;
     float criticality_exp;
     float init_wirelength_abort_threshold;
     bool verify_binary_search;
+    bool binary_search_warm_start; ///<Warm-start each channel width of the binary search from the previous routing
     bool full_stats;
     bool congestion_analysis;
     bool fanout_analysis;
@@ -1287,30 +1374,52 @@ struct t_router_opts {
     e_route_bb_update route_bb_update;
     enum e_clock_modeling clock_modeling; ///<How clock pins and nets should be handled
     bool two_stage_clock_routing;         ///<How clock nets on dedicated networks should be routed
+    bool dedicated_clock_sink_routing;    ///<Route the sinks of two-stage clock nets by walking the clock network back from them
     int high_fanout_threshold;
     float high_fanout_max_slope;
+    float high_fanout_batch_criticality; ///<Sinks of high fanout nets up to this criticality are routed in spatial batches (negative: off)
     int router_debug_net;
     int router_debug_sink_rr;
     int router_debug_iteration;
     e_router_lookahead lookahead_type;
+    bool lookahead_correction; ///<Scale the lookahead by factors learnt from the costs of the paths found in each iteration
+    bool global_route_guides;  ///<Bound the connections of the first iteration by the corridors of a coarse global routing
     int max_convergence_count;
     int route_verbosity;
     float reconvergence_cpd_threshold;
     e_router_initial_timing initial_timing;
     bool update_lower_bound_delays;
+    int hold_full_update_interval;
+    float hold_prune_slack;
 
     std::string first_iteration_timing_report_file;
     bool strict_checks;
 
     std::string write_router_lookahead;
     std::string read_router_lookahead;
+    ///@brief Directory of the on-disk router lookahead / placement delay model cache (disabled if empty)
+    std::string timing_model_cache_dir;
 
     std::string write_intra_cluster_router_lookahead;
     std::string read_intra_cluster_router_lookahead;
 
+    ///@brief Router checkpoint written every route_checkpoint_interval routing iterations (disabled if empty)
+    std::string write_route_checkpoint;
+    int route_checkpoint_interval;
+    ///@brief Router checkpoint to resume routing from (disabled if empty)
+    std::string route_resume;
+
+    ///@brief JSON file of the per-iteration router phase profile (disabled if empty, see router_phase_profiling.h)
+    std::string router_phase_profile;
+    bool router_phase_profile_hw_counters;
+
     e_heap_type router_heap;
     bool exit_after_first_routing_iteration;
 
+    ///@brief Placement of the large RR graph arrays (see vtr::set_large_array_policy())
+    vtr::e_huge_pages rr_graph_huge_pages;
+    bool rr_graph_numa_interleave;
+
     e_check_route_option check_route;
     e_timing_update_type timing_update_type;
 
@@ -1328,6 +1437,12 @@ struct t_router_opts {
     e_rr_node_reorder_algorithm reorder_rr_graph_nodes_algorithm = DONT_REORDER;
     int reorder_rr_graph_nodes_threshold = 0;
     int reorder_rr_graph_nodes_seed = 1;
+
+    // Compress the RR graph edges once the graph is built, to reduce memory usage
+    e_rr_edge_compression compress_rr_graph_edges = e_rr_edge_compression::NONE;
+
+    // Reuse the wire delays of the rr indexed data of the previous rr graph built (for another channel width)
+    bool reuse_rr_indexed_data_delays = false;
 };
 
 struct t_analysis_opts {
@@ -1337,6 +1452,7 @@ struct t_analysis_opts {
     bool gen_post_implementation_merged_netlist;
     e_post_synth_netlist_unconn_handling post_synth_netlist_unconn_input_handling;
     e_post_synth_netlist_unconn_handling post_synth_netlist_unconn_output_handling;
+    bool post_synth_netlist_compress; ///<Write the post-implementation netlists and SDF gzip compressed (.gz)
 
     int timing_report_npaths;
     e_timing_report_detail timing_report_detail;
@@ -1364,6 +1480,8 @@ struct t_noc_opts {
     int noc_sat_routing_congestion_weighting;      ///<controls the importance of reducing the number of congested NoC links in SAT routing [0-inf)
     int noc_sat_routing_num_workers;               ///<the number of parallel worker threads that the SAT solver can use to explore the solution space
     bool noc_sat_routing_log_search_progress;      ///<indicates whether the detailed log of the SAT solver's search progress in printed
+    bool noc_reject_deadlocking_moves;             ///<indicates whether the placer rejects moves whose traffic flow routes could deadlock (cyclic channel dependencies)
+    int noc_initial_placement_restarts;            ///<the number of independent runs of the initial NoC placement annealer, which can run in parallel; the best placement found is kept
     std::string noc_placement_file_name;           ///<is the name of the output file that contains the NoC placement information
 };
 
@@ -1574,35 +1692,68 @@ constexpr bool is_chan(e_rr_type type) { return (type == CHANX || type == CHANY)
 constexpr bool is_src_sink(e_rr_type type) { return (type == SOURCE || type == SINK); }
 
 /**
- * @brief Extra information about each rr_node needed only during routing
+ * @brief Search state of each rr_node during a single connection search
  *        (i.e. during the maze expansion).
  *
+ * Every search (e.g. each thread of the parallel router) keeps its own copy,
+ * which it resets through its list of modified nodes once done.
+ *
  *   @param prev_edge  ID of the edge (globally unique edge ID in the RR Graph)
  *                     that was used to reach this node from the previous node.
  *                     If there is no predecessor, prev_edge = NO_PREVIOUS.
- *   @param acc_cost   Accumulated cost term from previous Pathfinder iterations.
  *   @param path_cost  Total cost of the path up to and including this node +
  *                     the expected cost to the target if the timing_driven router
  *                     is being used.
  *   @param backward_path_cost  Total cost of the path up to and including this
  *                     node.
- *   @param occ        The current occupancy of the associated rr node
  */
 struct t_rr_node_route_inf {
-    RREdgeId prev_edge;
+    RREdgeId prev_edge = RREdgeId::INVALID();
 
-    float acc_cost;
-    float path_cost;
-    float backward_path_cost;
+    float path_cost = std::numeric_limits<float>::infinity();
+    float backward_path_cost = std::numeric_limits<float>::infinity();
+};
+
+/**
+ * @brief Congestion state of each rr_node, shared by all connection searches
+ *        and updated between Pathfinder iterations.
+ *
+ * Kept apart from t_rr_node_route_inf so the (read-mostly) congestion state
+ * stays dense and is not interleaved with the per-search state written on
+ * every heap push.
+ *
+ * The occupancy is atomic: the parallel router may rip up and add routing
+ * through the same node from several threads at once (see
+ * pathfinder_update_single_node_occupancy()). acc_cost is only written between
+ * routing iterations, so it stays a plain float. Relaxed loads and stores
+ * cost the same as plain ones, so the serial router is unaffected.
+ *
+ *   @param acc_cost   Accumulated cost term from previous Pathfinder iterations.
+ *   @param occ        The current occupancy of the associated rr node
+ */
+struct t_rr_node_cong_inf {
+    float acc_cost = 1.;
+
+    t_rr_node_cong_inf() = default;
+    t_rr_node_cong_inf(const t_rr_node_cong_inf& other)
+        : acc_cost(other.acc_cost)
+        , occ_(other.occ()) {}
+    t_rr_node_cong_inf& operator=(const t_rr_node_cong_inf& other) {
+        acc_cost = other.acc_cost;
+        set_occ(other.occ());
+        return *this;
+    }
 
   public: //Accessors
-    short occ() const { return occ_; }
+    short occ() const { return occ_.load(std::memory_order_relaxed); }
 
   public: //Mutators
-    void set_occ(int new_occ) { occ_ = new_occ; }
+    void set_occ(int new_occ) { occ_.store(new_occ, std::memory_order_relaxed); }
+    ///@brief Atomically add delta to the occupancy and return the new occupancy
+    int add_occ(int delta) { return occ_.fetch_add(delta, std::memory_order_relaxed) + delta; }
 
   private: //Data
-    short occ_ = 0;
+    std::atomic<short> occ_ = 0;
 };
 
 /**
@@ -1694,11 +1845,12 @@ struct t_TokenPair {
     int Enum;
 };
 
-struct t_lb_type_rr_node; /* Defined in pack_types.h */
+struct t_lb_type_rr_graph; /* Defined in pack_types.h */
 
 /// @brief Stores settings for VPR server mode
 struct t_server_opts {
     bool is_server_mode_enabled = false;
+    bool is_daemon_mode_enabled = false;
     int port_num = -1;
 };
 
@@ -1717,7 +1869,7 @@ struct t_vpr_setup {
     t_noc_opts NocOpts;             ///<Options for the NoC
     t_server_opts ServerOpts;       ///<Server options
     t_det_routing_arch RoutingArch; ///<routing architecture
-    std::vector<t_lb_type_rr_node>* PackerRRGraph;
+    t_lb_type_rr_graph* PackerRRGraph;
     std::vector<t_segment_inf> Segments; ///<wires in routing architecture
     t_timing_inf Timing;                 ///<timing information
     float constant_net_delay;            ///<timing information when place and route not run
@@ -1725,13 +1877,18 @@ struct t_vpr_setup {
     int GraphPause;                      ///<user interactiveness graphics option
     bool SaveGraphics;                   ///<option to save graphical contents to pdf, png, or svg
     std::string GraphicsCommands;        ///<commands to control graphics settings
+    std::string SnapshotImagePrefix;     ///<prefix of the headless snapshot images (none saved if empty)
+    int SnapshotImageInterval;           ///<annealing temperatures / router iterations between checkpoint snapshot images
     t_power_opts PowerOpts;
     std::string device_layout;
     e_constant_net_method constant_net_method; ///<How constant nets should be handled
     e_clock_modeling clock_modeling;           ///<How clocks should be handled
     bool two_stage_clock_routing;              ///<How clocks should be routed in the presence of a dedicated clock network
     bool exit_before_pack;                     ///<Exits early before starting packing (useful for collecting statistics without running/loading any stages)
+    bool overlap_device_creation;              ///<Creates the device (and the rr graph and router lookahead) while the packing loads, when possible
+    bool report_memory_usage;                  ///<Prints the memory held by the main data structures after each stage
     unsigned int num_workers;                  ///Maximum number of worker threads (determined from an env var or cmdline option)
+    bool reuse_rr_graph = false;               ///<Keeps an rr graph already built at the same channel width (e.g. by a previous VPR daemon job) instead of rebuilding it
 };
 
 class RouteStatus {
@@ -0,0 +1,376 @@
+/**
+ * @file
+ * @brief FPGA Interchange Physical Netlist Writer
+ *
+ * The physical netlist is written in three steps:
+ *  - the strings of the sites, site types, site pins, cells and nets are interned up front
+ *    (the device file is read back to name the sites of the used tile locations);
+ *  - the site pins of every net are resolved from its route tree, in parallel, as the
+ *    string table is then read only;
+ *  - the message is filled from the resolved nets (a capnp message builder can't be
+ *    shared between threads) and streamed to the file.
+ */
+
+#include "write_interchange_physical_netlist.h"
+
+#include "vtr_error.h"
+#include "vpr_error.h"
+
+#ifdef VTR_ENABLE_CAPNPROTO
+
+#    include <cstdint>
+#    include <tuple>
+#    include <unordered_map>
+#    include <unordered_set>
+#    include <vector>
+
+#    include "capnp/message.h"
+#    include "DeviceResources.capnp.h"
+#    include "PhysicalNetlist.capnp.h"
+#    include "interchange_message.h"
+
+#    include "vtr_assert.h"
+#    include "vtr_log.h"
+#    include "vtr_time.h"
+
+#    include "globals.h"
+#    include "physical_types_util.h"
+#    include "vpr_types.h"
+
+#    ifdef VPR_USE_TBB
+#        include <tbb/parallel_for_each.h>
+#    endif
+
+namespace {
+
+///@brief The string table of the physical netlist
+class StringTable {
+  public:
+    ///@brief Returns the index of str, adding it to the table if needed
+    uint32_t intern(const std::string& str) {
+        auto result = indices_.emplace(str, strings_.size());
+        if (result.second) {
+            strings_.push_back(str);
+        }
+        return result.first->second;
+    }
+
+    const std::vector<std::string>& strings() const { return strings_; }
+
+  private:
+    std::unordered_map<std::string, uint32_t> indices_;
+    std::vector<std::string> strings_;
+};
+
+///@brief A device site used by the implementation (as string indices)
+struct t_site {
+    uint32_t name;
+    uint32_t type;
+};
+
+///@brief A site pin (as string indices)
+struct t_site_pin {
+    uint32_t site;
+    uint32_t pin;
+};
+
+///@brief A net resolved from its route tree
+struct t_phys_net {
+    bool routed = false;
+    std::vector<t_site_pin> sources; ///<Driver site pins
+    std::vector<t_site_pin> stubs;   ///<Sink site pins
+};
+
+/**
+ * @brief Returns the device site of each used (sub tile) location of the grid
+ *
+ * A VPR tile at (x, y) is the device tile at (col, row) = (x - 1, y - 1), and its sub tiles
+ * are (in order) the site types of the tile type which VPR took from the device, so sub tile
+ * i is the site of the tile whose type is the i-th taken site type.
+ */
+std::unordered_map<t_pl_loc, t_site> find_used_sites(DeviceResources::Device::Reader device,
+                                                     const std::unordered_set<t_pl_loc>& used_locs,
+                                                     StringTable& strings) {
+    const DeviceGrid& grid = g_vpr_ctx.device().grid;
+
+    auto device_strs = device.getStrList();
+    auto tile_types = device.getTileTypeList();
+    auto site_types = device.getSiteTypeList();
+
+    std::unordered_map<t_pl_loc, t_site> sites;
+    for (auto tile : device.getTileList()) {
+        int x = tile.getCol() + 1;
+        int y = tile.getRow() + 1;
+        if (x >= int(grid.width()) || y >= int(grid.height())) {
+            continue;
+        }
+
+        t_physical_tile_loc tile_loc(x, y, 0);
+        t_physical_tile_type_ptr type = grid.get_physical_type(tile_loc);
+        auto tile_type = tile_types[tile.getType()];
+        if (grid.get_width_offset(tile_loc) != 0 || grid.get_height_offset(tile_loc) != 0
+            || std::string(type->name) != device_strs[tile_type.getName()].cStr()) {
+            //Not the VPR tile of this device tile (e.g. the constant source tile)
+            continue;
+        }
+
+        auto site_types_in_tile = tile_type.getSiteTypes();
+        size_t site_type_in_tile = 0;
+        for (const t_sub_tile& sub_tile : type->sub_tiles) {
+            //The next site type of the tile type with the name of the sub tile
+            while (site_type_in_tile < site_types_in_tile.size()
+                   && std::string(sub_tile.name) != device_strs[site_types[site_types_in_tile[site_type_in_tile].getPrimaryType()].getName()].cStr()) {
+                ++site_type_in_tile;
+            }
+            if (site_type_in_tile == site_types_in_tile.size()) {
+                break;
+            }
+
+            t_pl_loc loc(x, y, sub_tile.capacity.low, 0);
+            if (used_locs.count(loc)) {
+                for (auto site : tile.getSites()) {
+                    if (site.getType() == site_type_in_tile) {
+                        sites[loc] = {strings.intern(device_strs[site.getName()].cStr()), strings.intern(sub_tile.name)};
+                        break;
+                    }
+                }
+            }
+            ++site_type_in_tile;
+        }
+    }
+
+    return sites;
+}
+
+///@brief Finds the site pin of the tile pin (IPIN or OPIN) rr_node, and returns false if it is not on a used site
+bool find_site_pin(RRNodeId rr_node,
+                   const std::unordered_map<t_pl_loc, t_site>& sites,
+                   const std::unordered_map<const t_physical_tile_port*, uint32_t>& pin_names,
+                   t_site_pin& site_pin) {
+    const DeviceContext& device_ctx = g_vpr_ctx.device();
+    const RRGraphView& rr_graph = device_ctx.rr_graph;
+
+    t_physical_tile_loc tile_loc(rr_graph.node_xlow(rr_node), rr_graph.node_ylow(rr_node), rr_graph.node_layer(rr_node));
+    t_physical_tile_type_ptr type = device_ctx.grid.get_physical_type(tile_loc);
+    int pin = rr_graph.node_pin_num(rr_node);
+    if (!is_pin_on_tile(type, pin)) {
+        //An intra-cluster pin (flat routing)
+        return false;
+    }
+
+    int capacity_loc, sub_tile_pin;
+    std::tie(capacity_loc, sub_tile_pin) = get_capacity_location_from_physical_pin(type, pin);
+
+    t_pl_loc loc(tile_loc.x - device_ctx.grid.get_width_offset(tile_loc),
+                 tile_loc.y - device_ctx.grid.get_height_offset(tile_loc),
+                 capacity_loc,
+                 tile_loc.layer_num);
+    auto site_iter = sites.find(loc);
+    if (site_iter == sites.end()) {
+        return false;
+    }
+
+    const t_sub_tile* sub_tile = std::get<0>(get_sub_tile_from_pin_physical_num(type, pin));
+    const t_physical_tile_port* port = get_port_by_pin(sub_tile, sub_tile_pin);
+    VTR_ASSERT(port != nullptr);
+
+    site_pin = {site_iter->second.name, pin_names.at(port)};
+    return true;
+}
+
+///@brief Resolves the site pins of the net from its route tree
+void resolve_net(ParentNetId net_id,
+                 const std::unordered_map<t_pl_loc, t_site>& sites,
+                 const std::unordered_map<const t_physical_tile_port*, uint32_t>& pin_names,
+                 t_phys_net& phys_net) {
+    const RRGraphView& rr_graph = g_vpr_ctx.device().rr_graph;
+    const auto& tree = g_vpr_ctx.routing().route_trees[net_id];
+    if (!tree) {
+        return;
+    }
+
+    phys_net.routed = true;
+    for (const RouteTreeNode& rt_node : tree->all_nodes()) {
+        e_rr_type rr_type = rr_graph.node_type(rt_node.inode);
+        if (rr_type != OPIN && rr_type != IPIN) {
+            continue;
+        }
+
+        t_site_pin site_pin;
+        if (find_site_pin(rt_node.inode, sites, pin_names, site_pin)) {
+            (rr_type == OPIN ? phys_net.sources : phys_net.stubs).push_back(site_pin);
+        }
+    }
+}
+
+///@brief Returns the BEL of the leaf pb: its parent pb, without the suffix added when the BEL is named after its site type
+std::string leaf_bel_name(const t_pb* pb, const std::string& site_type) {
+    std::string bel = pb->parent_pb->pb_graph_node->pb_type->name;
+    if (bel == site_type + "_bel") {
+        bel = site_type;
+    }
+    return bel;
+}
+
+void fill_site_pins(::capnp::List<PhysicalNetlist::PhysNetlist::RouteBranch>::Builder branches,
+                    const std::vector<t_site_pin>& site_pins) {
+    for (size_t i = 0; i < site_pins.size(); ++i) {
+        auto site_pin = branches[i].getRouteSegment().initSitePin();
+        site_pin.setSite(site_pins[i].site);
+        site_pin.setPin(site_pins[i].pin);
+    }
+}
+
+} // namespace
+
+#endif // VTR_ENABLE_CAPNPROTO
+
+void write_interchange_physical_netlist(const std::string& file,
+                                        const std::string& device_file,
+                                        const Netlist<>& net_list,
+                                        const t_arch& arch,
+                                        bool compress) {
+#ifdef VTR_ENABLE_CAPNPROTO
+    vtr::ScopedStartFinishTimer timer("Writing FPGA interchange physical netlist");
+
+    const DeviceContext& device_ctx = g_vpr_ctx.device();
+    const AtomContext& atom_ctx = g_vpr_ctx.atom();
+    const ClusteringContext& cluster_ctx = g_vpr_ctx.clustering();
+    const auto& block_locs = g_vpr_ctx.placement().block_locs();
+
+    StringTable strings;
+
+    //The sites of the placed clusters
+    std::unordered_set<t_pl_loc> used_locs;
+    for (ClusterBlockId blk_id : cluster_ctx.clb_nlist.blocks()) {
+        used_locs.insert(block_locs[blk_id].loc);
+    }
+
+    ::capnp::MallocMessageBuilder builder;
+    auto phys_netlist = builder.initRoot<PhysicalNetlist::PhysNetlist>();
+
+    std::unordered_map<t_pl_loc, t_site> sites;
+    try {
+        InterchangeMessage device_message(device_file);
+        auto device = device_message.getRoot<DeviceResources::Device>();
+        phys_netlist.setPart(device.getName());
+        sites = find_used_sites(device, used_locs, strings);
+    } catch (vtr::VtrError& e) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER, "Failed to read the interchange device '%s': %s", device_file.c_str(), e.what());
+    }
+
+    std::unordered_map<const t_physical_tile_port*, uint32_t> pin_names;
+    for (const t_physical_tile_type& type : device_ctx.physical_tile_types) {
+        for (const t_sub_tile& sub_tile : type.sub_tiles) {
+            for (const t_physical_tile_port& port : sub_tile.ports) {
+                pin_names[&port] = strings.intern(port.name);
+            }
+        }
+    }
+
+    //The placement of the cells
+    std::vector<AtomBlockId> placed_atoms;
+    for (AtomBlockId blk_id : atom_ctx.nlist.blocks()) {
+        ClusterBlockId clb_id = atom_ctx.lookup.atom_clb(blk_id);
+        const t_pb* pb = atom_ctx.lookup.atom_pb(blk_id);
+        if (clb_id && pb && pb->parent_pb && sites.count(block_locs[clb_id].loc)) {
+            placed_atoms.push_back(blk_id);
+        }
+    }
+
+    auto placements = phys_netlist.initPlacements(placed_atoms.size());
+    for (size_t i = 0; i < placed_atoms.size(); ++i) {
+        AtomBlockId blk_id = placed_atoms[i];
+        const t_site& site = sites.at(block_locs[atom_ctx.lookup.atom_clb(blk_id)].loc);
+
+        auto placement = placements[i];
+        placement.setCellName(strings.intern(atom_ctx.nlist.block_name(blk_id)));
+        placement.setType(strings.intern(atom_ctx.nlist.block_model(blk_id)->name));
+        placement.setSite(site.name);
+        placement.setBel(strings.intern(leaf_bel_name(atom_ctx.lookup.atom_pb(blk_id), strings.strings()[site.type])));
+    }
+
+    std::vector<t_pl_loc> site_locs;
+    for (ClusterBlockId blk_id : cluster_ctx.clb_nlist.blocks()) {
+        if (sites.count(block_locs[blk_id].loc)) {
+            site_locs.push_back(block_locs[blk_id].loc);
+        }
+    }
+
+    auto site_insts = phys_netlist.initSiteInsts(site_locs.size());
+    for (size_t i = 0; i < site_locs.size(); ++i) {
+        const t_site& site = sites.at(site_locs[i]);
+        site_insts[i].setSite(site.name);
+        site_insts[i].setType(site.type);
+    }
+
+    //The routing of the nets, resolved in parallel
+    std::vector<uint32_t> net_names(net_list.nets().size());
+    for (ParentNetId net_id : net_list.nets()) {
+        net_names[size_t(net_id)] = strings.intern(net_list.net_name(net_id));
+    }
+
+    std::vector<t_phys_net> phys_nets(net_list.nets().size());
+    auto resolve = [&](ParentNetId net_id) {
+        resolve_net(net_id, sites, pin_names, phys_nets[size_t(net_id)]);
+    };
+#    ifdef VPR_USE_TBB
+    tbb::parallel_for_each(net_list.nets().begin(), net_list.nets().end(), resolve);
+#    else
+    for (ParentNetId net_id : net_list.nets()) {
+        resolve(net_id);
+    }
+#    endif
+
+    size_t num_routed_nets = 0;
+    for (const t_phys_net& phys_net : phys_nets) {
+        num_routed_nets += phys_net.routed;
+    }
+
+    auto nets = phys_netlist.initPhysNets(num_routed_nets);
+    size_t inet = 0;
+    for (ParentNetId net_id : net_list.nets()) {
+        const t_phys_net& phys_net = phys_nets[size_t(net_id)];
+        if (!phys_net.routed) {
+            continue;
+        }
+
+        auto net = nets[inet++];
+        net.setName(net_names[size_t(net_id)]);
+
+        const std::string& net_name = net_list.net_name(net_id);
+        if (net_name == arch.gnd_net) {
+            net.setType(PhysicalNetlist::PhysNetlist::NetType::GND);
+        } else if (net_name == arch.vcc_net) {
+            net.setType(PhysicalNetlist::PhysNetlist::NetType::VCC);
+        }
+
+        fill_site_pins(net.initSources(phys_net.sources.size()), phys_net.sources);
+        fill_site_pins(net.initStubs(phys_net.stubs.size()), phys_net.stubs);
+    }
+
+    const std::vector<std::string>& string_list = strings.strings();
+    auto str_list = phys_netlist.initStrList(string_list.size());
+    for (size_t i = 0; i < string_list.size(); ++i) {
+        str_list.set(i, ::capnp::Text::Reader(string_list[i].data(), string_list[i].size()));
+    }
+
+    VTR_LOG("Wrote %zu cell placements, %zu sites and %zu nets\n", placed_atoms.size(), site_locs.size(), num_routed_nets);
+
+    try {
+        write_interchange_message(file, builder, compress);
+    } catch (vtr::VtrError& e) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER, "Failed to write the interchange physical netlist '%s': %s", file.c_str(), e.what());
+    }
+
+#else // VTR_ENABLE_CAPNPROTO
+
+    (void)file;
+    (void)device_file;
+    (void)net_list;
+    (void)arch;
+    (void)compress;
+    VPR_FATAL_ERROR(VPR_ERROR_OTHER, "Unable to write the interchange physical netlist with CAPNPROTO disabled");
+
+#endif // VTR_ENABLE_CAPNPROTO
+}
@@ -0,0 +1,38 @@
+#ifndef WRITE_INTERCHANGE_PHYSICAL_NETLIST_H
+#define WRITE_INTERCHANGE_PHYSICAL_NETLIST_H
+
+/**
+ * @file
+ * @brief FPGA Interchange Physical Netlist Writer
+ *
+ * Writes the implementation of a circuit loaded from an FPGA Interchange device
+ * (and logical netlist) as an FPGA Interchange physical netlist, for downstream
+ * tools (e.g. bitstream generation) to pick up:
+ *  - the placement of every cell (atom) on its device site and BEL, and the site
+ *    instance of every used site;
+ *  - every routed net, from the site pin of its driver to the site pins of its sinks.
+ *
+ * The VPR routing resource graph of an interchange device is not (yet) built from
+ * the device wires and PIPs, so the route trees can't be exported PIP by PIP: each
+ * net is written as its source site pin and a stub per sink site pin, for the
+ * downstream router to complete.
+ *
+ * The nets are resolved from their route trees in parallel, and the message is
+ * streamed to the file (gzip compressed if requested, as interchange files usually are).
+ *
+ * Requires VPR to be built with Cap'n Proto support.
+ */
+
+#include <string>
+
+#include "netlist.h"
+#include "physical_types.h"
+
+///@brief Write the placement and routing of net_list to the physical netlist file of the device_file (interchange) device
+void write_interchange_physical_netlist(const std::string& file,
+                                        const std::string& device_file,
+                                        const Netlist<>& net_list,
+                                        const t_arch& arch,
+                                        bool compress);
+
+#endif /* WRITE_INTERCHANGE_PHYSICAL_NETLIST_H */
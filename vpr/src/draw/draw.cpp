@@ -58,6 +58,7 @@
 #include "manual_moves.h"
 #include "draw_noc.h"
 #include "draw_floorplanning.h"
+#include "draw_spatial_index.h"
 
 #include "move_utils.h"
 #include "ui_setup.h"
@@ -90,6 +91,10 @@
 #    include "place_macro.h"
 #    include "buttons.h"
 #    include "draw_rr.h"
+
+#    ifndef NO_SERVER
+#        include "serverupdate.h"
+#    endif /* NO_SERVER */
 /****************************** Define Macros *******************************/
 
 #    define DEFAULT_RR_NODE_COLOR ezgl::BLACK
@@ -401,6 +406,9 @@ void update_screen(ScreenUpdatePriority priority, const char* msg, enum pic_type
      * continue.  Saves the pic_on_screen_val to allow pan and zoom redraws. */
     t_draw_state* draw_state = get_draw_state_vars();
 
+    /* The flow calls this whenever it changed the routing: pans and zooms meanwhile reuse the index */
+    invalidate_draw_routing_index();
+
     if (!draw_state->show_graphics)
         ezgl::set_disable_event_loop(true);
     else
@@ -477,9 +485,23 @@ void update_screen(ScreenUpdatePriority priority, const char* msg, enum pic_type
             draw_state->forced_pause = false; //Reset pause flag
         }
 
+#ifndef NO_SERVER
+        // the flow is paused in the main loop: server critical path queries can run in the background meanwhile
+        server::TaskResolver& task_resolver = g_vpr_ctx.mutable_server().task_resolver;
+        task_resolver.allow_background_tasks();
+        if (g_vpr_ctx.server().gate_io.is_running()) {
+            server::schedule_update(&application);
+        }
+#endif /* NO_SERVER */
+
         application.run(init_setup, act_on_mouse_press, act_on_mouse_move,
                         act_on_key_press);
 
+#ifndef NO_SERVER
+        // the flow resumes and may change the timing state
+        task_resolver.stop_background_tasks();
+#endif /* NO_SERVER */
+
         if (!draw_state->graphics_commands.empty()) {
             run_graphics_commands(draw_state->graphics_commands);
         }
@@ -586,6 +608,9 @@ void init_draw_coords(float clb_width, const BlkLocRegistry& blk_loc_registry) {
         && draw_state->graphics_commands.empty())
         return; //do not initialize only if --disp off and --save_graphics off
 
+    /* The RR graph (or the tile coordinates) may have changed */
+    invalidate_draw_spatial_index();
+
     /* Each time routing is on screen, need to reallocate the color of each *
      * rr_node, as the number of rr_nodes may change.						*/
     if (rr_graph.num_nodes() != 0) {
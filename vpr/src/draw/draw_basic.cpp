@@ -32,6 +32,7 @@
 #include "draw_mux.h"
 #include "read_xml_arch_file.h"
 #include "draw_global.h"
+#include "draw_spatial_index.h"
 #include "intra_logic_block.h"
 #include "move_utils.h"
 #include "route_export.h"
@@ -110,11 +111,23 @@ void drawplace(ezgl::renderer* g) {
 
     int total_num_layers = device_ctx.grid.get_num_layers();
 
+    /* Only visit the visible tiles, and the tiles left of/below them whose blocks may extend on screen */
+    int max_tile_width = 1;
+    int max_tile_height = 1;
+    for (const auto& type : device_ctx.physical_tile_types) {
+        max_tile_width = std::max(max_tile_width, type.width);
+        max_tile_height = std::max(max_tile_height, type.height);
+    }
+    int visible_xmin, visible_ymin, visible_xmax, visible_ymax;
+    get_visible_tile_range(g, visible_xmin, visible_ymin, visible_xmax, visible_ymax);
+    visible_xmin = std::max(visible_xmin - (max_tile_width - 1), 0);
+    visible_ymin = std::max(visible_ymin - (max_tile_height - 1), 0);
+
     g->set_line_width(0);
     for (int layer_num = 0; layer_num < total_num_layers; layer_num++) {
         if (draw_state->draw_layer_display[layer_num].visible) {
-            for (int i = 0; i < (int)device_ctx.grid.width(); i++) {
-                for (int j = 0; j < (int)device_ctx.grid.height(); j++) {
+            for (int i = visible_xmin; i <= visible_xmax; i++) {
+                for (int j = visible_ymin; j <= visible_ymax; j++) {
                     /* Only the first block of a group should control drawing */
                     const auto& type = device_ctx.grid.get_physical_type({i, j, layer_num});
                     int width_offset = device_ctx.grid.get_width_offset({i, j, layer_num});
@@ -303,7 +316,7 @@ void draw_congestion(ezgl::renderer* g) {
     float max_congestion_ratio = min_congestion_ratio;
     auto congested_rr_nodes = collect_congested_rr_nodes();
     for (RRNodeId inode : congested_rr_nodes) {
-        short occ = route_ctx.rr_node_route_inf[inode].occ();
+        short occ = route_ctx.rr_node_cong_inf[inode].occ();
         short capacity = rr_graph.node_capacity(inode);
 
         float congestion_ratio = float(occ) / capacity;
@@ -325,10 +338,10 @@ void draw_congestion(ezgl::renderer* g) {
     //Sort the nodes in ascending order of value for drawing, this ensures high
     //valued nodes are not overdrawn by lower value ones (e.g-> when zoomed-out far)
     auto cmp_ascending_acc_cost = [&](RRNodeId lhs_node, RRNodeId rhs_node) {
-        short lhs_occ = route_ctx.rr_node_route_inf[lhs_node].occ();
+        short lhs_occ = route_ctx.rr_node_cong_inf[lhs_node].occ();
         short lhs_capacity = rr_graph.node_capacity(lhs_node);
 
-        short rhs_occ = route_ctx.rr_node_route_inf[rhs_node].occ();
+        short rhs_occ = route_ctx.rr_node_cong_inf[rhs_node].occ();
         short rhs_capacity = rr_graph.node_capacity(rhs_node);
 
         float lhs_cong_ratio = float(lhs_occ) / lhs_capacity;
@@ -366,7 +379,7 @@ void draw_congestion(ezgl::renderer* g) {
         int transparency_factor = get_rr_node_transparency(inode);
         if (!draw_state->draw_layer_display[layer_num].visible)
             continue;
-        short occ = route_ctx.rr_node_route_inf[inode].occ();
+        short occ = route_ctx.rr_node_cong_inf[inode].occ();
         short capacity = rr_graph.node_capacity(inode);
 
         float congestion_ratio = float(occ) / capacity;
@@ -574,11 +587,20 @@ void drawroute(enum e_draw_net_type draw_net_type, ezgl::renderer* g) {
 
     /* Now draw each net, one by one.      */
 
+    /* When zoomed out too far to tell wires apart, show how much of the routing is used instead */
+    if (draw_net_type == ALL_NETS && is_routing_level_of_detail_reduced(g)) {
+        draw_routing_density(g);
+        draw_net_type = HIGHLIGHTED;
+    }
+
     for (auto net_id : cluster_ctx.clb_nlist.nets()) {
         if (draw_net_type == HIGHLIGHTED
             && draw_state->net_color[net_id] == ezgl::BLACK)
             continue;
 
+        if (!is_routed_net_visible((ParentNetId&)net_id, g))
+            continue;
+
         draw_routed_net((ParentNetId&)net_id, g);
     } /* End for (each net) */
 }
@@ -862,11 +884,14 @@ void draw_routing_util(ezgl::renderer* g) {
     t_draw_coords* draw_coords = get_draw_coords_vars();
     auto& device_ctx = g_vpr_ctx.device();
 
-    auto chanx_usage = calculate_routing_usage(CHANX, draw_state->is_flat, false);
-    auto chany_usage = calculate_routing_usage(CHANY, draw_state->is_flat, false);
+    RoutingCongestionMap congestion_map(device_ctx.rr_graph, device_ctx.grid);
+    congestion_map.update(g_vpr_ctx.routing().rr_node_cong_inf, routing_util_visible_layers(false));
+
+    const auto& chanx_usage = congestion_map.usage(CHANX);
+    const auto& chany_usage = congestion_map.usage(CHANY);
 
-    auto chanx_avail = calculate_routing_avail(CHANX);
-    auto chany_avail = calculate_routing_avail(CHANY);
+    const auto& chanx_avail = congestion_map.avail(CHANX);
+    const auto& chany_avail = congestion_map.avail(CHANY);
 
     float min_util = 0.;
     float max_util = -std::numeric_limits<float>::infinity();
@@ -31,6 +31,7 @@
 #include "draw_mux.h"
 #include "read_xml_arch_file.h"
 #include "draw_global.h"
+#include "draw_spatial_index.h"
 
 #include "move_utils.h"
 
@@ -80,8 +81,16 @@ void draw_rr(ezgl::renderer* g) {
 
     g->set_line_dash(ezgl::line_dash::none);
 
+    /* When zoomed out too far to tell wires apart, show how much of the routing is used instead */
+    if (is_routing_level_of_detail_reduced(g)) {
+        draw_routing_density(g);
+        drawroute(HIGHLIGHTED, g);
+        return;
+    }
+
+    /* Edges use the colors of the nodes at both ends, which may be off screen: set the colors of all nodes,
+     * but only draw the visible ones */
     for (const RRNodeId inode : device_ctx.rr_graph.nodes()) {
-        int layer_num = rr_graph.node_layer(inode);
         int transparency_factor = get_rr_node_transparency(inode);
         if (!draw_state->draw_rr_node[inode].node_highlighted) {
             /* If not highlighted node, assign color based on type. */
@@ -108,7 +117,10 @@ void draw_rr(ezgl::renderer* g) {
         }
 
         draw_state->draw_rr_node[inode].color.alpha = transparency_factor;
+    }
 
+    for (const RRNodeId inode : get_visible_rr_nodes(g)) {
+        int layer_num = rr_graph.node_layer(inode);
         if (!draw_state->draw_layer_display[layer_num].visible)
             continue; // skip drawing if layer is not visible
 
@@ -0,0 +1,271 @@
+#ifndef NO_GRAPHICS
+
+#    include "draw_spatial_index.h"
+
+#    include <algorithm>
+#    include <cmath>
+
+#    include "draw.h"
+#    include "draw_global.h"
+#    include "globals.h"
+#    include "vtr_color_map.h"
+#    include "vtr_ndmatrix.h"
+#    include "vtr_vector.h"
+
+namespace {
+
+/** A range of tiles, inclusive */
+struct t_tile_region {
+    int xmin = 0;
+    int ymin = 0;
+    int xmax = -1;
+    int ymax = -1;
+
+    bool empty() const { return xmin > xmax || ymin > ymax; }
+
+    bool intersects(const t_tile_region& other) const {
+        return !empty() && !other.empty()
+               && xmin <= other.xmax && other.xmin <= xmax
+               && ymin <= other.ymax && other.ymin <= ymax;
+    }
+
+    bool operator==(const t_tile_region& other) const {
+        return xmin == other.xmin && ymin == other.ymin && xmax == other.xmax && ymax == other.ymax;
+    }
+
+    void expand(int x, int y) {
+        if (empty()) {
+            xmin = xmax = x;
+            ymin = ymax = y;
+        } else {
+            xmin = std::min(xmin, x);
+            xmax = std::max(xmax, x);
+            ymin = std::min(ymin, y);
+            ymax = std::max(ymax, y);
+        }
+    }
+};
+
+struct t_draw_spatial_index {
+    // RR graph dependent
+    bool is_rr_index_valid = false;
+    vtr::NdMatrix<std::vector<RRNodeId>, 2> rr_node_bins; // [0..num_bins_x-1][0..num_bins_y-1]
+
+    t_tile_region visible_rr_nodes_region; // region visible_rr_nodes were found for
+    std::vector<RRNodeId> visible_rr_nodes;
+
+    // routing dependent
+    bool is_routing_index_valid = false;
+    vtr::vector<ParentNetId, t_tile_region> net_regions; // tiles spanned by the routing of each net (empty if unrouted)
+    vtr::NdMatrix<int, 2> num_wires;                     // [0..grid.width()-1][0..grid.height()-1] wires spanning each tile
+    vtr::NdMatrix<int, 2> num_used_wires;                // same, but used by a net only
+};
+
+t_draw_spatial_index draw_index;
+
+} // namespace
+
+/** Tile (column or row) of a world coordinate, given the (ascending) world coordinates of the tiles */
+static int world_to_tile(const float* tile_coords, int num_tiles, double coord) {
+    int tile = int(std::upper_bound(tile_coords, tile_coords + num_tiles, float(coord)) - tile_coords) - 1;
+    return std::max(0, std::min(tile, num_tiles - 1));
+}
+
+/** Tiles of the visible world, grown by one tile on each side */
+static t_tile_region get_visible_tiles(ezgl::renderer* g) {
+    const t_draw_coords* draw_coords = get_draw_coords_vars();
+    const auto& grid = g_vpr_ctx.device().grid;
+    const int width = grid.width();
+    const int height = grid.height();
+
+    ezgl::rectangle world = g->get_visible_world();
+
+    t_tile_region region;
+    region.xmin = std::max(world_to_tile(draw_coords->tile_x, width, world.left()) - 1, 0);
+    region.xmax = std::min(world_to_tile(draw_coords->tile_x, width, world.right()) + 1, width - 1);
+    region.ymin = std::max(world_to_tile(draw_coords->tile_y, height, world.bottom()) - 1, 0);
+    region.ymax = std::min(world_to_tile(draw_coords->tile_y, height, world.top()) + 1, height - 1);
+    return region;
+}
+
+static void build_rr_index() {
+    const auto& rr_graph = g_vpr_ctx.device().rr_graph;
+    const auto& grid = g_vpr_ctx.device().grid;
+
+    size_t num_bins_x = (grid.width() + DRAW_INDEX_BIN_TILES - 1) / DRAW_INDEX_BIN_TILES;
+    size_t num_bins_y = (grid.height() + DRAW_INDEX_BIN_TILES - 1) / DRAW_INDEX_BIN_TILES;
+    draw_index.rr_node_bins.resize({num_bins_x, num_bins_y}); // empty bins
+
+    // nodes are added in ascending order to each bin they overlap
+    for (RRNodeId inode : rr_graph.nodes()) {
+        int bin_xmin = rr_graph.node_xlow(inode) / DRAW_INDEX_BIN_TILES;
+        int bin_xmax = rr_graph.node_xhigh(inode) / DRAW_INDEX_BIN_TILES;
+        int bin_ymin = rr_graph.node_ylow(inode) / DRAW_INDEX_BIN_TILES;
+        int bin_ymax = rr_graph.node_yhigh(inode) / DRAW_INDEX_BIN_TILES;
+        for (int bin_x = bin_xmin; bin_x <= bin_xmax; bin_x++) {
+            for (int bin_y = bin_ymin; bin_y <= bin_ymax; bin_y++) {
+                draw_index.rr_node_bins[bin_x][bin_y].push_back(inode);
+            }
+        }
+    }
+
+    draw_index.visible_rr_nodes_region = t_tile_region();
+    draw_index.visible_rr_nodes.clear();
+    draw_index.is_rr_index_valid = true;
+}
+
+static void build_routing_index() {
+    const auto& rr_graph = g_vpr_ctx.device().rr_graph;
+    const auto& grid = g_vpr_ctx.device().grid;
+    const auto& route_ctx = g_vpr_ctx.routing();
+
+    draw_index.net_regions.clear();
+    draw_index.net_regions.resize(route_ctx.route_trees.size());
+    for (size_t inet = 0; inet < route_ctx.route_trees.size(); inet++) {
+        ParentNetId net_id(inet);
+        if (!route_ctx.route_trees[net_id]) {
+            continue;
+        }
+        t_tile_region& region = draw_index.net_regions[net_id];
+        for (const RouteTreeNode& rt_node : route_ctx.route_trees[net_id].value().all_nodes()) {
+            region.expand(rr_graph.node_xlow(rt_node.inode), rr_graph.node_ylow(rt_node.inode));
+            region.expand(rr_graph.node_xhigh(rt_node.inode), rr_graph.node_yhigh(rt_node.inode));
+        }
+    }
+
+    draw_index.num_wires.resize({grid.width(), grid.height()}, 0);
+    draw_index.num_used_wires.resize({grid.width(), grid.height()}, 0);
+    bool has_occupancy = route_ctx.rr_node_cong_inf.size() == rr_graph.num_nodes();
+    for (RRNodeId inode : rr_graph.nodes()) {
+        t_rr_type type = rr_graph.node_type(inode);
+        if (type != CHANX && type != CHANY) {
+            continue;
+        }
+        bool is_used = has_occupancy && route_ctx.rr_node_cong_inf[inode].occ() > 0;
+        for (int x = rr_graph.node_xlow(inode); x <= rr_graph.node_xhigh(inode); x++) {
+            for (int y = rr_graph.node_ylow(inode); y <= rr_graph.node_yhigh(inode); y++) {
+                draw_index.num_wires[x][y]++;
+                draw_index.num_used_wires[x][y] += is_used;
+            }
+        }
+    }
+
+    draw_index.is_routing_index_valid = true;
+}
+
+void get_visible_tile_range(ezgl::renderer* g, int& xmin, int& ymin, int& xmax, int& ymax) {
+    t_tile_region region = get_visible_tiles(g);
+    xmin = region.xmin;
+    ymin = region.ymin;
+    xmax = region.xmax;
+    ymax = region.ymax;
+}
+
+void invalidate_draw_spatial_index() {
+    draw_index.is_rr_index_valid = false;
+    draw_index.is_routing_index_valid = false;
+}
+
+void invalidate_draw_routing_index() {
+    draw_index.is_routing_index_valid = false;
+}
+
+const std::vector<RRNodeId>& get_visible_rr_nodes(ezgl::renderer* g) {
+    if (!draw_index.is_rr_index_valid) {
+        build_rr_index();
+    }
+
+    t_tile_region region = get_visible_tiles(g);
+    if (region == draw_index.visible_rr_nodes_region) {
+        return draw_index.visible_rr_nodes;
+    }
+
+    const auto& rr_graph = g_vpr_ctx.device().rr_graph;
+    std::vector<RRNodeId>& nodes = draw_index.visible_rr_nodes;
+    nodes.clear();
+    for (int bin_x = region.xmin / DRAW_INDEX_BIN_TILES; bin_x <= region.xmax / DRAW_INDEX_BIN_TILES; bin_x++) {
+        for (int bin_y = region.ymin / DRAW_INDEX_BIN_TILES; bin_y <= region.ymax / DRAW_INDEX_BIN_TILES; bin_y++) {
+            for (RRNodeId inode : draw_index.rr_node_bins[bin_x][bin_y]) {
+                t_tile_region node_region;
+                node_region.expand(rr_graph.node_xlow(inode), rr_graph.node_ylow(inode));
+                node_region.expand(rr_graph.node_xhigh(inode), rr_graph.node_yhigh(inode));
+                if (node_region.intersects(region)) {
+                    nodes.push_back(inode);
+                }
+            }
+        }
+    }
+
+    // nodes spanning several bins were found once per bin: keep the RR graph order, so that overlapping nodes are drawn as before
+    std::sort(nodes.begin(), nodes.end());
+    nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+
+    draw_index.visible_rr_nodes_region = region;
+    return nodes;
+}
+
+bool is_routed_net_visible(ParentNetId net_id, ezgl::renderer* g) {
+    if (!draw_index.is_routing_index_valid) {
+        build_routing_index();
+    }
+
+    if (size_t(net_id) >= draw_index.net_regions.size()) {
+        return true; // routed after the index was built: don't know
+    }
+    return draw_index.net_regions[net_id].intersects(get_visible_tiles(g));
+}
+
+bool is_routing_level_of_detail_reduced(ezgl::renderer* g) {
+    t_draw_coords* draw_coords = get_draw_coords_vars();
+
+    double world_width = g->get_visible_world().width();
+    if (world_width <= 0.) {
+        return false;
+    }
+    double pixels_per_world_unit = g->get_visible_screen().width() / world_width;
+    return draw_coords->get_tile_width() * pixels_per_world_unit < DRAW_LOD_MIN_TILE_PIXELS;
+}
+
+void draw_routing_density(ezgl::renderer* g) {
+    if (!draw_index.is_routing_index_valid) {
+        build_routing_index();
+    }
+
+    t_draw_coords* draw_coords = get_draw_coords_vars();
+    const auto& grid = g_vpr_ctx.device().grid;
+    const int width = grid.width();
+    const int height = grid.height();
+
+    // aggregate enough tiles in each heatmap cell for it to take DRAW_LOD_MIN_TILE_PIXELS pixels
+    double pixels_per_world_unit = g->get_visible_screen().width() / g->get_visible_world().width();
+    double tile_pixels = std::max(draw_coords->get_tile_width() * pixels_per_world_unit, 1e-3);
+    int cell_tiles = std::max(1, int(std::ceil(DRAW_LOD_MIN_TILE_PIXELS / tile_pixels)));
+
+    vtr::PlasmaColorMap cmap(0., 1.);
+    t_tile_region region = get_visible_tiles(g);
+    for (int cell_x = region.xmin - region.xmin % cell_tiles; cell_x <= region.xmax; cell_x += cell_tiles) {
+        for (int cell_y = region.ymin - region.ymin % cell_tiles; cell_y <= region.ymax; cell_y += cell_tiles) {
+            int cell_xmax = std::min(cell_x + cell_tiles, width) - 1;
+            int cell_ymax = std::min(cell_y + cell_tiles, height) - 1;
+
+            int num_wires = 0;
+            int num_used_wires = 0;
+            for (int x = cell_x; x <= cell_xmax; x++) {
+                for (int y = cell_y; y <= cell_ymax; y++) {
+                    num_wires += draw_index.num_wires[x][y];
+                    num_used_wires += draw_index.num_used_wires[x][y];
+                }
+            }
+            if (num_wires == 0) {
+                continue;
+            }
+
+            g->set_color(to_ezgl_color(cmap.color(float(num_used_wires) / num_wires)));
+            g->fill_rectangle({draw_coords->tile_x[cell_x], draw_coords->tile_y[cell_y]},
+                              {draw_coords->tile_x[cell_xmax] + draw_coords->get_tile_width(),
+                               draw_coords->tile_y[cell_ymax] + draw_coords->get_tile_height()});
+        }
+    }
+}
+
+#endif /* NO_GRAPHICS */
@@ -0,0 +1,60 @@
+/**
+ * @file draw_spatial_index.h
+ * @brief Spatial index and level-of-detail helpers, so that drawing large devices only costs what is on screen.
+ *
+ * Overview
+ * ========
+ * - The RR nodes are binned by the tiles they span (bins of DRAW_INDEX_BIN_TILES x DRAW_INDEX_BIN_TILES tiles), so that
+ *   draw_rr() only visits the nodes overlapping the visible world instead of the whole RR graph.
+ * - The tile bounding box of each net's routing is kept, so that drawroute() skips the nets which are off screen.
+ * - drawplace() only visits the grid tiles of the visible world.
+ * - When zoomed out so far that a tile takes fewer than DRAW_LOD_MIN_TILE_PIXELS pixels, individual wires can't be
+ *   told apart anyway: the routing is then drawn as a density heatmap (fraction of the wires of each area used by a net),
+ *   aggregated over as many tiles as needed for each heatmap cell to take at least that many pixels.
+ *
+ * The index is built lazily on the first draw that needs it, and is only invalidated when the RR graph
+ * (invalidate_draw_spatial_index(), called from init_draw_coords()) or the routing (invalidate_draw_routing_index(),
+ * called from update_screen()) change, not when panning or zooming.
+ */
+
+#ifndef DRAW_SPATIAL_INDEX_H
+#define DRAW_SPATIAL_INDEX_H
+
+#ifndef NO_GRAPHICS
+
+#    include <vector>
+
+#    include "netlist_fwd.h"
+#    include "rr_graph_fwd.h"
+#    include "ezgl/graphics.hpp"
+
+///@brief Size (in tiles) of the square bins of the RR node spatial index
+constexpr int DRAW_INDEX_BIN_TILES = 8;
+
+///@brief Below this tile size on screen (in pixels), the routing is drawn as a density heatmap
+constexpr double DRAW_LOD_MIN_TILE_PIXELS = 4.;
+
+///@brief Drops the whole index (e.g. the RR graph was rebuilt)
+void invalidate_draw_spatial_index();
+
+///@brief Drops the routing dependent parts of the index (net bounding boxes and routing density)
+void invalidate_draw_routing_index();
+
+///@brief Returns the range of grid tiles of the visible world, grown by a tile on each side
+void get_visible_tile_range(ezgl::renderer* g, int& xmin, int& ymin, int& xmax, int& ymax);
+
+///@brief Returns the RR nodes spanning any tile of the visible world (grown by a tile, to catch edges to off-screen nodes), in ascending order
+const std::vector<RRNodeId>& get_visible_rr_nodes(ezgl::renderer* g);
+
+///@brief Returns whether any part of the routing of net_id may be in the visible world
+bool is_routed_net_visible(ParentNetId net_id, ezgl::renderer* g);
+
+///@brief Returns whether tiles are so small on screen that the routing should be drawn as a density heatmap
+bool is_routing_level_of_detail_reduced(ezgl::renderer* g);
+
+///@brief Draws the visible part of the routing density heatmap (used instead of the wires when zoomed out)
+void draw_routing_density(ezgl::renderer* g);
+
+#endif /* NO_GRAPHICS */
+
+#endif /* DRAW_SPATIAL_INDEX_H */
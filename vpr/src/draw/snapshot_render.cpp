@@ -0,0 +1,369 @@
+#include "snapshot_render.h"
+
+#include "vtr_log.h"
+
+#ifndef NO_HEADLESS_DRAW
+
+#    include <algorithm>
+#    include <cmath>
+#    include <condition_variable>
+#    include <deque>
+#    include <memory>
+#    include <mutex>
+#    include <thread>
+#    include <vector>
+
+#    include <cairo.h>
+
+#    include "globals.h"
+#    include "vtr_color_map.h"
+#    include "vtr_ndmatrix.h"
+#    include "vtr_util.h"
+
+namespace {
+
+/** A (root) grid tile and whether a block is placed on it */
+struct t_snapshot_tile {
+    int xlow = 0;
+    int ylow = 0;
+    int xhigh = 0;
+    int yhigh = 0;
+    int type_index = 0;
+    bool is_used = false;
+};
+
+/** What a snapshot image shows, copied from the flow so that it can be drawn while the flow goes on */
+struct t_snapshot {
+    std::string file_name;
+    std::string title;
+
+    int grid_width = 0;
+    int grid_height = 0;
+    int num_tile_types = 0;
+    std::vector<t_snapshot_tile> tiles;
+
+    bool has_routing = false;
+    vtr::NdMatrix<int, 2> wire_capacity;  // [0..grid_width-1][0..grid_height-1] capacity of the wires spanning each tile
+    vtr::NdMatrix<int, 2> wire_occupancy; // same, used by nets
+    vtr::NdMatrix<bool, 2> is_overused;   // same, whether any of these wires is overused
+};
+
+/** Draws and writes out snapshots on a worker thread, in the order they were pushed */
+class SnapshotRenderer {
+  public:
+    SnapshotRenderer() = default;
+    ~SnapshotRenderer() { finish(); }
+
+    SnapshotRenderer(const SnapshotRenderer&) = delete;
+    SnapshotRenderer& operator=(const SnapshotRenderer&) = delete;
+
+    ///@brief Queues a snapshot, waiting first if SNAPSHOT_MAX_PENDING are already queued
+    void push(std::unique_ptr<t_snapshot> snapshot);
+
+    ///@brief Waits for the queued snapshots to be written, and stops the worker thread
+    void finish();
+
+  private:
+    void run();
+
+    std::thread worker_;
+    std::mutex mutex_;
+    std::condition_variable cv_; // signalled when pending_ or is_finishing_ change
+    std::deque<std::unique_ptr<t_snapshot>> pending_;
+    bool is_finishing_ = false;
+};
+
+struct t_snapshot_images_state {
+    std::string file_prefix; // empty if disabled
+    int interval = 0;
+    SnapshotRenderer renderer;
+};
+
+t_snapshot_images_state snapshot_images;
+
+} // namespace
+
+static void render_snapshot(const t_snapshot& snapshot);
+
+void SnapshotRenderer::push(std::unique_ptr<t_snapshot> snapshot) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!worker_.joinable()) {
+        worker_ = std::thread(&SnapshotRenderer::run, this);
+    }
+
+    // don't pile up snapshots faster than they can be written
+    cv_.wait(lock, [this] { return pending_.size() < SNAPSHOT_MAX_PENDING; });
+    pending_.push_back(std::move(snapshot));
+    cv_.notify_all();
+}
+
+void SnapshotRenderer::finish() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!worker_.joinable()) {
+            return;
+        }
+        is_finishing_ = true;
+        cv_.notify_all();
+    }
+    worker_.join();
+    is_finishing_ = false;
+}
+
+void SnapshotRenderer::run() {
+    while (true) {
+        std::unique_ptr<t_snapshot> snapshot;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return !pending_.empty() || is_finishing_; });
+            if (pending_.empty()) {
+                return; // finishing, and all written
+            }
+            snapshot = std::move(pending_.front());
+            pending_.pop_front();
+            cv_.notify_all();
+        }
+        render_snapshot(*snapshot);
+    }
+}
+
+/** Copies the placement (and routing utilization) of the bottom layer of the device */
+static std::unique_ptr<t_snapshot> take_snapshot(pic_type stage, const BlkLocRegistry& blk_loc_registry) {
+    const auto& device_ctx = g_vpr_ctx.device();
+    const auto& grid = device_ctx.grid;
+    const auto& grid_blocks = blk_loc_registry.grid_blocks();
+
+    auto snapshot = std::make_unique<t_snapshot>();
+    snapshot->grid_width = grid.width();
+    snapshot->grid_height = grid.height();
+    snapshot->num_tile_types = device_ctx.physical_tile_types.size();
+
+    for (int x = 0; x < snapshot->grid_width; x++) {
+        for (int y = 0; y < snapshot->grid_height; y++) {
+            t_physical_tile_loc loc(x, y, 0);
+            t_physical_tile_type_ptr type = grid.get_physical_type(loc);
+            if (type->is_empty() || grid.get_width_offset(loc) != 0 || grid.get_height_offset(loc) != 0) {
+                continue;
+            }
+
+            vtr::Rect<int> bb = grid.get_tile_bb(loc);
+            t_snapshot_tile tile;
+            tile.xlow = bb.xmin();
+            tile.ylow = bb.ymin();
+            tile.xhigh = bb.xmax();
+            tile.yhigh = bb.ymax();
+            tile.type_index = type->index;
+            tile.is_used = grid_blocks.get_usage(loc) > 0;
+            snapshot->tiles.push_back(tile);
+        }
+    }
+
+    const auto& rr_graph = device_ctx.rr_graph;
+    const auto& route_ctx = g_vpr_ctx.routing();
+    if (stage == ROUTING && route_ctx.rr_node_cong_inf.size() == rr_graph.num_nodes()) {
+        snapshot->has_routing = true;
+        snapshot->wire_capacity.resize({grid.width(), grid.height()}, 0);
+        snapshot->wire_occupancy.resize({grid.width(), grid.height()}, 0);
+        snapshot->is_overused.resize({grid.width(), grid.height()}, false);
+
+        for (RRNodeId inode : rr_graph.nodes()) {
+            t_rr_type type = rr_graph.node_type(inode);
+            if ((type != CHANX && type != CHANY) || rr_graph.node_layer(inode) != 0) {
+                continue;
+            }
+            int capacity = rr_graph.node_capacity(inode);
+            int occ = route_ctx.rr_node_cong_inf[inode].occ();
+            for (int x = rr_graph.node_xlow(inode); x <= rr_graph.node_xhigh(inode); x++) {
+                for (int y = rr_graph.node_ylow(inode); y <= rr_graph.node_yhigh(inode); y++) {
+                    snapshot->wire_capacity[x][y] += capacity;
+                    snapshot->wire_occupancy[x][y] += occ;
+                    if (occ > capacity) {
+                        snapshot->is_overused[x][y] = true;
+                    }
+                }
+            }
+        }
+    }
+
+    return snapshot;
+}
+
+/** Evenly spread hues, so that neighbouring tiles of different types can be told apart */
+static vtr::Color<float> tile_type_color(int type_index, int num_tile_types) {
+    float hue = 6.f * type_index / std::max(num_tile_types, 1);
+    float sat = 0.5f;
+    float val = 0.85f;
+
+    float chroma = val * sat;
+    float x = chroma * (1.f - std::fabs(std::fmod(hue, 2.f) - 1.f));
+    float m = val - chroma;
+    float r = 0.f, g = 0.f, b = 0.f;
+    switch (int(hue) % 6) {
+        case 0: r = chroma, g = x; break;
+        case 1: r = x, g = chroma; break;
+        case 2: g = chroma, b = x; break;
+        case 3: g = x, b = chroma; break;
+        case 4: r = x, b = chroma; break;
+        default: r = chroma, b = x; break;
+    }
+    return {r + m, g + m, b + m};
+}
+
+static void render_snapshot(const t_snapshot& snapshot) {
+    constexpr int TITLE_PIXELS = 24;
+
+    const int tile_pixels = std::max(1, SNAPSHOT_IMAGE_MAX_PIXELS / std::max({snapshot.grid_width, snapshot.grid_height, 1}));
+    const int width = tile_pixels * snapshot.grid_width;
+    const int height = tile_pixels * snapshot.grid_height + TITLE_PIXELS;
+
+    cairo_surface_t* surface = cairo_image_surface_create(CAIRO_FORMAT_RGB24, width, height);
+    cairo_t* cr = cairo_create(surface);
+
+    cairo_set_source_rgb(cr, 1., 1., 1.);
+    cairo_paint(cr);
+
+    // y grows upwards, as in the interactive graphics
+    auto tile_rectangle = [&](int xlow, int ylow, int xhigh, int yhigh, double inset) {
+        cairo_rectangle(cr,
+                        xlow * tile_pixels + inset,
+                        TITLE_PIXELS + (snapshot.grid_height - 1 - yhigh) * tile_pixels + inset,
+                        (xhigh - xlow + 1) * tile_pixels - 2 * inset,
+                        (yhigh - ylow + 1) * tile_pixels - 2 * inset);
+    };
+
+    if (snapshot.has_routing) {
+        // wire utilization heatmap, overused tiles outlined in red
+        vtr::PlasmaColorMap cmap(0., 1.);
+        for (int x = 0; x < snapshot.grid_width; x++) {
+            for (int y = 0; y < snapshot.grid_height; y++) {
+                if (snapshot.wire_capacity[x][y] == 0) {
+                    continue;
+                }
+                float util = std::min(1.f, float(snapshot.wire_occupancy[x][y]) / snapshot.wire_capacity[x][y]);
+                vtr::Color<float> color = cmap.color(util);
+                cairo_set_source_rgb(cr, color.r, color.g, color.b);
+                tile_rectangle(x, y, x, y, 0.);
+                cairo_fill(cr);
+            }
+        }
+        for (int x = 0; x < snapshot.grid_width; x++) {
+            for (int y = 0; y < snapshot.grid_height; y++) {
+                if (snapshot.is_overused[x][y]) {
+                    cairo_set_source_rgb(cr, 1., 0., 0.);
+                    cairo_set_line_width(cr, std::max(1., tile_pixels / 8.));
+                    tile_rectangle(x, y, x, y, 0.);
+                    cairo_stroke(cr);
+                }
+            }
+        }
+
+        // used blocks drawn inset, so that the utilization of their tiles stays visible
+        if (tile_pixels >= 4) {
+            for (const t_snapshot_tile& tile : snapshot.tiles) {
+                if (!tile.is_used) {
+                    continue;
+                }
+                vtr::Color<float> color = tile_type_color(tile.type_index, snapshot.num_tile_types);
+                cairo_set_source_rgb(cr, color.r, color.g, color.b);
+                tile_rectangle(tile.xlow, tile.ylow, tile.xhigh, tile.yhigh, tile_pixels / 4.);
+                cairo_fill(cr);
+            }
+        }
+    } else {
+        // the tiles, in their type's color if used and in a washed out one if empty
+        for (const t_snapshot_tile& tile : snapshot.tiles) {
+            vtr::Color<float> color = tile_type_color(tile.type_index, snapshot.num_tile_types);
+            if (!tile.is_used) {
+                color = {0.3f * color.r + 0.7f, 0.3f * color.g + 0.7f, 0.3f * color.b + 0.7f};
+            }
+            cairo_set_source_rgb(cr, color.r, color.g, color.b);
+            tile_rectangle(tile.xlow, tile.ylow, tile.xhigh, tile.yhigh, 0.);
+            cairo_fill_preserve(cr);
+            if (tile_pixels >= 4) {
+                cairo_set_source_rgb(cr, 0.4, 0.4, 0.4);
+                cairo_set_line_width(cr, 1.);
+                cairo_stroke(cr);
+            } else {
+                cairo_new_path(cr);
+            }
+        }
+    }
+
+    cairo_set_source_rgb(cr, 0., 0., 0.);
+    cairo_select_font_face(cr, "sans-serif", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
+    cairo_set_font_size(cr, 14.);
+    cairo_move_to(cr, 4., 17.);
+    cairo_show_text(cr, snapshot.title.c_str());
+
+    cairo_surface_flush(surface);
+    cairo_status_t status = cairo_surface_write_to_png(surface, snapshot.file_name.c_str());
+    if (status != CAIRO_STATUS_SUCCESS) {
+        VTR_LOG_WARN("Failed to write snapshot image '%s': %s\n", snapshot.file_name.c_str(), cairo_status_to_string(status));
+    }
+
+    cairo_destroy(cr);
+    cairo_surface_destroy(surface);
+}
+
+static void queue_snapshot(pic_type stage, const BlkLocRegistry& blk_loc_registry, const std::string& file_suffix, const std::string& title) {
+    std::unique_ptr<t_snapshot> snapshot = take_snapshot(stage, blk_loc_registry);
+    snapshot->file_name = snapshot_images.file_prefix + file_suffix;
+    snapshot->title = title;
+    snapshot_images.renderer.push(std::move(snapshot));
+}
+
+void init_snapshot_images(const std::string& file_prefix, int interval) {
+    snapshot_images.file_prefix = file_prefix;
+    snapshot_images.interval = interval;
+    if (!file_prefix.empty()) {
+        VTR_LOG("Saving snapshot images to '%s_*.png'\n", file_prefix.c_str());
+    }
+}
+
+void finish_snapshot_images() {
+    snapshot_images.renderer.finish();
+}
+
+void save_snapshot_image_checkpoint(pic_type stage, int iteration, const BlkLocRegistry& blk_loc_registry) {
+    if (snapshot_images.file_prefix.empty() || snapshot_images.interval <= 0 || iteration % snapshot_images.interval != 0) {
+        return;
+    }
+
+    if (stage == PLACEMENT) {
+        queue_snapshot(stage, blk_loc_registry,
+                       vtr::string_fmt("_place_temp_%03d.png", iteration),
+                       vtr::string_fmt("Placement, temperature %d", iteration));
+    } else {
+        queue_snapshot(stage, blk_loc_registry,
+                       vtr::string_fmt("_route_iter_%03d.png", iteration),
+                       vtr::string_fmt("Routing, iteration %d", iteration));
+    }
+}
+
+void save_snapshot_image(pic_type stage, const BlkLocRegistry& blk_loc_registry) {
+    if (snapshot_images.file_prefix.empty()) {
+        return;
+    }
+
+    if (stage == PLACEMENT) {
+        queue_snapshot(stage, blk_loc_registry, "_place.png", "Placement");
+    } else {
+        queue_snapshot(stage, blk_loc_registry, "_route.png", "Routing");
+    }
+}
+
+#else /* NO_HEADLESS_DRAW */
+
+void init_snapshot_images(const std::string& file_prefix, int /*interval*/) {
+    if (!file_prefix.empty()) {
+        VTR_LOG_WARN("VPR was built without cairo: no snapshot image will be saved\n");
+    }
+}
+
+void finish_snapshot_images() {}
+
+void save_snapshot_image_checkpoint(pic_type /*stage*/, int /*iteration*/, const BlkLocRegistry& /*blk_loc_registry*/) {}
+
+void save_snapshot_image(pic_type /*stage*/, const BlkLocRegistry& /*blk_loc_registry*/) {}
+
+#endif /* NO_HEADLESS_DRAW */
@@ -0,0 +1,56 @@
+/**
+ * @file snapshot_render.h
+ * @brief Headless rendering of placement and routing snapshots to PNG images (--save_snapshot_images).
+ *
+ * Overview
+ * ========
+ * Unlike save_graphics(), which prints the interactive ezgl canvas on the main thread, these images don't need
+ * GTK/X11 (only cairo) and don't stall the flow:
+ * - At a checkpoint, the main thread only copies what is drawn (the tiles of the device and whether a block is
+ *   placed on them, plus the used and total wire capacity spanning each tile when routing) into a snapshot.
+ * - The snapshot is drawn to a cairo image surface and written out by a worker thread, while the placer or the
+ *   router keep running.
+ *
+ * Images are saved at the end of placement (`<prefix>_place.png`) and of each successful routing (`<prefix>_route.png`),
+ * and, with --snapshot_image_interval N, every N annealing temperatures (`<prefix>_place_temp_<i>.png`) and
+ * every N router iterations (`<prefix>_route_iter_<i>.png`).
+ *
+ * When VPR is built without cairo (NO_HEADLESS_DRAW), these functions only warn that no image is saved.
+ */
+
+#ifndef SNAPSHOT_RENDER_H
+#define SNAPSHOT_RENDER_H
+
+#include <string>
+
+#include "blk_loc_registry.h"
+#include "vpr_types.h"
+
+///@brief Largest width or height (in pixels) of a snapshot image
+constexpr int SNAPSHOT_IMAGE_MAX_PIXELS = 2048;
+
+///@brief Number of snapshots which may wait for the worker thread before a checkpoint waits for it to catch up
+constexpr size_t SNAPSHOT_MAX_PENDING = 4;
+
+/**
+ * @brief Enables snapshot images, saved to files starting with file_prefix (disabled if empty)
+ *
+ * @param interval Number of annealing temperatures / router iterations between checkpoint images (0 for none)
+ */
+void init_snapshot_images(const std::string& file_prefix, int interval);
+
+///@brief Waits until all the pending snapshots are written, and stops the worker thread
+void finish_snapshot_images();
+
+/**
+ * @brief Saves a snapshot image if `iteration` (annealing temperature or router iteration) is a checkpoint
+ *
+ * @param stage What the snapshot shows (PLACEMENT, or ROUTING to also draw the wire utilization)
+ * @param blk_loc_registry Current placement (the placer's own during annealing)
+ */
+void save_snapshot_image_checkpoint(pic_type stage, int iteration, const BlkLocRegistry& blk_loc_registry);
+
+///@brief Saves the snapshot image of the end of a stage (placement or routing)
+void save_snapshot_image(pic_type stage, const BlkLocRegistry& blk_loc_registry);
+
+#endif /* SNAPSHOT_RENDER_H */
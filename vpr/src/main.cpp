@@ -29,6 +29,10 @@
 
 #include "globals.h"
 
+#ifndef NO_SERVER
+#include "daemon.h"
+#endif /* NO_SERVER */
+
 /**
  * VPR program
  * Generate FPGA architecture given architecture description
@@ -59,6 +63,14 @@ int main(int argc, const char** argv) {
         }
 
         bool flow_succeeded = vpr_flow(vpr_setup, Arch);
+
+#ifndef NO_SERVER
+        if (vpr_setup.ServerOpts.is_daemon_mode_enabled) {
+            //Serve the batch jobs with the device of the circuit implemented above
+            server::run_daemon(Options, vpr_setup, Arch);
+        }
+#endif /* NO_SERVER */
+
         if (!flow_succeeded) {
             VTR_LOG("VPR failed to implement circuit\n");
             vpr_free_all(Arch, vpr_setup);
@@ -2,6 +2,7 @@
 #include "channel_dependency_graph.h"
 #include "vtr_assert.h"
 
+#include <algorithm>
 #include <stack>
 
 ChannelDependencyGraph::ChannelDependencyGraph(const NocStorage& noc_model,
@@ -125,4 +126,162 @@ bool ChannelDependencyGraph::has_cycles() {
 
     // if no vertex in the graph points to at least one of its ancestors, the graph does not have any cycles
     return false;
-}
\ No newline at end of file
+}
+
+ChannelDependencyGraph::ChannelDependencyGraph(size_t n_links) {
+    adjacency_list_.resize(n_links);
+    edge_route_counts_.resize(n_links);
+    reverse_adjacency_list_.resize(n_links);
+    visited_.resize(n_links, false);
+
+    // without any edges, any order is topological
+    topo_order_.resize(n_links);
+    for (size_t i = 0; i < n_links; i++) {
+        topo_order_[NocLinkId(i)] = (int)i;
+    }
+}
+
+bool ChannelDependencyGraph::add_route(const std::vector<NocLinkId>& route) {
+    VTR_ASSERT(topo_order_.size() == adjacency_list_.size());
+
+    for (size_t i = 1; i < route.size(); i++) {
+        if (!add_edge(route[i - 1], route[i])) {
+            // undo the edges added for this route
+            for (size_t j = 1; j < i; j++) {
+                remove_edge(route[j - 1], route[j]);
+            }
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void ChannelDependencyGraph::remove_route(const std::vector<NocLinkId>& route) {
+    VTR_ASSERT(topo_order_.size() == adjacency_list_.size());
+
+    for (size_t i = 1; i < route.size(); i++) {
+        remove_edge(route[i - 1], route[i]);
+    }
+}
+
+bool ChannelDependencyGraph::add_edge(NocLinkId from, NocLinkId to) {
+    // the edge may already be used by another route
+    auto& neighbors = adjacency_list_[from];
+    auto it = std::find(neighbors.begin(), neighbors.end(), to);
+    if (it != neighbors.end()) {
+        edge_route_counts_[from][it - neighbors.begin()]++;
+        return true;
+    }
+
+    if (from == to) {
+        return false;
+    }
+
+    // a new edge against the topological order requires reordering, which fails if it closes a cycle
+    if (topo_order_[from] > topo_order_[to] && !reorder(from, to)) {
+        return false;
+    }
+
+    neighbors.push_back(to);
+    edge_route_counts_[from].push_back(1);
+    reverse_adjacency_list_[to].push_back(from);
+
+    return true;
+}
+
+void ChannelDependencyGraph::remove_edge(NocLinkId from, NocLinkId to) {
+    auto& neighbors = adjacency_list_[from];
+    auto it = std::find(neighbors.begin(), neighbors.end(), to);
+    VTR_ASSERT(it != neighbors.end());
+
+    size_t index = it - neighbors.begin();
+    if (--edge_route_counts_[from][index] > 0) {
+        return;
+    }
+
+    // no route uses the edge anymore. Removing an edge keeps the topological order valid
+    neighbors[index] = neighbors.back();
+    neighbors.pop_back();
+    edge_route_counts_[from][index] = edge_route_counts_[from].back();
+    edge_route_counts_[from].pop_back();
+
+    auto& reverse_neighbors = reverse_adjacency_list_[to];
+    reverse_neighbors.erase(std::find(reverse_neighbors.begin(), reverse_neighbors.end(), from));
+}
+
+bool ChannelDependencyGraph::reorder(NocLinkId from, NocLinkId to) {
+    // only the vertices between to and from in the topological order can be affected
+    const int lower_bound = topo_order_[to];
+    const int upper_bound = topo_order_[from];
+
+    auto clear_visited = [this]() {
+        for (NocLinkId vertex : forward_region_) {
+            visited_[vertex] = false;
+        }
+        for (NocLinkId vertex : backward_region_) {
+            visited_[vertex] = false;
+        }
+    };
+
+    // find the vertices reachable from to that come before from in the order
+    forward_region_.clear();
+    backward_region_.clear();
+    forward_region_.push_back(to);
+    visited_[to] = true;
+    for (size_t i = 0; i < forward_region_.size(); i++) {
+        for (NocLinkId neighbor : adjacency_list_[forward_region_[i]]) {
+            if (neighbor == from) {
+                // to reaches from: adding from->to closes a cycle
+                clear_visited();
+                return false;
+            }
+            if (!visited_[neighbor] && topo_order_[neighbor] < upper_bound) {
+                visited_[neighbor] = true;
+                forward_region_.push_back(neighbor);
+            }
+        }
+    }
+
+    // find the vertices reaching from that come after to in the order
+    backward_region_.push_back(from);
+    visited_[from] = true;
+    for (size_t i = 0; i < backward_region_.size(); i++) {
+        for (NocLinkId neighbor : reverse_adjacency_list_[backward_region_[i]]) {
+            if (!visited_[neighbor] && topo_order_[neighbor] > lower_bound) {
+                visited_[neighbor] = true;
+                backward_region_.push_back(neighbor);
+            }
+        }
+    }
+
+    clear_visited();
+
+    // keep the relative order within each region, and give the positions they occupy
+    // to the backward region first, so that from comes before to
+    auto by_order = [this](NocLinkId a, NocLinkId b) {
+        return topo_order_[a] < topo_order_[b];
+    };
+    std::sort(forward_region_.begin(), forward_region_.end(), by_order);
+    std::sort(backward_region_.begin(), backward_region_.end(), by_order);
+
+    std::vector<int> positions;
+    positions.reserve(forward_region_.size() + backward_region_.size());
+    for (NocLinkId vertex : backward_region_) {
+        positions.push_back(topo_order_[vertex]);
+    }
+    for (NocLinkId vertex : forward_region_) {
+        positions.push_back(topo_order_[vertex]);
+    }
+    std::sort(positions.begin(), positions.end());
+
+    size_t next_position = 0;
+    for (NocLinkId vertex : backward_region_) {
+        topo_order_[vertex] = positions[next_position++];
+    }
+    for (NocLinkId vertex : forward_region_) {
+        topo_order_[vertex] = positions[next_position++];
+    }
+
+    return true;
+}
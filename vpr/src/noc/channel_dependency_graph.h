@@ -20,6 +20,17 @@
  * ACM SIGARCH Computer Architecture News, 20(2), 278-287.
  * 2) Dally, & Seitz. (1987). Deadlock-free message routing in multiprocessor
  * interconnection networks. IEEE Transactions on computers, 100(5), 547-553.
+ *
+ * Incremental Use
+ * ===============
+ * A CDG can also be built empty and updated as traffic flow routes change
+ * (add_route()/remove_route()), e.g. while NoC routers are moved during placement.
+ * An incremental CDG is kept acyclic: it maintains a topological order of its
+ * vertices, and a route whose edges would create a cycle is rejected. When an
+ * edge goes against the current order, only the vertices between its endpoints
+ * in the order are searched and reordered (Pearce & Kelly, A dynamic topological
+ * sort algorithm for directed acyclic graphs, 2007), so most route updates
+ * do not traverse the graph at all.
  */
 
 #include "vtr_vector.h"
@@ -52,9 +63,59 @@ class ChannelDependencyGraph {
      */
     bool has_cycles();
 
+    /**
+     * @brief Constructs an empty, incremental CDG.
+     *
+     * @param n_links The total number of NoC links.
+     */
+    explicit ChannelDependencyGraph(size_t n_links);
+
+    /**
+     * @brief Adds the dependencies of a traffic flow route to an incremental CDG,
+     * unless they would create a cycle, in which case the CDG is left unchanged.
+     *
+     * @param route The links traversed by a traffic flow, in traversal order.
+     * @return True if the route was added, false if it would cause a deadlock.
+     */
+    bool add_route(const std::vector<NocLinkId>& route);
+
+    /**
+     * @brief Removes the dependencies of a traffic flow route previously
+     * added to an incremental CDG with add_route().
+     *
+     * @param route The links traversed by a traffic flow, in traversal order.
+     */
+    void remove_route(const std::vector<NocLinkId>& route);
+
+  private:
+    /** Adds an edge (used by one more route), returns false if it would create a cycle */
+    bool add_edge(NocLinkId from, NocLinkId to);
+
+    /** Removes an edge (used by one less route) */
+    void remove_edge(NocLinkId from, NocLinkId to);
+
+    /**
+     * @brief Reorders the vertices so that to comes before from in the topological
+     * order, before adding a from->to edge.
+     * @return False if to reaches from, i.e. the edge would create a cycle.
+     */
+    bool reorder(NocLinkId from, NocLinkId to);
+
   private:
     /** An adjacency list used to represent channel dependency graph.*/
     vtr::vector<NocLinkId, std::vector<NocLinkId>> adjacency_list_;
+
+    /* Used by incremental CDGs only */
+    /// Number of routes using each edge of adjacency_list_
+    vtr::vector<NocLinkId, std::vector<int>> edge_route_counts_;
+    /// Incoming neighbours of each vertex
+    vtr::vector<NocLinkId, std::vector<NocLinkId>> reverse_adjacency_list_;
+    /// Position of each vertex in the topological order: all edges go from lower to higher positions
+    vtr::vector<NocLinkId, int> topo_order_;
+    /// Vertices visited by reorder(), with their visited flags
+    std::vector<NocLinkId> forward_region_;
+    std::vector<NocLinkId> backward_region_;
+    vtr::vector<NocLinkId, bool> visited_;
 };
 
 #endif //VTR_CHANNEL_DEPENDENCY_GRAPH_H
@@ -0,0 +1,22 @@
+#include "noc_routing.h"
+
+void NocRouting::route_flow_cached(NocRouterId src_router_id,
+                                   NocRouterId sink_router_id,
+                                   NocTrafficFlowId traffic_flow_id,
+                                   std::vector<NocLinkId>& flow_route,
+                                   const NocStorage& noc_model) {
+    if (route_depends_on_traffic_flow()) {
+        route_flow(src_router_id, sink_router_id, traffic_flow_id, flow_route, noc_model);
+        return;
+    }
+
+    auto it = route_cache_.find({src_router_id, sink_router_id});
+    if (it != route_cache_.end()) {
+        flow_route = it->second;
+        return;
+    }
+
+    // not cached yet: route_flow() throws if the routers can't be connected, in which case nothing is cached
+    route_flow(src_router_id, sink_router_id, traffic_flow_id, flow_route, noc_model);
+    route_cache_.emplace(std::make_pair(src_router_id, sink_router_id), flow_route);
+}
@@ -19,12 +19,19 @@
  * made that inherits this class. Then the following needs to be done:
  *  - The routing algorithm should be implemented inside the route_flow
  *    function and should match the prototype declared below
+ *  - If the route found between two routers does not depend on the
+ *    traffic flow being routed, route_depends_on_traffic_flow() can return
+ *    false so that the routes found by route_flow_cached() are shared by
+ *    all the traffic flows with the same source and sink routers
  */
 
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "noc_data_types.h"
 #include "noc_storage.h"
+#include "vtr_hash.h"
 
 class NocRouting {
     // pure virtual functions that should be implemented in derived classes.
@@ -61,6 +68,43 @@ class NocRouting {
                             NocTrafficFlowId traffic_flow_id,
                             std::vector<NocLinkId>& flow_route,
                             const NocStorage& noc_model) = 0;
+
+    /**
+     * @brief Whether the route found by route_flow() between two routers
+     * can differ from one traffic flow to another, e.g. when the traffic
+     * flow id is used to choose between several legal directions.
+     *
+     * @return False if all the traffic flows with the same source and
+     * sink routers get the same route.
+     */
+    virtual bool route_depends_on_traffic_flow() const { return false; }
+
+    /**
+     * @brief Finds a route in the same way as route_flow(), but reuses
+     * the route found earlier between the same source and sink routers
+     * when it doesn't depend on the traffic flow. The placer moves the
+     * router blocks of a traffic flow between a limited number of physical
+     * routers, so most routes are looked up rather than searched for.
+     * The cached routes are only valid for the NoC model they were found in.
+     *
+     * @param src_router_id The source router of a traffic flow.
+     * @param sink_router_id The destination router of a traffic flow.
+     * @param traffic_flow_id The unique ID for the traffic flow being routed.
+     * @param flow_route Stores the route found between the two routers.
+     * @param noc_model A model of the NoC.
+     */
+    void route_flow_cached(NocRouterId src_router_id,
+                           NocRouterId sink_router_id,
+                           NocTrafficFlowId traffic_flow_id,
+                           std::vector<NocLinkId>& flow_route,
+                           const NocStorage& noc_model);
+
+    /** @brief Forgets the routes found by route_flow_cached() */
+    void clear_route_cache() { route_cache_.clear(); }
+
+  private:
+    /// Routes found by route_flow_cached(), indexed by their (source, sink) routers
+    std::unordered_map<std::pair<NocRouterId, NocRouterId>, std::vector<NocLinkId>, vtr::hash_pair> route_cache_;
 };
 
 #endif
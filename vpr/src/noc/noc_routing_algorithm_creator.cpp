@@ -12,22 +12,29 @@
 std::unique_ptr<NocRouting> NocRoutingAlgorithmCreator::create_routing_algorithm(const std::string& routing_algorithm_name,
                                                                                  const NocStorage& noc_model) {
     std::unique_ptr<NocRouting> noc_routing_algorithm;
+    std::unique_ptr<TurnModelRouting> turn_model_routing_algorithm;
 
     if (routing_algorithm_name == "xy_routing") {
-        noc_routing_algorithm = std::make_unique<XYRouting>();
+        turn_model_routing_algorithm = std::make_unique<XYRouting>();
     } else if (routing_algorithm_name == "bfs_routing") {
         noc_routing_algorithm = std::make_unique<BFSRouting>();
     } else if (routing_algorithm_name == "west_first_routing") {
-        noc_routing_algorithm = std::make_unique<WestFirstRouting>();
+        turn_model_routing_algorithm = std::make_unique<WestFirstRouting>();
     } else if (routing_algorithm_name == "north_last_routing") {
-        noc_routing_algorithm = std::make_unique<NorthLastRouting>();
+        turn_model_routing_algorithm = std::make_unique<NorthLastRouting>();
     } else if (routing_algorithm_name == "negative_first_routing") {
-        noc_routing_algorithm = std::make_unique<NegativeFirstRouting>();
+        turn_model_routing_algorithm = std::make_unique<NegativeFirstRouting>();
     } else if (routing_algorithm_name == "odd_even_routing") {
-        noc_routing_algorithm = std::make_unique<OddEvenRouting>(noc_model);
+        turn_model_routing_algorithm = std::make_unique<OddEvenRouting>(noc_model);
     } else {
         VPR_FATAL_ERROR(VPR_ERROR_OTHER, "The provided NoC routing algorithm '%s' is not supported.", routing_algorithm_name.c_str());
     }
 
+    // turn model algorithms move one direction at a time: precompute the link to take in each direction
+    if (turn_model_routing_algorithm) {
+        turn_model_routing_algorithm->build_direction_links(noc_model);
+        noc_routing_algorithm = std::move(turn_model_routing_algorithm);
+    }
+
     return noc_routing_algorithm;
 }
\ No newline at end of file
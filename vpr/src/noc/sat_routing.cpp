@@ -7,6 +7,7 @@
 #include "globals.h"
 #include "vtr_time.h"
 
+#include <memory>
 #include <unordered_map>
 
 #include "ortools/sat/cp_model.h"
@@ -196,6 +197,58 @@ static orsat::LinearExpr create_objective(orsat::CpModelBuilder& cp_model,
 static vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>> convert_vars_to_routes(t_flow_link_var_map& flow_link_vars,
                                                                                     const orsat::CpSolverResponse& response);
 
+/**
+ * @brief Returns the hard NoC routers where the source and destination
+ * logical routers of a traffic flow are currently placed.
+ *
+ * @param traffic_flow_id The unique ID of the traffic flow.
+ * @return The (source, destination) NoC routers of the traffic flow.
+ */
+static std::pair<NocRouterId, NocRouterId> get_traffic_flow_routers(NocTrafficFlowId traffic_flow_id);
+
+/**
+ * @brief Adds the variables and the constraints that do not depend on where
+ * logical NoC routers are placed, i.e. everything but the continuity constraints,
+ * and sets the objective function to be minimized.
+ *
+ * @param cp_model The CP model builder object. Variables, constraints and the
+ * objective are added to this model builder object.
+ * @param flow_link_vars The created boolean variables for (traffic flow, link) pairs
+ * are stored in this container.
+ * @param minimize_aggregate_bandwidth Specifies whether the objective includes an
+ * aggregate bandwidth term.
+ * @param noc_opts NoC options specifying the bandwidth resolution and the
+ * weighting factors of the objective terms.
+ */
+static void create_placement_independent_model(orsat::CpModelBuilder& cp_model,
+                                               t_flow_link_var_map& flow_link_vars,
+                                               bool minimize_aggregate_bandwidth,
+                                               const t_noc_opts& noc_opts);
+
+/**
+ * @brief Gives the solver the given traffic flow routes as a hint.
+ * A good starting point also provides a tighter initial bound
+ * on the objective function.
+ *
+ * @param cp_model The CP model builder object. Hints are added to it.
+ * @param flow_link_vars Boolean variable container for (traffic flow, link) pairs.
+ * @param routes The route hinted for each traffic flow.
+ */
+static void add_route_hints(orsat::CpModelBuilder& cp_model,
+                            t_flow_link_var_map& flow_link_vars,
+                            const vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>>& routes);
+
+/**
+ * @brief Solves the given model and converts its solution to traffic flow routes.
+ *
+ * @return The routes of all traffic flows in traversal order, or an empty
+ * vector if no feasible solution was found.
+ */
+static vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>> solve_sat_model(orsat::CpModelBuilder& cp_model,
+                                                                             t_flow_link_var_map& flow_link_vars,
+                                                                             const t_noc_opts& noc_opts,
+                                                                             int seed);
+
 /**
  * @brief Sorts the given NoC links so that they can traversed one after another.
  *
@@ -316,20 +369,12 @@ static void add_continuity_constraints(t_flow_link_var_map& flow_link_vars,
                                        orsat::CpModelBuilder& cp_model) {
     const auto& noc_ctx = g_vpr_ctx.noc();
     const auto& traffic_flow_storage = noc_ctx.noc_traffic_flows_storage;
-    const auto& place_ctx = g_vpr_ctx.placement();
 
     // constrain the links that can be activated for each traffic flow in a way that they
     // form a continuous route
     for (auto traffic_flow_id : traffic_flow_storage.get_all_traffic_flow_id()) {
-        const auto& traffic_flow = traffic_flow_storage.get_single_noc_traffic_flow(traffic_flow_id);
-
-        // get the source and destination logical router blocks in the current traffic flow
-        ClusterBlockId logical_source_router_block_id = traffic_flow.source_router_cluster_id;
-        ClusterBlockId logical_sink_router_block_id = traffic_flow.sink_router_cluster_id;
-
-        // get the ids of the hard router blocks where the logical router cluster blocks have been placed
-        NocRouterId source_router_id = noc_ctx.noc_model.get_router_at_grid_location(place_ctx.block_locs[logical_source_router_block_id].loc);
-        NocRouterId sink_router_id = noc_ctx.noc_model.get_router_at_grid_location(place_ctx.block_locs[logical_sink_router_block_id].loc);
+        // get the hard routers where the source and destination logical routers of the traffic flow are placed
+        auto [source_router_id, sink_router_id] = get_traffic_flow_routers(traffic_flow_id);
 
         // exactly one outgoing link of the source must be selected
         const auto& src_outgoing_link_ids = noc_ctx.noc_model.get_noc_router_outgoing_links(source_router_id);
@@ -575,17 +620,6 @@ static orsat::LinearExpr create_objective(orsat::CpModelBuilder& cp_model,
                                           int latency_overrun_weight,
                                           int congestion_weight,
                                           bool minimize_aggregate_bandwidth) {
-    const auto& noc_ctx = g_vpr_ctx.noc();
-    const auto& traffic_flow_storage = noc_ctx.noc_traffic_flows_storage;
-
-    // use the current routing solution as a hint for the SAT solver
-    // This will help the solver by giving a good starting point and tighter initial lower bound on the objective function
-    for (auto traffic_flow_id : traffic_flow_storage.get_all_traffic_flow_id()) {
-        for (auto route_link_id : traffic_flow_storage.get_traffic_flow_route(traffic_flow_id)) {
-            cp_model.AddHint(flow_link_vars[{traffic_flow_id, route_link_id}], true);
-        }
-    }
-
     orsat::LinearExpr latency_overrun_sum;
     for (auto& [traffic_flow_id, latency_overrun_var] : latency_overrun_vars) {
         latency_overrun_sum += latency_overrun_var;
@@ -612,19 +646,27 @@ static orsat::LinearExpr create_objective(orsat::CpModelBuilder& cp_model,
 }
 
 
-vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>> noc_sat_route(bool minimize_aggregate_bandwidth,
-                                                                    const t_noc_opts& noc_opts,
-                                                                    int seed) {
-    vtr::ScopedStartFinishTimer timer("NoC SAT Routing");
+static std::pair<NocRouterId, NocRouterId> get_traffic_flow_routers(NocTrafficFlowId traffic_flow_id) {
+    const auto& noc_ctx = g_vpr_ctx.noc();
+    const auto& place_ctx = g_vpr_ctx.placement();
 
-    // Used to add variables and constraints to a CP-SAT model
-    orsat::CpModelBuilder cp_model;
+    const auto& traffic_flow = noc_ctx.noc_traffic_flows_storage.get_single_noc_traffic_flow(traffic_flow_id);
 
-    /* For each traffic flow and NoC link pair, we create a boolean variable.
-     * When a variable associated with traffic flow t and NoC link l is set,
-     * it means that t is routed through l.*/
-    t_flow_link_var_map flow_link_vars;
+    // get the source and destination logical router blocks in the current traffic flow
+    ClusterBlockId logical_source_router_block_id = traffic_flow.source_router_cluster_id;
+    ClusterBlockId logical_sink_router_block_id = traffic_flow.sink_router_cluster_id;
+
+    // get the ids of the hard router blocks where the logical router cluster blocks have been placed
+    NocRouterId source_router_id = noc_ctx.noc_model.get_router_at_grid_location(place_ctx.block_locs[logical_source_router_block_id].loc);
+    NocRouterId sink_router_id = noc_ctx.noc_model.get_router_at_grid_location(place_ctx.block_locs[logical_sink_router_block_id].loc);
 
+    return {source_router_id, sink_router_id};
+}
+
+static void create_placement_independent_model(orsat::CpModelBuilder& cp_model,
+                                               t_flow_link_var_map& flow_link_vars,
+                                               bool minimize_aggregate_bandwidth,
+                                               const t_noc_opts& noc_opts) {
     /* A boolean variable is associated with each NoC link to indicate
      * whether it is congested.*/
     vtr::vector<NocLinkId, orsat::BoolVar> link_congested_vars;
@@ -644,8 +686,6 @@ vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>> noc_sat_route(bool minimiz
 
     create_congested_link_vars(link_congested_vars, flow_link_vars, cp_model, noc_opts.noc_sat_routing_bandwidth_resolution);
 
-    add_continuity_constraints(flow_link_vars, cp_model);
-
     auto objective = create_objective(cp_model, flow_link_vars, latency_overrun_vars, link_congested_vars,
                                       noc_opts.noc_sat_routing_bandwidth_resolution,
                                       noc_opts.noc_sat_routing_latency_overrun_weighting,
@@ -653,7 +693,22 @@ vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>> noc_sat_route(bool minimiz
                                       minimize_aggregate_bandwidth);
 
     cp_model.Minimize(objective);
+}
 
+static void add_route_hints(orsat::CpModelBuilder& cp_model,
+                            t_flow_link_var_map& flow_link_vars,
+                            const vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>>& routes) {
+    for (auto traffic_flow_id : routes.keys()) {
+        for (auto route_link_id : routes[traffic_flow_id]) {
+            cp_model.AddHint(flow_link_vars[{traffic_flow_id, route_link_id}], true);
+        }
+    }
+}
+
+static vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>> solve_sat_model(orsat::CpModelBuilder& cp_model,
+                                                                             t_flow_link_var_map& flow_link_vars,
+                                                                             const t_noc_opts& noc_opts,
+                                                                             int seed) {
     orsat::SatParameters sat_params;
     if (noc_opts.noc_sat_routing_num_workers > 0) {
         sat_params.set_num_workers(noc_opts.noc_sat_routing_num_workers);
@@ -676,4 +731,120 @@ vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>> noc_sat_route(bool minimiz
     return {};
 }
 
+vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>> noc_sat_route(bool minimize_aggregate_bandwidth,
+                                                                    const t_noc_opts& noc_opts,
+                                                                    int seed) {
+    vtr::ScopedStartFinishTimer timer("NoC SAT Routing");
+
+    // Used to add variables and constraints to a CP-SAT model
+    orsat::CpModelBuilder cp_model;
+
+    /* For each traffic flow and NoC link pair, we create a boolean variable.
+     * When a variable associated with traffic flow t and NoC link l is set,
+     * it means that t is routed through l.*/
+    t_flow_link_var_map flow_link_vars;
+
+    create_placement_independent_model(cp_model, flow_link_vars, minimize_aggregate_bandwidth, noc_opts);
+
+    add_continuity_constraints(flow_link_vars, cp_model);
+
+    // use the current routing solution as a hint for the SAT solver
+    const auto& traffic_flow_storage = g_vpr_ctx.noc().noc_traffic_flows_storage;
+    vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>> curr_routes;
+    for (auto traffic_flow_id : traffic_flow_storage.get_all_traffic_flow_id()) {
+        curr_routes.push_back(traffic_flow_storage.get_traffic_flow_route(traffic_flow_id));
+    }
+    add_route_hints(cp_model, flow_link_vars, curr_routes);
+
+    return solve_sat_model(cp_model, flow_link_vars, noc_opts, seed);
+}
+
+/**
+ * @brief The SAT model kept between calls to noc_sat_route_incremental(),
+ * and the solution it found last.
+ */
+struct t_incremental_sat_model {
+    /// The variables, constraints and objective that don't depend on the placement
+    orsat::CpModelBuilder placement_independent_model;
+    /// The (traffic flow, link) variables of placement_independent_model
+    t_flow_link_var_map flow_link_vars;
+
+    /// The options the model was built with
+    bool minimize_aggregate_bandwidth;
+    int bandwidth_resolution;
+    int latency_overrun_weighting;
+    int congestion_weighting;
+
+    /// Source and destination routers of each traffic flow in the last solution
+    vtr::vector<NocTrafficFlowId, std::pair<NocRouterId, NocRouterId>> prev_traffic_flow_routers;
+    /// Traffic flow routes of the last solution (empty if none was found)
+    vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>> prev_routes;
+};
+
+static std::unique_ptr<t_incremental_sat_model> incremental_sat_model;
+
+vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>> noc_sat_route_incremental(bool minimize_aggregate_bandwidth,
+                                                                                const t_noc_opts& noc_opts,
+                                                                                int seed) {
+    vtr::ScopedStartFinishTimer timer("Incremental NoC SAT Routing");
+
+    const auto& traffic_flow_storage = g_vpr_ctx.noc().noc_traffic_flows_storage;
+
+    // (re)build the placement independent part of the model if it doesn't exist yet or was built with other options
+    if (!incremental_sat_model
+        || incremental_sat_model->minimize_aggregate_bandwidth != minimize_aggregate_bandwidth
+        || incremental_sat_model->bandwidth_resolution != noc_opts.noc_sat_routing_bandwidth_resolution
+        || incremental_sat_model->latency_overrun_weighting != noc_opts.noc_sat_routing_latency_overrun_weighting
+        || incremental_sat_model->congestion_weighting != noc_opts.noc_sat_routing_congestion_weighting) {
+        incremental_sat_model = std::make_unique<t_incremental_sat_model>();
+        create_placement_independent_model(incremental_sat_model->placement_independent_model,
+                                           incremental_sat_model->flow_link_vars,
+                                           minimize_aggregate_bandwidth, noc_opts);
+        incremental_sat_model->minimize_aggregate_bandwidth = minimize_aggregate_bandwidth;
+        incremental_sat_model->bandwidth_resolution = noc_opts.noc_sat_routing_bandwidth_resolution;
+        incremental_sat_model->latency_overrun_weighting = noc_opts.noc_sat_routing_latency_overrun_weighting;
+        incremental_sat_model->congestion_weighting = noc_opts.noc_sat_routing_congestion_weighting;
+    }
+
+    // copy the placement independent part of the model, its variables keep the same indices
+    orsat::CpModelBuilder cp_model;
+    cp_model.CopyFrom(incremental_sat_model->placement_independent_model.Proto());
+
+    t_flow_link_var_map flow_link_vars;
+    flow_link_vars.reserve(incremental_sat_model->flow_link_vars.size());
+    for (const auto& [key, var] : incremental_sat_model->flow_link_vars) {
+        flow_link_vars.emplace(key, cp_model.GetBoolVarFromProtoIndex(var.index()));
+    }
+
+    // only the continuity constraints depend on where the traffic flow endpoints are placed
+    add_continuity_constraints(flow_link_vars, cp_model);
+
+    /* Warm start from the last solution: traffic flows whose endpoints have not moved
+     * since are hinted their last SAT route, the others their current route. */
+    vtr::vector<NocTrafficFlowId, std::pair<NocRouterId, NocRouterId>> traffic_flow_routers;
+    vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>> hint_routes;
+    for (auto traffic_flow_id : traffic_flow_storage.get_all_traffic_flow_id()) {
+        traffic_flow_routers.push_back(get_traffic_flow_routers(traffic_flow_id));
+
+        if (!incremental_sat_model->prev_routes.empty()
+            && incremental_sat_model->prev_traffic_flow_routers[traffic_flow_id] == traffic_flow_routers[traffic_flow_id]) {
+            hint_routes.push_back(incremental_sat_model->prev_routes[traffic_flow_id]);
+        } else {
+            hint_routes.push_back(traffic_flow_storage.get_traffic_flow_route(traffic_flow_id));
+        }
+    }
+    add_route_hints(cp_model, flow_link_vars, hint_routes);
+
+    auto routes = solve_sat_model(cp_model, flow_link_vars, noc_opts, seed);
+
+    incremental_sat_model->prev_traffic_flow_routers = std::move(traffic_flow_routers);
+    incremental_sat_model->prev_routes = routes;
+
+    return routes;
+}
+
+void free_noc_sat_route_incremental() {
+    incremental_sat_model.reset();
+}
+
 #endif //ENABLE_NOC_SAT_ROUTING
\ No newline at end of file
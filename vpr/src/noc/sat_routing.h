@@ -45,6 +45,34 @@ vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>> noc_sat_route(bool minimiz
                                                                     const t_noc_opts& noc_opts,
                                                                     int seed);
 
+/**
+ * @brief Same as noc_sat_route(), for calling it repeatedly during placement.
+ *
+ * Only the continuity constraints of the SAT formulation depend on where
+ * logical NoC routers are placed. The other variables and constraints, and the
+ * objective function, are built on the first call and reused by the following
+ * calls with the same options, which only add the continuity constraints for
+ * the current placement. The solver is warm-started from the previous solution:
+ * traffic flows whose endpoints have not moved since are hinted the route it gave
+ * them, the others their current route.
+ *
+ * The reused model is only valid for the NoC and traffic flows it was built for:
+ * free_noc_sat_route_incremental() must be called if they change.
+ *
+ * @param minimize_aggregate_bandwidth Indicates whether the SAT solver
+ * should minimize the aggregate bandwidth or not.
+ * @param seed An integer seed to initialize the SAT solver.
+ * @return The generated routes for all traffic flows.
+ */
+vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>> noc_sat_route_incremental(bool minimize_aggregate_bandwidth,
+                                                                                const t_noc_opts& noc_opts,
+                                                                                int seed);
+
+/**
+ * @brief Frees the SAT model kept by noc_sat_route_incremental().
+ */
+void free_noc_sat_route_incremental();
+
 namespace std {
 
 template<>
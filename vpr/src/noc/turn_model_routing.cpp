@@ -101,6 +101,19 @@ NocLinkId TurnModelRouting::move_to_next_router(NocRouterId& curr_router_id,
     // When an acceptable link is found, this variable keeps track of whether the next router visited using the link was already visited or not.
     bool visited_next_router = false;
 
+    // look up the first link in the intended direction if the links in each direction were precomputed
+    if (direction_links_noc_model == &noc_model && next_step_direction < TurnModelRouting::Direction::N_DIRECTIONS) {
+        NocLinkId direction_link = direction_links[curr_router_id][(size_t)next_step_direction];
+        if (direction_link) {
+            NocRouterId next_router_id = noc_model.get_single_noc_link(direction_link).get_sink_router();
+            if (visited_routers.insert(next_router_id).second) {
+                curr_router_id = next_router_id;
+                return direction_link;
+            }
+        }
+        // the first link was not usable, look for another one below
+    }
+
     // get all the outgoing links for the current router
     const std::vector<NocLinkId>& router_connections = noc_model.get_noc_router_outgoing_links(curr_router_id);
 
@@ -121,40 +134,8 @@ NocLinkId TurnModelRouting::move_to_next_router(NocRouterId& curr_router_id,
          * the direction the algorithm determined we must travel in.
          * If the directions do not match, then this link is not valid.
          */
-        switch (next_step_direction) {
-            case TurnModelRouting::Direction::WEST:
-                if (next_router_position.x < curr_router_position.x) {
-                    found_next_router = true;
-                }
-                break;
-            case TurnModelRouting::Direction::EAST:
-                if (next_router_position.x > curr_router_position.x) {
-                    found_next_router = true;
-                }
-                break;
-            case TurnModelRouting::Direction::NORTH:
-                if (next_router_position.y > curr_router_position.y) {
-                    found_next_router = true;
-                }
-                break;
-            case TurnModelRouting::Direction::SOUTH:
-                if (next_router_position.y < curr_router_position.y) {
-                    found_next_router = true;
-                }
-                break;
-            case TurnModelRouting::Direction::UP:
-                if (next_router_position.layer_num > curr_router_position.layer_num) {
-                    found_next_router = true;
-                }
-                break;
-            case TurnModelRouting::Direction::DOWN:
-                if (next_router_position.layer_num < curr_router_position.layer_num) {
-                    found_next_router = true;
-                }
-                break;
-            default:
-                break;
-        }
+        found_next_router = is_move_in_direction(curr_router_position, next_router_position, next_step_direction);
+
         // check whether the next router we will visit was already visited
         if (visited_routers.find(next_router_id) != visited_routers.end()) {
             visited_next_router = true;
@@ -181,6 +162,54 @@ NocLinkId TurnModelRouting::move_to_next_router(NocRouterId& curr_router_id,
     return next_link;
 }
 
+bool TurnModelRouting::is_move_in_direction(const t_physical_tile_loc& curr_router_position,
+                                            const t_physical_tile_loc& next_router_position,
+                                            TurnModelRouting::Direction direction) {
+    switch (direction) {
+        case TurnModelRouting::Direction::WEST:
+            return next_router_position.x < curr_router_position.x;
+        case TurnModelRouting::Direction::EAST:
+            return next_router_position.x > curr_router_position.x;
+        case TurnModelRouting::Direction::NORTH:
+            return next_router_position.y > curr_router_position.y;
+        case TurnModelRouting::Direction::SOUTH:
+            return next_router_position.y < curr_router_position.y;
+        case TurnModelRouting::Direction::UP:
+            return next_router_position.layer_num > curr_router_position.layer_num;
+        case TurnModelRouting::Direction::DOWN:
+            return next_router_position.layer_num < curr_router_position.layer_num;
+        default:
+            return false;
+    }
+}
+
+void TurnModelRouting::build_direction_links(const NocStorage& noc_model) {
+    std::array<NocLinkId, (size_t)TurnModelRouting::Direction::N_DIRECTIONS> no_links;
+    no_links.fill(NocLinkId::INVALID());
+
+    direction_links.clear();
+    direction_links.resize(noc_model.get_number_of_noc_routers(), no_links);
+
+    for (size_t router = 0; router < direction_links.size(); router++) {
+        NocRouterId router_id(router);
+        const t_physical_tile_loc router_pos = noc_model.get_single_noc_router(router_id).get_router_physical_location();
+
+        // keep the first link in each direction, as move_to_next_router() would
+        for (NocLinkId link_id : noc_model.get_noc_router_outgoing_links(router_id)) {
+            NocRouterId next_router_id = noc_model.get_single_noc_link(link_id).get_sink_router();
+            const t_physical_tile_loc next_router_pos = noc_model.get_single_noc_router(next_router_id).get_router_physical_location();
+
+            for (size_t dir = 0; dir < direction_links[router_id].size(); dir++) {
+                if (!direction_links[router_id][dir] && is_move_in_direction(router_pos, next_router_pos, (TurnModelRouting::Direction)dir)) {
+                    direction_links[router_id][dir] = link_id;
+                }
+            }
+        }
+    }
+
+    direction_links_noc_model = &noc_model;
+}
+
 uint32_t TurnModelRouting::murmur3_32(const std::vector<uint32_t>& key, uint32_t seed) {
     uint32_t h = seed;
 
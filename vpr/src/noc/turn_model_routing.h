@@ -49,6 +49,11 @@
  *
  * TurnModelRouting also provides multiple helper methods that can be used
  * by derived classes.
+ *
+ * Moving to the next router in the selected direction requires finding an
+ * outgoing link of the current router in that direction. The first such link
+ * of each router can be precomputed (build_direction_links()) so that each
+ * step of a route is a table lookup.
  */
 
 #include "noc_routing.h"
@@ -91,6 +96,13 @@ class TurnModelRouting : public NocRouting {
                     std::vector<NocLinkId>& flow_route,
                     const NocStorage& noc_model) override;
 
+    /**
+     * @brief When several directions are legal, the next one is selected
+     * based on (a hash of) the traffic flow id among others, so traffic
+     * flows between the same routers can take different routes.
+     */
+    bool route_depends_on_traffic_flow() const override { return true; }
+
     /**
      * @brief Turn model algorithms forbid specific turns in the mesh topology
      * to guarantee deadlock-freedom. This function finds all illegal turns
@@ -102,6 +114,18 @@ class TurnModelRouting : public NocRouting {
      */
     std::vector<std::pair<NocLinkId, NocLinkId>> get_all_illegal_turns(const NocStorage& noc_model) const;
 
+    /**
+     * @brief Finds the first outgoing link of each NoC router in each direction,
+     * which route_flow() then looks up instead of going through all the outgoing
+     * links of the routers it visits. The table stores a link per router and
+     * direction (not a next hop per pair of routers), so its size is linear
+     * in the number of routers. It is optional, and only used when routing
+     * in the NoC model it was built for.
+     *
+     * @param noc_model Contains NoC router and link connectivity information.
+     */
+    void build_direction_links(const NocStorage& noc_model);
+
     /**
      * @brief Determines whether a turn specified by 3 NoC routers visited in the turn
      * is legal. Turn model routing algorithms forbid specific turns in the mesh topology
@@ -209,6 +233,14 @@ class TurnModelRouting : public NocRouting {
                                   std::unordered_set<NocRouterId>& visited_routers,
                                   const NocStorage& noc_model);
 
+    /**
+     * @brief Checks whether travelling from a router at curr_router_position
+     * to one at next_router_position moves in the given direction.
+     */
+    static bool is_move_in_direction(const t_physical_tile_loc& curr_router_position,
+                                     const t_physical_tile_loc& next_router_position,
+                                     TurnModelRouting::Direction direction);
+
 
     /**
      * @brief Computes MurmurHash3 for an array of 32-bit words initialized
@@ -275,6 +307,11 @@ class TurnModelRouting : public NocRouting {
   private:
     std::vector<uint32_t> inputs_to_murmur3_hasher{4};
 
+    // first outgoing link of each router in each direction (INVALID if there is none), see build_direction_links()
+    vtr::vector<NocRouterId, std::array<NocLinkId, (size_t)TurnModelRouting::Direction::N_DIRECTIONS>> direction_links;
+    // the NoC model direction_links was built for
+    const NocStorage* direction_links_noc_model = nullptr;
+
 };
 
 #endif //VTR_TURN_MODEL_ROUTING_H
@@ -92,6 +92,9 @@ class XYRouting : public TurnModelRouting {
   public:
     ~XYRouting() override;
 
+    /// There is always a single legal direction in XY routing
+    bool route_depends_on_traffic_flow() const override { return false; }
+
   private:
     const std::vector<TurnModelRouting::Direction>& get_legal_directions(NocRouterId src_router_id,
                                                                          NocRouterId curr_router_id,
@@ -48,6 +48,7 @@
 #include "cluster_util.h"
 #include "constraints_report.h"
 #include "globals.h"
+#include "incremental_pack.h"
 #include "prepack.h"
 #include "timing_info.h"
 #include "vpr_types.h"
@@ -77,6 +78,7 @@ std::map<t_logical_block_type_ptr, size_t> do_clustering(const t_packer_opts& pa
                                                          AttractionInfo& attraction_groups,
                                                          bool& floorplan_regions_overfull,
                                                          const t_pack_high_fanout_thresholds& high_fanout_thresholds,
+                                                         const std::vector<t_previous_cluster>& previous_clusters,
                                                          t_clustering_data& clustering_data) {
     /* Does the actual work of clustering multiple netlist blocks *
      * into clusters.                                                  */
@@ -107,7 +109,7 @@ std::map<t_logical_block_type_ptr, size_t> do_clustering(const t_packer_opts& pa
     const int verbosity = packer_opts.pack_verbosity;
 
     int unclustered_list_head_size;
-    std::unordered_map<AtomNetId, int> net_output_feeds_driving_block_input;
+    vtr::flat_hash_map<AtomNetId, int> net_output_feeds_driving_block_input;
 
     cluster_stats.num_molecules_processed = 0;
     cluster_stats.mols_since_last_print = 0;
@@ -184,16 +186,37 @@ std::map<t_logical_block_type_ptr, size_t> do_clustering(const t_packer_opts& pa
                                  clustering_delay_calc, timing_info, atom_criticality);
     }
 
-    // Assign gain scores to atoms and sort them based on the scores.
-    auto seed_atoms = initialize_seed_atoms(packer_opts.cluster_seed_type,
-                                            max_molecule_stats,
-                                            prepacker,
-                                            atom_criticality);
+    // Re-create the unchanged clusters of a previous packing (if any). Only the
+    // molecules left unclustered are clustered below.
+    if (!previous_clusters.empty()) {
+        cluster_stats.num_molecules_processed += reuse_previous_clusters(previous_clusters, prepacker, cluster_legalizer, verbosity);
+        for (LegalizationClusterId cluster_id : cluster_legalizer.clusters()) {
+            num_used_type_instances[cluster_legalizer.get_cluster_type(cluster_id)]++;
+            store_cluster_info_and_free(packer_opts, cluster_id, logic_block_type, le_pb_type, le_count, cluster_legalizer, clb_inter_blk_nets);
+            if (packer_opts.timing_driven && packer_opts.timing_update_interval > 0) {
+                invalidate_intra_cluster_timing(cluster_id, cluster_legalizer, *clustering_delay_calc, *timing_info);
+            }
+            cluster_legalizer.clean_cluster(cluster_id);
+            total_clb_num++;
+        }
+        // The reused clusters are known before any new cluster grows
+        if (packer_opts.timing_driven && packer_opts.timing_update_interval > 0) {
+            timing_info->update();
+            calc_atom_criticality(*timing_info, atom_criticality);
+        }
+        // Their atoms no longer pull the new clusters
+        if (attraction_groups.num_attraction_groups() > 0) {
+            rebuild_attraction_groups(attraction_groups, cluster_legalizer);
+        }
+    }
+
+    // Assign gain scores to atoms and queue them based on the scores.
+    ClusterSeedQueue seed_atoms = initialize_seed_atoms(packer_opts.cluster_seed_type,
+                                                        max_molecule_stats,
+                                                        prepacker,
+                                                        atom_criticality);
 
-    /* index of next most timing critical block */
-    int seed_index = 0;
-    istart = get_highest_gain_seed_molecule(seed_index,
-                                            seed_atoms,
+    istart = get_highest_gain_seed_molecule(seed_atoms,
                                             prepacker,
                                             cluster_legalizer);
 
@@ -205,7 +228,6 @@ std::map<t_logical_block_type_ptr, size_t> do_clustering(const t_packer_opts& pa
 
     while (istart != nullptr) {
         bool is_cluster_legal = false;
-        int saved_seed_index = seed_index;
         // The basic algorithm:
         // 1) Try to put all the molecules in that you can without doing the
         //    full intra-lb route. Then do full legalization at the end.
@@ -347,8 +369,7 @@ std::map<t_logical_block_type_ptr, size_t> do_clustering(const t_packer_opts& pa
 
             if (is_cluster_legal) {
                 // Pick new seed.
-                istart = get_highest_gain_seed_molecule(seed_index,
-                                                        seed_atoms,
+                istart = get_highest_gain_seed_molecule(seed_atoms,
                                                         prepacker,
                                                         cluster_legalizer);
                 // Update cluster stats.
@@ -356,6 +377,28 @@ std::map<t_logical_block_type_ptr, size_t> do_clustering(const t_packer_opts& pa
                     cluster_stats.blocks_since_last_analysis += num_blocks_hill_added;
 
                 store_cluster_info_and_free(packer_opts, legalization_cluster_id, logic_block_type, le_pb_type, le_count, cluster_legalizer, clb_inter_blk_nets);
+                // Update the timing of the connections closed into the cluster.
+                if (packer_opts.timing_driven && packer_opts.timing_update_interval > 0) {
+                    invalidate_intra_cluster_timing(legalization_cluster_id, cluster_legalizer, *clustering_delay_calc, *timing_info);
+                    cluster_stats.clusters_since_last_timing_update++;
+                    if (cluster_stats.clusters_since_last_timing_update >= packer_opts.timing_update_interval) {
+                        timing_info->update();
+                        cluster_stats.clusters_since_last_timing_update = 0;
+
+                        // Requeue the remaining seeds by their updated criticality
+                        if (seed_gains_depend_on_criticality(packer_opts.cluster_seed_type)) {
+                            calc_atom_criticality(*timing_info, atom_criticality);
+                            update_seed_gains(seed_atoms,
+                                              packer_opts.cluster_seed_type,
+                                              max_molecule_stats,
+                                              prepacker,
+                                              atom_criticality);
+                            istart = get_highest_gain_seed_molecule(seed_atoms,
+                                                                    prepacker,
+                                                                    cluster_legalizer);
+                        }
+                    }
+                }
                 // Since the cluster will no longer be added to beyond this point,
                 // clean the cluster of any data not strictly necessary for
                 // creating the clustered netlist.
@@ -364,7 +407,6 @@ std::map<t_logical_block_type_ptr, size_t> do_clustering(const t_packer_opts& pa
                 // If the cluster is not legal, requeue used mols.
                 num_used_type_instances[cluster_legalizer.get_cluster_type(legalization_cluster_id)]--;
                 total_clb_num--;
-                seed_index = saved_seed_index;
                 // Destroy the illegal cluster.
                 cluster_legalizer.destroy_cluster(legalization_cluster_id);
                 cluster_legalizer.compress();
@@ -3,6 +3,7 @@
 
 #include <map>
 #include <unordered_set>
+#include <vector>
 
 #include "physical_types.h"
 #include "vpr_types.h"
@@ -13,6 +14,7 @@ class ClusterLegalizer;
 class ClusteredNetlist;
 class Prepacker;
 struct t_clustering_data;
+struct t_previous_cluster;
 
 std::map<t_logical_block_type_ptr, size_t> do_clustering(const t_packer_opts& packer_opts,
                                                          const t_analysis_opts& analysis_opts,
@@ -26,6 +28,7 @@ std::map<t_logical_block_type_ptr, size_t> do_clustering(const t_packer_opts& pa
                                                          AttractionInfo& attraction_groups,
                                                          bool& floorplan_regions_overfull,
                                                          const t_pack_high_fanout_thresholds& high_fanout_thresholds,
+                                                         const std::vector<t_previous_cluster>& previous_clusters,
                                                          t_clustering_data& clustering_data);
 
 void print_pb_type_count(const ClusteredNetlist& clb_nlist);
@@ -38,6 +38,9 @@
 #include "vtr_vector.h"
 #include "vtr_vector_map.h"
 
+/// @brief Memory budget of the cache of unroutable intra-lb routing problems.
+static constexpr size_t INTRA_LB_ROUTE_CACHE_MAX_BYTES = 64 * 1024 * 1024;
+
 /*
  * @brief Gets the max cluster size that any logical block can have.
  *
@@ -71,24 +74,20 @@ static void alloc_and_load_pb_stats(t_pb* pb, const int feasible_block_array_siz
     pb->pb_stats->lookahead_output_pins_used = std::vector<std::vector<AtomNetId>>(pb->pb_graph_node->num_output_pin_class);
     pb->pb_stats->num_feasible_blocks = NOT_VALID;
     pb->pb_stats->feasible_blocks = new t_pack_molecule*[feasible_block_array_size];
+    pb->pb_stats->feasible_block_gains = new float[feasible_block_array_size];
 
-    for (int i = 0; i < feasible_block_array_size; i++)
+    for (int i = 0; i < feasible_block_array_size; i++) {
         pb->pb_stats->feasible_blocks[i] = nullptr;
+        pb->pb_stats->feasible_block_gains[i] = 0.;
+    }
 
     pb->pb_stats->tie_break_high_fanout_net = AtomNetId::INVALID();
 
     pb->pb_stats->pulled_from_atom_groups = 0;
     pb->pb_stats->num_att_group_atoms_used = 0;
 
-    pb->pb_stats->gain.clear();
-    pb->pb_stats->timinggain.clear();
-    pb->pb_stats->connectiongain.clear();
-    pb->pb_stats->sharinggain.clear();
-    pb->pb_stats->hillgain.clear();
     pb->pb_stats->transitive_fanout_candidates.clear();
 
-    pb->pb_stats->num_pins_of_net_in_pb.clear();
-
     pb->pb_stats->num_child_blocks_in_pb = 0;
 
     pb->pb_stats->explore_transitive_fanout = true;
@@ -163,12 +162,7 @@ static void record_molecule_failure(t_pack_molecule* molecule, t_pb* pb) {
     //The convention when checking if a molecule has failed to pack in the cluster
     //is to check whether the first atoms has been recorded as having failed
 
-    auto got = pb->pb_stats->atom_failures.find(molecule->atom_block_ids[0]);
-    if (got == pb->pb_stats->atom_failures.end()) {
-        pb->pb_stats->atom_failures.insert({molecule->atom_block_ids[0], 1});
-    } else {
-        got->second++;
-    }
+    pb->pb_stats->gain_stats->atom_failures[molecule->atom_block_ids[0]]++;
 }
 
 /**
@@ -1446,15 +1440,21 @@ ClusterLegalizer::start_new_cluster(t_pack_molecule* molecule,
     t_pb* cluster_pb = new t_pb;
     cluster_pb->pb_graph_node = cluster_type->pb_graph_head;
     alloc_and_load_pb_stats(cluster_pb, feasible_block_array_size_);
+    // The gain tables are shared by all clusters; the previous cluster's
+    // gains are no longer needed once a new cluster is started.
+    gain_stats_.clear();
+    cluster_pb->pb_stats->gain_stats = &gain_stats_;
     cluster_pb->parent_pb = nullptr;
     cluster_pb->mode = cluster_mode;
 
     // Allocate and load the LB router data
     t_lb_router_data* router_data = alloc_and_load_router_data(&lb_type_rr_graphs_[cluster_type->index],
                                                                cluster_type);
+    router_data->route_cache = &intra_lb_route_cache_;
 
     // Allocate and load the cluster's placement stats
     t_cluster_placement_stats* cluster_placement_stats = alloc_and_load_cluster_placement_stats(cluster_type, cluster_mode);
+    cluster_placement_stats->set_feasibility_table(&primitive_feasibility_tables_[cluster_type->index]);
 
     // Create the new cluster
     LegalizationCluster new_cluster;
@@ -1635,14 +1635,16 @@ bool ClusterLegalizer::check_cluster_legality(LegalizationClusterId cluster_id)
 ClusterLegalizer::ClusterLegalizer(const AtomNetlist& atom_netlist,
                                    const Prepacker& prepacker,
                                    const std::vector<t_logical_block_type>& logical_block_types,
-                                   std::vector<t_lb_type_rr_node>* lb_type_rr_graphs,
+                                   t_lb_type_rr_graph* lb_type_rr_graphs,
                                    size_t num_models,
                                    const std::vector<std::string>& target_external_pin_util_str,
                                    const t_pack_high_fanout_thresholds& high_fanout_thresholds,
                                    ClusterLegalizationStrategy cluster_legalization_strategy,
                                    bool enable_pin_feasibility_filter,
                                    int feasible_block_array_size,
-                                   int log_verbosity) : prepacker_(prepacker) {
+                                   int log_verbosity)
+    : prepacker_(prepacker)
+    , intra_lb_route_cache_(INTRA_LB_ROUTE_CACHE_MAX_BYTES) {
     // Verify that the inputs are valid.
     VTR_ASSERT_SAFE(lb_type_rr_graphs != nullptr);
 
@@ -1652,6 +1654,13 @@ ClusterLegalizer::ClusterLegalizer(const AtomNetlist& atom_netlist,
 
     // Resize the atom_cluster lookup to make the accesses much cheaper.
     atom_cluster_.resize(atom_netlist.blocks().size(), LegalizationClusterId::INVALID());
+    // Size the gain tables shared by the clusters for the whole netlist.
+    gain_stats_.init(atom_netlist.blocks().size(), atom_netlist.nets().size());
+    // Pre-compute which primitives of each logical block type each atom fits in.
+    primitive_feasibility_tables_.resize(logical_block_types.size());
+    for (const t_logical_block_type& blk_type : logical_block_types) {
+        primitive_feasibility_tables_[blk_type.index].init(&blk_type, atom_netlist);
+    }
     // Pre-compute the max size of any molecule.
     max_molecule_size_ = prepacker.get_max_molecule_size();
     // Calculate the max cluster size
@@ -15,9 +15,13 @@
 #include <unordered_map>
 #include <vector>
 #include "atom_netlist_fwd.h"
+#include "cluster_placement.h"
+#include "cluster_router.h"
 #include "noc_data_types.h"
+#include "pack_types.h"
 #include "partition_region.h"
 #include "vpr_types.h"
+#include "vtr_flat_hash_map.h"
 #include "vtr_range.h"
 #include "vtr_strong_id.h"
 #include "vtr_vector.h"
@@ -245,7 +249,7 @@ public:
     ClusterLegalizer(const AtomNetlist& atom_netlist,
                      const Prepacker& prepacker,
                      const std::vector<t_logical_block_type>& logical_block_types,
-                     std::vector<t_lb_type_rr_node>* lb_type_rr_graphs,
+                     t_lb_type_rr_graph* lb_type_rr_graphs,
                      size_t num_models,
                      const std::vector<std::string>& target_external_pin_util_str,
                      const t_pack_high_fanout_thresholds& high_fanout_thresholds,
@@ -420,6 +424,13 @@ public:
         return cluster.pr;
     }
 
+    /// @brief Gets the molecules packed in the given cluster.
+    inline const std::vector<t_pack_molecule*>& get_cluster_molecules(LegalizationClusterId cluster_id) const {
+        VTR_ASSERT_SAFE(cluster_id.is_valid() && (size_t)cluster_id < legalization_clusters_.size());
+        const LegalizationCluster& cluster = legalization_clusters_[cluster_id];
+        return cluster.molecules;
+    }
+
     /// @brief Gets the ID of the cluster that contains the given atom block.
     inline LegalizationClusterId get_atom_cluster(AtomBlockId blk_id) const {
         VTR_ASSERT_SAFE(blk_id.is_valid() && (size_t)blk_id < atom_cluster_.size());
@@ -477,6 +488,12 @@ public:
         log_verbosity_ = verbosity;
     }
 
+    /// @brief Gets the cache of unroutable intra-lb routing problems, e.g. to
+    ///        report its hit rate.
+    inline const IntraLbRouteCache& get_intra_lb_route_cache() const {
+        return intra_lb_route_cache_;
+    }
+
     /// @brief Destructor of the class. Frees allocated data.
     ~ClusterLegalizer();
 
@@ -486,7 +503,7 @@ private:
     vtr::vector_map<LegalizationClusterId, LegalizationClusterId> legalization_cluster_ids_;
 
     /// @brief Lookup table for which cluster each molecule is in.
-    std::unordered_map<t_pack_molecule*, LegalizationClusterId> molecule_cluster_;
+    vtr::flat_hash_map<t_pack_molecule*, LegalizationClusterId> molecule_cluster_;
 
     /// @brief List of all legalization clusters.
     vtr::vector_map<LegalizationClusterId, LegalizationCluster> legalization_clusters_;
@@ -519,7 +536,7 @@ private:
     ///        [0 .. num_logical_block_types-1]
     /// TODO: This really should not be a pointer to a vector... I think this is
     ///       meant to be a vector of vectors...
-    std::vector<t_lb_type_rr_node>* lb_type_rr_graphs_ = nullptr;
+    t_lb_type_rr_graph* lb_type_rr_graphs_ = nullptr;
 
     /// @brief The total number of models (user + library) in the architecture.
     ///        Used to allocate space in dynamic data structures.
@@ -554,5 +571,22 @@ private:
     /// @brief The prepacker object that stores the molecules which will be
     ///        legalized into clusters.
     const Prepacker& prepacker_;
+
+    /// @brief The gain tables of the most recently started cluster, indexed by
+    ///        atom block / net ID. Shared by all clusters (and referenced by
+    ///        the pb_stats of their top-level pb) so that starting a cluster
+    ///        only clears them, rather than allocating new tables.
+    t_pb_gain_stats gain_stats_;
+
+    /// @brief Intra-lb routing problems known to be unroutable, shared by all
+    ///        clusters. Kept across reset(), since the lb rr graphs do not
+    ///        change between packing iterations.
+    IntraLbRouteCache intra_lb_route_cache_;
+
+    /// @brief The primitive pb_types each atom could be placed into, for each
+    ///        logical block type [0..num_logical_block_types-1]. Used by the
+    ///        cluster placement stats to quickly check if a cluster has a free
+    ///        primitive for an atom.
+    std::vector<t_primitive_feasibility_table> primitive_feasibility_tables_;
 };
 
@@ -18,6 +18,7 @@
  */
 
 #include "cluster_placement.h"
+#include "atom_netlist.h"
 #include "hash.h"
 #include "physical_types.h"
 #include "vpr_types.h"
@@ -146,6 +147,95 @@ void t_cluster_placement_stats::free_primitives() {
     }
 }
 
+/* Collects the distinct primitive pb_types below pb_graph_node, in the order they are first found */
+static void collect_primitive_pb_types(const t_pb_graph_node* pb_graph_node,
+                                       std::unordered_map<const t_pb_type*, int>& pb_type_ids) {
+    const t_pb_type* pb_type = pb_graph_node->pb_type;
+    if (pb_type->modes == nullptr) {
+        pb_type_ids.insert({pb_type, (int)pb_type_ids.size()});
+        return;
+    }
+    for (int i = 0; i < pb_type->num_modes; i++) {
+        for (int j = 0; j < pb_type->modes[i].num_pb_type_children; j++) {
+            for (int k = 0; k < pb_type->modes[i].pb_type_children[j].num_pb; k++) {
+                collect_primitive_pb_types(&pb_graph_node->child_pb_graph_nodes[i][j][k], pb_type_ids);
+            }
+        }
+    }
+}
+
+void t_primitive_feasibility_table::init(t_logical_block_type_ptr cluster_type, const AtomNetlist& atom_nlist) {
+    pb_type_ids_.clear();
+    if (!is_empty_type(cluster_type)) {
+        collect_primitive_pb_types(cluster_type->pb_graph_head, pb_type_ids_);
+    }
+    num_words_ = (pb_type_ids_.size() + 63) / 64;
+
+    // Group the pb_types by model, so each atom is only tested against the pb_types of its model
+    std::unordered_map<const t_model*, std::vector<std::pair<const t_pb_type*, int>>> model_pb_types;
+    for (const auto& pb_type_id : pb_type_ids_) {
+        model_pb_types[pb_type_id.first->model].push_back(pb_type_id);
+    }
+
+    feasible_bits_.assign(atom_nlist.blocks().size() * num_words_, 0);
+    for (AtomBlockId blk_id : atom_nlist.blocks()) {
+        auto it = model_pb_types.find(atom_nlist.block_model(blk_id));
+        if (it == model_pb_types.end()) {
+            continue;
+        }
+        uint64_t* bits = &feasible_bits_[size_t(blk_id) * num_words_];
+        for (const auto& [pb_type, id] : it->second) {
+            if (primitive_type_feasible(blk_id, pb_type)) {
+                bits[id / 64] |= uint64_t(1) << (id % 64);
+            }
+        }
+    }
+}
+
+void t_cluster_placement_stats::set_feasibility_table(const t_primitive_feasibility_table* table) {
+    feasibility_table = table;
+    num_free_primitives.assign(table->num_pb_types(), 0);
+    free_pb_types.assign(table->num_words(), 0);
+
+    for (const auto& node_primitive : pb_graph_node_placement_primitive) {
+        if (node_primitive.second->valid) {
+            int id = table->pb_type_id(node_primitive.first->pb_type);
+            num_free_primitives[id]++;
+            free_pb_types[id / 64] |= uint64_t(1) << (id % 64);
+        }
+    }
+}
+
+void t_cluster_placement_stats::invalidate_primitive(t_cluster_placement_primitive* placement_primitive) {
+    if (!placement_primitive->valid) {
+        return;
+    }
+    placement_primitive->valid = false;
+
+    if (feasibility_table != nullptr) {
+        int id = feasibility_table->pb_type_id(placement_primitive->pb_graph_node->pb_type);
+        VTR_ASSERT_SAFE(num_free_primitives[id] > 0);
+        if (--num_free_primitives[id] == 0) {
+            free_pb_types[id / 64] &= ~(uint64_t(1) << (id % 64));
+        }
+    }
+}
+
+bool t_cluster_placement_stats::has_free_feasible_primitive(AtomBlockId blk_id) const {
+    VTR_ASSERT_SAFE(feasibility_table != nullptr);
+    const uint64_t* feasible = feasibility_table->feasible_pb_types(blk_id);
+    for (size_t iword = 0; iword < free_pb_types.size(); iword++) {
+        if (feasible[iword] & free_pb_types[iword]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool t_cluster_placement_stats::intermediate_queues_empty() const {
+    return in_flight.empty() && tried.empty();
+}
+
 t_cluster_placement_stats* alloc_and_load_cluster_placement_stats(t_logical_block_type_ptr cluster_type,
                                                                   int cluster_mode) {
     t_cluster_placement_stats* cluster_placement_stats = new t_cluster_placement_stats;
@@ -390,7 +480,7 @@ void commit_primitive(t_cluster_placement_stats* cluster_placement_stats,
     cur = cluster_placement_stats->get_pb_graph_node_placement_primitive(primitive);
     VTR_ASSERT(cur->valid == true);
 
-    cur->valid = false;
+    cluster_placement_stats->invalidate_primitive(cur);
     incr_cost = -0.01; /* cost of using a node drops as its neighbours are used, this drop should be small compared to scarcity values */
 
     pb_graph_node = cur->pb_graph_node;
@@ -452,7 +542,7 @@ static void update_primitive_cost_or_status(t_cluster_placement_stats* cluster_p
         if (valid) {
             placement_primitive->incremental_cost += incremental_cost;
         } else {
-            placement_primitive->valid = false;
+            cluster_placement_stats->invalidate_primitive(placement_primitive);
         }
     } else {
         for (i = 0; i < pb_graph_node->pb_type->num_modes; i++) {
@@ -699,6 +789,15 @@ bool exists_free_primitive_for_atom_block(t_cluster_placement_stats* cluster_pla
                                           const AtomBlockId blk_id) {
     int i;
 
+    /* Between molecules no primitive is in flight or tried, and every valid primitive
+     * is free, so the summary of free pb_types answers exactly */
+    if (cluster_placement_stats->has_feasibility_table()) {
+        bool has_free_primitive = cluster_placement_stats->has_free_feasible_primitive(blk_id);
+        if (!has_free_primitive || cluster_placement_stats->intermediate_queues_empty()) {
+            return has_free_primitive;
+        }
+    }
+
     /* might have a primitive in flight that's still valid */
     if (!cluster_placement_stats->in_flight_empty()) {
         if (primitive_type_feasible(blk_id,
@@ -6,11 +6,52 @@
 #ifndef CLUSTER_PLACEMENT_H
 #define CLUSTER_PLACEMENT_H
 
+#include <cstdint>
 #include <vector>
 #include <unordered_map>
+#include "atom_netlist_fwd.h"
 #include "physical_types.h"
 #include "vpr_types.h"
 
+/**
+ * @brief Precomputed primitive feasibility of every atom for one logical block type.
+ *
+ * The primitive pb_types of the logical block type are numbered densely, and for
+ * every atom the set of pb_types it could be placed into (as tested by
+ * primitive_type_feasible()) is stored as a bitset. Together with the bitset of
+ * pb_types which still have a free primitive kept by t_cluster_placement_stats,
+ * this lets exists_free_primitive_for_atom_block() answer with a few word-wide
+ * ANDs instead of walking the primitives of the cluster.
+ */
+class t_primitive_feasibility_table {
+  public:
+    /// @brief Numbers the primitive pb_types of cluster_type and computes the feasible pb_types of every atom.
+    void init(t_logical_block_type_ptr cluster_type, const AtomNetlist& atom_nlist);
+
+    /// @brief Number of distinct primitive pb_types in the logical block type
+    inline size_t num_pb_types() const { return pb_type_ids_.size(); }
+
+    /// @brief Number of 64-bit words in each bitset
+    inline size_t num_words() const { return num_words_; }
+
+    /// @brief Returns the dense id of a primitive pb_type of the logical block type.
+    inline int pb_type_id(const t_pb_type* pb_type) const {
+        auto it = pb_type_ids_.find(pb_type);
+        VTR_ASSERT_SAFE(it != pb_type_ids_.end());
+        return it->second;
+    }
+
+    /// @brief Returns the bitset (num_words() long) of the pb_types the atom could be placed into.
+    inline const uint64_t* feasible_pb_types(AtomBlockId blk_id) const {
+        return &feasible_bits_[size_t(blk_id) * num_words_];
+    }
+
+  private:
+    std::unordered_map<const t_pb_type*, int> pb_type_ids_;
+    size_t num_words_ = 0;
+    std::vector<uint64_t> feasible_bits_; ///<[0..num_atoms*num_words-1]
+};
+
 /**
  * @brief Stats keeper for placement within the cluster during packing
  *
@@ -106,6 +147,38 @@ class t_cluster_placement_stats {
      */
     void free_primitives();
 
+    /**
+     * @brief Use the feasibility table of the cluster's logical block type to
+     *        track which pb_types still have a free primitive.
+     *
+     * The table must outlive these stats.
+     */
+    void set_feasibility_table(const t_primitive_feasibility_table* table);
+
+    /**
+     * @brief Returns true if a feasibility table was set
+     */
+    inline bool has_feasibility_table() const {
+        return feasibility_table != nullptr;
+    }
+
+    /**
+     * @brief Mark a placement primitive as no longer usable (occupied, or in a
+     *        mode which is no longer selected)
+     */
+    void invalidate_primitive(t_cluster_placement_primitive* placement_primitive);
+
+    /**
+     * @brief Returns true if some primitive that blk_id could be placed into is
+     *        still free. Requires a feasibility table.
+     */
+    bool has_free_feasible_primitive(AtomBlockId blk_id) const;
+
+    /**
+     * @brief Return true if no primitive is in flight or tried
+     */
+    bool intermediate_queues_empty() const;
+
   private:
     std::unordered_multimap<int, t_cluster_placement_primitive*> in_flight; ///<ptrs to primitives currently being considered to pack into
     std::unordered_multimap<int, t_cluster_placement_primitive*> tried;     ///<ptrs to primitives that are already tried but current logic block unable to pack to
@@ -117,6 +190,10 @@ class t_cluster_placement_stats {
     ///       unique ID per cluster.
     std::unordered_map<const t_pb_graph_node*, t_cluster_placement_primitive*> pb_graph_node_placement_primitive;
 
+    const t_primitive_feasibility_table* feasibility_table = nullptr; ///<feasibility of atoms for the cluster's logical block type (not owned)
+    std::vector<int> num_free_primitives;                             ///<[0..feasibility_table->num_pb_types()-1] valid primitives of each pb_type
+    std::vector<uint64_t> free_pb_types;                              ///<bitset of the pb_types with num_free_primitives > 0
+
     /**
      * @brief iterate over elements of a queue and move its elements to valid_primitives
      *
@@ -20,6 +20,7 @@
 #include <cmath>
 
 #include "vtr_assert.h"
+#include "vtr_hash.h"
 #include "vtr_log.h"
 
 #include "vpr_error.h"
@@ -44,50 +45,22 @@
 enum e_commit_remove { RT_COMMIT,
                        RT_REMOVE };
 
-// TODO: check if this hacky class memory reserve thing is still necessary, if not, then delete
-/* Packing uses a priority queue that requires a large number of elements.  This backdoor
- * allows me to use a priority queue where I can pre-allocate the # of elements in the underlying container
- * for efficiency reasons.  Note: Must use vector with this */
-template<class T, class U, class V>
-class reservable_pq : public std::priority_queue<T, U, V> {
-  public:
-    typedef typename std::priority_queue<T>::size_type size_type;
-    reservable_pq(size_type capacity = 0) {
-        reserve(capacity);
-        cur_cap = capacity;
-    }
-    void reserve(size_type capacity) {
-        this->c.reserve(capacity);
-        cur_cap = capacity;
-    }
-    void clear() {
-        this->c.clear();
-        this->c.reserve(cur_cap);
-    }
-
-  private:
-    size_type cur_cap;
-};
-
 /*****************************************************************************************
  * Internal functions declarations
  ******************************************************************************************/
-static void free_lb_net_rt(t_lb_trace* lb_trace);
-static void free_lb_trace(t_lb_trace* lb_trace);
 static void add_pin_to_rt_terminals(t_lb_router_data* router_data, const AtomPinId pin_id);
 static void remove_pin_from_rt_terminals(t_lb_router_data* router_data, const AtomPinId pin_id);
 
 static void fix_duplicate_equivalent_pins(t_lb_router_data* router_data);
 
-static void commit_remove_rt(t_lb_trace* rt, t_lb_router_data* router_data, e_commit_remove op, std::unordered_map<const t_pb_graph_node*, const t_mode*>* mode_map, t_mode_selection_status* mode_status);
-static bool is_skip_route_net(t_lb_trace* rt, t_lb_router_data* router_data);
+static void commit_remove_rt(const t_lb_trace& rt, t_lb_router_data* router_data, e_commit_remove op, std::unordered_map<const t_pb_graph_node*, const t_mode*>* mode_map, t_mode_selection_status* mode_status);
+static bool is_skip_route_net(const t_lb_trace& rt, t_lb_router_data* router_data);
 static void add_source_to_rt(t_lb_router_data* router_data, int inet);
-static void expand_rt(t_lb_router_data* router_data, int inet, reservable_pq<t_expansion_node, std::vector<t_expansion_node>, compare_expansion_node>& pq, int irt_net);
-static void expand_rt_rec(t_lb_trace* rt, int prev_index, t_explored_node_tb* explored_node_tb, reservable_pq<t_expansion_node, std::vector<t_expansion_node>, compare_expansion_node>& pq, int irt_net, int explore_id_index);
+static void expand_rt(t_lb_router_data* router_data, int inet, t_lb_expansion_pq& pq, int irt_net);
 static bool try_expand_nodes(t_lb_router_data* router_data,
                              t_intra_lb_net* lb_net,
                              t_expansion_node* exp_node,
-                             reservable_pq<t_expansion_node, std::vector<t_expansion_node>, compare_expansion_node>& pq,
+                             t_lb_expansion_pq& pq,
                              int itarget,
                              bool try_other_modes,
                              int verbosity);
@@ -97,22 +70,22 @@ static void expand_edges(t_lb_router_data* router_data,
                          int cur_inode,
                          float cur_cost,
                          int net_fanout,
-                         reservable_pq<t_expansion_node, std::vector<t_expansion_node>, compare_expansion_node>& pq);
+                         t_lb_expansion_pq& pq);
 
-static void expand_node(t_lb_router_data* router_data, t_expansion_node exp_node, reservable_pq<t_expansion_node, std::vector<t_expansion_node>, compare_expansion_node>& pq, int net_fanout);
-static void expand_node_all_modes(t_lb_router_data* router_data, t_expansion_node exp_node, reservable_pq<t_expansion_node, std::vector<t_expansion_node>, compare_expansion_node>& pq, int net_fanout);
+static void expand_node(t_lb_router_data* router_data, t_expansion_node exp_node, t_lb_expansion_pq& pq, int net_fanout);
+static void expand_node_all_modes(t_lb_router_data* router_data, t_expansion_node exp_node, t_lb_expansion_pq& pq, int net_fanout);
 
-static bool add_to_rt(t_lb_trace* rt, int node_index, t_lb_router_data* router_data, int irt_net);
+static bool add_to_rt(t_lb_trace& rt, int node_index, t_lb_router_data* router_data, int irt_net);
 static bool is_route_success(t_lb_router_data* router_data);
-static t_lb_trace* find_node_in_rt(t_lb_trace* rt, int rt_index);
+static int find_node_in_rt(const t_lb_trace& rt, int rt_index);
 static void reset_explored_node_tb(t_lb_router_data* router_data);
 static void save_and_reset_lb_route(t_lb_router_data* router_data);
-static void load_trace_to_pb_route(t_pb_routes& pb_route, const int total_pins, const AtomNetId net_id, const int prev_pin_id, const t_lb_trace* trace);
+static void load_trace_to_pb_route(t_pb_routes& pb_route, const int total_pins, const AtomNetId net_id, const t_lb_trace& trace);
 
 static std::string describe_lb_type_rr_node(int inode,
                                             const t_lb_router_data* router_data);
 
-static std::vector<int> find_congested_rr_nodes(const std::vector<t_lb_type_rr_node>& lb_type_graph,
+static std::vector<int> find_congested_rr_nodes(const t_lb_type_rr_graph& lb_type_graph,
                                                 const t_lb_rr_node_stats* lb_rr_node_stats);
 static std::vector<int> find_incoming_rr_nodes(int dst_node, const t_lb_router_data* router_data);
 static std::string describe_congested_rr_nodes(const std::vector<int>& congested_rr_nodes,
@@ -124,23 +97,28 @@ static std::string describe_congested_rr_nodes(const std::vector<int>& congested
 static void print_route(const char* filename, t_lb_router_data* router_data);
 static void print_route(FILE* fp, t_lb_router_data* router_data);
 #endif
-static void print_trace(FILE* fp, t_lb_trace* trace, t_lb_router_data* router_data);
+static void print_trace(FILE* fp, const t_lb_trace& trace, int inode, t_lb_router_data* router_data);
 
 /*****************************************************************************************
  * Constructor/Destructor functions
  ******************************************************************************************/
 
+/* Returns the scratch state of the intra-logic block router of this thread */
+static t_lb_router_scratch& get_lb_router_scratch() {
+    static thread_local t_lb_router_scratch scratch;
+    return scratch;
+}
+
 /**
  * Build data structures used by intra-logic block router
  */
-t_lb_router_data* alloc_and_load_router_data(std::vector<t_lb_type_rr_node>* lb_type_graph, t_logical_block_type_ptr type) {
+t_lb_router_data* alloc_and_load_router_data(t_lb_type_rr_graph* lb_type_graph, t_logical_block_type_ptr type) {
     t_lb_router_data* router_data = new t_lb_router_data;
     int size;
 
     router_data->lb_type_graph = lb_type_graph;
     size = router_data->lb_type_graph->size();
     router_data->lb_rr_node_stats = new t_lb_rr_node_stats[size];
-    router_data->explored_node_tb = new t_explored_node_tb[size];
     router_data->intra_lb_nets = new std::vector<t_intra_lb_net>;
     router_data->atoms_added = new std::map<AtomBlockId, bool>;
     router_data->lb_type = type;
@@ -153,8 +131,6 @@ void free_router_data(t_lb_router_data* router_data) {
     if (router_data != nullptr && router_data->lb_type_graph != nullptr) {
         delete[] router_data->lb_rr_node_stats;
         router_data->lb_rr_node_stats = nullptr;
-        delete[] router_data->explored_node_tb;
-        router_data->explored_node_tb = nullptr;
         router_data->lb_type_graph = nullptr;
         delete router_data->atoms_added;
         router_data->atoms_added = nullptr;
@@ -165,20 +141,19 @@ void free_router_data(t_lb_router_data* router_data) {
     }
 }
 
-static bool route_has_conflict(t_lb_trace* rt, t_lb_router_data* router_data) {
-    std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
+static bool route_has_conflict(const t_lb_trace& rt, t_lb_router_data* router_data) {
+    t_lb_type_rr_graph& lb_type_graph = *router_data->lb_type_graph;
 
-    int cur_mode = -1;
-    for (unsigned int i = 0; i < rt->next_nodes.size(); i++) {
-        int new_mode = get_lb_type_rr_graph_edge_mode(lb_type_graph,
-                                                      rt->current_node, rt->next_nodes[i].current_node);
-        if (cur_mode != -1 && cur_mode != new_mode) {
-            return true;
-        }
-        if (route_has_conflict(&rt->next_nodes[i], router_data) == true) {
-            return true;
+    for (const t_lb_trace_node& rt_node : rt.nodes) {
+        int cur_mode = -1;
+        for (int ichild = rt_node.first_child; ichild != OPEN; ichild = rt.nodes[ichild].next_sibling) {
+            int new_mode = get_lb_type_rr_graph_edge_mode(lb_type_graph,
+                                                          rt_node.current_node, rt.nodes[ichild].current_node);
+            if (cur_mode != -1 && cur_mode != new_mode) {
+                return true;
+            }
+            cur_mode = new_mode;
         }
-        cur_mode = new_mode;
     }
 
     return false;
@@ -343,7 +318,7 @@ void set_reset_pb_modes(t_lb_router_data* router_data, const t_pb* pb, const boo
 static bool try_expand_nodes(t_lb_router_data* router_data,
                              t_intra_lb_net* lb_net,
                              t_expansion_node* exp_node,
-                             reservable_pq<t_expansion_node, std::vector<t_expansion_node>, compare_expansion_node>& pq,
+                             t_lb_expansion_pq& pq,
                              int itarget,
                              bool try_other_modes,
                              int verbosity) {
@@ -397,6 +372,34 @@ static bool try_expand_nodes(t_lb_router_data* router_data,
     return is_impossible;
 }
 
+/* Builds the canonical signature of the current routing problem for the route cache:
+ * the lb type, the terminals of each net in routing order (with their fixed flags),
+ * and the mode of every lb rr node which has one selected.
+ */
+static IntraLbRouteCache::t_signature build_route_signature(const t_lb_router_data* router_data) {
+    const std::vector<t_intra_lb_net>& lb_nets = *router_data->intra_lb_nets;
+    IntraLbRouteCache::t_signature signature;
+
+    signature.push_back(router_data->lb_type->index);
+    signature.push_back(lb_nets.size());
+    for (const t_intra_lb_net& lb_net : lb_nets) {
+        signature.push_back(lb_net.terminals.size());
+        for (size_t iterm = 0; iterm < lb_net.terminals.size(); iterm++) {
+            bool fixed = iterm < lb_net.fixed_terminals.size() && lb_net.fixed_terminals[iterm];
+            signature.push_back(2 * lb_net.terminals[iterm] + (fixed ? 1 : 0));
+        }
+    }
+    for (size_t inode = 0; inode < router_data->lb_type_graph->size(); inode++) {
+        int mode = router_data->lb_rr_node_stats[inode].mode;
+        if (mode != -1) {
+            signature.push_back(inode);
+            signature.push_back(mode);
+        }
+    }
+
+    return signature;
+}
+
 /* Attempt to route routing driver/targets on the current architecture
  * Follows pathfinder negotiated congestion algorithm
  */
@@ -404,24 +407,45 @@ bool try_intra_lb_route(t_lb_router_data* router_data,
                         int verbosity,
                         t_mode_selection_status* mode_status) {
     std::vector<t_intra_lb_net>& lb_nets = *router_data->intra_lb_nets;
-    std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
+    t_lb_type_rr_graph& lb_type_graph = *router_data->lb_type_graph;
     bool is_routed = false;
     bool is_impossible = false;
 
     mode_status->is_mode_conflict = false;
     mode_status->try_expand_all_modes = false;
 
+    /* Problems routed without expanding all modes depend only on the signature, so a known
+     * failure can be answered from the cache. With expand_all_modes the result also depends
+     * on the illegal modes found so far, which are not part of the signature. */
+    IntraLbRouteCache::t_signature signature;
+    bool use_route_cache = router_data->route_cache != nullptr && !mode_status->expand_all_modes;
+    if (use_route_cache) {
+        signature = build_route_signature(router_data);
+        if (router_data->route_cache->is_known_unroutable(signature)) {
+            VTR_LOGV(verbosity > 3, "Cluster is known to be unroutable within proposed %s cluster (cached)\n",
+                     router_data->lb_type->name);
+            for (unsigned int inet = 0; inet < lb_nets.size(); inet++) {
+                lb_nets[inet].rt_tree.clear();
+            }
+            return false;
+        }
+    }
+
     t_expansion_node exp_node;
 
-    /* Stores state info during route */
-    reservable_pq<t_expansion_node, std::vector<t_expansion_node>, compare_expansion_node> pq;
+    /* Stores state info during route, in the scratch state of this thread */
+    t_lb_router_scratch& scratch = get_lb_router_scratch();
+    if (scratch.explored_node_tb.size() < lb_type_graph.size()) {
+        scratch.explored_node_tb.resize(lb_type_graph.size());
+    }
+    router_data->explored_node_tb = scratch.explored_node_tb.data();
+    t_lb_expansion_pq& pq = scratch.pq;
 
     reset_explored_node_tb(router_data);
 
     /* Reset current routing */
     for (unsigned int inet = 0; inet < lb_nets.size(); inet++) {
-        free_lb_net_rt(lb_nets[inet].rt_tree);
-        lb_nets[inet].rt_tree = nullptr;
+        lb_nets[inet].rt_tree.clear();
     }
     for (unsigned int inode = 0; inode < lb_type_graph.size(); inode++) {
         router_data->lb_rr_node_stats[inode].historical_usage = 0;
@@ -442,8 +466,7 @@ bool try_intra_lb_route(t_lb_router_data* router_data,
                 continue;
             }
             commit_remove_rt(lb_nets[idx].rt_tree, router_data, RT_REMOVE, &mode_map, mode_status);
-            free_lb_net_rt(lb_nets[idx].rt_tree);
-            lb_nets[idx].rt_tree = nullptr;
+            lb_nets[idx].rt_tree.clear();
             add_source_to_rt(router_data, idx);
 
             /* Route each sink of net */
@@ -469,7 +492,7 @@ bool try_intra_lb_route(t_lb_router_data* router_data,
                 if (verbosity > 5) {
                     VTR_LOG("Routing finished\n");
                     VTR_LOG("\tS");
-                    print_trace(stdout, lb_nets[idx].rt_tree, router_data);
+                    print_trace(stdout, lb_nets[idx].rt_tree, 0, router_data);
                     VTR_LOG("\n");
                 }
 
@@ -531,13 +554,69 @@ bool try_intra_lb_route(t_lb_router_data* router_data,
 
         //Clean-up
         for (unsigned int inet = 0; inet < lb_nets.size(); inet++) {
-            free_lb_net_rt(lb_nets[inet].rt_tree);
-            lb_nets[inet].rt_tree = nullptr;
+            lb_nets[inet].rt_tree.clear();
+        }
+
+        //Failures which the caller retries with all modes expanded are not final, so are not cached
+        if (use_route_cache && !mode_status->is_mode_issue()) {
+            router_data->route_cache->add_unroutable(std::move(signature));
         }
     }
+
+    /* The scratch state is only valid during the route */
+    router_data->explored_node_tb = nullptr;
+
     return is_routed;
 }
 
+/*****************************************************************************************
+ * Route Cache
+ ******************************************************************************************/
+
+IntraLbRouteCache::IntraLbRouteCache(size_t max_bytes)
+    : max_bytes_(max_bytes) {}
+
+bool IntraLbRouteCache::is_known_unroutable(const t_signature& signature) {
+    if (unroutable_.count(signature)) {
+        ++num_hits_;
+        return true;
+    }
+    ++num_misses_;
+    return false;
+}
+
+void IntraLbRouteCache::add_unroutable(t_signature&& signature) {
+    size_t bytes = entry_bytes(signature);
+    if (bytes > max_bytes_) {
+        return;
+    }
+    if (num_bytes_ + bytes > max_bytes_) {
+        num_evictions_ += unroutable_.size();
+        clear();
+    }
+    if (unroutable_.insert(std::move(signature)).second) {
+        num_bytes_ += bytes;
+    }
+}
+
+void IntraLbRouteCache::clear() {
+    unroutable_.clear();
+    num_bytes_ = 0;
+}
+
+size_t IntraLbRouteCache::entry_bytes(const t_signature& signature) {
+    //The signature data, plus the vector and hash node overhead
+    return signature.size() * sizeof(int) + sizeof(t_signature) + 2 * sizeof(void*);
+}
+
+size_t IntraLbRouteCache::t_signature_hash::operator()(const t_signature& signature) const {
+    size_t seed = signature.size();
+    for (int value : signature) {
+        vtr::hash_combine(seed, value);
+    }
+    return seed;
+}
+
 /*****************************************************************************************
  * Accessor Functions
  ******************************************************************************************/
@@ -550,7 +629,7 @@ t_pb_routes alloc_and_load_pb_route(const std::vector<t_intra_lb_net>* intra_lb_
     t_pb_routes pb_route;
 
     for (int inet = 0; inet < (int)lb_nets.size(); inet++) {
-        load_trace_to_pb_route(pb_route, total_pins, lb_nets[inet].atom_net_id, OPEN, lb_nets[inet].rt_tree);
+        load_trace_to_pb_route(pb_route, total_pins, lb_nets[inet].atom_net_id, lb_nets[inet].rt_tree);
     }
 
     return pb_route;
@@ -570,8 +649,7 @@ void free_intra_lb_nets(std::vector<t_intra_lb_net>* intra_lb_nets) {
     std::vector<t_intra_lb_net>& lb_nets = *intra_lb_nets;
     for (unsigned int i = 0; i < lb_nets.size(); i++) {
         lb_nets[i].terminals.clear();
-        free_lb_net_rt(lb_nets[i].rt_tree);
-        lb_nets[i].rt_tree = nullptr;
+        lb_nets[i].rt_tree.clear();
     }
     delete intra_lb_nets;
 }
@@ -580,46 +658,27 @@ void free_intra_lb_nets(std::vector<t_intra_lb_net>* intra_lb_nets) {
  * Internal Functions
  ****************************************************************************/
 
-/* Recurse through route tree trace to populate pb pin to atom net lookup array */
-static void load_trace_to_pb_route(t_pb_routes& pb_route, const int total_pins, const AtomNetId net_id, const int prev_pin_id, const t_lb_trace* trace) {
-    int ipin = trace->current_node;
-    int driver_pb_pin_id = prev_pin_id;
-    int cur_pin_id = OPEN;
-    if (ipin < total_pins) {
+/* Walk the route tree trace to populate pb pin to atom net lookup array */
+static void load_trace_to_pb_route(t_pb_routes& pb_route, const int total_pins, const AtomNetId net_id, const t_lb_trace& trace) {
+    /* Parents precede their children, so every driver is seen before the pins it drives */
+    for (const t_lb_trace_node& rt_node : trace.nodes) {
+        int ipin = rt_node.current_node;
+        if (ipin >= total_pins) {
+            continue;
+        }
         /* This routing node corresponds with a pin.  This node is virtual (ie. sink or source node) */
-        cur_pin_id = ipin;
+        int driver_pb_pin_id = OPEN;
+        if (rt_node.parent != OPEN && trace.nodes[rt_node.parent].current_node < total_pins) {
+            driver_pb_pin_id = trace.nodes[rt_node.parent].current_node;
+        }
         if (!pb_route.count(ipin)) {
-            pb_route.insert(std::make_pair(cur_pin_id, t_pb_route()));
-            pb_route[cur_pin_id].atom_net_id = net_id;
-            pb_route[cur_pin_id].driver_pb_pin_id = driver_pb_pin_id;
+            pb_route.insert(std::make_pair(ipin, t_pb_route()));
+            pb_route[ipin].atom_net_id = net_id;
+            pb_route[ipin].driver_pb_pin_id = driver_pb_pin_id;
         } else {
-            VTR_ASSERT(pb_route[cur_pin_id].atom_net_id == net_id);
+            VTR_ASSERT(pb_route[ipin].atom_net_id == net_id);
         }
     }
-    for (int itrace = 0; itrace < (int)trace->next_nodes.size(); itrace++) {
-        load_trace_to_pb_route(pb_route, total_pins, net_id, cur_pin_id, &trace->next_nodes[itrace]);
-    }
-}
-
-/* Free route tree for intra-logic block routing */
-static void free_lb_net_rt(t_lb_trace* lb_trace) {
-    if (lb_trace != nullptr) {
-        for (unsigned int i = 0; i < lb_trace->next_nodes.size(); i++) {
-            free_lb_trace(&lb_trace->next_nodes[i]);
-        }
-        lb_trace->next_nodes.clear();
-        delete lb_trace;
-    }
-}
-
-/* Free trace for intra-logic block routing */
-static void free_lb_trace(t_lb_trace* lb_trace) {
-    if (lb_trace != nullptr) {
-        for (unsigned int i = 0; i < lb_trace->next_nodes.size(); i++) {
-            free_lb_trace(&lb_trace->next_nodes[i]);
-        }
-        lb_trace->next_nodes.clear();
-    }
 }
 
 /* Given a pin of a net, assign route tree terminals for it
@@ -627,7 +686,7 @@ static void free_lb_trace(t_lb_trace* lb_trace) {
  */
 static void add_pin_to_rt_terminals(t_lb_router_data* router_data, const AtomPinId pin_id) {
     std::vector<t_intra_lb_net>& lb_nets = *router_data->intra_lb_nets;
-    std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
+    t_lb_type_rr_graph& lb_type_graph = *router_data->lb_type_graph;
     t_logical_block_type_ptr lb_type = router_data->lb_type;
     bool found = false;
     unsigned int ipos;
@@ -731,11 +790,11 @@ static void add_pin_to_rt_terminals(t_lb_router_data* router_data, const AtomPin
         //Get the rr node index associated with the pin
         int pin_index = pb_graph_pin->pin_count_in_cluster;
         VTR_ASSERT(lb_type_graph[pin_index].num_modes == 1);
-        VTR_ASSERT(lb_type_graph[pin_index].num_fanout[0] == 1);
+        VTR_ASSERT(lb_type_graph.num_fanout(pin_index, 0) == 1);
 
         /* We actually route to the sink (to handle logically equivalent pins).
          * The sink is one past the primitive input pin */
-        int sink_index = lb_type_graph[pin_index].outedges[0][0].node_index;
+        int sink_index = lb_type_graph.outedge(pin_index, 0, 0).node_index;
         VTR_ASSERT(lb_type_graph[sink_index].type == LB_SINK);
 
         if (lb_nets[ipos].terminals.size() == atom_ctx.nlist.net_pins(net_id).size() && lb_nets[ipos].terminals[1] == get_lb_type_rr_graph_ext_sink_index(lb_type)) {
@@ -794,7 +853,7 @@ static void add_pin_to_rt_terminals(t_lb_router_data* router_data, const AtomPin
  */
 static void remove_pin_from_rt_terminals(t_lb_router_data* router_data, const AtomPinId pin_id) {
     std::vector<t_intra_lb_net>& lb_nets = *router_data->intra_lb_nets;
-    std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
+    t_lb_type_rr_graph& lb_type_graph = *router_data->lb_type_graph;
     t_logical_block_type_ptr lb_type = router_data->lb_type;
     bool found = false;
     unsigned int ipos;
@@ -848,8 +907,8 @@ static void remove_pin_from_rt_terminals(t_lb_router_data* router_data, const At
         unsigned int iterm;
 
         VTR_ASSERT(lb_type_graph[pin_index].num_modes == 1);
-        VTR_ASSERT(lb_type_graph[pin_index].num_fanout[0] == 1);
-        int sink_index = lb_type_graph[pin_index].outedges[0][0].node_index;
+        VTR_ASSERT(lb_type_graph.num_fanout(pin_index, 0) == 1);
+        int sink_index = lb_type_graph.outedge(pin_index, 0, 0).node_index;
         VTR_ASSERT(lb_type_graph[sink_index].type == LB_SINK);
 
         int target_index = -1;
@@ -920,7 +979,7 @@ static void remove_pin_from_rt_terminals(t_lb_router_data* router_data, const At
 static void fix_duplicate_equivalent_pins(t_lb_router_data* router_data) {
     auto& atom_ctx = g_vpr_ctx.atom();
 
-    std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
+    t_lb_type_rr_graph& lb_type_graph = *router_data->lb_type_graph;
     std::vector<t_intra_lb_net>& lb_nets = *router_data->intra_lb_nets;
 
     for (size_t ilb_net = 0; ilb_net < lb_nets.size(); ++ilb_net) {
@@ -959,8 +1018,8 @@ static void fix_duplicate_equivalent_pins(t_lb_router_data* router_data) {
                     kv.first, pin_index);
 
                 VTR_ASSERT(lb_type_graph[pin_index].type == LB_INTERMEDIATE);
-                VTR_ASSERT(lb_type_graph[pin_index].num_fanout[0] == 1);
-                int sink_index = lb_type_graph[pin_index].outedges[0][0].node_index;
+                VTR_ASSERT(lb_type_graph.num_fanout(pin_index, 0) == 1);
+                int sink_index = lb_type_graph.outedge(pin_index, 0, 0).node_index;
                 VTR_ASSERT(lb_type_graph[sink_index].type == LB_SINK);
                 VTR_ASSERT_MSG(sink_index == lb_nets[ilb_net].terminals[iterm], "Remapped pin must be connected to original sink");
 
@@ -972,80 +1031,60 @@ static void fix_duplicate_equivalent_pins(t_lb_router_data* router_data) {
 }
 
 /* Commit or remove route tree from currently routed solution */
-static void commit_remove_rt(t_lb_trace* rt, t_lb_router_data* router_data, e_commit_remove op, std::unordered_map<const t_pb_graph_node*, const t_mode*>* mode_map, t_mode_selection_status* mode_status) {
-    t_lb_rr_node_stats* lb_rr_node_stats;
-    t_explored_node_tb* explored_node_tb;
-    std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
-    int inode;
-    int incr;
-
-    lb_rr_node_stats = router_data->lb_rr_node_stats;
-    explored_node_tb = router_data->explored_node_tb;
-
-    if (rt == nullptr) {
-        return;
-    }
-
-    inode = rt->current_node;
-
-    /* Determine if node is being used or removed */
-    if (op == RT_COMMIT) {
-        incr = 1;
-        if (lb_rr_node_stats[inode].occ >= lb_type_graph[inode].capacity) {
-            lb_rr_node_stats[inode].historical_usage += (lb_rr_node_stats[inode].occ - lb_type_graph[inode].capacity + 1); /* store historical overuse */
-        }
-    } else {
-        incr = -1;
-        explored_node_tb[inode].inet = OPEN;
-    }
-
-    lb_rr_node_stats[inode].occ += incr;
-    VTR_ASSERT(lb_rr_node_stats[inode].occ >= 0);
+static void commit_remove_rt(const t_lb_trace& rt, t_lb_router_data* router_data, e_commit_remove op, std::unordered_map<const t_pb_graph_node*, const t_mode*>* mode_map, t_mode_selection_status* mode_status) {
+    t_lb_rr_node_stats* lb_rr_node_stats = router_data->lb_rr_node_stats;
+    t_explored_node_tb* explored_node_tb = router_data->explored_node_tb;
+    t_lb_type_rr_graph& lb_type_graph = *router_data->lb_type_graph;
 
-    auto& driver_node = lb_type_graph[inode];
-    auto* driver_pin = driver_node.pb_graph_pin;
+    /* Visit the route tree depth-first (as the mode conflict checks are order dependent) */
+    for (int irt = rt.empty() ? OPEN : 0; irt != OPEN; irt = rt.next_in_preorder(irt)) {
+        const t_lb_trace_node& rt_node = rt.nodes[irt];
+        int inode = rt_node.current_node;
 
-    /* Recursively update route tree */
-    for (unsigned int i = 0; i < rt->next_nodes.size(); i++) {
         // Check to see if there is no mode conflict between previous nets.
         // A conflict is present if there are differing modes between a pb_graph_node
         // and its children.
-        if (op == RT_COMMIT && mode_status->try_expand_all_modes) {
-            auto& node = lb_type_graph[rt->next_nodes[i].current_node];
-            auto* pin = node.pb_graph_pin;
+        if (op == RT_COMMIT && mode_status->try_expand_all_modes && rt_node.parent != OPEN) {
+            auto* driver_pin = lb_type_graph[rt.nodes[rt_node.parent].current_node].pb_graph_pin;
+            auto* pin = lb_type_graph[inode].pb_graph_pin;
 
             if (check_edge_for_route_conflicts(mode_map, driver_pin, pin)) {
                 mode_status->is_mode_conflict = true;
             }
         }
 
-        commit_remove_rt(&rt->next_nodes[i], router_data, op, mode_map, mode_status);
+        /* Determine if node is being used or removed */
+        int incr;
+        if (op == RT_COMMIT) {
+            incr = 1;
+            if (lb_rr_node_stats[inode].occ >= lb_type_graph[inode].capacity) {
+                lb_rr_node_stats[inode].historical_usage += (lb_rr_node_stats[inode].occ - lb_type_graph[inode].capacity + 1); /* store historical overuse */
+            }
+        } else {
+            incr = -1;
+            explored_node_tb[inode].inet = OPEN;
+        }
+
+        lb_rr_node_stats[inode].occ += incr;
+        VTR_ASSERT(lb_rr_node_stats[inode].occ >= 0);
     }
 }
 
 /* Should net be skipped?  If the net does not conflict with another net, then skip routing this net */
-static bool is_skip_route_net(t_lb_trace* rt, t_lb_router_data* router_data) {
-    t_lb_rr_node_stats* lb_rr_node_stats;
-    std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
-    int inode;
-
-    lb_rr_node_stats = router_data->lb_rr_node_stats;
+static bool is_skip_route_net(const t_lb_trace& rt, t_lb_router_data* router_data) {
+    t_lb_rr_node_stats* lb_rr_node_stats = router_data->lb_rr_node_stats;
+    t_lb_type_rr_graph& lb_type_graph = *router_data->lb_type_graph;
 
-    if (rt == nullptr) {
+    if (rt.empty()) {
         return false; /* Net is not routed, therefore must route net */
     }
 
-    inode = rt->current_node;
-
-    /* Determine if node is overused */
-    if (lb_rr_node_stats[inode].occ > lb_type_graph[inode].capacity) {
-        /* Conflict between this net and another net at this node, reroute net */
-        return false;
-    }
+    for (const t_lb_trace_node& rt_node : rt.nodes) {
+        int inode = rt_node.current_node;
 
-    /* Recursively check that rest of route tree does not have a conflict */
-    for (unsigned int i = 0; i < rt->next_nodes.size(); i++) {
-        if (!is_skip_route_net(&rt->next_nodes[i], router_data)) {
+        /* Determine if node is overused */
+        if (lb_rr_node_stats[inode].occ > lb_type_graph[inode].capacity) {
+            /* Conflict between this net and another net at this node, reroute net */
             return false;
         }
     }
@@ -1056,37 +1095,36 @@ static bool is_skip_route_net(t_lb_trace* rt, t_lb_router_data* router_data) {
 
 /* At source mode as starting point to existing route tree */
 static void add_source_to_rt(t_lb_router_data* router_data, int inet) {
-    VTR_ASSERT((*router_data->intra_lb_nets)[inet].rt_tree == nullptr);
-    (*router_data->intra_lb_nets)[inet].rt_tree = new t_lb_trace;
-    (*router_data->intra_lb_nets)[inet].rt_tree->current_node = (*router_data->intra_lb_nets)[inet].terminals[0];
+    t_intra_lb_net& lb_net = (*router_data->intra_lb_nets)[inet];
+    VTR_ASSERT(lb_net.rt_tree.empty());
+    lb_net.rt_tree.add_node(lb_net.terminals[0], OPEN);
 }
 
 /* Expand all nodes found in route tree into priority queue */
-static void expand_rt(t_lb_router_data* router_data, int inet, reservable_pq<t_expansion_node, std::vector<t_expansion_node>, compare_expansion_node>& pq, int irt_net) {
+static void expand_rt(t_lb_router_data* router_data, int inet, t_lb_expansion_pq& pq, int irt_net) {
     std::vector<t_intra_lb_net>& lb_nets = *router_data->intra_lb_nets;
 
     VTR_ASSERT(pq.empty());
 
-    expand_rt_rec(lb_nets[inet].rt_tree, OPEN, router_data->explored_node_tb, pq, irt_net, router_data->explore_id_index);
-}
-
-/* Expand all nodes found in route tree into priority queue recursively */
-static void expand_rt_rec(t_lb_trace* rt, int prev_index, t_explored_node_tb* explored_node_tb, reservable_pq<t_expansion_node, std::vector<t_expansion_node>, compare_expansion_node>& pq, int irt_net, int explore_id_index) {
-    t_expansion_node enode;
-
-    /* Perhaps should use a cost other than zero */
-    enode.cost = 0;
-    enode.node_index = rt->current_node;
-    enode.prev_index = prev_index;
-    pq.push(enode);
-    explored_node_tb[enode.node_index].inet = irt_net;
-    explored_node_tb[enode.node_index].explored_id = OPEN;
-    explored_node_tb[enode.node_index].enqueue_id = explore_id_index;
-    explored_node_tb[enode.node_index].enqueue_cost = 0;
-    explored_node_tb[enode.node_index].prev_index = prev_index;
+    const t_lb_trace& rt = lb_nets[inet].rt_tree;
+    t_explored_node_tb* explored_node_tb = router_data->explored_node_tb;
 
-    for (unsigned int i = 0; i < rt->next_nodes.size(); i++) {
-        expand_rt_rec(&rt->next_nodes[i], rt->current_node, explored_node_tb, pq, irt_net, explore_id_index);
+    /* Visit the route tree depth-first, so that nodes of equal cost are queued in a consistent order */
+    for (int irt = rt.empty() ? OPEN : 0; irt != OPEN; irt = rt.next_in_preorder(irt)) {
+        const t_lb_trace_node& rt_node = rt.nodes[irt];
+        int prev_index = (rt_node.parent == OPEN) ? OPEN : rt.nodes[rt_node.parent].current_node;
+        t_expansion_node enode;
+
+        /* Perhaps should use a cost other than zero */
+        enode.cost = 0;
+        enode.node_index = rt_node.current_node;
+        enode.prev_index = prev_index;
+        pq.push(enode);
+        explored_node_tb[enode.node_index].inet = irt_net;
+        explored_node_tb[enode.node_index].explored_id = OPEN;
+        explored_node_tb[enode.node_index].enqueue_id = router_data->explore_id_index;
+        explored_node_tb[enode.node_index].enqueue_cost = 0;
+        explored_node_tb[enode.node_index].prev_index = prev_index;
     }
 }
 
@@ -1096,24 +1134,24 @@ static void expand_edges(t_lb_router_data* router_data,
                          int cur_inode,
                          float cur_cost,
                          int net_fanout,
-                         reservable_pq<t_expansion_node, std::vector<t_expansion_node>, compare_expansion_node>& pq) {
-    std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
+                         t_lb_expansion_pq& pq) {
+    t_lb_type_rr_graph& lb_type_graph = *router_data->lb_type_graph;
     t_lb_rr_node_stats* lb_rr_node_stats = router_data->lb_rr_node_stats;
     t_lb_router_params params = router_data->params;
     t_expansion_node enode;
     int usage;
     float incr_cost;
 
-    for (int iedge = 0; iedge < lb_type_graph[cur_inode].num_fanout[mode]; iedge++) {
+    for (int iedge = 0; iedge < lb_type_graph.num_fanout(cur_inode, mode); iedge++) {
         /* Init new expansion node */
         enode.prev_index = cur_inode;
-        enode.node_index = lb_type_graph[cur_inode].outedges[mode][iedge].node_index;
+        enode.node_index = lb_type_graph.outedge(cur_inode, mode, iedge).node_index;
         enode.cost = cur_cost;
 
         /* Determine incremental cost of using expansion node */
         usage = lb_rr_node_stats[enode.node_index].occ + 1 - lb_type_graph[enode.node_index].capacity;
         incr_cost = lb_type_graph[enode.node_index].intrinsic_cost;
-        incr_cost += lb_type_graph[cur_inode].outedges[mode][iedge].intrinsic_cost;
+        incr_cost += lb_type_graph.outedge(cur_inode, mode, iedge).intrinsic_cost;
         incr_cost += params.hist_fac * lb_rr_node_stats[enode.node_index].historical_usage;
         if (usage > 0) {
             incr_cost *= (usage * router_data->pres_con_fac);
@@ -1126,7 +1164,7 @@ static void expand_edges(t_lb_router_data* router_data,
         if (next_mode == -1) {
             next_mode = 0;
         }
-        if (lb_type_graph[enode.node_index].num_fanout[next_mode] > 1) {
+        if (lb_type_graph.num_fanout(enode.node_index, next_mode) > 1) {
             fanout_factor = 0.85 + (0.25 / net_fanout);
         } else {
             fanout_factor = 1.15 - (0.25 / net_fanout);
@@ -1149,7 +1187,7 @@ static void expand_edges(t_lb_router_data* router_data,
 }
 
 /* Expand all nodes found in route tree into priority queue */
-static void expand_node(t_lb_router_data* router_data, t_expansion_node exp_node, reservable_pq<t_expansion_node, std::vector<t_expansion_node>, compare_expansion_node>& pq, int net_fanout) {
+static void expand_node(t_lb_router_data* router_data, t_expansion_node exp_node, t_lb_expansion_pq& pq, int net_fanout) {
     int cur_node;
     float cur_cost;
     int mode;
@@ -1167,8 +1205,8 @@ static void expand_node(t_lb_router_data* router_data, t_expansion_node exp_node
 }
 
 /* Expand all nodes using all possible modes found in route tree into priority queue */
-static void expand_node_all_modes(t_lb_router_data* router_data, t_expansion_node exp_node, reservable_pq<t_expansion_node, std::vector<t_expansion_node>, compare_expansion_node>& pq, int net_fanout) {
-    std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
+static void expand_node_all_modes(t_lb_router_data* router_data, t_expansion_node exp_node, t_lb_expansion_pq& pq, int net_fanout) {
+    t_lb_type_rr_graph& lb_type_graph = *router_data->lb_type_graph;
     t_lb_rr_node_stats* lb_rr_node_stats = router_data->lb_rr_node_stats;
 
     int cur_inode = exp_node.node_index;
@@ -1204,12 +1242,10 @@ static void expand_node_all_modes(t_lb_router_data* router_data, t_expansion_nod
 }
 
 /* Add new path from existing route tree to target sink */
-static bool add_to_rt(t_lb_trace* rt, int node_index, t_lb_router_data* router_data, int irt_net) {
+static bool add_to_rt(t_lb_trace& rt, int node_index, t_lb_router_data* router_data, int irt_net) {
     t_explored_node_tb* explored_node_tb = router_data->explored_node_tb;
     std::vector<int> trace_forward;
-    int rt_index, trace_index;
-    t_lb_trace* link_node;
-    t_lb_trace curr_node;
+    int rt_index, link_node;
 
     /* Store path all the way back to route tree */
     rt_index = node_index;
@@ -1221,17 +1257,14 @@ static bool add_to_rt(t_lb_trace* rt, int node_index, t_lb_router_data* router_d
 
     /* Find rt_index on the route tree */
     link_node = find_node_in_rt(rt, rt_index);
-    if (link_node == nullptr) {
+    if (link_node == OPEN) {
         VTR_LOG("Link node is nullptr. Routing impossible");
         return true;
     }
 
     /* Add path to root tree */
     while (!trace_forward.empty()) {
-        trace_index = trace_forward.back();
-        curr_node.current_node = trace_index;
-        link_node->next_nodes.push_back(curr_node);
-        link_node = &link_node->next_nodes.back();
+        link_node = rt.add_node(trace_forward.back(), link_node);
         trace_forward.pop_back();
     }
 
@@ -1240,7 +1273,7 @@ static bool add_to_rt(t_lb_trace* rt, int node_index, t_lb_router_data* router_d
 
 /* Determine if a completed route is valid.  A successful route has no congestion (ie. no routing resource is used by two nets). */
 static bool is_route_success(t_lb_router_data* router_data) {
-    std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
+    t_lb_type_rr_graph& lb_type_graph = *router_data->lb_type_graph;
 
     for (unsigned int inode = 0; inode < lb_type_graph.size(); inode++) {
         if (router_data->lb_rr_node_stats[inode].occ > lb_type_graph[inode].capacity) {
@@ -1251,27 +1284,22 @@ static bool is_route_success(t_lb_router_data* router_data) {
     return true;
 }
 
-/* Given a route tree and an index of a node on the route tree, return a pointer to the trace corresponding to that index */
-static t_lb_trace* find_node_in_rt(t_lb_trace* rt, int rt_index) {
-    t_lb_trace* cur;
-    if (rt->current_node == rt_index) {
-        return rt;
-    } else {
-        for (unsigned int i = 0; i < rt->next_nodes.size(); i++) {
-            cur = find_node_in_rt(&rt->next_nodes[i], rt_index);
-            if (cur != nullptr) {
-                return cur;
-            }
+/* Given a route tree and an index of a node on the route tree, return the index of the route tree node using it, or OPEN */
+static int find_node_in_rt(const t_lb_trace& rt, int rt_index) {
+    /* A route tree uses each lb rr node at most once */
+    for (size_t irt = 0; irt < rt.nodes.size(); irt++) {
+        if (rt.nodes[irt].current_node == rt_index) {
+            return irt;
         }
     }
-    return nullptr;
+    return OPEN;
 }
 
 #ifdef PRINT_INTRA_LB_ROUTE
 /* Debug routine, print out current intra logic block route */
 static void print_route(const char* filename, t_lb_router_data* router_data) {
     FILE* fp;
-    std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
+    t_lb_type_rr_graph& lb_type_graph = *router_data->lb_type_graph;
 
     fp = fopen(filename, "w");
     for (unsigned int inode = 0; inode < lb_type_graph.size(); inode++) {
@@ -1292,33 +1320,35 @@ static void print_route(FILE* fp, t_lb_router_data* router_data) {
         AtomNetId net_id = lb_nets[inet].atom_net_id;
         fprintf(fp, "net %s num targets %d \n", atom_ctx.nlist.net_name(net_id).c_str(), (int)lb_nets[inet].terminals.size());
         fprintf(fp, "\tS");
-        print_trace(fp, lb_nets[inet].rt_tree, router_data);
+        print_trace(fp, lb_nets[inet].rt_tree, 0, router_data);
         fprintf(fp, "\n\n");
     }
 }
 #endif
 
 /* Debug routine, print out trace of net */
-static void print_trace(FILE* fp, t_lb_trace* trace, t_lb_router_data* router_data) {
-    if (trace == NULL) {
+static void print_trace(FILE* fp, const t_lb_trace& trace, int inode, t_lb_router_data* router_data) {
+    if (trace.empty()) {
         fprintf(fp, "NULL");
         return;
     }
-    for (unsigned int ibranch = 0; ibranch < trace->next_nodes.size(); ibranch++) {
-        auto current_node = trace->current_node;
+    const t_lb_trace_node& rt_node = trace.nodes[inode];
+    bool is_branch = rt_node.first_child != rt_node.last_child;
+    for (int ichild = rt_node.first_child; ichild != OPEN; ichild = trace.nodes[ichild].next_sibling) {
+        auto current_node = rt_node.current_node;
         auto current_str = describe_lb_type_rr_node(current_node, router_data);
-        auto next_node = trace->next_nodes[ibranch].current_node;
+        auto next_node = trace.nodes[ichild].current_node;
         auto next_str = describe_lb_type_rr_node(next_node, router_data);
-        if (trace->next_nodes.size() > 1) {
+        if (is_branch) {
             fprintf(fp, "\n\tB");
         }
         fprintf(fp, "(%d:%s-->%d:%s) ", current_node, current_str.c_str(), next_node, next_str.c_str());
-        print_trace(fp, &trace->next_nodes[ibranch], router_data);
+        print_trace(fp, trace, ichild, router_data);
     }
 }
 
 static void reset_explored_node_tb(t_lb_router_data* router_data) {
-    std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
+    t_lb_type_rr_graph& lb_type_graph = *router_data->lb_type_graph;
     for (unsigned int inode = 0; inode < lb_type_graph.size(); inode++) {
         router_data->explored_node_tb[inode].prev_index = OPEN;
         router_data->explored_node_tb[inode].explored_id = OPEN;
@@ -1351,12 +1381,12 @@ static void save_and_reset_lb_route(t_lb_router_data* router_data) {
         for (int iterm = 0; iterm < (int)lb_nets[inet].terminals.size(); iterm++) {
             saved_lb_nets[inet].terminals[iterm] = lb_nets[inet].terminals[iterm];
         }
-        saved_lb_nets[inet].rt_tree = lb_nets[inet].rt_tree;
-        lb_nets[inet].rt_tree = nullptr;
+        std::swap(saved_lb_nets[inet].rt_tree, lb_nets[inet].rt_tree);
+        lb_nets[inet].rt_tree.clear();
     }
 }
 
-static std::vector<int> find_congested_rr_nodes(const std::vector<t_lb_type_rr_node>& lb_type_graph,
+static std::vector<int> find_congested_rr_nodes(const t_lb_type_rr_graph& lb_type_graph,
                                                 const t_lb_rr_node_stats* lb_rr_node_stats) {
     std::vector<int> congested_rr_nodes;
     for (size_t inode = 0; inode < lb_type_graph.size(); ++inode) {
@@ -1421,8 +1451,8 @@ static std::vector<int> find_incoming_rr_nodes(int dst_node, const t_lb_router_d
     for (size_t inode = 0; inode < lb_rr_graph.size(); ++inode) {
         const t_lb_type_rr_node& rr_node = lb_rr_graph[inode];
         for (int mode = 0; mode < rr_node.num_modes; mode++) {
-            for (int iedge = 0; iedge < rr_node.num_fanout[mode]; ++iedge) {
-                const t_lb_type_rr_node_edge& rr_edge = rr_node.outedges[mode][iedge];
+            for (int iedge = 0; iedge < lb_rr_graph.num_fanout(inode, mode); ++iedge) {
+                const t_lb_type_rr_node_edge& rr_edge = lb_rr_graph.outedge(inode, mode, iedge);
 
                 if (rr_edge.node_index == dst_node) {
                     //The current node connects to the destination node
@@ -1447,20 +1477,8 @@ static std::string describe_congested_rr_nodes(const std::vector<int>& congested
         AtomNetId atom_net = lb_nets[inet].atom_net_id;
 
         //Walk the lb_traceback to find congested RR nodes for each net
-        std::queue<t_lb_trace> q;
-
-        if (lb_nets[inet].rt_tree) {
-            q.push(*lb_nets[inet].rt_tree);
-        }
-        while (!q.empty()) {
-            t_lb_trace curr = q.front();
-            q.pop();
-
-            for (const t_lb_trace& next_trace : curr.next_nodes) {
-                q.push(next_trace);
-            }
-
-            int inode = curr.current_node;
+        for (const t_lb_trace_node& rt_node : lb_nets[inet].rt_tree.nodes) {
+            int inode = rt_node.current_node;
             const t_lb_type_rr_node& rr_node = lb_type_graph[inode];
             const t_lb_rr_node_stats& rr_node_stats = lb_rr_node_stats[inode];
 
@@ -1494,7 +1512,7 @@ static std::string describe_congested_rr_nodes(const std::vector<int>& congested
 }
 
 void reset_intra_lb_route(t_lb_router_data* router_data) {
-    for (auto& node : *router_data->lb_type_graph) {
+    for (auto& node : router_data->lb_type_graph->nodes) {
         auto* pin = node.pb_graph_pin;
         if (pin == nullptr) {
             continue;
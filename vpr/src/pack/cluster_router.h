@@ -6,12 +6,70 @@
  */
 #ifndef CLUSTER_ROUTER_H
 #define CLUSTER_ROUTER_H
+#include <cstddef>
+#include <unordered_set>
 #include <vector>
 #include "atom_netlist_fwd.h"
 #include "pack_types.h"
 
+/**
+ * @brief Remembers intra-logic block routing problems which were found to be unroutable.
+ *
+ * The result of try_intra_lb_route() only depends on the logic block type, the
+ * terminals of each intra-lb net (in order) and the modes selected on the lb rr
+ * graph nodes. Packing often asks the same question again, e.g. when the same
+ * candidate molecule is re-tried on a cluster which has not changed, so the
+ * canonical signature of every failed routing problem is stored and later
+ * requests with the same signature are rejected without running PathFinder.
+ *
+ * Only failures are cached: a successful route must be run to produce the
+ * route trees which become the pb_route of the cluster.
+ *
+ * The memory used by the stored signatures is bounded; once the budget is
+ * exceeded the cache is emptied and starts over.
+ */
+class IntraLbRouteCache {
+  public:
+    /// @brief A canonical description of an intra-lb routing problem.
+    typedef std::vector<int> t_signature;
+
+    explicit IntraLbRouteCache(size_t max_bytes);
+
+    /// @brief Returns true if signature is known to be unroutable. Updates the hit / miss counters.
+    bool is_known_unroutable(const t_signature& signature);
+
+    /// @brief Records signature as unroutable, evicting every entry if the memory budget would be exceeded.
+    void add_unroutable(t_signature&& signature);
+
+    /// @brief Removes all entries (the counters are kept).
+    void clear();
+
+    size_t num_hits() const { return num_hits_; }
+    size_t num_misses() const { return num_misses_; }
+    size_t num_evictions() const { return num_evictions_; }
+    size_t num_entries() const { return unroutable_.size(); }
+    size_t num_bytes() const { return num_bytes_; }
+
+  private:
+    struct t_signature_hash {
+        size_t operator()(const t_signature& signature) const;
+    };
+
+    ///@brief Approximate memory used by one entry of unroutable_
+    static size_t entry_bytes(const t_signature& signature);
+
+    std::unordered_set<t_signature, t_signature_hash> unroutable_;
+
+    size_t max_bytes_;
+    size_t num_bytes_ = 0;
+
+    size_t num_hits_ = 0;
+    size_t num_misses_ = 0;
+    size_t num_evictions_ = 0;
+};
+
 /* Constructors/Destructors */
-t_lb_router_data* alloc_and_load_router_data(std::vector<t_lb_type_rr_node>* lb_type_graph, t_logical_block_type_ptr type);
+t_lb_router_data* alloc_and_load_router_data(t_lb_type_rr_graph* lb_type_graph, t_logical_block_type_ptr type);
 void free_router_data(t_lb_router_data* router_data);
 void free_intra_lb_nets(std::vector<t_intra_lb_net>* intra_lb_nets);
 
@@ -0,0 +1,120 @@
+#include "cluster_seed_queue.h"
+
+#include <limits>
+#include <utility>
+
+#include "vtr_assert.h"
+
+///@brief The position of the atoms which are not in the queue
+static constexpr size_t NOT_IN_QUEUE = std::numeric_limits<size_t>::max();
+
+ClusterSeedQueue::ClusterSeedQueue(const vtr::vector<AtomBlockId, float>& seed_gains)
+    : gains_(seed_gains)
+    , position_(seed_gains.size(), NOT_IN_QUEUE) {
+    heap_.reserve(seed_gains.size());
+    for (AtomBlockId blk_id : seed_gains.keys()) {
+        position_[blk_id] = heap_.size();
+        heap_.push_back(blk_id);
+    }
+
+    //Heapify bottom-up, in linear time
+    for (size_t i = heap_.size() / 2; i-- > 0;) {
+        sift_down(i);
+    }
+}
+
+bool ClusterSeedQueue::contains(AtomBlockId blk_id) const {
+    return size_t(blk_id) < position_.size() && position_[blk_id] != NOT_IN_QUEUE;
+}
+
+AtomBlockId ClusterSeedQueue::top() const {
+    VTR_ASSERT(!heap_.empty());
+    return heap_.front();
+}
+
+float ClusterSeedQueue::gain(AtomBlockId blk_id) const {
+    VTR_ASSERT_SAFE(contains(blk_id));
+    return gains_[blk_id];
+}
+
+void ClusterSeedQueue::remove(AtomBlockId blk_id) {
+    if (!contains(blk_id)) {
+        return;
+    }
+
+    //Replace the atom by the last one of the heap, which then moves to where its gain belongs
+    size_t i = position_[blk_id];
+    size_t last = heap_.size() - 1;
+    if (i != last) {
+        swap_entries(i, last);
+    }
+    heap_.pop_back();
+    position_[blk_id] = NOT_IN_QUEUE;
+
+    if (i < heap_.size()) {
+        restore(i);
+    }
+}
+
+void ClusterSeedQueue::update_gain(AtomBlockId blk_id, float gain) {
+    VTR_ASSERT_SAFE(contains(blk_id));
+    if (gains_[blk_id] == gain) {
+        return;
+    }
+
+    gains_[blk_id] = gain;
+    restore(position_[blk_id]);
+}
+
+bool ClusterSeedQueue::before(size_t i, size_t j) const {
+    AtomBlockId blk_i = heap_[i];
+    AtomBlockId blk_j = heap_[j];
+    if (gains_[blk_i] != gains_[blk_j]) {
+        return gains_[blk_i] > gains_[blk_j];
+    }
+    return size_t(blk_i) < size_t(blk_j);
+}
+
+void ClusterSeedQueue::swap_entries(size_t i, size_t j) {
+    std::swap(heap_[i], heap_[j]);
+    position_[heap_[i]] = i;
+    position_[heap_[j]] = j;
+}
+
+void ClusterSeedQueue::sift_up(size_t i) {
+    while (i > 0) {
+        size_t parent = (i - 1) / 2;
+        if (!before(i, parent)) {
+            break;
+        }
+        swap_entries(i, parent);
+        i = parent;
+    }
+}
+
+void ClusterSeedQueue::sift_down(size_t i) {
+    while (true) {
+        size_t best = i;
+        size_t left = 2 * i + 1;
+        size_t right = left + 1;
+        if (left < heap_.size() && before(left, best)) {
+            best = left;
+        }
+        if (right < heap_.size() && before(right, best)) {
+            best = right;
+        }
+        if (best == i) {
+            break;
+        }
+        swap_entries(i, best);
+        i = best;
+    }
+}
+
+void ClusterSeedQueue::restore(size_t i) {
+    if (i > 0 && before(i, (i - 1) / 2)) {
+        sift_up(i);
+    } else {
+        sift_down(i);
+    }
+}
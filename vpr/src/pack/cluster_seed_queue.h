@@ -0,0 +1,66 @@
+#ifndef VPR_CLUSTER_SEED_QUEUE_H
+#define VPR_CLUSTER_SEED_QUEUE_H
+
+/**
+ * @file
+ * @brief The queue of the candidate seed atoms of the clusterer.
+ *
+ * An indexed binary max-heap of atoms ordered by decreasing seed gain. Atoms
+ * of equal gain are ordered by increasing id, which is the order the stable
+ * sort of the atoms by gain used to give. Each atom knows its position in the
+ * heap, so that an atom can be removed (e.g. once it is absorbed into a
+ * cluster) or have its gain changed (e.g. once the criticalities are updated)
+ * in O(log n), and the best seed is always found at the top.
+ */
+
+#include <vector>
+
+#include "atom_netlist_fwd.h"
+#include "vtr_vector.h"
+
+class ClusterSeedQueue {
+  public:
+    ClusterSeedQueue() = default;
+
+    ///@brief Creates the queue of all the atoms with a seed gain
+    explicit ClusterSeedQueue(const vtr::vector<AtomBlockId, float>& seed_gains);
+
+    ///@brief Returns true if there is no atom left in the queue
+    bool empty() const { return heap_.empty(); }
+
+    ///@brief Returns the number of atoms in the queue
+    size_t size() const { return heap_.size(); }
+
+    ///@brief Returns true if the atom is in the queue
+    bool contains(AtomBlockId blk_id) const;
+
+    ///@brief Returns the atom with the highest seed gain (the queue must not be empty)
+    AtomBlockId top() const;
+
+    ///@brief Returns the current seed gain of an atom in the queue
+    float gain(AtomBlockId blk_id) const;
+
+    ///@brief Removes the atom from the queue, if it is in it
+    void remove(AtomBlockId blk_id);
+
+    ///@brief Changes the seed gain of an atom in the queue
+    void update_gain(AtomBlockId blk_id, float gain);
+
+  private:
+    ///@brief Returns true if the atom at heap position i goes before the atom at position j
+    bool before(size_t i, size_t j) const;
+
+    void swap_entries(size_t i, size_t j);
+    void sift_up(size_t i);
+    void sift_down(size_t i);
+
+    ///@brief Moves the atom at heap position i up or down to where its gain belongs
+    void restore(size_t i);
+
+  private:
+    std::vector<AtomBlockId> heap_;             ///<The atoms in heap order
+    vtr::vector<AtomBlockId, float> gains_;     ///<The seed gain of each atom
+    vtr::vector<AtomBlockId, size_t> position_; ///<The heap position of each atom, or NOT_IN_QUEUE
+};
+
+#endif /* VPR_CLUSTER_SEED_QUEUE_H */
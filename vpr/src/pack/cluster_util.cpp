@@ -2,6 +2,10 @@
 #include <algorithm>
 #include <tuple>
 
+#ifdef VPR_USE_TBB
+#    include <tbb/parallel_for.h>
+#endif
+
 #include "PreClusterTimingGraphResolver.h"
 #include "PreClusterDelayCalculator.h"
 #include "atom_netlist.h"
@@ -116,15 +120,58 @@ void calc_init_packing_timing(const t_packer_opts& packer_opts,
     }
 
     //Calculate true criticalities of each block
-    for (AtomBlockId blk : atom_ctx.nlist.blocks()) {
-        for (AtomPinId in_pin : atom_ctx.nlist.block_input_pins(blk)) {
+    calc_atom_criticality(*timing_info, atom_criticality);
+}
+
+void calc_atom_criticality(const SetupTimingInfo& timing_info,
+                           vtr::vector<AtomBlockId, float>& atom_criticality) {
+    const AtomNetlist& atom_nlist = g_vpr_ctx.atom().nlist;
+
+    for (AtomBlockId blk : atom_nlist.blocks()) {
+        atom_criticality[blk] = 0.;
+        for (AtomPinId in_pin : atom_nlist.block_input_pins(blk)) {
             //Max criticality over incoming nets
-            float crit = timing_info->setup_pin_criticality(in_pin);
+            float crit = timing_info.setup_pin_criticality(in_pin);
             atom_criticality[blk] = std::max(atom_criticality[blk], crit);
         }
     }
 }
 
+size_t invalidate_intra_cluster_timing(LegalizationClusterId cluster_id,
+                                       const ClusterLegalizer& cluster_legalizer,
+                                       PreClusterDelayCalculator& clustering_delay_calc,
+                                       SetupTimingInfo& timing_info) {
+    const AtomContext& atom_ctx = g_vpr_ctx.atom();
+    const tatum::TimingGraph& timing_graph = *g_vpr_ctx.timing().graph;
+
+    size_t num_invalidated = 0;
+    for (const t_pack_molecule* molecule : cluster_legalizer.get_cluster_molecules(cluster_id)) {
+        for (AtomBlockId blk : molecule->atom_block_ids) {
+            if (!blk) continue;
+
+            //The connections into the block from drivers in the same cluster
+            for (AtomPinId sink_pin : atom_ctx.nlist.block_input_pins(blk)) {
+                tatum::NodeId sink_tnode = atom_ctx.lookup.atom_pin_tnode(sink_pin);
+                if (!sink_tnode) continue;
+
+                for (tatum::EdgeId edge : timing_graph.node_in_edges(sink_tnode)) {
+                    if (timing_graph.edge_type(edge) != tatum::EdgeType::INTERCONNECT) continue;
+                    if (clustering_delay_calc.is_intra_cluster_edge(edge)) continue;
+
+                    AtomPinId driver_pin = atom_ctx.lookup.tnode_atom_pin(timing_graph.edge_src_node(edge));
+                    if (!driver_pin || cluster_legalizer.get_atom_cluster(atom_ctx.nlist.pin_block(driver_pin)) != cluster_id) continue;
+
+                    clustering_delay_calc.set_intra_cluster_edge(edge);
+                    timing_info.invalidate_delay(edge);
+                    ++num_invalidated;
+                }
+            }
+        }
+    }
+
+    return num_invalidated;
+}
+
 void free_clustering_data(const t_packer_opts& packer_opts,
                           t_clustering_data& clustering_data) {
 
@@ -201,19 +248,16 @@ void print_pack_status(int num_clb,
 
 void rebuild_attraction_groups(AttractionInfo& attraction_groups,
                                const ClusterLegalizer& cluster_legalizer) {
-
     for (int igroup = 0; igroup < attraction_groups.num_attraction_groups(); igroup++) {
         AttractGroupId group_id(igroup);
         AttractionGroup& group = attraction_groups.get_attraction_group_info(group_id);
-        AttractionGroup new_att_group_info;
 
-        for (AtomBlockId atom : group.group_atoms) {
-            if (!cluster_legalizer.is_atom_clustered(atom)) {
-                new_att_group_info.group_atoms.push_back(atom);
-            }
-        }
-
-        attraction_groups.set_attraction_group_info(group_id, new_att_group_info);
+        //Drop the clustered atoms in place, keeping the group's gain
+        group.group_atoms.erase(std::remove_if(group.group_atoms.begin(), group.group_atoms.end(),
+                                               [&](AtomBlockId atom) {
+                                                   return cluster_legalizer.is_atom_clustered(atom);
+                                               }),
+                                group.group_atoms.end());
     }
 }
 
@@ -232,49 +276,62 @@ bool is_atom_blk_in_pb(const AtomBlockId blk_id, const t_pb* pb) {
 
 void remove_molecule_from_pb_stats_candidates(t_pack_molecule* molecule,
                                               t_pb* pb) {
-    int molecule_index;
-    bool found_molecule = false;
+    t_pb_stats* pb_stats = pb->pb_stats;
+    t_pack_molecule** begin = pb_stats->feasible_blocks;
+    t_pack_molecule** end = begin + pb_stats->num_feasible_blocks;
 
     //find the molecule index
-    for (int i = 0; i < pb->pb_stats->num_feasible_blocks; i++) {
-        if (pb->pb_stats->feasible_blocks[i] == molecule) {
-            found_molecule = true;
-            molecule_index = i;
-        }
-    }
+    t_pack_molecule** it = std::find(begin, end, molecule);
 
     //if it is not in the array, return
-    if (found_molecule == false) {
+    if (it == end) {
         return;
     }
 
-    //Otherwise, shift the molecules while removing the specified molecule
-    for (int j = molecule_index; j < pb->pb_stats->num_feasible_blocks - 1; j++) {
-        pb->pb_stats->feasible_blocks[j] = pb->pb_stats->feasible_blocks[j + 1];
-    }
-    pb->pb_stats->num_feasible_blocks--;
+    //Otherwise, shift the molecules (and their gains) while removing the specified molecule
+    int molecule_index = it - begin;
+    float* gains = pb_stats->feasible_block_gains;
+    std::copy(it + 1, end, it);
+    std::copy(gains + molecule_index + 1, gains + pb_stats->num_feasible_blocks, gains + molecule_index);
+    pb_stats->num_feasible_blocks--;
+}
+
+/*
+ * @brief Inserts molecule (with the given gain) at index ipos of the feasible blocks
+ *        of pb_stats, shifting the later entries up by one.
+ */
+static void insert_pb_stats_candidate(t_pb_stats* pb_stats, int ipos, t_pack_molecule* molecule, float gain) {
+    t_pack_molecule** blocks = pb_stats->feasible_blocks;
+    float* gains = pb_stats->feasible_block_gains;
+    int num_blocks = pb_stats->num_feasible_blocks;
+
+    std::copy_backward(blocks + ipos, blocks + num_blocks, blocks + num_blocks + 1);
+    std::copy_backward(gains + ipos, gains + num_blocks, gains + num_blocks + 1);
+    blocks[ipos] = molecule;
+    gains[ipos] = gain;
+    pb_stats->num_feasible_blocks++;
 }
 
 void add_molecule_to_pb_stats_candidates(t_pack_molecule* molecule,
-                                         std::map<AtomBlockId, float>& gain,
+                                         t_atom_epoch_table<AtomBlockId, float>& gain,
                                          t_pb* pb,
                                          int max_queue_size,
                                          AttractionInfo& attraction_groups) {
-    int i, j;
     int num_molecule_failures = 0;
+    t_pb_stats* pb_stats = pb->pb_stats;
 
-    AttractGroupId cluster_att_grp = pb->pb_stats->attraction_grp_id;
+    AttractGroupId cluster_att_grp = pb_stats->attraction_grp_id;
 
     /* When the clusterer packs with attraction groups the goal is to
      * pack more densely. Removing failed molecules to make room for the exploration of
      * more molecules helps to achieve this purpose.
      */
     if (attraction_groups.num_attraction_groups() > 0) {
-        auto got = pb->pb_stats->atom_failures.find(molecule->atom_block_ids[0]);
-        if (got == pb->pb_stats->atom_failures.end()) {
+        auto& atom_failures = pb_stats->gain_stats->atom_failures;
+        if (!atom_failures.contains(molecule->atom_block_ids[0])) {
             num_molecule_failures = 0;
         } else {
-            num_molecule_failures = got->second;
+            num_molecule_failures = atom_failures[molecule->atom_block_ids[0]];
         }
 
         if (num_molecule_failures > 0) {
@@ -283,42 +340,32 @@ void add_molecule_to_pb_stats_candidates(t_pack_molecule* molecule,
         }
     }
 
-    for (i = 0; i < pb->pb_stats->num_feasible_blocks; i++) {
-        if (pb->pb_stats->feasible_blocks[i] == molecule) {
-            return; // already in queue, do nothing
-        }
+    t_pack_molecule** blocks = pb_stats->feasible_blocks;
+    float* gains = pb_stats->feasible_block_gains;
+    int num_blocks = pb_stats->num_feasible_blocks;
+
+    if (std::find(blocks, blocks + num_blocks, molecule) != blocks + num_blocks) {
+        return; // already in queue, do nothing
     }
 
-    if (pb->pb_stats->num_feasible_blocks >= max_queue_size - 1) {
-        /* maximum size for array, remove smallest gain element and sort */
-        if (get_molecule_gain(molecule, gain, cluster_att_grp, attraction_groups, num_molecule_failures) > get_molecule_gain(pb->pb_stats->feasible_blocks[0], gain, cluster_att_grp, attraction_groups, num_molecule_failures)) {
-            /* single loop insertion sort */
-            for (j = 0; j < pb->pb_stats->num_feasible_blocks - 1; j++) {
-                if (get_molecule_gain(molecule, gain, cluster_att_grp, attraction_groups, num_molecule_failures) <= get_molecule_gain(pb->pb_stats->feasible_blocks[j + 1], gain, cluster_att_grp, attraction_groups, num_molecule_failures)) {
-                    pb->pb_stats->feasible_blocks[j] = molecule;
-                    break;
-                } else {
-                    pb->pb_stats->feasible_blocks[j] = pb->pb_stats->feasible_blocks[j + 1];
-                }
-            }
-            if (j == pb->pb_stats->num_feasible_blocks - 1) {
-                pb->pb_stats->feasible_blocks[j] = molecule;
-            }
+    /* The gains of the queued molecules were stored when they were added, so the gain is
+     * only computed for the new molecule, and its position is found by binary search */
+    float molecule_gain = get_molecule_gain(molecule, gain, cluster_att_grp, attraction_groups, num_molecule_failures);
+
+    if (num_blocks >= max_queue_size - 1) {
+        /* maximum size for array, remove smallest gain element and insert in sorted order
+         * (ahead of any molecules of equal gain) */
+        if (num_blocks > 0 && molecule_gain > gains[0]) {
+            int ipos = std::lower_bound(gains + 1, gains + num_blocks, molecule_gain) - gains;
+            std::copy(blocks + 1, blocks + ipos, blocks);
+            std::copy(gains + 1, gains + ipos, gains);
+            blocks[ipos - 1] = molecule;
+            gains[ipos - 1] = molecule_gain;
         }
     } else {
-        /* Expand array and single loop insertion sort */
-        for (j = pb->pb_stats->num_feasible_blocks - 1; j >= 0; j--) {
-            if (get_molecule_gain(pb->pb_stats->feasible_blocks[j], gain, cluster_att_grp, attraction_groups, num_molecule_failures) > get_molecule_gain(molecule, gain, cluster_att_grp, attraction_groups, num_molecule_failures)) {
-                pb->pb_stats->feasible_blocks[j + 1] = pb->pb_stats->feasible_blocks[j];
-            } else {
-                pb->pb_stats->feasible_blocks[j + 1] = molecule;
-                break;
-            }
-        }
-        if (j < 0) {
-            pb->pb_stats->feasible_blocks[0] = molecule;
-        }
-        pb->pb_stats->num_feasible_blocks++;
+        /* Expand array and insert in sorted order (after any molecules of equal gain) */
+        int ipos = std::upper_bound(gains, gains + num_blocks, molecule_gain) - gains;
+        insert_pb_stats_candidate(pb_stats, ipos, molecule, molecule_gain);
     }
 }
 
@@ -326,7 +373,7 @@ void add_molecule_to_pb_stats_candidates(t_pack_molecule* molecule,
 void alloc_and_init_clustering(const t_molecule_stats& max_molecule_stats,
                                const Prepacker& prepacker,
                                t_clustering_data& clustering_data,
-                               std::unordered_map<AtomNetId, int>& net_output_feeds_driving_block_input,
+                               vtr::flat_hash_map<AtomNetId, int>& net_output_feeds_driving_block_input,
                                int& unclustered_list_head_size,
                                int num_molecules) {
     /* Allocates the main data structures used for clustering and properly *
@@ -490,14 +537,14 @@ void update_connection_gain_values(const AtomNetId net_id,
                 /* TODO: Gain function accurate only if net has one connection to block,
                  * TODO: Should we handle case where net has multi-connection to block?
                  *       Gain computation is only off by a bit in this case */
-                if (cur_pb->pb_stats->connectiongain.count(blk_id) == 0) {
-                    cur_pb->pb_stats->connectiongain[blk_id] = 0;
+                if (!cur_pb->pb_stats->gain_stats->connectiongain.contains(blk_id)) {
+                    cur_pb->pb_stats->gain_stats->connectiongain[blk_id] = 0;
                 }
 
                 if (num_internal_connections > 1) {
-                    cur_pb->pb_stats->connectiongain[blk_id] -= 1 / (float)(num_open_connections + 1.5 * num_stuck_connections + 1 + 0.1);
+                    cur_pb->pb_stats->gain_stats->connectiongain[blk_id] -= 1 / (float)(num_open_connections + 1.5 * num_stuck_connections + 1 + 0.1);
                 }
-                cur_pb->pb_stats->connectiongain[blk_id] += 1 / (float)(num_open_connections + 1.5 * num_stuck_connections + 0.1);
+                cur_pb->pb_stats->gain_stats->connectiongain[blk_id] += 1 / (float)(num_open_connections + 1.5 * num_stuck_connections + 0.1);
             }
         }
     }
@@ -510,13 +557,13 @@ void update_connection_gain_values(const AtomNetId net_id,
         auto blk_id = atom_ctx.nlist.pin_block(driver_pin_id);
 
         if (!cluster_legalizer.is_atom_clustered(blk_id)) {
-            if (cur_pb->pb_stats->connectiongain.count(blk_id) == 0) {
-                cur_pb->pb_stats->connectiongain[blk_id] = 0;
+            if (!cur_pb->pb_stats->gain_stats->connectiongain.contains(blk_id)) {
+                cur_pb->pb_stats->gain_stats->connectiongain[blk_id] = 0;
             }
             if (num_internal_connections > 1) {
-                cur_pb->pb_stats->connectiongain[blk_id] -= 1 / (float)(num_open_connections + 1.5 * num_stuck_connections + 0.1 + 1);
+                cur_pb->pb_stats->gain_stats->connectiongain[blk_id] -= 1 / (float)(num_open_connections + 1.5 * num_stuck_connections + 0.1 + 1);
             }
-            cur_pb->pb_stats->connectiongain[blk_id] += 1 / (float)(num_open_connections + 1.5 * num_stuck_connections + 0.1);
+            cur_pb->pb_stats->gain_stats->connectiongain[blk_id] += 1 / (float)(num_open_connections + 1.5 * num_stuck_connections + 0.1);
         }
     }
 }
@@ -540,7 +587,7 @@ void try_fill_cluster(ClusterLegalizer& cluster_legalizer,
                       e_block_pack_status& block_pack_status,
                       t_molecule_link* unclustered_list_head,
                       const int& unclustered_list_head_size,
-                      std::unordered_map<AtomNetId, int>& net_output_feeds_driving_block_input,
+                      vtr::flat_hash_map<AtomNetId, int>& net_output_feeds_driving_block_input,
                       std::map<const t_model*, std::vector<t_logical_block_type_ptr>>& primitive_candidate_block_types) {
     const AtomContext& atom_ctx = g_vpr_ctx.atom();
     const DeviceContext& device_ctx = g_vpr_ctx.device();
@@ -665,7 +712,7 @@ void store_cluster_info_and_free(const t_packer_opts& packer_opts,
     t_pb* cur_pb = cluster_legalizer.get_cluster_pb(legalization_cluster_id);
     t_pb_stats* pb_stats = cur_pb->pb_stats;
     for (const AtomNetId mnet_id : pb_stats->marked_nets) {
-        int external_terminals = atom_ctx.nlist.net_pins(mnet_id).size() - pb_stats->num_pins_of_net_in_pb[mnet_id];
+        int external_terminals = atom_ctx.nlist.net_pins(mnet_id).size() - pb_stats->gain_stats->num_pins_of_net_in_pb[mnet_id];
         /* Check if external terminals of net is within the fanout limit and that there exists external terminals */
         if (external_terminals < packer_opts.transitive_fanout_threshold && external_terminals > 0) {
             clb_inter_blk_nets[legalization_cluster_id].push_back(mnet_id);
@@ -686,7 +733,7 @@ void update_timing_gain_values(const AtomNetId net_id,
                                enum e_net_relation_to_clustered_block net_relation_to_clustered_block,
                                const SetupTimingInfo& timing_info,
                                const std::unordered_set<AtomNetId>& is_global,
-                               std::unordered_map<AtomNetId, int>& net_output_feeds_driving_block_input) {
+                               vtr::flat_hash_map<AtomNetId, int>& net_output_feeds_driving_block_input) {
     /*This function is called when the timing_gain values on the atom net*
      *net_id requires updating.   */
     float timinggain;
@@ -706,11 +753,11 @@ void update_timing_gain_values(const AtomNetId net_id,
             if (!cluster_legalizer.is_atom_clustered(blk_id)) {
                 timinggain = timing_info.setup_pin_criticality(pin_id);
 
-                if (cur_pb->pb_stats->timinggain.count(blk_id) == 0) {
-                    cur_pb->pb_stats->timinggain[blk_id] = 0;
+                if (!cur_pb->pb_stats->gain_stats->timinggain.contains(blk_id)) {
+                    cur_pb->pb_stats->gain_stats->timinggain[blk_id] = 0;
                 }
-                if (timinggain > cur_pb->pb_stats->timinggain[blk_id])
-                    cur_pb->pb_stats->timinggain[blk_id] = timinggain;
+                if (timinggain > cur_pb->pb_stats->gain_stats->timinggain[blk_id])
+                    cur_pb->pb_stats->gain_stats->timinggain[blk_id] = timinggain;
             }
         }
     }
@@ -726,11 +773,11 @@ void update_timing_gain_values(const AtomNetId net_id,
             for (auto pin_id : atom_ctx.nlist.net_sinks(net_id)) {
                 timinggain = timing_info.setup_pin_criticality(pin_id);
 
-                if (cur_pb->pb_stats->timinggain.count(new_blk_id) == 0) {
-                    cur_pb->pb_stats->timinggain[new_blk_id] = 0;
+                if (!cur_pb->pb_stats->gain_stats->timinggain.contains(new_blk_id)) {
+                    cur_pb->pb_stats->gain_stats->timinggain[new_blk_id] = 0;
                 }
-                if (timinggain > cur_pb->pb_stats->timinggain[new_blk_id])
-                    cur_pb->pb_stats->timinggain[new_blk_id] = timinggain;
+                if (timinggain > cur_pb->pb_stats->gain_stats->timinggain[new_blk_id])
+                    cur_pb->pb_stats->gain_stats->timinggain[new_blk_id] = timinggain;
             }
         }
     }
@@ -747,7 +794,7 @@ void mark_and_update_partial_gain(const AtomNetId net_id,
                                   const SetupTimingInfo& timing_info,
                                   const std::unordered_set<AtomNetId>& is_global,
                                   const int high_fanout_net_threshold,
-                                  std::unordered_map<AtomNetId, int>& net_output_feeds_driving_block_input) {
+                                  vtr::flat_hash_map<AtomNetId, int>& net_output_feeds_driving_block_input) {
 
     const AtomContext& atom_ctx = g_vpr_ctx.atom();
     t_pb* cur_pb = atom_ctx.lookup.atom_pb(clustered_blk_id)->parent_pb;
@@ -770,7 +817,7 @@ void mark_and_update_partial_gain(const AtomNetId net_id,
 
     /* Mark atom net as being visited, if necessary. */
 
-    if (cur_pb->pb_stats->num_pins_of_net_in_pb.count(net_id) == 0) {
+    if (!cur_pb->pb_stats->gain_stats->num_pins_of_net_in_pb.contains(net_id)) {
         cur_pb->pb_stats->marked_nets.push_back(net_id);
     }
 
@@ -786,17 +833,17 @@ void mark_and_update_partial_gain(const AtomNetId net_id,
             //(i.e. the net loops back to the block only once)
             pins = atom_ctx.nlist.net_sinks(net_id);
 
-        if (cur_pb->pb_stats->num_pins_of_net_in_pb.count(net_id) == 0) {
+        if (!cur_pb->pb_stats->gain_stats->num_pins_of_net_in_pb.contains(net_id)) {
             for (auto pin_id : pins) {
                 auto blk_id = atom_ctx.nlist.pin_block(pin_id);
                 if (!cluster_legalizer.is_atom_clustered(blk_id)) {
-                    if (cur_pb->pb_stats->sharinggain.count(blk_id) == 0) {
+                    if (!cur_pb->pb_stats->gain_stats->sharinggain.contains(blk_id)) {
                         cur_pb->pb_stats->marked_blocks.push_back(blk_id);
-                        cur_pb->pb_stats->sharinggain[blk_id] = 1;
-                        cur_pb->pb_stats->hillgain[blk_id] = 1 - num_ext_inputs_atom_block(blk_id);
+                        cur_pb->pb_stats->gain_stats->sharinggain[blk_id] = 1;
+                        cur_pb->pb_stats->gain_stats->hillgain[blk_id] = 1 - num_ext_inputs_atom_block(blk_id);
                     } else {
-                        cur_pb->pb_stats->sharinggain[blk_id]++;
-                        cur_pb->pb_stats->hillgain[blk_id]++;
+                        cur_pb->pb_stats->gain_stats->sharinggain[blk_id]++;
+                        cur_pb->pb_stats->gain_stats->hillgain[blk_id]++;
                     }
                 }
             }
@@ -816,10 +863,10 @@ void mark_and_update_partial_gain(const AtomNetId net_id,
                                       net_output_feeds_driving_block_input);
         }
     }
-    if (cur_pb->pb_stats->num_pins_of_net_in_pb.count(net_id) == 0) {
-        cur_pb->pb_stats->num_pins_of_net_in_pb[net_id] = 0;
+    if (!cur_pb->pb_stats->gain_stats->num_pins_of_net_in_pb.contains(net_id)) {
+        cur_pb->pb_stats->gain_stats->num_pins_of_net_in_pb[net_id] = 0;
     }
-    cur_pb->pb_stats->num_pins_of_net_in_pb[net_id]++;
+    cur_pb->pb_stats->gain_stats->num_pins_of_net_in_pb[net_id]++;
 }
 
 /*****************************************/
@@ -835,18 +882,18 @@ void update_total_gain(float alpha, float beta, bool timing_driven, bool connect
     for (AtomBlockId blk_id : cur_pb->pb_stats->marked_blocks) {
         //Initialize connectiongain and sharinggain if
         //they have not previously been updated for the block
-        if (cur_pb->pb_stats->connectiongain.count(blk_id) == 0) {
-            cur_pb->pb_stats->connectiongain[blk_id] = 0;
+        if (!cur_pb->pb_stats->gain_stats->connectiongain.contains(blk_id)) {
+            cur_pb->pb_stats->gain_stats->connectiongain[blk_id] = 0;
         }
-        if (cur_pb->pb_stats->sharinggain.count(blk_id) == 0) {
-            cur_pb->pb_stats->sharinggain[blk_id] = 0;
+        if (!cur_pb->pb_stats->gain_stats->sharinggain.contains(blk_id)) {
+            cur_pb->pb_stats->gain_stats->sharinggain[blk_id] = 0;
         }
 
         AttractGroupId atom_grp_id = attraction_groups.get_atom_attraction_group(blk_id);
         if (atom_grp_id != AttractGroupId::INVALID() && atom_grp_id == cluster_att_grp_id) {
             //increase gain of atom based on attraction group gain
             float att_grp_gain = attraction_groups.get_attraction_group_gain(atom_grp_id);
-            cur_pb->pb_stats->gain[blk_id] += att_grp_gain;
+            cur_pb->pb_stats->gain_stats->gain[blk_id] += att_grp_gain;
         }
 
         /* Todo: This was used to explore different normalization options, can
@@ -860,20 +907,20 @@ void update_total_gain(float alpha, float beta, bool timing_driven, bool connect
         VTR_ASSERT(num_used_pins > 0);
         if (connection_driven) {
             /*try to absorb as many connections as possible*/
-            cur_pb->pb_stats->gain[blk_id] = ((1 - beta)
-                                                  * (float)cur_pb->pb_stats->sharinggain[blk_id]
-                                              + beta * (float)cur_pb->pb_stats->connectiongain[blk_id])
+            cur_pb->pb_stats->gain_stats->gain[blk_id] = ((1 - beta)
+                                                  * (float)cur_pb->pb_stats->gain_stats->sharinggain[blk_id]
+                                              + beta * (float)cur_pb->pb_stats->gain_stats->connectiongain[blk_id])
                                              / (num_used_pins);
         } else {
-            cur_pb->pb_stats->gain[blk_id] = ((float)cur_pb->pb_stats->sharinggain[blk_id])
+            cur_pb->pb_stats->gain_stats->gain[blk_id] = ((float)cur_pb->pb_stats->gain_stats->sharinggain[blk_id])
                                              / (num_used_pins);
         }
 
         /* Add in timing driven cost into cost function */
         if (timing_driven) {
-            cur_pb->pb_stats->gain[blk_id] = alpha
-                                                 * cur_pb->pb_stats->timinggain[blk_id]
-                                             + (1.0 - alpha) * (float)cur_pb->pb_stats->gain[blk_id];
+            cur_pb->pb_stats->gain_stats->gain[blk_id] = alpha
+                                                 * cur_pb->pb_stats->gain_stats->timinggain[blk_id]
+                                             + (1.0 - alpha) * (float)cur_pb->pb_stats->gain_stats->gain[blk_id];
         }
     }
 }
@@ -891,7 +938,7 @@ void update_cluster_stats(const t_pack_molecule* molecule,
                           const int high_fanout_net_threshold,
                           const SetupTimingInfo& timing_info,
                           AttractionInfo& attraction_groups,
-                          std::unordered_map<AtomNetId, int>& net_output_feeds_driving_block_input) {
+                          vtr::flat_hash_map<AtomNetId, int>& net_output_feeds_driving_block_input) {
 
     int molecule_size;
     int iblock;
@@ -1221,7 +1268,7 @@ void add_cluster_molecule_candidates_by_connectivity_and_timing(t_pb* cur_pb,
             if (molecule->valid) {
                 if (cluster_legalizer.is_molecule_compatible(molecule, legalization_cluster_id)) {
                     add_molecule_to_pb_stats_candidates(molecule,
-                                                        cur_pb->pb_stats->gain, cur_pb, feasible_block_array_size, attraction_groups);
+                                                        cur_pb->pb_stats->gain_stats->gain, cur_pb, feasible_block_array_size, attraction_groups);
                 }
             }
         }
@@ -1254,7 +1301,7 @@ void add_cluster_molecule_candidates_by_highfanout_connectivity(t_pb* cur_pb,
             if (molecule->valid) {
                 if (cluster_legalizer.is_molecule_compatible(molecule, legalization_cluster_id)) {
                     add_molecule_to_pb_stats_candidates(molecule,
-                                                        cur_pb->pb_stats->gain, cur_pb, std::min(feasible_block_array_size, AAPACK_MAX_HIGH_FANOUT_EXPLORE), attraction_groups);
+                                                        cur_pb->pb_stats->gain_stats->gain, cur_pb, std::min(feasible_block_array_size, AAPACK_MAX_HIGH_FANOUT_EXPLORE), attraction_groups);
                     count++;
                 }
             }
@@ -1331,7 +1378,7 @@ void add_cluster_molecule_candidates_by_attraction_group(t_pb* cur_pb,
                 if (molecule->valid) {
                     if (cluster_legalizer.is_molecule_compatible(molecule, legalization_cluster_id)) {
                         add_molecule_to_pb_stats_candidates(molecule,
-                                                            cur_pb->pb_stats->gain, cur_pb, feasible_block_array_size, attraction_groups);
+                                                            cur_pb->pb_stats->gain_stats->gain, cur_pb, feasible_block_array_size, attraction_groups);
                     }
                 }
             }
@@ -1362,7 +1409,7 @@ void add_cluster_molecule_candidates_by_attraction_group(t_pb* cur_pb,
             if (molecule->valid) {
                 if (cluster_legalizer.is_molecule_compatible(molecule, legalization_cluster_id)) {
                     add_molecule_to_pb_stats_candidates(molecule,
-                                                        cur_pb->pb_stats->gain, cur_pb, feasible_block_array_size, attraction_groups);
+                                                        cur_pb->pb_stats->gain_stats->gain, cur_pb, feasible_block_array_size, attraction_groups);
                 }
             }
         }
@@ -1393,7 +1440,7 @@ void add_cluster_molecule_candidates_by_transitive_connectivity(t_pb* cur_pb,
         if (molecule->valid) {
             if (cluster_legalizer.is_molecule_compatible(molecule, legalization_cluster_id)) {
                 add_molecule_to_pb_stats_candidates(molecule,
-                                                    cur_pb->pb_stats->gain, cur_pb, std::min(feasible_block_array_size, AAPACK_MAX_TRANSITIVE_EXPLORE), attraction_groups);
+                                                    cur_pb->pb_stats->gain_stats->gain, cur_pb, std::min(feasible_block_array_size, AAPACK_MAX_TRANSITIVE_EXPLORE), attraction_groups);
             }
         }
     }
@@ -1523,18 +1570,30 @@ t_molecule_stats calc_molecule_stats(const t_pack_molecule* molecule, const Atom
     return molecule_stats;
 }
 
-std::vector<AtomBlockId> initialize_seed_atoms(const e_cluster_seed seed_type,
-                                               const t_molecule_stats& max_molecule_stats,
-                                               const Prepacker& prepacker,
-                                               const vtr::vector<AtomBlockId, float>& atom_criticality) {
+vtr::vector<AtomBlockId, float> compute_seed_gains(const e_cluster_seed seed_type,
+                                                   const t_molecule_stats& max_molecule_stats,
+                                                   const Prepacker& prepacker,
+                                                   const vtr::vector<AtomBlockId, float>& atom_criticality) {
     const AtomNetlist& atom_nlist = g_vpr_ctx.atom().nlist;
 
-    //Put all atoms in seed list
-    std::vector<AtomBlockId> seed_atoms(atom_nlist.blocks().begin(), atom_nlist.blocks().end());
-
     //Initially all gains are zero
     vtr::vector<AtomBlockId, float> atom_gains(atom_nlist.blocks().size(), 0.);
 
+    //The seed gain of an atom only depends on its own molecule, so the gains of
+    //all the atoms are computed in parallel (when VPR is built with TBB)
+    auto compute_atom_gains = [&](const auto& atom_gain) {
+#ifdef VPR_USE_TBB
+        tbb::parallel_for(size_t(0), atom_gains.size(), [&](size_t iatom) {
+            AtomBlockId blk(iatom);
+            atom_gains[blk] = atom_gain(blk);
+        });
+#else
+        for (AtomBlockId blk : atom_gains.keys()) {
+            atom_gains[blk] = atom_gain(blk);
+        }
+#endif
+    };
+
     if (seed_type == e_cluster_seed::TIMING) {
         VTR_ASSERT(atom_gains.size() == atom_criticality.size());
 
@@ -1543,15 +1602,15 @@ std::vector<AtomBlockId> initialize_seed_atoms(const e_cluster_seed seed_type,
 
     } else if (seed_type == e_cluster_seed::MAX_INPUTS) {
         //By number of used molecule input pins
-        for (auto blk : atom_nlist.blocks()) {
+        compute_atom_gains([&](AtomBlockId blk) -> float {
             const t_pack_molecule* blk_mol = prepacker.get_atom_molecule(blk);
             const t_molecule_stats molecule_stats = calc_molecule_stats(blk_mol, atom_nlist);
-            atom_gains[blk] = molecule_stats.num_used_ext_inputs;
-        }
+            return molecule_stats.num_used_ext_inputs;
+        });
 
     } else if (seed_type == e_cluster_seed::BLEND) {
         //By blended gain (criticality and inputs used)
-        for (auto blk : atom_nlist.blocks()) {
+        compute_atom_gains([&](AtomBlockId blk) -> float {
             /* Score seed gain of each block as a weighted sum of timing criticality,
              * number of tightly coupled blocks connected to it, and number of external inputs */
             float seed_blend_fac = 0.5;
@@ -1563,13 +1622,13 @@ std::vector<AtomBlockId> initialize_seed_atoms(const e_cluster_seed seed_type,
             float blend_gain = (seed_blend_fac * atom_criticality[blk]
                                 + (1 - seed_blend_fac) * (molecule_stats.num_used_ext_inputs / max_molecule_stats.num_used_ext_inputs));
             blend_gain *= (1 + 0.2 * (molecule_stats.num_blocks - 1));
-            atom_gains[blk] = blend_gain;
-        }
+            return blend_gain;
+        });
 
     } else if (seed_type == e_cluster_seed::MAX_PINS || seed_type == e_cluster_seed::MAX_INPUT_PINS) {
         //By pins per molecule (i.e. available pins on primitives, not pins in use)
 
-        for (auto blk : atom_nlist.blocks()) {
+        compute_atom_gains([&](AtomBlockId blk) -> float {
             const t_pack_molecule* mol = prepacker.get_atom_molecule(blk);
             const t_molecule_stats molecule_stats = calc_molecule_stats(mol, atom_nlist);
 
@@ -1583,11 +1642,11 @@ std::vector<AtomBlockId> initialize_seed_atoms(const e_cluster_seed seed_type,
                 molecule_pins = molecule_stats.num_input_pins;
             }
 
-            atom_gains[blk] = molecule_pins;
-        }
+            return molecule_pins;
+        });
 
     } else if (seed_type == e_cluster_seed::BLEND2) {
-        for (auto blk : atom_nlist.blocks()) {
+        compute_atom_gains([&](AtomBlockId blk) -> float {
             const t_pack_molecule* mol = prepacker.get_atom_molecule(blk);
             const t_molecule_stats molecule_stats = calc_molecule_stats(mol, atom_nlist);
 
@@ -1620,60 +1679,82 @@ std::vector<AtomBlockId> initialize_seed_atoms(const e_cluster_seed seed_type,
                          + BLOCKS_WEIGHT * num_blocks_ratio
                          + CRITICALITY_WEIGHT * criticality;
 
-            atom_gains[blk] = gain;
-        }
+            return gain;
+        });
 
     } else {
         VPR_FATAL_ERROR(VPR_ERROR_PACK, "Unrecognized cluster seed type");
     }
 
-    //Sort seeds in descending order of gain (i.e. highest gain first)
-    //
-    // Note that we use a *stable* sort here. It has been observed that different
-    // standard library implementations (e.g. gcc-4.9 vs gcc-5) use sorting algorithms
-    // which produce different orderings for seeds of equal gain (which is allowed with
-    // std::sort which does not specify how equal values are handled). Using a stable
-    // sort ensures that regardless of the underlying sorting algorithm the same seed
-    // order is produced regardless of compiler.
-    auto by_descending_gain = [&](const AtomBlockId lhs, const AtomBlockId rhs) {
-        return atom_gains[lhs] > atom_gains[rhs];
-    };
-    std::stable_sort(seed_atoms.begin(), seed_atoms.end(), by_descending_gain);
+    return atom_gains;
+}
+
+bool seed_gains_depend_on_criticality(const e_cluster_seed seed_type) {
+    return seed_type == e_cluster_seed::TIMING
+           || seed_type == e_cluster_seed::BLEND
+           || seed_type == e_cluster_seed::BLEND2;
+}
+
+ClusterSeedQueue initialize_seed_atoms(const e_cluster_seed seed_type,
+                                       const t_molecule_stats& max_molecule_stats,
+                                       const Prepacker& prepacker,
+                                       const vtr::vector<AtomBlockId, float>& atom_criticality) {
+    vtr::vector<AtomBlockId, float> atom_gains = compute_seed_gains(seed_type, max_molecule_stats, prepacker, atom_criticality);
 
     if (getEchoEnabled() && isEchoFileEnabled(E_ECHO_CLUSTERING_BLOCK_CRITICALITIES)) {
+        //Seeds in descending order of gain (i.e. highest gain first), as the queue gives them
+        std::vector<AtomBlockId> seed_atoms(atom_gains.keys().begin(), atom_gains.keys().end());
+        auto by_descending_gain = [&](const AtomBlockId lhs, const AtomBlockId rhs) {
+            return atom_gains[lhs] > atom_gains[rhs];
+        };
+        std::stable_sort(seed_atoms.begin(), seed_atoms.end(), by_descending_gain);
+
         print_seed_gains(getEchoFileName(E_ECHO_CLUSTERING_BLOCK_CRITICALITIES), seed_atoms, atom_gains, atom_criticality);
     }
 
-    return seed_atoms;
+    // Note that the queue orders the seeds of equal gain by atom id, so the same
+    // seed order is produced regardless of compiler (and of the thread count).
+    return ClusterSeedQueue(atom_gains);
 }
 
-t_pack_molecule* get_highest_gain_seed_molecule(int& seed_index,
-                                                const std::vector<AtomBlockId>& seed_atoms,
-                                                const Prepacker& prepacker,
-                                                const ClusterLegalizer& cluster_legalizer) {
-    while (seed_index < static_cast<int>(seed_atoms.size())) {
-        AtomBlockId blk_id = seed_atoms[seed_index++];
+void update_seed_gains(ClusterSeedQueue& seed_atoms,
+                       const e_cluster_seed seed_type,
+                       const t_molecule_stats& max_molecule_stats,
+                       const Prepacker& prepacker,
+                       const vtr::vector<AtomBlockId, float>& atom_criticality) {
+    vtr::vector<AtomBlockId, float> atom_gains = compute_seed_gains(seed_type, max_molecule_stats, prepacker, atom_criticality);
 
-        // Check if the atom has already been assigned to a cluster
-        if (!cluster_legalizer.is_atom_clustered(blk_id)) {
-            t_pack_molecule* best = nullptr;
+    for (AtomBlockId blk_id : atom_gains.keys()) {
+        if (seed_atoms.contains(blk_id)) {
+            seed_atoms.update_gain(blk_id, atom_gains[blk_id]);
+        }
+    }
+}
 
-            t_pack_molecule* molecule = prepacker.get_atom_molecule(blk_id);
-            if (molecule->valid) {
-                if (best == nullptr || (best->base_gain) < (molecule->base_gain)) {
-                    best = molecule;
-                }
-            }
-            VTR_ASSERT(best != nullptr);
-            return best;
+t_pack_molecule* get_highest_gain_seed_molecule(ClusterSeedQueue& seed_atoms,
+                                                const Prepacker& prepacker,
+                                                const ClusterLegalizer& cluster_legalizer) {
+    while (!seed_atoms.empty()) {
+        AtomBlockId blk_id = seed_atoms.top();
+
+        // Drop the atoms which have already been assigned to a cluster. The seed
+        // itself stays queued until its cluster is committed, so that it is picked
+        // again if its cluster turns out to be illegal.
+        if (cluster_legalizer.is_atom_clustered(blk_id)) {
+            seed_atoms.remove(blk_id);
+            continue;
         }
+
+        t_pack_molecule* molecule = prepacker.get_atom_molecule(blk_id);
+        VTR_ASSERT(molecule->valid);
+        return molecule;
     }
 
     /*if it makes it to here , there are no more blocks available*/
     return nullptr;
 }
 
-float get_molecule_gain(t_pack_molecule* molecule, std::map<AtomBlockId, float>& blk_gain, AttractGroupId cluster_attraction_group_id, AttractionInfo& attraction_groups, int num_molecule_failures) {
+float get_molecule_gain(t_pack_molecule* molecule, t_atom_epoch_table<AtomBlockId, float>& blk_gain, AttractGroupId cluster_attraction_group_id, AttractionInfo& attraction_groups, int num_molecule_failures) {
     float gain;
     int i;
     int num_introduced_inputs_of_indirectly_related_block;
@@ -1686,7 +1767,7 @@ float get_molecule_gain(t_pack_molecule* molecule, std::map<AtomBlockId, float>&
     for (i = 0; i < get_array_size_of_molecule(molecule); i++) {
         auto blk_id = molecule->atom_block_ids[i];
         if (blk_id) {
-            if (blk_gain.count(blk_id) > 0) {
+            if (blk_gain.contains(blk_id)) {
                 gain += blk_gain[blk_id];
             } else {
                 /* This block has no connection with current cluster, penalize molecule for having this block
@@ -1758,10 +1839,10 @@ void load_transitive_fanout_candidates(LegalizationClusterId legalization_cluste
                             if (!cluster_legalizer.is_atom_clustered(blk_id)) {
                                 auto& transitive_fanout_candidates = pb_stats->transitive_fanout_candidates;
 
-                                if (pb_stats->gain.count(blk_id) == 0) {
-                                    pb_stats->gain[blk_id] = 0.001;
+                                if (!pb_stats->gain_stats->gain.contains(blk_id)) {
+                                    pb_stats->gain_stats->gain[blk_id] = 0.001;
                                 } else {
-                                    pb_stats->gain[blk_id] += 0.001;
+                                    pb_stats->gain_stats->gain[blk_id] += 0.001;
                                 }
                                 t_pack_molecule* molecule = prepacker.get_atom_molecule(blk_id);
                                 if (molecule->valid) {
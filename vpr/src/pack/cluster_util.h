@@ -3,7 +3,9 @@
 
 #include <vector>
 #include "cluster_legalizer.h"
+#include "cluster_seed_queue.h"
 #include "pack_types.h"
+#include "vtr_flat_hash_map.h"
 #include "vtr_vector.h"
 
 class AtomNetId;
@@ -68,6 +70,7 @@ struct t_cluster_progress_stats {
     int num_molecules_processed = 0;
     int mols_since_last_print = 0;
     int blocks_since_last_analysis = 0;
+    int clusters_since_last_timing_update = 0;
     int num_unrelated_clustering_attempts = 0;
 };
 
@@ -92,7 +95,7 @@ struct t_clustering_data {
      * The only time an atom block should connect to the same atom net *
      * twice is when one connection is an output and the other is an input, *
      * so this should take care of all multiple connections.                */
-    std::unordered_map<AtomNetId, int> net_output_feeds_driving_block_input;
+    vtr::flat_hash_map<AtomNetId, int> net_output_feeds_driving_block_input;
 };
 
 /***********************************/
@@ -109,6 +112,26 @@ void calc_init_packing_timing(const t_packer_opts& packer_opts,
                               std::shared_ptr<SetupTimingInfo>& timing_info,
                               vtr::vector<AtomBlockId, float>& atom_criticality);
 
+/*
+ * @brief Sets the criticality of each atom to the maximum setup criticality of its input pins.
+ */
+void calc_atom_criticality(const SetupTimingInfo& timing_info,
+                           vtr::vector<AtomBlockId, float>& atom_criticality);
+
+/*
+ * @brief Marks the connections between the atoms of the given (closed) cluster
+ *        as intra-cluster in the pre-cluster delay calculator, and invalidates
+ *        their timing edges. The next timing_info.update() re-propagates only
+ *        the timing affected by the invalidated edges (if incremental timing
+ *        updates are enabled).
+ *
+ * Returns the number of timing edges invalidated.
+ */
+size_t invalidate_intra_cluster_timing(LegalizationClusterId cluster_id,
+                                       const ClusterLegalizer& cluster_legalizer,
+                                       PreClusterDelayCalculator& clustering_delay_calc,
+                                       SetupTimingInfo& timing_info);
+
 /*
  * @brief Free the clustering data structures.
  */
@@ -132,7 +155,7 @@ bool is_atom_blk_in_pb(const AtomBlockId blk_id, const t_pb* pb);
  * @brief Add blk to list of feasible blocks sorted according to gain.
  */
 void add_molecule_to_pb_stats_candidates(t_pack_molecule* molecule,
-                                         std::map<AtomBlockId, float>& gain,
+                                         t_atom_epoch_table<AtomBlockId, float>& gain,
                                          t_pb* pb,
                                          int max_queue_size,
                                          AttractionInfo& attraction_groups);
@@ -154,7 +177,7 @@ void remove_molecule_from_pb_stats_candidates(t_pack_molecule* molecule,
 void alloc_and_init_clustering(const t_molecule_stats& max_molecule_stats,
                                const Prepacker& prepacker,
                                t_clustering_data& clustering_data,
-                               std::unordered_map<AtomNetId, int>& net_output_feeds_driving_block_input,
+                               vtr::flat_hash_map<AtomNetId, int>& net_output_feeds_driving_block_input,
                                int& unclustered_list_head_size,
                                int num_molecules);
 
@@ -237,7 +260,7 @@ void try_fill_cluster(ClusterLegalizer& cluster_legalizer,
                       e_block_pack_status& block_pack_status,
                       t_molecule_link* unclustered_list_head,
                       const int& unclustered_list_head_size,
-                      std::unordered_map<AtomNetId, int>& net_output_feeds_driving_block_input,
+                      vtr::flat_hash_map<AtomNetId, int>& net_output_feeds_driving_block_input,
                       std::map<const t_model*, std::vector<t_logical_block_type_ptr>>& primitive_candidate_block_types);
 
 void store_cluster_info_and_free(const t_packer_opts& packer_opts,
@@ -260,7 +283,7 @@ void update_timing_gain_values(const AtomNetId net_id,
                                enum e_net_relation_to_clustered_block net_relation_to_clustered_block,
                                const SetupTimingInfo& timing_info,
                                const std::unordered_set<AtomNetId>& is_global,
-                               std::unordered_map<AtomNetId, int>& net_output_feeds_driving_block_input);
+                               vtr::flat_hash_map<AtomNetId, int>& net_output_feeds_driving_block_input);
 
 /*
  * @brief Updates the marked data structures, and if gain_flag is GAIN, the gain
@@ -281,7 +304,7 @@ void mark_and_update_partial_gain(const AtomNetId net_id,
                                   const SetupTimingInfo& timing_info,
                                   const std::unordered_set<AtomNetId>& is_global,
                                   const int high_fanout_net_threshold,
-                                  std::unordered_map<AtomNetId, int>& net_output_feeds_driving_block_input);
+                                  vtr::flat_hash_map<AtomNetId, int>& net_output_feeds_driving_block_input);
 
 /*
  * @brief Updates the total  gain array to reflect the desired tradeoff between
@@ -309,7 +332,7 @@ void update_cluster_stats(const t_pack_molecule* molecule,
                           const int high_fanout_net_threshold,
                           const SetupTimingInfo& timing_info,
                           AttractionInfo& attraction_groups,
-                          std::unordered_map<AtomNetId, int>& net_output_feeds_driving_block_input);
+                          vtr::flat_hash_map<AtomNetId, int>& net_output_feeds_driving_block_input);
 
 /*
  * @brief Given a starting seed block, start_new_cluster determines the next
@@ -428,13 +451,43 @@ t_pack_molecule* get_molecule_for_cluster(t_pb* cur_pb,
  */
 t_molecule_stats calc_molecule_stats(const t_pack_molecule* molecule, const AtomNetlist& atom_nlist);
 
-std::vector<AtomBlockId> initialize_seed_atoms(const e_cluster_seed seed_type,
-                                               const t_molecule_stats& max_molecule_stats,
-                                               const Prepacker& prepacker,
-                                               const vtr::vector<AtomBlockId, float>& atom_criticality);
+/*
+ * @brief Computes the seed gain of every atom for the given seed type.
+ */
+vtr::vector<AtomBlockId, float> compute_seed_gains(const e_cluster_seed seed_type,
+                                                   const t_molecule_stats& max_molecule_stats,
+                                                   const Prepacker& prepacker,
+                                                   const vtr::vector<AtomBlockId, float>& atom_criticality);
+
+/*
+ * @brief Returns true if the seed gains of the given seed type change with the atom criticalities.
+ */
+bool seed_gains_depend_on_criticality(const e_cluster_seed seed_type);
+
+/*
+ * @brief Creates the queue of all the atoms, ordered by decreasing seed gain.
+ */
+ClusterSeedQueue initialize_seed_atoms(const e_cluster_seed seed_type,
+                                       const t_molecule_stats& max_molecule_stats,
+                                       const Prepacker& prepacker,
+                                       const vtr::vector<AtomBlockId, float>& atom_criticality);
 
-t_pack_molecule* get_highest_gain_seed_molecule(int& seed_index,
-                                                const std::vector<AtomBlockId>& seed_atoms,
+/*
+ * @brief Recomputes the seed gains of the atoms still in the queue (e.g. after a
+ *        timing update has changed the atom criticalities).
+ */
+void update_seed_gains(ClusterSeedQueue& seed_atoms,
+                       const e_cluster_seed seed_type,
+                       const t_molecule_stats& max_molecule_stats,
+                       const Prepacker& prepacker,
+                       const vtr::vector<AtomBlockId, float>& atom_criticality);
+
+/*
+ * @brief Returns the molecule of the unclustered atom with the highest seed gain
+ *        (or nullptr if all the atoms are clustered), dropping the clustered atoms
+ *        from the top of the queue.
+ */
+t_pack_molecule* get_highest_gain_seed_molecule(ClusterSeedQueue& seed_atoms,
                                                 const Prepacker& prepacker,
                                                 const ClusterLegalizer& cluster_legalizer);
 
@@ -446,7 +499,7 @@ t_pack_molecule* get_highest_gain_seed_molecule(int& seed_index,
  * + molecule_base_gain*some_factor
  * - introduced_input_nets_of_unrelated_blocks_pulled_in_by_molecule*some_other_factor
  */
-float get_molecule_gain(t_pack_molecule* molecule, std::map<AtomBlockId, float>& blk_gain, AttractGroupId cluster_attraction_group_id, AttractionInfo& attraction_groups, int num_molecule_failures);
+float get_molecule_gain(t_pack_molecule* molecule, t_atom_epoch_table<AtomBlockId, float>& blk_gain, AttractGroupId cluster_attraction_group_id, AttractionInfo& attraction_groups, int num_molecule_failures);
 
 void print_seed_gains(const char* fname, const std::vector<AtomBlockId>& seed_atoms, const vtr::vector<AtomBlockId, float>& atom_gain, const vtr::vector<AtomBlockId, float>& atom_criticality);
 
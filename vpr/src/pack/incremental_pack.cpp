@@ -0,0 +1,336 @@
+#include "incremental_pack.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <tuple>
+#include <unordered_set>
+
+#include "pugixml.hpp"
+#include "pugixml_util.hpp"
+
+#include "atom_netlist.h"
+#include "cluster_legalizer.h"
+#include "globals.h"
+#include "prepack.h"
+#include "vpr_error.h"
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_util.h"
+#include "vtr_vector.h"
+
+/**
+ * @brief Add the net names listed in the ports of a .net file <inputs>,
+ *        <outputs> or <clocks> node to nets.
+ *
+ * Pins which are unused ("open") or driven by intra-cluster interconnect
+ * ("pin->interconnect") do not name a net and are skipped.
+ */
+static void add_port_nets(pugi::xml_node ports, std::unordered_set<std::string>& nets) {
+    for (pugi::xml_node port : ports.children("port")) {
+        for (const std::string& pin : vtr::split(port.text().get())) {
+            if (pin != "open" && pin.find("->") == std::string::npos) {
+                nets.insert(pin);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Collect the primitives (atoms) below a .net file pb, and the nets
+ *        their outputs drive.
+ */
+static void load_previous_primitives(pugi::xml_node pb_node,
+                                     std::vector<std::string>& atom_names,
+                                     std::unordered_set<std::string>& nets) {
+    for (pugi::xml_node child : pb_node.children("block")) {
+        if (std::strcmp(child.attribute("name").value(), "open") == 0) {
+            continue;
+        }
+
+        if (child.attribute("mode")) {
+            load_previous_primitives(child, atom_names, nets);
+        } else {
+            //Only primitives have no mode
+            atom_names.push_back(child.attribute("name").value());
+            add_port_nets(child.child("outputs"), nets);
+        }
+    }
+}
+
+std::vector<t_previous_cluster> read_previous_clusters(const std::string& net_file,
+                                                       const AtomNetlist& atom_nlist,
+                                                       const std::vector<t_logical_block_type>& logical_block_types) {
+    pugi::xml_document doc;
+    pugiutil::loc_data loc_data;
+    try {
+        loc_data = pugiutil::load_xml(doc, net_file);
+    } catch (pugiutil::XmlError& e) {
+        vpr_throw(VPR_ERROR_NET_F, net_file.c_str(), 0,
+                  "Failed to load previous packing file '%s' (%s).\n", net_file.c_str(), e.what());
+    }
+
+    pugi::xml_node top = doc.child("block");
+    if (!top) {
+        vpr_throw(VPR_ERROR_NET_F, net_file.c_str(), 0,
+                  "Root element must be 'block'.\n");
+    }
+
+    std::vector<t_previous_cluster> previous_clusters;
+    for (pugi::xml_node cluster_node : top.children("block")) {
+        t_previous_cluster cluster;
+        cluster.name = pugiutil::get_attribute(cluster_node, "name", loc_data).value();
+
+        //The instance is of the form type_name[index]
+        std::string instance = pugiutil::get_attribute(cluster_node, "instance", loc_data).value();
+        std::string type_name = instance.substr(0, instance.find('['));
+        for (const t_logical_block_type& type : logical_block_types) {
+            if (type.pb_type && type_name == type.name) {
+                cluster.type = &type;
+                break;
+            }
+        }
+        if (!cluster.type) {
+            vpr_throw(VPR_ERROR_NET_F, net_file.c_str(), loc_data.line(cluster_node),
+                      "Unknown block type '%s' for cluster '%s'.\n", type_name.c_str(), cluster.name.c_str());
+        }
+
+        const char* mode_name = pugiutil::get_attribute(cluster_node, "mode", loc_data).value();
+        cluster.mode = OPEN;
+        for (int imode = 0; imode < cluster.type->pb_type->num_modes; imode++) {
+            if (std::strcmp(mode_name, cluster.type->pb_type->modes[imode].name) == 0) {
+                cluster.mode = imode;
+                break;
+            }
+        }
+        if (cluster.mode == OPEN) {
+            vpr_throw(VPR_ERROR_NET_F, net_file.c_str(), loc_data.line(cluster_node),
+                      "Unknown mode '%s' for cluster '%s'.\n", mode_name, cluster.name.c_str());
+        }
+
+        //Every net connected to an atom of the cluster is either driven inside the
+        //cluster (and so named by a primitive output), or enters it through a
+        //top-level input or clock pin
+        std::vector<std::string> atom_names;
+        std::unordered_set<std::string> previous_nets;
+        load_previous_primitives(cluster_node, atom_names, previous_nets);
+        add_port_nets(cluster_node.child("inputs"), previous_nets);
+        add_port_nets(cluster_node.child("clocks"), previous_nets);
+
+        cluster.unchanged = !atom_names.empty();
+        std::unordered_set<std::string> current_nets;
+        for (const std::string& atom_name : atom_names) {
+            AtomBlockId blk_id = atom_nlist.find_block(atom_name);
+            if (!blk_id) {
+                //Atom was removed (or renamed)
+                cluster.unchanged = false;
+                continue;
+            }
+            cluster.atoms.push_back(blk_id);
+
+            for (AtomPinId pin_id : atom_nlist.block_pins(blk_id)) {
+                AtomNetId net_id = atom_nlist.pin_net(pin_id);
+                if (net_id) {
+                    current_nets.insert(atom_nlist.net_name(net_id));
+                }
+            }
+        }
+        if (current_nets != previous_nets) {
+            cluster.unchanged = false;
+        }
+
+        previous_clusters.push_back(std::move(cluster));
+    }
+
+    return previous_clusters;
+}
+
+/**
+ * @brief Get the molecules of a previous cluster, with the molecule it was
+ *        named after (i.e. the one it was started from) first.
+ *
+ * Returns an empty list if one of the molecules is not fully contained in the
+ * cluster.
+ */
+static std::vector<t_pack_molecule*> get_previous_cluster_molecules(const t_previous_cluster& cluster,
+                                                                    const AtomNetlist& atom_nlist,
+                                                                    const Prepacker& prepacker) {
+    std::unordered_set<AtomBlockId> cluster_atoms(cluster.atoms.begin(), cluster.atoms.end());
+
+    std::vector<t_pack_molecule*> molecules;
+    for (AtomBlockId blk_id : cluster.atoms) {
+        t_pack_molecule* molecule = prepacker.get_atom_molecule(blk_id);
+        if (std::find(molecules.begin(), molecules.end(), molecule) != molecules.end()) {
+            continue;
+        }
+
+        for (AtomBlockId molecule_blk_id : molecule->atom_block_ids) {
+            if (molecule_blk_id && !cluster_atoms.count(molecule_blk_id)) {
+                return {};
+            }
+        }
+
+        if (atom_nlist.block_name(blk_id) == cluster.name) {
+            molecules.insert(molecules.begin(), molecule);
+        } else {
+            molecules.push_back(molecule);
+        }
+    }
+
+    return molecules;
+}
+
+size_t reuse_previous_clusters(const std::vector<t_previous_cluster>& previous_clusters,
+                               const Prepacker& prepacker,
+                               ClusterLegalizer& cluster_legalizer,
+                               int verbosity) {
+    const AtomNetlist& atom_nlist = g_vpr_ctx.atom().nlist;
+
+    //The clusters were legal in the previous packing, so most should pass;
+    //check them fully once rather than falling back from a cheaper check
+    cluster_legalizer.set_legalization_strategy(ClusterLegalizationStrategy::FULL);
+
+    size_t num_modified = 0;
+    size_t num_dissolved = 0;
+    size_t num_reused_molecules = 0;
+    for (const t_previous_cluster& cluster : previous_clusters) {
+        if (!cluster.unchanged) {
+            num_modified++;
+            continue;
+        }
+
+        std::vector<t_pack_molecule*> molecules = get_previous_cluster_molecules(cluster, atom_nlist, prepacker);
+        if (molecules.empty()) {
+            VTR_LOGV(verbosity > 2, "Dissolving cluster '%s': its molecules changed\n", cluster.name.c_str());
+            num_dissolved++;
+            continue;
+        }
+
+        e_block_pack_status pack_status;
+        LegalizationClusterId cluster_id;
+        std::tie(pack_status, cluster_id) = cluster_legalizer.start_new_cluster(molecules[0], cluster.type, cluster.mode);
+        for (size_t imol = 1; imol < molecules.size() && pack_status == e_block_pack_status::BLK_PASSED; imol++) {
+            pack_status = cluster_legalizer.add_mol_to_cluster(molecules[imol], cluster_id);
+        }
+
+        if (pack_status != e_block_pack_status::BLK_PASSED) {
+            VTR_LOGV(verbosity > 2, "Dissolving cluster '%s': it is no longer legal\n", cluster.name.c_str());
+            if (cluster_id.is_valid()) {
+                cluster_legalizer.destroy_cluster(cluster_id);
+            }
+            num_dissolved++;
+        } else {
+            num_reused_molecules += molecules.size();
+        }
+    }
+    cluster_legalizer.compress();
+
+    size_t num_reused = cluster_legalizer.clusters().size();
+    VTR_ASSERT(num_reused + num_modified + num_dissolved == previous_clusters.size());
+    VTR_LOG("Incremental packing: reused %zu of %zu previous clusters (%zu modified, %zu dissolved)\n",
+            num_reused, previous_clusters.size(), num_modified, num_dissolved);
+
+    return num_reused_molecules;
+}
+
+std::vector<t_previous_cluster> get_clusters_outside_overfull_regions(const ClusterLegalizer& cluster_legalizer,
+                                                                      const std::vector<PartitionRegion>& overfull_prs,
+                                                                      int max_neighbour_fanout) {
+    const AtomNetlist& atom_nlist = g_vpr_ctx.atom().nlist;
+    const UserPlaceConstraints& constraints = g_vpr_ctx.floorplanning().constraints;
+
+    //The partitions whose atoms are re-packed
+    std::vector<bool> part_overlaps_overfull_pr(constraints.get_num_partitions(), false);
+    for (int ipart = 0; ipart < constraints.get_num_partitions(); ipart++) {
+        const PartitionRegion& part_pr = constraints.get_partition(PartitionId(ipart)).get_part_region();
+        for (const PartitionRegion& overfull_pr : overfull_prs) {
+            if (!intersection(part_pr, overfull_pr).empty()) {
+                part_overlaps_overfull_pr[ipart] = true;
+                break;
+            }
+        }
+    }
+
+    auto cluster_overlaps_overfull_pr = [&](LegalizationClusterId cluster_id) {
+        const PartitionRegion& cluster_pr = cluster_legalizer.get_cluster_pr(cluster_id);
+        if (cluster_pr.empty()) {
+            //Unconstrained clusters do not count towards the region capacities
+            return false;
+        }
+        for (const PartitionRegion& overfull_pr : overfull_prs) {
+            if (!intersection(cluster_pr, overfull_pr).empty()) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    auto cluster_atoms = [&](LegalizationClusterId cluster_id) {
+        std::vector<AtomBlockId> atoms;
+        for (const t_pack_molecule* molecule : cluster_legalizer.get_cluster_molecules(cluster_id)) {
+            for (AtomBlockId blk_id : molecule->atom_block_ids) {
+                if (blk_id) {
+                    atoms.push_back(blk_id);
+                }
+            }
+        }
+        return atoms;
+    };
+
+    vtr::vector<LegalizationClusterId, bool> dissolve(cluster_legalizer.clusters().size(), false);
+    std::vector<LegalizationClusterId> overfull_clusters;
+    for (LegalizationClusterId cluster_id : cluster_legalizer.clusters()) {
+        bool overfull = cluster_overlaps_overfull_pr(cluster_id);
+        for (AtomBlockId blk_id : cluster_atoms(cluster_id)) {
+            if (overfull) {
+                break;
+            }
+            PartitionId part_id = constraints.get_atom_partition(blk_id);
+            overfull = part_id.is_valid() && part_overlaps_overfull_pr[size_t(part_id)];
+        }
+        if (overfull) {
+            dissolve[cluster_id] = true;
+            overfull_clusters.push_back(cluster_id);
+        }
+    }
+
+    //Dissolve the clusters tightly connected to the dissolved ones
+    for (LegalizationClusterId cluster_id : overfull_clusters) {
+        for (AtomBlockId blk_id : cluster_atoms(cluster_id)) {
+            for (AtomPinId pin_id : atom_nlist.block_pins(blk_id)) {
+                AtomNetId net_id = atom_nlist.pin_net(pin_id);
+                if (!net_id || atom_nlist.net_sinks(net_id).size() > size_t(max_neighbour_fanout)) {
+                    continue;
+                }
+                for (AtomPinId net_pin_id : atom_nlist.net_pins(net_id)) {
+                    LegalizationClusterId neighbour_id = cluster_legalizer.get_atom_cluster(atom_nlist.pin_block(net_pin_id));
+                    if (neighbour_id.is_valid()) {
+                        dissolve[neighbour_id] = true;
+                    }
+                }
+            }
+        }
+    }
+
+    std::vector<t_previous_cluster> kept_clusters;
+    for (LegalizationClusterId cluster_id : cluster_legalizer.clusters()) {
+        if (dissolve[cluster_id]) {
+            continue;
+        }
+        const t_pb* pb = cluster_legalizer.get_cluster_pb(cluster_id);
+
+        t_previous_cluster cluster;
+        cluster.name = pb->name;
+        cluster.type = cluster_legalizer.get_cluster_type(cluster_id);
+        cluster.mode = pb->mode;
+        cluster.atoms = cluster_atoms(cluster_id);
+        cluster.unchanged = true;
+        kept_clusters.push_back(std::move(cluster));
+    }
+
+    VTR_LOG("Keeping %zu of %zu clusters outside of the overfull floorplan regions (%zu overfull, %zu neighbours dissolved)\n",
+            kept_clusters.size(), cluster_legalizer.clusters().size(), overfull_clusters.size(),
+            cluster_legalizer.clusters().size() - kept_clusters.size() - overfull_clusters.size());
+
+    return kept_clusters;
+}
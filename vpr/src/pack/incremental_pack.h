@@ -0,0 +1,87 @@
+#ifndef VPR_INCREMENTAL_PACK_H
+#define VPR_INCREMENTAL_PACK_H
+
+/**
+ * @file
+ * @brief Reuse of the clusters of a previous packing (.net file) when only a
+ *        small part of the atom netlist has changed.
+ *
+ * The clusters of the previous packing are matched to the current atom
+ * netlist by atom name. A previous cluster is unchanged if all of its atoms
+ * still exist and they still connect to the same set of nets (by name).
+ * Unchanged clusters are re-legalized from their previous contents, without
+ * any candidate selection; every other cluster is dissolved and its atoms are
+ * clustered again by the normal packer, together with any new atoms.
+ */
+
+#include <string>
+#include <vector>
+
+#include "atom_netlist_fwd.h"
+#include "partition_region.h"
+#include "physical_types.h"
+
+class ClusterLegalizer;
+class Prepacker;
+
+/**
+ * @brief A cluster read from a previous packing.
+ *
+ *      name      : name of the cluster (the root atom of its first molecule)
+ *      type      : logical block type of the cluster
+ *      mode      : mode of the cluster's top-level pb
+ *      atoms     : the atoms of the cluster, in .net file order
+ *      unchanged : whether every atom of the cluster still exists and
+ *                  connects to the same nets as in the previous packing
+ */
+struct t_previous_cluster {
+    std::string name;
+    t_logical_block_type_ptr type = nullptr;
+    int mode = 0;
+    std::vector<AtomBlockId> atoms;
+    bool unchanged = false;
+};
+
+/**
+ * @brief Read the clusters of a previous packing from a .net file, and match
+ *        them to the atoms of the given netlist.
+ */
+std::vector<t_previous_cluster> read_previous_clusters(const std::string& net_file,
+                                                       const AtomNetlist& atom_nlist,
+                                                       const std::vector<t_logical_block_type>& logical_block_types);
+
+/**
+ * @brief Re-create every unchanged previous cluster in the cluster legalizer.
+ *
+ * Each cluster is rebuilt from the molecules of its atoms, with full
+ * legalization. A cluster is dissolved (left unclustered) if one of its
+ * molecules is not fully contained in it (e.g. prepacking changed), or if it
+ * is no longer legal.
+ *
+ * The legalizer is compressed before returning, so all the clusters it
+ * contains are the reused ones.
+ *
+ *  @return The number of molecules in the reused clusters.
+ */
+size_t reuse_previous_clusters(const std::vector<t_previous_cluster>& previous_clusters,
+                               const Prepacker& prepacker,
+                               ClusterLegalizer& cluster_legalizer,
+                               int verbosity);
+
+/**
+ * @brief Get the clusters of the cluster legalizer to keep when re-packing
+ *        because some floorplan regions are overfull.
+ *
+ * A cluster is dissolved if its PartitionRegion intersects one of the overfull
+ * regions, or if one of its atoms belongs to a partition that does (these are
+ * the atoms the attraction groups pull together). The neighbours of these
+ * clusters (the clusters sharing a net of at most max_neighbour_fanout sinks
+ * with them) are dissolved too, so the re-packed atoms can be clustered with
+ * the logic they connect to. Every other cluster is returned, to be reused by
+ * reuse_previous_clusters() in the next packing iteration.
+ */
+std::vector<t_previous_cluster> get_clusters_outside_overfull_regions(const ClusterLegalizer& cluster_legalizer,
+                                                                      const std::vector<PartitionRegion>& overfull_prs,
+                                                                      int max_neighbour_fanout);
+
+#endif
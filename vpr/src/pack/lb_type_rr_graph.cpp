@@ -18,6 +18,7 @@
  * Date: July 22, 2013
  */
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 #include <vector>
@@ -33,16 +34,32 @@
 #include "pack_types.h"
 #include "lb_type_rr_graph.h"
 
+#if defined(VPR_USE_TBB)
+#    include <tbb/parallel_for.h>
+#endif
+
 /*****************************************************************************************
  * Internal functions declarations
  ******************************************************************************************/
+
+/* Out-edges of the nodes of a graph being built [0..num_nodes - 1][0..num_modes - 1][0..num_fanout - 1],
+ * compressed into the graph once it is complete */
+typedef std::vector<std::vector<std::vector<t_lb_type_rr_node_edge>>> t_lb_type_rr_edge_lists;
+
 static void alloc_and_load_lb_type_rr_graph_for_type(const t_logical_block_type_ptr lb_type,
-                                                     std::vector<t_lb_type_rr_node>& lb_type_rr_node_graph);
-static void alloc_and_load_lb_type_rr_graph_for_pb_graph_node(const t_pb_graph_node* pb_graph_node,
+                                                     t_lb_type_rr_graph& lb_type_rr_graph);
+static void alloc_and_load_lb_type_rr_graph_for_pb_graph_node(const t_logical_block_type_ptr lb_type,
+                                                              const t_pb_graph_node* pb_graph_node,
                                                               std::vector<t_lb_type_rr_node>& lb_type_rr_node_graph,
+                                                              t_lb_type_rr_edge_lists& edge_lists,
                                                               const int ext_rr_index);
+static void load_lb_type_rr_node_outedges(const t_logical_block_type_ptr lb_type,
+                                          const t_pb_graph_pin* pb_pin,
+                                          int num_modes,
+                                          std::vector<std::vector<t_lb_type_rr_node_edge>>& outedges);
+static void compress_lb_type_rr_graph_edges(const t_lb_type_rr_edge_lists& edge_lists, t_lb_type_rr_graph& lb_type_rr_graph);
 static float get_cost_of_pb_edge(t_pb_graph_edge* edge);
-static void print_lb_type_rr_graph(FILE* fp, const std::vector<t_lb_type_rr_node>& lb_type_rr_graph);
+static void print_lb_type_rr_graph(FILE* fp, const t_lb_type_rr_graph& lb_type_rr_graph);
 
 /*****************************************************************************************
  * Constructor/Destructor functions
@@ -50,53 +67,34 @@ static void print_lb_type_rr_graph(FILE* fp, const std::vector<t_lb_type_rr_node
 
 /* Populate each logic block type (type_descriptor) with a directed graph that respresents the interconnect within it.
  */
-std::vector<t_lb_type_rr_node>* alloc_and_load_all_lb_type_rr_graph() {
-    std::vector<t_lb_type_rr_node>* lb_type_rr_graphs;
+t_lb_type_rr_graph* alloc_and_load_all_lb_type_rr_graph() {
+    t_lb_type_rr_graph* lb_type_rr_graphs;
     auto& device_ctx = g_vpr_ctx.device();
 
-    lb_type_rr_graphs = new std::vector<t_lb_type_rr_node>[device_ctx.logical_block_types.size()];
+    lb_type_rr_graphs = new t_lb_type_rr_graph[device_ctx.logical_block_types.size()];
 
-    for (const auto& type : device_ctx.logical_block_types) {
+    auto load_type_graph = [&](const t_logical_block_type& type) {
         int itype = type.index;
         if (&type != device_ctx.EMPTY_LOGICAL_BLOCK_TYPE) {
             alloc_and_load_lb_type_rr_graph_for_type(&type, lb_type_rr_graphs[itype]);
-
-            /* Now that the data is loaded, reallocate to the precise amount of memory needed to prevent insidious bugs */
-            /* I should be using shrinktofit() but as of 2013, C++ 11 is yet not well supported so I can't call this function in gcc */
-            std::vector<t_lb_type_rr_node>(lb_type_rr_graphs[itype]).swap(lb_type_rr_graphs[itype]);
         }
+    };
+
+    /* The graph of each type only depends on its own pb graph */
+#if defined(VPR_USE_TBB)
+    tbb::parallel_for(size_t(0), device_ctx.logical_block_types.size(), [&](size_t itype) {
+        load_type_graph(device_ctx.logical_block_types[itype]);
+    });
+#else
+    for (const auto& type : device_ctx.logical_block_types) {
+        load_type_graph(type);
     }
+#endif
     return lb_type_rr_graphs;
 }
 
 /* Free routing resource graph for all logic block types */
-void free_all_lb_type_rr_graph(std::vector<t_lb_type_rr_node>* lb_type_rr_graphs) {
-    if (lb_type_rr_graphs == nullptr) {
-        return;
-    }
-
-    auto& device_ctx = g_vpr_ctx.device();
-
-    for (const auto& type : device_ctx.logical_block_types) {
-        int itype = type.index;
-        if (!is_empty_type(&type)) {
-            int graph_size = lb_type_rr_graphs[itype].size();
-            for (int inode = 0; inode < graph_size; inode++) {
-                t_lb_type_rr_node* node = &lb_type_rr_graphs[itype][inode];
-                if (node->outedges != nullptr) {
-                    for (int imode = 0; imode < node->num_modes; imode++) {
-                        if (node->outedges[imode] != nullptr) {
-                            delete[] node->outedges[imode];
-                        }
-                    }
-                    delete[] node->outedges;
-                }
-                if (node->num_fanout != nullptr) {
-                    delete[] node->num_fanout;
-                }
-            }
-        }
-    }
+void free_all_lb_type_rr_graph(t_lb_type_rr_graph* lb_type_rr_graphs) {
     delete[] lb_type_rr_graphs;
 }
 
@@ -114,11 +112,11 @@ int get_lb_type_rr_graph_ext_sink_index(t_logical_block_type_ptr lb_type) {
     return lb_type->pb_graph_head->total_pb_pins + 1;
 }
 
-int get_lb_type_rr_graph_edge_mode(std::vector<t_lb_type_rr_node>& lb_type_rr_graph, int src_index, int dst_index) {
+int get_lb_type_rr_graph_edge_mode(t_lb_type_rr_graph& lb_type_rr_graph, int src_index, int dst_index) {
     auto& src = lb_type_rr_graph[src_index];
     for (int imode = 0; imode < src.num_modes; imode++) {
-        for (int iedge = 0; iedge < src.num_fanout[imode]; iedge++) {
-            if (src.outedges[imode][iedge].node_index == dst_index) {
+        for (int iedge = 0; iedge < lb_type_rr_graph.num_fanout(src_index, imode); iedge++) {
+            if (lb_type_rr_graph.outedge(src_index, imode, iedge).node_index == dst_index) {
                 return imode;
             }
         }
@@ -131,7 +129,7 @@ int get_lb_type_rr_graph_edge_mode(std::vector<t_lb_type_rr_node>& lb_type_rr_gr
  ******************************************************************************************/
 
 /* Output all logic block type pb graphs */
-void echo_lb_type_rr_graphs(char* filename, std::vector<t_lb_type_rr_node>* lb_type_rr_graphs) {
+void echo_lb_type_rr_graphs(char* filename, t_lb_type_rr_graph* lb_type_rr_graphs) {
     FILE* fp;
     fp = vtr::fopen(filename, "w");
 
@@ -159,12 +157,12 @@ void echo_lb_type_rr_graphs(char* filename, std::vector<t_lb_type_rr_node>* lb_t
  * of the pb_type
  */
 static void alloc_and_load_lb_type_rr_graph_for_type(const t_logical_block_type_ptr lb_type,
-                                                     std::vector<t_lb_type_rr_node>& lb_type_rr_node_graph) {
+                                                     t_lb_type_rr_graph& lb_type_rr_graph) {
     t_pb_type* pb_type;
     t_pb_graph_node* pb_graph_head;
     int ext_source_index, ext_sink_index, ext_rr_index;
-    int ioutedges;
 
+    std::vector<t_lb_type_rr_node>& lb_type_rr_node_graph = lb_type_rr_graph.nodes;
     VTR_ASSERT(lb_type_rr_node_graph.empty());
 
     pb_type = lb_type->pb_type;
@@ -177,6 +175,7 @@ static void alloc_and_load_lb_type_rr_graph_for_type(const t_logical_block_type_
      * All nodes after total_pin_pins + 2 are other nodes that do not have a corresponding pb_graph_pin (eg. a sink node that is driven by one or more pb_graph_pins of a primitive)
      */
     lb_type_rr_node_graph.resize(pb_graph_head->total_pb_pins + 3);
+    t_lb_type_rr_edge_lists edge_lists(lb_type_rr_node_graph.size());
 
     /* Define the external source, sink, and external interconnect for the routing resource graph of the logic block type */
     ext_source_index = pb_graph_head->total_pb_pins;
@@ -192,38 +191,24 @@ static void alloc_and_load_lb_type_rr_graph_for_type(const t_logical_block_type_
     /* External source node drives all inputs going into logic block type */
     lb_type_rr_node_graph[ext_source_index].capacity = pb_type->num_input_pins + pb_type->num_clock_pins;
     lb_type_rr_node_graph[ext_source_index].num_modes = 1;
-    lb_type_rr_node_graph[ext_source_index].num_fanout = new short[1];
-    lb_type_rr_node_graph[ext_source_index].num_fanout[0] = pb_type->num_input_pins + pb_type->num_clock_pins;
-    lb_type_rr_node_graph[ext_source_index].outedges = new t_lb_type_rr_node_edge*[1];
-    lb_type_rr_node_graph[ext_source_index].outedges[0] = nullptr;
-    if (lb_type_rr_node_graph[ext_source_index].num_fanout[0] > 0) {
-        lb_type_rr_node_graph[ext_source_index].outedges[0] = new t_lb_type_rr_node_edge[lb_type_rr_node_graph[ext_source_index].num_fanout[0]];
-        for (int i = 0; i < lb_type_rr_node_graph[ext_source_index].num_fanout[0]; i++)
-            lb_type_rr_node_graph[ext_source_index].outedges[0][i] = t_lb_type_rr_node_edge();
-    }
     lb_type_rr_node_graph[ext_source_index].type = LB_SOURCE;
+    edge_lists[ext_source_index].resize(1);
 
     /* Connect external source node to all input and clock pins of logic block type */
-    ioutedges = 0;
-
     for (int iport = 0; iport < pb_graph_head->num_input_ports; iport++) {
         for (int ipin = 0; ipin < pb_graph_head->num_input_pins[iport]; ipin++) {
-            lb_type_rr_node_graph[ext_source_index].outedges[0][ioutedges].node_index = pb_graph_head->input_pins[iport][ipin].pin_count_in_cluster;
-            lb_type_rr_node_graph[ext_source_index].outedges[0][ioutedges].intrinsic_cost = 1;
-            ioutedges++;
+            edge_lists[ext_source_index][0].push_back({pb_graph_head->input_pins[iport][ipin].pin_count_in_cluster, 1});
         }
     }
 
     for (int iport = 0; iport < pb_graph_head->num_clock_ports; iport++) {
         for (int ipin = 0; ipin < pb_graph_head->num_clock_pins[iport]; ipin++) {
-            lb_type_rr_node_graph[ext_source_index].outedges[0][ioutedges].node_index = pb_graph_head->clock_pins[iport][ipin].pin_count_in_cluster;
-            lb_type_rr_node_graph[ext_source_index].outedges[0][ioutedges].intrinsic_cost = 1;
-            ioutedges++;
+            edge_lists[ext_source_index][0].push_back({pb_graph_head->clock_pins[iport][ipin].pin_count_in_cluster, 1});
         }
     }
 
     /* Check that the fanout indices are correct */
-    VTR_ASSERT(ioutedges == pb_type->num_input_pins + pb_type->num_clock_pins);
+    VTR_ASSERT((int)edge_lists[ext_source_index][0].size() == pb_type->num_input_pins + pb_type->num_clock_pins);
 
     /*******************************************************************************
      * Build logic block sink node
@@ -232,10 +217,8 @@ static void alloc_and_load_lb_type_rr_graph_for_type(const t_logical_block_type_
     /* External sink node driven by all outputs exiting logic block type */
     lb_type_rr_node_graph[ext_sink_index].capacity = pb_type->num_output_pins;
     lb_type_rr_node_graph[ext_sink_index].num_modes = 1;
-    lb_type_rr_node_graph[ext_sink_index].num_fanout = new short[1];
-    lb_type_rr_node_graph[ext_sink_index].num_fanout[0] = 0; /* Terminal point */
-    lb_type_rr_node_graph[ext_sink_index].outedges = nullptr;
     lb_type_rr_node_graph[ext_sink_index].type = LB_SINK;
+    edge_lists[ext_sink_index].resize(1); /* Terminal point */
 
     /*******************************************************************************
      * Build node that approximates external interconnect
@@ -244,39 +227,89 @@ static void alloc_and_load_lb_type_rr_graph_for_type(const t_logical_block_type_
     /* External rr node that drives all existing logic block input pins and is driven by all outputs exiting logic block type */
     lb_type_rr_node_graph[ext_rr_index].capacity = pb_type->num_output_pins;
     lb_type_rr_node_graph[ext_rr_index].num_modes = 1;
-    lb_type_rr_node_graph[ext_rr_index].num_fanout = new short[1];
-    lb_type_rr_node_graph[ext_rr_index].num_fanout[0] = pb_type->num_input_pins + pb_type->num_clock_pins + 1;
-    lb_type_rr_node_graph[ext_rr_index].outedges = new t_lb_type_rr_node_edge*[1];
-    lb_type_rr_node_graph[ext_rr_index].outedges[0] = nullptr;
-    if (lb_type_rr_node_graph[ext_rr_index].num_fanout[0] > 0) {
-        lb_type_rr_node_graph[ext_rr_index].outedges[0] = new t_lb_type_rr_node_edge[lb_type_rr_node_graph[ext_rr_index].num_fanout[0]];
-        for (int i = 0; i < lb_type_rr_node_graph[ext_rr_index].num_fanout[0]; i++)
-            lb_type_rr_node_graph[ext_rr_index].outedges[0][i] = t_lb_type_rr_node_edge();
-    }
     lb_type_rr_node_graph[ext_rr_index].type = LB_INTERMEDIATE;
+    edge_lists[ext_rr_index].resize(1);
 
     /* Connect opin of logic block to sink */
-    lb_type_rr_node_graph[ext_rr_index].outedges[0][0].node_index = ext_sink_index;
-    lb_type_rr_node_graph[ext_rr_index].outedges[0][0].intrinsic_cost = 1;
+    edge_lists[ext_rr_index][0].push_back({ext_sink_index, 1});
 
     /* Connect opin of logic block to all input and clock pins of logic block type */
-    ioutedges = 1;
     for (int iport = 0; iport < pb_graph_head->num_input_ports; iport++) {
         for (int ipin = 0; ipin < pb_graph_head->num_input_pins[iport]; ipin++) {
-            lb_type_rr_node_graph[ext_rr_index].outedges[0][ioutedges].node_index = pb_graph_head->input_pins[iport][ipin].pin_count_in_cluster;
-            lb_type_rr_node_graph[ext_rr_index].outedges[0][ioutedges].intrinsic_cost = 1000; /* set cost high to avoid using external interconnect unless necessary */
-            ioutedges++;
+            /* set cost high to avoid using external interconnect unless necessary */
+            edge_lists[ext_rr_index][0].push_back({pb_graph_head->input_pins[iport][ipin].pin_count_in_cluster, 1000});
         }
     }
     for (int iport = 0; iport < pb_graph_head->num_clock_ports; iport++) {
         for (int ipin = 0; ipin < pb_graph_head->num_clock_pins[iport]; ipin++) {
-            lb_type_rr_node_graph[ext_rr_index].outedges[0][ioutedges].node_index = pb_graph_head->clock_pins[iport][ipin].pin_count_in_cluster;
-            lb_type_rr_node_graph[ext_rr_index].outedges[0][ioutedges].intrinsic_cost = 1000; /* set cost high to avoid using external interconnect unless necessary */
-            ioutedges++;
+            /* set cost high to avoid using external interconnect unless necessary */
+            edge_lists[ext_rr_index][0].push_back({pb_graph_head->clock_pins[iport][ipin].pin_count_in_cluster, 1000});
         }
     }
 
-    alloc_and_load_lb_type_rr_graph_for_pb_graph_node(pb_graph_head, lb_type_rr_node_graph, ext_rr_index);
+    alloc_and_load_lb_type_rr_graph_for_pb_graph_node(lb_type, pb_graph_head, lb_type_rr_node_graph, edge_lists, ext_rr_index);
+
+    /* Now that the data is loaded, reallocate to the precise amount of memory needed */
+    lb_type_rr_node_graph.shrink_to_fit();
+    compress_lb_type_rr_graph_edges(edge_lists, lb_type_rr_graph);
+}
+
+/* Load the rr node of a pin with a single mode */
+static void load_single_mode_lb_type_rr_node(std::vector<t_lb_type_rr_node>& lb_type_rr_node_graph,
+                                             t_lb_type_rr_edge_lists& edge_lists,
+                                             t_pb_graph_pin* pb_pin,
+                                             e_lb_rr_type type) {
+    int pin_index = pb_pin->pin_count_in_cluster;
+    lb_type_rr_node_graph[pin_index].capacity = 1;
+    lb_type_rr_node_graph[pin_index].num_modes = 1;
+    lb_type_rr_node_graph[pin_index].type = type;
+    lb_type_rr_node_graph[pin_index].pb_graph_pin = pb_pin;
+    edge_lists[pin_index].resize(1);
+}
+
+/* Load the rr node of a pin with num_modes mode-dependant out-going edges */
+static void load_multi_mode_lb_type_rr_node(const t_logical_block_type_ptr lb_type,
+                                            std::vector<t_lb_type_rr_node>& lb_type_rr_node_graph,
+                                            t_lb_type_rr_edge_lists& edge_lists,
+                                            t_pb_graph_pin* pb_pin,
+                                            int num_modes,
+                                            e_lb_rr_type type) {
+    int pin_index = pb_pin->pin_count_in_cluster;
+    lb_type_rr_node_graph[pin_index].capacity = 1;
+    lb_type_rr_node_graph[pin_index].num_modes = num_modes;
+    lb_type_rr_node_graph[pin_index].type = type;
+    lb_type_rr_node_graph[pin_index].pb_graph_pin = pb_pin;
+
+    /* Load the mode-dependant out-going edges */
+    load_lb_type_rr_node_outedges(lb_type, pb_pin, num_modes, edge_lists[pin_index]);
+}
+
+/* Load the rr node of a primitive input (or clock) pin, which drives a sink.
+ * The pins of an equivalent port share their sink: sink_index is the sink of the port so far (OPEN for a new one) */
+static void load_primitive_input_lb_type_rr_node(std::vector<t_lb_type_rr_node>& lb_type_rr_node_graph,
+                                                 t_lb_type_rr_edge_lists& edge_lists,
+                                                 t_pb_graph_pin* pb_pin,
+                                                 int& sink_index) {
+    PortEquivalence port_equivalent = pb_pin->port->equivalent;
+    int pin_index = pb_pin->pin_count_in_cluster;
+
+    /* alloc and load rr node info */
+    load_single_mode_lb_type_rr_node(lb_type_rr_node_graph, edge_lists, pb_pin, LB_INTERMEDIATE);
+
+    if (port_equivalent == PortEquivalence::NONE || sink_index == OPEN) {
+        /* Create new sink for input to primitive */
+        t_lb_type_rr_node new_sink;
+        if (port_equivalent != PortEquivalence::NONE) {
+            new_sink.capacity = pb_pin->port->num_pins;
+        } else {
+            new_sink.capacity = 1;
+        }
+        new_sink.type = LB_SINK;
+        sink_index = lb_type_rr_node_graph.size();
+        lb_type_rr_node_graph.push_back(new_sink);
+        edge_lists.emplace_back();
+    }
+    edge_lists[pin_index][0].push_back({sink_index, 1});
 }
 
 /* Given a pb_graph_node, build the routing resource data for it.
@@ -284,149 +317,44 @@ static void alloc_and_load_lb_type_rr_graph_for_type(const t_logical_block_type_
  * This function populates the rr node for the pb_graph_pin of the current pb_graph_node then recursively
  * repeats this on all children of the pb_graph_node
  */
-static void alloc_and_load_lb_type_rr_graph_for_pb_graph_node(const t_pb_graph_node* pb_graph_node,
+static void alloc_and_load_lb_type_rr_graph_for_pb_graph_node(const t_logical_block_type_ptr lb_type,
+                                                              const t_pb_graph_node* pb_graph_node,
                                                               std::vector<t_lb_type_rr_node>& lb_type_rr_node_graph,
+                                                              t_lb_type_rr_edge_lists& edge_lists,
                                                               const int ext_rr_index) {
     t_pb_type* pb_type;
-    int pin_index;
     t_pb_graph_pin* pb_pin;
     t_pb_graph_node* parent_node;
 
     pb_type = pb_graph_node->pb_type;
     parent_node = pb_graph_node->parent_pb_graph_node;
-    int num_modes;
 
     if (pb_type->num_modes == 0) {
         /* This pb_graph_node is a terminating leaf node (primitive) */
 
         /* alloc and load input pins that connect to sinks */
         for (int iport = 0; iport < pb_graph_node->num_input_ports; iport++) {
-            PortEquivalence port_equivalent = PortEquivalence::NONE;
             int sink_index = OPEN;
             for (int ipin = 0; ipin < pb_graph_node->num_input_pins[iport]; ipin++) {
-                /* load intermediate indices */
                 pb_pin = &pb_graph_node->input_pins[iport][ipin];
-                port_equivalent = pb_pin->port->equivalent;
-                pin_index = pb_pin->pin_count_in_cluster;
-
-                /* alloc and load rr node info */
-                lb_type_rr_node_graph[pin_index].capacity = 1;
-                lb_type_rr_node_graph[pin_index].num_modes = 1;
-                lb_type_rr_node_graph[pin_index].num_fanout = new short[1];
-                lb_type_rr_node_graph[pin_index].num_fanout[0] = 1;
-                lb_type_rr_node_graph[pin_index].outedges = new t_lb_type_rr_node_edge*[1];
-                lb_type_rr_node_graph[pin_index].outedges[0] = nullptr;
-                lb_type_rr_node_graph[pin_index].outedges[0] = new t_lb_type_rr_node_edge[1];
-                lb_type_rr_node_graph[pin_index].outedges[0][0] = t_lb_type_rr_node_edge();
-                lb_type_rr_node_graph[pin_index].outedges[0][0].intrinsic_cost = 1;
-                lb_type_rr_node_graph[pin_index].type = LB_INTERMEDIATE;
-                lb_type_rr_node_graph[pin_index].pb_graph_pin = pb_pin;
-
-                if (port_equivalent == PortEquivalence::NONE || sink_index == OPEN) {
-                    /* Create new sink for input to primitive */
-                    t_lb_type_rr_node new_sink;
-                    if (port_equivalent != PortEquivalence::NONE) {
-                        new_sink.capacity = pb_pin->port->num_pins;
-                    } else {
-                        new_sink.capacity = 1;
-                    }
-                    new_sink.num_fanout = new short[1];
-                    new_sink.num_fanout[0] = 0;
-                    new_sink.type = LB_SINK;
-                    sink_index = lb_type_rr_node_graph.size();
-                    lb_type_rr_node_graph.push_back(new_sink);
-                }
-                lb_type_rr_node_graph[pin_index].outedges[0][0].node_index = sink_index;
+                load_primitive_input_lb_type_rr_node(lb_type_rr_node_graph, edge_lists, pb_pin, sink_index);
             }
         }
 
         /* alloc and load output pins that are represented as rr sources */
         for (int iport = 0; iport < pb_graph_node->num_output_ports; iport++) {
             for (int ipin = 0; ipin < pb_graph_node->num_output_pins[iport]; ipin++) {
-                /* load intermediate indices */
                 pb_pin = &pb_graph_node->output_pins[iport][ipin];
-                pin_index = pb_pin->pin_count_in_cluster;
-                num_modes = parent_node->pb_type->num_modes;
-
-                /* alloc and load rr node info */
-                lb_type_rr_node_graph[pin_index].capacity = 1;
-                lb_type_rr_node_graph[pin_index].num_modes = num_modes;
-                lb_type_rr_node_graph[pin_index].num_fanout = new short[num_modes];
-                lb_type_rr_node_graph[pin_index].outedges = new t_lb_type_rr_node_edge*[num_modes];
-                for (int i = 0; i < num_modes; i++) {
-                    lb_type_rr_node_graph[pin_index].outedges[i] = nullptr;
-                    lb_type_rr_node_graph[pin_index].num_fanout[i] = 0;
-                }
-                lb_type_rr_node_graph[pin_index].pb_graph_pin = pb_pin;
-
-                /* Count number of mode-dependant fanout */
-                for (int iedge = 0; iedge < pb_pin->num_output_edges; iedge++) {
-                    VTR_ASSERT(pb_pin->output_edges[iedge]->num_output_pins == 1);
-                    int pmode;
-                    pmode = pb_pin->output_edges[iedge]->interconnect->parent_mode->index;
-                    lb_type_rr_node_graph[pin_index].num_fanout[pmode]++;
-                }
-
-                /* Allocate space based on fanout */
-                for (int imode = 0; imode < num_modes; imode++) {
-                    lb_type_rr_node_graph[pin_index].outedges[imode] = new t_lb_type_rr_node_edge[lb_type_rr_node_graph[pin_index].num_fanout[imode]];
-                    for (int i = 0; i < lb_type_rr_node_graph[pin_index].num_fanout[imode]; i++)
-                        lb_type_rr_node_graph[pin_index].outedges[imode][i] = t_lb_type_rr_node_edge();
-                    lb_type_rr_node_graph[pin_index].num_fanout[imode] = 0; /* reset to 0 so that we can reuse this variable to populate fanout stats */
-                }
-
-                /* Load edges */
-                for (int iedge = 0; iedge < pb_pin->num_output_edges; iedge++) {
-                    VTR_ASSERT(pb_pin->output_edges[iedge]->num_output_pins == 1);
-                    int pmode;
-                    int ioutedges;
-                    pmode = pb_pin->output_edges[iedge]->interconnect->parent_mode->index;
-                    ioutedges = lb_type_rr_node_graph[pin_index].num_fanout[pmode];
-                    lb_type_rr_node_graph[pin_index].outedges[pmode][ioutedges].node_index = pb_pin->output_edges[iedge]->output_pins[0]->pin_count_in_cluster;
-                    lb_type_rr_node_graph[pin_index].outedges[pmode][ioutedges].intrinsic_cost = get_cost_of_pb_edge(pb_pin->output_edges[iedge]);
-                    lb_type_rr_node_graph[pin_index].num_fanout[pmode]++;
-                }
-
-                lb_type_rr_node_graph[pin_index].type = LB_SOURCE;
+                load_multi_mode_lb_type_rr_node(lb_type, lb_type_rr_node_graph, edge_lists, pb_pin, parent_node->pb_type->num_modes, LB_SOURCE);
             }
         }
 
         /* alloc and load clock pins that connect to sinks */
         for (int iport = 0; iport < pb_graph_node->num_clock_ports; iport++) {
-            PortEquivalence port_equivalent = PortEquivalence::NONE;
             int sink_index = OPEN;
             for (int ipin = 0; ipin < pb_graph_node->num_clock_pins[iport]; ipin++) {
-                /* load intermediate indices */
                 pb_pin = &pb_graph_node->clock_pins[iport][ipin];
-                port_equivalent = pb_pin->port->equivalent;
-                pin_index = pb_pin->pin_count_in_cluster;
-
-                /* alloc and load rr node info */
-                lb_type_rr_node_graph[pin_index].capacity = 1;
-                lb_type_rr_node_graph[pin_index].num_modes = 1;
-                lb_type_rr_node_graph[pin_index].num_fanout = new short[1];
-                lb_type_rr_node_graph[pin_index].num_fanout[0] = 1;
-                lb_type_rr_node_graph[pin_index].outedges = new t_lb_type_rr_node_edge*[1];
-                lb_type_rr_node_graph[pin_index].outedges[0] = new t_lb_type_rr_node_edge[1];
-                lb_type_rr_node_graph[pin_index].outedges[0][0].intrinsic_cost = 1;
-                lb_type_rr_node_graph[pin_index].type = LB_INTERMEDIATE;
-                lb_type_rr_node_graph[pin_index].pb_graph_pin = pb_pin;
-
-                if (port_equivalent == PortEquivalence::NONE || sink_index == OPEN) {
-                    /* Create new sink for clock to primitive */
-                    t_lb_type_rr_node new_sink;
-                    if (port_equivalent != PortEquivalence::NONE) {
-                        new_sink.capacity = pb_pin->port->num_pins;
-                    } else {
-                        new_sink.capacity = 1;
-                    }
-                    new_sink.num_fanout = new short[1];
-                    new_sink.num_fanout[0] = 0;
-                    new_sink.type = LB_SINK;
-                    sink_index = lb_type_rr_node_graph.size();
-                    lb_type_rr_node_graph.push_back(new_sink);
-                }
-                lb_type_rr_node_graph[pin_index].outedges[0][0].node_index = sink_index;
+                load_primitive_input_lb_type_rr_node(lb_type_rr_node_graph, edge_lists, pb_pin, sink_index);
             }
         }
     } else {
@@ -434,7 +362,7 @@ static void alloc_and_load_lb_type_rr_graph_for_pb_graph_node(const t_pb_graph_n
         for (int imode = 0; imode < pb_type->num_modes; imode++) {
             for (int ipb_type = 0; ipb_type < pb_type->modes[imode].num_pb_type_children; ipb_type++) {
                 for (int ipb = 0; ipb < pb_type->modes[imode].pb_type_children[ipb_type].num_pb; ipb++) {
-                    alloc_and_load_lb_type_rr_graph_for_pb_graph_node(&pb_graph_node->child_pb_graph_nodes[imode][ipb_type][ipb], lb_type_rr_node_graph, ext_rr_index);
+                    alloc_and_load_lb_type_rr_graph_for_pb_graph_node(lb_type, &pb_graph_node->child_pb_graph_nodes[imode][ipb_type][ipb], lb_type_rr_node_graph, edge_lists, ext_rr_index);
                 }
             }
         }
@@ -442,52 +370,8 @@ static void alloc_and_load_lb_type_rr_graph_for_pb_graph_node(const t_pb_graph_n
         /* alloc and load input pins that drive other rr nodes */
         for (int iport = 0; iport < pb_graph_node->num_input_ports; iport++) {
             for (int ipin = 0; ipin < pb_graph_node->num_input_pins[iport]; ipin++) {
-                /* load intermediate indices */
                 pb_pin = &pb_graph_node->input_pins[iport][ipin];
-                pin_index = pb_pin->pin_count_in_cluster;
-                num_modes = pb_graph_node->pb_type->num_modes;
-
-                /* alloc and load rr node info */
-                lb_type_rr_node_graph[pin_index].capacity = 1;
-                lb_type_rr_node_graph[pin_index].num_modes = num_modes;
-                lb_type_rr_node_graph[pin_index].num_fanout = new short[num_modes];
-                lb_type_rr_node_graph[pin_index].outedges = new t_lb_type_rr_node_edge*[num_modes];
-                for (int i = 0; i < num_modes; i++) {
-                    lb_type_rr_node_graph[pin_index].outedges[i] = nullptr;
-                    lb_type_rr_node_graph[pin_index].num_fanout[i] = 0;
-                }
-                lb_type_rr_node_graph[pin_index].pb_graph_pin = pb_pin;
-
-                /* Count number of mode-dependant out-going edges */
-                for (int iedge = 0; iedge < pb_pin->num_output_edges; iedge++) {
-                    VTR_ASSERT(pb_pin->output_edges[iedge]->num_output_pins == 1);
-                    int pmode;
-                    pmode = pb_pin->output_edges[iedge]->interconnect->parent_mode->index;
-                    lb_type_rr_node_graph[pin_index].num_fanout[pmode]++;
-                }
-
-                /* Allocate space based on fanout */
-                for (int imode = 0; imode < num_modes; imode++) {
-                    lb_type_rr_node_graph[pin_index].outedges[imode] = new t_lb_type_rr_node_edge[lb_type_rr_node_graph[pin_index].num_fanout[imode]];
-                    for (int i = 0; i < lb_type_rr_node_graph[pin_index].num_fanout[imode]; i++) {
-                        lb_type_rr_node_graph[pin_index].outedges[imode][i] = t_lb_type_rr_node_edge();
-                    }
-                    lb_type_rr_node_graph[pin_index].num_fanout[imode] = 0; /* reset to 0 so that we can reuse this variable to populate fanout stats */
-                }
-
-                /* Load edges */
-                for (int iedge = 0; iedge < pb_pin->num_output_edges; iedge++) {
-                    VTR_ASSERT(pb_pin->output_edges[iedge]->num_output_pins == 1);
-                    int pmode;
-                    int ioutedges;
-                    pmode = pb_pin->output_edges[iedge]->interconnect->parent_mode->index;
-                    ioutedges = lb_type_rr_node_graph[pin_index].num_fanout[pmode];
-                    lb_type_rr_node_graph[pin_index].outedges[pmode][ioutedges].node_index = pb_pin->output_edges[iedge]->output_pins[0]->pin_count_in_cluster;
-                    lb_type_rr_node_graph[pin_index].outedges[pmode][ioutedges].intrinsic_cost = get_cost_of_pb_edge(pb_pin->output_edges[iedge]);
-                    lb_type_rr_node_graph[pin_index].num_fanout[pmode]++;
-                }
-
-                lb_type_rr_node_graph[pin_index].type = LB_INTERMEDIATE;
+                load_multi_mode_lb_type_rr_node(lb_type, lb_type_rr_node_graph, edge_lists, pb_pin, pb_type->num_modes, LB_INTERMEDIATE);
             }
         }
 
@@ -496,85 +380,19 @@ static void alloc_and_load_lb_type_rr_graph_for_pb_graph_node(const t_pb_graph_n
             /* Top level output pins go to other CLBs, represented different */
             for (int iport = 0; iport < pb_graph_node->num_output_ports; iport++) {
                 for (int ipin = 0; ipin < pb_graph_node->num_output_pins[iport]; ipin++) {
-                    /* load intermediate indices */
                     pb_pin = &pb_graph_node->output_pins[iport][ipin];
-                    pin_index = pb_pin->pin_count_in_cluster;
-                    num_modes = 1; /* One edge to external sinks */
-                    lb_type_rr_node_graph[pin_index].type = LB_INTERMEDIATE;
-
-                    /* alloc and load rr node info */
-                    lb_type_rr_node_graph[pin_index].capacity = 1;
-                    lb_type_rr_node_graph[pin_index].num_modes = num_modes;
-                    lb_type_rr_node_graph[pin_index].num_fanout = new short[num_modes];
-                    lb_type_rr_node_graph[pin_index].outedges = new t_lb_type_rr_node_edge*[num_modes];
-                    for (int i = 0; i < num_modes; i++) {
-                        lb_type_rr_node_graph[pin_index].outedges[i] = nullptr;
-                        lb_type_rr_node_graph[pin_index].num_fanout[i] = 0;
-                    }
-                    lb_type_rr_node_graph[pin_index].pb_graph_pin = pb_pin;
-
-                    /* One edge to external sinks */
-                    lb_type_rr_node_graph[pin_index].num_fanout[0] = 1;
-
-                    /* Allocate space based on fanout */
-                    lb_type_rr_node_graph[pin_index].outedges[0] = new t_lb_type_rr_node_edge[lb_type_rr_node_graph[pin_index].num_fanout[0]];
-                    for (int i = 0; i < lb_type_rr_node_graph[pin_index].num_fanout[0]; i++)
-                        lb_type_rr_node_graph[pin_index].outedges[0][i] = t_lb_type_rr_node_edge();
-
-                    /* Load one edge to external opin */;
-                    lb_type_rr_node_graph[pin_index].outedges[0][0].node_index = ext_rr_index;
-                    lb_type_rr_node_graph[pin_index].outedges[0][0].intrinsic_cost = 1;
+                    load_single_mode_lb_type_rr_node(lb_type_rr_node_graph, edge_lists, pb_pin, LB_INTERMEDIATE);
+
+                    /* Load one edge to external opin */
+                    edge_lists[pb_pin->pin_count_in_cluster][0].push_back({ext_rr_index, 1});
                 }
             }
         } else {
             /* Subcluster output pins */
             for (int iport = 0; iport < pb_graph_node->num_output_ports; iport++) {
                 for (int ipin = 0; ipin < pb_graph_node->num_output_pins[iport]; ipin++) {
-                    /* load intermediate indices */
                     pb_pin = &pb_graph_node->output_pins[iport][ipin];
-                    pin_index = pb_pin->pin_count_in_cluster;
-                    num_modes = parent_node->pb_type->num_modes;
-
-                    /* alloc and load rr node info */
-                    lb_type_rr_node_graph[pin_index].capacity = 1;
-                    lb_type_rr_node_graph[pin_index].num_modes = num_modes;
-                    lb_type_rr_node_graph[pin_index].num_fanout = new short[num_modes];
-                    lb_type_rr_node_graph[pin_index].outedges = new t_lb_type_rr_node_edge*[num_modes];
-                    for (int i = 0; i < num_modes; i++) {
-                        lb_type_rr_node_graph[pin_index].outedges[i] = nullptr;
-                        lb_type_rr_node_graph[pin_index].num_fanout[i] = 0;
-                    }
-                    lb_type_rr_node_graph[pin_index].pb_graph_pin = pb_pin;
-
-                    /* Count number of mode-dependant out-going edges */
-                    for (int iedge = 0; iedge < pb_pin->num_output_edges; iedge++) {
-                        VTR_ASSERT(pb_pin->output_edges[iedge]->num_output_pins == 1);
-                        int pmode;
-                        pmode = pb_pin->output_edges[iedge]->interconnect->parent_mode->index;
-                        lb_type_rr_node_graph[pin_index].num_fanout[pmode]++;
-                    }
-
-                    /* Allocate space based on fanout */
-                    for (int imode = 0; imode < num_modes; imode++) {
-                        lb_type_rr_node_graph[pin_index].outedges[imode] = new t_lb_type_rr_node_edge[lb_type_rr_node_graph[pin_index].num_fanout[imode]];
-                        for (int i = 0; i < lb_type_rr_node_graph[pin_index].num_fanout[imode]; i++)
-                            lb_type_rr_node_graph[pin_index].outedges[imode][i] = t_lb_type_rr_node_edge();
-                        lb_type_rr_node_graph[pin_index].num_fanout[imode] = 0; /* reset to 0 so that we can reuse this variable to populate fanout stats */
-                    }
-
-                    /* Load edges */
-                    for (int iedge = 0; iedge < pb_pin->num_output_edges; iedge++) {
-                        VTR_ASSERT(pb_pin->output_edges[iedge]->num_output_pins == 1);
-                        int pmode;
-                        int ioutedges;
-                        pmode = pb_pin->output_edges[iedge]->interconnect->parent_mode->index;
-                        ioutedges = lb_type_rr_node_graph[pin_index].num_fanout[pmode];
-                        lb_type_rr_node_graph[pin_index].outedges[pmode][ioutedges].node_index = pb_pin->output_edges[iedge]->output_pins[0]->pin_count_in_cluster;
-                        lb_type_rr_node_graph[pin_index].outedges[pmode][ioutedges].intrinsic_cost = get_cost_of_pb_edge(pb_pin->output_edges[iedge]);
-                        lb_type_rr_node_graph[pin_index].num_fanout[pmode]++;
-                    }
-
-                    lb_type_rr_node_graph[pin_index].type = LB_INTERMEDIATE;
+                    load_multi_mode_lb_type_rr_node(lb_type, lb_type_rr_node_graph, edge_lists, pb_pin, parent_node->pb_type->num_modes, LB_INTERMEDIATE);
                 }
             }
         }
@@ -582,54 +400,63 @@ static void alloc_and_load_lb_type_rr_graph_for_pb_graph_node(const t_pb_graph_n
         /* alloc and load clock pins that drive other rr nodes */
         for (int iport = 0; iport < pb_graph_node->num_clock_ports; iport++) {
             for (int ipin = 0; ipin < pb_graph_node->num_clock_pins[iport]; ipin++) {
-                /* load intermediate indices */
                 pb_pin = &pb_graph_node->clock_pins[iport][ipin];
-                pin_index = pb_pin->pin_count_in_cluster;
-                num_modes = pb_graph_node->pb_type->num_modes;
-
-                /* alloc and load rr node info */
-                lb_type_rr_node_graph[pin_index].capacity = 1;
-                lb_type_rr_node_graph[pin_index].num_modes = num_modes;
-                lb_type_rr_node_graph[pin_index].num_fanout = new short[num_modes];
-                lb_type_rr_node_graph[pin_index].outedges = new t_lb_type_rr_node_edge*[num_modes];
-                for (int i = 0; i < num_modes; i++) {
-                    lb_type_rr_node_graph[pin_index].outedges[i] = nullptr;
-                    lb_type_rr_node_graph[pin_index].num_fanout[i] = 0;
-                }
-                lb_type_rr_node_graph[pin_index].pb_graph_pin = pb_pin;
-
-                /* Count number of mode-dependant out-going edges */
-                for (int iedge = 0; iedge < pb_pin->num_output_edges; iedge++) {
-                    VTR_ASSERT(pb_pin->output_edges[iedge]->num_output_pins == 1);
-                    int pmode;
-                    pmode = pb_pin->output_edges[iedge]->interconnect->parent_mode->index;
-                    lb_type_rr_node_graph[pin_index].num_fanout[pmode]++;
-                }
+                load_multi_mode_lb_type_rr_node(lb_type, lb_type_rr_node_graph, edge_lists, pb_pin, pb_type->num_modes, LB_INTERMEDIATE);
+            }
+        }
+    }
+}
 
-                /* Allocate space based on fanout */
-                for (int imode = 0; imode < num_modes; imode++) {
-                    lb_type_rr_node_graph[pin_index].outedges[imode] = new t_lb_type_rr_node_edge[lb_type_rr_node_graph[pin_index].num_fanout[imode]];
-                    for (int i = 0; i < lb_type_rr_node_graph[pin_index].num_fanout[imode]; i++)
-                        lb_type_rr_node_graph[pin_index].outedges[imode][i] = t_lb_type_rr_node_edge();
-                    lb_type_rr_node_graph[pin_index].num_fanout[imode] = 0; /* reset to 0 so that we can reuse this variable to populate fanout stats */
-                }
+/* Load the out-going edges of the rr node of pb_pin, in each of its num_modes modes,
+ * from the flattened pin fanout of the logic block type */
+static void load_lb_type_rr_node_outedges(const t_logical_block_type_ptr lb_type,
+                                          const t_pb_graph_pin* pb_pin,
+                                          int num_modes,
+                                          std::vector<std::vector<t_lb_type_rr_node_edge>>& outedges) {
+    uint32_t first_fanout = lb_type->pb_pin_fanout_offsets[pb_pin->pin_count_in_cluster];
+    uint32_t last_fanout = lb_type->pb_pin_fanout_offsets[pb_pin->pin_count_in_cluster + 1];
+
+    outedges.resize(num_modes);
+    for (uint32_t ifanout = first_fanout; ifanout < last_fanout; ifanout++) {
+        const t_pb_graph_pin_fanout& fanout = lb_type->pb_pin_fanout[ifanout];
+        VTR_ASSERT(fanout.edge->num_output_pins == 1);
+        outedges[fanout.mode].push_back({fanout.sink_pin, get_cost_of_pb_edge(fanout.edge)});
+    }
+}
 
-                /* Load edges */
-                for (int iedge = 0; iedge < pb_pin->num_output_edges; iedge++) {
-                    VTR_ASSERT(pb_pin->output_edges[iedge]->num_output_pins == 1);
-                    int pmode;
-                    int ioutedges;
-                    pmode = pb_pin->output_edges[iedge]->interconnect->parent_mode->index;
-                    ioutedges = lb_type_rr_node_graph[pin_index].num_fanout[pmode];
-                    lb_type_rr_node_graph[pin_index].outedges[pmode][ioutedges].node_index = pb_pin->output_edges[iedge]->output_pins[0]->pin_count_in_cluster;
-                    lb_type_rr_node_graph[pin_index].outedges[pmode][ioutedges].intrinsic_cost = get_cost_of_pb_edge(pb_pin->output_edges[iedge]);
-                    lb_type_rr_node_graph[pin_index].num_fanout[pmode]++;
-                }
+/* Store the out-going edges of all the nodes contiguously in the graph (see t_lb_type_rr_graph) */
+static void compress_lb_type_rr_graph_edges(const t_lb_type_rr_edge_lists& edge_lists, t_lb_type_rr_graph& lb_type_rr_graph) {
+    VTR_ASSERT(edge_lists.size() == lb_type_rr_graph.nodes.size());
 
-                lb_type_rr_node_graph[pin_index].type = LB_INTERMEDIATE;
-            }
+    size_t num_mode_edges = 0;
+    size_t num_edges = 0;
+    for (const auto& node_edge_lists : edge_lists) {
+        num_mode_edges += node_edge_lists.size();
+        for (const auto& mode_edges : node_edge_lists) {
+            num_edges += mode_edges.size();
+        }
+    }
+
+    lb_type_rr_graph.mode_edges.clear();
+    lb_type_rr_graph.mode_edges.reserve(num_mode_edges + 1);
+    lb_type_rr_graph.edges.clear();
+    lb_type_rr_graph.edges.reserve(num_edges);
+
+    for (size_t inode = 0; inode < edge_lists.size(); inode++) {
+        t_lb_type_rr_node& node = lb_type_rr_graph.nodes[inode];
+        VTR_ASSERT((int)edge_lists[inode].size() <= std::max(node.num_modes, 1));
+
+        node.first_mode_edges = lb_type_rr_graph.mode_edges.size();
+        for (const auto& mode_edges : edge_lists[inode]) {
+            lb_type_rr_graph.mode_edges.push_back(lb_type_rr_graph.edges.size());
+            lb_type_rr_graph.edges.insert(lb_type_rr_graph.edges.end(), mode_edges.begin(), mode_edges.end());
+        }
+        /* Modes without an edge list (e.g. of nodes without fanout) have no edges */
+        for (int imode = edge_lists[inode].size(); imode < node.num_modes; imode++) {
+            lb_type_rr_graph.mode_edges.push_back(lb_type_rr_graph.edges.size());
         }
     }
+    lb_type_rr_graph.mode_edges.push_back(lb_type_rr_graph.edges.size());
 }
 
 /* Determine intrinsic cost of an edge that joins two pb_graph_pins */
@@ -638,7 +465,7 @@ static float get_cost_of_pb_edge(t_pb_graph_edge* /*edge*/) {
 }
 
 /* Print logic block type routing resource graph */
-static void print_lb_type_rr_graph(FILE* fp, const std::vector<t_lb_type_rr_node>& lb_type_rr_graph) {
+static void print_lb_type_rr_graph(FILE* fp, const t_lb_type_rr_graph& lb_type_rr_graph) {
     for (unsigned int inode = 0; inode < lb_type_rr_graph.size(); inode++) {
         fprintf(fp, "Node %d\n", inode);
         if (lb_type_rr_graph[inode].pb_graph_pin != nullptr) {
@@ -653,20 +480,18 @@ static void print_lb_type_rr_graph(FILE* fp, const std::vector<t_lb_type_rr_node
         fprintf(fp, "\tNumber Modes: %d\n", lb_type_rr_graph[inode].num_modes);
         fprintf(fp, "\tIntrinsic Cost: %g\n", lb_type_rr_graph[inode].intrinsic_cost);
         for (int imode = 0; imode < lb_type_rr_graph[inode].num_modes; imode++) {
-            if (lb_type_rr_graph[inode].num_fanout != nullptr) {
-                fprintf(fp, "\tMode: %d   # Outedges: %d", imode, lb_type_rr_graph[inode].num_fanout[imode]);
-                int count = 0;
-                for (int iedge = 0; iedge < lb_type_rr_graph[inode].num_fanout[imode]; iedge++) {
-                    if (count % 5 == 0) {
-                        /* Formatting to prevent very long lines */
-                        fprintf(fp, "\n\t\t");
-                    }
-                    count++;
-                    fprintf(fp, "(%d, %g) ", lb_type_rr_graph[inode].outedges[imode][iedge].node_index,
-                            lb_type_rr_graph[inode].outedges[imode][iedge].intrinsic_cost);
+            fprintf(fp, "\tMode: %d   # Outedges: %d", imode, lb_type_rr_graph.num_fanout(inode, imode));
+            int count = 0;
+            for (int iedge = 0; iedge < lb_type_rr_graph.num_fanout(inode, imode); iedge++) {
+                if (count % 5 == 0) {
+                    /* Formatting to prevent very long lines */
+                    fprintf(fp, "\n\t\t");
                 }
-                fprintf(fp, "\n");
+                count++;
+                fprintf(fp, "(%d, %g) ", lb_type_rr_graph.outedge(inode, imode, iedge).node_index,
+                        lb_type_rr_graph.outedge(inode, imode, iedge).intrinsic_cost);
             }
+            fprintf(fp, "\n");
         }
 
         fprintf(fp, "\n");
@@ -11,15 +11,15 @@
 #include "pack_types.h"
 
 /* Constructors/Destructors */
-std::vector<t_lb_type_rr_node>* alloc_and_load_all_lb_type_rr_graph();
-void free_all_lb_type_rr_graph(std::vector<t_lb_type_rr_node>* lb_type_rr_graphs);
+t_lb_type_rr_graph* alloc_and_load_all_lb_type_rr_graph();
+void free_all_lb_type_rr_graph(t_lb_type_rr_graph* lb_type_rr_graphs);
 
 /* Accessor functions */
 int get_lb_type_rr_graph_ext_source_index(t_logical_block_type_ptr lb_type);
 int get_lb_type_rr_graph_ext_sink_index(t_logical_block_type_ptr lb_type);
-int get_lb_type_rr_graph_edge_mode(std::vector<t_lb_type_rr_node>& lb_type_rr_graph, int src_index, int dst_index);
+int get_lb_type_rr_graph_edge_mode(t_lb_type_rr_graph& lb_type_rr_graph, int src_index, int dst_index);
 
 /* Debug functions */
-void echo_lb_type_rr_graphs(char* filename, std::vector<t_lb_type_rr_node>* lb_type_rr_graphs);
+void echo_lb_type_rr_graphs(char* filename, t_lb_type_rr_graph* lb_type_rr_graphs);
 
 #endif
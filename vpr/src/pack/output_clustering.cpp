@@ -3,9 +3,12 @@
  * Print complex block information to a file
  */
 
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
+#include <sstream>
 #include <vector>
 
 #include "cluster_legalizer.h"
@@ -28,6 +31,10 @@
 #include "vpr_utils.h"
 #include "pack.h"
 
+#ifdef VPR_USE_TBB
+#    include <tbb/parallel_for.h>
+#endif
+
 #define LINELENGTH 1024
 #define TAB_LENGTH 4
 
@@ -609,39 +616,83 @@ static void clustering_xml_block(pugi::xml_node& parent_node, t_logical_block_ty
     }
 }
 
-static void clustering_xml_blocks_from_legalizer(pugi::xml_node& block_node,
-                                                 const IntraLbPbPinLookup& pb_graph_pin_lookup_from_index_by_type,
-                                                 ClusterLegalizer& cluster_legalizer) {
+/* A cluster to output */
+struct t_output_cluster {
+    t_logical_block_type_ptr type;
+    t_pb* pb;
+    int index;
+};
+
+/* Number of clusters serialized at a time: only their text is held in memory */
+constexpr size_t CLUSTERS_PER_BATCH = 1024;
+
+static std::vector<t_output_cluster> output_clusters_from_legalizer(ClusterLegalizer& cluster_legalizer) {
     // Finalize the cluster legalization by ensuring that each cluster pb has
     // its pb_route calculated.
     cluster_legalizer.finalize();
+    std::vector<t_output_cluster> clusters;
     for (LegalizationClusterId cluster_id : cluster_legalizer.clusters()) {
-        clustering_xml_block(block_node,
-                             cluster_legalizer.get_cluster_type(cluster_id),
-                             pb_graph_pin_lookup_from_index_by_type,
-                             cluster_legalizer.get_cluster_pb(cluster_id),
-                             size_t(cluster_id),
-                             cluster_legalizer.get_cluster_pb(cluster_id)->pb_route);
+        clusters.push_back({cluster_legalizer.get_cluster_type(cluster_id),
+                            cluster_legalizer.get_cluster_pb(cluster_id),
+                            int(size_t(cluster_id))});
     }
+    return clusters;
 }
 
-static void clustering_xml_blocks_from_netlist(pugi::xml_node& block_node,
-                                               const IntraLbPbPinLookup& pb_graph_pin_lookup_from_index_by_type) {
+static std::vector<t_output_cluster> output_clusters_from_netlist() {
     const ClusteredNetlist& clb_nlist = g_vpr_ctx.clustering().clb_nlist;
+    std::vector<t_output_cluster> clusters;
     for (auto blk_id : clb_nlist.blocks()) {
         /* TODO: Must do check that total CLB pins match top-level pb pins, perhaps check this earlier? */
-        clustering_xml_block(block_node,
-                             clb_nlist.block_type(blk_id),
-                             pb_graph_pin_lookup_from_index_by_type,
-                             clb_nlist.block_pb(blk_id),
-                             size_t(blk_id),
-                             clb_nlist.block_pb(blk_id)->pb_route);
+        clusters.push_back({clb_nlist.block_type(blk_id),
+                            clb_nlist.block_pb(blk_id),
+                            int(size_t(blk_id))});
+    }
+    return clusters;
+}
+
+/* Returns the XML text of a cluster, as it appears in the .net file (i.e. indented under the top-level block).
+ * Each cluster is built in its own small document, so the clusters can be serialized independently. */
+static std::string clustering_xml_cluster_text(const t_output_cluster& cluster, const IntraLbPbPinLookup& pb_graph_pin_lookup_from_index_by_type) {
+    pugi::xml_document cluster_xml;
+    pugi::xml_node parent_node = cluster_xml;
+    clustering_xml_block(parent_node, cluster.type, pb_graph_pin_lookup_from_index_by_type, cluster.pb, cluster.index, cluster.pb->pb_route);
+
+    std::ostringstream text;
+    cluster_xml.first_child().print(text, "\t", pugi::format_default, pugi::encoding_auto, 1);
+    return text.str();
+}
+
+/* Writes the clusters in order, serializing a batch of them at a time (in parallel) */
+static void write_clustering_xml_clusters(std::ostream& out,
+                                          const std::vector<t_output_cluster>& clusters,
+                                          const IntraLbPbPinLookup& pb_graph_pin_lookup_from_index_by_type) {
+    std::vector<std::string> cluster_texts;
+    for (size_t batch_begin = 0; batch_begin < clusters.size(); batch_begin += CLUSTERS_PER_BATCH) {
+        size_t batch_end = std::min(batch_begin + CLUSTERS_PER_BATCH, clusters.size());
+        cluster_texts.resize(batch_end - batch_begin);
+
+        auto serialize_cluster = [&](size_t icluster) {
+            cluster_texts[icluster - batch_begin] = clustering_xml_cluster_text(clusters[icluster], pb_graph_pin_lookup_from_index_by_type);
+        };
+#ifdef VPR_USE_TBB
+        tbb::parallel_for(batch_begin, batch_end, serialize_cluster);
+#else
+        for (size_t icluster = batch_begin; icluster < batch_end; icluster++) {
+            serialize_cluster(icluster);
+        }
+#endif
+
+        for (const std::string& text : cluster_texts) {
+            out << text;
+        }
     }
 }
 
 /* This routine dumps out the output netlist in a format suitable for  *
  * input to vpr. This routine also dumps out the internal structure of *
- * the cluster, in essentially a graph based format.                   */
+ * the cluster, in essentially a graph based format.                   *
+ * The clusters are serialized in parallel and streamed to the file.   */
 void output_clustering(ClusterLegalizer* cluster_legalizer_ptr, bool global_clocks, const std::unordered_set<AtomNetId>& is_clock, const std::string& architecture_id, const char* out_fname, bool skip_clustering, bool from_legalizer) {
     const DeviceContext& device_ctx = g_vpr_ctx.device();
     const AtomNetlist& atom_nlist = g_vpr_ctx.atom().nlist;
@@ -702,17 +753,32 @@ void output_clustering(ClusterLegalizer* cluster_legalizer_ptr, bool global_cloc
         block_node.append_child("clocks").text().set(vtr::join(clocks.begin(), clocks.end(), " ").c_str());
     }
 
+    std::vector<t_output_cluster> clusters;
     if (skip_clustering == false) {
         if (from_legalizer) {
             VTR_ASSERT(cluster_legalizer_ptr != nullptr);
-            clustering_xml_blocks_from_legalizer(block_node, pb_graph_pin_lookup_from_index_by_type, *cluster_legalizer_ptr);
+            clusters = output_clusters_from_legalizer(*cluster_legalizer_ptr);
         } else {
             VTR_ASSERT(cluster_legalizer_ptr == nullptr);
-            clustering_xml_blocks_from_netlist(block_node, pb_graph_pin_lookup_from_index_by_type);
+            clusters = output_clusters_from_netlist();
         }
     }
 
-    out_xml.save_file(out_fname);
+    /* The document only holds the top-level block: the clusters are streamed in
+     * before its closing tag, rather than built into the document */
+    std::ostringstream top_level_xml;
+    out_xml.save(top_level_xml);
+    std::string top_level_text = top_level_xml.str();
+    size_t top_level_end = top_level_text.rfind("</block>");
+    VTR_ASSERT(top_level_end != std::string::npos);
+
+    std::ofstream out(out_fname, std::ios::binary);
+    if (!out) {
+        VPR_FATAL_ERROR(VPR_ERROR_PACK, "Failed to open '%s' for writing\n", out_fname);
+    }
+    out.write(top_level_text.data(), top_level_end);
+    write_clustering_xml_clusters(out, clusters, pb_graph_pin_lookup_from_index_by_type);
+    out.write(top_level_text.data() + top_level_end, top_level_text.size() - top_level_end);
 
     print_stats(cluster_legalizer_ptr, from_legalizer);
 }
@@ -5,6 +5,7 @@
 #include "cluster_legalizer.h"
 #include "cluster_util.h"
 #include "globals.h"
+#include "incremental_pack.h"
 #include "pack.h"
 #include "prepack.h"
 #include "vpr_context.h"
@@ -32,7 +33,7 @@ bool try_pack(t_packer_opts* packer_opts,
               const t_model* user_models,
               const t_model* library_models,
               float interc_delay,
-              std::vector<t_lb_type_rr_node>* lb_type_rr_graphs) {
+              t_lb_type_rr_graph* lb_type_rr_graphs) {
     const AtomContext& atom_ctx = g_vpr_ctx.atom();
     const DeviceContext& device_ctx = g_vpr_ctx.device();
 
@@ -104,6 +105,16 @@ bool try_pack(t_packer_opts* packer_opts,
     int pack_iteration = 1;
     bool floorplan_regions_overfull = false;
 
+    // The clusters of a previous packing, which are reused (as far as they
+    // are unchanged) in every packing iteration.
+    std::vector<t_previous_cluster> previous_clusters;
+    if (!packer_opts->incremental_pack_file.empty()) {
+        VTR_LOG("Loading previous packing from '%s'.\n", packer_opts->incremental_pack_file.c_str());
+        previous_clusters = read_previous_clusters(packer_opts->incremental_pack_file,
+                                                   atom_ctx.nlist,
+                                                   device_ctx.logical_block_types);
+    }
+
     // Initialize the cluster legalizer.
     ClusterLegalizer cluster_legalizer(atom_ctx.nlist,
                                        prepacker,
@@ -140,6 +151,7 @@ bool try_pack(t_packer_opts* packer_opts,
                                                 attraction_groups,
                                                 floorplan_regions_overfull,
                                                 high_fanout_thresholds,
+                                                previous_clusters,
                                                 clustering_data);
 
         //Try to size/find a device
@@ -236,6 +248,14 @@ bool try_pack(t_packer_opts* packer_opts,
             VPR_FATAL_ERROR(VPR_ERROR_OTHER, "Failed to find device which satisfies resource requirements required: %s (available %s)", resource_reqs.c_str(), resource_avail.c_str());
         }
 
+        // Only re-pack around the overfull floorplan regions, if asked: the
+        // other clusters are kept (and re-legalized) in the next iteration.
+        if (packer_opts->repack_overfull_regions_only && floorplan_regions_overfull) {
+            previous_clusters = get_clusters_outside_overfull_regions(cluster_legalizer,
+                                                                      g_vpr_ctx.floorplanning().overfull_partition_regions,
+                                                                      packer_opts->transitive_fanout_threshold);
+        }
+
         //Reset clustering for re-packing
         for (auto blk : g_vpr_ctx.atom().nlist.blocks()) {
             g_vpr_ctx.mutable_atom().lookup.set_atom_clb(blk, ClusterBlockId::INVALID());
@@ -268,6 +288,13 @@ bool try_pack(t_packer_opts* packer_opts,
      */
     /******************** End **************************/
 
+    const IntraLbRouteCache& route_cache = cluster_legalizer.get_intra_lb_route_cache();
+    size_t num_route_queries = route_cache.num_hits() + route_cache.num_misses();
+    VTR_LOG("Intra-LB route cache: %zu hits, %zu misses (%.1f%% hit rate), %zu entries, %zu evictions\n",
+            route_cache.num_hits(), route_cache.num_misses(),
+            num_route_queries > 0 ? 100. * route_cache.num_hits() / num_route_queries : 0.,
+            route_cache.num_entries(), route_cache.num_evictions());
+
     //check clustering and output it
     check_and_output_clustering(cluster_legalizer, *packer_opts, is_clock, arch);
 
@@ -7,7 +7,7 @@
 class AtomNetId;
 struct t_analysis_opts;
 struct t_arch;
-struct t_lb_type_rr_node;
+struct t_lb_type_rr_graph;
 struct t_model;
 struct t_packer_opts;
 
@@ -17,7 +17,7 @@ bool try_pack(t_packer_opts* packer_opts,
               const t_model* user_models,
               const t_model* library_models,
               float interc_delay,
-              std::vector<t_lb_type_rr_node>* lb_type_rr_graphs);
+              t_lb_type_rr_graph* lb_type_rr_graphs);
 
 float get_arch_switch_info(short switch_index, int switch_fanin, float& Tdel_switch, float& R_switch, float& Cout_switch);
 
@@ -6,7 +6,10 @@
  *
  * Defines core data structures used in packing
  */
+#include <algorithm>
+#include <cstdint>
 #include <map>
+#include <queue>
 #include <unordered_map>
 #include <vector>
 
@@ -14,6 +17,8 @@
 #include "atom_netlist_fwd.h"
 #include "attraction_groups.h"
 
+class IntraLbRouteCache;
+
 /**************************************************************************
  * Packing Algorithm Enumerations
  ***************************************************************************/
@@ -32,17 +37,69 @@ const std::vector<const char*> lb_rr_type_str{
  * Packing Algorithm Data Structures
  ***************************************************************************/
 
-/* Stores statistical information for a physical cluster_ctx.blocks such as costs and usages */
-struct t_pb_stats {
-    /* Packing statistics */
-    std::map<AtomBlockId, float> gain; /* Attraction (inverse of cost) function */
+/**
+ * @brief A table of values indexed by atom block or atom net id.
+ *
+ * Each entry records the generation (epoch) in which it was last written, and
+ * entries of older generations are treated as absent. The table can therefore be
+ * emptied in O(1) by clear(), and keeps its storage, so it can be reused for every
+ * cluster without the allocation and rebalancing cost of a std::map.
+ */
+template<typename K, typename V>
+class t_atom_epoch_table {
+  public:
+    ///@brief Sizes the table for ids in [0, num_ids) and empties it
+    void init(size_t num_ids) {
+        values_.assign(num_ids, V());
+        epochs_.assign(num_ids, 0);
+        epoch_ = 1;
+    }
+
+    ///@brief Empties the table
+    void clear() {
+        if (++epoch_ == 0) {
+            //The epoch wrapped around: the stale tags could be mistaken for current ones
+            std::fill(epochs_.begin(), epochs_.end(), 0);
+            epoch_ = 1;
+        }
+    }
+
+    ///@brief Returns true if a value has been stored for id since the last clear()
+    bool contains(K id) const {
+        return epochs_[size_t(id)] == epoch_;
+    }
+
+    ///@brief Returns the value of id, inserting a value-initialized one if absent (like std::map::operator[])
+    V& operator[](K id) {
+        size_t index = size_t(id);
+        if (epochs_[index] != epoch_) {
+            epochs_[index] = epoch_;
+            values_[index] = V();
+        }
+        return values_[index];
+    }
+
+  private:
+    std::vector<V> values_;
+    std::vector<uint32_t> epochs_;
+    uint32_t epoch_ = 0;
+};
 
-    std::map<AtomBlockId, float> timinggain;     /* The timing criticality score of this atom cluster_ctx.blocks.
-                                                  * Determined by the most critical atom net
-                                                  * between this atom cluster_ctx.blocks and any atom cluster_ctx.blocks in
-                                                  * the current pb */
-    std::map<AtomBlockId, float> connectiongain; /* Weighted sum of connections to attraction function */
-    std::map<AtomBlockId, float> sharinggain;    /* How many nets on an atom cluster_ctx.blocks are already in the pb under consideration */
+/**
+ * @brief The gain tables of the cluster being filled by the packer.
+ *
+ * A single instance is owned by the ClusterLegalizer and is cleared whenever a
+ * new cluster is started, since the gains are only needed while a cluster is open.
+ */
+struct t_pb_gain_stats {
+    t_atom_epoch_table<AtomBlockId, float> gain; /* Attraction (inverse of cost) function */
+
+    t_atom_epoch_table<AtomBlockId, float> timinggain;     /* The timing criticality score of this atom cluster_ctx.blocks.
+                                                            * Determined by the most critical atom net
+                                                            * between this atom cluster_ctx.blocks and any atom cluster_ctx.blocks in
+                                                            * the current pb */
+    t_atom_epoch_table<AtomBlockId, float> connectiongain; /* Weighted sum of connections to attraction function */
+    t_atom_epoch_table<AtomBlockId, float> sharinggain;    /* How many nets on an atom cluster_ctx.blocks are already in the pb under consideration */
 
     /* This is the gain used for hill-climbing. It stores*
      * the reduction in the number of pins that adding this atom cluster_ctx.blocks to the the*
@@ -50,13 +107,47 @@ struct t_pb_stats {
      * addition of an atom cluster_ctx.blocks to a pb may reduce the number of inputs     *
      * required if it shares inputs with all other BLEs and it's output is  *
      * used by all other child pbs in this parent pb.                               */
-    std::map<AtomBlockId, float> hillgain;
+    t_atom_epoch_table<AtomBlockId, float> hillgain;
 
     /*
      * stores the number of times atoms have failed to be packed into the cluster
      * key: root block id of the molecule, value: number of times the molecule has failed to be packed into the cluster
      */
-    std::map<AtomBlockId, int> atom_failures;
+    t_atom_epoch_table<AtomBlockId, int> atom_failures;
+
+    /* How many pins of each atom net are contained in the *
+     * currently open pb?                                  */
+    t_atom_epoch_table<AtomNetId, int> num_pins_of_net_in_pb;
+
+    ///@brief Sizes all the tables for the given atom netlist size
+    void init(size_t num_atom_blocks, size_t num_atom_nets) {
+        gain.init(num_atom_blocks);
+        timinggain.init(num_atom_blocks);
+        connectiongain.init(num_atom_blocks);
+        sharinggain.init(num_atom_blocks);
+        hillgain.init(num_atom_blocks);
+        atom_failures.init(num_atom_blocks);
+        num_pins_of_net_in_pb.init(num_atom_nets);
+    }
+
+    ///@brief Empties all the tables
+    void clear() {
+        gain.clear();
+        timinggain.clear();
+        connectiongain.clear();
+        sharinggain.clear();
+        hillgain.clear();
+        atom_failures.clear();
+        num_pins_of_net_in_pb.clear();
+    }
+};
+
+/* Stores statistical information for a physical cluster_ctx.blocks such as costs and usages */
+struct t_pb_stats {
+    /* Packing statistics (gains, failures and net pin counts). Only set for the
+     * top-level pb of a cluster, and only valid while it is the most recently
+     * started cluster, since the tables are shared by all clusters. */
+    t_pb_gain_stats* gain_stats = nullptr;
 
     int pulled_from_atom_groups;
     int num_att_group_atoms_used;
@@ -74,10 +165,6 @@ struct t_pb_stats {
     bool explore_transitive_fanout;                                       /* If no marked candidate molecules and no high fanout nets to determine next candidate molecule then explore molecules on transitive fanout */
     std::map<AtomBlockId, t_pack_molecule*> transitive_fanout_candidates; // Holding trasitive fanout candidates key: root block id of the molecule, value: pointer to the molecule
 
-    /* How many pins of each atom net are contained in the *
-     * currently open pb?                                  */
-    std::map<AtomNetId, int> num_pins_of_net_in_pb;
-
     /* Record of pins of class used */
     std::vector<std::unordered_map<size_t, AtomNetId>> input_pins_used;  /* [0..pb_graph_node->num_pin_classes-1] nets using this input pin class */
     std::vector<std::unordered_map<size_t, AtomNetId>> output_pins_used; /* [0..pb_graph_node->num_pin_classes-1] nets using this output pin class */
@@ -94,6 +181,11 @@ struct t_pb_stats {
      * Sorted in ascending gain order so that the last cluster_ctx.blocks is the most desirable (this makes it easy to pop blocks off the list
      */
     t_pack_molecule** feasible_blocks;
+    /* Gain of each molecule in feasible_blocks [0..max_array_size-1], computed when it was added.
+     * The gains which a molecule gain is computed from only change when a molecule is packed, which
+     * invalidates the list (num_feasible_blocks = NOT_VALID), so the stored gains never go stale.
+     */
+    float* feasible_block_gains;
     int num_feasible_blocks; /* [0..num_marked_models-1] */
 };
 
@@ -111,10 +203,9 @@ struct t_lb_type_rr_node_edge {
 struct t_lb_type_rr_node {
     short capacity; /* Number of nets that can simultaneously use this node */
     int num_modes;
-    short* num_fanout;      /* [0..num_modes - 1] Mode dependant fanout */
     enum e_lb_rr_type type; /* Type of logic cluster_ctx.blocks resource node */
 
-    t_lb_type_rr_node_edge** outedges; /* [0..num_modes - 1][0..num_fanout-1] index and cost of out edges */
+    int first_mode_edges; /* Index in t_lb_type_rr_graph::mode_edges of the out-edges of mode 0, see t_lb_type_rr_graph */
 
     t_pb_graph_pin* pb_graph_pin; /* pb_graph_pin associated with this lb_rr_node if exists, NULL otherwise */
     float intrinsic_cost;         /* cost of this node */
@@ -122,14 +213,46 @@ struct t_lb_type_rr_node {
     t_lb_type_rr_node() {
         capacity = 0;
         num_modes = 0;
-        num_fanout = nullptr;
         type = NUM_LB_RR_TYPES;
-        outedges = nullptr;
+        first_mode_edges = 0;
         pb_graph_pin = nullptr;
         intrinsic_cost = 0;
     }
 };
 
+/* The routing resource graph within a logic cluster_ctx.blocks type.
+ *
+ * The out-edges of all the nodes are stored contiguously (compressed sparse rows), node by node and mode by mode:
+ * the out-edges of node inode in mode imode are edges[mode_edges[m]..mode_edges[m + 1] - 1], m = nodes[inode].first_mode_edges + imode.
+ * The graph of a type is built once (see alloc_and_load_all_lb_type_rr_graph()) and only read afterwards, so it is
+ * shared by all the clusters of the type (and the threads packing them).
+ */
+struct t_lb_type_rr_graph {
+    std::vector<t_lb_type_rr_node> nodes;
+    std::vector<int> mode_edges;                /* [0..sum of num_modes] */
+    std::vector<t_lb_type_rr_node_edge> edges; /* [0..total fanout - 1] */
+
+    size_t size() const { return nodes.size(); }
+    bool empty() const { return nodes.empty(); }
+
+    t_lb_type_rr_node& operator[](size_t inode) { return nodes[inode]; }
+    const t_lb_type_rr_node& operator[](size_t inode) const { return nodes[inode]; }
+
+    /* Mode dependant fanout of node inode (0 for a mode it does not have) */
+    short num_fanout(int inode, int imode) const {
+        if (imode >= nodes[inode].num_modes) {
+            return 0;
+        }
+        int m = nodes[inode].first_mode_edges + imode;
+        return mode_edges[m + 1] - mode_edges[m];
+    }
+
+    /* Out edge iedge of node inode in mode imode */
+    const t_lb_type_rr_node_edge& outedge(int inode, int imode, int iedge) const {
+        return edges[mode_edges[nodes[inode].first_mode_edges + imode] + iedge];
+    }
+};
+
 /**************************************************************************
  * Intra-Logic Block Routing Data Structures (by instance)
  ***************************************************************************/
@@ -161,15 +284,62 @@ struct t_lb_rr_node_stats {
     }
 };
 
+/* One node of a t_lb_trace route tree */
+struct t_lb_trace_node {
+    int current_node; /* current t_lb_type_rr_node used by net */
+    int parent;       /* index (into t_lb_trace::nodes) of the route tree node driving this one, OPEN for the source */
+    int first_child;  /* index of the first node driven by this one, OPEN if none */
+    int last_child;   /* index of the most recently added node driven by this one, OPEN if none */
+    int next_sibling; /* index of the next node driven by the same parent, OPEN if none */
+};
+
 /*
  * Data structure forming the route tree of a net within one logic cluster_ctx.blocks.
  *
- * A net is implemented using routing resource nodes.  The t_lb_trace data structure records one of the nodes used by the net and the connections
- * to other nodes
+ * A net is implemented using routing resource nodes.  The t_lb_trace data structure records the nodes used by the net and the connections
+ * between them. The nodes are stored in a flat vector (nodes[0] is the source) in the order they were added, so a parent always precedes
+ * its children.  The children of a node are linked in the order they were added, so that next_in_preorder() walks the tree in the same
+ * order as a recursive depth-first traversal would.
+ *
+ * clear() keeps the storage, so re-routing a net does not allocate.
  */
 struct t_lb_trace {
-    int current_node;                   /* current t_lb_type_rr_node used by net */
-    std::vector<t_lb_trace> next_nodes; /* index of previous edge that drives current node */
+    std::vector<t_lb_trace_node> nodes;
+
+    bool empty() const {
+        return nodes.empty();
+    }
+
+    void clear() {
+        nodes.clear();
+    }
+
+    /* Adds a node driven by the route tree node parent (OPEN for the source), and returns its index */
+    int add_node(int current_node, int parent) {
+        int inode = nodes.size();
+        nodes.push_back({current_node, parent, OPEN, OPEN, OPEN});
+        if (parent != OPEN) {
+            t_lb_trace_node& parent_node = nodes[parent];
+            if (parent_node.last_child == OPEN) {
+                parent_node.first_child = inode;
+            } else {
+                nodes[parent_node.last_child].next_sibling = inode;
+            }
+            parent_node.last_child = inode;
+        }
+        return inode;
+    }
+
+    /* Returns the node visited after inode in a depth-first pre-order traversal, or OPEN once all nodes are visited */
+    int next_in_preorder(int inode) const {
+        if (nodes[inode].first_child != OPEN) {
+            return nodes[inode].first_child;
+        }
+        while (inode != OPEN && nodes[inode].next_sibling == OPEN) {
+            inode = nodes[inode].parent;
+        }
+        return (inode == OPEN) ? OPEN : nodes[inode].next_sibling;
+    }
 };
 
 /* Represents a net used inside a logic cluster_ctx.blocks and the physical nodes used by the net */
@@ -178,11 +348,10 @@ struct t_intra_lb_net {
     std::vector<int> terminals;        /* endpoints of the intra_lb_net, 0th position is the source, all others are sinks */
     std::vector<AtomPinId> atom_pins;  /* AtomPin's associated with each terminal */
     std::vector<bool> fixed_terminals; /* Marks a terminal as having a fixed target (i.e. a pin not a sink) */
-    t_lb_trace* rt_tree;               /* Route tree head */
+    t_lb_trace rt_tree;                /* Route tree, empty if the net is not routed */
 
     t_intra_lb_net() {
         atom_net_id = AtomNetId::INVALID();
-        rt_tree = nullptr;
     }
 };
 
@@ -218,6 +387,32 @@ class compare_expansion_node {
     }
 };
 
+/* Packing uses a priority queue that requires a large number of elements.  This backdoor
+ * allows me to use a priority queue where I can pre-allocate the # of elements in the underlying container
+ * for efficiency reasons.  Note: Must use vector with this */
+template<class T, class U, class V>
+class reservable_pq : public std::priority_queue<T, U, V> {
+  public:
+    typedef typename std::priority_queue<T>::size_type size_type;
+    reservable_pq(size_type capacity = 0) {
+        reserve(capacity);
+        cur_cap = capacity;
+    }
+    void reserve(size_type capacity) {
+        this->c.reserve(capacity);
+        cur_cap = capacity;
+    }
+    void clear() {
+        this->c.clear();
+        this->c.reserve(cur_cap);
+    }
+
+  private:
+    size_type cur_cap;
+};
+
+typedef reservable_pq<t_expansion_node, std::vector<t_expansion_node>, compare_expansion_node> t_lb_expansion_pq;
+
 /* Stores explored nodes by router */
 struct t_explored_node_tb {
     int prev_index;     /* Prevous node that drives this one */
@@ -235,10 +430,17 @@ struct t_explored_node_tb {
     }
 };
 
+/* State of the intra-logic cluster_ctx.blocks router which only lives for one routing attempt.
+ * It is kept per thread rather than per cluster, so that its storage is reused by all the clusters routed on the thread. */
+struct t_lb_router_scratch {
+    std::vector<t_explored_node_tb> explored_node_tb; /* Sized to the largest lb_type_graph routed on the thread */
+    t_lb_expansion_pq pq;                             /* Expansion priority queue */
+};
+
 /* Stores all data needed by intra-logic cluster_ctx.blocks router */
 struct t_lb_router_data {
     /* Physical Architecture Info */
-    std::vector<t_lb_type_rr_node>* lb_type_graph; /* Pointer to physical intra-logic cluster_ctx.blocks type rr graph */
+    t_lb_type_rr_graph* lb_type_graph; /* Pointer to physical intra-logic cluster_ctx.blocks type rr graph */
 
     /* Logical Netlist Info */
     std::vector<t_intra_lb_net>* intra_lb_nets; /* Pointer to vector of intra logic cluster_ctx.blocks nets and their connections */
@@ -253,7 +455,7 @@ struct t_lb_router_data {
     bool is_routed;                       /* Stores whether or not the current logical-to-physical mapping has a routed solution */
 
     /* Stores state info during Pathfinder iterative routing */
-    t_explored_node_tb* explored_node_tb; /* [0..lb_type_graph->size()-1] Stores mode exploration and lb_traceback info for nodes */
+    t_explored_node_tb* explored_node_tb; /* [0..lb_type_graph->size()-1] Stores mode exploration and lb_traceback info for nodes, in the t_lb_router_scratch of the routing thread (only set during try_intra_lb_route()) */
     int explore_id_index;                 /* used in conjunction with node_traceback to determine whether or not a location has been explored.  By using a unique identifier every route, I don't have to clear the previous route exploration */
 
     /* Current type */
@@ -265,6 +467,9 @@ struct t_lb_router_data {
     /* current congestion factor */
     float pres_con_fac;
 
+    /* Optional cache of unroutable problems shared with other clusters (not owned) */
+    IntraLbRouteCache* route_cache;
+
     t_lb_router_data() {
         lb_type_graph = nullptr;
         lb_rr_node_stats = nullptr;
@@ -275,6 +480,7 @@ struct t_lb_router_data {
         atoms_added = nullptr;
         explored_node_tb = nullptr;
         explore_id_index = 1;
+        route_cache = nullptr;
 
         params.max_iterations = 50;
         params.pres_fac = 1;
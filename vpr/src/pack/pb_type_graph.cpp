@@ -14,6 +14,7 @@
 #include <cstdio>
 #include <cstring>
 #include <cinttypes>
+#include <mutex>
 #include <queue>
 
 #include "vtr_util.h"
@@ -35,15 +36,27 @@
 #include "power.h"
 #include "read_xml_arch_file.h"
 
+#if defined(VPR_USE_TBB)
+#    include <tbb/parallel_for.h>
+#endif
+
 /* variable global to this section that indexes each pb graph pin within a cluster */
 static vtr::t_linked_vptr* edges_head;
 static vtr::t_linked_vptr* num_edges_head;
+/* the pb graphs of the logical block types are built concurrently: guards the edge lists above */
+static std::mutex edges_mutex;
 
 /* TODO: Software engineering decision needed: Move this file to libarch?
  *
  */
 
 static int check_pb_graph();
+static void alloc_and_load_pb_graph_head(t_logical_block_type& type, bool load_power_structures, bool is_flat);
+static void record_pb_graph_edges(t_pb_graph_edge* edges, int num_edges);
+
+/* Load the CSR pin fanout (pb_pin_fanout_offsets/pb_pin_fanout) of the pb graph of logical_block */
+static void alloc_and_load_pb_graph_pin_fanout(t_logical_block_type* logical_block);
+static void load_pb_graph_pin_fanout_rec(t_logical_block_type* logical_block, const t_pb_graph_node* pb_graph_node, bool count_only);
 static void alloc_and_load_pb_graph(t_pb_graph_node* pb_graph_node,
                                     t_pb_graph_node* parent_pb_graph_node,
                                     t_pb_type* pb_type,
@@ -149,43 +162,132 @@ void alloc_and_load_all_pb_graphs(bool load_power_structures, bool is_flat) {
     edges_head = nullptr;
     num_edges_head = nullptr;
     auto& device_ctx = g_vpr_ctx.mutable_device();
+    auto& types = device_ctx.logical_block_types;
 
-    for (auto& type : device_ctx.logical_block_types) {
-        if (type.pb_type) {
-            type.pb_graph_head = new t_pb_graph_node();
-            int pin_count_in_cluster = 0;
-            int primitive_num = 0;
-            alloc_and_load_pb_graph(type.pb_graph_head,
-                                    nullptr,
-                                    type.pb_type,
-                                    0,
-                                    0,
-                                    load_power_structures,
-                                    pin_count_in_cluster,
-                                    primitive_num);
-            type.pb_graph_head->total_pb_pins = pin_count_in_cluster;
-            load_pin_classes_in_pb_graph_head(type.pb_graph_head);
-            if (is_flat) {
-                alloc_and_load_pb_graph_pin_sinks(type.pb_graph_head);
-                set_pins_logical_num(&type);
-                add_primitive_logical_classes(&type);
-            }
-        } else {
-            type.pb_graph_head = nullptr;
-            VTR_ASSERT(&type == device_ctx.EMPTY_LOGICAL_BLOCK_TYPE);
-        }
+    /* The pb graph of each type only depends on its own pb_type hierarchy: build them in parallel */
+#if defined(VPR_USE_TBB)
+    tbb::parallel_for(size_t(0), types.size(), [&](size_t itype) {
+        alloc_and_load_pb_graph_head(types[itype], load_power_structures, is_flat);
+    });
+#else
+    for (auto& type : types) {
+        alloc_and_load_pb_graph_head(type, load_power_structures, is_flat);
     }
+#endif
 
     errors = check_pb_graph();
     if (errors > 0) {
         VTR_LOG_ERROR("in pb graph");
         exit(1);
     }
-    for (auto& type : device_ctx.logical_block_types) {
+
+#if defined(VPR_USE_TBB)
+    tbb::parallel_for(size_t(0), types.size(), [&](size_t itype) {
+        if (types[itype].pb_type) {
+            load_pb_graph_pin_to_pin_annotations(types[itype].pb_graph_head);
+        }
+    });
+#else
+    for (auto& type : types) {
         if (type.pb_type) {
             load_pb_graph_pin_to_pin_annotations(type.pb_graph_head);
         }
     }
+#endif
+}
+
+/* Allocate and load the pb graph of a single logical block type */
+static void alloc_and_load_pb_graph_head(t_logical_block_type& type, bool load_power_structures, bool is_flat) {
+    if (!type.pb_type) {
+        type.pb_graph_head = nullptr;
+        VTR_ASSERT(&type == g_vpr_ctx.device().EMPTY_LOGICAL_BLOCK_TYPE);
+        return;
+    }
+
+    type.pb_graph_head = new t_pb_graph_node();
+    int pin_count_in_cluster = 0;
+    int primitive_num = 0;
+    alloc_and_load_pb_graph(type.pb_graph_head,
+                            nullptr,
+                            type.pb_type,
+                            0,
+                            0,
+                            load_power_structures,
+                            pin_count_in_cluster,
+                            primitive_num);
+    type.pb_graph_head->total_pb_pins = pin_count_in_cluster;
+    load_pin_classes_in_pb_graph_head(type.pb_graph_head);
+    alloc_and_load_pb_graph_pin_fanout(&type);
+    if (is_flat) {
+        alloc_and_load_pb_graph_pin_sinks(type.pb_graph_head);
+        set_pins_logical_num(&type);
+        add_primitive_logical_classes(&type);
+    }
+}
+
+static void alloc_and_load_pb_graph_pin_fanout(t_logical_block_type* logical_block) {
+    int num_pins = logical_block->pb_graph_head->total_pb_pins;
+
+    /* count the fanout of each pin (in its offset entry), then turn the counts into offsets and load the fanout */
+    logical_block->pb_pin_fanout_offsets.assign(num_pins + 1, 0);
+    load_pb_graph_pin_fanout_rec(logical_block, logical_block->pb_graph_head, true);
+
+    uint32_t num_fanout = 0;
+    for (uint32_t& offset : logical_block->pb_pin_fanout_offsets) {
+        uint32_t pin_fanout = offset;
+        offset = num_fanout;
+        num_fanout += pin_fanout;
+    }
+
+    logical_block->pb_pin_fanout.clear();
+    logical_block->pb_pin_fanout.reserve(num_fanout);
+    load_pb_graph_pin_fanout_rec(logical_block, logical_block->pb_graph_head, false);
+    VTR_ASSERT(logical_block->pb_pin_fanout.size() == num_fanout);
+}
+
+static void load_pb_graph_pin_fanout_rec(t_logical_block_type* logical_block, const t_pb_graph_node* pb_graph_node, bool count_only) {
+    /* pins are visited in pin_count_in_cluster order */
+    for (int ipin = 0; ipin < pb_graph_node->num_pins(); ipin++) {
+        const t_pb_graph_pin& pb_pin = pb_graph_node->pins[ipin];
+        VTR_ASSERT_SAFE(pb_pin.pin_count_in_cluster == pb_graph_node->pin_num_range.low + ipin);
+
+        VTR_ASSERT_SAFE(count_only || logical_block->pb_pin_fanout.size() == logical_block->pb_pin_fanout_offsets[pb_pin.pin_count_in_cluster]);
+        for (int iedge = 0; iedge < pb_pin.num_output_edges; iedge++) {
+            t_pb_graph_edge* edge = pb_pin.output_edges[iedge];
+            if (count_only) {
+                logical_block->pb_pin_fanout_offsets[pb_pin.pin_count_in_cluster] += edge->num_output_pins;
+                continue;
+            }
+            for (int isink = 0; isink < edge->num_output_pins; isink++) {
+                logical_block->pb_pin_fanout.push_back({uint32_t(edge->output_pins[isink]->pin_count_in_cluster),
+                                                        uint32_t(edge->interconnect->parent_mode->index),
+                                                        edge});
+            }
+        }
+    }
+
+    const t_pb_type* pb_type = pb_graph_node->pb_type;
+    for (int imode = 0; imode < pb_type->num_modes; imode++) {
+        for (int ichild = 0; ichild < pb_type->modes[imode].num_pb_type_children; ichild++) {
+            for (int ipb = 0; ipb < pb_type->modes[imode].pb_type_children[ichild].num_pb; ipb++) {
+                load_pb_graph_pin_fanout_rec(logical_block, &pb_graph_node->child_pb_graph_nodes[imode][ichild][ipb], count_only);
+            }
+        }
+    }
+}
+
+/* Record an array of pb graph edges, to be freed by free_pb_graph_edges() */
+static void record_pb_graph_edges(t_pb_graph_edge* edges, int num_edges) {
+    std::lock_guard<std::mutex> lock(edges_mutex);
+
+    vtr::t_linked_vptr* cur = new vtr::t_linked_vptr;
+    cur->next = edges_head;
+    edges_head = cur;
+    cur->data_vptr = (void*)edges;
+    cur = new vtr::t_linked_vptr;
+    cur->next = num_edges_head;
+    num_edges_head = cur;
+    cur->data_vptr = (void*)((intptr_t)num_edges);
 }
 
 /**
@@ -278,6 +380,14 @@ static void alloc_and_load_pb_graph(t_pb_graph_node* pb_graph_node,
         pb_graph_node->clock_pins = new t_pb_graph_pin* [pb_graph_node->num_clock_ports] { nullptr };
     }
 
+    /* All the pins of the node are allocated together, in pin_count_in_cluster order */
+    int num_pins = 0;
+    for (i = 0; i < pb_type->num_ports; i++) {
+        num_pins += pb_type->ports[i].num_pins;
+    }
+    pb_graph_node->pins = new t_pb_graph_pin[num_pins];
+    t_pb_graph_pin* next_port_pins = pb_graph_node->pins;
+
     i_input = i_output = i_clockport = 0;
     pb_graph_node->pin_num_range.low = pin_count_in_cluster;
     for (i = 0; i < pb_type->num_ports; i++) {
@@ -287,7 +397,7 @@ static void alloc_and_load_pb_graph(t_pb_graph_node* pb_graph_node,
             VTR_ASSERT(pb_type->num_modes != 0 || pb_type->ports[i].is_clock);
         }
         if (pb_type->ports[i].type == IN_PORT && !pb_type->ports[i].is_clock) {
-            pb_graph_node->input_pins[i_input] = new t_pb_graph_pin[pb_type->ports[i].num_pins];
+            pb_graph_node->input_pins[i_input] = next_port_pins;
             pb_graph_node->num_input_pins[i_input] = pb_type->ports[i].num_pins;
             for (j = 0; j < pb_type->ports[i].num_pins; j++) {
                 pb_graph_node->input_pins[i_input][j].pin_number = j;
@@ -307,7 +417,7 @@ static void alloc_and_load_pb_graph(t_pb_graph_node* pb_graph_node,
             }
             i_input++;
         } else if (pb_type->ports[i].type == OUT_PORT) {
-            pb_graph_node->output_pins[i_output] = new t_pb_graph_pin[pb_type->ports[i].num_pins];
+            pb_graph_node->output_pins[i_output] = next_port_pins;
             pb_graph_node->num_output_pins[i_output] = pb_type->ports[i].num_pins;
             for (j = 0; j < pb_type->ports[i].num_pins; j++) {
                 pb_graph_node->output_pins[i_output][j].pin_number = j;
@@ -328,7 +438,7 @@ static void alloc_and_load_pb_graph(t_pb_graph_node* pb_graph_node,
             i_output++;
         } else {
             VTR_ASSERT(pb_type->ports[i].is_clock && pb_type->ports[i].type == IN_PORT);
-            pb_graph_node->clock_pins[i_clockport] = new t_pb_graph_pin[pb_type->ports[i].num_pins];
+            pb_graph_node->clock_pins[i_clockport] = next_port_pins;
             pb_graph_node->num_clock_pins[i_clockport] = pb_type->ports[i].num_pins;
             for (j = 0; j < pb_type->ports[i].num_pins; j++) {
                 pb_graph_node->clock_pins[i_clockport][j].pin_number = j;
@@ -342,6 +452,7 @@ static void alloc_and_load_pb_graph(t_pb_graph_node* pb_graph_node,
             }
             i_clockport++;
         }
+        next_port_pins += pb_type->ports[i].num_pins;
     }
 
     pb_graph_node->pin_num_range.high = (pin_count_in_cluster - 1);
@@ -1026,7 +1137,6 @@ static void alloc_and_load_complete_interc_edges(t_interconnect* interconnect,
     int in_count, out_count;
     t_pb_graph_edge* edges;
     int i_edge;
-    vtr::t_linked_vptr* cur;
 
     VTR_ASSERT(interconnect->infer_annotations == false);
 
@@ -1043,14 +1153,7 @@ static void alloc_and_load_complete_interc_edges(t_interconnect* interconnect,
     edges = new t_pb_graph_edge[in_count * out_count];
     for (int i = 0; i < (in_count * out_count); i++)
         edges[i] = t_pb_graph_edge();
-    cur = new vtr::t_linked_vptr;
-    cur->next = edges_head;
-    edges_head = cur;
-    cur->data_vptr = (void*)edges;
-    cur = new vtr::t_linked_vptr;
-    cur->next = num_edges_head;
-    num_edges_head = cur;
-    cur->data_vptr = (void*)((intptr_t)in_count * out_count);
+    record_pb_graph_edges(edges, in_count * out_count);
 
     for (i_inset = 0; i_inset < num_input_sets; i_inset++) {
         for (i_inpin = 0; i_inpin < num_input_ptrs[i_inset]; i_inpin++) {
@@ -1125,14 +1228,7 @@ static void alloc_and_load_direct_interc_edges(t_interconnect* interconnect,
     t_pb_graph_edge* edges = new t_pb_graph_edge[pins_per_set * num_output_sets];
     for (int i = 0; i < (pins_per_set * num_output_sets); i++)
         edges[i] = t_pb_graph_edge();
-    vtr::t_linked_vptr* cur = new vtr::t_linked_vptr;
-    cur->next = edges_head;
-    edges_head = cur;
-    cur->data_vptr = (void*)edges;
-    cur = new vtr::t_linked_vptr;
-    cur->next = num_edges_head;
-    num_edges_head = cur;
-    cur->data_vptr = (void*)((intptr_t)num_input_ptrs[0]);
+    record_pb_graph_edges(edges, num_input_ptrs[0]);
 
     /* Reallocate memory for pins and load connections between pins and record these updates in the edges */
     for (int ipin = 0; ipin < pins_per_set; ++ipin) {
@@ -1196,7 +1292,6 @@ static void alloc_and_load_mux_interc_edges(t_interconnect* interconnect,
                                             const int* num_output_ptrs) {
     int i_inset, i_inpin, i_outpin;
     t_pb_graph_edge* edges;
-    vtr::t_linked_vptr* cur;
 
     VTR_ASSERT(interconnect->infer_annotations == false);
 
@@ -1209,14 +1304,7 @@ static void alloc_and_load_mux_interc_edges(t_interconnect* interconnect,
     edges = new t_pb_graph_edge[num_input_sets];
     for (int i = 0; i < (num_input_sets); i++)
         edges[i] = t_pb_graph_edge();
-    cur = new vtr::t_linked_vptr;
-    cur->next = edges_head;
-    edges_head = cur;
-    cur->data_vptr = (void*)edges;
-    cur = new vtr::t_linked_vptr;
-    cur->next = num_edges_head;
-    num_edges_head = cur;
-    cur->data_vptr = (void*)((intptr_t)num_input_sets);
+    record_pb_graph_edges(edges, num_input_sets);
 
     for (i_inset = 0; i_inset < num_input_sets; i_inset++) {
         for (i_inpin = 0; i_inpin < num_input_ptrs[i_inset]; i_inpin++) {
@@ -18,6 +18,25 @@
 /* Include global variables of VPR */
 #include "globals.h"
 
+#ifdef VPR_USE_TBB
+#    include <tbb/parallel_for.h>
+#endif
+
+/********************************************************************
+ * The fix-up of a clustered block, which only depends on the block itself.
+ * The blocks are fixed up independently (in parallel) into their own
+ * fix-ups, which are merged into the clustering context afterwards.
+ *  - post_routing_pin_nets and pre_routing_pin_mapping are the entries
+ *    of the block in ClusteringContext::post_routing_clb_pin_nets and
+ *    ClusteringContext::pre_routing_net_pin_mapping
+ *******************************************************************/
+struct t_cluster_pin_fixup {
+    std::map<int, ClusterNetId> post_routing_pin_nets;
+    std::map<int, int> pre_routing_pin_mapping;
+    size_t num_mismatches = 0;
+    size_t num_fixup = 0;
+};
+
 /********************************************************************
  * Give a given pin index, find the side where this pin is located 
  * on the physical tile
@@ -54,7 +73,7 @@ static void update_cluster_pin_with_post_routing_results(const Netlist<>& net_li
                                                          const vtr::vector<RRNodeId, ParentNetId>& rr_node_nets,
                                                          const t_pl_loc& grid_coord,
                                                          const ClusterBlockId& blk_id,
-                                                         size_t& num_mismatches,
+                                                         t_cluster_pin_fixup& fixup,
                                                          const bool& verbose,
                                                          bool is_flat) {
     const int sub_tile_z = grid_coord.sub_tile;
@@ -228,7 +247,7 @@ static void update_cluster_pin_with_post_routing_results(const Netlist<>& net_li
         }
 
         /* Update the clustering context with net modification */
-        clustering_ctx.post_routing_clb_pin_nets[blk_id][pb_graph_pin->pin_count_in_cluster] = cluster_equivalent_net_id;
+        fixup.post_routing_pin_nets[pb_graph_pin->pin_count_in_cluster] = cluster_equivalent_net_id;
 
         std::string routing_net_name("unmapped");
         if (clustering_ctx.clb_nlist.valid_net_id(cluster_equivalent_net_id)) {
@@ -252,7 +271,7 @@ static void update_cluster_pin_with_post_routing_results(const Netlist<>& net_li
                  cluster_net_name.c_str());
 
         /* Update counter */
-        num_mismatches++;
+        fixup.num_mismatches++;
     }
 }
 
@@ -267,6 +286,7 @@ static int find_target_pb_route_from_equivalent_pins(const AtomContext& atom_ctx
                                                      const ClusteringContext& clustering_ctx,
                                                      const ClusterBlockId& blk_id,
                                                      t_pb* pb,
+                                                     const t_cluster_pin_fixup& fixup,
                                                      const t_pb_graph_pin* source_pb_graph_pin,
                                                      const AtomNetId& target_net,
                                                      const bool& verbose) {
@@ -301,10 +321,10 @@ static int find_target_pb_route_from_equivalent_pins(const AtomContext& atom_ctx
             continue;
         }
 
-        auto remapped_result = clustering_ctx.post_routing_clb_pin_nets.at(blk_id).find(pin);
+        auto remapped_result = fixup.post_routing_pin_nets.find(pin);
 
         /* Skip this pin if it is consistent in pre- and post- routing results */
-        if (remapped_result == clustering_ctx.post_routing_clb_pin_nets.at(blk_id).end()) {
+        if (remapped_result == fixup.post_routing_pin_nets.end()) {
             continue;
         }
 
@@ -493,6 +513,7 @@ static std::map<int, std::pair<AtomPinId, const t_pb_graph_pin*>> cache_atom_pin
                                                                                                    const ClusteringContext& clustering_ctx,
                                                                                                    const ClusterBlockId& blk_id,
                                                                                                    t_pb* pb,
+                                                                                                   const t_cluster_pin_fixup& fixup,
                                                                                                    t_logical_block_type_ptr logical_block) {
     std::map<int, std::pair<AtomPinId, const t_pb_graph_pin*>> atom_pin_to_pb_pin_mapping;
     for (int pb_type_pin = 0; pb_type_pin < logical_block->pb_type->num_pins; ++pb_type_pin) {
@@ -510,10 +531,10 @@ static std::map<int, std::pair<AtomPinId, const t_pb_graph_pin*>> cache_atom_pin
         VTR_ASSERT(pb_graph_pin->parent_node == pb->pb_graph_node);
         VTR_ASSERT(pb_graph_pin->parent_node->is_root());
 
-        auto remapped_result = clustering_ctx.post_routing_clb_pin_nets.at(blk_id).find(pb_graph_pin->pin_count_in_cluster);
+        auto remapped_result = fixup.post_routing_pin_nets.find(pb_graph_pin->pin_count_in_cluster);
 
         /* Skip this pin: it is consistent in pre- and post- routing results */
-        if (remapped_result == clustering_ctx.post_routing_clb_pin_nets.at(blk_id).end()) {
+        if (remapped_result == fixup.post_routing_pin_nets.end()) {
             continue;
         }
 
@@ -600,7 +621,7 @@ static void update_cluster_regular_routing_traces_with_post_routing_results(Atom
                                                                             t_pb* pb,
                                                                             t_logical_block_type_ptr logical_block,
                                                                             t_pb_routes& new_pb_routes,
-                                                                            size_t& num_fixup,
+                                                                            t_cluster_pin_fixup& fixup,
                                                                             const bool& verbose) {
     /* Go through each pb_graph pin at the top level
      * and build the new routing traces
@@ -625,15 +646,15 @@ static void update_cluster_regular_routing_traces_with_post_routing_results(Atom
         VTR_ASSERT(pb_graph_pin->parent_node == pb->pb_graph_node);
         VTR_ASSERT(pb_graph_pin->parent_node->is_root());
 
-        auto remapped_result = clustering_ctx.post_routing_clb_pin_nets.at(blk_id).find(pb_graph_pin->pin_count_in_cluster);
+        auto remapped_result = fixup.post_routing_pin_nets.find(pb_graph_pin->pin_count_in_cluster);
 
         /* Skip this pin: it is consistent in pre- and post- routing results */
-        if (remapped_result == clustering_ctx.post_routing_clb_pin_nets.at(blk_id).end()) {
+        if (remapped_result == fixup.post_routing_pin_nets.end()) {
             continue;
         }
 
         /* Update only when there is a remapping! */
-        VTR_ASSERT_SAFE(remapped_result != clustering_ctx.post_routing_clb_pin_nets[blk_id].end());
+        VTR_ASSERT_SAFE(remapped_result != fixup.post_routing_pin_nets.end());
 
         /* Cache the remapped net id */
         AtomNetId remapped_net = atom_ctx.lookup.atom_net(remapped_result->second);
@@ -673,12 +694,13 @@ static void update_cluster_regular_routing_traces_with_post_routing_results(Atom
                                                                     clustering_ctx,
                                                                     blk_id,
                                                                     pb,
+                                                                    fixup,
                                                                     pb_graph_pin,
                                                                     remapped_net,
                                                                     verbose);
 
         /* Record the previous pin mapping for finding the correct pin index during timing analysis */
-        clustering_ctx.pre_routing_net_pin_mapping[blk_id][pb_graph_pin->pin_count_in_cluster] = pb_route_id;
+        fixup.pre_routing_pin_mapping[pb_graph_pin->pin_count_in_cluster] = pb_route_id;
 
         /* Remove the old pb_route and insert the new one */
         new_pb_routes.insert(std::make_pair(pb_graph_pin->pin_count_in_cluster, t_pb_route()));
@@ -874,7 +896,7 @@ static void update_cluster_regular_routing_traces_with_post_routing_results(Atom
                  atom_ctx.nlist.net_name(remapped_net).c_str());
 
         /* Update fixup counter */
-        num_fixup++;
+        fixup.num_fixup++;
     }
 }
 
@@ -892,7 +914,7 @@ static void update_cluster_global_routing_traces_with_post_routing_results(const
                                                                            t_pb* pb,
                                                                            t_logical_block_type_ptr logical_block,
                                                                            t_pb_routes& new_pb_routes,
-                                                                           size_t& num_fixup,
+                                                                           t_cluster_pin_fixup& fixup,
                                                                            const bool& verbose) {
     /* Reassign global nets to unused pins in the same port where they were mapped
      * NO optimization is done here!!! First find first fit
@@ -925,15 +947,15 @@ static void update_cluster_global_routing_traces_with_post_routing_results(const
 
         AtomNetId global_atom_net_id = atom_ctx.lookup.atom_net(global_net_id);
 
-        auto remapped_result = clustering_ctx.post_routing_clb_pin_nets.at(blk_id).find(pb_graph_pin->pin_count_in_cluster);
+        auto remapped_result = fixup.post_routing_pin_nets.find(pb_graph_pin->pin_count_in_cluster);
 
         /* Skip this pin: it is consistent in pre- and post- routing results */
-        if (remapped_result == clustering_ctx.post_routing_clb_pin_nets.at(blk_id).end()) {
+        if (remapped_result == fixup.post_routing_pin_nets.end()) {
             continue;
         }
 
         /* Update only when there is a remapping! */
-        VTR_ASSERT_SAFE(remapped_result != clustering_ctx.post_routing_clb_pin_nets[blk_id].end());
+        VTR_ASSERT_SAFE(remapped_result != fixup.post_routing_pin_nets.end());
 
         VTR_LOGV(verbose,
                  "Remapping clustered block '%s' global net '%s' to unused pin as %s\r",
@@ -963,8 +985,8 @@ static void update_cluster_global_routing_traces_with_post_routing_results(const
         }
 
         /* Update the remapping nets for this global net */
-        clustering_ctx.post_routing_clb_pin_nets[blk_id][unused_pb_graph_pin->pin_count_in_cluster] = global_net_id;
-        clustering_ctx.pre_routing_net_pin_mapping[blk_id][unused_pb_graph_pin->pin_count_in_cluster] = pb_route_id;
+        fixup.post_routing_pin_nets[unused_pb_graph_pin->pin_count_in_cluster] = global_net_id;
+        fixup.pre_routing_pin_mapping[unused_pb_graph_pin->pin_count_in_cluster] = pb_route_id;
 
         VTR_LOGV(verbose,
                  "Remap clustered block '%s' global net '%s' to pin '%s'\n",
@@ -973,7 +995,7 @@ static void update_cluster_global_routing_traces_with_post_routing_results(const
                  unused_pb_graph_pin->to_string().c_str());
 
         /* Update fixup counter */
-        num_fixup++;
+        fixup.num_fixup++;
     }
 }
 
@@ -990,10 +1012,10 @@ static void update_cluster_routing_traces_with_post_routing_results(AtomContext&
                                                                     const IntraLbPbPinLookup& intra_lb_pb_pin_lookup,
                                                                     ClusteringContext& clustering_ctx,
                                                                     const ClusterBlockId& blk_id,
-                                                                    size_t& num_fixup,
+                                                                    t_cluster_pin_fixup& fixup,
                                                                     const bool& verbose) {
     /* Skip block where no remapping is applied */
-    if (clustering_ctx.post_routing_clb_pin_nets.find(blk_id) == clustering_ctx.post_routing_clb_pin_nets.end()) {
+    if (fixup.post_routing_pin_nets.empty()) {
         return;
     }
 
@@ -1004,7 +1026,7 @@ static void update_cluster_routing_traces_with_post_routing_results(AtomContext&
     t_pb_routes new_pb_routes = pb->pb_route;
 
     /* Cache the current mapping between atom pin to pb_graph pin in this block */
-    std::map<int, std::pair<AtomPinId, const t_pb_graph_pin*>> previous_atom_pin_to_pb_pin_mapping = cache_atom_pin_to_pb_pin_mapping(const_cast<const AtomContext&>(atom_ctx), intra_lb_pb_pin_lookup, const_cast<const ClusteringContext&>(clustering_ctx), blk_id, pb, logical_block);
+    std::map<int, std::pair<AtomPinId, const t_pb_graph_pin*>> previous_atom_pin_to_pb_pin_mapping = cache_atom_pin_to_pb_pin_mapping(const_cast<const AtomContext&>(atom_ctx), intra_lb_pb_pin_lookup, const_cast<const ClusteringContext&>(clustering_ctx), blk_id, pb, fixup, logical_block);
 
     update_cluster_regular_routing_traces_with_post_routing_results(atom_ctx,
                                                                     previous_atom_pin_to_pb_pin_mapping,
@@ -1013,7 +1035,7 @@ static void update_cluster_routing_traces_with_post_routing_results(AtomContext&
                                                                     pb,
                                                                     logical_block,
                                                                     new_pb_routes,
-                                                                    num_fixup,
+                                                                    fixup,
                                                                     verbose);
 
     update_cluster_global_routing_traces_with_post_routing_results(const_cast<const AtomContext&>(atom_ctx),
@@ -1022,7 +1044,7 @@ static void update_cluster_routing_traces_with_post_routing_results(AtomContext&
                                                                    pb,
                                                                    logical_block,
                                                                    new_pb_routes,
-                                                                   num_fixup,
+                                                                   fixup,
                                                                    verbose);
 
     /* Replace old pb_routes with the new one */
@@ -1067,15 +1089,12 @@ void sync_netlists_to_routing(const Netlist<>& net_list,
 
     IntraLbPbPinLookup intra_lb_pb_pin_lookup(device_ctx.logical_block_types);
 
-    /* Count the number of mismatches and fix-up */
-    size_t num_mismatches = 0;
-    size_t num_fixup = 0;
-
+    /* Find the clustered blocks to fix up (each block once) */
+    std::vector<ClusterBlockId> clb_blk_ids;
     std::unordered_set<ClusterBlockId> seen_block_ids;
     seen_block_ids.reserve(clustering_ctx.clb_nlist.blocks().size());
     /* Update the core logic (center blocks of the FPGA) */
     for (const ParentBlockId& blk_id : net_list.blocks()) {
-        /* We know the entrance to grid info and mapping results, do the fix-up for this block */
         ClusterBlockId clb_blk_id;
         if (is_flat) {
             clb_blk_id = atom_look_up.atom_clb(convert_to_atom_block_id(blk_id));
@@ -1085,24 +1104,63 @@ void sync_netlists_to_routing(const Netlist<>& net_list,
         VTR_ASSERT(clb_blk_id != ClusterBlockId::INVALID());
 
         if (seen_block_ids.insert(clb_blk_id).second) {
-            update_cluster_pin_with_post_routing_results(net_list,
-                                                         atom_ctx,
-                                                         device_ctx,
-                                                         clustering_ctx,
-                                                         rr_node_nets,
-                                                         placement_ctx.block_locs()[clb_blk_id].loc,
-                                                         clb_blk_id,
-                                                         num_mismatches,
-                                                         verbose,
-                                                         is_flat);
-
-            update_cluster_routing_traces_with_post_routing_results(atom_ctx,
-                                                                    intra_lb_pb_pin_lookup,
-                                                                    clustering_ctx,
-                                                                    clb_blk_id,
-                                                                    num_fixup,
-                                                                    verbose);
+            clb_blk_ids.push_back(clb_blk_id);
+        }
+    }
+
+    /* The fix-up of a block only modifies the block (its pb and the look-up of its atom pins),
+     * so the blocks are fixed up in parallel into their own fix-ups
+     */
+    std::vector<t_cluster_pin_fixup> fixups(clb_blk_ids.size());
+    auto fixup_cluster = [&](size_t iblk) {
+        /* We know the entrance to grid info and mapping results, do the fix-up for this block */
+        ClusterBlockId clb_blk_id = clb_blk_ids[iblk];
+        update_cluster_pin_with_post_routing_results(net_list,
+                                                     atom_ctx,
+                                                     device_ctx,
+                                                     clustering_ctx,
+                                                     rr_node_nets,
+                                                     placement_ctx.block_locs()[clb_blk_id].loc,
+                                                     clb_blk_id,
+                                                     fixups[iblk],
+                                                     verbose,
+                                                     is_flat);
+
+        update_cluster_routing_traces_with_post_routing_results(atom_ctx,
+                                                                intra_lb_pb_pin_lookup,
+                                                                clustering_ctx,
+                                                                clb_blk_id,
+                                                                fixups[iblk],
+                                                                verbose);
+    };
+#ifdef VPR_USE_TBB
+    /* Keep the verbose outputs of each block together */
+    if (!verbose) {
+        tbb::parallel_for(size_t(0), clb_blk_ids.size(), fixup_cluster);
+    } else {
+        for (size_t iblk = 0; iblk < clb_blk_ids.size(); ++iblk) {
+            fixup_cluster(iblk);
+        }
+    }
+#else
+    for (size_t iblk = 0; iblk < clb_blk_ids.size(); ++iblk) {
+        fixup_cluster(iblk);
+    }
+#endif
+
+    /* Merge the fix-ups and count the number of mismatches and fix-up */
+    size_t num_mismatches = 0;
+    size_t num_fixup = 0;
+    for (size_t iblk = 0; iblk < clb_blk_ids.size(); ++iblk) {
+        t_cluster_pin_fixup& fixup = fixups[iblk];
+        if (!fixup.post_routing_pin_nets.empty()) {
+            clustering_ctx.post_routing_clb_pin_nets[clb_blk_ids[iblk]] = std::move(fixup.post_routing_pin_nets);
+        }
+        if (!fixup.pre_routing_pin_mapping.empty()) {
+            clustering_ctx.pre_routing_net_pin_mapping[clb_blk_ids[iblk]] = std::move(fixup.pre_routing_pin_mapping);
         }
+        num_mismatches += fixup.num_mismatches;
+        num_fixup += fixup.num_fixup;
     }
 
     /* Print a short summary */
@@ -19,6 +19,10 @@
 #include <utility>
 #include <vector>
 
+#ifdef VPR_USE_TBB
+#    include <tbb/parallel_for.h>
+#endif
+
 #include "atom_netlist.h"
 #include "cluster_util.h"
 #include "echo_files.h"
@@ -28,9 +32,24 @@
 #include "vpr_utils.h"
 #include "vtr_assert.h"
 #include "vtr_range.h"
+#include "vtr_time.h"
 #include "vtr_util.h"
 #include "vtr_vector.h"
 
+/**
+ * @brief Result of matching a pack pattern rooted at a single atom, computed
+ *        ahead of the serial scan that commits the molecules.
+ *
+ *      feasible       : whether the pattern matched
+ *      atom_block_ids : the atoms of the matched molecule (valid only if feasible)
+ *      visited_blocks : the atoms whose molecule membership the match depended on
+ */
+struct t_molecule_match {
+    bool feasible = false;
+    std::vector<AtomBlockId> atom_block_ids;
+    std::vector<AtomBlockId> visited_blocks;
+};
+
 /*****************************************/
 /*Local Function Declaration			 */
 /*****************************************/
@@ -82,10 +101,18 @@ static t_pack_molecule* try_create_molecule(t_pack_patterns* list_of_pack_patter
                                             std::multimap<AtomBlockId, t_pack_molecule*>& atom_molecules,
                                             const AtomNetlist& atom_nlist);
 
+static t_pack_molecule* alloc_forced_pack_molecule(t_pack_patterns* pack_pattern);
+
+static void commit_molecule(t_pack_molecule* molecule,
+                            const AtomBlockId root_blk_id,
+                            std::multimap<AtomBlockId, t_pack_molecule*>& atom_molecules,
+                            const AtomNetlist& atom_nlist);
+
 static bool try_expand_molecule(t_pack_molecule* molecule,
                                 const AtomBlockId blk_id,
                                 const std::multimap<AtomBlockId, t_pack_molecule*>& atom_molecules,
-                                const AtomNetlist& atom_nlist);
+                                const AtomNetlist& atom_nlist,
+                                std::vector<AtomBlockId>* visited_blocks = nullptr);
 
 static void print_pack_molecules(const char* fname,
                                  const t_pack_patterns* list_of_pack_patterns,
@@ -817,6 +844,10 @@ static t_pack_molecule* alloc_and_load_pack_molecules(t_pack_patterns* list_of_p
 
     cur_molecule = list_of_molecules_head = nullptr;
 
+    vtr::Timer pattern_timer;
+    size_t num_molecules = 0;
+    size_t num_stale_matches = 0;
+
     /* Find forced pack patterns
      * Simplifying assumptions: Each atom can map to at most one molecule,
      *                          use first-fit mapping based on priority of pattern
@@ -842,30 +873,102 @@ static t_pack_molecule* alloc_and_load_pack_molecules(t_pack_patterns* list_of_p
         VTR_ASSERT(is_used[best_pattern] == false);
         is_used[best_pattern] = true;
 
+        t_pack_patterns* pack_pattern = &list_of_pack_patterns[best_pattern];
+
+        //Links a newly created molecule into the list, and returns true if it
+        //covers blk_id
+        auto add_molecule = [&](t_pack_molecule* molecule, AtomBlockId blk_id) {
+            molecule->next = list_of_molecules_head;
+            /* In the event of multiple molecules with the same atom block pattern,
+             * bias to use the molecule with less costly physical resources first */
+            /* TODO: Need to normalize magical number 100 */
+            molecule->base_gain = molecule->num_blocks - (molecule->pack_pattern->base_cost / 100);
+            list_of_molecules_head = molecule;
+            num_molecules++;
+
+            //Note: atom_molecules is an (ordered) multimap so the last molecule
+            //      inserted for a given blk_id will be the last valid element
+            //      in the equal_range
+            auto rng = atom_molecules.equal_range(blk_id); //The range of molecules matching this block
+            bool range_empty = (rng.first == rng.second);
+            bool cur_was_last_inserted = false;
+            if (!range_empty) {
+                auto last_valid_iter = --rng.second; //Iterator to last element (only valid if range is not empty)
+                cur_was_last_inserted = (last_valid_iter->second == molecule);
+            }
+            return !range_empty && cur_was_last_inserted;
+        };
+
         auto blocks = atom_nlist.blocks();
+
+#ifdef VPR_USE_TBB
+        if (!pack_pattern->is_chain && pack_pattern->num_blocks > 0 && pack_pattern->root_block != nullptr) {
+            //Match the pattern rooted at every atom in parallel, against the molecules
+            //of the previous (higher priority) patterns only. The result for an atom
+            //depends on the molecules found so far only through the atoms its match
+            //visited, so it is reused below as long as none of those atoms have been
+            //claimed by an earlier molecule of this pattern.
+            std::vector<t_molecule_match> matches(blocks.size());
+            tbb::parallel_for(size_t(0), blocks.size(), [&](size_t iblk) {
+                t_molecule_match& match = matches[iblk];
+                t_pack_molecule molecule;
+                molecule.pack_pattern = pack_pattern;
+                molecule.atom_block_ids = std::vector<AtomBlockId>(pack_pattern->num_blocks);
+                match.feasible = try_expand_molecule(&molecule, *(blocks.begin() + iblk), atom_molecules, atom_nlist, &match.visited_blocks);
+                if (match.feasible) {
+                    match.atom_block_ids = std::move(molecule.atom_block_ids);
+                }
+            });
+
+            //Commit the matches in atom order, so the molecules (and which one wins
+            //when two overlap) are exactly those of the serial scan below
+            std::vector<bool> claimed(blocks.size(), false);
+            for (size_t iblk = 0; iblk < blocks.size(); iblk++) {
+                AtomBlockId blk_id = *(blocks.begin() + iblk);
+                t_molecule_match& match = matches[iblk];
+
+                bool match_is_stale = false;
+                for (AtomBlockId visited_blk : match.visited_blocks) {
+                    if (claimed[size_t(visited_blk)]) {
+                        match_is_stale = true;
+                        break;
+                    }
+                }
+
+                cur_molecule = nullptr;
+                if (match_is_stale) {
+                    num_stale_matches++;
+                    cur_molecule = try_create_molecule(list_of_pack_patterns, best_pattern, blk_id, atom_molecules, atom_nlist);
+                } else if (match.feasible) {
+                    cur_molecule = alloc_forced_pack_molecule(pack_pattern);
+                    cur_molecule->atom_block_ids = std::move(match.atom_block_ids);
+                    commit_molecule(cur_molecule, blk_id, atom_molecules, atom_nlist);
+                }
+
+                if (cur_molecule != nullptr) {
+                    for (AtomBlockId molecule_blk : cur_molecule->atom_block_ids) {
+                        if (molecule_blk) {
+                            claimed[size_t(molecule_blk)] = true;
+                        }
+                    }
+                    //The root of a non-chain molecule is always blk_id itself
+                    bool covers_blk = add_molecule(cur_molecule, blk_id);
+                    VTR_ASSERT(covers_blk);
+                }
+            }
+            continue;
+        }
+#endif
+
+        //Chain patterns are matched serially: the root of a chain molecule is found by
+        //walking up the chain to the first atom not yet in a molecule, which depends on
+        //every molecule found before it
         for (auto blk_iter = blocks.begin(); blk_iter != blocks.end(); ++blk_iter) {
             auto blk_id = *blk_iter;
 
             cur_molecule = try_create_molecule(list_of_pack_patterns, best_pattern, blk_id, atom_molecules, atom_nlist);
             if (cur_molecule != nullptr) {
-                cur_molecule->next = list_of_molecules_head;
-                /* In the event of multiple molecules with the same atom block pattern,
-                 * bias to use the molecule with less costly physical resources first */
-                /* TODO: Need to normalize magical number 100 */
-                cur_molecule->base_gain = cur_molecule->num_blocks - (cur_molecule->pack_pattern->base_cost / 100);
-                list_of_molecules_head = cur_molecule;
-
-                //Note: atom_molecules is an (ordered) multimap so the last molecule
-                //      inserted for a given blk_id will be the last valid element
-                //      in the equal_range
-                auto rng = atom_molecules.equal_range(blk_id); //The range of molecules matching this block
-                bool range_empty = (rng.first == rng.second);
-                bool cur_was_last_inserted = false;
-                if (!range_empty) {
-                    auto last_valid_iter = --rng.second; //Iterator to last element (only valid if range is not empty)
-                    cur_was_last_inserted = (last_valid_iter->second == cur_molecule);
-                }
-                if (range_empty || !cur_was_last_inserted) {
+                if (!add_molecule(cur_molecule, blk_id)) {
                     /* molecule did not cover current atom (possibly because molecule created is
                      * part of a long chain that extends past multiple logic blocks), try again */
                     --blk_iter;
@@ -875,6 +978,9 @@ static t_pack_molecule* alloc_and_load_pack_molecules(t_pack_patterns* list_of_p
     }
     delete[] is_used;
 
+    VTR_LOG("Found %zu forced pack molecules (%zu pattern matches recomputed) in %g seconds\n",
+            num_molecules, num_stale_matches, pattern_timer.elapsed_sec());
+
     /* List all atom blocks as a molecule for blocks that do not belong to any molecules.
      * This allows the packer to be consistent as it now packs molecules only instead of atoms and molecules
      *
@@ -982,39 +1088,58 @@ static t_pack_molecule* try_create_molecule(t_pack_patterns* list_of_pack_patter
         if (!blk_id) return nullptr;
     }
 
-    molecule = new t_pack_molecule;
+    molecule = alloc_forced_pack_molecule(pack_pattern);
+
+    if (try_expand_molecule(molecule, blk_id, atom_molecules, atom_nlist)) {
+        // Success! commit molecule
+        commit_molecule(molecule, blk_id, atom_molecules, atom_nlist);
+    } else {
+        // Failed to create molecule
+        delete molecule;
+        return nullptr;
+    }
+
+    return molecule;
+}
+
+/**
+ * Allocate an empty forced pack molecule for the given pattern, with every
+ * atom block position in the pattern set to invalid
+ */
+static t_pack_molecule* alloc_forced_pack_molecule(t_pack_patterns* pack_pattern) {
+    t_pack_molecule* molecule = new t_pack_molecule;
     molecule->valid = true;
     molecule->type = MOLECULE_FORCED_PACK;
     molecule->pack_pattern = pack_pattern;
     molecule->atom_block_ids = std::vector<AtomBlockId>(pack_pattern->num_blocks); //Initializes invalid
     molecule->num_blocks = pack_pattern->num_blocks;
     molecule->root = pack_pattern->root_block->block_id;
+    return molecule;
+}
 
-    if (try_expand_molecule(molecule, blk_id, atom_molecules, atom_nlist)) {
-        // Success! commit molecule
+/**
+ * Commit a successfully expanded molecule rooted at root_blk_id: initialize its
+ * chain info (for chain molecules) and link its atoms to it in atom_molecules
+ */
+static void commit_molecule(t_pack_molecule* molecule,
+                            const AtomBlockId root_blk_id,
+                            std::multimap<AtomBlockId, t_pack_molecule*>& atom_molecules,
+                            const AtomNetlist& atom_nlist) {
+    // update chain info for chain molecules
+    if (molecule->pack_pattern->is_chain) {
+        init_molecule_chain_info(root_blk_id, molecule, atom_molecules, atom_nlist);
+    }
 
-        // update chain info for chain molecules
-        if (molecule->pack_pattern->is_chain) {
-            init_molecule_chain_info(blk_id, molecule, atom_molecules, atom_nlist);
+    // update the atom_molcules with the atoms that are mapped to this molecule
+    for (int i = 0; i < molecule->pack_pattern->num_blocks; i++) {
+        auto blk_id2 = molecule->atom_block_ids[i];
+        if (!blk_id2) {
+            VTR_ASSERT(molecule->pack_pattern->is_block_optional[i]);
+            continue;
         }
 
-        // update the atom_molcules with the atoms that are mapped to this molecule
-        for (int i = 0; i < molecule->pack_pattern->num_blocks; i++) {
-            auto blk_id2 = molecule->atom_block_ids[i];
-            if (!blk_id2) {
-                VTR_ASSERT(molecule->pack_pattern->is_block_optional[i]);
-                continue;
-            }
-
-            atom_molecules.insert({blk_id2, molecule});
-        }
-    } else {
-        // Failed to create molecule
-        delete molecule;
-        return nullptr;
+        atom_molecules.insert({blk_id2, molecule});
     }
-
-    return molecule;
 }
 
 /**
@@ -1029,11 +1154,13 @@ static t_pack_molecule* try_create_molecule(t_pack_patterns* list_of_pack_patter
  *      molecule       : the molecule we are trying to expand
  *      atom_molecules : map of atom block ids that are assigned a molecule and a pointer to this molecule
  *      blk_id         : chosen to be the root of this molecule and the code is expanding from
+ *      visited_blocks : if not null, every atom block looked up in atom_molecules is appended to it
  */
 static bool try_expand_molecule(t_pack_molecule* molecule,
                                 const AtomBlockId blk_id,
                                 const std::multimap<AtomBlockId, t_pack_molecule*>& atom_molecules,
-                                const AtomNetlist& atom_nlist) {
+                                const AtomNetlist& atom_nlist,
+                                std::vector<AtomBlockId>* visited_blocks) {
     // root block of the pack pattern, which is the starting point of this pattern
     const auto pattern_root_block = molecule->pack_pattern->root_block;
     // bool array indicating whether a position in a pack pattern is optional or should
@@ -1065,6 +1192,10 @@ static bool try_expand_molecule(t_pack_molecule* molecule,
             continue;
         }
 
+        if (visited_blocks && block_id) {
+            visited_blocks->push_back(block_id);
+        }
+
         if (!block_id || !primitive_type_feasible(block_id, pattern_block->pb_type) || (molecule_atom_block_id && molecule_atom_block_id != block_id) || atom_molecules.find(block_id) != atom_molecules.end()) {
             // Stopping conditions, if:
             // 1) this is an invalid atom block (nothing)
@@ -3,10 +3,15 @@
 #    include "analytic_placer.h"
 #    include <Eigen/Core>
 #    include <Eigen/IterativeLinearSolvers>
+#    include <algorithm>
 #    include <iostream>
 #    include <vector>
 #    include <stdint.h>
 
+#    if defined(VPR_USE_TBB)
+#        include <tbb/parallel_invoke.h>
+#    endif
+
 #    include "vpr_types.h"
 #    include "vtr_time.h"
 #    include "read_place.h"
@@ -19,88 +24,118 @@
 // Templated struct for constructing and solving matrix equations in analytic placer
 template<typename T>
 struct EquationSystem {
+    // Eigen only runs the sparse matrix-vector products of the solver on multiple (OpenMP) threads
+    // for row major matrices. The matrix being symmetric, both storage orders give the same system.
+#    ifdef ENABLE_ANALYTIC_PLACE_OPENMP
+    using SparseMatrix = Eigen::SparseMatrix<T, Eigen::RowMajor>;
+#    else
+    using SparseMatrix = Eigen::SparseMatrix<T>;
+#    endif
+
     EquationSystem(size_t rows, size_t cols) {
-        A.resize(cols);
-        rhs.resize(rows);
+        resize(rows, cols);
     }
 
-    // A[col] is an entire column of the sparse matrix
-    // each entry in A[col][index] is a pair with {row_number, matrix value}.
-    //
-    // The strategy of skipping 0 row entries in each column enables easy conversion to
-    // Compressed Column Storage scheme supported by Eigen to reduce memory consumption
-    // and increase performance
-    std::vector<std::vector<std::pair<int, T>>> A;
+    // Nonzero entries of the sparse matrix A added since the last reset(), as {row, col, value} triplets.
+    // Entries at the same position are summed when A is assembled.
+    std::vector<Eigen::Triplet<T>> coeffs;
     // right hand side vector, i.e. b in Ax = b
     std::vector<T> rhs;
 
+    // A in compressed storage (by rows with ENABLE_ANALYTIC_PLACE_OPENMP, by columns otherwise), as
+    // assembled from coeffs by the last solve().
+    //
+    // The net connections (and so the positions in coeffs) of a block type rarely change from
+    // one build-solve iteration to the next, only the weights do. If coeffs has the same positions
+    // as when A was last assembled, only the values of A are updated, through coeff_value_index
+    // (index of each entry of coeffs in A's values), reusing A's sparsity pattern.
+    SparseMatrix mat;
+    std::vector<std::pair<int, int>> coeff_positions;
+    std::vector<int> coeff_value_index;
+
+    // Jacobi (diagonal) preconditioned conjugate gradient solver. The matrix is symmetric,
+    // both triangles are used so that the matrix-vector products can be vectorized.
+    Eigen::ConjugateGradient<SparseMatrix, Eigen::Lower | Eigen::Upper, Eigen::DiagonalPreconditioner<T>> solver;
+
+    // Sets the number of equations (rows) and variables (cols), and resets the system
+    void resize(size_t rows, size_t cols) {
+        if (size_t(mat.cols()) != cols) {
+            mat.resize(cols, cols);
+            coeff_positions.clear();
+            coeff_value_index.clear();
+        }
+        rhs.resize(rows);
+        reset();
+    }
+
     // System of equation is reset by:
-    // Clearing all entries in A's column, but size of A (number of columns) is preserved
+    // Clearing all entries of A (but keeping the last assembled sparsity pattern for reuse)
     // right hand side vector is set to default value of its templated type
     void reset() {
-        for (auto& col : A)
-            col.clear();
+        coeffs.clear();
         std::fill(rhs.begin(), rhs.end(), T());
     }
 
     // Add val to the matrix entry at (row, col)
     // create entry if it doesn't exist
     void add_coeff(int row, int col, T val) {
-        auto& A_col = A.at(col);
-        // Binary search for the row entry in column col
-        int begin_i = 0, end_i = int(A_col.size()) - 1;
-        while (begin_i <= end_i) {
-            int i = (begin_i + end_i) / 2;
-            if (A_col.at(i).first == row) {
-                A_col.at(i).second += val;
-                return;
-            }
-            if (A_col.at(i).first > row)
-                end_i = i - 1;
-            else
-                begin_i = i + 1;
-        }
-        A_col.insert(A_col.begin() + begin_i, std::make_pair(row, val));
+        coeffs.emplace_back(row, col, val);
     }
 
     // Add val to the "row"-th entry of right hand side vector
     void add_rhs(int row, T val) { rhs[row] += val; }
 
+    // Assemble mat from coeffs, reusing its sparsity pattern if coeffs has the same positions as last time
+    void assemble() {
+        bool same_pattern = coeff_positions.size() == coeffs.size()
+                            && std::equal(coeffs.begin(), coeffs.end(), coeff_positions.begin(),
+                                          [](const Eigen::Triplet<T>& coeff, const std::pair<int, int>& pos) {
+                                              return coeff.row() == pos.first && coeff.col() == pos.second;
+                                          });
+        if (same_pattern) {
+            T* values = mat.valuePtr();
+            std::fill(values, values + mat.nonZeros(), T());
+            for (size_t i = 0; i < coeffs.size(); i++)
+                values[coeff_value_index[i]] += coeffs[i].value();
+            return;
+        }
+
+        mat.setFromTriplets(coeffs.begin(), coeffs.end());
+        mat.makeCompressed();
+
+        coeff_positions.resize(coeffs.size());
+        coeff_value_index.resize(coeffs.size());
+        const int* outer = mat.outerIndexPtr();
+        const int* inner = mat.innerIndexPtr();
+        for (size_t i = 0; i < coeffs.size(); i++) {
+            int row = coeffs[i].row(), col = coeffs[i].col();
+            coeff_positions[i] = {row, col};
+            int outer_index = SparseMatrix::IsRowMajor ? row : col;
+            int inner_index = SparseMatrix::IsRowMajor ? col : row;
+            coeff_value_index[i] = int(std::lower_bound(inner + outer[outer_index], inner + outer[outer_index + 1], inner_index) - inner);
+        }
+    }
+
     // Solving Ax = b, using current x as an initial guess, returns x by reference.
     // (x must be of correct size, A and rhs must have their entries filled in)
     // tolerance is residual error from solver: |Ax-b|/|b|, 1e-5 works well,
     // can be tuned in ap_cfg in AnalyticPlacer constructor
     void solve(std::vector<T>& x, float tolerance) {
         using namespace Eigen;
+        using Vector = Matrix<T, Dynamic, 1>;
 
-        VTR_ASSERT(x.size() == A.size());
+        VTR_ASSERT(x.size() == size_t(mat.cols()));
 
-        // Converting A into SparseMatrix format from Eigen
-        VectorXd vec_x_guess(x.size()), vec_rhs(rhs.size());
-        SparseMatrix<T> mat(A.size(), A.size());
-
-        std::vector<int> colnnz; // vector containing number of entries in each column
-        for (auto& A_col : A)
-            colnnz.push_back(int(A_col.size()));
-        mat.reserve(colnnz); // reserve memory for mat depending on number of entries in each row
-        for (int col = 0; col < int(A.size()); col++) {
-            auto& A_col = A.at(col);
-            for (auto& row_entry : A_col)
-                mat.insert(row_entry.first, col) = row_entry.second;
-        }
+        assemble();
 
         // use current value of x as guess for iterative solver
-        for (int i_row = 0; i_row < int(x.size()); i_row++)
-            vec_x_guess[i_row] = x.at(i_row);
-
-        for (int i_row = 0; i_row < int(rhs.size()); i_row++)
-            vec_rhs[i_row] = rhs.at(i_row);
+        Map<Vector> vec_x(x.data(), x.size());
+        Map<const Vector> vec_rhs(rhs.data(), rhs.size());
+        Vector vec_x_guess = vec_x;
 
-        ConjugateGradient<SparseMatrix<T>, Lower | Upper> solver;
         solver.setTolerance(tolerance);
-        VectorXd x_res = solver.compute(mat).solveWithGuess(vec_rhs, vec_x_guess);
-        for (int i_row = 0; i_row < int(x.size()); i_row++)
-            x.at(i_row) = x_res[i_row];
+        solver.compute(mat);
+        vec_x = solver.solveWithGuess(vec_rhs, vec_x_guess);
     }
 };
 
@@ -131,7 +166,10 @@ constexpr int HEAP_STALLED_ITERATIONS_STOP = 15;
 
 AnalyticPlacer::AnalyticPlacer(BlkLocRegistry& blk_loc_registry)
     : blk_loc_registry_ref_(blk_loc_registry) {
-    //Eigen::initParallel();
+#    ifdef ENABLE_ANALYTIC_PLACE_OPENMP
+    // The x and y systems may be solved concurrently (see build_solve_type()), each with multiple threads
+    Eigen::initParallel();
+#    endif
 
     // TODO: PlacerHeapCfg should be externally configured & supplied
     // TODO: tune these parameters for better performance
@@ -163,6 +201,9 @@ AnalyticPlacer::AnalyticPlacer(BlkLocRegistry& blk_loc_registry)
     ap_cfg.timingWeight = 10;
 }
 
+// Out of line, where EquationSystem is complete
+AnalyticPlacer::~AnalyticPlacer() = default;
+
 /*
  * Main function of analytic placement
  * Takes the random initial placement from place.cpp through g_vpr_ctx
@@ -285,8 +326,16 @@ void AnalyticPlacer::build_solve_type(t_logical_block_type_ptr run, int iter) {
     setup_solve_blks(run);
     // build and solve matrix equation for both x, y
     // passing -1 as iter to build_solve_direction() signals build_equation() not to add pseudo-connections
-    build_solve_direction(false, (iter == 0) ? -1 : iter, ap_cfg.buildSolveIter);
-    build_solve_direction(true, (iter == 0) ? -1 : iter, ap_cfg.buildSolveIter);
+    // The x and y equations only read and write the x and y locations of blocks respectively, so they are
+    // solved concurrently
+    auto build_solve_x = [&]() { build_solve_direction(false, (iter == 0) ? -1 : iter, ap_cfg.buildSolveIter); };
+    auto build_solve_y = [&]() { build_solve_direction(true, (iter == 0) ? -1 : iter, ap_cfg.buildSolveIter); };
+#    if defined(VPR_USE_TBB)
+    tbb::parallel_invoke(build_solve_x, build_solve_y);
+#    else
+    build_solve_x();
+    build_solve_y();
+#    endif
     update_macros(); // update macro member locations, since only macro head is solved
 }
 
@@ -308,6 +357,8 @@ void AnalyticPlacer::init() {
     for (auto blk_id : clb_nlist.blocks()) {
         blk_locs.insert(blk_id, BlockLocation{});
         blk_locs[blk_id].loc = init_block_locs[blk_id].loc; // transfer of initial placement
+        blk_locs[blk_id].rawx = blk_locs[blk_id].loc.x;     // initial guess of the first solve
+        blk_locs[blk_id].rawy = blk_locs[blk_id].loc.y;
         row_num.insert(blk_id, DONT_SOLVE);                      // no blocks are moved by default, until they are setup in setup_solve_blks()
     }
 
@@ -450,10 +501,17 @@ void AnalyticPlacer::update_macros() {
  * tuned for better performance.
  */
 void AnalyticPlacer::build_solve_direction(bool yaxis, int iter, int build_solve_iter) {
+    // the equation system of each direction is kept across solves, to reuse its memory and sparsity pattern
+    std::unique_ptr<EquationSystem<double>>& es = yaxis ? equations_y : equations_x;
+    if (!es) {
+        es = std::make_unique<EquationSystem<double>>(solve_blks.size(), solve_blks.size());
+    } else {
+        es->resize(solve_blks.size(), solve_blks.size());
+    }
+
     for (int i = 0; i < build_solve_iter; i++) {
-        EquationSystem<double> esx(solve_blks.size(), solve_blks.size());
-        build_equations(esx, yaxis, iter);
-        solve_equations(esx, yaxis);
+        build_equations(*es, yaxis, iter);
+        solve_equations(*es, yaxis);
     }
 }
 
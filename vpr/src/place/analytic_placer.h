@@ -82,6 +82,8 @@
  * https://github.com/YosysHQ/nextpnr
  */
 
+#    include <memory>
+
 #    include "vpr_context.h"
 #    include "timing_place.h"
 #    include "PlacementDelayCalculator.h"
@@ -124,6 +126,7 @@ class AnalyticPlacer {
      */
     AnalyticPlacer() = delete;
     explicit AnalyticPlacer(BlkLocRegistry& blk_loc_registry);
+    ~AnalyticPlacer();
 
     /*
      * @brief main function of analytic placement
@@ -196,6 +199,10 @@ class AnalyticPlacer {
     // which are a subset of place_blks
     std::vector<ClusterBlockId> solve_blks;
 
+    // equation systems of the x and y directions, reused by each build-solve (@see build_solve_direction())
+    std::unique_ptr<EquationSystem<double>> equations_x;
+    std::unique_ptr<EquationSystem<double>> equations_y;
+
     /*
      * Prints the location of each block, and a simple drawing of FPGA fabric, showing num of blocks on each tile
      * Very useful for debugging
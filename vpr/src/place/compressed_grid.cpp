@@ -14,6 +14,14 @@
 static t_compressed_block_grid create_compressed_block_grid(const std::vector<std::vector<vtr::Point<int>>>& locations,
                                                             int num_layers);
 
+/**
+ * @brief Builds the dense look-ups of a compressed grid (prefix counts of its columns and
+ * closest compressed coordinates of each device grid coordinate) from its sparse grid.
+ */
+static void build_compressed_block_grid_lookups(t_compressed_block_grid& compressed_grid,
+                                                int device_width,
+                                                int device_height);
+
 
 std::vector<t_compressed_block_grid> create_compressed_block_grids() {
     auto& device_ctx = g_vpr_ctx.device();
@@ -52,7 +60,9 @@ std::vector<t_compressed_block_grid> create_compressed_block_grids() {
 
     for (const auto& logical_block : device_ctx.logical_block_types) {
         auto compressed_block_grid = create_compressed_block_grid(block_locations[logical_block.index], num_layers);
+        build_compressed_block_grid_lookups(compressed_block_grid, (int)grid.width(), (int)grid.height());
 
+        compressed_block_grid.compatible_sub_tiles_for_tile.resize(device_ctx.physical_tile_types.size());
         for (const auto& physical_tile : logical_block.equivalent_tiles) {
             std::vector<int> compatible_sub_tiles;
 
@@ -68,12 +78,17 @@ std::vector<t_compressed_block_grid> create_compressed_block_grids() {
                 }
             }
 
-            // For each of physical tiles compatible with the current logical block, create add an entry
-            // to the compatible sub tiles map with the physical tile index and the above generated vector.
-            compressed_block_grid.compatible_sub_tiles_for_tile.insert({physical_tile->index, compatible_sub_tiles});
+            // For each of physical tiles compatible with the current logical block, store the above
+            // generated vector at the physical tile index.
+            auto& compatible_sub_tiles_for_tile = compressed_block_grid.compatible_sub_tiles_for_tile;
+            VTR_ASSERT(physical_tile->index >= 0);
+            if (physical_tile->index >= (int)compatible_sub_tiles_for_tile.size()) {
+                compatible_sub_tiles_for_tile.resize(physical_tile->index + 1);
+            }
+            compatible_sub_tiles_for_tile[physical_tile->index] = std::move(compatible_sub_tiles);
         }
 
-        compressed_type_grids[logical_block.index] = compressed_block_grid;
+        compressed_type_grids[logical_block.index] = std::move(compressed_block_grid);
     }
 
     return compressed_type_grids;
@@ -162,6 +177,49 @@ static t_compressed_block_grid create_compressed_block_grid(const std::vector<st
     return compressed_grid;
 }
 
+static void build_compressed_block_grid_lookups(t_compressed_block_grid& compressed_grid,
+                                                int device_width,
+                                                int device_height) {
+    const int num_layers = (int)compressed_grid.grid.size();
+
+    compressed_grid.num_blocks_below.resize(num_layers);
+    compressed_grid.grid_x_to_compressed_x_approx.resize(num_layers);
+    compressed_grid.grid_y_to_compressed_y_approx.resize(num_layers);
+
+    for (int layer_num = 0; layer_num < num_layers; layer_num++) {
+        const auto& layer_compressed_grid = compressed_grid.grid[layer_num];
+        const int num_columns = (int)compressed_grid.get_num_columns(layer_num);
+        const int num_rows = (int)compressed_grid.get_num_rows(layer_num);
+
+        auto& num_blocks_below = compressed_grid.num_blocks_below[layer_num];
+        num_blocks_below.resize({(size_t)num_columns, (size_t)num_rows + 1}, 0);
+        for (int cx = 0; cx < num_columns; cx++) {
+            int num_blocks = 0;
+            auto block_itr = layer_compressed_grid[cx].begin();
+            for (int cy = 0; cy <= num_rows; cy++) {
+                //Count the blocks of the column below cy
+                while (block_itr != layer_compressed_grid[cx].end() && block_itr->first < cy) {
+                    ++num_blocks;
+                    ++block_itr;
+                }
+                num_blocks_below[cx][cy] = num_blocks;
+            }
+        }
+
+        auto& x_lookup = compressed_grid.grid_x_to_compressed_x_approx[layer_num];
+        x_lookup.resize(device_width);
+        for (int x = 0; x < device_width; x++) {
+            x_lookup[x] = t_compressed_block_grid::find_closest_compressed_point(x, compressed_grid.compressed_to_grid_x[layer_num]);
+        }
+
+        auto& y_lookup = compressed_grid.grid_y_to_compressed_y_approx[layer_num];
+        y_lookup.resize(device_height);
+        for (int y = 0; y < device_height; y++) {
+            y_lookup[y] = t_compressed_block_grid::find_closest_compressed_point(y, compressed_grid.compressed_to_grid_y[layer_num]);
+        }
+    }
+}
+
 /*Print the contents of the compressed grids to an echo file*/
 void echo_compressed_grids(const char* filename, const std::vector<t_compressed_block_grid>& comp_grids) {
     FILE* fp;
@@ -5,6 +5,7 @@
 
 #include "vtr_geometry.h"
 #include "vtr_flat_map.h"
+#include "vtr_ndmatrix.h"
 
 struct t_compressed_block_grid {
     // The compressed grid of a block type stores only the coordinates that are occupied by that particular block type.
@@ -25,11 +26,23 @@ struct t_compressed_block_grid {
     //This makes it easy to check whether there exist
     std::vector<std::vector<vtr::flat_map2<int, t_physical_tile_loc>>> grid;
 
+    //Dense prefix counts of the sparse columns: 'num_blocks_below[layer_num][cx][cy]' is the number
+    //of blocks of column 'cx' whose compressed y is smaller than 'cy'. Since a column's blocks are
+    //sorted by y, this gives the position in grid[layer_num][cx] of the blocks within any range of
+    //rows in O(1) (see get_column_block_range()).
+    std::vector<vtr::NdMatrix<int, 2>> num_blocks_below; // [0...num_layers-1][0...num_columns-1][0...num_rows]
+
+    //The closest compressed x (resp. y) of each device grid x (resp. y), as returned by
+    //grid_loc_to_compressed_loc_approx(), so that it doesn't need to binary search
+    std::vector<std::vector<int>> grid_x_to_compressed_x_approx; // [0...num_layers-1][0...device_width-1]
+    std::vector<std::vector<int>> grid_y_to_compressed_y_approx; // [0...num_layers-1][0...device_height-1]
+
     //The sub type compatibility for a given physical tile and a compressed block grid
     //corresponding to the possible placement location for a given logical block
-    //  - key: physical tile index
+    //  - index: physical tile index
     //  - value: vector of compatible sub tiles for the physical tile/logical block pair
-    std::unordered_map<int, std::vector<int>> compatible_sub_tiles_for_tile;
+    //           (empty if the physical tile isn't compatible with the logical block)
+    std::vector<std::vector<int>> compatible_sub_tiles_for_tile;
 
     inline size_t get_num_columns(int layer_num) const {
         return compressed_to_grid_x[layer_num].size();
@@ -118,46 +131,72 @@ struct t_compressed_block_grid {
      * the nearest compressed location to point by rounding it down
      */
     inline t_physical_tile_loc grid_loc_to_compressed_loc_approx(t_physical_tile_loc grid_loc) const {
-        auto find_closest_compressed_point = [](int loc, const std::vector<int>& compressed_grid_dim) -> int {
-            auto itr = std::lower_bound(compressed_grid_dim.begin(), compressed_grid_dim.end(), loc);
-            int cx;
-            if (itr < compressed_grid_dim.end() - 1) {
-                int dist_prev = abs(loc - *itr);
-                int dist_next = abs(loc - *(itr+1));
-                if (dist_prev < dist_next) {
-                    cx = std::distance(compressed_grid_dim.begin(), itr);
-                } else {
-                    cx = std::distance(compressed_grid_dim.begin(), itr + 1);
-                }
-            } else if (itr == compressed_grid_dim.end()) {
-                cx = std::distance(compressed_grid_dim.begin(), itr - 1);
-            } else {
-                cx = std::distance(compressed_grid_dim.begin(), itr);
+        auto closest_compressed_point = [](int loc, const std::vector<int>& lookup, const std::vector<int>& compressed_grid_dim) -> int {
+            if (loc >= 0 && loc < (int)lookup.size()) {
+                return lookup[loc];
             }
-
-            return cx;
+            return find_closest_compressed_point(loc, compressed_grid_dim);
         };
 
         const int layer_num = grid_loc.layer_num;
-        const int cx = find_closest_compressed_point(grid_loc.x, compressed_to_grid_x[layer_num]);
-        const int cy = find_closest_compressed_point(grid_loc.y, compressed_to_grid_y[layer_num]);
+        const int cx = closest_compressed_point(grid_loc.x, grid_x_to_compressed_x_approx[layer_num], compressed_to_grid_x[layer_num]);
+        const int cy = closest_compressed_point(grid_loc.y, grid_y_to_compressed_y_approx[layer_num], compressed_to_grid_y[layer_num]);
 
         return {cx, cy, layer_num};
     }
 
+    ///@brief Returns the closest point to loc in compressed_grid_dim (the sorted grid coordinates of one dimension of a compressed grid)
+    static int find_closest_compressed_point(int loc, const std::vector<int>& compressed_grid_dim) {
+        auto itr = std::lower_bound(compressed_grid_dim.begin(), compressed_grid_dim.end(), loc);
+        int cx;
+        if (itr < compressed_grid_dim.end() - 1) {
+            int dist_prev = abs(loc - *itr);
+            int dist_next = abs(loc - *(itr+1));
+            if (dist_prev < dist_next) {
+                cx = std::distance(compressed_grid_dim.begin(), itr);
+            } else {
+                cx = std::distance(compressed_grid_dim.begin(), itr + 1);
+            }
+        } else if (itr == compressed_grid_dim.end()) {
+            cx = std::distance(compressed_grid_dim.begin(), itr - 1);
+        } else {
+            cx = std::distance(compressed_grid_dim.begin(), itr);
+        }
+
+        return cx;
+    }
+
     inline t_physical_tile_loc compressed_loc_to_grid_loc(t_physical_tile_loc compressed_loc) const {
         int layer_num = compressed_loc.layer_num;
         return {compressed_to_grid_x[layer_num][compressed_loc.x], compressed_to_grid_y[layer_num][compressed_loc.y], layer_num};
     }
 
     inline const std::vector<int>& compatible_sub_tile_num(int physical_type_index) const {
-        return compatible_sub_tiles_for_tile.at(physical_type_index);
+        VTR_ASSERT_SAFE(physical_type_index >= 0 && physical_type_index < (int)compatible_sub_tiles_for_tile.size());
+        return compatible_sub_tiles_for_tile[physical_type_index];
     }
 
     inline const vtr::flat_map2<int, t_physical_tile_loc>& get_column_block_map(int cx, int layer_num) const {
         return grid[layer_num][cx];
     }
 
+    /**
+     * @brief Returns the positions [first, last) in get_column_block_map(cx, layer_num) of the blocks
+     * whose compressed y is within [ymin, ymax], in O(1).
+     *
+     * The range is empty (first == last) if there is no such block; first is then the position of the
+     * first block above ymax (or the size of the column if there is none).
+     */
+    inline std::pair<int, int> get_column_block_range(int cx, int ymin, int ymax, int layer_num) const {
+        const auto& layer_num_blocks_below = num_blocks_below[layer_num];
+        const int num_rows = (int)layer_num_blocks_below.dim_size(1) - 1;
+
+        int first = layer_num_blocks_below[cx][std::clamp(ymin, 0, num_rows)];
+        int last = layer_num_blocks_below[cx][std::clamp(ymax + 1, 0, num_rows)];
+
+        return {first, std::max(first, last)};
+    }
+
     inline const std::vector<int>& get_layer_nums() const {
         return compressed_to_grid_layer;
     }
@@ -1,6 +1,7 @@
 
 #include "directed_moves_util.h"
 #include "centroid_move_generator.h"
+#include "placer_state.h"
 
 t_physical_tile_loc get_coordinate_of_pin(ClusterPinId pin,
                                           const BlkLocRegistry& blk_loc_registry) {
@@ -23,12 +24,113 @@ t_physical_tile_loc get_coordinate_of_pin(ClusterPinId pin,
     return tile_loc;
 }
 
+void init_net_sink_loc_sums(const PlacerCriticalities* criticalities,
+                            PlacerState& placer_state) {
+    const auto& clb_nlist = g_vpr_ctx.clustering().clb_nlist;
+    const auto& blk_loc_registry = placer_state.blk_loc_registry();
+    auto& place_move_ctx = placer_state.mutable_move();
+
+    place_move_ctx.net_sink_loc_sums.assign(clb_nlist.nets().size(), t_net_sink_loc_sum());
+    place_move_ctx.sink_pin_locs.resize(clb_nlist.pins().size());
+    place_move_ctx.sink_pin_weights.assign(clb_nlist.pins().size(), 0.);
+
+    for (ClusterNetId net_id : clb_nlist.nets()) {
+        if (clb_nlist.net_is_ignored(net_id)) {
+            continue;
+        }
+
+        t_net_sink_loc_sum& sum = place_move_ctx.net_sink_loc_sums[net_id];
+        for (ClusterPinId sink_pin_id : clb_nlist.net_sinks(net_id)) {
+            t_physical_tile_loc tile_loc = get_coordinate_of_pin(sink_pin_id, blk_loc_registry);
+            float weight = 0.;
+            if (criticalities) {
+                weight = criticalities->criticality(net_id, clb_nlist.pin_net_index(sink_pin_id));
+            }
+
+            sum.num_sinks++;
+            sum.x += tile_loc.x;
+            sum.y += tile_loc.y;
+            sum.layer += tile_loc.layer_num;
+
+            sum.weight += weight;
+            sum.weighted_x += tile_loc.x * weight;
+            sum.weighted_y += tile_loc.y * weight;
+            sum.weighted_layer += tile_loc.layer_num * weight;
+
+            place_move_ctx.sink_pin_locs[sink_pin_id] = tile_loc;
+            place_move_ctx.sink_pin_weights[sink_pin_id] = weight;
+        }
+    }
+}
+
+void update_net_sink_loc_sums(const t_pl_blocks_to_be_moved& blocks_affected,
+                              PlacerState& placer_state) {
+    const auto& clb_nlist = g_vpr_ctx.clustering().clb_nlist;
+    const auto& blk_loc_registry = placer_state.blk_loc_registry();
+    auto& place_move_ctx = placer_state.mutable_move();
+
+    for (const t_pl_moved_block& moved_block : blocks_affected.moved_blocks) {
+        for (ClusterPinId pin_id : clb_nlist.block_pins(moved_block.block_num)) {
+            ClusterNetId net_id = clb_nlist.pin_net(pin_id);
+            if (clb_nlist.pin_type(pin_id) != PinType::SINK || clb_nlist.net_is_ignored(net_id)) {
+                continue;
+            }
+
+            t_physical_tile_loc new_loc = get_coordinate_of_pin(pin_id, blk_loc_registry);
+            t_physical_tile_loc& old_loc = place_move_ctx.sink_pin_locs[pin_id];
+            int dx = new_loc.x - old_loc.x;
+            int dy = new_loc.y - old_loc.y;
+            int dlayer = new_loc.layer_num - old_loc.layer_num;
+            float weight = place_move_ctx.sink_pin_weights[pin_id];
+
+            t_net_sink_loc_sum& sum = place_move_ctx.net_sink_loc_sums[net_id];
+            sum.x += dx;
+            sum.y += dy;
+            sum.layer += dlayer;
+            sum.weighted_x += dx * weight;
+            sum.weighted_y += dy * weight;
+            sum.weighted_layer += dlayer * weight;
+
+            old_loc = new_loc;
+        }
+    }
+}
+
+void update_net_sink_loc_sum_weight(ClusterPinId sink_pin,
+                                    float weight,
+                                    PlacerMoveContext& place_move_ctx) {
+    const auto& clb_nlist = g_vpr_ctx.clustering().clb_nlist;
+
+    //Nothing to update until the sums are initialized
+    if (place_move_ctx.sink_pin_weights.empty()) {
+        return;
+    }
+
+    ClusterNetId net_id = clb_nlist.pin_net(sink_pin);
+    if (clb_nlist.pin_type(sink_pin) != PinType::SINK || clb_nlist.net_is_ignored(net_id)) {
+        return;
+    }
+
+    const t_physical_tile_loc& tile_loc = place_move_ctx.sink_pin_locs[sink_pin];
+    float& old_weight = place_move_ctx.sink_pin_weights[sink_pin];
+    double dweight = (double)weight - old_weight;
+
+    t_net_sink_loc_sum& sum = place_move_ctx.net_sink_loc_sums[net_id];
+    sum.weight += dweight;
+    sum.weighted_x += tile_loc.x * dweight;
+    sum.weighted_y += tile_loc.y * dweight;
+    sum.weighted_layer += tile_loc.layer_num * dweight;
+
+    old_weight = weight;
+}
+
 void calculate_centroid_loc(ClusterBlockId b_from,
                             bool timing_weights,
                             t_pl_loc& centroid,
                             const PlacerCriticalities* criticalities,
                             bool noc_attraction_enabled,
                             float noc_attraction_weight,
+                            const PlacerMoveContext& place_move_ctx,
                             const BlkLocRegistry& blk_loc_registry) {
     const auto& cluster_ctx = g_vpr_ctx.clustering();
     const auto& block_locs = blk_loc_registry.block_locs();
@@ -61,29 +163,21 @@ void calculate_centroid_loc(ClusterBlockId b_from,
             }
         }
 
-        //if the pin is driver iterate over all the sinks
+        //if the pin is driver use the sums of the coordinates of all the sinks
         if (cluster_ctx.clb_nlist.pin_type(pin_id) == PinType::DRIVER) {
-            if (cluster_ctx.clb_nlist.net_is_ignored(net_id))
-                continue;
+            const t_net_sink_loc_sum& sum = place_move_ctx.net_sink_loc_sums[net_id];
+            VTR_ASSERT_SAFE(sum.num_sinks == (int)cluster_ctx.clb_nlist.net_sinks(net_id).size());
 
-            for (auto sink_pin_id : cluster_ctx.clb_nlist.net_sinks(net_id)) {
-                /* Ignore if one of the sinks is the block itself      *
-                 * This case rarely happens but causes QoR degradation */
-                if (pin_id == sink_pin_id)
-                    continue;
-                int ipin = cluster_ctx.clb_nlist.pin_net_index(sink_pin_id);
-                if (timing_weights) {
-                    weight = criticalities->criticality(net_id, ipin);
-                } else {
-                    weight = 1;
-                }
-
-                t_physical_tile_loc tile_loc = get_coordinate_of_pin(sink_pin_id, blk_loc_registry);
-
-                acc_x += tile_loc.x * weight;
-                acc_y += tile_loc.y * weight;
-                acc_layer += tile_loc.layer_num * weight;
-                acc_weight += weight;
+            if (timing_weights) {
+                acc_x += sum.weighted_x;
+                acc_y += sum.weighted_y;
+                acc_layer += sum.weighted_layer;
+                acc_weight += sum.weight;
+            } else {
+                acc_x += sum.x;
+                acc_y += sum.y;
+                acc_layer += sum.layer;
+                acc_weight += sum.num_sinks;
             }
         }
 
@@ -139,7 +233,8 @@ static std::map<std::string, e_reward_function> available_reward_function = {
     {"basic", e_reward_function::BASIC},
     {"nonPenalizing_basic", e_reward_function::NON_PENALIZING_BASIC},
     {"runtime_aware", e_reward_function::RUNTIME_AWARE},
-    {"WLbiased_runtime_aware", e_reward_function::WL_BIASED_RUNTIME_AWARE}};
+    {"WLbiased_runtime_aware", e_reward_function::WL_BIASED_RUNTIME_AWARE},
+    {"cost_per_time", e_reward_function::COST_PER_TIME}};
 
 e_reward_function string_to_reward(const std::string& st) {
     return available_reward_function[st];
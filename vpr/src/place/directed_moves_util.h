@@ -3,15 +3,20 @@
 
 #include "globals.h"
 #include "timing_place.h"
+#include "move_transactions.h"
+
+class PlacerState;
+struct PlacerMoveContext;
 
 /**
  * @brief enum represents the different reward functions
  */
 enum class e_reward_function {
-    BASIC,                  ///@ directly uses the change of the annealing cost function
-    NON_PENALIZING_BASIC,   ///@ same as basic reward function but with 0 reward if it's a hill-climbing one
-    RUNTIME_AWARE,          ///@ same as NON_PENALIZING_BASIC but with normalizing with the runtime factor of each move type
-    WL_BIASED_RUNTIME_AWARE ///@ same as RUNTIME_AWARE but more biased to WL cost (the factor of the bias is REWARD_BB_TIMING_RELATIVE_WEIGHT)
+    BASIC,                   ///@ directly uses the change of the annealing cost function
+    NON_PENALIZING_BASIC,    ///@ same as basic reward function but with 0 reward if it's a hill-climbing one
+    RUNTIME_AWARE,           ///@ same as NON_PENALIZING_BASIC but with normalizing with the runtime factor of each move type
+    WL_BIASED_RUNTIME_AWARE, ///@ same as RUNTIME_AWARE but more biased to WL cost (the factor of the bias is REWARD_BB_TIMING_RELATIVE_WEIGHT)
+    COST_PER_TIME            ///@ same as NON_PENALIZING_BASIC but divided by the measured average time (in microseconds) to evaluate a move of the move type
 };
 
 e_reward_function string_to_reward(const std::string& st);
@@ -20,6 +25,27 @@ e_reward_function string_to_reward(const std::string& st);
 t_physical_tile_loc get_coordinate_of_pin(ClusterPinId pin,
                                           const BlkLocRegistry& blk_loc_registry);
 
+/**
+ * @brief Computes the sums of the sink coordinates of every net (PlacerMoveContext::net_sink_loc_sums) from scratch
+ *
+ * The sums are then kept up to date by update_net_sink_loc_sums() as moves are committed, and by
+ * update_net_sink_loc_sum_weight() as criticalities change, so they must be recomputed whenever
+ * the placement is modified otherwise (e.g. when a checkpoint is restored).
+ *
+ * @param criticalities The criticalities used to weight the sinks (nullptr if the placement isn't timing driven)
+ */
+void init_net_sink_loc_sums(const PlacerCriticalities* criticalities,
+                            PlacerState& placer_state);
+
+///@brief Updates the sink coordinate sums of the nets of the blocks moved by a committed move
+void update_net_sink_loc_sums(const t_pl_blocks_to_be_moved& blocks_affected,
+                              PlacerState& placer_state);
+
+///@brief Updates the weighted sink coordinate sums of the net of sink_pin to the new weight of sink_pin
+void update_net_sink_loc_sum_weight(ClusterPinId sink_pin,
+                                    float weight,
+                                    PlacerMoveContext& place_move_ctx);
+
 /**
  * @brief Calculates the exact centroid location
  *
@@ -39,6 +65,8 @@ t_physical_tile_loc get_coordinate_of_pin(ClusterPinId pin,
  * @param noc_attraction_weight When NoC attraction is enabled, this weight
  * specifies to which extent the computed centroid should be adjusted. A value
  * in range [0, 1] is expected.
+ * @param place_move_ctx Provides the sink coordinate sums of the nets driven by b_from
+ * (see init_net_sink_loc_sums()), so that their sinks don't need to be visited.
  * 
  * @return The calculated location is returned in centroid parameter that is sent by reference
  */
@@ -48,14 +76,16 @@ void calculate_centroid_loc(ClusterBlockId b_from,
                             const PlacerCriticalities* criticalities,
                             bool noc_attraction_enabled,
                             float noc_attraction_weight,
+                            const PlacerMoveContext& place_move_ctx,
                             const BlkLocRegistry& blk_loc_registry);
 
 inline void calculate_centroid_loc(ClusterBlockId b_from,
                                    bool timing_weights,
                                    t_pl_loc& centroid,
                                    const PlacerCriticalities* criticalities,
+                                   const PlacerMoveContext& place_move_ctx,
                                    const BlkLocRegistry& blk_loc_registry) {
-    calculate_centroid_loc(b_from, timing_weights, centroid, criticalities, false, 0.0f, blk_loc_registry);
+    calculate_centroid_loc(b_from, timing_weights, centroid, criticalities, false, 0.0f, place_move_ctx, blk_loc_registry);
 }
 
 #endif
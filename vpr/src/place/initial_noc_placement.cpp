@@ -1,33 +1,26 @@
-
 #include "initial_noc_placment.h"
 
 #include "vpr_types.h"
 #include "initial_placement.h"
 #include "noc_place_utils.h"
 #include "noc_place_checkpoint.h"
+#include "noc_routing_algorithm_creator.h"
 #include "place_constraints.h"
 
 #include "sat_routing.h"
 
 #include "vtr_math.h"
+#include "vtr_random.h"
 #include "vtr_time.h"
 
+#include <algorithm>
 #include <limits>
+#include <map>
 #include <queue>
 
-/**
- * @brief Evaluates whether a NoC router swap should be accepted or not.
- * If delta cost is non-positive, the move is always accepted. If the cost
- * has increased, the probability of accepting the move is prob.
- *
- *   @param delta_cost Specifies how much the total cost would change if
- *   the proposed swap is accepted.
- *   @param prob The probability by which a router swap that increases
- *   the cost is accepted. The passed value should be in range [0, 1].
- *
- * @return true if the proposed swap is accepted, false if not.
- */
-static bool accept_noc_swap(double delta_cost, double prob);
+#ifdef VPR_USE_TBB
+#    include <tbb/parallel_for.h>
+#endif
 
 /**
  * @brief Places a constrained NoC router within its partition region.
@@ -53,13 +46,18 @@ static void place_noc_routers_randomly(std::vector<ClusterBlockId>& unfixed_rout
                                        BlkLocRegistry& blk_loc_registry);
 
 /**
- * @brief Runs a simulated annealing optimizer for NoC routers.
+ * @brief Runs noc_opts.noc_initial_placement_restarts independent simulated
+ * annealing optimizers for NoC routers in parallel, and keeps the placement
+ * with the lowest NoC cost. The first one starts from the current placement,
+ * the others from random placements of the unconstrained NoC routers.
  *
  *   @param noc_opts Contains weighting factors for NoC cost terms.
+ *   @param seed Seeds the random numbers of the optimizers.
  *   @param blk_loc_registry Placement block location information.
  *   To be filled with the location where pl_macro is placed.
  */
 static void noc_routers_anneal(const t_noc_opts& noc_opts,
+                               int seed,
                                BlkLocRegistry& blk_loc_registry);
 
 /**
@@ -68,6 +66,138 @@ static void noc_routers_anneal(const t_noc_opts& noc_opts,
  */
 static const t_compressed_block_grid& get_compressed_noc_grid();
 
+/**
+ * @brief The locations NoC router blocks can be placed at, and the NoC router
+ * blocks to be placed, shared by all the NoC router annealers.
+ */
+struct t_noc_anneal_problem {
+    /// A location where a NoC router block can be placed
+    struct t_slot {
+        t_pl_loc loc;
+        NocRouterId phy_router;
+        int x, y; ///< compressed location of the physical router
+    };
+
+    std::vector<t_slot> slots;
+    ///< the slots of the physical router at each compressed location, [(layer * num_x + x) * num_y + y]
+    std::vector<std::vector<int>> slots_at;
+    int num_x, num_y, num_layers;
+
+    std::vector<ClusterBlockId> routers;       ///< the NoC router blocks
+    std::vector<int> initial_slots;            ///< [router] the slot of each router in the current placement
+    std::vector<char> movable;                 ///< [router] whether the router is not fixed
+    std::vector<char> relocatable;             ///< [router] whether the router may start anywhere (unconstrained and movable)
+    std::vector<const PartitionRegion*> regions; ///< [router] region the router is constrained to, nullptr if unconstrained
+    std::vector<int> initial_occupants;        ///< [slot] router at the slot, -1 if empty, -2 if used by another block
+    vtr::vector<ClusterBlockId, int> router_index; ///< [block] index in routers, -1 if not a NoC router block
+
+    float max_r_lim;
+    NocCostTerms norm_factors; ///< shared by all the annealers, so that their costs can be compared
+};
+
+/**
+ * @brief A simulated annealing optimizer of the placement of the NoC router
+ * blocks which only considers the NoC costs.
+ *
+ * The placer keeps the traffic flow routes and link bandwidth usages in the
+ * NoC context and the NoC costs in static variables (see noc_place_utils.h),
+ * so that only one placement can be evaluated at a time. An annealer instead
+ * owns all its state: the location of each router block, the route and costs
+ * of each traffic flow, the bandwidth usage of each link, a routing algorithm
+ * (whose cache of the routes between physical routers is reused from move to
+ * move) and a random number generator. Several annealers can then run in
+ * parallel, each finding the same placement whatever the number of threads.
+ */
+class NocRouterAnnealer {
+  public:
+    NocRouterAnnealer(const t_noc_anneal_problem& problem,
+                      const t_noc_opts& noc_opts,
+                      vtr::RandomNumberGenerator rng);
+
+    ///@brief Places the relocatable routers at random slots
+    void place_randomly();
+
+    ///@brief Runs the annealing, saving the placement with the lowest cost
+    void anneal();
+
+    ///@brief The cost terms of the current placement
+    const NocCostTerms& cost_terms() const { return cost_terms_; }
+
+    ///@brief The lowest cost found, and the slot of each router in that placement
+    double best_cost() const { return best_cost_; }
+    const std::vector<int>& best_slots() const { return best_slots_; }
+
+  private:
+    ///@brief Routes all the traffic flows, and computes the costs of the current placement
+    void route_all_flows();
+
+    ///@brief Routes a traffic flow between the current locations of its routers, and computes its costs
+    void route_flow(NocTrafficFlowId flow_id);
+
+    ///@brief Moves a random router to a random slot within r_lim, swapping it with the router there if any
+    bool propose_move(float r_lim);
+
+    ///@brief Whether a router may be placed at a slot
+    bool is_legal(int router, int slot) const;
+
+    void move_router(int router, int slot);
+
+    ///@brief Re-routes the traffic flows of the routers moved by the last proposed move and returns the change of the cost terms
+    NocCostTerms reroute_moved_flows();
+
+    ///@brief Adds (or removes, if sign is -1) the bandwidth of a traffic flow to the links of its route
+    void update_link_usages(NocTrafficFlowId flow_id, double sign);
+
+    double link_congestion_cost(NocLinkId link_id, double usage) const;
+
+    void revert_move();
+
+    /**
+     * @brief Evaluates whether a NoC router swap should be accepted or not.
+     * If delta cost is non-positive, the move is always accepted. If the cost
+     * has increased, the probability of accepting the move is prob.
+     */
+    bool accept_move(double delta_cost, double prob);
+
+    double cost(const NocCostTerms& cost_terms) const {
+        return calculate_noc_cost(cost_terms, problem_.norm_factors, noc_opts_);
+    }
+
+    const t_noc_anneal_problem& problem_;
+    const t_noc_opts& noc_opts_;
+    const NocStorage& noc_model_;
+    const NocTrafficFlows& traffic_flows_;
+    std::unique_ptr<NocRouting> routing_;
+    vtr::RandomNumberGenerator rng_;
+
+    std::vector<int> router_slots_; ///< [router] slot of each router
+    std::vector<int> occupants_;    ///< [slot] router at each slot, -1 if empty, -2 if used by another block
+
+    vtr::vector<NocTrafficFlowId, std::vector<NocLinkId>> flow_routes_;
+    vtr::vector<NocTrafficFlowId, TrafficFlowPlaceCost> flow_costs_;
+    vtr::vector<NocLinkId, double> link_usages_;
+    NocCostTerms cost_terms_;
+
+    // What the last proposed move changed, to revert it
+    std::vector<std::pair<int, int>> moved_routers_; ///< (router, previous slot)
+    std::vector<NocTrafficFlowId> moved_flows_;
+    std::vector<std::vector<NocLinkId>> moved_flow_prev_routes_;
+    std::vector<TrafficFlowPlaceCost> moved_flow_prev_costs_;
+    std::vector<std::pair<NocLinkId, double>> moved_link_prev_usages_;
+    vtr::vector<NocTrafficFlowId, size_t> flow_stamps_;
+    vtr::vector<NocLinkId, size_t> link_stamps_;
+    size_t move_stamp_ = 0;
+
+    double best_cost_ = std::numeric_limits<double>::infinity();
+    std::vector<int> best_slots_;
+};
+
+/**
+ * @brief Builds the placement problem of the NoC router blocks from their
+ * current placement.
+ */
+static t_noc_anneal_problem build_noc_anneal_problem(const BlkLocRegistry& blk_loc_registry);
+
 static const t_compressed_block_grid& get_compressed_noc_grid() {
     auto& noc_ctx = g_vpr_ctx.noc();
     auto& place_ctx = g_vpr_ctx.placement();
@@ -82,23 +212,6 @@ static const t_compressed_block_grid& get_compressed_noc_grid() {
     return compressed_noc_grid;
 }
 
-static bool accept_noc_swap(double delta_cost, double prob) {
-    if (delta_cost <= 0.0) {
-        return true;
-    }
-
-    if (prob == 0.0) {
-        return false;
-    }
-
-    float random_num = vtr::frand();
-    if (random_num < prob) {
-        return true;
-    } else {
-        return false;
-    }
-}
-
 static void place_constrained_noc_router(ClusterBlockId router_blk_id,
                                          BlkLocRegistry& blk_loc_registry) {
     auto& cluster_ctx = g_vpr_ctx.clustering();
@@ -171,7 +284,7 @@ static void place_noc_routers_randomly(std::vector<ClusterBlockId>& unfixed_rout
 
         // Find a compatible sub-tile
         const auto& phy_type = device_ctx.grid.get_physical_type(router_phy_loc);
-        const auto& compatible_sub_tiles = compressed_noc_grid.compatible_sub_tiles_for_tile.at(phy_type->index);
+        const auto& compatible_sub_tiles = compressed_noc_grid.compatible_sub_tile_num(phy_type->index);
         int sub_tile = compatible_sub_tiles[vtr::irand((int)compatible_sub_tiles.size() - 1)];
 
         t_pl_loc loc(router_phy_loc, sub_tile);
@@ -201,49 +314,342 @@ static void place_noc_routers_randomly(std::vector<ClusterBlockId>& unfixed_rout
     } // end for of random router placement
 }
 
-static void noc_routers_anneal(const t_noc_opts& noc_opts,
-                               BlkLocRegistry& blk_loc_registry) {
-    auto& noc_ctx = g_vpr_ctx.noc();
+
+static t_noc_anneal_problem build_noc_anneal_problem(const BlkLocRegistry& blk_loc_registry) {
+    const auto& noc_ctx = g_vpr_ctx.noc();
+    const auto& device_ctx = g_vpr_ctx.device();
+    const auto& cluster_ctx = g_vpr_ctx.clustering();
+    const auto& floorplanning_ctx = g_vpr_ctx.floorplanning();
     const auto& block_locs = blk_loc_registry.block_locs();
+    const GridBlock& grid_blocks = blk_loc_registry.grid_blocks();
+    const auto& compressed_noc_grid = get_compressed_noc_grid();
+    const auto& noc_phy_routers = noc_ctx.noc_model.get_noc_routers();
 
-    // Only NoC related costs are considered
-    t_placer_costs costs;
+    t_noc_anneal_problem problem;
 
-    // Initialize NoC-related costs
-    costs.noc_cost_terms.aggregate_bandwidth = comp_noc_aggregate_bandwidth_cost();
-    std::tie(costs.noc_cost_terms.latency, costs.noc_cost_terms.latency_overrun) = comp_noc_latency_cost();
-    costs.noc_cost_terms.congestion = comp_noc_congestion_cost();
-    update_noc_normalization_factors(costs);
-    costs.cost = calculate_noc_cost(costs.noc_cost_terms, costs.noc_cost_norm_factors, noc_opts);
+    // Compress the locations of the physical routers, so that the range limit counts routers rather than tiles
+    std::map<int, int> x_indices, y_indices;
+    for (const NocRouter& phy_router : noc_phy_routers) {
+        x_indices[phy_router.get_router_grid_position_x()] = 0;
+        y_indices[phy_router.get_router_grid_position_y()] = 0;
+    }
+    int index = 0;
+    for (auto& [x, x_index] : x_indices) {
+        x_index = index++;
+    }
+    index = 0;
+    for (auto& [y, y_index] : y_indices) {
+        y_index = index++;
+    }
+    problem.num_x = x_indices.size();
+    problem.num_y = y_indices.size();
+    problem.num_layers = device_ctx.grid.get_num_layers();
+    problem.slots_at.resize(problem.num_layers * problem.num_x * problem.num_y);
 
-    const auto& compressed_noc_grid = get_compressed_noc_grid();
-    const size_t n_noc_layers = compressed_noc_grid.get_layer_nums().size();
+    // Each compatible sub-tile location of a physical router is a slot
+    std::unordered_map<t_pl_loc, int> slot_indices;
+    for (const NocRouter& phy_router : noc_phy_routers) {
+        t_physical_tile_loc phy_loc = phy_router.get_router_physical_location();
+        const auto& phy_type = device_ctx.grid.get_physical_type(phy_loc);
+        int x = x_indices[phy_loc.x];
+        int y = y_indices[phy_loc.y];
+
+        for (int sub_tile_index : compressed_noc_grid.compatible_sub_tile_num(phy_type->index)) {
+            const t_sub_tile& sub_tile = phy_type->sub_tiles[sub_tile_index];
+            for (int k = sub_tile.capacity.low; k <= sub_tile.capacity.high; k++) {
+                t_pl_loc loc(phy_loc, k);
+                int slot = problem.slots.size();
+                problem.slots.push_back({loc, noc_ctx.noc_model.get_router_at_grid_location(loc), x, y});
+                problem.slots_at[(phy_loc.layer_num * problem.num_x + x) * problem.num_y + y].push_back(slot);
+                slot_indices[loc] = slot;
+            }
+        }
+    }
+
+    // The NoC router blocks
+    problem.routers = noc_ctx.noc_traffic_flows_storage.get_router_clusters_in_netlist();
+    problem.router_index.resize(cluster_ctx.clb_nlist.blocks().size(), -1);
+    for (size_t router = 0; router < problem.routers.size(); router++) {
+        ClusterBlockId router_blk_id = problem.routers[router];
+        problem.router_index[router_blk_id] = router;
+
+        auto slot_it = slot_indices.find(block_locs[router_blk_id].loc);
+        VTR_ASSERT(slot_it != slot_indices.end());
+        problem.initial_slots.push_back(slot_it->second);
+
+        const PartitionRegion* region = nullptr;
+        if (is_cluster_constrained(router_blk_id)) {
+            region = &floorplanning_ctx.cluster_constraints[router_blk_id];
+        }
+        problem.regions.push_back(region);
+        problem.movable.push_back(!block_locs[router_blk_id].is_fixed);
+        problem.relocatable.push_back(!block_locs[router_blk_id].is_fixed && region == nullptr);
+    }
+
+    for (const t_noc_anneal_problem::t_slot& slot : problem.slots) {
+        ClusterBlockId blk_id = grid_blocks.block_at_location(slot.loc);
+        if (!blk_id) {
+            problem.initial_occupants.push_back(-1);
+        } else if (problem.router_index[blk_id] >= 0) {
+            problem.initial_occupants.push_back(problem.router_index[blk_id]);
+        } else {
+            problem.initial_occupants.push_back(-2);
+        }
+    }
 
     /* Maximum distance in each direction that a router can travel in a move.
      * The calculation below assumes that NoC routers are organized in a square grid;
      * if it is a 3D architecture it also assumes each layer has the same number of routers.
      * Breaking that assumption is OK, but the calculation may not compute the best initial range limit in that case.
      * Each router can initially move within the entire grid with a single swap.*/
-    const size_t n_physical_routers = noc_ctx.noc_model.get_noc_routers().size();
-    const float max_r_lim = ceilf(sqrtf((float)n_physical_routers / (float)n_noc_layers));
+    const size_t n_noc_layers = compressed_noc_grid.get_layer_nums().size();
+    const size_t n_physical_routers = noc_phy_routers.size();
+    problem.max_r_lim = ceilf(sqrtf((float)n_physical_routers / (float)n_noc_layers));
+
+    return problem;
+}
+
+NocRouterAnnealer::NocRouterAnnealer(const t_noc_anneal_problem& problem,
+                                     const t_noc_opts& noc_opts,
+                                     vtr::RandomNumberGenerator rng)
+    : problem_(problem)
+    , noc_opts_(noc_opts)
+    , noc_model_(g_vpr_ctx.noc().noc_model)
+    , traffic_flows_(g_vpr_ctx.noc().noc_traffic_flows_storage)
+    , routing_(NocRoutingAlgorithmCreator::create_routing_algorithm(noc_opts.noc_routing_algorithm, noc_model_))
+    , rng_(rng)
+    , router_slots_(problem.initial_slots)
+    , occupants_(problem.initial_occupants) {
+    const size_t num_flows = traffic_flows_.get_number_of_traffic_flows();
+    flow_routes_.resize(num_flows);
+    flow_costs_.resize(num_flows);
+    flow_stamps_.resize(num_flows, 0);
+
+    const size_t num_links = noc_model_.get_number_of_noc_links();
+    link_usages_.resize(num_links, 0.);
+    link_stamps_.resize(num_links, 0);
+
+    route_all_flows();
+}
+
+void NocRouterAnnealer::place_randomly() {
+    // The relocatable routers can go to any slot that is empty or taken by one of them
+    std::vector<int> free_slots;
+    for (int slot = 0; slot < (int)occupants_.size(); slot++) {
+        int router = occupants_[slot];
+        if (router == -1 || (router >= 0 && problem_.relocatable[router])) {
+            free_slots.push_back(slot);
+            occupants_[slot] = -1;
+        }
+    }
+
+    vtr::shuffle(free_slots.begin(), free_slots.end(), rng_);
+
+    size_t ifree = 0;
+    for (int router = 0; router < (int)router_slots_.size(); router++) {
+        if (problem_.relocatable[router]) {
+            router_slots_[router] = free_slots[ifree++];
+            occupants_[router_slots_[router]] = router;
+        }
+    }
+
+    route_all_flows();
+}
+
+void NocRouterAnnealer::route_all_flows() {
+    std::fill(link_usages_.begin(), link_usages_.end(), 0.);
+    cost_terms_ = NocCostTerms();
 
-    // At most, two routers are swapped
-    t_pl_blocks_to_be_moved blocks_affected(2);
+    for (NocTrafficFlowId flow_id : traffic_flows_.get_all_traffic_flow_id()) {
+        route_flow(flow_id);
+        update_link_usages(flow_id, 1.);
 
+        const TrafficFlowPlaceCost& flow_cost = flow_costs_[flow_id];
+        cost_terms_ += NocCostTerms(flow_cost.aggregate_bandwidth, flow_cost.latency, flow_cost.latency_overrun, 0.);
+    }
+
+    for (const NocLink& link : noc_model_.get_noc_links()) {
+        cost_terms_.congestion += link_congestion_cost(link.get_link_id(), link_usages_[link.get_link_id()]);
+    }
+
+    moved_link_prev_usages_.clear();
+}
+
+void NocRouterAnnealer::route_flow(NocTrafficFlowId flow_id) {
+    const t_noc_traffic_flow& traffic_flow = traffic_flows_.get_single_noc_traffic_flow(flow_id);
+
+    // the physical routers where the logical routers of the traffic flow are placed
+    int source_router = problem_.router_index[traffic_flow.source_router_cluster_id];
+    int sink_router = problem_.router_index[traffic_flow.sink_router_cluster_id];
+    VTR_ASSERT_SAFE(source_router >= 0 && sink_router >= 0);
+    NocRouterId source_phy_router = problem_.slots[router_slots_[source_router]].phy_router;
+    NocRouterId sink_phy_router = problem_.slots[router_slots_[sink_router]].phy_router;
+
+    std::vector<NocLinkId>& route = flow_routes_[flow_id];
+    routing_->route_flow_cached(source_phy_router, sink_phy_router, flow_id, route, noc_model_);
+
+    TrafficFlowPlaceCost& flow_cost = flow_costs_[flow_id];
+    flow_cost.aggregate_bandwidth = calculate_traffic_flow_aggregate_bandwidth_cost(route, traffic_flow);
+    std::tie(flow_cost.latency, flow_cost.latency_overrun) = calculate_traffic_flow_latency_cost(route, noc_model_, traffic_flow);
+}
+
+bool NocRouterAnnealer::is_legal(int router, int slot) const {
+    return problem_.regions[router] == nullptr || problem_.regions[router]->is_loc_in_part_reg(problem_.slots[slot].loc);
+}
+
+void NocRouterAnnealer::move_router(int router, int slot) {
+    moved_routers_.emplace_back(router, router_slots_[router]);
+    router_slots_[router] = slot;
+    occupants_[slot] = router;
+}
+
+bool NocRouterAnnealer::propose_move(float r_lim) {
+    moved_routers_.clear();
+
+    // Randomly select a movable router
+    int from_router = rng_.irand((int)problem_.routers.size() - 1);
+    if (!problem_.movable[from_router]) {
+        return false;
+    }
+    const int from_slot = router_slots_[from_router];
+    const t_noc_anneal_problem::t_slot& from = problem_.slots[from_slot];
+
+    // Randomly select a slot of a physical router within the range limit, on the same layer
+    const int r = std::max((int)r_lim, 1);
+    const int to_x = from.x + rng_.irand(2 * r) - r;
+    const int to_y = from.y + rng_.irand(2 * r) - r;
+    if (to_x < 0 || to_x >= problem_.num_x || to_y < 0 || to_y >= problem_.num_y) {
+        return false;
+    }
+    const std::vector<int>& to_slots = problem_.slots_at[(from.loc.layer * problem_.num_x + to_x) * problem_.num_y + to_y];
+    if (to_slots.empty()) {
+        return false;
+    }
+    const int to_slot = to_slots[rng_.irand((int)to_slots.size() - 1)];
+
+    // The router at the selected slot (if any) is swapped with the moved one
+    const int to_router = occupants_[to_slot];
+    if (to_slot == from_slot || to_router == -2 || !is_legal(from_router, to_slot)) {
+        return false;
+    }
+    if (to_router >= 0 && (!problem_.movable[to_router] || !is_legal(to_router, from_slot))) {
+        return false;
+    }
+
+    occupants_[from_slot] = -1;
+    move_router(from_router, to_slot);
+    if (to_router >= 0) {
+        move_router(to_router, from_slot);
+    }
+
+    return true;
+}
+
+void NocRouterAnnealer::update_link_usages(NocTrafficFlowId flow_id, double sign) {
+    const double bandwidth = traffic_flows_.get_single_noc_traffic_flow(flow_id).traffic_flow_bandwidth;
+
+    for (NocLinkId link_id : flow_routes_[flow_id]) {
+        // remember the usage of each link before the move, to compute the congestion delta and to revert the move
+        if (link_stamps_[link_id] != move_stamp_) {
+            link_stamps_[link_id] = move_stamp_;
+            moved_link_prev_usages_.emplace_back(link_id, link_usages_[link_id]);
+        }
+        link_usages_[link_id] += sign * bandwidth;
+    }
+}
+
+double NocRouterAnnealer::link_congestion_cost(NocLinkId link_id, double usage) const {
+    const double bandwidth = noc_model_.get_single_noc_link(link_id).get_bandwidth();
+    return std::max(usage - bandwidth, 0.) / bandwidth;
+}
+
+NocCostTerms NocRouterAnnealer::reroute_moved_flows() {
+    move_stamp_++;
+    moved_flows_.clear();
+    moved_flow_prev_routes_.clear();
+    moved_flow_prev_costs_.clear();
+    moved_link_prev_usages_.clear();
+
+    NocCostTerms delta_cost_terms;
+
+    for (const auto& [router, prev_slot] : moved_routers_) {
+        for (NocTrafficFlowId flow_id : traffic_flows_.get_traffic_flows_associated_to_router_block(problem_.routers[router])) {
+            // a traffic flow between two moved routers is only re-routed once
+            if (flow_stamps_[flow_id] == move_stamp_) {
+                continue;
+            }
+            flow_stamps_[flow_id] = move_stamp_;
+
+            moved_flows_.push_back(flow_id);
+            moved_flow_prev_routes_.push_back(flow_routes_[flow_id]);
+            moved_flow_prev_costs_.push_back(flow_costs_[flow_id]);
+
+            update_link_usages(flow_id, -1.);
+            route_flow(flow_id);
+            update_link_usages(flow_id, 1.);
+
+            const TrafficFlowPlaceCost& prev_cost = moved_flow_prev_costs_.back();
+            const TrafficFlowPlaceCost& new_cost = flow_costs_[flow_id];
+            delta_cost_terms.aggregate_bandwidth += new_cost.aggregate_bandwidth - prev_cost.aggregate_bandwidth;
+            delta_cost_terms.latency += new_cost.latency - prev_cost.latency;
+            delta_cost_terms.latency_overrun += new_cost.latency_overrun - prev_cost.latency_overrun;
+        }
+    }
+
+    for (const auto& [link_id, prev_usage] : moved_link_prev_usages_) {
+        delta_cost_terms.congestion += link_congestion_cost(link_id, link_usages_[link_id]) - link_congestion_cost(link_id, prev_usage);
+    }
+
+    return delta_cost_terms;
+}
+
+void NocRouterAnnealer::revert_move() {
+    for (const auto& [link_id, prev_usage] : moved_link_prev_usages_) {
+        link_usages_[link_id] = prev_usage;
+    }
+
+    for (size_t i = 0; i < moved_flows_.size(); i++) {
+        std::swap(flow_routes_[moved_flows_[i]], moved_flow_prev_routes_[i]);
+        flow_costs_[moved_flows_[i]] = moved_flow_prev_costs_[i];
+    }
+
+    // vacate all the destination slots first, as a swapped router moves to the other's previous slot
+    for (const auto& [router, prev_slot] : moved_routers_) {
+        occupants_[router_slots_[router]] = -1;
+    }
+    for (const auto& [router, prev_slot] : moved_routers_) {
+        router_slots_[router] = prev_slot;
+        occupants_[prev_slot] = router;
+    }
+}
+
+bool NocRouterAnnealer::accept_move(double delta_cost, double prob) {
+    if (delta_cost <= 0.0) {
+        return true;
+    }
+
+    if (prob == 0.0) {
+        return false;
+    }
+
+    return rng_.frand() < prob;
+}
+
+void NocRouterAnnealer::anneal() {
     // Total number of moves grows linearly with the number of logical NoC routers.
     // The constant factor was selected experimentally by running the algorithm on
     // synthetic benchmarks. NoC-related metrics did not improve after increasing
     // the constant factor above 35000.
-    // Get all the router clusters and figure out how many of them exist
-    const int num_router_clusters = noc_ctx.noc_traffic_flows_storage.get_router_clusters_in_netlist().size();
+    const int num_router_clusters = problem_.routers.size();
     const int N_MOVES_PER_ROUTER = 50000;
     const int N_MOVES = num_router_clusters * N_MOVES_PER_ROUTER;
 
     const double starting_prob = 0.5;
     const double prob_step = starting_prob / N_MOVES;
 
-    // The checkpoint stored the placement with the lowest cost.
-    NoCPlacementCheckpoint checkpoint;
+    double current_cost = cost(cost_terms_);
+    best_cost_ = current_cost;
+    best_slots_ = router_slots_;
 
     /* Algorithm overview:
      * In each iteration, one logical NoC router and a physical NoC router are selected randomly.
@@ -251,50 +657,90 @@ static void noc_routers_anneal(const t_noc_opts& noc_opts,
      * If not, the selected logical NoC router is moved to the vacant physical router.
      * Then, the cost difference of this swap is computed. If the swap reduces the cost,
      * it is always accepted. Swaps that increase the cost are accepted with a
-     * gradually decreasing probability. The placement with the lowest cost is saved
-     * as a checkpoint. When the annealing is over, if the checkpoint has a better
-     * cost than the current placement, the checkpoint is restored.
+     * gradually decreasing probability. The placement with the lowest cost is saved.
      * Range limit and the probability of accepting swaps with positive delta cost
      * decrease linearly as more swaps are evaluated. Late in the annealing,
      * NoC routers are swapped only with their neighbors as the range limit approaches 1.
      */
-
-    // Generate and evaluate router moves
     for (int i_move = 0; i_move < N_MOVES; i_move++) {
-        blocks_affected.clear_move_blocks();
         // Shrink the range limit over time
-        float r_lim_decayed = 1.0f + (N_MOVES - i_move) * (max_r_lim / N_MOVES);
-        e_create_move create_move_outcome = propose_router_swap(blocks_affected, r_lim_decayed, blk_loc_registry);
-
-        if (create_move_outcome != e_create_move::ABORT) {
-            apply_move_blocks(blocks_affected, blk_loc_registry);
-
-            NocCostTerms noc_delta_c;
-            find_affected_noc_routers_and_update_noc_costs(blocks_affected, noc_delta_c, block_locs);
-            double delta_cost = calculate_noc_cost(noc_delta_c, costs.noc_cost_norm_factors, noc_opts);
-
-            double prob = starting_prob - i_move * prob_step;
-            bool move_accepted = accept_noc_swap(delta_cost, prob);
-
-            if (move_accepted) {
-                costs.cost += delta_cost;
-                commit_move_blocks(blocks_affected, blk_loc_registry.mutable_grid_blocks());
-                commit_noc_costs();
-                costs += noc_delta_c;
-                // check if the current placement is better than the stored checkpoint
-                if (costs.cost < checkpoint.get_cost() || !checkpoint.is_valid()) {
-                    checkpoint.save_checkpoint(costs.cost, block_locs);
-                }
-            } else { // The proposed move is rejected
-                revert_move_blocks(blocks_affected, blk_loc_registry);
-                revert_noc_traffic_flow_routes(blocks_affected, block_locs);
+        float r_lim_decayed = 1.0f + (N_MOVES - i_move) * (problem_.max_r_lim / N_MOVES);
+        if (!propose_move(r_lim_decayed)) {
+            continue;
+        }
+
+        NocCostTerms delta_cost_terms = reroute_moved_flows();
+        double delta_cost = cost(delta_cost_terms);
+
+        double prob = starting_prob - i_move * prob_step;
+        if (accept_move(delta_cost, prob)) {
+            cost_terms_ += delta_cost_terms;
+            current_cost += delta_cost;
+            // check if the current placement is better than the best one seen
+            if (current_cost < best_cost_) {
+                best_cost_ = current_cost;
+                best_slots_ = router_slots_;
             }
+        } else { // The proposed move is rejected
+            revert_move();
         }
     }
+}
 
-    if (checkpoint.get_cost() < costs.cost) {
-        checkpoint.restore_checkpoint(costs, blk_loc_registry);
+static void noc_routers_anneal(const t_noc_opts& noc_opts,
+                               int seed,
+                               BlkLocRegistry& blk_loc_registry) {
+    t_noc_anneal_problem problem = build_noc_anneal_problem(blk_loc_registry);
+
+    // Each run draws from its own random number stream, so the result doesn't depend on how the runs are scheduled
+    const size_t num_runs = std::max(noc_opts.noc_initial_placement_restarts, 1);
+    std::vector<NocRouterAnnealer> annealers;
+    annealers.reserve(num_runs);
+    for (size_t run = 0; run < num_runs; run++) {
+        annealers.emplace_back(problem, noc_opts, vtr::RandomNumberGenerator::worker_stream(seed, run));
     }
+
+    // All runs are normalized by the costs of the current placement, so that their costs can be compared
+    t_placer_costs costs;
+    costs.noc_cost_terms = annealers[0].cost_terms();
+    update_noc_normalization_factors(costs);
+    problem.norm_factors = costs.noc_cost_norm_factors;
+
+    auto anneal_run = [&](size_t run) {
+        if (run > 0) {
+            annealers[run].place_randomly();
+        }
+        annealers[run].anneal();
+    };
+#ifdef VPR_USE_TBB
+    tbb::parallel_for(size_t(0), num_runs, anneal_run);
+#else
+    for (size_t run = 0; run < num_runs; run++) {
+        anneal_run(run);
+    }
+#endif
+
+    size_t best_run = 0;
+    for (size_t run = 1; run < num_runs; run++) {
+        if (annealers[run].best_cost() < annealers[best_run].best_cost()) {
+            best_run = run;
+        }
+    }
+    if (num_runs > 1) {
+        VTR_LOG("Best initial NoC placement found by run %zu of %zu (NoC cost %g)\n",
+                best_run + 1, num_runs, annealers[best_run].best_cost());
+    }
+
+    // Place the routers at their best locations
+    const std::vector<int>& best_slots = annealers[best_run].best_slots();
+    vtr::vector_map<ClusterBlockId, t_block_loc> best_block_locs = blk_loc_registry.block_locs();
+    for (size_t router = 0; router < problem.routers.size(); router++) {
+        best_block_locs[problem.routers[router]].loc = problem.slots[best_slots[router]].loc;
+    }
+
+    NoCPlacementCheckpoint checkpoint;
+    checkpoint.save_checkpoint(annealers[best_run].best_cost(), best_block_locs);
+    checkpoint.restore_checkpoint(costs, blk_loc_registry);
 }
 
 void initial_noc_placement(const t_noc_opts& noc_opts,
@@ -330,7 +776,7 @@ void initial_noc_placement(const t_noc_opts& noc_opts,
     initial_noc_routing({}, block_locs);
 
     // Run the simulated annealing optimizer for NoC routers
-    noc_routers_anneal(noc_opts, blk_loc_registry);
+    noc_routers_anneal(noc_opts, placer_opts.seed, blk_loc_registry);
 
     // check if there is any cycles
     bool has_cycle = noc_routing_has_cycle(block_locs);
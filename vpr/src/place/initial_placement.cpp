@@ -776,6 +776,15 @@ bool try_place_macro_exhaustively(const t_pl_macro& pl_macro,
 
                 VTR_ASSERT(y_range >= 0);
 
+                //Skip the columns which are already full (common on highly utilized devices)
+                if (y_range > 0) {
+                    const auto grid_min_loc = compressed_block_grid.compressed_loc_to_grid_loc({cx, y_lower_iter->first, layer_num});
+                    const int grid_max_y = compressed_block_grid.compressed_loc_to_grid_loc({cx, (y_upper_iter - 1)->first, layer_num}).y;
+                    if (grid_blocks.num_empty_sub_tiles_in_column(layer_num, grid_min_loc.x, grid_min_loc.y, grid_max_y) == 0) {
+                        continue;
+                    }
+                }
+
                 for (int dy = 0; dy < y_range && !placed; dy++) {
                     int cy = (y_lower_iter + dy)->first;
 
@@ -28,12 +28,32 @@ struct MoveOutcomeStats {
  * blk_type_moves: the block type index of each proposed move (e.g. [0..NUM_PL_MOVE_TYPES][agent_available_types.size()-1)])
  * accepted_moves: the number of accepted moves of each move and block type (e.g. [0..NUM_PL_MOVE_TYPES][agent_available_types.size()-1)] )
  * rejected_moves: the number of rejected moves of each move and block type (e.g. [0..NUM_PL_MOVE_TYPES][agent_available_types.size()-1)] )
+ * eval_time_ns: the total time (in nanoseconds) spent proposing and evaluating the moves of each move type
+ * timed_moves: the number of moves of each move type timed in eval_time_ns
  *
  */
 struct MoveTypeStat {
     vtr::NdMatrix<int, 2> blk_type_moves;
     vtr::NdMatrix<int, 2> accepted_moves;
     vtr::NdMatrix<int, 2> rejected_moves;
+    vtr::vector<e_move_type, int64_t> eval_time_ns;
+    vtr::vector<e_move_type, int> timed_moves;
+
+    ///@brief Records the time taken to propose and evaluate a move (manual moves are not recorded)
+    void add_eval_time(e_move_type move_type, int64_t time_ns) {
+        if (size_t(move_type) < eval_time_ns.size()) {
+            eval_time_ns[move_type] += time_ns;
+            ++timed_moves[move_type];
+        }
+    }
+
+    ///@brief Returns the average time (in microseconds) to propose and evaluate a move of move_type, 0 if none was timed
+    double avg_eval_time_us(e_move_type move_type) const {
+        if (size_t(move_type) >= timed_moves.size() || timed_moves[move_type] == 0) {
+            return 0.;
+        }
+        return 1e-3 * eval_time_ns[move_type] / timed_moves[move_type];
+    }
 };
 
 /**
@@ -81,6 +101,18 @@ class MoveGenerator {
      */
     virtual void process_outcome(double /*reward*/, e_reward_function /*reward_fun*/) {}
 
+    /**
+     * @brief Returns what the move generator learned from the outcomes of its moves so far
+     *        (e.g. the RL agent's estimated action values), to save it in an anneal checkpoint
+     */
+    virtual std::vector<double> learned_state() const { return {}; }
+
+    /**
+     * @brief Restores a state returned by learned_state() of a move generator built with the same options
+     * @return False if the state does not match this move generator
+     */
+    virtual bool restore_learned_state(const std::vector<double>& state) { return state.empty(); }
+
   protected:
     std::reference_wrapper<PlacerState> placer_state_;
 };
@@ -165,3 +165,10 @@ void t_pl_blocks_to_be_moved::clear_move_blocks() {
 
     affected_pins.clear();
 }
+
+void t_pl_blocks_to_be_moved::swap(t_pl_blocks_to_be_moved& other) {
+    std::swap(moved_blocks, other.moved_blocks);
+    std::swap(moved_from, other.moved_from);
+    std::swap(moved_to, other.moved_to);
+    std::swap(affected_pins, other.affected_pins);
+}
@@ -59,6 +59,11 @@ struct t_pl_blocks_to_be_moved {
  */
     void clear_move_blocks();
 
+/**
+ * @brief Exchanges the proposed moves (and buffers) of this struct and other.
+ */
+    void swap(t_pl_blocks_to_be_moved& other);
+
 
     e_block_move_result record_block_move(ClusterBlockId blk,
                                           t_pl_loc to,
@@ -19,6 +19,10 @@ bool f_placer_breakpoint_reached = false;
 //Records counts of reasons for aborted moves
 static std::map<std::string, size_t, std::less<>> f_move_abort_reasons;
 
+static bool is_legal_macro_move(const int imacro,
+                                t_pl_offset swap_offset,
+                                const BlkLocRegistry& blk_loc_registry);
+
 void log_move_abort(std::string_view reason) {
     auto it = f_move_abort_reasons.find(reason);
     if (it != f_move_abort_reasons.end()) {
@@ -188,6 +192,13 @@ e_block_move_result record_macro_swaps(t_pl_blocks_to_be_moved& blocks_affected,
 
     e_block_move_result outcome = e_block_move_result::VALID;
 
+    //Make sure that the swap_to locations of all the macro members are valid, so that the members don't need
+    //to be checked one by one below
+    if (!is_legal_macro_move(imacro_from, swap_offset, blk_loc_registry)) {
+        log_move_abort("macro_from swap to location illegal");
+        return e_block_move_result::ABORT;
+    }
+
     for (; imember_from < int(pl_macros[imacro_from].members.size()) && outcome == e_block_move_result::VALID; imember_from++) {
         // Gets the new from and to info for every block in the macro
         // cannot use the old from and to info
@@ -197,39 +208,27 @@ e_block_move_result record_macro_swaps(t_pl_blocks_to_be_moved& blocks_affected,
 
         t_pl_loc curr_to = curr_from + swap_offset;
 
-        //Make sure that the swap_to location is valid
-        //It must be:
-        // * on chip, and
-        // * match the correct block type
-        //
-        //Note that we need to explicitly check that the types match, since the device floorplan is not
-        //(necessarily) translationally invariant for an arbitrary macro
-        if (!is_legal_swap_to_location(curr_b_from, curr_to, blk_loc_registry)) {
-            log_move_abort("macro_from swap to location illegal");
-            outcome = e_block_move_result::ABORT;
-        } else {
-            ClusterBlockId b_to = grid_blocks.block_at_location(curr_to);
-            int imacro_to = -1;
-            get_imacro_from_iblk(&imacro_to, b_to, pl_macros);
-
-            if (imacro_to != -1) {
-                //To block is a macro
-
-                if (imacro_from == imacro_to) {
-                    outcome = record_macro_self_swaps(blocks_affected, imacro_from, swap_offset, blk_loc_registry);
-                    imember_from = pl_macros[imacro_from].members.size();
-                    break; //record_macro_self_swaps() handles this case completely, so we don't need to continue the loop
-                } else {
-                    outcome = record_macro_macro_swaps(blocks_affected, imacro_from, imember_from, imacro_to, b_to, swap_offset, blk_loc_registry);
-                    if (outcome == e_block_move_result::INVERT_VALID) {
-                        break; //The move was inverted and successfully proposed, don't need to continue the loop
-                    }
-                    imember_from -= 1; //record_macro_macro_swaps() will have already advanced the original imember_from
-                }
+        ClusterBlockId b_to = grid_blocks.block_at_location(curr_to);
+        int imacro_to = -1;
+        get_imacro_from_iblk(&imacro_to, b_to, pl_macros);
+
+        if (imacro_to != -1) {
+            //To block is a macro
+
+            if (imacro_from == imacro_to) {
+                outcome = record_macro_self_swaps(blocks_affected, imacro_from, swap_offset, blk_loc_registry);
+                imember_from = pl_macros[imacro_from].members.size();
+                break; //record_macro_self_swaps() handles this case completely, so we don't need to continue the loop
             } else {
-                //To block is not a macro
-                outcome = record_single_block_swap(blocks_affected, curr_b_from, curr_to, blk_loc_registry);
+                outcome = record_macro_macro_swaps(blocks_affected, imacro_from, imember_from, imacro_to, b_to, swap_offset, blk_loc_registry);
+                if (outcome == e_block_move_result::INVERT_VALID) {
+                    break; //The move was inverted and successfully proposed, don't need to continue the loop
+                }
+                imember_from -= 1; //record_macro_macro_swaps() will have already advanced the original imember_from
             }
+        } else {
+            //To block is not a macro
+            outcome = record_single_block_swap(blocks_affected, curr_b_from, curr_to, blk_loc_registry);
         }
     } // Finish going through all the blocks in the macro
     return outcome;
@@ -276,6 +275,12 @@ e_block_move_result record_macro_macro_swaps(t_pl_blocks_to_be_moved& blocks_aff
     ClusterBlockId blk_from = pl_macros[imacro_from].members[imember_from].blk_index;
     VTR_ASSERT_SAFE(block_locs[blk_from].loc + swap_offset == block_locs[blk_to].loc);
 
+    //The whole 'to' macro moves by -swap_offset (either swapping with the 'from' macro below, or past its end).
+    //The 'from' macro members' new locations were already checked by record_macro_swaps().
+    if (!is_legal_macro_move(imacro_to, -swap_offset, blk_loc_registry)) {
+        return e_block_move_result::ABORT;
+    }
+
     //Continue walking along the overlapping parts of the from and to macros, recording
     //each block swap.
     //
@@ -303,22 +308,7 @@ e_block_move_result record_macro_macro_swaps(t_pl_blocks_to_be_moved& blocks_aff
         ClusterBlockId b_from = pl_macros[imacro_from].members[imember_from].blk_index;
 
         t_pl_loc curr_to = block_locs[b_from].loc + swap_offset;
-        t_pl_loc curr_from = block_locs[b_from].loc;
-
-        ClusterBlockId b_to = pl_macros[imacro_to].members[imember_to].blk_index;
-        VTR_ASSERT_SAFE(curr_to == block_locs[b_to].loc);
-
-        // Check whether block to is compatible with from location
-        if (b_to != ClusterBlockId::INVALID()) {
-            if (!(is_legal_swap_to_location(b_to, curr_from, blk_loc_registry))) {
-                return e_block_move_result::ABORT;
-            }
-        }
-
-        if (!is_legal_swap_to_location(b_from, curr_to, blk_loc_registry)) {
-            log_move_abort("macro_from swap to location illegal");
-            return e_block_move_result::ABORT;
-        }
+        VTR_ASSERT_SAFE(curr_to == block_locs[pl_macros[imacro_to].members[imember_to].blk_index].loc);
 
         auto outcome = record_single_block_swap(blocks_affected, b_from, curr_to, blk_loc_registry);
         if (outcome != e_block_move_result::VALID) {
@@ -352,16 +342,16 @@ e_block_move_result record_macro_move(t_pl_blocks_to_be_moved& blocks_affected,
     const auto& block_locs = blk_loc_registry.block_locs();
     const GridBlock& grid_blocks = blk_loc_registry.grid_blocks();
 
+    if (!is_legal_macro_move(imacro, swap_offset, blk_loc_registry)) {
+        log_move_abort("macro move to location illegal");
+        return e_block_move_result::ABORT;
+    }
+
     for (const t_pl_macro_member& member : pl_macros[imacro].members) {
         t_pl_loc from = block_locs[member.blk_index].loc;
 
         t_pl_loc to = from + swap_offset;
 
-        if (!is_legal_swap_to_location(member.blk_index, to, blk_loc_registry)) {
-            log_move_abort("macro move to location illegal");
-            return e_block_move_result::ABORT;
-        }
-
         ClusterBlockId blk_to = grid_blocks.block_at_location(to);
 
         blocks_affected.record_block_move(member.blk_index, to, blk_loc_registry);
@@ -388,17 +378,17 @@ e_block_move_result identify_macro_self_swap_affected_macros(std::vector<int>& m
 
     e_block_move_result outcome = e_block_move_result::VALID;
 
+    if (!is_legal_macro_move(imacro, swap_offset, blk_loc_registry)) {
+        log_move_abort("macro move to location illegal");
+        return e_block_move_result::ABORT;
+    }
+
     for (size_t imember = 0; imember < pl_macros[imacro].members.size() && outcome == e_block_move_result::VALID; ++imember) {
         ClusterBlockId blk = pl_macros[imacro].members[imember].blk_index;
 
         t_pl_loc from = block_locs[blk].loc;
         t_pl_loc to = from + swap_offset;
 
-        if (!is_legal_swap_to_location(blk, to, blk_loc_registry)) {
-            log_move_abort("macro move to location illegal");
-            return e_block_move_result::ABORT;
-        }
-
         ClusterBlockId blk_to = grid_blocks.block_at_location(to);
 
         int imacro_to = -1;
@@ -474,6 +464,27 @@ e_block_move_result record_macro_self_swaps(t_pl_blocks_to_be_moved& blocks_affe
     return outcome;
 }
 
+//Returns true if each member of macro imacro can be moved by swap_offset (see is_legal_swap_to_location()),
+//in a single look-up of the macro footprints once they are initialized
+static bool is_legal_macro_move(const int imacro,
+                                t_pl_offset swap_offset,
+                                const BlkLocRegistry& blk_loc_registry) {
+    const auto& place_ctx = g_vpr_ctx.placement();
+    const t_pl_macro& pl_macro = place_ctx.pl_macros[imacro];
+    const auto& block_locs = blk_loc_registry.block_locs();
+
+    if (place_ctx.macro_footprints.is_initialized()) {
+        return place_ctx.macro_footprints.is_legal_head_loc(imacro, block_locs[pl_macro.members[0].blk_index].loc + swap_offset);
+    }
+
+    for (const t_pl_macro_member& member : pl_macro.members) {
+        if (!is_legal_swap_to_location(member.blk_index, block_locs[member.blk_index].loc + swap_offset, blk_loc_registry)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool is_legal_swap_to_location(ClusterBlockId blk,
                                t_pl_loc to,
                                const BlkLocRegistry& blk_loc_registry) {
@@ -1032,7 +1043,7 @@ int find_empty_compatible_subtile(t_logical_block_type_ptr type,
     compressed_grid_to_loc(type, to_loc, to_uncompressed_loc);
     const t_physical_tile_loc to_phy_uncompressed_loc{to_uncompressed_loc.x, to_uncompressed_loc.y, to_uncompressed_loc.layer};
     const t_physical_tile_type_ptr phy_type = device_ctx.grid.get_physical_type(to_phy_uncompressed_loc);
-    const auto& compatible_sub_tiles = compressed_block_grid.compatible_sub_tiles_for_tile.at(phy_type->index);
+    const auto& compatible_sub_tiles = compressed_block_grid.compatible_sub_tile_num(phy_type->index);
 
     for (const int sub_tile : compatible_sub_tiles) {
         if (grid_blocks.is_sub_tile_empty(to_phy_uncompressed_loc, sub_tile)) {
@@ -1084,15 +1095,16 @@ bool find_compatible_compressed_loc_in_range(t_logical_block_type_ptr type,
         //We are careful here to consider that there may be a sparse
         //set of candidate blocks in the y-axis at this x location.
         //
-        //The candidates are stored in a flat_map so we can efficiently find the set of valid
-        //candidates with upper/lower bound.
+        //The candidates are stored in a flat_map sorted by y, and the compressed grid
+        //gives the positions of the valid candidates within it in O(1).
         const auto& block_rows = compressed_block_grid.get_column_block_map(to_loc.x, to_layer_num);
-        auto y_lower_iter = block_rows.lower_bound(search_range.ymin);
+        const auto y_block_range = compressed_block_grid.get_column_block_range(to_loc.x, search_range.ymin, search_range.ymax, to_layer_num);
+        auto y_lower_iter = block_rows.begin() + y_block_range.first;
         if (y_lower_iter == block_rows.end()) {
             continue;
         }
 
-        auto y_upper_iter = block_rows.upper_bound(search_range.ymax);
+        auto y_upper_iter = block_rows.begin() + y_block_range.second;
 
         if (y_lower_iter->first > search_range.ymin) {
             //No valid blocks at this x location which are within rlim_y
@@ -1112,6 +1124,16 @@ bool find_compatible_compressed_loc_in_range(t_logical_block_type_ptr type,
         int y_range = std::distance(y_lower_iter, y_upper_iter);
         VTR_ASSERT(y_range >= 0);
 
+        if (search_for_empty && y_range > 0) {
+            //Don't probe the candidates one by one if none of the tiles of this column
+            //within the y range has an empty sub tile
+            const auto grid_min_loc = compressed_block_grid.compressed_loc_to_grid_loc({to_loc.x, y_lower_iter->first, to_layer_num});
+            const int grid_max_y = compressed_block_grid.compressed_loc_to_grid_loc({to_loc.x, (y_upper_iter - 1)->first, to_layer_num}).y;
+            if (blk_loc_registry.grid_blocks().num_empty_sub_tiles_in_column(to_layer_num, grid_min_loc.x, grid_min_loc.y, grid_max_y) == 0) {
+                continue;
+            }
+        }
+
         //At this point we know y_lower_iter and y_upper_iter
         //bound the range of valid blocks at this x-location, which
         //are within rlim_y
@@ -21,6 +21,12 @@
  * and these two numbers are the indices to access this 2D array. By default, the placement delay model is created by iterating over the router lookahead
  * to get the minimum cost for each dx and dy.
  *
+ * Optionally (--place_congestion_weight), the routing congestion is estimated by a RUDY map of the routing demand of the nets
+ * (see routing_demand_map.h), which is kept up to date from the bounding boxes of the nets affected by each committed move. The
+ * congestion cost of a net is its wirelength weighted by how much the estimated channel utilization of its bounding box exceeds
+ * a threshold. The utilization is only refreshed from the demand at each temperature (like the criticalities of the timing cost),
+ * so the congestion cost of a move only depends on the bounding boxes of its affected nets.
+ *
  * @date July 12, 2024
  */
 #include "net_cost_handler.h"
@@ -34,9 +40,14 @@
 #include "noc_place_utils.h"
 #include "vtr_math.h"
 
+#include <algorithm>
 #include <optional>
 #include <functional>
 
+#ifdef VPR_USE_TBB
+#    include <tbb/parallel_for_each.h>
+#endif
+
 using std::max;
 using std::min;
 
@@ -50,6 +61,20 @@ enum class NetUpdateState {
     GOT_FROM_SCRATCH
 };
 
+/**
+ * @brief The configuration the incremental cost evaluation of a move (find_affected_nets_and_update_costs()) is
+ * compiled for: the type of bounding box, whether the device has more than one layer, and whether the placement
+ * is timing driven. The evaluation is instantiated for each configuration, and the instantiations matching the
+ * placement are chosen once by init_try_swap_net_cost_structs(), so e.g. 2D placement pays nothing for the
+ * checks of the 3D support in the per-move and per-pin loops.
+ */
+template<bool CubeBB, bool MultiLayer, bool TimingDriven>
+struct t_net_cost_features {
+    static constexpr bool cube_bb = CubeBB;
+    static constexpr bool multi_layer = MultiLayer;
+    static constexpr bool timing_driven = TimingDriven;
+};
+
 static constexpr int MAX_FANOUT_CROSSING_COUNT = 50;
 
 /**
@@ -102,6 +127,8 @@ struct PLNetCost {
     vtr::vector<ClusterNetId, double> net_cost;
     vtr::vector<ClusterNetId, double> proposed_net_cost;
     vtr::vector<ClusterNetId, NetUpdateState> bb_update_status;
+    /* Congestion cost of each net, only used when the routing demand map is initialized */
+    vtr::vector<ClusterNetId, double> net_congestion_cost;
 };
 
 /* The following arrays are used by the try_swap function for speed.   */
@@ -127,6 +154,26 @@ struct TSInfo {
     // TSInfo(TSInfo&&) = delete;
 };
 
+/**
+ * @brief Structure-of-arrays copy of the location of every net pin.
+ *
+ * The pins of a net are stored contiguously (driver first, in net pin order), so that the brute-force
+ * bounding box of a net is a min/max reduction over contiguous arrays, which the compiler vectorizes,
+ * instead of a chain of pin -> block -> location -> tile type look-ups per pin.
+ *
+ * The locations are loaded from the placement by comp_bb_cost()/comp_layer_bb_cost() and kept in sync with
+ * the moves evaluated by find_affected_nets_and_update_costs(). The previous locations of the moved pins are
+ * kept until the move is either committed (update_move_nets()) or reverted (reset_move_nets()).
+ */
+struct NetPinCoords {
+    /* [0...cluster_ctx.clb_nlist.nets().size()] -> index of the first pin of each net in the arrays below */
+    std::vector<size_t> net_begin;
+    /* [0...num_net_pins-1] -> pin location */
+    std::vector<int> x, y, layer;
+    /* [0...num_moved_pins-1] -> index and previous location of the pins moved by the proposed move */
+    std::vector<std::pair<size_t, t_physical_tile_loc>> moved_pins;
+};
+
 /**
  * @brief This class is used to hide control flows needed to distinguish 2d and 3d placement
  */
@@ -139,8 +186,12 @@ class BBUpdater {
 
   public:
     void init(size_t num_nets, bool cube_bb);
+    //The type of bounding box (and the number of layers) of the hot path are given by Features rather than m_cube_bb
+    template<typename Features>
     void get_non_updatable_bb(const ClusterNetId& net);
+    template<typename Features>
     void update_bb(ClusterNetId net_id, t_physical_tile_loc pin_old_loc, t_physical_tile_loc pin_new_loc, bool is_driver);
+    template<typename Features>
     double get_net_cost(const ClusterNetId net_id);
     void set_ts_bb_coord(const ClusterNetId net_id);
     void set_ts_edge(const ClusterNetId net_id);
@@ -151,8 +202,19 @@ static struct PLNetCost pl_net_cost;
 
 static struct TSInfo ts_info;
 
+static struct NetPinCoords net_pin_coords;
+
 static BBUpdater bb_updater;
 
+/* The routing demand of the committed bounding boxes, initialized only if the placement cost includes the congestion cost */
+static RoutingDemandMap routing_demand_map;
+
+/* The utilization above which the congestion cost of routing_demand_map counts a channel as congested */
+static float congestion_util_threshold = 1.;
+
+/* Congestion costs below this (in tracks) are only round off of the utilization prefix sums, and aren't checked */
+static constexpr double MIN_EXPECTED_CONGESTION_COST = 1.e-3;
+
 static std::optional<std::reference_wrapper<PlacerState>> placer_state_ref;
 
 void set_net_handlers_placer_state(PlacerState& placer_state) {
@@ -175,6 +237,7 @@ static bool driven_by_moved_block(const ClusterNetId net,
  * @param blk_pin
  * @param pl_moved_block
  */
+template<typename Features>
 static void update_net_bb(const ClusterNetId net,
                           const ClusterBlockId blk,
                           const ClusterPinId blk_pin,
@@ -209,7 +272,6 @@ static void record_affected_net(const ClusterNetId net);
 /**
  * @brief Call suitable function based on the bounding box type to update the bounding box of the net connected to pin_id. Also,
  * call the function to update timing information if the placement algorithm is timing-driven.
- * @param place_algorithm Placement algorithm
  * @param delay_model Timing delay model used by placer
  * @param criticalities Connections timing criticalities
  * @param blk_id Block ID of that the moving pin belongs to.
@@ -219,8 +281,8 @@ static void record_affected_net(const ClusterNetId net);
  * @param timing_delta_c Timing cost change based on the proposed move
  * @param is_src_moving Is the moving pin the source of a net.
  */
-static void update_net_info_on_pin_move(const t_place_algorithm& place_algorithm,
-                                        const PlaceDelayModel* delay_model,
+template<typename Features>
+static void update_net_info_on_pin_move(const PlaceDelayModel* delay_model,
                                         const PlacerCriticalities* criticalities,
                                         const ClusterBlockId blk_id,
                                         const ClusterPinId pin_id,
@@ -244,7 +306,9 @@ static void update_net_info_on_pin_move(const t_place_algorithm& place_algorithm
  * @param pin_old_loc The old location of the moving pin
  * @param pin_new_loc The new location of the moving pin
  * @param src_pin Is the moving pin driving the net
+ * @tparam MultiLayer Whether the device has more than one layer (otherwise the layer extent is left unchanged)
  */
+template<bool MultiLayer>
 static void update_bb(ClusterNetId net_id,
                       t_bb& bb_edge_new,
                       t_bb& bb_coord_new,
@@ -254,18 +318,36 @@ static void update_bb(ClusterNetId net_id,
                       bool src_pin);
 
 /**
- * @brief Calculate the 3D bounding box of "net_id" from scratch (based on the block locations stored in place_ctx) and
+ * @brief Loads the location of every net pin into net_pin_coords from the current placement.
+ */
+static void load_net_pin_coords();
+
+/**
+ * @brief Updates net_pin_coords with the new location of the pins of the moved blocks, remembering their
+ * previous location so that the move can be reverted. Assumes the move has been applied to the block locations.
+ */
+static void update_net_pin_coords(const t_pl_blocks_to_be_moved& blocks_affected);
+
+/**
+ * @brief Restores the location of the pins moved by the last update_net_pin_coords() call.
+ */
+static void revert_net_pin_coords();
+
+/**
+ * @brief Calculate the 3D bounding box of "net_id" from scratch (based on the pin locations stored in net_pin_coords) and
  * store them in bb_coord_new
  * @param net_id ID of the net for which the bounding box is requested
  * @param bb_coord_new Computed by this function and returned by reference.
  * @param num_sink_pin_layer Store the number of sink pins of "net_id" on each layer
+ * @tparam MultiLayer Whether the device has more than one layer
  */
+template<bool MultiLayer>
 static void get_non_updatable_bb(ClusterNetId net_id,
                                  t_bb& bb_coord_new,
                                  vtr::NdMatrixProxy<int, 1> num_sink_pin_layer);
 
 /**
- * @brief Calculate the per-layer bounding box of "net_id" from scratch (based on the block locations stored in place_ctx) and
+ * @brief Calculate the per-layer bounding box of "net_id" from scratch (based on the pin locations stored in net_pin_coords) and
  * store them in bb_coord_new
  * @param net_id ID of the net for which the bounding box is requested
  * @param bb_coord_new Computed by this function and returned by reference.
@@ -469,6 +551,26 @@ static double get_net_wirelength_estimate(ClusterNetId net_id, const t_bb& bb);
  */
 static double recompute_bb_cost();
 
+/**
+ * @brief Calls fn(xmin, xmax, ymin, ymax, crossing) for the bounding box of the net (one per layer with sinks for the per-layer
+ * bounding box), with the crossing count of the terminals it holds.
+ * @param net_id
+ * @param proposed True for the bounding box proposed by the move being evaluated (ts_* data structures), false for the committed one.
+ * @param fn
+ */
+template<typename Fn>
+static void for_each_net_bb_rect(ClusterNetId net_id, bool proposed, Fn&& fn);
+
+/**
+ * @brief Adds (sign = 1) or removes (sign = -1) the routing demand of the net in demand_map.
+ */
+static void add_net_routing_demand(RoutingDemandMap& demand_map, ClusterNetId net_id, bool proposed, double sign);
+
+/**
+ * @brief Returns the congestion cost of the net against the utilization of routing_demand_map.
+ */
+static double get_net_congestion_cost(ClusterNetId net_id, bool proposed);
+
 /**
  * @brief To get the wirelength cost/est, BB perimeter is multiplied by a factor to approximately correct for the half-perimeter
  * bounding box wirelength's underestimate of wiring for nets with fanout greater than 2.
@@ -481,8 +583,26 @@ static double wirelength_crossing_count(size_t fanout);
  * indicated in the blocks_affected data structure.
  * @param bb_delta_c Cost difference after and before moving the block
  */
+template<typename Features>
 static void set_bb_delta_cost(double& bb_delta_c);
 
+/**
+ * @brief find_affected_nets_and_update_costs() for the placement configuration given by Features
+ */
+template<typename Features>
+static void find_affected_nets_and_update_costs(const PlaceDelayModel* delay_model,
+                                                const PlacerCriticalities* criticalities,
+                                                t_pl_blocks_to_be_moved& blocks_affected,
+                                                double& bb_delta_c,
+                                                double& timing_delta_c);
+
+/**
+ * @brief The instantiations of find_affected_nets_and_update_costs() for the placement, chosen by
+ * init_try_swap_net_cost_structs(): [0] when the placement is not timing driven, [1] when it is
+ */
+typedef void (*t_find_affected_nets_fn)(const PlaceDelayModel*, const PlacerCriticalities*, t_pl_blocks_to_be_moved&, double&, double&);
+static t_find_affected_nets_fn find_affected_nets_fns[2] = {nullptr, nullptr};
+
 /******************************* End of Function definitions ************************************/
 namespace {
 // Initialize the ts vectors
@@ -505,9 +625,10 @@ void BBUpdater::init(size_t num_nets, bool cube_bb) {
     ts_info.ts_nets_to_update.resize(num_nets, ClusterNetId::INVALID());
 }
 
+template<typename Features>
 void BBUpdater::get_non_updatable_bb(const ClusterNetId& net) {
-    if (m_cube_bb) {
-        ::get_non_updatable_bb(net,
+    if constexpr (Features::cube_bb) {
+        ::get_non_updatable_bb<Features::multi_layer>(net,
                                ts_info.ts_bb_coord_new[net],
                                ts_info.ts_layer_sink_pin_count[size_t(net)]);
     }
@@ -518,9 +639,10 @@ void BBUpdater::get_non_updatable_bb(const ClusterNetId& net) {
     }
 }
 
+template<typename Features>
 void BBUpdater::update_bb(ClusterNetId net_id, t_physical_tile_loc pin_old_loc, t_physical_tile_loc pin_new_loc, bool is_driver) {
-    if (m_cube_bb) {
-        ::update_bb(net_id,
+    if constexpr (Features::cube_bb) {
+        ::update_bb<Features::multi_layer>(net_id,
                     ts_info.ts_bb_edge_new[net_id],
                     ts_info.ts_bb_coord_new[net_id],
                     ts_info.ts_layer_sink_pin_count[size_t(net_id)],
@@ -539,8 +661,9 @@ void BBUpdater::update_bb(ClusterNetId net_id, t_physical_tile_loc pin_old_loc,
     }
 }
 
+template<typename Features>
 double BBUpdater::get_net_cost(const ClusterNetId net_id) {
-    if (m_cube_bb) {
+    if constexpr (Features::cube_bb) {
         return ::get_net_cost(net_id, ts_info.ts_bb_coord_new[net_id]);
     }
     else {
@@ -584,6 +707,7 @@ static bool driven_by_moved_block(const ClusterNetId net,
     return is_driven_by_move_blk;
 }
 
+template<typename Features>
 static void update_net_bb(const ClusterNetId net,
                           const ClusterBlockId blk,
                           const ClusterPinId blk_pin,
@@ -596,7 +720,7 @@ static void update_net_bb(const ClusterNetId net,
         //For small nets brute-force bounding box update is faster
 
         if (pl_net_cost.bb_update_status[net] == NetUpdateState::NOT_UPDATED_YET) { //Only once per-net
-            bb_updater.get_non_updatable_bb(net);
+            bb_updater.get_non_updatable_bb<Features>(net);
         }
     } else {
         //For large nets, update bounding box incrementally
@@ -609,7 +733,7 @@ static void update_net_bb(const ClusterNetId net,
         bool is_driver = cluster_ctx.clb_nlist.pin_type(blk_pin) == PinType::DRIVER;
 
         //Incremental bounding box update
-        bb_updater.update_bb(net,
+        bb_updater.update_bb<Features>(net,
                              {pl_moved_block.old_loc.x + pin_width_offset,
                               pl_moved_block.old_loc.y + pin_height_offset,
                               pl_moved_block.old_loc.layer},
@@ -723,8 +847,8 @@ static void record_affected_net(const ClusterNetId net) {
     }
 }
 
-static void update_net_info_on_pin_move(const t_place_algorithm& place_algorithm,
-                                        const PlaceDelayModel* delay_model,
+template<typename Features>
+static void update_net_info_on_pin_move(const PlaceDelayModel* delay_model,
                                         const PlacerCriticalities* criticalities,
                                         const ClusterBlockId blk_id,
                                         const ClusterPinId pin_id,
@@ -747,9 +871,9 @@ static void update_net_info_on_pin_move(const t_place_algorithm& place_algorithm
     record_affected_net(net_id);
 
     /* Update the net bounding boxes. */
-    update_net_bb(net_id, blk_id, pin_id, moving_blk_inf);
+    update_net_bb<Features>(net_id, blk_id, pin_id, moving_blk_inf);
 
-    if (place_algorithm.is_timing_driven()) {
+    if constexpr (Features::timing_driven) {
         /* Determine the change in connection delay and timing cost. */
         update_td_delta_costs(delay_model,
                               *criticalities,
@@ -761,61 +885,127 @@ static void update_net_info_on_pin_move(const t_place_algorithm& place_algorithm
     }
 }
 
-static void get_non_updatable_bb(ClusterNetId net_id,
-                                 t_bb& bb_coord_new,
-                                 vtr::NdMatrixProxy<int, 1> num_sink_pin_layer) {
-    //TODO: account for multiple physical pin instances per logical pin
-    auto& cluster_ctx = g_vpr_ctx.clustering();
-    auto& device_ctx = g_vpr_ctx.device();
-    auto& placer_state = placer_state_ref->get();
-    auto& block_locs = placer_state.block_locs();
-
-    ClusterBlockId bnum = cluster_ctx.clb_nlist.net_driver_block(net_id);
-    int pnum = placer_state.blk_loc_registry().net_pin_to_tile_pin_index(net_id, 0);
+static void load_net_pin_coords() {
+    const auto& clb_nlist = g_vpr_ctx.clustering().clb_nlist;
+    const auto& placer_state = placer_state_ref->get();
+    const auto& block_locs = placer_state.block_locs();
 
-    t_pl_loc block_loc = block_locs[bnum].loc;
-    int x = block_loc.x + physical_tile_type(block_loc)->pin_width_offset[pnum];
-    int y = block_loc.y + physical_tile_type(block_loc)->pin_height_offset[pnum];
-    int layer = block_loc.layer;
+    net_pin_coords.net_begin.resize(clb_nlist.nets().size() + 1);
+    net_pin_coords.moved_pins.clear();
 
-    int xmin = x;
-    int ymin = y;
-    int layer_min = layer;
-    int xmax = x;
-    int ymax = y;
-    int layer_max = layer;
+    size_t num_pins = 0;
+    for (ClusterNetId net_id : clb_nlist.nets()) {
+        net_pin_coords.net_begin[size_t(net_id)] = num_pins;
+        num_pins += clb_nlist.net_pins(net_id).size();
+    }
+    net_pin_coords.net_begin.back() = num_pins;
+
+    net_pin_coords.x.resize(num_pins);
+    net_pin_coords.y.resize(num_pins);
+    net_pin_coords.layer.resize(num_pins);
+
+    /* Each net fills its own range of the arrays */
+    auto load_net = [&](ClusterNetId net_id) {
+        size_t ipin = net_pin_coords.net_begin[size_t(net_id)];
+        for (ClusterPinId pin_id : clb_nlist.net_pins(net_id)) {
+            t_pl_loc block_loc = block_locs[clb_nlist.pin_block(pin_id)].loc;
+            int pnum = placer_state.blk_loc_registry().tile_pin_index(pin_id);
+            t_physical_tile_type_ptr blk_type = physical_tile_type(block_loc);
+
+            net_pin_coords.x[ipin] = block_loc.x + blk_type->pin_width_offset[pnum];
+            net_pin_coords.y[ipin] = block_loc.y + blk_type->pin_height_offset[pnum];
+            net_pin_coords.layer[ipin] = block_loc.layer;
+            ipin++;
+        }
+    };
 
-    for (int layer_num = 0; layer_num < device_ctx.grid.get_num_layers(); layer_num++) {
-        num_sink_pin_layer[layer_num] = 0;
+#ifdef VPR_USE_TBB
+    tbb::parallel_for_each(clb_nlist.nets().begin(), clb_nlist.nets().end(), load_net);
+#else
+    for (ClusterNetId net_id : clb_nlist.nets()) {
+        load_net(net_id);
     }
+#endif
+}
 
-    for (ClusterPinId pin_id : cluster_ctx.clb_nlist.net_sinks(net_id)) {
-        bnum = cluster_ctx.clb_nlist.pin_block(pin_id);
-        block_loc = block_locs[bnum].loc;
-        pnum = placer_state.blk_loc_registry().tile_pin_index(pin_id);
-        x = block_loc.x + physical_tile_type(block_loc)->pin_width_offset[pnum];
-        y = block_loc.y + physical_tile_type(block_loc)->pin_height_offset[pnum];
-        layer = block_loc.layer;
+static void update_net_pin_coords(const t_pl_blocks_to_be_moved& blocks_affected) {
+    const auto& clb_nlist = g_vpr_ctx.clustering().clb_nlist;
+    const auto& placer_state = placer_state_ref->get();
+    const auto& block_locs = placer_state.block_locs();
 
-        if (x < xmin) {
-            xmin = x;
-        } else if (x > xmax) {
-            xmax = x;
-        }
+    VTR_ASSERT_SAFE(net_pin_coords.moved_pins.empty());
 
-        if (y < ymin) {
-            ymin = y;
-        } else if (y > ymax) {
-            ymax = y;
-        }
+    for (const t_pl_moved_block& moved_block : blocks_affected.moved_blocks) {
+        t_pl_loc block_loc = block_locs[moved_block.block_num].loc;
+        t_physical_tile_type_ptr blk_type = physical_tile_type(block_loc);
+
+        for (ClusterPinId pin_id : clb_nlist.block_pins(moved_block.block_num)) {
+            ClusterNetId net_id = clb_nlist.pin_net(pin_id);
+            size_t ipin = net_pin_coords.net_begin[size_t(net_id)] + clb_nlist.pin_net_index(pin_id);
+            int pnum = placer_state.blk_loc_registry().tile_pin_index(pin_id);
+
+            net_pin_coords.moved_pins.emplace_back(ipin, t_physical_tile_loc{net_pin_coords.x[ipin],
+                                                                             net_pin_coords.y[ipin],
+                                                                             net_pin_coords.layer[ipin]});
 
-        if (layer < layer_min) {
-            layer_min = layer;
-        } else if (layer > layer_max) {
-            layer_max = layer;
+            net_pin_coords.x[ipin] = block_loc.x + blk_type->pin_width_offset[pnum];
+            net_pin_coords.y[ipin] = block_loc.y + blk_type->pin_height_offset[pnum];
+            net_pin_coords.layer[ipin] = block_loc.layer;
         }
+    }
+}
 
-        num_sink_pin_layer[layer]++;
+static void revert_net_pin_coords() {
+    for (const auto& [ipin, old_loc] : net_pin_coords.moved_pins) {
+        net_pin_coords.x[ipin] = old_loc.x;
+        net_pin_coords.y[ipin] = old_loc.y;
+        net_pin_coords.layer[ipin] = old_loc.layer_num;
+    }
+    net_pin_coords.moved_pins.clear();
+}
+
+template<bool MultiLayer>
+static void get_non_updatable_bb(ClusterNetId net_id,
+                                 t_bb& bb_coord_new,
+                                 vtr::NdMatrixProxy<int, 1> num_sink_pin_layer) {
+    //TODO: account for multiple physical pin instances per logical pin
+    auto& device_ctx = g_vpr_ctx.device();
+
+    const size_t begin = net_pin_coords.net_begin[size_t(net_id)];
+    const size_t end = net_pin_coords.net_begin[size_t(net_id) + 1];
+    const int* x = net_pin_coords.x.data();
+    const int* y = net_pin_coords.y.data();
+    const int* layer = net_pin_coords.layer.data();
+
+    /* The driver (first pin) initializes the bounding box. The reductions below are *
+     * branch-free min/max over contiguous arrays so that they get vectorized.       */
+    int xmin = x[begin];
+    int ymin = y[begin];
+    int layer_min = layer[begin];
+    int xmax = x[begin];
+    int ymax = y[begin];
+    int layer_max = layer[begin];
+
+    for (size_t ipin = begin + 1; ipin < end; ipin++) {
+        xmin = min(xmin, x[ipin]);
+        xmax = max(xmax, x[ipin]);
+        ymin = min(ymin, y[ipin]);
+        ymax = max(ymax, y[ipin]);
+        layer_min = min(layer_min, layer[ipin]);
+        layer_max = max(layer_max, layer[ipin]);
+    }
+
+    if constexpr (!MultiLayer) {
+        num_sink_pin_layer[0] = end - begin - 1;
+    } else {
+        const int num_layers = device_ctx.grid.get_num_layers();
+        for (int layer_num = 0; layer_num < num_layers; layer_num++) {
+            int num_sinks = 0;
+            for (size_t ipin = begin + 1; ipin < end; ipin++) {
+                num_sinks += (layer[ipin] == layer_num);
+            }
+            num_sink_pin_layer[layer_num] = num_sinks;
+        }
     }
 
     /* Now I've found the coordinates of the bounding box.  There are no *
@@ -839,65 +1029,54 @@ static void get_non_updatable_layer_bb(ClusterNetId net_id,
                                        vtr::NdMatrixProxy<int, 1> num_sink_layer) {
     //TODO: account for multiple physical pin instances per logical pin
     auto& device_ctx = g_vpr_ctx.device();
-    auto& cluster_ctx = g_vpr_ctx.clustering();
-    auto& placer_state = placer_state_ref->get();
-    auto& block_locs = placer_state.block_locs();
-
-    int num_layers = device_ctx.grid.get_num_layers();
-    for (int layer_num = 0; layer_num < device_ctx.grid.get_num_layers(); layer_num++) {
-        num_sink_layer[layer_num] = 0;
-    }
-
-    ClusterBlockId bnum = cluster_ctx.clb_nlist.net_driver_block(net_id);
-    t_pl_loc block_loc = block_locs[bnum].loc;
-    int pnum = placer_state.blk_loc_registry().net_pin_to_tile_pin_index(net_id, 0);
-
-    int src_x = block_locs[bnum].loc.x + physical_tile_type(block_loc)->pin_width_offset[pnum];
-    int src_y = block_locs[bnum].loc.y + physical_tile_type(block_loc)->pin_height_offset[pnum];
-
-    std::vector<int> xmin(num_layers, src_x);
-    std::vector<int> ymin(num_layers, src_y);
-    std::vector<int> xmax(num_layers, src_x);
-    std::vector<int> ymax(num_layers, src_y);
-
-    for (ClusterPinId pin_id : cluster_ctx.clb_nlist.net_sinks(net_id)) {
-        bnum = cluster_ctx.clb_nlist.pin_block(pin_id);
-        block_loc = block_locs[bnum].loc;
-        pnum = placer_state.blk_loc_registry().tile_pin_index(pin_id);
-        int x = block_locs[bnum].loc.x + physical_tile_type(block_loc)->pin_width_offset[pnum];
-        int y = block_locs[bnum].loc.y + physical_tile_type(block_loc)->pin_height_offset[pnum];
+    const int num_layers = device_ctx.grid.get_num_layers();
 
-        int layer_num = block_locs[bnum].loc.layer;
-        num_sink_layer[layer_num]++;
-        if (x < xmin[layer_num]) {
-            xmin[layer_num] = x;
-        } else if (x > xmax[layer_num]) {
-            xmax[layer_num] = x;
-        }
+    const size_t begin = net_pin_coords.net_begin[size_t(net_id)];
+    const size_t end = net_pin_coords.net_begin[size_t(net_id) + 1];
+    const int* x = net_pin_coords.x.data();
+    const int* y = net_pin_coords.y.data();
+    const int* layer = net_pin_coords.layer.data();
 
-        if (y < ymin[layer_num]) {
-            ymin[layer_num] = y;
-        } else if (y > ymax[layer_num]) {
-            ymax[layer_num] = y;
-        }
-    }
+    const int src_x = x[begin];
+    const int src_y = y[begin];
 
-    /* Now I've found the coordinates of the bounding box.  There are no *
-     * channels beyond device_ctx.grid.width()-2 and                     *
-     * device_ctx.grid.height() - 2, so I want to clip to that.  As well,*
-     * since I'll always include the channel immediately below and the   *
-     * channel immediately to the left of the bounding box, I want to    *
-     * clip to 1 in both directions as well (since minimum channel index *
-     * is 0).  See route_common.cpp for a channel diagram.               */
     for (int layer_num = 0; layer_num < num_layers; layer_num++) {
+        /* The bounding box on each layer starts at the driver location. Sinks on other *
+         * layers are replaced by the driver location, which keeps the loop branch-free. */
+        int xmin = src_x;
+        int ymin = src_y;
+        int xmax = src_x;
+        int ymax = src_y;
+        int num_sinks = 0;
+
+        for (size_t ipin = begin + 1; ipin < end; ipin++) {
+            const bool on_layer = (layer[ipin] == layer_num);
+            const int pin_x = on_layer ? x[ipin] : src_x;
+            const int pin_y = on_layer ? y[ipin] : src_y;
+            xmin = min(xmin, pin_x);
+            xmax = max(xmax, pin_x);
+            ymin = min(ymin, pin_y);
+            ymax = max(ymax, pin_y);
+            num_sinks += on_layer;
+        }
+        num_sink_layer[layer_num] = num_sinks;
+
+        /* Now I've found the coordinates of the bounding box.  There are no *
+         * channels beyond device_ctx.grid.width()-2 and                     *
+         * device_ctx.grid.height() - 2, so I want to clip to that.  As well,*
+         * since I'll always include the channel immediately below and the   *
+         * channel immediately to the left of the bounding box, I want to    *
+         * clip to 1 in both directions as well (since minimum channel index *
+         * is 0).  See route_common.cpp for a channel diagram.               */
         bb_coord_new[layer_num].layer_num = layer_num;
-        bb_coord_new[layer_num].xmin = max(min<int>(xmin[layer_num], device_ctx.grid.width() - 2), 1);  //-2 for no perim channels
-        bb_coord_new[layer_num].ymin = max(min<int>(ymin[layer_num], device_ctx.grid.height() - 2), 1); //-2 for no perim channels
-        bb_coord_new[layer_num].xmax = max(min<int>(xmax[layer_num], device_ctx.grid.width() - 2), 1);  //-2 for no perim channels
-        bb_coord_new[layer_num].ymax = max(min<int>(ymax[layer_num], device_ctx.grid.height() - 2), 1); //-2 for no perim channels
+        bb_coord_new[layer_num].xmin = max(min<int>(xmin, device_ctx.grid.width() - 2), 1);  //-2 for no perim channels
+        bb_coord_new[layer_num].ymin = max(min<int>(ymin, device_ctx.grid.height() - 2), 1); //-2 for no perim channels
+        bb_coord_new[layer_num].xmax = max(min<int>(xmax, device_ctx.grid.width() - 2), 1);  //-2 for no perim channels
+        bb_coord_new[layer_num].ymax = max(min<int>(ymax, device_ctx.grid.height() - 2), 1); //-2 for no perim channels
     }
 }
 
+template<bool MultiLayer>
 static void update_bb(ClusterNetId net_id,
                       t_bb& bb_edge_new,
                       t_bb& bb_coord_new,
@@ -912,14 +1091,14 @@ static void update_bb(ClusterNetId net_id,
     auto& placer_state = placer_state_ref->get();
     auto& place_move_ctx = placer_state.move();
 
-    const int num_layers = device_ctx.grid.get_num_layers();
+    const int num_layers = MultiLayer ? device_ctx.grid.get_num_layers() : 1;
 
     pin_new_loc.x = max(min<int>(pin_new_loc.x, device_ctx.grid.width() - 2), 1);  //-2 for no perim channels
     pin_new_loc.y = max(min<int>(pin_new_loc.y, device_ctx.grid.height() - 2), 1); //-2 for no perim channels
-    pin_new_loc.layer_num = max(min<int>(pin_new_loc.layer_num, device_ctx.grid.get_num_layers() - 1), 0);
+    pin_new_loc.layer_num = max(min<int>(pin_new_loc.layer_num, num_layers - 1), 0);
     pin_old_loc.x = max(min<int>(pin_old_loc.x, device_ctx.grid.width() - 2), 1);  //-2 for no perim channels
     pin_old_loc.y = max(min<int>(pin_old_loc.y, device_ctx.grid.height() - 2), 1); //-2 for no perim channels
-    pin_old_loc.layer_num = max(min<int>(pin_old_loc.layer_num, device_ctx.grid.get_num_layers() - 1), 0);
+    pin_old_loc.layer_num = max(min<int>(pin_old_loc.layer_num, num_layers - 1), 0);
 
     /* Check if the net had been updated before. */
     if (pl_net_cost.bb_update_status[net_id] == NetUpdateState::GOT_FROM_SCRATCH) {
@@ -1087,7 +1266,7 @@ static void update_bb(ClusterNetId net_id,
     }
 
     /* Now account for the layer motion. */
-    if (num_layers > 1) {
+    if constexpr (MultiLayer) {
         /* We need to update it only if multiple layers are available */
         for (int layer_num = 0; layer_num < num_layers; layer_num++) {
             num_sink_pin_layer_new[layer_num] = curr_num_sink_pin_layer[layer_num];
@@ -1877,6 +2056,42 @@ static double recompute_bb_cost() {
     return (cost);
 }
 
+template<typename Fn>
+static void for_each_net_bb_rect(ClusterNetId net_id, bool proposed, Fn&& fn) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    const auto& place_move_ctx = placer_state_ref->get().move();
+
+    if (g_vpr_ctx.placement().cube_bb) {
+        const t_bb& bb = proposed ? ts_info.ts_bb_coord_new[net_id] : place_move_ctx.bb_coords[net_id];
+        fn(bb.xmin, bb.xmax, bb.ymin, bb.ymax, wirelength_crossing_count(cluster_ctx.clb_nlist.net_pins(net_id).size()));
+    } else {
+        const std::vector<t_2D_bb>& layer_bb = proposed ? ts_info.layer_ts_bb_coord_new[net_id] : place_move_ctx.layer_bb_coords[net_id];
+        const vtr::Matrix<int>& sink_pin_count = proposed ? ts_info.ts_layer_sink_pin_count : place_move_ctx.num_sink_pin_layer;
+        for (size_t layer_num = 0; layer_num < layer_bb.size(); layer_num++) {
+            int layer_sink_pin_count = sink_pin_count[size_t(net_id)][layer_num];
+            if (layer_sink_pin_count == 0) {
+                continue;
+            }
+            const t_2D_bb& bb = layer_bb[layer_num];
+            fn(bb.xmin, bb.xmax, bb.ymin, bb.ymax, wirelength_crossing_count(layer_sink_pin_count + 1));
+        }
+    }
+}
+
+static void add_net_routing_demand(RoutingDemandMap& demand_map, ClusterNetId net_id, bool proposed, double sign) {
+    for_each_net_bb_rect(net_id, proposed, [&](int xmin, int xmax, int ymin, int ymax, double crossing) {
+        demand_map.add_net(xmin, xmax, ymin, ymax, sign * crossing);
+    });
+}
+
+static double get_net_congestion_cost(ClusterNetId net_id, bool proposed) {
+    double cost = 0.;
+    for_each_net_bb_rect(net_id, proposed, [&](int xmin, int xmax, int ymin, int ymax, double crossing) {
+        cost += routing_demand_map.net_cost(xmin, xmax, ymin, ymax, crossing);
+    });
+    return cost;
+}
+
 static double wirelength_crossing_count(size_t fanout) {
     /* Get the expected "crossing count" of a net, based on its number *
      * of pins.  Extrapolate for very large nets.                      */
@@ -1888,11 +2103,12 @@ static double wirelength_crossing_count(size_t fanout) {
     }
 }
 
+template<typename Features>
 static void set_bb_delta_cost(double& bb_delta_c) {
     for (const ClusterNetId ts_net: ts_info.ts_nets_to_update) {
         ClusterNetId net_id = ts_net;
 
-        pl_net_cost.proposed_net_cost[net_id] = bb_updater.get_net_cost(net_id);
+        pl_net_cost.proposed_net_cost[net_id] = bb_updater.get_net_cost<Features>(net_id);
 
         bb_delta_c += pl_net_cost.proposed_net_cost[net_id] - pl_net_cost.net_cost[net_id];
     }
@@ -1905,12 +2121,26 @@ void find_affected_nets_and_update_costs(
     t_pl_blocks_to_be_moved& blocks_affected,
     double& bb_delta_c,
     double& timing_delta_c) {
+    VTR_ASSERT_DEBUG(find_affected_nets_fns[place_algorithm.is_timing_driven()]);
+    find_affected_nets_fns[place_algorithm.is_timing_driven()](delay_model, criticalities, blocks_affected, bb_delta_c, timing_delta_c);
+}
+
+template<typename Features>
+static void find_affected_nets_and_update_costs(const PlaceDelayModel* delay_model,
+                                                const PlacerCriticalities* criticalities,
+                                                t_pl_blocks_to_be_moved& blocks_affected,
+                                                double& bb_delta_c,
+                                                double& timing_delta_c) {
     VTR_ASSERT_SAFE(bb_delta_c == 0.);
     VTR_ASSERT_SAFE(timing_delta_c == 0.);
     auto& clb_nlist = g_vpr_ctx.clustering().clb_nlist;
 
     ts_info.ts_nets_to_update.resize(0);
 
+    /* The brute-force bounding boxes of the small nets are computed from the pin *
+     * locations, so bring them up to date with the whole move first.            */
+    update_net_pin_coords(blocks_affected);
+
     /* Go through all the blocks moved. */
     for (const auto& block : blocks_affected.moved_blocks) {
         const auto& moving_block_inf = block;
@@ -1925,21 +2155,211 @@ void find_affected_nets_and_update_costs(
                 is_src_moving = driven_by_moved_block(net_id,
                                                       blocks_affected.moved_blocks);
             }
-            update_net_info_on_pin_move(place_algorithm,
-                                        delay_model,
-                                        criticalities,
-                                        blk,
-                                        blk_pin,
-                                        moving_block_inf,
-                                        affected_pins,
-                                        timing_delta_c,
-                                        is_src_moving);
+            update_net_info_on_pin_move<Features>(delay_model,
+                                                  criticalities,
+                                                  blk,
+                                                  blk_pin,
+                                                  moving_block_inf,
+                                                  affected_pins,
+                                                  timing_delta_c,
+                                                  is_src_moving);
         }
     }
 
     /* Now update the bounding box costs (since the net bounding     *
      * boxes are up-to-date). The cost is only updated once per net. */
-    set_bb_delta_cost(bb_delta_c);
+    set_bb_delta_cost<Features>(bb_delta_c);
+}
+
+/**
+ * @brief Returns the location of blk once the move stored in blocks_affected is applied.
+ */
+static const t_pl_loc& get_proposed_block_loc(ClusterBlockId blk,
+                                              const t_pl_blocks_to_be_moved& blocks_affected,
+                                              const vtr::vector_map<ClusterBlockId, t_block_loc>& block_locs) {
+    for (const t_pl_moved_block& moved_block : blocks_affected.moved_blocks) {
+        if (moved_block.block_num == blk) {
+            return moved_block.new_loc;
+        }
+    }
+
+    return block_locs[blk].loc;
+}
+
+/**
+ * @brief Returns the location of a pin once the move stored in blocks_affected is applied.
+ * @note The physical pin of the block is assumed not to change, i.e. the block stays on the same physical tile type.
+ */
+static t_physical_tile_loc get_proposed_pin_loc(ClusterPinId pin_id,
+                                                const t_pl_blocks_to_be_moved& blocks_affected) {
+    const auto& clb_nlist = g_vpr_ctx.clustering().clb_nlist;
+    const auto& placer_state = placer_state_ref->get();
+
+    const t_pl_loc& block_loc = get_proposed_block_loc(clb_nlist.pin_block(pin_id), blocks_affected, placer_state.block_locs());
+    int pnum = placer_state.blk_loc_registry().tile_pin_index(pin_id);
+    t_physical_tile_type_ptr blk_type = physical_tile_type(block_loc);
+
+    return {block_loc.x + blk_type->pin_width_offset[pnum],
+            block_loc.y + blk_type->pin_height_offset[pnum],
+            block_loc.layer};
+}
+
+/**
+ * @brief Computes the wiring cost of net_id from scratch, as if the move stored in blocks_affected was applied.
+ * Both the 3D and the per-layer bounding box cost formulations are supported.
+ */
+static double get_net_cost_after_move(ClusterNetId net_id,
+                                      const t_pl_blocks_to_be_moved& blocks_affected) {
+    const auto& clb_nlist = g_vpr_ctx.clustering().clb_nlist;
+    const auto& grid = g_vpr_ctx.device().grid;
+    const int num_layers = grid.get_num_layers();
+
+    const t_physical_tile_loc src_loc = get_proposed_pin_loc(clb_nlist.net_driver(net_id), blocks_affected);
+
+    if (g_vpr_ctx.placement().cube_bb) {
+        int xmin = src_loc.x, xmax = src_loc.x;
+        int ymin = src_loc.y, ymax = src_loc.y;
+
+        for (ClusterPinId pin_id : clb_nlist.net_sinks(net_id)) {
+            const t_physical_tile_loc pin_loc = get_proposed_pin_loc(pin_id, blocks_affected);
+            xmin = min(xmin, pin_loc.x);
+            xmax = max(xmax, pin_loc.x);
+            ymin = min(ymin, pin_loc.y);
+            ymax = max(ymax, pin_loc.y);
+        }
+
+        // Same clipping as get_non_updatable_bb(); the layer extent does not contribute to the cost.
+        t_bb bb;
+        bb.xmin = max(min<int>(xmin, grid.width() - 2), 1);
+        bb.ymin = max(min<int>(ymin, grid.height() - 2), 1);
+        bb.xmax = max(min<int>(xmax, grid.width() - 2), 1);
+        bb.ymax = max(min<int>(ymax, grid.height() - 2), 1);
+
+        return get_net_cost(net_id, bb);
+    }
+
+    std::vector<int> xmin(num_layers, src_loc.x), xmax(num_layers, src_loc.x);
+    std::vector<int> ymin(num_layers, src_loc.y), ymax(num_layers, src_loc.y);
+    std::vector<int> num_sinks(num_layers, 0);
+
+    for (ClusterPinId pin_id : clb_nlist.net_sinks(net_id)) {
+        const t_physical_tile_loc pin_loc = get_proposed_pin_loc(pin_id, blocks_affected);
+        const int layer_num = pin_loc.layer_num;
+        num_sinks[layer_num]++;
+        xmin[layer_num] = min(xmin[layer_num], pin_loc.x);
+        xmax[layer_num] = max(xmax[layer_num], pin_loc.x);
+        ymin[layer_num] = min(ymin[layer_num], pin_loc.y);
+        ymax[layer_num] = max(ymax[layer_num], pin_loc.y);
+    }
+
+    // Same clipping and cost formulation as get_non_updatable_layer_bb() and get_net_layer_bb_wire_cost()
+    double ncost = 0.;
+    for (int layer_num = 0; layer_num < num_layers; layer_num++) {
+        if (num_sinks[layer_num] == 0) {
+            continue;
+        }
+
+        int bb_xmin = max(min<int>(xmin[layer_num], grid.width() - 2), 1);
+        int bb_ymin = max(min<int>(ymin[layer_num], grid.height() - 2), 1);
+        int bb_xmax = max(min<int>(xmax[layer_num], grid.width() - 2), 1);
+        int bb_ymax = max(min<int>(ymax[layer_num], grid.height() - 2), 1);
+
+        double crossing = wirelength_crossing_count(num_sinks[layer_num] + 1);
+        ncost += (bb_xmax - bb_xmin + 1) * crossing * chanx_place_cost_fac[bb_ymax][bb_ymin - 1];
+        ncost += (bb_ymax - bb_ymin + 1) * crossing * chany_place_cost_fac[bb_xmax][bb_xmin - 1];
+    }
+
+    return ncost;
+}
+
+/**
+ * @brief Returns the delay of the connection net_id[ipin] as if the move stored in blocks_affected was applied.
+ * Mirrors comp_td_single_connection_delay().
+ */
+static float get_connection_delay_after_move(const PlaceDelayModel* delay_model,
+                                             ClusterNetId net_id,
+                                             int ipin,
+                                             const t_pl_blocks_to_be_moved& blocks_affected) {
+    const auto& clb_nlist = g_vpr_ctx.clustering().clb_nlist;
+    const auto& block_locs = placer_state_ref->get().block_locs();
+
+    ClusterPinId source_pin = clb_nlist.net_driver(net_id);
+    ClusterPinId sink_pin = clb_nlist.net_pin(net_id, ipin);
+
+    const t_pl_loc& source_loc = get_proposed_block_loc(clb_nlist.pin_block(source_pin), blocks_affected, block_locs);
+    const t_pl_loc& sink_loc = get_proposed_block_loc(clb_nlist.pin_block(sink_pin), blocks_affected, block_locs);
+
+    return delay_model->delay({source_loc.x, source_loc.y, source_loc.layer}, clb_nlist.pin_logical_index(source_pin),
+                              {sink_loc.x, sink_loc.y, sink_loc.layer}, clb_nlist.pin_logical_index(sink_pin));
+}
+
+bool estimate_move_cost_deltas(const t_place_algorithm& place_algorithm,
+                               const PlaceDelayModel* delay_model,
+                               const PlacerCriticalities* criticalities,
+                               const t_pl_blocks_to_be_moved& blocks_affected,
+                               std::vector<ClusterNetId>& affected_nets,
+                               double& bb_delta_c,
+                               double& timing_delta_c) {
+    const auto& clb_nlist = g_vpr_ctx.clustering().clb_nlist;
+    const auto& grid = g_vpr_ctx.device().grid;
+    const auto& p_timing_ctx = placer_state_ref->get().timing();
+
+    affected_nets.clear();
+    bb_delta_c = 0.;
+    timing_delta_c = 0.;
+
+    for (const t_pl_moved_block& moved_block : blocks_affected.moved_blocks) {
+        const t_pl_loc& old_loc = moved_block.old_loc;
+        const t_pl_loc& new_loc = moved_block.new_loc;
+
+        // A move to another physical tile type re-maps the physical pins of the block,
+        // which is only done by apply_move_blocks().
+        if (grid.get_physical_type({old_loc.x, old_loc.y, old_loc.layer}) != grid.get_physical_type({new_loc.x, new_loc.y, new_loc.layer})) {
+            return false;
+        }
+    }
+
+    for (const t_pl_moved_block& moved_block : blocks_affected.moved_blocks) {
+        for (ClusterPinId blk_pin : clb_nlist.block_pins(moved_block.block_num)) {
+            ClusterNetId net_id = clb_nlist.pin_net(blk_pin);
+            if (clb_nlist.net_is_ignored(net_id)) {
+                continue;
+            }
+
+            affected_nets.push_back(net_id);
+
+            if (!place_algorithm.is_timing_driven()) {
+                continue;
+            }
+
+            // Same connection selection as update_td_delta_costs(): each affected connection is counted once
+            if (clb_nlist.pin_type(blk_pin) == PinType::DRIVER) {
+                for (size_t ipin = 1; ipin < clb_nlist.net_pins(net_id).size(); ipin++) {
+                    float temp_delay = get_connection_delay_after_move(delay_model, net_id, ipin, blocks_affected);
+                    if (temp_delay != p_timing_ctx.connection_delay[net_id][ipin]) {
+                        timing_delta_c += criticalities->criticality(net_id, ipin) * temp_delay
+                                          - p_timing_ctx.connection_timing_cost[net_id][ipin];
+                    }
+                }
+            } else if (!driven_by_moved_block(net_id, blocks_affected.moved_blocks)) {
+                int ipin = clb_nlist.pin_net_index(blk_pin);
+                float temp_delay = get_connection_delay_after_move(delay_model, net_id, ipin, blocks_affected);
+                if (temp_delay != p_timing_ctx.connection_delay[net_id][ipin]) {
+                    timing_delta_c += criticalities->criticality(net_id, ipin) * temp_delay
+                                      - p_timing_ctx.connection_timing_cost[net_id][ipin];
+                }
+            }
+        }
+    }
+
+    std::sort(affected_nets.begin(), affected_nets.end());
+    affected_nets.erase(std::unique(affected_nets.begin(), affected_nets.end()), affected_nets.end());
+
+    for (ClusterNetId net_id : affected_nets) {
+        bb_delta_c += get_net_cost_after_move(net_id, blocks_affected) - pl_net_cost.net_cost[net_id];
+    }
+
+    return true;
 }
 
 double comp_bb_cost(e_cost_methods method) {
@@ -1949,22 +2369,47 @@ double comp_bb_cost(e_cost_methods method) {
     auto& placer_state = placer_state_ref->get();
     auto& place_move_ctx = placer_state.mutable_move();
 
-    for (auto net_id : cluster_ctx.clb_nlist.nets()) {       /* for each net ... */
-        if (!cluster_ctx.clb_nlist.net_is_ignored(net_id)) { /* Do only if not ignored. */
-            /* Small nets don't use incremental updating on their bounding boxes, *
-             * so they can use a fast bounding box calculator.                    */
-            if (cluster_ctx.clb_nlist.net_sinks(net_id).size() >= SMALL_NET && method == e_cost_methods::NORMAL) {
-                get_bb_from_scratch(net_id,
-                                    place_move_ctx.bb_coords[net_id],
-                                    place_move_ctx.bb_num_on_edges[net_id],
-                                    place_move_ctx.num_sink_pin_layer[size_t(net_id)]);
+    load_net_pin_coords();
+
+    auto comp_net_bb_cost = [&](ClusterNetId net_id) {
+        if (cluster_ctx.clb_nlist.net_is_ignored(net_id)) { /* Do only if not ignored. */
+            return;
+        }
+
+        /* Small nets don't use incremental updating on their bounding boxes, *
+         * so they can use a fast bounding box calculator.                    */
+        if (cluster_ctx.clb_nlist.net_sinks(net_id).size() >= SMALL_NET && method == e_cost_methods::NORMAL) {
+            get_bb_from_scratch(net_id,
+                                place_move_ctx.bb_coords[net_id],
+                                place_move_ctx.bb_num_on_edges[net_id],
+                                place_move_ctx.num_sink_pin_layer[size_t(net_id)]);
+        } else {
+            if (g_vpr_ctx.device().grid.get_num_layers() > 1) {
+                get_non_updatable_bb<true>(net_id,
+                                           place_move_ctx.bb_coords[net_id],
+                                           place_move_ctx.num_sink_pin_layer[size_t(net_id)]);
             } else {
-                get_non_updatable_bb(net_id,
-                                     place_move_ctx.bb_coords[net_id],
-                                     place_move_ctx.num_sink_pin_layer[size_t(net_id)]);
+                get_non_updatable_bb<false>(net_id,
+                                            place_move_ctx.bb_coords[net_id],
+                                            place_move_ctx.num_sink_pin_layer[size_t(net_id)]);
             }
+        }
+
+        pl_net_cost.net_cost[net_id] = get_net_cost(net_id, place_move_ctx.bb_coords[net_id]);
+    };
+
+    /* The bounding boxes and costs of the nets are independent, so they are computed in parallel, *
+     * but summed in netlist order so that the total is the same whatever the number of threads.    */
+#ifdef VPR_USE_TBB
+    tbb::parallel_for_each(cluster_ctx.clb_nlist.nets().begin(), cluster_ctx.clb_nlist.nets().end(), comp_net_bb_cost);
+#else
+    for (auto net_id : cluster_ctx.clb_nlist.nets()) {
+        comp_net_bb_cost(net_id);
+    }
+#endif
 
-            pl_net_cost.net_cost[net_id] = get_net_cost(net_id, place_move_ctx.bb_coords[net_id]);
+    for (auto net_id : cluster_ctx.clb_nlist.nets()) {
+        if (!cluster_ctx.clb_nlist.net_is_ignored(net_id)) {
             cost += pl_net_cost.net_cost[net_id];
             if (method == e_cost_methods::CHECK)
                 expected_wirelength += get_net_wirelength_estimate(net_id, place_move_ctx.bb_coords[net_id]);
@@ -1986,24 +2431,42 @@ double comp_layer_bb_cost(e_cost_methods method) {
     auto& placer_state = placer_state_ref->get();
     auto& place_move_ctx = placer_state.mutable_move();
 
-    for (auto net_id : cluster_ctx.clb_nlist.nets()) {       /* for each net ... */
-        if (!cluster_ctx.clb_nlist.net_is_ignored(net_id)) { /* Do only if not ignored. */
-            /* Small nets don't use incremental updating on their bounding boxes, *
-             * so they can use a fast bounding box calculator.                    */
-            if (cluster_ctx.clb_nlist.net_sinks(net_id).size() >= SMALL_NET && method == e_cost_methods::NORMAL) {
-                get_layer_bb_from_scratch(net_id,
-                                          place_move_ctx.layer_bb_num_on_edges[net_id],
-                                          place_move_ctx.layer_bb_coords[net_id],
-                                          place_move_ctx.num_sink_pin_layer[size_t(net_id)]);
-            } else {
-                get_non_updatable_layer_bb(net_id,
-                                           place_move_ctx.layer_bb_coords[net_id],
-                                           place_move_ctx.num_sink_pin_layer[size_t(net_id)]);
-            }
+    load_net_pin_coords();
+
+    auto comp_net_layer_bb_cost = [&](ClusterNetId net_id) {
+        if (cluster_ctx.clb_nlist.net_is_ignored(net_id)) { /* Do only if not ignored. */
+            return;
+        }
 
-            pl_net_cost.net_cost[net_id] = get_net_layer_bb_wire_cost(net_id,
-                                                                      place_move_ctx.layer_bb_coords[net_id],
-                                                                      place_move_ctx.num_sink_pin_layer[size_t(net_id)]);
+        /* Small nets don't use incremental updating on their bounding boxes, *
+         * so they can use a fast bounding box calculator.                    */
+        if (cluster_ctx.clb_nlist.net_sinks(net_id).size() >= SMALL_NET && method == e_cost_methods::NORMAL) {
+            get_layer_bb_from_scratch(net_id,
+                                      place_move_ctx.layer_bb_num_on_edges[net_id],
+                                      place_move_ctx.layer_bb_coords[net_id],
+                                      place_move_ctx.num_sink_pin_layer[size_t(net_id)]);
+        } else {
+            get_non_updatable_layer_bb(net_id,
+                                       place_move_ctx.layer_bb_coords[net_id],
+                                       place_move_ctx.num_sink_pin_layer[size_t(net_id)]);
+        }
+
+        pl_net_cost.net_cost[net_id] = get_net_layer_bb_wire_cost(net_id,
+                                                                  place_move_ctx.layer_bb_coords[net_id],
+                                                                  place_move_ctx.num_sink_pin_layer[size_t(net_id)]);
+    };
+
+    /* As in comp_bb_cost(), computed in parallel and summed in netlist order */
+#ifdef VPR_USE_TBB
+    tbb::parallel_for_each(cluster_ctx.clb_nlist.nets().begin(), cluster_ctx.clb_nlist.nets().end(), comp_net_layer_bb_cost);
+#else
+    for (auto net_id : cluster_ctx.clb_nlist.nets()) {
+        comp_net_layer_bb_cost(net_id);
+    }
+#endif
+
+    for (auto net_id : cluster_ctx.clb_nlist.nets()) {
+        if (!cluster_ctx.clb_nlist.net_is_ignored(net_id)) {
             cost += pl_net_cost.net_cost[net_id];
             if (method == e_cost_methods::CHECK)
                 expected_wirelength += get_net_wirelength_from_layer_bb(net_id,
@@ -2029,6 +2492,13 @@ void update_move_nets() {
     for (const ClusterNetId ts_net : ts_info.ts_nets_to_update) {
         ClusterNetId net_id = ts_net;
 
+        /* Move the routing demand of the net from its old bounding box to the new one */
+        if (routing_demand_map.is_initialized()) {
+            add_net_routing_demand(routing_demand_map, net_id, false, -1.);
+            add_net_routing_demand(routing_demand_map, net_id, true, 1.);
+            pl_net_cost.net_congestion_cost[net_id] = get_net_congestion_cost(net_id, true);
+        }
+
         bb_updater.set_ts_bb_coord(net_id);
 
         for (int layer_num = 0; layer_num < g_vpr_ctx.device().grid.get_num_layers(); layer_num++) {
@@ -2045,6 +2515,9 @@ void update_move_nets() {
         pl_net_cost.proposed_net_cost[net_id] = -1;
         pl_net_cost.bb_update_status[net_id] = NetUpdateState::NOT_UPDATED_YET;
     }
+
+    /* The new pin locations are kept */
+    net_pin_coords.moved_pins.clear();
 }
 
 void reset_move_nets() {
@@ -2054,6 +2527,8 @@ void reset_move_nets() {
         pl_net_cost.proposed_net_cost[net_id] = -1;
         pl_net_cost.bb_update_status[net_id] = NetUpdateState::NOT_UPDATED_YET;
     }
+
+    revert_net_pin_coords();
 }
 
 void recompute_costs_from_scratch(const t_placer_opts& placer_opts,
@@ -2078,6 +2553,15 @@ void recompute_costs_from_scratch(const t_placer_opts& placer_opts,
     check_and_print_cost(new_bb_cost, costs->bb_cost, "bb_cost");
     costs->bb_cost = new_bb_cost;
 
+    if (routing_demand_map.is_initialized()) {
+        /* Also drops the round off the incremental updates accumulated in the demand */
+        double new_congestion_cost = recompute_congestion_cost();
+        if (new_congestion_cost > MIN_EXPECTED_CONGESTION_COST) {
+            check_and_print_cost(new_congestion_cost, costs->congestion_cost, "congestion_cost");
+        }
+        costs->congestion_cost = new_congestion_cost;
+    }
+
     if (placer_opts.place_algorithm.is_timing_driven()) {
         double new_timing_cost = 0.;
         comp_td_costs(delay_model, *criticalities, placer_state, &new_timing_cost);
@@ -2225,6 +2709,82 @@ void free_chan_w_factors_for_place_cost() {
     chany_place_cost_fac.clear();
 }
 
+/* Loads demand_map (sized for the device first if needed) with the demand of the committed bounding boxes of all the nets */
+static void load_routing_demand(RoutingDemandMap& demand_map) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& device_ctx = g_vpr_ctx.device();
+
+    if (!demand_map.is_initialized()) {
+        demand_map.init(device_ctx.grid.width(), device_ctx.grid.height(),
+                        device_ctx.chan_width.x_list, device_ctx.chan_width.y_list);
+    } else {
+        demand_map.clear_demand();
+    }
+
+    for (ClusterNetId net_id : cluster_ctx.clb_nlist.nets()) {
+        if (!cluster_ctx.clb_nlist.net_is_ignored(net_id)) {
+            add_net_routing_demand(demand_map, net_id, false, 1.);
+        }
+    }
+}
+
+void init_routing_demand_map(float util_threshold) {
+    congestion_util_threshold = util_threshold;
+    pl_net_cost.net_congestion_cost.resize(g_vpr_ctx.clustering().clb_nlist.nets().size(), 0.);
+    load_routing_demand(routing_demand_map);
+}
+
+void free_routing_demand_map() {
+    routing_demand_map.clear();
+    vtr::release_memory(pl_net_cost.net_congestion_cost);
+}
+
+double update_congestion_cost() {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+
+    routing_demand_map.update_utilization(congestion_util_threshold);
+
+    double cost = 0.;
+    for (ClusterNetId net_id : cluster_ctx.clb_nlist.nets()) {
+        if (!cluster_ctx.clb_nlist.net_is_ignored(net_id)) {
+            pl_net_cost.net_congestion_cost[net_id] = get_net_congestion_cost(net_id, false);
+            cost += pl_net_cost.net_congestion_cost[net_id];
+        }
+    }
+    return cost;
+}
+
+double recompute_congestion_cost() {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+
+    load_routing_demand(routing_demand_map);
+
+    double cost = 0.;
+    for (ClusterNetId net_id : cluster_ctx.clb_nlist.nets()) {
+        if (!cluster_ctx.clb_nlist.net_is_ignored(net_id)) {
+            cost += pl_net_cost.net_congestion_cost[net_id];
+        }
+    }
+    return cost;
+}
+
+double find_affected_nets_congestion_delta() {
+    VTR_ASSERT_SAFE(routing_demand_map.is_initialized());
+
+    double congestion_delta_c = 0.;
+    for (const ClusterNetId net_id : ts_info.ts_nets_to_update) {
+        congestion_delta_c += get_net_congestion_cost(net_id, true) - pl_net_cost.net_congestion_cost[net_id];
+    }
+    return congestion_delta_c;
+}
+
+t_routing_demand_stats estimate_routing_demand() {
+    RoutingDemandMap demand_map;
+    load_routing_demand(demand_map);
+    demand_map.update_utilization(1.);
+    return demand_map.stats();
+}
+
 void init_place_move_structs(size_t num_nets) {
     pl_net_cost.net_cost.resize(num_nets, -1.);
     pl_net_cost.proposed_net_cost.resize(num_nets, -1.);
@@ -2242,6 +2802,19 @@ void free_place_move_structs() {
 
 void init_try_swap_net_cost_structs(size_t num_nets, bool cube_bb) {
     bb_updater.init(num_nets, cube_bb);
+
+    //The per-layer bounding box update does not specialize on the number of layers
+    bool multi_layer = g_vpr_ctx.device().grid.get_num_layers() > 1;
+    if (!cube_bb) {
+        find_affected_nets_fns[0] = find_affected_nets_and_update_costs<t_net_cost_features<false, true, false>>;
+        find_affected_nets_fns[1] = find_affected_nets_and_update_costs<t_net_cost_features<false, true, true>>;
+    } else if (multi_layer) {
+        find_affected_nets_fns[0] = find_affected_nets_and_update_costs<t_net_cost_features<true, true, false>>;
+        find_affected_nets_fns[1] = find_affected_nets_and_update_costs<t_net_cost_features<true, true, true>>;
+    } else {
+        find_affected_nets_fns[0] = find_affected_nets_and_update_costs<t_net_cost_features<true, false, false>>;
+        find_affected_nets_fns[1] = find_affected_nets_and_update_costs<t_net_cost_features<true, false, true>>;
+    }
 }
 
 void free_try_swap_net_cost_structs() {
@@ -2251,4 +2824,10 @@ void free_try_swap_net_cost_structs() {
     vtr::release_memory(ts_info.layer_ts_bb_coord_new);
     ts_info.ts_layer_sink_pin_count.clear();
     vtr::release_memory(ts_info.ts_nets_to_update);
+
+    vtr::release_memory(net_pin_coords.net_begin);
+    vtr::release_memory(net_pin_coords.x);
+    vtr::release_memory(net_pin_coords.y);
+    vtr::release_memory(net_pin_coords.layer);
+    vtr::release_memory(net_pin_coords.moved_pins);
 }
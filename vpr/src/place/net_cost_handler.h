@@ -3,6 +3,7 @@
 #include "timing_place.h"
 #include "move_transactions.h"
 #include "place_util.h"
+#include "routing_demand_map.h"
 
 class PlacerState;
 
@@ -62,6 +63,34 @@ void find_affected_nets_and_update_costs(
     double& bb_delta_c,
     double& timing_delta_c);
 
+/**
+ * @brief Estimates the bounding box and timing cost changes of a proposed move without applying it.
+ *
+ * Unlike find_affected_nets_and_update_costs(), the moved blocks are not relocated and none of the
+ * incremental (ts_* and proposed_*) data structures are modified. The affected net bounding boxes are
+ * computed from scratch with the moved blocks at their new locations. This only reads the placement
+ * state, so several moves can be estimated concurrently against the same placement.
+ *
+ * Moves which relocate a block to a different physical tile type change the block's physical pins;
+ * their cost cannot be estimated here and false is returned.
+ *
+ * @param place_algorithm
+ * @param delay_model
+ * @param criticalities
+ * @param blocks_affected The proposed move.
+ * @param affected_nets Filled with the sorted, unique (non-ignored) nets connected to the moved blocks.
+ * @param bb_delta_c Returns the change in the bounding box cost.
+ * @param timing_delta_c Returns the change in the timing cost.
+ * @return True if the cost changes could be estimated.
+ */
+bool estimate_move_cost_deltas(const t_place_algorithm& place_algorithm,
+                               const PlaceDelayModel* delay_model,
+                               const PlacerCriticalities* criticalities,
+                               const t_pl_blocks_to_be_moved& blocks_affected,
+                               std::vector<ClusterNetId>& affected_nets,
+                               double& bb_delta_c,
+                               double& timing_delta_c);
+
 /**
  * @brief Finds the bb cost from scratch (based on 3D BB).
  * Done only when the placement has been radically changed
@@ -91,12 +120,14 @@ double comp_layer_bb_cost(e_cost_methods method);
 
 /**
  * @brief update net cost data structures (in placer context and net_cost in .cpp file) and reset flags (proposed_net_cost and bb_updated_before).
+ * The net pin locations updated by find_affected_nets_and_update_costs() are kept.
  * @param num_nets_affected The number of nets affected by the move. It is used to determine the index up to which elements in ts_nets_to_update are valid.
  */
 void update_move_nets();
 
 /**
  * @brief Reset the net cost function flags (proposed_net_cost and bb_updated_before)
+ * and restore the net pin locations updated by find_affected_nets_and_update_costs().
  * @param num_nets_affected
  */
 void reset_move_nets();
@@ -156,4 +187,43 @@ void init_try_swap_net_cost_structs(size_t num_nets, bool cube_bb);
  */
 void free_try_swap_net_cost_structs();
 
+/**
+ * @brief Loads the routing demand map of the congestion cost from the net bounding boxes, which must be computed first
+ * (comp_bb_cost() or comp_layer_bb_cost()). The demand is then kept up to date by update_move_nets().
+ * @param util_threshold The estimated channel utilization above which a channel is congested.
+ */
+void init_routing_demand_map(float util_threshold);
+
+/**
+ * @brief Frees the routing demand map and the congestion costs of the nets.
+ */
+void free_routing_demand_map();
+
+/**
+ * @brief Refreshes the channel utilization the congestion costs are computed against from the current routing demand,
+ * and recomputes the congestion cost of each net. Called at each temperature change.
+ * @return The congestion cost of the placement.
+ */
+double update_congestion_cost();
+
+/**
+ * @brief Reloads the routing demand from the net bounding boxes, dropping the round off accumulated by the
+ * incremental updates, and sums the congestion costs of the nets (see recompute_costs_from_scratch()).
+ * @return The congestion cost of the placement.
+ */
+double recompute_congestion_cost();
+
+/**
+ * @brief Finds the change in the congestion cost of the nets affected by the move evaluated by the last
+ * find_affected_nets_and_update_costs(), against the utilization of the last update_congestion_cost().
+ * @return The change in the congestion cost.
+ */
+double find_affected_nets_congestion_delta();
+
+/**
+ * @brief Estimates the channel utilization of the current placement from scratch (RUDY), as a predictor of its
+ * routability. Independent of the congestion cost, the net bounding boxes only need to be up to date.
+ */
+t_routing_demand_stats estimate_routing_demand();
+
 void set_net_handlers_placer_state(PlacerState& placer_state);
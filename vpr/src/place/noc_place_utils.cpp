@@ -17,6 +17,12 @@
 #endif
 
 #include <fstream>
+#include <memory>
+
+#ifdef VPR_USE_TBB
+#    include <tbb/enumerable_thread_specific.h>
+#    include <tbb/parallel_for.h>
+#endif
 
 /********************** Variables local to noc_place_utils.c pp***************************/
 /* Proposed and actual cost of a noc traffic flow used for each move assessment */
@@ -30,6 +36,17 @@ static vtr::vector<NocLinkId, double> link_congestion_costs, proposed_link_conge
 
 /* Keeps track of NoC links whose bandwidth usage have been updated at each attempted placement move*/
 static std::unordered_set<NocLinkId> affected_noc_links;
+
+/* Channel dependency graph of the current traffic flow routes, only built if deadlocking moves are rejected */
+static std::unique_ptr<ChannelDependencyGraph> incremental_cdg;
+
+/* Routes of the affected traffic flows before the attempted placement move, in the order of affected_traffic_flows */
+static std::vector<std::vector<NocLinkId>> affected_traffic_flow_prev_routes;
+
+/* Number of proposed routes (of the first affected traffic flows) added to incremental_cdg,
+ * and whether the next one was rejected because it could deadlock */
+static size_t num_proposed_routes_in_cdg = 0;
+static bool proposed_routes_deadlock = false;
 /*********************************************************** *****************************/
 
 /**
@@ -112,6 +129,11 @@ void reinitialize_noc_routing(t_placer_costs& costs,
     // Route traffic flows and update link bandwidth usage
     initial_noc_routing(new_traffic_flow_routes, block_locs);
 
+    // the channel dependency graph of the previous routes is no longer valid
+    if (incremental_cdg) {
+        init_noc_deadlock_check();
+    }
+
     // Initialize traffic_flow_costs
     costs.noc_cost_terms.aggregate_bandwidth = comp_noc_aggregate_bandwidth_cost();
     std::tie(costs.noc_cost_terms.latency, costs.noc_cost_terms.latency_overrun) = comp_noc_latency_cost();
@@ -138,6 +160,7 @@ void find_affected_noc_routers_and_update_noc_costs(const t_pl_blocks_to_be_move
 
     affected_traffic_flows.clear();
     affected_noc_links.clear();
+    affected_traffic_flow_prev_routes.clear();
 
     // go through the moved blocks and process them only if they are NoC routers
     for (const auto& block : blocks_affected.moved_blocks) {
@@ -150,6 +173,23 @@ void find_affected_noc_routers_and_update_noc_costs(const t_pl_blocks_to_be_move
         }
     }
 
+    // replace the previous routes of the affected traffic flows by the proposed ones in the channel dependency graph,
+    // stopping at the first proposed route that closes a dependency cycle
+    num_proposed_routes_in_cdg = 0;
+    proposed_routes_deadlock = false;
+    if (incremental_cdg) {
+        for (const auto& prev_route : affected_traffic_flow_prev_routes) {
+            incremental_cdg->remove_route(prev_route);
+        }
+        for (auto traffic_flow_id : affected_traffic_flows) {
+            if (!incremental_cdg->add_route(noc_traffic_flows_storage.get_traffic_flow_route(traffic_flow_id))) {
+                proposed_routes_deadlock = true;
+                break;
+            }
+            num_proposed_routes_in_cdg++;
+        }
+    }
+
     // go through all the affected traffic flows and calculate their new costs after being re-routed, then determine the change in cost before the traffic flows were modified
     for (auto& traffic_flow_id : affected_traffic_flows) {
         // get the traffic flow route
@@ -202,6 +242,11 @@ void commit_noc_costs() {
         // invalidate the proposed link congestion flow costs
         proposed_link_congestion_costs[link] = INVALID_NOC_COST_TERM;
     }
+
+    // a deadlocking move can still be committed (e.g. a manual move), the graph is then missing some of the routes
+    if (incremental_cdg && proposed_routes_deadlock) {
+        init_noc_deadlock_check();
+    }
 }
 
 std::vector<NocLinkId>& route_traffic_flow(NocTrafficFlowId traffic_flow_id,
@@ -220,9 +265,9 @@ std::vector<NocLinkId>& route_traffic_flow(NocTrafficFlowId traffic_flow_id,
     NocRouterId source_router_block_id = noc_model.get_router_at_grid_location(block_locs[logical_source_router_block_id].loc);
     NocRouterId sink_router_block_id = noc_model.get_router_at_grid_location(block_locs[logical_sink_router_block_id].loc);
 
-    // route the current traffic flow
+    // route the current traffic flow, reusing the route found earlier between the same routers if the routing algorithm allows it
     std::vector<NocLinkId>& curr_traffic_flow_route = noc_traffic_flows_storage.get_mutable_traffic_flow_route(traffic_flow_id);
-    noc_flows_router.route_flow(source_router_block_id, sink_router_block_id, traffic_flow_id, curr_traffic_flow_route, noc_model);
+    noc_flows_router.route_flow_cached(source_router_block_id, sink_router_block_id, traffic_flow_id, curr_traffic_flow_route, noc_model);
 
     return curr_traffic_flow_route;
 }
@@ -261,6 +306,11 @@ void re_route_associated_traffic_flows(ClusterBlockId moved_block_router_id,
             // The returned const std::vector<NocLinkId>& is copied so that we can modify (sort) it
             std::vector<NocLinkId> prev_traffic_flow_links = noc_traffic_flows_storage.get_traffic_flow_route(traffic_flow_id);
 
+            // the channel dependency graph needs the previous route in traversal order
+            if (incremental_cdg) {
+                affected_traffic_flow_prev_routes.push_back(prev_traffic_flow_links);
+            }
+
             // now update the current traffic flow by re-routing it based on the new locations of its src and destination routers
             re_route_traffic_flow(traffic_flow_id, noc_traffic_flows_storage, noc_model, noc_flows_router, block_locs);
 
@@ -289,6 +339,20 @@ void revert_noc_traffic_flow_routes(const t_pl_blocks_to_be_moved& blocks_affect
 
     NocTrafficFlows& noc_traffic_flows_storage = noc_ctx.noc_traffic_flows_storage;
 
+    // restore the channel dependency graph of the routes before the move, the proposed routes are still stored
+    if (incremental_cdg) {
+        for (size_t i = 0; i < num_proposed_routes_in_cdg; i++) {
+            incremental_cdg->remove_route(noc_traffic_flows_storage.get_traffic_flow_route(affected_traffic_flows[i]));
+        }
+        for (const auto& prev_route : affected_traffic_flow_prev_routes) {
+            // these routes were in the graph before the move, so they cannot create a cycle
+            bool added = incremental_cdg->add_route(prev_route);
+            VTR_ASSERT(added);
+        }
+        num_proposed_routes_in_cdg = 0;
+        affected_traffic_flow_prev_routes.clear();
+    }
+
     // keeps track of traffic flows that have been reverted
     // This is useful for cases where two moved routers were part of the same traffic flow and prevents us from re-routing the same flow twice.
     std::unordered_set<NocTrafficFlowId> reverted_traffic_flows;
@@ -340,6 +404,29 @@ void re_route_traffic_flow(NocTrafficFlowId traffic_flow_id,
     update_traffic_flow_link_usage(re_routed_traffic_flow_route, noc_model, 1, curr_traffic_flow.traffic_flow_bandwidth);
 }
 
+bool init_noc_deadlock_check() {
+    const auto& noc_ctx = g_vpr_ctx.noc();
+    const NocTrafficFlows& noc_traffic_flows_storage = noc_ctx.noc_traffic_flows_storage;
+
+    incremental_cdg = std::make_unique<ChannelDependencyGraph>(noc_ctx.noc_model.get_number_of_noc_links());
+    num_proposed_routes_in_cdg = 0;
+    proposed_routes_deadlock = false;
+
+    for (auto traffic_flow_id : noc_traffic_flows_storage.get_all_traffic_flow_id()) {
+        if (!incremental_cdg->add_route(noc_traffic_flows_storage.get_traffic_flow_route(traffic_flow_id))) {
+            VTR_LOG_WARN("The current NoC traffic flow routes have cyclic channel dependencies: deadlocking moves will not be rejected.\n");
+            incremental_cdg.reset();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool noc_proposed_routes_deadlock() {
+    return proposed_routes_deadlock;
+}
+
 void recompute_noc_costs(NocCostTerms& new_cost) {
     auto& noc_ctx = g_vpr_ctx.noc();
 
@@ -472,28 +559,44 @@ int check_noc_placement_costs(const t_placer_costs& costs,
     // reset bandwidth utilization for all links
     std::for_each(temp_noc_link_storage.begin(), temp_noc_link_storage.end(), [](NocLink& link) { link.set_bandwidth_usage(0.0); });
 
-    // need to create a temporary noc routing algorithm
-    std::unique_ptr<NocRouting> temp_noc_routing_algorithm = NocRoutingAlgorithmCreator::create_routing_algorithm(noc_opts.noc_routing_algorithm,
-                                                                                                                  noc_model);
+    const std::vector<NocTrafficFlowId>& traffic_flow_ids = noc_traffic_flows_storage.get_all_traffic_flow_id();
 
-    // stores a temporarily found route for a traffic flow
-    std::vector<NocLinkId> temp_found_noc_route;
+    // the route found for each traffic flow, based on where the routers are placed within the NoC
+    std::vector<std::vector<NocLinkId>> temp_found_noc_routes(traffic_flow_ids.size());
 
-    // go through all the traffic flows and find a route for them based on where the routers are placed within the NoC
-    for (const auto& traffic_flow_id : noc_traffic_flows_storage.get_all_traffic_flow_id()) {
-        // get the traffic flow with the current id
+    auto route_traffic_flow = [&](NocRouting& temp_noc_routing_algorithm, size_t iflow) {
+        NocTrafficFlowId traffic_flow_id = traffic_flow_ids[iflow];
         const t_noc_traffic_flow& curr_traffic_flow = noc_traffic_flows_storage.get_single_noc_traffic_flow(traffic_flow_id);
 
-        // get the source and destination logical router blocks in the current traffic flow
-        ClusterBlockId logical_source_router_block_id = curr_traffic_flow.source_router_cluster_id;
-        ClusterBlockId logical_sink_router_block_id = curr_traffic_flow.sink_router_cluster_id;
-
         // get the ids of the hard router blocks where the logical router cluster blocks have been placed
-        NocRouterId source_router_block_id = noc_model.get_router_at_grid_location(block_locs[logical_source_router_block_id].loc);
-        NocRouterId sink_router_block_id = noc_model.get_router_at_grid_location(block_locs[logical_sink_router_block_id].loc);
+        NocRouterId source_router_block_id = noc_model.get_router_at_grid_location(block_locs[curr_traffic_flow.source_router_cluster_id].loc);
+        NocRouterId sink_router_block_id = noc_model.get_router_at_grid_location(block_locs[curr_traffic_flow.sink_router_cluster_id].loc);
+
+        temp_noc_routing_algorithm.route_flow(source_router_block_id, sink_router_block_id, traffic_flow_id, temp_found_noc_routes[iflow], noc_model);
+    };
+
+    // the routes of the traffic flows are independent (the routing algorithms only depend on the
+    // placement and the flow ids), so they are found in parallel, each thread with its own temporary
+    // routing algorithm
+#ifdef VPR_USE_TBB
+    tbb::enumerable_thread_specific<std::unique_ptr<NocRouting>> temp_noc_routing_algorithms([&]() {
+        return NocRoutingAlgorithmCreator::create_routing_algorithm(noc_opts.noc_routing_algorithm, noc_model);
+    });
+    tbb::parallel_for(size_t(0), traffic_flow_ids.size(), [&](size_t iflow) {
+        route_traffic_flow(*temp_noc_routing_algorithms.local(), iflow);
+    });
+#else
+    std::unique_ptr<NocRouting> temp_noc_routing_algorithm = NocRoutingAlgorithmCreator::create_routing_algorithm(noc_opts.noc_routing_algorithm,
+                                                                                                                  noc_model);
+    for (size_t iflow = 0; iflow < traffic_flow_ids.size(); iflow++) {
+        route_traffic_flow(*temp_noc_routing_algorithm, iflow);
+    }
+#endif
 
-        // route the current traffic flow
-        temp_noc_routing_algorithm->route_flow(source_router_block_id, sink_router_block_id, traffic_flow_id, temp_found_noc_route, noc_model);
+    // the costs are accumulated in traffic flow order, so they don't depend on the number of threads
+    for (size_t iflow = 0; iflow < traffic_flow_ids.size(); iflow++) {
+        const t_noc_traffic_flow& curr_traffic_flow = noc_traffic_flows_storage.get_single_noc_traffic_flow(traffic_flow_ids[iflow]);
+        const std::vector<NocLinkId>& temp_found_noc_route = temp_found_noc_routes[iflow];
 
         // now calculate the costs associated to the current traffic flow and accumulate it to find the total cost of the NoC placement
         double current_flow_aggregate_bandwidth_cost = calculate_traffic_flow_aggregate_bandwidth_cost(temp_found_noc_route, curr_traffic_flow);
@@ -510,9 +613,6 @@ int check_noc_placement_costs(const t_placer_costs& costs,
             link.set_bandwidth_usage(curr_link_bw_util + curr_traffic_flow.traffic_flow_bandwidth);
             VTR_ASSERT(link.get_bandwidth_usage() >= 0.0);
         }
-
-        // clear the current traffic flow route, so we can route the next traffic flow
-        temp_found_noc_route.clear();
     }
 
     // Iterate over all NoC links and accumulate congestion cost
@@ -780,6 +880,13 @@ void free_noc_placement_structs() {
     vtr::release_memory(link_congestion_costs);
     vtr::release_memory(proposed_link_congestion_costs);
     vtr::release_memory(affected_noc_links);
+
+    incremental_cdg.reset();
+    vtr::release_memory(affected_traffic_flow_prev_routes);
+
+#ifdef ENABLE_NOC_SAT_ROUTING
+    free_noc_sat_route_incremental();
+#endif
 }
 
 /* Below are functions related to the feature that forces to the placer to swap router blocks for a certain percentage of the total number of swaps */
@@ -938,7 +1045,7 @@ bool noc_routing_has_cycle(const vtr::vector<NocTrafficFlowId, std::vector<NocLi
 #ifdef ENABLE_NOC_SAT_ROUTING
 void invoke_sat_router(t_placer_costs& costs, const t_noc_opts& noc_opts, int seed) {
 
-    auto traffic_flow_routes = noc_sat_route(true, noc_opts, seed);
+    auto traffic_flow_routes = noc_sat_route_incremental(true, noc_opts, seed);
 
     if (!traffic_flow_routes.empty()) {
         bool has_cycle = noc_routing_has_cycle(traffic_flow_routes);
@@ -139,6 +139,29 @@ void find_affected_noc_routers_and_update_noc_costs(const t_pl_blocks_to_be_move
  */
 void commit_noc_costs();
 
+/**
+ * @brief Starts checking whether the traffic flow routes proposed by placement
+ * moves could deadlock. A channel dependency graph (CDG) of the current routes is
+ * built, and then kept up to date incrementally as traffic flows are re-routed
+ * by find_affected_noc_routers_and_update_noc_costs() and reverted by
+ * revert_noc_traffic_flow_routes(). The check stops with free_noc_placement_structs().
+ *
+ * Should be called once all traffic flows are routed. reinitialize_noc_routing()
+ * rebuilds the CDG of its new routes.
+ *
+ * @return False if the current routes already have cyclic dependencies,
+ * in which case the proposed routes are not checked.
+ */
+bool init_noc_deadlock_check();
+
+/**
+ * @brief Whether the traffic flow routes proposed by the last call to
+ * find_affected_noc_routers_and_update_noc_costs() create a cycle in the
+ * channel dependency graph, i.e. could deadlock. Such a move should be rejected.
+ * Always false if init_noc_deadlock_check() was not called.
+ */
+bool noc_proposed_routes_deadlock();
+
 /**
  * @brief Routes a given traffic flow within the NoC based on where the
  * logical cluster blocks in the traffic flow are currently placed. The
@@ -6,6 +6,11 @@
 #include <numeric>
 #include <chrono>
 #include <optional>
+#include <unordered_set>
+
+#ifdef VPR_USE_TBB
+#    include <tbb/parallel_for.h>
+#endif
 
 #include "NetPinTimingInvalidator.h"
 #include "vtr_assert.h"
@@ -26,6 +31,7 @@
 #include "place.h"
 #include "read_place.h"
 #include "draw.h"
+#include "snapshot_render.h"
 #include "place_and_route.h"
 #include "net_delay.h"
 #include "timing_place_lookup.h"
@@ -37,6 +43,8 @@
 #include "place_util.h"
 #include "analytic_placer.h"
 #include "initial_placement.h"
+#include "place_multilevel.h"
+#include "place_anneal_telemetry.h"
 #include "place_delay_model.h"
 #include "place_timing_update.h"
 #include "move_transactions.h"
@@ -96,6 +104,46 @@ static constexpr int MAX_MOVES_BEFORE_RECOMPUTE = 500000;
 constexpr float INVALID_DELAY = std::numeric_limits<float>::quiet_NaN();
 constexpr float INVALID_COST = std::numeric_limits<double>::quiet_NaN();
 
+/**
+ * @brief A move proposed as part of a batch of speculatively evaluated moves.
+ *
+ * All the moves of a batch are proposed against the same placement. Their costs
+ * are then estimated concurrently (see estimate_move_cost_deltas()) and the moves
+ * are finally accepted/rejected and committed one at a time, in proposal order.
+ */
+struct t_speculative_move {
+    explicit t_speculative_move(size_t max_blocks)
+        : blocks_affected(max_blocks) {}
+
+    t_pl_blocks_to_be_moved blocks_affected;
+    t_propose_action proposed_action{e_move_type::UNIFORM, -1};
+    e_create_move create_move_outcome = e_create_move::ABORT;
+    int64_t eval_time_ns = 0; ///<Time spent proposing and evaluating the move so far
+
+    ///@brief True if the cost changes below were estimated against the batch's starting placement
+    bool estimated = false;
+    std::vector<ClusterNetId> affected_nets;
+    double bb_delta_c = 0.;
+    double timing_delta_c = 0.;
+};
+
+/**
+ * @brief The outcome of placing the circuit with one seed of a --place_seeds run.
+ *
+ * The placer state is heap allocated since the placement delay calculator refers
+ * to its connection delays, and both are needed to report on the best placement.
+ */
+struct t_placement_seed_result {
+    int seed = 0;
+    std::unique_ptr<PlacerState> placer_state;
+    t_placer_costs costs;
+
+    ///@brief Estimated critical path delay (NaN if the placement is not timing driven)
+    float cpd = INVALID_DELAY;
+    std::shared_ptr<SetupTimingInfo> timing_info;
+    std::shared_ptr<PlacementDelayCalculator> placement_delay_calc;
+};
+
 /********************** Variables local to place.c ***************************/
 
 
@@ -207,6 +255,7 @@ static e_move_result try_swap(const t_annealing_state* state,
                               SetupTimingInfo* timing_info,
                               NetPinTimingInvalidator* pin_timing_invalidator,
                               t_pl_blocks_to_be_moved& blocks_affected,
+                              t_pl_blocks_to_be_moved* candidate_blocks_affected,
                               const PlaceDelayModel* delay_model,
                               PlacerCriticalities* criticalities,
                               PlacerSetupSlacks* setup_slacks,
@@ -290,6 +339,47 @@ static void outer_loop_update_timing_info(const t_placer_opts& placer_opts,
                                           SetupTimingInfo* timing_info,
                                           PlacerState& placer_state);
 
+static bool use_speculative_moves(const t_placer_opts& placer_opts,
+                                  const t_noc_opts& noc_opts,
+                                  const t_place_algorithm& place_algorithm);
+
+static double get_estimated_delta_c(const t_placer_costs* costs,
+                                    const t_placer_opts& placer_opts,
+                                    const t_place_algorithm& place_algorithm,
+                                    double bb_delta_c,
+                                    double timing_delta_c);
+
+static bool use_move_candidates(const t_placer_opts& placer_opts,
+                                const t_noc_opts& noc_opts,
+                                const t_place_algorithm& place_algorithm);
+
+static void pick_best_move_candidate(t_pl_blocks_to_be_moved& blocks_affected,
+                                     t_pl_blocks_to_be_moved& candidate_blocks_affected,
+                                     float rlim,
+                                     const t_placer_costs* costs,
+                                     const PlaceDelayModel* delay_model,
+                                     const PlacerCriticalities* criticalities,
+                                     const t_placer_opts& placer_opts,
+                                     const t_place_algorithm& place_algorithm,
+                                     const PlacerState& placer_state);
+
+static void try_speculative_swaps(const t_annealing_state* state,
+                                  t_placer_costs* costs,
+                                  MoveGenerator& move_generator,
+                                  SetupTimingInfo* timing_info,
+                                  NetPinTimingInvalidator* pin_timing_invalidator,
+                                  const PlaceDelayModel* delay_model,
+                                  PlacerCriticalities* criticalities,
+                                  const t_placer_opts& placer_opts,
+                                  MoveTypeStat& move_type_stat,
+                                  const t_place_algorithm& place_algorithm,
+                                  float timing_bb_factor,
+                                  std::vector<std::unique_ptr<t_speculative_move>>& speculative_moves,
+                                  int num_moves,
+                                  t_placer_statistics* stats,
+                                  t_swap_stats& swap_stats,
+                                  PlacerState& placer_state);
+
 static void placement_inner_loop(const t_annealing_state* state,
                                  const t_placer_opts& placer_opts,
                                  const t_noc_opts& noc_opts,
@@ -304,6 +394,8 @@ static void placement_inner_loop(const t_annealing_state* state,
                                  MoveGenerator& move_generator,
                                  ManualMoveGenerator& manual_move_generator,
                                  t_pl_blocks_to_be_moved& blocks_affected,
+                                 t_pl_blocks_to_be_moved* candidate_blocks_affected,
+                                 std::vector<std::unique_ptr<t_speculative_move>>& speculative_moves,
                                  SetupTimingInfo* timing_info,
                                  const t_place_algorithm& place_algorithm,
                                  MoveTypeStat& move_type_stat,
@@ -323,6 +415,8 @@ static void calculate_reward_and_process_outcome(const t_placer_opts& placer_opt
                                                  const MoveOutcomeStats& move_outcome_stats,
                                                  double delta_c,
                                                  float timing_bb_factor,
+                                                 e_move_type move_type,
+                                                 const MoveTypeStat& move_type_stat,
                                                  MoveGenerator& move_generator);
 
 static void print_place_status_header(bool noc_enabled);
@@ -343,42 +437,56 @@ static void print_placement_swaps_stats(const t_annealing_state& state, const t_
 
 static void print_placement_move_types_stats(const MoveTypeStat& move_type_stat);
 
+static void save_anneal_checkpoint(const std::string& filename,
+                                   const t_annealing_state& state,
+                                   const BlkLocRegistry& blk_loc_registry,
+                                   int tot_iter,
+                                   int moves_since_cost_recompute,
+                                   int outer_crit_iter_count,
+                                   e_agent_state agent_state,
+                                   const MoveGenerator& move_generator,
+                                   const MoveGenerator& move_generator2);
+
 /**
  * @brief Copies the placement location variables into the global placement context.
  * @param blk_loc_registry The placement location variables to be copied.
  */
 static void copy_locs_to_global_state(const BlkLocRegistry& blk_loc_registry);
 
-/*****************************************************************************/
-void try_place(const Netlist<>& net_list,
-               const t_placer_opts& placer_opts,
-               t_annealing_sched annealing_sched,
-               const t_router_opts& router_opts,
-               const t_analysis_opts& analysis_opts,
-               const t_noc_opts& noc_opts,
-               t_chan_width_dist chan_width_dist,
-               t_det_routing_arch* det_routing_arch,
-               std::vector<t_segment_inf>& segment_inf,
-               t_direct_inf* directs,
-               int num_directs,
-               bool is_flat) {
-    /* Does almost all the work of placing a circuit.  Width_fac gives the   *
-     * width of the widest channel.  Place_cost_exp says what exponent the   *
-     * width should be taken to when calculating costs.  This allows a       *
-     * greater bias for anisotropic architectures.                           */
+/**
+ * @brief Returns true if candidate is a better placement than best.
+ *
+ * The total costs of different seeds are normalized differently and can't be
+ * compared, so timing-driven placements are compared by their estimated critical
+ * path delay (and then bounding box cost), and others by their bounding box cost.
+ */
+static bool is_better_seed_result(const t_placement_seed_result& candidate,
+                                  const t_placement_seed_result& best,
+                                  const t_placer_opts& placer_opts);
 
-    /*
-     * Currently, the functions that require is_flat as their parameter and are called during placement should
-     * receive is_flat as false. For example, if the RR graph of router lookahead is built here, it should be as
-     * if is_flat is false, even if is_flat is set to true from the command line.
-     */
-    VTR_ASSERT(!is_flat);
+/*****************************************************************************/
+/**
+ * @brief Runs the placer (initial placement, anneal and quench) once, from the
+ *        current state of the random number generator.
+ *
+ * The device, the timing graph and place_delay_model are only read, so they are
+ * shared by all the seeds of a --place_seeds run. The resulting placement is left
+ * in the returned placer state rather than copied to the global placement context.
+ */
+static std::unique_ptr<t_placement_seed_result> place_with_seed(const Netlist<>& net_list,
+                                                                const t_placer_opts& placer_opts,
+                                                                const t_annealing_sched& annealing_sched,
+                                                                const t_analysis_opts& analysis_opts,
+                                                                const t_noc_opts& noc_opts,
+                                                                std::unique_ptr<PlaceDelayModel>& place_delay_model,
+                                                                t_direct_inf* directs,
+                                                                int num_directs,
+                                                                bool is_flat) {
     auto& device_ctx = g_vpr_ctx.device();
     auto& atom_ctx = g_vpr_ctx.atom();
     auto& cluster_ctx = g_vpr_ctx.clustering();
 
     auto& timing_ctx = g_vpr_ctx.timing();
-    auto pre_place_timing_stats = timing_ctx.stats;
     int tot_iter, moves_since_cost_recompute, num_connections, outer_crit_iter_count;
     float first_crit_exponent;
 
@@ -396,44 +504,35 @@ void try_place(const Netlist<>& net_list,
 
     std::shared_ptr<SetupTimingInfo> timing_info;
     std::shared_ptr<PlacementDelayCalculator> placement_delay_calc;
-    std::unique_ptr<PlaceDelayModel> place_delay_model;
     std::unique_ptr<PlacerSetupSlacks> placer_setup_slacks;
     std::unique_ptr<PlacerCriticalities> placer_criticalities;
     std::unique_ptr<NetPinTimingInvalidator> pin_timing_invalidator;
 
     t_pl_blocks_to_be_moved blocks_affected(net_list.blocks().size());
 
-    // Swap statistics keep record of the number accepted/rejected/aborted swaps.
-    t_swap_stats swap_stats;
-
-    if (placer_opts.place_algorithm.is_timing_driven()) {
-        /*do this before the initial placement to avoid messing up the initial placement */
-        place_delay_model = alloc_lookups_and_delay_model(net_list,
-                                                          chan_width_dist,
-                                                          placer_opts,
-                                                          router_opts,
-                                                          det_routing_arch,
-                                                          segment_inf,
-                                                          directs,
-                                                          num_directs,
-                                                          is_flat);
-
-        if (isEchoFileEnabled(E_ECHO_PLACEMENT_DELTA_DELAY_MODEL)) {
-            place_delay_model->dump_echo(
-                getEchoFileName(E_ECHO_PLACEMENT_DELTA_DELAY_MODEL));
+    // Move buffers of the speculative (batched) annealer, only allocated when it is enabled
+    std::vector<std::unique_ptr<t_speculative_move>> speculative_moves;
+    if (placer_opts.place_move_batch_size > 1) {
+        for (int imove = 0; imove < placer_opts.place_move_batch_size; imove++) {
+            speculative_moves.push_back(std::make_unique<t_speculative_move>(net_list.blocks().size()));
         }
     }
 
-    g_vpr_ctx.mutable_placement().cube_bb = is_cube_bb(placer_opts.place_bounding_box_mode, device_ctx.rr_graph);
-    const bool cube_bb = g_vpr_ctx.placement().cube_bb;
+    // Scratch move of the serial annealer's candidate moves, only allocated when they are enabled
+    std::unique_ptr<t_pl_blocks_to_be_moved> candidate_blocks_affected;
+    if (placer_opts.place_move_candidates > 1) {
+        candidate_blocks_affected = std::make_unique<t_pl_blocks_to_be_moved>(net_list.blocks().size());
+    }
 
-    VTR_LOG("\n");
-    VTR_LOG("Bounding box mode is %s\n", (cube_bb ? "Cube" : "Per-layer"));
-    VTR_LOG("\n");
+    // Swap statistics keep record of the number accepted/rejected/aborted swaps.
+    t_swap_stats swap_stats;
+
+    const bool cube_bb = g_vpr_ctx.placement().cube_bb;
 
     int move_lim = (int)(annealing_sched.inner_num * pow(net_list.blocks().size(), 1.3333));
 
-    PlacerState placer_state;
+    auto placer_state_ptr = std::make_unique<PlacerState>();
+    PlacerState& placer_state = *placer_state_ptr;
     auto& place_move_ctx = placer_state.mutable_move();
     auto& blk_loc_registry = placer_state.mutable_blk_loc_registry();
     const auto& p_timing_ctx = placer_state.timing();
@@ -445,14 +544,15 @@ void try_place(const Netlist<>& net_list,
 
     std::unique_ptr<ManualMoveGenerator> manual_move_generator = std::make_unique<ManualMoveGenerator>(placer_state);
 
-    vtr::ScopedStartFinishTimer timer("Placement");
-
     if (noc_opts.noc) {
         normalize_noc_cost_weighting_factor(const_cast<t_noc_opts&>(noc_opts));
     }
 
     initial_placement(placer_opts, placer_opts.constraints_file.c_str(), noc_opts, blk_loc_registry);
 
+    //The fixed blocks are now placed (and won't move), so the legal macro head locations can be computed
+    g_vpr_ctx.mutable_placement().macro_footprints.init(g_vpr_ctx.placement().pl_macros, blk_loc_registry);
+
     //create the move generator based on the chosen strategy
     auto [move_generator, move_generator2] = create_move_generators(placer_state, placer_opts, move_lim, noc_opts.noc_centroid_weight);
 
@@ -473,6 +573,26 @@ void try_place(const Netlist<>& net_list,
 
 #endif /* ENABLE_ANALYTIC_PLACE */
 
+    //Resume an anneal saved by another VPR process from its placement
+    t_anneal_checkpoint resume_checkpoint;
+    const bool resume_anneal = !placer_opts.place_resume_file.empty();
+    if (resume_anneal) {
+        resume_checkpoint = read_anneal_checkpoint(placer_opts.place_resume_file);
+
+        blk_loc_registry.mutable_block_locs() = resume_checkpoint.block_locs;
+        blk_loc_registry.mutable_grid_blocks().load_from_block_locs(blk_loc_registry.block_locs());
+
+        if (!move_generator->restore_learned_state(resume_checkpoint.move_generator_state)
+            || !move_generator2->restore_learned_state(resume_checkpoint.move_generator2_state)) {
+            VPR_FATAL_ERROR(VPR_ERROR_PLACE,
+                            "Placement checkpoint '%s' was written with different placer (RL agent) options\n",
+                            placer_opts.place_resume_file.c_str());
+        }
+
+        VTR_LOG("Resuming the anneal saved in '%s' at temperature %g (after %d temperatures)\n",
+                placer_opts.place_resume_file.c_str(), resume_checkpoint.t, resume_checkpoint.num_temps);
+    }
+
     // Update physical pin values
     for (const ClusterBlockId block_id : cluster_ctx.clb_nlist.blocks()) {
         blk_loc_registry.place_sync_external_block_connections(block_id);
@@ -588,6 +708,12 @@ void try_place(const Netlist<>& net_list,
         first_crit_exponent = 0;
     }
 
+    if (placer_opts.place_congestion_weight > 0.) {
+        // the routing demand is loaded from the bounding boxes computed above
+        init_routing_demand_map(placer_opts.place_congestion_util_threshold);
+        costs.congestion_cost = update_congestion_cost();
+    }
+
     if (noc_opts.noc) {
         // get the costs associated with the NoC
         costs.noc_cost_terms.aggregate_bandwidth = comp_noc_aggregate_bandwidth_cost();
@@ -596,6 +722,10 @@ void try_place(const Netlist<>& net_list,
 
         // initialize all the noc normalization factors
         update_noc_normalization_factors(costs);
+
+        if (noc_opts.noc_reject_deadlocking_moves) {
+            init_noc_deadlock_check();
+        }
     }
 
     // set the starting total placement cost
@@ -685,6 +815,8 @@ void try_place(const Netlist<>& net_list,
     move_type_stat.blk_type_moves.resize({device_ctx.logical_block_types.size(), (int)e_move_type::NUMBER_OF_AUTO_MOVES}, 0);
     move_type_stat.accepted_moves.resize({device_ctx.logical_block_types.size(), (int)e_move_type::NUMBER_OF_AUTO_MOVES}, 0);
     move_type_stat.rejected_moves.resize({device_ctx.logical_block_types.size(), (int)e_move_type::NUMBER_OF_AUTO_MOVES}, 0);
+    move_type_stat.eval_time_ns.resize((int)e_move_type::NUMBER_OF_AUTO_MOVES, 0);
+    move_type_stat.timed_moves.resize((int)e_move_type::NUMBER_OF_AUTO_MOVES, 0);
 
     /* Get the first range limiter */
     float first_rlim = (float)max(device_ctx.grid.width() - 1, device_ctx.grid.height() - 1);
@@ -697,13 +829,25 @@ void try_place(const Netlist<>& net_list,
                             first_crit_exponent,
                             device_ctx.grid.get_num_layers());
 
-    /* Update the starting temperature for placement annealing to a more appropriate value */
-    state.t = starting_t(&state, &costs, annealing_sched,
-                         place_delay_model.get(), placer_criticalities.get(),
-                         placer_setup_slacks.get(), timing_info.get(), *move_generator,
-                         *manual_move_generator, pin_timing_invalidator.get(),
-                         blocks_affected, placer_opts, noc_opts, move_type_stat,
-                         swap_stats, placer_state);
+    if (resume_anneal) {
+        /* Continue from the saved temperature, with the random number sequence the anneal would have used */
+        state.t = resume_checkpoint.t;
+        state.restart_t = resume_checkpoint.restart_t;
+        state.alpha = resume_checkpoint.alpha;
+        state.num_temps = resume_checkpoint.num_temps;
+        state.rlim = resume_checkpoint.rlim;
+        state.crit_exponent = resume_checkpoint.crit_exponent;
+        state.move_lim = resume_checkpoint.move_lim;
+        vtr::srandom(int(resume_checkpoint.rand_state));
+    } else {
+        /* Update the starting temperature for placement annealing to a more appropriate value */
+        state.t = starting_t(&state, &costs, annealing_sched,
+                             place_delay_model.get(), placer_criticalities.get(),
+                             placer_setup_slacks.get(), timing_info.get(), *move_generator,
+                             *manual_move_generator, pin_timing_invalidator.get(),
+                             blocks_affected, placer_opts, noc_opts, move_type_stat,
+                             swap_stats, placer_state);
+    }
 
     if (!placer_opts.move_stats_file.empty()) {
         f_move_stats_file = std::unique_ptr<FILE, decltype(&vtr::fclose)>(
@@ -728,11 +872,44 @@ void try_place(const Netlist<>& net_list,
     //RL agent state definition
     e_agent_state agent_state = e_agent_state::EARLY_IN_THE_ANNEAL;
 
+    if (resume_anneal) {
+        tot_iter = resume_checkpoint.tot_iter;
+        moves_since_cost_recompute = resume_checkpoint.moves_since_cost_recompute;
+        outer_crit_iter_count = resume_checkpoint.outer_crit_iter_count;
+        if (resume_checkpoint.late_in_the_anneal) {
+            agent_state = e_agent_state::LATE_IN_THE_ANNEAL;
+        }
+    }
+
     std::unique_ptr<MoveGenerator> current_move_generator;
 
     //Define the timing bb weight factor for the agent's reward function
     float timing_bb_factor = REWARD_BB_TIMING_RELATIVE_WEIGHT;
 
+    //Coarse levels of the multilevel anneal, from the finest to the coarsest
+    std::vector<t_placement_level> placement_levels;
+    if (placer_opts.place_multilevel_levels > 0 && !skip_anneal) {
+        if (noc_opts.noc || resume_anneal) {
+            VTR_LOG_WARN("Multilevel placement is not supported with NoC placement or when resuming an anneal, annealing the flat netlist only\n");
+        } else {
+            placement_levels = coarsen_clustered_netlist(placer_opts.place_multilevel_levels,
+                                                         placer_opts.place_high_fanout_net,
+                                                         blk_loc_registry);
+        }
+    }
+
+    std::unique_ptr<AnnealTelemetryWriter> telemetry_writer;
+    std::unique_ptr<AnnealScheduleModel> schedule_model;
+    if (!skip_anneal) {
+        if (!placer_opts.place_anneal_telemetry_file.empty()) {
+            telemetry_writer = std::make_unique<AnnealTelemetryWriter>(placer_opts.place_anneal_telemetry_file);
+        }
+        if (!placer_opts.place_anneal_schedule_model_file.empty()) {
+            schedule_model = std::make_unique<AnnealScheduleModel>(placer_opts.place_anneal_schedule_model_file,
+                                                                   cluster_ctx.clb_nlist.blocks().size());
+        }
+    }
+
     if (!skip_anneal) {
         //Table header
         VTR_LOG("\n");
@@ -742,6 +919,12 @@ void try_place(const Netlist<>& net_list,
         do {
             vtr::Timer temperature_timer;
 
+            if (!placer_opts.place_checkpoint_file.empty()) {
+                save_anneal_checkpoint(placer_opts.place_checkpoint_file, state, blk_loc_registry,
+                                       tot_iter, moves_since_cost_recompute, outer_crit_iter_count,
+                                       agent_state, *move_generator, *move_generator2);
+            }
+
             outer_loop_update_timing_info(placer_opts, noc_opts, &costs, num_connections,
                                           state.crit_exponent, &outer_crit_iter_count,
                                           place_delay_model.get(), placer_criticalities.get(),
@@ -767,29 +950,53 @@ void try_place(const Netlist<>& net_list,
             assign_current_move_generator(move_generator, move_generator2,
                                           agent_state, placer_opts, false, current_move_generator);
 
+            //At the coarse levels of a multilevel anneal, move groups of blocks with proportionally fewer moves
+            int level = get_placement_level(state.num_temps, placement_levels.size(), placer_opts.place_multilevel_temps);
+            std::unique_ptr<MoveGenerator> level_move_generator;
+            t_annealing_state level_state = state;
+            if (level != OPEN) {
+                level_move_generator = std::make_unique<MultilevelMoveGenerator>(placer_state, *current_move_generator,
+                                                                                 placement_levels[level]);
+                level_state.move_lim = std::max(1, (int)((double)state.move_lim * placement_levels[level].num_coarse_blocks
+                                                         / cluster_ctx.clb_nlist.blocks().size()));
+            }
+
             //do a complete inner loop iteration
-            placement_inner_loop(&state, placer_opts, noc_opts,
+            placement_inner_loop(&level_state, placer_opts, noc_opts,
                                  inner_recompute_limit,
                                  &stats, &costs, &moves_since_cost_recompute,
                                  pin_timing_invalidator.get(), place_delay_model.get(),
                                  placer_criticalities.get(), placer_setup_slacks.get(),
-                                 *current_move_generator, *manual_move_generator,
-                                 blocks_affected, timing_info.get(),
+                                 level_move_generator ? *level_move_generator : *current_move_generator,
+                                 *manual_move_generator,
+                                 blocks_affected, candidate_blocks_affected.get(), speculative_moves, timing_info.get(),
                                  placer_opts.place_algorithm, move_type_stat,
                                  timing_bb_factor,
                                  swap_stats, placer_state);
+            level_move_generator.reset();
 
             //move the update used move_generator to its original variable
             update_move_generator(move_generator, move_generator2, agent_state,
                                   placer_opts, false, current_move_generator);
 
-            tot_iter += state.move_lim;
+            tot_iter += level_state.move_lim;
             ++state.num_temps;
 
             print_place_status(state, stats, temperature_timer.elapsed_sec(),
                                critical_path.delay(), sTNS, sWNS, tot_iter,
                                noc_opts.noc, costs.noc_cost_terms);
 
+            if (telemetry_writer) {
+                telemetry_writer->write_temperature(state, stats, costs, critical_path.delay(),
+                                                    temperature_timer.elapsed_sec());
+            }
+
+            if (schedule_model
+                && schedule_model->anneal_converged(stats, costs, placer_opts.place_algorithm.is_timing_driven())) {
+                VTR_LOG("Anneal converged according to the schedule model, skipping the remaining temperatures\n");
+                break;
+            }
+
             if (placer_opts.place_algorithm.is_timing_driven()
                 && placer_opts.place_agent_multistate
                 && agent_state == e_agent_state::EARLY_IN_THE_ANNEAL) {
@@ -803,6 +1010,7 @@ void try_place(const Netlist<>& net_list,
                     costs.cost, costs.bb_cost, costs.timing_cost, state.t);
             update_screen(ScreenUpdatePriority::MINOR, msg, PLACEMENT,
                           timing_info);
+            save_snapshot_image_checkpoint(PLACEMENT, state.num_temps, blk_loc_registry);
 
             //#ifdef VERBOSE
             //            if (getEchoEnabled()) {
@@ -841,7 +1049,7 @@ void try_place(const Netlist<>& net_list,
                              pin_timing_invalidator.get(), place_delay_model.get(),
                              placer_criticalities.get(), placer_setup_slacks.get(),
                              *current_move_generator, *manual_move_generator,
-                             blocks_affected, timing_info.get(),
+                             blocks_affected, candidate_blocks_affected.get(), speculative_moves, timing_info.get(),
                              placer_opts.place_quench_algorithm, move_type_stat,
                              timing_bb_factor,
                              swap_stats, placer_state);
@@ -924,23 +1132,6 @@ void try_place(const Netlist<>& net_list,
 
         critical_path = timing_info->least_slack_critical_path();
 
-        if (isEchoFileEnabled(E_ECHO_FINAL_PLACEMENT_TIMING_GRAPH)) {
-            tatum::write_echo(
-                getEchoFileName(E_ECHO_FINAL_PLACEMENT_TIMING_GRAPH),
-                *timing_ctx.graph, *timing_ctx.constraints,
-                *placement_delay_calc, timing_info->analyzer());
-
-            tatum::NodeId debug_tnode = id_or_pin_name_to_tnode(
-                analysis_opts.echo_dot_timing_graph_node);
-            write_setup_timing_graph_dot(
-                getEchoFileName(E_ECHO_FINAL_PLACEMENT_TIMING_GRAPH)
-                    + std::string(".dot"),
-                *timing_info, debug_tnode);
-        }
-
-        generate_post_place_timing_reports(placer_opts, analysis_opts, *timing_info,
-                                           *placement_delay_calc, is_flat, blk_loc_registry);
-
         /* Print critical path delay metrics */
         VTR_LOG("\n");
         print_setup_timing_summary(*timing_ctx.constraints,
@@ -952,6 +1143,16 @@ void try_place(const Netlist<>& net_list,
             costs.cost, costs.bb_cost, costs.timing_cost, width_fac);
     VTR_LOG("Placement cost: %g, bb_cost: %g, td_cost: %g, \n", costs.cost,
             costs.bb_cost, costs.timing_cost);
+    if (placer_opts.place_congestion_weight > 0.) {
+        VTR_LOG("Placement congestion cost: %g\n", costs.congestion_cost);
+    }
+
+    //Predict the routability of the placement from its estimated routing demand
+    t_routing_demand_stats demand_stats = estimate_routing_demand();
+    VTR_LOG("Placement estimated channel utilization (RUDY): average CHANX %.3f CHANY %.3f, max CHANX %.3f CHANY %.3f\n",
+            demand_stats.avg_chanx_util, demand_stats.avg_chany_util,
+            demand_stats.max_chanx_util, demand_stats.max_chany_util);
+    VTR_LOG("Placement estimated channels over capacity: %.2f%%\n", 100. * demand_stats.overused_fraction);
     // print the noc costs info
     if (noc_opts.noc) {
         print_noc_costs("\nNoC Placement Costs", costs, noc_opts);
@@ -965,6 +1166,7 @@ void try_place(const Netlist<>& net_list,
     }
 
     update_screen(ScreenUpdatePriority::MAJOR, msg, PLACEMENT, timing_info);
+    save_snapshot_image(PLACEMENT, blk_loc_registry);
     // Print out swap statistics
     print_resources_utilization(blk_loc_registry);
 
@@ -972,24 +1174,164 @@ void try_place(const Netlist<>& net_list,
 
     print_placement_move_types_stats(move_type_stat);
 
-    if (noc_opts.noc) {
-        write_noc_placement_file(noc_opts.noc_placement_file_name, blk_loc_registry.block_locs());
-    }
-
     free_placement_structs(noc_opts);
     free_try_swap_arrays();
 
     print_timing_stats("Placement Quench", post_quench_timing_stats,
                        pre_quench_timing_stats);
-    print_timing_stats("Placement Total ", timing_ctx.stats,
-                       pre_place_timing_stats);
-
     VTR_LOG("update_td_costs: connections %g nets %g sum_nets %g total %g\n",
             p_runtime_ctx.f_update_td_costs_connections_elapsed_sec,
             p_runtime_ctx.f_update_td_costs_nets_elapsed_sec,
             p_runtime_ctx.f_update_td_costs_sum_nets_elapsed_sec,
             p_runtime_ctx.f_update_td_costs_total_elapsed_sec);
 
+    //The placement is kept in placer_state until the best seed is known
+    g_vpr_ctx.mutable_placement().unlock_loc_vars();
+
+    auto result = std::make_unique<t_placement_seed_result>();
+    result->placer_state = std::move(placer_state_ptr);
+    result->costs = costs;
+    result->cpd = placer_opts.place_algorithm.is_timing_driven() ? critical_path.delay() : INVALID_DELAY;
+    result->timing_info = timing_info;
+    result->placement_delay_calc = placement_delay_calc;
+    return result;
+}
+
+void try_place(const Netlist<>& net_list,
+               const t_placer_opts& placer_opts,
+               t_annealing_sched annealing_sched,
+               const t_router_opts& router_opts,
+               const t_analysis_opts& analysis_opts,
+               const t_noc_opts& noc_opts,
+               t_chan_width_dist chan_width_dist,
+               t_det_routing_arch* det_routing_arch,
+               std::vector<t_segment_inf>& segment_inf,
+               t_direct_inf* directs,
+               int num_directs,
+               bool is_flat) {
+    /* Does almost all the work of placing a circuit.  Width_fac gives the   *
+     * width of the widest channel.  Place_cost_exp says what exponent the   *
+     * width should be taken to when calculating costs.  This allows a       *
+     * greater bias for anisotropic architectures.                           */
+
+    /*
+     * Currently, the functions that require is_flat as their parameter and are called during placement should
+     * receive is_flat as false. For example, if the RR graph of router lookahead is built here, it should be as
+     * if is_flat is false, even if is_flat is set to true from the command line.
+     */
+    VTR_ASSERT(!is_flat);
+
+    //NoC placement updates the global NoC traffic flow routes, which can't be restored per seed
+    if (placer_opts.place_seeds > 1 && noc_opts.noc) {
+        VPR_FATAL_ERROR(VPR_ERROR_PLACE,
+                        "Placing with multiple seeds (--place_seeds) is not supported with NoC placement.\n");
+    }
+
+    //A resumed anneal continues a single anneal, whose NoC traffic flow routes are not saved
+    if (!placer_opts.place_resume_file.empty() && (placer_opts.place_seeds > 1 || noc_opts.noc)) {
+        VPR_FATAL_ERROR(VPR_ERROR_PLACE,
+                        "Resuming an anneal (--place_resume) is not supported with NoC placement or multiple seeds (--place_seeds).\n");
+    }
+
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& timing_ctx = g_vpr_ctx.timing();
+    auto pre_place_timing_stats = timing_ctx.stats;
+
+    std::unique_ptr<PlaceDelayModel> place_delay_model;
+
+    if (placer_opts.place_algorithm.is_timing_driven()) {
+        /*do this before the initial placement to avoid messing up the initial placement */
+        place_delay_model = alloc_lookups_and_delay_model(net_list,
+                                                          chan_width_dist,
+                                                          placer_opts,
+                                                          router_opts,
+                                                          det_routing_arch,
+                                                          segment_inf,
+                                                          directs,
+                                                          num_directs,
+                                                          is_flat);
+
+        if (isEchoFileEnabled(E_ECHO_PLACEMENT_DELTA_DELAY_MODEL)) {
+            place_delay_model->dump_echo(
+                getEchoFileName(E_ECHO_PLACEMENT_DELTA_DELAY_MODEL));
+        }
+    }
+
+    g_vpr_ctx.mutable_placement().cube_bb = is_cube_bb(placer_opts.place_bounding_box_mode, device_ctx.rr_graph);
+
+    VTR_LOG("\n");
+    VTR_LOG("Bounding box mode is %s\n", (g_vpr_ctx.placement().cube_bb ? "Cube" : "Per-layer"));
+    VTR_LOG("\n");
+
+    vtr::ScopedStartFinishTimer timer("Placement");
+
+    const int num_seeds = std::max(placer_opts.place_seeds, 1);
+    std::unique_ptr<t_placement_seed_result> best;
+    for (int iseed = 0; iseed < num_seeds; iseed++) {
+        const int seed = placer_opts.seed + iseed;
+        if (num_seeds > 1) {
+            VTR_LOG("\nPlacement with seed %d (%d of %d)\n", seed, iseed + 1, num_seeds);
+            //The first seed continues from the generator state set up by SetupVPR,
+            //so that its result matches a single-seed run
+            if (iseed > 0) {
+                vtr::srandom(seed);
+            }
+        }
+
+        auto result = place_with_seed(net_list, placer_opts, annealing_sched, analysis_opts, noc_opts,
+                                      place_delay_model, directs, num_directs, is_flat);
+        result->seed = seed;
+
+        if (!best || is_better_seed_result(*result, *best, placer_opts)) {
+            best = std::move(result);
+        }
+    }
+
+    if (place_delay_model) {
+        place_delay_model->persist();
+    }
+
+    if (num_seeds > 1) {
+        VTR_LOG("\n");
+        if (placer_opts.place_algorithm.is_timing_driven()) {
+            VTR_LOG("Keeping the placement of seed %d: bb_cost: %g, estimated CPD: %g ns\n",
+                    best->seed, best->costs.bb_cost, 1e9 * best->cpd);
+        } else {
+            VTR_LOG("Keeping the placement of seed %d: bb_cost: %g\n",
+                    best->seed, best->costs.bb_cost);
+        }
+    }
+
+    const BlkLocRegistry& blk_loc_registry = best->placer_state->blk_loc_registry();
+
+    if (placer_opts.place_algorithm.is_timing_driven()) {
+        VTR_ASSERT(best->timing_info);
+
+        if (isEchoFileEnabled(E_ECHO_FINAL_PLACEMENT_TIMING_GRAPH)) {
+            tatum::write_echo(
+                getEchoFileName(E_ECHO_FINAL_PLACEMENT_TIMING_GRAPH),
+                *timing_ctx.graph, *timing_ctx.constraints,
+                *best->placement_delay_calc, best->timing_info->analyzer());
+
+            tatum::NodeId debug_tnode = id_or_pin_name_to_tnode(
+                analysis_opts.echo_dot_timing_graph_node);
+            write_setup_timing_graph_dot(
+                getEchoFileName(E_ECHO_FINAL_PLACEMENT_TIMING_GRAPH)
+                    + std::string(".dot"),
+                *best->timing_info, debug_tnode);
+        }
+
+        generate_post_place_timing_reports(placer_opts, analysis_opts, *best->timing_info,
+                                           *best->placement_delay_calc, is_flat, blk_loc_registry);
+    }
+
+    if (noc_opts.noc) {
+        write_noc_placement_file(noc_opts.noc_placement_file_name, blk_loc_registry.block_locs());
+    }
+
+    print_timing_stats("Placement Total ", timing_ctx.stats,
+                       pre_place_timing_stats);
+
     copy_locs_to_global_state(blk_loc_registry);
 }
 
@@ -1049,6 +1391,8 @@ static void placement_inner_loop(const t_annealing_state* state,
                                  MoveGenerator& move_generator,
                                  ManualMoveGenerator& manual_move_generator,
                                  t_pl_blocks_to_be_moved& blocks_affected,
+                                 t_pl_blocks_to_be_moved* candidate_blocks_affected,
+                                 std::vector<std::unique_ptr<t_speculative_move>>& speculative_moves,
                                  SetupTimingInfo* timing_info,
                                  const t_place_algorithm& place_algorithm,
                                  MoveTypeStat& move_type_stat,
@@ -1060,24 +1404,39 @@ static void placement_inner_loop(const t_annealing_state* state,
 
     stats->reset();
 
+    /* The centroid moves use the sink coordinate sums of the nets of the current placement */
+    init_net_sink_loc_sums(criticalities, placer_state);
+
     bool manual_move_enabled = false;
 
-    /* Inner loop begins */
-    for (int inner_iter = 0, inner_crit_iter_count = 1; inner_iter < state->move_lim; inner_iter++) {
-        e_move_result swap_result = try_swap(state, costs, move_generator,
-                                             manual_move_generator, timing_info, pin_timing_invalidator,
-                                             blocks_affected, delay_model, criticalities, setup_slacks,
-                                             placer_opts, noc_opts, move_type_stat, place_algorithm,
-                                             timing_bb_factor, manual_move_enabled, swap_stats, placer_state);
+    const bool speculative = use_speculative_moves(placer_opts, noc_opts, place_algorithm);
 
-        if (swap_result == ACCEPTED) {
-            /* Move was accepted.  Update statistics that are useful for the annealing schedule. */
-            stats->single_swap_update(*costs);
-            swap_stats.num_swap_accepted++;
-        } else if (swap_result == ABORTED) {
-            swap_stats.num_swap_aborted++;
-        } else { // swap_result == REJECTED
-            swap_stats.num_swap_rejected++;
+    /* Inner loop begins */
+    for (int inner_iter = 0, inner_crit_iter_count = 1; inner_iter < state->move_lim;) {
+        //Number of moves attempted in this iteration
+        int num_moves = 1;
+
+        if (speculative) {
+            num_moves = std::min<int>(speculative_moves.size(), state->move_lim - inner_iter);
+            try_speculative_swaps(state, costs, move_generator, timing_info, pin_timing_invalidator,
+                                  delay_model, criticalities, placer_opts, move_type_stat, place_algorithm,
+                                  timing_bb_factor, speculative_moves, num_moves, stats, swap_stats, placer_state);
+        } else {
+            e_move_result swap_result = try_swap(state, costs, move_generator,
+                                                 manual_move_generator, timing_info, pin_timing_invalidator,
+                                                 blocks_affected, candidate_blocks_affected, delay_model, criticalities, setup_slacks,
+                                                 placer_opts, noc_opts, move_type_stat, place_algorithm,
+                                                 timing_bb_factor, manual_move_enabled, swap_stats, placer_state);
+
+            if (swap_result == ACCEPTED) {
+                /* Move was accepted.  Update statistics that are useful for the annealing schedule. */
+                stats->single_swap_update(*costs);
+                swap_stats.num_swap_accepted++;
+            } else if (swap_result == ABORTED) {
+                swap_stats.num_swap_aborted++;
+            } else { // swap_result == REJECTED
+                swap_stats.num_swap_rejected++;
+            }
         }
 
         if (place_algorithm.is_timing_driven()) {
@@ -1085,7 +1444,7 @@ static void placement_inner_loop(const t_annealing_state* state,
              * We do this only once in a while, since it is expensive.
              */
             if (inner_crit_iter_count >= inner_recompute_limit
-                && inner_iter != state->move_lim - 1) { /*on last iteration don't recompute */
+                && inner_iter + num_moves < state->move_lim) { /*on last iteration don't recompute */
 
                 inner_crit_iter_count = 0;
 #ifdef VERBOSE
@@ -1101,7 +1460,7 @@ static void placement_inner_loop(const t_annealing_state* state,
                                            setup_slacks, pin_timing_invalidator,
                                            timing_info, costs, placer_state);
             }
-            inner_crit_iter_count++;
+            inner_crit_iter_count += num_moves;
         }
 
         /* Lines below prevent too much round-off error from accumulating
@@ -1109,7 +1468,7 @@ static void placement_inner_loop(const t_annealing_state* state,
          * This round-off can lead to error checks failing because the cost
          * is different from what you get when you recompute from scratch.
          */
-        ++(*moves_since_cost_recompute);
+        *moves_since_cost_recompute += num_moves;
         if (*moves_since_cost_recompute > MAX_MOVES_BEFORE_RECOMPUTE) {
             //VTR_LOG("recomputing costs from scratch, old bb_cost is %g\n", costs->bb_cost);
             recompute_costs_from_scratch(placer_opts, noc_opts, delay_model,
@@ -1118,15 +1477,25 @@ static void placement_inner_loop(const t_annealing_state* state,
             *moves_since_cost_recompute = 0;
         }
 
-        if (placer_opts.placement_saves_per_temperature >= 1 && inner_iter > 0
-            && (inner_iter + 1) % (state->move_lim / placer_opts.placement_saves_per_temperature) == 0) {
-            std::string filename = vtr::string_fmt("placement_%03d_%03d.place",
-                                                   state->num_temps + 1, inner_placement_save_count);
-            VTR_LOG("Saving placement to file at temperature move %d / %d: %s\n",
-                    inner_iter, state->move_lim, filename.c_str());
-            print_place(nullptr, nullptr, filename.c_str(), placer_state.block_locs());
-            ++inner_placement_save_count;
+        if (placer_opts.placement_saves_per_temperature >= 1) {
+            const int save_interval = state->move_lim / placer_opts.placement_saves_per_temperature;
+            //Last move of this iteration which triggers a save (if any)
+            int save_iter = inner_iter + num_moves - 1;
+            if (save_interval > 0) {
+                save_iter -= (save_iter + 1) % save_interval;
+            }
+
+            if (save_interval > 0 && save_iter > 0 && save_iter >= inner_iter) {
+                std::string filename = vtr::string_fmt("placement_%03d_%03d.place",
+                                                       state->num_temps + 1, inner_placement_save_count);
+                VTR_LOG("Saving placement to file at temperature move %d / %d: %s\n",
+                        save_iter, state->move_lim, filename.c_str());
+                print_place(nullptr, nullptr, filename.c_str(), placer_state.block_locs());
+                ++inner_placement_save_count;
+            }
         }
+
+        inner_iter += num_moves;
     }
 
     /* Calculate the success_rate and std_dev of the costs. */
@@ -1173,6 +1542,8 @@ static float starting_t(const t_annealing_state* state,
 
     auto& cluster_ctx = g_vpr_ctx.clustering();
 
+    init_net_sink_loc_sums(criticalities, placer_state);
+
     /* Use to calculate the average of cost when swap is accepted. */
     int num_accepted = 0;
 
@@ -1197,7 +1568,7 @@ static float starting_t(const t_annealing_state* state,
         //Will not deploy setup slack analysis, so omit crit_exponenet and setup_slack
         e_move_result swap_result = try_swap(state, costs, move_generator,
                                              manual_move_generator, timing_info, pin_timing_invalidator,
-                                             blocks_affected, delay_model, criticalities, setup_slacks,
+                                             blocks_affected, /*candidate_blocks_affected=*/nullptr, delay_model, criticalities, setup_slacks,
                                              placer_opts, noc_opts, move_type_stat, placer_opts.place_algorithm,
                                              REWARD_BB_TIMING_RELATIVE_WEIGHT, manual_move_enabled, swap_stats, placer_state);
 
@@ -1260,6 +1631,7 @@ static e_move_result try_swap(const t_annealing_state* state,
                               SetupTimingInfo* timing_info,
                               NetPinTimingInvalidator* pin_timing_invalidator,
                               t_pl_blocks_to_be_moved& blocks_affected,
+                              t_pl_blocks_to_be_moved* candidate_blocks_affected,
                               const PlaceDelayModel* delay_model,
                               PlacerCriticalities* criticalities,
                               PlacerSetupSlacks* setup_slacks,
@@ -1291,6 +1663,7 @@ static e_move_result try_swap(const t_annealing_state* state,
 
     swap_stats.num_ts_called++;
 
+    auto move_start_time = std::chrono::steady_clock::now();
     MoveOutcomeStats move_outcome_stats;
 
     /* I'm using negative values of proposed_net_cost as a flag, *
@@ -1334,6 +1707,13 @@ static e_move_result try_swap(const t_annealing_state* state,
     } else {
         //Generate a new move (perturbation) used to explore the space of possible placements
         create_move_outcome = move_generator.propose_move(blocks_affected, proposed_action, rlim, placer_opts, criticalities);
+
+        //Try other locations for the moved block, and keep the most promising move
+        if (create_move_outcome == e_create_move::VALID && candidate_blocks_affected
+            && use_move_candidates(placer_opts, noc_opts, place_algorithm)) {
+            pick_best_move_candidate(blocks_affected, *candidate_blocks_affected, rlim, costs,
+                                     delay_model, criticalities, placer_opts, place_algorithm, placer_state);
+        }
     }
 
     if (proposed_action.logical_blk_type_index != -1) { //if the agent proposed the block type, then collect the block type stat
@@ -1441,8 +1821,19 @@ static e_move_result try_swap(const t_annealing_state* state,
             delta_c += calculate_noc_cost(noc_delta_c, costs->noc_cost_norm_factors, noc_opts);
         }
 
+        double congestion_delta_c = 0.; // change in the routing congestion cost
+        if (placer_opts.place_congestion_weight > 0.) {
+            congestion_delta_c = find_affected_nets_congestion_delta();
+            delta_c += placer_opts.place_congestion_weight * congestion_delta_c * costs->bb_cost_norm;
+        }
+
         /* 1 -> move accepted, 0 -> rejected. */
-        move_outcome = assess_swap(delta_c, state->t);
+        if (noc_opts.noc && noc_proposed_routes_deadlock()) {
+            // the proposed traffic flow routes could deadlock
+            move_outcome = REJECTED;
+        } else {
+            move_outcome = assess_swap(delta_c, state->t);
+        }
 
         //Updates the manual_move_state members and displays costs to the user to decide whether to ACCEPT/REJECT manual move.
 #ifndef NO_GRAPHICS
@@ -1454,6 +1845,7 @@ static e_move_result try_swap(const t_annealing_state* state,
         if (move_outcome == ACCEPTED) {
             costs->cost += delta_c;
             costs->bb_cost += bb_delta_c;
+            costs->congestion_cost += congestion_delta_c;
 
             if (place_algorithm == SLACK_TIMING_PLACE) {
                 /* Update the timing driven cost as usual */
@@ -1483,6 +1875,7 @@ static e_move_result try_swap(const t_annealing_state* state,
 
             /* Update clb data structures since we kept the move. */
             commit_move_blocks(blocks_affected, placer_state.mutable_grid_blocks());
+            update_net_sink_loc_sums(blocks_affected, placer_state);
 
             if (proposed_action.logical_blk_type_index != -1) { //if the agent proposed the block type, then collect the block type stat
                 ++move_type_stat.accepted_moves[proposed_action.logical_blk_type_index][(int)proposed_action.move_type];
@@ -1560,8 +1953,13 @@ static e_move_result try_swap(const t_annealing_state* state,
     // the move generators status since this outcome is not a direct
     // consequence of the move generator
     if (!router_block_move) {
+        int64_t move_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - move_start_time).count();
+        move_outcome_stats.elapsed_time = 1e-9 * move_time_ns;
+        move_type_stat.add_eval_time(proposed_action.move_type, move_time_ns);
+
         calculate_reward_and_process_outcome(placer_opts, move_outcome_stats,
-                                             delta_c, timing_bb_factor, move_generator);
+                                             delta_c, timing_bb_factor, proposed_action.move_type,
+                                             move_type_stat, move_generator);
     }
 
 #ifdef VTR_ENABLE_DEBUG_LOGGING
@@ -1584,6 +1982,364 @@ static e_move_result try_swap(const t_annealing_state* state,
     return move_outcome;
 }
 
+/**
+ * @brief Returns true if placement_inner_loop() should propose and evaluate moves in speculative batches.
+ *
+ * Batching is only supported by the cost formulations whose move cost depends solely on
+ * the placement (i.e. not by slack_timing, which runs a timing update per move), not
+ * with NoC placement since the NoC cost update re-routes traffic flows in place, and not
+ * with the congestion cost, which estimate_move_cost_deltas() doesn't estimate.
+ */
+static bool use_speculative_moves(const t_placer_opts& placer_opts,
+                                  const t_noc_opts& noc_opts,
+                                  const t_place_algorithm& place_algorithm) {
+    if (placer_opts.place_move_batch_size <= 1 || noc_opts.noc || placer_opts.place_congestion_weight > 0.) {
+        return false;
+    }
+
+    return place_algorithm == BOUNDING_BOX_PLACE || place_algorithm == CRITICALITY_TIMING_PLACE;
+}
+
+/**
+ * @brief Returns the change in placement cost of a move from its bounding box and timing cost changes.
+ *
+ * Only for the cost formulations supported by estimate_move_cost_deltas() (bounding_box and criticality_timing).
+ */
+static double get_estimated_delta_c(const t_placer_costs* costs,
+                                    const t_placer_opts& placer_opts,
+                                    const t_place_algorithm& place_algorithm,
+                                    double bb_delta_c,
+                                    double timing_delta_c) {
+    if (place_algorithm == CRITICALITY_TIMING_PLACE) {
+        return (1 - placer_opts.timing_tradeoff) * bb_delta_c * costs->bb_cost_norm
+               + placer_opts.timing_tradeoff * timing_delta_c * costs->timing_cost_norm;
+    }
+    VTR_ASSERT_SAFE(place_algorithm == BOUNDING_BOX_PLACE);
+    return bb_delta_c * costs->bb_cost_norm;
+}
+
+/**
+ * @brief Returns true if try_swap() should pick the best of several candidate moves (see pick_best_move_candidate()).
+ *
+ * As for the speculative moves, the candidates are only supported by the cost formulations whose move cost
+ * can be estimated without applying the move, and not with NoC placement or the congestion cost.
+ */
+static bool use_move_candidates(const t_placer_opts& placer_opts,
+                                const t_noc_opts& noc_opts,
+                                const t_place_algorithm& place_algorithm) {
+    if (placer_opts.place_move_candidates <= 1 || noc_opts.noc || placer_opts.place_congestion_weight > 0.) {
+        return false;
+    }
+
+    return place_algorithm == BOUNDING_BOX_PLACE || place_algorithm == CRITICALITY_TIMING_PLACE;
+}
+
+/**
+ * @brief Replaces the proposed move by the best of placer_opts.place_move_candidates moves of the same block.
+ *
+ * The other candidates move the (first) block of the proposed move to random locations within rlim, as a
+ * uniform move would. All the candidates are costed against the current placement with estimate_move_cost_deltas(),
+ * and blocks_affected is left with the one with the lowest estimated cost change. This move then goes through
+ * the regular (exact) cost evaluation and acceptance test, so the candidates only change which move is attempted.
+ *
+ * A proposed move whose cost can't be estimated is kept as is.
+ */
+static void pick_best_move_candidate(t_pl_blocks_to_be_moved& blocks_affected,
+                                     t_pl_blocks_to_be_moved& candidate_blocks_affected,
+                                     float rlim,
+                                     const t_placer_costs* costs,
+                                     const PlaceDelayModel* delay_model,
+                                     const PlacerCriticalities* criticalities,
+                                     const t_placer_opts& placer_opts,
+                                     const t_place_algorithm& place_algorithm,
+                                     const PlacerState& placer_state) {
+    const auto& clb_nlist = g_vpr_ctx.clustering().clb_nlist;
+    const auto& blk_loc_registry = placer_state.blk_loc_registry();
+
+    std::vector<ClusterNetId> affected_nets;
+    double bb_delta_c = 0.;
+    double timing_delta_c = 0.;
+
+    if (!estimate_move_cost_deltas(place_algorithm, delay_model, criticalities,
+                                   blocks_affected, affected_nets, bb_delta_c, timing_delta_c)) {
+        return;
+    }
+    double best_delta_c = get_estimated_delta_c(costs, placer_opts, place_algorithm, bb_delta_c, timing_delta_c);
+
+    const ClusterBlockId b_from = blocks_affected.moved_blocks[0].block_num;
+    const t_pl_loc from = blocks_affected.moved_blocks[0].old_loc;
+    const t_logical_block_type_ptr cluster_from_type = clb_nlist.block_type(b_from);
+
+    for (int icandidate = 1; icandidate < placer_opts.place_move_candidates; icandidate++) {
+        candidate_blocks_affected.clear_move_blocks();
+
+        t_pl_loc to;
+        if (!find_to_loc_uniform(cluster_from_type, rlim, from, to, b_from, blk_loc_registry)) {
+            continue;
+        }
+
+        if (create_move(candidate_blocks_affected, b_from, to, blk_loc_registry) != e_create_move::VALID
+            || !floorplan_legal(candidate_blocks_affected)) {
+            continue;
+        }
+
+        if (!estimate_move_cost_deltas(place_algorithm, delay_model, criticalities,
+                                       candidate_blocks_affected, affected_nets, bb_delta_c, timing_delta_c)) {
+            continue;
+        }
+
+        double delta_c = get_estimated_delta_c(costs, placer_opts, place_algorithm, bb_delta_c, timing_delta_c);
+        if (delta_c < best_delta_c) {
+            best_delta_c = delta_c;
+            blocks_affected.swap(candidate_blocks_affected);
+        }
+    }
+
+    candidate_blocks_affected.clear_move_blocks();
+}
+
+/**
+ * @brief Attempts num_moves moves whose costs are evaluated speculatively (and concurrently).
+ *
+ * The moves are proposed one after the other against the current placement, so the proposals
+ * themselves (and the random number stream) are identical to the serial annealer. Their costs
+ * are then estimated concurrently by estimate_move_cost_deltas(), which only reads the placement.
+ *
+ * The moves are finally processed serially in proposal order:
+ *  - A move involving a block or location changed by an earlier move of the batch is stale and aborted.
+ *  - A move sharing a net with an earlier accepted move is re-estimated against the updated placement.
+ *  - A move whose cost could not be estimated speculatively is evaluated with the regular incremental
+ *    cost update (see find_affected_nets_and_update_costs()).
+ *
+ * Rejected moves are never applied, which is where the speed-up comes from since most moves are
+ * rejected for most of the anneal. Accepted moves are applied and committed with the regular
+ * incremental cost update, so the placement costs are exactly those the serial annealer would get.
+ * Since only the cost estimation is parallel, the result does not depend on the number of workers.
+ */
+static void try_speculative_swaps(const t_annealing_state* state,
+                                  t_placer_costs* costs,
+                                  MoveGenerator& move_generator,
+                                  SetupTimingInfo* timing_info,
+                                  NetPinTimingInvalidator* pin_timing_invalidator,
+                                  const PlaceDelayModel* delay_model,
+                                  PlacerCriticalities* criticalities,
+                                  const t_placer_opts& placer_opts,
+                                  MoveTypeStat& move_type_stat,
+                                  const t_place_algorithm& place_algorithm,
+                                  float timing_bb_factor,
+                                  std::vector<std::unique_ptr<t_speculative_move>>& speculative_moves,
+                                  int num_moves,
+                                  t_placer_statistics* stats,
+                                  t_swap_stats& swap_stats,
+                                  PlacerState& placer_state) {
+    const auto& clb_nlist = g_vpr_ctx.clustering().clb_nlist;
+
+    VTR_ASSERT_SAFE(num_moves <= (int)speculative_moves.size());
+
+    auto get_delta_c = [&](double bb_delta_c, double timing_delta_c) {
+        return get_estimated_delta_c(costs, placer_opts, place_algorithm, bb_delta_c, timing_delta_c);
+    };
+
+    /* Propose all the moves against the current placement */
+    for (int imove = 0; imove < num_moves; imove++) {
+        t_speculative_move& move = *speculative_moves[imove];
+        move.proposed_action = {e_move_type::UNIFORM, -1};
+        move.estimated = false;
+        auto propose_start_time = std::chrono::steady_clock::now();
+
+        swap_stats.num_ts_called++;
+
+        /* Allow some fraction of moves to not be restricted by rlim, */
+        /* in the hopes of better escaping local minima.              */
+        float rlim;
+        if (placer_opts.rlim_escape_fraction > 0. && vtr::frand() < placer_opts.rlim_escape_fraction) {
+            rlim = std::numeric_limits<float>::infinity();
+        } else {
+            rlim = state->rlim;
+        }
+
+        move.create_move_outcome = move_generator.propose_move(move.blocks_affected, move.proposed_action,
+                                                               rlim, placer_opts, criticalities);
+        move.eval_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - propose_start_time).count();
+
+        if (move.proposed_action.logical_blk_type_index != -1) {
+            ++move_type_stat.blk_type_moves[move.proposed_action.logical_blk_type_index][(int)move.proposed_action.move_type];
+        }
+    }
+
+    /* Estimate the move costs concurrently. This only reads the placement state. */
+    auto estimate_move = [&](size_t imove) {
+        t_speculative_move& move = *speculative_moves[imove];
+        if (move.create_move_outcome == e_create_move::VALID) {
+            auto estimate_start_time = std::chrono::steady_clock::now();
+            move.estimated = estimate_move_cost_deltas(place_algorithm, delay_model, criticalities,
+                                                        move.blocks_affected, move.affected_nets,
+                                                        move.bb_delta_c, move.timing_delta_c);
+            move.eval_time_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - estimate_start_time).count();
+        }
+    };
+
+#ifdef VPR_USE_TBB
+    tbb::parallel_for(size_t(0), size_t(num_moves), estimate_move);
+#else
+    for (size_t imove = 0; imove < size_t(num_moves); imove++) {
+        estimate_move(imove);
+    }
+#endif
+
+    /* Accept/reject and commit the moves in proposal order */
+    std::unordered_set<ClusterBlockId> moved_blocks;
+    std::unordered_set<t_pl_loc> moved_locs;
+    std::unordered_set<ClusterNetId> modified_nets;
+
+    for (int imove = 0; imove < num_moves; imove++) {
+        t_speculative_move& move = *speculative_moves[imove];
+        t_pl_blocks_to_be_moved& blocks_affected = move.blocks_affected;
+        auto commit_start_time = std::chrono::steady_clock::now();
+
+        MoveOutcomeStats move_outcome_stats;
+        e_move_result move_outcome = ABORTED;
+        double delta_c = 0.;
+        double bb_delta_c = 0.;
+        double timing_delta_c = 0.;
+
+        bool stale = false;
+        if (move.create_move_outcome == e_create_move::VALID) {
+            for (const t_pl_moved_block& moved_block : blocks_affected.moved_blocks) {
+                if (moved_blocks.count(moved_block.block_num)
+                    || moved_locs.count(moved_block.old_loc)
+                    || moved_locs.count(moved_block.new_loc)) {
+                    stale = true;
+                    break;
+                }
+            }
+            if (stale) {
+                log_move_abort("speculative move conflicts with an earlier move of its batch");
+            }
+        }
+
+        if (move.create_move_outcome == e_create_move::VALID && !stale) {
+            bool estimate_valid = move.estimated
+                                  && std::none_of(move.affected_nets.begin(), move.affected_nets.end(),
+                                                  [&](ClusterNetId net_id) { return modified_nets.count(net_id) > 0; });
+
+            if (move.estimated && !estimate_valid) {
+                //An earlier move of the batch changed one of this move's nets, update the estimate
+                estimate_valid = estimate_move_cost_deltas(place_algorithm, delay_model, criticalities,
+                                                           blocks_affected, move.affected_nets,
+                                                           move.bb_delta_c, move.timing_delta_c);
+            }
+
+            bool applied = false;
+            if (estimate_valid) {
+                bb_delta_c = move.bb_delta_c;
+                timing_delta_c = move.timing_delta_c;
+                delta_c = get_delta_c(bb_delta_c, timing_delta_c);
+                move_outcome = assess_swap(delta_c, state->t);
+            } else {
+                //Evaluate the move with the regular incremental cost update
+                apply_move_blocks(blocks_affected, placer_state.mutable_blk_loc_registry());
+                find_affected_nets_and_update_costs(place_algorithm, delay_model, criticalities,
+                                                    blocks_affected, bb_delta_c, timing_delta_c);
+                applied = true;
+                delta_c = get_delta_c(bb_delta_c, timing_delta_c);
+                move_outcome = assess_swap(delta_c, state->t);
+            }
+
+            if (move_outcome == ACCEPTED) {
+                if (!applied) {
+                    //Apply the move and compute its exact incremental cost change
+                    bb_delta_c = 0.;
+                    timing_delta_c = 0.;
+                    apply_move_blocks(blocks_affected, placer_state.mutable_blk_loc_registry());
+                    find_affected_nets_and_update_costs(place_algorithm, delay_model, criticalities,
+                                                        blocks_affected, bb_delta_c, timing_delta_c);
+                    delta_c = get_delta_c(bb_delta_c, timing_delta_c);
+                }
+
+                costs->cost += delta_c;
+                costs->bb_cost += bb_delta_c;
+
+                if (place_algorithm == CRITICALITY_TIMING_PLACE) {
+                    costs->timing_cost += timing_delta_c;
+
+                    /* Invalidates timing of modified connections for incremental *
+                     * timing updates. These invalidations are accumulated for a  *
+                     * big timing update in the outer loop.                       */
+                    invalidate_affected_connections(blocks_affected,
+                                                    pin_timing_invalidator, timing_info);
+
+                    /* Update the connection_timing_cost and connection_delay *
+                     * values from the temporary values.                      */
+                    commit_td_cost(blocks_affected, placer_state);
+                }
+
+                /* Update net cost functions and reset flags. */
+                update_move_nets();
+
+                /* Update clb data structures since we kept the move. */
+                commit_move_blocks(blocks_affected, placer_state.mutable_grid_blocks());
+                update_net_sink_loc_sums(blocks_affected, placer_state);
+
+                if (move.proposed_action.logical_blk_type_index != -1) {
+                    ++move_type_stat.accepted_moves[move.proposed_action.logical_blk_type_index][(int)move.proposed_action.move_type];
+                }
+
+                /* Later moves of the batch touching these blocks, locations or nets must be updated */
+                for (const t_pl_moved_block& moved_block : blocks_affected.moved_blocks) {
+                    moved_blocks.insert(moved_block.block_num);
+                    moved_locs.insert(moved_block.old_loc);
+                    moved_locs.insert(moved_block.new_loc);
+                    for (ClusterPinId blk_pin : clb_nlist.block_pins(moved_block.block_num)) {
+                        modified_nets.insert(clb_nlist.pin_net(blk_pin));
+                    }
+                }
+            } else {
+                VTR_ASSERT_SAFE(move_outcome == REJECTED);
+
+                if (applied) {
+                    reset_move_nets();
+                    revert_move_blocks(blocks_affected, placer_state.mutable_blk_loc_registry());
+                    if (place_algorithm == CRITICALITY_TIMING_PLACE) {
+                        revert_td_cost(blocks_affected, placer_state.mutable_timing());
+                    }
+                }
+
+                if (move.proposed_action.logical_blk_type_index != -1) {
+                    ++move_type_stat.rejected_moves[move.proposed_action.logical_blk_type_index][(int)move.proposed_action.move_type];
+                }
+            }
+
+            move_outcome_stats.delta_cost_norm = delta_c;
+            move_outcome_stats.delta_bb_cost_norm = bb_delta_c * costs->bb_cost_norm;
+            move_outcome_stats.delta_timing_cost_norm = timing_delta_c * costs->timing_cost_norm;
+
+            move_outcome_stats.delta_bb_cost_abs = bb_delta_c;
+            move_outcome_stats.delta_timing_cost_abs = timing_delta_c;
+        }
+        move_outcome_stats.outcome = move_outcome;
+
+        move.eval_time_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - commit_start_time).count();
+        move_outcome_stats.elapsed_time = 1e-9 * move.eval_time_ns;
+        move_type_stat.add_eval_time(move.proposed_action.move_type, move.eval_time_ns);
+
+        calculate_reward_and_process_outcome(placer_opts, move_outcome_stats,
+                                             delta_c, timing_bb_factor, move.proposed_action.move_type,
+                                             move_type_stat, move_generator);
+
+        if (move_outcome == ACCEPTED) {
+            stats->single_swap_update(*costs);
+            swap_stats.num_swap_accepted++;
+        } else if (move_outcome == ABORTED) {
+            swap_stats.num_swap_aborted++;
+        } else {
+            swap_stats.num_swap_rejected++;
+        }
+
+        blocks_affected.clear_move_blocks();
+    }
+}
+
 static bool is_cube_bb(const e_place_bounding_box_mode place_bb_mode,
                        const RRGraphView& rr_graph) {
     bool cube_bb;
@@ -1630,6 +2386,11 @@ static void update_placement_cost_normalization_factors(t_placer_costs* costs, c
         update_noc_normalization_factors(*costs);
     }
 
+    // refresh the channel utilization the congestion costs are computed against
+    if (placer_opts.place_congestion_weight > 0.) {
+        costs->congestion_cost = update_congestion_cost();
+    }
+
     // update the current total placement cost
     costs->cost = get_total_cost(costs, placer_opts, noc_opts);
 }
@@ -1660,6 +2421,11 @@ static double get_total_cost(t_placer_costs* costs, const t_placer_opts& placer_
         total_cost += calculate_noc_cost(costs->noc_cost_terms, costs->noc_cost_norm_factors, noc_opts);
     }
 
+    if (placer_opts.place_congestion_weight > 0.) {
+        // the congestion cost is a (congestion weighted) wirelength, normalized as such
+        total_cost += placer_opts.place_congestion_weight * costs->congestion_cost * costs->bb_cost_norm;
+    }
+
     return total_cost;
 }
 
@@ -1912,9 +2678,12 @@ static void alloc_and_load_placement_structs(float place_cost_exp,
  * elsewhere).   */
 static void free_placement_structs(const t_noc_opts& noc_opts) {
     free_placement_macros_structs();
+    g_vpr_ctx.mutable_placement().macro_footprints.clear();
 
     free_place_move_structs();
 
+    free_routing_demand_map();
+
     free_chan_w_factors_for_place_cost();
 
     free_try_swap_structs();
@@ -2363,13 +3132,58 @@ static void print_placement_move_types_stats(const MoveTypeStat& move_type_stat)
         }
         VTR_LOG("\n");
     }
+
+    VTR_LOG("Placement move evaluation time by move type: \n");
+    VTR_LOG("----------------- ---------------- ---------------- \n");
+    VTR_LOG("    Move Type       Moves Timed      Avg Time(us)   \n");
+    VTR_LOG("----------------- ---------------- ---------------- \n");
+    for (int imove = 0; imove < (int)move_type_stat.timed_moves.size(); imove++) {
+        e_move_type move_type = e_move_type(imove);
+        if (move_type_stat.timed_moves[move_type] == 0) {
+            continue;
+        }
+        VTR_LOG("%-17.17s %-16d %-16.3f\n",
+                move_type_to_string(move_type).c_str(), move_type_stat.timed_moves[move_type],
+                move_type_stat.avg_eval_time_us(move_type));
+    }
     VTR_LOG("\n");
 }
 
+static void save_anneal_checkpoint(const std::string& filename,
+                                   const t_annealing_state& state,
+                                   const BlkLocRegistry& blk_loc_registry,
+                                   int tot_iter,
+                                   int moves_since_cost_recompute,
+                                   int outer_crit_iter_count,
+                                   e_agent_state agent_state,
+                                   const MoveGenerator& move_generator,
+                                   const MoveGenerator& move_generator2) {
+    t_anneal_checkpoint checkpoint;
+    checkpoint.block_locs = blk_loc_registry.block_locs();
+    checkpoint.t = state.t;
+    checkpoint.restart_t = state.restart_t;
+    checkpoint.alpha = state.alpha;
+    checkpoint.num_temps = state.num_temps;
+    checkpoint.rlim = state.rlim;
+    checkpoint.crit_exponent = state.crit_exponent;
+    checkpoint.move_lim = state.move_lim;
+    checkpoint.tot_iter = tot_iter;
+    checkpoint.moves_since_cost_recompute = moves_since_cost_recompute;
+    checkpoint.outer_crit_iter_count = outer_crit_iter_count;
+    checkpoint.late_in_the_anneal = (agent_state == e_agent_state::LATE_IN_THE_ANNEAL);
+    checkpoint.rand_state = vtr::get_random_state();
+    checkpoint.move_generator_state = move_generator.learned_state();
+    checkpoint.move_generator2_state = move_generator2.learned_state();
+
+    write_anneal_checkpoint(filename, checkpoint);
+}
+
 static void calculate_reward_and_process_outcome(const t_placer_opts& placer_opts,
                                                  const MoveOutcomeStats& move_outcome_stats,
                                                  double delta_c,
                                                  float timing_bb_factor,
+                                                 e_move_type move_type,
+                                                 const MoveTypeStat& move_type_stat,
                                                  MoveGenerator& move_generator) {
     static std::optional<e_reward_function> reward_fun;
     if (!reward_fun.has_value()) {
@@ -2396,15 +3210,29 @@ static void calculate_reward_and_process_outcome(const t_placer_opts& placer_opt
         } else {
             move_generator.process_outcome(0, reward_fun.value());
         }
+    } else if (reward_fun == e_reward_function::COST_PER_TIME) {
+        //Cost improvement per microsecond spent evaluating a move of this type (on average, as single moves are noisy)
+        double avg_time_us = move_type_stat.avg_eval_time_us(move_type);
+        if (delta_c < 0 && avg_time_us > 0.) {
+            move_generator.process_outcome(-1 * delta_c / avg_time_us, reward_fun.value());
+        } else {
+            move_generator.process_outcome(0, reward_fun.value());
+        }
     }
 }
 
+static bool is_better_seed_result(const t_placement_seed_result& candidate,
+                                  const t_placement_seed_result& best,
+                                  const t_placer_opts& placer_opts) {
+    if (placer_opts.place_algorithm.is_timing_driven() && candidate.cpd != best.cpd) {
+        return candidate.cpd < best.cpd;
+    }
+    return candidate.costs.bb_cost < best.costs.bb_cost;
+}
+
 static void copy_locs_to_global_state(const BlkLocRegistry& blk_loc_registry) {
     auto& place_ctx = g_vpr_ctx.mutable_placement();
 
-    // the placement location variables should be unlocked before being accessed
-    place_ctx.unlock_loc_vars();
-
     // copy the local location variables into the global state
     auto& global_blk_loc_registry = place_ctx.mutable_blk_loc_registry();
     global_blk_loc_registry = blk_loc_registry;
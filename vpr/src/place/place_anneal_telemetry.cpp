@@ -0,0 +1,117 @@
+/**
+ * @file place_anneal_telemetry.cpp
+ * @brief Defines the anneal telemetry writer and schedule model declared in place_anneal_telemetry.h.
+ */
+
+#include "place_anneal_telemetry.h"
+
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+#include "vpr_error.h"
+#include "vtr_log.h"
+
+AnnealTelemetryWriter::AnnealTelemetryWriter(const std::string& filename)
+    : os_(filename)
+    , num_blocks_(g_vpr_ctx.clustering().clb_nlist.blocks().size()) {
+    if (!os_) {
+        VPR_FATAL_ERROR(VPR_ERROR_PLACE, "Failed to open anneal telemetry file '%s' for writing\n", filename.c_str());
+    }
+
+    os_ << "num_blocks,temp_num,t,alpha,success_rate,rlim,crit_exponent,move_lim,cost,bb_cost,timing_cost,cpd,time\n";
+}
+
+void AnnealTelemetryWriter::write_temperature(const t_annealing_state& state,
+                                              const t_placer_statistics& stats,
+                                              const t_placer_costs& costs,
+                                              float cpd,
+                                              float elapsed_sec) {
+    os_ << num_blocks_ << ','
+        << state.num_temps << ','
+        << state.t << ','
+        << state.alpha << ','
+        << stats.success_rate << ','
+        << state.rlim << ','
+        << state.crit_exponent << ','
+        << state.move_lim << ','
+        << costs.cost << ','
+        << costs.bb_cost << ','
+        << costs.timing_cost << ','
+        << cpd << ','
+        << elapsed_sec << '\n';
+
+    //Flushed each temperature, so that the telemetry of an interrupted run is not lost
+    os_.flush();
+}
+
+AnnealScheduleModel::AnnealScheduleModel(const std::string& filename, size_t num_blocks) {
+    std::ifstream is(filename);
+    if (!is) {
+        VPR_FATAL_ERROR(VPR_ERROR_PLACE, "Failed to open anneal schedule model '%s'\n", filename.c_str());
+    }
+
+    double best_distance = std::numeric_limits<double>::infinity();
+    int best_num_blocks = 0;
+    std::string line;
+    for (int line_num = 1; std::getline(is, line); line_num++) {
+        std::istringstream line_is(line);
+
+        std::string first_token;
+        if (!(line_is >> first_token) || first_token[0] == '#') {
+            continue; //Empty line or comment
+        }
+        line_is.seekg(0);
+
+        int row_num_blocks = 0, row_window = 0;
+        float row_min_improvement = 0., row_max_success_rate = 0.;
+        if (!(line_is >> row_num_blocks >> row_window >> row_min_improvement >> row_max_success_rate)
+            || row_num_blocks <= 0 || row_window <= 0 || row_min_improvement < 0.
+            || row_max_success_rate < 0. || row_max_success_rate > 1.) {
+            VPR_FATAL_ERROR(VPR_ERROR_PLACE,
+                            "Invalid row on line %d of anneal schedule model '%s'"
+                            " (expected '<num_blocks> <window> <min_improvement> <max_success_rate>')\n",
+                            line_num, filename.c_str());
+        }
+
+        double distance = std::abs(std::log((double)row_num_blocks) - std::log((double)std::max<size_t>(num_blocks, 1)));
+        if (distance < best_distance) {
+            best_distance = distance;
+            best_num_blocks = row_num_blocks;
+            window_ = row_window;
+            min_improvement_ = row_min_improvement;
+            max_success_rate_ = row_max_success_rate;
+        }
+    }
+
+    if (window_ == 0) {
+        VPR_FATAL_ERROR(VPR_ERROR_PLACE, "Anneal schedule model '%s' has no rows\n", filename.c_str());
+    }
+
+    VTR_LOG("Anneal schedule model: row fitted for %d blocks (window %d, min improvement %g, max success rate %g)\n",
+            best_num_blocks, window_, min_improvement_, max_success_rate_);
+}
+
+bool AnnealScheduleModel::anneal_converged(const t_placer_statistics& stats, const t_placer_costs& costs, bool timing_driven) {
+    bb_costs_.push_back(costs.bb_cost);
+    timing_costs_.push_back(costs.timing_cost);
+
+    if (stats.success_rate >= max_success_rate_ || (int)bb_costs_.size() <= window_) {
+        return false;
+    }
+
+    auto relative_improvement = [this](const std::vector<double>& cost_history) {
+        double old_cost = cost_history[cost_history.size() - 1 - window_];
+        double new_cost = cost_history.back();
+        return (old_cost > 0.) ? (old_cost - new_cost) / old_cost : 0.;
+    };
+
+    if (relative_improvement(bb_costs_) > min_improvement_) {
+        return false;
+    }
+    if (timing_driven && relative_improvement(timing_costs_) > min_improvement_) {
+        return false;
+    }
+
+    return true;
+}
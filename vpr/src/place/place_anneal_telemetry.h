@@ -0,0 +1,76 @@
+#ifndef VPR_PLACE_ANNEAL_TELEMETRY_H
+#define VPR_PLACE_ANNEAL_TELEMETRY_H
+
+/**
+ * @file place_anneal_telemetry.h
+ * @brief Per-temperature anneal telemetry (--place_anneal_telemetry_file), and the anneal schedule
+ *        model fitted on the telemetry of previous runs (--place_anneal_schedule_model).
+ *
+ * The telemetry file is a CSV file with a header and a row per temperature (quench excluded):
+ *
+ *      num_blocks,temp_num,t,alpha,success_rate,rlim,crit_exponent,move_lim,cost,bb_cost,timing_cost,cpd,time
+ *
+ * The schedule model is a text file with a row per design size (empty lines and lines starting
+ * with '#' are ignored):
+ *
+ *      <num_blocks> <window> <min_improvement> <max_success_rate>
+ *
+ * The placer uses the row whose number of clustered blocks is the closest (on a log scale) to the
+ * design's. Once the success rate drops below max_success_rate, the anneal stops (and the quench
+ * starts) as soon as neither the bounding box cost nor the timing cost has improved by more than
+ * min_improvement (relative) over the last window temperatures, instead of running the schedule's
+ * last, unproductive, temperatures.
+ */
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "place_util.h"
+
+/**
+ * @brief Writes a row of the telemetry file per temperature
+ */
+class AnnealTelemetryWriter {
+  public:
+    ///@brief Creates (or truncates) filename and writes the header
+    explicit AnnealTelemetryWriter(const std::string& filename);
+
+    ///@brief Writes the row of the temperature which just ended (state.num_temps already incremented)
+    void write_temperature(const t_annealing_state& state,
+                           const t_placer_statistics& stats,
+                           const t_placer_costs& costs,
+                           float cpd,
+                           float elapsed_sec);
+
+  private:
+    std::ofstream os_;
+    size_t num_blocks_;
+};
+
+/**
+ * @brief Decides when the anneal stops improving, from a model fitted on previous runs
+ */
+class AnnealScheduleModel {
+  public:
+    ///@brief Reads the model in filename, and selects its row for designs of num_blocks clustered blocks
+    AnnealScheduleModel(const std::string& filename, size_t num_blocks);
+
+    /**
+     * @brief Records the costs at the end of a temperature
+     *
+     * @return True if the anneal has converged (according to the model) and should stop.
+     */
+    bool anneal_converged(const t_placer_statistics& stats, const t_placer_costs& costs, bool timing_driven);
+
+  private:
+    int window_ = 0;
+    float min_improvement_ = 0.;
+    float max_success_rate_ = 0.;
+
+    ///@brief The costs at the end of each temperature
+    std::vector<double> bb_costs_;
+    std::vector<double> timing_costs_;
+};
+
+#endif
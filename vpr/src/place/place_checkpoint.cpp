@@ -3,6 +3,67 @@
 #include "placer_state.h"
 #include "grid_block.h"
 
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+/* Anneal checkpoint file layout (native byte order): the magic and version, the netlist and
+ * device fingerprint, the annealing state, the block locations, then the move generator states */
+static constexpr char ANNEAL_CHECKPOINT_MAGIC[8] = {'V', 'P', 'R', 'A', 'N', 'N', 'C', 'P'};
+static constexpr uint32_t ANNEAL_CHECKPOINT_VERSION = 1;
+
+template<typename T>
+static void write_value(std::ofstream& os, const T& value) {
+    os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+static void read_value(std::ifstream& is, T& value) {
+    is.read(reinterpret_cast<char*>(&value), sizeof(T));
+}
+
+static void write_vector(std::ofstream& os, const std::vector<double>& values) {
+    write_value(os, uint64_t(values.size()));
+    os.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(double));
+}
+
+static void read_vector(std::ifstream& is, std::vector<double>& values) {
+    uint64_t size = 0;
+    read_value(is, size);
+    if (!is || size > (1u << 24)) {
+        is.setstate(std::ios::failbit);
+        return;
+    }
+    values.resize(size);
+    is.read(reinterpret_cast<char*>(values.data()), size * sizeof(double));
+}
+
+///@brief Returns a hash of the clustered netlist (block names and types) and of the device grid size
+static uint64_t anneal_checkpoint_fingerprint() {
+    const auto& clb_nlist = g_vpr_ctx.clustering().clb_nlist;
+    const auto& grid = g_vpr_ctx.device().grid;
+
+    //FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    auto hash_bytes = [&](const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; i++) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+    };
+
+    size_t dims[3] = {grid.width(), grid.height(), size_t(grid.get_num_layers())};
+    hash_bytes(dims, sizeof(dims));
+    for (ClusterBlockId blk_id : clb_nlist.blocks()) {
+        const std::string& name = clb_nlist.block_name(blk_id);
+        hash_bytes(name.data(), name.size() + 1);
+        int type_index = clb_nlist.block_type(blk_id)->index;
+        hash_bytes(&type_index, sizeof(type_index));
+    }
+    return hash;
+}
+
 float t_placement_checkpoint::get_cp_cpd() const { return cpd_; }
 
 double t_placement_checkpoint::get_cp_bb_cost() const { return costs_.bb_cost; }
@@ -81,3 +142,110 @@ void restore_best_placement(PlacerState& placer_state,
         VTR_LOG("\nCheckpoint restored\n");
     }
 }
+
+void write_anneal_checkpoint(const std::string& filename, const t_anneal_checkpoint& checkpoint) {
+    std::string tmp_filename = filename + ".tmp";
+    {
+        std::ofstream os(tmp_filename, std::ios::binary | std::ios::trunc);
+        if (!os) {
+            VPR_FATAL_ERROR(VPR_ERROR_PLACE, "Failed to open placement checkpoint '%s' for writing\n", tmp_filename.c_str());
+        }
+
+        os.write(ANNEAL_CHECKPOINT_MAGIC, sizeof(ANNEAL_CHECKPOINT_MAGIC));
+        write_value(os, ANNEAL_CHECKPOINT_VERSION);
+        write_value(os, anneal_checkpoint_fingerprint());
+
+        write_value(os, checkpoint.t);
+        write_value(os, checkpoint.restart_t);
+        write_value(os, checkpoint.alpha);
+        write_value(os, checkpoint.num_temps);
+        write_value(os, checkpoint.rlim);
+        write_value(os, checkpoint.crit_exponent);
+        write_value(os, checkpoint.move_lim);
+        write_value(os, checkpoint.tot_iter);
+        write_value(os, checkpoint.moves_since_cost_recompute);
+        write_value(os, checkpoint.outer_crit_iter_count);
+        write_value(os, uint8_t(checkpoint.late_in_the_anneal));
+        write_value(os, checkpoint.rand_state);
+
+        write_value(os, uint64_t(checkpoint.block_locs.size()));
+        for (const t_block_loc& block_loc : checkpoint.block_locs) {
+            int32_t loc[4] = {block_loc.loc.x, block_loc.loc.y, block_loc.loc.sub_tile, block_loc.loc.layer};
+            write_value(os, loc);
+            write_value(os, uint8_t(block_loc.is_fixed));
+        }
+
+        write_vector(os, checkpoint.move_generator_state);
+        write_vector(os, checkpoint.move_generator2_state);
+
+        os.close();
+        if (!os) {
+            VPR_FATAL_ERROR(VPR_ERROR_PLACE, "Failed to write placement checkpoint '%s'\n", tmp_filename.c_str());
+        }
+    }
+
+    if (std::rename(tmp_filename.c_str(), filename.c_str()) != 0) {
+        VPR_FATAL_ERROR(VPR_ERROR_PLACE, "Failed to replace placement checkpoint '%s': %s\n", filename.c_str(), std::strerror(errno));
+    }
+}
+
+t_anneal_checkpoint read_anneal_checkpoint(const std::string& filename) {
+    const auto& clb_nlist = g_vpr_ctx.clustering().clb_nlist;
+
+    std::ifstream is(filename, std::ios::binary);
+    if (!is) {
+        VPR_FATAL_ERROR(VPR_ERROR_PLACE, "Failed to open placement checkpoint '%s'\n", filename.c_str());
+    }
+
+    char magic[sizeof(ANNEAL_CHECKPOINT_MAGIC)] = {};
+    uint32_t version = 0;
+    uint64_t fingerprint = 0;
+    is.read(magic, sizeof(magic));
+    read_value(is, version);
+    read_value(is, fingerprint);
+    if (!is || std::memcmp(magic, ANNEAL_CHECKPOINT_MAGIC, sizeof(magic)) != 0 || version != ANNEAL_CHECKPOINT_VERSION) {
+        VPR_FATAL_ERROR(VPR_ERROR_PLACE, "'%s' is not a placement checkpoint (or was written by an incompatible version of VPR)\n", filename.c_str());
+    }
+    if (fingerprint != anneal_checkpoint_fingerprint()) {
+        VPR_FATAL_ERROR(VPR_ERROR_PLACE, "Placement checkpoint '%s' was written for a different netlist or device\n", filename.c_str());
+    }
+
+    t_anneal_checkpoint checkpoint;
+    uint8_t late_in_the_anneal = 0;
+    read_value(is, checkpoint.t);
+    read_value(is, checkpoint.restart_t);
+    read_value(is, checkpoint.alpha);
+    read_value(is, checkpoint.num_temps);
+    read_value(is, checkpoint.rlim);
+    read_value(is, checkpoint.crit_exponent);
+    read_value(is, checkpoint.move_lim);
+    read_value(is, checkpoint.tot_iter);
+    read_value(is, checkpoint.moves_since_cost_recompute);
+    read_value(is, checkpoint.outer_crit_iter_count);
+    read_value(is, late_in_the_anneal);
+    read_value(is, checkpoint.rand_state);
+    checkpoint.late_in_the_anneal = late_in_the_anneal;
+
+    uint64_t num_blocks = 0;
+    read_value(is, num_blocks);
+    if (!is || num_blocks != clb_nlist.blocks().size()) {
+        VPR_FATAL_ERROR(VPR_ERROR_PLACE, "Placement checkpoint '%s' is truncated or corrupted\n", filename.c_str());
+    }
+    checkpoint.block_locs.resize(num_blocks);
+    for (t_block_loc& block_loc : checkpoint.block_locs) {
+        int32_t loc[4];
+        uint8_t is_fixed = 0;
+        read_value(is, loc);
+        read_value(is, is_fixed);
+        block_loc.loc = t_pl_loc(loc[0], loc[1], loc[2], loc[3]);
+        block_loc.is_fixed = is_fixed;
+    }
+
+    read_vector(is, checkpoint.move_generator_state);
+    read_vector(is, checkpoint.move_generator2_state);
+    if (!is) {
+        VPR_FATAL_ERROR(VPR_ERROR_PLACE, "Placement checkpoint '%s' is truncated or corrupted\n", filename.c_str());
+    }
+
+    return checkpoint;
+}
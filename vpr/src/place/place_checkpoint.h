@@ -10,6 +10,7 @@
 
 #include "place_delay_model.h"
 #include "place_timing_update.h"
+#include "vtr_random.h"
 
 /**
  * @brief Data structure that stores the placement state and saves it as a checkpoint.
@@ -75,4 +76,45 @@ void restore_best_placement(PlacerState& placer_state,
                             std::unique_ptr<PlaceDelayModel>& place_delay_model,
                             std::unique_ptr<NetPinTimingInvalidator>& pin_timing_invalidator,
                             PlaceCritParams crit_params, const t_noc_opts& noc_opts);
+
+/**
+ * @brief The state of an anneal at the start of a temperature, saved to a file (--place_checkpoint_file)
+ *        so that another VPR process can resume the anneal from that temperature (--place_resume).
+ *
+ * The placement costs and timing are not saved, since they are recomputed from the block locations.
+ * The file is a small binary, which is only valid for the same netlist, device grid and placer options.
+ */
+struct t_anneal_checkpoint {
+    vtr::vector_map<ClusterBlockId, t_block_loc> block_locs;
+
+    ///@brief Annealing state (see t_annealing_state)
+    float t = 0.;
+    float restart_t = 0.;
+    float alpha = 0.;
+    int num_temps = 0;
+    float rlim = 0.;
+    float crit_exponent = 0.;
+    int move_lim = 0;
+
+    int tot_iter = 0;
+    int moves_since_cost_recompute = 0;
+    int outer_crit_iter_count = 0;
+    bool late_in_the_anneal = false; ///<Whether the RL agent was in its second state
+    vtr::RandState rand_state = 0;   ///<State of the vtr random number generator
+
+    ///@brief Learned state of the move generators (see MoveGenerator::learned_state())
+    std::vector<double> move_generator_state;
+    std::vector<double> move_generator2_state;
+};
+
+/**
+ * @brief Writes an anneal checkpoint to filename.
+ *
+ * The checkpoint is written to a temporary file first, which then replaces filename,
+ * so that a process killed while writing it leaves the previous checkpoint intact.
+ */
+void write_anneal_checkpoint(const std::string& filename, const t_anneal_checkpoint& checkpoint);
+
+///@brief Reads an anneal checkpoint written by write_anneal_checkpoint(), and checks it matches the current netlist and device
+t_anneal_checkpoint read_anneal_checkpoint(const std::string& filename);
 #endif
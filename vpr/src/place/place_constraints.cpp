@@ -8,6 +8,9 @@
  *  the placement stage of VPR.
  */
 
+#include <algorithm>
+#include <map>
+
 #include "globals.h"
 #include "place_constraints.h"
 #include "place_util.h"
@@ -201,8 +204,15 @@ bool cluster_floorplanning_legal(ClusterBlockId blk_id, const t_pl_loc& loc) {
         //not constrained so will not have floorplanning issues
         floorplanning_good = true;
     } else {
-        PartitionRegion pr = floorplanning_ctx.cluster_constraints[blk_id];
-        bool in_pr = pr.is_loc_in_part_reg(loc);
+        const auto& index_ids = floorplanning_ctx.cluster_constraints_index_ids;
+        int index_id = (size_t(blk_id) < index_ids.size()) ? index_ids[blk_id] : OPEN;
+
+        bool in_pr;
+        if (index_id != OPEN) {
+            in_pr = floorplanning_ctx.cluster_constraints_indices[index_id].is_loc_in_part_reg(loc);
+        } else {
+            in_pr = floorplanning_ctx.cluster_constraints[blk_id].is_loc_in_part_reg(loc);
+        }
 
         //if location is in partitionregion, floorplanning is respected
         //if not it is not
@@ -223,32 +233,55 @@ void load_cluster_constraints() {
     auto& floorplanning_ctx = g_vpr_ctx.mutable_floorplanning();
     const ClusteringContext& cluster_ctx = g_vpr_ctx.clustering();
 
+    floorplanning_ctx.cluster_constraints.clear();
     floorplanning_ctx.cluster_constraints.resize(cluster_ctx.clb_nlist.blocks().size());
 
+    //The clusters of a floorplan mostly hold atoms of the same few combinations of partitions,
+    //so the intersection of the PartitionRegions of each combination is computed once
+    struct t_partitions_intersection {
+        PartitionRegion pr;
+        bool compatible = true;
+    };
+    std::map<std::vector<PartitionId>, t_partitions_intersection> intersections;
+    std::vector<PartitionId> cluster_partitions;
+
     for (auto cluster_id : cluster_ctx.clb_nlist.blocks()) {
         const std::unordered_set<AtomBlockId>& atoms = cluster_ctx.atoms_lookup[cluster_id];
-        PartitionRegion empty_pr;
-        floorplanning_ctx.cluster_constraints[cluster_id] = empty_pr;
 
-        //if there are any constrained atoms in the cluster,
-        //we update the cluster's PartitionRegion
+        cluster_partitions.clear();
         for (AtomBlockId atom : atoms) {
             PartitionId partid = floorplanning_ctx.constraints.get_atom_partition(atom);
-
             if (partid != PartitionId::INVALID()) {
-                PartitionRegion pr = floorplanning_ctx.constraints.get_partition_pr(partid);
-                if (floorplanning_ctx.cluster_constraints[cluster_id].empty()) {
-                    floorplanning_ctx.cluster_constraints[cluster_id] = pr;
+                cluster_partitions.push_back(partid);
+            }
+        }
+
+        //if there are any constrained atoms in the cluster,
+        //we update the cluster's PartitionRegion
+        if (cluster_partitions.empty()) {
+            continue;
+        }
+        std::sort(cluster_partitions.begin(), cluster_partitions.end());
+        cluster_partitions.erase(std::unique(cluster_partitions.begin(), cluster_partitions.end()), cluster_partitions.end());
+
+        auto result = intersections.emplace(cluster_partitions, t_partitions_intersection());
+        t_partitions_intersection& intersection_pr = result.first->second;
+        if (result.second) {
+            intersection_pr.pr = floorplanning_ctx.constraints.get_partition_pr(cluster_partitions[0]);
+            for (size_t ipart = 1; ipart < cluster_partitions.size(); ++ipart) {
+                PartitionRegion intersect_pr = intersection(floorplanning_ctx.constraints.get_partition_pr(cluster_partitions[ipart]), intersection_pr.pr);
+                if (intersect_pr.empty()) {
+                    intersection_pr.compatible = false;
                 } else {
-                    PartitionRegion intersect_pr = intersection(pr, floorplanning_ctx.cluster_constraints[cluster_id]);
-                    if (intersect_pr.empty()) {
-                        VTR_LOG_ERROR("Cluster block %zu has atoms with incompatible floorplan constraints.\n", size_t(cluster_id));
-                    } else {
-                        floorplanning_ctx.cluster_constraints[cluster_id] = intersect_pr;
-                    }
+                    intersection_pr.pr = std::move(intersect_pr);
                 }
             }
         }
+
+        if (!intersection_pr.compatible) {
+            VTR_LOG_ERROR("Cluster block %zu has atoms with incompatible floorplan constraints.\n", size_t(cluster_id));
+        }
+        floorplanning_ctx.cluster_constraints[cluster_id] = intersection_pr.pr;
     }
 }
 
@@ -285,15 +318,32 @@ void alloc_and_load_compressed_cluster_constraints() {
 
     floorplanning_ctx.compressed_cluster_constraints.resize(n_layers);
     for (int l = 0; l < n_layers; l++) {
+        floorplanning_ctx.compressed_cluster_constraints[l].clear();
         floorplanning_ctx.compressed_cluster_constraints[l].resize(cluster_ctx.clb_nlist.blocks().size());
     }
 
+    //Constraints with few regions are checked about as fast by scanning them as with an index
+    constexpr size_t MIN_INDEXED_REGIONS = 8;
+    std::unordered_map<PartitionRegion, int> pr_index_ids;
+    floorplanning_ctx.cluster_constraints_indices.clear();
+    floorplanning_ctx.cluster_constraints_index_ids.clear();
+    floorplanning_ctx.cluster_constraints_index_ids.resize(cluster_ctx.clb_nlist.blocks().size(), OPEN);
+
     for (ClusterBlockId blk_id : cluster_ctx.clb_nlist.blocks()) {
         if (!is_cluster_constrained(blk_id)) {
             continue;
         }
 
         const PartitionRegion& pr = floorplanning_ctx.cluster_constraints[blk_id];
+
+        if (pr.get_regions().size() >= MIN_INDEXED_REGIONS) {
+            auto [itr, inserted] = pr_index_ids.emplace(pr, (int)floorplanning_ctx.cluster_constraints_indices.size());
+            if (inserted) {
+                floorplanning_ctx.cluster_constraints_indices.emplace_back(pr);
+            }
+            floorplanning_ctx.cluster_constraints_index_ids[blk_id] = itr->second;
+        }
+
         auto block_type = cluster_ctx.clb_nlist.block_type(blk_id);
         // Get the compressed grid for NoC
         const auto& compressed_grid = place_ctx.compressed_block_grids[block_type->index];
@@ -305,8 +355,6 @@ void alloc_and_load_compressed_cluster_constraints() {
             const vtr::Rect<int>& rect = region.get_rect();
 
             for (int l = layer_low; l <= layer_high; l++) {
-                PartitionRegion compressed_pr;
-
                 if (compressed_grid.compressed_to_grid_x[l].empty() || compressed_grid.compressed_to_grid_y[l].empty()) {
                     continue;
                 }
@@ -320,9 +368,8 @@ void alloc_and_load_compressed_cluster_constraints() {
                                          compressed_max_loc.x, compressed_max_loc.y, l);
                 compressed_region.set_sub_tile(region.get_sub_tile());
 
-                compressed_pr.add_to_part_region(compressed_region);
-
-                floorplanning_ctx.compressed_cluster_constraints[l][blk_id] = compressed_pr;
+                //Each region of the layer is kept (not only the last one)
+                floorplanning_ctx.compressed_cluster_constraints[l][blk_id].add_to_part_region(compressed_region);
             }
         }
 
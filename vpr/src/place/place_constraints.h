@@ -146,6 +146,9 @@ void mark_fixed_blocks(BlkLocRegistry& blk_loc_registry);
 /**
  * @brief Converts the floorplanning constraints from grid location to
  * compressed grid locations and store them in FloorplanningContext.
+ *
+ * Also builds the spatial indices of the constraints made of many regions
+ * (see FloorplanningContext::cluster_constraints_indices).
  */
 void alloc_and_load_compressed_cluster_constraints();
 
@@ -4,6 +4,8 @@
  *        routines related to the placer delay model.
  */
 
+#include <cmath>
+#include <limits>
 #include <queue>
 #include "place_delay_model.h"
 #include "globals.h"
@@ -56,6 +58,97 @@ void DeltaDelayModel::dump_echo(std::string filepath) const {
     vtr::fclose(f);
 }
 
+///@brief LazyDeltaDelayModel methods.
+float LazyDeltaDelayModel::delay(const t_physical_tile_loc& from_loc, int /*from_pin*/, const t_physical_tile_loc& to_loc, int /*to_pin*/) const {
+    int delta_x = std::abs(from_loc.x - to_loc.x);
+    int delta_y = std::abs(from_loc.y - to_loc.y);
+
+    float delay_val = delays_[index(from_loc.layer_num, to_loc.layer_num, delta_x, delta_y)].load(std::memory_order_acquire);
+    if (std::isnan(delay_val)) {
+        delay_val = fill_delay(from_loc.layer_num, to_loc.layer_num, delta_x, delta_y, /*allow_estimate=*/true);
+    }
+    return delay_val;
+}
+
+void LazyDeltaDelayModel::init_tables() {
+    const auto& grid = g_vpr_ctx.device().grid;
+    num_layers_ = grid.get_num_layers();
+    width_ = grid.width();
+    height_ = grid.height();
+
+    size_t num_entries = num_layers_ * num_layers_ * width_ * height_;
+    delays_ = std::vector<std::atomic<float>>(num_entries);
+    sampled_delays_ = std::vector<std::atomic<float>>(num_entries);
+    for (size_t i = 0; i < num_entries; ++i) {
+        delays_[i].store(std::numeric_limits<float>::quiet_NaN(), std::memory_order_relaxed);
+        sampled_delays_[i].store(std::numeric_limits<float>::quiet_NaN(), std::memory_order_relaxed);
+    }
+    num_filled_.store(0, std::memory_order_relaxed);
+    num_persisted_ = 0;
+
+    coarse_delays_.clear();
+}
+
+float LazyDeltaDelayModel::coarse_estimate(int from_layer, int to_layer, int delta_x, int delta_y) const {
+    if (coarse_delays_.size() == 0) {
+        //Not computed yet
+        return std::numeric_limits<float>::infinity();
+    }
+
+    //Nearest entry of the coarse lattice
+    int coarse_x = std::min<int>(vtr::nint(float(delta_x) / COARSE_SAMPLE_STRIDE), coarse_delays_.dim_size(2) - 1);
+    int coarse_y = std::min<int>(vtr::nint(float(delta_y) / COARSE_SAMPLE_STRIDE), coarse_delays_.dim_size(3) - 1);
+    return coarse_delays_[from_layer][to_layer][coarse_x][coarse_y];
+}
+
+vtr::NdMatrix<float, 4> LazyDeltaDelayModel::snapshot(vtr::NdMatrix<bool, 4>* filled) const {
+    vtr::NdMatrix<float, 4> delays({num_layers_, num_layers_, width_, height_});
+    if (filled) {
+        filled->resize({num_layers_, num_layers_, width_, height_}, false);
+    }
+
+    for (size_t from_layer = 0; from_layer < num_layers_; ++from_layer) {
+        for (size_t to_layer = 0; to_layer < num_layers_; ++to_layer) {
+            for (size_t dx = 0; dx < width_; ++dx) {
+                for (size_t dy = 0; dy < height_; ++dy) {
+                    float delay_val = delays_[index(from_layer, to_layer, dx, dy)].load(std::memory_order_acquire);
+                    bool is_filled = !std::isnan(delay_val);
+                    if (!is_filled) {
+                        delay_val = coarse_estimate(from_layer, to_layer, dx, dy);
+                    }
+                    delays[from_layer][to_layer][dx][dy] = delay_val;
+                    if (filled) {
+                        (*filled)[from_layer][to_layer][dx][dy] = is_filled;
+                    }
+                }
+            }
+        }
+    }
+
+    return delays;
+}
+
+void LazyDeltaDelayModel::dump_echo(std::string filepath) const {
+    DeltaDelayModel(cross_layer_delay_, snapshot(nullptr), is_flat_).dump_echo(filepath);
+}
+
+void LazyDeltaDelayModel::add_persist_fn(std::function<void()> persist_fn) {
+    persist_fns_.push_back(std::move(persist_fn));
+}
+
+void LazyDeltaDelayModel::persist() {
+    size_t num_filled = num_filled_.load(std::memory_order_acquire);
+    if (num_filled == num_persisted_) {
+        return;
+    }
+
+    VTR_LOG("Placement delay model computed %zu of %zu entries\n", num_filled, delays_.size());
+    for (const auto& persist_fn : persist_fns_) {
+        persist_fn();
+    }
+    num_persisted_ = num_filled;
+}
+
 const DeltaDelayModel* OverrideDelayModel::base_delay_model() const {
     return base_delay_model_.get();
 }
@@ -69,28 +162,107 @@ float OverrideDelayModel::delay(const t_physical_tile_loc& from_loc, int from_pi
     t_physical_tile_type_ptr from_type_ptr = grid.get_physical_type(from_loc);
     t_physical_tile_type_ptr to_type_ptr = grid.get_physical_type(to_loc);
 
-    t_override override_key;
-    override_key.from_type = from_type_ptr->index;
-    override_key.from_class = from_type_ptr->pin_class[from_pin];
-    override_key.to_type = to_type_ptr->index;
-    override_key.to_class = to_type_ptr->pin_class[to_pin];
-
-    //Delay overrides may be different for +/- delta so do not use
-    //an absolute delta for the look-up
-    override_key.delta_x = to_loc.x - from_loc.x;
-    override_key.delta_y = to_loc.y - from_loc.y;
-
-    float delay_val = std::numeric_limits<float>::quiet_NaN();
-    auto override_iter = delay_overrides_.find(override_key);
-    if (override_iter != delay_overrides_.end()) {
-        //Found an override
-        delay_val = override_iter->second;
-    } else {
-        //Fall back to the base delay model if no override was found
-        delay_val = base_delay_model_->delay(from_loc, from_pin, to_loc, to_pin);
+    //Most type pairs have no overrides at all
+    const t_override_table* table = find_override_table(from_type_ptr->index, to_type_ptr->index);
+    if (table) {
+        //Delay overrides may be different for +/- delta so do not use
+        //an absolute delta for the look-up
+        size_t index = table->index(from_type_ptr->pin_class[from_pin],
+                                    to_type_ptr->pin_class[to_pin],
+                                    to_loc.x - from_loc.x,
+                                    to_loc.y - from_loc.y);
+        if (index != t_override_table::NO_INDEX && table->has_override[index]) {
+            //Found an override
+            return table->delays[index];
+        }
     }
 
-    return delay_val;
+    //Fall back to the base delay model if no override was found
+    return base_delay_model_->delay(from_loc, from_pin, to_loc, to_pin);
+}
+
+void OverrideDelayModel::rebuild_override_table(int from_type, int to_type) {
+    //Overrides are sorted by type pair first, so those of a pair are contiguous
+    t_override first_key;
+    first_key.from_type = from_type;
+    first_key.to_type = to_type;
+    first_key.from_class = std::numeric_limits<short>::min();
+    first_key.to_class = std::numeric_limits<short>::min();
+    first_key.delta_x = std::numeric_limits<short>::min();
+    first_key.delta_y = std::numeric_limits<short>::min();
+
+    auto begin = delay_overrides_.lower_bound(first_key);
+    auto end = begin;
+    while (end != delay_overrides_.end() && end->first.from_type == from_type && end->first.to_type == to_type) {
+        ++end;
+    }
+    if (begin == end) {
+        return;
+    }
+
+    //Grow the type pair index if needed, keeping the existing tables
+    size_t num_from_types = std::max<size_t>(override_table_index_.dim_size(0), from_type + 1);
+    size_t num_to_types = std::max<size_t>(override_table_index_.dim_size(1), to_type + 1);
+    if (num_from_types != override_table_index_.dim_size(0) || num_to_types != override_table_index_.dim_size(1)) {
+        vtr::NdMatrix<int, 2> table_index({num_from_types, num_to_types}, OPEN);
+        for (size_t i = 0; i < override_table_index_.dim_size(0); ++i) {
+            for (size_t j = 0; j < override_table_index_.dim_size(1); ++j) {
+                table_index[i][j] = override_table_index_[i][j];
+            }
+        }
+        override_table_index_ = std::move(table_index);
+    }
+
+    if (override_table_index_[from_type][to_type] == OPEN) {
+        override_table_index_[from_type][to_type] = override_tables_.size();
+        override_tables_.emplace_back();
+    }
+    t_override_table& table = override_tables_[override_table_index_[from_type][to_type]];
+
+    int max_delta_x = std::numeric_limits<int>::min();
+    int max_delta_y = std::numeric_limits<int>::min();
+    table.num_from_class = 0;
+    table.num_to_class = 0;
+    table.min_delta_x = std::numeric_limits<int>::max();
+    table.min_delta_y = std::numeric_limits<int>::max();
+    for (auto iter = begin; iter != end; ++iter) {
+        const t_override& key = iter->first;
+        table.num_from_class = std::max<int>(table.num_from_class, key.from_class + 1);
+        table.num_to_class = std::max<int>(table.num_to_class, key.to_class + 1);
+        table.min_delta_x = std::min<int>(table.min_delta_x, key.delta_x);
+        table.min_delta_y = std::min<int>(table.min_delta_y, key.delta_y);
+        max_delta_x = std::max<int>(max_delta_x, key.delta_x);
+        max_delta_y = std::max<int>(max_delta_y, key.delta_y);
+    }
+    table.num_delta_x = max_delta_x - table.min_delta_x + 1;
+    table.num_delta_y = max_delta_y - table.min_delta_y + 1;
+
+    size_t num_entries = size_t(table.num_from_class) * table.num_to_class * table.num_delta_x * table.num_delta_y;
+    table.delays.assign(num_entries, std::numeric_limits<float>::quiet_NaN());
+    table.has_override.assign(num_entries, false);
+    for (auto iter = begin; iter != end; ++iter) {
+        const t_override& key = iter->first;
+        size_t index = table.index(key.from_class, key.to_class, key.delta_x, key.delta_y);
+        VTR_ASSERT_SAFE(index != t_override_table::NO_INDEX);
+        table.delays[index] = iter->second;
+        table.has_override[index] = true;
+    }
+}
+
+void OverrideDelayModel::rebuild_override_tables() {
+    override_tables_.clear();
+    override_table_index_.clear();
+
+    for (auto iter = delay_overrides_.begin(); iter != delay_overrides_.end();) {
+        int from_type = iter->first.from_type;
+        int to_type = iter->first.to_type;
+        rebuild_override_table(from_type, to_type);
+
+        //Skip to the next type pair
+        while (iter != delay_overrides_.end() && iter->first.from_type == from_type && iter->first.to_type == to_type) {
+            ++iter;
+        }
+    }
 }
 
 void OverrideDelayModel::set_delay_override(int from_type, int from_class, int to_type, int to_class, int delta_x, int delta_y, float delay_val) {
@@ -106,6 +278,8 @@ void OverrideDelayModel::set_delay_override(int from_type, int from_class, int t
     if (!res.second) {                 //Key already exists
         res.first->second = delay_val; //Overwrite existing delay
     }
+
+    rebuild_override_table(from_type, to_type);
 }
 
 void OverrideDelayModel::dump_echo(std::string filepath) const {
@@ -178,6 +352,14 @@ void DeltaDelayModel::write(const std::string& /*file*/) const {
     VPR_THROW(VPR_ERROR_PLACE, "DeltaDelayModel::write " DISABLE_ERROR);
 }
 
+void LazyDeltaDelayModel::read(const std::string& /*file*/) {
+    VPR_THROW(VPR_ERROR_PLACE, "LazyDeltaDelayModel::read " DISABLE_ERROR);
+}
+
+void LazyDeltaDelayModel::write(const std::string& /*file*/) const {
+    VPR_THROW(VPR_ERROR_PLACE, "LazyDeltaDelayModel::write " DISABLE_ERROR);
+}
+
 void OverrideDelayModel::read(const std::string& /*file*/) {
     VPR_THROW(VPR_ERROR_PLACE, "OverrideDelayModel::read " DISABLE_ERROR);
 }
@@ -256,6 +438,74 @@ void DeltaDelayModel::write(const std::string& file) const {
     writeMessageToFile(file, &builder);
 }
 
+static void ToBool(bool* out, const VprBoolEntry::Reader& in) {
+    *out = in.getValue();
+}
+
+static void FromBool(VprBoolEntry::Builder* out, const bool& in) {
+    out->setValue(in);
+}
+
+void LazyDeltaDelayModel::read(const std::string& file) {
+    MmapFile f(file);
+
+    /* Increase reader limit to 1G words to allow for large files. */
+    ::capnp::ReaderOptions opts = default_large_capnp_opts();
+    ::capnp::FlatArrayMessageReader reader(f.getData(), opts);
+
+    auto model = reader.getRoot<VprDeltaDelayModel>();
+
+    vtr::NdMatrix<float, 4> delays;
+    ToNdMatrix<4, VprFloatEntry, float>(&delays, model.getDelays(), ToFloat);
+
+    //Files written by a DeltaDelayModel have no mask: all their entries were computed
+    vtr::NdMatrix<bool, 4> filled;
+    if (model.hasFilled()) {
+        ToNdMatrix<4, VprBoolEntry, bool>(&filled, model.getFilled(), ToBool);
+    } else {
+        filled.resize({delays.dim_size(0), delays.dim_size(1), delays.dim_size(2), delays.dim_size(3)}, true);
+    }
+
+    init_tables();
+    if (delays.dim_size(0) != num_layers_ || delays.dim_size(1) != num_layers_
+        || delays.dim_size(2) != width_ || delays.dim_size(3) != height_
+        || filled.size() != delays.size()) {
+        VPR_THROW(VPR_ERROR_PLACE, "Placement delay model '%s' does not match the device", file.c_str());
+    }
+
+    size_t num_filled = 0;
+    for (size_t from_layer = 0; from_layer < num_layers_; ++from_layer) {
+        for (size_t to_layer = 0; to_layer < num_layers_; ++to_layer) {
+            for (size_t dx = 0; dx < width_; ++dx) {
+                for (size_t dy = 0; dy < height_; ++dy) {
+                    if (filled[from_layer][to_layer][dx][dy]) {
+                        delays_[index(from_layer, to_layer, dx, dy)].store(delays[from_layer][to_layer][dx][dy], std::memory_order_relaxed);
+                        ++num_filled;
+                    }
+                }
+            }
+        }
+    }
+    num_filled_.store(num_filled, std::memory_order_release);
+    num_persisted_ = num_filled;
+}
+
+void LazyDeltaDelayModel::write(const std::string& file) const {
+    ::capnp::MallocMessageBuilder builder;
+    auto model = builder.initRoot<VprDeltaDelayModel>();
+
+    vtr::NdMatrix<bool, 4> filled;
+    vtr::NdMatrix<float, 4> delays = snapshot(&filled);
+
+    auto delay_values = model.getDelays();
+    FromNdMatrix<4, VprFloatEntry, float>(&delay_values, delays, FromFloat);
+
+    auto filled_values = model.getFilled();
+    FromNdMatrix<4, VprBoolEntry, bool>(&filled_values, filled, FromBool);
+
+    writeMessageToFile(file, &builder);
+}
+
 void OverrideDelayModel::read(const std::string& file) {
     MmapFile f(file);
 
@@ -286,6 +536,7 @@ void OverrideDelayModel::read(const std::string& file) {
     }
 
     delay_overrides_ = vtr::make_flat_map2(std::move(overrides_arr));
+    rebuild_override_tables();
 }
 
 void OverrideDelayModel::write(const std::string& file) const {
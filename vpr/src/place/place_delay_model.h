@@ -5,6 +5,13 @@
  */
 
 #pragma once
+#include <array>
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <set>
+
 #include "vtr_ndmatrix.h"
 #include "vtr_flat_map.h"
 #include "vpr_types.h"
@@ -27,6 +34,7 @@
 ///@brief Forward declarations.
 class PlaceDelayModel;
 class PlacerState;
+class DelayProfilerPool;
 
 ///@brief Initialize the placer delay model.
 std::unique_ptr<PlaceDelayModel> alloc_lookups_and_delay_model(const Netlist<>& net_list,
@@ -85,6 +93,14 @@ class PlaceDelayModel {
      * May be unimplemented, in which case method should throw an exception.
      */
     virtual void read(const std::string& file) = 0;
+
+    /**
+     * @brief Saves what the model learned while it was queried.
+     *
+     * Called once the placer is done with the model. Most models are complete
+     * once computed or read, so this does nothing by default.
+     */
+    virtual void persist() {}
 };
 
 ///@brief A simple delay model based on the distance (delta) between block locations.
@@ -124,6 +140,124 @@ class DeltaDelayModel : public PlaceDelayModel {
     bool is_flat_;
 };
 
+///@brief A location sampled to profile the delta delays, and the region of sinks routed to from it
+struct t_delta_sample_source {
+    int x;
+    int y;
+    int start_x;
+    int start_y;
+    int end_x;
+    int end_y;
+};
+
+/**
+ * @brief A DeltaDelayModel whose entries are computed the first time they are queried.
+ *
+ * Computing a DeltaDelayModel routes sample connections for every (from_layer, to_layer,
+ * dx, dy) entry of the device, while the placement of a small design on a large device
+ * only ever queries a small range of deltas. This model only computes a coarse lattice of
+ * entries (every COARSE_SAMPLE_STRIDE in x and y) up front. Any other entry is computed on
+ * its first query, by routing the same sample connections DeltaDelayModel::compute() would
+ * have used for it.
+ *
+ * delay() may be called concurrently: entries are memoized as atomics, and computed under
+ * locks striped over the entries so that each entry is only routed once. The connections are
+ * routed on the RR graph built for the delay model, so the model may only be queried while
+ * it exists (i.e. during placement).
+ *
+ * The model is stored in the DeltaDelayModel format, with the entries not computed yet holding
+ * their coarse estimate, and a mask of the computed ones. Reading such a file back only computes
+ * the entries still missing, and persist() rewrites the timing model cache entry and the
+ * --write_placement_delay_lookup file with the entries filled in meanwhile, so that later runs
+ * start from them.
+ */
+class LazyDeltaDelayModel : public PlaceDelayModel {
+  public:
+    ///@brief Spacing in x and y of the entries computed up front
+    static constexpr int COARSE_SAMPLE_STRIDE = 8;
+
+    LazyDeltaDelayModel(float min_cross_layer_delay,
+                        bool is_flat);
+    ~LazyDeltaDelayModel() override;
+
+    /**
+     * @brief Computes the coarse lattice of entries (those not already read), and keeps
+     *        a profiler routing on route_profiler's RR graph to compute the others
+     */
+    void compute(
+        RouterDelayProfiler& route_profiler,
+        const t_placer_opts& placer_opts,
+        const t_router_opts& router_opts,
+        int longest_length) override;
+    float delay(const t_physical_tile_loc& from_loc, int /*from_pin*/, const t_physical_tile_loc& to_loc, int /*to_pin*/) const override;
+    void dump_echo(std::string filepath) const override;
+
+    void read(const std::string& file) override;
+    void write(const std::string& file) const override;
+
+    ///@brief Calls the persist functions if entries were computed since the last call
+    void persist() override;
+
+    ///@brief Adds a function (re-)writing the model, called by persist()
+    void add_persist_fn(std::function<void()> persist_fn);
+
+    ///@brief Returns the number of entries computed (or read) so far
+    size_t num_filled() const { return num_filled_.load(std::memory_order_relaxed); }
+
+  private:
+    size_t index(int from_layer, int to_layer, int delta_x, int delta_y) const {
+        return ((size_t(from_layer) * num_layers_ + to_layer) * width_ + delta_x) * height_ + delta_y;
+    }
+
+    ///@brief Sizes the tables for the current device, with no entry computed
+    void init_tables();
+
+    ///@brief Computes (once) an entry, falling back to the coarse estimate if allow_estimate
+    float fill_delay(int from_layer, int to_layer, int delta_x, int delta_y, bool allow_estimate) const;
+
+    ///@brief Computes (once) the reduced sampled delay of an entry, which may be EMPTY or IMPOSSIBLE
+    float sampled_delay(int from_layer, int to_layer, int delta_x, int delta_y) const;
+
+    float find_neighbouring_average(int from_layer, int to_layer, int delta_x, int delta_y, int max_distance) const;
+
+    float coarse_estimate(int from_layer, int to_layer, int delta_x, int delta_y) const;
+
+    ///@brief Returns all the entries, with the coarse estimate for those not computed yet, and which ones were
+    vtr::NdMatrix<float, 4> snapshot(vtr::NdMatrix<bool, 4>* filled) const;
+
+    float cross_layer_delay_;
+    /**
+     * @brief Indicates whether the router is a two-stage or run-flat
+     */
+    bool is_flat_;
+
+    size_t num_layers_ = 0;
+    size_t width_ = 0;
+    size_t height_ = 0;
+
+    mutable std::vector<std::atomic<float>> delays_;         //[index()], NaN until computed
+    mutable std::vector<std::atomic<float>> sampled_delays_; //[index()], NaN until computed
+    mutable std::atomic<size_t> num_filled_{0};
+    size_t num_persisted_ = 0;
+
+    //Entries and sampled delays are locked separately, since computing an entry may sample its neighbours
+    static constexpr size_t NUM_LOCK_STRIPES = 64;
+    mutable std::array<std::mutex, NUM_LOCK_STRIPES> delay_locks_;
+    mutable std::array<std::mutex, NUM_LOCK_STRIPES> sample_locks_;
+
+    vtr::NdMatrix<float, 4> coarse_delays_; // [0..num_layers-1][0..num_layers-1][0..max_dx / COARSE_SAMPLE_STRIDE][0..max_dy / COARSE_SAMPLE_STRIDE]
+
+    //Profiling state, set up by compute()
+    std::unique_ptr<RouterDelayProfiler> route_profiler_;
+    std::unique_ptr<DelayProfilerPool> profiler_pool_;
+    t_router_opts router_opts_;
+    e_reducer reducer_ = e_reducer::MIN;
+    std::set<std::string> allowed_types_;
+    std::vector<std::vector<t_delta_sample_source>> sample_sources_; //[from_layer]
+
+    std::vector<std::function<void()>> persist_fns_;
+};
+
 class OverrideDelayModel : public PlaceDelayModel {
   public:
     OverrideDelayModel(float min_cross_layer_delay,
@@ -216,6 +350,56 @@ class OverrideDelayModel : public PlaceDelayModel {
      */
     vtr::flat_map2<t_override, float> delay_overrides_;
 
+    /**
+     * @brief Dense index of the overrides of one (from_type, to_type) pair.
+     *
+     * The overrides are stored over the bounding box of their pin classes and deltas,
+     * with a bitmap of which entries hold an override, so that delay() finds them
+     * without searching delay_overrides_.
+     */
+    struct t_override_table {
+        static constexpr size_t NO_INDEX = std::numeric_limits<size_t>::max();
+
+        int num_from_class = 0;
+        int num_to_class = 0;
+        int min_delta_x = 0;
+        int min_delta_y = 0;
+        int num_delta_x = 0;
+        int num_delta_y = 0;
+
+        std::vector<float> delays;
+        std::vector<bool> has_override;
+
+        ///@brief Returns the entry of the specified override, or NO_INDEX if outside of the table
+        size_t index(int from_class, int to_class, int delta_x, int delta_y) const {
+            int dx = delta_x - min_delta_x;
+            int dy = delta_y - min_delta_y;
+            if (from_class < 0 || from_class >= num_from_class || to_class < 0 || to_class >= num_to_class
+                || dx < 0 || dx >= num_delta_x || dy < 0 || dy >= num_delta_y) {
+                return NO_INDEX;
+            }
+            return ((size_t(from_class) * num_to_class + to_class) * num_delta_x + dx) * num_delta_y + dy;
+        }
+    };
+
+    std::vector<t_override_table> override_tables_;
+    vtr::NdMatrix<int, 2> override_table_index_; //[from_type][to_type] -> index in override_tables_, or OPEN if no overrides
+
+    ///@brief Returns the override table of a (from_type, to_type) pair, or nullptr if it has no overrides
+    const t_override_table* find_override_table(int from_type, int to_type) const {
+        if (from_type >= (int)override_table_index_.dim_size(0) || to_type >= (int)override_table_index_.dim_size(1)) {
+            return nullptr;
+        }
+        int itable = override_table_index_[from_type][to_type];
+        return itable == OPEN ? nullptr : &override_tables_[itable];
+    }
+
+    ///@brief Rebuilds the override table of a (from_type, to_type) pair from delay_overrides_
+    void rebuild_override_table(int from_type, int to_type);
+
+    ///@brief Rebuilds all the override tables from delay_overrides_
+    void rebuild_override_tables();
+
     /**
      * operator< treats memory layout of t_override as an array of short.
      * This requires all members of t_override are shorts and there is no
@@ -0,0 +1,120 @@
+/**
+ * @file place_macro_footprints.cpp
+ * @brief Defines the PlaceMacroFootprints routines declared in place_macro_footprints.h.
+ */
+
+#include "place_macro_footprints.h"
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+#include "globals.h"
+#include "place_macro.h"
+#include "blk_loc_registry.h"
+#include "physical_types_util.h"
+#include "vtr_memory.h"
+
+void PlaceMacroFootprints::init(const std::vector<t_pl_macro>& pl_macros, const BlkLocRegistry& blk_loc_registry) {
+    const auto& grid = g_vpr_ctx.device().grid;
+    const auto& clb_nlist = g_vpr_ctx.clustering().clb_nlist;
+    const auto& block_locs = blk_loc_registry.block_locs();
+    const GridBlock& grid_blocks = blk_loc_registry.grid_blocks();
+
+    clear();
+
+    //Number the sub tiles of the device, and record the location of each of them
+    std::vector<t_pl_loc> bit_locs;
+    loc_first_bit_.resize({(size_t)grid.get_num_layers(), grid.width(), grid.height()});
+    for (int layer_num = 0; layer_num < grid.get_num_layers(); layer_num++) {
+        for (int x = 0; x < (int)grid.width(); x++) {
+            for (int y = 0; y < (int)grid.height(); y++) {
+                loc_first_bit_[layer_num][x][y] = bit_locs.size();
+                int capacity = grid.get_physical_type({x, y, layer_num})->capacity;
+                for (int sub_tile = 0; sub_tile < capacity; sub_tile++) {
+                    bit_locs.emplace_back(x, y, sub_tile, layer_num);
+                }
+            }
+        }
+    }
+
+    //The legal locations of each logical block type (computed when first needed)
+    std::vector<vtr::dynamic_bitset<>> type_legal_locs(g_vpr_ctx.device().logical_block_types.size());
+    auto get_type_legal_locs = [&](t_logical_block_type_ptr logical_block) -> const vtr::dynamic_bitset<>& {
+        vtr::dynamic_bitset<>& legal_locs = type_legal_locs[logical_block->index];
+        if (legal_locs.size() == 0) {
+            legal_locs.resize(bit_locs.size());
+            for (size_t bit = 0; bit < bit_locs.size(); bit++) {
+                const t_pl_loc& loc = bit_locs[bit];
+                ClusterBlockId blk_at_loc = grid_blocks.block_at_location(loc);
+                bool legal = is_sub_tile_compatible(grid.get_physical_type({loc.x, loc.y, loc.layer}), logical_block, loc.sub_tile)
+                             && !(blk_at_loc && block_locs[blk_at_loc].is_fixed);
+                legal_locs.set(bit, legal);
+            }
+        }
+        return legal_locs;
+    };
+
+    //Macros with the same footprint share their legal head locations
+    std::map<std::vector<std::pair<t_pl_offset, int>>, int> footprint_lookup;
+    macro_footprint_.resize(pl_macros.size(), OPEN);
+    for (size_t imacro = 0; imacro < pl_macros.size(); imacro++) {
+        std::vector<std::pair<t_pl_offset, int>> footprint;
+        for (const t_pl_macro_member& member : pl_macros[imacro].members) {
+            footprint.emplace_back(member.offset, clb_nlist.block_type(member.blk_index)->index);
+        }
+
+        auto [itr, inserted] = footprint_lookup.emplace(std::move(footprint), (int)legal_head_locs_.size());
+        macro_footprint_[imacro] = itr->second;
+        if (!inserted) {
+            continue;
+        }
+
+        //Start from the locations the head can be at, and drop those where another member can't be
+        std::vector<int> head_bits;
+        const auto& head_legal_locs = get_type_legal_locs(clb_nlist.block_type(pl_macros[imacro].members[0].blk_index));
+        head_legal_locs.for_each_set_bit([&](size_t bit) {
+            head_bits.push_back(bit);
+        });
+
+        for (const t_pl_macro_member& member : pl_macros[imacro].members) {
+            const auto& member_legal_locs = get_type_legal_locs(clb_nlist.block_type(member.blk_index));
+            auto is_illegal_head_bit = [&](int head_bit) {
+                int member_bit = loc_bit(bit_locs[head_bit] + member.offset);
+                return member_bit == OPEN || !member_legal_locs.get(member_bit);
+            };
+            head_bits.erase(std::remove_if(head_bits.begin(), head_bits.end(), is_illegal_head_bit), head_bits.end());
+        }
+
+        vtr::dynamic_bitset<>& legal_head_locs = legal_head_locs_.emplace_back(bit_locs.size());
+        for (int bit : head_bits) {
+            legal_head_locs.set(bit, true);
+        }
+    }
+}
+
+void PlaceMacroFootprints::clear() {
+    vtr::release_memory(macro_footprint_);
+    vtr::release_memory(legal_head_locs_);
+    loc_first_bit_.clear();
+}
+
+bool PlaceMacroFootprints::is_legal_head_loc(int imacro, const t_pl_loc& head_loc) const {
+    VTR_ASSERT_SAFE(imacro >= 0 && imacro < (int)macro_footprint_.size());
+
+    int bit = loc_bit(head_loc);
+    return bit != OPEN && legal_head_locs_[macro_footprint_[imacro]].get(bit);
+}
+
+int PlaceMacroFootprints::loc_bit(const t_pl_loc& loc) const {
+    const auto& grid = g_vpr_ctx.device().grid;
+
+    if (loc.x < 0 || loc.x >= (int)grid.width()
+        || loc.y < 0 || loc.y >= (int)grid.height()
+        || loc.layer < 0 || loc.layer >= grid.get_num_layers()
+        || loc.sub_tile < 0 || loc.sub_tile >= grid.get_physical_type({loc.x, loc.y, loc.layer})->capacity) {
+        return OPEN;
+    }
+
+    return loc_first_bit_[loc.layer][loc.x][loc.y] + loc.sub_tile;
+}
@@ -0,0 +1,62 @@
+#ifndef VPR_PLACE_MACRO_FOOTPRINTS_H
+#define VPR_PLACE_MACRO_FOOTPRINTS_H
+
+/**
+ * @file place_macro_footprints.h
+ * @brief Precomputed legal head locations of the placement macros
+ *
+ * Moving a placement macro is only legal if each of its members lands on an on-chip location
+ * compatible with its logical block type, which isn't occupied by a fixed block. None of this
+ * depends on the movable blocks, so for each macro footprint (the offsets and logical block types
+ * of its members, shared by e.g. all the carry chains of the same length) the set of locations its
+ * head can be moved to is computed once, as a bitmap over all the sub tiles of the device.
+ * Checking a whole macro move then takes a single bit look-up instead of one
+ * is_legal_swap_to_location() call per member.
+ */
+
+#include <vector>
+
+#include "vpr_types.h"
+#include "vtr_ndmatrix.h"
+#include "vtr_dynamic_bitset.h"
+
+struct t_pl_macro;
+class BlkLocRegistry;
+
+class PlaceMacroFootprints {
+  public:
+    /**
+     * @brief Computes the legal head locations of each macro footprint
+     *
+     * Must be called once the fixed blocks are placed in blk_loc_registry, since the locations of
+     * the fixed blocks are treated as illegal for all macro members (fixed blocks never move).
+     */
+    void init(const std::vector<t_pl_macro>& pl_macros, const BlkLocRegistry& blk_loc_registry);
+
+    ///@brief Frees the footprints
+    void clear();
+
+    ///@brief Returns true if init() was called (and not cleared since)
+    bool is_initialized() const { return !macro_footprint_.empty(); }
+
+    /**
+     * @brief Returns true if each member of macro imacro would be at a legal location
+     *        (see is_legal_swap_to_location()) with its head at head_loc
+     */
+    bool is_legal_head_loc(int imacro, const t_pl_loc& head_loc) const;
+
+  private:
+    ///@brief Returns the bit of loc, OPEN if loc is not on the device
+    int loc_bit(const t_pl_loc& loc) const;
+
+    ///@brief The first bit of the sub tiles of each grid location [0..num_layers-1][0..width-1][0..height-1]
+    vtr::NdMatrix<int, 3> loc_first_bit_;
+
+    ///@brief The footprint of each macro (index in legal_head_locs_)
+    std::vector<int> macro_footprint_;
+
+    ///@brief The legal head locations of each footprint, indexed by loc_bit()
+    std::vector<vtr::dynamic_bitset<>> legal_head_locs_;
+};
+
+#endif
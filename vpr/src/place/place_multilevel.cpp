@@ -0,0 +1,248 @@
+/**
+ * @file place_multilevel.cpp
+ * @brief Defines the routines declared in place_multilevel.h.
+ */
+
+#include "place_multilevel.h"
+
+#include "globals.h"
+#include "placer_state.h"
+#include "place_macro.h"
+#include "place_constraints.h"
+#include "move_utils.h"
+
+/* Routines local to place_multilevel.cpp */
+static bool is_groupable_block(ClusterBlockId blk_id,
+                               const BlkLocRegistry& blk_loc_registry);
+
+static void record_group_member_move(t_pl_blocks_to_be_moved& blocks_affected,
+                                     ClusterBlockId member,
+                                     t_pl_offset offset,
+                                     const BlkLocRegistry& blk_loc_registry);
+
+///@brief Returns true if blk_id can be grouped with other blocks (and moved along with them)
+static bool is_groupable_block(ClusterBlockId blk_id,
+                               const BlkLocRegistry& blk_loc_registry) {
+    const auto& pl_macros = g_vpr_ctx.placement().pl_macros;
+
+    if (blk_loc_registry.block_locs()[blk_id].is_fixed || is_cluster_constrained(blk_id)) {
+        return false;
+    }
+
+    int imacro = OPEN;
+    get_imacro_from_iblk(&imacro, blk_id, pl_macros);
+    return imacro == OPEN;
+}
+
+std::vector<t_placement_level> coarsen_clustered_netlist(int num_levels,
+                                                         int high_fanout_net,
+                                                         const BlkLocRegistry& blk_loc_registry) {
+    const auto& clb_nlist = g_vpr_ctx.clustering().clb_nlist;
+
+    std::vector<t_placement_level> levels;
+
+    //The groups of the previous level, starting from the groupable blocks themselves
+    std::vector<std::vector<ClusterBlockId>> groups;
+    vtr::vector<ClusterBlockId, int> block_group(clb_nlist.blocks().size(), OPEN);
+    for (ClusterBlockId blk_id : clb_nlist.blocks()) {
+        if (is_groupable_block(blk_id, blk_loc_registry)) {
+            block_group[blk_id] = groups.size();
+            groups.push_back({blk_id});
+        }
+    }
+    const int num_ungroupable_blocks = (int)clb_nlist.blocks().size() - (int)groups.size();
+
+    //Connection weight to each group of the group being matched (and the groups with a non-zero weight)
+    std::vector<float> group_weights(groups.size(), 0.);
+    std::vector<int> connected_groups;
+
+    for (int ilevel = 0; ilevel < num_levels; ilevel++) {
+        std::vector<int> group_match(groups.size(), OPEN);
+        int num_matches = 0;
+
+        for (int igroup = 0; igroup < (int)groups.size(); igroup++) {
+            if (group_match[igroup] != OPEN) {
+                continue;
+            }
+
+            t_logical_block_type_ptr group_type = clb_nlist.block_type(groups[igroup][0]);
+
+            for (ClusterBlockId blk_id : groups[igroup]) {
+                for (ClusterPinId pin_id : clb_nlist.block_pins(blk_id)) {
+                    ClusterNetId net_id = clb_nlist.pin_net(pin_id);
+                    int num_net_pins = clb_nlist.net_pins(net_id).size();
+                    if (clb_nlist.net_is_ignored(net_id) || num_net_pins < 2 || num_net_pins > high_fanout_net) {
+                        continue;
+                    }
+
+                    float weight = 1. / (num_net_pins - 1);
+                    for (ClusterPinId net_pin_id : clb_nlist.net_pins(net_id)) {
+                        int other_group = block_group[clb_nlist.pin_block(net_pin_id)];
+                        if (other_group == OPEN || other_group == igroup || group_match[other_group] != OPEN
+                            || clb_nlist.block_type(groups[other_group][0]) != group_type) {
+                            continue;
+                        }
+
+                        if (group_weights[other_group] == 0.) {
+                            connected_groups.push_back(other_group);
+                        }
+                        group_weights[other_group] += weight;
+                    }
+                }
+            }
+
+            int best_group = OPEN;
+            for (int other_group : connected_groups) {
+                if (best_group == OPEN || group_weights[other_group] > group_weights[best_group]
+                    || (group_weights[other_group] == group_weights[best_group] && other_group < best_group)) {
+                    best_group = other_group;
+                }
+                group_weights[other_group] = 0.;
+            }
+            connected_groups.clear();
+
+            if (best_group != OPEN) {
+                group_match[igroup] = best_group;
+                group_match[best_group] = igroup;
+                num_matches++;
+            }
+        }
+
+        //Not worth another level
+        if (num_matches < 0.1 * groups.size()) {
+            break;
+        }
+
+        //Merge the matched groups
+        std::vector<std::vector<ClusterBlockId>> coarse_groups;
+        for (int igroup = 0; igroup < (int)groups.size(); igroup++) {
+            if (group_match[igroup] != OPEN && group_match[igroup] < igroup) {
+                continue; //Merged into its match
+            }
+
+            int icoarse_group = coarse_groups.size();
+            coarse_groups.push_back(std::move(groups[igroup]));
+            if (group_match[igroup] != OPEN) {
+                auto& match_blocks = groups[group_match[igroup]];
+                coarse_groups.back().insert(coarse_groups.back().end(), match_blocks.begin(), match_blocks.end());
+            }
+            for (ClusterBlockId blk_id : coarse_groups.back()) {
+                block_group[blk_id] = icoarse_group;
+            }
+        }
+        groups = std::move(coarse_groups);
+        group_weights.resize(groups.size());
+
+        t_placement_level level;
+        level.block_group.resize(clb_nlist.blocks().size(), OPEN);
+        level.num_coarse_blocks = num_ungroupable_blocks;
+        for (const auto& group : groups) {
+            level.num_coarse_blocks++;
+            if (group.size() < 2) {
+                continue;
+            }
+
+            for (ClusterBlockId blk_id : group) {
+                level.block_group[blk_id] = level.groups.size();
+            }
+            level.groups.push_back(group);
+        }
+
+        VTR_LOG("Multilevel placement level %d: %d blocks (%zu groups of 2 or more blocks)\n",
+                ilevel + 1, level.num_coarse_blocks, level.groups.size());
+        levels.push_back(std::move(level));
+    }
+
+    return levels;
+}
+
+int get_placement_level(int num_temps, int num_levels, int temps_per_level) {
+    int level = num_levels - 1 - num_temps / temps_per_level;
+    return (level >= 0) ? level : OPEN;
+}
+
+/**
+ * @brief Moves member by offset, swapping it with the block at its new location (if any)
+ *
+ * Nothing is recorded if the move isn't legal, or if it involves a location already moved from
+ * or to by blocks_affected (so recording the move can't fail half way through).
+ */
+static void record_group_member_move(t_pl_blocks_to_be_moved& blocks_affected,
+                                     ClusterBlockId member,
+                                     t_pl_offset offset,
+                                     const BlkLocRegistry& blk_loc_registry) {
+    const auto& pl_macros = g_vpr_ctx.placement().pl_macros;
+    const GridBlock& grid_blocks = blk_loc_registry.grid_blocks();
+
+    t_pl_loc from = blk_loc_registry.block_locs()[member].loc;
+    t_pl_loc to = from + offset;
+
+    if (blocks_affected.moved_from.count(from) || blocks_affected.moved_to.count(from)
+        || blocks_affected.moved_from.count(to) || blocks_affected.moved_to.count(to)) {
+        return;
+    }
+
+    if (!is_legal_swap_to_location(member, to, blk_loc_registry)) {
+        return;
+    }
+
+    ClusterBlockId b_to = grid_blocks.block_at_location(to);
+    if (b_to) {
+        int imacro_to = OPEN;
+        get_imacro_from_iblk(&imacro_to, b_to, pl_macros);
+        if (imacro_to != OPEN || !is_legal_swap_to_location(b_to, from, blk_loc_registry)
+            || (is_cluster_constrained(b_to) && !cluster_floorplanning_legal(b_to, from))) {
+            return;
+        }
+    }
+
+    e_block_move_result outcome = blocks_affected.record_block_move(member, to, blk_loc_registry);
+    VTR_ASSERT_SAFE(outcome == e_block_move_result::VALID);
+    if (b_to) {
+        outcome = blocks_affected.record_block_move(b_to, from, blk_loc_registry);
+        VTR_ASSERT_SAFE(outcome == e_block_move_result::VALID);
+    }
+    (void)outcome;
+}
+
+MultilevelMoveGenerator::MultilevelMoveGenerator(PlacerState& placer_state,
+                                                 MoveGenerator& move_generator,
+                                                 const t_placement_level& level)
+    : MoveGenerator(placer_state)
+    , move_generator_(move_generator)
+    , level_(level) {}
+
+e_create_move MultilevelMoveGenerator::propose_move(t_pl_blocks_to_be_moved& blocks_affected,
+                                                    t_propose_action& proposed_action,
+                                                    float rlim,
+                                                    const t_placer_opts& placer_opts,
+                                                    const PlacerCriticalities* criticalities) {
+    e_create_move create_move = move_generator_.get().propose_move(blocks_affected, proposed_action, rlim,
+                                                                    placer_opts, criticalities);
+    if (create_move != e_create_move::VALID || blocks_affected.moved_blocks.empty()) {
+        return create_move;
+    }
+
+    const t_placement_level& level = level_.get();
+    const t_pl_moved_block first_moved_block = blocks_affected.moved_blocks[0];
+
+    int igroup = level.block_group[first_moved_block.block_num];
+    if (igroup == OPEN) {
+        return create_move;
+    }
+
+    //Move the rest of the group along
+    const auto& blk_loc_registry = placer_state_.get().blk_loc_registry();
+    t_pl_offset offset = first_moved_block.new_loc - first_moved_block.old_loc;
+    for (ClusterBlockId member : level.groups[igroup]) {
+        if (member != first_moved_block.block_num) {
+            record_group_member_move(blocks_affected, member, offset, blk_loc_registry);
+        }
+    }
+
+    return create_move;
+}
+
+void MultilevelMoveGenerator::process_outcome(double reward, e_reward_function reward_fun) {
+    move_generator_.get().process_outcome(reward, reward_fun);
+}
@@ -0,0 +1,88 @@
+#ifndef VPR_PLACE_MULTILEVEL_H
+#define VPR_PLACE_MULTILEVEL_H
+
+/**
+ * @file place_multilevel.h
+ * @brief Coarsening of the clustered netlist for the multilevel annealer
+ *
+ * The multilevel annealer (see --place_multilevel_levels) starts the anneal on a coarsened
+ * netlist, whose blocks are groups of strongly connected clustered blocks, and uncoarsens it
+ * one level at a time as the anneal cools down.
+ *
+ * A coarse level doesn't build another netlist: the annealer keeps evaluating the cost of the
+ * clustered netlist, but each move of a block also moves (by the same offset) the other blocks
+ * of its group (see MultilevelMoveGenerator). Groups are therefore placed as a whole at the
+ * coarse levels, at the high temperatures, and refined block by block at the finer levels.
+ */
+
+#include <vector>
+
+#include "vtr_vector.h"
+#include "move_generator.h"
+
+class BlkLocRegistry;
+
+/**
+ * @brief A coarse level of the clustered netlist
+ */
+struct t_placement_level {
+    ///@brief The group of each block, OPEN if the block is not grouped with any other block
+    vtr::vector<ClusterBlockId, int> block_group;
+
+    ///@brief The blocks of each group (of 2 or more blocks)
+    std::vector<std::vector<ClusterBlockId>> groups;
+
+    ///@brief The number of groups and ungrouped blocks, i.e. the number of blocks of the coarse netlist
+    int num_coarse_blocks = 0;
+};
+
+/**
+ * @brief Builds up to num_levels coarse levels of the clustered netlist, from the finest to the coarsest
+ *
+ * Each level matches the groups of the previous level (the blocks for the first level) by heavy edge
+ * matching: a group is merged with the unmatched group it shares the most connections with, weighting
+ * each net by 1/(number of pins - 1). Nets with more than high_fanout_net pins are not considered.
+ *
+ * Only blocks of the same logical type are grouped, and fixed blocks, placement macro members and
+ * blocks with floorplan constraints are never grouped, so that group moves don't need to check them.
+ * Coarsening stops early when a level would merge less than 10% of the groups of the previous one.
+ */
+std::vector<t_placement_level> coarsen_clustered_netlist(int num_levels,
+                                                         int high_fanout_net,
+                                                         const BlkLocRegistry& blk_loc_registry);
+
+/**
+ * @brief Returns the level (index in the levels returned by coarsen_clustered_netlist()) the anneal
+ *        is at after num_temps temperatures, OPEN once it is back to the flat netlist
+ */
+int get_placement_level(int num_temps, int num_levels, int temps_per_level);
+
+/**
+ * @brief A move generator which moves groups of blocks of a coarse level
+ *
+ * The moves are proposed by another move generator. The other blocks of the group of the first
+ * block moved are then moved by the same offset, swapping with the blocks at their new locations.
+ * A group member which can't move by this offset (illegal or already used location, ...) stays in
+ * place, so the groups are not rigid.
+ */
+class MultilevelMoveGenerator : public MoveGenerator {
+  public:
+    MultilevelMoveGenerator() = delete;
+    MultilevelMoveGenerator(PlacerState& placer_state,
+                            MoveGenerator& move_generator,
+                            const t_placement_level& level);
+
+    e_create_move propose_move(t_pl_blocks_to_be_moved& blocks_affected,
+                               t_propose_action& proposed_action,
+                               float rlim,
+                               const t_placer_opts& placer_opts,
+                               const PlacerCriticalities* criticalities) override;
+
+    void process_outcome(double reward, e_reward_function reward_fun) override;
+
+  private:
+    std::reference_wrapper<MoveGenerator> move_generator_;
+    std::reference_wrapper<const t_placement_level> level_;
+};
+
+#endif
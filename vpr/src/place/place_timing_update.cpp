@@ -8,6 +8,10 @@
 #include "place_timing_update.h"
 #include "placer_state.h"
 
+#ifdef VPR_USE_TBB
+#    include <tbb/parallel_for_each.h>
+#endif
+
 /* Routines local to place_timing_update.cpp */
 static double comp_td_connection_cost(const PlaceDelayModel* delay_model,
                                       const PlacerCriticalities& place_crit,
@@ -237,7 +241,8 @@ bool verify_connection_setup_slacks(const PlacerSetupSlacks* setup_slacks,
  * @brief Incrementally updates timing cost based on the current delays and criticality estimates.
  *
  * Unlike comp_td_costs(), this only updates connections who's criticality has changed.
- * This is a superset of those connections whose connection delay has changed. For a
+ * The costs of the connections whose delay changed with the same criticality are already
+ * up to date, since commit_td_cost() records them as moves are accepted. For a
  * from-scratch recalculation, refer to comp_td_cost().
  *
  * We must be careful calculating the total timing cost incrementally, due to limited
@@ -316,6 +321,10 @@ void update_td_costs(const PlaceDelayModel* delay_model,
  * sum of nets) in order to allow it to be incremental while avoiding round-off effects.
  *
  * For a more efficient incremental update, see update_td_costs().
+ *
+ * The nets are costed in parallel, and the intermediate costs of the changed connections
+ * are then invalidated serially. The total is still summed net by net in netlist order,
+ * so it is the same whatever the number of threads.
  */
 void comp_td_costs(const PlaceDelayModel* delay_model,
                    const PlacerCriticalities& place_crit,
@@ -327,18 +336,40 @@ void comp_td_costs(const PlaceDelayModel* delay_model,
     auto& connection_timing_cost = p_timing_ctx.connection_timing_cost;
     auto& net_timing_cost = p_timing_ctx.net_timing_cost;
 
-    for (ClusterNetId net_id : cluster_ctx.clb_nlist.nets()) {
-        if (cluster_ctx.clb_nlist.net_is_ignored(net_id)) continue;
+    //Whether any connection cost of each net changed
+    std::vector<char> net_changed(cluster_ctx.clb_nlist.nets().size(), false);
+
+    auto comp_net_td_cost = [&](ClusterNetId net_id) {
+        if (cluster_ctx.clb_nlist.net_is_ignored(net_id)) return;
 
         for (size_t ipin = 1; ipin < cluster_ctx.clb_nlist.net_pins(net_id).size(); ipin++) {
             float conn_timing_cost = comp_td_connection_cost(delay_model, place_crit, placer_state, net_id, ipin);
 
             /* Record new value */
-            connection_timing_cost[net_id][ipin] = conn_timing_cost;
+            if (connection_timing_cost.set_connection_cost_deferred(net_id, ipin, conn_timing_cost)) {
+                net_changed[size_t(net_id)] = true;
+            }
         }
         /* Store net timing cost for more efficient incremental updating */
         net_timing_cost[net_id] = sum_td_net_cost(net_id, placer_state);
+    };
+
+#ifdef VPR_USE_TBB
+    tbb::parallel_for_each(cluster_ctx.clb_nlist.nets().begin(), cluster_ctx.clb_nlist.nets().end(), comp_net_td_cost);
+#else
+    for (ClusterNetId net_id : cluster_ctx.clb_nlist.nets()) {
+        comp_net_td_cost(net_id);
     }
+#endif
+
+    for (ClusterNetId net_id : cluster_ctx.clb_nlist.nets()) {
+        if (!net_changed[size_t(net_id)]) continue;
+
+        for (size_t ipin = 1; ipin < cluster_ctx.clb_nlist.net_pins(net_id).size(); ipin++) {
+            connection_timing_cost.invalidate_connection(net_id, ipin);
+        }
+    }
+
     /* Make sure timing cost does not go above MIN_TIMING_COST. */
     *timing_cost = sum_td_costs(placer_state);
 }
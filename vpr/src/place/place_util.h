@@ -72,6 +72,10 @@ struct NocCostTerms {
  *   @param timing_cost_norm The normalization factor for the timing cost, which
  *              is upper-bounded by the value of MAX_INV_TIMING_COST.
  *
+ *   @param congestion_cost The estimated routing congestion cost (see routing_demand_map.h),
+ *              only computed with a non-zero --place_congestion_weight. It is a
+ *              wirelength, so it is normalized by bb_cost_norm.
+ *
  *   @param noc_cost_terms NoC-related cost terms
  *   @param noc_cost_norm_factors Normalization factors for NoC-related cost terms.
  *
@@ -92,6 +96,7 @@ class t_placer_costs {
     double timing_cost = 0.;
     double bb_cost_norm = 0.;
     double timing_cost_norm = 0.;
+    double congestion_cost = 0.;
 
     NocCostTerms noc_cost_terms;
     NocCostTerms noc_cost_norm_factors;
@@ -86,6 +86,23 @@ struct PlacerRuntimeContext : public Context {
     float f_update_td_costs_total_elapsed_sec;
 };
 
+/**
+ * @brief Sums of the coordinates (see get_coordinate_of_pin()) of the sinks of a net
+ *
+ * The weighted sums weight each sink by the criticality of its connection.
+ */
+struct t_net_sink_loc_sum {
+    int num_sinks = 0;
+    int x = 0;
+    int y = 0;
+    int layer = 0;
+
+    double weight = 0.;
+    double weighted_x = 0.;
+    double weighted_y = 0.;
+    double weighted_layer = 0.;
+};
+
 /**
  * @brief Placement Move generators data
  */
@@ -119,6 +136,14 @@ struct PlacerMoveContext : public Context {
 
     // Container to save the highly critical pins (higher than a timing criticality limit set by commandline option)
     std::vector<std::pair<ClusterNetId, int>> highly_crit_pins;
+
+    // [0..cluster_ctx.clb_nlist.nets().size()-1]. Running sums of the sink coordinates of each net, so that the centroid
+    // moves don't need to iterate over the sinks of the nets driven by the moved block (see init_net_sink_loc_sums())
+    vtr::vector<ClusterNetId, t_net_sink_loc_sum> net_sink_loc_sums;
+
+    // [0..cluster_ctx.clb_nlist.pins().size()-1]. The coordinates and weight of each sink pin in net_sink_loc_sums
+    vtr::vector<ClusterPinId, t_physical_tile_loc> sink_pin_locs;
+    vtr::vector<ClusterPinId, float> sink_pin_weights;
 };
 
 /**
@@ -0,0 +1,123 @@
+#include "routing_demand_map.h"
+
+#include <algorithm>
+
+#include "vtr_assert.h"
+
+void RoutingDemandMap::init(size_t width, size_t height, const std::vector<int>& chanx_width, const std::vector<int>& chany_width) {
+    VTR_ASSERT(chanx_width.size() >= height);
+    VTR_ASSERT(chany_width.size() >= width);
+
+    chanx_width_.assign(chanx_width.begin(), chanx_width.begin() + height);
+    chany_width_.assign(chany_width.begin(), chany_width.begin() + width);
+
+    chanx_demand_delta_.resize({width + 1, height + 1}, 0.);
+    chany_demand_delta_.resize({width + 1, height + 1}, 0.);
+    chanx_util_.resize({width, height}, 0.);
+    chany_util_.resize({width, height}, 0.);
+    acc_chanx_overflow_.resize({width + 1, height + 1}, 0.);
+    acc_chany_overflow_.resize({width + 1, height + 1}, 0.);
+    clear_demand();
+}
+
+void RoutingDemandMap::clear() {
+    chanx_width_.clear();
+    chany_width_.clear();
+    chanx_demand_delta_.clear();
+    chany_demand_delta_.clear();
+    chanx_util_.clear();
+    chany_util_.clear();
+    acc_chanx_overflow_.clear();
+    acc_chany_overflow_.clear();
+}
+
+void RoutingDemandMap::clear_demand() {
+    chanx_demand_delta_.fill(0.);
+    chany_demand_delta_.fill(0.);
+}
+
+void RoutingDemandMap::add_net(int xmin, int xmax, int ymin, int ymax, double crossing) {
+    VTR_ASSERT_SAFE(xmin >= 0 && xmin <= xmax && size_t(xmax) < chanx_util_.dim_size(0));
+    VTR_ASSERT_SAFE(ymin >= 0 && ymin <= ymax && size_t(ymax) < chanx_util_.dim_size(1));
+
+    //The horizontal wirelength crossing * w spread over the w * h tiles, and likewise vertically
+    double chanx_demand = crossing / (ymax - ymin + 1);
+    double chany_demand = crossing / (xmax - xmin + 1);
+
+    chanx_demand_delta_[xmin][ymin] += chanx_demand;
+    chanx_demand_delta_[xmax + 1][ymin] -= chanx_demand;
+    chanx_demand_delta_[xmin][ymax + 1] -= chanx_demand;
+    chanx_demand_delta_[xmax + 1][ymax + 1] += chanx_demand;
+
+    chany_demand_delta_[xmin][ymin] += chany_demand;
+    chany_demand_delta_[xmax + 1][ymin] -= chany_demand;
+    chany_demand_delta_[xmin][ymax + 1] -= chany_demand;
+    chany_demand_delta_[xmax + 1][ymax + 1] += chany_demand;
+}
+
+void RoutingDemandMap::update_utilization(double util_threshold) {
+    size_t width = chanx_util_.dim_size(0);
+    size_t height = chanx_util_.dim_size(1);
+
+    //The demand of a tile is the prefix sum of the differences up to it, and the
+    //overflow prefix sums are accumulated in the same pass
+    vtr::NdMatrix<double, 2> chanx_demand({width + 1, height + 1}, 0.);
+    vtr::NdMatrix<double, 2> chany_demand({width + 1, height + 1}, 0.);
+    for (size_t x = 0; x < width; x++) {
+        for (size_t y = 0; y < height; y++) {
+            chanx_demand[x + 1][y + 1] = chanx_demand_delta_[x][y] + chanx_demand[x][y + 1] + chanx_demand[x + 1][y] - chanx_demand[x][y];
+            chany_demand[x + 1][y + 1] = chany_demand_delta_[x][y] + chany_demand[x][y + 1] + chany_demand[x + 1][y] - chany_demand[x][y];
+
+            //Channels without tracks are treated as a single track, as by the wiring cost
+            //(the demand only goes negative by round off)
+            chanx_util_[x][y] = std::max(chanx_demand[x + 1][y + 1], 0.) / std::max(chanx_width_[y], 1);
+            chany_util_[x][y] = std::max(chany_demand[x + 1][y + 1], 0.) / std::max(chany_width_[x], 1);
+
+            acc_chanx_overflow_[x + 1][y + 1] = std::max(chanx_util_[x][y] - util_threshold, 0.)
+                                                + acc_chanx_overflow_[x][y + 1] + acc_chanx_overflow_[x + 1][y] - acc_chanx_overflow_[x][y];
+            acc_chany_overflow_[x + 1][y + 1] = std::max(chany_util_[x][y] - util_threshold, 0.)
+                                                + acc_chany_overflow_[x][y + 1] + acc_chany_overflow_[x + 1][y] - acc_chany_overflow_[x][y];
+        }
+    }
+}
+
+double RoutingDemandMap::net_cost(int xmin, int xmax, int ymin, int ymax, double crossing) const {
+    int w = xmax - xmin + 1;
+    int h = ymax - ymin + 1;
+
+    //crossing * w tracks over the average CHANX overflow, plus crossing * h over the average CHANY overflow
+    //(the sums over regions without overflow only go negative by round off)
+    double chanx_overflow = rect_sum(acc_chanx_overflow_, xmin, xmax, ymin, ymax);
+    double chany_overflow = rect_sum(acc_chany_overflow_, xmin, xmax, ymin, ymax);
+    return crossing * std::max(chanx_overflow / h + chany_overflow / w, 0.);
+}
+
+t_routing_demand_stats RoutingDemandMap::stats() const {
+    t_routing_demand_stats stats;
+
+    size_t num_tiles = chanx_util_.size();
+    if (num_tiles == 0) {
+        return stats;
+    }
+
+    size_t num_overused = 0;
+    for (size_t i = 0; i < num_tiles; i++) {
+        double chanx_util = chanx_util_.get(i);
+        double chany_util = chany_util_.get(i);
+
+        stats.avg_chanx_util += chanx_util;
+        stats.avg_chany_util += chany_util;
+        stats.max_chanx_util = std::max(stats.max_chanx_util, chanx_util);
+        stats.max_chany_util = std::max(stats.max_chany_util, chany_util);
+        num_overused += (chanx_util > 1.) + (chany_util > 1.);
+    }
+    stats.avg_chanx_util /= num_tiles;
+    stats.avg_chany_util /= num_tiles;
+    stats.overused_fraction = double(num_overused) / (2 * num_tiles);
+
+    return stats;
+}
+
+double RoutingDemandMap::rect_sum(const vtr::NdMatrix<double, 2>& acc, int xmin, int xmax, int ymin, int ymax) {
+    return acc[xmax + 1][ymax + 1] - acc[xmin][ymax + 1] - acc[xmax + 1][ymin] + acc[xmin][ymin];
+}
@@ -0,0 +1,100 @@
+#ifndef VPR_ROUTING_DEMAND_MAP_H
+#define VPR_ROUTING_DEMAND_MAP_H
+
+/**
+ * @file routing_demand_map.h
+ * @brief RUDY (Rectangular Uniform wire DensitY) estimate of the routing demand of a placement
+ *
+ * The wirelength of each net (its bounding box half perimeter times its crossing count) is spread
+ * uniformly over its bounding box: a net with a w x h bounding box adds crossing / h horizontal
+ * (CHANX) tracks and crossing / w vertical (CHANY) tracks to each tile of its bounding box. Divided by
+ * the channel widths this gives an estimated channel utilization per tile, which predicts where the
+ * routing will be congested before any routing is done.
+ *
+ * The demand is kept as 2D difference arrays, so adding or removing a net is O(1) whatever the size
+ * of its bounding box, and the placer can keep the map up to date with each committed move. The
+ * utilization (and the prefix sums of its overflow, which make the congestion cost of a bounding box
+ * O(1)) is only materialized by update_utilization().
+ */
+
+#include <vector>
+
+#include "vtr_ndmatrix.h"
+
+///@brief Summary of the estimated channel utilization of a placement (see RoutingDemandMap::stats())
+struct t_routing_demand_stats {
+    double avg_chanx_util = 0.;
+    double avg_chany_util = 0.;
+    double max_chanx_util = 0.;
+    double max_chany_util = 0.;
+    ///@brief Fraction of the channel segments (one CHANX and one CHANY per tile) estimated over capacity
+    double overused_fraction = 0.;
+};
+
+class RoutingDemandMap {
+  public:
+    /**
+     * @brief Sizes the (empty) map for a width x height grid
+     *
+     * @param chanx_width The number of tracks of the CHANX channel of each row [0..height-1]
+     * @param chany_width The number of tracks of the CHANY channel of each column [0..width-1]
+     */
+    void init(size_t width, size_t height, const std::vector<int>& chanx_width, const std::vector<int>& chany_width);
+
+    ///@brief Frees the map
+    void clear();
+
+    ///@brief Returns true if init() was called (and not cleared since)
+    bool is_initialized() const { return !chanx_demand_delta_.empty(); }
+
+    ///@brief Removes the demand of all the nets
+    void clear_demand();
+
+    /**
+     * @brief Adds the demand of a net bounding box [xmin..xmax] x [ymin..ymax] (in tiles, inclusive)
+     *
+     * A negative crossing count removes a bounding box previously added with the opposite count.
+     */
+    void add_net(int xmin, int xmax, int ymin, int ymax, double crossing);
+
+    /**
+     * @brief Recomputes the utilization of each tile from the current demand
+     *
+     * The congestion costs are computed against the utilization the map had at the last call,
+     * whatever nets were added or removed since.
+     *
+     * @param util_threshold The utilization above which a channel is considered congested by net_cost()
+     */
+    void update_utilization(double util_threshold);
+
+    /**
+     * @brief Returns the congestion cost of a net bounding box: the wirelength of the net in each
+     *        direction times the average utilization over the threshold of its bounding box
+     */
+    double net_cost(int xmin, int xmax, int ymin, int ymax, double crossing) const;
+
+    ///@brief Returns the estimated utilization at the last update_utilization()
+    t_routing_demand_stats stats() const;
+
+  private:
+    ///@brief Returns the sum of acc over [xmin..xmax] x [ymin..ymax]
+    static double rect_sum(const vtr::NdMatrix<double, 2>& acc, int xmin, int xmax, int ymin, int ymax);
+
+    ///@brief The number of tracks of the channels of each row (CHANX) and column (CHANY)
+    std::vector<int> chanx_width_;
+    std::vector<int> chany_width_;
+
+    ///@brief Difference arrays of the demand [0..width][0..height]
+    vtr::NdMatrix<double, 2> chanx_demand_delta_;
+    vtr::NdMatrix<double, 2> chany_demand_delta_;
+
+    ///@brief Utilization of each tile at the last update [0..width-1][0..height-1]
+    vtr::NdMatrix<double, 2> chanx_util_;
+    vtr::NdMatrix<double, 2> chany_util_;
+
+    ///@brief Prefix sums of the utilization over the threshold [0..width][0..height], acc[x][y] summing [0..x-1] x [0..y-1]
+    vtr::NdMatrix<double, 2> acc_chanx_overflow_;
+    vtr::NdMatrix<double, 2> acc_chany_overflow_;
+};
+
+#endif /* VPR_ROUTING_DEMAND_MAP_H */
@@ -28,6 +28,14 @@ void SimpleRLMoveGenerator::process_outcome(double reward, e_reward_function rew
     karmed_bandit_agent->process_outcome(reward, reward_fun);
 }
 
+std::vector<double> SimpleRLMoveGenerator::learned_state() const {
+    return karmed_bandit_agent->learned_state();
+}
+
+bool SimpleRLMoveGenerator::restore_learned_state(const std::vector<double>& state) {
+    return karmed_bandit_agent->restore_learned_state(state);
+}
+
 /*                                        *
  *                                        *
  *  K-Armed bandit agent implementation   *
@@ -141,6 +149,23 @@ void KArmedBanditAgent::process_outcome(double reward, e_reward_function reward_
     }
 }
 
+std::vector<double> KArmedBanditAgent::learned_state() const {
+    std::vector<double> state(q_.begin(), q_.end());
+    state.insert(state.end(), num_action_chosen_.begin(), num_action_chosen_.end());
+    return state;
+}
+
+bool KArmedBanditAgent::restore_learned_state(const std::vector<double>& state) {
+    if (state.size() != 2 * num_available_actions_) {
+        return false;
+    }
+    std::copy(state.begin(), state.begin() + num_available_actions_, q_.begin());
+    for (size_t i = 0; i < num_available_actions_; ++i) {
+        num_action_chosen_[i] = size_t(state[num_available_actions_ + i]);
+    }
+    return true;
+}
+
 void KArmedBanditAgent::write_agent_info(int last_action, double reward) {
     fseek(agent_info_file_, 0, SEEK_END);
     fprintf(agent_info_file_, "%d,", last_action);
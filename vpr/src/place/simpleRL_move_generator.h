@@ -33,6 +33,17 @@ class KArmedBanditAgent {
      */
     void process_outcome(double, e_reward_function);
 
+    /**
+     * @brief Returns the agent's Q-table followed by the number of times each action was chosen
+     */
+    std::vector<double> learned_state() const;
+
+    /**
+     * @brief Restores a Q-table and action counts returned by learned_state()
+     * @return False if the state does not match the agent's number of actions
+     */
+    bool restore_learned_state(const std::vector<double>& state);
+
     /**
      * @brief write all agent internal information (Q-table, reward for each performed action, ...) to a file (agent_info_file_)
      *
@@ -230,6 +241,10 @@ class SimpleRLMoveGenerator : public MoveGenerator {
 
     // Receives feedback about the outcome of the previously proposed move
     void process_outcome(double reward, e_reward_function reward_fun) override;
+
+    // Save/restore the agent's Q-table
+    std::vector<double> learned_state() const override;
+    bool restore_learned_state(const std::vector<double>& state) override;
 };
 
 template<class T, class>
@@ -17,6 +17,7 @@
 #include "timing_place_lookup.h"
 #include "timing_place.h"
 #include "placer_state.h"
+#include "directed_moves_util.h"
 
 #include "timing_info.h"
 
@@ -24,7 +25,8 @@
 PlacerCriticalities::PlacerCriticalities(const ClusteredNetlist& clb_nlist, const ClusteredPinAtomPinsLookup& netlist_pin_lookup)
     : clb_nlist_(clb_nlist)
     , pin_lookup_(netlist_pin_lookup)
-    , timing_place_crit_(make_net_pins_matrix(clb_nlist_, std::numeric_limits<float>::quiet_NaN())) {
+    , timing_place_crit_(make_net_pins_matrix(clb_nlist_, std::numeric_limits<float>::quiet_NaN()))
+    , timing_place_raw_crit_(make_net_pins_matrix(clb_nlist_, std::numeric_limits<float>::quiet_NaN())) {
 }
 
 /**
@@ -35,7 +37,12 @@ PlacerCriticalities::PlacerCriticalities(const ClusteredNetlist& clb_nlist, cons
  * cannot accurately account for all the pins that need to be updated. In this case,
  * `recompute_required` would be true, and we update all criticalities from scratch.
  *
- * If the criticality exponent has changed, we also need to update from scratch.
+ * Only the raw criticalities of the pins reported as modified by the timing info are looked up.
+ * If the criticality exponent has changed, every criticality is sharpened again from its raw
+ * value, without any timing look-up.
+ *
+ * Afterwards, pins_with_modified_criticality() only holds the pins whose (sharpened) criticality
+ * actually changed, so that the timing costs are only updated for these connections.
  */
 void PlacerCriticalities::update_criticalities(const SetupTimingInfo* timing_info,
                                                const PlaceCritParams& crit_params,
@@ -48,10 +55,27 @@ void PlacerCriticalities::update_criticalities(const SetupTimingInfo* timing_inf
     }
 
     /* Determine what pins need updating */
-    if (!recompute_required && crit_params.crit_exponent == last_crit_exponent_) {
+    if (!recompute_required) {
         incr_update_criticalities(timing_info);
     } else {
         recompute_criticalities();
+    }
+
+    /* Look up the raw criticality of the pins whose timing changed */
+    for (ClusterPinId clb_pin : cluster_pins_with_modified_criticality_) {
+        ClusterNetId clb_net = clb_nlist_.pin_net(clb_pin);
+        int pin_index_in_net = clb_nlist_.pin_net_index(clb_pin);
+        // Routing for placement is not flat (at least for the time being)
+        timing_place_raw_crit_[clb_net][pin_index_in_net] = calculate_clb_net_pin_criticality(*timing_info, pin_lookup_, ParentPinId(size_t(clb_pin)), false);
+    }
+
+    /* A new criticality exponent changes the sharpened criticality of every pin */
+    if (crit_params.crit_exponent != last_crit_exponent_) {
+        for (ClusterNetId net_id : clb_nlist_.nets()) {
+            for (ClusterPinId pin_id : clb_nlist_.net_sinks(net_id)) {
+                cluster_pins_with_modified_criticality_.insert(pin_id);
+            }
+        }
 
         /* Record new criticality exponent */
         last_crit_exponent_ = crit_params.crit_exponent;
@@ -63,14 +87,19 @@ void PlacerCriticalities::update_criticalities(const SetupTimingInfo* timing_inf
      * For every pin on every net (or, equivalently, for every tedge ending
      * in that pin), timing_place_crit_ = criticality^(criticality exponent) */
 
-    /* Update the affected pins */
+    /* Update the affected pins, and only keep those whose criticality changed */
+    changed_pins_.clear();
     for (ClusterPinId clb_pin : cluster_pins_with_modified_criticality_) {
         ClusterNetId clb_net = clb_nlist_.pin_net(clb_pin);
         int pin_index_in_net = clb_nlist_.pin_net_index(clb_pin);
-        // Routing for placement is not flat (at least for the time being)
-        float clb_pin_crit = calculate_clb_net_pin_criticality(*timing_info, pin_lookup_, ParentPinId(size_t(clb_pin)), false);
 
-        float new_crit = pow(clb_pin_crit, crit_params.crit_exponent);
+        float new_crit = pow(timing_place_raw_crit_[clb_net][pin_index_in_net], crit_params.crit_exponent);
+        float old_crit = timing_place_crit_[clb_net][pin_index_in_net];
+        if (new_crit == old_crit) {
+            continue;
+        }
+        changed_pins_.push_back(clb_pin);
+
         /*
          * Update the highly critical pins container
          *
@@ -78,9 +107,9 @@ void PlacerCriticalities::update_criticalities(const SetupTimingInfo* timing_inf
          * If the old criticality > limit and the new criticality < limit --> remove this pin from the highly critical pins
          */
         if (!first_time_update_criticality) {
-            if (new_crit > crit_params.crit_limit && timing_place_crit_[clb_net][pin_index_in_net] < crit_params.crit_limit) {
+            if (new_crit > crit_params.crit_limit && old_crit < crit_params.crit_limit) {
                 place_move_ctx.highly_crit_pins.push_back(std::make_pair(clb_net, pin_index_in_net));
-            } else if (new_crit < crit_params.crit_limit && timing_place_crit_[clb_net][pin_index_in_net] > crit_params.crit_limit) {
+            } else if (new_crit < crit_params.crit_limit && old_crit > crit_params.crit_limit) {
                 place_move_ctx.highly_crit_pins.erase(std::remove(place_move_ctx.highly_crit_pins.begin(), place_move_ctx.highly_crit_pins.end(), std::make_pair(clb_net, pin_index_in_net)), place_move_ctx.highly_crit_pins.end());
             }
         } else {
@@ -92,8 +121,14 @@ void PlacerCriticalities::update_criticalities(const SetupTimingInfo* timing_inf
          * Since path criticality varies much more than timing, we "sharpen" timing
          * criticality by taking it to some power, crit_exponent (between 1 and 8 by default). */
         timing_place_crit_[clb_net][pin_index_in_net] = new_crit;
+
+        /* Keep the criticality weighted sink coordinates of the centroid moves in sync */
+        update_net_sink_loc_sum_weight(clb_pin, new_crit, place_move_ctx);
     }
 
+    cluster_pins_with_modified_criticality_.clear();
+    cluster_pins_with_modified_criticality_.insert(changed_pins_.begin(), changed_pins_.end());
+
     /* Criticalities updated. In sync with timing info.   */
     /* Can be incrementally updated on the next iteration */
     recompute_required = false;
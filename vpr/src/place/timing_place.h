@@ -158,6 +158,14 @@ class PlacerCriticalities {
      */
     ClbNetPinsMatrix<float> timing_place_crit_;
 
+    /**
+     * @brief The criticality of each connection before sharpening (i.e. as returned by the
+     *        timing info), so that a new criticality exponent doesn't require timing look-ups.
+     *
+     * Index range: [0..cluster_ctx.clb_nlist.nets().size()-1][1..num_pins-1]
+     */
+    ClbNetPinsMatrix<float> timing_place_raw_crit_;
+
     /**
      * The criticality exponent when update_criticalites() was last called
      * (used to detect if incremental update can be used).
@@ -167,6 +175,9 @@ class PlacerCriticalities {
     ///@brief Set of pins with criticaltites modified by last call to update_criticalities().
     vtr::vec_id_set<ClusterPinId> cluster_pins_with_modified_criticality_;
 
+    ///@brief Scratch list of the pins whose criticality changed, used by update_criticalities()
+    std::vector<ClusterPinId> changed_pins_;
+
     ///@brief Incremental update. See timing_place.cpp for more.
     void incr_update_criticalities(const SetupTimingInfo* timing_info);
 
@@ -493,6 +504,32 @@ class PlacerTimingCosts {
         return NetProxy(const_cast<PlacerTimingCosts*>(this), const_cast<double*>(net_connection_costs));
     }
 
+    /**
+     * @brief Sets a connection cost without invalidating the intermediate costs above it.
+     *
+     * Unlike assigning through operator[], this doesn't touch any shared intermediate cost,
+     * so the connections of different nets can be set concurrently. Returns true if the cost
+     * changed, in which case invalidate_connection() must be called (by a single thread)
+     * before the next total_cost().
+     */
+    bool set_connection_cost_deferred(ClusterNetId net_id, size_t ipin, double new_cost) {
+        VTR_ASSERT_SAFE(net_start_indicies_[net_id] >= 0);
+
+        double& connection_cost = connection_costs_[net_start_indicies_[net_id] + ipin];
+        if (new_cost == connection_cost) {
+            return false;
+        }
+        connection_cost = new_cost;
+        return true;
+    }
+
+    ///@brief Invalidates the intermediate costs above a connection set by set_connection_cost_deferred().
+    void invalidate_connection(ClusterNetId net_id, size_t ipin) {
+        VTR_ASSERT_SAFE(net_start_indicies_[net_id] >= 0);
+
+        invalidate(&connection_costs_[net_start_indicies_[net_id] + ipin]);
+    }
+
     void clear() {
         connection_costs_.clear();
         net_start_indicies_.clear();
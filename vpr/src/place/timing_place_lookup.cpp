@@ -24,6 +24,7 @@
 #include "route_export.h"
 #include "rr_graph.h"
 #include "timing_place_lookup.h"
+#include "timing_model_cache.h"
 #include "read_xml_arch_file.h"
 #include "echo_files.h"
 #include "atom_netlist.h"
@@ -34,6 +35,11 @@
 #include "router_delay_profiling.h"
 #include "place_delay_model.h"
 
+#ifdef VPR_USE_TBB
+#    include <tbb/enumerable_thread_specific.h>
+#    include <tbb/parallel_for.h>
+#endif
+
 /*To compute delay between blocks we calculate the delay between */
 /*different nodes in the FPGA.  From this procedure we generate
  * a lookup table which tells us the delay between different locations in*/
@@ -64,6 +70,53 @@ struct t_profile_info {
     int max_delta_y;
 };
 
+/**
+ * @brief Hands out a RouterDelayProfiler to each worker thread.
+ *
+ * Every worker gets its own profiler, and hence its own ConnectionRouter, heap and
+ * path search state, so sample connections can be routed concurrently. Without TBB
+ * all connections are routed by the shared profiler.
+ */
+class DelayProfilerPool {
+  public:
+    explicit DelayProfilerPool(RouterDelayProfiler& shared_profiler)
+        : shared_profiler_(shared_profiler) {
+        //Worker profilers leave global state alone, so set up the base costs they expect here
+        update_rr_base_costs(1);
+    }
+
+    ///@brief Returns the profiler of the calling worker
+    RouterDelayProfiler& local() {
+#ifdef VPR_USE_TBB
+        t_worker& worker = workers_.local();
+        if (!worker.profiler) {
+            worker.rr_node_route_inf = g_vpr_ctx.routing().rr_node_route_inf;
+            worker.profiler = std::make_unique<RouterDelayProfiler>(shared_profiler_.net_list(),
+                                                                    shared_profiler_.lookahead(),
+                                                                    shared_profiler_.is_flat(),
+                                                                    worker.rr_node_route_inf);
+            if (shared_profiler_.reverse_edges()) {
+                worker.profiler->enable_bidirectional_search(shared_profiler_.reverse_edges());
+            }
+        }
+        return *worker.profiler;
+#else
+        return shared_profiler_;
+#endif
+    }
+
+  private:
+    RouterDelayProfiler& shared_profiler_;
+
+#ifdef VPR_USE_TBB
+    struct t_worker {
+        vtr::vector<RRNodeId, t_rr_node_route_inf> rr_node_route_inf;
+        std::unique_ptr<RouterDelayProfiler> profiler;
+    };
+    tbb::enumerable_thread_specific<t_worker> workers_;
+#endif
+};
+
 /*** Function Prototypes *****/
 static t_chan_width setup_chan_width(const t_router_opts& router_opts,
                                      t_chan_width_dist chan_width_dist);
@@ -81,7 +134,7 @@ static float route_connection_delay(
 
 // Prototype for computing delta delay matrix.
 typedef std::function<void(
-    RouterDelayProfiler&,
+    DelayProfilerPool&,
     vtr::Matrix<std::vector<float>>&,
     int,
     int,
@@ -98,7 +151,7 @@ typedef std::function<void(
     t_compute_delta_delay_matrix;
 
 static void generic_compute_matrix_iterative_astar(
-    RouterDelayProfiler& route_profiler,
+    DelayProfilerPool& profiler_pool,
     vtr::Matrix<std::vector<float>>& matrix,
     int from_layer_num,
     int to_layer_num,
@@ -114,7 +167,7 @@ static void generic_compute_matrix_iterative_astar(
     bool /***/);
 
 static void generic_compute_matrix_dijkstra_expansion(
-    RouterDelayProfiler& route_profiler,
+    DelayProfilerPool& profiler_pool,
     vtr::Matrix<std::vector<float>>& matrix,
     int from_layer_num,
     int to_layer_num,
@@ -129,6 +182,13 @@ static void generic_compute_matrix_dijkstra_expansion(
     const std::set<std::string>& allowed_types,
     bool is_flat);
 
+static std::set<std::string> delay_model_allowed_types(const t_placer_opts& placer_opts);
+
+///@brief Returns the locations sampled to profile the delta delays from from_layer_num, and their sink regions
+static std::vector<t_delta_sample_source> find_delta_sample_sources(int from_layer_num,
+                                                                    size_t longest_length,
+                                                                    const std::set<std::string>& allowed_types);
+
 static vtr::NdMatrix<float, 4> compute_delta_delays(
     RouterDelayProfiler& route_profiler,
     const t_placer_opts& palcer_opts,
@@ -198,15 +258,20 @@ std::unique_ptr<PlaceDelayModel> compute_place_delay_model(const t_placer_opts&
                                                                           router_opts.lookahead_type,
                                                                           router_opts.write_router_lookahead,
                                                                           router_opts.read_router_lookahead,
+                                                                          router_opts.timing_model_cache_dir,
                                                                           segment_inf,
                                                                           is_flat);
 
     RouterDelayProfiler route_profiler(net_list, router_lookahead, is_flat);
+    if (router_opts.router_profiler_bidirectional_search) {
+        route_profiler.enable_bidirectional_search(std::make_shared<RRReverseEdges>(g_vpr_ctx.device().rr_graph.rr_nodes().view()));
+    }
 
     int longest_length = get_longest_segment_length(segment_inf);
 
     /*now setup and compute the actual arrays */
     std::unique_ptr<PlaceDelayModel> place_delay_model;
+    LazyDeltaDelayModel* lazy_delay_model = nullptr;
     float min_cross_layer_delay = get_min_cross_layer_delay();
 
     if (placer_opts.delay_model_type == PlaceDelayModelType::SIMPLE) {
@@ -215,18 +280,63 @@ std::unique_ptr<PlaceDelayModel> compute_place_delay_model(const t_placer_opts&
         place_delay_model = std::make_unique<DeltaDelayModel>(min_cross_layer_delay, is_flat);
     } else if (placer_opts.delay_model_type == PlaceDelayModelType::DELTA_OVERRIDE) {
         place_delay_model = std::make_unique<OverrideDelayModel>(min_cross_layer_delay, is_flat);
+    } else if (placer_opts.delay_model_type == PlaceDelayModelType::DELTA_LAZY) {
+        auto lazy_model = std::make_unique<LazyDeltaDelayModel>(min_cross_layer_delay, is_flat);
+        lazy_delay_model = lazy_model.get();
+        place_delay_model = std::move(lazy_model);
     } else {
         VTR_ASSERT_MSG(false, "Invalid placer delay model");
     }
 
-    if (placer_opts.read_placement_delay_lookup.empty()) {
-        place_delay_model->compute(route_profiler, placer_opts, router_opts, longest_length);
-    } else {
+    if (!placer_opts.read_placement_delay_lookup.empty()) {
         place_delay_model->read(placer_opts.read_placement_delay_lookup);
+        if (lazy_delay_model) {
+            //Entries missing from the file are computed as they are queried
+            place_delay_model->compute(route_profiler, placer_opts, router_opts, longest_length);
+        }
+    } else if (!router_opts.timing_model_cache_dir.empty() && place_delay_model_is_cacheable(placer_opts.delay_model_type)) {
+        std::string entry = timing_model_cache_entry(router_opts.timing_model_cache_dir, "place_delay_model",
+                                                     place_delay_model_cache_key(placer_opts, router_opts, segment_inf, is_flat));
+        bool loaded = false;
+        if (timing_model_cache_lookup(entry)) {
+            try {
+                place_delay_model->read(entry);
+                loaded = true;
+                VTR_LOG("Loaded placement delay model from cache '%s'\n", entry.c_str());
+            } catch (const VprError& e) {
+                VTR_LOG_WARN("Discarding unreadable placement delay model cache entry '%s': %s\n", entry.c_str(), e.what());
+                timing_model_cache_remove(entry);
+            }
+        }
+
+        if (!loaded || lazy_delay_model) {
+            place_delay_model->compute(route_profiler, placer_opts, router_opts, longest_length);
+        }
+        if (!loaded) {
+            timing_model_cache_store(entry, [&](const std::string& file) {
+                place_delay_model->write(file);
+            });
+        }
+        if (lazy_delay_model) {
+            //Store the entries computed while placing for later runs
+            lazy_delay_model->add_persist_fn([lazy_delay_model, entry]() {
+                timing_model_cache_store(entry, [&](const std::string& file) {
+                    lazy_delay_model->write(file);
+                });
+            });
+        }
+    } else {
+        place_delay_model->compute(route_profiler, placer_opts, router_opts, longest_length);
     }
 
     if (!placer_opts.write_placement_delay_lookup.empty()) {
         place_delay_model->write(placer_opts.write_placement_delay_lookup);
+        if (lazy_delay_model) {
+            std::string file = placer_opts.write_placement_delay_lookup;
+            lazy_delay_model->add_persist_fn([lazy_delay_model, file]() {
+                lazy_delay_model->write(file);
+            });
+        }
     }
 
     /*free all data structures that are no longer needed */
@@ -271,6 +381,212 @@ void SimpleDelayModel::compute(
     delays_ = compute_simple_delay_model(router);
 }
 
+LazyDeltaDelayModel::LazyDeltaDelayModel(float min_cross_layer_delay,
+                                         bool is_flat)
+    : cross_layer_delay_(min_cross_layer_delay)
+    , is_flat_(is_flat) {}
+
+//Out of line, since DelayProfilerPool is only defined here
+LazyDeltaDelayModel::~LazyDeltaDelayModel() = default;
+
+void LazyDeltaDelayModel::compute(
+    RouterDelayProfiler& route_profiler,
+    const t_placer_opts& placer_opts,
+    const t_router_opts& router_opts,
+    int longest_length) {
+    vtr::ScopedStartFinishTimer timer("Computing coarse delta delays");
+
+    //Keep entries already read
+    if (delays_.empty()) {
+        init_tables();
+    }
+
+    //The profiler passed in only lives while the model is computed, so route with a copy
+    route_profiler_ = std::make_unique<RouterDelayProfiler>(route_profiler.net_list(),
+                                                            route_profiler.lookahead(),
+                                                            route_profiler.is_flat());
+    if (route_profiler.reverse_edges()) {
+        route_profiler_->enable_bidirectional_search(route_profiler.reverse_edges());
+    }
+    profiler_pool_ = std::make_unique<DelayProfilerPool>(*route_profiler_);
+
+    router_opts_ = router_opts;
+    reducer_ = placer_opts.delay_model_reducer;
+    allowed_types_ = delay_model_allowed_types(placer_opts);
+
+    sample_sources_.clear();
+    for (size_t from_layer_num = 0; from_layer_num < num_layers_; ++from_layer_num) {
+        sample_sources_.push_back(find_delta_sample_sources(from_layer_num, longest_length, allowed_types_));
+    }
+
+    size_t coarse_width = (width_ + COARSE_SAMPLE_STRIDE - 1) / COARSE_SAMPLE_STRIDE;
+    size_t coarse_height = (height_ + COARSE_SAMPLE_STRIDE - 1) / COARSE_SAMPLE_STRIDE;
+    vtr::NdMatrix<float, 4> coarse_delays({num_layers_, num_layers_, coarse_width, coarse_height});
+
+    //Each entry routes its sample connections serially, so the lattice is computed in parallel
+    size_t num_coarse_entries = coarse_delays.size();
+    auto compute_coarse_entry = [&](size_t i) {
+        size_t coarse_y = i % coarse_height;
+        size_t coarse_x = (i / coarse_height) % coarse_width;
+        size_t to_layer = (i / (coarse_height * coarse_width)) % num_layers_;
+        size_t from_layer = i / (coarse_height * coarse_width * num_layers_);
+        coarse_delays[from_layer][to_layer][coarse_x][coarse_y] = fill_delay(from_layer, to_layer,
+                                                                             coarse_x * COARSE_SAMPLE_STRIDE,
+                                                                             coarse_y * COARSE_SAMPLE_STRIDE,
+                                                                             /*allow_estimate=*/false);
+    };
+
+#ifdef VPR_USE_TBB
+    tbb::parallel_for(size_t(0), num_coarse_entries, compute_coarse_entry);
+#else
+    for (size_t i = 0; i < num_coarse_entries; i++) {
+        compute_coarse_entry(i);
+    }
+#endif
+
+    coarse_delays_ = std::move(coarse_delays);
+
+    VTR_LOG("Computed %zu of %zu placement delay model entries up front\n", num_filled(), delays_.size());
+}
+
+float LazyDeltaDelayModel::sampled_delay(int from_layer, int to_layer, int delta_x, int delta_y) const {
+    std::atomic<float>& sampled = sampled_delays_[index(from_layer, to_layer, delta_x, delta_y)];
+    float delay_val = sampled.load(std::memory_order_acquire);
+    if (!std::isnan(delay_val)) {
+        return delay_val;
+    }
+
+    std::lock_guard<std::mutex> lock(sample_locks_[index(from_layer, to_layer, delta_x, delta_y) % NUM_LOCK_STRIPES]);
+    delay_val = sampled.load(std::memory_order_acquire);
+    if (!std::isnan(delay_val)) {
+        //Sampled by another thread meanwhile
+        return delay_val;
+    }
+
+    if (!profiler_pool_) {
+        VPR_THROW(VPR_ERROR_PLACE, "LazyDeltaDelayModel entry [%d,%d,%d,%d] queried before compute()",
+                  from_layer, to_layer, delta_x, delta_y);
+    }
+
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& grid = device_ctx.grid;
+
+    //Route the same connections compute_delta_delays() would have recorded for this delta:
+    //from each sample source to the sinks at a (+/-delta_x, +/-delta_y) offset inside its region
+    std::vector<float> delays;
+    bool found_empty = false;
+    for (const t_delta_sample_source& source : sample_sources_[from_layer]) {
+        t_physical_tile_type_ptr src_type = grid.get_physical_type({source.x, source.y, from_layer});
+        bool is_allowed_type = allowed_types_.empty() || allowed_types_.find(src_type->name) != allowed_types_.end();
+
+        std::array<int, 2> sink_xs = {source.x + delta_x, source.x - delta_x};
+        std::array<int, 2> sink_ys = {source.y + delta_y, source.y - delta_y};
+        for (int ix = 0; ix < (delta_x == 0 ? 1 : 2); ++ix) {
+            for (int iy = 0; iy < (delta_y == 0 ? 1 : 2); ++iy) {
+                int sink_x = sink_xs[ix];
+                int sink_y = sink_ys[iy];
+                if (sink_x < source.start_x || sink_x > source.end_x || sink_y < source.start_y || sink_y > source.end_y) {
+                    continue;
+                }
+
+                t_physical_tile_type_ptr sink_type = grid.get_physical_type({sink_x, sink_y, to_layer});
+                if (src_type == device_ctx.EMPTY_PHYSICAL_TILE_TYPE || sink_type == device_ctx.EMPTY_PHYSICAL_TILE_TYPE || !is_allowed_type) {
+                    found_empty = true;
+                    continue;
+                }
+
+                delays.push_back(route_connection_delay(profiler_pool_->local(),
+                                                        from_layer, to_layer,
+                                                        source.x, source.y,
+                                                        sink_x, sink_y,
+                                                        router_opts_,
+                                                        /*measure_directconnect=*/true));
+            }
+        }
+    }
+
+    if (!delays.empty()) {
+        delay_val = delay_reduce(delays, reducer_);
+    } else if (found_empty) {
+        delay_val = EMPTY_DELTA;
+    } else {
+        //No region covers this delta (see fix_uninitialized_coordinates())
+        delay_val = IMPOSSIBLE_DELTA;
+    }
+
+    sampled.store(delay_val, std::memory_order_release);
+    return delay_val;
+}
+
+float LazyDeltaDelayModel::find_neighbouring_average(int from_layer, int to_layer, int delta_x, int delta_y, int max_distance) const {
+    //As find_neightboring_average(), over the sampled delays
+    for (int distance = 1; distance <= max_distance; ++distance) {
+        float sum = 0;
+        int counter = 0;
+        for (int delx = delta_x - distance; delx <= delta_x + distance; delx++) {
+            for (int dely = delta_y - distance; dely <= delta_y + distance; dely++) {
+                if (abs(delx - delta_x) + abs(dely - delta_y) > distance) {
+                    continue;
+                }
+                if (delx < 0 || dely < 0 || delx >= (int)width_ || dely >= (int)height_) {
+                    continue;
+                }
+                if (delx == delta_x && dely == delta_y) {
+                    continue;
+                }
+
+                float neighbour_delay = sampled_delay(from_layer, to_layer, delx, dely);
+                if (neighbour_delay == EMPTY_DELTA || neighbour_delay == IMPOSSIBLE_DELTA) {
+                    continue;
+                }
+                counter++;
+                sum += neighbour_delay;
+            }
+        }
+        if (counter != 0) {
+            return sum / (float)counter;
+        }
+    }
+
+    return IMPOSSIBLE_DELTA;
+}
+
+float LazyDeltaDelayModel::fill_delay(int from_layer, int to_layer, int delta_x, int delta_y, bool allow_estimate) const {
+    std::atomic<float>& entry = delays_[index(from_layer, to_layer, delta_x, delta_y)];
+
+    std::lock_guard<std::mutex> lock(delay_locks_[index(from_layer, to_layer, delta_x, delta_y) % NUM_LOCK_STRIPES]);
+    float delay_val = entry.load(std::memory_order_acquire);
+    if (!std::isnan(delay_val)) {
+        //Computed by another thread meanwhile, or read
+        return delay_val;
+    }
+
+    //Fix up the sampled delay as compute_delta_delay_model() does, except that neighbours
+    //are averaged from their sampled delays rather than their fixed up values
+    delay_val = sampled_delay(from_layer, to_layer, delta_x, delta_y);
+    if (delay_val == EMPTY_DELTA) {
+        //See fix_empty_coordinates()
+        delay_val = find_neighbouring_average(from_layer, to_layer, delta_x, delta_y, /*max_distance=*/2);
+    }
+    if (delay_val == IMPOSSIBLE_DELTA) {
+        //See fill_impossible_coordinates()
+        delay_val = find_neighbouring_average(from_layer, to_layer, delta_x, delta_y, /*max_distance=*/5);
+    }
+    if (delay_val == IMPOSSIBLE_DELTA && allow_estimate) {
+        delay_val = coarse_estimate(from_layer, to_layer, delta_x, delta_y);
+    }
+
+    if (delay_val < 0.) {
+        VPR_ERROR(VPR_ERROR_PLACE,
+                  "Found invaild negative delay %g for delta [%d,%d,%d,%d]",
+                  delay_val, from_layer, to_layer, delta_x, delta_y);
+    }
+
+    entry.store(delay_val, std::memory_order_release);
+    num_filled_.fetch_add(1, std::memory_order_relaxed);
+    return delay_val;
+}
+
 /******* File Accessible Functions **********/
 
 std::vector<int> get_best_classes(enum e_pin_type pintype, t_physical_tile_type_ptr type) {
@@ -448,7 +764,7 @@ static void add_delay_to_matrix(
 }
 
 static void generic_compute_matrix_dijkstra_expansion(
-    RouterDelayProfiler& /*route_profiler*/,
+    DelayProfilerPool& /*profiler_pool*/,
     vtr::Matrix<std::vector<float>>& matrix,
     int from_layer_num,
     int to_layer_num,
@@ -590,7 +906,7 @@ static void generic_compute_matrix_dijkstra_expansion(
 }
 
 static void generic_compute_matrix_iterative_astar(
-    RouterDelayProfiler& route_profiler,
+    DelayProfilerPool& profiler_pool,
     vtr::Matrix<std::vector<float>>& matrix,
     int from_layer_num,
     int to_layer_num,
@@ -611,20 +927,58 @@ static void generic_compute_matrix_iterative_astar(
 
     auto& device_ctx = g_vpr_ctx.device();
 
+    t_physical_tile_type_ptr src_type = device_ctx.grid.get_physical_type({source_x, source_y, from_layer_num});
+    bool is_allowed_type = allowed_types.empty() || allowed_types.find(src_type->name) != allowed_types.end();
+
+    auto is_valid_sink = [&](int x, int y) {
+        t_physical_tile_type_ptr sink_type = device_ctx.grid.get_physical_type({x, y, to_layer_num});
+
+        bool src_or_target_empty = (src_type == device_ctx.EMPTY_PHYSICAL_TILE_TYPE
+                                    || sink_type == device_ctx.EMPTY_PHYSICAL_TILE_TYPE);
+
+        return !src_or_target_empty && is_allowed_type;
+    };
+
+    //Route all the sample connections first. They are independent of each other, so each
+    //worker routes its share with its own profiler. The delays are then recorded in sink
+    //order below, which keeps the sampled delays independent of the number of workers.
+    std::vector<vtr::Point<int>> sinks;
     for (sink_x = start_x; sink_x <= end_x; sink_x++) {
         for (sink_y = start_y; sink_y <= end_y; sink_y++) {
-            delta_x = abs(sink_x - source_x);
-            delta_y = abs(sink_y - source_y);
+            if (is_valid_sink(sink_x, sink_y)) {
+                sinks.emplace_back(sink_x, sink_y);
+            }
+        }
+    }
 
-            t_physical_tile_type_ptr src_type = device_ctx.grid.get_physical_type({source_x, source_y, from_layer_num});
-            t_physical_tile_type_ptr sink_type = device_ctx.grid.get_physical_type({sink_x, sink_y, to_layer_num});
+    std::vector<float> sink_delays(sinks.size());
+    auto route_sink = [&](size_t isink) {
+        sink_delays[isink] = route_connection_delay(profiler_pool.local(),
+                                                    from_layer_num,
+                                                    to_layer_num,
+                                                    source_x,
+                                                    source_y,
+                                                    sinks[isink].x(),
+                                                    sinks[isink].y(),
+                                                    router_opts,
+                                                    measure_directconnect);
+    };
 
-            bool src_or_target_empty = (src_type == device_ctx.EMPTY_PHYSICAL_TILE_TYPE
-                                        || sink_type == device_ctx.EMPTY_PHYSICAL_TILE_TYPE);
+#ifdef VPR_USE_TBB
+    tbb::parallel_for(size_t(0), sinks.size(), route_sink);
+#else
+    for (size_t isink = 0; isink < sinks.size(); isink++) {
+        route_sink(isink);
+    }
+#endif
 
-            bool is_allowed_type = allowed_types.empty() || allowed_types.find(src_type->name) != allowed_types.end();
+    size_t isink = 0;
+    for (sink_x = start_x; sink_x <= end_x; sink_x++) {
+        for (sink_y = start_y; sink_y <= end_y; sink_y++) {
+            delta_x = abs(sink_x - source_x);
+            delta_y = abs(sink_y - source_y);
 
-            if (src_or_target_empty || !is_allowed_type) {
+            if (!is_valid_sink(sink_x, sink_y)) {
                 if (matrix[delta_x][delta_y].empty()) {
                     //Only set empty target if we don't already have a valid delta delay
                     matrix[delta_x][delta_y].push_back(EMPTY_DELTA);
@@ -638,16 +992,8 @@ static void generic_compute_matrix_iterative_astar(
                 }
             } else {
                 //Valid start/end
-
-                float delay = route_connection_delay(route_profiler,
-                                                     from_layer_num,
-                                                     to_layer_num,
-                                                     source_x,
-                                                     source_y,
-                                                     sink_x,
-                                                     sink_y,
-                                                     router_opts,
-                                                     measure_directconnect);
+                VTR_ASSERT_SAFE(sinks[isink] == vtr::Point<int>(sink_x, sink_y));
+                float delay = sink_delays[isink++];
 
 #ifdef VERBOSE
                 VTR_LOG("Computed delay: %12g delta: %d,%d (src: %d,%d sink: %d,%d)\n",
@@ -668,6 +1014,120 @@ static void generic_compute_matrix_iterative_astar(
     }
 }
 
+static std::set<std::string> delay_model_allowed_types(const t_placer_opts& placer_opts) {
+    std::set<std::string> allowed_types;
+    if (!placer_opts.allowed_tiles_for_delay_model.empty()) {
+        auto allowed_types_vector = vtr::split(placer_opts.allowed_tiles_for_delay_model, ",");
+        for (const auto& type : allowed_types_vector) {
+            allowed_types.insert(type);
+        }
+    }
+    return allowed_types;
+}
+
+static std::vector<t_delta_sample_source> find_delta_sample_sources(int from_layer_num,
+                                                                    size_t longest_length,
+                                                                    const std::set<std::string>& allowed_types) {
+    //To avoid edge effects we place the source at least 'longest_length' away
+    //from the device edge
+    //and route from there for all possible delta values < dimension
+
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& grid = device_ctx.grid;
+
+    size_t mid_x = vtr::nint(grid.width() / 2);
+    size_t mid_y = vtr::nint(grid.height() / 2);
+
+    size_t low_x = std::min(longest_length, mid_x);
+    size_t low_y = std::min(longest_length, mid_y);
+    size_t high_x = mid_x;
+    size_t high_y = mid_y;
+    if (longest_length <= grid.width()) {
+        high_x = std::max(grid.width() - longest_length, mid_x);
+    }
+    if (longest_length <= grid.height()) {
+        high_y = std::max(grid.height() - longest_length, mid_y);
+    }
+
+    //   +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+    //   +                 |                       |               +
+    //   +        A        |           B           |       C       +
+    //   +                 |                       |               +
+    //   +-----------------\-----------------------.---------------+
+    //   +                 |                       |               +
+    //   +                 |                       |               +
+    //   +                 |                       |               +
+    //   +                 |                       |               +
+    //   +        D        |           E           |       F       +
+    //   +                 |                       |               +
+    //   +                 |                       |               +
+    //   +                 |                       |               +
+    //   +                 |                       |               +
+    //   +-----------------*-----------------------/---------------+
+    //   +                 |                       |               +
+    //   +        G        |           H           |       I       +
+    //   +                 |                       |               +
+    //   +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+    //
+    //   * = (low_x, low_y)
+    //   . = (high_x, high_y)
+    //   / = (high_x, low_y)
+    //   \ = (low_x, high_y)
+    //   + = device edge
+
+    auto is_allowed_source = [&](int x, int y) {
+        auto type = grid.get_physical_type({x, y, from_layer_num});
+        if (type == device_ctx.EMPTY_PHYSICAL_TILE_TYPE) {
+            return false;
+        }
+        return allowed_types.empty() || allowed_types.find(std::string(type->name)) != allowed_types.end();
+    };
+
+    std::vector<t_delta_sample_source> sources;
+
+    //Find the lowest y location on the left edge with a non-empty block
+    bool found = false;
+    for (int x = 0; x < (int)grid.width() && !found; ++x) {
+        for (int y = 0; y < (int)grid.height() && !found; ++y) {
+            if (is_allowed_source(x, y)) {
+                sources.push_back({x, y, x, y, (int)grid.width() - 1, (int)grid.height() - 1});
+                found = true;
+            }
+        }
+    }
+    VTR_ASSERT(found);
+
+    //Find the lowest x location on the bottom edge with a non-empty block
+    found = false;
+    for (int y = 0; y < (int)grid.height() && !found; ++y) {
+        for (int x = 0; x < (int)grid.width() && !found; ++x) {
+            if (is_allowed_source(x, y)) {
+                sources.push_back({x, y, x, y, (int)grid.width() - 1, (int)grid.height() - 1});
+                found = true;
+            }
+        }
+    }
+    VTR_ASSERT(found);
+
+    //Since the other delta delay values may have suffered from edge effects,
+    //we recalculate deltas within regions B, C, E, F
+    sources.push_back({(int)low_x, (int)low_y, (int)low_x, (int)low_y, (int)grid.width() - 1, (int)grid.height() - 1});
+
+    //Since the other delta delay values may have suffered from edge effects,
+    //we recalculate deltas within regions D, E, G, H
+    sources.push_back({(int)high_x, (int)high_y, 0, 0, (int)high_x, (int)high_y});
+
+    //Since the other delta delay values may have suffered from edge effects,
+    //we recalculate deltas within regions A, B, D, E
+    sources.push_back({(int)high_x, (int)low_y, 0, (int)low_y, (int)high_x, (int)grid.height() - 1});
+
+    //Since the other delta delay values may have suffered from edge effects,
+    //we recalculate deltas within regions E, F, H, I
+    sources.push_back({(int)low_x, (int)high_y, (int)low_x, 0, (int)grid.width() - 1, (int)high_y});
+
+    return sources;
+}
+
 static vtr::NdMatrix<float, 4> compute_delta_delays(
     RouterDelayProfiler& route_profiler,
     const t_placer_opts& placer_opts,
@@ -675,199 +1135,47 @@ static vtr::NdMatrix<float, 4> compute_delta_delays(
     bool measure_directconnect,
     size_t longest_length,
     bool is_flat) {
-    //To avoid edge effects we place the source at least 'longest_length' away
-    //from the device edge
-    //and route from there for all possible delta values < dimension
-
     auto& device_ctx = g_vpr_ctx.device();
     auto& grid = device_ctx.grid;
 
     vtr::NdMatrix<float, 4> delta_delays({static_cast<unsigned long>(grid.get_num_layers()), static_cast<unsigned long>(grid.get_num_layers()), grid.width(), grid.height()});
 
-    for (int from_layer_num = 0; from_layer_num < grid.get_num_layers(); from_layer_num++) {
-        for (int to_layer_num = 0; to_layer_num < grid.get_num_layers(); to_layer_num++) {
-            vtr::NdMatrix<std::vector<float>, 2> sampled_delta_delays({grid.width(), grid.height()});
+    DelayProfilerPool profiler_pool(route_profiler);
 
-            size_t mid_x = vtr::nint(grid.width() / 2);
-            size_t mid_y = vtr::nint(grid.height() / 2);
+    std::set<std::string> allowed_types = delay_model_allowed_types(placer_opts);
 
-            size_t low_x = std::min(longest_length, mid_x);
-            size_t low_y = std::min(longest_length, mid_y);
-            size_t high_x = mid_x;
-            size_t high_y = mid_y;
-            if (longest_length <= grid.width()) {
-                high_x = std::max(grid.width() - longest_length, mid_x);
-            }
-            if (longest_length <= grid.height()) {
-                high_y = std::max(grid.height() - longest_length, mid_y);
-            }
-
-            std::set<std::string> allowed_types;
-            if (!placer_opts.allowed_tiles_for_delay_model.empty()) {
-                auto allowed_types_vector = vtr::split(placer_opts.allowed_tiles_for_delay_model, ",");
-                for (const auto& type : allowed_types_vector) {
-                    allowed_types.insert(type);
-                }
-            }
+    t_compute_delta_delay_matrix generic_compute_matrix;
+    switch (placer_opts.place_delta_delay_matrix_calculation_method) {
+        case e_place_delta_delay_algorithm::ASTAR_ROUTE:
+            generic_compute_matrix = generic_compute_matrix_iterative_astar;
+            break;
+        case e_place_delta_delay_algorithm::DIJKSTRA_EXPANSION:
+            generic_compute_matrix = generic_compute_matrix_dijkstra_expansion;
+            break;
+        default:
+            VPR_FATAL_ERROR(VPR_ERROR_PLACE, "Unknown place_delta_delay_matrix_calculation_method %d", placer_opts.place_delta_delay_matrix_calculation_method);
+    }
 
-            //   +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-            //   +                 |                       |               +
-            //   +        A        |           B           |       C       +
-            //   +                 |                       |               +
-            //   +-----------------\-----------------------.---------------+
-            //   +                 |                       |               +
-            //   +                 |                       |               +
-            //   +                 |                       |               +
-            //   +                 |                       |               +
-            //   +        D        |           E           |       F       +
-            //   +                 |                       |               +
-            //   +                 |                       |               +
-            //   +                 |                       |               +
-            //   +                 |                       |               +
-            //   +-----------------*-----------------------/---------------+
-            //   +                 |                       |               +
-            //   +        G        |           H           |       I       +
-            //   +                 |                       |               +
-            //   +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-            //
-            //   * = (low_x, low_y)
-            //   . = (high_x, high_y)
-            //   / = (high_x, low_y)
-            //   \ = (low_x, high_y)
-            //   + = device edge
-
-            //Find the lowest y location on the left edge with a non-empty block
-            int y = 0;
-            int x = 0;
-            t_physical_tile_type_ptr src_type = nullptr;
-            for (x = 0; x < (int)grid.width(); ++x) {
-                for (y = 0; y < (int)grid.height(); ++y) {
-                    auto type = grid.get_physical_type({x, y, from_layer_num});
-
-                    if (type != device_ctx.EMPTY_PHYSICAL_TILE_TYPE) {
-                        if (!allowed_types.empty() && allowed_types.find(std::string(type->name)) == allowed_types.end()) {
-                            continue;
-                        }
-                        src_type = type;
-                        break;
-                    }
-                }
-                if (src_type) {
-                    break;
-                }
-            }
-            VTR_ASSERT(src_type != nullptr);
+    for (int from_layer_num = 0; from_layer_num < grid.get_num_layers(); from_layer_num++) {
+        std::vector<t_delta_sample_source> sources = find_delta_sample_sources(from_layer_num, longest_length, allowed_types);
 
-            t_compute_delta_delay_matrix generic_compute_matrix;
-            switch (placer_opts.place_delta_delay_matrix_calculation_method) {
-                case e_place_delta_delay_algorithm::ASTAR_ROUTE:
-                    generic_compute_matrix = generic_compute_matrix_iterative_astar;
-                    break;
-                case e_place_delta_delay_algorithm::DIJKSTRA_EXPANSION:
-                    generic_compute_matrix = generic_compute_matrix_dijkstra_expansion;
-                    break;
-                default:
-                    VPR_FATAL_ERROR(VPR_ERROR_PLACE, "Unknown place_delta_delay_matrix_calculation_method %d", placer_opts.place_delta_delay_matrix_calculation_method);
-            }
+        for (int to_layer_num = 0; to_layer_num < grid.get_num_layers(); to_layer_num++) {
+            vtr::NdMatrix<std::vector<float>, 2> sampled_delta_delays({grid.width(), grid.height()});
 
+            for (const t_delta_sample_source& source : sources) {
 #ifdef VERBOSE
-            VTR_LOG("Computing from lower left edge (%d,%d):\n", x, y);
+                VTR_LOG("Computing from (%d,%d):\n", source.x, source.y);
 #endif
-            generic_compute_matrix(route_profiler, sampled_delta_delays,
-                                   from_layer_num, to_layer_num,
-                                   x, y,
-                                   x, y,
-                                   grid.width() - 1, grid.height() - 1,
-                                   router_opts,
-                                   measure_directconnect, allowed_types,
-                                   is_flat);
-
-            //Find the lowest x location on the bottom edge with a non-empty block
-            src_type = nullptr;
-            for (y = 0; y < (int)grid.height(); ++y) {
-                for (x = 0; x < (int)grid.width(); ++x) {
-                    auto type = grid.get_physical_type({x, y, from_layer_num});
-
-                    if (type != device_ctx.EMPTY_PHYSICAL_TILE_TYPE) {
-                        if (!allowed_types.empty() && allowed_types.find(std::string(type->name)) == allowed_types.end()) {
-                            continue;
-                        }
-                        src_type = type;
-                        break;
-                    }
-                }
-                if (src_type) {
-                    break;
-                }
+                generic_compute_matrix(profiler_pool, sampled_delta_delays,
+                                       from_layer_num, to_layer_num,
+                                       source.x, source.y,
+                                       source.start_x, source.start_y,
+                                       source.end_x, source.end_y,
+                                       router_opts,
+                                       measure_directconnect, allowed_types,
+                                       is_flat);
             }
-            VTR_ASSERT(src_type != nullptr);
-#ifdef VERBOSE
-            VTR_LOG("Computing from left bottom edge (%d,%d):\n", x, y);
-#endif
-            generic_compute_matrix(route_profiler, sampled_delta_delays,
-                                   from_layer_num, to_layer_num,
-                                   x, y,
-                                   x, y,
-                                   grid.width() - 1, grid.height() - 1,
-                                   router_opts,
-                                   measure_directconnect, allowed_types,
-                                   is_flat);
-
-            //Since the other delta delay values may have suffered from edge effects,
-            //we recalculate deltas within regions B, C, E, F
-#ifdef VERBOSE
-            VTR_LOG("Computing from low/low:\n");
-#endif
-            generic_compute_matrix(route_profiler, sampled_delta_delays,
-                                   from_layer_num, to_layer_num,
-                                   low_x, low_y,
-                                   low_x, low_y,
-                                   grid.width() - 1, grid.height() - 1,
-                                   router_opts,
-                                   measure_directconnect, allowed_types,
-                                   is_flat);
-
-            //Since the other delta delay values may have suffered from edge effects,
-            //we recalculate deltas within regions D, E, G, H
-#ifdef VERBOSE
-            VTR_LOG("Computing from high/high:\n");
-#endif
-            generic_compute_matrix(route_profiler, sampled_delta_delays,
-                                   from_layer_num, to_layer_num,
-                                   high_x, high_y,
-                                   0, 0,
-                                   high_x, high_y,
-                                   router_opts,
-                                   measure_directconnect, allowed_types,
-                                   is_flat);
-
-            //Since the other delta delay values may have suffered from edge effects,
-            //we recalculate deltas within regions A, B, D, E
-#ifdef VERBOSE
-            VTR_LOG("Computing from high/low:\n");
-#endif
-            generic_compute_matrix(route_profiler, sampled_delta_delays,
-                                   from_layer_num, to_layer_num,
-                                   high_x, low_y,
-                                   0, low_y,
-                                   high_x, grid.height() - 1,
-                                   router_opts,
-                                   measure_directconnect, allowed_types,
-                                   is_flat);
-
-            //Since the other delta delay values may have suffered from edge effects,
-            //we recalculate deltas within regions E, F, H, I
-#ifdef VERBOSE
-            VTR_LOG("Computing from low/high:\n");
-#endif
-            generic_compute_matrix(route_profiler, sampled_delta_delays,
-                                   from_layer_num, to_layer_num,
-                                   low_x, high_y,
-                                   low_x, 0,
-                                   grid.width() - 1, high_y,
-                                   router_opts,
-                                   measure_directconnect, allowed_types,
-                                   is_flat);
+
             for (size_t dx = 0; dx < sampled_delta_delays.dim_size(0); ++dx) {
                 for (size_t dy = 0; dy < sampled_delta_delays.dim_size(1); ++dy) {
                     delta_delays[from_layer_num][to_layer_num][dx][dy] = delay_reduce(sampled_delta_delays[dx][dy], placer_opts.delay_model_reducer);
@@ -61,9 +61,33 @@ void PowerCallibInputs::callibrate() {
     /* Set max-value placeholder */
     entries[entries.size() - 1]->factor = entries[entries.size() - 2]->factor;
 
+    callib_sizes.clear();
+    callib_factors.clear();
+    for (const PowerCallibSize* entry : entries) {
+        callib_sizes.push_back(entry->transistor_size);
+        callib_factors.push_back(entry->factor);
+    }
+
     done_callibration = true;
 }
 
+float PowerCallibInputs::interpolate_factor(float transistor_size) const {
+    VTR_ASSERT(done_callibration);
+
+    /* Same bounds as get_entry_bound(): first size above transistor_size (past the min placeholder), and the one before */
+    auto upper = std::upper_bound(callib_sizes.begin() + 1, callib_sizes.end(), transistor_size);
+    if (upper == callib_sizes.end()) {
+        VPR_FATAL_ERROR(VPR_ERROR_POWER, "Failed to interpolate transitor size");
+    }
+    size_t iupper = upper - callib_sizes.begin();
+    size_t ilower = iupper - 1;
+
+    float perc_upper = (transistor_size - callib_sizes[ilower])
+                       / (callib_sizes[iupper] - callib_sizes[ilower]);
+    return perc_upper * callib_factors[iupper]
+           + (1 - perc_upper) * callib_factors[ilower];
+}
+
 PowerCallibSize* PowerCallibInputs::get_entry_bound(bool lower,
                                                     float transistor_size) {
     PowerCallibSize* prev = entries[0];
@@ -153,70 +177,58 @@ void PowerSpicedComponent::add_data_point(int num_inputs, float transistor_size,
     VTR_ASSERT(!done_callibration);
     PowerCallibInputs* inputs_entry = get_entry(num_inputs);
     inputs_entry->add_size(transistor_size, power);
+    data_points.push_back({num_inputs, transistor_size, power});
     sorted = false;
 }
 
+PowerSpicedComponent::t_inputs_bound PowerSpicedComponent::find_inputs_bound(int num_inputs) {
+    t_inputs_bound bound;
+    bound.lower = get_entry_bound(true, num_inputs);
+    bound.upper = get_entry_bound(false, num_inputs);
+    bound.perc_upper = 0.;
+    if (bound.lower && bound.upper) {
+        bound.perc_upper = ((float)(num_inputs - bound.lower->num_inputs))
+                           / ((float)(bound.upper->num_inputs
+                                      - bound.lower->num_inputs));
+    }
+    return bound;
+}
+
 float PowerSpicedComponent::scale_factor(int num_inputs,
                                          float transistor_size) {
-    PowerCallibInputs* inputs_lower;
-    PowerCallibInputs* inputs_upper;
-
-    PowerCallibSize* size_lower;
-    PowerCallibSize* size_upper;
-
     float factor_lower = 0.;
     float factor_upper = 0.;
     float factor;
 
-    float perc_upper;
-
     VTR_ASSERT(done_callibration);
+    VTR_ASSERT(!inputs_bounds.empty());
 
-    inputs_lower = get_entry_bound(true, num_inputs);
-    inputs_upper = get_entry_bound(false, num_inputs);
+    /* Past the largest calibrated # inputs, the bounds are those of the last slot
+     * (up to the max-value placeholder, above which there are none) */
+    t_inputs_bound bound;
+    if (num_inputs < 0 || num_inputs >= entries[entries.size() - 1]->num_inputs) {
+        bound = find_inputs_bound(num_inputs);
+    } else {
+        bound = inputs_bounds[std::min<size_t>(num_inputs, inputs_bounds.size() - 1)];
+    }
 
-    if (inputs_lower) {
+    if (bound.lower) {
         /* Interpolation of factor between sizes for lower # inputs */
-        VTR_ASSERT(inputs_lower->done_callibration);
-        size_lower = inputs_lower->get_entry_bound(true, transistor_size);
-        size_upper = inputs_lower->get_entry_bound(false, transistor_size);
-
-        if (size_lower && size_upper) {
-            perc_upper = (transistor_size - size_lower->transistor_size)
-                         / (size_upper->transistor_size - size_lower->transistor_size);
-            factor_lower = perc_upper * size_upper->factor
-                           + (1 - perc_upper) * size_lower->factor;
-        } else {
-            VPR_FATAL_ERROR(VPR_ERROR_POWER, "Failed to interpolate transitor size");
-        }
+        factor_lower = bound.lower->interpolate_factor(transistor_size);
     }
 
-    if (inputs_upper) {
+    if (bound.upper) {
         /* Interpolation of factor between sizes for upper # inputs */
-        VTR_ASSERT(inputs_upper->done_callibration);
-        size_lower = inputs_upper->get_entry_bound(true, transistor_size);
-        size_upper = inputs_upper->get_entry_bound(false, transistor_size);
-
-        if (size_lower && size_upper) {
-            perc_upper = (transistor_size - size_lower->transistor_size)
-                         / (size_upper->transistor_size - size_lower->transistor_size);
-            factor_upper = perc_upper * size_upper->factor
-                           + (1 - perc_upper) * size_lower->factor;
-        } else {
-            VPR_FATAL_ERROR(VPR_ERROR_POWER, "Failed to interpolate transitor size");
-        }
+        factor_upper = bound.upper->interpolate_factor(transistor_size);
     }
 
-    if (!inputs_lower) {
+    if (!bound.lower) {
         factor = factor_upper;
-    } else if (!inputs_upper) {
+    } else if (!bound.upper) {
         factor = factor_lower;
     } else {
         /* Interpolation of factor between inputs */
-        perc_upper = ((float)(num_inputs - inputs_lower->num_inputs))
-                     / ((float)(inputs_upper->num_inputs
-                                - inputs_lower->num_inputs));
-        factor = perc_upper * factor_upper + (1 - perc_upper) * factor_lower;
+        factor = bound.perc_upper * factor_upper + (1 - bound.perc_upper) * factor_lower;
     }
     return factor;
 }
@@ -242,6 +254,13 @@ void PowerSpicedComponent::callibrate() {
          it != entries.end(); it++) {
         (*it)->callibrate();
     }
+
+    /* Entries are padded with min/max placeholders: the last real one is before the max placeholder */
+    int max_num_inputs = entries[entries.size() - 2]->num_inputs;
+    inputs_bounds.clear();
+    for (int num_inputs = 0; num_inputs <= max_num_inputs; num_inputs++) {
+        inputs_bounds.push_back(find_inputs_bound(num_inputs));
+    }
     done_callibration = true;
 }
 
@@ -55,13 +55,30 @@ class PowerCallibInputs {
     void sort_me();
     bool done_callibration;
     void callibrate();
+
+    /* Factor interpolated between the calibrated sizes around transistor_size (once calibrated) */
+    float interpolate_factor(float transistor_size) const;
+
+  private:
+    /* Sorted sizes (with placeholders) and their factors, copied from entries by callibrate() */
+    std::vector<float> callib_sizes;
+    std::vector<float> callib_factors;
 };
 
 class PowerSpicedComponent {
   public:
+    struct t_data_point {
+        int num_inputs;
+        float transistor_size;
+        float power;
+    };
+
     std::string name;
     std::vector<PowerCallibInputs*> entries;
 
+    /* Data points in the order they were added (e.g. to save them) */
+    std::vector<t_data_point> data_points;
+
     /* Estimation function for this component */
     float (*component_usage)(int num_inputs, float transistor_size);
 
@@ -84,6 +101,20 @@ class PowerSpicedComponent {
     void callibrate();
     bool is_done_callibration();
     void print(FILE* fp);
+
+  private:
+    /* Calibrated entries around a number of inputs, and how far between them it lies */
+    struct t_inputs_bound {
+        PowerCallibInputs* lower;
+        PowerCallibInputs* upper;
+        float perc_upper;
+    };
+
+    /* [0..largest calibrated # inputs], built by callibrate() so that scale_factor()
+     * doesn't search the entries (and only reads this component, from any thread) */
+    std::vector<t_inputs_bound> inputs_bounds;
+
+    t_inputs_bound find_inputs_bound(int num_inputs);
 };
 
 #endif
@@ -27,6 +27,9 @@
 #include <ctime>
 #include <cmath>
 #include <ctype.h>
+#include <map>
+#include <tuple>
+#include <vector>
 
 #include "vtr_util.h"
 #include "vtr_path.h"
@@ -47,10 +50,18 @@
 #include "rr_graph.h"
 #include "vpr_utils.h"
 
+#ifdef VPR_USE_TBB
+#    include <tbb/enumerable_thread_specific.h>
+#    include <tbb/parallel_for.h>
+#endif
+
 /************************* DEFINES **********************************/
 #define CONVERT_NM_PER_M 1000000000
 #define CONVERT_UM_PER_M 1000000
 
+/* Number of routing resources calculated together (by the same thread) */
+#define POWER_RR_NODE_CHUNK_SIZE 4096
+
 /************************* ENUMS ************************************/
 typedef enum {
     POWER_BREAKDOWN_ENTRY_TYPE_TITLE = 0,
@@ -61,6 +72,38 @@ typedef enum {
     POWER_BREAKDOWN_ENTRY_TYPE_BUFS_WIRES
 } e_power_breakdown_entry_type;
 
+/************************* STRUCTS **********************************/
+/* Power of routing resources, split between the components it is reported under */
+struct t_rr_node_power_usage {
+    t_power_usage sb;   /* POWER_COMPONENT_ROUTE_SB */
+    t_power_usage cb;   /* POWER_COMPONENT_ROUTE_CB */
+    t_power_usage wire; /* POWER_COMPONENT_ROUTE_GLB_WIRE */
+    int num_sb_buffers;
+    float total_sb_buffer_size;
+    int num_cb_buffers;
+    float total_cb_buffer_size;
+    int num_unknown_type; /* Number of resources of unknown type (no power, logged once from the main thread) */
+};
+
+/* Configuration of a routing resource which no net uses: the power of such a resource only depends on these */
+struct t_idle_rr_node_config {
+    t_rr_type type = NUM_RR_TYPES;
+    t_edge_size fan_in = 0;
+    short driver_switch_type = OPEN;
+    int seg_index = OPEN;
+    int wire_length = 0;
+    int switchbox_fanout = 0;
+    int connectionbox_fanout = 0;
+
+    bool operator<(const t_idle_rr_node_config& other) const {
+        return std::tie(type, fan_in, driver_switch_type, seg_index, wire_length, switchbox_fanout, connectionbox_fanout)
+               < std::tie(other.type, other.fan_in, other.driver_switch_type, other.seg_index, other.wire_length,
+                          other.switchbox_fanout, other.connectionbox_fanout);
+    }
+};
+
+typedef std::map<t_idle_rr_node_config, t_rr_node_power_usage> t_idle_rr_node_cache;
+
 /************************* File Scope **********************************/
 static t_rr_node_power* rr_node_power;
 
@@ -69,6 +112,19 @@ static t_rr_node_power* rr_node_power;
 static void power_usage_routing(t_power_usage* power_usage,
                                 const t_det_routing_arch* routing_arch,
                                 bool is_flat);
+static void power_usage_rr_node(t_rr_node_power_usage* node_usage,
+                                RRNodeId rr_id,
+                                const t_det_routing_arch* routing_arch);
+static void power_usage_rr_node_cached(t_rr_node_power_usage* node_usage,
+                                       RRNodeId rr_id,
+                                       const t_det_routing_arch* routing_arch,
+                                       t_idle_rr_node_cache* idle_cache);
+static void power_count_rr_node_fanout(RRNodeId rr_id,
+                                       const t_det_routing_arch* routing_arch,
+                                       int* switchbox_fanout,
+                                       int* connectionbox_fanout);
+static void power_zero_rr_node_usage(t_rr_node_power_usage* node_usage);
+static void power_add_rr_node_usage(t_rr_node_power_usage* dest, const t_rr_node_power_usage* src);
 
 /* Tiles */
 static void power_usage_blocks(t_power_usage* power_usage);
@@ -781,6 +837,257 @@ static void dealloc_mux_graph_rec(t_mux_node* node) {
     }
 }
 
+/**
+ * Counts the switches a wire drives into switchboxes and into connection boxes
+ */
+static void power_count_rr_node_fanout(RRNodeId rr_id,
+                                       const t_det_routing_arch* routing_arch,
+                                       int* switchbox_fanout,
+                                       int* connectionbox_fanout) {
+    const auto& rr_graph = g_vpr_ctx.device().rr_graph;
+
+    *connectionbox_fanout = 0;
+    *switchbox_fanout = 0;
+    for (t_edge_size iedge = 0; iedge < rr_graph.num_edges(rr_id); iedge++) {
+        if (rr_graph.edge_switch(rr_id, iedge) == routing_arch->wire_to_rr_ipin_switch) {
+            (*connectionbox_fanout)++;
+        } else if (rr_graph.edge_switch(rr_id, iedge) == routing_arch->delayless_switch) {
+            /* Do nothing */
+        } else {
+            (*switchbox_fanout)++;
+        }
+    }
+}
+
+static void power_zero_rr_node_usage(t_rr_node_power_usage* node_usage) {
+    power_zero_usage(&node_usage->sb);
+    power_zero_usage(&node_usage->cb);
+    power_zero_usage(&node_usage->wire);
+    node_usage->num_sb_buffers = 0;
+    node_usage->total_sb_buffer_size = 0.;
+    node_usage->num_cb_buffers = 0;
+    node_usage->total_cb_buffer_size = 0.;
+    node_usage->num_unknown_type = 0;
+}
+
+static void power_add_rr_node_usage(t_rr_node_power_usage* dest, const t_rr_node_power_usage* src) {
+    power_add_usage(&dest->sb, &src->sb);
+    power_add_usage(&dest->cb, &src->cb);
+    power_add_usage(&dest->wire, &src->wire);
+    dest->num_sb_buffers += src->num_sb_buffers;
+    dest->total_sb_buffer_size += src->total_sb_buffer_size;
+    dest->num_cb_buffers += src->num_cb_buffers;
+    dest->total_cb_buffer_size += src->total_cb_buffer_size;
+    dest->num_unknown_type += src->num_unknown_type;
+}
+
+/**
+ * Calculates the power of a single routing resource (not local routing).
+ * Only reads the shared power state, so that routing resources can be calculated in parallel.
+ */
+static void power_usage_rr_node(t_rr_node_power_usage* node_usage,
+                                RRNodeId rr_id,
+                                const t_det_routing_arch* routing_arch) {
+    auto& power_ctx = g_vpr_ctx.power();
+    auto& device_ctx = g_vpr_ctx.device();
+    const auto& rr_graph = device_ctx.rr_graph;
+
+    t_power_usage sub_power_usage;
+    t_rr_node_power* node_power = &rr_node_power[(size_t)rr_id];
+    float C_wire;
+    float buffer_size;
+    int connectionbox_fanout;
+    int switchbox_fanout;
+    //float C_per_seg_split;
+    int wire_length;
+    const t_edge_size node_fan_in = rr_graph.node_fan_in(rr_id);
+
+    power_zero_rr_node_usage(node_usage);
+
+    switch (rr_graph.node_type(rr_id)) {
+        case SOURCE:
+        case SINK:
+        case OPIN:
+            /* No power usage for these types */
+            break;
+        case IPIN:
+            /* This is part of the connectionbox.  The connection box is comprised of:
+             *  - Driver (accounted for at end of CHANX/Y - see below)
+             *  - Multiplexor */
+
+            if (node_fan_in) {
+                VTR_ASSERT(node_power->in_dens);
+                VTR_ASSERT(node_power->in_prob);
+
+                /* Multiplexor */
+                power_usage_mux_multilevel(&sub_power_usage,
+                                           power_get_mux_arch(node_fan_in,
+                                                              power_ctx.arch->mux_transistor_size),
+                                           node_power->in_prob, node_power->in_dens,
+                                           node_power->selected_input, true,
+                                           power_ctx.solution_inf.T_crit);
+                power_add_usage(&node_usage->cb, &sub_power_usage);
+            }
+            break;
+        case CHANX:
+        case CHANY: {
+            /* This is a wire driven by a switchbox, which includes:
+             * 	- The Multiplexor at the beginning of the wire
+             * 	- A buffer, after the mux to drive the wire
+             * 	- The wire itself
+             * 	- A buffer at the end of the wire, going to switchbox/connectionbox */
+            VTR_ASSERT(node_power->in_dens);
+            VTR_ASSERT(node_power->in_prob);
+
+            wire_length = 0;
+            if (rr_graph.node_type(rr_id) == CHANX) {
+                wire_length = rr_graph.node_xhigh(rr_id) - rr_graph.node_xlow(rr_id) + 1;
+            } else if (rr_graph.node_type(rr_id) == CHANY) {
+                wire_length = rr_graph.node_yhigh(rr_id) - rr_graph.node_ylow(rr_id) + 1;
+            }
+            int seg_index = device_ctx.rr_indexed_data[rr_graph.node_cost_index(rr_id)].seg_index;
+            C_wire = wire_length * rr_graph.rr_segments(RRSegmentId(seg_index)).Cmetal;
+            //(double)power_ctx.commonly_used->tile_length);
+            VTR_ASSERT(node_power->selected_input < node_fan_in);
+
+            /* Multiplexor */
+            power_usage_mux_multilevel(&sub_power_usage,
+                                       power_get_mux_arch(node_fan_in,
+                                                          power_ctx.arch->mux_transistor_size),
+                                       node_power->in_prob, node_power->in_dens,
+                                       node_power->selected_input, true, power_ctx.solution_inf.T_crit);
+            power_add_usage(&node_usage->sb, &sub_power_usage);
+
+            /* Buffer Size */
+            switch (rr_graph.rr_switch_inf(RRSwitchId(node_power->driver_switch_type)).power_buffer_type) {
+                case POWER_BUFFER_TYPE_AUTO:
+                    /*
+                     * C_per_seg_split = ((float) node->num_edges
+                     * power_ctx.commonly_used->INV_1X_C_in + C_wire);
+                     * // / (float) power_ctx.arch->seg_buffer_split;
+                     * buffer_size = power_buffer_size_from_logical_effort(
+                     * C_per_seg_split);
+                     * buffer_size = std::max(buffer_size, 1.0F);
+                     */
+                    buffer_size = power_calc_buffer_size_from_Cout(rr_graph.rr_switch_inf(RRSwitchId(node_power->driver_switch_type)).Cout);
+                    break;
+                case POWER_BUFFER_TYPE_ABSOLUTE_SIZE:
+                    buffer_size = rr_graph.rr_switch_inf(RRSwitchId(node_power->driver_switch_type)).power_buffer_size;
+                    buffer_size = std::max(buffer_size, 1.0F);
+                    break;
+                case POWER_BUFFER_TYPE_NONE:
+                    buffer_size = 0.;
+                    break;
+                default:
+                    buffer_size = 0.;
+                    VTR_ASSERT(0);
+                    break;
+            }
+
+            node_usage->num_sb_buffers++;
+            node_usage->total_sb_buffer_size += buffer_size;
+
+            /*
+             * power_ctx.commonly_used->num_sb_buffers +=
+             * power_ctx.arch->seg_buffer_split;
+             * power_ctx.commonly_used->total_sb_buffer_size += buffer_size
+             * power_ctx.arch->seg_buffer_split;
+             */
+
+            /* Buffer */
+            power_usage_buffer(&sub_power_usage, buffer_size,
+                               node_power->in_prob[node_power->selected_input],
+                               node_power->in_dens[node_power->selected_input], true,
+                               power_ctx.solution_inf.T_crit);
+            power_add_usage(&node_usage->sb, &sub_power_usage);
+
+            /* Wire Capacitance */
+            power_usage_wire(&sub_power_usage, C_wire,
+                             clb_net_density(node_power->net_num), power_ctx.solution_inf.T_crit);
+            power_add_usage(&node_usage->wire, &sub_power_usage);
+
+            /* Determine types of switches that this wire drives */
+            power_count_rr_node_fanout(rr_id, routing_arch, &switchbox_fanout, &connectionbox_fanout);
+
+            /* Buffer to next Switchbox */
+            if (switchbox_fanout) {
+                buffer_size = power_buffer_size_from_logical_effort(switchbox_fanout * power_ctx.commonly_used->NMOS_1X_C_d);
+                power_usage_buffer(&sub_power_usage, buffer_size,
+                                   1 - node_power->in_prob[node_power->selected_input],
+                                   node_power->in_dens[node_power->selected_input], false,
+                                   power_ctx.solution_inf.T_crit);
+                power_add_usage(&node_usage->sb, &sub_power_usage);
+            }
+
+            /* Driver for ConnectionBox */
+            if (connectionbox_fanout) {
+                buffer_size = power_buffer_size_from_logical_effort(connectionbox_fanout * power_ctx.commonly_used->NMOS_1X_C_d);
+
+                power_usage_buffer(&sub_power_usage, buffer_size,
+                                   1 - node_power->in_prob[node_power->selected_input],
+                                   node_power->in_dens[node_power->selected_input],
+                                   false, power_ctx.solution_inf.T_crit);
+                power_add_usage(&node_usage->cb, &sub_power_usage);
+
+                node_usage->num_cb_buffers++;
+                node_usage->total_cb_buffer_size += buffer_size;
+            }
+            break;
+        }
+        default:
+            /* Logged by the caller, which may not be able to log from this thread */
+            node_usage->num_unknown_type++;
+            break;
+    }
+}
+
+/**
+ * Same as power_usage_rr_node, but looks up the power of the routing resources
+ * no net uses in the cache (calculating it on the first lookup of each configuration).
+ * Since the inputs of these resources are all static, their power only depends on their configuration,
+ * and most routing resources of a large device are unused.
+ */
+static void power_usage_rr_node_cached(t_rr_node_power_usage* node_usage,
+                                       RRNodeId rr_id,
+                                       const t_det_routing_arch* routing_arch,
+                                       t_idle_rr_node_cache* idle_cache) {
+    auto& device_ctx = g_vpr_ctx.device();
+    const auto& rr_graph = device_ctx.rr_graph;
+    const t_rr_node_power* node_power = &rr_node_power[(size_t)rr_id];
+    const t_rr_type type = rr_graph.node_type(rr_id);
+
+    bool is_idle = (type == IPIN || type == CHANX || type == CHANY)
+                   && node_power->net_num == ClusterNetId::INVALID()
+                   && node_power->selected_input == 0;
+    const t_edge_size node_fan_in = rr_graph.node_fan_in(rr_id);
+    for (t_edge_size i = 0; is_idle && i < node_fan_in; i++) {
+        is_idle = node_power->in_prob[i] == 0. && node_power->in_dens[i] == 0.;
+    }
+    if (!is_idle) {
+        power_usage_rr_node(node_usage, rr_id, routing_arch);
+        return;
+    }
+
+    t_idle_rr_node_config config;
+    config.type = type;
+    config.fan_in = node_fan_in;
+    if (type == CHANX || type == CHANY) {
+        config.driver_switch_type = node_power->driver_switch_type;
+        config.seg_index = device_ctx.rr_indexed_data[rr_graph.node_cost_index(rr_id)].seg_index;
+        config.wire_length = (type == CHANX) ? rr_graph.node_xhigh(rr_id) - rr_graph.node_xlow(rr_id) + 1
+                                             : rr_graph.node_yhigh(rr_id) - rr_graph.node_ylow(rr_id) + 1;
+        power_count_rr_node_fanout(rr_id, routing_arch, &config.switchbox_fanout, &config.connectionbox_fanout);
+    }
+
+    auto it = idle_cache->find(config);
+    if (it == idle_cache->end()) {
+        power_usage_rr_node(node_usage, rr_id, routing_arch);
+        idle_cache->emplace(config, *node_usage);
+    } else {
+        *node_usage = it->second;
+    }
+}
+
 /**
  * Calculates the power of the entire routing fabric (not local routing
  */
@@ -864,175 +1171,71 @@ static void power_usage_routing(t_power_usage* power_usage,
         }
     }
 
-    /* Calculate power of all routing entities */
-    for (const RRNodeId& rr_id : device_ctx.rr_graph.nodes()) {
-        t_power_usage sub_power_usage;
-        t_rr_node_power* node_power = &rr_node_power[(size_t)rr_id];
-        float C_wire;
-        float buffer_size;
-        int connectionbox_fanout;
-        int switchbox_fanout;
-        //float C_per_seg_split;
-        int wire_length;
-        const t_edge_size node_fan_in = rr_graph.node_fan_in(rr_id);
+    /* Calculate power of all routing entities.
+     * The routing resources are split into fixed size chunks, which are calculated in parallel and then
+     * added up in order, so that the results don't depend on the number of threads. */
 
-        switch (rr_graph.node_type(rr_id)) {
-            case SOURCE:
-            case SINK:
-            case OPIN:
-                /* No power usage for these types */
-                break;
-            case IPIN:
-                /* This is part of the connectionbox.  The connection box is comprised of:
-                 *  - Driver (accounted for at end of CHANX/Y - see below)
-                 *  - Multiplexor */
-
-                if (node_fan_in) {
-                    VTR_ASSERT(node_power->in_dens);
-                    VTR_ASSERT(node_power->in_prob);
-
-                    /* Multiplexor */
-                    power_usage_mux_multilevel(&sub_power_usage,
-                                               power_get_mux_arch(node_fan_in,
-                                                                  power_ctx.arch->mux_transistor_size),
-                                               node_power->in_prob, node_power->in_dens,
-                                               node_power->selected_input, true,
-                                               power_ctx.solution_inf.T_crit);
-                    power_add_usage(power_usage, &sub_power_usage);
-                    power_component_add_usage(&sub_power_usage,
-                                              POWER_COMPONENT_ROUTE_CB);
-                }
-                break;
-            case CHANX:
-            case CHANY: {
-                /* This is a wire driven by a switchbox, which includes:
-                 * 	- The Multiplexor at the beginning of the wire
-                 * 	- A buffer, after the mux to drive the wire
-                 * 	- The wire itself
-                 * 	- A buffer at the end of the wire, going to switchbox/connectionbox */
-                VTR_ASSERT(node_power->in_dens);
-                VTR_ASSERT(node_power->in_prob);
-
-                wire_length = 0;
-                if (rr_graph.node_type(rr_id) == CHANX) {
-                    wire_length = rr_graph.node_xhigh(rr_id) - rr_graph.node_xlow(rr_id) + 1;
-                } else if (rr_graph.node_type(rr_id) == CHANY) {
-                    wire_length = rr_graph.node_yhigh(rr_id) - rr_graph.node_ylow(rr_id) + 1;
-                }
-                int seg_index = device_ctx.rr_indexed_data[rr_graph.node_cost_index(rr_id)].seg_index;
-                C_wire = wire_length * rr_graph.rr_segments(RRSegmentId(seg_index)).Cmetal;
-                //(double)power_ctx.commonly_used->tile_length);
-                VTR_ASSERT(node_power->selected_input < node_fan_in);
-
-                /* Multiplexor */
-                power_usage_mux_multilevel(&sub_power_usage,
-                                           power_get_mux_arch(node_fan_in,
-                                                              power_ctx.arch->mux_transistor_size),
-                                           node_power->in_prob, node_power->in_dens,
-                                           node_power->selected_input, true, power_ctx.solution_inf.T_crit);
-                power_add_usage(power_usage, &sub_power_usage);
-                power_component_add_usage(&sub_power_usage,
-                                          POWER_COMPONENT_ROUTE_SB);
-
-                /* Buffer Size */
-                switch (rr_graph.rr_switch_inf(RRSwitchId(node_power->driver_switch_type)).power_buffer_type) {
-                    case POWER_BUFFER_TYPE_AUTO:
-                        /*
-                         * C_per_seg_split = ((float) node->num_edges
-                         * power_ctx.commonly_used->INV_1X_C_in + C_wire);
-                         * // / (float) power_ctx.arch->seg_buffer_split;
-                         * buffer_size = power_buffer_size_from_logical_effort(
-                         * C_per_seg_split);
-                         * buffer_size = std::max(buffer_size, 1.0F);
-                         */
-                        buffer_size = power_calc_buffer_size_from_Cout(rr_graph.rr_switch_inf(RRSwitchId(node_power->driver_switch_type)).Cout);
-                        break;
-                    case POWER_BUFFER_TYPE_ABSOLUTE_SIZE:
-                        buffer_size = rr_graph.rr_switch_inf(RRSwitchId(node_power->driver_switch_type)).power_buffer_size;
-                        buffer_size = std::max(buffer_size, 1.0F);
-                        break;
-                    case POWER_BUFFER_TYPE_NONE:
-                        buffer_size = 0.;
-                        break;
-                    default:
-                        buffer_size = 0.;
-                        VTR_ASSERT(0);
-                        break;
-                }
-
-                power_ctx.commonly_used->num_sb_buffers++;
-                power_ctx.commonly_used->total_sb_buffer_size += buffer_size;
+    /* Allocate the multiplexer architectures of all the routing muxes ahead, as the threads only look them up */
+    if (power_ctx.commonly_used->max_routing_mux_size > 0) {
+        power_get_mux_arch(power_ctx.commonly_used->max_routing_mux_size, power_ctx.arch->mux_transistor_size);
+    }
 
-                /*
-                 * power_ctx.commonly_used->num_sb_buffers +=
-                 * power_ctx.arch->seg_buffer_split;
-                 * power_ctx.commonly_used->total_sb_buffer_size += buffer_size
-                 * power_ctx.arch->seg_buffer_split;
-                 */
+    const size_t num_rr_nodes = rr_graph.num_nodes();
+    const size_t num_chunks = (num_rr_nodes + POWER_RR_NODE_CHUNK_SIZE - 1) / POWER_RR_NODE_CHUNK_SIZE;
+    std::vector<t_rr_node_power_usage> chunk_usages(num_chunks);
 
-                /* Buffer */
-                power_usage_buffer(&sub_power_usage, buffer_size,
-                                   node_power->in_prob[node_power->selected_input],
-                                   node_power->in_dens[node_power->selected_input], true,
-                                   power_ctx.solution_inf.T_crit);
-                power_add_usage(power_usage, &sub_power_usage);
-                power_component_add_usage(&sub_power_usage,
-                                          POWER_COMPONENT_ROUTE_SB);
-
-                /* Wire Capacitance */
-                power_usage_wire(&sub_power_usage, C_wire,
-                                 clb_net_density(node_power->net_num), power_ctx.solution_inf.T_crit);
-                power_add_usage(power_usage, &sub_power_usage);
-                power_component_add_usage(&sub_power_usage,
-                                          POWER_COMPONENT_ROUTE_GLB_WIRE);
-
-                /* Determine types of switches that this wire drives */
-                connectionbox_fanout = 0;
-                switchbox_fanout = 0;
-                for (t_edge_size iedge = 0; iedge < rr_graph.num_edges(rr_id); iedge++) {
-                    if (rr_graph.edge_switch(rr_id, iedge) == routing_arch->wire_to_rr_ipin_switch) {
-                        connectionbox_fanout++;
-                    } else if (rr_graph.edge_switch(rr_id, iedge) == routing_arch->delayless_switch) {
-                        /* Do nothing */
-                    } else {
-                        switchbox_fanout++;
-                    }
-                }
+#ifdef VPR_USE_TBB
+    tbb::enumerable_thread_specific<t_idle_rr_node_cache> idle_caches;
+#else
+    t_idle_rr_node_cache idle_cache;
+#endif
 
-                /* Buffer to next Switchbox */
-                if (switchbox_fanout) {
-                    buffer_size = power_buffer_size_from_logical_effort(switchbox_fanout * power_ctx.commonly_used->NMOS_1X_C_d);
-                    power_usage_buffer(&sub_power_usage, buffer_size,
-                                       1 - node_power->in_prob[node_power->selected_input],
-                                       node_power->in_dens[node_power->selected_input], false,
-                                       power_ctx.solution_inf.T_crit);
-                    power_add_usage(power_usage, &sub_power_usage);
-                    power_component_add_usage(&sub_power_usage,
-                                              POWER_COMPONENT_ROUTE_SB);
-                }
+    auto calc_chunk = [&](size_t ichunk) {
+#ifdef VPR_USE_TBB
+        t_idle_rr_node_cache* chunk_idle_cache = &idle_caches.local();
+#else
+        t_idle_rr_node_cache* chunk_idle_cache = &idle_cache;
+#endif
+        t_rr_node_power_usage* chunk_usage = &chunk_usages[ichunk];
+        t_rr_node_power_usage node_usage;
+
+        power_zero_rr_node_usage(chunk_usage);
+        size_t end = std::min(num_rr_nodes, (ichunk + 1) * POWER_RR_NODE_CHUNK_SIZE);
+        for (size_t inode = ichunk * POWER_RR_NODE_CHUNK_SIZE; inode < end; inode++) {
+            power_usage_rr_node_cached(&node_usage, RRNodeId(inode), routing_arch, chunk_idle_cache);
+            power_add_rr_node_usage(chunk_usage, &node_usage);
+        }
+    };
 
-                /* Driver for ConnectionBox */
-                if (connectionbox_fanout) {
-                    buffer_size = power_buffer_size_from_logical_effort(connectionbox_fanout * power_ctx.commonly_used->NMOS_1X_C_d);
+#ifdef VPR_USE_TBB
+    tbb::parallel_for(size_t(0), num_chunks, calc_chunk);
+#else
+    for (size_t ichunk = 0; ichunk < num_chunks; ichunk++) {
+        calc_chunk(ichunk);
+    }
+#endif
 
-                    power_usage_buffer(&sub_power_usage, buffer_size,
-                                       1 - node_power->in_prob[node_power->selected_input],
-                                       node_power->in_dens[node_power->selected_input],
-                                       false, power_ctx.solution_inf.T_crit);
-                    power_add_usage(power_usage, &sub_power_usage);
-                    power_component_add_usage(&sub_power_usage,
-                                              POWER_COMPONENT_ROUTE_CB);
+    t_rr_node_power_usage routing_usage;
+    power_zero_rr_node_usage(&routing_usage);
+    for (const t_rr_node_power_usage& chunk_usage : chunk_usages) {
+        power_add_rr_node_usage(&routing_usage, &chunk_usage);
+    }
 
-                    power_ctx.commonly_used->num_cb_buffers++;
-                    power_ctx.commonly_used->total_cb_buffer_size += buffer_size;
-                }
-                break;
-            }
-            default:
-                power_log_msg(POWER_LOG_WARNING,
-                              "The global routing-resource graph contains an unknown node type.");
-                break;
-        }
+    power_add_usage(power_usage, &routing_usage.sb);
+    power_add_usage(power_usage, &routing_usage.cb);
+    power_add_usage(power_usage, &routing_usage.wire);
+    power_component_add_usage(&routing_usage.sb, POWER_COMPONENT_ROUTE_SB);
+    power_component_add_usage(&routing_usage.cb, POWER_COMPONENT_ROUTE_CB);
+    power_component_add_usage(&routing_usage.wire, POWER_COMPONENT_ROUTE_GLB_WIRE);
+
+    power_ctx.commonly_used->num_sb_buffers += routing_usage.num_sb_buffers;
+    power_ctx.commonly_used->total_sb_buffer_size += routing_usage.total_sb_buffer_size;
+    power_ctx.commonly_used->num_cb_buffers += routing_usage.num_cb_buffers;
+    power_ctx.commonly_used->total_cb_buffer_size += routing_usage.total_cb_buffer_size;
+
+    if (routing_usage.num_unknown_type > 0) {
+        power_log_msg(POWER_LOG_WARNING,
+                      "The global routing-resource graph contains an unknown node type.");
     }
 }
 
@@ -1306,7 +1509,8 @@ void power_routing_init(const t_det_routing_arch* routing_arch) {
 bool power_init(const char* power_out_filepath,
                 const char* cmos_tech_behavior_filepath,
                 const t_arch* arch,
-                const t_det_routing_arch* routing_arch) {
+                const t_det_routing_arch* routing_arch,
+                const std::string& tech_cache_dir) {
     auto& power_ctx = g_vpr_ctx.mutable_power();
     bool error = false;
 
@@ -1334,7 +1538,7 @@ bool power_init(const char* power_out_filepath,
     }
 
     /* Load technology properties */
-    power_tech_init(cmos_tech_behavior_filepath);
+    power_tech_init(cmos_tech_behavior_filepath, tech_cache_dir);
 
     /* Low-Level Initialization */
     power_lowlevel_init();
@@ -24,7 +24,9 @@
 
 /************************* INCLUDES *********************************/
 #include <cstring>
+#include <string>
 #include "vtr_assert.h"
+#include "vtr_log.h"
 
 #include "pugixml.hpp"
 #include "pugixml_util.hpp"
@@ -42,8 +44,29 @@
 #include "read_xml_util.h"
 #include "PowerSpicedComponent.h"
 #include "power_callibrate.h"
+#include "timing_model_cache.h"
+
+#ifdef VTR_ENABLE_CAPNPROTO
+#    include "capnp/serialize.h"
+#    include "power_tech.capnp.h"
+#    include "mmap_file.h"
+#    include "serdes_utils.h"
+#endif /* VTR_ENABLE_CAPNPROTO */
 
 /************************* FILE SCOPE **********************************/
+/* Tech file name and estimation function of each calibrated component, by e_power_callib_component */
+struct t_callib_component_inf {
+    const char* name;
+    float (*usage_fn)(int num_inputs, float transistor_size);
+};
+
+static const t_callib_component_inf callib_component_inf[POWER_CALLIB_COMPONENT_MAX] = {
+    {"buf", power_usage_buf_for_callibration},
+    {"buf_levr", power_usage_buf_levr_for_callibration},
+    {"dff", power_usage_ff_for_callibration},
+    {"mux", power_usage_mux_for_callibration},
+    {"lut", power_usage_lut_for_callibration}};
+
 static t_transistor_inf* f_transistor_last_searched;
 static t_power_buffer_strength_inf* f_buffer_strength_last_searched;
 static t_power_mux_volt_inf* f_mux_volt_last_searched;
@@ -63,10 +86,34 @@ static int power_compare_buffer_strength(const void* key_void, const void* elem_
 static int power_compare_buffer_sc_levr(const void* key_void, const void* elem_void);
 static void power_tech_xml_load_components(pugi::xml_node parent, const pugiutil::loc_data& loc_data);
 static void power_tech_xml_load_component(pugi::xml_node parent, const pugiutil::loc_data& loc_data, PowerSpicedComponent** component, const char* name, float (*usage_fn)(int num_inputs, float transistor_size));
+static void power_tech_write_cache(const std::string& file);
+static void power_tech_read_cache(const std::string& file);
 /************************* FUNCTION DEFINITIONS *********************/
 
-void power_tech_init(const char* cmos_tech_behavior_filepath) {
+void power_tech_init(const char* cmos_tech_behavior_filepath, const std::string& cache_dir) {
+    std::string key;
+    if (!cache_dir.empty() && power_tech_is_cacheable()) {
+        key = power_tech_cache_key(cmos_tech_behavior_filepath);
+    }
+    if (key.empty()) {
+        power_tech_load_xml_file(cmos_tech_behavior_filepath);
+        return;
+    }
+
+    std::string entry = timing_model_cache_entry(cache_dir, "power_tech", key);
+    if (timing_model_cache_lookup(entry)) {
+        try {
+            power_tech_read_cache(entry);
+            VTR_LOG("Loaded CMOS technology properties from cache '%s'\n", entry.c_str());
+            return;
+        } catch (const VprError& e) {
+            VTR_LOG_WARN("Discarding unreadable CMOS technology properties cache entry '%s': %s\n", entry.c_str(), e.what());
+            timing_model_cache_remove(entry);
+        }
+    }
+
     power_tech_load_xml_file(cmos_tech_behavior_filepath);
+    timing_model_cache_store(entry, power_tech_write_cache);
 }
 
 /**
@@ -160,28 +207,11 @@ static void power_tech_xml_load_components(pugi::xml_node parent, const pugiutil
     auto& power_ctx = g_vpr_ctx.power();
 
     power_ctx.commonly_used->component_callibration = new PowerSpicedComponent*[POWER_CALLIB_COMPONENT_MAX];
-    for (int i = 0; i < POWER_CALLIB_COMPONENT_MAX; i++)
-        power_ctx.commonly_used->component_callibration[i] = nullptr;
-
-    power_tech_xml_load_component(parent, loc_data,
-                                  &power_ctx.commonly_used->component_callibration[POWER_CALLIB_COMPONENT_BUFFER],
-                                  "buf", power_usage_buf_for_callibration);
-
-    power_tech_xml_load_component(parent, loc_data,
-                                  &power_ctx.commonly_used->component_callibration[POWER_CALLIB_COMPONENT_BUFFER_WITH_LEVR],
-                                  "buf_levr", power_usage_buf_levr_for_callibration);
-
-    power_tech_xml_load_component(parent, loc_data,
-                                  &power_ctx.commonly_used->component_callibration[POWER_CALLIB_COMPONENT_FF],
-                                  "dff", power_usage_ff_for_callibration);
-
-    power_tech_xml_load_component(parent, loc_data,
-                                  &power_ctx.commonly_used->component_callibration[POWER_CALLIB_COMPONENT_MUX],
-                                  "mux", power_usage_mux_for_callibration);
-
-    power_tech_xml_load_component(parent, loc_data,
-                                  &power_ctx.commonly_used->component_callibration[POWER_CALLIB_COMPONENT_LUT],
-                                  "lut", power_usage_lut_for_callibration);
+    for (int i = 0; i < POWER_CALLIB_COMPONENT_MAX; i++) {
+        power_tech_xml_load_component(parent, loc_data,
+                                      &power_ctx.commonly_used->component_callibration[i],
+                                      callib_component_inf[i].name, callib_component_inf[i].usage_fn);
+    }
 }
 
 /**
@@ -738,3 +768,187 @@ static int power_compare_voltage_pair(const void* key_void,
         return 0;
     }
 }
+
+/*
+ * Cache of the technology properties (power_tech_init() with a cache directory).
+ * Without Cap'n Proto, power_tech_is_cacheable() is false and these are never called.
+ */
+#ifndef VTR_ENABLE_CAPNPROTO
+
+static void power_tech_write_cache(const std::string& /*file*/) {
+    VPR_FATAL_ERROR(VPR_ERROR_POWER, "Caching CMOS technology properties requires VTR_ENABLE_CAPNPROTO=ON");
+}
+
+static void power_tech_read_cache(const std::string& /*file*/) {
+    VPR_FATAL_ERROR(VPR_ERROR_POWER, "Caching CMOS technology properties requires VTR_ENABLE_CAPNPROTO=ON");
+}
+
+#else /* VTR_ENABLE_CAPNPROTO */
+
+static void write_transistor_size(VprPowerTransistorSize::Builder out, const t_transistor_size_inf& size_inf) {
+    out.setSize(size_inf.size);
+    out.setLeakageSubthreshold(size_inf.leakage_subthreshold);
+    out.setLeakageGate(size_inf.leakage_gate);
+    out.setCG(size_inf.C_g);
+    out.setCS(size_inf.C_s);
+    out.setCD(size_inf.C_d);
+}
+
+static void read_transistor_size(VprPowerTransistorSize::Reader in, t_transistor_size_inf& size_inf) {
+    size_inf.size = in.getSize();
+    size_inf.leakage_subthreshold = in.getLeakageSubthreshold();
+    size_inf.leakage_gate = in.getLeakageGate();
+    size_inf.C_g = in.getCG();
+    size_inf.C_s = in.getCS();
+    size_inf.C_d = in.getCD();
+}
+
+static void write_transistor(VprPowerTransistor::Builder out, const t_transistor_inf& trans_inf) {
+    auto sizes = out.initSizes(trans_inf.num_size_entries);
+    for (int i = 0; i < trans_inf.num_size_entries; i++) {
+        write_transistor_size(sizes[i], trans_inf.size_inf[i]);
+    }
+    write_transistor_size(out.initLongSize(), *trans_inf.long_trans_inf);
+}
+
+static void read_transistor(VprPowerTransistor::Reader in, t_transistor_inf& trans_inf) {
+    auto sizes = in.getSizes();
+    trans_inf.num_size_entries = sizes.size();
+    trans_inf.size_inf = new t_transistor_size_inf[trans_inf.num_size_entries];
+    for (int i = 0; i < trans_inf.num_size_entries; i++) {
+        read_transistor_size(sizes[i], trans_inf.size_inf[i]);
+    }
+    trans_inf.long_trans_inf = new t_transistor_size_inf;
+    read_transistor_size(in.getLongSize(), *trans_inf.long_trans_inf);
+}
+
+static void power_tech_write_cache(const std::string& file) {
+    const auto& power_ctx = g_vpr_ctx.power();
+    const t_power_tech* tech = power_ctx.tech;
+
+    ::capnp::MallocMessageBuilder builder;
+    auto out = builder.initRoot<VprPowerTech>();
+
+    out.setPnRatio(tech->PN_ratio);
+    out.setVdd(tech->Vdd);
+    out.setTechSize(tech->tech_size);
+    out.setTemperature(tech->temperature);
+
+    write_transistor(out.initNmos(), tech->NMOS_inf);
+    write_transistor(out.initPmos(), tech->PMOS_inf);
+
+    auto nmos_mux = out.initNmosMux(tech->num_nmos_mux_info);
+    for (int inmos = 0; inmos < tech->num_nmos_mux_info; inmos++) {
+        const t_power_nmos_mux_inf& nmos_inf = tech->nmos_mux_info[inmos];
+        nmos_mux[inmos].setNmosSize(nmos_inf.nmos_size);
+
+        /* Entries 0 and max_mux_sl_size are only padding (see power_tech_xml_load_multiplexer_info()) */
+        auto mux_sizes = nmos_mux[inmos].initMuxSizes(nmos_inf.max_mux_sl_size - 1);
+        for (int mux_size = 1; mux_size < nmos_inf.max_mux_sl_size; mux_size++) {
+            const t_power_mux_volt_inf& volt_inf = nmos_inf.mux_voltage_inf[mux_size];
+            auto pairs = mux_sizes[mux_size - 1].initPairs(volt_inf.num_voltage_pairs);
+            for (int i = 0; i < volt_inf.num_voltage_pairs; i++) {
+                pairs[i].setVIn(volt_inf.mux_voltage_pairs[i].v_in);
+                pairs[i].setVOutMin(volt_inf.mux_voltage_pairs[i].v_out_min);
+                pairs[i].setVOutMax(volt_inf.mux_voltage_pairs[i].v_out_max);
+            }
+        }
+    }
+
+    auto nmos_leakage = out.initNmosLeakage(tech->num_nmos_leakage_info);
+    for (int inmos = 0; inmos < tech->num_nmos_leakage_info; inmos++) {
+        const t_power_nmos_leakage_inf& nmos_info = tech->nmos_leakage_info[inmos];
+        nmos_leakage[inmos].setNmosSize(nmos_info.nmos_size);
+        auto pairs = nmos_leakage[inmos].initPairs(nmos_info.num_leakage_pairs);
+        for (int i = 0; i < nmos_info.num_leakage_pairs; i++) {
+            pairs[i].setVDs(nmos_info.leakage_pairs[i].v_ds);
+            pairs[i].setIDs(nmos_info.leakage_pairs[i].i_ds);
+        }
+    }
+
+    auto components = out.initComponents(POWER_CALLIB_COMPONENT_MAX);
+    for (int icomp = 0; icomp < POWER_CALLIB_COMPONENT_MAX; icomp++) {
+        const PowerSpicedComponent* component = power_ctx.commonly_used->component_callibration[icomp];
+        auto points = components[icomp].initPoints(component->data_points.size());
+        for (size_t i = 0; i < component->data_points.size(); i++) {
+            points[i].setNumInputs(component->data_points[i].num_inputs);
+            points[i].setTransistorSize(component->data_points[i].transistor_size);
+            points[i].setPower(component->data_points[i].power);
+        }
+    }
+
+    writeMessageToFile(file, &builder);
+}
+
+static void power_tech_read_cache(const std::string& file) {
+    auto& power_ctx = g_vpr_ctx.mutable_power();
+    t_power_tech* tech = power_ctx.tech;
+
+    MmapFile f(file);
+    ::capnp::FlatArrayMessageReader reader(f.getData(), default_large_capnp_opts());
+    auto in = reader.getRoot<VprPowerTech>();
+
+    /* Check the message has what the xml loader would have required, before allocating anything */
+    if (in.getNmosMux().size() == 0 || in.getComponents().size() != POWER_CALLIB_COMPONENT_MAX) {
+        VPR_FATAL_ERROR(VPR_ERROR_POWER, "Incomplete CMOS technology properties in '%s'", file.c_str());
+    }
+
+    tech->PN_ratio = in.getPnRatio();
+    tech->Vdd = in.getVdd();
+    tech->tech_size = in.getTechSize();
+    tech->temperature = in.getTemperature();
+
+    read_transistor(in.getNmos(), tech->NMOS_inf);
+    read_transistor(in.getPmos(), tech->PMOS_inf);
+
+    auto nmos_mux = in.getNmosMux();
+    tech->num_nmos_mux_info = nmos_mux.size();
+    tech->nmos_mux_info = new t_power_nmos_mux_inf[tech->num_nmos_mux_info];
+    for (int inmos = 0; inmos < tech->num_nmos_mux_info; inmos++) {
+        t_power_nmos_mux_inf& nmos_inf = tech->nmos_mux_info[inmos];
+        nmos_inf.nmos_size = nmos_mux[inmos].getNmosSize();
+
+        auto mux_sizes = nmos_mux[inmos].getMuxSizes();
+        nmos_inf.max_mux_sl_size = 1 + mux_sizes.size();
+        nmos_inf.mux_voltage_inf = new t_power_mux_volt_inf[nmos_inf.max_mux_sl_size + 1];
+        for (int mux_size = 1; mux_size < nmos_inf.max_mux_sl_size; mux_size++) {
+            t_power_mux_volt_inf& volt_inf = nmos_inf.mux_voltage_inf[mux_size];
+            auto pairs = mux_sizes[mux_size - 1].getPairs();
+            volt_inf.num_voltage_pairs = pairs.size();
+            volt_inf.mux_voltage_pairs = new t_power_mux_volt_pair[volt_inf.num_voltage_pairs];
+            for (int i = 0; i < volt_inf.num_voltage_pairs; i++) {
+                volt_inf.mux_voltage_pairs[i].v_in = pairs[i].getVIn();
+                volt_inf.mux_voltage_pairs[i].v_out_min = pairs[i].getVOutMin();
+                volt_inf.mux_voltage_pairs[i].v_out_max = pairs[i].getVOutMax();
+            }
+        }
+    }
+
+    auto nmos_leakage = in.getNmosLeakage();
+    tech->num_nmos_leakage_info = nmos_leakage.size();
+    tech->nmos_leakage_info = new t_power_nmos_leakage_inf[tech->num_nmos_leakage_info];
+    for (int inmos = 0; inmos < tech->num_nmos_leakage_info; inmos++) {
+        t_power_nmos_leakage_inf& nmos_info = tech->nmos_leakage_info[inmos];
+        nmos_info.nmos_size = nmos_leakage[inmos].getNmosSize();
+        auto pairs = nmos_leakage[inmos].getPairs();
+        nmos_info.num_leakage_pairs = pairs.size();
+        nmos_info.leakage_pairs = new t_power_nmos_leakage_pair[nmos_info.num_leakage_pairs];
+        for (int i = 0; i < nmos_info.num_leakage_pairs; i++) {
+            nmos_info.leakage_pairs[i].v_ds = pairs[i].getVDs();
+            nmos_info.leakage_pairs[i].i_ds = pairs[i].getIDs();
+        }
+    }
+
+    auto components = in.getComponents();
+    power_ctx.commonly_used->component_callibration = new PowerSpicedComponent*[POWER_CALLIB_COMPONENT_MAX];
+    for (int icomp = 0; icomp < POWER_CALLIB_COMPONENT_MAX; icomp++) {
+        PowerSpicedComponent* component = new PowerSpicedComponent(callib_component_inf[icomp].name,
+                                                                   callib_component_inf[icomp].usage_fn);
+        for (auto point : components[icomp].getPoints()) {
+            component->add_data_point(point.getNumInputs(), point.getTransistorSize(), point.getPower());
+        }
+        power_ctx.commonly_used->component_callibration[icomp] = component;
+    }
+}
+
+#endif /* VTR_ENABLE_CAPNPROTO */
@@ -26,10 +26,13 @@
 #define __POWER_CMOS_TECH_H__
 
 /************************* INCLUDES *********************************/
+#include <string>
+
 #include "power.h"
 
 /************************* FUNCTION DECLARATIONS ********************/
-void power_tech_init(const char* cmos_tech_behavior_filepath);
+/* Loads the technology properties, from the cache in cache_dir (if not empty) when the file was seen before */
+void power_tech_init(const char* cmos_tech_behavior_filepath, const std::string& cache_dir);
 bool power_find_transistor_info(t_transistor_size_inf** lower,
                                 t_transistor_size_inf** upper,
                                 e_tx_type type,
@@ -2,9 +2,26 @@
 
 /** @file Parallel and net-decomposing case for NetlistRouter. Works like
  * \see ParallelNetlistRouter, but tries to "decompose" nets and assign them to
- * the next level of the partition tree where possible. */
+ * the next level of the partition tree where possible.
+ *
+ * The partition tree is the same for any number of threads, so with --router_deterministic,
+ * where the results of the tree nodes are combined in a fixed order, so is the routing.
+ *
+ * Net decomposition adapts to each net:
+ * - A net (or vnet) is split along the cutline of the tree node, so one side often gets most
+ *   of its sinks. Vnets holding more than their balanced share of their net's sinks keep being
+ *   decomposed past MAX_DECOMP_DEPTH, down to the leaves if need be, rather than being routed
+ *   whole by a single thread (see should_decompose_vnet()).
+ * - Very high fanout nets may be decomposed one level deeper each time their fanout doubles
+ *   (see max_decomp_depth()).
+ * - The routing work (heap pops) of each decomposed net is split between the serial part, at the
+ *   node where it was decomposed, and the parallel part, in its vnets. When less than
+ *   MIN_DECOMP_PARALLEL_FRACTION of it is parallel, decomposition did not gain anything and
+ *   is turned off for the net. */
 #include "netlist_routers.h"
 
+#include <atomic>
+
 #include <tbb/task_group.h>
 
 /** Maximum number of iterations for net decomposition
@@ -21,6 +38,25 @@ const int MIN_DECOMP_SINKS = 8;
 /** Minimum # of fanouts of a virtual net to consider decomp. */
 const int MIN_DECOMP_SINKS_VNET = 8;
 
+/** Nets with more fanouts than this may be decomposed past MAX_DECOMP_DEPTH: one more level each time the fanout doubles */
+const int HIGH_FANOUT_DECOMP_SINKS = 256;
+
+/** Maximum # of decomposition for a very high fanout net */
+const int MAX_HIGH_FANOUT_DECOMP_DEPTH = 4;
+
+/** Decomposition is turned off for a net when less than this fraction of its routing work in an
+ * iteration was done in its virtual nets (i.e. in parallel) */
+constexpr float MIN_DECOMP_PARALLEL_FRACTION = 0.5;
+
+/** Maximum # of decomposition for a net with \p num_sinks fanouts */
+inline int max_decomp_depth(int num_sinks) {
+    int depth = MAX_DECOMP_DEPTH;
+    for (int sinks = HIGH_FANOUT_DECOMP_SINKS; num_sinks > sinks && depth < MAX_HIGH_FANOUT_DECOMP_DEPTH; sinks *= 2) {
+        depth++;
+    }
+    return depth;
+}
+
 template<typename HeapType>
 class DecompNetlistRouter : public NetlistRouter {
   public:
@@ -37,7 +73,8 @@ class DecompNetlistRouter : public NetlistRouter {
         const RoutingPredictor& routing_predictor,
         const vtr::vector<ParentNetId, std::vector<std::unordered_map<RRNodeId, int>>>& choking_spots,
         bool is_flat)
-        : _routers_th(_make_router(router_lookahead, is_flat))
+        : _rr_node_route_inf_th([]() { return vtr::vector<RRNodeId, t_rr_node_route_inf>(g_vpr_ctx.device().rr_graph.num_nodes()); })
+        , _routers_th([this, router_lookahead, is_flat]() { return _make_router(router_lookahead, is_flat); })
         , _net_list(net_list)
         , _router_opts(router_opts)
         , _connections_inf(connections_inf)
@@ -50,7 +87,10 @@ class DecompNetlistRouter : public NetlistRouter {
         , _choking_spots(choking_spots)
         , _is_flat(is_flat)
         , _net_known_samples(net_list.nets().size())
-        , _is_decomp_disabled(net_list.nets().size()) {}
+        , _is_decomp_disabled(net_list.nets().size())
+        , _is_decomposed(net_list.nets().size())
+        , _decomp_serial_work(net_list.nets().size())
+        , _decomp_parallel_work(net_list.nets().size()) {}
     ~DecompNetlistRouter() {}
 
     /** Run a single iteration of netlist routing for this->_net_list. This usually means calling
@@ -77,10 +117,22 @@ class DecompNetlistRouter : public NetlistRouter {
     bool decompose_and_route_vnet(VirtualNet& vnet, const PartitionTreeNode& node, VirtualNet& left, VirtualNet& right);
     /** A single task to route nets inside a PartitionTree node and add tasks for its child nodes to task group \p g. */
     void route_partition_tree_node(tbb::task_group& g, PartitionTreeNode& node);
+    /** Turn decomposition off for the nets decomposed in the last iteration without any parallel gain */
+    void update_decomp_disabled();
+    /** Route a virtual net (or the part of a net before or after decomposing it) with route_net(),
+     * adding its heap pops to \p work. Forwards route_net()'s flags. */
+    NetResultFlags route_decomp_net(const PartitionTreeNode& node, ParentNetId net_id, const t_bb& bb, const vtr::dynamic_bitset<>& sink_mask, size_t& work);
+
+    /** Results to record the routing of \p node's nets in: the node's own in deterministic mode,
+     * the calling thread's otherwise */
+    RouteIterResults& _results_of(const PartitionTreeNode& node) {
+        return _tree_results ? _tree_results->of(node) : _results_th.local();
+    }
 
+    /** Make the ConnectionRouter of the calling thread, which searches with the thread's own
+     * search state so threads never share (cache lines of) path costs */
     ConnectionRouter<HeapType> _make_router(const RouterLookahead* router_lookahead, bool is_flat) {
         auto& device_ctx = g_vpr_ctx.device();
-        auto& route_ctx = g_vpr_ctx.mutable_routing();
 
         return ConnectionRouter<HeapType>(
             device_ctx.grid,
@@ -89,11 +141,14 @@ class DecompNetlistRouter : public NetlistRouter {
             &device_ctx.rr_graph,
             device_ctx.rr_rc_data,
             device_ctx.rr_graph.rr_switch(),
-            route_ctx.rr_node_route_inf,
+            _rr_node_route_inf_th.local(),
             is_flat);
     }
 
     /* Context fields. Most of them will be forwarded to route_net (see route_net.tpp) */
+    /** Per-thread search state (path costs) of the ConnectionRouters. Congestion state stays in
+     * the (shared) RoutingContext::rr_node_cong_inf. */
+    tbb::enumerable_thread_specific<vtr::vector<RRNodeId, t_rr_node_route_inf>> _rr_node_route_inf_th;
     /** Per-thread storage for ConnectionRouters. */
     tbb::enumerable_thread_specific<ConnectionRouter<HeapType>> _routers_th;
     const Netlist<>& _net_list;
@@ -101,6 +156,8 @@ class DecompNetlistRouter : public NetlistRouter {
     CBRR& _connections_inf;
     /** Per-thread storage for RouteIterResults. */
     tbb::enumerable_thread_specific<RouteIterResults> _results_th;
+    /** Per-node storage for RouteIterResults of the current iteration in deterministic mode (null otherwise) */
+    PartitionTreeResults* _tree_results = nullptr;
     NetPinsMatrix<float>& _net_delay;
     const ClusteredPinAtomPinsLookup& _netlist_pin_lookup;
     std::shared_ptr<SetupHoldTimingInfo> _timing_info;
@@ -119,8 +176,17 @@ class DecompNetlistRouter : public NetlistRouter {
      * (i.e. when routing fails after decomposition for a sink, sample it on next iteration) */
     vtr::vector<ParentNetId, vtr::dynamic_bitset<>> _net_known_samples;
 
-    /** Is decomposition disabled for this net? [0.._net_list.size()-1] */
-    vtr::vector<ParentNetId, bool> _is_decomp_disabled;
+    /** Is decomposition disabled for this net? [0.._net_list.size()-1]
+     * (not a vector<bool>: nets in different partitions are written concurrently) */
+    vtr::vector<ParentNetId, char> _is_decomp_disabled;
+
+    /** Was this net decomposed in the current iteration? [0.._net_list.size()-1] */
+    vtr::vector<ParentNetId, char> _is_decomposed;
+
+    /** Routing work (heap pops) of each decomposed net in the current iteration, done at the tree node
+     * where it was decomposed and in its virtual nets (which are routed concurrently) [0.._net_list.size()-1] */
+    vtr::vector<ParentNetId, size_t> _decomp_serial_work;
+    vtr::vector<ParentNetId, std::atomic<size_t>> _decomp_parallel_work;
 };
 
 #include "DecompNetlistRouter.tpp"
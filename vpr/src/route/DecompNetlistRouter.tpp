@@ -21,25 +21,81 @@ inline RouteIterResults DecompNetlistRouter<HeapType>::route_netlist(int itry, f
     _pres_fac = pres_fac;
     _worst_neg_slack = worst_neg_slack;
 
+    update_decomp_disabled();
+
     /* Organize netlist into a PartitionTree.
      * Nets in a given level of nodes are guaranteed to not have any overlapping bounding boxes, so they can be routed in parallel. */
-    PartitionTree tree(_net_list);
+    PartitionTree tree(_net_list, _is_flat);
+
+    std::unique_ptr<PartitionTreeResults> tree_results;
+    if (_router_opts.router_deterministic) {
+        tree_results = std::make_unique<PartitionTreeResults>(tree);
+    }
+    _tree_results = tree_results.get();
 
     /* Put the root node on the task queue, which will add its child nodes when it's finished. Wait until the entire tree gets routed. */
     tbb::task_group g;
     route_partition_tree_node(g, tree.root());
     g.wait();
 
-    /* Combine results from threads */
+    /* Combine results from tree nodes (deterministic mode) or threads */
     RouteIterResults out;
-    for (auto& results : _results_th) {
-        out.stats.combine(results.stats);
-        out.rerouted_nets.insert(out.rerouted_nets.end(), results.rerouted_nets.begin(), results.rerouted_nets.end());
-        out.is_routable &= results.is_routable;
+    if (tree_results) {
+        out = tree_results->combine();
+        _tree_results = nullptr;
+    } else {
+        for (auto& results : _results_th) {
+            out.combine(results);
+        }
     }
     return out;
 }
 
+template<typename HeapType>
+void DecompNetlistRouter<HeapType>::update_decomp_disabled() {
+    for (auto net_id : _net_list.nets()) {
+        if (!_is_decomposed[net_id])
+            continue;
+        size_t parallel_work = _decomp_parallel_work[net_id];
+        size_t total_work = _decomp_serial_work[net_id] + parallel_work;
+        if (parallel_work < MIN_DECOMP_PARALLEL_FRACTION * total_work)
+            _is_decomp_disabled[net_id] = true;
+
+        _is_decomposed[net_id] = false;
+        _decomp_serial_work[net_id] = 0;
+        _decomp_parallel_work[net_id] = 0;
+    }
+}
+
+template<typename HeapType>
+NetResultFlags DecompNetlistRouter<HeapType>::route_decomp_net(const PartitionTreeNode& node, ParentNetId net_id, const t_bb& bb, const vtr::dynamic_bitset<>& sink_mask, size_t& work) {
+    RouterStats& stats = _results_of(node).stats;
+    size_t heap_pops = stats.heap_pops;
+    auto flags = route_net(
+        _routers_th.local(),
+        _net_list,
+        net_id,
+        _itry,
+        _pres_fac,
+        _router_opts,
+        _connections_inf,
+        stats,
+        _net_delay,
+        _netlist_pin_lookup,
+        _timing_info.get(),
+        _pin_timing_invalidator,
+        _budgeting_inf,
+        _worst_neg_slack,
+        _routing_predictor,
+        _choking_spots[net_id],
+        _is_flat,
+        bb,
+        false,
+        sink_mask);
+    work += stats.heap_pops - heap_pops;
+    return flags;
+}
+
 template<typename HeapType>
 void DecompNetlistRouter<HeapType>::set_rcv_enabled(bool x) {
     if (x)
@@ -96,9 +152,16 @@ inline bool should_decompose_vnet(const VirtualNet& vnet, const PartitionTreeNod
     if (!node.left || !node.right)
         return false;
 
-    /* Vnet has been decomposed too many times */
-    if (vnet.times_decomposed >= MAX_DECOMP_DEPTH)
-        return false;
+    /* Vnet has been decomposed too many times for its net's fanout */
+    int net_sinks = g_vpr_ctx.routing().route_trees[vnet.net_id]->num_sinks();
+    int num_sinks = get_vnet_sink_mask(vnet).count();
+    if (vnet.times_decomposed >= max_decomp_depth(net_sinks)) {
+        /* ... unless the cutlines so far left it with more than twice its balanced share
+         * (1 / 2^times_decomposed) of the sinks: a single thread would route most of the net */
+        bool is_heavy = (size_t(num_sinks) << vnet.times_decomposed) > 2 * size_t(net_sinks);
+        if (!is_heavy)
+            return false;
+    }
 
     /* Cutline doesn't go through vnet (a valid case: it wasn't there when partition tree was being built) */
     if (node.cutline_axis == Axis::X) {
@@ -110,7 +173,6 @@ inline bool should_decompose_vnet(const VirtualNet& vnet, const PartitionTreeNod
     }
 
     /* Vnet is too small */
-    int num_sinks = get_vnet_sink_mask(vnet).count();
     if (num_sinks < MIN_DECOMP_SINKS_VNET)
         return false;
 
@@ -121,6 +183,23 @@ template<typename HeapType>
 void DecompNetlistRouter<HeapType>::route_partition_tree_node(tbb::task_group& g, PartitionTreeNode& node) {
     auto& route_ctx = g_vpr_ctx.mutable_routing();
 
+    /* A cutline between dies has no nets of its own (so none to decompose): route the dies
+     * on either side in parallel, then the nets crossing between them */
+    if (node.cutline_axis == Axis::LAYER) {
+        tbb::task_group dies;
+        dies.run([&]() {
+            route_partition_tree_node(dies, *node.left);
+        });
+        dies.run([&]() {
+            route_partition_tree_node(dies, *node.right);
+        });
+        dies.wait();
+        if (node.crossing) {
+            route_partition_tree_node(g, *node.crossing);
+        }
+        return;
+    }
+
     /* Sort so that nets with the most sinks are routed first.
      * We want to interleave virtual nets with regular ones, so sort an "index vector"
      * instead where indices >= node.nets.size() refer to node.vnets.
@@ -135,6 +214,7 @@ void DecompNetlistRouter<HeapType>::route_partition_tree_node(tbb::task_group& g
     });
 
     vtr::Timer t;
+    RouteIterResults& results = _results_of(node);
     for (size_t i : order) {
         if (i < node.nets.size()) { /* Regular net (not decomposed) */
             ParentNetId net_id = node.nets[i];
@@ -155,7 +235,7 @@ void DecompNetlistRouter<HeapType>::route_partition_tree_node(tbb::task_group& g
                 if (is_decomposed) {
                     node.left->vnets.push_back(left_vnet);
                     node.right->vnets.push_back(right_vnet);
-                    _results_th.local().rerouted_nets.push_back(net_id);
+                    results.rerouted_nets.push_back(net_id);
                     continue;
                 }
             }
@@ -168,7 +248,7 @@ void DecompNetlistRouter<HeapType>::route_partition_tree_node(tbb::task_group& g
                 _pres_fac,
                 _router_opts,
                 _connections_inf,
-                _results_th.local().stats,
+                results.stats,
                 _net_delay,
                 _netlist_pin_lookup,
                 _timing_info.get(),
@@ -182,7 +262,7 @@ void DecompNetlistRouter<HeapType>::route_partition_tree_node(tbb::task_group& g
                 false);
             if (!flags.success && !flags.retry_with_full_bb) {
                 /* Disconnected RRG and ConnectionRouter doesn't think growing the BB will work */
-                _results_th.local().is_routable = false;
+                results.is_routable = false;
                 return;
             }
             if (flags.retry_with_full_bb) {
@@ -193,7 +273,7 @@ void DecompNetlistRouter<HeapType>::route_partition_tree_node(tbb::task_group& g
                 continue;
             }
             if (flags.was_rerouted) {
-                _results_th.local().rerouted_nets.push_back(net_id);
+                results.rerouted_nets.push_back(net_id);
             }
         } else { /* Virtual net (was decomposed in the upper level) */
             VirtualNet& vnet = node.vnets[i - node.nets.size()];
@@ -208,27 +288,9 @@ void DecompNetlistRouter<HeapType>::route_partition_tree_node(tbb::task_group& g
             }
             /* Route the full vnet. Again we don't care about the flags, they should be handled by the regular path */
             auto sink_mask = get_vnet_sink_mask(vnet);
-            route_net(
-                _routers_th.local(),
-                _net_list,
-                vnet.net_id,
-                _itry,
-                _pres_fac,
-                _router_opts,
-                _connections_inf,
-                _results_th.local().stats,
-                _net_delay,
-                _netlist_pin_lookup,
-                _timing_info.get(),
-                _pin_timing_invalidator,
-                _budgeting_inf,
-                _worst_neg_slack,
-                _routing_predictor,
-                _choking_spots[vnet.net_id],
-                _is_flat,
-                vnet.clipped_bb,
-                false,
-                sink_mask);
+            size_t work = 0;
+            route_decomp_net(node, vnet.net_id, vnet.clipped_bb, sink_mask, work);
+            _decomp_parallel_work[vnet.net_id] += work;
         }
     }
 
@@ -284,31 +346,14 @@ bool DecompNetlistRouter<HeapType>::decompose_and_route_net(ParentNetId net_id,
     auto sink_mask = get_decomposition_mask(net_id, node);
 
     /* Route the net with the given mask: only the sinks we ask for will be routed */
-    auto flags = route_net(
-        _routers_th.local(),
-        _net_list,
-        net_id,
-        _itry,
-        _pres_fac,
-        _router_opts,
-        _connections_inf,
-        _results_th.local().stats,
-        _net_delay,
-        _netlist_pin_lookup,
-        _timing_info.get(),
-        _pin_timing_invalidator,
-        _budgeting_inf,
-        _worst_neg_slack,
-        _routing_predictor,
-        _choking_spots[net_id],
-        _is_flat,
-        net_bb,
-        false,
-        sink_mask);
+    size_t work = 0;
+    auto flags = route_decomp_net(node, net_id, net_bb, sink_mask, work);
 
     if (!flags.success) { /* Even if flags.retry_with_full_bb is set, better to bail out here */
         return false;
     }
+    _is_decomposed[net_id] = true;
+    _decomp_serial_work[net_id] = work;
 
     /* Divide the net into two halves */
     make_vnet_pair(net_id, net_bb, node.cutline_axis, node.cutline_pos, left, right);
@@ -385,27 +430,9 @@ bool DecompNetlistRouter<HeapType>::decompose_and_route_vnet(VirtualNet& vnet, c
     auto sink_mask = get_vnet_decomposition_mask(vnet, node);
 
     /* Route the *parent* net with the given mask: only the sinks we ask for will be routed */
-    auto flags = route_net(
-        _routers_th.local(),
-        _net_list,
-        vnet.net_id,
-        _itry,
-        _pres_fac,
-        _router_opts,
-        _connections_inf,
-        _results_th.local().stats,
-        _net_delay,
-        _netlist_pin_lookup,
-        _timing_info.get(),
-        _pin_timing_invalidator,
-        _budgeting_inf,
-        _worst_neg_slack,
-        _routing_predictor,
-        _choking_spots[vnet.net_id],
-        _is_flat,
-        vnet.clipped_bb,
-        false,
-        sink_mask);
+    size_t work = 0;
+    auto flags = route_decomp_net(node, vnet.net_id, vnet.clipped_bb, sink_mask, work);
+    _decomp_parallel_work[vnet.net_id] += work;
 
     if (!flags.success) { /* Even if flags.retry_with_full_bb is set, better to bail out here */
         PartitionTreeDebug::log("Failed to route decomposed net:\n" + describe_vnet(vnet));
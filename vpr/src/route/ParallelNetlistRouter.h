@@ -6,11 +6,33 @@
  * its child nodes to the task queue. This approach is serially equivalent & deterministic,
  * but it can reduce QoR in congested cases [0].
  *
+ * Idle threads steal queued tree nodes (tbb::task_group is work-stealing), but a single
+ * expensive leaf still holds up the end of an iteration. To balance the load, each net's
+ * routing time in the previous iteration is used as its cost when building the tree, and
+ * partitions costing more than a fraction of an ideal per-thread share are split further.
+ *
+ * With --router_optimistic_concurrency, a node's nets (the ones crossing its cutline) are
+ * routed concurrently with each other and with its branches instead of before them. Their
+ * occupancy updates are atomic (see t_rr_node_cong_inf), so nets using the same routing
+ * resource at once only cause overuse, which later iterations resolve as usual. This
+ * shrinks the serial part at the top of the tree, but the result is no longer deterministic.
+ *
+ * Without it, the routing itself is the same whichever thread routes a node, but the tree is
+ * not: it is balanced with the nets' routing times and the number of threads. With
+ * --router_deterministic, it is balanced with the number of heap pops of each net instead, for
+ * a fixed number of threads, and the results of the nodes are combined in a fixed order (see
+ * PartitionTreeResults), so that the routing is the same for any --num_workers.
+ *
+ * On multi-die devices, the dies are routed in parallel first, and the nets crossing between
+ * dies only once they are done (see PartitionTree).
+ *
  * Note that the parallel router does not support graphical router breakpoints.
  *
  * [0]: F. Koşar, "A net-decomposing parallel FPGA router", MS thesis, UofT ECE, 2023 */
 #include "netlist_routers.h"
 
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for_each.h>
 #include <tbb/task_group.h>
 
 /** Parallel impl for NetlistRouter.
@@ -34,7 +56,8 @@ class ParallelNetlistRouter : public NetlistRouter {
         const RoutingPredictor& routing_predictor,
         const vtr::vector<ParentNetId, std::vector<std::unordered_map<RRNodeId, int>>>& choking_spots,
         bool is_flat)
-        : _routers_th(_make_router(router_lookahead, is_flat))
+        : _rr_node_route_inf_th([]() { return vtr::vector<RRNodeId, t_rr_node_route_inf>(g_vpr_ctx.device().rr_graph.num_nodes()); })
+        , _routers_th([this, router_lookahead, is_flat]() { return _make_router(router_lookahead, is_flat); })
         , _net_list(net_list)
         , _router_opts(router_opts)
         , _connections_inf(connections_inf)
@@ -45,7 +68,8 @@ class ParallelNetlistRouter : public NetlistRouter {
         , _budgeting_inf(budgeting_inf)
         , _routing_predictor(routing_predictor)
         , _choking_spots(choking_spots)
-        , _is_flat(is_flat) {}
+        , _is_flat(is_flat)
+        , _net_costs(net_list.nets().size(), 0.) {}
     ~ParallelNetlistRouter() {}
 
     /** Run a single iteration of netlist routing for this->_net_list. This usually means calling
@@ -59,9 +83,32 @@ class ParallelNetlistRouter : public NetlistRouter {
     /** A single task to route nets inside a PartitionTree node and add tasks for its child nodes to task group \p g. */
     void route_partition_tree_node(tbb::task_group& g, PartitionTreeNode& node);
 
+    /** Route the branches of a PartitionTree node with a layer cutline (i.e. the dies on either side) in parallel,
+     * then its crossing subtree, adding the tasks of the latter to task group \p g. */
+    void route_layer_partition_tree_node(tbb::task_group& g, PartitionTreeNode& node);
+
+    /** Add tasks to route the child nodes of \p node (if any) to task group \p g. */
+    void add_branch_tasks(tbb::task_group& g, PartitionTreeNode& node);
+
+    /** Route a single net of a PartitionTree node with the calling thread's ConnectionRouter,
+     * recording it in \p results.
+     * \return false if the net is unroutable */
+    bool route_partition_net(ParentNetId net_id, RouteIterResults& results);
+
+    /** Build a PartitionTree weighted by the previous iteration's net costs, splitting
+     * partitions which would take too long for a single one of \p num_threads threads. */
+    PartitionTree _make_cost_partition_tree(size_t num_threads);
+
+    /** Results to record the routing of \p node's nets in: the node's own in deterministic mode,
+     * the calling thread's otherwise */
+    RouteIterResults& _results_of(const PartitionTreeNode& node) {
+        return _tree_results ? _tree_results->of(node) : _results_th.local();
+    }
+
+    /** Make the ConnectionRouter of the calling thread, which searches with the thread's own
+     * search state so threads never share (cache lines of) path costs */
     ConnectionRouter<HeapType> _make_router(const RouterLookahead* router_lookahead, bool is_flat) {
         auto& device_ctx = g_vpr_ctx.device();
-        auto& route_ctx = g_vpr_ctx.mutable_routing();
 
         return ConnectionRouter<HeapType>(
             device_ctx.grid,
@@ -70,11 +117,14 @@ class ParallelNetlistRouter : public NetlistRouter {
             &device_ctx.rr_graph,
             device_ctx.rr_rc_data,
             device_ctx.rr_graph.rr_switch(),
-            route_ctx.rr_node_route_inf,
+            _rr_node_route_inf_th.local(),
             is_flat);
     }
 
     /* Context fields. Most of them will be forwarded to route_net (see route_net.tpp) */
+    /** Per-thread search state (path costs) of the ConnectionRouters. Congestion state stays in
+     * the (shared) RoutingContext::rr_node_cong_inf. */
+    tbb::enumerable_thread_specific<vtr::vector<RRNodeId, t_rr_node_route_inf>> _rr_node_route_inf_th;
     /** Per-thread storage for ConnectionRouters. */
     tbb::enumerable_thread_specific<ConnectionRouter<HeapType>> _routers_th;
     const Netlist<>& _net_list;
@@ -82,6 +132,8 @@ class ParallelNetlistRouter : public NetlistRouter {
     CBRR& _connections_inf;
     /** Per-thread storage for RouteIterResults. */
     tbb::enumerable_thread_specific<RouteIterResults> _results_th;
+    /** Per-node storage for RouteIterResults of the current iteration in deterministic mode (null otherwise) */
+    PartitionTreeResults* _tree_results = nullptr;
     NetPinsMatrix<float>& _net_delay;
     const ClusteredPinAtomPinsLookup& _netlist_pin_lookup;
     std::shared_ptr<SetupHoldTimingInfo> _timing_info;
@@ -91,6 +143,12 @@ class ParallelNetlistRouter : public NetlistRouter {
     const vtr::vector<ParentNetId, std::vector<std::unordered_map<RRNodeId, int>>>& _choking_spots;
     bool _is_flat;
 
+    /** Time taken to route each net in the previous iteration (heap pops in deterministic mode).
+     * Used as a cost estimate when building the PartitionTree */
+    vtr::vector<ParentNetId, float> _net_costs;
+    /** Per-thread time spent routing nets in the current iteration */
+    tbb::enumerable_thread_specific<float> _busy_time_th;
+
     /** Cached routing parameters for current iteration (inputs to \see route_netlist()) */
     int _itry;
     float _pres_fac;
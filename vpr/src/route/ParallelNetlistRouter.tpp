@@ -6,12 +6,30 @@
 #include "route_net.h"
 #include "vtr_time.h"
 
+#include <tbb/task_arena.h>
+
+/** Partitions estimated to take longer than this fraction of an ideal per-thread share of
+ * the iteration (total cost / number of threads) get split further when building the tree */
+constexpr float HEAVY_PARTITION_FRACTION = 0.5;
+
+/** Lower bound on the cost of a net, so that nets which took (almost) no time to route last
+ * iteration still count when placing cutlines */
+constexpr float MIN_NET_COST = 1e-7;
+
+/** Number of threads the PartitionTree is balanced for in deterministic mode, whatever the
+ * actual number, so that the tree (and so the routing) doesn't depend on it */
+constexpr size_t DETERMINISTIC_NUM_THREADS = 64;
+
 template<typename HeapType>
 inline RouteIterResults ParallelNetlistRouter<HeapType>::route_netlist(int itry, float pres_fac, float worst_neg_slack) {
     /* Reset results for each thread */
     for (auto& results : _results_th) {
         results = RouteIterResults();
     }
+    for (auto& busy_time : _busy_time_th) {
+        busy_time = 0.;
+    }
+    vtr::Timer iter_timer;
 
     /* Set the routing parameters: they won't change until the next call and that saves us the trouble of passing them around */
     _itry = itry;
@@ -20,71 +38,106 @@ inline RouteIterResults ParallelNetlistRouter<HeapType>::route_netlist(int itry,
 
     /* Organize netlist into a PartitionTree.
      * Nets in a given level of nodes are guaranteed to not have any overlapping bounding boxes, so they can be routed in parallel. */
-    PartitionTree tree(_net_list);
+    size_t num_threads = tbb::this_task_arena::max_concurrency();
+    bool deterministic = _router_opts.router_deterministic;
+    PartitionTree tree = (itry == 1) ? PartitionTree(_net_list, _is_flat) : _make_cost_partition_tree(deterministic ? DETERMINISTIC_NUM_THREADS : num_threads);
+
+    std::unique_ptr<PartitionTreeResults> tree_results;
+    if (deterministic) {
+        tree_results = std::make_unique<PartitionTreeResults>(tree);
+    }
+    _tree_results = tree_results.get();
 
     /* Put the root node on the task queue, which will add its child nodes when it's finished. Wait until the entire tree gets routed. */
     tbb::task_group g;
     route_partition_tree_node(g, tree.root());
     g.wait();
 
-    /* Combine results from threads */
+    /* Combine results from tree nodes (deterministic mode) or threads */
     RouteIterResults out;
-    for (auto& results : _results_th) {
-        out.stats.combine(results.stats);
-        out.rerouted_nets.insert(out.rerouted_nets.end(), results.rerouted_nets.begin(), results.rerouted_nets.end());
-        out.is_routable &= results.is_routable;
+    if (tree_results) {
+        out = tree_results->combine();
+        _tree_results = nullptr;
+    } else {
+        for (auto& results : _results_th) {
+            out.combine(results);
+        }
     }
+
+    /* Threads which never got any work don't show up in _busy_time_th */
+    out.thread_busy_time.assign(_busy_time_th.begin(), _busy_time_th.end());
+    out.thread_busy_time.resize(std::max(out.thread_busy_time.size(), num_threads), 0.);
+    out.wall_time = iter_timer.elapsed_sec();
     return out;
 }
 
+template<typename HeapType>
+PartitionTree ParallelNetlistRouter<HeapType>::_make_cost_partition_tree(size_t num_threads) {
+    vtr::vector<ParentNetId, float> net_costs(_net_costs.size());
+    float total_cost = 0.;
+    for (auto net_id : _net_list.nets()) {
+        net_costs[net_id] = std::max(_net_costs[net_id], MIN_NET_COST);
+        total_cost += net_costs[net_id];
+    }
+
+    float split_cost = HEAVY_PARTITION_FRACTION * total_cost / num_threads;
+    return PartitionTree(_net_list, net_costs, split_cost, _is_flat);
+}
+
 template<typename HeapType>
 void ParallelNetlistRouter<HeapType>::route_partition_tree_node(tbb::task_group& g, PartitionTreeNode& node) {
-    auto& route_ctx = g_vpr_ctx.mutable_routing();
+    if (node.cutline_axis == Axis::LAYER) {
+        route_layer_partition_tree_node(g, node);
+        return;
+    }
 
     /* Sort so net with most sinks is routed first. */
     std::stable_sort(node.nets.begin(), node.nets.end(), [&](ParentNetId id1, ParentNetId id2) -> bool {
         return _net_list.net_sinks(id1).size() > _net_list.net_sinks(id2).size();
     });
 
+    /* Optimistic mode: don't wait for this node's nets, they may share routing resources with
+     * the nets on either side. Route them all concurrently with the branches. */
+    if (_router_opts.router_optimistic_concurrency) {
+        add_branch_tasks(g, node);
+
+        vtr::Timer t;
+        tbb::parallel_for_each(node.nets.begin(), node.nets.end(), [&](ParentNetId net_id) {
+            route_partition_net(net_id, _results_th.local());
+        });
+        PartitionTreeDebug::log("Node with " + std::to_string(node.nets.size()) + " nets routed optimistically in " + std::to_string(t.elapsed_sec()) + " s");
+        return;
+    }
+
     vtr::Timer t;
+    RouteIterResults& results = _results_of(node);
     for (auto net_id : node.nets) {
-        auto flags = route_net(
-            _routers_th.local(),
-            _net_list,
-            net_id,
-            _itry,
-            _pres_fac,
-            _router_opts,
-            _connections_inf,
-            _results_th.local().stats,
-            _net_delay,
-            _netlist_pin_lookup,
-            _timing_info.get(),
-            _pin_timing_invalidator,
-            _budgeting_inf,
-            _worst_neg_slack,
-            _routing_predictor,
-            _choking_spots[net_id],
-            _is_flat,
-            route_ctx.route_bb[net_id]);
-
-        if (!flags.success && !flags.retry_with_full_bb) {
-            /* Disconnected RRG and ConnectionRouter doesn't think growing the BB will work */
-            _results_th.local().is_routable = false;
+        if (!route_partition_net(net_id, results))
             return;
-        }
-        if (flags.retry_with_full_bb) {
-            /* ConnectionRouter thinks we should grow the BB. Do that and leave this net unrouted for now */
-            route_ctx.route_bb[net_id] = full_device_bb();
-            continue;
-        }
-        if (flags.was_rerouted) {
-            _results_th.local().rerouted_nets.push_back(net_id);
-        }
     }
     PartitionTreeDebug::log("Node with " + std::to_string(node.nets.size()) + " nets routed in " + std::to_string(t.elapsed_sec()) + " s");
 
     /* This node is finished: add left & right branches to the task queue */
+    add_branch_tasks(g, node);
+}
+
+template<typename HeapType>
+void ParallelNetlistRouter<HeapType>::route_layer_partition_tree_node(tbb::task_group& g, PartitionTreeNode& node) {
+    /* Route the dies on either side in parallel (in their own task group, to know when they are done) */
+    vtr::Timer t;
+    tbb::task_group dies;
+    add_branch_tasks(dies, node);
+    dies.wait();
+    PartitionTreeDebug::log("Dies on either side of layer cutline " + std::to_string(node.cutline_pos) + " routed in " + std::to_string(t.elapsed_sec()) + " s");
+
+    /* Then the nets crossing between them */
+    if (node.crossing) {
+        route_partition_tree_node(g, *node.crossing);
+    }
+}
+
+template<typename HeapType>
+void ParallelNetlistRouter<HeapType>::add_branch_tasks(tbb::task_group& g, PartitionTreeNode& node) {
     if (node.left && node.right) {
         g.run([&]() {
             route_partition_tree_node(g, *node.left);
@@ -97,6 +150,52 @@ void ParallelNetlistRouter<HeapType>::route_partition_tree_node(tbb::task_group&
     }
 }
 
+template<typename HeapType>
+bool ParallelNetlistRouter<HeapType>::route_partition_net(ParentNetId net_id, RouteIterResults& results) {
+    auto& route_ctx = g_vpr_ctx.mutable_routing();
+
+    vtr::Timer net_timer;
+    size_t heap_pops = results.stats.heap_pops;
+    auto flags = route_net(
+        _routers_th.local(),
+        _net_list,
+        net_id,
+        _itry,
+        _pres_fac,
+        _router_opts,
+        _connections_inf,
+        results.stats,
+        _net_delay,
+        _netlist_pin_lookup,
+        _timing_info.get(),
+        _pin_timing_invalidator,
+        _budgeting_inf,
+        _worst_neg_slack,
+        _routing_predictor,
+        _choking_spots[net_id],
+        _is_flat,
+        route_ctx.route_bb[net_id]);
+    float net_time = net_timer.elapsed_sec();
+    _busy_time_th.local() += net_time;
+    /* The work done routing the net doesn't depend on the machine or its load, unlike the time taken */
+    _net_costs[net_id] = _router_opts.router_deterministic ? float(results.stats.heap_pops - heap_pops) : net_time;
+
+    if (!flags.success && !flags.retry_with_full_bb) {
+        /* Disconnected RRG and ConnectionRouter doesn't think growing the BB will work */
+        results.is_routable = false;
+        return false;
+    }
+    if (flags.retry_with_full_bb) {
+        /* ConnectionRouter thinks we should grow the BB. Do that and leave this net unrouted for now */
+        route_ctx.route_bb[net_id] = full_device_bb();
+        return true;
+    }
+    if (flags.was_rerouted) {
+        results.rerouted_nets.push_back(net_id);
+    }
+    return true;
+}
+
 template<typename HeapType>
 void ParallelNetlistRouter<HeapType>::set_rcv_enabled(bool x) {
     for (auto& router : _routers_th) {
@@ -141,6 +141,10 @@
 #include "physical_types.h"
 #include "parse_switchblocks.h"
 #include "vtr_expr_eval.h"
+#include "vtr_optional.h"
+
+#include <map>
+#include <tuple>
 
 using vtr::FormulaParser;
 using vtr::t_formula_data;
@@ -186,6 +190,12 @@ struct t_wireconn_scratchpad {
     std::vector<t_wire_switchpoint> potential_src_wires;
     std::vector<t_wire_switchpoint> potential_dest_wires;
     std::vector<t_wire_switchpoint> scratch_wires;
+
+    /* The formulas only depend on the sizes of the wire sets, which are the same at most switch block
+     * locations: their results are kept, by formula (of the current switch block) and set sizes.
+     * Permutation results are indexed by source wire, unset until needed. */
+    std::map<std::tuple<const std::string*, int, int>, int> num_conns_results;
+    std::map<std::tuple<const std::string*, int, int>, std::vector<vtr::optional<int>>> permutation_results;
 };
 
 /************ Typedefs ************/
@@ -238,7 +248,10 @@ static void compute_wireconn_connections(
     vtr::RandState& rand_state,
     t_wireconn_scratchpad* scratchpad);
 
-static int evaluate_num_conns_formula(t_wireconn_scratchpad* scratchpad, std::string num_conns_formula, int from_wire_count, int to_wire_count);
+static int evaluate_num_conns_formula(t_wireconn_scratchpad* scratchpad, const std::string& num_conns_formula, int from_wire_count, int to_wire_count);
+
+/* Returns the raw destination wire index of permutation formula for source wire src_wire_ind */
+static int evaluate_permutation_formula(t_wireconn_scratchpad* scratchpad, const std::string& permutation_formula, int src_W, int dest_W, int src_wire_ind);
 
 /**
  *
@@ -421,6 +434,10 @@ t_sb_connection_map* alloc_and_load_switchblock_permutations(const t_chan_detail
     for (int i_sb = 0; i_sb < (int)switchblocks.size(); i_sb++) {
         t_switchblock_inf sb = switchblocks[i_sb];
 
+        /* formula results are keyed by the formulas of sb */
+        scratchpad.num_conns_results.clear();
+        scratchpad.permutation_results.clear();
+
         /* verify that switchblock type matches specified directionality -- currently we have to stay consistent */
         if (directionality != sb.directionality) {
             VPR_FATAL_ERROR(VPR_ERROR_ARCH, "alloc_and_load_switchblock_connections: Switchblock %s does not match directionality of architecture\n", sb.name.c_str());
@@ -863,11 +880,7 @@ static void compute_wireconn_connections(
         const std::vector<std::string>& permutations_ref = iter->second;
         for (int iperm = 0; iperm < (int)permutations_ref.size(); iperm++) {
             /* Convert the symbolic permutation formula to a number */
-            t_formula_data& formula_data = scratchpad->formula_data;
-            formula_data.clear();
-            formula_data.set_var_value("W", dest_W);
-            formula_data.set_var_value("t", src_wire_ind);
-            int raw_dest_wire_ind = get_sb_formula_raw_result(scratchpad->formula_parser, permutations_ref[iperm].c_str(), formula_data);
+            int raw_dest_wire_ind = evaluate_permutation_formula(scratchpad, permutations_ref[iperm], src_W, dest_W, src_wire_ind);
             int dest_wire_ind = adjust_formula_result(raw_dest_wire_ind, src_W, dest_W, iconn);
 
             if (dest_wire_ind < 0) {
@@ -915,14 +928,39 @@ static void compute_wireconn_connections(
     }
 }
 
-static int evaluate_num_conns_formula(t_wireconn_scratchpad* scratchpad, std::string num_conns_formula, int from_wire_count, int to_wire_count) {
+static int evaluate_num_conns_formula(t_wireconn_scratchpad* scratchpad, const std::string& num_conns_formula, int from_wire_count, int to_wire_count) {
+    auto key = std::make_tuple(&num_conns_formula, from_wire_count, to_wire_count);
+    auto iter = scratchpad->num_conns_results.find(key);
+    if (iter != scratchpad->num_conns_results.end()) {
+        return iter->second;
+    }
+
     t_formula_data& vars = scratchpad->formula_data;
     vars.clear();
 
     vars.set_var_value("from", from_wire_count);
     vars.set_var_value("to", to_wire_count);
 
-    return scratchpad->formula_parser.parse_formula(num_conns_formula, vars);
+    int num_conns = scratchpad->formula_parser.parse_formula(num_conns_formula, vars);
+    scratchpad->num_conns_results.emplace(key, num_conns);
+    return num_conns;
+}
+
+static int evaluate_permutation_formula(t_wireconn_scratchpad* scratchpad, const std::string& permutation_formula, int src_W, int dest_W, int src_wire_ind) {
+    std::vector<vtr::optional<int>>& results = scratchpad->permutation_results[std::make_tuple(&permutation_formula, src_W, dest_W)];
+    if (results.empty()) {
+        results.resize(src_W);
+    }
+
+    vtr::optional<int>& result = results[src_wire_ind];
+    if (!result) {
+        t_formula_data& formula_data = scratchpad->formula_data;
+        formula_data.clear();
+        formula_data.set_var_value("W", dest_W);
+        formula_data.set_var_value("t", src_wire_ind);
+        result = get_sb_formula_raw_result(scratchpad->formula_parser, permutation_formula.c_str(), formula_data);
+    }
+    return *result;
 }
 
 static const t_chan_details& index_into_correct_chan(int tile_x, int tile_y, int tile_layer, enum e_side src_side, enum e_side dest_side, const t_chan_details& chan_details_x, const t_chan_details& chan_details_y, int& chan_x, int& chan_y, int& chan_layer, t_rr_type& chan_type) {
@@ -44,6 +44,10 @@
 
 #include "cb_metrics.h"
 
+#ifdef VPR_USE_TBB
+#    include <tbb/parallel_for.h>
+#endif
+
 /* TODO: move to libarchfpga/include/util.h after ODIN II has been converted to use g++ */
 /* a generic function for determining if a given map key exists */
 template<typename F, typename T>
@@ -73,13 +77,13 @@ bool set_has_element(const T elem, const std::set<T>* my_set) {
 /**** Function Declarations ****/
 /* goes through each pin of pin_type and determines which side of the block it comes out on. results are stored in
  * the 'pin_locations' 2d-vector */
-static void get_pin_locations(const t_physical_tile_type_ptr block_type, const e_pin_type pin_type, const int num_pin_type_pins, int***** tracks_connected_to_pin, t_2d_int_vec* pin_locations);
+static void get_pin_locations(const t_physical_tile_type_ptr block_type, const e_pin_type pin_type, const int num_pin_type_pins, const t_cb_pattern& tracks_connected_to_pin, t_2d_int_vec* pin_locations);
 
 /* Gets the maximum Fc value from the Fc_array of this pin type. Errors out if the pins of this pin_type don't all have the same Fc */
 static int get_max_Fc(const int* Fc_array, const t_physical_tile_type_ptr block_type, const e_pin_type pin_type);
 
 /* initializes the fields of the cb_metrics class */
-static void init_cb_structs(const t_physical_tile_type_ptr block_type, int***** tracks_connected_to_pin, const int num_segments, const t_segment_inf* segment_inf, const e_pin_type pin_type, const int num_pin_type_pins, const int nodes_per_chan, const int Fc, Conn_Block_Metrics* cb_metrics);
+static void init_cb_structs(const t_physical_tile_type_ptr block_type, const t_cb_pattern& tracks_connected_to_pin, const int num_segments, const t_segment_inf* segment_inf, const e_pin_type pin_type, const int num_pin_type_pins, const int nodes_per_chan, const int Fc, Conn_Block_Metrics* cb_metrics);
 
 /* given a set of tracks connected to a pin, we'd like to find which of these tracks are connected to a number of switches
  * greater than 'criteria'. The resulting set of tracks is passed back in the 'result' vector */
@@ -105,24 +109,22 @@ static float get_lemieux_cost_func(const int exponent, const bool both_sides, co
 
 /* this annealer is used to adjust a desired wire or pin metric while keeping the other type of metric
  * relatively constant */
-static bool annealer(const e_metric metric, const int nodes_per_chan, const t_physical_tile_type_ptr block_type, const e_pin_type pin_type, const int Fc, const int num_pin_type_pins, const float target_metric, const float target_metric_tolerance, int***** pin_to_track_connections, Conn_Block_Metrics* cb_metrics);
+static bool annealer(const e_metric metric, const int nodes_per_chan, const t_physical_tile_type_ptr block_type, const e_pin_type pin_type, const int Fc, const int num_pin_type_pins, const float target_metric, const float target_metric_tolerance, t_cb_pattern& pin_to_track_connections, vtr::RandomNumberGenerator& rng, Conn_Block_Metrics* cb_metrics);
 /* updates temperature based on current temperature and the annealer's outer loop iteration */
 static double update_temp(const double temp);
 /* determines whether to accept or reject a proposed move based on the resulting delta of the cost and current temperature */
-static bool accept_move(const double del_cost, const double temp);
+static bool accept_move(const double del_cost, const double temp, vtr::RandomNumberGenerator& rng);
 /* this function simply moves a switch from one track to another track (with an empty slot). The switch stays on the
- * same pin as before. */
-static double try_move(const e_metric metric, const int nodes_per_chan, const float initial_orthogonal_metric, const float orthogonal_metric_tolerance, const t_physical_tile_type_ptr block_type, const e_pin_type pin_type, const int Fc, const int num_pin_type_pins, const double cost, const double temp, const float target_metric, int***** pin_to_track_connections, Conn_Block_Metrics* cb_metrics);
+ * same pin as before. set_of_tracks is scratch space, kept by the caller between calls so that it isn't reallocated */
+static double try_move(const e_metric metric, const int nodes_per_chan, const float initial_orthogonal_metric, const float orthogonal_metric_tolerance, const t_physical_tile_type_ptr block_type, const e_pin_type pin_type, const int Fc, const int num_pin_type_pins, const double cost, const double temp, const float target_metric, t_cb_pattern& pin_to_track_connections, vtr::RandomNumberGenerator& rng, std::vector<int>& set_of_tracks, Conn_Block_Metrics* cb_metrics);
 
 static void print_switch_histogram(const int nodes_per_chan, const Conn_Block_Metrics* cb_metrics);
 
 /**** Function Definitions ****/
 
-/* adjusts the connection block until the appropriate metric has hit its target value. the other orthogonal metric is kept constant
- * within some tolerance */
-void adjust_cb_metric(const e_metric metric, const float target, const float target_tolerance, const t_physical_tile_type_ptr block_type, int***** pin_to_track_connections, const e_pin_type pin_type, const int* Fc_array, const t_chan_width* chan_width_inf, const int num_segments, const t_segment_inf* segment_inf) {
-    Conn_Block_Metrics cb_metrics;
-
+/* adjusts the connection block of a single block/pin type (see adjust_cb_metrics); the adjusted metrics are passed back
+ * through cb_metrics. returns whether the target was reached */
+static bool adjust_one_cb_metric(const e_metric metric, const float target, const float target_tolerance, const t_physical_tile_type_ptr block_type, t_cb_pattern& pin_to_track_connections, const e_pin_type pin_type, const int* Fc_array, const t_chan_width* chan_width_inf, const int num_segments, const t_segment_inf* segment_inf, vtr::RandomNumberGenerator& rng, Conn_Block_Metrics* cb_metrics) {
     /* various error checks */
     if (metric >= NUM_METRICS) {
         VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Invalid CB metric type specified: %d\n", (int)metric);
@@ -155,20 +157,54 @@ void adjust_cb_metric(const e_metric metric, const float target, const float tar
 
     /* get initial values for metrics */
     get_conn_block_metrics(block_type, pin_to_track_connections, num_segments, segment_inf, pin_type,
-                           Fc_array, chan_width_inf, &cb_metrics);
+                           Fc_array, chan_width_inf, cb_metrics);
 
     /* now run the annealer to adjust the desired metric towards the target value */
-    bool success = annealer(metric, nodes_per_chan, block_type, pin_type, Fc, num_pin_type_pins, target,
-                            target_tolerance, pin_to_track_connections, &cb_metrics);
-    if (!success) {
-        VTR_LOG("Failed to adjust specified connection block metric\n");
+    return annealer(metric, nodes_per_chan, block_type, pin_type, Fc, num_pin_type_pins, target,
+                    target_tolerance, pin_to_track_connections, rng, cb_metrics);
+}
+
+/* adjusts the connection block until the appropriate metric has hit its target value. the other orthogonal metric is kept constant
+ * within some tolerance */
+void adjust_cb_metric(const e_metric metric, const float target, const float target_tolerance, const t_physical_tile_type_ptr block_type, t_cb_pattern& pin_to_track_connections, const e_pin_type pin_type, const int* Fc_array, const t_chan_width* chan_width_inf, const int num_segments, const t_segment_inf* segment_inf) {
+    std::vector<t_cb_metric_adjustment> adjustments = {{block_type, pin_type, Fc_array, &pin_to_track_connections}};
+    adjust_cb_metrics(metric, target, target_tolerance, adjustments, chan_width_inf, num_segments, segment_inf);
+}
+
+/* adjusts the connection blocks of several block/pin types. they are independent, so they are annealed in parallel */
+void adjust_cb_metrics(const e_metric metric, const float target, const float target_tolerance, const std::vector<t_cb_metric_adjustment>& adjustments, const t_chan_width* chan_width_inf, const int num_segments, const t_segment_inf* segment_inf) {
+    /* each annealer draws from its own random number stream, so the adjusted connection blocks don't depend on
+     * how the annealers are scheduled */
+    uint64_t seed = vtr::get_random_state();
+
+    std::vector<Conn_Block_Metrics> cb_metrics(adjustments.size());
+    std::vector<char> success(adjustments.size(), false);
+    auto adjust = [&](size_t i) {
+        const t_cb_metric_adjustment& adjustment = adjustments[i];
+        vtr::RandomNumberGenerator rng = vtr::RandomNumberGenerator::worker_stream(seed, i);
+        success[i] = adjust_one_cb_metric(metric, target, target_tolerance, adjustment.block_type, *adjustment.pin_to_track_connections,
+                                          adjustment.pin_type, adjustment.Fc_array, chan_width_inf, num_segments, segment_inf, rng, &cb_metrics[i]);
+    };
+#ifdef VPR_USE_TBB
+    tbb::parallel_for(size_t(0), adjustments.size(), adjust);
+#else
+    for (size_t i = 0; i < adjustments.size(); i++) {
+        adjust(i);
     }
+#endif
+
+    /* report the results in order */
+    for (size_t i = 0; i < adjustments.size(); i++) {
+        if (!success[i]) {
+            VTR_LOG("Failed to adjust specified connection block metric\n");
+        }
 
-    print_switch_histogram(nodes_per_chan, &cb_metrics);
+        print_switch_histogram(chan_width_inf->x_min, &cb_metrics[i]);
+    }
 }
 
 /* calculates all the connection block metrics and returns them through the cb_metrics variable */
-void get_conn_block_metrics(const t_physical_tile_type_ptr block_type, int***** tracks_connected_to_pin, const int num_segments, const t_segment_inf* segment_inf, const e_pin_type pin_type, const int* Fc_array, const t_chan_width* chan_width_inf, Conn_Block_Metrics* cb_metrics) {
+void get_conn_block_metrics(const t_physical_tile_type_ptr block_type, const t_cb_pattern& tracks_connected_to_pin, const int num_segments, const t_segment_inf* segment_inf, const e_pin_type pin_type, const int* Fc_array, const t_chan_width* chan_width_inf, Conn_Block_Metrics* cb_metrics) {
     if (chan_width_inf->x_min != chan_width_inf->x_max || chan_width_inf->y_min != chan_width_inf->y_max
         || chan_width_inf->x_max != chan_width_inf->y_max) {
         VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Currently this code assumes that channel width is uniform throughout the fpga");
@@ -224,7 +260,7 @@ void get_conn_block_metrics(const t_physical_tile_type_ptr block_type, int*****
 }
 
 /* initializes the fields of the cb_metrics class */
-static void init_cb_structs(const t_physical_tile_type_ptr block_type, int***** tracks_connected_to_pin, const int num_segments, const t_segment_inf* segment_inf, const e_pin_type pin_type, const int num_pin_type_pins, const int nodes_per_chan, const int Fc, Conn_Block_Metrics* cb_metrics) {
+static void init_cb_structs(const t_physical_tile_type_ptr block_type, const t_cb_pattern& tracks_connected_to_pin, const int num_segments, const t_segment_inf* segment_inf, const e_pin_type pin_type, const int num_pin_type_pins, const int nodes_per_chan, const int Fc, Conn_Block_Metrics* cb_metrics) {
     /* can not calculate CB metrics for open pins */
     if (OPEN == pin_type) {
         VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Can not initialize CB metric structures for pins of OPEN type\n");
@@ -576,7 +612,7 @@ static float get_wire_homogeneity(const int Fc, const int nodes_per_chan, const
 
 /* goes through each pin of pin_type and determines which side of the block it comes out on. results are stored in
  * the 'pin_locations' 2d-vector */
-static void get_pin_locations(const t_physical_tile_type_ptr block_type, const e_pin_type pin_type, const int num_pin_type_pins, int***** tracks_connected_to_pin, t_2d_int_vec* pin_locations) {
+static void get_pin_locations(const t_physical_tile_type_ptr block_type, const e_pin_type pin_type, const int num_pin_type_pins, const t_cb_pattern& tracks_connected_to_pin, t_2d_int_vec* pin_locations) {
     std::set<int> counted_pins;
 
     pin_locations->clear();
@@ -658,7 +694,7 @@ static void find_tracks_unconnected_to_pin(const std::set<int>* pin_tracks, cons
 
 /* this function simply moves a switch from one track to another track (with an empty slot). The switch stays on the
  * same pin as before. */
-static double try_move(const e_metric metric, const int nodes_per_chan, const float initial_orthogonal_metric, const float orthogonal_metric_tolerance, const t_physical_tile_type_ptr block_type, const e_pin_type pin_type, const int Fc, const int num_pin_type_pins, const double cost, const double temp, const float target_metric, int***** pin_to_track_connections, Conn_Block_Metrics* cb_metrics) {
+static double try_move(const e_metric metric, const int nodes_per_chan, const float initial_orthogonal_metric, const float orthogonal_metric_tolerance, const t_physical_tile_type_ptr block_type, const e_pin_type pin_type, const int Fc, const int num_pin_type_pins, const double cost, const double temp, const float target_metric, t_cb_pattern& pin_to_track_connections, vtr::RandomNumberGenerator& rng, std::vector<int>& set_of_tracks, Conn_Block_Metrics* cb_metrics) {
     double new_cost = 0;
     float new_orthogonal_metric = 0;
     float new_metric = 0;
@@ -687,15 +723,12 @@ static double try_move(const e_metric metric, const int nodes_per_chan, const fl
         both_sides = false;
     }
 
-    static std::vector<int> set_of_tracks;
-    /* the set_of_tracks vector is used to find sets of tracks satisfying some criteria that we want. we reserve memory for it, which
-     * should be preserved between calls of this function so that we don't have to allocate memory every time */
-    set_of_tracks.reserve(nodes_per_chan);
+    /* the set_of_tracks vector is used to find sets of tracks satisfying some criteria that we want */
     set_of_tracks.clear();
 
     /* choose a random side, random pin, and a random switch */
-    int rand_side = vtr::irand(3);
-    int rand_pin_index = vtr::irand(cb_metrics->pin_locations.at(rand_side).size() - 1);
+    int rand_side = rng.irand(3);
+    int rand_pin_index = rng.irand(cb_metrics->pin_locations.at(rand_side).size() - 1);
     int rand_pin = cb_metrics->pin_locations.at(rand_side).at(rand_pin_index);
     std::set<int>* tracks_connected_to_pin = &pin_to_tracks->at(rand_side).at(rand_pin_index);
 
@@ -724,12 +757,12 @@ static double try_move(const e_metric metric, const int nodes_per_chan, const fl
             new_cost = cost;
         } else {
             /* now choose a random track from the returned set of qualifying tracks */
-            int old_track = vtr::irand(set_of_tracks.size() - 1);
+            int old_track = rng.irand(set_of_tracks.size() - 1);
             old_track = set_of_tracks.at(old_track);
 
             /* next, get a new track connection i.e. one that is not already connected to our randomly chosen pin */
             find_tracks_unconnected_to_pin(tracks_connected_to_pin, &track_to_pins->at(rand_side), &set_of_tracks);
-            int new_track = vtr::irand(set_of_tracks.size() - 1);
+            int new_track = rng.irand(set_of_tracks.size() - 1);
             new_track = set_of_tracks.at(new_track);
 
             /* move the rand_pin's connection from the old track to the new track and see what the new cost is */
@@ -781,7 +814,7 @@ static double try_move(const e_metric metric, const int nodes_per_chan, const fl
                 }
                 new_cost = fabs(target_metric - new_metric);
                 delta_cost = new_cost - cost;
-                if (!accept_move(delta_cost, temp)) {
+                if (!accept_move(delta_cost, temp, rng)) {
                     revert = true;
                 }
             } else {
@@ -843,7 +876,7 @@ static double try_move(const e_metric metric, const int nodes_per_chan, const fl
 
 /* this annealer is used to adjust a desired wire or pin metric while keeping the other type of metric
  * relatively constant */
-static bool annealer(const e_metric metric, const int nodes_per_chan, const t_physical_tile_type_ptr block_type, const e_pin_type pin_type, const int Fc, const int num_pin_type_pins, const float target_metric, const float target_metric_tolerance, int***** pin_to_track_connections, Conn_Block_Metrics* cb_metrics) {
+static bool annealer(const e_metric metric, const int nodes_per_chan, const t_physical_tile_type_ptr block_type, const e_pin_type pin_type, const int Fc, const int num_pin_type_pins, const float target_metric, const float target_metric_tolerance, t_cb_pattern& pin_to_track_connections, vtr::RandomNumberGenerator& rng, Conn_Block_Metrics* cb_metrics) {
     bool success = false;
     double temp = INITIAL_TEMP;
 
@@ -885,12 +918,16 @@ static bool annealer(const e_metric metric, const int nodes_per_chan, const t_ph
         }
     }
 
+    /* scratch space for try_move, preserved between its calls so that we don't have to allocate memory every time */
+    std::vector<int> set_of_tracks;
+    set_of_tracks.reserve(nodes_per_chan);
+
     /* the main annealer loop */
     for (int i_outer = 0; i_outer < MAX_OUTER_ITERATIONS; i_outer++) {
         for (int i_inner = 0; i_inner < MAX_INNER_ITERATIONS; i_inner++) {
             double new_cost = 0;
             new_cost = try_move(metric, nodes_per_chan, initial_orthogonal_metric, orthogonal_metric_tolerance,
-                                block_type, pin_type, Fc, num_pin_type_pins, cost, temp, target_metric, pin_to_track_connections, cb_metrics);
+                                block_type, pin_type, Fc, num_pin_type_pins, cost, temp, target_metric, pin_to_track_connections, rng, set_of_tracks, cb_metrics);
 
             /* update the cost after trying the move */
             if (new_cost != cost) {
@@ -937,7 +974,7 @@ static double update_temp(const double temp) {
 }
 
 /* determines whether to accept or reject a proposed move based on the resulting delta of the cost and current temperature */
-static bool accept_move(const double del_cost, const double temp) {
+static bool accept_move(const double del_cost, const double temp, vtr::RandomNumberGenerator& rng) {
     bool accept = false;
 
     if (del_cost < 0) {
@@ -946,7 +983,7 @@ static bool accept_move(const double del_cost, const double temp) {
     } else {
         /* determine probabilistically whether or not to accept */
         double probability = pow(2.718, -(del_cost / temp));
-        double rand_value = (double)vtr::frand();
+        double rand_value = (double)rng.frand();
         if (rand_value < probability) {
             accept = true;
         } else {
@@ -986,7 +1023,7 @@ static void print_switch_histogram(const int nodes_per_chan, const Conn_Block_Me
 /* constructs a crossbar matrix from the connection block 'conn_block'. rows correspond to the pins,
  * columns correspond to the wires. entry (i,j) is set to 1 if that pin and track are connected. the
  * only pins accounted for here are the pins that actually have switches on the conn block side in question */
-static void get_xbar_matrix(const int***** conn_block, const t_physical_tile_type_ptr block_type, e_pin_type pin_type, const int side, const bool both_sides, const int nodes_per_chan, const int Fc, t_xbar_matrix* xbar_matrix) {
+static void get_xbar_matrix(const t_cb_pattern& conn_block, const t_physical_tile_type_ptr block_type, e_pin_type pin_type, const int side, const bool both_sides, const int nodes_per_chan, const int Fc, t_xbar_matrix* xbar_matrix) {
     xbar_matrix->clear();
     if (both_sides && side >= 2) {
         VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "If analyzing both sides of a conn block, the initial side should have index < 2");
@@ -1316,7 +1353,7 @@ static t_xbar_matrix combine_two_xbars(const t_xbar_matrix* xbar1, const t_xbar_
     return xbar_out;
 }
 
-void analyze_conn_blocks(const int***** opin_cb, const int***** ipin_cb, const t_physical_tile_type_ptr block_type, const int* Fc_array_out, const int* Fc_array_in, const t_chan_width* chan_width_inf) {
+void analyze_conn_blocks(const t_cb_pattern& opin_cb, const t_cb_pattern& ipin_cb, const t_physical_tile_type_ptr block_type, const int* Fc_array_out, const int* Fc_array_in, const t_chan_width* chan_width_inf) {
     if (0 != strcmp(block_type->name, "clb")) {
         VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "This code currently works for CLB blocks only");
     }
@@ -1366,7 +1403,7 @@ void analyze_conn_blocks(const int***** opin_cb, const int***** ipin_cb, const t
 }
 
 /* make a poor cb pattern. */
-void make_poor_cb_pattern(const e_pin_type pin_type, const t_physical_tile_type_ptr block_type, const int* Fc_array, const t_chan_width* chan_width_inf, int***** cb) {
+void make_poor_cb_pattern(const e_pin_type pin_type, const t_physical_tile_type_ptr block_type, const int* Fc_array, const t_chan_width* chan_width_inf, t_cb_pattern& cb) {
     if (block_type->num_pins == 0) {
         VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Trying to adjust CB metrics for a block with no pins!\n");
     }
@@ -4,6 +4,8 @@
 #include <vector>
 #include <set>
 
+#include "vtr_ndmatrix.h"
+
 #define MAX_OUTER_ITERATIONS 100000
 #define MAX_INNER_ITERATIONS 10
 #define INITIAL_TEMP 1
@@ -28,6 +30,9 @@ typedef std::vector<std::vector<int> > t_2d_int_vec;
 typedef std::vector<std::vector<std::vector<int> > > t_3d_int_vec;
 /* a vector of vectors of integer sets. used for pin-to-track and track-to-pin lookups */
 typedef std::vector<std::vector<std::set<int> > > t_vec_vec_set;
+/* a connection block: the tracks each pin connects to. [0..num_pins-1][0..width-1][0..height-1][0..3][0..Fc-1],
+ * the first entry of a pin side being -1 if the pin doesn't connect to tracks there */
+typedef vtr::NdMatrix<int, 5> t_cb_pattern;
 
 /**** Classes ****/
 /* Contains various useful structures to calculate connection block metrics, and is used to
@@ -58,6 +63,14 @@ class Conn_Block_Metrics {
     }
 };
 
+/* a connection block to adjust, for the pins of pin_type of block_type */
+struct t_cb_metric_adjustment {
+    t_physical_tile_type_ptr block_type;
+    e_pin_type pin_type;
+    const int* Fc_array;
+    t_cb_pattern* pin_to_track_connections;
+};
+
 /**** Function Declarations ****/
 
 /* wires may be grouped in a channel according to their start points. i.e. at a given channel segment with L=4, there are up to
@@ -68,10 +81,13 @@ class Conn_Block_Metrics {
 int get_num_wire_types(const int num_segments, const t_segment_inf* segment_inf);
 
 /* calculates all the connection block metrics and returns them through the cb_metrics variable */
-void get_conn_block_metrics(const t_physical_tile_type_ptr block_type, int***** tracks_connected_to_pin, const int num_segments, const t_segment_inf* segment_inf, const e_pin_type pin_type, const int* Fc_array, const t_chan_width* chan_width_inf, Conn_Block_Metrics* cb_metrics);
+void get_conn_block_metrics(const t_physical_tile_type_ptr block_type, const t_cb_pattern& tracks_connected_to_pin, const int num_segments, const t_segment_inf* segment_inf, const e_pin_type pin_type, const int* Fc_array, const t_chan_width* chan_width_inf, Conn_Block_Metrics* cb_metrics);
 /* adjusts the connection block until the appropriate wire metric has hit it's target value. the pin metric is kept constant
  * within some tolerance */
-void adjust_cb_metric(const e_metric metric, const float target, const float target_tolerance, const t_physical_tile_type_ptr block_type, int***** pin_to_track_connections, const e_pin_type pin_type, const int* Fc_array, const t_chan_width* chan_width_inf, const int num_segments, const t_segment_inf* segment_inf);
+void adjust_cb_metric(const e_metric metric, const float target, const float target_tolerance, const t_physical_tile_type_ptr block_type, t_cb_pattern& pin_to_track_connections, const e_pin_type pin_type, const int* Fc_array, const t_chan_width* chan_width_inf, const int num_segments, const t_segment_inf* segment_inf);
+/* adjusts the connection blocks of several block/pin types as adjust_cb_metric does. the connection blocks are independent,
+ * so they are adjusted in parallel (each with its own random number stream, so the results don't depend on the scheduling) */
+void adjust_cb_metrics(const e_metric metric, const float target, const float target_tolerance, const std::vector<t_cb_metric_adjustment>& adjustments, const t_chan_width* chan_width_inf, const int num_segments, const t_segment_inf* segment_inf);
 
 /**** EXPERIMENTAL ****/
 #include <map>
@@ -93,10 +109,10 @@ class Wire_Counting {
 typedef std::vector<std::vector<float> > t_xbar_matrix;
 
 /* perform a probabilistic analysis on the compound crossbar formed by the input and output connection blocks */
-void analyze_conn_blocks(const int***** opin_cb, const int***** ipin_cb, const t_physical_tile_type_ptr block_type, const int* Fc_array_out, const int* Fc_array_in, const t_chan_width* chan_width_inf);
+void analyze_conn_blocks(const t_cb_pattern& opin_cb, const t_cb_pattern& ipin_cb, const t_physical_tile_type_ptr block_type, const int* Fc_array_out, const int* Fc_array_in, const t_chan_width* chan_width_inf);
 
 /* make a poor cb pattern. */
-void make_poor_cb_pattern(const e_pin_type pin_type, const t_physical_tile_type_ptr block_type, const int* Fc_array, const t_chan_width* chan_width_inf, int***** cb);
+void make_poor_cb_pattern(const e_pin_type pin_type, const t_physical_tile_type_ptr block_type, const int* Fc_array, const t_chan_width* chan_width_inf, t_cb_pattern& cb);
 
 /**** END EXPERIMENTAL ****/
 
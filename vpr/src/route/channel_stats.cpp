@@ -20,11 +20,17 @@ void print_channel_stats(bool is_flat) {
     histogram.emplace_back(0.9, 1.0);
     histogram.emplace_back(1.0, std::numeric_limits<float>::infinity());
 
-    auto chanx_usage = calculate_routing_usage(CHANX, is_flat, true);
-    auto chany_usage = calculate_routing_usage(CHANY, is_flat, true);
+    //The occupancy of the rr_nodes is the usage of the route trees, of whichever netlist was routed
+    (void)is_flat;
 
-    auto chanx_avail = calculate_routing_avail(CHANX);
-    auto chany_avail = calculate_routing_avail(CHANY);
+    RoutingCongestionMap congestion_map(device_ctx.rr_graph, device_ctx.grid);
+    congestion_map.update(g_vpr_ctx.routing().rr_node_cong_inf);
+
+    const auto& chanx_usage = congestion_map.usage(CHANX);
+    const auto& chany_usage = congestion_map.usage(CHANY);
+
+    const auto& chanx_avail = congestion_map.avail(CHANX);
+    const auto& chany_avail = congestion_map.avail(CHANY);
 
     auto comp = [](const HistogramBucket& bucket, float value) {
         return bucket.max_value < value;
@@ -36,7 +42,7 @@ void print_channel_stats(bool is_flat) {
     for (size_t x = 0; x < device_ctx.grid.width() - 1; ++x) {
         for (size_t y = 0; y < device_ctx.grid.height() - 1; ++y) {
             float chanx_util = routing_util(chanx_usage[x][y], chanx_avail[x][y]);
-            float chany_util = routing_util(chanx_usage[x][y], chanx_avail[x][y]);
+            float chany_util = routing_util(chany_usage[x][y], chany_avail[x][y]);
 
             for (float util : {chanx_util, chany_util}) {
                 //Record peak utilization
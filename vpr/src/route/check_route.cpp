@@ -16,6 +16,12 @@
 #include "check_rr_graph.h"
 #include "read_xml_arch_file.h"
 #include "route_tree.h"
+#include "vtr_hash.h"
+
+#ifdef VPR_USE_TBB
+#    include <tbb/enumerable_thread_specific.h>
+#    include <tbb/parallel_for_each.h>
+#endif
 
 /******************** Subroutines local to this module **********************/
 static void check_node_and_range(RRNodeId inode,
@@ -39,7 +45,18 @@ static void check_locally_used_clb_opins(const t_clb_opins_used& clb_opins_used_
                                          enum e_route_type route_type,
                                          bool is_flat);
 
-static void check_all_non_configurable_edges(const Netlist<>& net_list, bool is_flat);
+static void check_net_route(const Netlist<>& net_list,
+                            ParentNetId net_id,
+                            enum e_route_type route_type,
+                            bool* pin_done,
+                            bool is_flat);
+static size_t route_tree_fingerprint(const Netlist<>& net_list,
+                                     ParentNetId net_id,
+                                     bool is_flat);
+
+static void check_all_non_configurable_edges(const Netlist<>& net_list,
+                                             const vtr::vector<ParentNetId, uint8_t>& nets_to_check,
+                                             bool is_flat);
 static bool check_non_configurable_edges(const Netlist<>& net_list,
                                          ParentNetId net,
                                          const t_non_configurable_rr_sets& non_configurable_rr_sets,
@@ -66,15 +83,10 @@ void check_route(const Netlist<>& net_list,
     }
 
     int max_pins;
-    unsigned int ipin;
-    bool valid, connects;
+    bool valid;
 
-    auto& device_ctx = g_vpr_ctx.device();
-    const auto& rr_graph = device_ctx.rr_graph;
     auto& route_ctx = g_vpr_ctx.routing();
 
-    const size_t num_switches = rr_graph.num_rr_switches();
-
     VTR_LOG("\n");
     VTR_LOG("Checking to ensure routing is legal...\n");
 
@@ -99,79 +111,161 @@ void check_route(const Netlist<>& net_list,
     for (auto net_id : net_list.nets())
         max_pins = std::max(max_pins, (int)net_list.net_pins(net_id).size());
 
-    auto pin_done = std::make_unique<bool[]>(max_pins);
+    /* In incremental mode, only the nets whose routing changed since it was last *
+     * verified are checked.                                                      */
+    auto& verified_fingerprints = g_vpr_ctx.mutable_routing().verified_route_tree_fingerprints;
+    if (verified_fingerprints.size() != net_list.nets().size()) {
+        verified_fingerprints.clear();
+        verified_fingerprints.resize(net_list.nets().size(), 0);
+    }
+    vtr::vector<ParentNetId, size_t> fingerprints(net_list.nets().size(), 0);
+    vtr::vector<ParentNetId, uint8_t> nets_to_check(net_list.nets().size(), false);
 
     /* Now check that all nets are indeed connected. */
-    for (auto net_id : net_list.nets()) {
+    auto check_net = [&](ParentNetId net_id, bool* pin_done) {
+        if (route_ctx.route_trees[net_id]) {
+            fingerprints[net_id] = route_tree_fingerprint(net_list, net_id, is_flat);
+            if (check_route_option == e_check_route_option::INCREMENTAL && fingerprints[net_id] == verified_fingerprints[net_id]) {
+                return; /* Unchanged since verified */
+            }
+        }
+        nets_to_check[net_id] = true;
+
         if (net_list.net_is_ignored(net_id) || net_list.net_sinks(net_id).size() == 0) /* Skip ignored nets. */
-            continue;
+            return;
+
+        check_net_route(net_list, net_id, route_type, pin_done, is_flat);
+    };
+
+#ifdef VPR_USE_TBB
+    tbb::enumerable_thread_specific<std::unique_ptr<bool[]>> thread_pin_done([max_pins] {
+        return std::make_unique<bool[]>(max_pins);
+    });
+    tbb::parallel_for_each(net_list.nets().begin(), net_list.nets().end(), [&](ParentNetId net_id) {
+        check_net(net_id, thread_pin_done.local().get());
+    });
+#else
+    auto pin_done = std::make_unique<bool[]>(max_pins);
+    for (auto net_id : net_list.nets()) {
+        check_net(net_id, pin_done.get());
+    }
+#endif
+
+    if (check_route_option == e_check_route_option::INCREMENTAL) {
+        size_t num_checked_nets = std::count(nets_to_check.begin(), nets_to_check.end(), true);
+        VTR_LOG("Checked the routing of %zu of %zu nets (the others are unchanged since last checked)\n",
+                num_checked_nets, net_list.nets().size());
+    }
 
-        std::fill_n(pin_done.get(), net_list.net_pins(net_id).size(), false);
+    if (check_route_option == e_check_route_option::FULL || check_route_option == e_check_route_option::INCREMENTAL) {
+        check_all_non_configurable_edges(net_list, nets_to_check, is_flat);
 
-        if (!route_ctx.route_trees[net_id]) {
-            VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
-                            "in check_route: net %d has no routing.\n", size_t(net_id));
+        /* Everything about these nets was verified, so later incremental checks can skip them */
+        for (auto net_id : net_list.nets()) {
+            if (nets_to_check[net_id]) {
+                verified_fingerprints[net_id] = fingerprints[net_id];
+            }
         }
+    } else {
+        VTR_ASSERT(check_route_option == e_check_route_option::QUICK);
+    }
 
-        /* Check the SOURCE of the net. */
-        RRNodeId source_inode = route_ctx.route_trees[net_id].value().root().inode;
-        check_node_and_range(source_inode, route_type, is_flat);
-        check_source(net_list, source_inode, net_id, is_flat);
+    VTR_LOG("Completed routing consistency check successfully.\n");
+    VTR_LOG("\n");
+}
 
-        pin_done[0] = true;
+/* Checks that the routing of net_id is a properly connected path from its SOURCE *
+ * to each of its SINKs, without stubs.                                          */
+static void check_net_route(const Netlist<>& net_list,
+                            ParentNetId net_id,
+                            enum e_route_type route_type,
+                            bool* pin_done,
+                            bool is_flat) {
+    auto& device_ctx = g_vpr_ctx.device();
+    const auto& rr_graph = device_ctx.rr_graph;
+    auto& route_ctx = g_vpr_ctx.routing();
 
-        /* Check the rest of the net */
-        size_t num_sinks = 0;
-        for (auto& rt_node : route_ctx.route_trees[net_id].value().all_nodes()) {
-            RRNodeId inode = rt_node.inode;
-            int net_pin_index = rt_node.net_pin_index;
-            check_node_and_range(inode, route_type, is_flat);
-            check_switch(rt_node, num_switches);
-
-            if (rt_node.parent()) {
-                connects = check_adjacent(rt_node.parent()->inode, rt_node.inode, is_flat);
-                if (!connects) {
-                    VPR_ERROR(VPR_ERROR_ROUTE,
-                              "in check_route: found non-adjacent segments in traceback while checking net %d:\n"
-                              "  %s\n"
-                              "  %s\n",
-                              size_t(net_id),
-                              describe_rr_node(rr_graph, device_ctx.grid, device_ctx.rr_indexed_data, rt_node.parent()->inode, is_flat).c_str(),
-                              describe_rr_node(rr_graph, device_ctx.grid, device_ctx.rr_indexed_data, inode, is_flat).c_str());
-                }
-            }
+    const size_t num_switches = rr_graph.num_rr_switches();
 
-            if (rr_graph.node_type(inode) == SINK) {
-                check_sink(net_list, inode, net_pin_index, net_id, pin_done.get());
-                num_sinks += 1;
+    std::fill_n(pin_done, net_list.net_pins(net_id).size(), false);
+
+    if (!route_ctx.route_trees[net_id]) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                        "in check_route: net %d has no routing.\n", size_t(net_id));
+    }
+
+    /* Check the SOURCE of the net. */
+    RRNodeId source_inode = route_ctx.route_trees[net_id].value().root().inode;
+    check_node_and_range(source_inode, route_type, is_flat);
+    check_source(net_list, source_inode, net_id, is_flat);
+
+    pin_done[0] = true;
+
+    /* Check the rest of the net */
+    size_t num_sinks = 0;
+    for (auto& rt_node : route_ctx.route_trees[net_id].value().all_nodes()) {
+        RRNodeId inode = rt_node.inode;
+        int net_pin_index = rt_node.net_pin_index;
+        check_node_and_range(inode, route_type, is_flat);
+        check_switch(rt_node, num_switches);
+
+        if (rt_node.parent()) {
+            bool connects = check_adjacent(rt_node.parent()->inode, rt_node.inode, is_flat);
+            if (!connects) {
+                VPR_ERROR(VPR_ERROR_ROUTE,
+                          "in check_route: found non-adjacent segments in traceback while checking net %d:\n"
+                          "  %s\n"
+                          "  %s\n",
+                          size_t(net_id),
+                          describe_rr_node(rr_graph, device_ctx.grid, device_ctx.rr_indexed_data, rt_node.parent()->inode, is_flat).c_str(),
+                          describe_rr_node(rr_graph, device_ctx.grid, device_ctx.rr_indexed_data, inode, is_flat).c_str());
             }
         }
 
-        if (num_sinks != net_list.net_sinks(net_id).size()) {
-            VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
-                            "in check_route: net %zu (%s) has %zu SINKs (expected %zu).\n",
-                            size_t(net_id), net_list.net_name(net_id).c_str(),
-                            num_sinks, net_list.net_sinks(net_id).size());
+        if (rr_graph.node_type(inode) == SINK) {
+            check_sink(net_list, inode, net_pin_index, net_id, pin_done);
+            num_sinks += 1;
         }
+    }
 
-        for (ipin = 0; ipin < net_list.net_pins(net_id).size(); ipin++) {
-            if (pin_done[ipin] == false) {
-                VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
-                                "in check_route: net %zu does not connect to pin %d.\n", size_t(net_id), ipin);
-            }
+    if (num_sinks != net_list.net_sinks(net_id).size()) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                        "in check_route: net %zu (%s) has %zu SINKs (expected %zu).\n",
+                        size_t(net_id), net_list.net_name(net_id).c_str(),
+                        num_sinks, net_list.net_sinks(net_id).size());
+    }
+
+    for (unsigned int ipin = 0; ipin < net_list.net_pins(net_id).size(); ipin++) {
+        if (pin_done[ipin] == false) {
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                            "in check_route: net %zu does not connect to pin %d.\n", size_t(net_id), ipin);
         }
+    }
 
-        check_net_for_stubs(net_list, net_id, is_flat);
-    } /* End for each net */
+    check_net_for_stubs(net_list, net_id, is_flat);
+}
 
-    if (check_route_option == e_check_route_option::FULL) {
-        check_all_non_configurable_edges(net_list, is_flat);
-    } else {
-        VTR_ASSERT(check_route_option == e_check_route_option::QUICK);
+/* Returns a hash of the routing of net_id (and of the location of its driver, *
+ * against which its SOURCE is checked), never 0.                             */
+static size_t route_tree_fingerprint(const Netlist<>& net_list,
+                                     ParentNetId net_id,
+                                     bool is_flat) {
+    auto& route_ctx = g_vpr_ctx.routing();
+
+    size_t fingerprint = is_flat;
+    t_pl_loc driver_loc = get_block_loc(net_list.net_driver_block(net_id), is_flat).loc;
+    vtr::hash_combine(fingerprint, driver_loc.x);
+    vtr::hash_combine(fingerprint, driver_loc.y);
+    vtr::hash_combine(fingerprint, driver_loc.layer);
+
+    for (auto& rt_node : route_ctx.route_trees[net_id].value().all_nodes()) {
+        vtr::hash_combine(fingerprint, rt_node.inode);
+        vtr::hash_combine(fingerprint, rt_node.parent() ? rt_node.parent()->inode : RRNodeId::INVALID());
+        vtr::hash_combine(fingerprint, rt_node.parent_switch);
+        vtr::hash_combine(fingerprint, rt_node.net_pin_index);
     }
 
-    VTR_LOG("Completed routing consistency check successfully.\n");
-    VTR_LOG("\n");
+    return (fingerprint != 0) ? fingerprint : 1;
 }
 
 /* Checks that this SINK node is one of the terminals of inet, and marks   *
@@ -492,22 +586,31 @@ void recompute_occupancy_from_scratch(const Netlist<>& net_list, bool is_flat) {
 
     /* First set the occupancy of everything to zero. */
     for (RRNodeId inode : device_ctx.rr_graph.nodes())
-        route_ctx.rr_node_route_inf[inode].set_occ(0);
+        route_ctx.rr_node_cong_inf[inode].set_occ(0);
 
     /* Now go through each net and count the tracks and pins used everywhere */
 
-    for (auto net_id : net_list.nets()) {
+    auto count_net_occupancy = [&](ParentNetId net_id) {
         if (!route_ctx.route_trees[net_id])
-            continue;
+            return;
 
         if (net_list.net_is_ignored(net_id)) /* Skip ignored nets. */
-            continue;
+            return;
 
+        /* The occupancy is atomic, so that nets can be counted concurrently (a node *
+         * is rarely shared by several nets, so this is hardly ever contended).      */
         for (auto& rt_node : route_ctx.route_trees[net_id].value().all_nodes()) {
-            RRNodeId inode = rt_node.inode;
-            route_ctx.rr_node_route_inf[inode].set_occ(route_ctx.rr_node_route_inf[inode].occ() + 1);
+            route_ctx.rr_node_cong_inf[rt_node.inode].add_occ(1);
         }
+    };
+
+#ifdef VPR_USE_TBB
+    tbb::parallel_for_each(net_list.nets().begin(), net_list.nets().end(), count_net_occupancy);
+#else
+    for (auto net_id : net_list.nets()) {
+        count_net_occupancy(net_id);
     }
+#endif
 
     /* We only need to reserve output pins if flat routing is not enabled */
     if (!is_flat) {
@@ -523,7 +626,7 @@ void recompute_occupancy_from_scratch(const Netlist<>& net_list, bool is_flat) {
                 for (int ipin = 0; ipin < num_local_opins; ipin++) {
                     RRNodeId inode = route_ctx.clb_opins_used_locally[cluster_blk_id][iclass][ipin];
                     VTR_ASSERT(inode && size_t(inode) < device_ctx.rr_graph.num_nodes());
-                    route_ctx.rr_node_route_inf[inode].set_occ(route_ctx.rr_node_route_inf[inode].occ() + 1);
+                    route_ctx.rr_node_cong_inf[inode].set_occ(route_ctx.rr_node_cong_inf[inode].occ() + 1);
                 }
             }
         }
@@ -595,18 +698,34 @@ static void check_node_and_range(RRNodeId inode,
                   is_flat);
 }
 
-//Checks that all non-configurable edges are in a legal configuration
+//Checks that all non-configurable edges are in a legal configuration (for the nets in nets_to_check)
 //This check is slow, so it has been moved out of check_route()
-static void check_all_non_configurable_edges(const Netlist<>& net_list, bool is_flat) {
+static void check_all_non_configurable_edges(const Netlist<>& net_list,
+                                             const vtr::vector<ParentNetId, uint8_t>& nets_to_check,
+                                             bool is_flat) {
+    if (std::find(nets_to_check.begin(), nets_to_check.end(), true) == nets_to_check.end()) {
+        return;
+    }
+
     vtr::ScopedStartFinishTimer timer("Checking to ensure non-configurable edges are legal");
     auto non_configurable_rr_sets = identify_non_configurable_rr_sets();
 
+    auto check_net = [&](ParentNetId net_id) {
+        if (nets_to_check[net_id]) {
+            check_non_configurable_edges(net_list,
+                                         net_id,
+                                         non_configurable_rr_sets,
+                                         is_flat);
+        }
+    };
+
+#ifdef VPR_USE_TBB
+    tbb::parallel_for_each(net_list.nets().begin(), net_list.nets().end(), check_net);
+#else
     for (auto net_id : net_list.nets()) {
-        check_non_configurable_edges(net_list,
-                                     net_id,
-                                     non_configurable_rr_sets,
-                                     is_flat);
+        check_net(net_id);
     }
+#endif
 }
 
 // Checks that the specified routing is legal with respect to non-configurable edges
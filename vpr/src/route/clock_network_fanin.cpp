@@ -0,0 +1,41 @@
+#include "clock_network_fanin.h"
+
+ClockNetworkFanin::ClockNetworkFanin(const t_rr_graph_view& rr_nodes,
+                                     const RRGraphView& rr_graph,
+                                     const vtr::vector<RRIndexedDataId, t_rr_indexed_data>& rr_indexed_data) {
+    auto is_clock_network_wire = [&](RRNodeId node) {
+        t_rr_type type = rr_graph.node_type(node);
+        if (type != CHANX && type != CHANY) {
+            return false;
+        }
+        int seg_index = rr_indexed_data[rr_graph.node_cost_index(node)].seg_index;
+        return seg_index >= 0 && rr_graph.rr_segments(RRSegmentId(seg_index)).res_type == SegResType::GCLK;
+    };
+
+    std::vector<RRNodeId> clock_pins;
+    for (RRNodeId node : rr_graph.nodes()) {
+        if (!is_clock_network_wire(node)) continue;
+
+        for (RREdgeId edge : rr_nodes.edge_range(node)) {
+            RRNodeId to_node = rr_nodes.edge_sink_node(edge);
+            if (is_clock_network_wire(to_node)) {
+                in_edges_[to_node].push_back(edge);
+            } else if (rr_graph.node_type(to_node) == IPIN) {
+                std::vector<RREdgeId>& pin_in_edges = in_edges_[to_node];
+                if (pin_in_edges.empty()) {
+                    clock_pins.push_back(to_node);
+                }
+                pin_in_edges.push_back(edge);
+            }
+        }
+    }
+
+    for (RRNodeId pin : clock_pins) {
+        for (RREdgeId edge : rr_nodes.edge_range(pin)) {
+            RRNodeId to_node = rr_nodes.edge_sink_node(edge);
+            if (rr_graph.node_type(to_node) == SINK) {
+                in_edges_[to_node].push_back(edge);
+            }
+        }
+    }
+}
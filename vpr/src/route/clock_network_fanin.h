@@ -0,0 +1,50 @@
+#ifndef CLOCK_NETWORK_FANIN_H
+#define CLOCK_NETWORK_FANIN_H
+
+#include <unordered_map>
+#include <vector>
+
+#include "rr_graph_storage.h"
+#include "rr_graph_view.h"
+#include "vtr_array_view.h"
+
+/**
+ * @brief The fan-in of the dedicated clock networks of an RR graph.
+ *
+ * The clock networks built from the architecture's clock description are trees:
+ * a drive point drives a spine, whose switch points drive ribs, whose wires drive
+ * the clock pins (see ClockSpine and ClockRib). Their wires are the CHANX/CHANY
+ * nodes of GCLK segments. This records the edges driving each of them from another
+ * clock network wire, the edges from clock network wires to the IPINs they drive,
+ * and the edges from those IPINs to their SINKs.
+ *
+ * From a clock sink, walking these edges backward visits the handful of wires
+ * above it in the clock network, so the router can reach the part of the network
+ * a net already uses without a general search over its large fan-out.
+ *
+ * The edge ids are those of the RR graph the fan-in was built from; it must be
+ * rebuilt if that RR graph changes.
+ */
+class ClockNetworkFanin {
+  public:
+    ClockNetworkFanin(const t_rr_graph_view& rr_nodes,
+                      const RRGraphView& rr_graph,
+                      const vtr::vector<RRIndexedDataId, t_rr_indexed_data>& rr_indexed_data);
+
+    ///@brief Returns the clock network edges driving node (none if the clock networks do not drive node)
+    vtr::array_view<const RREdgeId> in_edges(RRNodeId node) const {
+        auto it = in_edges_.find(node);
+        if (it == in_edges_.end()) {
+            return vtr::array_view<const RREdgeId>();
+        }
+        return vtr::array_view<const RREdgeId>(it->second.data(), it->second.size());
+    }
+
+    ///@brief Returns true if the RR graph has no dedicated clock network
+    bool empty() const { return in_edges_.empty(); }
+
+  private:
+    std::unordered_map<RRNodeId, std::vector<RREdgeId>> in_edges_;
+};
+
+#endif /* CLOCK_NETWORK_FANIN_H */
@@ -12,7 +12,8 @@ Connection_based_routing_resources::Connection_based_routing_resources(const Net
     , last_stable_critical_path_delay{0.0f}
     , critical_path_growth_tolerance{1.001f}
     , connection_criticality_tolerance{0.9f}
-    , connection_delay_optimality_tolerance{1.1f} {
+    , connection_delay_optimality_tolerance{1.1f}
+    , incremental_reroute_all_nets{false} {
     /* Initialize the persistent data structures for incremental rerouting
      *
      * remaining_targets will reserve enough space to ensure it won't need
@@ -13,7 +13,11 @@
 // lookup and persistent scratch-space resources used for incremental reroute through
 // pruning the route tree of large fanouts. Instead of rerouting to each sink of a congested net,
 // reroute only the connections to the ones that did not have a legal connection the previous time
+class RouteCheckpoint;
+
 class Connection_based_routing_resources {
+    friend class RouteCheckpoint; // saves and restores the rerouting state
+
   public:
     Connection_based_routing_resources(const Netlist<>& net_list,
                                        const vtr::vector<ParentNetId, std::vector<RRNodeId>>& net_terminals,
@@ -24,6 +28,11 @@ class Connection_based_routing_resources {
     void set_connection_criticality_tolerance(float val) { connection_criticality_tolerance = val; }
     void set_connection_delay_tolerance(float val) { connection_delay_optimality_tolerance = val; }
 
+    // whether every net, regardless of fanout, should be rerouted incrementally (set once little
+    // overuse remains, so only the connections through overused nodes get ripped up and rerouted)
+    void set_incremental_reroute_all_nets(bool val) { incremental_reroute_all_nets = val; }
+    bool should_incrementally_reroute_all_nets() const { return incremental_reroute_all_nets; }
+
     // Targeted reroute resources --------------
   private:
     const Netlist<>& net_list_;
@@ -55,6 +64,9 @@ class Connection_based_routing_resources {
     // what fraction of a connection's lower bound delay is considered close enough to optimal (> 1)
     float connection_delay_optimality_tolerance;
 
+    // see set_incremental_reroute_all_nets()
+    bool incremental_reroute_all_nets;
+
   public:
     // after timing analysis of 1st iteration, can set a lower bound on connection delay
     void set_lower_bound_connection_delays(NetPinsMatrix<float>& net_delay);
@@ -1,11 +1,20 @@
 #include "connection_router.h"
 
+#include <cmath>
 #include <algorithm>
+#include <memory>
+#include <queue>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
 #include "rr_graph.h"
 #include "binary_heap.h"
 #include "four_ary_heap.h"
 #include "bucket.h"
+#include "radix_heap.h"
+#include "eight_ary_heap.h"
 #include "rr_graph_fwd.h"
+#include "router_phase_profiling.h"
 
 static bool relevant_node_to_target(const RRGraphView* rr_graph,
                                     RRNodeId node_to_add,
@@ -42,6 +51,9 @@ std::tuple<bool, bool, t_heap> ConnectionRouter<Heap>::timing_driven_route_conne
     if (cheapest != nullptr) {
         rcv_path_manager.update_route_tree_set(cheapest->path_data);
         update_cheapest(cheapest);
+        if (lookahead_correction_.is_enabled() && !rcv_path_manager.is_enabled()) {
+            record_lookahead_samples(sink_node, cost_params);
+        }
         t_heap out = *cheapest;
         heap_.free(cheapest);
         heap_.empty_heap();
@@ -79,9 +91,11 @@ std::tuple<bool, t_heap*> ConnectionRouter<Heap>::timing_driven_route_connection
                    bounding_box.layer_min, bounding_box.xmin, bounding_box.ymin,
                    bounding_box.layer_max, bounding_box.xmax, bounding_box.ymax);
 
-    t_heap* cheapest = timing_driven_route_connection_from_heap(sink_node,
-                                                                cost_params,
-                                                                bounding_box);
+    t_heap* cheapest = dispatch_router_features([&](auto features) {
+        return timing_driven_route_connection_from_heap<decltype(features)>(sink_node,
+                                                                            cost_params,
+                                                                            bounding_box);
+    });
 
     if (cheapest == nullptr) {
         // No path found within the current bounding box.
@@ -98,6 +112,10 @@ std::tuple<bool, t_heap*> ConnectionRouter<Heap>::timing_driven_route_connection
         }
 
         // Otherwise, leave unrouted and bubble up a signal to retry this net with a full-device bounding box
+        // (the corridors of the global routing are retried within the net bounding box by the caller)
+        if (conn_params_->in_global_route_corridor_) {
+            return std::make_tuple(true, nullptr);
+        }
         VTR_LOG_WARN("No routing path for connection to sink_rr %d, leaving unrouted to retry later\n", sink_node);
         return std::make_tuple(true, nullptr);
     }
@@ -140,9 +158,11 @@ std::tuple<bool, bool, t_heap> ConnectionRouter<Heap>::timing_driven_route_conne
 
     bool retry_with_full_bb = false;
     t_heap* cheapest;
-    cheapest = timing_driven_route_connection_from_heap(sink_node,
-                                                        cost_params,
-                                                        high_fanout_bb);
+    cheapest = dispatch_router_features([&](auto features) {
+        return timing_driven_route_connection_from_heap<decltype(features)>(sink_node,
+                                                                            cost_params,
+                                                                            high_fanout_bb);
+    });
 
     if (cheapest == nullptr) {
         //Found no path, that may be due to an unlucky choice of existing route tree sub-set,
@@ -170,6 +190,9 @@ std::tuple<bool, bool, t_heap> ConnectionRouter<Heap>::timing_driven_route_conne
 
     rcv_path_manager.update_route_tree_set(cheapest->path_data);
     update_cheapest(cheapest);
+    if (lookahead_correction_.is_enabled() && !rcv_path_manager.is_enabled()) {
+        record_lookahead_samples(sink_node, cost_params);
+    }
 
     t_heap out = *cheapest;
     heap_.free(cheapest);
@@ -185,45 +208,31 @@ std::tuple<bool, bool, t_heap> ConnectionRouter<Heap>::timing_driven_route_conne
 //
 // Returns either the last element of the path, or nullptr if no path is found
 template<typename Heap>
+template<typename Features>
 t_heap* ConnectionRouter<Heap>::timing_driven_route_connection_from_heap(RRNodeId sink_node,
                                                                          const t_conn_cost_params& cost_params,
                                                                          const t_bb& bounding_box) {
     VTR_ASSERT_SAFE(heap_.is_valid());
+    VTR_ASSERT(bounding_box.layer_max < (int)grid_.get_num_layers());
 
     if (heap_.is_empty_heap()) { //No source
         VTR_LOGV_DEBUG(router_debug_, "  Initial heap empty (no source)\n");
     }
 
     const auto& device_ctx = g_vpr_ctx.device();
-    auto& route_ctx = g_vpr_ctx.mutable_routing();
 
     // Get bounding box for sink node used in timing_driven_expand_neighbour
     VTR_ASSERT_SAFE(sink_node != RRNodeId::INVALID());
 
-    t_bb target_bb;
-    if (rr_graph_->node_type(sink_node) == SINK) { // We need to get a bounding box for the sink's entire tile
-        vtr::Rect<int> tile_bb = grid_.get_tile_bb({rr_graph_->node_xlow(sink_node),
-                                                    rr_graph_->node_ylow(sink_node),
-                                                    rr_graph_->node_layer(sink_node)});
-
-        target_bb.xmin = tile_bb.xmin();
-        target_bb.ymin = tile_bb.ymin();
-        target_bb.xmax = tile_bb.xmax();
-        target_bb.ymax = tile_bb.ymax();
-    } else {
-        target_bb.xmin = rr_graph_->node_xlow(sink_node);
-        target_bb.ymin = rr_graph_->node_ylow(sink_node);
-        target_bb.xmax = rr_graph_->node_xhigh(sink_node);
-        target_bb.ymax = rr_graph_->node_yhigh(sink_node);
-    }
-
-    target_bb.layer_min = rr_graph_->node_layer(RRNodeId(sink_node));
-    target_bb.layer_max = rr_graph_->node_layer(RRNodeId(sink_node));
+    t_bb target_bb = get_node_tile_bb(sink_node);
 
     t_heap* cheapest = nullptr;
     while (!heap_.is_empty_heap()) {
         // cheapest t_heap in current route tree to be expanded on
-        cheapest = heap_.get_heap_head();
+        {
+            router_phase_profiling::ScopedPhase phase(e_router_phase::HEAP);
+            cheapest = heap_.get_heap_head();
+        }
         update_router_stats(router_stats_,
                             false,
                             cheapest->index,
@@ -235,22 +244,22 @@ t_heap* ConnectionRouter<Heap>::timing_driven_route_connection_from_heap(RRNodeI
 
         // Have we found the target?
         if (inode == sink_node) {
-            // If we're running RCV, the path will be stored in the path_data->path_rr vector
+            // If we're running RCV, the path is stored as links of the path manager, rebuilt here from the sink
             // This is then placed into the traceback so that the correct path is returned
             // TODO: This can be eliminated by modifying the actual traceback function in route_timing
-            if (rcv_path_manager.is_enabled()) {
-                rcv_path_manager.insert_backwards_path_into_traceback(cheapest->path_data, cheapest->cost, cheapest->backward_path_cost, route_ctx);
+            if (Features::rcv) {
+                rcv_path_manager.insert_backwards_path_into_traceback(cheapest->path_data, cheapest->cost, cheapest->backward_path_cost, rr_node_route_inf_);
             }
             VTR_LOGV_DEBUG(router_debug_, "  Found target %8d (%s)\n", inode, describe_rr_node(device_ctx.rr_graph, device_ctx.grid, device_ctx.rr_indexed_data, inode, is_flat_).c_str());
             break;
         }
 
         // If not, keep searching
-        timing_driven_expand_cheapest(cheapest,
-                                      sink_node,
-                                      cost_params,
-                                      bounding_box,
-                                      target_bb);
+        timing_driven_expand_cheapest<Features>(cheapest,
+                                                sink_node,
+                                                cost_params,
+                                                bounding_box,
+                                                target_bb);
 
         rcv_path_manager.free_path_struct(cheapest->path_data);
         heap_.free(cheapest);
@@ -270,6 +279,356 @@ t_heap* ConnectionRouter<Heap>::timing_driven_route_connection_from_heap(RRNodeI
     return cheapest;
 }
 
+template<typename Heap>
+float ConnectionRouter<Heap>::corrected_expected_cost(RRNodeId node, RRNodeId target_node, float expected_cost) const {
+    t_rr_type node_type = rr_graph_->node_type(node);
+    if (node_type != CHANX && node_type != CHANY) {
+        return expected_cost;
+    }
+
+    int seg_index = g_vpr_ctx.device().rr_indexed_data[rr_graph_->node_cost_index(node)].seg_index;
+    auto [delta_x, delta_y] = util::get_xy_deltas(node, target_node);
+    return expected_cost * lookahead_correction_.factor(seg_index, std::abs(delta_x) + std::abs(delta_y));
+}
+
+template<typename Heap>
+void ConnectionRouter<Heap>::record_lookahead_samples(RRNodeId sink_node, const t_conn_cost_params& cost_params) {
+    const auto& device_ctx = g_vpr_ctx.device();
+    float sink_cost = rr_node_route_inf_[sink_node].backward_path_cost;
+
+    //Walk the new part of the path back to the route tree (whose nodes were pushed without a previous edge)
+    for (RREdgeId edge = rr_node_route_inf_[sink_node].prev_edge; edge != RREdgeId::INVALID();) {
+        RRNodeId node = rr_graph_->edge_src_node(edge);
+        t_rr_type node_type = rr_graph_->node_type(node);
+        if (node_type == CHANX || node_type == CHANY) {
+            int seg_index = device_ctx.rr_indexed_data[rr_graph_->node_cost_index(node)].seg_index;
+            auto [delta_x, delta_y] = util::get_xy_deltas(node, sink_node);
+            //The uncorrected estimate, which is what the factors scale
+            float estimate = router_lookahead_.get_expected_cost(node, sink_node, cost_params, 0.);
+            float actual = sink_cost - rr_node_route_inf_[node].backward_path_cost;
+            router_stats_->lookahead_samples.add(seg_index, std::abs(delta_x) + std::abs(delta_y), estimate, actual);
+        }
+        edge = rr_node_route_inf_[node].prev_edge;
+    }
+}
+
+template<typename Heap>
+t_bb ConnectionRouter<Heap>::get_node_tile_bb(RRNodeId node) const {
+    t_bb tile_bb;
+    t_rr_type node_type = rr_graph_->node_type(node);
+    if (node_type == SINK || node_type == SOURCE) { // We need to get a bounding box for the entire tile
+        vtr::Rect<int> rect = grid_.get_tile_bb({rr_graph_->node_xlow(node),
+                                                 rr_graph_->node_ylow(node),
+                                                 rr_graph_->node_layer(node)});
+
+        tile_bb.xmin = rect.xmin();
+        tile_bb.ymin = rect.ymin();
+        tile_bb.xmax = rect.xmax();
+        tile_bb.ymax = rect.ymax();
+    } else {
+        tile_bb.xmin = rr_graph_->node_xlow(node);
+        tile_bb.ymin = rr_graph_->node_ylow(node);
+        tile_bb.xmax = rr_graph_->node_xhigh(node);
+        tile_bb.ymax = rr_graph_->node_yhigh(node);
+    }
+
+    tile_bb.layer_min = rr_graph_->node_layer(node);
+    tile_bb.layer_max = rr_graph_->node_layer(node);
+
+    return tile_bb;
+}
+
+//Returns true if node (e.g. an IPIN or OPIN) lies entirely within bb
+static bool node_within_bb(const RRGraphView* rr_graph, RRNodeId node, const t_bb& bb) {
+    return rr_graph->node_xlow(node) >= bb.xmin
+           && rr_graph->node_ylow(node) >= bb.ymin
+           && rr_graph->node_xhigh(node) <= bb.xmax
+           && rr_graph->node_yhigh(node) <= bb.ymax
+           && rr_graph->node_layer(node) >= bb.layer_min
+           && rr_graph->node_layer(node) <= bb.layer_max;
+}
+
+// Finds a path from the root of rt_root to sink_node with a bidirectional search.
+//
+// A forward A* search from the root (guided by the lookahead, as in the regular
+// router) and a backward Dijkstra search from the sink are run alternately, always
+// advancing the one with fewer queued nodes. Since edge costs do not depend on the
+// path leading to them, the cost of a path through a node labelled by both
+// searches is the sum of its two labels; the cheapest such path is kept, and the
+// search stops once the cheapest queued node of either search costs at least as
+// much. Like the regular router, the lookahead is trusted to underestimate (it
+// is only a lower bound for astar_fac <= 1 and an admissible lookahead).
+//
+// The backward half of the path is then spliced into rr_node_route_inf, so the
+// whole path can be traced back from sink_node through prev_edge as usual.
+template<typename Heap>
+std::tuple<bool, bool, t_heap> ConnectionRouter<Heap>::timing_driven_route_connection_bidirectional(
+    const RouteTreeNode& rt_root,
+    RRNodeId sink_node,
+    const t_conn_cost_params& cost_params,
+    const t_bb& bounding_box,
+    const RRReverseEdges& reverse_edges,
+    RouterStats& router_stats) {
+    router_stats_ = &router_stats;
+
+    RRNodeId source_node = rt_root.inode;
+
+    if (bidir_cost_to_sink_.size() != rr_nodes_.size()) {
+        bidir_cost_to_sink_.assign(rr_nodes_.size(), std::numeric_limits<float>::infinity());
+        bidir_next_edge_.assign(rr_nodes_.size(), RREdgeId::INVALID());
+    }
+
+    // As in the regular router, IPINs are only entered on the target block, and
+    // (symmetrically) OPINs are only left on the source block
+    t_bb target_bb = get_node_tile_bb(sink_node);
+    t_bb source_bb = get_node_tile_bb(source_node);
+
+    VTR_LOGV_DEBUG(router_debug_, "  Routing to %d bidirectionally (BB: %d,%d,%d x %d,%d,%d)\n", sink_node,
+                   bounding_box.layer_min, bounding_box.xmin, bounding_box.ymin,
+                   bounding_box.layer_max, bounding_box.xmax, bounding_box.ymax);
+
+    using t_queued_node = std::pair<float, RRNodeId>;
+    using t_node_queue = std::priority_queue<t_queued_node, std::vector<t_queued_node>, std::greater<t_queued_node>>;
+    t_node_queue forward_queue;
+    t_node_queue backward_queue;
+
+    float best_cost = std::numeric_limits<float>::infinity();
+    RRNodeId meeting_node = RRNodeId::INVALID();
+
+    auto try_meeting_node = [&](RRNodeId node) {
+        float cost = rr_node_route_inf_[node].backward_path_cost + bidir_cost_to_sink_[node];
+        if (cost < best_cost) {
+            best_cost = cost;
+            meeting_node = node;
+        }
+    };
+
+    // Forward labels are kept in rr_node_route_inf: backward_path_cost is the cost
+    // from the source, and path_cost that plus the expected cost to the sink
+    auto label_forward = [&](RRNodeId node, RREdgeId prev_edge, float cost) {
+        t_rr_node_route_inf& route_inf = rr_node_route_inf_[node];
+        if (cost >= route_inf.backward_path_cost) return;
+
+        float expected_cost = router_lookahead_.get_expected_cost(node, sink_node, cost_params, 0.);
+
+        add_to_mod_list(node);
+        route_inf.prev_edge = prev_edge;
+        route_inf.backward_path_cost = cost;
+        route_inf.path_cost = cost + cost_params.astar_fac * std::max(0.f, expected_cost - cost_params.astar_offset);
+
+        forward_queue.emplace(route_inf.path_cost, node);
+        update_router_stats(router_stats_, true, node, rr_graph_);
+        try_meeting_node(node);
+    };
+
+    auto label_backward = [&](RRNodeId node, RREdgeId next_edge, float cost) {
+        if (cost >= bidir_cost_to_sink_[node]) return;
+
+        if (std::isinf(bidir_cost_to_sink_[node])) {
+            bidir_modified_nodes_.push_back(node);
+        }
+        bidir_cost_to_sink_[node] = cost;
+        bidir_next_edge_[node] = next_edge;
+
+        backward_queue.emplace(cost, node);
+        update_router_stats(router_stats_, true, node, rr_graph_);
+        try_meeting_node(node);
+    };
+
+    label_forward(source_node, RREdgeId::INVALID(), 0.);
+    label_backward(sink_node, RREdgeId::INVALID(), 0.);
+
+    while (!forward_queue.empty() && !backward_queue.empty()) {
+        //Neither search can find a cheaper path once its cheapest queued node costs as much
+        if (forward_queue.top().first >= best_cost || backward_queue.top().first >= best_cost) {
+            break;
+        }
+
+        if (forward_queue.size() <= backward_queue.size()) {
+            float key = forward_queue.top().first;
+            RRNodeId node = forward_queue.top().second;
+            forward_queue.pop();
+            update_router_stats(router_stats_, false, node, rr_graph_);
+
+            if (key > rr_node_route_inf_[node].path_cost) continue; //Stale (since improved) entry
+
+            float cost = rr_node_route_inf_[node].backward_path_cost;
+            for (RREdgeId edge : rr_nodes_.edge_range(node)) {
+                RRNodeId to_node = rr_nodes_.edge_sink_node(node, edge);
+                if (!inside_bb(to_node, bounding_box)) continue;
+                if (rr_graph_->node_type(to_node) == IPIN && !node_within_bb(rr_graph_, to_node, target_bb)) continue;
+
+                label_forward(to_node, edge, cost + bidirectional_edge_cost(cost_params, node, edge, to_node));
+            }
+        } else {
+            float key = backward_queue.top().first;
+            RRNodeId node = backward_queue.top().second;
+            backward_queue.pop();
+            update_router_stats(router_stats_, false, node, rr_graph_);
+
+            if (key > bidir_cost_to_sink_[node]) continue; //Stale (since improved) entry
+
+            auto in_edges = reverse_edges.in_edges(node);
+            auto in_nodes = reverse_edges.in_nodes(node);
+            for (size_t i = 0; i < in_edges.size(); ++i) {
+                RRNodeId from_node = in_nodes[i];
+                if (!inside_bb(from_node, bounding_box)) continue;
+                if (rr_graph_->node_type(from_node) == OPIN && !node_within_bb(rr_graph_, from_node, source_bb)) continue;
+
+                label_backward(from_node, in_edges[i], key + bidirectional_edge_cost(cost_params, from_node, in_edges[i], node));
+            }
+        }
+    }
+
+    bool found_path = meeting_node.is_valid();
+    if (found_path) {
+        //Walk the forward half of the path, so the backward half can be cut where it
+        //rejoins it (possible only over zero cost edges)
+        std::unordered_set<RRNodeId> forward_path_nodes;
+        for (RRNodeId node = meeting_node; node.is_valid();) {
+            forward_path_nodes.insert(node);
+            RREdgeId prev_edge = rr_node_route_inf_[node].prev_edge;
+            node = prev_edge.is_valid() ? rr_graph_->edge_src_node(prev_edge) : RRNodeId::INVALID();
+        }
+
+        RRNodeId splice_node = meeting_node;
+        for (RRNodeId node = meeting_node; node != sink_node;) {
+            node = rr_nodes_.edge_sink_node(node, bidir_next_edge_[node]);
+            if (forward_path_nodes.count(node)) {
+                splice_node = node;
+            }
+        }
+
+        //Record the backward half of the path as continuing the forward one
+        for (RRNodeId node = splice_node; node != sink_node;) {
+            RREdgeId edge = bidir_next_edge_[node];
+            RRNodeId next_node = rr_nodes_.edge_sink_node(node, edge);
+            float cost = rr_node_route_inf_[node].backward_path_cost + bidirectional_edge_cost(cost_params, node, edge, next_node);
+
+            t_rr_node_route_inf& route_inf = rr_node_route_inf_[next_node];
+            add_to_mod_list(next_node);
+            route_inf.prev_edge = edge;
+            route_inf.backward_path_cost = cost;
+            route_inf.path_cost = cost;
+
+            node = next_node;
+        }
+        VTR_LOGV_DEBUG(router_debug_, "  Found target %8d meeting at node %d (cost: %g)\n", sink_node, meeting_node, best_cost);
+    } else {
+        VTR_LOG("%s\n", describe_unrouteable_connection(source_node, sink_node, is_flat_).c_str());
+        reset_path_costs();
+        modified_rr_node_inf_.clear();
+    }
+
+    //Reset the backward search state for the next connection
+    for (RRNodeId node : bidir_modified_nodes_) {
+        bidir_cost_to_sink_[node] = std::numeric_limits<float>::infinity();
+        bidir_next_edge_[node] = RREdgeId::INVALID();
+    }
+    bidir_modified_nodes_.clear();
+
+    if (!found_path) {
+        return std::make_tuple(false, /*retry=*/false, t_heap());
+    }
+
+    t_heap out;
+    out.index = sink_node;
+    out.cost = rr_node_route_inf_[sink_node].path_cost;
+    out.backward_path_cost = rr_node_route_inf_[sink_node].backward_path_cost;
+    out.set_prev_edge(rr_node_route_inf_[sink_node].prev_edge);
+    return std::make_tuple(true, /*retry=*/false, out);
+}
+
+// Finds a path from tree to sink_node through the dedicated clock networks, with a
+// backward Dijkstra search from sink_node over their fan-in which stops at the first
+// wire of tree. Since the clock networks are trees, this only labels the few wires
+// above the sink, unlike a forward search from the route tree which would expand
+// the whole fan-out of the clock network towards the sink.
+//
+// As in the bidirectional search, each edge is costed independently of the path
+// leading to it. The path found is recorded in rr_node_route_inf, so it can be
+// traced back from sink_node through prev_edge as usual.
+template<typename Heap>
+std::tuple<bool, bool, t_heap> ConnectionRouter<Heap>::timing_driven_route_connection_through_clock_network(
+    const RouteTree& tree,
+    RRNodeId sink_node,
+    const t_conn_cost_params& cost_params,
+    RouterStats& router_stats) {
+    router_stats_ = &router_stats;
+
+    if (!clock_network_fanin_) {
+        clock_network_fanin_ = std::make_shared<const ClockNetworkFanin>(rr_nodes_, *rr_graph_, g_vpr_ctx.device().rr_indexed_data);
+    }
+    const ClockNetworkFanin& clock_network_fanin = *clock_network_fanin_;
+
+    //The cost from each labelled node to sink_node, and the edge leaving the node on that path
+    std::unordered_map<RRNodeId, std::pair<float, RREdgeId>> labels;
+
+    using t_queued_node = std::pair<float, RRNodeId>;
+    std::priority_queue<t_queued_node, std::vector<t_queued_node>, std::greater<t_queued_node>> queue;
+
+    labels.emplace(sink_node, std::make_pair(0.f, RREdgeId::INVALID()));
+    queue.emplace(0., sink_node);
+
+    RRNodeId tree_node = RRNodeId::INVALID();
+    while (!queue.empty()) {
+        auto [cost, node] = queue.top();
+        queue.pop();
+        update_router_stats(router_stats_, false, node, rr_graph_);
+
+        if (cost > labels[node].first) continue; //Stale (since improved) entry
+
+        //Branch off a wire of the route tree (as the general search, never off its pins)
+        t_rr_type type = rr_graph_->node_type(node);
+        if ((type == CHANX || type == CHANY) && tree.find_by_rr_id(node)) {
+            tree_node = node;
+            break;
+        }
+
+        for (RREdgeId edge : clock_network_fanin.in_edges(node)) {
+            RRNodeId from_node = rr_graph_->edge_src_node(edge);
+            float from_cost = cost + bidirectional_edge_cost(cost_params, from_node, edge, node);
+
+            auto [it, inserted] = labels.try_emplace(from_node, from_cost, edge);
+            if (!inserted) {
+                if (from_cost >= it->second.first) continue;
+                it->second = std::make_pair(from_cost, edge);
+            }
+            queue.emplace(from_cost, from_node);
+            update_router_stats(router_stats_, true, from_node, rr_graph_);
+        }
+    }
+
+    if (!tree_node.is_valid()) {
+        VTR_LOGV_DEBUG(router_debug_, "  No path to %d through the clock networks\n", sink_node);
+        return std::make_tuple(false, /*retry=*/false, t_heap());
+    }
+
+    //Record the path as continuing the route tree at tree_node
+    float cost = 0.;
+    for (RRNodeId node = tree_node; node != sink_node;) {
+        RREdgeId edge = labels[node].second;
+        RRNodeId next_node = rr_nodes_.edge_sink_node(edge);
+        cost += bidirectional_edge_cost(cost_params, node, edge, next_node);
+
+        t_rr_node_route_inf& route_inf = rr_node_route_inf_[next_node];
+        add_to_mod_list(next_node);
+        route_inf.prev_edge = edge;
+        route_inf.backward_path_cost = cost;
+        route_inf.path_cost = cost;
+
+        node = next_node;
+    }
+    VTR_LOGV_DEBUG(router_debug_, "  Found target %8d through the clock networks from node %d (cost: %g)\n", sink_node, tree_node, cost);
+
+    t_heap out;
+    out.index = sink_node;
+    out.cost = rr_node_route_inf_[sink_node].path_cost;
+    out.backward_path_cost = rr_node_route_inf_[sink_node].backward_path_cost;
+    out.set_prev_edge(rr_node_route_inf_[sink_node].prev_edge);
+    return std::make_tuple(true, /*retry=*/false, out);
+}
+
 // Find shortest paths from specified route tree to all nodes in the RR graph
 template<typename Heap>
 vtr::vector<RRNodeId, t_heap> ConnectionRouter<Heap>::timing_driven_find_all_shortest_paths_from_route_tree(
@@ -286,7 +645,9 @@ vtr::vector<RRNodeId, t_heap> ConnectionRouter<Heap>::timing_driven_find_all_sho
     add_route_tree_to_heap(rt_root, target_node, cost_params, bounding_box);
     heap_.build_heap(); // via sifting down everything
 
-    auto res = timing_driven_find_all_shortest_paths_from_heap(cost_params, bounding_box);
+    auto res = dispatch_router_features([&](auto features) {
+        return timing_driven_find_all_shortest_paths_from_heap<decltype(features)>(cost_params, bounding_box);
+    });
     heap_.empty_heap();
 
     return res;
@@ -300,12 +661,14 @@ vtr::vector<RRNodeId, t_heap> ConnectionRouter<Heap>::timing_driven_find_all_sho
 // Note that to re-use code used for the regular A*-based router we use a
 // no-operation lookahead which always returns zero.
 template<typename Heap>
+template<typename Features>
 vtr::vector<RRNodeId, t_heap> ConnectionRouter<Heap>::timing_driven_find_all_shortest_paths_from_heap(
     const t_conn_cost_params& cost_params,
     const t_bb& bounding_box) {
     vtr::vector<RRNodeId, t_heap> cheapest_paths(rr_nodes_.size());
 
     VTR_ASSERT_SAFE(heap_.is_valid());
+    VTR_ASSERT(bounding_box.layer_max < (int)grid_.get_num_layers());
 
     if (heap_.is_empty_heap()) { // No source
         VTR_LOGV_DEBUG(router_debug_, "  Initial heap empty (no source)\n");
@@ -313,7 +676,11 @@ vtr::vector<RRNodeId, t_heap> ConnectionRouter<Heap>::timing_driven_find_all_sho
 
     while (!heap_.is_empty_heap()) {
         // cheapest t_heap in current route tree to be expanded on
-        t_heap* cheapest = heap_.get_heap_head();
+        t_heap* cheapest;
+        {
+            router_phase_profiling::ScopedPhase phase(e_router_phase::HEAP);
+            cheapest = heap_.get_heap_head();
+        }
         update_router_stats(router_stats_,
                             false,
                             cheapest->index,
@@ -330,11 +697,11 @@ vtr::vector<RRNodeId, t_heap> ConnectionRouter<Heap>::timing_driven_find_all_sho
         // lookahead we can re-use the node exploration code from the regular router
         RRNodeId target_node = RRNodeId::INVALID();
 
-        timing_driven_expand_cheapest(cheapest,
-                                      target_node,
-                                      cost_params,
-                                      bounding_box,
-                                      t_bb());
+        timing_driven_expand_cheapest<Features>(cheapest,
+                                                target_node,
+                                                cost_params,
+                                                bounding_box,
+                                                t_bb());
 
         if (cheapest_paths[inode].index == RRNodeId::INVALID() || cheapest_paths[inode].cost >= cheapest->cost) {
             VTR_LOGV_DEBUG(router_debug_, "  Better cost to node %d: %g (was %g)\n", inode, cheapest->cost, cheapest_paths[inode].cost);
@@ -351,6 +718,7 @@ vtr::vector<RRNodeId, t_heap> ConnectionRouter<Heap>::timing_driven_find_all_sho
 }
 
 template<typename Heap>
+template<typename Features>
 void ConnectionRouter<Heap>::timing_driven_expand_cheapest(t_heap* cheapest,
                                                            RRNodeId target_node,
                                                            const t_conn_cost_params& cost_params,
@@ -373,7 +741,7 @@ void ConnectionRouter<Heap>::timing_driven_expand_cheapest(t_heap* cheapest,
      * than one with higher cost.  Test whether or not I should disallow   *
      * re-expansion based on a higher total cost.                          */
 
-    if (best_total_cost > new_total_cost && ((rcv_path_manager.is_enabled()) || best_back_cost > new_back_cost)) {
+    if (best_total_cost > new_total_cost && (Features::rcv || best_back_cost > new_back_cost)) {
         // Explore from this node, since the current/new partial path has the best cost
         // found so far
         VTR_LOGV_DEBUG(router_debug_, "    Better cost to %d\n", inode);
@@ -387,8 +755,8 @@ void ConnectionRouter<Heap>::timing_driven_expand_cheapest(t_heap* cheapest,
 
         update_cheapest(cheapest, route_inf);
 
-        timing_driven_expand_neighbours(cheapest, cost_params, bounding_box,
-                                        target_node, target_bb);
+        timing_driven_expand_neighbours<Features>(cheapest, cost_params, bounding_box,
+                                                  target_node, target_bb);
     } else {
         // Post-heap prune, do not re-explore from the current/new partial path as it
         // has worse cost than the best partial path to this node found so far
@@ -401,6 +769,7 @@ void ConnectionRouter<Heap>::timing_driven_expand_cheapest(t_heap* cheapest,
 }
 
 template<typename Heap>
+template<typename Features>
 void ConnectionRouter<Heap>::timing_driven_expand_neighbours(t_heap* current,
                                                              const t_conn_cost_params& cost_params,
                                                              const t_bb& bounding_box,
@@ -412,9 +781,14 @@ void ConnectionRouter<Heap>::timing_driven_expand_neighbours(t_heap* current,
     RRNodeId from_node = current->index;
     auto edges = rr_nodes_.edge_range(from_node);
 
-    // This is a simple prefetch that prefetches:
-    //  - RR node data reachable from this node
-    //  - rr switch data to reach those nodes from this node.
+    // The expansion is a two stage pipeline. The first stage gathers the
+    // destinations of the edges, and prefetches for each of them:
+    //  - its RR node data,
+    //  - its route info (path costs) and congestion info,
+    //  - the rr switch data to reach it from this node.
+    // None of these addresses depend on a cache-missing load, so the misses of
+    // all the fan-out overlap, instead of stalling in turn on each edge while
+    // the second stage evaluates its costs.
     //
     // This code will be a NOP on compiler targets that do not have a
     // builtin to emit prefetch instructions.
@@ -422,31 +796,40 @@ void ConnectionRouter<Heap>::timing_driven_expand_neighbours(t_heap* current,
     // This code will be a NOP on CPU targets that lack prefetch instructions.
     // All modern x86 and ARM64 platforms provide prefetch instructions.
     //
-    // This code delivers ~6-8% reduction in wallclock time when running Titan
-    // benchmarks, and was specifically measured against the gsm_switch and
-    // directrf vtr_reg_weekly running in high effort.
+    // Prefetching the RR node and switch data alone delivered ~6-8% reduction
+    // in wallclock time when running Titan benchmarks, and was specifically
+    // measured against the gsm_switch and directrf vtr_reg_weekly running in
+    // high effort.
     //
     //  - directrf_stratixiv_arch_timing.blif
     //  - gsm_switch_stratixiv_arch_timing.blif
     //
+    const auto& rr_node_cong_inf = g_vpr_ctx.routing().rr_node_cong_inf;
+
+    expansion_to_nodes_.clear();
     for (RREdgeId from_edge : edges) {
         RRNodeId to_node = rr_nodes_.edge_sink_node(from_edge);
+        expansion_to_nodes_.push_back(to_node);
+
         rr_nodes_.prefetch_node(to_node);
+        VTR_PREFETCH(&rr_node_route_inf_[to_node], 0, 0);
+        VTR_PREFETCH(&rr_node_cong_inf[to_node], 0, 0);
 
         int switch_idx = rr_nodes_.edge_switch(from_edge);
-        VTR_PREFETCH(&rr_switch_inf_[switch_idx], 0, 0);
+        VTR_PREFETCH(&switch_costs_[switch_idx], 0, 0);
     }
 
+    size_t iedge = 0;
     for (RREdgeId from_edge : edges) {
-        RRNodeId to_node = rr_nodes_.edge_sink_node(from_edge);
-        timing_driven_expand_neighbour(current,
-                                       from_node,
-                                       from_edge,
-                                       to_node,
-                                       cost_params,
-                                       bounding_box,
-                                       target_node,
-                                       target_bb);
+        RRNodeId to_node = expansion_to_nodes_[iedge++];
+        timing_driven_expand_neighbour<Features>(current,
+                                                 from_node,
+                                                 from_edge,
+                                                 to_node,
+                                                 cost_params,
+                                                 bounding_box,
+                                                 target_node,
+                                                 target_bb);
     }
 }
 
@@ -454,6 +837,7 @@ void ConnectionRouter<Heap>::timing_driven_expand_neighbours(t_heap* current,
 // RR nodes outside the expanded bounding box specified in bounding_box are not added
 // to the heap.
 template<typename Heap>
+template<typename Features>
 void ConnectionRouter<Heap>::timing_driven_expand_neighbour(t_heap* current,
                                                             RRNodeId from_node,
                                                             RREdgeId from_edge,
@@ -462,13 +846,11 @@ void ConnectionRouter<Heap>::timing_driven_expand_neighbour(t_heap* current,
                                                             const t_bb& bounding_box,
                                                             RRNodeId target_node,
                                                             const t_bb& target_bb) {
-    VTR_ASSERT(bounding_box.layer_max < g_vpr_ctx.device().grid.get_num_layers());
-
     // BB-pruning
     // Disable BB-pruning if RCV is enabled, as this can make it harder for circuits with high negative hold slack to resolve this
     // TODO: Only disable pruning if the net has negative hold slack, maybe go off budgets
     if (!inside_bb(to_node, bounding_box)
-        && !rcv_path_manager.is_enabled()) {
+        && !Features::rcv) {
         VTR_LOGV_DEBUG(router_debug_,
                        "      Pruned expansion of node %d edge %zu -> %d"
                        " (to node location %d,%d,%d x %d,%d,%d outside of expanded"
@@ -521,23 +903,24 @@ void ConnectionRouter<Heap>::timing_driven_expand_neighbour(t_heap* current,
     // Check if the node exists in the route tree when RCV is enabled
     // Other pruning methods have been disabled when RCV is on, so this method is required to prevent "loops" from being created
     bool node_exists = false;
-    if (rcv_path_manager.is_enabled()) {
+    if (Features::rcv) {
         node_exists = rcv_path_manager.node_exists_in_tree(current->path_data,
                                                            to_node);
     }
 
-    if (!node_exists || !rcv_path_manager.is_enabled()) {
-        timing_driven_add_to_heap(cost_params,
-                                  current,
-                                  from_node,
-                                  to_node,
-                                  from_edge,
-                                  target_node);
+    if (!node_exists || !Features::rcv) {
+        timing_driven_add_to_heap<Features>(cost_params,
+                                            current,
+                                            from_node,
+                                            to_node,
+                                            from_edge,
+                                            target_node);
     }
 }
 
 // Add to_node to the heap, and also add any nodes which are connected by non-configurable edges
 template<typename Heap>
+template<typename Features>
 void ConnectionRouter<Heap>::timing_driven_add_to_heap(const t_conn_cost_params& cost_params,
                                                        const t_heap* current,
                                                        RRNodeId from_node,
@@ -555,19 +938,22 @@ void ConnectionRouter<Heap>::timing_driven_add_to_heap(const t_conn_cost_params&
     next.backward_path_cost = current->backward_path_cost;
 
     // path_data variables are initialized to current values
-    if (rcv_path_manager.is_enabled() && current->path_data) {
+    if (Features::rcv && current->path_data) {
         next.path_data->backward_cong = current->path_data->backward_cong;
         next.path_data->backward_delay = current->path_data->backward_delay;
     }
 
     next.R_upstream = current->R_upstream;
 
-    evaluate_timing_driven_node_costs(&next,
-                                      cost_params,
-                                      from_node,
-                                      to_node,
-                                      from_edge,
-                                      target_node);
+    {
+        router_phase_profiling::ScopedPhase phase(e_router_phase::COST_EVALUATION);
+        evaluate_timing_driven_node_costs<Features>(&next,
+                                                    cost_params,
+                                                    from_node,
+                                                    to_node,
+                                                    from_edge,
+                                                    target_node);
+    }
 
     float best_total_cost = rr_node_route_inf_[to_node].path_cost;
     float best_back_cost = rr_node_route_inf_[to_node].backward_path_cost;
@@ -575,7 +961,7 @@ void ConnectionRouter<Heap>::timing_driven_add_to_heap(const t_conn_cost_params&
     float new_total_cost = next.cost;
     float new_back_cost = next.backward_path_cost;
 
-    if (new_total_cost < best_total_cost && ((rcv_path_manager.is_enabled()) || (new_back_cost < best_back_cost))) {
+    if (new_total_cost < best_total_cost && (Features::rcv || (new_back_cost < best_back_cost))) {
         VTR_LOGV_DEBUG(router_debug_, "      Expanding to node %d (%s)\n", to_node,
                        describe_rr_node(device_ctx.rr_graph,
                                         device_ctx.grid,
@@ -592,7 +978,7 @@ void ConnectionRouter<Heap>::timing_driven_add_to_heap(const t_conn_cost_params&
         t_heap* next_ptr = heap_.alloc();
 
         // Use the already created next path structure pointer when RCV is enabled
-        if (rcv_path_manager.is_enabled()) rcv_path_manager.move(next_ptr->path_data, next.path_data);
+        if (Features::rcv) rcv_path_manager.move(next_ptr->path_data, next.path_data);
 
         //Record how we reached this node
         next_ptr->cost = next.cost;
@@ -601,14 +987,15 @@ void ConnectionRouter<Heap>::timing_driven_add_to_heap(const t_conn_cost_params&
         next_ptr->index = to_node;
         next_ptr->set_prev_edge(from_edge);
 
-        if (rcv_path_manager.is_enabled() && current->path_data) {
-            next_ptr->path_data->path_rr = current->path_data->path_rr;
-            next_ptr->path_data->edge = current->path_data->edge;
-            next_ptr->path_data->path_rr.emplace_back(from_node);
-            next_ptr->path_data->edge.emplace_back(from_edge);
+        if (Features::rcv && current->path_data) {
+            // O(1): the new path shares the links of the current path
+            rcv_path_manager.extend_path(next_ptr->path_data, current->path_data, from_node, from_edge);
         }
 
-        heap_.add_to_heap(next_ptr);
+        {
+            router_phase_profiling::ScopedPhase phase(e_router_phase::HEAP);
+            heap_.add_to_heap(next_ptr);
+        }
         update_router_stats(router_stats_,
                             true,
                             to_node,
@@ -620,7 +1007,7 @@ void ConnectionRouter<Heap>::timing_driven_add_to_heap(const t_conn_cost_params&
         VTR_LOGV_DEBUG(router_debug_, "        New Total Cost %g New back Cost %g \n", new_total_cost, new_back_cost);
     }
 
-    if (rcv_path_manager.is_enabled() && next.path_data != nullptr) {
+    if (Features::rcv && next.path_data != nullptr) {
         rcv_path_manager.free_path_struct(next.path_data);
     }
 }
@@ -696,8 +1083,43 @@ void ConnectionRouter<Heap>::set_rcv_enabled(bool enable) {
     rcv_path_manager.set_enabled(enable);
 }
 
+template<typename Heap>
+float ConnectionRouter<Heap>::bidirectional_edge_cost(const t_conn_cost_params& cost_params,
+                                                      RRNodeId from_node,
+                                                      RREdgeId from_edge,
+                                                      RRNodeId to_node) const {
+    //Info for the switch connecting from_node to_node
+    int iswitch = rr_nodes_.edge_switch(from_node, from_edge);
+    const t_router_switch_cost& switch_cost = switch_costs_[iswitch];
+
+    float node_C = rr_rc_data_[rr_graph_->node_rc_index(to_node)].C;
+    float node_R = rr_rc_data_[rr_graph_->node_rc_index(to_node)].R;
+    float from_node_R = rr_rc_data_[rr_graph_->node_rc_index(from_node)].R;
+
+    //Delay as in evaluate_timing_driven_node_costs(), but with no upstream resistance
+    float R_upstream = switch_cost.R + node_R;
+    float Tdel = switch_cost.Tdel + (R_upstream - 0.5 * node_R) * node_C;
+    Tdel += (R_upstream - 0.5 * from_node_R) * switch_cost.Cinternal;
+
+    float cost = cost_params.criticality * Tdel;
+    if (switch_cost.configurable && cost_params.criticality < 1.) {
+        cost += (1. - cost_params.criticality) * get_rr_cong_cost(to_node, cost_params.pres_fac);
+    }
+
+    if (cost_params.bend_cost != 0.) {
+        t_rr_type from_type = rr_graph_->node_type(from_node);
+        t_rr_type to_type = rr_graph_->node_type(to_node);
+        if ((from_type == CHANX && to_type == CHANY) || (from_type == CHANY && to_type == CHANX)) {
+            cost += cost_params.bend_cost;
+        }
+    }
+
+    return cost;
+}
+
 //Calculates the cost of reaching to_node
 template<typename Heap>
+template<typename Features>
 void ConnectionRouter<Heap>::evaluate_timing_driven_node_costs(t_heap* to,
                                                                const t_conn_cost_params& cost_params,
                                                                RRNodeId from_node,
@@ -714,12 +1136,12 @@ void ConnectionRouter<Heap>::evaluate_timing_driven_node_costs(t_heap* to,
      */
 
     //Info for the switch connecting from_node to_node
-    int iswitch = rr_nodes_.edge_switch(from_edge);
-    bool switch_buffered = rr_switch_inf_[iswitch].buffered();
-    bool reached_configurably = rr_switch_inf_[iswitch].configurable();
-    float switch_R = rr_switch_inf_[iswitch].R;
-    float switch_Tdel = rr_switch_inf_[iswitch].Tdel;
-    float switch_Cinternal = rr_switch_inf_[iswitch].Cinternal;
+    const t_router_switch_cost& switch_cost = switch_costs_[rr_nodes_.edge_switch(from_node, from_edge)];
+    bool switch_buffered = switch_cost.buffered;
+    bool reached_configurably = switch_cost.configurable;
+    float switch_R = switch_cost.R;
+    float switch_Tdel = switch_cost.Tdel;
+    float switch_Cinternal = switch_cost.Cinternal;
 
     //To node info
     auto rc_index = rr_graph_->node_rc_index(to_node);
@@ -775,10 +1197,10 @@ void ConnectionRouter<Heap>::evaluate_timing_driven_node_costs(t_heap* to,
         //cost.
         cong_cost = 0.;
     }
-    if (conn_params_->has_choking_spot_ && is_flat_ && rr_graph_->node_type(to_node) == IPIN) {
+    if (Features::flat && conn_params_->has_choking_spot_ && rr_graph_->node_type(to_node) == IPIN) {
         auto find_res = conn_params_->connection_choking_spots_.find(to_node);
         if (find_res != conn_params_->connection_choking_spots_.end()) {
-            cong_cost = cong_cost / pow(2, (float)find_res->second);
+            cong_cost = std::ldexp(cong_cost, -find_res->second); // cong_cost / 2^choking_count
         }
     }
 
@@ -796,7 +1218,7 @@ void ConnectionRouter<Heap>::evaluate_timing_driven_node_costs(t_heap* to,
 
     float total_cost = 0.;
 
-    if (rcv_path_manager.is_enabled() && to->path_data != nullptr) {
+    if (Features::rcv && to->path_data != nullptr) {
         to->path_data->backward_delay += cost_params.criticality * Tdel;
         to->path_data->backward_cong += (1. - cost_params.criticality) * get_rr_cong_cost(to_node, cost_params.pres_fac);
 
@@ -804,10 +1226,26 @@ void ConnectionRouter<Heap>::evaluate_timing_driven_node_costs(t_heap* to,
     } else {
         const auto& device_ctx = g_vpr_ctx.device();
         //Update total cost
-        float expected_cost = router_lookahead_.get_expected_cost(to_node,
-                                                                  target_node,
-                                                                  cost_params,
-                                                                  to->R_upstream);
+        float expected_cost;
+        {
+            router_phase_profiling::ScopedPhase phase(e_router_phase::LOOKAHEAD);
+            if constexpr (std::is_same<typename Features::lookahead, RouterLookahead>::value) {
+                expected_cost = router_lookahead_.get_expected_cost(to_node,
+                                                                    target_node,
+                                                                    cost_params,
+                                                                    to->R_upstream);
+            } else {
+                //A qualified call, so not dispatched through the vtable
+                using Lookahead = typename Features::lookahead;
+                expected_cost = static_cast<const Lookahead&>(router_lookahead_).Lookahead::get_expected_cost(to_node,
+                                                                                                               target_node,
+                                                                                                               cost_params,
+                                                                                                               to->R_upstream);
+            }
+            if (lookahead_correction_.is_enabled() && target_node != RRNodeId::INVALID()) {
+                expected_cost = corrected_expected_cost(to_node, target_node, expected_cost);
+            }
+        }
         VTR_LOGV_DEBUG(router_debug_ && !std::isfinite(expected_cost),
                        "        Lookahead from %s (%s) to %s (%s) is non-finite, expected_cost = %f, to->R_upstream = %f\n",
                        rr_node_arch_name(to_node, is_flat_).c_str(),
@@ -907,7 +1345,14 @@ void ConnectionRouter<Heap>::add_route_tree_node_to_heap(
 
     if (!rcv_path_manager.is_enabled()) {
         // tot_cost = backward_path_cost + cost_params.astar_fac * expected_cost;
-        float expected_cost = router_lookahead_.get_expected_cost(inode, target_node, cost_params, R_upstream);
+        float expected_cost;
+        {
+            router_phase_profiling::ScopedPhase phase(e_router_phase::LOOKAHEAD);
+            expected_cost = router_lookahead_.get_expected_cost(inode, target_node, cost_params, R_upstream);
+            if (lookahead_correction_.is_enabled() && target_node != RRNodeId::INVALID()) {
+                expected_cost = corrected_expected_cost(inode, target_node, expected_cost);
+            }
+        }
         float tot_cost = backward_path_cost + cost_params.astar_fac * std::max(0.f, expected_cost - cost_params.astar_offset);
         VTR_LOGV_DEBUG(router_debug_, "  Adding node %8d to heap from init route tree with cost %g (%s)\n",
                        inode,
@@ -1154,8 +1599,32 @@ std::unique_ptr<ConnectionRouterInterface> make_connection_router(e_heap_type he
                 rr_switch_inf,
                 rr_node_route_inf,
                 is_flat);
+        case e_heap_type::RADIX_HEAP:
+            return std::make_unique<ConnectionRouter<RadixHeap>>(
+                grid,
+                router_lookahead,
+                rr_nodes,
+                rr_graph,
+                rr_rc_data,
+                rr_switch_inf,
+                rr_node_route_inf,
+                is_flat);
+        case e_heap_type::EIGHT_ARY_HEAP:
+            return std::make_unique<ConnectionRouter<EightAryHeap>>(
+                grid,
+                router_lookahead,
+                rr_nodes,
+                rr_graph,
+                rr_rc_data,
+                rr_switch_inf,
+                rr_node_route_inf,
+                is_flat);
         default:
             VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Unknown heap_type %d",
                             heap_type);
     }
 }
+
+// The delay profiler uses the bidirectional search, which is not part of
+// ConnectionRouterInterface, directly
+template class ConnectionRouter<FourAryHeap>;
@@ -1,10 +1,15 @@
 #ifndef _CONNECTION_ROUTER_H
 #define _CONNECTION_ROUTER_H
 
+#include <typeinfo>
+
 #include "connection_router_interface.h"
 #include "rr_graph_storage.h"
+#include "rr_reverse_edges.h"
+#include "clock_network_fanin.h"
 #include "route_common.h"
 #include "router_lookahead.h"
+#include "router_lookahead_map.h"
 #include "route_tree.h"
 #include "rr_rc_data.h"
 #include "router_stats.h"
@@ -13,6 +18,32 @@
 // Prune the heap when it contains 4x the number of nodes in the RR graph.
 constexpr size_t kHeapPruneFactor = 4;
 
+// The fields of t_rr_switch_inf read on every neighbour expansion. t_rr_switch_inf
+// also holds the switch name and power data, and buffered()/configurable() are
+// out-of-line calls, so the router keeps this packed copy (16 bytes per switch)
+// instead.
+struct t_router_switch_cost {
+    float R = 0.;
+    float Tdel = 0.;
+    float Cinternal = 0.;
+    bool buffered = false;
+    bool configurable = false;
+};
+
+// The configuration the maze routing loop (timing_driven_route_connection_from_heap()
+// and the expansion routines it calls) is compiled for. The loop is entered
+// through ConnectionRouter::dispatch_router_features(), once per connection, so
+// the checks of whether RCV is enabled and whether the router is flat are
+// resolved at compile time on every neighbour expansion. Lookahead is the
+// concrete type of the router lookahead when it is known (its expected cost is
+// then called without a virtual call), and RouterLookahead otherwise.
+template<bool Rcv, bool Flat, typename Lookahead>
+struct t_router_features {
+    static constexpr bool rcv = Rcv;
+    static constexpr bool flat = Flat;
+    using lookahead = Lookahead;
+};
+
 // This class encapsolates the timing driven connection router. This class
 // routes from some initial set of sources (via the input rt tree) to a
 // particular sink.
@@ -38,13 +69,15 @@ class ConnectionRouter : public ConnectionRouterInterface {
         , rr_nodes_(rr_nodes.view())
         , rr_graph_(rr_graph)
         , rr_rc_data_(rr_rc_data.data(), rr_rc_data.size())
-        , rr_switch_inf_(rr_switch_inf.data(), rr_switch_inf.size())
+        , switch_costs_(make_switch_costs(rr_switch_inf))
         , net_terminal_groups(g_vpr_ctx.routing().net_terminal_groups)
         , net_terminal_group_num(g_vpr_ctx.routing().net_terminal_group_num)
         , rr_node_route_inf_(rr_node_route_inf)
         , is_flat_(is_flat)
         , router_stats_(nullptr)
-        , router_debug_(false) {
+        , router_debug_(false)
+        , use_map_lookahead_(typeid(router_lookahead) == typeid(MapLookahead))
+        , lookahead_correction_(g_vpr_ctx.routing().lookahead_correction) {
         heap_.init_heap(grid);
         heap_.set_prune_limit(rr_nodes_.size(), kHeapPruneFactor * rr_nodes_.size());
         only_opin_inter_layer = (grid.get_num_layers() > 1) && inter_layer_connections_limited_to_opin(*rr_graph);
@@ -58,7 +91,11 @@ class ConnectionRouter : public ConnectionRouterInterface {
 
     // Reset modified data in rr_node_route_inf based on modified_rr_node_inf.
     void reset_path_costs() final {
-        ::reset_path_costs(modified_rr_node_inf_);
+        for (RRNodeId node : modified_rr_node_inf_) {
+            rr_node_route_inf_[node].path_cost = std::numeric_limits<float>::infinity();
+            rr_node_route_inf_[node].backward_path_cost = std::numeric_limits<float>::infinity();
+            rr_node_route_inf_[node].prev_edge = RREdgeId::INVALID();
+        }
     }
 
     /** Finds a path from the route tree rooted at rt_root to sink_node.
@@ -96,6 +133,46 @@ class ConnectionRouter : public ConnectionRouterInterface {
         RouterStats& router_stats,
         const ConnectionParameters& conn_params) final;
 
+    /** Finds a path from the route tree to sink_node through the dedicated
+     * clock networks only, by walking their fan-in backward from sink_node
+     * until it reaches a wire of the route tree.
+     *
+     * Returns a tuple of:
+     * bool: path exists through the clock networks?
+     * bool: should retry with full bounding box? (always false)
+     * t_heap: heap element of cheapest path */
+    std::tuple<bool, bool, t_heap> timing_driven_route_connection_through_clock_network(
+        const RouteTree& tree,
+        RRNodeId sink_node,
+        const t_conn_cost_params& cost_params,
+        RouterStats& router_stats) final;
+
+    /** Finds a path from the root of rt_root to sink_node by searching both
+     * forward from the root and backward from the sink (over the fan-in
+     * adjacency reverse_edges), until the two searches meet on a path neither
+     * can improve on.
+     *
+     * This is intended for connections with no congestion coupling to other
+     * connections, such as delay profiling, where long connections would
+     * otherwise grow a very large forward wavefront. Each edge is costed
+     * independently of the path leading to it (the delay is computed as if the
+     * upstream resistance were zero, which is exact for buffered switches), and
+     * non-configurable edges are not treated specially. Only the root of
+     * rt_root is used as a start point.
+     *
+     * As for timing_driven_route_connection_from_route_tree(), the path found
+     * is recorded in rr_node_route_inf, and the return value is a tuple of:
+     * bool: path exists? (hard failure, rr graph disconnected)
+     * bool: should retry with full bounding box? (always false)
+     * t_heap: heap element of the sink, to trace the path back from */
+    std::tuple<bool, bool, t_heap> timing_driven_route_connection_bidirectional(
+        const RouteTreeNode& rt_root,
+        RRNodeId sink_node,
+        const t_conn_cost_params& cost_params,
+        const t_bb& bounding_box,
+        const RRReverseEdges& reverse_edges,
+        RouterStats& router_stats);
+
     // Finds a path from the route tree rooted at rt_root to all sinks
     // available.
     //
@@ -127,6 +204,10 @@ class ConnectionRouter : public ConnectionRouterInterface {
     // Ensure route budgets have been calculated before enabling this
     void set_rcv_enabled(bool enable) final;
 
+    const vtr::vector<RRNodeId, t_rr_node_route_inf>& get_rr_node_route_inf() const final {
+        return rr_node_route_inf_;
+    }
+
   private:
     // Mark that data associated with rr_node "inode" has been modified, and
     // needs to be reset in reset_path_costs.
@@ -165,6 +246,33 @@ class ConnectionRouter : public ConnectionRouterInterface {
         const t_conn_cost_params& cost_params,
         const t_bb& bounding_box);
 
+    // Calls fn with the t_router_features matching the current configuration of
+    // the router, e.g.
+    //
+    //    dispatch_router_features([&](auto features) {
+    //        return timing_driven_route_connection_from_heap<decltype(features)>(...);
+    //    });
+    template<typename Fn>
+    decltype(auto) dispatch_router_features(Fn&& fn) {
+        if (rcv_path_manager.is_enabled()) {
+            //RCV costs nodes with get_expected_delay_and_cong(), so the lookahead type does not matter
+            if (is_flat_) {
+                return fn(t_router_features<true, true, RouterLookahead>());
+            }
+            return fn(t_router_features<true, false, RouterLookahead>());
+        }
+        if (use_map_lookahead_) {
+            if (is_flat_) {
+                return fn(t_router_features<false, true, MapLookahead>());
+            }
+            return fn(t_router_features<false, false, MapLookahead>());
+        }
+        if (is_flat_) {
+            return fn(t_router_features<false, true, RouterLookahead>());
+        }
+        return fn(t_router_features<false, false, RouterLookahead>());
+    }
+
     // Finds a path to sink_node, starting from the elements currently in the
     // heap.
     //
@@ -174,12 +282,14 @@ class ConnectionRouter : public ConnectionRouterInterface {
     //
     // Returns either the last element of the path, or nullptr if no path is
     // found
+    template<typename Features>
     t_heap* timing_driven_route_connection_from_heap(
         RRNodeId sink_node,
         const t_conn_cost_params& cost_params,
         const t_bb& bounding_box);
 
     // Expand this current node if it is a cheaper path.
+    template<typename Features>
     void timing_driven_expand_cheapest(
         t_heap* cheapest,
         RRNodeId target_node,
@@ -188,6 +298,7 @@ class ConnectionRouter : public ConnectionRouterInterface {
         const t_bb& target_bb);
 
     // Expand each neighbor of the current node.
+    template<typename Features>
     void timing_driven_expand_neighbours(
         t_heap* current,
         const t_conn_cost_params& cost_params,
@@ -200,6 +311,7 @@ class ConnectionRouter : public ConnectionRouterInterface {
     //
     // RR nodes outside bounding box specified in bounding_box are not added
     // to the heap.
+    template<typename Features>
     void timing_driven_expand_neighbour(
         t_heap* current,
         RRNodeId from_node,
@@ -212,6 +324,7 @@ class ConnectionRouter : public ConnectionRouterInterface {
 
     // Add to_node to the heap, and also add any nodes which are connected by
     // non-configurable edges
+    template<typename Features>
     void timing_driven_add_to_heap(
         const t_conn_cost_params& cost_params,
         const t_heap* current,
@@ -221,6 +334,7 @@ class ConnectionRouter : public ConnectionRouterInterface {
         RRNodeId target_node);
 
     // Calculates the cost of reaching to_node
+    template<typename Features>
     void evaluate_timing_driven_node_costs(
         t_heap* to,
         const t_conn_cost_params& cost_params,
@@ -229,7 +343,30 @@ class ConnectionRouter : public ConnectionRouterInterface {
         RREdgeId from_edge,
         RRNodeId target_node);
 
+    // Cost of using from_edge to reach to_node in the bidirectional search,
+    // which (unlike evaluate_timing_driven_node_costs) does not depend on the
+    // path used to reach from_node
+    float bidirectional_edge_cost(const t_conn_cost_params& cost_params,
+                                  RRNodeId from_node,
+                                  RREdgeId from_edge,
+                                  RRNodeId to_node) const;
+
+    // Returns expected_cost, the lookahead's estimate of the cost from node to
+    // target_node, scaled by the lookahead correction for wires
+    float corrected_expected_cost(RRNodeId node, RRNodeId target_node, float expected_cost) const;
+
+    // Records the lookahead estimates from the wires of the path found to
+    // sink_node against their actual costs to it (in router_stats_), for the
+    // next update of the lookahead correction
+    void record_lookahead_samples(RRNodeId sink_node, const t_conn_cost_params& cost_params);
+
+    // Returns the region of the device a search must reach to leave (for a
+    // SOURCE) or enter (for a SINK) node: its whole tile for SOURCEs and
+    // SINKs, and its own extent otherwise
+    t_bb get_node_tile_bb(RRNodeId node) const;
+
     // Find paths from current heap to all nodes in the RR graph
+    template<typename Features>
     vtr::vector<RRNodeId, t_heap> timing_driven_find_all_shortest_paths_from_heap(
         const t_conn_cost_params& cost_params,
         const t_bb& bounding_box);
@@ -268,17 +405,27 @@ class ConnectionRouter : public ConnectionRouterInterface {
         const SpatialRouteTreeLookup& spatial_route_tree_lookup,
         const t_bb& net_bounding_box);
 
+    static std::vector<t_router_switch_cost> make_switch_costs(const vtr::vector<RRSwitchId, t_rr_switch_inf>& rr_switch_inf) {
+        std::vector<t_router_switch_cost> switch_costs;
+        switch_costs.reserve(rr_switch_inf.size());
+        for (const t_rr_switch_inf& switch_inf : rr_switch_inf) {
+            switch_costs.push_back({switch_inf.R, switch_inf.Tdel, switch_inf.Cinternal, switch_inf.buffered(), switch_inf.configurable()});
+        }
+        return switch_costs;
+    }
+
     const DeviceGrid& grid_;
     const RouterLookahead& router_lookahead_;
     const t_rr_graph_view rr_nodes_;
     const RRGraphView* rr_graph_;
     vtr::array_view<const t_rr_rc_data> rr_rc_data_;
-    vtr::array_view<const t_rr_switch_inf> rr_switch_inf_;
+    std::vector<t_router_switch_cost> switch_costs_; // [0..num_rr_switches-1], see t_router_switch_cost
     const vtr::vector<ParentNetId, std::vector<std::vector<int>>>& net_terminal_groups;
     const vtr::vector<ParentNetId, std::vector<int>>& net_terminal_group_num;
     vtr::vector<RRNodeId, t_rr_node_route_inf>& rr_node_route_inf_;
     bool is_flat_;
     std::vector<RRNodeId> modified_rr_node_inf_;
+    std::vector<RRNodeId> expansion_to_nodes_; // Destinations of the edges of the node being expanded (see timing_driven_expand_neighbours)
     RouterStats* router_stats_;
     const ConnectionParameters* conn_params_;
     HeapImplementation heap_;
@@ -286,8 +433,24 @@ class ConnectionRouter : public ConnectionRouterInterface {
 
     bool only_opin_inter_layer;
 
+    // Whether router_lookahead_ is a MapLookahead (see t_router_features)
+    bool use_map_lookahead_;
+
+    // Scales the expected costs of wires when enabled (only updated between routing iterations)
+    const LookaheadCorrection& lookahead_correction_;
+
     // The path manager for RCV, keeps track of the route tree as a set, also manages the allocation of the heap types
     PathManager rcv_path_manager;
+
+    // Backward search state of timing_driven_route_connection_bidirectional(): the cost
+    // from each node to the sink, and the edge leaving the node on that path
+    vtr::vector<RRNodeId, float> bidir_cost_to_sink_;
+    vtr::vector<RRNodeId, RREdgeId> bidir_next_edge_;
+    std::vector<RRNodeId> bidir_modified_nodes_;
+
+    // Fan-in of the clock networks for timing_driven_route_connection_through_clock_network(),
+    // built on first use (shared, so that routers stay copyable)
+    std::shared_ptr<const ClockNetworkFanin> clock_network_fanin_;
 };
 
 /** Construct a connection router that uses the specified heap type.
@@ -82,6 +82,24 @@ class ConnectionRouterInterface {
         const ConnectionParameters& conn_params)
         = 0;
 
+    /** Finds a path from the route tree to sink_node through the dedicated
+     * clock networks only (see ClockNetworkFanin).
+     *
+     * This is used for the sinks of global nets which have been pre-routed to
+     * the root of a clock network. Unlike the other searches, not finding a
+     * path is not an error: the caller then falls back to a general search.
+     *
+     * Returns a tuple of:
+     * bool: path exists through the clock networks?
+     * bool: should retry with full bounding box? (always false)
+     * t_heap: heap element of cheapest path */
+    virtual std::tuple<bool, bool, t_heap> timing_driven_route_connection_through_clock_network(
+        const RouteTree& tree,
+        RRNodeId sink_node,
+        const t_conn_cost_params& cost_params,
+        RouterStats& router_stats)
+        = 0;
+
     // Finds a path from the route tree rooted at rt_root to all sinks
     // available.
     //
@@ -112,6 +130,10 @@ class ConnectionRouterInterface {
     //
     // Ensure route budgets have been calculated before enabling this
     virtual void set_rcv_enabled(bool enable) = 0;
+
+    // Returns the search state the paths found are recorded in, to trace
+    // them back from the sink (see RouteTree::update_from_heap)
+    virtual const vtr::vector<RRNodeId, t_rr_node_route_inf>& get_rr_node_route_inf() const = 0;
 };
 
 #endif /* _CONNECTION_ROUTER_INTERFACE_H */
@@ -0,0 +1,256 @@
+#include "eight_ary_heap.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "rr_graph_fwd.h"
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+EightAryHeap::EightAryHeap()
+    : lines_(1)
+    , heap_tail_(ROOT)
+    , max_index_(std::numeric_limits<size_t>::max())
+    , prune_limit_(std::numeric_limits<size_t>::max()) {}
+
+EightAryHeap::~EightAryHeap() {
+    free_all_memory();
+}
+
+t_heap* EightAryHeap::alloc() {
+    return storage_.alloc();
+}
+
+void EightAryHeap::free(t_heap* hptr) {
+    storage_.free(hptr);
+}
+
+void EightAryHeap::init_heap(const DeviceGrid& grid) {
+    empty_heap();
+
+    size_t target_heap_size = (grid.width() - 1) * (grid.height() - 1);
+    size_t target_num_lines = (ROOT + target_heap_size) / 8 + 1;
+    if (lines_.size() < target_num_lines) {
+        lines_.resize(target_num_lines);
+    }
+}
+
+inline uint32_t EightAryHeap::acquire_slot(t_heap* hptr) {
+    uint32_t slot;
+    if (free_slots_.empty()) {
+        slot = slots_.size();
+        slots_.push_back(hptr);
+    } else {
+        slot = free_slots_.back();
+        free_slots_.pop_back();
+        slots_[slot] = hptr;
+    }
+    return slot;
+}
+
+inline t_heap* EightAryHeap::release_slot(uint32_t slot) {
+    t_heap* hptr = slots_[slot];
+    slots_[slot] = nullptr;
+    free_slots_.push_back(slot);
+    return hptr;
+}
+
+inline void EightAryHeap::expand_heap_if_full() {
+    if (heap_tail_ >= lines_.size() * 8) { /* Heap is full */
+        lines_.resize(lines_.size() * 2);
+    }
+}
+
+void EightAryHeap::add_to_heap(t_heap* hptr) {
+    expand_heap_if_full();
+    // start with undefined hole
+    ++heap_tail_;
+    sift_up(heap_tail_ - 1, {hptr->cost, acquire_slot(hptr)});
+
+    // If we have pruned, rebuild the heap now.
+    if (check_prune_limit()) {
+        build_heap();
+    }
+}
+
+// adds an element to the back of heap and expand if necessary, but does not maintain heap property
+void EightAryHeap::push_back(t_heap* const hptr) {
+    expand_heap_if_full();
+
+    elem(heap_tail_) = {hptr->cost, acquire_slot(hptr)};
+    ++heap_tail_;
+
+    check_prune_limit();
+}
+
+void EightAryHeap::build_heap() {
+    if (heap_tail_ <= ROOT + 1) {
+        return;
+    }
+
+    for (size_t i = parent(heap_tail_ - 1); i >= ROOT; --i) {
+        sift_down(i);
+    }
+}
+
+t_heap* EightAryHeap::get_heap_head() {
+    /* Returns a pointer to the smallest element on the heap, or NULL if the     *
+     * heap is empty.  Invalid (index == OPEN) entries on the heap are never     *
+     * returned -- they are just skipped over.                                   */
+
+    t_heap* cheapest;
+
+    do {
+        if (heap_tail_ == ROOT) { /* Empty heap. */
+            VTR_LOG_WARN("Empty heap occurred in get_heap_head.\n");
+            return (nullptr);
+        }
+
+        cheapest = release_slot(elem(ROOT).slot);
+
+        --heap_tail_;
+        if (heap_tail_ > ROOT) {
+            elem(ROOT) = elem(heap_tail_);
+            sift_down(ROOT);
+        }
+    } while (!cheapest->index.is_valid()); /* Get another one if invalid entry. */
+
+    return (cheapest);
+}
+
+bool EightAryHeap::is_empty_heap() const {
+    return heap_tail_ == ROOT;
+}
+
+bool EightAryHeap::is_valid() const {
+    for (size_t i = ROOT; i < heap_tail_; ++i) {
+        if (slots_[elem(i).slot] == nullptr) {
+            return false;
+        }
+
+        if (i > ROOT && elem(i).cost < elem(parent(i)).cost) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void EightAryHeap::empty_heap() {
+    for (size_t i = ROOT; i < heap_tail_; i++) {
+        free(slots_[elem(i).slot]);
+    }
+
+    heap_tail_ = ROOT;
+    slots_.clear();
+    free_slots_.clear();
+}
+
+void EightAryHeap::free_all_memory() {
+    empty_heap();
+
+    vtr::release_memory(slots_);
+    vtr::release_memory(free_slots_);
+    lines_.resize(1);
+    lines_.shrink_to_fit();
+
+    storage_.free_all_memory();
+}
+
+void EightAryHeap::set_prune_limit(size_t max_index, size_t prune_limit) {
+    if (prune_limit != std::numeric_limits<size_t>::max()) {
+        VTR_ASSERT(max_index < prune_limit);
+    }
+    max_index_ = max_index;
+    prune_limit_ = prune_limit;
+}
+
+void EightAryHeap::sift_up(size_t leaf, heap_elem node) {
+    while (leaf > ROOT && node.cost < elem(parent(leaf)).cost) {
+        // sift hole up
+        elem(leaf) = elem(parent(leaf));
+        leaf = parent(leaf);
+    }
+
+    elem(leaf) = node;
+}
+
+// make a heap rooted at index hole by **sifting down** in O(log8(n)) time
+void EightAryHeap::sift_down(size_t hole) {
+    heap_elem head = elem(hole);
+    size_t child = smallest_child(hole);
+
+    while (child < heap_tail_ && elem(child).cost < head.cost) {
+        elem(hole) = elem(child);
+        hole = child;
+        child = smallest_child(hole);
+    }
+
+    elem(hole) = head;
+}
+
+inline size_t EightAryHeap::smallest_child(size_t i) const {
+    const size_t first = first_child(i);
+    if (first >= heap_tail_) {
+        return first;
+    }
+
+    // All the children are on the cache line of the first one
+    const heap_elem* children = &elem(first);
+    const size_t num_children = std::min<size_t>(8, heap_tail_ - first);
+
+    size_t best = 0;
+    for (size_t j = 1; j < num_children; ++j) {
+        if (children[j].cost < children[best].cost) {
+            best = j;
+        }
+    }
+    return first + best;
+}
+
+bool EightAryHeap::check_prune_limit() {
+    if (size() >= prune_limit_) {
+        prune_heap();
+        return true;
+    }
+
+    return false;
+}
+
+void EightAryHeap::prune_heap() {
+    VTR_ASSERT(max_index_ < prune_limit_);
+
+    // Find the cheapest instance of each index, and free all the others
+    constexpr uint32_t NO_SLOT = std::numeric_limits<uint32_t>::max();
+    std::vector<heap_elem> best_heap_item(max_index_, {0., NO_SLOT});
+
+    for (size_t i = ROOT; i < heap_tail_; i++) {
+        const heap_elem& item = elem(i);
+        t_heap* hptr = slots_[item.slot];
+
+        if (!hptr->index.is_valid()) {
+            free(release_slot(item.slot));
+            continue;
+        }
+
+        auto idx = size_t(hptr->index);
+        VTR_ASSERT(idx < max_index_);
+
+        heap_elem& best = best_heap_item[idx];
+        if (best.slot == NO_SLOT) {
+            best = item;
+        } else if (best.cost > item.cost) {
+            free(release_slot(best.slot));
+            best = item;
+        } else {
+            free(release_slot(item.slot));
+        }
+    }
+
+    heap_tail_ = ROOT;
+    for (const heap_elem& best : best_heap_item) {
+        if (best.slot != NO_SLOT) {
+            elem(heap_tail_++) = best;
+        }
+    }
+}
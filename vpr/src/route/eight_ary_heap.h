@@ -0,0 +1,115 @@
+#ifndef VTR_EIGHT_ARY_HEAP_H
+#define VTR_EIGHT_ARY_HEAP_H
+
+#include "heap_type.h"
+#include "vtr_memory.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Minheap with 8 child nodes per parent, whose elements are only 8 bytes.
+ *
+ * @details
+ * Unlike the KAryHeap children, whose heap_elem holds a t_heap pointer (12 bytes, 16 once
+ * padded), the elements of this heap are a float cost and a 32-bit slot. A slot is the index
+ * of the t_heap pointer in a side array (slots_), so sifting only moves 8-byte elements and
+ * never touches the t_heap it refers to. The t_heap is only dereferenced when the element is
+ * popped. Slots are recycled through a free list, so slots_ does not grow past the largest
+ * number of elements in the heap.
+ *
+ * Eight elements fit on a cache line. The root is stored at index 7 so that the 8 children of
+ * node p (at indices 8 * (p - 6) to 8 * (p - 6) + 7) always are a single, aligned, cache line:
+ * finding the smallest child of a node costs one cache miss, while the tree is a third of the
+ * depth of a BinaryHeap.
+ */
+class EightAryHeap : public HeapInterface {
+  public:
+    EightAryHeap();
+    ~EightAryHeap();
+
+    t_heap* alloc() final;
+    void free(t_heap* hptr) final;
+
+    void init_heap(const DeviceGrid& grid) final;
+    void add_to_heap(t_heap* hptr) final;
+    void push_back(t_heap* const hptr) final;
+    void build_heap() final;
+    t_heap* get_heap_head() final;
+    bool is_empty_heap() const final;
+    bool is_valid() const final;
+    void empty_heap() final;
+    void free_all_memory() final;
+    void set_prune_limit(size_t max_index, size_t prune_limit) final;
+
+  private:
+    ///@brief Index of the root of the heap (the indices before it are unused)
+    static constexpr size_t ROOT = 7;
+
+    struct heap_elem {
+        float cost;
+        uint32_t slot;
+    };
+    static_assert(sizeof(heap_elem) == 8, "Eight heap elements should fit on a cache line");
+
+    ///@brief The 8 elements of a cache line (so that aligned_allocator aligns the heap on cache lines)
+    struct alignas(64) heap_line {
+        heap_elem elems[8];
+    };
+
+    heap_elem& elem(size_t i) { return lines_[i >> 3].elems[i & 7]; }
+    const heap_elem& elem(size_t i) const { return lines_[i >> 3].elems[i & 7]; }
+
+    ///@brief The first of the 8 children of node i
+    static size_t first_child(size_t i) { return (i - 6) << 3; }
+
+    ///@brief The parent of node i (i > ROOT)
+    static size_t parent(size_t i) { return (i >> 3) + 6; }
+
+    ///@brief Number of elements in the heap
+    size_t size() const { return heap_tail_ - ROOT; }
+
+    ///@brief Stores hptr in a free slot, and returns the slot
+    uint32_t acquire_slot(t_heap* hptr);
+
+    ///@brief Returns the t_heap of slot, and frees the slot
+    t_heap* release_slot(uint32_t slot);
+
+    ///@brief Makes room for one more element at heap_tail_
+    void expand_heap_if_full();
+
+    ///@brief Moves node up from the hole at leaf until it satisfies the minheap property
+    void sift_up(size_t leaf, heap_elem node);
+
+    ///@brief Moves the node at hole down until it satisfies the minheap property
+    void sift_down(size_t hole);
+
+    /**
+     * @return The child node of i with the smallest cost. Returns the first child of i if i has
+     * no children.
+     */
+    size_t smallest_child(size_t i) const;
+
+    /**
+     * @brief If the size of the heap is greater than the prune limit, prune the heap.
+     *
+     * @return Whether the heap was pruned.
+     */
+    bool check_prune_limit();
+
+    ///@brief Keeps only the cheapest element of each index (and drops invalid elements)
+    void prune_heap();
+
+    HeapStorage storage_;
+
+    std::vector<heap_line, vtr::aligned_allocator<heap_line>> lines_;
+    size_t heap_tail_; /* Index of first unused slot in the heap array */
+
+    ///@brief The t_heap of each slot (nullptr if the slot is free), and the free slots
+    std::vector<t_heap*> slots_;
+    std::vector<uint32_t> free_slots_;
+
+    size_t max_index_;
+    size_t prune_limit_;
+};
+
+#endif //VTR_EIGHT_ARY_HEAP_H
@@ -0,0 +1,357 @@
+#include "global_route.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+
+#include "globals.h"
+#include "route_net.h"
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+namespace {
+
+//Congestion costs of the gcell edges, relative to the base cost (1) of crossing an edge
+constexpr float INITIAL_PRES_FAC = 0.5;
+constexpr float PRES_FAC_MULT = 2.;
+constexpr float HIST_FAC = 0.5;
+
+constexpr int NOT_IN_TREE = -2;
+constexpr int TREE_ROOT = -1;
+
+///@brief Grid graph of the gcells, with the capacity, use and congestion history of each edge
+class GCellGraph {
+  public:
+    GCellGraph(int grid_width, int grid_height, const std::vector<int>& x_chan_widths, const std::vector<int>& y_chan_widths)
+        : width_((grid_width + GlobalRouteGuides::GCELL_SIZE - 1) / GlobalRouteGuides::GCELL_SIZE)
+        , height_((grid_height + GlobalRouteGuides::GCELL_SIZE - 1) / GlobalRouteGuides::GCELL_SIZE)
+        , edges_(2 * width_ * height_) {
+        constexpr int G = GlobalRouteGuides::GCELL_SIZE;
+        for (int x = 0; x < width_; ++x) {
+            for (int y = 0; y < height_; ++y) {
+                //The horizontal wires of the gcell's rows cross to the gcell on the right,
+                //the vertical wires of its columns to the gcell above
+                if (x + 1 < width_) {
+                    for (int tile_y = y * G; tile_y < std::min(grid_height, (y + 1) * G); ++tile_y) {
+                        edges_[2 * cell(x, y)].capacity += x_chan_widths[tile_y];
+                    }
+                }
+                if (y + 1 < height_) {
+                    for (int tile_x = x * G; tile_x < std::min(grid_width, (x + 1) * G); ++tile_x) {
+                        edges_[2 * cell(x, y) + 1].capacity += y_chan_widths[tile_x];
+                    }
+                }
+            }
+        }
+    }
+
+    int width() const { return width_; }
+    int height() const { return height_; }
+
+    int cell(int x, int y) const { return x * height_ + y; }
+
+    ///@brief Returns the edge between two adjacent gcells: 2 * cell + 0 to the gcell on its right, + 1 to the one above
+    int edge_between(int from, int to) const {
+        int lower = std::min(from, to);
+        return 2 * lower + (std::abs(to - from) == height_ ? 0 : 1);
+    }
+
+    float edge_cost(int edge, float pres_fac) const {
+        const t_edge& e = edges_[edge];
+        int overuse = std::max(0, e.use + 1 - e.capacity);
+        return (1. + HIST_FAC * e.history) * (1. + pres_fac * overuse);
+    }
+
+    bool is_overused(int edge) const { return edges_[edge].use > edges_[edge].capacity; }
+
+    void add_use(int edge, int delta) { edges_[edge].use += delta; }
+
+    ///@brief Adds the overuse of each edge to its history, returning the number of overused edges
+    size_t update_history() {
+        size_t num_overused = 0;
+        for (t_edge& e : edges_) {
+            if (e.use > e.capacity) {
+                e.history += e.use - e.capacity;
+                ++num_overused;
+            }
+        }
+        return num_overused;
+    }
+
+  private:
+    struct t_edge {
+        int capacity = 0;
+        int use = 0; //Number of nets crossing the edge
+        float history = 0.;
+    };
+
+    int width_;
+    int height_;
+    std::vector<t_edge> edges_;
+};
+
+///@brief Routes the nets as trees of gcells, and derives the corridors of their connections
+class GCellRouter {
+  public:
+    explicit GCellRouter(GCellGraph& graph)
+        : graph_(graph) {}
+
+    /**
+     * @brief Routes a net from its driver to each of its sinks in turn, within the gcells
+     *        of its pins grown by one, recording the edges it uses in net_edges and the
+     *        corridor of each connection in corridors
+     */
+    void route_net(const std::vector<vtr::Point<int>>& pin_locs,
+                   int grid_width,
+                   int grid_height,
+                   float pres_fac,
+                   std::vector<int>& net_edges,
+                   std::vector<t_bb>& corridors) {
+        constexpr int G = GlobalRouteGuides::GCELL_SIZE;
+
+        for (int edge : net_edges) {
+            graph_.add_use(edge, -1);
+        }
+        net_edges.clear();
+
+        pin_cells_.clear();
+        int xmin = graph_.width(), xmax = 0, ymin = graph_.height(), ymax = 0;
+        for (const vtr::Point<int>& loc : pin_locs) {
+            int x = std::clamp(loc.x() / G, 0, graph_.width() - 1);
+            int y = std::clamp(loc.y() / G, 0, graph_.height() - 1);
+            pin_cells_.emplace_back(x, y);
+            xmin = std::min(xmin, x);
+            xmax = std::max(xmax, x);
+            ymin = std::min(ymin, y);
+            ymax = std::max(ymax, y);
+        }
+        bb_xmin_ = std::max(0, xmin - 1);
+        bb_ymin_ = std::max(0, ymin - 1);
+        bb_width_ = std::min(graph_.width() - 1, xmax + 1) - bb_xmin_ + 1;
+        bb_height_ = std::min(graph_.height() - 1, ymax + 1) - bb_ymin_ + 1;
+        size_t bb_size = size_t(bb_width_) * bb_height_;
+
+        //The search is over the gcells of the net bounding box, indexed locally
+        parent_.assign(bb_size, NOT_IN_TREE);
+        tree_cells_.clear();
+        int source = local_cell(pin_cells_[0]);
+        parent_[source] = TREE_ROOT;
+        tree_cells_.push_back(source);
+
+        //Closer sinks first, so that the farther ones branch off their routes
+        sink_order_.clear();
+        for (size_t ipin = 1; ipin < pin_locs.size(); ++ipin) {
+            sink_order_.push_back(ipin);
+        }
+        std::stable_sort(sink_order_.begin(), sink_order_.end(), [&](int lhs, int rhs) {
+            return distance(pin_cells_[lhs], pin_cells_[0]) < distance(pin_cells_[rhs], pin_cells_[0]);
+        });
+
+        corridors.assign(pin_locs.size(), t_bb());
+        for (int ipin : sink_order_) {
+            int target = local_cell(pin_cells_[ipin]);
+            if (parent_[target] == NOT_IN_TREE) {
+                route_to(target, pres_fac, net_edges);
+            }
+
+            //The corridor spans the gcells from the sink back to the source
+            int cxmin = graph_.width(), cxmax = 0, cymin = graph_.height(), cymax = 0;
+            for (int c = target; c != TREE_ROOT; c = parent_[c]) {
+                int x = bb_xmin_ + c / bb_height_;
+                int y = bb_ymin_ + c % bb_height_;
+                cxmin = std::min(cxmin, x);
+                cxmax = std::max(cxmax, x);
+                cymin = std::min(cymin, y);
+                cymax = std::max(cymax, y);
+            }
+            constexpr int M = GlobalRouteGuides::CORRIDOR_MARGIN;
+            t_bb& corridor = corridors[ipin];
+            corridor.xmin = std::max(0, (cxmin - M) * G);
+            corridor.xmax = std::min(grid_width - 1, (cxmax + M + 1) * G - 1);
+            corridor.ymin = std::max(0, (cymin - M) * G);
+            corridor.ymax = std::min(grid_height - 1, (cymax + M + 1) * G - 1);
+        }
+    }
+
+  private:
+    int local_cell(const std::pair<int, int>& xy) const {
+        return (xy.first - bb_xmin_) * bb_height_ + (xy.second - bb_ymin_);
+    }
+
+    static int distance(const std::pair<int, int>& a, const std::pair<int, int>& b) {
+        return std::abs(a.first - b.first) + std::abs(a.second - b.second);
+    }
+
+    ///@brief A* search from the net's tree to target, adding the path found to the tree
+    void route_to(int target, float pres_fac, std::vector<int>& net_edges) {
+        const int target_x = target / bb_height_;
+        const int target_y = target % bb_height_;
+        //Each edge costs at least 1, so the Manhattan distance never over-estimates
+        auto heuristic = [&](int c) {
+            return float(std::abs(c / bb_height_ - target_x) + std::abs(c % bb_height_ - target_y));
+        };
+
+        cost_.assign(parent_.size(), std::numeric_limits<float>::infinity());
+        prev_.assign(parent_.size(), NOT_IN_TREE);
+        std::priority_queue<std::pair<float, int>, std::vector<std::pair<float, int>>, std::greater<>> heap;
+        for (int c : tree_cells_) {
+            cost_[c] = 0.;
+            heap.emplace(heuristic(c), c);
+        }
+
+        while (!heap.empty()) {
+            auto [f, c] = heap.top();
+            heap.pop();
+            if (c == target) break;
+            float g = cost_[c];
+            if (f > g + heuristic(c)) continue; //Stale entry
+
+            int x = c / bb_height_;
+            int y = c % bb_height_;
+            int global = graph_.cell(bb_xmin_ + x, bb_ymin_ + y);
+            auto expand = [&](int nx, int ny) {
+                if (nx < 0 || nx >= bb_width_ || ny < 0 || ny >= bb_height_) return;
+                int n = nx * bb_height_ + ny;
+                int edge = graph_.edge_between(global, graph_.cell(bb_xmin_ + nx, bb_ymin_ + ny));
+                float new_cost = g + graph_.edge_cost(edge, pres_fac);
+                if (new_cost < cost_[n]) {
+                    cost_[n] = new_cost;
+                    prev_[n] = c;
+                    heap.emplace(new_cost + heuristic(n), n);
+                }
+            };
+            expand(x + 1, y);
+            expand(x - 1, y);
+            expand(x, y + 1);
+            expand(x, y - 1);
+        }
+        //The bounding box is a full grid, so the target is always reached
+        VTR_ASSERT(prev_[target] != NOT_IN_TREE);
+
+        for (int c = target; parent_[c] == NOT_IN_TREE; c = prev_[c]) {
+            parent_[c] = prev_[c];
+            tree_cells_.push_back(c);
+
+            int from = graph_.cell(bb_xmin_ + c / bb_height_, bb_ymin_ + c % bb_height_);
+            int to = graph_.cell(bb_xmin_ + prev_[c] / bb_height_, bb_ymin_ + prev_[c] % bb_height_);
+            int edge = graph_.edge_between(from, to);
+            graph_.add_use(edge, 1);
+            net_edges.push_back(edge);
+        }
+    }
+
+    GCellGraph& graph_;
+
+    //Bounding box of the net being routed, in gcells
+    int bb_xmin_ = 0;
+    int bb_ymin_ = 0;
+    int bb_width_ = 0;
+    int bb_height_ = 0;
+
+    //Scratch buffers, reused across nets
+    std::vector<std::pair<int, int>> pin_cells_;
+    std::vector<int> sink_order_;
+    std::vector<int> parent_; //[local cell] Parent in the net's tree, or NOT_IN_TREE/TREE_ROOT
+    std::vector<int> tree_cells_;
+    std::vector<float> cost_;
+    std::vector<int> prev_;
+};
+
+} // namespace
+
+void GlobalRouteGuides::compute(int grid_width,
+                                int grid_height,
+                                const std::vector<int>& x_chan_widths,
+                                const std::vector<int>& y_chan_widths,
+                                const vtr::vector<ParentNetId, std::vector<vtr::Point<int>>>& net_pin_locs) {
+    VTR_ASSERT(x_chan_widths.size() == size_t(grid_height));
+    VTR_ASSERT(y_chan_widths.size() == size_t(grid_width));
+
+    GCellGraph graph(grid_width, grid_height, x_chan_widths, y_chan_widths);
+    GCellRouter router(graph);
+
+    //Smaller nets first, so that the larger ones go around them
+    std::vector<ParentNetId> net_order;
+    for (size_t inet = 0; inet < net_pin_locs.size(); ++inet) {
+        if (net_pin_locs[ParentNetId(inet)].size() > 1) {
+            net_order.push_back(ParentNetId(inet));
+        }
+    }
+    auto half_perimeter = [&](ParentNetId net_id) {
+        const auto& locs = net_pin_locs[net_id];
+        auto [xmin, xmax] = std::minmax_element(locs.begin(), locs.end(), [](const auto& a, const auto& b) { return a.x() < b.x(); });
+        auto [ymin, ymax] = std::minmax_element(locs.begin(), locs.end(), [](const auto& a, const auto& b) { return a.y() < b.y(); });
+        return (xmax->x() - xmin->x()) + (ymax->y() - ymin->y());
+    };
+    std::stable_sort(net_order.begin(), net_order.end(), [&](ParentNetId lhs, ParentNetId rhs) {
+        return half_perimeter(lhs) < half_perimeter(rhs);
+    });
+
+    connection_bbs_.clear();
+    connection_bbs_.resize(net_pin_locs.size());
+    vtr::vector<ParentNetId, std::vector<int>> net_edges(net_pin_locs.size());
+
+    //Negotiated congestion: after the first iteration, only the nets crossing overused edges are rerouted
+    float pres_fac = 0.;
+    num_overused_edges_ = 0;
+    for (int iter = 0; iter < NUM_ITERATIONS; ++iter) {
+        for (ParentNetId net_id : net_order) {
+            bool reroute = (iter == 0)
+                           || std::any_of(net_edges[net_id].begin(), net_edges[net_id].end(), [&](int edge) {
+                                  return graph.is_overused(edge);
+                              });
+            if (reroute) {
+                router.route_net(net_pin_locs[net_id], grid_width, grid_height, pres_fac, net_edges[net_id], connection_bbs_[net_id]);
+            }
+        }
+
+        num_overused_edges_ = graph.update_history();
+        if (num_overused_edges_ == 0) break;
+
+        pres_fac = (iter == 0) ? INITIAL_PRES_FAC : pres_fac * PRES_FAC_MULT;
+    }
+}
+
+void GlobalRouteGuides::clear() {
+    connection_bbs_.clear();
+    num_overused_edges_ = 0;
+}
+
+const t_bb* GlobalRouteGuides::connection_bb(ParentNetId net_id, int ipin) const {
+    if (size_t(net_id) >= connection_bbs_.size()) return nullptr;
+
+    const std::vector<t_bb>& net_bbs = connection_bbs_[net_id];
+    if (size_t(ipin) >= net_bbs.size() || net_bbs[ipin].xmin == OPEN) return nullptr;
+    return &net_bbs[ipin];
+}
+
+void compute_global_route_guides(const Netlist<>& net_list, int high_fanout_threshold) {
+    vtr::ScopedStartFinishTimer timer("Global Routing");
+
+    const auto& device_ctx = g_vpr_ctx.device();
+    const auto& rr_graph = device_ctx.rr_graph;
+    auto& route_ctx = g_vpr_ctx.mutable_routing();
+
+    vtr::vector<ParentNetId, std::vector<vtr::Point<int>>> net_pin_locs(net_list.nets().size());
+    size_t num_connections = 0;
+    for (ParentNetId net_id : net_list.nets()) {
+        int fanout = net_list.net_sinks(net_id).size();
+        if (net_list.net_is_ignored(net_id) || is_high_fanout(fanout, high_fanout_threshold)) continue;
+
+        for (RRNodeId node : route_ctx.net_rr_terminals[net_id]) {
+            net_pin_locs[net_id].emplace_back(rr_graph.node_xlow(node), rr_graph.node_ylow(node));
+        }
+        num_connections += fanout;
+    }
+
+    route_ctx.global_route_guides.compute(device_ctx.grid.width(), device_ctx.grid.height(),
+                                          device_ctx.chan_width.x_list, device_ctx.chan_width.y_list,
+                                          net_pin_locs);
+
+    VTR_LOG("Global routing: %zu connections guided, %zu gcell edges left overused\n",
+            num_connections, route_ctx.global_route_guides.num_overused_edges());
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+/** @file Coarse global routing of the nets, guiding the first iteration of the detailed router.
+ *
+ * In its first iteration, PathFinder routes every connection with no congestion
+ * history, and on congested designs the connections pile up in the same channels
+ * before later iterations negotiate them apart. With --router_global_route_guides,
+ * the nets are first routed on a coarse grid graph, whose cells (gcells) are
+ * GCELL_SIZE x GCELL_SIZE tiles of the device and whose edges have the capacity of
+ * the channel wires crossing between two cells. A few negotiated congestion
+ * iterations on this small graph spread the nets out, and the gcells on the global
+ * route of each connection (from the net source to its sink), grown by
+ * CORRIDOR_MARGIN gcells, then bound the detailed search of the connection in the
+ * first iteration. Connections with no path within their corridor are routed
+ * within their net bounding box as usual.
+ */
+
+#include <cstddef>
+#include <vector>
+
+#include "netlist.h"
+#include "vpr_types.h"
+#include "vtr_geometry.h"
+#include "vtr_vector.h"
+
+///@brief Per-connection corridors from a global routing of the nets
+class GlobalRouteGuides {
+  public:
+    ///@brief Side of a global routing cell, in tiles
+    static constexpr int GCELL_SIZE = 4;
+
+    ///@brief Number of gcells by which the corridors are grown around the global routes
+    static constexpr int CORRIDOR_MARGIN = 1;
+
+    ///@brief Number of negotiated congestion iterations of the global router
+    static constexpr int NUM_ITERATIONS = 4;
+
+    /**
+     * @brief Global routes the nets, replacing any previous corridors
+     *
+     *   @param grid_width, grid_height Size of the device grid, in tiles
+     *   @param x_chan_widths Number of horizontal wires in the channel of each row of tiles [0..grid_height-1]
+     *   @param y_chan_widths Number of vertical wires in the channel of each column of tiles [0..grid_width-1]
+     *   @param net_pin_locs [net][ipin] Tile of each pin of each net, the driver first.
+     *                       Nets with no pins get no corridors.
+     */
+    void compute(int grid_width,
+                 int grid_height,
+                 const std::vector<int>& x_chan_widths,
+                 const std::vector<int>& y_chan_widths,
+                 const vtr::vector<ParentNetId, std::vector<vtr::Point<int>>>& net_pin_locs);
+
+    void clear();
+
+    bool is_enabled() const { return !connection_bbs_.empty(); }
+
+    /**
+     * @brief Returns the corridor of the connection to pin ipin of net_id, or nullptr if it has none
+     *
+     * The corridors are 2D: their layer range is OPEN, to be taken from the net bounding box.
+     */
+    const t_bb* connection_bb(ParentNetId net_id, int ipin) const;
+
+    ///@brief Returns the number of gcell edges still used beyond their capacity by the last compute()
+    size_t num_overused_edges() const { return num_overused_edges_; }
+
+  private:
+    //[net][ipin] Corridor of each connection, with an empty vector for the nets with no corridors
+    vtr::vector<ParentNetId, std::vector<t_bb>> connection_bbs_;
+
+    size_t num_overused_edges_ = 0;
+};
+
+/**
+ * @brief Global routes the nets of net_list on the current device and channel widths
+ *        into route_ctx.global_route_guides
+ *
+ * Ignored nets and nets with more than max_fanout sinks (which the router routes with
+ * its high fanout spatial lookup instead) get no corridors.
+ */
+void compute_global_route_guides(const Netlist<>& net_list, int max_fanout);
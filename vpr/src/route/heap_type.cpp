@@ -3,6 +3,8 @@
 #include "binary_heap.h"
 #include "four_ary_heap.h"
 #include "bucket.h"
+#include "radix_heap.h"
+#include "eight_ary_heap.h"
 #include "rr_graph_fwd.h"
 #include "vpr_error.h"
 #include "vpr_types.h"
@@ -67,6 +69,10 @@ std::unique_ptr<HeapInterface> make_heap(e_heap_type heap_type) {
             return std::make_unique<FourAryHeap>();
         case e_heap_type::BUCKET_HEAP_APPROXIMATION:
             return std::make_unique<Bucket>();
+        case e_heap_type::RADIX_HEAP:
+            return std::make_unique<RadixHeap>();
+        case e_heap_type::EIGHT_ARY_HEAP:
+            return std::make_unique<EightAryHeap>();
         default:
             VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Unknown heap_type %d", heap_type);
     }
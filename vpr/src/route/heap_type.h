@@ -267,6 +267,8 @@ enum class e_heap_type {
     BINARY_HEAP,
     FOUR_ARY_HEAP,
     BUCKET_HEAP_APPROXIMATION,
+    RADIX_HEAP,
+    EIGHT_ARY_HEAP,
 };
 
 /**
@@ -19,6 +19,8 @@
 #include "binary_heap.h"
 #include "four_ary_heap.h"
 #include "bucket.h"
+#include "radix_heap.h"
+#include "eight_ary_heap.h"
 #include "clustered_netlist_utils.h"
 #include "connection_based_routing_fwd.h"
 #include "connection_router.h"
@@ -42,6 +44,59 @@ struct RouteIterResults {
     std::vector<ParentNetId> rerouted_nets;
     /** RouterStats for this iteration */
     RouterStats stats;
+    /** Time each thread spent routing nets (only filled in by multi-threaded routers) */
+    std::vector<float> thread_busy_time;
+    /** Wall-clock time of the netlist routing run (only filled in by multi-threaded routers) */
+    float wall_time = 0.;
+
+    /** Add rhs's results to mine */
+    void combine(RouteIterResults& rhs) {
+        stats.combine(rhs.stats);
+        rerouted_nets.insert(rerouted_nets.end(), rhs.rerouted_nets.begin(), rhs.rerouted_nets.end());
+        is_routable &= rhs.is_routable;
+    }
+};
+
+/** RouteIterResults of each node of a PartitionTree, for the deterministic mode of the parallel
+ * routers (see t_router_opts::router_deterministic). The nets of a node are all routed by one task,
+ * into the node's own results, and the results of the nodes are combined in a fixed (pre-)order.
+ * Neither the order of the rerouted nets nor the floating-point sums of the stats then depend on
+ * which thread routed which node, or when. */
+class PartitionTreeResults {
+  public:
+    explicit PartitionTreeResults(PartitionTree& tree) {
+        add_node(tree.root());
+    }
+
+    /** Results of \p node. Can be called concurrently for different nodes. */
+    RouteIterResults& of(const PartitionTreeNode& node) {
+        return _results[_node_index.at(&node)];
+    }
+
+    /** Combine the results of all nodes, in pre-order */
+    RouteIterResults combine() {
+        RouteIterResults out;
+        for (auto& results : _results) {
+            out.combine(results);
+        }
+        return out;
+    }
+
+  private:
+    void add_node(const PartitionTreeNode& node) {
+        _node_index.emplace(&node, _results.size());
+        _results.emplace_back();
+        if (node.left && node.right) {
+            add_node(*node.left);
+            add_node(*node.right);
+        }
+        if (node.crossing) {
+            add_node(*node.crossing);
+        }
+    }
+
+    std::unordered_map<const PartitionTreeNode*, size_t> _node_index;
+    std::vector<RouteIterResults> _results;
 };
 
 /** Route a given netlist. Takes a big context and passes it around to net & sink routing fns.
@@ -196,6 +251,34 @@ inline std::unique_ptr<NetlistRouter> make_netlist_router(
             routing_predictor,
             choking_spots,
             is_flat);
+    } else if (router_opts.router_heap == e_heap_type::RADIX_HEAP) {
+        return make_netlist_router_with_heap<RadixHeap>(
+            net_list,
+            router_lookahead,
+            router_opts,
+            connections_inf,
+            net_delay,
+            netlist_pin_lookup,
+            timing_info,
+            pin_timing_invalidator,
+            budgeting_inf,
+            routing_predictor,
+            choking_spots,
+            is_flat);
+    } else if (router_opts.router_heap == e_heap_type::EIGHT_ARY_HEAP) {
+        return make_netlist_router_with_heap<EightAryHeap>(
+            net_list,
+            router_lookahead,
+            router_opts,
+            connections_inf,
+            net_delay,
+            netlist_pin_lookup,
+            timing_info,
+            pin_timing_invalidator,
+            budgeting_inf,
+            routing_predictor,
+            choking_spots,
+            is_flat);
     } else {
         VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Unknown heap type %d", router_opts.router_heap);
     }
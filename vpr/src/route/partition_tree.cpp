@@ -1,5 +1,6 @@
 #include "partition_tree.h"
 #include <cmath>
+#include <limits>
 #include <memory>
 
 /** Minimum number of nets inside a partition to continue further partitioning.
@@ -7,14 +8,114 @@
  * and the task creation overhead outweighs the advantage of partitioning, so we should stop. */
 constexpr size_t MIN_NETS_TO_PARTITION = 256;
 
-PartitionTree::PartitionTree(const Netlist<>& netlist) {
+/** Minimum number of nets inside a partition to split it further when it is heavier than the
+ * split cost. Expensive partitions are worth splitting below MIN_NETS_TO_PARTITION, but below
+ * this limit there is little left to spread across threads. */
+constexpr size_t MIN_NETS_TO_RESPLIT = 16;
+
+/** Weight each net by its fanout */
+static vtr::vector<ParentNetId, float> get_net_fanouts(const Netlist<>& netlist) {
+    vtr::vector<ParentNetId, float> fanouts(netlist.nets().size());
+    for (auto net_id : netlist.nets()) {
+        fanouts[net_id] = netlist.net_sinks(net_id).size();
+    }
+    return fanouts;
+}
+
+PartitionTree::PartitionTree(const Netlist<>& netlist, bool is_flat)
+    : PartitionTree(netlist, get_net_fanouts(netlist), std::numeric_limits<float>::infinity(), is_flat) {}
+
+PartitionTree::PartitionTree(const Netlist<>& netlist, const vtr::vector<ParentNetId, float>& net_costs, float split_cost, bool is_flat) {
     const auto& device_ctx = g_vpr_ctx.device();
+    const auto& grid = device_ctx.grid;
+
+    /* The SOURCE/SINK and intra-cluster RR nodes of a tile are located at its root (see inside_bb()),
+     * but its root-level pins are spread over the tile. A cutline through a tile would put the pins of one side and the intra-cluster
+     * nodes they lead to in different partitions: nets routed on the far side couldn't reach their sinks
+     * without leaving their (clipped) bounding box. So build a prefix count of the grid locations
+     * where a cutline would cross a tile and keep cutlines away from them. */
+    if (is_flat) {
+        int W = grid.width(), H = grid.height();
+        _x_tile_cuts.resize({size_t(std::max(W - 1, 0)), size_t(H + 1)}, 0);
+        _y_tile_cuts.resize({size_t(std::max(H - 1, 0)), size_t(W + 1)}, 0);
+        for (int layer = 0; layer < grid.get_num_layers(); layer++) {
+            for (int x = 0; x < W - 1; x++) {
+                for (int y = 0; y < H; y++) {
+                    _x_tile_cuts[x][y + 1] += (grid.get_width_offset({x + 1, y, layer}) > 0);
+                }
+            }
+            for (int y = 0; y < H - 1; y++) {
+                for (int x = 0; x < W; x++) {
+                    _y_tile_cuts[y][x + 1] += (grid.get_height_offset({x, y + 1, layer}) > 0);
+                }
+            }
+        }
+        for (int x = 0; x < W - 1; x++) {
+            for (int y = 0; y < H; y++) {
+                _x_tile_cuts[x][y + 1] += _x_tile_cuts[x][y];
+            }
+        }
+        for (int y = 0; y < H - 1; y++) {
+            for (int x = 0; x < W; x++) {
+                _y_tile_cuts[y][x + 1] += _y_tile_cuts[y][x];
+            }
+        }
+    }
 
     auto all_nets = std::vector<ParentNetId>(netlist.nets().begin(), netlist.nets().end());
-    _root = build_helper(netlist, all_nets, 0, 0, device_ctx.grid.width() - 1, device_ctx.grid.height() - 1);
+    _root = build_layer_helper(net_costs, split_cost, all_nets, 0, grid.get_num_layers() - 1);
+    if (!_root) /* Always make a root, even for an empty netlist */
+        _root = std::make_unique<PartitionTreeNode>();
+}
+
+std::unique_ptr<PartitionTreeNode> PartitionTree::build_layer_helper(const vtr::vector<ParentNetId, float>& net_costs, float split_cost, const std::vector<ParentNetId>& nets, int layer1, int layer2) {
+    const auto& device_ctx = g_vpr_ctx.device();
+    int x2 = device_ctx.grid.width() - 1, y2 = device_ctx.grid.height() - 1;
+    if (layer1 == layer2)
+        return build_helper(net_costs, split_cost, nets, 0, 0, x2, y2);
+
+    /* The routers keep each net within the layers of its bounding box, so nets on either side of a
+     * layer cutline never share routing resources, as for an x/y cutline */
+    const auto& route_ctx = g_vpr_ctx.routing();
+    int mid = (layer1 + layer2) / 2;
+    std::vector<ParentNetId> lower_nets, upper_nets, crossing_nets;
+    for (auto net_id : nets) {
+        const t_bb& bb = route_ctx.route_bb[net_id];
+        if (bb.layer_max <= mid) {
+            lower_nets.push_back(net_id);
+        } else if (bb.layer_min > mid) {
+            upper_nets.push_back(net_id);
+        } else {
+            crossing_nets.push_back(net_id);
+        }
+    }
+
+    /* Nothing to route in parallel on either side: partition the nets in x/y only */
+    if (lower_nets.empty() || upper_nets.empty())
+        return build_helper(net_costs, split_cost, nets, 0, 0, x2, y2);
+
+    auto out = std::make_unique<PartitionTreeNode>();
+    out->left = build_layer_helper(net_costs, split_cost, lower_nets, layer1, mid);
+    out->right = build_layer_helper(net_costs, split_cost, upper_nets, mid + 1, layer2);
+    out->crossing = build_helper(net_costs, split_cost, crossing_nets, 0, 0, x2, y2);
+    out->cutline_axis = Axis::LAYER;
+    out->cutline_pos = mid + 0.5;
+    return out;
+}
+
+bool PartitionTree::tile_cut_x(int x, int y1, int y2) const {
+    if (_x_tile_cuts.empty())
+        return false;
+    return _x_tile_cuts[x][y2 + 1] != _x_tile_cuts[x][y1];
+}
+
+bool PartitionTree::tile_cut_y(int y, int x1, int x2) const {
+    if (_y_tile_cuts.empty())
+        return false;
+    return _y_tile_cuts[y][x2 + 1] != _y_tile_cuts[y][x1];
 }
 
-std::unique_ptr<PartitionTreeNode> PartitionTree::build_helper(const Netlist<>& netlist, const std::vector<ParentNetId>& nets, int x1, int y1, int x2, int y2) {
+std::unique_ptr<PartitionTreeNode> PartitionTree::build_helper(const vtr::vector<ParentNetId, float>& net_costs, float split_cost, const std::vector<ParentNetId>& nets, int x1, int y1, int x2, int y2) {
     if (nets.empty())
         return nullptr;
 
@@ -22,8 +123,14 @@ std::unique_ptr<PartitionTreeNode> PartitionTree::build_helper(const Netlist<>&
     auto out = std::make_unique<PartitionTreeNode>();
 
     if (nets.size() < MIN_NETS_TO_PARTITION) {
-        out->nets = nets;
-        return out;
+        float cost = 0.;
+        for (auto net_id : nets) {
+            cost += net_costs[net_id];
+        }
+        if (nets.size() < MIN_NETS_TO_RESPLIT || cost <= split_cost) {
+            out->nets = nets;
+            return out;
+        }
     }
 
     /* Build ParaDRo-ish prefix sum lookup for each bin (coordinate) in the device.
@@ -35,7 +142,10 @@ std::unique_ptr<PartitionTreeNode> PartitionTree::build_helper(const Netlist<>&
     int width = x2 - x1 + 1;
     int height = y2 - y1 + 1;
 
-    VTR_ASSERT(width > 1 && height > 1);
+    if (width < 2 && height < 2) { /* Nowhere to put a cutline (possible for a small, heavy partition) */
+        out->nets = nets;
+        return out;
+    }
     /* Cutlines are placed between integral coordinates.
      * For instance, x_total_before[0] assumes a cutline at x=0.5, so fanouts at x=0 are included but not
      * x=1. It's similar for x_total_after[0], which excludes fanouts at x=0 and includes x=1.
@@ -43,12 +153,12 @@ std::unique_ptr<PartitionTreeNode> PartitionTree::build_helper(const Netlist<>&
      *
      * Here, *_total_before holds total score of nets before the cutline and not intersecting it.
      * In ParaDRo this would be total_before + total_on. (same for total_after)*/
-    std::vector<int> x_total_before(width - 1, 0), x_total_after(width - 1, 0), x_total_on(width - 1, 0);
-    std::vector<int> y_total_before(height - 1, 0), y_total_after(height - 1, 0), y_total_on(height - 1, 0);
+    std::vector<float> x_total_before(width - 1, 0), x_total_after(width - 1, 0), x_total_on(width - 1, 0);
+    std::vector<float> y_total_before(height - 1, 0), y_total_after(height - 1, 0), y_total_on(height - 1, 0);
 
     for (auto net_id : nets) {
         t_bb bb = route_ctx.route_bb[net_id];
-        size_t fanouts = netlist.net_sinks(net_id).size();
+        float cost = net_costs[net_id];
 
         /* Inclusive start and end coords of the bbox relative to x1. Clamp to [x1, x2]. */
         int x_start = std::max(x1, bb.xmin) - x1;
@@ -57,38 +167,40 @@ std::unique_ptr<PartitionTreeNode> PartitionTree::build_helper(const Netlist<>&
          * This means total_before includes the max coord of the bbox but
          * total_after does not include the min coord. */
         for (int x = x_end; x < width - 1; x++) {
-            x_total_before[x] += fanouts;
+            x_total_before[x] += cost;
         }
         for (int x = 0; x < x_start; x++) {
-            x_total_after[x] += fanouts;
+            x_total_after[x] += cost;
         }
         for (int x = x_start; x < x_end; x++) {
-            x_total_on[x] += fanouts;
+            x_total_on[x] += cost;
         }
         int y_start = std::max(y1, bb.ymin) - y1;
         int y_end = std::min(bb.ymax, y2) - y1;
         for (int y = y_end; y < height - 1; y++) {
-            y_total_before[y] += fanouts;
+            y_total_before[y] += cost;
         }
         for (int y = 0; y < y_start; y++) {
-            y_total_after[y] += fanouts;
+            y_total_after[y] += cost;
         }
         for (int y = y_start; y < y_end; y++) {
-            y_total_on[y] += fanouts;
+            y_total_on[y] += cost;
         }
     }
 
-    int best_score = std::numeric_limits<int>::max();
+    float best_score = std::numeric_limits<float>::max();
     float best_pos = std::numeric_limits<double>::quiet_NaN();
     Axis best_axis = Axis::X;
 
     for (int x = 0; x < width - 1; x++) {
-        int before = x_total_before[x];
-        int after = x_total_after[x];
+        float before = x_total_before[x];
+        float after = x_total_after[x];
         if (before == 0 || after == 0) /* Cutting here would leave no nets to the left or right */
             continue;
+        if (tile_cut_x(x1 + x, y1, y2)) /* Cutting here would split a tile (flat routing) */
+            continue;
         /* Now get a measure of "critical path": work on cutline + max(work on sides) */
-        int score = x_total_on[x] + std::max(x_total_before[x], x_total_after[x]);
+        float score = x_total_on[x] + std::max(x_total_before[x], x_total_after[x]);
         // int score = std::abs(int(x_total_before[x]) - int(x_total_after[x]));
         if (score < best_score) {
             best_score = score;
@@ -98,11 +210,13 @@ std::unique_ptr<PartitionTreeNode> PartitionTree::build_helper(const Netlist<>&
     }
 
     for (int y = 0; y < height - 1; y++) {
-        int before = y_total_before[y];
-        int after = y_total_after[y];
+        float before = y_total_before[y];
+        float after = y_total_after[y];
         if (before == 0 || after == 0) /* Cutting here would leave no nets to the left or right (sideways) */
             continue;
-        int score = y_total_on[y] + std::max(y_total_before[y], y_total_after[y]);
+        if (tile_cut_y(y1 + y, x1, x2))
+            continue;
+        float score = y_total_on[y] + std::max(y_total_before[y], y_total_after[y]);
         // int score = std::abs(int(y_total_before[y]) - int(y_total_after[y]));
         if (score < best_score) {
             best_score = score;
@@ -132,8 +246,8 @@ std::unique_ptr<PartitionTreeNode> PartitionTree::build_helper(const Netlist<>&
             }
         }
 
-        out->left = build_helper(netlist, left_nets, x1, y1, std::floor(best_pos), y2);
-        out->right = build_helper(netlist, right_nets, std::floor(best_pos + 1), y1, x2, y2);
+        out->left = build_helper(net_costs, split_cost, left_nets, x1, y1, std::floor(best_pos), y2);
+        out->right = build_helper(net_costs, split_cost, right_nets, std::floor(best_pos + 1), y1, x2, y2);
     } else {
         VTR_ASSERT(best_axis == Axis::Y);
         for (auto net_id : nets) {
@@ -147,8 +261,8 @@ std::unique_ptr<PartitionTreeNode> PartitionTree::build_helper(const Netlist<>&
             }
         }
 
-        out->left = build_helper(netlist, left_nets, x1, y1, x2, std::floor(best_pos));
-        out->right = build_helper(netlist, right_nets, x1, std::floor(best_pos + 1), x2, y2);
+        out->left = build_helper(net_costs, split_cost, left_nets, x1, y1, x2, std::floor(best_pos));
+        out->right = build_helper(net_costs, split_cost, right_nets, x1, std::floor(best_pos + 1), x2, y2);
     }
 
     out->nets = my_nets;
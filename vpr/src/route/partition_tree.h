@@ -12,9 +12,10 @@
 #    include <tbb/concurrent_vector.h>
 #endif
 
-/** Self-descriptive */
+/** Self-descriptive. LAYER cutlines separate the dies of a multi-die (3D) device */
 enum class Axis { X,
-                  Y };
+                  Y,
+                  LAYER };
 
 /** Which side of a line? */
 enum class Side { LEFT = 0,
@@ -49,7 +50,13 @@ class VirtualNet {
  * by the cutline. Leaf nodes represent a final set of nets reached by partitioning.
  *
  * To route this in parallel, we first route the nets in the root node, then add
- * its left and right to a task queue, and repeat this for the whole tree. */
+ * its left and right to a task queue, and repeat this for the whole tree.
+ *
+ * On multi-die devices, the top of the tree cuts between dies (Axis::LAYER) instead: the
+ * nets within a single die are partitioned in x/y under the branch of their die, and the
+ * nets crossing dies are partitioned in x/y on their own, in the crossing subtree. The dies
+ * are routed in parallel first, then the crossing subtree, with the congestion of the
+ * intra-die nets already known. */
 class PartitionTreeNode {
   public:
     /** Nets claimed by this node (intersected by cutline if branch, nets in final region if leaf) */
@@ -60,6 +67,9 @@ class PartitionTreeNode {
     std::unique_ptr<PartitionTreeNode> left = nullptr;
     /** Right subtree. */
     std::unique_ptr<PartitionTreeNode> right = nullptr;
+    /** Only for Axis::LAYER cutlines, which have no nets of their own: subtree of the nets crossing the
+     * cutline, to be routed once both branches are done. May be null if no nets cross it. */
+    std::unique_ptr<PartitionTreeNode> crossing = nullptr;
     /* Axis of the cutline. */
     Axis cutline_axis = Axis::X;
     /* Position of the cutline. It's a float, because cutlines are considered to be "between" integral coordinates. */
@@ -77,15 +87,34 @@ class PartitionTree {
     PartitionTree& operator=(const PartitionTree&) = delete;
     PartitionTree& operator=(PartitionTree&&) = default;
 
-    /** Can only be built from a netlist */
-    PartitionTree(const Netlist<>& netlist);
+    /** Can only be built from a netlist. Nets are weighted by their fanout.
+     * With \p is_flat, cutlines never cross a physical tile, so that the intra-cluster
+     * RR nodes of each tile stay in a single partition (\see tile_cut_x()). */
+    PartitionTree(const Netlist<>& netlist, bool is_flat);
+
+    /** Build from a netlist, weighting each net by \p net_costs (e.g. its routing time in the
+     * previous iteration) instead of its fanout. Partitions costing more than \p split_cost are
+     * split further even if they hold few nets, so that a handful of expensive nets can't keep
+     * a single thread busy long after the others have run out of work. */
+    PartitionTree(const Netlist<>& netlist, const vtr::vector<ParentNetId, float>& net_costs, float split_cost, bool is_flat);
 
     /** Access root. Shouldn't cause a segfault, because PartitionTree constructor always makes a _root */
     inline PartitionTreeNode& root(void) { return *_root; }
 
   private:
     std::unique_ptr<PartitionTreeNode> _root;
-    std::unique_ptr<PartitionTreeNode> build_helper(const Netlist<>& netlist, const std::vector<ParentNetId>& nets, int x1, int y1, int x2, int y2);
+    /** Only filled in for flat routing. [x][y]: number of grid locations (x+1, 0..y-1) which are
+     * not the leftmost column of their tile, i.e. which a cutline at x+0.5 would cut off */
+    vtr::NdMatrix<int, 2> _x_tile_cuts;
+    /** Only filled in for flat routing. [y][x]: same as _x_tile_cuts for a cutline at y+0.5 */
+    vtr::NdMatrix<int, 2> _y_tile_cuts;
+    /** Would a cutline at x+0.5 cross a tile between y1 and y2 (inclusive)? */
+    bool tile_cut_x(int x, int y1, int y2) const;
+    /** Would a cutline at y+0.5 cross a tile between x1 and x2 (inclusive)? */
+    bool tile_cut_y(int y, int x1, int x2) const;
+    std::unique_ptr<PartitionTreeNode> build_helper(const vtr::vector<ParentNetId, float>& net_costs, float split_cost, const std::vector<ParentNetId>& nets, int x1, int y1, int x2, int y2);
+    /** Cut the nets between dies layer1..layer2 in halves (recursively), down to one x/y tree per die */
+    std::unique_ptr<PartitionTreeNode> build_layer_helper(const vtr::vector<ParentNetId, float>& net_costs, float split_cost, const std::vector<ParentNetId>& nets, int layer1, int layer2);
 };
 
 #ifdef VPR_DEBUG_PARTITION_TREE
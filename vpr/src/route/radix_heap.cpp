@@ -0,0 +1,244 @@
+#include "radix_heap.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "rr_graph_fwd.h"
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+RadixHeap::RadixHeap()
+    : last_(0)
+    , size_(0)
+    , max_index_(std::numeric_limits<size_t>::max())
+    , prune_limit_(std::numeric_limits<size_t>::max()) {}
+
+RadixHeap::~RadixHeap() {
+    free_all_memory();
+}
+
+t_heap* RadixHeap::alloc() {
+    return storage_.alloc();
+}
+
+void RadixHeap::free(t_heap* hptr) {
+    storage_.free(hptr);
+}
+
+void RadixHeap::init_heap(const DeviceGrid& /*grid*/) {
+    // Buckets grow on demand and keep their capacity, so there is nothing to size here
+    empty_heap();
+}
+
+uint32_t RadixHeap::cost_to_key(float cost) {
+    static_assert(sizeof(float) == sizeof(uint32_t));
+    uint32_t bits;
+    std::memcpy(&bits, &cost, sizeof(bits));
+
+    // Flip all bits of negative values and only the sign bit of positive values, so
+    // that the unsigned order of the keys matches the order of the floats
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+inline size_t RadixHeap::bucket_index(uint32_t key) const {
+    VTR_ASSERT_SAFE(key >= last_);
+    if (key == last_) {
+        return 0;
+    }
+    // Position of the most significant bit which differs from last_, plus one
+    return 32 - __builtin_clz(key ^ last_);
+}
+
+inline void RadixHeap::insert(const heap_elem& elem) {
+    if (elem.key < last_) {
+        // Not monotone (e.g. over-estimating lookahead); cheaper than everything in the buckets
+        underflow_.push_back(elem);
+        std::push_heap(underflow_.begin(), underflow_.end(), elem_greater);
+    } else {
+        buckets_[bucket_index(elem.key)].push_back(elem);
+    }
+    ++size_;
+}
+
+void RadixHeap::add_to_heap(t_heap* hptr) {
+    insert({hptr, cost_to_key(hptr->cost)});
+    check_prune_limit();
+}
+
+void RadixHeap::push_back(t_heap* const hptr) {
+    // Insertion is already O(1), so there is no separate bulk-insertion path
+    add_to_heap(hptr);
+}
+
+void RadixHeap::build_heap() {
+    // The heap property is maintained on every insertion
+}
+
+void RadixHeap::refill_bucket_zero() {
+    if (!buckets_[0].empty()) {
+        return;
+    }
+
+    size_t ibucket = 1;
+    while (buckets_[ibucket].empty()) {
+        ++ibucket;
+        VTR_ASSERT_SAFE(ibucket < NUM_BUCKETS);
+    }
+
+    std::vector<heap_elem>& bucket = buckets_[ibucket];
+    last_ = std::min_element(bucket.begin(), bucket.end(),
+                             [](const heap_elem& lhs, const heap_elem& rhs) {
+                                 return lhs.key < rhs.key;
+                             })
+                ->key;
+
+    // Every key in this bucket agrees with the new last_ above bit ibucket - 1,
+    // so they all move to strictly lower buckets (and the minimum to bucket 0)
+    for (const heap_elem& elem : bucket) {
+        buckets_[bucket_index(elem.key)].push_back(elem);
+    }
+    bucket.clear();
+}
+
+t_heap* RadixHeap::get_heap_head() {
+    /* Returns a pointer to the smallest element on the heap, or NULL if the     *
+     * heap is empty.  Invalid (index == OPEN) entries on the heap are never     *
+     * returned -- they are just skipped over.                                   */
+
+    t_heap* cheapest;
+
+    do {
+        if (size_ == 0) { /* Empty heap. */
+            VTR_LOG_WARN("Empty heap occurred in get_heap_head.\n");
+            return (nullptr);
+        }
+
+        if (!underflow_.empty()) {
+            std::pop_heap(underflow_.begin(), underflow_.end(), elem_greater);
+            cheapest = underflow_.back().elem_ptr;
+            underflow_.pop_back();
+        } else {
+            refill_bucket_zero();
+            cheapest = buckets_[0].back().elem_ptr;
+            buckets_[0].pop_back();
+        }
+        --size_;
+    } while (!cheapest->index.is_valid()); /* Get another one if invalid entry. */
+
+    return (cheapest);
+}
+
+bool RadixHeap::is_empty_heap() const {
+    return size_ == 0;
+}
+
+bool RadixHeap::is_valid() const {
+    size_t num_elems = underflow_.size();
+
+    for (const heap_elem& elem : underflow_) {
+        if (elem.key >= last_) {
+            return false;
+        }
+    }
+    if (!std::is_heap(underflow_.begin(), underflow_.end(), elem_greater)) {
+        return false;
+    }
+
+    for (size_t ibucket = 0; ibucket < NUM_BUCKETS; ++ibucket) {
+        for (const heap_elem& elem : buckets_[ibucket]) {
+            if (elem.key < last_ || bucket_index(elem.key) != ibucket) {
+                return false;
+            }
+        }
+        num_elems += buckets_[ibucket].size();
+    }
+
+    return num_elems == size_;
+}
+
+void RadixHeap::empty_heap() {
+    for (const heap_elem& elem : underflow_) {
+        free(elem.elem_ptr);
+    }
+    underflow_.clear();
+
+    for (std::vector<heap_elem>& bucket : buckets_) {
+        for (const heap_elem& elem : bucket) {
+            free(elem.elem_ptr);
+        }
+        bucket.clear();
+    }
+
+    size_ = 0;
+    last_ = 0;
+}
+
+void RadixHeap::free_all_memory() {
+    empty_heap();
+
+    underflow_.shrink_to_fit();
+    for (std::vector<heap_elem>& bucket : buckets_) {
+        bucket.shrink_to_fit();
+    }
+
+    storage_.free_all_memory();
+}
+
+void RadixHeap::set_prune_limit(size_t max_index, size_t prune_limit) {
+    if (prune_limit != std::numeric_limits<size_t>::max()) {
+        VTR_ASSERT(max_index < prune_limit);
+    }
+    max_index_ = max_index;
+    prune_limit_ = prune_limit;
+}
+
+void RadixHeap::check_prune_limit() {
+    if (size_ > prune_limit_) {
+        prune_heap();
+    }
+}
+
+void RadixHeap::prune_heap() {
+    VTR_ASSERT(max_index_ < prune_limit_);
+
+    heap_elem blank_elem = {nullptr, 0};
+    std::vector<heap_elem> best_heap_item(max_index_, blank_elem);
+
+    // Find the cheapest instance of each index and free all others
+    auto keep_cheapest = [&](std::vector<heap_elem>& elems) {
+        for (const heap_elem& elem : elems) {
+            if (!elem.elem_ptr->index.is_valid()) {
+                free(elem.elem_ptr);
+                continue;
+            }
+
+            auto idx = size_t(elem.elem_ptr->index);
+            VTR_ASSERT(idx < max_index_);
+
+            heap_elem& best = best_heap_item[idx];
+            if (best.elem_ptr == nullptr) {
+                best = elem;
+            } else if (best.key > elem.key) {
+                free(best.elem_ptr);
+                best = elem;
+            } else {
+                free(elem.elem_ptr);
+            }
+        }
+        elems.clear();
+    };
+
+    keep_cheapest(underflow_);
+    for (std::vector<heap_elem>& bucket : buckets_) {
+        keep_cheapest(bucket);
+    }
+
+    // Re-insert the survivors; last_ is unchanged, so each returns to the same side of it
+    size_ = 0;
+    for (const heap_elem& elem : best_heap_item) {
+        if (elem.elem_ptr != nullptr) {
+            insert(elem);
+        }
+    }
+}
@@ -0,0 +1,97 @@
+#ifndef VTR_RADIX_HEAP_H
+#define VTR_RADIX_HEAP_H
+
+#include "heap_type.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Exact monotone priority queue (radix heap) keyed on the float cost of each t_heap.
+ *
+ * @details
+ * Costs are mapped to order-preserving 32-bit keys. An element is stored in bucket
+ * i if the most significant bit in which its key differs from the last popped key
+ * (last_) is bit i-1 (bucket 0 holds keys equal to last_). Insertion is therefore
+ * O(1), and each element is moved to a strictly lower bucket at most 32 times
+ * before it is popped, so the amortized cost of get_heap_head does not grow with
+ * the heap size as it does for the k-ary heaps.
+ *
+ * Unlike BUCKET_HEAP_APPROXIMATION, elements are popped in exact cost order. A radix
+ * heap requires keys to be monotone (no insertion below the last popped key), which
+ * does not hold for an A* search whose lookahead over-estimates (e.g. astar_fac > 1).
+ * Such elements go into a small binary heap (underflow_) instead. Every element of
+ * underflow_ is cheaper than every element in the buckets, so it is always drained
+ * first and the ordering stays exact.
+ *
+ * Bucket elements are 16 bytes (pointer and key), and each bucket is a contiguous
+ * vector which keeps its capacity across connections, so that redistributing a bucket
+ * is a linear scan without allocation.
+ */
+class RadixHeap : public HeapInterface {
+  public:
+    RadixHeap();
+    ~RadixHeap();
+
+    t_heap* alloc() final;
+    void free(t_heap* hptr) final;
+
+    void init_heap(const DeviceGrid& grid) final;
+    void add_to_heap(t_heap* hptr) final;
+    void push_back(t_heap* const hptr) final;
+    void build_heap() final;
+    t_heap* get_heap_head() final;
+    bool is_empty_heap() const final;
+    bool is_valid() const final;
+    void empty_heap() final;
+    void free_all_memory() final;
+    void set_prune_limit(size_t max_index, size_t prune_limit) final;
+
+  private:
+    ///@brief Number of buckets: one for keys equal to last_, plus one per key bit
+    static constexpr size_t NUM_BUCKETS = 33;
+
+    struct heap_elem {
+        t_heap* elem_ptr;
+        uint32_t key;
+    };
+
+    ///@brief Orders the underflow heap so that the cheapest element is at the front
+    static bool elem_greater(const heap_elem& lhs, const heap_elem& rhs) {
+        return lhs.key > rhs.key;
+    }
+
+    ///@brief Maps a float to an unsigned key with the same ordering
+    static uint32_t cost_to_key(float cost);
+
+    ///@brief Returns the bucket key belongs in, relative to last_
+    size_t bucket_index(uint32_t key) const;
+
+    ///@brief Inserts elem into the underflow heap or the bucket matching its key
+    void insert(const heap_elem& elem);
+
+    ///@brief Ensures bucket 0 is non-empty (if any bucket is) by redistributing the first non-empty bucket
+    void refill_bucket_zero();
+
+    ///@brief Keeps only the cheapest element of each index if the heap has grown past the prune limit
+    void check_prune_limit();
+
+    void prune_heap();
+
+    HeapStorage storage_;
+
+    std::array<std::vector<heap_elem>, NUM_BUCKETS> buckets_;
+
+    ///@brief Binary min-heap holding the elements inserted with a key below last_
+    std::vector<heap_elem> underflow_;
+
+    ///@brief Key of the most recently popped element from the buckets
+    uint32_t last_;
+
+    size_t size_;
+
+    size_t max_index_;
+    size_t prune_limit_;
+};
+
+#endif //VTR_RADIX_HEAP_H
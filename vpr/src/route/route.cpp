@@ -1,15 +1,20 @@
 #include "concrete_timing_info.h"
 #include "connection_based_routing.h"
 #include "draw.h"
+#include "global_route.h"
 #include "netlist_routers.h"
 #include "place_and_route.h"
 #include "read_route.h"
 #include "route.h"
+#include "route_checkpoint.h"
+#include "router_phase_profiling.h"
 #include "route_common.h"
 #include "route_debug.h"
 #include "route_export.h"
 #include "route_profiling.h"
 #include "route_utils.h"
+#include "route_warm_start.h"
+#include "snapshot_render.h"
 #include "vtr_time.h"
 
 bool route(const Netlist<>& net_list,
@@ -25,7 +30,8 @@ bool route(const Netlist<>& net_list,
            t_direct_inf* directs,
            int num_directs,
            ScreenUpdatePriority first_iteration_priority,
-           bool is_flat) {
+           bool is_flat,
+           const RoutingWarmStart* warm_start) {
     auto& device_ctx = g_vpr_ctx.mutable_device();
     auto& cluster_ctx = g_vpr_ctx.clustering();
     auto& atom_ctx = g_vpr_ctx.atom();
@@ -93,9 +99,12 @@ bool route(const Netlist<>& net_list,
     /*
      * Configure the routing predictor
      */
-    RoutingPredictor routing_predictor;
+    RoutingPredictor routing_predictor = warm_start ? RoutingPredictor(ROUTING_PREDICTOR_WARM_START_MIN_HISTORY) : RoutingPredictor();
     float abort_iteration_threshold = std::numeric_limits<float>::infinity(); //Default no early abort
-    if (router_opts.routing_failure_predictor == SAFE) {
+    if (warm_start && router_opts.routing_failure_predictor != OFF) {
+        //A warm-started channel width is likely close to the minimum: give up on it early
+        abort_iteration_threshold = ROUTING_PREDICTOR_ITERATION_ABORT_FACTOR_AGGRESSIVE * router_opts.max_router_iterations;
+    } else if (router_opts.routing_failure_predictor == SAFE) {
         abort_iteration_threshold = ROUTING_PREDICTOR_ITERATION_ABORT_FACTOR_SAFE * router_opts.max_router_iterations;
     } else if (router_opts.routing_failure_predictor == AGGRESSIVE) {
         abort_iteration_threshold = ROUTING_PREDICTOR_ITERATION_ABORT_FACTOR_AGGRESSIVE * router_opts.max_router_iterations;
@@ -125,6 +134,7 @@ bool route(const Netlist<>& net_list,
                                                                           router_opts.lookahead_type,
                                                                           router_opts.write_router_lookahead,
                                                                           router_opts.read_router_lookahead,
+                                                                          router_opts.timing_model_cache_dir,
                                                                           segment_inf,
                                                                           is_flat);
 
@@ -145,6 +155,7 @@ bool route(const Netlist<>& net_list,
                                                        router_opts.lookahead_type,
                                                        router_opts.write_router_lookahead,
                                                        router_opts.read_router_lookahead,
+                                                       router_opts.timing_model_cache_dir,
                                                        segment_inf,
                                                        is_flat);
         if (!router_opts.write_intra_cluster_router_lookahead.empty()) {
@@ -221,6 +232,10 @@ bool route(const Netlist<>& net_list,
         choking_spots,
         is_flat);
 
+    if (router_opts.with_timing_analysis) {
+        timing_info->set_hold_pruning(router_opts.hold_full_update_interval, router_opts.hold_prune_slack);
+    }
+
     RouterStats router_stats;
     float prev_iter_cumm_time = 0;
     vtr::Timer iteration_timer;
@@ -239,8 +254,79 @@ bool route(const Netlist<>& net_list,
 
     int rcv_finished_count = RCV_FINISH_EARLY_COUNTDOWN;
 
+    /* Continue from a checkpointed routing iteration if asked to */
+    int first_itry = 1;
+    if (!router_opts.route_resume.empty()) {
+        t_route_iteration_state resumed_state;
+        RouteCheckpoint::read(router_opts.route_resume, net_list, width_fac, is_flat,
+                              resumed_state, routing_predictor, connections_inf, budgeting_inf,
+                              best_routing, best_clb_opins_used_locally, best_routing_metrics);
+
+        first_itry = resumed_state.itry + 1;
+        pres_fac = resumed_state.pres_fac;
+        update_draw_pres_fac(pres_fac);
+        bb_fac = resumed_state.bb_fac;
+        router_congestion_mode = resumed_state.conflicted_mode ? RouterCongestionMode::CONFLICTED : RouterCongestionMode::NORMAL;
+        itry_conflicted_mode = resumed_state.itry_conflicted_mode;
+        legal_convergence_count = resumed_state.legal_convergence_count;
+        itry_since_last_convergence = resumed_state.itry_since_last_convergence;
+        rcv_finished_count = resumed_state.rcv_finished_count;
+        overuse_info = resumed_state.overuse_info;
+        success = resumed_state.success;
+
+        /* Net delays (and so timing) follow from the restored routing */
+        if (router_opts.with_timing_analysis) {
+            for (auto net_id : net_list.nets()) {
+                if (!net_list.net_is_ignored(net_id) && route_ctx.route_trees[net_id]) {
+                    update_net_delays_from_route_tree(net_delay[net_id].data(), net_list, net_id, timing_info.get(), pin_timing_invalidator.get());
+                }
+            }
+            timing_info->update();
+            pin_timing_invalidator->reset();
+        }
+
+        if (first_itry > 1 && router_opts.routing_budgets_algorithm == YOYO)
+            netlist_router->set_rcv_enabled(true);
+
+        VTR_LOG("Resuming routing at iteration %d\n", first_itry);
+    } else if (warm_start) {
+        size_t num_restored = warm_start->restore(net_list, is_flat);
+
+        if (router_opts.with_timing_analysis) {
+            for (auto net_id : net_list.nets()) {
+                if (!net_list.net_is_ignored(net_id) && route_ctx.route_trees[net_id]) {
+                    update_net_delays_from_route_tree(net_delay[net_id].data(), net_list, net_id, timing_info.get(), pin_timing_invalidator.get());
+                }
+            }
+            timing_info->update();
+            pin_timing_invalidator->reset();
+        }
+
+        size_t num_connections = 0;
+        for (auto net_id : net_list.nets()) {
+            if (!net_list.net_is_ignored(net_id))
+                num_connections += net_list.net_sinks(net_id).size();
+        }
+        VTR_LOG("Warm-starting routing: %zu of %zu connections restored\n", num_restored, num_connections);
+    }
+
+    router_phase_profiling::init(router_opts.router_phase_profile, router_opts.router_phase_profile_hw_counters);
+
+    /* Each routing (e.g. of each channel width tried) learns its own lookahead correction */
+    if (router_opts.lookahead_correction) {
+        route_ctx.lookahead_correction.init(device_ctx.rr_graph.num_rr_segments());
+    } else {
+        route_ctx.lookahead_correction.clear();
+    }
+
+    /* A coarse global routing guides the first iteration of a routing from scratch */
+    route_ctx.global_route_guides.clear();
+    if (router_opts.global_route_guides && first_itry == 1 && !warm_start) {
+        compute_global_route_guides(net_list, router_opts.high_fanout_threshold);
+    }
+
     print_route_status_header();
-    for (itry = 1; itry <= router_opts.max_router_iterations; ++itry) {
+    for (itry = first_itry; itry <= router_opts.max_router_iterations; ++itry) {
         /* Reset "is_routed" and "is_fixed" flags to indicate nets not pre-routed (yet) */
         for (auto net_id : net_list.nets()) {
             route_ctx.net_status.set_is_routed(net_id, false);
@@ -263,13 +349,36 @@ bool route(const Netlist<>& net_list,
         else
             netlist_router->set_timing_info(timing_info);
 
+        /* Once only a few nodes are overused, reroute just the connections through them
+         * (by pruning the route trees of nets of any fanout) rather than whole nets.
+         * overuse_info is still that of the previous iteration here. */
+        connections_inf.set_incremental_reroute_all_nets(itry > 1
+                                                         && router_opts.incremental_reroute_overuse_threshold >= 0
+                                                         && overuse_info.overused_nodes <= size_t(router_opts.incremental_reroute_overuse_threshold));
+        /* A warm-started first iteration keeps the restored routing of every net (less its overused parts) */
+        if (itry == 1 && warm_start)
+            connections_inf.set_incremental_reroute_all_nets(true);
+
         /* Route each net */
         RouteIterResults iter_results = netlist_router->route_netlist(itry, pres_fac, worst_negative_slack);
 
         if (!iter_results.is_routable) { /* Disconnected RRG */
+            route_ctx.global_route_guides.clear();
             return false;
         }
 
+        /* Later iterations negotiate the congestion within the net bounding boxes */
+        if (route_ctx.global_route_guides.is_enabled()) {
+            VTR_LOG("Global routing corridors: %zu connections routed outside their corridor\n",
+                    iter_results.stats.global_route_corridor_misses);
+            route_ctx.global_route_guides.clear();
+        }
+
+        /* The routers only read the correction, so it is updated between iterations */
+        if (route_ctx.lookahead_correction.is_enabled()) {
+            route_ctx.lookahead_correction.update(iter_results.stats.lookahead_samples);
+        }
+
         // Make sure any CLB OPINs used up by subblocks being hooked directly to them are reserved for that purpose
         bool rip_up_local_opins = (itry == 1 ? false : true);
         if (!is_flat) {
@@ -292,10 +401,16 @@ bool route(const Netlist<>& net_list,
 
         wirelength_info = calculate_wirelength_info(net_list, available_wirelength);
         routing_predictor.add_iteration_overuse(itry, overuse_info.overused_nodes);
+        if (!overuse_info.layer_overused_nodes.empty()) {
+            routing_predictor.add_iteration_layer_overuse(itry, overuse_info.layer_overused_nodes);
+        }
 
         //Update timing based on the new routing
         //Note that the net delays have already been updated by timing_driven_route_net
-        timing_info->update();
+        {
+            router_phase_profiling::ScopedPhase phase(e_router_phase::TIMING_ANALYSIS);
+            timing_info->update();
+        }
         timing_info->set_warn_unconstrained(false); //Don't warn again about unconstrained nodes again during routing
         pin_timing_invalidator->reset();
 
@@ -312,6 +427,8 @@ bool route(const Netlist<>& net_list,
 
         //Output progress
         print_route_status(itry, iter_elapsed_time, pres_fac, num_net_bounding_boxes_updated, iter_results.stats, overuse_info, wirelength_info, timing_info, est_success_iteration);
+        print_route_thread_utilization(iter_results.thread_busy_time, iter_results.wall_time);
+        router_phase_profiling::write_iteration(itry, iter_elapsed_time);
 
         prev_iter_cumm_time = iter_cumm_time;
 
@@ -321,6 +438,7 @@ bool route(const Netlist<>& net_list,
         } else {
             update_screen(ScreenUpdatePriority::MINOR, "Routing...", ROUTING, timing_info);
         }
+        save_snapshot_image_checkpoint(ROUTING, itry, g_vpr_ctx.placement().blk_loc_registry());
 
         if (router_opts.save_routing_per_iteration) {
             std::string filename = vtr::string_fmt("iteration_%03d.route", itry);
@@ -338,7 +456,8 @@ bool route(const Netlist<>& net_list,
 
             if (is_better_quality_routing(best_routing, best_routing_metrics, wirelength_info, timing_info)) {
                 //Save routing
-                best_routing = router_ctx.route_trees;
+                //Only the trees which changed since the last save are copied
+                copy_changed_route_trees(best_routing, router_ctx.route_trees);
                 best_clb_opins_used_locally = router_ctx.clb_opins_used_locally;
 
                 success = true;
@@ -408,6 +527,10 @@ bool route(const Netlist<>& net_list,
 
             if (!std::isnan(est_success_iteration) && est_success_iteration > abort_iteration_threshold && router_opts.routing_budgets_algorithm != YOYO) {
                 VTR_LOG("Routing aborted, the predicted iteration for a successful route (%.1f) is too high.\n", est_success_iteration);
+                for (size_t layer = 0; layer < routing_predictor.num_layers(); layer++) {
+                    VTR_LOG("  Die %zu: %zu overused nodes, predicted legal at iteration %.1f\n",
+                            layer, overuse_info.layer_overused_nodes[layer], routing_predictor.estimate_layer_success_iteration(layer));
+                }
 #ifndef NO_GRAPHICS
                 update_router_info_and_check_bp(BP_ROUTE_ITER, -1);
 #endif
@@ -561,24 +684,46 @@ bool route(const Netlist<>& net_list,
         if (router_opts.congestion_analysis) profiling::congestion_analysis();
         if (router_opts.fanout_analysis) profiling::time_on_fanout_analysis();
         // profiling::time_on_criticality_analysis();
+
+        /* Save the state needed to continue from the next iteration */
+        if (!router_opts.write_route_checkpoint.empty() && itry % router_opts.route_checkpoint_interval == 0) {
+            t_route_iteration_state iter_state;
+            iter_state.itry = itry;
+            iter_state.pres_fac = pres_fac;
+            iter_state.bb_fac = bb_fac;
+            iter_state.conflicted_mode = (router_congestion_mode == RouterCongestionMode::CONFLICTED);
+            iter_state.itry_conflicted_mode = itry_conflicted_mode;
+            iter_state.legal_convergence_count = legal_convergence_count;
+            iter_state.itry_since_last_convergence = itry_since_last_convergence;
+            iter_state.rcv_finished_count = rcv_finished_count;
+            iter_state.overuse_info = overuse_info;
+            iter_state.success = success;
+
+            RouteCheckpoint::write(router_opts.write_route_checkpoint, net_list, width_fac, is_flat,
+                                   iter_state, routing_predictor, connections_inf, budgeting_inf,
+                                   best_routing, best_clb_opins_used_locally, best_routing_metrics);
+        }
     }
 
     /* Write out partition tree logs (no-op if debug option not set) */
     PartitionTreeDebug::write("partition_tree.log");
+    router_phase_profiling::finish();
 
     if (success) {
         VTR_LOG("Restoring best routing\n");
 
         auto& router_ctx = g_vpr_ctx.mutable_routing();
 
-        /* Restore congestion from best route */
+        /* Restore congestion from best route. The nets which didn't change since it was saved keep their congestion */
         for (auto net_id : net_list.nets()) {
+            if (is_same_route_tree(route_ctx.route_trees[net_id], best_routing[net_id]))
+                continue;
             if (route_ctx.route_trees[net_id])
                 pathfinder_update_cost_from_route_tree(route_ctx.route_trees[net_id]->root(), -1);
             if (best_routing[net_id])
                 pathfinder_update_cost_from_route_tree(best_routing[net_id]->root(), 1);
         }
-        router_ctx.route_trees = best_routing;
+        copy_changed_route_trees(router_ctx.route_trees, best_routing);
         router_ctx.clb_opins_used_locally = best_clb_opins_used_locally;
 
         prune_unused_non_configurable_nets(connections_inf, net_list);
@@ -588,6 +733,7 @@ bool route(const Netlist<>& net_list,
         }
 
         VTR_LOG("Successfully routed after %d routing iterations.\n", itry);
+        save_snapshot_image(ROUTING, g_vpr_ctx.placement().blk_loc_registry());
     } else {
         VTR_LOG("Routing failed.\n");
 
@@ -603,6 +749,9 @@ bool route(const Netlist<>& net_list,
     if (router_opts.with_timing_analysis) {
         VTR_LOG("Final Net Connection Criticality Histogram:\n");
         print_router_criticality_histogram(net_list, *timing_info, netlist_pin_lookup, is_flat);
+
+        //Later analyses of the routing are full
+        timing_info->set_hold_pruning(0, 0.);
     }
 
     VTR_ASSERT(router_stats.heap_pushes >= router_stats.intra_cluster_node_pushes);
@@ -625,5 +774,10 @@ bool route(const Netlist<>& net_list,
 #endif
     VTR_LOG("\n");
 
+    if (route_ctx.lookahead_correction.is_enabled()) {
+        VTR_LOG("Router lookahead correction: average factor %.3f\n", route_ctx.lookahead_correction.average_factor());
+        route_ctx.lookahead_correction.clear();
+    }
+
     return success;
 }
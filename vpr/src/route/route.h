@@ -6,6 +6,8 @@
 #include "vpr_types.h"
 #include "netlist.h"
 
+class RoutingWarmStart;
+
 /** Attempts a routing via the AIR algorithm [0].
  *
  * \p width_fac specifies the relative width of the channels, while the members of
@@ -14,6 +16,10 @@
  * architecture (connection and switch boxes) of the FPGA; it is used
  * only if a DETAILED routing has been selected.
  *
+ * If \p warm_start is given, routing starts from the (saved) routing of another
+ * channel width rather than from scratch, and the routing predictor gives up on this
+ * channel width after fewer iterations (see RoutingWarmStart).
+ *
  * [0]: K. E. Murray, S. Zhong, and V. Betz, "AIR: A fast but lazy timing-driven FPGA router", in ASPDAC 2020
  *
  * \return Success status. */
@@ -30,4 +36,5 @@ bool route(const Netlist<>& net_list,
            t_direct_inf* directs,
            int num_directs,
            ScreenUpdatePriority first_iteration_priority,
-           bool is_flat);
+           bool is_flat,
+           const RoutingWarmStart* warm_start = nullptr);
@@ -50,8 +50,14 @@
 #include "tatum/echo_writer.hpp"
 #include "net_delay.h"
 #include "route_budgets.h"
+#include "NetPinTimingInvalidator.h"
 #include "vtr_time.h"
 
+#ifdef VPR_USE_TBB
+#    include <tbb/combinable.h>
+#    include <tbb/parallel_for_each.h>
+#endif
+
 #define SHORT_PATH_EXP 0.5
 
 route_budgets::route_budgets(const Netlist<>& net_list, bool is_flat)
@@ -134,6 +140,13 @@ void route_budgets::load_route_budgets(NetPinsMatrix<float>& net_delay,
 
     vtr::ScopedFinishTimer budget_timer("Calculating Route Budgets");
 
+    /*The budget STAs only change where budgets changed between two slack allocations, so they are
+     * updated incrementally unless full updates were requested*/
+    budget_timing_update_type_ = router_opts.timing_update_type;
+    if (budget_timing_update_type_ == e_timing_update_type::AUTO) {
+        budget_timing_update_type_ = e_timing_update_type::INCREMENTAL;
+    }
+
     /*allocate and load memory for budgets*/
     alloc_budget_memory();
     load_initial_budgets();
@@ -193,8 +206,21 @@ void route_budgets::allocate_slack_using_weights(NetPinsMatrix<float>& net_delay
     /*Preprocessing algorithm in order to consider short paths when setting initial maximum budgets.
      * Not necessary unless budgets are really hard to meet*/
     // process_negative_slack_using_minimax();
+    auto& atom_ctx = g_vpr_ctx.atom();
+    pin_timing_invalidator_ = make_net_pin_timing_invalidator(budget_timing_update_type_,
+                                                              net_list_,
+                                                              netlist_pin_lookup,
+                                                              atom_ctx.nlist,
+                                                              atom_ctx.lookup,
+                                                              *g_vpr_ctx.timing().graph,
+                                                              is_flat_);
+    changed_nets_.assign(net_list_.nets().size(), false);
+
+    /*The net delays do not change while allocating slack, so their timing is analyzed once*/
+    original_timing_info = perform_sta(net_delay);
+
     if (negative_hold_slack) {
-        process_negative_slack_using_minimax(net_delay, netlist_pin_lookup);
+        process_negative_slack_using_minimax(original_timing_info, net_delay, netlist_pin_lookup);
     }
 
     iteration = 0;
@@ -204,11 +230,12 @@ void route_budgets::allocate_slack_using_weights(NetPinsMatrix<float>& net_delay
     // An experimentally derived constant that allows for a balance between budget calculation time, and quality
     constexpr float MAX_BUDGET_CHANGE_THRESHOLD = 5e-12;
 
-    original_timing_info = perform_sta(net_delay);
-
     /*This allocates long path slack and increases the budgets*/
+    timing_info = perform_sta(delay_max_budget);
     while ((iteration > 3 && max_budget_change > MAX_BUDGET_CHANGE_THRESHOLD) || iteration <= 3) {
-        timing_info = perform_sta(delay_max_budget);
+        if (iteration != 0) {
+            update_sta(timing_info);
+        }
 
         max_budget_change = minimax_PERT(original_timing_info, timing_info, delay_max_budget, net_delay, netlist_pin_lookup, SETUP, true, BOTH);
 
@@ -229,15 +256,16 @@ void route_budgets::allocate_slack_using_weights(NetPinsMatrix<float>& net_delay
     /*Set the minimum budgets equal to the maximum budgets*/
     set_min_max_budgets_equal();
 
-    original_timing_info = perform_sta(net_delay);
-    timing_info_min = perform_sta(delay_min_budget);
-
     iteration = 0;
     max_budget_change = 900e-12;
 
     /*Allocate the short path slack to decrease the budgets accordingly*/
+    std::fill(changed_nets_.begin(), changed_nets_.end(), false); //Analyzed from scratch below
+    timing_info_min = perform_sta(delay_min_budget);
     while ((iteration > 3 && max_budget_change > MAX_BUDGET_CHANGE_THRESHOLD) || iteration <= 3) {
-        timing_info_min = perform_sta(delay_min_budget);
+        if (iteration != 0) {
+            update_sta(timing_info_min);
+        }
         max_budget_change = minimax_PERT(original_timing_info, timing_info_min, delay_min_budget, net_delay, netlist_pin_lookup, HOLD, true, POSITIVE);
         iteration++;
 
@@ -252,21 +280,25 @@ void route_budgets::allocate_slack_using_weights(NetPinsMatrix<float>& net_delay
     max_budget_change = 900e-12;
     float bottom_range = -1e-9;
 
-    original_timing_info = perform_sta(net_delay);
     while (iteration < 5 && max_budget_change > MAX_BUDGET_CHANGE_THRESHOLD) {
         /*budgets must be in bounds before timing analysis*/
         if (iteration != 0) {
             keep_budget_in_bounds(delay_min_budget);
         }
-        timing_info_min = perform_sta(delay_min_budget);
+        update_sta(timing_info_min);
         max_budget_change = minimax_PERT(original_timing_info, timing_info_min, delay_min_budget, net_delay, netlist_pin_lookup, HOLD, false, POSITIVE);
         iteration++;
     }
     /*budgets may go below minimum delay bound to optimize for setup time*/
     keep_budget_above_value(delay_min_budget, bottom_range);
+
+    pin_timing_invalidator_.reset();
+    vtr::release_memory(changed_nets_);
 }
 
-void route_budgets::process_negative_slack_using_minimax(NetPinsMatrix<float>& net_delay, const ClusteredPinAtomPinsLookup& netlist_pin_lookup) {
+void route_budgets::process_negative_slack_using_minimax(std::shared_ptr<SetupHoldTimingInfo> original_timing_info,
+                                                         NetPinsMatrix<float>& net_delay,
+                                                         const ClusteredPinAtomPinsLookup& netlist_pin_lookup) {
     /*This function is an optional pre-processing for the maximum budgets.
      * This ensures that the short path slacks are also taken into account for the maximum budgets.
      * Ensures that maximum budgets will always be above minimum budgets.
@@ -274,12 +306,10 @@ void route_budgets::process_negative_slack_using_minimax(NetPinsMatrix<float>& n
     unsigned iteration;
     float max_budget_change;
     std::shared_ptr<SetupHoldTimingInfo> timing_info = nullptr;
-    std::shared_ptr<SetupHoldTimingInfo> original_timing_info = nullptr;
 
     iteration = 0;
     max_budget_change = 900e-12;
     float second_max_budget_change = 900e-12;
-    original_timing_info = perform_sta(net_delay);
 
     // Cutoff threshold so if budgets aren't changing, stop early
     constexpr float MAX_BUDGET_CHANGE_THRESHOLD_PREPROCESSING = 5e-12;
@@ -287,11 +317,12 @@ void route_budgets::process_negative_slack_using_minimax(NetPinsMatrix<float>& n
     while (iteration < 20 && max_budget_change > MAX_BUDGET_CHANGE_THRESHOLD_PREPROCESSING) {
         if (iteration == 0) {
             max_budget_change = minimax_PERT(original_timing_info, original_timing_info, delay_max_budget, net_delay, netlist_pin_lookup, HOLD, true, NEGATIVE);
+            std::fill(changed_nets_.begin(), changed_nets_.end(), false); //Analyzed from scratch below
             timing_info = perform_sta(delay_max_budget);
         } else {
             second_max_budget_change = minimax_PERT(original_timing_info, timing_info, delay_max_budget, net_delay, netlist_pin_lookup, HOLD, true, NEGATIVE);
             max_budget_change = std::max(max_budget_change, second_max_budget_change);
-            timing_info = perform_sta(delay_max_budget);
+            update_sta(timing_info);
         }
 
         iteration++;
@@ -310,11 +341,17 @@ void route_budgets::keep_budget_above_value(NetPinsMatrix<float>& temp_budgets,
 }
 
 void route_budgets::keep_budget_in_bounds(NetPinsMatrix<float>& temp_budgets) {
-    /*Make sure the budget is between the lower and upper bounds*/
+    /*Make sure the budget is between the lower and upper bounds.
+     * Records the nets whose budgets changed, for the next incremental STA*/
 
     for (auto net_id : net_list_.nets()) {
         for (auto pin_id : net_list_.net_sinks(net_id)) {
+            int ipin = net_list_.pin_net_index(pin_id);
+            float old_budget = temp_budgets[net_id][ipin];
             keep_budget_in_bounds(temp_budgets, net_id, pin_id);
+            if (temp_budgets[net_id][ipin] != old_budget) {
+                changed_nets_[net_id] = true;
+            }
         }
     }
 }
@@ -363,14 +400,21 @@ float route_budgets::minimax_PERT(std::shared_ptr<SetupHoldTimingInfo> orig_timi
      * The weights are deteremined by how much delay of the whole path is present in this connection*/
 
     std::shared_ptr<const tatum::SetupHoldTimingAnalyzer> timing_analyzer = orig_timing_info->setup_hold_analyzer();
-    float total_path_delay = 0;
-    float path_slack;
-    float hold_path_slack;
-    float max_budget_change = 0;
-    for (auto net_id : net_list_.nets()) {
+
+    //Flags of the nets with a hold violation, set by the net's task and merged into should_reroute_for_hold afterwards
+    vtr::vector<ParentNetId, uint8_t> reroute_for_hold(net_list_.nets().size(), false);
+
+    /*The connections are independent: each one only reads the timing analyses and only writes
+     * its own budget and path delay caches, so the nets are processed in parallel.
+     * Returns the largest budget change of the net*/
+    auto allocate_net_slack = [&](ParentNetId net_id) {
+        float net_max_budget_change = 0;
         for (auto pin_id : net_list_.net_sinks(net_id)) {
             int ipin = net_list_.pin_net_index(pin_id);
             AtomPinId atom_pin;
+            float path_slack;
+            float hold_path_slack;
+            float old_budget = temp_budgets[net_id][ipin];
 
             /*calculate slack, save the pin that has min slack to calculate total path delay*/
             if (analysis_type == HOLD) {
@@ -393,10 +437,7 @@ float route_budgets::minimax_PERT(std::shared_ptr<SetupHoldTimingInfo> orig_timi
                 }
             }
 
-            total_path_delay = get_total_path_delay(timing_analyzer, analysis_type, net_id, ipin, atom_pin);
-            // if ((size_t)net_id == 10) {
-            //     VTR_LOG("NET 10 TOTAL PATH DELAY IS %e\n", total_path_delay);
-            // }
+            float total_path_delay = get_total_path_delay(timing_analyzer, analysis_type, net_id, ipin, atom_pin);
 
             if (total_path_delay == -1) {
                 /*Delay node is not valid, leave the budgets as is*/
@@ -408,29 +449,53 @@ float route_budgets::minimax_PERT(std::shared_ptr<SetupHoldTimingInfo> orig_timi
             if ((slack_type == NEGATIVE && path_slack < 0) || (slack_type == POSITIVE && path_slack > 0) || slack_type == BOTH) {
                 if (analysis_type == HOLD) {
                     temp_budgets[net_id][ipin] += -1 * net_delay[net_id][ipin] * path_slack / total_path_delay;
-                    max_budget_change = std::max(max_budget_change, std::abs(net_delay[net_id][ipin] * path_slack / total_path_delay));
+                    net_max_budget_change = std::max(net_max_budget_change, std::abs(net_delay[net_id][ipin] * path_slack / total_path_delay));
                 } else {
                     if ((slack_type == POSITIVE) || (hold_path_slack > 0)) {
                         temp_budgets[net_id][ipin] += net_delay[net_id][ipin] * path_slack / total_path_delay;
-                        max_budget_change = std::max(max_budget_change, std::abs(net_delay[net_id][ipin] * path_slack / total_path_delay));
+                        net_max_budget_change = std::max(net_max_budget_change, std::abs(net_delay[net_id][ipin] * path_slack / total_path_delay));
                     }
                 }
             }
 
-            // if ((size_t)net_id == 916 && analysis_type == HOLD) {
-            //     VTR_LOG("Path slack %e weight %e max_budget_change %e net min budg %e\n", path_slack, net_delay[net_id][ipin]/total_path_delay, max_budget_change, temp_budgets[net_id][ipin]);
-            // }
-
             /*Budgets need to be between maximum and minimum budgets*/
             if (keep_in_bounds) {
                 keep_budget_in_bounds(temp_budgets, net_id, pin_id);
             }
 
+            if (temp_budgets[net_id][ipin] != old_budget) {
+                changed_nets_[net_id] = true;
+            }
+
             if ((slack_type == NEGATIVE && path_slack < 0 && analysis_type == HOLD) || hold_path_slack < 0) {
-                should_reroute_for_hold[net_id] = true;
+                reroute_for_hold[net_id] = true;
             }
         }
+        return net_max_budget_change;
+    };
+
+    float max_budget_change = 0;
+#ifdef VPR_USE_TBB
+    tbb::combinable<float> thread_max_budget_change(0.f);
+
+    tbb::parallel_for_each(net_list_.nets().begin(), net_list_.nets().end(), [&](ParentNetId net_id) {
+        float& thread_max = thread_max_budget_change.local();
+        thread_max = std::max(thread_max, allocate_net_slack(net_id));
+    });
+
+    max_budget_change = thread_max_budget_change.combine([](float a, float b) { return std::max(a, b); });
+#else
+    for (auto net_id : net_list_.nets()) {
+        max_budget_change = std::max(max_budget_change, allocate_net_slack(net_id));
     }
+#endif
+
+    for (auto net_id : net_list_.nets()) {
+        if (reroute_for_hold[net_id]) {
+            should_reroute_for_hold[net_id] = true;
+        }
+    }
+
     return max_budget_change;
 }
 
@@ -662,9 +727,8 @@ std::shared_ptr<SetupHoldTimingInfo> route_budgets::perform_sta(NetPinsMatrix<fl
     /*Perform static timing analysis to get the delay and path weights for slack allocation*/
     std::shared_ptr<RoutingDelayCalculator> routing_delay_calc = std::make_shared<RoutingDelayCalculator>(atom_ctx.nlist, atom_ctx.lookup, temp_budgets, is_flat_);
 
-    //TODO: now that we support incremental timing updates, we should avoid re-building the timing analyzer from scratch and try
-    //      to calculate this incrementally
-    std::shared_ptr<SetupHoldTimingInfo> timing_info = make_setup_hold_timing_info(routing_delay_calc, e_timing_update_type::AUTO);
+    //The analysis refers to temp_budgets, so that update_sta() can later re-analyze only the changed connections
+    std::shared_ptr<SetupHoldTimingInfo> timing_info = make_setup_hold_timing_info(routing_delay_calc, budget_timing_update_type_);
 
     /*Unconstrained nodes should be warned in the main routing function, do not report it here*/
     timing_info->set_warn_unconstrained(false);
@@ -673,6 +737,23 @@ std::shared_ptr<SetupHoldTimingInfo> route_budgets::perform_sta(NetPinsMatrix<fl
     return timing_info;
 }
 
+void route_budgets::update_sta(std::shared_ptr<SetupHoldTimingInfo> timing_info) {
+    /*Re-analyze timing_info after its budgets changed. Only the connections of the nets whose budgets
+     * changed since the last analysis are invalidated (with full updates, everything is re-analyzed)*/
+    for (auto net_id : net_list_.nets()) {
+        if (!changed_nets_[net_id]) {
+            continue;
+        }
+        for (auto pin_id : net_list_.net_sinks(net_id)) {
+            pin_timing_invalidator_->invalidate_connection(pin_id, timing_info.get());
+        }
+        changed_nets_[net_id] = false;
+    }
+
+    timing_info->update();
+    pin_timing_invalidator_->reset();
+}
+
 void route_budgets::update_congestion_times(ParentNetId net_id) {
     /*Calling this function indicates this net is congested in
      * this routing iteration. This vector keeps the number of
@@ -8,6 +8,9 @@
 #include <vector>
 #include <queue>
 #include "RoutingDelayCalculator.h"
+#include "vpr_types.h"
+
+class NetPinTimingInvalidator;
 
 enum analysis_type {
     SETUP,
@@ -21,7 +24,13 @@ enum slack_allocated_type {
 };
 
 #define UNINITIALIZED_PATH_DELAY -2.
+
+class RouteCheckpoint;
+
 class route_budgets {
+    /*saves and restores the budgets*/
+    friend class RouteCheckpoint;
+
   public:
     route_budgets(const Netlist<>& net_list, bool is_flat);
 
@@ -79,10 +88,14 @@ class route_budgets {
                        bool keep_in_bounds,
                        slack_allocated_type slack_type = BOTH);
 
-    void process_negative_slack_using_minimax(NetPinsMatrix<float>& net_delay, const ClusteredPinAtomPinsLookup& netlist_pin_lookup);
+    void process_negative_slack_using_minimax(std::shared_ptr<SetupHoldTimingInfo> original_timing_info,
+                                              NetPinsMatrix<float>& net_delay,
+                                              const ClusteredPinAtomPinsLookup& netlist_pin_lookup);
 
     /*Perform static timing analysis*/
     std::shared_ptr<SetupHoldTimingInfo> perform_sta(NetPinsMatrix<float>& temp_budgets);
+    /*Update a budget timing analysis from perform_sta() after slack allocation (only the changed nets are invalidated)*/
+    void update_sta(std::shared_ptr<SetupHoldTimingInfo> timing_info);
 
     /*checks*/
     void keep_budget_in_bounds(NetPinsMatrix<float>& temp_budgets);
@@ -129,6 +142,11 @@ class route_budgets {
     vtr::vector<ParentNetId, int> num_times_congested; //[0..num_nets]
     std::queue<float> negative_hold_slacks;
 
+    /*incremental timing updates of the budget STAs while allocating slack*/
+    e_timing_update_type budget_timing_update_type_ = e_timing_update_type::FULL;
+    std::unique_ptr<NetPinTimingInvalidator> pin_timing_invalidator_;
+    vtr::vector<ParentNetId, uint8_t> changed_nets_; //[0..num_nets] nets whose budgets changed since the last STA
+
     const Netlist<>& net_list_;
     bool is_flat_;
 
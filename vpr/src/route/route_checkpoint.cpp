@@ -0,0 +1,610 @@
+#include "route_checkpoint.h"
+
+#include <cstdio>
+#include <limits>
+#include <map>
+#include <queue>
+#include <unordered_map>
+
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+#include "globals.h"
+#include "vpr_error.h"
+
+#ifdef VTR_ENABLE_CAPNPROTO
+#    include "capnp/serialize.h"
+#    include "route_checkpoint.capnp.h"
+#    include "mmap_file.h"
+#    include "serdes_utils.h"
+#endif /* VTR_ENABLE_CAPNPROTO */
+
+/*
+ * Functions below are for when VTR_ENABLE_CAPNPROTO is disabled; an error is thrown instead.
+ */
+#ifndef VTR_ENABLE_CAPNPROTO
+
+#    define DISABLE_ERROR                              \
+        "is disable because VTR_ENABLE_CAPNPROTO=OFF." \
+        "Re-compile with CMake option VTR_ENABLE_CAPNPROTO=ON to enable."
+
+void RouteCheckpoint::write(const std::string& /*file*/,
+                            const Netlist<>& /*net_list*/,
+                            int /*width_fac*/,
+                            bool /*is_flat*/,
+                            const t_route_iteration_state& /*iter_state*/,
+                            const RoutingPredictor& /*routing_predictor*/,
+                            const CBRR& /*connections_inf*/,
+                            const route_budgets& /*budgeting_inf*/,
+                            const vtr::vector<ParentNetId, vtr::optional<RouteTree>>& /*best_routing*/,
+                            const t_clb_opins_used& /*best_clb_opins_used_locally*/,
+                            const RoutingMetrics& /*best_routing_metrics*/) {
+    VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "RouteCheckpoint::write " DISABLE_ERROR);
+}
+
+void RouteCheckpoint::read(const std::string& /*file*/,
+                           const Netlist<>& /*net_list*/,
+                           int /*width_fac*/,
+                           bool /*is_flat*/,
+                           t_route_iteration_state& /*iter_state*/,
+                           RoutingPredictor& /*routing_predictor*/,
+                           CBRR& /*connections_inf*/,
+                           route_budgets& /*budgeting_inf*/,
+                           vtr::vector<ParentNetId, vtr::optional<RouteTree>>& /*best_routing*/,
+                           t_clb_opins_used& /*best_clb_opins_used_locally*/,
+                           RoutingMetrics& /*best_routing_metrics*/) {
+    VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "RouteCheckpoint::read " DISABLE_ERROR);
+}
+
+#else /* VTR_ENABLE_CAPNPROTO */
+
+/******** File-scope function declarations ********/
+
+static void write_route_trees(::capnp::List<VprRouteTree>::Builder out,
+                              const vtr::vector<ParentNetId, vtr::optional<RouteTree>>& trees);
+
+static void write_clb_opins_used(::capnp::List<VprClbOpinsUsed>::Builder out,
+                                 const t_clb_opins_used& clb_opins_used);
+
+static t_clb_opins_used read_clb_opins_used(::capnp::List<VprClbOpinsUsed>::Reader in);
+
+static void write_net_pins_matrix(::capnp::List<::capnp::List<float>>::Builder out,
+                                  const NetPinsMatrix<float>& matrix,
+                                  const Netlist<>& net_list);
+
+static void read_net_pins_matrix(::capnp::List<::capnp::List<float>>::Reader in,
+                                 NetPinsMatrix<float>& matrix,
+                                 const Netlist<>& net_list,
+                                 const std::string& file);
+
+static void check_checkpoint_size(size_t found, size_t expected, const char* what, const std::string& file);
+
+/******** Function definitions ********/
+
+void RouteCheckpoint::write(const std::string& file,
+                            const Netlist<>& net_list,
+                            int width_fac,
+                            bool is_flat,
+                            const t_route_iteration_state& iter_state,
+                            const RoutingPredictor& routing_predictor,
+                            const CBRR& connections_inf,
+                            const route_budgets& budgeting_inf,
+                            const vtr::vector<ParentNetId, vtr::optional<RouteTree>>& best_routing,
+                            const t_clb_opins_used& best_clb_opins_used_locally,
+                            const RoutingMetrics& best_routing_metrics) {
+    const auto& route_ctx = g_vpr_ctx.routing();
+    const auto& rr_graph = g_vpr_ctx.device().rr_graph;
+    size_t num_nets = net_list.nets().size();
+
+    ::capnp::MallocMessageBuilder builder;
+    auto out = builder.initRoot<VprRouteCheckpoint>();
+
+    out.setNetlistId(net_list.netlist_id().c_str());
+    out.setNumNets(num_nets);
+    out.setNumRrNodes(rr_graph.num_nodes());
+    out.setChannelWidth(width_fac);
+    out.setIsFlat(is_flat);
+
+    //Iteration state
+    out.setIteration(iter_state.itry);
+    out.setPresFac(iter_state.pres_fac);
+    out.setBbFac(iter_state.bb_fac);
+    out.setConflictedMode(iter_state.conflicted_mode);
+    out.setIterationsConflictedMode(iter_state.itry_conflicted_mode);
+    out.setLegalConvergenceCount(iter_state.legal_convergence_count);
+    out.setIterationsSinceLastConvergence(iter_state.itry_since_last_convergence);
+    out.setRcvFinishedCount(iter_state.rcv_finished_count);
+    out.setOverusedNodes(iter_state.overuse_info.overused_nodes);
+    out.setTotalOveruse(iter_state.overuse_info.total_overuse);
+    out.setWorstOveruse(iter_state.overuse_info.worst_overuse);
+
+    //Routing and congestion
+    write_route_trees(out.initRouteTrees(num_nets), route_ctx.route_trees);
+
+    auto route_bbs = out.initRouteBbs(num_nets);
+    for (auto net_id : net_list.nets()) {
+        const t_bb& bb = route_ctx.route_bb[net_id];
+        auto out_bb = route_bbs[size_t(net_id)];
+        out_bb.setXmin(bb.xmin);
+        out_bb.setXmax(bb.xmax);
+        out_bb.setYmin(bb.ymin);
+        out_bb.setYmax(bb.ymax);
+        out_bb.setLayerMin(bb.layer_min);
+        out_bb.setLayerMax(bb.layer_max);
+    }
+
+    write_clb_opins_used(out.initClbOpinsUsedLocally(route_ctx.clb_opins_used_locally.size()), route_ctx.clb_opins_used_locally);
+
+    auto occ = out.initOcc(rr_graph.num_nodes());
+    auto acc_cost = out.initAccCost(rr_graph.num_nodes());
+    for (const RRNodeId& inode : rr_graph.nodes()) {
+        occ.set(size_t(inode), route_ctx.rr_node_cong_inf[inode].occ());
+        acc_cost.set(size_t(inode), route_ctx.rr_node_cong_inf[inode].acc_cost);
+    }
+
+    //Routing predictor
+    auto predictor = out.initRoutingPredictor();
+    auto iterations = predictor.initIterations(routing_predictor.iterations_.size());
+    auto overused_counts = predictor.initOverusedRrNodeCounts(routing_predictor.iteration_overused_rr_node_counts_.size());
+    for (size_t i = 0; i < routing_predictor.iterations_.size(); ++i) {
+        iterations.set(i, routing_predictor.iterations_[i]);
+        overused_counts.set(i, routing_predictor.iteration_overused_rr_node_counts_[i]);
+    }
+    predictor.setSlope(routing_predictor.slope_);
+
+    //Connection based rerouting
+    auto rerouting = out.initConnectionRerouting();
+    auto lower_bounds = rerouting.initLowerBoundConnectionDelays(num_nets);
+    auto forced_sinks = rerouting.initForcedRerouteSinks(num_nets);
+    for (auto net_id : net_list.nets()) {
+        const std::vector<float>& net_lower_bounds = connections_inf.lower_bound_connection_delay[net_id];
+        auto out_lower_bounds = lower_bounds.init(size_t(net_id), net_lower_bounds.size());
+        for (size_t ipin = 0; ipin < net_lower_bounds.size(); ++ipin) {
+            out_lower_bounds.set(ipin, net_lower_bounds[ipin]);
+        }
+
+        std::vector<RRNodeId> net_forced_sinks;
+        for (const auto& sink_flag : connections_inf.forcible_reroute_connection_flag[net_id]) {
+            if (sink_flag.second) {
+                net_forced_sinks.push_back(sink_flag.first);
+            }
+        }
+        auto out_forced_sinks = forced_sinks.init(size_t(net_id), net_forced_sinks.size());
+        for (size_t i = 0; i < net_forced_sinks.size(); ++i) {
+            out_forced_sinks.set(i, size_t(net_forced_sinks[i]));
+        }
+    }
+    rerouting.setLastStableCriticalPathDelay(connections_inf.last_stable_critical_path_delay);
+    rerouting.setCriticalPathGrowthTolerance(connections_inf.critical_path_growth_tolerance);
+    rerouting.setConnectionCriticalityTolerance(connections_inf.connection_criticality_tolerance);
+    rerouting.setConnectionDelayOptimalityTolerance(connections_inf.connection_delay_optimality_tolerance);
+
+    //Routing budgets
+    auto budgets = out.initRouteBudgets();
+    budgets.setIsSet(budgeting_inf.set);
+    if (budgeting_inf.set) {
+        write_net_pins_matrix(budgets.initDelayMinBudget(num_nets), budgeting_inf.delay_min_budget, net_list);
+        write_net_pins_matrix(budgets.initDelayMaxBudget(num_nets), budgeting_inf.delay_max_budget, net_list);
+        write_net_pins_matrix(budgets.initDelayTarget(num_nets), budgeting_inf.delay_target, net_list);
+        write_net_pins_matrix(budgets.initDelayLowerBound(num_nets), budgeting_inf.delay_lower_bound, net_list);
+        write_net_pins_matrix(budgets.initDelayUpperBound(num_nets), budgeting_inf.delay_upper_bound, net_list);
+        write_net_pins_matrix(budgets.initShortPathCrit(num_nets), budgeting_inf.short_path_crit, net_list);
+
+        auto num_times_congested = budgets.initNumTimesCongested(num_nets);
+        for (auto net_id : net_list.nets()) {
+            num_times_congested.set(size_t(net_id), budgeting_inf.num_times_congested[net_id]);
+        }
+
+        std::queue<float> negative_hold_slacks = budgeting_inf.negative_hold_slacks;
+        auto out_slacks = budgets.initNegativeHoldSlacks(negative_hold_slacks.size());
+        for (size_t i = 0; !negative_hold_slacks.empty(); ++i) {
+            out_slacks.set(i, negative_hold_slacks.front());
+            negative_hold_slacks.pop();
+        }
+
+        auto should_reroute = budgets.initShouldRerouteForHold(budgeting_inf.should_reroute_for_hold.size());
+        size_t i = 0;
+        for (const auto& net_reroute : budgeting_inf.should_reroute_for_hold) {
+            should_reroute[i].setNet(size_t(net_reroute.first));
+            should_reroute[i].setValue(net_reroute.second);
+            ++i;
+        }
+
+        auto hold_fac = budgets.initHoldFac(budgeting_inf.hold_fac.size());
+        i = 0;
+        for (const auto& net_hold_fac : budgeting_inf.hold_fac) {
+            hold_fac[i].setNet(size_t(net_hold_fac.first));
+            hold_fac[i].setValue(net_hold_fac.second);
+            ++i;
+        }
+    }
+
+    //Best routing
+    out.setHasBestRouting(iter_state.success);
+    if (iter_state.success) {
+        write_route_trees(out.initBestRouteTrees(best_routing.size()), best_routing);
+        write_clb_opins_used(out.initBestClbOpinsUsedLocally(best_clb_opins_used_locally.size()), best_clb_opins_used_locally);
+
+        auto metrics = out.initBestRoutingMetrics();
+        metrics.setUsedWirelength(best_routing_metrics.used_wirelength);
+        metrics.setSetupWns(best_routing_metrics.sWNS);
+        metrics.setSetupTns(best_routing_metrics.sTNS);
+        metrics.setHoldWns(best_routing_metrics.hWNS);
+        metrics.setHoldTns(best_routing_metrics.hTNS);
+        metrics.setCriticalPathDelay(best_routing_metrics.critical_path.delay());
+        metrics.setCriticalPathSlack(best_routing_metrics.critical_path.slack());
+    }
+
+    //Write to a temporary file first, so an interrupted write doesn't destroy the previous checkpoint
+    std::string tmp_file = file + ".tmp";
+    writeMessageToFile(tmp_file, &builder);
+    if (std::rename(tmp_file.c_str(), file.c_str()) != 0) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Failed to move router checkpoint '%s' to '%s'\n", tmp_file.c_str(), file.c_str());
+    }
+}
+
+void RouteCheckpoint::read(const std::string& file,
+                           const Netlist<>& net_list,
+                           int width_fac,
+                           bool is_flat,
+                           t_route_iteration_state& iter_state,
+                           RoutingPredictor& routing_predictor,
+                           CBRR& connections_inf,
+                           route_budgets& budgeting_inf,
+                           vtr::vector<ParentNetId, vtr::optional<RouteTree>>& best_routing,
+                           t_clb_opins_used& best_clb_opins_used_locally,
+                           RoutingMetrics& best_routing_metrics) {
+    vtr::ScopedStartFinishTimer timer("Load router checkpoint");
+
+    auto& route_ctx = g_vpr_ctx.mutable_routing();
+    const auto& rr_graph = g_vpr_ctx.device().rr_graph;
+    size_t num_nets = net_list.nets().size();
+
+    MmapFile f(file);
+    ::capnp::FlatArrayMessageReader reader(f.getData(), default_large_capnp_opts());
+    auto in = reader.getRoot<VprRouteCheckpoint>();
+
+    //The checkpoint must be for the same routing problem
+    if (in.getNetlistId() != net_list.netlist_id().c_str()) {
+        vpr_throw(VPR_ERROR_ROUTE, file.c_str(), 0,
+                  "Router checkpoint was written for a different netlist (loaded netlist ID: %s, checkpoint netlist ID: %s)\n",
+                  net_list.netlist_id().c_str(), in.getNetlistId().cStr());
+    }
+    check_checkpoint_size(in.getNumNets(), num_nets, "nets", file);
+    check_checkpoint_size(in.getNumRrNodes(), rr_graph.num_nodes(), "RR nodes", file);
+    if (in.getChannelWidth() != width_fac || in.getIsFlat() != is_flat) {
+        vpr_throw(VPR_ERROR_ROUTE, file.c_str(), 0,
+                  "Router checkpoint was written for channel width %d (%s routing), but routing channel width %d (%s routing)\n",
+                  in.getChannelWidth(), in.getIsFlat() ? "flat" : "non-flat", width_fac, is_flat ? "flat" : "non-flat");
+    }
+
+    //Iteration state
+    iter_state.itry = in.getIteration();
+    iter_state.pres_fac = in.getPresFac();
+    iter_state.bb_fac = in.getBbFac();
+    iter_state.conflicted_mode = in.getConflictedMode();
+    iter_state.itry_conflicted_mode = in.getIterationsConflictedMode();
+    iter_state.legal_convergence_count = in.getLegalConvergenceCount();
+    iter_state.itry_since_last_convergence = in.getIterationsSinceLastConvergence();
+    iter_state.rcv_finished_count = in.getRcvFinishedCount();
+    iter_state.overuse_info = OveruseInfo(rr_graph.num_nodes());
+    iter_state.overuse_info.overused_nodes = in.getOverusedNodes();
+    iter_state.overuse_info.total_overuse = in.getTotalOveruse();
+    iter_state.overuse_info.worst_overuse = in.getWorstOveruse();
+    iter_state.success = in.getHasBestRouting();
+
+    //Rebuilds route trees, checking they are for the nets (and placement) being routed
+    auto read_route_trees = [&](::capnp::List<VprRouteTree>::Reader in_trees) {
+        check_checkpoint_size(in_trees.size(), num_nets, "route trees", file);
+
+        vtr::vector<ParentNetId, vtr::optional<RouteTree>> trees(num_nets);
+        std::vector<t_rt_node_record> nodes;
+        for (auto net_id : net_list.nets()) {
+            auto in_tree = in_trees[size_t(net_id)];
+            if (!in_tree.getIsRouted()) {
+                continue;
+            }
+
+            size_t num_sinks = net_list.net_sinks(net_id).size();
+            nodes.clear();
+            for (auto in_node : in_tree.getNodes()) {
+                t_rt_node_record record;
+                record.inode = RRNodeId(in_node.getRrNode());
+                record.parent = in_node.getParent();
+                record.parent_switch = in_node.getParentSwitch() < 0 ? RRSwitchId::INVALID() : RRSwitchId(in_node.getParentSwitch());
+                record.net_pin_index = in_node.getNetPinIndex();
+                record.re_expand = in_node.getReExpand();
+
+                bool is_root = nodes.empty();
+                if (size_t(record.inode) >= rr_graph.num_nodes()
+                    || (is_root && (record.parent != -1 || record.inode != route_ctx.net_rr_terminals[net_id][0]))
+                    || (!is_root && (record.parent < 0 || size_t(record.parent) >= nodes.size() || !record.parent_switch.is_valid() || size_t(record.parent_switch) >= rr_graph.num_rr_switches()))
+                    || record.net_pin_index < OPEN || record.net_pin_index > int(num_sinks)) {
+                    vpr_throw(VPR_ERROR_ROUTE, file.c_str(), 0,
+                              "Invalid route tree node %zu of net %zu in router checkpoint\n",
+                              nodes.size(), size_t(net_id));
+                }
+                nodes.push_back(record);
+            }
+
+            if (nodes.empty()) {
+                vpr_throw(VPR_ERROR_ROUTE, file.c_str(), 0, "Empty route tree for net %zu in router checkpoint\n", size_t(net_id));
+            }
+            trees[net_id] = make_route_tree(net_id, nodes);
+        }
+        return trees;
+    };
+
+    //Routing and congestion
+    route_ctx.route_trees = read_route_trees(in.getRouteTrees());
+
+    auto route_bbs = in.getRouteBbs();
+    check_checkpoint_size(route_bbs.size(), num_nets, "route bounding boxes", file);
+    for (auto net_id : net_list.nets()) {
+        auto in_bb = route_bbs[size_t(net_id)];
+        route_ctx.route_bb[net_id] = t_bb(in_bb.getXmin(), in_bb.getXmax(),
+                                          in_bb.getYmin(), in_bb.getYmax(),
+                                          in_bb.getLayerMin(), in_bb.getLayerMax());
+    }
+
+    route_ctx.clb_opins_used_locally = read_clb_opins_used(in.getClbOpinsUsedLocally());
+
+    auto occ = in.getOcc();
+    auto acc_cost = in.getAccCost();
+    check_checkpoint_size(occ.size(), rr_graph.num_nodes(), "RR node occupancies", file);
+    check_checkpoint_size(acc_cost.size(), rr_graph.num_nodes(), "RR node accumulated costs", file);
+    for (const RRNodeId& inode : rr_graph.nodes()) {
+        route_ctx.rr_node_cong_inf[inode].set_occ(occ[size_t(inode)]);
+        route_ctx.rr_node_cong_inf[inode].acc_cost = acc_cost[size_t(inode)];
+    }
+
+    //Routing predictor
+    auto predictor = in.getRoutingPredictor();
+    routing_predictor.iterations_.clear();
+    for (uint64_t iteration : predictor.getIterations()) {
+        routing_predictor.iterations_.push_back(iteration);
+    }
+    routing_predictor.iteration_overused_rr_node_counts_.clear();
+    for (uint64_t overused_count : predictor.getOverusedRrNodeCounts()) {
+        routing_predictor.iteration_overused_rr_node_counts_.push_back(overused_count);
+    }
+    if (routing_predictor.iterations_.size() != routing_predictor.iteration_overused_rr_node_counts_.size()) {
+        vpr_throw(VPR_ERROR_ROUTE, file.c_str(), 0, "Inconsistent routing predictor history in router checkpoint\n");
+    }
+    routing_predictor.slope_ = predictor.getSlope();
+    routing_predictor.layer_iterations_.clear();
+    routing_predictor.layer_overused_rr_node_counts_.clear();
+
+    //Connection based rerouting
+    auto rerouting = in.getConnectionRerouting();
+    auto lower_bounds = rerouting.getLowerBoundConnectionDelays();
+    auto forced_sinks = rerouting.getForcedRerouteSinks();
+    check_checkpoint_size(lower_bounds.size(), num_nets, "connection delay lower bounds", file);
+    check_checkpoint_size(forced_sinks.size(), num_nets, "forced reroutes", file);
+    for (auto net_id : net_list.nets()) {
+        std::vector<float>& net_lower_bounds = connections_inf.lower_bound_connection_delay[net_id];
+        auto in_lower_bounds = lower_bounds[size_t(net_id)];
+        check_checkpoint_size(in_lower_bounds.size(), net_lower_bounds.size(), "connection delay lower bounds", file);
+        for (size_t ipin = 0; ipin < net_lower_bounds.size(); ++ipin) {
+            net_lower_bounds[ipin] = in_lower_bounds[ipin];
+        }
+
+        auto& net_flags = connections_inf.forcible_reroute_connection_flag[net_id];
+        for (auto& sink_flag : net_flags) {
+            sink_flag.second = false;
+        }
+        for (uint32_t sink : forced_sinks[size_t(net_id)]) {
+            auto itr = net_flags.find(RRNodeId(sink));
+            if (itr == net_flags.end()) {
+                vpr_throw(VPR_ERROR_ROUTE, file.c_str(), 0, "Forced reroute of net %zu to a node which isn't one of its sinks in router checkpoint\n", size_t(net_id));
+            }
+            itr->second = true;
+        }
+    }
+    connections_inf.last_stable_critical_path_delay = rerouting.getLastStableCriticalPathDelay();
+    connections_inf.critical_path_growth_tolerance = rerouting.getCriticalPathGrowthTolerance();
+    connections_inf.connection_criticality_tolerance = rerouting.getConnectionCriticalityTolerance();
+    connections_inf.connection_delay_optimality_tolerance = rerouting.getConnectionDelayOptimalityTolerance();
+
+    //Routing budgets
+    auto budgets = in.getRouteBudgets();
+    budgeting_inf.free_budgets();
+    if (budgets.getIsSet()) {
+        budgeting_inf.alloc_budget_memory();
+        budgeting_inf.num_times_congested.resize(num_nets, 0);
+        budgeting_inf.set = true;
+
+        read_net_pins_matrix(budgets.getDelayMinBudget(), budgeting_inf.delay_min_budget, net_list, file);
+        read_net_pins_matrix(budgets.getDelayMaxBudget(), budgeting_inf.delay_max_budget, net_list, file);
+        read_net_pins_matrix(budgets.getDelayTarget(), budgeting_inf.delay_target, net_list, file);
+        read_net_pins_matrix(budgets.getDelayLowerBound(), budgeting_inf.delay_lower_bound, net_list, file);
+        read_net_pins_matrix(budgets.getDelayUpperBound(), budgeting_inf.delay_upper_bound, net_list, file);
+        read_net_pins_matrix(budgets.getShortPathCrit(), budgeting_inf.short_path_crit, net_list, file);
+
+        auto num_times_congested = budgets.getNumTimesCongested();
+        check_checkpoint_size(num_times_congested.size(), num_nets, "routing budget congestion counts", file);
+        for (auto net_id : net_list.nets()) {
+            budgeting_inf.num_times_congested[net_id] = num_times_congested[size_t(net_id)];
+        }
+
+        budgeting_inf.negative_hold_slacks = std::queue<float>();
+        for (float slack : budgets.getNegativeHoldSlacks()) {
+            budgeting_inf.negative_hold_slacks.push(slack);
+        }
+
+        budgeting_inf.should_reroute_for_hold.clear();
+        for (auto net_reroute : budgets.getShouldRerouteForHold()) {
+            budgeting_inf.should_reroute_for_hold[ParentNetId(net_reroute.getNet())] = net_reroute.getValue();
+        }
+
+        budgeting_inf.hold_fac.clear();
+        for (auto net_hold_fac : budgets.getHoldFac()) {
+            budgeting_inf.hold_fac[ParentNetId(net_hold_fac.getNet())] = net_hold_fac.getValue();
+        }
+    }
+
+    //Best routing
+    if (iter_state.success) {
+        best_routing = read_route_trees(in.getBestRouteTrees());
+        best_clb_opins_used_locally = read_clb_opins_used(in.getBestClbOpinsUsedLocally());
+
+        auto metrics = in.getBestRoutingMetrics();
+        best_routing_metrics.used_wirelength = metrics.getUsedWirelength();
+        best_routing_metrics.sWNS = metrics.getSetupWns();
+        best_routing_metrics.sTNS = metrics.getSetupTns();
+        best_routing_metrics.hWNS = metrics.getHoldWns();
+        best_routing_metrics.hTNS = metrics.getHoldTns();
+        //Only the critical path delay and slack are used once the routing has been found
+        best_routing_metrics.critical_path = tatum::TimingPathInfo(tatum::TimingType::SETUP,
+                                                                   metrics.getCriticalPathDelay(),
+                                                                   metrics.getCriticalPathSlack(),
+                                                                   tatum::NodeId::INVALID(),
+                                                                   tatum::NodeId::INVALID(),
+                                                                   tatum::DomainId::INVALID(),
+                                                                   tatum::DomainId::INVALID());
+    }
+
+    VTR_LOG("Loaded router checkpoint '%s' after routing iteration %d\n", file.c_str(), iter_state.itry);
+}
+
+RouteTree RouteCheckpoint::make_route_tree(ParentNetId net_id, const std::vector<t_rt_node_record>& nodes) {
+    VTR_ASSERT(!nodes.empty() && nodes[0].parent == -1);
+
+    RouteTree tree(net_id);
+    VTR_ASSERT(tree._root->inode == nodes[0].inode);
+    tree._root->net_pin_index = nodes[0].net_pin_index;
+    tree._root->re_expand = nodes[0].re_expand;
+
+    std::vector<std::vector<int>> children(nodes.size());
+    for (size_t irecord = 1; irecord < nodes.size(); ++irecord) {
+        children[nodes[irecord].parent].push_back(irecord);
+    }
+    add_route_tree_children(tree, tree._root, 0, nodes, children);
+
+    tree.reload_timing();
+    return tree;
+}
+
+void RouteCheckpoint::add_route_tree_children(RouteTree& tree,
+                                              RouteTreeNode* parent,
+                                              int parent_record,
+                                              const std::vector<t_rt_node_record>& nodes,
+                                              const std::vector<std::vector<int>>& children) {
+    //RouteTree::add_node() puts a node before its existing siblings, so the children
+    //are added last to first to keep them in their original order
+    const std::vector<int>& parent_children = children[parent_record];
+    for (auto itr = parent_children.rbegin(); itr != parent_children.rend(); ++itr) {
+        const t_rt_node_record& record = nodes[*itr];
+
+        RouteTreeNode node_value(record.inode, record.parent_switch);
+        node_value.net_pin_index = record.net_pin_index;
+        node_value.re_expand = record.re_expand;
+        node_value.R_upstream = std::numeric_limits<float>::quiet_NaN();
+        node_value.C_downstream = std::numeric_limits<float>::quiet_NaN();
+        node_value.Tdel = std::numeric_limits<float>::quiet_NaN();
+        RouteTreeNode* node = tree.add_node(parent, node_value);
+
+        if (record.net_pin_index > 0) {
+            tree._is_isink_reached.set(record.net_pin_index, true);
+        }
+
+        add_route_tree_children(tree, node, *itr, nodes, children);
+    }
+}
+
+static void write_route_trees(::capnp::List<VprRouteTree>::Builder out,
+                              const vtr::vector<ParentNetId, vtr::optional<RouteTree>>& trees) {
+    std::unordered_map<const RouteTreeNode*, int> node_index;
+    for (size_t inet = 0; inet < trees.size(); ++inet) {
+        const vtr::optional<RouteTree>& tree = trees[ParentNetId(inet)];
+        auto out_tree = out[inet];
+        out_tree.setIsRouted(tree.has_value());
+        if (!tree) {
+            continue;
+        }
+
+        //Number the nodes in pre-order (the order all_nodes() walks them in)
+        node_index.clear();
+        for (const RouteTreeNode& rt_node : tree->all_nodes()) {
+            node_index.emplace(&rt_node, node_index.size());
+        }
+
+        auto out_nodes = out_tree.initNodes(node_index.size());
+        for (const RouteTreeNode& rt_node : tree->all_nodes()) {
+            auto out_node = out_nodes[node_index.at(&rt_node)];
+            auto parent = rt_node.parent();
+
+            out_node.setRrNode(size_t(rt_node.inode));
+            out_node.setParent(parent ? node_index.at(&parent.value()) : -1);
+            out_node.setParentSwitch(rt_node.parent_switch.is_valid() ? int(size_t(rt_node.parent_switch)) : -1);
+            out_node.setNetPinIndex(rt_node.net_pin_index);
+            out_node.setReExpand(rt_node.re_expand);
+        }
+    }
+}
+
+static void write_clb_opins_used(::capnp::List<VprClbOpinsUsed>::Builder out,
+                                 const t_clb_opins_used& clb_opins_used) {
+    for (size_t iblk = 0; iblk < clb_opins_used.size(); ++iblk) {
+        const auto& blk_classes = clb_opins_used[ClusterBlockId(iblk)];
+        auto out_classes = out[iblk].initClasses(blk_classes.size());
+        for (size_t iclass = 0; iclass < blk_classes.size(); ++iclass) {
+            auto out_pins = out_classes.init(iclass, blk_classes[iclass].size());
+            for (size_t ipin = 0; ipin < blk_classes[iclass].size(); ++ipin) {
+                out_pins.set(ipin, size_t(blk_classes[iclass][ipin]));
+            }
+        }
+    }
+}
+
+static t_clb_opins_used read_clb_opins_used(::capnp::List<VprClbOpinsUsed>::Reader in) {
+    t_clb_opins_used clb_opins_used(in.size());
+    for (size_t iblk = 0; iblk < in.size(); ++iblk) {
+        auto& blk_classes = clb_opins_used[ClusterBlockId(iblk)];
+        for (auto in_pins : in[iblk].getClasses()) {
+            blk_classes.emplace_back();
+            for (uint32_t inode : in_pins) {
+                blk_classes.back().push_back(RRNodeId(inode));
+            }
+        }
+    }
+    return clb_opins_used;
+}
+
+static void write_net_pins_matrix(::capnp::List<::capnp::List<float>>::Builder out,
+                                  const NetPinsMatrix<float>& matrix,
+                                  const Netlist<>& net_list) {
+    for (auto net_id : net_list.nets()) {
+        auto row = matrix[net_id];
+        auto out_row = out.init(size_t(net_id), row.size());
+        for (size_t ipin = 0; ipin < row.size(); ++ipin) {
+            out_row.set(ipin, row[ipin]);
+        }
+    }
+}
+
+static void read_net_pins_matrix(::capnp::List<::capnp::List<float>>::Reader in,
+                                 NetPinsMatrix<float>& matrix,
+                                 const Netlist<>& net_list,
+                                 const std::string& file) {
+    check_checkpoint_size(in.size(), net_list.nets().size(), "routing budgets", file);
+    for (auto net_id : net_list.nets()) {
+        auto row = matrix[net_id];
+        auto in_row = in[size_t(net_id)];
+        check_checkpoint_size(in_row.size(), row.size(), "routing budget net pins", file);
+        for (size_t ipin = 0; ipin < row.size(); ++ipin) {
+            row[ipin] = in_row[ipin];
+        }
+    }
+}
+
+static void check_checkpoint_size(size_t found, size_t expected, const char* what, const std::string& file) {
+    if (found != expected) {
+        vpr_throw(VPR_ERROR_ROUTE, file.c_str(), 0,
+                  "Router checkpoint has %zu %s, but %zu were expected (was it written for this netlist, placement and architecture?)\n",
+                  found, what, expected);
+    }
+}
+
+#endif /* VTR_ENABLE_CAPNPROTO */
@@ -0,0 +1,98 @@
+#pragma once
+
+/**
+ * @file
+ * @brief Binary (Cap'n Proto) checkpoints of the router state after a routing iteration.
+ *
+ * A checkpoint holds everything route() needs to continue from the following
+ * routing iteration: the route tree and bounding box of every net, the
+ * occupancy and accumulated cost of every RR node, the locally used OPINs,
+ * the iteration state (present congestion factor, convergence counts, ...),
+ * the best routing found so far, and the state of the routing predictor, of
+ * connection based rerouting and of the routing budgets.
+ *
+ * Timing is not saved: net delays are recomputed from the restored route trees.
+ * Router statistics are not saved either, so they only cover the resumed run.
+ *
+ * Checkpoints require VPR to be built with Cap'n Proto support.
+ */
+
+#include <string>
+#include <vector>
+
+#include "connection_based_routing.h"
+#include "netlist.h"
+#include "route_budgets.h"
+#include "route_tree.h"
+#include "route_utils.h"
+#include "router_stats.h"
+#include "routing_predictor.h"
+#include "vpr_types.h"
+
+/** State of the routing iteration loop in route() which isn't held in the routing context */
+struct t_route_iteration_state {
+    int itry = 0; ///<Last routing iteration completed
+    float pres_fac = 0.;
+    int bb_fac = 0;
+    bool conflicted_mode = false; ///<Is the router in RouterCongestionMode::CONFLICTED?
+    int itry_conflicted_mode = 0;
+    int legal_convergence_count = 0;
+    int itry_since_last_convergence = -1;
+    int rcv_finished_count = 0;
+    OveruseInfo overuse_info;
+    bool success = false; ///<Has a legal routing (the best routing) been found?
+};
+
+/** Writes and reads router checkpoints.
+ * This class is a friend of the router classes whose state is checkpointed,
+ * so that their internals don't need to be exposed. */
+class RouteCheckpoint {
+  public:
+    /** Write the router state to file: the routing context (route trees and bounding boxes,
+     * RR node congestion, locally used OPINs) and the given state. */
+    static void write(const std::string& file,
+                      const Netlist<>& net_list,
+                      int width_fac,
+                      bool is_flat,
+                      const t_route_iteration_state& iter_state,
+                      const RoutingPredictor& routing_predictor,
+                      const CBRR& connections_inf,
+                      const route_budgets& budgeting_inf,
+                      const vtr::vector<ParentNetId, vtr::optional<RouteTree>>& best_routing,
+                      const t_clb_opins_used& best_clb_opins_used_locally,
+                      const RoutingMetrics& best_routing_metrics);
+
+    /** Restore the router state written by write(). The routing context must have been
+     * initialized (init_route_structs()) for the same netlist and RR graph. */
+    static void read(const std::string& file,
+                     const Netlist<>& net_list,
+                     int width_fac,
+                     bool is_flat,
+                     t_route_iteration_state& iter_state,
+                     RoutingPredictor& routing_predictor,
+                     CBRR& connections_inf,
+                     route_budgets& budgeting_inf,
+                     vtr::vector<ParentNetId, vtr::optional<RouteTree>>& best_routing,
+                     t_clb_opins_used& best_clb_opins_used_locally,
+                     RoutingMetrics& best_routing_metrics);
+
+  private:
+    /** A route tree node as stored in a checkpoint (nodes are listed in pre-order) */
+    struct t_rt_node_record {
+        RRNodeId inode;
+        int parent; ///<Index of the parent record, -1 for the root
+        RRSwitchId parent_switch;
+        int net_pin_index;
+        bool re_expand;
+    };
+
+    /** Rebuild the route tree of net_id from its pre-ordered node records */
+    static RouteTree make_route_tree(ParentNetId net_id, const std::vector<t_rt_node_record>& nodes);
+
+    /** Add the (record) children of parent_record below parent, recursively */
+    static void add_route_tree_children(RouteTree& tree,
+                                        RouteTreeNode* parent,
+                                        int parent_record,
+                                        const std::vector<t_rt_node_record>& nodes,
+                                        const std::vector<std::vector<int>>& children);
+};
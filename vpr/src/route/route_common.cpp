@@ -70,7 +70,7 @@ void save_routing(vtr::vector<ParentNetId, vtr::optional<RouteTree>>& best_routi
                   t_clb_opins_used& saved_clb_opins_used_locally) {
     auto& route_ctx = g_vpr_ctx.routing();
 
-    best_routing = route_ctx.route_trees;
+    copy_changed_route_trees(best_routing, route_ctx.route_trees);
 
     /* Save which OPINs are locally used. */
     saved_clb_opins_used_locally = clb_opins_used_locally;
@@ -83,12 +83,37 @@ void restore_routing(vtr::vector<ParentNetId, vtr::optional<RouteTree>>& best_ro
                      const t_clb_opins_used& saved_clb_opins_used_locally) {
     auto& route_ctx = g_vpr_ctx.mutable_routing();
 
-    route_ctx.route_trees = best_routing;
+    copy_changed_route_trees(route_ctx.route_trees, best_routing);
 
     /* Restore which OPINs are locally used. */
     clb_opins_used_locally = saved_clb_opins_used_locally;
 }
 
+bool is_same_route_tree(const vtr::optional<RouteTree>& lhs, const vtr::optional<RouteTree>& rhs) {
+    if (!lhs || !rhs)
+        return !lhs && !rhs;
+    return lhs->version() == rhs->version();
+}
+
+/* Between two snapshots of the routing, only the nets which were rerouted change:
+ * skip copying the others, which are most of the nets in the late iterations. */
+size_t copy_changed_route_trees(vtr::vector<ParentNetId, vtr::optional<RouteTree>>& dst_trees,
+                                const vtr::vector<ParentNetId, vtr::optional<RouteTree>>& src_trees) {
+    dst_trees.resize(src_trees.size());
+
+    size_t num_copied = 0;
+    for (size_t inet = 0; inet < src_trees.size(); inet++) {
+        ParentNetId net_id(inet);
+        if (is_same_route_tree(dst_trees[net_id], src_trees[net_id]))
+            continue;
+
+        dst_trees[net_id] = src_trees[net_id];
+        num_copied++;
+    }
+
+    return num_copied;
+}
+
 /* This routine finds a "magic cookie" for the routing and prints it.    *
  * Use this number as a routing serial number to ensure that programming *
  * changes do not break the router.                                      */
@@ -125,7 +150,7 @@ bool feasible_routing() {
     auto& route_ctx = g_vpr_ctx.routing();
 
     for (const RRNodeId& rr_id : rr_graph.nodes()) {
-        if (route_ctx.rr_node_route_inf[rr_id].occ() > rr_graph.node_capacity(rr_id)) {
+        if (route_ctx.rr_node_cong_inf[rr_id].occ() > rr_graph.node_capacity(rr_id)) {
             return (false);
         }
     }
@@ -141,7 +166,7 @@ std::vector<RRNodeId> collect_congested_rr_nodes() {
 
     std::vector<RRNodeId> congested_rr_nodes;
     for (const RRNodeId inode : device_ctx.rr_graph.nodes()) {
-        short occ = route_ctx.rr_node_route_inf[inode].occ();
+        short occ = route_ctx.rr_node_cong_inf[inode].occ();
         short capacity = rr_graph.node_capacity(inode);
 
         if (occ > capacity) {
@@ -175,8 +200,8 @@ vtr::vector<RRNodeId, std::set<ClusterNetId>> collect_rr_node_nets() {
 void pathfinder_update_single_node_occupancy(RRNodeId inode, int add_or_sub) {
     auto& route_ctx = g_vpr_ctx.mutable_routing();
 
-    int occ = route_ctx.rr_node_route_inf[inode].occ() + add_or_sub;
-    route_ctx.rr_node_route_inf[inode].set_occ(occ);
+    // Atomic, since the parallel router may update the same node from several threads
+    int occ = route_ctx.rr_node_cong_inf[inode].add_occ(add_or_sub);
     // can't have negative occupancy
     VTR_ASSERT(occ >= 0);
 }
@@ -192,19 +217,27 @@ void pathfinder_update_acc_cost_and_overuse_info(float acc_fac, OveruseInfo& ove
     const auto& rr_graph = device_ctx.rr_graph;
     auto& route_ctx = g_vpr_ctx.mutable_routing();
 
+    // Overused nodes are also counted per die on multi-die devices
+    size_t num_layers = device_ctx.grid.get_num_layers();
+    size_t num_layer_counts = num_layers > 1 ? num_layers : 0;
+
 #ifdef VPR_USE_TBB
     tbb::combinable<size_t> overused_nodes(0), total_overuse(0), worst_overuse(0);
+    tbb::combinable<std::vector<size_t>> layer_overused_nodes([&]() { return std::vector<size_t>(num_layer_counts, 0); });
     tbb::parallel_for_each(rr_graph.nodes().begin(), rr_graph.nodes().end(), [&](RRNodeId rr_id) {
-        int overuse = route_ctx.rr_node_route_inf[rr_id].occ() - rr_graph.node_capacity(rr_id);
+        int overuse = route_ctx.rr_node_cong_inf[rr_id].occ() - rr_graph.node_capacity(rr_id);
 
         // If overused, update the acc_cost and add this node to the overuse info
         // If not, do nothing
         if (overuse > 0) {
-            route_ctx.rr_node_route_inf[rr_id].acc_cost += overuse * acc_fac;
+            route_ctx.rr_node_cong_inf[rr_id].acc_cost += overuse * acc_fac;
 
             ++overused_nodes.local();
             total_overuse.local() += overuse;
             worst_overuse.local() = std::max(worst_overuse.local(), size_t(overuse));
+            if (num_layer_counts) {
+                ++layer_overused_nodes.local()[rr_graph.node_layer(rr_id)];
+            }
         }
     });
 
@@ -212,20 +245,30 @@ void pathfinder_update_acc_cost_and_overuse_info(float acc_fac, OveruseInfo& ove
     overuse_info.overused_nodes = overused_nodes.combine(std::plus<size_t>());
     overuse_info.total_overuse = total_overuse.combine(std::plus<size_t>());
     overuse_info.worst_overuse = worst_overuse.combine([](size_t a, size_t b) { return std::max(a, b); });
+    overuse_info.layer_overused_nodes.assign(num_layer_counts, 0);
+    layer_overused_nodes.combine_each([&](const std::vector<size_t>& counts) {
+        for (size_t layer = 0; layer < num_layer_counts; layer++) {
+            overuse_info.layer_overused_nodes[layer] += counts[layer];
+        }
+    });
 #else
     size_t overused_nodes = 0, total_overuse = 0, worst_overuse = 0;
+    std::vector<size_t> layer_overused_nodes(num_layer_counts, 0);
 
     for (const RRNodeId& rr_id : rr_graph.nodes()) {
-        int overuse = route_ctx.rr_node_route_inf[rr_id].occ() - rr_graph.node_capacity(rr_id);
+        int overuse = route_ctx.rr_node_cong_inf[rr_id].occ() - rr_graph.node_capacity(rr_id);
 
         // If overused, update the acc_cost and add this node to the overuse info
         // If not, do nothing
         if (overuse > 0) {
-            route_ctx.rr_node_route_inf[rr_id].acc_cost += overuse * acc_fac;
+            route_ctx.rr_node_cong_inf[rr_id].acc_cost += overuse * acc_fac;
 
             ++overused_nodes;
             total_overuse += overuse;
             worst_overuse = std::max(worst_overuse, size_t(overuse));
+            if (num_layer_counts) {
+                ++layer_overused_nodes[rr_graph.node_layer(rr_id)];
+            }
         }
     }
 
@@ -233,6 +276,7 @@ void pathfinder_update_acc_cost_and_overuse_info(float acc_fac, OveruseInfo& ove
     overuse_info.overused_nodes = overused_nodes;
     overuse_info.total_overuse = total_overuse;
     overuse_info.worst_overuse = worst_overuse;
+    overuse_info.layer_overused_nodes = std::move(layer_overused_nodes);
 #endif
 }
 
@@ -399,8 +443,10 @@ void alloc_and_load_rr_node_route_structs() {
     auto& device_ctx = g_vpr_ctx.device();
 
     route_ctx.rr_node_route_inf.resize(device_ctx.rr_graph.num_nodes());
+    route_ctx.rr_node_cong_inf.resize(device_ctx.rr_graph.num_nodes());
     route_ctx.non_configurable_bitset.resize(device_ctx.rr_graph.num_nodes());
     route_ctx.non_configurable_bitset.fill(false);
+    route_ctx.verified_route_tree_fingerprints.clear();
 
     reset_rr_node_route_structs();
 
@@ -417,15 +463,18 @@ void reset_rr_node_route_structs() {
     auto& device_ctx = g_vpr_ctx.device();
 
     VTR_ASSERT(route_ctx.rr_node_route_inf.size() == size_t(device_ctx.rr_graph.num_nodes()));
+    VTR_ASSERT(route_ctx.rr_node_cong_inf.size() == size_t(device_ctx.rr_graph.num_nodes()));
 
     for (const RRNodeId& rr_id : device_ctx.rr_graph.nodes()) {
         auto& node_inf = route_ctx.rr_node_route_inf[rr_id];
 
         node_inf.prev_edge = RREdgeId::INVALID();
-        node_inf.acc_cost = 1.0;
         node_inf.path_cost = std::numeric_limits<float>::infinity();
         node_inf.backward_path_cost = std::numeric_limits<float>::infinity();
-        node_inf.set_occ(0);
+
+        auto& node_cong_inf = route_ctx.rr_node_cong_inf[rr_id];
+        node_cong_inf.acc_cost = 1.0;
+        node_cong_inf.set_occ(0);
     }
 }
 
@@ -868,14 +917,14 @@ static void adjust_one_rr_occ_and_acc_cost(RRNodeId inode, int add_or_sub, float
     auto& device_ctx = g_vpr_ctx.device();
     const auto& rr_graph = device_ctx.rr_graph;
 
-    int new_occ = route_ctx.rr_node_route_inf[inode].occ() + add_or_sub;
+    int new_occ = route_ctx.rr_node_cong_inf[inode].occ() + add_or_sub;
     int capacity = rr_graph.node_capacity(inode);
-    route_ctx.rr_node_route_inf[inode].set_occ(new_occ);
+    route_ctx.rr_node_cong_inf[inode].set_occ(new_occ);
 
     if (new_occ < capacity) {
     } else {
         if (add_or_sub == 1) {
-            route_ctx.rr_node_route_inf[inode].acc_cost += (new_occ - capacity) * acc_fac;
+            route_ctx.rr_node_cong_inf[inode].acc_cost += (new_occ - capacity) * acc_fac;
         }
     }
 }
@@ -903,7 +952,7 @@ void print_invalid_routing_info(const Netlist<>& net_list, bool is_flat) {
         node_x = rr_graph.node_xlow(inode);
         node_y = rr_graph.node_ylow(inode);
 
-        int occ = route_ctx.rr_node_route_inf[inode].occ();
+        int occ = route_ctx.rr_node_cong_inf[inode].occ();
         int cap = rr_graph.node_capacity(inode);
         if (occ > cap) {
             VTR_LOG("  %s is overused (occ=%d capacity=%d)\n", describe_rr_node(rr_graph, device_ctx.grid, device_ctx.rr_indexed_data, inode, is_flat).c_str(), occ, cap);
@@ -961,7 +1010,7 @@ void print_rr_node_route_inf_dot() {
         const auto& inf = route_ctx.rr_node_route_inf[RRNodeId(inode)];
         if (!std::isinf(inf.path_cost)) {
             VTR_LOG("\tnode%zu[label=\"{%zu (%s)", inode, inode, rr_graph.node_type_string(RRNodeId(inode)));
-            if (inf.occ() > rr_graph.node_capacity(RRNodeId(inode))) {
+            if (route_ctx.rr_node_cong_inf[RRNodeId(inode)].occ() > rr_graph.node_capacity(RRNodeId(inode))) {
                 VTR_LOG(" x");
             }
             VTR_LOG("}\"]\n");
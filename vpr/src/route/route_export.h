@@ -17,6 +17,14 @@ vtr::vector<RRNodeId, std::set<ClusterNetId>> collect_rr_node_nets();
 
 void free_route_structs();
 
+/** Make dst_trees a copy of src_trees, copying only the route trees which differ (see RouteTree::version()).
+ * Returns the number of route trees copied. */
+size_t copy_changed_route_trees(vtr::vector<ParentNetId, vtr::optional<RouteTree>>& dst_trees,
+                                const vtr::vector<ParentNetId, vtr::optional<RouteTree>>& src_trees);
+
+/** Is the route tree of a net the same in both routings? (see RouteTree::version()) */
+bool is_same_route_tree(const vtr::optional<RouteTree>& lhs, const vtr::optional<RouteTree>& rhs);
+
 void save_routing(vtr::vector<ParentNetId, vtr::optional<RouteTree>>& best_routing,
                   const t_clb_opins_used& clb_opins_used_locally,
                   t_clb_opins_used& saved_clb_opins_used_locally);
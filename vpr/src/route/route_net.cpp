@@ -1,6 +1,7 @@
 /** @file Impls for non-templated net routing fns & utils */
 
 #include "route_net.h"
+#include "router_phase_profiling.h"
 #include "stats.h"
 
 bool check_hold(const t_router_opts& router_opts, float worst_neg_slack) {
@@ -19,6 +20,7 @@ void setup_net(int itry,
                const t_router_opts& router_opts,
                float worst_neg_slack) {
     auto& route_ctx = g_vpr_ctx.mutable_routing();
+    router_phase_profiling::ScopedPhase phase(e_router_phase::ROUTE_TREE);
 
     /* "tree" points to this net's spot in the global context here, so re-initializing it etc. changes the global state */
     vtr::optional<RouteTree>& tree = route_ctx.route_trees[net_id];
@@ -28,7 +30,11 @@ void setup_net(int itry,
 
     // for nets below a certain size (min_incremental_reroute_fanout), rip up any old routing
     // otherwise, we incrementally reroute by reusing legal parts of the previous iteration
-    if (num_sinks < router_opts.min_incremental_reroute_fanout || itry == 1 || ripup_high_fanout_nets) {
+    // (once little overuse remains, every net is rerouted incrementally: see incremental_reroute_overuse_threshold)
+    // the first iteration routes from scratch, unless it starts from a restored routing (see RoutingWarmStart)
+    bool small_net = num_sinks < router_opts.min_incremental_reroute_fanout && !connections_inf.should_incrementally_reroute_all_nets();
+    bool first_iteration = itry == 1 && !connections_inf.should_incrementally_reroute_all_nets();
+    if (small_net || first_iteration || ripup_high_fanout_nets) {
         profiling::net_rerouted();
 
         /* rip up the whole net */
@@ -150,7 +156,7 @@ bool should_route_net(const Netlist<>& net_list,
     /* Walk over all rt_nodes in the net */
     for (auto& rt_node : tree.all_nodes()) {
         RRNodeId inode = rt_node.inode;
-        int occ = route_ctx.rr_node_route_inf[inode].occ();
+        int occ = route_ctx.rr_node_cong_inf[inode].occ();
         int capacity = rr_graph.node_capacity(inode);
 
         if (occ > capacity) {
@@ -63,7 +63,9 @@ constexpr bool is_high_fanout(int fanout, int fanout_threshold) {
 
 /** Setup the current route tree for this net.
  * Depending on # of fanouts, this fn either resets or prunes the route tree
- * and updates other global data structures to match its state. */
+ * and updates other global data structures to match its state.
+ * If \p connections_inf says to reroute all nets incrementally, the tree is pruned
+ * regardless of fanout. */
 void setup_net(int itry,
                ParentNetId net_id,
                const Netlist<>& net_list,
@@ -119,9 +121,10 @@ void update_rr_route_inf_from_tree(const RouteTreeNode& rt_node);
  * (return a vector with indices of set bits) */
 inline std::vector<size_t> sink_mask_to_vector(const vtr::dynamic_bitset<>& mask, size_t num_sinks) {
     std::vector<size_t> out;
-    for (size_t i = 1; i < num_sinks + 1; i++)
-        if (mask.get(i))
+    mask.for_each_set_bit([&](size_t i) {
+        if (i >= 1 && i < num_sinks + 1)
             out.push_back(i);
+    });
     return out;
 }
 
@@ -12,6 +12,8 @@
 #include "route_common.h"
 #include "route_debug.h"
 #include "route_profiling.h"
+#include "router_phase_profiling.h"
+#include "sink_sampling.h"
 #include "rr_graph_fwd.h"
 #include "vtr_dynamic_bitset.h"
 
@@ -133,6 +135,14 @@ inline NetResultFlags route_net(ConnectionRouter& router,
         return pin_criticality[a] > pin_criticality[b];
     });
 
+    // route the less critical sinks of high fanout nets in spatial batches (the critical ones still go first)
+    if (high_fanout && router_opts.high_fanout_batch_criticality >= 0.) {
+        auto first_batched = std::find_if(begin(remaining_targets), end(remaining_targets), [&](int ipin) {
+            return pin_criticality[ipin] <= router_opts.high_fanout_batch_criticality;
+        });
+        sink_sampling::batch_sinks_by_bin(net_id, spatial_route_tree_lookup, first_batched, end(remaining_targets));
+    }
+
     /* Update base costs according to fanout and criticality rules */
     update_rr_base_costs(num_sinks);
 
@@ -145,6 +155,7 @@ inline NetResultFlags route_net(ConnectionRouter& router,
     cost_params.delay_budget = ((budgeting_inf.if_set()) ? &conn_delay_budget : nullptr);
 
     // Pre-route to clock source for clock nets (marked as global nets)
+    bool routed_to_clock_root = false;
     if (net_list.net_is_global(net_id) && router_opts.two_stage_clock_routing) {
         auto& route_constraints = route_ctx.constraints;
         std::string net_name = net_list.net_name(net_id);
@@ -193,6 +204,8 @@ inline NetResultFlags route_net(ConnectionRouter& router,
 
             if (flags.success == false)
                 return flags;
+
+            routed_to_clock_root = true;
         }
     }
 
@@ -235,7 +248,8 @@ inline NetResultFlags route_net(ConnectionRouter& router,
                                      routing_predictor,
                                      choking_spots,
                                      is_flat,
-                                     net_bb);
+                                     net_bb,
+                                     routed_to_clock_root && router_opts.dedicated_clock_sink_routing);
 
         flags.retry_with_full_bb |= sink_flags.retry_with_full_bb;
 
@@ -260,11 +274,14 @@ inline NetResultFlags route_net(ConnectionRouter& router,
     float* net_delay = net_delays[net_id].data();
 
     // may have to update timing delay of the previously legally reached sinks since downstream capacitance could be changed
-    update_net_delays_from_route_tree(net_delay,
-                                      net_list,
-                                      net_id,
-                                      timing_info,
-                                      pin_timing_invalidator);
+    {
+        router_phase_profiling::ScopedPhase phase(e_router_phase::TIMING_ANALYSIS);
+        update_net_delays_from_route_tree(net_delay,
+                                          net_list,
+                                          net_id,
+                                          timing_info,
+                                          pin_timing_invalidator);
+    }
 
     if (router_opts.update_lower_bound_delays) {
         for (int ipin : remaining_targets) {
@@ -272,7 +289,7 @@ inline NetResultFlags route_net(ConnectionRouter& router,
         }
     }
 
-    VTR_ASSERT_MSG(g_vpr_ctx.routing().rr_node_route_inf[tree.root().inode].occ() <= rr_graph.node_capacity(tree.root().inode), "SOURCE should never be congested");
+    VTR_ASSERT_MSG(g_vpr_ctx.routing().rr_node_cong_inf[tree.root().inode].occ() <= rr_graph.node_capacity(tree.root().inode), "SOURCE should never be congested");
     VTR_LOGV_DEBUG(f_router_debug, "Routed Net %zu (%zu sinks)\n", size_t(net_id), num_sinks);
 
     router.empty_rcv_route_tree_set(); // ?
@@ -351,7 +368,10 @@ inline NetResultFlags pre_route_to_clock_root(ConnectionRouter& router,
      * points. Therefore, we can set the net pin index of the sink node to      *
      * OPEN (meaning illegal) as it is not meaningful for this sink.            */
     vtr::optional<const RouteTreeNode&> new_branch, new_sink;
-    std::tie(new_branch, new_sink) = tree.update_from_heap(&cheapest, OPEN, ((high_fanout) ? &spatial_rt_lookup : nullptr), is_flat);
+    {
+        router_phase_profiling::ScopedPhase phase(e_router_phase::ROUTE_TREE);
+        std::tie(new_branch, new_sink) = tree.update_from_heap(&cheapest, OPEN, ((high_fanout) ? &spatial_rt_lookup : nullptr), is_flat, router.get_rr_node_route_inf());
+    }
 
     VTR_ASSERT_DEBUG(!high_fanout || validate_route_tree_spatial_lookup(tree.root(), spatial_rt_lookup));
 
@@ -371,7 +391,7 @@ inline NetResultFlags pre_route_to_clock_root(ConnectionRouter& router,
     // - remove sink from route tree and fix routing for all nodes leading to the sink ("freeze")
     // - free up virtual sink occupancy
     tree.freeze();
-    m_route_ctx.rr_node_route_inf[sink_node].set_occ(0);
+    m_route_ctx.rr_node_cong_inf[sink_node].set_occ(0);
 
     // routed to a sink successfully
     out.success = true;
@@ -398,6 +418,7 @@ inline NetResultFlags pre_route_to_clock_root(ConnectionRouter& router,
  * @param choking_spots
  * @param is_flat
  * @param net_bb Bounding box for the net (Routing resources outside net_bb will not be used)
+ * @param through_clock_network Try to reach the sink through the clock network the net was pre-routed to first
  * @return NetResultFlags for this sink to be bubbled up through route_net */
 template<typename ConnectionRouter>
 inline NetResultFlags route_sink(ConnectionRouter& router,
@@ -414,7 +435,8 @@ inline NetResultFlags route_sink(ConnectionRouter& router,
                                  const RoutingPredictor& routing_predictor,
                                  const std::vector<std::unordered_map<RRNodeId, int>>& choking_spots,
                                  bool is_flat,
-                                 const t_bb& net_bb) {
+                                 const t_bb& net_bb,
+                                 bool through_clock_network) {
     const auto& device_ctx = g_vpr_ctx.device();
     auto& route_ctx = g_vpr_ctx.mutable_routing();
 
@@ -427,7 +449,7 @@ inline NetResultFlags route_sink(ConnectionRouter& router,
 
     router.clear_modified_rr_node_info();
 
-    bool found_path;
+    bool found_path = false;
     t_heap cheapest;
 
     bool net_is_global = net_list.net_is_global(net_id);
@@ -439,10 +461,19 @@ inline NetResultFlags route_sink(ConnectionRouter& router,
     bool has_choking_spot = ((int)choking_spots[target_pin].size() != 0) && router_opts.has_choking_spot;
     ConnectionParameters conn_params(net_id, target_pin, has_choking_spot, choking_spots[target_pin]);
 
+    if (through_clock_network) {
+        //Walk the dedicated clock network back from the sink, falling back to a general search
+        //for the sinks it does not reach
+        std::tie(found_path, std::ignore, cheapest) = router.timing_driven_route_connection_through_clock_network(tree,
+                                                                                                                sink_node,
+                                                                                                                cost_params,
+                                                                                                                router_stats);
+    }
+
     //We normally route high fanout nets by only adding spatially close-by routing to the heap (reduces run-time).
     //However, if the current sink is 'critical' from a timing perspective, we put the entire route tree back onto
     //the heap to ensure it has more flexibility to find the best path.
-    if (high_fanout && !sink_critical && !net_is_global && !net_is_clock && -routing_predictor.get_slope() > router_opts.high_fanout_max_slope) {
+    if (!found_path && high_fanout && !sink_critical && !net_is_global && !net_is_clock && -routing_predictor.get_slope() > router_opts.high_fanout_max_slope) {
         std::tie(found_path, flags.retry_with_full_bb, cheapest) = router.timing_driven_route_connection_from_route_tree_high_fanout(tree.root(),
                                                                                                                                      sink_node,
                                                                                                                                      cost_params,
@@ -450,13 +481,43 @@ inline NetResultFlags route_sink(ConnectionRouter& router,
                                                                                                                                      spatial_rt_lookup,
                                                                                                                                      router_stats,
                                                                                                                                      conn_params);
-    } else {
-        std::tie(found_path, flags.retry_with_full_bb, cheapest) = router.timing_driven_route_connection_from_route_tree(tree.root(),
-                                                                                                                         sink_node,
-                                                                                                                         cost_params,
-                                                                                                                         net_bb,
-                                                                                                                         router_stats,
-                                                                                                                         conn_params);
+    } else if (!found_path) {
+        //Search the corridor of the connection's global route first, when it is tighter than the net bounding box
+        const t_bb* corridor = route_ctx.global_route_guides.connection_bb(net_id, target_pin);
+        if (corridor && !net_is_global && !net_is_clock) {
+            t_bb conn_bb;
+            conn_bb.xmin = std::max(net_bb.xmin, corridor->xmin);
+            conn_bb.xmax = std::min(net_bb.xmax, corridor->xmax);
+            conn_bb.ymin = std::max(net_bb.ymin, corridor->ymin);
+            conn_bb.ymax = std::min(net_bb.ymax, corridor->ymax);
+            conn_bb.layer_min = net_bb.layer_min;
+            conn_bb.layer_max = net_bb.layer_max;
+
+            bool is_tighter = conn_bb.xmin > net_bb.xmin || conn_bb.xmax < net_bb.xmax
+                              || conn_bb.ymin > net_bb.ymin || conn_bb.ymax < net_bb.ymax;
+            if (is_tighter && conn_bb.xmin <= conn_bb.xmax && conn_bb.ymin <= conn_bb.ymax) {
+                conn_params.in_global_route_corridor_ = true;
+                std::tie(found_path, std::ignore, cheapest) = router.timing_driven_route_connection_from_route_tree(tree.root(),
+                                                                                                                    sink_node,
+                                                                                                                    cost_params,
+                                                                                                                    conn_bb,
+                                                                                                                    router_stats,
+                                                                                                                    conn_params);
+                conn_params.in_global_route_corridor_ = false;
+                if (!found_path) {
+                    ++router_stats.global_route_corridor_misses;
+                }
+            }
+        }
+
+        if (!found_path) {
+            std::tie(found_path, flags.retry_with_full_bb, cheapest) = router.timing_driven_route_connection_from_route_tree(tree.root(),
+                                                                                                                             sink_node,
+                                                                                                                             cost_params,
+                                                                                                                             net_bb,
+                                                                                                                             router_stats,
+                                                                                                                             conn_params);
+        }
     }
 
     if (!found_path) {
@@ -478,7 +539,10 @@ inline NetResultFlags route_sink(ConnectionRouter& router,
     profiling::sink_criticality_end(cost_params.criticality);
 
     vtr::optional<const RouteTreeNode&> new_branch, new_sink;
-    std::tie(new_branch, new_sink) = tree.update_from_heap(&cheapest, target_pin, ((high_fanout) ? &spatial_rt_lookup : nullptr), is_flat);
+    {
+        router_phase_profiling::ScopedPhase phase(e_router_phase::ROUTE_TREE);
+        std::tie(new_branch, new_sink) = tree.update_from_heap(&cheapest, target_pin, ((high_fanout) ? &spatial_rt_lookup : nullptr), is_flat, router.get_rr_node_route_inf());
+    }
 
     VTR_ASSERT_DEBUG(!high_fanout || validate_route_tree_spatial_lookup(tree.root(), spatial_rt_lookup));
 
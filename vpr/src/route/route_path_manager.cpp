@@ -1,5 +1,10 @@
 #include "route_path_manager.h"
+
+#include <algorithm>
+
 #include "globals.h"
+#include "vtr_assert.h"
+#include "vtr_memory.h"
 
 PathManager::PathManager() {
     // Only init data structure if required by RCV
@@ -17,8 +22,8 @@ bool PathManager::node_exists_in_tree(t_heap_path* path_data,
     if (!path_data || !is_enabled_) return false;
 
     // First check the smaller current path, the ordering of these checks might effect runtime slightly
-    for (auto& node : path_data->path_rr) {
-        if (node == to_node) {
+    for (t_path_link_index link = path_data->last_link; link != NO_PATH_LINK; link = links_[link].prev) {
+        if (links_[link].node == to_node) {
             return true;
         }
     }
@@ -39,15 +44,17 @@ void PathManager::mark_node_visited(RRNodeId node) {
     }
 }
 
-void PathManager::insert_backwards_path_into_traceback(t_heap_path* path_data, float cost, float backward_path_cost, RoutingContext& route_ctx) {
+void PathManager::insert_backwards_path_into_traceback(t_heap_path* path_data, float cost, float backward_path_cost, vtr::vector<RRNodeId, t_rr_node_route_inf>& rr_node_route_inf) {
     if (!is_enabled_) return;
 
-    for (unsigned i = 1; i < path_data->edge.size() - 1; i++) {
-        RRNodeId node_2 = path_data->path_rr[i];
-        RREdgeId edge = path_data->edge[i - 1];
-        route_ctx.rr_node_route_inf[node_2].prev_edge = edge;
-        route_ctx.rr_node_route_inf[node_2].path_cost = cost;
-        route_ctx.rr_node_route_inf[node_2].backward_path_cost = backward_path_cost;
+    materialize_path(path_data);
+
+    for (size_t i = 1; i + 1 < path_links_.size(); i++) {
+        RRNodeId node_2 = path_links_[i].node;
+        RREdgeId edge = path_links_[i - 1].edge;
+        rr_node_route_inf[node_2].prev_edge = edge;
+        rr_node_route_inf[node_2].path_cost = cost;
+        rr_node_route_inf[node_2].backward_path_cost = backward_path_cost;
     }
 }
 
@@ -60,31 +67,48 @@ void PathManager::set_enabled(bool enable) {
 }
 
 void PathManager::alloc_path_struct(t_heap_path*& tptr) {
-    // TODO: Use arena allocation for this part
-
     // If RCV isn't enabled return a nullptr
     if (!is_enabled_) {
         return;
     }
 
-    // if (tptr == nullptr) {
     // Use a free node list to avoid unnecessary data allocation
     // If there are unused data structures in memory use these
     if (freed_nodes_.size() > 0) {
         tptr = freed_nodes_.back();
         freed_nodes_.pop_back();
     } else {
-        tptr = new t_heap_path;
+        // Carve the structure out of the last slab, starting a new one once it is full
+        // (the slabs are reserved up front, so their structures never move)
+        if (slabs_.empty() || slabs_.back().size() == SLAB_SIZE) {
+            slabs_.emplace_back();
+            slabs_.back().reserve(SLAB_SIZE);
+        }
+        tptr = &slabs_.back().emplace_back();
         alloc_list_.push_back(tptr);
     }
-    // }
 
-    tptr->path_rr.clear();
-    tptr->edge.clear();
+    tptr->last_link = NO_PATH_LINK;
     tptr->backward_cong = 0.;
     tptr->backward_delay = 0.;
 }
 
+void PathManager::extend_path(t_heap_path* dest, const t_heap_path* src, RRNodeId from_node, RREdgeId from_edge) {
+    t_path_link_index prev = src ? src->last_link : NO_PATH_LINK;
+
+    VTR_ASSERT(links_.size() < NO_PATH_LINK);
+    dest->last_link = t_path_link_index(links_.size());
+    links_.push_back({from_node, from_edge, prev});
+}
+
+void PathManager::materialize_path(const t_heap_path* path_data) {
+    path_links_.clear();
+    for (t_path_link_index link = path_data->last_link; link != NO_PATH_LINK; link = links_[link].prev) {
+        path_links_.push_back(links_[link]);
+    }
+    std::reverse(path_links_.begin(), path_links_.end());
+}
+
 void PathManager::free_path_struct(t_heap_path*& tptr) {
     // Put freed structs in a freed array to be used later
     if (tptr != nullptr) {
@@ -94,11 +118,12 @@ void PathManager::free_path_struct(t_heap_path*& tptr) {
 }
 
 void PathManager::free_all_memory() {
-    // Only delete freed nodes because doing a partial arena alloc scheme
-    // Actually delete in heap_type
-    for (t_heap_path* node : alloc_list_) {
-        delete node;
-    }
+    // The structures are owned by the slabs
+    vtr::release_memory(alloc_list_);
+    vtr::release_memory(freed_nodes_);
+    vtr::release_memory(slabs_);
+    vtr::release_memory(links_);
+    vtr::release_memory(path_links_);
 }
 
 void PathManager::empty_heap() {
@@ -108,13 +133,18 @@ void PathManager::empty_heap() {
 
     // Copy alloc_list_ into the freed nodes list
     std::copy(alloc_list_.begin(), alloc_list_.end(), freed_nodes_.begin());
+
+    // All the paths of the connection are freed at once (keeping the capacity for the next connection)
+    links_.clear();
 }
 
 void PathManager::update_route_tree_set(t_heap_path* cheapest_path_struct) {
     if (!is_enabled_) return;
 
     // Add all values in path struct to the route tree nodes set
-    route_tree_nodes_.insert(cheapest_path_struct->path_rr.begin(), cheapest_path_struct->path_rr.end());
+    for (t_path_link_index link = cheapest_path_struct->last_link; link != NO_PATH_LINK; link = links_[link].prev) {
+        route_tree_nodes_.insert(links_[link].node);
+    }
 }
 
 void PathManager::empty_route_tree_nodes() {
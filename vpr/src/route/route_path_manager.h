@@ -1,6 +1,9 @@
 #include "rr_graph_fwd.h"
 #include "vtr_assert.h"
+#include "vtr_vector.h"
 
+#include <cstdint>
+#include <limits>
 #include <set>
 #include <list>
 #include <vector>
@@ -8,27 +11,42 @@
 #ifndef _PATH_MANAGER_H
 #    define _PATH_MANAGER_H
 
+/* Index of a t_path_link in the link pool of a PathManager (NO_PATH_LINK: none) */
+typedef uint32_t t_path_link_index;
+constexpr t_path_link_index NO_PATH_LINK = std::numeric_limits<t_path_link_index>::max();
+
+/* A node of a partial path of RCV: the node, the edge leaving it on the path and the link
+ * of the previous node of the path (NO_PATH_LINK for the first node of the path)
+ *
+ * Partial paths share their common prefixes (a path extended by a node is a single new
+ * link pointing to the last link of the path), so extending a path costs O(1) instead of
+ * a copy of the whole path. */
+struct t_path_link {
+    RRNodeId node;
+    RREdgeId edge;
+    t_path_link_index prev;
+};
+
 /* Extra path data needed by RCV, seperated from t_heap struct for performance reasons
  * Can be accessed by a pointer, won't be initialized unless by RCV
  * Use PathManager class to handle this structure's allocation and deallocation
  *
- * path_rr: The entire partial path up until the route tree with the first node being the SOURCE,
- *          or a part of the route tree that already exists for this net 
- * 
- * edge: A list of edges from each node in the partial path to reach the next node
- * 
+ * last_link: The last node of the entire partial path up until the route tree (see t_path_link), whose
+ *            first node is the SOURCE, or a part of the route tree that already exists for this net.
+ *            The nodes of the path (and the edges from each node to reach the next node) are only
+ *            materialized by walking the links back, once the path reaches the sink.
+ *
  * backward_delay: The delay of the partial path plus the path from route tree to source
  * 
  * backward_cong: The congestion estimate of the partial path plus the path from route tree to source */
 struct t_heap_path {
-    std::vector<RRNodeId> path_rr;
-    std::vector<RREdgeId> edge;
+    t_path_link_index last_link = NO_PATH_LINK;
     float backward_delay = 0.;
     float backward_cong = 0.;
 };
 
-// Forward declaration of RoutingContext needed for traceback insertion
-struct RoutingContext;
+// Forward declaration of the search state needed for traceback insertion
+struct t_rr_node_route_inf;
 
 /* A class to manage the extra data required for RCV
  * It manages a set containing all the nodes that currently exist in the route tree
@@ -51,7 +69,11 @@ struct RoutingContext;
  * Having these in t_heap creates significant performance issues when RCV is disabled
  * A t_heap_path pointer is instead stored in t_heap, which is selectively allocated only when RCV is enabled
  * 
- * If the _is_enabled flag is true, alloc_path_struct allocates t_heap_path structures, otherwise will be a NOOP */
+ * If the _is_enabled flag is true, alloc_path_struct allocates t_heap_path structures, otherwise will be a NOOP
+ *
+ * The t_heap_path structures and the links of the partial paths are only needed while routing a connection,
+ * so they are allocated from pools (slabs of structures, and a vector of links) which empty_heap() frees
+ * all at once at the end of each connection. */
 class PathManager {
   public:
     PathManager();
@@ -73,8 +95,8 @@ class PathManager {
     // Enable/disable path manager class and therefore RCV
     void set_enabled(bool enable);
 
-    // Insert the partial path data into the main route context traceback
-    void insert_backwards_path_into_traceback(t_heap_path* path_data, float cost, float backward_path_cost, RoutingContext& route_ctx);
+    // Insert the partial path data into the traceback of the search state rr_node_route_inf
+    void insert_backwards_path_into_traceback(t_heap_path* path_data, float cost, float backward_path_cost, vtr::vector<RRNodeId, t_rr_node_route_inf>& rr_node_route_inf);
 
     // Dynamically create a t_heap_path structure to be used in the heap
     // Will return unless RCV is enabled
@@ -87,11 +109,14 @@ class PathManager {
     // Move the structure from src to dest while also invalidating the src pointer
     void move(t_heap_path*& dest, t_heap_path*& src);
 
+    // Set the path of dest to the path of src (none if src is nullptr) extended by from_node, left through from_edge
+    void extend_path(t_heap_path* dest, const t_heap_path* src, RRNodeId from_node, RREdgeId from_edge);
+
     // Cleanup and free all the allocated memory, called when PathManager is destroyed
     void free_all_memory();
 
-    // Put all currently allocated structures into the free_nodes list
-    // This currently does NOT invalidate them
+    // Put all currently allocated structures into the free_nodes list, and free all the path links
+    // This currently does NOT invalidate the structures (but their paths are no longer valid)
     // Ideally used before a t_heap empty_heap() call
     void empty_heap();
 
@@ -103,9 +128,16 @@ class PathManager {
     void update_route_tree_set(t_heap_path* cheapest_path_struct);
 
   private:
+    // Fill path_links_ with the links of the path of path_data, from its first node to its last
+    void materialize_path(const t_heap_path* path_data);
+
     // Is RCV enabled and thus route_tree_nodes in use
     bool is_enabled_;
 
+    // Slabs of structures, allocated SLAB_SIZE at a time (the structures never move)
+    static constexpr size_t SLAB_SIZE = 1024;
+    std::vector<std::vector<t_heap_path>> slabs_;
+
     // This is a list of all currently allocated heap path pointers
     std::vector<t_heap_path*> alloc_list_;
 
@@ -115,6 +147,12 @@ class PathManager {
     // Set containing the current route tree, for faster lookup
     // Required by RCV so the router doesn't expand already visited nodes
     std::set<RRNodeId> route_tree_nodes_;
+
+    // The links of the partial paths of the current connection
+    std::vector<t_path_link> links_;
+
+    // Scratch space for the materialized path of materialize_path()
+    std::vector<t_path_link> path_links_;
 };
 
 #endif
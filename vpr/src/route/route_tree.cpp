@@ -7,12 +7,15 @@
 #include "rr_graph_fwd.h"
 #include "vtr_math.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
 /* Construct a new RouteTreeNode.
- * Doesn't add the node to parent's child_nodes! (see add_child) */
-RouteTreeNode::RouteTreeNode(RRNodeId _inode, RRSwitchId _parent_switch, RouteTreeNode* parent)
+ * Doesn't add the node to a tree! (see RouteTree::add_node) */
+RouteTreeNode::RouteTreeNode(RRNodeId _inode, RRSwitchId _parent_switch)
     : inode(_inode)
-    , parent_switch(_parent_switch)
-    , _parent(parent) {
+    , parent_switch(_parent_switch) {
     auto& device_ctx = g_vpr_ctx.device();
     const auto& rr_graph = device_ctx.rr_graph;
 
@@ -22,9 +25,6 @@ RouteTreeNode::RouteTreeNode(RRNodeId _inode, RRSwitchId _parent_switch, RouteTr
     R_upstream = rr_graph.node_R(_inode);
     Tdel = 0.5 * R_upstream * C_downstream;
 
-    _next = nullptr;
-    _prev = nullptr;
-    _subtree_end = nullptr;
     _is_leaf = true;
 }
 
@@ -51,8 +51,8 @@ void RouteTreeNode::print_x(int depth) const {
             C_downstream,
             Tdel);
 
-    if (_parent) {
-        VTR_LOG("parent: %d \t parent_switch: %d", _parent->inode, parent_switch);
+    if (parent()) {
+        VTR_LOG("parent: %d \t parent_switch: %d", parent()->inode, parent_switch);
         bool parent_edge_configurable = rr_graph.rr_switch_inf(parent_switch).configurable();
         if (!parent_edge_configurable) {
             VTR_LOG("*");
@@ -60,7 +60,7 @@ void RouteTreeNode::print_x(int depth) const {
     }
 
     auto& route_ctx = g_vpr_ctx.routing();
-    if (route_ctx.rr_node_route_inf[inode].occ() > rr_graph.node_capacity(inode)) {
+    if (route_ctx.rr_node_cong_inf[inode].occ() > rr_graph.node_capacity(inode)) {
         VTR_LOG(" x");
     }
 
@@ -71,61 +71,105 @@ void RouteTreeNode::print_x(int depth) const {
     }
 }
 
+uint32_t RouteTreeNodePool::allocate(const RouteTreeNode& node) {
+    uint32_t index = _size;
+    int chunk = chunk_of(index);
+    VTR_ASSERT(chunk < MAX_CHUNKS);
+    if (!_chunks[chunk])
+        _chunks[chunk] = static_cast<RouteTreeNode*>(::operator new(chunk_size(chunk) * sizeof(RouteTreeNode)));
+
+    RouteTreeNode* x = new (&_chunks[chunk][index - chunk_begin(chunk)]) RouteTreeNode(node);
+    x->_pool = this;
+    x->_index = index;
+    _size++;
+    return index;
+}
+
+/* The nodes are trivially copyable: copy the chunks in use as is, then point the nodes to this pool */
+void RouteTreeNodePool::copy_from(const RouteTreeNodePool& rhs) {
+    clear();
+    for (int chunk = 0; chunk < MAX_CHUNKS && chunk_begin(chunk) < rhs._size; chunk++) {
+        uint32_t num_nodes = std::min(chunk_size(chunk), rhs._size - chunk_begin(chunk));
+        _chunks[chunk] = static_cast<RouteTreeNode*>(::operator new(chunk_size(chunk) * sizeof(RouteTreeNode)));
+        std::memcpy(static_cast<void*>(_chunks[chunk]), rhs._chunks[chunk], num_nodes * sizeof(RouteTreeNode));
+        for (uint32_t i = 0; i < num_nodes; i++)
+            _chunks[chunk][i]._pool = this;
+    }
+    _size = rhs._size;
+}
+
+void RouteTreeNodePool::clear() {
+    for (RouteTreeNode*& chunk : _chunks) {
+        ::operator delete(chunk);
+        chunk = nullptr;
+    }
+    _size = 0;
+}
+
+size_t RouteTreeNodePool::capacity_bytes() const {
+    size_t bytes = 0;
+    for (int chunk = 0; chunk < MAX_CHUNKS; chunk++) {
+        if (_chunks[chunk])
+            bytes += chunk_size(chunk) * sizeof(RouteTreeNode);
+    }
+    return bytes;
+}
+
+/* Versions handed out to the route trees. Trees are modified from multiple threads */
+static std::atomic<uint64_t> next_route_tree_version(0);
+
+void RouteTree::new_version(void) {
+    _version = next_route_tree_version.fetch_add(1, std::memory_order_relaxed);
+}
+
 /* Construct a top-level route tree. */
-RouteTree::RouteTree(RRNodeId _inode) {
-    _root = new RouteTreeNode(_inode, RRSwitchId::INVALID(), nullptr);
+RouteTree::RouteTree(RRNodeId _inode)
+    : _pool(std::make_unique<RouteTreeNodePool>()) {
+    new_version();
+    _root = _pool->get(_pool->allocate(RouteTreeNode(_inode, RRSwitchId::INVALID())));
     _net_id = ParentNetId::INVALID();
-    _rr_node_to_rt_node[_inode] = _root;
+    _rr_node_to_rt_node[_inode] = _root->_index;
 }
 
-RouteTree::RouteTree(ParentNetId _inet) {
+RouteTree::RouteTree(ParentNetId _inet)
+    : _pool(std::make_unique<RouteTreeNodePool>()) {
     auto& route_ctx = g_vpr_ctx.routing();
 
+    new_version();
     RRNodeId inode = RRNodeId(route_ctx.net_rr_terminals[_inet][0]);
-    _root = new RouteTreeNode(inode, RRSwitchId::INVALID(), nullptr);
+    _root = _pool->get(_pool->allocate(RouteTreeNode(inode, RRSwitchId::INVALID())));
     _net_id = _inet;
-    _rr_node_to_rt_node[inode] = _root;
+    _rr_node_to_rt_node[inode] = _root->_index;
 
     _num_sinks = route_ctx.net_rr_terminals[_inet].size() - 1;
-    _isink_to_rt_node.resize(_num_sinks);     /* 0-indexed */
-    _is_isink_reached.resize(_num_sinks + 1); /* 1-indexed */
-}
-
-/** Make a copy of rhs and return it.
- * Traverse it as a tree so we can keep parent & child ptrs valid. */
-RouteTreeNode* RouteTree::copy_tree(const RouteTreeNode* rhs) {
-    RouteTreeNode* root = new RouteTreeNode(rhs->inode, RRSwitchId::INVALID(), nullptr);
-    _rr_node_to_rt_node[root->inode] = root;
-    copy_tree_x(root, *rhs);
-    return root;
+    _isink_to_rt_node.resize(_num_sinks, RouteTreeNodePool::NO_NODE); /* 0-indexed */
+    _is_isink_reached.resize(_num_sinks + 1);                         /* 1-indexed */
 }
 
-/* Helper for copy_list: copy child nodes of rhs into lhs */
-void RouteTree::copy_tree_x(RouteTreeNode* lhs, const RouteTreeNode& rhs) {
-    for (auto& rchild : rhs.child_nodes()) {
-        RouteTreeNode* child = new RouteTreeNode(rchild);
-        child->_is_leaf = true;
-        add_node(lhs, child);
-        copy_tree_x(child, rchild);
-    }
-}
-
-/* Copy constructor */
-RouteTree::RouteTree(const RouteTree& rhs) {
-    _isink_to_rt_node.resize(rhs._isink_to_rt_node.size());
+/* Copy constructor:
+ * The links are indices in the pool, so copying the pool and the lookups as is gives a valid tree. */
+RouteTree::RouteTree(const RouteTree& rhs)
+    : _pool(std::make_unique<RouteTreeNodePool>()) {
+    _pool->copy_from(*rhs._pool);
+    _num_free_nodes = rhs._num_free_nodes;
+    _version = rhs._version;
+    _root = _pool->get(rhs._root->_index);
     _net_id = rhs._net_id;
-    _root = copy_tree(rhs._root);
+    _rr_node_to_rt_node = rhs._rr_node_to_rt_node;
+    _isink_to_rt_node = rhs._isink_to_rt_node;
     _is_isink_reached = rhs._is_isink_reached;
     _num_sinks = rhs._num_sinks;
 }
 
 /* Move constructor:
- * Take over rhs' linked list & set it to null so it doesn't get freed.
- * Refs should stay valid after this?
+ * Take over rhs' pool. The pool itself doesn't move, so refs stay valid after this.
  * I don't think there's a user crazy enough to move around route trees
  * from multiple threads, but better safe than sorry */
 RouteTree::RouteTree(RouteTree&& rhs) {
     std::unique_lock<std::mutex> rhs_write_lock(rhs._write_mutex);
+    _pool = std::move(rhs._pool);
+    _num_free_nodes = rhs._num_free_nodes;
+    _version = rhs._version;
     _root = rhs._root;
     _net_id = rhs._net_id;
     rhs._root = nullptr;
@@ -135,26 +179,29 @@ RouteTree::RouteTree(RouteTree&& rhs) {
     _num_sinks = rhs._num_sinks;
 }
 
-/* Copy assignment: free list, clear lookup, reload list. */
+/* Copy assignment: copy the pool and the lookups over mine. */
 RouteTree& RouteTree::operator=(const RouteTree& rhs) {
     if (this == &rhs)
         return *this;
     std::unique_lock<std::mutex> write_lock(_write_mutex);
-    free_list(_root);
-    _rr_node_to_rt_node.clear();
-    _isink_to_rt_node.clear();
-    _isink_to_rt_node.resize(rhs._isink_to_rt_node.size());
+    if (!_pool)
+        _pool = std::make_unique<RouteTreeNodePool>();
+    _pool->copy_from(*rhs._pool);
+    _num_free_nodes = rhs._num_free_nodes;
+    _version = rhs._version;
+    _root = _pool->get(rhs._root->_index);
     _net_id = rhs._net_id;
-    _root = copy_tree(rhs._root);
+    _rr_node_to_rt_node = rhs._rr_node_to_rt_node;
+    _isink_to_rt_node = rhs._isink_to_rt_node;
     _is_isink_reached = rhs._is_isink_reached;
     _num_sinks = rhs._num_sinks;
     return *this;
 }
 
 /* Move assignment:
- * Free my list, take over rhs' linked list & set it to null so it doesn't get freed.
+ * Free my pool, take over rhs' pool.
  * Also ~steal~ acquire ownership of node lookup from rhs.
- * Refs should stay valid after this?
+ * Refs should stay valid after this.
  * I don't think there's a user crazy enough to move around route trees
  * from multiple threads, but better safe than sorry */
 RouteTree& RouteTree::operator=(RouteTree&& rhs) {
@@ -164,7 +211,9 @@ RouteTree& RouteTree::operator=(RouteTree&& rhs) {
     std::unique_lock<std::mutex> write_lock(_write_mutex, std::defer_lock);
     std::unique_lock<std::mutex> rhs_write_lock(rhs._write_mutex, std::defer_lock);
     std::lock(write_lock, rhs_write_lock);
-    free_list(_root);
+    _pool = std::move(rhs._pool);
+    _num_free_nodes = rhs._num_free_nodes;
+    _version = rhs._version;
     _root = rhs._root;
     _net_id = rhs._net_id;
     rhs._root = nullptr;
@@ -180,6 +229,7 @@ RouteTree& RouteTree::operator=(RouteTree&& rhs) {
  * Note that update_from_heap already calls this. */
 void RouteTree::reload_timing(vtr::optional<RouteTreeNode&> from_node) {
     std::unique_lock<std::mutex> write_lock(_write_mutex);
+    new_version();
     reload_timing_unlocked(from_node);
 }
 
@@ -201,8 +251,8 @@ void RouteTree::reload_timing_unlocked(vtr::optional<RouteTreeNode&> from_node)
 
     float Tdel_start = 0;
 
-    if (unbuffered_subtree_rt_root._parent) {
-        RouteTreeNode& subtree_parent_rt_node = *unbuffered_subtree_rt_root._parent;
+    if (unbuffered_subtree_rt_root.parent()) {
+        RouteTreeNode& subtree_parent_rt_node = *_pool->get(unbuffered_subtree_rt_root._parent);
         Tdel_start = subtree_parent_rt_node.Tdel;
         RRSwitchId iswitch = unbuffered_subtree_rt_root.parent_switch;
         /* TODO Just a note (no action needed for this PR): In future, we need to consider APIs that returns
@@ -220,7 +270,7 @@ void RouteTree::load_new_subtree_R_upstream(RouteTreeNode& rt_node) {
     auto& device_ctx = g_vpr_ctx.device();
     const auto& rr_graph = device_ctx.rr_graph;
 
-    RouteTreeNode* parent_rt_node = rt_node._parent;
+    RouteTreeNode* parent_rt_node = _pool->get(rt_node._parent);
     RRNodeId inode = rt_node.inode;
 
     //Calculate upstream resistance
@@ -299,20 +349,20 @@ RouteTree::update_unbuffered_ancestors_C_downstream(RouteTreeNode& from_node) {
      * the internal capacitance of the parent switch in the while loop.*/
 
     RouteTreeNode* last_node = std::addressof(from_node);
-    RouteTreeNode* parent_rt_node = from_node._parent;
+    RouteTreeNode* parent_rt_node = _pool->get(from_node._parent);
 
     if (rr_graph.rr_switch_inf(iswitch).buffered() == true) {
         C_downstream_addition = rr_graph.rr_switch_inf(iswitch).Cinternal;
         last_node = parent_rt_node;
         last_node->C_downstream += C_downstream_addition;
-        parent_rt_node = last_node->_parent;
+        parent_rt_node = _pool->get(last_node->_parent);
         iswitch = last_node->parent_switch;
     }
 
     while (parent_rt_node && rr_graph.rr_switch_inf(iswitch).buffered() == false) {
         last_node = parent_rt_node;
         last_node->C_downstream += C_downstream_addition;
-        parent_rt_node = last_node->_parent;
+        parent_rt_node = _pool->get(last_node->_parent);
         iswitch = last_node->parent_switch;
     }
 
@@ -350,7 +400,7 @@ void RouteTree::load_route_tree_Tdel(RouteTreeNode& from_node, float Tarrival) {
 vtr::optional<const RouteTreeNode&> RouteTree::find_by_rr_id(RRNodeId rr_node) const {
     auto it = _rr_node_to_rt_node.find(rr_node);
     if (it != _rr_node_to_rt_node.end()) {
-        return *it->second;
+        return *_pool->get(it->second);
     }
     return vtr::nullopt;
 }
@@ -397,9 +447,9 @@ bool RouteTree::is_valid_x(const RouteTreeNode& rt_node) const {
     }
 
     if (rr_graph.node_type(inode) == SINK) { // sink, must not be congested and must not have fanouts
-        int occ = route_ctx.rr_node_route_inf[inode].occ();
+        int occ = route_ctx.rr_node_cong_inf[inode].occ();
         int capacity = rr_graph.node_capacity(inode);
-        if (rt_node._next != nullptr && rt_node._next->_parent == &rt_node) {
+        if (rt_node._next != RouteTreeNodePool::NO_NODE && _pool->get(rt_node._next)->_parent == rt_node._index) {
             VTR_LOG("SINK %d has fanouts?\n", inode);
             return false;
         }
@@ -416,7 +466,7 @@ bool RouteTree::is_valid_x(const RouteTreeNode& rt_node) const {
     // check downstream C
     float C_downstream_children = 0;
     for (auto& child : rt_node.child_nodes()) {
-        if (child._parent != std::addressof(rt_node)) {
+        if (child._parent != rt_node._index) {
             VTR_LOG("parent-child relationship not mutually acknowledged by parent %d->%d child %d<-%d\n",
                     inode, child.inode,
                     child.inode, rt_node.inode);
@@ -455,7 +505,7 @@ bool RouteTree::is_uncongested_x(const RouteTreeNode& rt_node) const {
     const auto& rr_graph = device_ctx.rr_graph;
 
     RRNodeId inode = rt_node.inode;
-    if (route_ctx.rr_node_route_inf[inode].occ() > rr_graph.node_capacity(RRNodeId(inode))) {
+    if (route_ctx.rr_node_cong_inf[inode].occ() > rr_graph.node_capacity(RRNodeId(inode))) {
         //This node is congested
         return false;
     }
@@ -476,6 +526,18 @@ void RouteTree::print(void) const {
     _root->print();
 }
 
+/** Get the memory held by this route tree: its nodes and look-ups. */
+vtr::t_memory_usage RouteTree::memory_usage(void) const {
+    vtr::t_memory_usage usage;
+    /* The whole pool: the nodes in the tree, the nodes freed since the last prune() and the unused capacity */
+    usage.bytes += _pool->capacity_bytes();
+    usage.slack_bytes += _pool->capacity_bytes() - (_pool->size() - _num_free_nodes) * sizeof(RouteTreeNode);
+    usage += vtr::hash_memory_usage(_rr_node_to_rt_node);
+    usage += vtr::vector_memory_usage(_isink_to_rt_node);
+    usage.bytes += _is_isink_reached.size() / 8;
+    return usage;
+}
+
 /** Add the most recently finished wire segment to the routing tree, and
  * update the Tdel, etc. numbers for the rest of the routing tree. hptr
  * is the heap pointer of the SINK that was reached, and target_net_pin_index
@@ -487,12 +549,18 @@ void RouteTree::print(void) const {
  * RouteTreeNode of the SINK it adds to the routing. */
 std::tuple<vtr::optional<const RouteTreeNode&>, vtr::optional<const RouteTreeNode&>>
 RouteTree::update_from_heap(t_heap* hptr, int target_net_pin_index, SpatialRouteTreeLookup* spatial_rt_lookup, bool is_flat) {
+    return update_from_heap(hptr, target_net_pin_index, spatial_rt_lookup, is_flat, g_vpr_ctx.routing().rr_node_route_inf);
+}
+
+std::tuple<vtr::optional<const RouteTreeNode&>, vtr::optional<const RouteTreeNode&>>
+RouteTree::update_from_heap(t_heap* hptr, int target_net_pin_index, SpatialRouteTreeLookup* spatial_rt_lookup, bool is_flat, const vtr::vector<RRNodeId, t_rr_node_route_inf>& rr_node_route_inf) {
     /* Lock the route tree for writing. At least on Linux this shouldn't have an impact on single-threaded code */
     std::unique_lock<std::mutex> write_lock(_write_mutex);
+    new_version();
 
     //Create a new subtree from the target in hptr to existing routing
     vtr::optional<RouteTreeNode&> start_of_new_subtree_rt_node, sink_rt_node;
-    std::tie(start_of_new_subtree_rt_node, sink_rt_node) = add_subtree_from_heap(hptr, target_net_pin_index, is_flat);
+    std::tie(start_of_new_subtree_rt_node, sink_rt_node) = add_subtree_from_heap(hptr, target_net_pin_index, is_flat, rr_node_route_inf);
 
     if (!start_of_new_subtree_rt_node)
         return {vtr::nullopt, *sink_rt_node};
@@ -515,10 +583,9 @@ RouteTree::update_from_heap(t_heap* hptr, int target_net_pin_index, SpatialRoute
  * to the SINK indicated by hptr. Returns the first (most upstream) new rt_node,
  * and the rt_node of the new SINK. Traverses up from SINK  */
 std::tuple<vtr::optional<RouteTreeNode&>, vtr::optional<RouteTreeNode&>>
-RouteTree::add_subtree_from_heap(t_heap* hptr, int target_net_pin_index, bool is_flat) {
+RouteTree::add_subtree_from_heap(t_heap* hptr, int target_net_pin_index, bool is_flat, const vtr::vector<RRNodeId, t_rr_node_route_inf>& rr_node_route_inf) {
     auto& device_ctx = g_vpr_ctx.device();
     const auto& rr_graph = device_ctx.rr_graph;
-    auto& route_ctx = g_vpr_ctx.routing();
 
     RRNodeId sink_inode = RRNodeId(hptr->index);
 
@@ -543,14 +610,14 @@ RouteTree::add_subtree_from_heap(t_heap* hptr, int target_net_pin_index, bool is
     while (!_rr_node_to_rt_node.count(new_inode)) {
         new_branch_inodes.push_back(new_inode);
         new_branch_iswitches.push_back(new_iswitch);
-        edge = route_ctx.rr_node_route_inf[new_inode].prev_edge;
+        edge = rr_node_route_inf[new_inode].prev_edge;
         new_inode = rr_graph.edge_src_node(edge);
         new_iswitch = RRSwitchId(rr_graph.rr_nodes().edge_switch(edge));
     }
     new_branch_iswitches.push_back(new_iswitch);
 
     /* Build the new tree branch starting from the existing node we found */
-    RouteTreeNode* last_node = _rr_node_to_rt_node[new_inode];
+    RouteTreeNode* last_node = _pool->get(_rr_node_to_rt_node[new_inode]);
     all_visited.insert(last_node->inode);
 
     /* In the code below I'm marking SINKs and IPINs as not to be re-expanded.
@@ -559,22 +626,20 @@ RouteTree::add_subtree_from_heap(t_heap* hptr, int target_net_pin_index, bool is
      * ---
      * Walk through new_branch_iswitches and corresponding new_branch_inodes. */
     for (int i = new_branch_inodes.size() - 1; i >= 0; i--) {
-        RouteTreeNode* new_node = new RouteTreeNode(new_branch_inodes[i], new_branch_iswitches[i], last_node);
+        RouteTreeNode new_node(new_branch_inodes[i], new_branch_iswitches[i]);
 
         e_rr_type node_type = rr_graph.node_type(new_branch_inodes[i]);
         // If is_flat is enabled, IPINs should be added, since they are used for intra-cluster routing
         if (node_type == IPIN && !is_flat) {
-            new_node->re_expand = false;
+            new_node.re_expand = false;
         } else if (node_type == SINK) {
-            new_node->re_expand = false;
-            new_node->net_pin_index = target_net_pin_index; // net pin index is invalid for non-SINK nodes
+            new_node.re_expand = false;
+            new_node.net_pin_index = target_net_pin_index; // net pin index is invalid for non-SINK nodes
         } else {
-            new_node->re_expand = true;
+            new_node.re_expand = true;
         }
 
-        add_node(last_node, new_node);
-
-        last_node = new_node;
+        last_node = add_node(last_node, new_node);
 
         main_branch_visited.insert(new_branch_inodes[i]);
         all_visited.insert(new_branch_inodes[i]);
@@ -584,13 +649,13 @@ RouteTree::add_subtree_from_heap(t_heap* hptr, int target_net_pin_index, bool is
     // non-configurably connected nodes
     // Sink is not included, so no need to pass in the node's ipin value.
     for (RRNodeId rr_node : main_branch_visited) {
-        add_non_configurable_nodes(_rr_node_to_rt_node.at(rr_node), false, all_visited, is_flat);
+        add_non_configurable_nodes(_pool->get(_rr_node_to_rt_node.at(rr_node)), false, all_visited, is_flat);
     }
 
     /* the first and last nodes we added.
      * vec[size-1] works, because new_branch_inodes is guaranteed to contain at least [sink, found_node] */
-    vtr::optional<RouteTreeNode&> downstream_rt_node = *_rr_node_to_rt_node.at(new_branch_inodes[new_branch_inodes.size() - 1]);
-    vtr::optional<RouteTreeNode&> sink_rt_node = *_rr_node_to_rt_node.at(new_branch_inodes[0]);
+    vtr::optional<RouteTreeNode&> downstream_rt_node = *_pool->get(_rr_node_to_rt_node.at(new_branch_inodes[new_branch_inodes.size() - 1]));
+    vtr::optional<RouteTreeNode&> sink_rt_node = *_pool->get(_rr_node_to_rt_node.at(new_branch_inodes[0]));
 
     return {downstream_rt_node, sink_rt_node};
 }
@@ -622,17 +687,15 @@ void RouteTree::add_non_configurable_nodes(RouteTreeNode* rt_node,
 
         RRSwitchId edge_switch(rr_graph.edge_switch(rr_node, iedge));
 
-        RouteTreeNode* new_node = new RouteTreeNode(to_rr_node, edge_switch, rt_node);
-        add_node(rt_node, new_node);
-
-        new_node->net_pin_index = OPEN;
+        RouteTreeNode new_node(to_rr_node, edge_switch);
+        new_node.net_pin_index = OPEN;
         if (rr_graph.node_type(to_rr_node) == IPIN && !is_flat) {
-            new_node->re_expand = false;
+            new_node.re_expand = false;
         } else {
-            new_node->re_expand = true;
+            new_node.re_expand = true;
         }
 
-        add_non_configurable_nodes(new_node, true, visited, is_flat);
+        add_non_configurable_nodes(add_node(rt_node, new_node), true, visited, is_flat);
     }
 }
 
@@ -649,21 +712,56 @@ RouteTree::prune(CBRR& connections_inf, std::vector<int>* non_config_node_set_us
     auto& route_ctx = g_vpr_ctx.routing();
 
     std::unique_lock<std::mutex> write_lock(_write_mutex);
+    new_version();
 
     VTR_ASSERT_MSG(rr_graph.node_type(root().inode) == SOURCE, "Root of route tree must be SOURCE");
 
     VTR_ASSERT_MSG(_net_id, "RouteTree must be constructed using a ParentNetId");
 
-    VTR_ASSERT_MSG(route_ctx.rr_node_route_inf[root().inode].occ() <= rr_graph.node_capacity(root().inode),
+    VTR_ASSERT_MSG(route_ctx.rr_node_cong_inf[root().inode].occ() <= rr_graph.node_capacity(root().inode),
                    "Route tree root/SOURCE should never be congested");
 
     auto pruned_node = prune_x(*_root, connections_inf, false, non_config_node_set_usage);
+    if (_num_free_nodes > 0)
+        compact();
+
     if (pruned_node)
         return *this;
     else
         return vtr::nullopt;
 }
 
+/** Move the nodes to a new pool, in the order of the depth-first list, leaving out the nodes removed from the tree.
+ * All links and lookups are remapped to the new indices: the SINKs removed from the tree are not in _isink_to_rt_node anymore. */
+void RouteTree::compact(void) {
+    std::vector<uint32_t> new_index(_pool->size(), RouteTreeNodePool::NO_NODE);
+    uint32_t num_nodes = 0;
+    for (RouteTreeNode* p = _root; p; p = _pool->get(p->_next))
+        new_index[p->_index] = num_nodes++;
+
+    auto remap = [&](uint32_t index) {
+        return index == RouteTreeNodePool::NO_NODE ? RouteTreeNodePool::NO_NODE : new_index[index];
+    };
+
+    auto pool = std::make_unique<RouteTreeNodePool>();
+    for (RouteTreeNode* p = _root; p; p = _pool->get(p->_next)) {
+        RouteTreeNode* x = pool->get(pool->allocate(*p));
+        x->_parent = remap(x->_parent);
+        x->_next = remap(x->_next);
+        x->_prev = remap(x->_prev);
+        x->_subtree_end = remap(x->_subtree_end); /* or _next_sibling, see RouteTreeNode */
+    }
+
+    for (auto& rr_and_rt_node : _rr_node_to_rt_node)
+        rr_and_rt_node.second = new_index[rr_and_rt_node.second];
+    for (uint32_t& isink_rt_node : _isink_to_rt_node)
+        isink_rt_node = remap(isink_rt_node);
+
+    _pool = std::move(pool);
+    _root = _pool->get(0);
+    _num_free_nodes = 0;
+}
+
 /** Helper for prune.
  * Recursively traverse the route tree rooted at node and remove any congested subtrees.
  * Returns nullopt if pruned */
@@ -672,7 +770,7 @@ RouteTree::prune_x(RouteTreeNode& rt_node, CBRR& connections_inf, bool force_pru
     auto& device_ctx = g_vpr_ctx.device();
     const auto& rr_graph = device_ctx.rr_graph;
     auto& route_ctx = g_vpr_ctx.routing();
-    bool congested = (route_ctx.rr_node_route_inf[rt_node.inode].occ() > rr_graph.node_capacity(rt_node.inode));
+    bool congested = (route_ctx.rr_node_cong_inf[rt_node.inode].occ() > rr_graph.node_capacity(rt_node.inode));
 
     int node_set = -1;
     auto itr = device_ctx.rr_node_to_non_config_node_set.find(rt_node.inode);
@@ -826,6 +924,7 @@ RouteTree::prune_x(RouteTreeNode& rt_node, CBRR& connections_inf, bool force_pru
  * TODO: is this function doing anything? Try running without it */
 void RouteTree::freeze(void) {
     std::unique_lock<std::mutex> write_lock(_write_mutex);
+    new_version();
     return freeze_x(*_root);
 }
 
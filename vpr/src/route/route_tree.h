@@ -78,11 +78,27 @@
  * or a search may be required to find a certain SINK.
  *
  * When the occupancy and timing data is up to date, a tree can be sanity checked using RouteTree::is_valid().
+ *
+ * Storage
+ * =======
+ *
+ * The nodes of a RouteTree are kept in a RouteTreeNodePool owned by the tree, and link to each other by their
+ * indices in it. Nodes never move while a tree grows, so references to them stay valid until the tree is pruned
+ * (prune() compacts the pool, see below) or destroyed. Destroying a tree frees its pool in a few deallocations,
+ * and copying one (e.g. to save the best routing) copies the pool and its look-ups as is: the nodes are copied
+ * with memcpy and none of the links need to be rebuilt.
+ *
+ * The nodes removed from a tree are only unlinked: prune() then compacts the remaining nodes into a new pool,
+ * in depth-first order, so that walking all_nodes() reads the pool sequentially.
  */
 
+#include <array>
+#include <cstdint>
 #include <functional>
 #include <iostream>
 #include <iterator>
+#include <limits>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
 
@@ -91,16 +107,75 @@
 #include "vtr_assert.h"
 #include "spatial_route_tree_lookup.h"
 #include "vtr_dynamic_bitset.h"
+#include "vtr_memory_usage.h"
 #include "vtr_optional.h"
 #include "vtr_range.h"
 #include "vtr_vec_id_set.h"
 
+class RouteTreeNode;
+
+/**
+ * @brief Storage of the nodes of a RouteTree
+ *
+ * The nodes are allocated in chunks of geometrically growing sizes (16, 32, 64... nodes), which are
+ * never reallocated: a node keeps its address as the pool grows (even while another thread reads
+ * the tree), looking a node up by index is O(1), and freeing the pool takes one deallocation per
+ * chunk. Nodes are never freed individually. */
+class RouteTreeNodePool {
+  public:
+    /** Index of no node (e.g. the parent of the root) */
+    static constexpr uint32_t NO_NODE = std::numeric_limits<uint32_t>::max();
+
+    RouteTreeNodePool() = default;
+    RouteTreeNodePool(const RouteTreeNodePool&) = delete;
+    RouteTreeNodePool& operator=(const RouteTreeNodePool&) = delete;
+    ~RouteTreeNodePool() { clear(); }
+
+    /** Get the node at index, or nullptr for NO_NODE. */
+    inline RouteTreeNode* get(uint32_t index) const;
+
+    /** Add a copy of node to the pool. Returns its index. */
+    uint32_t allocate(const RouteTreeNode& node);
+
+    /** Replace the nodes of this pool by a copy of the nodes of rhs, at the same indices. */
+    void copy_from(const RouteTreeNodePool& rhs);
+
+    /** Free all the nodes. */
+    void clear();
+
+    /** Number of nodes allocated, including any nodes unlinked from their tree. */
+    uint32_t size() const { return _size; }
+
+    /** Bytes held by the chunks allocated. */
+    size_t capacity_bytes() const;
+
+  private:
+    static constexpr int FIRST_CHUNK_BITS = 4;
+    static constexpr int MAX_CHUNKS = 28;
+
+    /** Chunk c holds the nodes [chunk_begin(c)..chunk_begin(c + 1) - 1] */
+    static constexpr uint32_t chunk_begin(int chunk) {
+        return ((uint32_t(1) << chunk) - 1) << FIRST_CHUNK_BITS;
+    }
+    static constexpr uint32_t chunk_size(int chunk) {
+        return uint32_t(1) << (chunk + FIRST_CHUNK_BITS);
+    }
+    static inline int chunk_of(uint32_t index) {
+        /* floor(log2(index / 16 + 1)) */
+        return 31 - __builtin_clz((index >> FIRST_CHUNK_BITS) + 1);
+    }
+
+    std::array<RouteTreeNode*, MAX_CHUNKS> _chunks = {};
+    uint32_t _size = 0;
+};
+
 /**
  * @brief A single route tree node
  *
  * Structure describing one node in a RouteTree. */
 class RouteTreeNode {
     friend class RouteTree;
+    friend class RouteTreeNodePool;
 
   public:
     RouteTreeNode() = delete;
@@ -110,8 +185,9 @@ class RouteTreeNode {
     RouteTreeNode& operator=(RouteTreeNode&&) = default;
 
     /** This struct makes little sense outside the context of a RouteTree.
-     * This constructor is only public for compatibility purposes. */
-    RouteTreeNode(RRNodeId inode, RRSwitchId parent_switch, RouteTreeNode* parent);
+     * This constructor is only public for compatibility purposes: a node
+     * is only part of a tree once copied into it by RouteTree::add_node(). */
+    RouteTreeNode(RRNodeId inode, RRSwitchId parent_switch);
 
     /** ID of the rr_node that corresponds to this node. */
     RRNodeId inode;
@@ -150,7 +226,7 @@ class RouteTreeNode {
     int net_pin_index;
 
     /** Iterator implementation for child_nodes(). Walks using
-     * _next_sibling ptrs. At the end of the child list, the ptr
+     * _next_sibling links. At the end of the child list, the link
      * points up to where the parent's subtree ends, so we know where
      * to stop */
     template<class ref>
@@ -169,7 +245,7 @@ class RouteTreeNode {
             return const_cast<ref>(*_p);
         }
         inline RTIterator& operator++() {
-            _p = _p->_next_sibling;
+            _p = _p->_node(_p->_next_sibling);
             return *this;
         }
         inline RTIterator operator++(int) {
@@ -206,7 +282,7 @@ class RouteTreeNode {
             return const_cast<ref>(*_p);
         }
         inline RTRecIterator& operator++() {
-            _p = _p->_next;
+            _p = _p->_node(_p->_next);
             return *this;
         }
         inline RTRecIterator operator++(int) {
@@ -251,18 +327,18 @@ class RouteTreeNode {
     using rec_iterable = Iterable<RTRecIterator<ref>>;
 
     /** Traverse child nodes. */
-    constexpr iterable<const RouteTreeNode&> child_nodes(void) const {
-        return iterable<const RouteTreeNode&>(_next, _subtree_end);
+    inline iterable<const RouteTreeNode&> child_nodes(void) const {
+        return iterable<const RouteTreeNode&>(_node(_next), _node(_subtree_end));
     }
 
     /** Get parent node if exists. (nullopt if not) */
-    constexpr vtr::optional<const RouteTreeNode&> parent(void) const {
-        return _parent ? vtr::optional<const RouteTreeNode&>(*_parent) : vtr::nullopt;
+    inline vtr::optional<const RouteTreeNode&> parent(void) const {
+        return _parent != RouteTreeNodePool::NO_NODE ? vtr::optional<const RouteTreeNode&>(*_node(_parent)) : vtr::nullopt;
     }
 
     /** Traverse the subtree under this node in depth-first order. Doesn't include this node. */
-    constexpr rec_iterable<const RouteTreeNode&> all_nodes(void) const {
-        return rec_iterable<const RouteTreeNode&>(_next, _subtree_end);
+    inline rec_iterable<const RouteTreeNode&> all_nodes(void) const {
+        return rec_iterable<const RouteTreeNode&>(_node(_next), _node(_subtree_end));
     }
 
     /** Print information about this subtree to stdout. */
@@ -286,49 +362,74 @@ class RouteTreeNode {
     void print_x(int depth) const;
 
     /** Traverse child nodes, mutable reference */
-    constexpr iterable<RouteTreeNode&> _child_nodes(void) const {
-        return iterable<RouteTreeNode&>(_next, _subtree_end);
+    inline iterable<RouteTreeNode&> _child_nodes(void) const {
+        return iterable<RouteTreeNode&>(_node(_next), _node(_subtree_end));
     }
 
     /** Traverse subtree, mutable reference */
-    constexpr rec_iterable<RouteTreeNode&> _all_nodes(void) const {
-        return rec_iterable<RouteTreeNode&>(_next, _subtree_end);
+    inline rec_iterable<RouteTreeNode&> _all_nodes(void) const {
+        return rec_iterable<RouteTreeNode&>(_node(_next), _node(_subtree_end));
     }
 
-    /** Ptr to parent */
-    RouteTreeNode* _parent = nullptr;
+    /** Get the node at index in this node's tree (nullptr for NO_NODE) */
+    inline RouteTreeNode* _node(uint32_t index) const {
+        return _pool->get(index);
+    }
+
+    /** Pool holding this node (and the rest of its tree) */
+    RouteTreeNodePool* _pool = nullptr;
+
+    /** Index of this node in _pool. The links below are indices in _pool too */
+    uint32_t _index = RouteTreeNodePool::NO_NODE;
+
+    /** Parent */
+    uint32_t _parent = RouteTreeNodePool::NO_NODE;
 
     /** In the RouteTree, nodes are stored as a linked list in depth-first order.
      * This points to the next element in that list. If proper ordering is kept,
      * this also points to the first child of this node (given that it's not a leaf) */
-    RouteTreeNode* _next = nullptr;
+    uint32_t _next = RouteTreeNodePool::NO_NODE;
 
     /** Having a doubly linked list helps maintain the ordering of nodes */
-    RouteTreeNode* _prev = nullptr;
+    uint32_t _prev = RouteTreeNodePool::NO_NODE;
 
-    /** Here is the awkward part: these two pointers can become a union. 
+    /** Here is the awkward part: these two links can become a union.
      * 1. If there is a next sibling, _subtree_end is equal to it: when we finish walking the subtree we arrive at the next sibling.
      * 2. If there is not, _subtree_end is equal to the parent's _subtree_end.
      * So there is never a case where _next_sibling and _subtree_end are both valid and pointing at different things.
-     * Then, the only question is where to stop when walking _next_sibling ptrs, since the final sibling won't point at nullptr.
+     * Then, the only question is where to stop when walking _next_sibling links, since the final sibling won't point at NO_NODE.
      * But it will point at parent's _subtree_end, so we can use that as the limiting case */
     union {
-        /* Ptr to "next sibling": used when traversing child nodes */
-        RouteTreeNode* _next_sibling = nullptr;
+        /* "Next sibling": used when traversing child nodes */
+        uint32_t _next_sibling = RouteTreeNodePool::NO_NODE;
         /* Where does the subtree under this node end in the flattened linked list? Needed when recursively iterating */
-        RouteTreeNode* _subtree_end;
+        uint32_t _subtree_end;
     };
 };
 
+/* Pools are copied with memcpy */
+static_assert(std::is_trivially_copyable<RouteTreeNode>::value, "RouteTreeNode must be trivially copyable");
+
+inline RouteTreeNode* RouteTreeNodePool::get(uint32_t index) const {
+    if (index == NO_NODE)
+        return nullptr;
+    int chunk = chunk_of(index);
+    return &_chunks[chunk][index - chunk_begin(chunk)];
+}
+
 /** fwd definition for compatibility class in old_traceback.h */
 class TracebackCompat;
 
+/** fwd definition for the router checkpoint reader in route_checkpoint.h */
+class RouteCheckpoint;
+
 /**
  * @brief Top level route tree used in timing analysis and keeping routing state.
  *
  * Contains the root node and a lookup from RRNodeIds to RouteTreeNode&s in the tree. */
 class RouteTree {
     friend class TracebackCompat;
+    friend class RouteCheckpoint;
 
   public:
     RouteTree() = delete;
@@ -346,7 +447,7 @@ class RouteTree {
 
     ~RouteTree() {
         std::unique_lock<std::mutex> write_lock(_write_mutex);
-        free_list(_root);
+        _pool.reset();
     }
 
     /** Add the most recently finished wire segment to the routing tree, and
@@ -359,6 +460,12 @@ class RouteTree {
     std::tuple<vtr::optional<const RouteTreeNode&>, vtr::optional<const RouteTreeNode&>>
     update_from_heap(t_heap* hptr, int target_net_pin_index, SpatialRouteTreeLookup* spatial_rt_lookup, bool is_flat);
 
+    /** Same as update_from_heap(), but traces the new branch back through the
+     * prev_edge values in rr_node_route_inf rather than in the global RoutingContext.
+     * Used by routers which keep their own path search state (e.g. concurrent delay profilers). */
+    std::tuple<vtr::optional<const RouteTreeNode&>, vtr::optional<const RouteTreeNode&>>
+    update_from_heap(t_heap* hptr, int target_net_pin_index, SpatialRouteTreeLookup* spatial_rt_lookup, bool is_flat, const vtr::vector<RRNodeId, t_rr_node_route_inf>& rr_node_route_inf);
+
     /** Reload timing values (R_upstream, C_downstream, Tdel).
      * Can take a RouteTreeNode& to do an incremental update.
      * Note that update_from_heap already does this, but prune() doesn't.
@@ -373,7 +480,7 @@ class RouteTree {
     /** Get the sink RouteTreeNode associated with the isink. 
      * Will probably segfault if the tree is not constructed with a ParentNetId. */
     inline vtr::optional<const RouteTreeNode&> find_by_isink(int isink) const {
-        RouteTreeNode* x = _isink_to_rt_node[isink - 1];
+        RouteTreeNode* x = _pool->get(_isink_to_rt_node[isink - 1]);
         return x ? vtr::optional<const RouteTreeNode&>(*x) : vtr::nullopt;
     }
 
@@ -396,9 +503,13 @@ class RouteTree {
     /** Print information about this route tree to stdout. */
     void print(void) const;
 
+    /** Get the memory held by this route tree: its nodes and look-ups. */
+    vtr::t_memory_usage memory_usage(void) const;
+
     /** Prune overused nodes from the tree.
      * Also prune unused non-configurable nodes if non_config_node_set_usage is provided (see get_non_config_node_set_usage)
      * Returns nullopt if the entire tree is pruned.
+     * The remaining nodes are compacted (see the file comment), so references to the nodes of the tree are invalidated.
      * Locking operation: only one thread can prune() a RouteTree at a time. */
     vtr::optional<RouteTree&> prune(CBRR& connections_inf, std::vector<int>* non_config_node_set_usage = nullptr);
 
@@ -416,6 +527,12 @@ class RouteTree {
     using iterator = RouteTreeNode::RTRecIterator<const RouteTreeNode&>;
     using iterable = RouteTreeNode::Iterable<RouteTreeNode::const_rec_iterator>;
 
+    /** Version of the contents of this tree.
+     * A copy of a tree has its version until either of them is modified: the modified tree then takes a
+     * version no other tree ever had. Comparing versions tells if a saved copy of a tree is still up to
+     * date, so that saving or restoring a routing only copies the trees which changed. */
+    uint64_t version(void) const { return _version; }
+
     /** Get an iterable for all nodes in this RouteTree. */
     constexpr iterable all_nodes(void) const { return iterable(_root, nullptr); }
 
@@ -491,7 +608,7 @@ class RouteTree {
 
   private:
     std::tuple<vtr::optional<RouteTreeNode&>, vtr::optional<RouteTreeNode&>>
-    add_subtree_from_heap(t_heap* hptr, int target_net_pin_index, bool is_flat);
+    add_subtree_from_heap(t_heap* hptr, int target_net_pin_index, bool is_flat, const vtr::vector<RRNodeId, t_rr_node_route_inf>& rr_node_route_inf);
 
     void add_non_configurable_nodes(RouteTreeNode* rt_node,
                                     bool reached_by_non_configurable_edge,
@@ -515,96 +632,107 @@ class RouteTree {
 
     void freeze_x(RouteTreeNode& rt_node);
 
-    /** Add node to parent, set up prev/next links, set up parent-child links and update lookup. */
-    inline void add_node(RouteTreeNode* parent, RouteTreeNode* node) {
-        node->_prev = parent;
+    /** Add a copy of node to parent, set up prev/next links, set up parent-child links and update lookup.
+     * Returns the node added to the tree. */
+    inline RouteTreeNode* add_node(RouteTreeNode* parent, const RouteTreeNode& node_value) {
+        new_version();
+
+        uint32_t index = _pool->allocate(node_value);
+        RouteTreeNode* node = _pool->get(index);
+        node->_is_leaf = true;
+
+        node->_prev = parent->_index;
         node->_next = parent->_next;
-        if (parent->_next)
-            parent->_next->_prev = node;
+        if (parent->_next != RouteTreeNodePool::NO_NODE)
+            _pool->get(parent->_next)->_prev = index;
 
-        node->_parent = parent;
-        /* If parent is a leaf, its _next ptr isn't a child node. Update _subtree_end
-         * Otherwise, update the sibling ptr, since a sibling exists, it's the end of our subtree.
-         * These two pointers are a union, see RouteTreeNode definition for details */
+        node->_parent = parent->_index;
+        /* If parent is a leaf, its _next link isn't a child node. Update _subtree_end
+         * Otherwise, update the sibling link, since a sibling exists, it's the end of our subtree.
+         * These two links are a union, see RouteTreeNode definition for details */
         if (parent->is_leaf()) {
             node->_subtree_end = parent->_subtree_end;
         } else {
             node->_next_sibling = parent->_next;
         }
-        parent->_next = node;
+        parent->_next = index;
 
         /** Add node to RR to RT lookup */
-        _rr_node_to_rt_node[node->inode] = node;
+        _rr_node_to_rt_node[node->inode] = index;
         /** If node is a SINK (net_pin_index > 0), also add it to sink RT lookup */
         if (node->net_pin_index > 0 && _net_id.is_valid())
-            _isink_to_rt_node[node->net_pin_index - 1] = node;
+            _isink_to_rt_node[node->net_pin_index - 1] = index;
 
         /* Now it's a branch */
         parent->_is_leaf = false;
-    }
 
-    /** Free all nodes after node */
-    inline void free_list(RouteTreeNode* node) {
-        RouteTreeNode* p = node;
-        while (p) {
-            RouteTreeNode* x = p;
-            p = p->_next;
-            free_node(x);
-        }
+        return node;
     }
 
-    /** Make a copy of rhs and return it. Updates _rr_node_to_rt_node */
-    RouteTreeNode* copy_tree(const RouteTreeNode* rhs);
-
-    /** Helper for copy_list: copy child nodes of rhs into lhs */
-    void copy_tree_x(RouteTreeNode* lhs, const RouteTreeNode& rhs);
-
-    /** Free a node. Only keeps the linked list valid (not the tree ptrs) */
+    /** Unlink a node from the depth-first list (not the tree links).
+     * Its storage is only reclaimed when the pool is compacted. */
     inline void free_node(RouteTreeNode* node) {
-        if (node->_prev)
-            node->_prev->_next = node->_next;
-        if (node->_next)
-            node->_next->_prev = node->_prev;
-        delete node;
+        if (node->_prev != RouteTreeNodePool::NO_NODE)
+            _pool->get(node->_prev)->_next = node->_next;
+        if (node->_next != RouteTreeNodePool::NO_NODE)
+            _pool->get(node->_next)->_prev = node->_prev;
+        ++_num_free_nodes;
     }
 
+    /** Move the nodes of the tree to a new pool, in depth-first order and without the nodes freed.
+     * Updates the look-ups. */
+    void compact(void);
+
     /** Iterate through parent's child nodes and remove if p returns true.
-     * Updates tree ptrs and _rr_node_to_rt_node. */
+     * Updates tree links and _rr_node_to_rt_node. */
     inline void remove_child_if(RouteTreeNode& parent, const std::function<bool(RouteTreeNode&)>& p) {
-        RouteTreeNode* curr = parent._next;
+        RouteTreeNode* curr = _pool->get(parent._next);
         RouteTreeNode* prev = nullptr;
-        RouteTreeNode* end = parent._subtree_end;
+        RouteTreeNode* end = _pool->get(parent._subtree_end);
         while (curr != end) {
             if (p(*curr)) {
                 _rr_node_to_rt_node.erase(curr->inode);
                 /* Here is a tricky part: when updating prev's _next_sibling, we need to also
-                 * update the _subtree_end/_next_sibling ptrs of prev's subtree. We know that
+                 * update the _subtree_end/_next_sibling links of prev's subtree. We know that
                  * _next_sibling points to _subtree_end in the last ("rightmost") node of every
                  * level. _subtree_end's _prev will take us to the rightmost leaf in the subtree,
-                 * and from there we can walk up via _parent ptrs and update along the way */
+                 * and from there we can walk up via _parent links and update along the way */
                 if (prev) {
-                    RouteTreeNode* q = prev->_subtree_end->_prev;
+                    RouteTreeNode* q = _pool->get(_pool->get(prev->_subtree_end)->_prev);
                     while (q != prev) {
                         q->_subtree_end = curr->_subtree_end;
-                        q = q->_parent;
+                        q = _pool->get(q->_parent);
                     }
                     prev->_next_sibling = curr->_next_sibling;
                 }
                 RouteTreeNode* x = curr;
-                curr = curr->_next_sibling;
+                curr = _pool->get(curr->_next_sibling);
                 free_node(x);
             } else {
                 prev = curr;
-                curr = curr->_next_sibling;
+                curr = _pool->get(curr->_next_sibling);
             }
         }
         /* did this node become a leaf? */
-        if (parent._next == nullptr || parent._next->_parent != &parent)
+        if (parent._next == RouteTreeNodePool::NO_NODE || _pool->get(parent._next)->_parent != parent._index)
             parent._is_leaf = true;
     }
 
+    /** Give this tree a version no other tree had (see version()) */
+    void new_version(void);
+
+    /** Version of the contents (see version()) */
+    uint64_t _version;
+
+    /** Storage of the nodes (see RouteTreeNodePool).
+     * Its address is stable, so moving a RouteTree keeps references to its nodes valid. */
+    std::unique_ptr<RouteTreeNodePool> _pool;
+
+    /** Nodes unlinked from the tree but still in _pool */
+    uint32_t _num_free_nodes = 0;
+
     /** Root node.
-     * This is also the internal node list via the ptrs in RouteTreeNode. */
+     * This is also the internal node list via the links in RouteTreeNode. */
     RouteTreeNode* _root;
 
     /** Net ID.
@@ -620,12 +748,12 @@ class RouteTree {
      * tree if we go to the same SINK more than once. rr_node_to_rt_node[inode] will
      * therefore store the last rt_node created of all the SINK nodes with the same
      * index "inode". */
-    std::unordered_map<RRNodeId, RouteTreeNode*> _rr_node_to_rt_node;
+    std::unordered_map<RRNodeId, uint32_t> _rr_node_to_rt_node;
 
     /** RRNodeId is not a unique lookup for sink RouteTreeNodes, but net_pin_index
      * is. Store a 0-indexed lookup here for users who need to look up a sink from
      * a net_pin_index, ipin, isink, etc. */
-    std::vector<RouteTreeNode*> _isink_to_rt_node;
+    std::vector<uint32_t> _isink_to_rt_node;
 
     /** Is Nth sink in this net reached?
      * Bitset of [1..num_sinks]. (1-indexed!)
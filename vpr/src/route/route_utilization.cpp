@@ -1,98 +1,189 @@
 #include "route_utilization.h"
+
+#include <algorithm>
+#include <limits>
+
 #include "globals.h"
 #include "draw_types.h"
 #include "draw_global.h"
 
-vtr::Matrix<float> calculate_routing_usage(t_rr_type rr_type, bool is_flat, bool is_print) {
-    VTR_ASSERT(rr_type == CHANX || rr_type == CHANY);
-
-    auto& device_ctx = g_vpr_ctx.device();
-    const auto& rr_graph = device_ctx.rr_graph;
-    auto& cluster_ctx = g_vpr_ctx.clustering();
-    auto& route_ctx = g_vpr_ctx.routing();
+RoutingCongestionMap::RoutingCongestionMap(const RRGraphView& rr_graph, const DeviceGrid& grid)
+    : num_layers_(grid.get_num_layers())
+    , width_(grid.width())
+    , height_(grid.height()) {
+    build_chan_map(rr_graph, CHANX, chan_maps_[0]);
+    build_chan_map(rr_graph, CHANY, chan_maps_[1]);
+}
 
-    vtr::Matrix<float> usage({{device_ctx.grid.width(), device_ctx.grid.height()}}, 0.);
+const RoutingCongestionMap::t_chan_map& RoutingCongestionMap::chan(t_rr_type rr_type) const {
+    VTR_ASSERT(rr_type == CHANX || rr_type == CHANY);
+    return chan_maps_[rr_type == CHANX ? 0 : 1];
+}
 
-    //Collect all the in-use RR nodes
-    std::set<RRNodeId> rr_nodes;
-    for (auto net : cluster_ctx.clb_nlist.nets()) {
-        auto parent_id = get_cluster_net_parent_id(g_vpr_ctx.atom().lookup, net, is_flat);
+void RoutingCongestionMap::build_chan_map(const RRGraphView& rr_graph, t_rr_type rr_type, t_chan_map& chan_map) {
+    size_t num_locations = num_layers_ * width_ * height_;
 
-        if (!route_ctx.route_trees[parent_id])
-            continue;
-        for (auto& rt_node : route_ctx.route_trees[parent_id].value().all_nodes()) {
-            if (rr_graph.node_type(rt_node.inode) == rr_type) {
-                rr_nodes.insert(rt_node.inode);
-            }
+    //Sort the nodes by the location of their low end (a counting sort, since the locations are dense)
+    std::vector<size_t> location_begin(num_locations + 1, 0);
+    for (RRNodeId rr_node : rr_graph.nodes()) {
+        if (rr_graph.node_type(rr_node) == rr_type) {
+            ++location_begin[location_index(rr_graph.node_layer(rr_node), rr_graph.node_xlow(rr_node), rr_graph.node_ylow(rr_node)) + 1];
         }
     }
+    for (size_t i = 0; i < num_locations; ++i) {
+        location_begin[i + 1] += location_begin[i];
+    }
 
-    //Record number of used resources in each x/y channel
-    for (RRNodeId rr_node : rr_nodes) {
-#ifndef NO_GRAPHICS
-        if (!is_print) {
-            t_draw_state* draw_state = get_draw_state_vars();
-            int layer_num = rr_graph.node_layer(rr_node);
-            if (!draw_state->draw_layer_display[layer_num].visible)
-                continue; // don't count usage if layer is not visible
+    chan_map.nodes.resize(location_begin[num_locations]);
+    for (RRNodeId rr_node : rr_graph.nodes()) {
+        if (rr_graph.node_type(rr_node) == rr_type) {
+            chan_map.nodes[location_begin[location_index(rr_graph.node_layer(rr_node), rr_graph.node_xlow(rr_node), rr_graph.node_ylow(rr_node))]++] = rr_node;
         }
-#else
-        // Cast to void to avoid warning.
-        (void)is_print;
-#endif
+    }
+
+    size_t num_nodes = chan_map.nodes.size();
+    VTR_ASSERT(num_nodes < std::numeric_limits<uint32_t>::max());
+    chan_map.node_layer.resize(num_nodes);
+    chan_map.capacity.resize(num_nodes);
+    chan_map.occ.assign(num_nodes, 0.);
+    for (size_t i = 0; i < num_nodes; ++i) {
+        chan_map.node_layer[i] = rr_graph.node_layer(chan_map.nodes[i]);
+        chan_map.capacity[i] = rr_graph.node_capacity(chan_map.nodes[i]);
+    }
 
+    //Build the CSR index of the nodes spanning each location
+    auto for_each_location = [&](RRNodeId rr_node, auto&& fn) {
+        int layer = rr_graph.node_layer(rr_node);
         if (rr_type == CHANX) {
-            VTR_ASSERT(rr_graph.node_type(rr_node) == CHANX);
             VTR_ASSERT(rr_graph.node_ylow(rr_node) == rr_graph.node_yhigh(rr_node));
-
             int y = rr_graph.node_ylow(rr_node);
             for (int x = rr_graph.node_xlow(rr_node); x <= rr_graph.node_xhigh(rr_node); ++x) {
-                usage[x][y] += route_ctx.rr_node_route_inf[rr_node].occ();
+                fn(location_index(layer, x, y));
             }
         } else {
-            VTR_ASSERT(rr_type == CHANY);
-            VTR_ASSERT(rr_graph.node_type(rr_node) == CHANY);
             VTR_ASSERT(rr_graph.node_xlow(rr_node) == rr_graph.node_xhigh(rr_node));
-
             int x = rr_graph.node_xlow(rr_node);
             for (int y = rr_graph.node_ylow(rr_node); y <= rr_graph.node_yhigh(rr_node); ++y) {
-                usage[x][y] += route_ctx.rr_node_route_inf[rr_node].occ();
+                fn(location_index(layer, x, y));
             }
         }
-    }
-    return usage;
-}
+    };
 
-vtr::Matrix<float> calculate_routing_avail(t_rr_type rr_type) {
-    //Calculate the number of available resources in each x/y channel
-    VTR_ASSERT(rr_type == CHANX || rr_type == CHANY);
+    chan_map.row_begin.assign(num_locations + 1, 0);
+    for (RRNodeId rr_node : chan_map.nodes) {
+        for_each_location(rr_node, [&](size_t location) { ++chan_map.row_begin[location + 1]; });
+    }
+    for (size_t i = 0; i < num_locations; ++i) {
+        chan_map.row_begin[i + 1] += chan_map.row_begin[i];
+    }
 
-    auto& device_ctx = g_vpr_ctx.device();
-    const auto& rr_graph = device_ctx.rr_graph;
+    std::vector<size_t> row_end(chan_map.row_begin.begin(), chan_map.row_begin.end() - 1);
+    chan_map.row_nodes.resize(chan_map.row_begin[num_locations]);
+    for (size_t i = 0; i < num_nodes; ++i) {
+        for_each_location(chan_map.nodes[i], [&](size_t location) { chan_map.row_nodes[row_end[location]++] = uint32_t(i); });
+    }
 
-    vtr::Matrix<float> avail({{device_ctx.grid.width(), device_ctx.grid.height()}}, 0.);
-    for (const RRNodeId& rr_node : rr_graph.nodes()) {
-        const short& rr_node_capacity = rr_graph.node_capacity(rr_node);
+    //The capacity of each location
+    chan_map.avail = vtr::Matrix<float>({{width_, height_}}, 0.);
+    chan_map.usage = vtr::Matrix<float>({{width_, height_}}, 0.);
+    chan_map.overuse = vtr::Matrix<float>({{width_, height_}}, 0.);
+    for (size_t layer = 0; layer < num_layers_; ++layer) {
+        for (size_t x = 0; x < width_; ++x) {
+            for (size_t y = 0; y < height_; ++y) {
+                size_t location = location_index(layer, x, y);
+                float avail = 0.;
+                for (size_t k = chan_map.row_begin[location]; k < chan_map.row_begin[location + 1]; ++k) {
+                    avail += chan_map.capacity[chan_map.row_nodes[k]];
+                }
+                chan_map.avail[x][y] += avail;
+            }
+        }
+    }
+}
 
-        if (rr_graph.node_type(rr_node) == CHANX && rr_type == CHANX) {
-            VTR_ASSERT(rr_graph.node_type(rr_node) == CHANX);
-            VTR_ASSERT(rr_graph.node_ylow(rr_node) == rr_graph.node_yhigh(rr_node));
+void RoutingCongestionMap::update(const vtr::vector<RRNodeId, t_rr_node_cong_inf>& rr_node_cong_inf,
+                                  const std::vector<bool>& visible_layers) {
+    for (t_chan_map& chan_map : chan_maps_) {
+        update_chan_map(rr_node_cong_inf, visible_layers, chan_map);
+    }
+}
 
-            int y = rr_graph.node_ylow(rr_node);
-            for (int x = rr_graph.node_xlow(rr_node); x <= rr_graph.node_xhigh(rr_node); ++x) {
-                avail[x][y] += rr_node_capacity;
+void RoutingCongestionMap::update_chan_map(const vtr::vector<RRNodeId, t_rr_node_cong_inf>& rr_node_cong_inf,
+                                           const std::vector<bool>& visible_layers,
+                                           t_chan_map& chan_map) {
+    //Gather the occupancy of the sorted nodes (the only random accesses of the update)
+    size_t num_nodes = chan_map.nodes.size();
+    for (size_t i = 0; i < num_nodes; ++i) {
+        chan_map.occ[i] = rr_node_cong_inf[chan_map.nodes[i]].occ();
+    }
+    if (!visible_layers.empty()) {
+        for (size_t i = 0; i < num_nodes; ++i) {
+            size_t layer = chan_map.node_layer[i];
+            if (layer < visible_layers.size() && !visible_layers[layer]) {
+                chan_map.occ[i] = 0.; //don't count usage if layer is not visible
             }
-        } else if (rr_graph.node_type(rr_node) == CHANY && rr_type == CHANY) {
-            VTR_ASSERT(rr_graph.node_type(rr_node) == CHANY);
-            VTR_ASSERT(rr_graph.node_xlow(rr_node) == rr_graph.node_xhigh(rr_node));
+        }
+    }
 
-            int x = rr_graph.node_xlow(rr_node);
-            for (int y = rr_graph.node_ylow(rr_node); y <= rr_graph.node_yhigh(rr_node); ++y) {
-                avail[x][y] += rr_node_capacity;
+    const float* occ = chan_map.occ.data();
+    const float* capacity = chan_map.capacity.data();
+    const uint32_t* row_nodes = chan_map.row_nodes.data();
+    for (size_t x = 0; x < width_; ++x) {
+        for (size_t y = 0; y < height_; ++y) {
+            float usage = 0.;
+            float overuse = 0.;
+            for (size_t layer = 0; layer < num_layers_; ++layer) {
+                size_t location = location_index(layer, x, y);
+                for (size_t k = chan_map.row_begin[location]; k < chan_map.row_begin[location + 1]; ++k) {
+                    float node_occ = occ[row_nodes[k]];
+                    usage += node_occ;
+                    overuse += std::max(node_occ - capacity[row_nodes[k]], 0.f);
+                }
             }
+            chan_map.usage[x][y] = usage;
+            chan_map.overuse[x][y] = overuse;
+        }
+    }
+}
+
+std::vector<bool> routing_util_visible_layers(bool is_print) {
+    std::vector<bool> visible_layers;
+#ifndef NO_GRAPHICS
+    if (!is_print) {
+        t_draw_state* draw_state = get_draw_state_vars();
+        for (const t_draw_layer_display& layer_display : draw_state->draw_layer_display) {
+            visible_layers.push_back(layer_display.visible);
         }
     }
-    return avail;
+#else
+    // Cast to void to avoid warning.
+    (void)is_print;
+#endif
+    return visible_layers;
+}
+
+vtr::Matrix<float> calculate_routing_usage(t_rr_type rr_type, bool is_flat, bool is_print) {
+    VTR_ASSERT(rr_type == CHANX || rr_type == CHANY);
+
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& route_ctx = g_vpr_ctx.routing();
+
+    //The occupancy of the rr_nodes is the usage of the route trees, of whichever netlist was routed
+    (void)is_flat;
+
+    RoutingCongestionMap congestion_map(device_ctx.rr_graph, device_ctx.grid);
+    congestion_map.update(route_ctx.rr_node_cong_inf, routing_util_visible_layers(is_print));
+    return congestion_map.usage(rr_type);
+}
+
+vtr::Matrix<float> calculate_routing_avail(t_rr_type rr_type) {
+    //Calculate the number of available resources in each x/y channel
+    VTR_ASSERT(rr_type == CHANX || rr_type == CHANY);
+
+    auto& device_ctx = g_vpr_ctx.device();
+
+    RoutingCongestionMap congestion_map(device_ctx.rr_graph, device_ctx.grid);
+    return congestion_map.avail(rr_type);
 }
 
 float routing_util(float used, float avail) {
@@ -1,15 +1,90 @@
 #ifndef VPR_ROUTE_UTIL_H
 #define VPR_ROUTE_UTIL_H
+#include <array>
+#include <cstdint>
+#include <vector>
+
 #include "vpr_types.h"
+#include "rr_graph_view.h"
+#include "device_grid.h"
 #include "draw_types.h"
 #include "draw_global.h"
 
+/**
+ * @brief Usage, capacity and overuse of the CHANX and CHANY rr_nodes at each (x,y) channel location (a congestion heatmap).
+ *
+ * The channel rr_nodes of each type are sorted by location when the map is built, and the rr_nodes spanning each
+ * (layer, x, y) location are stored as a CSR index into the sorted nodes. update() gathers the occupancy of the sorted
+ * nodes into a contiguous array, after which the usage (overuse) of each location is a reduction over its row of the
+ * index: a heatmap costs a linear pass over the channel rr_nodes instead of a walk of every route tree with random
+ * accesses to the rr_node coordinates. The capacity is computed once, when the map is built, since it does not change
+ * during routing.
+ *
+ * The map is only valid for the rr graph it was built for, and is intended to be updated every routing iteration
+ * (e.g. for congestion telemetry, or to feed the overuse of each region to a RoutingPredictor).
+ */
+class RoutingCongestionMap {
+  public:
+    RoutingCongestionMap(const RRGraphView& rr_graph, const DeviceGrid& grid);
+
+    /**
+     * @brief Recomputes the usage and overuse of every channel location from the current rr_node occupancies.
+     *
+     * @param rr_node_cong_inf: The occupancy of each rr_node
+     * @param visible_layers: If not empty, only the rr_nodes of the layers whose entry is true are counted
+     */
+    void update(const vtr::vector<RRNodeId, t_rr_node_cong_inf>& rr_node_cong_inf,
+                const std::vector<bool>& visible_layers = {});
+
+    ///@brief The occupancy of the rr_nodes of rr_type (CHANX or CHANY) at each (x,y) location, as of the last update()
+    const vtr::Matrix<float>& usage(t_rr_type rr_type) const { return chan(rr_type).usage; }
+
+    ///@brief The capacity of the rr_nodes of rr_type (CHANX or CHANY) at each (x,y) location
+    const vtr::Matrix<float>& avail(t_rr_type rr_type) const { return chan(rr_type).avail; }
+
+    ///@brief The occupancy in excess of capacity of the rr_nodes of rr_type at each (x,y) location, as of the last update()
+    const vtr::Matrix<float>& overuse(t_rr_type rr_type) const { return chan(rr_type).overuse; }
+
+  private:
+    struct t_chan_map {
+        std::vector<RRNodeId> nodes;     ///<The channel rr_nodes, sorted by (layer, xlow, ylow)
+        std::vector<int> node_layer;     ///<The layer of each sorted node
+        std::vector<float> capacity;     ///<The capacity of each sorted node
+        std::vector<float> occ;          ///<The occupancy of each sorted node, gathered by update()
+        std::vector<size_t> row_begin;   ///<The nodes spanning location i are row_nodes[row_begin[i]..row_begin[i+1]-1]
+        std::vector<uint32_t> row_nodes; ///<Indices into nodes
+        vtr::Matrix<float> usage;
+        vtr::Matrix<float> avail;
+        vtr::Matrix<float> overuse;
+    };
+
+    const t_chan_map& chan(t_rr_type rr_type) const;
+
+    void build_chan_map(const RRGraphView& rr_graph, t_rr_type rr_type, t_chan_map& chan_map);
+
+    void update_chan_map(const vtr::vector<RRNodeId, t_rr_node_cong_inf>& rr_node_cong_inf,
+                         const std::vector<bool>& visible_layers,
+                         t_chan_map& chan_map);
+
+    ///@brief Index of the (layer, x, y) channel location
+    size_t location_index(int layer, int x, int y) const { return (size_t(layer) * width_ + x) * height_ + y; }
+
+    size_t num_layers_;
+    size_t width_;
+    size_t height_;
+
+    std::array<t_chan_map, 2> chan_maps_; ///<[0]: CHANX, [1]: CHANY
+};
+
 vtr::Matrix<float> calculate_routing_avail(t_rr_type rr_type);
 
 /**
  * @brief: Calculates and returns the usage over the entire grid for the specified
  * type of rr_node to the usage array. The usage is recorded at each (x,y) location.
  *
+ * Builds a RoutingCongestionMap for a single query: callers needing both channel types, or both the usage and the
+ * capacity, should build one RoutingCongestionMap instead.
+ *
  * @param rr_type: Type of rr_node that we are calculating the usage of; can be CHANX or CHANY
  * @param is_flat: Is the flat router being used or not?
  * @param only_visible: If true, only record the usage of rr_nodes on layers that are visible according to the current
@@ -18,4 +93,11 @@ vtr::Matrix<float> calculate_routing_avail(t_rr_type rr_type);
 vtr::Matrix<float> calculate_routing_usage(t_rr_type rr_type, bool is_flat, bool is_print);
 float routing_util(float used, float avail);
 
+/**
+ * @brief The visibility of each layer in the current drawing settings, as RoutingCongestionMap::update() takes it.
+ *
+ * Empty (all the layers) when is_print is true, or when VPR is built without graphics.
+ */
+std::vector<bool> routing_util_visible_layers(bool is_print);
+
 #endif
@@ -247,6 +247,9 @@ void print_overused_nodes_status(const t_router_opts& router_opts, const Overuse
 
     //Overused nodes info logging upper limit
     VTR_LOG("Total number of overused nodes: %d\n", num_overused);
+    for (size_t layer = 0; layer < overuse_info.layer_overused_nodes.size(); layer++) {
+        VTR_LOG("  Overused nodes on die %zu: %zu\n", layer, overuse_info.layer_overused_nodes[layer]);
+    }
     if (num_overused > max_logged_overused_rr_nodes) {
         VTR_LOG("Total number of overused nodes is larger than the logging limit (%d).\n", max_logged_overused_rr_nodes);
         VTR_LOG("Displaying the first %d entries.\n", max_logged_overused_rr_nodes);
@@ -359,6 +362,29 @@ void print_route_status_header() {
     VTR_LOG("---- ------ ------- ---- ------- ------- ------- ----------------- --------------- -------- ---------- ---------- ---------- ---------- --------\n");
 }
 
+void print_route_thread_utilization(const std::vector<float>& thread_busy_time, float wall_time) {
+    if (thread_busy_time.empty() || wall_time <= 0.) {
+        return;
+    }
+
+    float total_busy_time = 0.;
+    float min_busy_time = std::numeric_limits<float>::max();
+    float max_busy_time = 0.;
+    for (float busy_time : thread_busy_time) {
+        total_busy_time += busy_time;
+        min_busy_time = std::min(min_busy_time, busy_time);
+        max_busy_time = std::max(max_busy_time, busy_time);
+    }
+    float avg_busy_time = total_busy_time / thread_busy_time.size();
+
+    VTR_LOG("     Thread utilization: %zu threads, min %5.1f%% avg %5.1f%% max %5.1f%%, speedup %.2fx\n",
+            thread_busy_time.size(),
+            100. * min_busy_time / wall_time,
+            100. * avg_busy_time / wall_time,
+            100. * max_busy_time / wall_time,
+            total_busy_time / wall_time);
+}
+
 void print_router_criticality_histogram(const Netlist<>& net_list,
                                         const SetupTimingInfo& timing_info,
                                         const ClusteredPinAtomPinsLookup& netlist_pin_lookup,
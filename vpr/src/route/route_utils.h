@@ -95,6 +95,10 @@ void print_route_status(int itry, double elapsed_sec, float pres_fac, int num_bb
 
 void print_route_status_header();
 
+/** Log how busy each router thread was during an iteration relative to \p wall_time, and the
+ * resulting speedup over routing the same nets serially. */
+void print_route_thread_utilization(const std::vector<float>& thread_busy_time, float wall_time);
+
 void print_router_criticality_histogram(const Netlist<>& net_list,
                                         const SetupTimingInfo& timing_info,
                                         const ClusteredPinAtomPinsLookup& netlist_pin_lookup,
@@ -0,0 +1,150 @@
+#include "route_warm_start.h"
+
+#include <unordered_map>
+
+#include "globals.h"
+#include "heap_type.h"
+#include "route_common.h"
+#include "route_tree.h"
+#include "vtr_assert.h"
+
+void RoutingWarmStart::save(const Netlist<>& net_list) {
+    const auto& rr_graph = g_vpr_ctx.device().rr_graph;
+    const auto& route_ctx = g_vpr_ctx.routing();
+
+    std::unordered_map<const RouteTreeNode*, int> node_index;
+
+    net_nodes_.clear();
+    net_nodes_.resize(net_list.nets().size());
+    for (auto net_id : net_list.nets()) {
+        const vtr::optional<RouteTree>& tree = route_ctx.route_trees[net_id];
+        if (!tree || net_list.net_is_ignored(net_id))
+            continue;
+
+        std::vector<t_node_record>& nodes = net_nodes_[net_id];
+        node_index.clear();
+        for (const RouteTreeNode& rt_node : tree->all_nodes()) {
+            RRNodeId inode = rt_node.inode;
+            auto parent = rt_node.parent();
+
+            t_node_record record;
+            record.type = rr_graph.node_type(inode);
+            record.layer = rr_graph.node_layer(inode);
+            record.xlow = rr_graph.node_xlow(inode);
+            record.ylow = rr_graph.node_ylow(inode);
+            record.xhigh = rr_graph.node_xhigh(inode);
+            record.yhigh = rr_graph.node_yhigh(inode);
+            record.ptc = rr_graph.node_ptc_num(inode);
+            record.side = NUM_2D_SIDES;
+            if (record.type == IPIN || record.type == OPIN) {
+                for (e_side side : TOTAL_2D_SIDES) {
+                    if (rr_graph.is_node_on_specific_side(inode, side)) {
+                        record.side = side;
+                        break;
+                    }
+                }
+            }
+            record.direction = (record.type == CHANX || record.type == CHANY) ? rr_graph.node_direction(inode) : Direction::NONE;
+            record.parent = parent ? node_index.at(&parent.value()) : -1;
+            record.net_pin_index = rt_node.net_pin_index;
+
+            node_index.emplace(&rt_node, nodes.size());
+            nodes.push_back(record);
+        }
+    }
+}
+
+size_t RoutingWarmStart::restore(const Netlist<>& net_list, bool is_flat) const {
+    const auto& rr_graph = g_vpr_ctx.device().rr_graph;
+    auto& route_ctx = g_vpr_ctx.mutable_routing();
+
+    VTR_ASSERT(net_nodes_.size() == net_list.nets().size());
+
+    /* Saved paths are replayed through RouteTree::update_from_heap(), which only
+     * follows the prev_edge of each node: keep those apart from the router's state */
+    vtr::vector<RRNodeId, t_rr_node_route_inf> rr_node_route_inf(rr_graph.num_nodes());
+
+    std::vector<RRNodeId> node_ids;
+    std::vector<RREdgeId> parent_edges;
+    size_t num_restored = 0;
+
+    for (auto net_id : net_list.nets()) {
+        const std::vector<t_node_record>& nodes = net_nodes_[net_id];
+        if (nodes.empty() || net_list.net_is_ignored(net_id))
+            continue;
+
+        VTR_ASSERT(!route_ctx.route_trees[net_id]);
+        const std::vector<RRNodeId>& terminals = route_ctx.net_rr_terminals[net_id];
+        const t_bb& bb = route_ctx.route_bb[net_id];
+
+        /* Map the saved nodes onto the current RR graph. A node is mapped only if its
+         * parent is, so every mapped SINK has a complete path back to the source */
+        node_ids.assign(nodes.size(), RRNodeId::INVALID());
+        parent_edges.assign(nodes.size(), RREdgeId::INVALID());
+        node_ids[0] = terminals[0];
+
+        for (size_t irecord = 1; irecord < nodes.size(); ++irecord) {
+            const t_node_record& record = nodes[irecord];
+            RRNodeId parent_inode = node_ids[record.parent];
+            if (!parent_inode.is_valid())
+                continue;
+
+            RRNodeId inode = (record.net_pin_index > 0) ? terminals[record.net_pin_index] : find_node(record);
+            if (!inode.is_valid() || !inside_bb(inode, bb))
+                continue;
+
+            for (RREdgeId edge : rr_graph.edge_range(parent_inode)) {
+                if (rr_graph.rr_nodes().edge_sink_node(edge) == inode) {
+                    node_ids[irecord] = inode;
+                    parent_edges[irecord] = edge;
+                    break;
+                }
+            }
+            if (node_ids[irecord].is_valid() && record.type != SINK) {
+                rr_node_route_inf[inode].prev_edge = parent_edges[irecord];
+            }
+        }
+
+        /* Add the connections whose whole path still exists */
+        RouteTree tree(net_id);
+        size_t num_net_restored = 0;
+        for (size_t irecord = 1; irecord < nodes.size(); ++irecord) {
+            if (nodes[irecord].net_pin_index <= 0 || !node_ids[irecord].is_valid())
+                continue;
+
+            t_heap hptr;
+            hptr.index = node_ids[irecord];
+            hptr.set_prev_edge(parent_edges[irecord]);
+            tree.update_from_heap(&hptr, nodes[irecord].net_pin_index, nullptr, is_flat, rr_node_route_inf);
+            ++num_net_restored;
+        }
+
+        if (num_net_restored > 0) {
+            pathfinder_update_cost_from_route_tree(tree.root(), 1);
+            route_ctx.route_trees[net_id] = std::move(tree);
+            num_restored += num_net_restored;
+        }
+    }
+
+    return num_restored;
+}
+
+RRNodeId RoutingWarmStart::find_node(const t_node_record& record) {
+    const auto& rr_graph = g_vpr_ctx.device().rr_graph;
+
+    RRNodeId inode = rr_graph.node_lookup().find_node(record.layer, record.xlow, record.ylow, record.type, record.ptc, record.side);
+    if (!inode.is_valid())
+        return RRNodeId::INVALID();
+
+    /* Wires are looked up by a single location: check the whole span (and direction) match,
+     * since the tracks of a channel are laid out differently at another channel width */
+    if (rr_graph.node_xlow(inode) != record.xlow || rr_graph.node_ylow(inode) != record.ylow
+        || rr_graph.node_xhigh(inode) != record.xhigh || rr_graph.node_yhigh(inode) != record.yhigh) {
+        return RRNodeId::INVALID();
+    }
+    if ((record.type == CHANX || record.type == CHANY) && rr_graph.node_direction(inode) != record.direction) {
+        return RRNodeId::INVALID();
+    }
+
+    return inode;
+}
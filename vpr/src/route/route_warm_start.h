@@ -0,0 +1,63 @@
+#pragma once
+
+/**
+ * @file
+ * @brief Carries a routing over to the RR graph of another channel width.
+ *
+ * The minimum channel width search routes the same placement at a series of
+ * channel widths, and the RR graph (and its node ids) is rebuilt for each one.
+ * A RoutingWarmStart saves the routing found at one width in terms of the RR
+ * graph coordinates of its nodes (type, location, track/pin number, side and
+ * direction) rather than their ids, so that the router can start the next width
+ * from it instead of from scratch.
+ *
+ * A connection (source to sink path) is restored only if each of its nodes is found
+ * in the new RR graph, with the same span, and consecutive nodes are still connected
+ * by an edge: e.g. connections using a track above the new channel width are dropped,
+ * and get routed again in the first routing iteration.
+ */
+
+#include <vector>
+
+#include "netlist.h"
+#include "physical_types.h"
+#include "rr_graph_fwd.h"
+#include "rr_node_types.h"
+#include "vtr_vector.h"
+
+class RoutingWarmStart {
+  public:
+    /** Save the routing in the routing context (route trees) of net_list, on the current RR graph */
+    void save(const Netlist<>& net_list);
+
+    /** Has a routing been saved? */
+    bool empty() const { return net_nodes_.empty(); }
+
+    /** Rebuild the saved routing on the current RR graph: sets the route trees of the routing
+     * context and adds their occupancy. The routing context must have been initialized
+     * (init_route_structs()) for the same netlist, with no routing yet.
+     * @return The number of connections restored */
+    size_t restore(const Netlist<>& net_list, bool is_flat) const;
+
+  private:
+    /** A route tree node, identified independently of RR node ids (nodes are listed in pre-order) */
+    struct t_node_record {
+        t_rr_type type;
+        short layer;
+        short xlow;
+        short ylow;
+        short xhigh;
+        short yhigh;
+        int ptc;
+        e_side side; ///<A side the node is on (IPIN/OPIN only)
+        Direction direction;
+        int parent;        ///<Index of the parent record, -1 for the root
+        int net_pin_index; ///<Net pin index of SINKs, OPEN otherwise
+    };
+
+    /** Find the node matching record in the current RR graph, RRNodeId::INVALID() if it doesn't exist */
+    static RRNodeId find_node(const t_node_record& record);
+
+    /** Saved route tree nodes of each net (empty if unrouted) */
+    vtr::vector<ParentNetId, std::vector<t_node_record>> net_nodes_;
+};
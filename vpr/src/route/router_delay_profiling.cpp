@@ -8,10 +8,25 @@
 #include "vtr_time.h"
 #include "draw.h"
 
+#ifdef VPR_USE_TBB
+#    include <tbb/parallel_for.h>
+#endif
+
 RouterDelayProfiler::RouterDelayProfiler(const Netlist<>& net_list,
                                          const RouterLookahead* lookahead,
                                          bool is_flat)
+    : RouterDelayProfiler(net_list, lookahead, is_flat, g_vpr_ctx.mutable_routing().rr_node_route_inf) {
+    update_base_costs_ = true;
+}
+
+RouterDelayProfiler::RouterDelayProfiler(const Netlist<>& net_list,
+                                         const RouterLookahead* lookahead,
+                                         bool is_flat,
+                                         vtr::vector<RRNodeId, t_rr_node_route_inf>& rr_node_route_inf)
     : net_list_(net_list)
+    , lookahead_(lookahead)
+    , rr_node_route_inf_(rr_node_route_inf)
+    , update_base_costs_(false)
     , router_(
           g_vpr_ctx.device().grid,
           *lookahead,
@@ -19,7 +34,7 @@ RouterDelayProfiler::RouterDelayProfiler(const Netlist<>& net_list,
           &g_vpr_ctx.device().rr_graph,
           g_vpr_ctx.device().rr_rc_data,
           g_vpr_ctx.device().rr_graph.rr_switch(),
-          g_vpr_ctx.mutable_routing().rr_node_route_inf,
+          rr_node_route_inf,
           is_flat)
     , is_flat_(is_flat) {
     const auto& grid = g_vpr_ctx.device().grid;
@@ -58,7 +73,6 @@ bool RouterDelayProfiler::calculate_delay(RRNodeId source_node,
      * case the rr_graph is disconnected and you can give up.                   */
     auto& device_ctx = g_vpr_ctx.device();
     const auto& rr_graph = device_ctx.rr_graph;
-    auto& route_ctx = g_vpr_ctx.mutable_routing();
 
     //vtr::ScopedStartFinishTimer t(vtr::string_fmt("Profiling Delay from %s at %d,%d (%s) to %s at %d,%d (%s)",
     //rr_graph.node_type_string(RRNodeId(source_node)),
@@ -74,7 +88,9 @@ bool RouterDelayProfiler::calculate_delay(RRNodeId source_node,
     enable_router_debug(router_opts, ParentNetId(), sink_node, 0, &router_);
 
     /* Update base costs according to fanout and criticality rules */
-    update_rr_base_costs(1);
+    if (update_base_costs_) {
+        update_rr_base_costs(1);
+    }
 
     //maximum bounding box for placement
     t_bb bounding_box;
@@ -105,13 +121,23 @@ bool RouterDelayProfiler::calculate_delay(RRNodeId source_node,
     if (size_t(sink_node) == 778060 && size_t(source_node) == 14) {
         router_.set_router_debug(true);
     }
-    std::tie(found_path, std::ignore, cheapest) = router_.timing_driven_route_connection_from_route_tree(
-        tree.root(),
-        sink_node,
-        cost_params,
-        bounding_box,
-        router_stats,
-        conn_params);
+    if (reverse_edges_) {
+        std::tie(found_path, std::ignore, cheapest) = router_.timing_driven_route_connection_bidirectional(
+            tree.root(),
+            sink_node,
+            cost_params,
+            bounding_box,
+            *reverse_edges_,
+            router_stats);
+    } else {
+        std::tie(found_path, std::ignore, cheapest) = router_.timing_driven_route_connection_from_route_tree(
+            tree.root(),
+            sink_node,
+            cost_params,
+            bounding_box,
+            router_stats,
+            conn_params);
+    }
 
     router_.set_router_debug(false);
 
@@ -119,12 +145,12 @@ bool RouterDelayProfiler::calculate_delay(RRNodeId source_node,
         VTR_ASSERT(cheapest.index == sink_node);
 
         vtr::optional<const RouteTreeNode&> rt_node_of_sink;
-        std::tie(std::ignore, rt_node_of_sink) = tree.update_from_heap(&cheapest, OPEN, nullptr, is_flat_);
+        std::tie(std::ignore, rt_node_of_sink) = tree.update_from_heap(&cheapest, OPEN, nullptr, is_flat_, rr_node_route_inf_);
 
         //find delay
         *net_delay = rt_node_of_sink->Tdel;
 
-        VTR_ASSERT_MSG(route_ctx.rr_node_route_inf[tree.root().inode].occ() <= rr_graph.node_capacity(tree.root().inode), "SOURCE should never be congested");
+        VTR_ASSERT_MSG(g_vpr_ctx.routing().rr_node_cong_inf[tree.root().inode].occ() <= rr_graph.node_capacity(tree.root().inode), "SOURCE should never be congested");
     }
 
     //VTR_LOG("Explored %zu of %zu (%.2f) RR nodes: path delay %g\n", router_stats.heap_pops, device_ctx.rr_nodes.size(), float(router_stats.heap_pops) / device_ctx.rr_nodes.size(), *net_delay);
@@ -171,7 +197,7 @@ vtr::vector<RRNodeId, float> calculate_all_path_delays_from_rr_node(RRNodeId src
     VTR_ASSERT(is_flat == false);
     t_det_routing_arch det_routing_arch;
     auto router_lookahead = make_router_lookahead(det_routing_arch, e_router_lookahead::NO_OP,
-                                                  /*write_lookahead=*/"", /*read_lookahead=*/"",
+                                                  /*write_lookahead=*/"", /*read_lookahead=*/"", /*cache_dir=*/"",
                                                   /*segment_inf=*/{},
                                                   is_flat);
 
@@ -193,25 +219,36 @@ vtr::vector<RRNodeId, float> calculate_all_path_delays_from_rr_node(RRNodeId src
                                                                                                                 conn_params);
 
     VTR_ASSERT(shortest_paths.size() == device_ctx.rr_graph.num_nodes());
-    for (int isink = 0; isink < (int)device_ctx.rr_graph.num_nodes(); ++isink) {
+
+    //Tracing back each path only reads the search results, so the paths are
+    //traced independently (and in parallel, when available)
+    auto trace_path_delay = [&](size_t isink) {
         RRNodeId sink_rr_node(isink);
         if (RRNodeId(sink_rr_node) == src_rr_node) {
             path_delays_to[sink_rr_node] = 0.;
         } else {
-            if (!shortest_paths[sink_rr_node].index.is_valid()) continue;
+            if (!shortest_paths[sink_rr_node].index.is_valid()) return;
 
             VTR_ASSERT(RRNodeId(shortest_paths[sink_rr_node].index) == sink_rr_node);
 
             //Build the routing tree to get the delay
-            tree = RouteTree(RRNodeId(src_rr_node));
+            RouteTree sink_tree(src_rr_node);
             vtr::optional<const RouteTreeNode&> rt_node_of_sink;
-            std::tie(std::ignore, rt_node_of_sink) = tree.update_from_heap(&shortest_paths[sink_rr_node], OPEN, nullptr, router_opts.flat_routing);
+            std::tie(std::ignore, rt_node_of_sink) = sink_tree.update_from_heap(&shortest_paths[sink_rr_node], OPEN, nullptr, router_opts.flat_routing);
 
             VTR_ASSERT(rt_node_of_sink->inode == RRNodeId(sink_rr_node));
 
             path_delays_to[sink_rr_node] = rt_node_of_sink->Tdel;
         }
+    };
+
+#ifdef VPR_USE_TBB
+    tbb::parallel_for(size_t(0), size_t(device_ctx.rr_graph.num_nodes()), trace_path_delay);
+#else
+    for (size_t isink = 0; isink < device_ctx.rr_graph.num_nodes(); ++isink) {
+        trace_path_delay(isink);
     }
+#endif
     router.reset_path_costs();
 
 #if 0
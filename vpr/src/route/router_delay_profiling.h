@@ -5,7 +5,9 @@
 #include "binary_heap.h"
 #include "four_ary_heap.h"
 #include "connection_router.h"
+#include "rr_reverse_edges.h"
 
+#include <memory>
 #include <vector>
 
 class RouterDelayProfiler {
@@ -14,6 +16,19 @@ class RouterDelayProfiler {
                         const RouterLookahead* lookahead,
                         bool is_flat);
 
+    /**
+     * @brief Creates a profiler which keeps its path search state in rr_node_route_inf
+     * instead of the global RoutingContext, so that several profilers can
+     * route concurrently.
+     *
+     * Such a profiler does not modify any global state: the RR base costs must
+     * already be set up for a fanout of one (see update_rr_base_costs()).
+     */
+    RouterDelayProfiler(const Netlist<>& net_list,
+                        const RouterLookahead* lookahead,
+                        bool is_flat,
+                        vtr::vector<RRNodeId, t_rr_node_route_inf>& rr_node_route_inf);
+
     /**
      * @brief Returns true as long as found some way to hook up this net, even if that
      * way resulted in overuse of resources (congestion).  If there is no way
@@ -42,12 +57,34 @@ class RouterDelayProfiler {
      */
     float get_min_delay(int physical_tile_type_idx, int from_layer, int to_layer, int dx, int dy) const;
 
+    /**
+     * @brief Makes calculate_delay() search bidirectionally, using the fan-in adjacency
+     * reverse_edges of the RR graph (see
+     * ConnectionRouter::timing_driven_route_connection_bidirectional()).
+     *
+     * The adjacency can be shared by several profilers.
+     */
+    void enable_bidirectional_search(std::shared_ptr<const RRReverseEdges> reverse_edges) {
+        reverse_edges_ = std::move(reverse_edges);
+    }
+
+    ///@brief Returns the RR graph fan-in used for bidirectional search, or nullptr if it is disabled
+    const std::shared_ptr<const RRReverseEdges>& reverse_edges() const { return reverse_edges_; }
+
+    const Netlist<>& net_list() const { return net_list_; }
+    const RouterLookahead* lookahead() const { return lookahead_; }
+    bool is_flat() const { return is_flat_; }
+
   private:
     const Netlist<>& net_list_;
+    const RouterLookahead* lookahead_;
+    vtr::vector<RRNodeId, t_rr_node_route_inf>& rr_node_route_inf_;
+    bool update_base_costs_; ///<Whether calculate_delay() sets up the (global) RR base costs itself
     RouterStats router_stats_;
     ConnectionRouter<FourAryHeap> router_;
     vtr::NdMatrix<float, 5> min_delays_; // [physical_type_idx][from_layer][to_layer][dx][dy]
     bool is_flat_;
+    std::shared_ptr<const RRReverseEdges> reverse_edges_;
 };
 
 vtr::vector<RRNodeId, float> calculate_all_path_delays_from_rr_node(RRNodeId src_rr_node,
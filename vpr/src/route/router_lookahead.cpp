@@ -4,6 +4,7 @@
 #include "router_lookahead_map.h"
 #include "router_lookahead_compressed_map.h"
 #include "router_lookahead_extended_map.h"
+#include "timing_model_cache.h"
 #include "vpr_error.h"
 #include "globals.h"
 
@@ -26,6 +27,8 @@ static std::unique_ptr<RouterLookahead> make_router_lookahead_object(const t_det
         return std::make_unique<ClassicLookahead>();
     } else if (router_lookahead_type == e_router_lookahead::MAP) {
         return std::make_unique<MapLookahead>(det_routing_arch, is_flat);
+    } else if (router_lookahead_type == e_router_lookahead::QUANTIZED_MAP) {
+        return std::make_unique<MapLookahead>(det_routing_arch, is_flat, /*quantize=*/true);
     } else if (router_lookahead_type == e_router_lookahead::COMPRESSED_MAP) {
         return std::make_unique<CompressedMapLookahead>(det_routing_arch, is_flat);
     } else if (router_lookahead_type == e_router_lookahead::EXTENDED_MAP) {
@@ -42,16 +45,70 @@ std::unique_ptr<RouterLookahead> make_router_lookahead(const t_det_routing_arch&
                                                        e_router_lookahead router_lookahead_type,
                                                        const std::string& write_lookahead,
                                                        const std::string& read_lookahead,
+                                                       const std::string& cache_dir,
                                                        const std::vector<t_segment_inf>& segment_inf,
                                                        bool is_flat) {
     std::unique_ptr<RouterLookahead> router_lookahead = make_router_lookahead_object(det_routing_arch,
                                                                                      router_lookahead_type,
                                                                                      is_flat);
 
-    if (read_lookahead.empty()) {
-        router_lookahead->compute(segment_inf);
-    } else {
+    if (!read_lookahead.empty()) {
         router_lookahead->read(read_lookahead);
+    } else if (!cache_dir.empty() && router_lookahead_is_cacheable(router_lookahead_type)) {
+        std::string key = router_lookahead_cache_key(router_lookahead_type, segment_inf, is_flat);
+        std::string entry = timing_model_cache_entry(cache_dir, "router_lookahead", key);
+        std::string shared_entry = timing_model_cache_mapped_entry(cache_dir, "router_lookahead", key);
+
+        //Prefer attaching to the tables mapped by the other VPR processes sharing the cache
+        //directory over loading a private copy of them
+        bool shared = false;
+        if (timing_model_cache_lookup(shared_entry)) {
+            try {
+                router_lookahead->read_shared(shared_entry);
+                shared = true;
+                VTR_LOG("Attached to shared router lookahead '%s'\n", shared_entry.c_str());
+            } catch (const VprError& e) {
+                VTR_LOG_WARN("Discarding unreadable shared router lookahead cache entry '%s': %s\n", shared_entry.c_str(), e.what());
+                timing_model_cache_remove(shared_entry);
+            }
+        }
+
+        bool loaded = shared;
+        if (!loaded && timing_model_cache_lookup(entry)) {
+            try {
+                router_lookahead->read(entry);
+                loaded = true;
+                VTR_LOG("Loaded router lookahead from cache '%s'\n", entry.c_str());
+            } catch (const VprError& e) {
+                VTR_LOG_WARN("Discarding unreadable router lookahead cache entry '%s': %s\n", entry.c_str(), e.what());
+                timing_model_cache_remove(entry);
+            }
+        }
+
+        if (!loaded) {
+            router_lookahead->compute(segment_inf);
+            timing_model_cache_store(entry, [&](const std::string& file) {
+                router_lookahead->write(file);
+            });
+        }
+
+        if (!shared) {
+            //Publish the tables for the next processes, and attach to them so that this process
+            //(which may be the first of many concurrent ones) only keeps the shared copy
+            timing_model_cache_store(shared_entry, [&](const std::string& file) {
+                router_lookahead->write_shared(file);
+            });
+            if (timing_model_cache_lookup(shared_entry)) {
+                try {
+                    router_lookahead->read_shared(shared_entry);
+                } catch (const VprError& e) {
+                    //The private copy is still loaded
+                    VTR_LOG_WARN("Unable to attach to shared router lookahead '%s': %s\n", shared_entry.c_str(), e.what());
+                }
+            }
+        }
+    } else {
+        router_lookahead->compute(segment_inf);
     }
 
     if (!write_lookahead.empty()) {
@@ -209,6 +266,7 @@ const RouterLookahead* get_cached_router_lookahead(const t_det_routing_arch& det
                                                    e_router_lookahead router_lookahead_type,
                                                    const std::string& write_lookahead,
                                                    const std::string& read_lookahead,
+                                                   const std::string& cache_dir,
                                                    const std::vector<t_segment_inf>& segment_inf,
                                                    bool is_flat) {
     auto& router_ctx = g_vpr_ctx.routing();
@@ -228,6 +286,7 @@ const RouterLookahead* get_cached_router_lookahead(const t_det_routing_arch& det
                                   router_lookahead_type,
                                   write_lookahead,
                                   read_lookahead,
+                                  cache_dir,
                                   segment_inf,
                                   is_flat));
     }
@@ -3,6 +3,7 @@
 #include <memory>
 #include "vpr_types.h"
 #include "vpr_error.h"
+#include "vtr_memory_usage.h"
 
 struct t_conn_cost_params; //Forward declaration
 
@@ -65,6 +66,27 @@ class RouterLookahead {
      */
     virtual void write_intra_cluster(const std::string& file) const = 0;
 
+    /**
+     * @brief Attach to the router lookahead tables of a file written by write_shared().
+     *
+     * Unlike read(), the tables are memory mapped read-only and queried in place, so all the VPR
+     * processes attached to the same file share a single physical copy of them (the page cache's).
+     * @attention May be unimplemented, in which case method should throw an exception.
+     * @param file Name of the file that stores the shared router lookahead.
+     */
+    virtual void read_shared(const std::string& /*file*/) {
+        VPR_THROW(VPR_ERROR_ROUTE, "Router lookahead does not support shared lookahead files");
+    }
+
+    /**
+     * @brief Write the router lookahead tables in the layout read_shared() maps.
+     * @attention May be unimplemented, in which case method should throw an exception.
+     * @param file Name of the file to write the shared router lookahead.
+     */
+    virtual void write_shared(const std::string& /*file*/) const {
+        VPR_THROW(VPR_ERROR_ROUTE, "Router lookahead does not support shared lookahead files");
+    }
+
     /**
      * @brief Retrieve the minimum delay to a point on the "to_layer," which is dx and dy away, across all the OPINs on the physical tile identified by "physical_tile_idx."
      * @param physical_tile_idx The index of the physical tile from which the cost is calculated
@@ -76,6 +98,15 @@ class RouterLookahead {
      */
     virtual float get_opin_distance_min_delay(int physical_tile_idx, int from_layer, int to_layer, int dx, int dy) const = 0;
 
+    /**
+     * @brief Returns the memory held by the router lookahead tables.
+     *
+     * Tables memory mapped from a shared file (see read_shared()) are not included, as they are not private to the process.
+     */
+    virtual vtr::t_memory_usage memory_usage() const {
+        return vtr::t_memory_usage();
+    }
+
     virtual ~RouterLookahead() {}
 };
 
@@ -86,6 +117,8 @@ class RouterLookahead {
  * @param router_lookahead_type
  * @param write_lookahead
  * @param read_lookahead
+ * @param cache_dir Directory of the on-disk timing model cache (disabled if empty).
+ *                  Only used if read_lookahead is empty.
  * @param segment_inf
  * @param is_flat
  * @return Return a unique pointer that points to the router lookahead object
@@ -94,6 +127,7 @@ std::unique_ptr<RouterLookahead> make_router_lookahead(const t_det_routing_arch&
                                                        e_router_lookahead router_lookahead_type,
                                                        const std::string& write_lookahead,
                                                        const std::string& read_lookahead,
+                                                       const std::string& cache_dir,
                                                        const std::vector<t_segment_inf>& segment_inf,
                                                        bool is_flat);
 
@@ -109,6 +143,7 @@ void invalidate_router_lookahead_cache();
  * @param router_lookahead_type
  * @param write_lookahead
  * @param read_lookahead
+ * @param cache_dir
  * @param segment_inf
  * @param is_flat
  * @return
@@ -117,6 +152,7 @@ const RouterLookahead* get_cached_router_lookahead(const t_det_routing_arch& det
                                                    e_router_lookahead router_lookahead_type,
                                                    const std::string& write_lookahead,
                                                    const std::string& read_lookahead,
+                                                   const std::string& cache_dir,
                                                    const std::vector<t_segment_inf>& segment_inf,
                                                    bool is_flat);
 
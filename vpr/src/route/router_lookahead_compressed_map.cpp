@@ -5,6 +5,7 @@
 #include <cmath>
 #include <vector>
 #include <queue>
+#include <set>
 #include <ctime>
 #include "router_lookahead_compressed_map.h"
 #include "connection_router_interface.h"
@@ -143,37 +144,31 @@ static void compute_router_wire_compressed_lookahead(const std::vector<t_segment
     for (const auto& sample_loc : sample_locations) {
         sorted_sample_loc[sample_loc.first] = std::set<int>(sample_loc.second.begin(), sample_loc.second.end());
     }
-    //Profile each wire segment type
-    for (int from_layer_num = 0; from_layer_num < grid.get_num_layers(); from_layer_num++) {
-        for (const auto& segment_inf : segment_inf_vec) {
-            std::map<t_rr_type, std::vector<RRNodeId>> sample_nodes;
-            std::vector<e_rr_type> chan_types;
-            if (segment_inf.parallel_axis == X_AXIS)
-                chan_types.push_back(CHANX);
-            else if (segment_inf.parallel_axis == Y_AXIS)
-                chan_types.push_back(CHANY);
-            else //Both for BOTH_AXIS segments and special segments such as clock_networks we want to search in both directions.
-                chan_types.insert(chan_types.end(), {CHANX, CHANY});
-
-            for (e_rr_type chan_type : chan_types) {
-                util::t_routing_cost_map routing_cost_map = util::get_routing_cost_map(longest_seg_length,
-                                                                                       from_layer_num,
-                                                                                       chan_type,
-                                                                                       segment_inf,
-                                                                                       sample_locations,
-                                                                                       false);
-                if (routing_cost_map.empty()) {
-                    continue;
-                }
-
-                /* boil down the cost list in routing_cost_map at each coordinate to a representative cost entry and store it in the lookahead
-                 * cost map */
-                set_compressed_lookahead_map_costs(from_layer_num, segment_inf.seg_index, chan_type, routing_cost_map);
-
-                /* fill in missing entries in the lookahead cost map by copying the closest cost entries (cost map was computed based on
-                 * a reference coordinate > (0,0) so some entries that represent a cross-chip distance have not been computed) */
-                fill_in_missing_compressed_lookahead_entries(sorted_sample_loc, segment_inf.seg_index, chan_type);
-            }
+    //Profile each wire segment type. Each profiling job writes its own
+    //[from_layer][chan][seg] slice of the cost map, so jobs can run concurrently.
+    std::vector<util::t_wire_profiling_job> jobs = util::get_wire_profiling_jobs(segment_inf_vec);
+    std::vector<bool> profiled = util::run_wire_profiling_jobs(jobs,
+                                                               longest_seg_length,
+                                                               sample_locations,
+                                                               false,
+                                                               [](const util::t_wire_profiling_job& job, util::t_routing_cost_map& routing_cost_map) {
+                                                                   /* boil down the cost list in routing_cost_map at each coordinate to a representative cost entry and store it in the lookahead
+                                                                    * cost map */
+                                                                   set_compressed_lookahead_map_costs(job.from_layer_num, job.segment_inf->seg_index, job.chan_type, routing_cost_map);
+                                                               });
+
+    /* fill in missing entries in the lookahead cost map by copying the closest cost entries (cost map was computed based on
+     * a reference coordinate > (0,0) so some entries that represent a cross-chip distance have not been computed).
+     *
+     * This reads entries across all layers of a segment/channel type, so it is done serially, in job order, once every
+     * layer has been profiled. This keeps the result independent of the number of workers. */
+    std::set<std::pair<int, e_rr_type>> filled;
+    for (size_t ijob = 0; ijob < jobs.size(); ijob++) {
+        if (!profiled[ijob]) continue;
+
+        int seg_index = jobs[ijob].segment_inf->seg_index;
+        if (filled.insert({seg_index, jobs[ijob].chan_type}).second) {
+            fill_in_missing_compressed_lookahead_entries(sorted_sample_loc, seg_index, jobs[ijob].chan_type);
         }
     }
 }
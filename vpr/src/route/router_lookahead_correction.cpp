@@ -0,0 +1,90 @@
+#include "router_lookahead_correction.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "vtr_assert.h"
+
+void LookaheadCorrectionSamples::add(int seg_index, int distance, float estimate, float actual) {
+    VTR_ASSERT_SAFE(seg_index >= 0);
+
+    //Samples the lookahead has no (finite, positive) estimate for cannot be corrected by a factor
+    if (!(estimate > 0.) || !std::isfinite(estimate) || !std::isfinite(actual)) {
+        return;
+    }
+
+    size_t index = seg_index * LookaheadCorrection::NUM_DISTANCE_BUCKETS + LookaheadCorrection::distance_bucket(distance);
+    if (index >= buckets_.size()) {
+        buckets_.resize((seg_index + 1) * LookaheadCorrection::NUM_DISTANCE_BUCKETS);
+    }
+
+    t_bucket& bucket = buckets_[index];
+    bucket.estimate_sum += estimate;
+    bucket.actual_sum += actual;
+    ++bucket.count;
+}
+
+void LookaheadCorrectionSamples::combine(const LookaheadCorrectionSamples& rhs) {
+    if (rhs.buckets_.size() > buckets_.size()) {
+        buckets_.resize(rhs.buckets_.size());
+    }
+
+    for (size_t i = 0; i < rhs.buckets_.size(); ++i) {
+        buckets_[i].estimate_sum += rhs.buckets_[i].estimate_sum;
+        buckets_[i].actual_sum += rhs.buckets_[i].actual_sum;
+        buckets_[i].count += rhs.buckets_[i].count;
+    }
+}
+
+size_t LookaheadCorrectionSamples::num_samples() const {
+    size_t num_samples = 0;
+    for (const t_bucket& bucket : buckets_) {
+        num_samples += bucket.count;
+    }
+    return num_samples;
+}
+
+int LookaheadCorrection::distance_bucket(int distance) {
+    int bucket = 0;
+    while (distance > 0 && bucket < NUM_DISTANCE_BUCKETS - 1) {
+        distance >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+void LookaheadCorrection::init(int num_segments) {
+    factors_.assign(num_segments * NUM_DISTANCE_BUCKETS, 1.);
+}
+
+void LookaheadCorrection::clear() {
+    factors_.clear();
+}
+
+void LookaheadCorrection::update(const LookaheadCorrectionSamples& samples) {
+    VTR_ASSERT(samples.buckets_.size() <= factors_.size());
+
+    for (size_t i = 0; i < samples.buckets_.size(); ++i) {
+        const LookaheadCorrectionSamples::t_bucket& bucket = samples.buckets_[i];
+        if (bucket.count < MIN_BUCKET_SAMPLES) {
+            continue;
+        }
+
+        //The ratio of the sums rather than the average of the ratios, so the few connections
+        //ending very close to a wire (whose ratios are the noisiest) weigh by their cost
+        float observed = std::clamp<float>(bucket.actual_sum / bucket.estimate_sum, MIN_FACTOR, MAX_FACTOR);
+        factors_[i] = (1. - UPDATE_WEIGHT) * factors_[i] + UPDATE_WEIGHT * observed;
+    }
+}
+
+float LookaheadCorrection::average_factor() const {
+    if (factors_.empty()) {
+        return 1.;
+    }
+
+    double sum = 0.;
+    for (float factor : factors_) {
+        sum += factor;
+    }
+    return sum / factors_.size();
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+/** @file Online correction of the router lookahead from the costs the router observes.
+ *
+ * The router lookahead is computed once, before routing, from the costs of an
+ * uncongested device. As PathFinder raises the present and historical congestion
+ * costs, the actual cost of completing a connection from a wire grows, the
+ * lookahead under-estimates it more and more, and the router expands many more
+ * nodes per connection in the late iterations.
+ *
+ * When enabled, the connection routers record, for each wire on the path of each
+ * connection they route, the pair (lookahead estimate, actual cost from the wire
+ * to the sink) in a LookaheadCorrectionSamples (see RouterStats). Between routing
+ * iterations, LookaheadCorrection::update() turns the samples of the iteration into
+ * a correction factor per segment type and distance bucket, by which the routers
+ * then scale the expected costs of the lookahead for wires.
+ */
+
+#include <cstddef>
+#include <vector>
+
+///@brief Sums of the (estimate, actual cost) samples of each [segment type][distance bucket]
+class LookaheadCorrectionSamples {
+  public:
+    ///@brief Adds a sample for a wire of segment type seg_index, distance (dx + dy) from the sink
+    void add(int seg_index, int distance, float estimate, float actual);
+
+    ///@brief Adds the samples of rhs to these
+    void combine(const LookaheadCorrectionSamples& rhs);
+
+    void clear() { buckets_.clear(); }
+
+    size_t num_samples() const;
+
+  private:
+    friend class LookaheadCorrection;
+
+    struct t_bucket {
+        double estimate_sum = 0.;
+        double actual_sum = 0.;
+        size_t count = 0;
+    };
+
+    //[seg_index * NUM_DISTANCE_BUCKETS + distance_bucket], grown as the samples come
+    std::vector<t_bucket> buckets_;
+};
+
+///@brief Correction factors of the expected costs of the router lookahead
+class LookaheadCorrection {
+  public:
+    ///@brief Distances are bucketed by powers of 2: 0, 1, 2-3, 4-7, ... up to the last bucket
+    static constexpr int NUM_DISTANCE_BUCKETS = 8;
+
+    ///@brief Buckets with fewer samples in an iteration keep their factor
+    static constexpr size_t MIN_BUCKET_SAMPLES = 32;
+
+    ///@brief Weight of the last iteration's samples in the factors (the rest being their previous value)
+    static constexpr float UPDATE_WEIGHT = 0.5;
+
+    /**
+     * @brief Bounds of the factors
+     *
+     * The factors only make the lookahead more pessimistic: on an uncongested device it is already
+     * close to exact, and lowering it would only make the router expand more. The upper bound keeps
+     * a few very congested connections from making the router greedy everywhere.
+     */
+    static constexpr float MIN_FACTOR = 1.;
+    static constexpr float MAX_FACTOR = 4.;
+
+    static int distance_bucket(int distance);
+
+    ///@brief Enables the correction for num_segments segment types, with all the factors at 1
+    void init(int num_segments);
+
+    ///@brief Disables the correction
+    void clear();
+
+    bool is_enabled() const { return !factors_.empty(); }
+
+    ///@brief Returns the correction factor of a wire of segment type seg_index, distance (dx + dy) from the sink
+    float factor(int seg_index, int distance) const {
+        return factors_[seg_index * NUM_DISTANCE_BUCKETS + distance_bucket(distance)];
+    }
+
+    ///@brief Moves the factors towards the ratio of the actual to the estimated costs of the samples
+    void update(const LookaheadCorrectionSamples& samples);
+
+    ///@brief Returns the average of the factors (1 until some samples were seen)
+    float average_factor() const;
+
+  private:
+    std::vector<float> factors_; //[seg_index * NUM_DISTANCE_BUCKETS + distance_bucket]
+};
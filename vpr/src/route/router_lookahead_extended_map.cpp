@@ -2,7 +2,6 @@
 
 #include <vector>
 #include <queue>
-#include <mutex>
 
 #include "connection_router_interface.h"
 #include "rr_node.h"
@@ -27,7 +26,7 @@
 #endif
 
 #if defined(VPR_USE_TBB)
-#    include <tbb/parallel_for_each.h>
+#    include <tbb/parallel_for.h>
 #endif
 
 /* we're profiling routing cost over many tracks for each wire type, so we'll
@@ -59,6 +58,45 @@ static constexpr bool BREAK_ON_MISS = false;
  */
 static constexpr int MIN_PATH_COUNT = 1000;
 
+/**
+ * @brief Threshold of the cost variation (see cost_variation()) between the initial sample regions of a segment type
+ * above which the sampling of the segment type is refined with more sample regions
+ */
+static constexpr float MAX_SAMPLE_COST_VARIATION = 0.05;
+
+///@brief The costs found from the sample points of a sample region
+struct t_sample_region_costs {
+    util::RoutingCosts delay_costs;
+    util::RoutingCosts base_costs;
+    int path_count = 0;
+};
+
+/**
+ * @brief Returns the mean relative difference between the costs found by two sample regions at the same
+ * (segment type, distance), infinite if they have no distance in common
+ */
+static float cost_variation(const util::RoutingCosts& a, const util::RoutingCosts& b) {
+    double sum_relative_difference = 0.;
+    size_t num_common = 0;
+    for (const auto& a_cost : a) {
+        auto b_cost = b.find(a_cost.first);
+        if (b_cost == b.end()) {
+            continue;
+        }
+
+        float max_cost = std::max(a_cost.second, b_cost->second);
+        if (max_cost > 0.f) {
+            sum_relative_difference += std::abs(a_cost.second - b_cost->second) / max_cost;
+        }
+        num_common++;
+    }
+
+    if (num_common == 0) {
+        return std::numeric_limits<float>::infinity();
+    }
+    return sum_relative_difference / num_common;
+}
+
 template<typename Entry>
 static std::pair<float, int> run_dijkstra(RRNodeId start_node,
                                           std::vector<bool>* node_expanded,
@@ -432,7 +470,7 @@ void ExtendedMapLookahead::compute(const std::vector<t_segment_inf>& segment_inf
     alloc_and_load_rr_node_route_structs();
 
     size_t num_segments = segment_inf.size();
-    std::vector<SampleRegion> sample_regions = find_sample_regions(num_segments);
+    SegmentNodeCounts segment_counts = count_segment_nodes(num_segments);
 
     /* free previous delay map and allocate new one */
     auto& device_ctx = g_vpr_ctx.device();
@@ -442,84 +480,85 @@ void ExtendedMapLookahead::compute(const std::vector<t_segment_inf>& segment_inf
     util::RoutingCosts all_delay_costs;
     util::RoutingCosts all_base_costs;
 
-    /* run Dijkstra's algorithm for each segment type & channel type combination */
-#if defined(VPR_USE_TBB) // Run in parallel
-    std::mutex all_costs_mutex;
-    tbb::parallel_for_each(sample_regions, [&](const SampleRegion& region) {
-#else // Run serially
-    for (const auto& region : sample_regions) {
-#endif
-        // holds the cost entries for a run
-        util::RoutingCosts delay_costs;
-        util::RoutingCosts base_costs;
-        int total_path_count = 0;
-        std::vector<bool> node_expanded(device_ctx.rr_graph.num_nodes());
-        std::vector<util::Search_Path> paths(device_ctx.rr_graph.num_nodes());
-
-        // Each point in a sample region contains a set of nodes. Each node becomes a starting node
-        // for the dijkstra expansions, and different paths are explored to reach different locations.
-        //
-        // If the nodes get exhausted or the minimum number of paths is reached (set by MIN_PATH_COUNT)
-        // the routine exits and the costs added to the collection of all the costs found so far.
-        for (auto& point : region.points) {
-            // statistics
-            vtr::Timer run_timer;
-            float max_delay_cost = 0.f;
-            float max_base_cost = 0.f;
-            int path_count = 0;
-            for (auto node : point.nodes) {
-                // For each starting node, two different expansions are performed, one to find minimum delay
-                // and the second to find minimum base costs.
-                //
-                // NOTE: Doing two separate dijkstra expansions, each finding a minimum value leads to have an optimistic lookahead,
-                //       given that delay and base costs may not be simultaneously achievemnts.
-                //       Experiments have shown that the having two separate expansions lead to better results for Series 7 devices, but
-                //       this might not be true for Stratix ones.
-                {
-                    auto result = run_dijkstra<util::PQ_Entry_Delay>(node, &node_expanded, &paths, &delay_costs);
-                    max_delay_cost = std::max(max_delay_cost, result.first);
-                    path_count += result.second;
+    /* runs Dijkstra's algorithm from the sample points of each region */
+    auto expand_sample_regions = [&](const std::vector<SampleRegion>& sample_regions) {
+        std::vector<t_sample_region_costs> region_costs(sample_regions.size());
+        auto expand_sample_region = [&](size_t iregion) {
+            const SampleRegion& region = sample_regions[iregion];
+
+            // holds the cost entries for a run
+            util::RoutingCosts& delay_costs = region_costs[iregion].delay_costs;
+            util::RoutingCosts& base_costs = region_costs[iregion].base_costs;
+            int total_path_count = 0;
+            std::vector<bool> node_expanded(device_ctx.rr_graph.num_nodes());
+            std::vector<util::Search_Path> paths(device_ctx.rr_graph.num_nodes());
+
+            // Each point in a sample region contains a set of nodes. Each node becomes a starting node
+            // for the dijkstra expansions, and different paths are explored to reach different locations.
+            //
+            // If the nodes get exhausted or the minimum number of paths is reached (set by MIN_PATH_COUNT)
+            // the routine exits and the costs added to the collection of all the costs found so far.
+            for (auto& point : region.points) {
+                // statistics
+                vtr::Timer run_timer;
+                float max_delay_cost = 0.f;
+                float max_base_cost = 0.f;
+                int path_count = 0;
+                for (auto node : point.nodes) {
+                    // For each starting node, two different expansions are performed, one to find minimum delay
+                    // and the second to find minimum base costs.
+                    //
+                    // NOTE: Doing two separate dijkstra expansions, each finding a minimum value leads to have an optimistic lookahead,
+                    //       given that delay and base costs may not be simultaneously achievemnts.
+                    //       Experiments have shown that the having two separate expansions lead to better results for Series 7 devices, but
+                    //       this might not be true for Stratix ones.
+                    {
+                        auto result = run_dijkstra<util::PQ_Entry_Delay>(node, &node_expanded, &paths, &delay_costs);
+                        max_delay_cost = std::max(max_delay_cost, result.first);
+                        path_count += result.second;
+                    }
+                    {
+                        auto result = run_dijkstra<util::PQ_Entry_Base_Cost>(node, &node_expanded, &paths, &base_costs);
+                        max_base_cost = std::max(max_base_cost, result.first);
+                        path_count += result.second;
+                    }
                 }
-                {
-                    auto result = run_dijkstra<util::PQ_Entry_Base_Cost>(node, &node_expanded, &paths, &base_costs);
-                    max_base_cost = std::max(max_base_cost, result.first);
-                    path_count += result.second;
+
+                if (path_count > 0) {
+                    VTR_LOG("Expanded %d paths of segment type %s(%d) starting at (%d, %d) from %d segments, max_cost %e %e (%g paths/sec)\n",
+                            path_count, segment_inf[region.segment_type].name.c_str(), region.segment_type,
+                            point.location.x(), point.location.y(),
+                            (int)point.nodes.size(),
+                            max_delay_cost, max_base_cost,
+                            path_count / run_timer.elapsed_sec());
                 }
-            }
 
-            if (path_count > 0) {
-                VTR_LOG("Expanded %d paths of segment type %s(%d) starting at (%d, %d) from %d segments, max_cost %e %e (%g paths/sec)\n",
-                        path_count, segment_inf[region.segment_type].name.c_str(), region.segment_type,
-                        point.location.x(), point.location.y(),
-                        (int)point.nodes.size(),
-                        max_delay_cost, max_base_cost,
-                        path_count / run_timer.elapsed_sec());
+                total_path_count += path_count;
+                if (total_path_count > MIN_PATH_COUNT) {
+                    break;
+                }
             }
 
-            total_path_count += path_count;
-            if (total_path_count > MIN_PATH_COUNT) {
-                break;
+            if (total_path_count == 0) {
+                VTR_LOG_WARN("No paths found for sample region %s(%d, %d) of level %d\n",
+                             segment_inf[region.segment_type].name.c_str(), region.grid_location.x(), region.grid_location.y(),
+                             region.level);
             }
+            region_costs[iregion].path_count = total_path_count;
+        };
+#if defined(VPR_USE_TBB) // Run in parallel
+        tbb::parallel_for(size_t(0), sample_regions.size(), expand_sample_region);
+#else // Run serially
+        for (size_t iregion = 0; iregion < sample_regions.size(); iregion++) {
+            expand_sample_region(iregion);
         }
-
-#if defined(VPR_USE_TBB)
-        // The mutex locks the common data structures that each worker uses to store the routing
-        // expansion data.
-        //
-        // This because delay_costs and base_costs are in the worker's scope, so they can be run parallely and
-        // no data is shared among workers.
-        // Instead, all_delay_costs and all_base_costs is a shared object between all the workers, hence the
-        // need of a mutex when modifying their entries.
-        all_costs_mutex.lock();
 #endif
+        return region_costs;
+    };
 
-        if (total_path_count == 0) {
-            VTR_LOG_WARN("No paths found for sample region %s(%d, %d)\n",
-                         segment_inf[region.segment_type].name.c_str(), region.grid_location.x(), region.grid_location.y());
-        }
-
-        // combine the cost map from this run with the final cost maps for each segment
-        for (const auto& cost : delay_costs) {
+    /* combines the cost map of a region with the final cost maps for each segment */
+    auto add_region_costs = [&](const t_sample_region_costs& costs) {
+        for (const auto& cost : costs.delay_costs) {
             const auto& val = cost.second;
             auto result = all_delay_costs.insert(std::make_pair(cost.first, val));
             if (!result.second) {
@@ -527,7 +566,7 @@ void ExtendedMapLookahead::compute(const std::vector<t_segment_inf>& segment_inf
                 result.first->second = std::min(result.first->second, val);
             }
         }
-        for (const auto& cost : base_costs) {
+        for (const auto& cost : costs.base_costs) {
             const auto& val = cost.second;
             auto result = all_base_costs.insert(std::make_pair(cost.first, val));
             if (!result.second) {
@@ -535,13 +574,60 @@ void ExtendedMapLookahead::compute(const std::vector<t_segment_inf>& segment_inf
                 result.first->second = std::min(result.first->second, val);
             }
         }
+    };
+
+    /* Adaptive sampling: the initial (diagonal) windows of each segment type are sampled first.
+     * The cost map only depends on the distance to the target, so on a regular device all the
+     * sample regions find the same costs, and the other locations are well represented by the
+     * initial samples. Only the segment types whose initial samples disagree are sampled further,
+     * around the boundaries between the windows. */
+    std::vector<SampleRegion> initial_regions = find_sample_regions(segment_counts, initial_sample_windows(num_segments));
+    std::vector<t_sample_region_costs> initial_costs = expand_sample_regions(initial_regions);
+
+    std::vector<SampleWindow> refined_windows;
+    for (size_t iseg = 0; iseg < num_segments; iseg++) {
+        std::vector<const t_sample_region_costs*> segment_costs;
+        for (size_t iregion = 0; iregion < initial_regions.size(); iregion++) {
+            if (initial_regions[iregion].segment_type == (int)iseg && initial_costs[iregion].path_count > 0) {
+                segment_costs.push_back(&initial_costs[iregion]);
+            }
+        }
+        if (segment_costs.empty() && segment_counts.bounding_boxes[iseg].empty()) {
+            continue;
+        }
+
+        //Without two initial samples to compare, the variation is unknown
+        float variation = std::numeric_limits<float>::infinity();
+        if (segment_costs.size() >= 2) {
+            variation = 0.f;
+            for (size_t i = 0; i < segment_costs.size(); i++) {
+                for (size_t j = i + 1; j < segment_costs.size(); j++) {
+                    variation = std::max({variation,
+                                          cost_variation(segment_costs[i]->delay_costs, segment_costs[j]->delay_costs),
+                                          cost_variation(segment_costs[i]->base_costs, segment_costs[j]->base_costs)});
+                }
+            }
+        }
 
-#if defined(VPR_USE_TBB)
-        all_costs_mutex.unlock();
-    });
-#else
+        if (variation > MAX_SAMPLE_COST_VARIATION) {
+            VTR_LOG("Refining the sampling of segment type %s(%d) (initial cost variation %g)\n",
+                    segment_inf[iseg].name.c_str(), (int)iseg, variation);
+            std::vector<SampleWindow> segment_windows = refined_sample_windows(iseg);
+            refined_windows.insert(refined_windows.end(), segment_windows.begin(), segment_windows.end());
+        }
+    }
+
+    for (const t_sample_region_costs& costs : initial_costs) {
+        add_region_costs(costs);
+    }
+    vtr::release_memory(initial_costs);
+
+    if (!refined_windows.empty()) {
+        std::vector<SampleRegion> refined_regions = find_sample_regions(segment_counts, refined_windows);
+        for (const t_sample_region_costs& costs : expand_sample_regions(refined_regions)) {
+            add_region_costs(costs);
+        }
     }
-#endif
 
     VTR_LOG("Combining results\n");
     /* boil down the cost list in routing_cost_map at each coordinate to a
@@ -22,6 +22,10 @@
  */
 
 #include <cmath>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <utility>
 #include <vector>
 #include "connection_router_interface.h"
 #include "vpr_types.h"
@@ -48,6 +52,17 @@
 #    include "serdes_utils.h"
 #endif /* VTR_ENABLE_CAPNPROTO */
 
+#ifdef VPR_USE_TBB
+#    include <tbb/parallel_for.h>
+#endif
+
+#ifndef _WIN32
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
 static constexpr int VALID_NEIGHBOR_NUMBER = 3;
 
 /* when a list of delay/congestion entries at a coordinate in Cost_Entry is boiled down to a single
@@ -61,11 +76,101 @@ enum e_representative_entry_method {
     MEDIAN
 };
 
+/**
+ * @brief The header of a shared wire lookahead file (MapLookahead::write_shared())
+ *
+ * The costs start at costs_offset, in t_wire_cost_map order: t_shared_cost entries, or
+ * QuantizedWireCostMap::t_quantized_cost entries if the map is quantized, in which case the
+ * encodings of its slices (QuantizedWireCostMap::t_quantization, in [from_layer][chan][seg] order)
+ * start at quantizations_offset. The file is queried in place, so everything is in native layout.
+ */
+struct t_shared_wire_cost_map_header {
+    char magic[8];
+    uint32_t version;
+    uint32_t quantized;
+    uint64_t dims[6];
+    uint64_t costs_offset;
+    uint64_t quantizations_offset;
+};
+
+static constexpr char SHARED_WIRE_COST_MAP_MAGIC[8] = {'V', 'P', 'R', 'W', 'L', 'M', 'A', 'P'};
+static constexpr uint32_t SHARED_WIRE_COST_MAP_VERSION = 1;
+
+///@brief Alignment of the tables of a shared wire lookahead file (a page, so that no page holds the header and costs)
+static constexpr size_t SHARED_WIRE_COST_MAP_ALIGNMENT = 4096;
+
+///@brief A full precision cost of a shared wire lookahead file (util::Cost_Entry without its fill flag)
+struct t_shared_cost {
+    float delay;
+    float congestion;
+};
+
+/**
+ * @brief A wire lookahead queried in place in a shared wire lookahead file, memory mapped read-only
+ *
+ * The processes mapping the same file share its pages, so the wire lookahead (by far the largest
+ * table of the map lookahead) costs its memory footprint once per host rather than once per process.
+ */
+class SharedWireCostMap {
+  public:
+    SharedWireCostMap() = default;
+    SharedWireCostMap(const SharedWireCostMap&) = delete;
+    SharedWireCostMap& operator=(const SharedWireCostMap&) = delete;
+    ~SharedWireCostMap() { clear(); }
+
+    ///@brief Maps file, or throws a VprError (leaving this map empty) if it is not a valid shared wire lookahead file
+    void map(const std::string& file);
+
+    ///@brief Unmaps the file (if any)
+    void clear();
+
+    void swap(SharedWireCostMap& other);
+
+    bool empty() const { return mapping_ == nullptr; }
+    size_t dim_size(size_t i) const { return dims_[i]; }
+
+    ///@brief The mapped file
+    const char* data() const { return static_cast<const char*>(mapping_); }
+    size_t size() const { return mapping_size_; }
+
+    ///@brief Returns the (decoded) cost at the given indices (the same as t_wire_cost_map's)
+    util::Cost_Entry get(int from_layer, int chan, int seg, int to_layer, int dx, int dy) const {
+        size_t slice = (from_layer * dims_[1] + chan) * dims_[2] + seg;
+        size_t i = ((slice * dims_[3] + to_layer) * dims_[4] + dx) * dims_[5] + dy;
+        if (quantizations_) {
+            const QuantizedWireCostMap::t_quantized_cost& cost = quantized_costs_[i];
+            const QuantizedWireCostMap::t_quantization& quantization = quantizations_[slice];
+            return util::Cost_Entry(QuantizedWireCostMap::decode(cost.delay, quantization.delay_offset, quantization.delay_scale),
+                                    QuantizedWireCostMap::decode(cost.congestion, quantization.congestion_offset, quantization.congestion_scale));
+        }
+        return util::Cost_Entry(costs_[i].delay, costs_[i].congestion);
+    }
+
+    ///@brief Copies all the (decoded) costs of this map into cost_map
+    void copy_to(t_wire_cost_map& cost_map) const;
+
+  private:
+    void* mapping_ = nullptr;
+    size_t mapping_size_ = 0;
+    size_t dims_[6] = {0, 0, 0, 0, 0, 0};
+
+    //Into the mapping: costs_ if full precision, or quantized_costs_ and quantizations_ if quantized
+    const t_shared_cost* costs_ = nullptr;
+    const QuantizedWireCostMap::t_quantized_cost* quantized_costs_ = nullptr;
+    const QuantizedWireCostMap::t_quantization* quantizations_ = nullptr;
+};
+
 /******** File-Scope Variables ********/
 
 //Look-up table from CHANX/CHANY (to SINKs) for various distances
 t_wire_cost_map f_wire_cost_map;
 
+//Quantized f_wire_cost_map of the quantized map lookahead, which then replaces f_wire_cost_map (empty otherwise)
+static QuantizedWireCostMap f_quantized_wire_cost_map;
+
+//f_wire_cost_map (or f_quantized_wire_cost_map) mapped from a shared wire lookahead file, which then replaces both (empty otherwise)
+static SharedWireCostMap f_shared_wire_cost_map;
+
 /******** File-Scope Functions ********/
 
 /***
@@ -142,6 +247,14 @@ static void set_lookahead_map_costs(int from_layer_num, int segment_index, e_rr_
 static void fill_in_missing_lookahead_entries(int segment_index, e_rr_type chan_type);
 /* returns a cost entry in the f_wire_cost_map that is near the specified coordinates (and preferably towards (0,0)) */
 static util::Cost_Entry get_nearby_cost_entry(int from_layer_num, int x, int y, int to_layer_num, int segment_index, int chan_index);
+/* returns the size of the ith dimension of the wire lookahead (f_wire_cost_map, or f_quantized_wire_cost_map if quantized) */
+static size_t wire_cost_map_dim_size(size_t i);
+/* replaces f_wire_cost_map by f_quantized_wire_cost_map */
+static void quantize_wire_cost_map();
+/* replaces the wire lookahead by the one mapped from a shared wire lookahead file */
+static void attach_shared_wire_cost_map(const std::string& file);
+/* writes the wire lookahead to a shared wire lookahead file */
+static void write_shared_wire_cost_map(const std::string& file);
 
 /**
  * @brief Fill in the missing entry in router lookahead map
@@ -163,9 +276,10 @@ static util::Cost_Entry get_nearby_cost_entry_average_neighbour(int from_layer_n
                                                                 int chan_index);
 
 /******** Interface class member function definitions ********/
-MapLookahead::MapLookahead(const t_det_routing_arch& det_routing_arch, bool is_flat)
+MapLookahead::MapLookahead(const t_det_routing_arch& det_routing_arch, bool is_flat, bool quantize)
     : det_routing_arch_(det_routing_arch)
-    , is_flat_(is_flat) {}
+    , is_flat_(is_flat)
+    , quantize_(quantize) {}
 
 float MapLookahead::get_expected_cost(RRNodeId current_node, RRNodeId target_node, const t_conn_cost_params& params, float R_upstream) const {
     auto& device_ctx = g_vpr_ctx.device();
@@ -402,6 +516,10 @@ void MapLookahead::compute(const std::vector<t_segment_inf>& segment_inf) {
 
     min_chann_global_cost_map(chann_distance_based_min_cost);
     min_opin_distance_cost_map(src_opin_delays, opin_distance_based_min_cost);
+
+    if (quantize_) {
+        quantize_wire_cost_map();
+    }
 }
 
 void MapLookahead::compute_intra_tile() {
@@ -425,13 +543,17 @@ void MapLookahead::read(const std::string& file) {
 
     min_chann_global_cost_map(chann_distance_based_min_cost);
     min_opin_distance_cost_map(src_opin_delays, opin_distance_based_min_cost);
+
+    if (quantize_) {
+        quantize_wire_cost_map();
+    }
 }
 
 void MapLookahead::read_intra_cluster(const std::string& file) {
     vtr::ScopedStartFinishTimer timer("Loading router intra cluster lookahead map");
     is_flat_ = true;
     // Maps related to global resources should not be empty
-    VTR_ASSERT(!f_wire_cost_map.empty());
+    VTR_ASSERT(!f_wire_cost_map.empty() || !f_quantized_wire_cost_map.empty() || !f_shared_wire_cost_map.empty());
     read_intra_cluster_router_lookahead(intra_tile_pin_primitive_pin_delay,
                                         file);
 
@@ -450,7 +572,7 @@ void MapLookahead::write(const std::string& file_name) const {
     if (vtr::check_file_name_extension(file_name, ".csv")) {
         std::vector<int> wire_cost_map_size(f_wire_cost_map.ndims());
         for (size_t i = 0; i < f_wire_cost_map.ndims(); ++i) {
-            wire_cost_map_size[i] = static_cast<int>(f_wire_cost_map.dim_size(i));
+            wire_cost_map_size[i] = static_cast<int>(wire_cost_map_dim_size(i));
         }
         dump_readable_router_lookahead_map(file_name, wire_cost_map_size, get_wire_cost_entry);
     } else {
@@ -464,10 +586,66 @@ void MapLookahead::write_intra_cluster(const std::string& file) const {
                                          intra_tile_pin_primitive_pin_delay);
 }
 
+void MapLookahead::read_shared(const std::string& file) {
+    attach_shared_wire_cost_map(file);
+
+    //The other tables are small, and are recomputed from the shared wire lookahead
+    this->src_opin_delays = util::compute_router_src_opin_lookahead(is_flat_);
+
+    min_chann_global_cost_map(chann_distance_based_min_cost);
+    min_opin_distance_cost_map(src_opin_delays, opin_distance_based_min_cost);
+}
+
+void MapLookahead::write_shared(const std::string& file) const {
+    write_shared_wire_cost_map(file);
+}
+
 float MapLookahead::get_opin_distance_min_delay(int physical_tile_idx, int from_layer, int to_layer, int dx, int dy) const {
     return opin_distance_based_min_cost[physical_tile_idx][from_layer][to_layer][dx][dy].delay;
 }
 
+vtr::t_memory_usage MapLookahead::memory_usage() const {
+    vtr::t_memory_usage usage;
+
+    //Wire lookahead (a shared one is mapped from its file, so not counted)
+    usage += vtr::matrix_memory_usage(f_wire_cost_map);
+    usage += vtr::matrix_memory_usage(f_quantized_wire_cost_map.costs());
+    usage += vtr::matrix_memory_usage(f_quantized_wire_cost_map.quantizations());
+
+    //Source/OPIN lookahead
+    usage += vtr::vector_memory_usage(src_opin_delays);
+    for (const auto& layer_delays : src_opin_delays) {
+        usage += vtr::vector_memory_usage(layer_delays);
+        for (const auto& tile_delays : layer_delays) {
+            usage += vtr::vector_memory_usage(tile_delays);
+            for (const auto& ptc_delays : tile_delays) {
+                usage += vtr::vector_memory_usage(ptc_delays);
+                for (const auto& reachable_wires : ptc_delays) {
+                    usage += vtr::tree_memory_usage(reachable_wires);
+                }
+            }
+        }
+    }
+
+    //Intra-cluster lookahead
+    usage += vtr::hash_memory_usage(intra_tile_pin_primitive_pin_delay);
+    for (const auto& tile_delays : intra_tile_pin_primitive_pin_delay) {
+        usage += vtr::vector_memory_usage(tile_delays.second);
+        for (const auto& pin_delays : tile_delays.second) {
+            usage += vtr::hash_memory_usage(pin_delays);
+        }
+    }
+    usage += vtr::hash_memory_usage(tile_min_cost);
+    for (const auto& tile_costs : tile_min_cost) {
+        usage += vtr::hash_memory_usage(tile_costs.second);
+    }
+
+    usage += vtr::matrix_memory_usage(chann_distance_based_min_cost);
+    usage += vtr::matrix_memory_usage(opin_distance_based_min_cost);
+
+    return usage;
+}
+
 /******** Function Definitions ********/
 
 static util::Cost_Entry get_wire_cost_entry(e_rr_type rr_type, int seg_index, int from_layer_num, int delta_x, int delta_y, int to_layer_num) {
@@ -478,17 +656,320 @@ static util::Cost_Entry get_wire_cost_entry(e_rr_type rr_type, int seg_index, in
         chan_index = 1;
     }
 
-    VTR_ASSERT_SAFE(from_layer_num < (int)f_wire_cost_map.dim_size(0));
-    VTR_ASSERT_SAFE(to_layer_num < (int)f_wire_cost_map.dim_size(3));
-    VTR_ASSERT_SAFE(delta_x < (int)f_wire_cost_map.dim_size(4));
-    VTR_ASSERT_SAFE(delta_y < (int)f_wire_cost_map.dim_size(5));
+    VTR_ASSERT_SAFE(from_layer_num < (int)wire_cost_map_dim_size(0));
+    VTR_ASSERT_SAFE(to_layer_num < (int)wire_cost_map_dim_size(3));
+    VTR_ASSERT_SAFE(delta_x < (int)wire_cost_map_dim_size(4));
+    VTR_ASSERT_SAFE(delta_y < (int)wire_cost_map_dim_size(5));
 
+    if (!f_shared_wire_cost_map.empty()) {
+        return f_shared_wire_cost_map.get(from_layer_num, chan_index, seg_index, to_layer_num, delta_x, delta_y);
+    }
+    if (!f_quantized_wire_cost_map.empty()) {
+        return f_quantized_wire_cost_map.get(from_layer_num, chan_index, seg_index, to_layer_num, delta_x, delta_y);
+    }
     return f_wire_cost_map[from_layer_num][chan_index][seg_index][to_layer_num][delta_x][delta_y];
 }
 
+static size_t wire_cost_map_dim_size(size_t i) {
+    if (!f_shared_wire_cost_map.empty()) {
+        return f_shared_wire_cost_map.dim_size(i);
+    }
+    return f_quantized_wire_cost_map.empty() ? f_wire_cost_map.dim_size(i) : f_quantized_wire_cost_map.dim_size(i);
+}
+
+static void quantize_wire_cost_map() {
+    size_t full_precision_bytes = f_wire_cost_map.size() * sizeof(util::Cost_Entry);
+
+    f_quantized_wire_cost_map.quantize(f_wire_cost_map);
+    f_wire_cost_map.clear();
+
+    VTR_LOG("Quantized router wire lookahead map: %.1f MiB (%.1f MiB at full precision)\n",
+            f_quantized_wire_cost_map.costs().size() * sizeof(QuantizedWireCostMap::t_quantized_cost) / (1024. * 1024.),
+            full_precision_bytes / (1024. * 1024.));
+}
+
+static void attach_shared_wire_cost_map(const std::string& file) {
+    vtr::ScopedStartFinishTimer timer("Attaching to shared router wire lookahead map");
+
+    //Map into a new map first, so that the current lookahead is kept if file is invalid
+    SharedWireCostMap shared_map;
+    shared_map.map(file);
+
+    const auto& grid = g_vpr_ctx.device().grid;
+    if (shared_map.dim_size(0) != (size_t)grid.get_num_layers() || shared_map.dim_size(1) != 2
+        || shared_map.dim_size(3) != (size_t)grid.get_num_layers()
+        || shared_map.dim_size(4) != grid.width() || shared_map.dim_size(5) != grid.height()) {
+        VPR_THROW(VPR_ERROR_ROUTE, "Shared router lookahead '%s' was written for a different device", file.c_str());
+    }
+
+    //The previous mapping (if any) is unmapped with shared_map
+    f_shared_wire_cost_map.swap(shared_map);
+    f_wire_cost_map.clear();
+    f_quantized_wire_cost_map.clear();
+
+    VTR_LOG("Shared router wire lookahead map: %.1f MiB\n", f_shared_wire_cost_map.size() / (1024. * 1024.));
+}
+
+static size_t shared_wire_cost_map_align(size_t offset) {
+    return (offset + SHARED_WIRE_COST_MAP_ALIGNMENT - 1) / SHARED_WIRE_COST_MAP_ALIGNMENT * SHARED_WIRE_COST_MAP_ALIGNMENT;
+}
+
+static void write_shared_wire_cost_map(const std::string& file) {
+    std::ofstream os(file, std::ios::binary | std::ios::trunc);
+    if (!os) {
+        VPR_THROW(VPR_ERROR_ROUTE, "Unable to open shared router lookahead '%s' for writing", file.c_str());
+    }
+
+    auto write_padding = [&](size_t offset) {
+        std::vector<char> padding(offset - (size_t)os.tellp(), 0);
+        os.write(padding.data(), padding.size());
+    };
+
+    if (!f_shared_wire_cost_map.empty()) {
+        //Already in the shared layout
+        os.write(f_shared_wire_cost_map.data(), f_shared_wire_cost_map.size());
+    } else {
+        bool quantized = !f_quantized_wire_cost_map.empty();
+
+        t_shared_wire_cost_map_header header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, SHARED_WIRE_COST_MAP_MAGIC, sizeof(header.magic));
+        header.version = SHARED_WIRE_COST_MAP_VERSION;
+        header.quantized = quantized;
+        size_t num_costs = 1;
+        for (size_t i = 0; i < 6; ++i) {
+            header.dims[i] = wire_cost_map_dim_size(i);
+            num_costs *= header.dims[i];
+        }
+        size_t cost_bytes = num_costs * (quantized ? sizeof(QuantizedWireCostMap::t_quantized_cost) : sizeof(t_shared_cost));
+        header.costs_offset = shared_wire_cost_map_align(sizeof(header));
+        if (quantized) {
+            header.quantizations_offset = shared_wire_cost_map_align(header.costs_offset + cost_bytes);
+        }
+
+        os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        write_padding(header.costs_offset);
+
+        if (quantized) {
+            const auto& costs = f_quantized_wire_cost_map.costs();
+            const auto& quantizations = f_quantized_wire_cost_map.quantizations();
+            if (num_costs > 0) {
+                os.write(reinterpret_cast<const char*>(&costs.get(0)), cost_bytes);
+            }
+            write_padding(header.quantizations_offset);
+            if (!quantizations.empty()) {
+                os.write(reinterpret_cast<const char*>(&quantizations.get(0)), quantizations.size() * sizeof(QuantizedWireCostMap::t_quantization));
+            }
+        } else {
+            //Dropping the fill flags, a chunk at a time
+            std::vector<t_shared_cost> chunk;
+            chunk.reserve(1 << 16);
+            for (size_t i = 0; i < num_costs; ++i) {
+                const util::Cost_Entry& cost = f_wire_cost_map.get(i);
+                chunk.push_back({cost.delay, cost.congestion});
+                if (chunk.size() == chunk.capacity() || i + 1 == num_costs) {
+                    os.write(reinterpret_cast<const char*>(chunk.data()), chunk.size() * sizeof(t_shared_cost));
+                    chunk.clear();
+                }
+            }
+        }
+    }
+
+    if (!os) {
+        VPR_THROW(VPR_ERROR_ROUTE, "Failed to write shared router lookahead '%s'", file.c_str());
+    }
+}
+
+void SharedWireCostMap::map(const std::string& file) {
+    VTR_ASSERT(empty());
+#ifndef _WIN32
+    int fd = open(file.c_str(), O_RDONLY);
+    if (fd < 0) {
+        VPR_THROW(VPR_ERROR_ROUTE, "Unable to open shared router lookahead '%s'", file.c_str());
+    }
+
+    struct stat file_stat;
+    void* mapping = MAP_FAILED;
+    size_t size = 0;
+    if (fstat(fd, &file_stat) == 0 && file_stat.st_size >= (off_t)sizeof(t_shared_wire_cost_map_header)) {
+        size = file_stat.st_size;
+        //Shared (rather than private) so that all the processes use the page cache's copy
+        mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        VPR_THROW(VPR_ERROR_ROUTE, "Unable to map shared router lookahead '%s'", file.c_str());
+    }
+    mapping_ = mapping;
+    mapping_size_ = size;
+
+    const auto* header = static_cast<const t_shared_wire_cost_map_header*>(mapping);
+    bool quantized = header->quantized;
+    bool valid = std::memcmp(header->magic, SHARED_WIRE_COST_MAP_MAGIC, sizeof(header->magic)) == 0
+                 && header->version == SHARED_WIRE_COST_MAP_VERSION;
+
+    //The tables must fit in the file (checked without overflowing)
+    size_t num_costs = 1;
+    for (size_t i = 0; valid && i < 6; ++i) {
+        if (header->dims[i] != 0 && num_costs > size / header->dims[i]) {
+            valid = false;
+        }
+        num_costs *= header->dims[i];
+    }
+    size_t num_slices = valid ? header->dims[0] * header->dims[1] * header->dims[2] : 0;
+    auto table_fits = [&](uint64_t offset, size_t num_elements, size_t element_size) {
+        return offset % SHARED_WIRE_COST_MAP_ALIGNMENT == 0 && offset <= size
+               && num_elements <= (size - offset) / element_size;
+    };
+    valid = valid
+            && table_fits(header->costs_offset, num_costs, quantized ? sizeof(QuantizedWireCostMap::t_quantized_cost) : sizeof(t_shared_cost))
+            && (!quantized || table_fits(header->quantizations_offset, num_slices, sizeof(QuantizedWireCostMap::t_quantization)));
+
+    if (!valid) {
+        clear();
+        VPR_THROW(VPR_ERROR_ROUTE, "'%s' is not a valid shared router lookahead file", file.c_str());
+    }
+
+    for (size_t i = 0; i < 6; ++i) {
+        dims_[i] = header->dims[i];
+    }
+    const char* data = static_cast<const char*>(mapping);
+    if (quantized) {
+        quantized_costs_ = reinterpret_cast<const QuantizedWireCostMap::t_quantized_cost*>(data + header->costs_offset);
+        quantizations_ = reinterpret_cast<const QuantizedWireCostMap::t_quantization*>(data + header->quantizations_offset);
+    } else {
+        costs_ = reinterpret_cast<const t_shared_cost*>(data + header->costs_offset);
+    }
+#else
+    VPR_THROW(VPR_ERROR_ROUTE, "Unable to map shared router lookahead '%s': not supported on this platform", file.c_str());
+#endif
+}
+
+void SharedWireCostMap::clear() {
+#ifndef _WIN32
+    if (mapping_) {
+        munmap(mapping_, mapping_size_);
+    }
+#endif
+    mapping_ = nullptr;
+    mapping_size_ = 0;
+    std::fill(std::begin(dims_), std::end(dims_), 0);
+    costs_ = nullptr;
+    quantized_costs_ = nullptr;
+    quantizations_ = nullptr;
+}
+
+void SharedWireCostMap::swap(SharedWireCostMap& other) {
+    std::swap(mapping_, other.mapping_);
+    std::swap(mapping_size_, other.mapping_size_);
+    std::swap(dims_, other.dims_);
+    std::swap(costs_, other.costs_);
+    std::swap(quantized_costs_, other.quantized_costs_);
+    std::swap(quantizations_, other.quantizations_);
+}
+
+void SharedWireCostMap::copy_to(t_wire_cost_map& cost_map) const {
+    cost_map.resize({dims_[0], dims_[1], dims_[2], dims_[3], dims_[4], dims_[5]});
+    for (size_t from_layer = 0; from_layer < dims_[0]; ++from_layer) {
+        for (size_t chan = 0; chan < dims_[1]; ++chan) {
+            for (size_t seg = 0; seg < dims_[2]; ++seg) {
+                for (size_t to_layer = 0; to_layer < dims_[3]; ++to_layer) {
+                    for (size_t dx = 0; dx < dims_[4]; ++dx) {
+                        for (size_t dy = 0; dy < dims_[5]; ++dy) {
+                            cost_map[from_layer][chan][seg][to_layer][dx][dy] = get(from_layer, chan, seg, to_layer, dx, dy);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+uint16_t QuantizedWireCostMap::encode(float value, float offset, float scale) {
+    if (std::isnan(value)) {
+        return NAN_CODE;
+    } else if (std::isinf(value)) {
+        return INF_CODE;
+    } else if (scale == 0.) {
+        return 0; //All the finite values of the slice are equal to the offset
+    }
+    float code = std::round((value - offset) / scale);
+    return static_cast<uint16_t>(std::min(std::max(code, 0.f), float(MAX_CODE)));
+}
+
+void QuantizedWireCostMap::quantize(const t_wire_cost_map& cost_map) {
+    std::array<size_t, 6> dims;
+    for (size_t i = 0; i < dims.size(); i++) {
+        dims[i] = cost_map.dim_size(i);
+    }
+    costs_.resize(dims);
+    quantizations_.resize({dims[0], dims[1], dims[2]});
+
+    //The entries of a [from_layer][chan][seg] slice are contiguous (NdMatrix is row-major)
+    size_t slice_size = dims[3] * dims[4] * dims[5];
+    for (size_t islice = 0; islice < quantizations_.size(); islice++) {
+        size_t slice_begin = islice * slice_size;
+        size_t slice_end = slice_begin + slice_size;
+
+        float min_delay = std::numeric_limits<float>::infinity(), max_delay = -std::numeric_limits<float>::infinity();
+        float min_cong = std::numeric_limits<float>::infinity(), max_cong = -std::numeric_limits<float>::infinity();
+        for (size_t i = slice_begin; i < slice_end; i++) {
+            const util::Cost_Entry& entry = cost_map.get(i);
+            if (std::isfinite(entry.delay)) {
+                min_delay = std::min(min_delay, entry.delay);
+                max_delay = std::max(max_delay, entry.delay);
+            }
+            if (std::isfinite(entry.congestion)) {
+                min_cong = std::min(min_cong, entry.congestion);
+                max_cong = std::max(max_cong, entry.congestion);
+            }
+        }
+
+        t_quantization& quantization = quantizations_.get(islice);
+        if (min_delay <= max_delay) {
+            quantization.delay_offset = min_delay;
+            quantization.delay_scale = (max_delay - min_delay) / MAX_CODE;
+        }
+        if (min_cong <= max_cong) {
+            quantization.congestion_offset = min_cong;
+            quantization.congestion_scale = (max_cong - min_cong) / MAX_CODE;
+        }
+
+        for (size_t i = slice_begin; i < slice_end; i++) {
+            const util::Cost_Entry& entry = cost_map.get(i);
+            costs_.get(i) = {encode(entry.delay, quantization.delay_offset, quantization.delay_scale),
+                             encode(entry.congestion, quantization.congestion_offset, quantization.congestion_scale)};
+        }
+    }
+}
+
+void QuantizedWireCostMap::dequantize(t_wire_cost_map& cost_map) const {
+    std::array<size_t, 6> dims;
+    for (size_t i = 0; i < dims.size(); i++) {
+        dims[i] = costs_.dim_size(i);
+    }
+    cost_map.resize(dims);
+
+    size_t slice_size = dims[3] * dims[4] * dims[5];
+    for (size_t i = 0; i < costs_.size(); i++) {
+        const t_quantization& quantization = quantizations_.get(i / slice_size);
+        const t_quantized_cost& cost = costs_.get(i);
+        cost_map.get(i) = util::Cost_Entry(decode(cost.delay, quantization.delay_offset, quantization.delay_scale),
+                                           decode(cost.congestion, quantization.congestion_offset, quantization.congestion_scale));
+    }
+}
+
+void QuantizedWireCostMap::clear() {
+    costs_.clear();
+    quantizations_.clear();
+}
+
 static void compute_router_wire_lookahead(const std::vector<t_segment_inf>& segment_inf_vec) {
     vtr::ScopedStartFinishTimer timer("Computing wire lookahead");
 
+    f_quantized_wire_cost_map.clear();
+    f_shared_wire_cost_map.clear();
+
     auto& device_ctx = g_vpr_ctx.device();
 
     auto& grid = device_ctx.grid;
@@ -506,36 +987,31 @@ static void compute_router_wire_lookahead(const std::vector<t_segment_inf>& segm
         longest_seg_length = std::max(longest_seg_length, seg_inf.length);
     }
 
-    //Profile each wire segment type
-    for (int from_layer_num = 0; from_layer_num < grid.get_num_layers(); from_layer_num++) {
-        for (const auto& segment_inf : segment_inf_vec) {
-            std::vector<e_rr_type> chan_types;
-            if (segment_inf.parallel_axis == X_AXIS)
-                chan_types.push_back(CHANX);
-            else if (segment_inf.parallel_axis == Y_AXIS)
-                chan_types.push_back(CHANY);
-            else //Both for BOTH_AXIS segments and special segments such as clock_networks we want to search in both directions.
-                chan_types.insert(chan_types.end(), {CHANX, CHANY});
-
-            for (e_rr_type chan_type : chan_types) {
-                util::t_routing_cost_map routing_cost_map = util::get_routing_cost_map(longest_seg_length,
-                                                                                       from_layer_num,
-                                                                                       chan_type,
-                                                                                       segment_inf,
-                                                                                       std::unordered_map<int, std::unordered_set<int>>(),
-                                                                                       true);
-                if (routing_cost_map.empty()) {
-                    continue;
-                }
-
-                /* boil down the cost list in routing_cost_map at each coordinate to a representative cost entry and store it in the lookahead
-                 * cost map */
-                set_lookahead_map_costs(from_layer_num, segment_inf.seg_index, chan_type, routing_cost_map);
-
-                /* fill in missing entries in the lookahead cost map by copying the closest cost entries (cost map was computed based on
-                 * a reference coordinate > (0,0) so some entries that represent a cross-chip distance have not been computed) */
-                fill_in_missing_lookahead_entries(segment_inf.seg_index, chan_type);
-            }
+    //Profile each wire segment type. Each profiling job writes its own
+    //[from_layer][chan][seg] slice of the cost map, so jobs can run concurrently.
+    std::vector<util::t_wire_profiling_job> jobs = util::get_wire_profiling_jobs(segment_inf_vec);
+    std::vector<bool> profiled = util::run_wire_profiling_jobs(jobs,
+                                                               longest_seg_length,
+                                                               std::unordered_map<int, std::unordered_set<int>>(),
+                                                               true,
+                                                               [](const util::t_wire_profiling_job& job, util::t_routing_cost_map& routing_cost_map) {
+                                                                   /* boil down the cost list in routing_cost_map at each coordinate to a representative cost entry and store it in the lookahead
+                                                                    * cost map */
+                                                                   set_lookahead_map_costs(job.from_layer_num, job.segment_inf->seg_index, job.chan_type, routing_cost_map);
+                                                               });
+
+    /* fill in missing entries in the lookahead cost map by copying the closest cost entries (cost map was computed based on
+     * a reference coordinate > (0,0) so some entries that represent a cross-chip distance have not been computed).
+     *
+     * This reads entries across all layers of a segment/channel type, so it is done serially, in job order, once every
+     * layer has been profiled. This keeps the result independent of the number of workers. */
+    std::set<std::pair<int, e_rr_type>> filled;
+    for (size_t ijob = 0; ijob < jobs.size(); ijob++) {
+        if (!profiled[ijob]) continue;
+
+        int seg_index = jobs[ijob].segment_inf->seg_index;
+        if (filled.insert({seg_index, jobs[ijob].chan_type}).second) {
+            fill_in_missing_lookahead_entries(seg_index, jobs[ijob].chan_type);
         }
     }
 }
@@ -683,15 +1159,37 @@ static void compute_tiles_lookahead(std::unordered_map<int, util::t_ipin_primiti
                                     const DeviceContext& device_ctx) {
     const auto& tiles = device_ctx.physical_tile_types;
 
-    for (const auto& tile : tiles) {
+    //Each tile type is expanded on its own tile RR graph, so the expansions are independent.
+    //Results are first gathered per tile type, then merged in tile type order.
+    std::vector<std::unordered_map<int, util::t_ipin_primitive_sink_delays>> tile_pin_delays(tiles.size());
+
+    auto compute_tile = [&](size_t itile) {
+        const auto& tile = tiles[itile];
         if (is_empty_type(&tile)) {
-            continue;
+            return;
         }
 
-        compute_tile_lookahead(intra_tile_pin_primitive_pin_delay,
+        compute_tile_lookahead(tile_pin_delays[itile],
                                &tile,
                                det_routing_arch,
                                device_ctx.delayless_switch_idx);
+    };
+
+#ifdef VPR_USE_TBB
+    tbb::parallel_for(size_t(0), tiles.size(), compute_tile);
+#else
+    for (size_t itile = 0; itile < tiles.size(); itile++) {
+        compute_tile(itile);
+    }
+#endif
+
+    for (size_t itile = 0; itile < tiles.size(); itile++) {
+        const auto& tile = tiles[itile];
+        if (is_empty_type(&tile)) {
+            continue;
+        }
+
+        intra_tile_pin_primitive_pin_delay.insert(tile_pin_delays[itile].begin(), tile_pin_delays[itile].end());
         store_min_cost_to_sinks(tile_min_cost,
                                 &tile,
                                 intra_tile_pin_primitive_pin_delay);
@@ -779,10 +1277,9 @@ static void min_chann_global_cost_map(vtr::NdMatrix<util::Cost_Entry, 4>& distan
             for (int dx = 0; dx < width; dx++) {
                 for (int dy = 0; dy < height; dy++) {
                     util::Cost_Entry min_cost(std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
-                    for (int chan_idx = 0; chan_idx < (int)f_wire_cost_map.dim_size(1); chan_idx++) {
-                        for (int seg_idx = 0; seg_idx < (int)f_wire_cost_map.dim_size(2); seg_idx++) {
-                            auto cost = util::Cost_Entry(f_wire_cost_map[from_layer_num][chan_idx][seg_idx][to_layer_num][dx][dy].delay,
-                                                         f_wire_cost_map[from_layer_num][chan_idx][seg_idx][to_layer_num][dx][dy].congestion);
+                    for (int chan_idx = 0; chan_idx < (int)wire_cost_map_dim_size(1); chan_idx++) {
+                        for (int seg_idx = 0; seg_idx < (int)wire_cost_map_dim_size(2); seg_idx++) {
+                            auto cost = get_wire_cost_entry((chan_idx == 0) ? CHANX : CHANY, seg_idx, from_layer_num, dx, dy, to_layer_num);
                             if (cost.delay < min_cost.delay) {
                                 min_cost.delay = cost.delay;
                                 min_cost.congestion = cost.congestion;
@@ -910,6 +1407,30 @@ static void FromCostEntry(VprMapCostEntry::Builder* out, const util::Cost_Entry&
     out->setCongestion(in.congestion);
 }
 
+static void ToQuantizedCostEntry(QuantizedWireCostMap::t_quantized_cost* out, const VprQuantizedCostEntry::Reader& in) {
+    out->delay = in.getDelay();
+    out->congestion = in.getCongestion();
+}
+
+static void FromQuantizedCostEntry(VprQuantizedCostEntry::Builder* out, const QuantizedWireCostMap::t_quantized_cost& in) {
+    out->setDelay(in.delay);
+    out->setCongestion(in.congestion);
+}
+
+static void ToCostQuantization(QuantizedWireCostMap::t_quantization* out, const VprCostQuantization::Reader& in) {
+    out->delay_offset = in.getDelayOffset();
+    out->delay_scale = in.getDelayScale();
+    out->congestion_offset = in.getCongestionOffset();
+    out->congestion_scale = in.getCongestionScale();
+}
+
+static void FromCostQuantization(VprCostQuantization::Builder* out, const QuantizedWireCostMap::t_quantization& in) {
+    out->setDelayOffset(in.delay_offset);
+    out->setDelayScale(in.delay_scale);
+    out->setCongestionOffset(in.congestion_offset);
+    out->setCongestionScale(in.congestion_scale);
+}
+
 static void toIntEntry(std::vector<int>& out,
                        int idx,
                        const int& cost) {
@@ -1078,7 +1599,17 @@ void read_router_lookahead(const std::string& file) {
 
     auto map = reader.getRoot<VprMapLookahead>();
 
-    ToNdMatrix<6, VprMapCostEntry, util::Cost_Entry>(&f_wire_cost_map, map.getCostMap(), ToCostEntry);
+    f_quantized_wire_cost_map.clear();
+    f_shared_wire_cost_map.clear();
+    if (map.hasQuantizedCostMap()) {
+        //Written by a quantized map lookahead: decode it (MapLookahead::read() quantizes it again if needed)
+        ToNdMatrix<6, VprQuantizedCostEntry, QuantizedWireCostMap::t_quantized_cost>(&f_quantized_wire_cost_map.mutable_costs(), map.getQuantizedCostMap(), ToQuantizedCostEntry);
+        ToNdMatrix<3, VprCostQuantization, QuantizedWireCostMap::t_quantization>(&f_quantized_wire_cost_map.mutable_quantizations(), map.getCostQuantizations(), ToCostQuantization);
+        f_quantized_wire_cost_map.dequantize(f_wire_cost_map);
+        f_quantized_wire_cost_map.clear();
+    } else {
+        ToNdMatrix<6, VprMapCostEntry, util::Cost_Entry>(&f_wire_cost_map, map.getCostMap(), ToCostEntry);
+    }
 }
 
 void write_router_lookahead(const std::string& file) {
@@ -1086,8 +1617,21 @@ void write_router_lookahead(const std::string& file) {
 
     auto map = builder.initRoot<VprMapLookahead>();
 
-    auto cost_map = map.initCostMap();
-    FromNdMatrix<6, VprMapCostEntry, util::Cost_Entry>(&cost_map, f_wire_cost_map, FromCostEntry);
+    if (!f_quantized_wire_cost_map.empty()) {
+        auto quantized_cost_map = map.initQuantizedCostMap();
+        FromNdMatrix<6, VprQuantizedCostEntry, QuantizedWireCostMap::t_quantized_cost>(&quantized_cost_map, f_quantized_wire_cost_map.costs(), FromQuantizedCostEntry);
+        auto cost_quantizations = map.initCostQuantizations();
+        FromNdMatrix<3, VprCostQuantization, QuantizedWireCostMap::t_quantization>(&cost_quantizations, f_quantized_wire_cost_map.quantizations(), FromCostQuantization);
+    } else if (!f_shared_wire_cost_map.empty()) {
+        //Written at full precision (the decoded costs if the shared map is quantized)
+        t_wire_cost_map shared_cost_map;
+        f_shared_wire_cost_map.copy_to(shared_cost_map);
+        auto cost_map = map.initCostMap();
+        FromNdMatrix<6, VprMapCostEntry, util::Cost_Entry>(&cost_map, shared_cost_map, FromCostEntry);
+    } else {
+        auto cost_map = map.initCostMap();
+        FromNdMatrix<6, VprMapCostEntry, util::Cost_Entry>(&cost_map, f_wire_cost_map, FromCostEntry);
+    }
 
     writeMessageToFile(file, &builder);
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <limits>
 #include "vtr_ndmatrix.h"
@@ -11,9 +12,19 @@
  */
 class MapLookahead : public RouterLookahead {
   public:
-    explicit MapLookahead(const t_det_routing_arch& det_routing_arch, bool is_flat);
+    /**
+     * @param quantize If true, the wire lookahead is stored quantized to 16 bits per value once computed
+     *                 or read (see QuantizedWireCostMap), which divides its memory footprint by 3
+     */
+    MapLookahead(const t_det_routing_arch& det_routing_arch, bool is_flat, bool quantize = false);
+
+    // The connection router calls get_expected_cost() without a virtual call (see t_router_features)
+    template<typename HeapImplementation>
+    friend class ConnectionRouter;
 
   private:
+    // Only reads the lookup tables below (through at() and find(): operator[] would insert into
+    // the maps), so the parallel routers' threads can share a single lookahead in flat routing
     float get_expected_cost_flat_router(RRNodeId current_node, RRNodeId target_node, const t_conn_cost_params& params, float R_upstream) const;
     //Look-up table from SOURCE/OPIN to CHANX/CHANY of various types
     util::t_src_opin_delays src_opin_delays;
@@ -27,6 +38,7 @@ class MapLookahead : public RouterLookahead {
 
     const t_det_routing_arch& det_routing_arch_;
     bool is_flat_;
+    bool quantize_;
 
   protected:
     float get_expected_cost(RRNodeId current_node, RRNodeId target_node, const t_conn_cost_params& params, float R_upstream) const override;
@@ -38,7 +50,10 @@ class MapLookahead : public RouterLookahead {
     void read_intra_cluster(const std::string& file) override;
     void write(const std::string& file_name) const override;
     void write_intra_cluster(const std::string& file) const override;
+    void read_shared(const std::string& file) override;
+    void write_shared(const std::string& file) const override;
     float get_opin_distance_min_delay(int physical_tile_idx, int from_layer, int to_layer, int dx, int dy) const override;
+    vtr::t_memory_usage memory_usage() const override;
 };
 
 /* provides delay/congestion estimates to travel specified distances
@@ -52,5 +67,71 @@ typedef vtr::NdMatrix<util::Cost_Entry, 6> t_wire_cost_map; //[0..num_layers][0.
                                                             // The first index is the layer number that the node under consideration is on, and the forth index
                                                             // is the layer number that the target node is on.
 
+/**
+ * @brief A t_wire_cost_map whose delays and congestions are quantized to 16 bits (4 bytes per entry instead of 12)
+ *
+ * The costs of each [from_layer][chan][seg] slice of the map are encoded linearly between the smallest
+ * and the largest finite value of the slice: value = offset + code * scale. The largest codes are
+ * reserved for NaN (no cost recorded) and infinity, so the error of a decoded value is at most half a
+ * step, (max - min) / (2 * MAX_CODE), of its slice.
+ */
+class QuantizedWireCostMap {
+  public:
+    struct t_quantized_cost {
+        uint16_t delay;
+        uint16_t congestion;
+    };
+
+    ///@brief The encoding of the costs of a [from_layer][chan][seg] slice
+    struct t_quantization {
+        float delay_offset = 0.;
+        float delay_scale = 0.;
+        float congestion_offset = 0.;
+        float congestion_scale = 0.;
+    };
+
+    static constexpr uint16_t NAN_CODE = 0xFFFF;
+    static constexpr uint16_t INF_CODE = 0xFFFE;
+    static constexpr uint16_t MAX_CODE = 0xFFFD;
+
+    ///@brief Replaces the content of this map by the quantized costs of cost_map
+    void quantize(const t_wire_cost_map& cost_map);
+
+    ///@brief Decodes all the costs of this map into cost_map
+    void dequantize(t_wire_cost_map& cost_map) const;
+
+    ///@brief Returns the decoded cost at the given indices (the same as t_wire_cost_map's)
+    util::Cost_Entry get(int from_layer, int chan, int seg, int to_layer, int dx, int dy) const {
+        const t_quantized_cost& cost = costs_[from_layer][chan][seg][to_layer][dx][dy];
+        const t_quantization& quantization = quantizations_[from_layer][chan][seg];
+        return util::Cost_Entry(decode(cost.delay, quantization.delay_offset, quantization.delay_scale),
+                                decode(cost.congestion, quantization.congestion_offset, quantization.congestion_scale));
+    }
+
+    bool empty() const { return costs_.empty(); }
+    void clear();
+    size_t dim_size(size_t i) const { return costs_.dim_size(i); }
+
+    ///@brief The codes and slice encodings, for serialization
+    const vtr::NdMatrix<t_quantized_cost, 6>& costs() const { return costs_; }
+    const vtr::NdMatrix<t_quantization, 3>& quantizations() const { return quantizations_; }
+    vtr::NdMatrix<t_quantized_cost, 6>& mutable_costs() { return costs_; }
+    vtr::NdMatrix<t_quantization, 3>& mutable_quantizations() { return quantizations_; }
+
+    ///@brief Returns the value of code in a slice encoded with offset and scale
+    static float decode(uint16_t code, float offset, float scale) {
+        if (code >= INF_CODE) {
+            return (code == NAN_CODE) ? std::numeric_limits<float>::quiet_NaN() : std::numeric_limits<float>::infinity();
+        }
+        return offset + code * scale;
+    }
+
+  private:
+    static uint16_t encode(float value, float offset, float scale);
+
+    vtr::NdMatrix<t_quantized_cost, 6> costs_;       //Same dimensions as the t_wire_cost_map
+    vtr::NdMatrix<t_quantization, 3> quantizations_; //[0..num_layers][0..1][0..num_seg_types-1]
+};
+
 void read_router_lookahead(const std::string& file);
 void write_router_lookahead(const std::string& file);
@@ -18,6 +18,10 @@
 #include "route_common.h"
 #include "route_debug.h"
 
+#ifdef VPR_USE_TBB
+#    include <tbb/parallel_for.h>
+#endif
+
 /**
  * We will profile delay/congestion using this many tracks for each wire type.
  * Larger values increase the time to compute the lookahead, but may give
@@ -817,6 +821,61 @@ t_routing_cost_map get_routing_cost_map(int longest_seg_length,
     return routing_cost_map;
 }
 
+std::vector<t_wire_profiling_job> get_wire_profiling_jobs(const std::vector<t_segment_inf>& segment_inf_vec) {
+    const auto& grid = g_vpr_ctx.device().grid;
+
+    std::vector<t_wire_profiling_job> jobs;
+    for (int from_layer_num = 0; from_layer_num < grid.get_num_layers(); from_layer_num++) {
+        for (const auto& segment_inf : segment_inf_vec) {
+            if (segment_inf.parallel_axis == X_AXIS) {
+                jobs.push_back({from_layer_num, &segment_inf, CHANX});
+            } else if (segment_inf.parallel_axis == Y_AXIS) {
+                jobs.push_back({from_layer_num, &segment_inf, CHANY});
+            } else { //Both for BOTH_AXIS segments and special segments such as clock_networks we want to search in both directions.
+                jobs.push_back({from_layer_num, &segment_inf, CHANX});
+                jobs.push_back({from_layer_num, &segment_inf, CHANY});
+            }
+        }
+    }
+    return jobs;
+}
+
+std::vector<bool> run_wire_profiling_jobs(const std::vector<t_wire_profiling_job>& jobs,
+                                          int longest_seg_length,
+                                          const std::unordered_map<int, std::unordered_set<int>>& sample_locs,
+                                          bool sample_all_locs,
+                                          const std::function<void(const t_wire_profiling_job&, t_routing_cost_map&)>& store_costs) {
+    //Stored as char rather than bool so that concurrent writes to different jobs do not race
+    std::vector<char> profiled(jobs.size(), false);
+
+    auto run_job = [&](size_t ijob) {
+        const t_wire_profiling_job& job = jobs[ijob];
+        t_routing_cost_map routing_cost_map = get_routing_cost_map(longest_seg_length,
+                                                                   job.from_layer_num,
+                                                                   job.chan_type,
+                                                                   *job.segment_inf,
+                                                                   sample_locs,
+                                                                   sample_all_locs);
+        if (routing_cost_map.empty()) {
+            return;
+        }
+
+        store_costs(job, routing_cost_map);
+        profiled[ijob] = true;
+    };
+
+#ifdef VPR_USE_TBB
+    //Jobs share no mutable state, so the result is independent of the number of workers
+    tbb::parallel_for(size_t(0), jobs.size(), run_job);
+#else
+    for (size_t ijob = 0; ijob < jobs.size(); ijob++) {
+        run_job(ijob);
+    }
+#endif
+
+    return std::vector<bool>(profiled.begin(), profiled.end());
+}
+
 std::pair<float, float> get_cost_from_src_opin(const std::map<int, util::t_reachable_wire_inf>& src_opin_delay_map,
                                                int delta_x,
                                                int delta_y,
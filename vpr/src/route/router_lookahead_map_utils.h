@@ -16,6 +16,7 @@
  */
 
 #include <cmath>
+#include <functional>
 #include <limits>
 #include <vector>
 #include <queue>
@@ -344,6 +345,38 @@ t_routing_cost_map get_routing_cost_map(int longest_seg_length,
                                         const std::unordered_map<int, std::unordered_set<int>>& sample_locs,
                                         bool sample_all_locs);
 
+/**
+ * @brief A single wire profiling run: the Dijkstra floods from the sample points of one
+ *        segment type along one channel type, starting on one layer.
+ */
+struct t_wire_profiling_job {
+    int from_layer_num;
+    const t_segment_inf* segment_inf;
+    e_rr_type chan_type;
+};
+
+/**
+ * @brief Returns the wire profiling jobs needed to profile every segment type on every layer,
+ *        in the order the lookahead maps are filled.
+ */
+std::vector<t_wire_profiling_job> get_wire_profiling_jobs(const std::vector<t_segment_inf>& segment_inf_vec);
+
+/**
+ * @brief Runs the wire profiling jobs, in parallel when VPR is built with TBB.
+ *
+ * Each job profiles the routing network with its own Dijkstra state (via get_routing_cost_map())
+ * and hands its cost map to store_costs. store_costs may run concurrently for different jobs,
+ * so it must only write data owned by the job it is given (e.g. the job's slice of a cost map);
+ * any cross-job post-processing should be done by the caller once this function returns.
+ *
+ * @return For each job, whether it produced a (non-empty) cost map.
+ */
+std::vector<bool> run_wire_profiling_jobs(const std::vector<t_wire_profiling_job>& jobs,
+                                          int longest_seg_length,
+                                          const std::unordered_map<int, std::unordered_set<int>>& sample_locs,
+                                          bool sample_all_locs,
+                                          const std::function<void(const t_wire_profiling_job&, t_routing_cost_map&)>& store_costs);
+
 /**
  * @brief Iterate over all of the wire segments accessible from the SOURCE/OPIN (stored in src_opin_delay_map) and return the minimum cost (congestion and delay) across them to the sink
  * @param src_opin_delay_map
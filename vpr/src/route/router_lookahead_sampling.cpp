@@ -149,59 +149,56 @@ static std::tuple<int, int, int> get_node_info(const t_rr_node& node, int num_se
     return std::tuple<int, int, int>(seg_index, x, y);
 }
 
-// Fills the sample_regions vector
-static void compute_sample_regions(std::vector<SampleRegion>& sample_regions,
-                                   std::vector<vtr::Matrix<int>>& segment_counts,
-                                   std::vector<vtr::Rect<int>>& bounding_box_for_segment,
-                                   int num_segments) {
-    // select sample points
-    for (int i = 0; i < num_segments; i++) {
-        const auto& counts = segment_counts[i];
-        const auto& bounding_box = bounding_box_for_segment[i];
-        if (bounding_box.empty()) continue;
-        for (int y = 0; y < SAMPLE_GRID_SIZE; y++) {
-            for (int x = 0; x < SAMPLE_GRID_SIZE; x++) {
-                vtr::Rect<int> window = sample_window(bounding_box, x, y, SAMPLE_GRID_SIZE);
-                if (window.empty()) continue;
-
-                auto histogram = count_histogram(window, segment_counts[i]);
-                SampleRegion region = {
-                    /* .segment_type = */ i,
-                    /* .grid_location = */ vtr::Point<int>(x, y),
-                    /* .points = */ choose_points(counts, window, quantile(histogram, kSamplingCountLowerQuantile), quantile(histogram, kSamplingCountUpperQuantile)),
-                    /* .order = */ 0};
-                if (!region.points.empty()) {
-                    /* In order to improve caching, the list of sample points are
-                     * sorted to keep points that are nearby on the Euclidean plane also
-                     * nearby in the vector of sample points.
-                     *
-                     * This means subsequent expansions on the same thread are likely
-                     * to cover a similar set of nodes, so they are more likely to be
-                     * cached. This improves performance by about 7%, which isn't a lot,
-                     * but not a bad improvement for a few lines of code. */
-                    vtr::Point<int> location = region.points[0].location;
-
-                    // interleave bits of X and Y for a Z-curve ordering.
-                    region.order = interleave(location.x()) | (interleave(location.y()) << 1);
-
-                    sample_regions.push_back(region);
-                }
-            }
-        }
+// Returns the sample region of a window, whose points are empty if the window has no sample points
+static SampleRegion find_sample_region(const SegmentNodeCounts& segment_counts, const SampleWindow& grid_window) {
+    int i = grid_window.segment_type;
+    const auto& counts = segment_counts.counts[i];
+    const auto& bounding_box = segment_counts.bounding_boxes[i];
+
+    SampleRegion region = {
+        /* .segment_type = */ i,
+        /* .level = */ grid_window.level,
+        /* .grid_location = */ grid_window.grid_location,
+        /* .points = */ {},
+        /* .order = */ 0};
+    if (bounding_box.empty()) {
+        return region;
     }
+
+    vtr::Rect<int> window = sample_window(bounding_box,
+                                          grid_window.grid_location.x(), grid_window.grid_location.y(),
+                                          SAMPLE_GRID_SIZE << grid_window.level);
+    if (window.empty()) {
+        return region;
+    }
+
+    auto histogram = count_histogram(window, counts);
+    region.points = choose_points(counts, window, quantile(histogram, kSamplingCountLowerQuantile), quantile(histogram, kSamplingCountUpperQuantile));
+    if (!region.points.empty()) {
+        /* In order to improve caching, the list of sample points are
+         * sorted to keep points that are nearby on the Euclidean plane also
+         * nearby in the vector of sample points.
+         *
+         * This means subsequent expansions on the same thread are likely
+         * to cover a similar set of nodes, so they are more likely to be
+         * cached. This improves performance by about 7%, which isn't a lot,
+         * but not a bad improvement for a few lines of code. */
+        vtr::Point<int> location = region.points[0].location;
+
+        // interleave bits of X and Y for a Z-curve ordering.
+        region.order = interleave(location.x()) | (interleave(location.y()) << 1);
+    }
+    return region;
 }
 
-// for each segment type, find the nearest nodes to an equally spaced grid of points
-// within the bounding box for that segment type
-std::vector<SampleRegion> find_sample_regions(int num_segments) {
-    vtr::ScopedStartFinishTimer timer("finding sample regions");
-    std::vector<SampleRegion> sample_regions;
+SegmentNodeCounts count_segment_nodes(int num_segments) {
     auto& device_ctx = g_vpr_ctx.device();
     const auto& rr_graph = device_ctx.rr_graph;
-    std::vector<vtr::Matrix<int>> segment_counts(num_segments);
+    SegmentNodeCounts segment_counts;
+    segment_counts.counts.resize(num_segments);
 
     // compute bounding boxes for each segment type
-    std::vector<vtr::Rect<int>> bounding_box_for_segment(num_segments, vtr::Rect<int>());
+    segment_counts.bounding_boxes.assign(num_segments, vtr::Rect<int>());
     for (auto& node : rr_graph.rr_nodes()) {
         if (rr_graph.node_type(node.id()) != CHANX && rr_graph.node_type(node.id()) != CHANY) continue;
         if (rr_graph.node_capacity(node.id()) == 0 || rr_graph.num_edges(node.id()) == 0) continue;
@@ -210,13 +207,13 @@ std::vector<SampleRegion> find_sample_regions(int num_segments) {
         VTR_ASSERT(seg_index != OPEN);
         VTR_ASSERT(seg_index < num_segments);
 
-        bounding_box_for_segment[seg_index].expand_bounding_box(bounding_box_for_node(node.id()));
+        segment_counts.bounding_boxes[seg_index].expand_bounding_box(bounding_box_for_node(node.id()));
     }
 
     // initialize counts
     for (int seg = 0; seg < num_segments; seg++) {
-        const auto& box = bounding_box_for_segment[seg];
-        segment_counts[seg] = vtr::Matrix<int>({size_t(box.width()), size_t(box.height())}, 0);
+        const auto& box = segment_counts.bounding_boxes[seg];
+        segment_counts.counts[seg] = vtr::Matrix<int>({size_t(box.width()), size_t(box.height())}, 0);
     }
 
     // count sample points
@@ -226,10 +223,61 @@ std::vector<SampleRegion> find_sample_regions(int num_segments) {
 
         if (seg_index == OPEN) continue;
 
-        segment_counts[seg_index][x][y] += 1;
+        segment_counts.counts[seg_index][x][y] += 1;
     }
 
-    compute_sample_regions(sample_regions, segment_counts, bounding_box_for_segment, num_segments);
+    return segment_counts;
+}
+
+std::vector<SampleWindow> initial_sample_windows(int num_segments) {
+    std::vector<SampleWindow> windows;
+    for (int i = 0; i < num_segments; i++) {
+        for (int xy = 0; xy < SAMPLE_GRID_SIZE; xy++) {
+            windows.push_back(SampleWindow{i, 0, vtr::Point<int>(xy, xy)});
+        }
+    }
+    return windows;
+}
+
+std::vector<SampleWindow> refined_sample_windows(int segment_type) {
+    std::vector<SampleWindow> windows;
+    for (int y = 0; y < SAMPLE_GRID_SIZE; y++) {
+        for (int x = 0; x < SAMPLE_GRID_SIZE; x++) {
+            if (x != y) {
+                windows.push_back(SampleWindow{segment_type, 0, vtr::Point<int>(x, y)});
+            }
+        }
+    }
+
+    // The junction between level 0 windows (x - 1, y - 1) and (x, y) is surrounded by
+    // the level 1 windows (2x - 1, 2y - 1) to (2x, 2y)
+    for (int y = 1; y < SAMPLE_GRID_SIZE; y++) {
+        for (int x = 1; x < SAMPLE_GRID_SIZE; x++) {
+            for (int dy = -1; dy <= 0; dy++) {
+                for (int dx = -1; dx <= 0; dx++) {
+                    windows.push_back(SampleWindow{segment_type, 1, vtr::Point<int>(2 * x + dx, 2 * y + dy)});
+                }
+            }
+        }
+    }
+    return windows;
+}
+
+std::vector<SampleRegion> find_sample_regions(const SegmentNodeCounts& segment_counts,
+                                              const std::vector<SampleWindow>& windows) {
+    vtr::ScopedStartFinishTimer timer("finding sample regions");
+    std::vector<SampleRegion> sample_regions;
+    auto& device_ctx = g_vpr_ctx.device();
+    const auto& rr_graph = device_ctx.rr_graph;
+    int num_segments = segment_counts.counts.size();
+
+    // select sample points
+    for (const SampleWindow& window : windows) {
+        SampleRegion region = find_sample_region(segment_counts, window);
+        if (!region.points.empty()) {
+            sample_regions.push_back(std::move(region));
+        }
+    }
 
     // sort regions
     std::stable_sort(sample_regions.begin(), sample_regions.end(),
@@ -238,10 +286,11 @@ std::vector<SampleRegion> find_sample_regions(int num_segments) {
               });
 
     // build an index of sample points on segment type and location
-    std::map<std::tuple<int, int, int>, SamplePoint*> sample_point_index;
+    // (the windows of different levels overlap, so a location can be a point of several regions)
+    std::map<std::tuple<int, int, int>, std::vector<SamplePoint*>> sample_point_index;
     for (auto& region : sample_regions) {
         for (auto& point : region.points) {
-            sample_point_index[std::make_tuple(region.segment_type, point.location.x(), point.location.y())] = &point;
+            sample_point_index[std::make_tuple(region.segment_type, point.location.x(), point.location.y())].push_back(&point);
         }
     }
 
@@ -252,9 +301,11 @@ std::vector<SampleRegion> find_sample_regions(int num_segments) {
 
         if (seg_index == OPEN) continue;
 
-        auto point = sample_point_index.find(std::make_tuple(seg_index, x, y));
-        if (point != sample_point_index.end()) {
-            point->second->nodes.push_back(node.id());
+        auto points = sample_point_index.find(std::make_tuple(seg_index, x, y));
+        if (points != sample_point_index.end()) {
+            for (SamplePoint* point : points->second) {
+                point->nodes.push_back(node.id());
+            }
         }
     }
 
@@ -3,6 +3,7 @@
 
 #include <vector>
 #include "vtr_geometry.h"
+#include "vtr_ndmatrix.h"
 #include "globals.h"
 
 // a sample point for a segment type, contains all segments at the VPR location
@@ -14,10 +15,28 @@ struct SamplePoint {
     std::vector<RRNodeId> nodes;
 };
 
+// A window of the sample grid of a segment type: its bounding box split into an
+// N x N grid, where N = SAMPLE_GRID_SIZE << level.
+//
+// The grid of level + 1 splits each window of level in 2 x 2, so the windows of
+// the higher levels are used to refine the sampling where the costs vary.
+struct SampleWindow {
+    int segment_type;
+
+    // refinement level of the sample grid
+    int level;
+
+    // location on the sample grid
+    vtr::Point<int> grid_location;
+};
+
 struct SampleRegion {
     // all nodes in `points' have this segment type
     int segment_type;
 
+    // refinement level of the sample grid (see SampleWindow)
+    int level;
+
     // location on the sample grid
     vtr::Point<int> grid_location;
 
@@ -30,6 +49,32 @@ struct SampleRegion {
     uint64_t order;
 };
 
-std::vector<SampleRegion> find_sample_regions(int num_segments);
+// the number of (expandable) wire nodes of each segment type at each location,
+// from which the sample points are chosen
+struct SegmentNodeCounts {
+    // [0..num_segments-1][x][y]
+    std::vector<vtr::Matrix<int>> counts;
+
+    // the bounding box of the nodes of each segment type [0..num_segments-1]
+    std::vector<vtr::Rect<int>> bounding_boxes;
+};
+
+SegmentNodeCounts count_segment_nodes(int num_segments);
+
+// The initial windows of the adaptive sampling: for each segment type, the
+// windows on the diagonal of the level 0 grid.
+std::vector<SampleWindow> initial_sample_windows(int num_segments);
+
+// The windows refining the sampling of a segment type whose initial samples
+// disagree: the other windows of the level 0 grid, and the windows of the
+// level 1 grid at the junctions of the level 0 windows, where the costs found
+// from either side of the boundaries would differ the most.
+std::vector<SampleWindow> refined_sample_windows(int segment_type);
+
+// Chooses the sample points of each window, and collects their nodes.
+// The windows without sample points are dropped, and the regions are sorted
+// to improve caching.
+std::vector<SampleRegion> find_sample_regions(const SegmentNodeCounts& segment_counts,
+                                              const std::vector<SampleWindow>& windows);
 
 #endif
@@ -0,0 +1,233 @@
+#include "router_phase_profiling.h"
+
+#include "vpr_error.h"
+
+#ifndef VPR_ROUTER_PHASE_PROFILING
+
+namespace router_phase_profiling {
+
+void init(const std::string& json_file, bool /*hw_counters*/) {
+    if (!json_file.empty()) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                        "Router phase profiling requires VPR to be built with VPR_ROUTER_PHASE_PROFILING\n");
+    }
+}
+
+void write_iteration(int /*itry*/, float /*wall_time*/) {}
+
+void finish() {}
+
+} // namespace router_phase_profiling
+
+#else /* VPR_ROUTER_PHASE_PROFILING */
+
+#    include <array>
+#    include <chrono>
+#    include <cstdint>
+#    include <fstream>
+#    include <memory>
+#    include <mutex>
+#    include <vector>
+
+#    include "vtr_log.h"
+
+#    ifdef __linux__
+#        include <linux/perf_event.h>
+#        include <sys/syscall.h>
+#        include <unistd.h>
+#    endif
+
+namespace router_phase_profiling {
+
+using phase_clock = std::chrono::steady_clock;
+
+constexpr size_t NUM_PHASES = size_t(e_router_phase::NUM_PHASES);
+
+/** Names of the phases in the JSON output */
+constexpr std::array<const char*, NUM_PHASES> PHASE_NAMES = {"lookahead", "heap", "cost_evaluation", "route_tree", "timing_analysis"};
+
+/** Hardware counters read per thread */
+enum e_hw_counter {
+    HW_CYCLES,
+    HW_INSTRUCTIONS,
+    HW_CACHE_MISSES,
+    NUM_HW_COUNTERS
+};
+
+/** Phase profile of a single thread */
+struct t_thread_profile {
+    std::array<double, NUM_PHASES> phase_time = {}; ///<Seconds spent in each phase this iteration
+    e_router_phase phase = e_router_phase::NUM_PHASES; ///<Current phase (NUM_PHASES: not in any phase)
+    phase_clock::time_point phase_start;               ///<When the current phase was (re-)entered
+
+    std::array<int, NUM_HW_COUNTERS> hw_fd = {-1, -1, -1};    ///<perf_event file descriptors, -1 if unavailable
+    std::array<uint64_t, NUM_HW_COUNTERS> hw_last_count = {}; ///<Counts at the end of the previous iteration
+
+    ~t_thread_profile() {
+#    ifdef __linux__
+        for (int fd : hw_fd) {
+            if (fd >= 0) close(fd);
+        }
+#    endif
+    }
+};
+
+/* Profiling state. Threads register their profile on their first phase of a run (init()),
+ * the generation tells them whether the profile they hold belongs to the current run. */
+static bool enabled = false;
+static bool read_hw_counters = false;
+static unsigned generation = 0;
+static std::ofstream json;
+static std::mutex threads_mutex;
+static std::vector<std::unique_ptr<t_thread_profile>> threads;
+
+static thread_local t_thread_profile* thread_profile = nullptr;
+static thread_local unsigned thread_generation = 0;
+
+#    ifdef __linux__
+/** Open a hardware counter of the calling thread (user space only), -1 if unavailable */
+static int open_hw_counter(uint64_t config) {
+    perf_event_attr attr = {};
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+static uint64_t read_hw_counter(int fd) {
+    uint64_t count = 0;
+    if (read(fd, &count, sizeof(count)) != sizeof(count))
+        return 0;
+    return count;
+}
+#    endif
+
+/** Profile of the calling thread, registered on first use in this run */
+static t_thread_profile& get_thread_profile() {
+    if (thread_generation != generation) {
+        auto profile = std::make_unique<t_thread_profile>();
+#    ifdef __linux__
+        if (read_hw_counters) {
+            profile->hw_fd[HW_CYCLES] = open_hw_counter(PERF_COUNT_HW_CPU_CYCLES);
+            profile->hw_fd[HW_INSTRUCTIONS] = open_hw_counter(PERF_COUNT_HW_INSTRUCTIONS);
+            profile->hw_fd[HW_CACHE_MISSES] = open_hw_counter(PERF_COUNT_HW_CACHE_MISSES);
+            for (size_t i = 0; i < NUM_HW_COUNTERS; i++) {
+                if (profile->hw_fd[i] >= 0)
+                    profile->hw_last_count[i] = read_hw_counter(profile->hw_fd[i]);
+            }
+        }
+#    endif
+        std::lock_guard<std::mutex> lock(threads_mutex);
+        thread_profile = profile.get();
+        thread_generation = generation;
+        threads.push_back(std::move(profile));
+    }
+    return *thread_profile;
+}
+
+ScopedPhase::ScopedPhase(e_router_phase phase)
+    : active_(enabled) {
+    if (!active_)
+        return;
+
+    t_thread_profile& profile = get_thread_profile();
+    auto now = phase_clock::now();
+    if (profile.phase != e_router_phase::NUM_PHASES) {
+        profile.phase_time[size_t(profile.phase)] += std::chrono::duration<double>(now - profile.phase_start).count();
+    }
+    prev_phase_ = profile.phase;
+    profile.phase = phase;
+    profile.phase_start = now;
+}
+
+ScopedPhase::~ScopedPhase() {
+    if (!active_)
+        return;
+
+    t_thread_profile& profile = *thread_profile;
+    auto now = phase_clock::now();
+    profile.phase_time[size_t(profile.phase)] += std::chrono::duration<double>(now - profile.phase_start).count();
+    profile.phase = prev_phase_;
+    profile.phase_start = now;
+}
+
+void init(const std::string& json_file, bool hw_counters) {
+    if (json_file.empty())
+        return;
+
+    /* A previous route() may have returned without finish(): start over */
+    if (json.is_open())
+        json.close();
+    json.clear();
+    json.open(json_file);
+    if (!json) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Failed to open router phase profile '%s' for writing\n", json_file.c_str());
+    }
+#    ifndef __linux__
+    if (hw_counters) {
+        VTR_LOG_WARN("Router phase profiling: hardware counters are only supported on Linux\n");
+        hw_counters = false;
+    }
+#    endif
+
+    threads.clear();
+    ++generation;
+    read_hw_counters = hw_counters;
+    enabled = true;
+}
+
+void write_iteration(int itry, float wall_time) {
+    if (!enabled)
+        return;
+
+    std::lock_guard<std::mutex> lock(threads_mutex);
+
+    json << "{\"iteration\": " << itry << ", \"wall_time\": " << wall_time << ", \"threads\": [";
+    for (size_t ithread = 0; ithread < threads.size(); ithread++) {
+        t_thread_profile& profile = *threads[ithread];
+
+        json << (ithread > 0 ? ", {" : "{");
+        for (size_t iphase = 0; iphase < NUM_PHASES; iphase++) {
+            json << (iphase > 0 ? ", \"" : "\"") << PHASE_NAMES[iphase] << "\": " << profile.phase_time[iphase];
+        }
+        profile.phase_time.fill(0.);
+
+        if (read_hw_counters) {
+#    ifdef __linux__
+            constexpr std::array<const char*, NUM_HW_COUNTERS> HW_COUNTER_NAMES = {"cycles", "instructions", "cache_misses"};
+            std::array<uint64_t, NUM_HW_COUNTERS> counts = {};
+            for (size_t i = 0; i < NUM_HW_COUNTERS; i++) {
+                if (profile.hw_fd[i] < 0) {
+                    json << ", \"" << HW_COUNTER_NAMES[i] << "\": null";
+                    continue;
+                }
+                uint64_t count = read_hw_counter(profile.hw_fd[i]);
+                counts[i] = count - profile.hw_last_count[i];
+                profile.hw_last_count[i] = count;
+                json << ", \"" << HW_COUNTER_NAMES[i] << "\": " << counts[i];
+            }
+            if (counts[HW_CYCLES] > 0 && profile.hw_fd[HW_INSTRUCTIONS] >= 0) {
+                json << ", \"ipc\": " << double(counts[HW_INSTRUCTIONS]) / counts[HW_CYCLES];
+            }
+#    endif
+        }
+        json << "}";
+    }
+    json << "]}" << std::endl;
+}
+
+void finish() {
+    if (!enabled)
+        return;
+
+    enabled = false;
+    json.close();
+    std::lock_guard<std::mutex> lock(threads_mutex);
+    threads.clear();
+}
+
+} // namespace router_phase_profiling
+
+#endif /* VPR_ROUTER_PHASE_PROFILING */
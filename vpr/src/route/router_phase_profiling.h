@@ -0,0 +1,65 @@
+#pragma once
+
+/**
+ * @file
+ * @brief Breakdown of router time into phases, per routing iteration and per thread.
+ *
+ * The router code marks its phases (lookahead queries, heap operations, node cost
+ * evaluation, route tree updates, timing analysis) with router_phase_profiling::ScopedPhase.
+ * Phases nest, and time is charged to the innermost one only, so the cost evaluation
+ * time does not include the lookahead queries it makes.
+ *
+ * Profiling is compiled in only with VPR_ROUTER_PHASE_PROFILING (CMake option of the
+ * same name), since timing each heap operation costs a few percent of router run-time:
+ * otherwise ScopedPhase is empty and every call below is a no-op. It is then enabled with
+ * --router_phase_profile, which writes one JSON object (line) per routing iteration. On
+ * Linux, the per-thread cycle, instruction and cache miss counts of each iteration can be
+ * added to it (--router_phase_profile_hw_counters), read from perf_event counters.
+ */
+
+#include <string>
+
+enum class e_router_phase {
+    LOOKAHEAD,       ///<RouterLookahead queries
+    HEAP,            ///<Heap pushes and pops
+    COST_EVALUATION, ///<Evaluating the cost of reaching a node (less lookahead queries)
+    ROUTE_TREE,      ///<Route tree pruning and updates
+    TIMING_ANALYSIS, ///<Net delay and timing graph updates
+    NUM_PHASES
+};
+
+namespace router_phase_profiling {
+
+#ifdef VPR_ROUTER_PHASE_PROFILING
+/** Charges the time until it goes out of scope to a phase (of the calling thread) */
+class ScopedPhase {
+  public:
+    explicit ScopedPhase(e_router_phase phase);
+    ~ScopedPhase();
+
+    ScopedPhase(const ScopedPhase&) = delete;
+    ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+  private:
+    bool active_;
+    e_router_phase prev_phase_;
+};
+#else
+class ScopedPhase {
+  public:
+    explicit ScopedPhase(e_router_phase /*phase*/) {}
+};
+#endif
+
+/** Start profiling, writing the iterations to json_file (no-op if it is empty). Reads the
+ * hardware counters of each thread too if hw_counters is set. */
+void init(const std::string& json_file, bool hw_counters);
+
+/** Write the profile of routing iteration itry (which took wall_time seconds), and reset the
+ * per-thread phase times. Must be called while no thread is routing. */
+void write_iteration(int itry, float wall_time);
+
+/** Stop profiling and close the JSON file */
+void finish();
+
+} // namespace router_phase_profiling
@@ -3,6 +3,7 @@
 #include "netlist_fwd.h"
 #include "rr_graph_fwd.h"
 #include "rr_node_types.h"
+#include "router_lookahead_correction.h"
 #include "vtr_assert.h"
 
 // This struct instructs the router on how to route the given connection
@@ -27,6 +28,10 @@ struct ConnectionParameters {
     bool has_choking_spot_;
 
     const std::unordered_map<RRNodeId, int>& connection_choking_spots_;
+
+    // Whether the connection is searched within its global routing corridor (see
+    // GlobalRouteGuides), in which case failing to find a path is expected now and then
+    bool in_global_route_corridor_ = false;
 };
 
 struct RouterStats {
@@ -46,6 +51,14 @@ struct RouterStats {
     // For debugging purposes
     size_t rt_node_pushes[t_rr_type::NUM_RR_TYPES] = {0};
 
+    // Lookahead estimates against the actual costs of the paths found (only
+    // recorded when the lookahead correction is enabled, see LookaheadCorrection)
+    LookaheadCorrectionSamples lookahead_samples;
+
+    // Connections with no path within their global routing corridor, routed
+    // within their net bounding box instead
+    size_t global_route_corridor_misses = 0;
+
     /** Add rhs's stats to mine */
     void combine(RouterStats& rhs) {
         connections_routed += rhs.connections_routed;
@@ -63,6 +76,8 @@ struct RouterStats {
             intra_cluster_node_type_cnt_pops[node_type_idx] += rhs.intra_cluster_node_type_cnt_pops[node_type_idx];
             rt_node_pushes[node_type_idx] += rhs.rt_node_pushes[node_type_idx];
         }
+        lookahead_samples.combine(rhs.lookahead_samples);
+        global_route_corridor_misses += rhs.global_route_corridor_misses;
     }
 };
 
@@ -104,6 +119,8 @@ struct OveruseInfo {
     size_t overused_nodes = 0u;
     size_t total_overuse = 0u;
     size_t worst_overuse = 0u;
+    /** [layer] Overused nodes on each die. Only filled in for multi-die devices */
+    std::vector<size_t> layer_overused_nodes;
 
     float overused_node_ratio() const {
         if (total_nodes > 0) {
@@ -174,6 +174,37 @@ float RoutingPredictor::estimate_success_iteration() {
     return success_iteration;
 }
 
+float RoutingPredictor::estimate_layer_success_iteration(size_t layer) const {
+    VTR_ASSERT(layer < layer_overused_rr_node_counts_.size());
+    const std::vector<size_t>& overuse = layer_overused_rr_node_counts_[layer];
+
+    if (!overuse.empty() && overuse.back() == 0) {
+        //Nothing overused on this die
+        return layer_iterations_.back();
+    }
+
+    float success_iteration = std::numeric_limits<float>::quiet_NaN();
+
+    if (layer_iterations_.size() > min_history_) {
+        //A die may have been legal in some earlier iterations: count those as a single overused node,
+        //since the model is fitted to the log of the overuse
+        std::vector<size_t> clamped_overuse(overuse.size());
+        std::transform(overuse.begin(), overuse.end(), clamped_overuse.begin(), [](size_t count) {
+            return std::max<size_t>(count, 1);
+        });
+
+        auto model = fit_model(layer_iterations_, clamped_overuse, history_factor_);
+        success_iteration = model.find_x_for_y_value(0.);
+
+        if (success_iteration < 0. || std::isnan(success_iteration)) {
+            //No downward trend (e.g. the overuse stayed constant)
+            success_iteration = std::numeric_limits<float>::infinity();
+        }
+    }
+
+    return success_iteration;
+}
+
 float RoutingPredictor::estimate_overuse_slope() {
     //We use a fixed size sliding window of history to estimate the slope
     //This makes the slope estimate more 'recent' than the values used to estimate
@@ -209,3 +240,16 @@ void RoutingPredictor::add_iteration_overuse(size_t iteration, size_t overused_r
         slope_ = model.get_slope();
     }
 }
+
+void RoutingPredictor::add_iteration_layer_overuse(size_t iteration, const std::vector<size_t>& layer_overused_rr_node_counts) {
+    if (layer_overused_rr_node_counts_.size() != layer_overused_rr_node_counts.size()) {
+        //First record (or after the history was reset)
+        layer_iterations_.clear();
+        layer_overused_rr_node_counts_.assign(layer_overused_rr_node_counts.size(), {});
+    }
+
+    layer_iterations_.push_back(iteration);
+    for (size_t layer = 0; layer < layer_overused_rr_node_counts.size(); ++layer) {
+        layer_overused_rr_node_counts_[layer].push_back(layer_overused_rr_node_counts[layer]);
+    }
+}
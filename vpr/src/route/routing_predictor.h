@@ -13,7 +13,16 @@ constexpr float ROUTING_PREDICTOR_ITERATION_ABORT_FACTOR_AGGRESSIVE = 1.5;
 // This avoids giving up when solutions are nearly legal, but converging slowly
 constexpr size_t ROUTING_PREDICTOR_MIN_ABSOLUTE_OVERUSE_THRESHOLD = 100;
 
+//Number of iterations of overuse history needed before predicting when a warm-started
+//routing (see RoutingWarmStart) will succeed. It starts close to its final congestion,
+//so the overuse trend shows sooner than from scratch.
+constexpr size_t ROUTING_PREDICTOR_WARM_START_MIN_HISTORY = 4;
+
+class RouteCheckpoint;
+
 class RoutingPredictor {
+    friend class RouteCheckpoint; //Saves and restores the overuse history
+
   public:
     RoutingPredictor(size_t min_history = 8, float history_factor = 0.5);
 
@@ -25,6 +34,15 @@ class RoutingPredictor {
 
     void add_iteration_overuse(size_t iteration, size_t overused_rr_node_count);
 
+    //Records the overuse of each die of a multi-die device (see OveruseInfo::layer_overused_nodes)
+    void add_iteration_layer_overuse(size_t iteration, const std::vector<size_t>& layer_overused_rr_node_counts);
+
+    //Returns the number of dies with a recorded overuse history (0 unless multi-die)
+    size_t num_layers() const { return layer_overused_rr_node_counts_.size(); }
+
+    //Returns the estimated iteration when the overuse on die layer will be resolved
+    float estimate_layer_success_iteration(size_t layer) const;
+
     float get_slope() const;
 
   private:
@@ -34,6 +52,10 @@ class RoutingPredictor {
     std::vector<size_t> iterations_;
     std::vector<size_t> iteration_overused_rr_node_counts_;
     float slope_;
+
+    //Per die history. It is not checkpointed, and restarts when a checkpoint is restored.
+    std::vector<size_t> layer_iterations_;
+    std::vector<std::vector<size_t>> layer_overused_rr_node_counts_; //[layer][history index]
 };
 
 #endif
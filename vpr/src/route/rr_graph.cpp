@@ -41,9 +41,17 @@
 #include "rr_types.h"
 #include "echo_files.h"
 
+#if defined(VPR_USE_TBB)
+#    include <tbb/parallel_for.h>
+#    include <tbb/task_arena.h>
+#endif
+
 //#define VERBOSE
 //used for getting the exact count of each edge type and printing it to std out.
 
+/* Number of grid columns whose channel edges are collected concurrently, per thread */
+constexpr size_t CHAN_COLUMNS_PER_THREAD = 4;
+
 struct t_mux {
     int size;
     t_mux* next;
@@ -488,7 +496,6 @@ static void build_rr_chan(RRGraphBuilder& rr_graph_builder,
                           t_sb_connection_map* sb_conn_map,
                           const vtr::NdMatrix<std::vector<int>, 3>& switch_block_conn,
                           vtr::NdMatrix<int, 2>& num_of_3d_conns_custom_SB,
-                          const int cost_index_offset,
                           const t_chan_width& nodes_per_chan,
                           const DeviceGrid& grid,
                           const int tracks_per_chan,
@@ -504,6 +511,23 @@ static void build_rr_chan(RRGraphBuilder& rr_graph_builder,
                           const int delayless_switch,
                           const enum e_directionality directionality);
 
+/**
+ * @brief Loads the attributes (type, span, cost index, RC data, ...) of the channel wires starting at (layer, x_coord, y_coord).
+ *
+ * build_rr_chan() only records the edges of these wires, which only needs the node lookup: the edges of different
+ * channels can then be collected concurrently, while this function (which creates the RC data of the nodes)
+ * runs in the usual channel order, so that the RC data (and graph) is the same as when building serially.
+ */
+static void load_rr_chan_nodes(RRGraphBuilder& rr_graph_builder,
+                               const int layer,
+                               const int x_coord,
+                               const int y_coord,
+                               const t_rr_type chan_type,
+                               const int cost_index_offset,
+                               const int tracks_per_chan,
+                               const t_chan_details& chan_details_x,
+                               const t_chan_details& chan_details_y);
+
 /**
  * @brief builds the extra length-0 CHANX nodes to handle 3D custom switchblocks edges in the RR graph.
  *  @param rr_graph_builder RRGraphBuilder data structure which allows data modification on a routing resource graph
@@ -553,7 +577,8 @@ static void rr_graph_externals(const std::vector<t_segment_inf>& segment_inf,
                                const std::vector<t_segment_inf>& segment_inf_x,
                                const std::vector<t_segment_inf>& segment_inf_y,
                                int wire_to_rr_ipin_switch,
-                               enum e_base_cost_type base_cost_type);
+                               enum e_base_cost_type base_cost_type,
+                               bool reuse_indexed_data_delays);
 
 static t_clb_to_clb_directs* alloc_and_load_clb_to_clb_directs(const t_direct_inf* directs, const int num_directs, const int delayless_switch);
 
@@ -678,6 +703,7 @@ static void build_rr_graph(const t_graph_type graph_type,
                            const float R_minW_nmos,
                            const float R_minW_pmos,
                            const enum e_base_cost_type base_cost_type,
+                           const bool reuse_indexed_data_delays,
                            const enum e_clock_modeling clock_modeling,
                            const t_direct_inf* directs,
                            const int num_directs,
@@ -783,12 +809,20 @@ void create_rr_graph(const t_graph_type graph_type,
                            det_routing_arch->R_minW_nmos,
                            det_routing_arch->R_minW_pmos,
                            router_opts.base_cost_type,
+                           router_opts.reuse_rr_indexed_data_delays,
                            router_opts.clock_modeling,
                            directs, num_directs,
                            &det_routing_arch->wire_to_rr_ipin_switch,
                            is_flat,
                            Warnings,
                            router_opts.route_verbosity);
+            if (router_opts.compress_rr_graph_edges == e_rr_edge_compression::TILED
+                && router_opts.reorder_rr_graph_nodes_algorithm == DONT_REORDER) {
+                // Number the nodes tile by tile, so identical tiles get identical edge patterns
+                mutable_device_ctx.rr_graph_builder.reorder_nodes(TILE_LOCATION,
+                                                                  0,
+                                                                  router_opts.reorder_rr_graph_nodes_seed);
+            }
         }
     }
 
@@ -819,6 +853,9 @@ void create_rr_graph(const t_graph_type graph_type,
 
     rr_set_sink_locs(device_ctx.rr_graph, mutable_device_ctx.rr_graph_builder, grid);
 
+    // The graph is complete: pack the look-up (verified below in its compressed form)
+    mutable_device_ctx.rr_graph_builder.node_lookup().compress();
+
     verify_rr_node_indices(grid,
                            device_ctx.rr_graph,
                            device_ctx.rr_indexed_data,
@@ -846,6 +883,30 @@ void create_rr_graph(const t_graph_type graph_type,
                        echo_file_name,
                        is_flat);
     }
+
+    if (router_opts.compress_rr_graph_edges != e_rr_edge_compression::NONE) {
+        const t_rr_graph_storage& rr_nodes = device_ctx.rr_graph.rr_nodes();
+        size_t unpacked_bytes = rr_nodes.edge_memory_bytes();
+        if (router_opts.compress_rr_graph_edges == e_rr_edge_compression::TILED) {
+            if (mutable_device_ctx.rr_graph_builder.tile_edges()) {
+                VTR_LOG("Tiled RR graph edges: %.1f MiB -> %.1f MiB (%zu distinct edge pattern entries)\n",
+                        unpacked_bytes / (1024. * 1024.),
+                        rr_nodes.edge_memory_bytes() / (1024. * 1024.),
+                        rr_nodes.num_edge_pattern_entries());
+            } else {
+                VTR_LOG("RR graph edge patterns do not repeat enough to save memory, packing the edges instead\n");
+            }
+        }
+        if (!rr_nodes.edges_packed()) {
+            if (mutable_device_ctx.rr_graph_builder.pack_edges()) {
+                VTR_LOG("Packed RR graph edges: %.1f MiB -> %.1f MiB\n",
+                        unpacked_bytes / (1024. * 1024.),
+                        rr_nodes.edge_memory_bytes() / (1024. * 1024.));
+            } else {
+                VTR_LOG_WARN("Unable to pack RR graph edges: RR node and switch ids do not fit in 32 bits\n");
+            }
+        }
+    }
 }
 
 static void add_intra_cluster_edges_rr_graph(RRGraphBuilder& rr_graph_builder,
@@ -1009,6 +1070,7 @@ static void build_rr_graph(const t_graph_type graph_type,
                            const float R_minW_nmos,
                            const float R_minW_pmos,
                            const enum e_base_cost_type base_cost_type,
+                           const bool reuse_indexed_data_delays,
                            const enum e_clock_modeling clock_modeling,
                            const t_direct_inf* directs,
                            const int num_directs,
@@ -1482,7 +1544,7 @@ static void build_rr_graph(const t_graph_type graph_type,
     //Save the channel widths for the newly constructed graph
     device_ctx.chan_width = nodes_per_chan;
 
-    rr_graph_externals(segment_inf, segment_inf_x, segment_inf_y, *wire_to_rr_ipin_switch, base_cost_type);
+    rr_graph_externals(segment_inf, segment_inf_x, segment_inf_y, *wire_to_rr_ipin_switch, base_cost_type, reuse_indexed_data_delays);
 
     check_rr_graph(device_ctx.rr_graph,
                    types,
@@ -1854,7 +1916,8 @@ static void rr_graph_externals(const std::vector<t_segment_inf>& segment_inf,
                                const std::vector<t_segment_inf>& segment_inf_x,
                                const std::vector<t_segment_inf>& segment_inf_y,
                                int wire_to_rr_ipin_switch,
-                               enum e_base_cost_type base_cost_type) {
+                               enum e_base_cost_type base_cost_type,
+                               bool reuse_indexed_data_delays) {
     auto& device_ctx = g_vpr_ctx.device();
     const auto& rr_graph = device_ctx.rr_graph;
     const auto& grid = device_ctx.grid;
@@ -1864,7 +1927,8 @@ static void rr_graph_externals(const std::vector<t_segment_inf>& segment_inf,
     const char* echo_file_name = getEchoFileName(E_ECHO_RR_GRAPH_INDEXED_DATA);
     add_rr_graph_C_from_switches(rr_graph.rr_switch_inf(RRSwitchId(wire_to_rr_ipin_switch)).Cin);
     alloc_and_load_rr_indexed_data(rr_graph, grid, segment_inf, segment_inf_x,
-                                   segment_inf_y, rr_indexed_data, wire_to_rr_ipin_switch, base_cost_type, echo_enabled, echo_file_name);
+                                   segment_inf_y, rr_indexed_data, wire_to_rr_ipin_switch, base_cost_type, echo_enabled, echo_file_name,
+                                   reuse_indexed_data_delays ? &mutable_device_ctx.rr_indexed_data_delays : nullptr);
     //load_rr_index_segments(segment_inf.size());
 }
 
@@ -2219,72 +2283,136 @@ static std::function<void(t_chan_width*)> alloc_and_load_rr_graph(RRGraphBuilder
         num_of_3d_conns_custom_SB.resize(std::array<size_t,2>{grid.width(), grid.height()}, 0);
     }
 
-    for (size_t i = 0; i < grid.width() - 1; ++i) {
+    /* The edges of the channels are collected one grid column at a time, each column into its own
+     * buffer, so that the columns can be processed concurrently. The buffers are then loaded in
+     * column order, together with the channel nodes, which gives the same graph as building the
+     * channels one after another.
+     *
+     * The 3D connections of custom switch blocks are numbered per switch block in the order the
+     * tracks are visited (num_of_3d_conns_custom_SB), so these graphs are built serially. */
+    auto& device_ctx = g_vpr_ctx.device();
+    bool build_3d_custom_sb = grid.get_num_layers() > 1 && sb_conn_map != nullptr;
+
+    auto build_column_chan_edges = [&](size_t i, t_rr_edge_info_set& column_edges, t_rr_edge_info_set& column_3d_edges) {
+        t_rr_edge_info_set chan_edges;
         for (size_t j = 0; j < grid.height() - 1; ++j) {
             for (int layer = 0; layer < grid.get_num_layers(); ++layer) {
-                auto &device_ctx = g_vpr_ctx.device();
                 /* Skip the current die if architecture file specifies that it doesn't require inter-cluster programmable resource routing */
                 if (!device_ctx.inter_cluster_prog_routing_resources.at(layer)) {
                     continue;
                 }
-                /* In multi-die FPGAs with track-to-track connections between layers, we need to load newly added length-0 CHANX nodes
-                 * These extra nodes can be driven from many tracks in the source layer and can drive multiple tracks in the destination layer,
-                 * since these die-crossing connections have more delays.
-                 */
-                if (grid.get_num_layers() > 1 && sb_conn_map != nullptr) {
-                    //custom switch block defined in the architecture
-                    VTR_ASSERT(sblock_pattern.empty() && switch_block_conn.empty());
-                    build_inter_die_custom_sb_rr_chan(rr_graph_builder, layer, i, j, CHANX_COST_INDEX_START, chan_width,
-                                                      chan_details_x);
-                }
-
                 if (i > 0) {
                     int tracks_per_chan = ((is_global_graph) ? 1 : chan_width.x_list[j]);
                     build_rr_chan(rr_graph_builder, layer, i, j, CHANX, track_to_pin_lookup_x, sb_conn_map,
                                   switch_block_conn,
-                                  num_of_3d_conns_custom_SB, CHANX_COST_INDEX_START,
+                                  num_of_3d_conns_custom_SB,
                                   chan_width, grid, tracks_per_chan,
                                   sblock_pattern, Fs / 3, chan_details_x, chan_details_y,
-                                  rr_edges_to_create, des_3d_rr_edges_to_create,
+                                  chan_edges, column_3d_edges,
                                   wire_to_ipin_switch,
                                   wire_to_pin_between_dice_switch,
                                   custom_3d_sb_fanin_fanout,
                                   delayless_switch,
                                   directionality);
 
-                    //Create the actual CHAN->CHAN edges
-                    uniquify_edges(rr_edges_to_create);
-                    alloc_and_load_edges(rr_graph_builder, rr_edges_to_create);
-                    num_edges += rr_edges_to_create.size();
-
-                    rr_edges_to_create.clear();
+                    //Collect the CHAN->CHAN edges of this channel segment
+                    uniquify_edges(chan_edges);
+                    column_edges.insert(column_edges.end(), chan_edges.begin(), chan_edges.end());
+                    chan_edges.clear();
                 }
                 if (j > 0) {
                     int tracks_per_chan = ((is_global_graph) ? 1 : chan_width.y_list[i]);
                     build_rr_chan(rr_graph_builder, layer, i, j, CHANY, track_to_pin_lookup_y, sb_conn_map,
                                   switch_block_conn,
-                                  num_of_3d_conns_custom_SB, CHANX_COST_INDEX_START + num_seg_types_x,
+                                  num_of_3d_conns_custom_SB,
                                   chan_width, grid, tracks_per_chan,
                                   sblock_pattern, Fs / 3, chan_details_x, chan_details_y,
-                                  rr_edges_to_create, des_3d_rr_edges_to_create,
+                                  chan_edges, column_3d_edges,
                                   wire_to_ipin_switch,
                                   wire_to_pin_between_dice_switch,
                                   custom_3d_sb_fanin_fanout,
                                   delayless_switch,
                                   directionality);
 
-                    //Create the actual CHAN->CHAN edges
-                    uniquify_edges(rr_edges_to_create);
-                    alloc_and_load_edges(rr_graph_builder, rr_edges_to_create);
-                    num_edges += rr_edges_to_create.size();
+                    //Collect the CHAN->CHAN edges of this channel segment
+                    uniquify_edges(chan_edges);
+                    column_edges.insert(column_edges.end(), chan_edges.begin(), chan_edges.end());
+                    chan_edges.clear();
+                }
+            }
+        }
+    };
 
-                    rr_edges_to_create.clear();
+    auto load_column_chan_nodes = [&](size_t i) {
+        for (size_t j = 0; j < grid.height() - 1; ++j) {
+            for (int layer = 0; layer < grid.get_num_layers(); ++layer) {
+                if (!device_ctx.inter_cluster_prog_routing_resources.at(layer)) {
+                    continue;
+                }
+                /* In multi-die FPGAs with track-to-track connections between layers, we need to load newly added length-0 CHANX nodes
+                 * These extra nodes can be driven from many tracks in the source layer and can drive multiple tracks in the destination layer,
+                 * since these die-crossing connections have more delays.
+                 */
+                if (build_3d_custom_sb) {
+                    //custom switch block defined in the architecture
+                    VTR_ASSERT(sblock_pattern.empty() && switch_block_conn.empty());
+                    build_inter_die_custom_sb_rr_chan(rr_graph_builder, layer, i, j, CHANX_COST_INDEX_START, chan_width,
+                                                      chan_details_x);
+                }
+                if (i > 0) {
+                    int tracks_per_chan = ((is_global_graph) ? 1 : chan_width.x_list[j]);
+                    load_rr_chan_nodes(rr_graph_builder, layer, i, j, CHANX, CHANX_COST_INDEX_START, tracks_per_chan,
+                                       chan_details_x, chan_details_y);
+                }
+                if (j > 0) {
+                    int tracks_per_chan = ((is_global_graph) ? 1 : chan_width.y_list[i]);
+                    load_rr_chan_nodes(rr_graph_builder, layer, i, j, CHANY, CHANX_COST_INDEX_START + num_seg_types_x, tracks_per_chan,
+                                       chan_details_x, chan_details_y);
                 }
             }
         }
+    };
+
+    /* Columns are processed in batches, to bound the memory held by the column buffers (RR graph
+     * creation is the high-watermark of VPR's memory use) */
+    size_t column_batch_size = 1;
+#if defined(VPR_USE_TBB)
+    if (!build_3d_custom_sb) {
+        column_batch_size = CHAN_COLUMNS_PER_THREAD * tbb::this_task_arena::max_concurrency();
     }
+#endif
+    size_t num_columns = grid.width() - 1;
+    std::vector<t_rr_edge_info_set> column_edges(column_batch_size);
+    for (size_t first_column = 0; first_column < num_columns; first_column += column_batch_size) {
+        size_t num_batch_columns = std::min(column_batch_size, num_columns - first_column);
+#if defined(VPR_USE_TBB)
+        if (num_batch_columns > 1) {
+            tbb::parallel_for(size_t(0), num_batch_columns, [&](size_t icolumn) {
+                //Only custom 3D switch blocks create edges between layers, which are built serially
+                t_rr_edge_info_set unused_3d_edges;
+                build_column_chan_edges(first_column + icolumn, column_edges[icolumn], unused_3d_edges);
+                VTR_ASSERT(unused_3d_edges.empty());
+            });
+        } else {
+            build_column_chan_edges(first_column, column_edges[0], des_3d_rr_edges_to_create);
+        }
+#else
+        build_column_chan_edges(first_column, column_edges[0], des_3d_rr_edges_to_create);
+#endif
 
-    if(grid.get_num_layers() > 1 && sb_conn_map != nullptr){
+        for (size_t icolumn = 0; icolumn < num_batch_columns; ++icolumn) {
+            load_column_chan_nodes(first_column + icolumn);
+
+            //Create the actual CHAN->CHAN edges
+            alloc_and_load_edges(rr_graph_builder, column_edges[icolumn]);
+            num_edges += column_edges[icolumn].size();
+
+            column_edges[icolumn].clear();
+        }
+    }
+    column_edges.clear();
+
+    if (build_3d_custom_sb) {
         uniquify_edges(des_3d_rr_edges_to_create);
         alloc_and_load_edges(rr_graph_builder, des_3d_rr_edges_to_create);
         num_edges += des_3d_rr_edges_to_create.size();
@@ -3123,8 +3251,9 @@ static std::unordered_set<int> get_chain_pins(std::vector<t_pin_chain_node> chai
     return chain_pins;
 }
 
-/* Allocates/loads edges for nodes belonging to specified channel segment and initializes
- * node properties such as cost, occupancy and capacity */
+/* Collects the edges of the wires starting in the specified channel segment. Only reads the
+ * graph (node lookup), so that different channels can be processed concurrently: the node
+ * properties such as cost, occupancy and capacity are set by load_rr_chan_nodes() */
 static void build_rr_chan(RRGraphBuilder& rr_graph_builder,
                           const int layer,
                           const int x_coord,
@@ -3134,7 +3263,6 @@ static void build_rr_chan(RRGraphBuilder& rr_graph_builder,
                           t_sb_connection_map* sb_conn_map,
                           const vtr::NdMatrix<std::vector<int>, 3>& switch_block_conn,
                           vtr::NdMatrix<int, 2>& num_of_3d_conns_custom_SB,
-                          const int cost_index_offset,
                           const t_chan_width& nodes_per_chan,
                           const DeviceGrid& grid,
                           const int tracks_per_chan,
@@ -3153,7 +3281,6 @@ static void build_rr_chan(RRGraphBuilder& rr_graph_builder,
      * coordinates based on channel type */
 
     auto& device_ctx = g_vpr_ctx.device();
-    auto& mutable_device_ctx = g_vpr_ctx.mutable_device();
 
     //Initally assumes CHANX
     int seg_coord = x_coord;                           //The absolute coordinate of this segment within the channel
@@ -3287,8 +3414,47 @@ static void build_rr_chan(RRGraphBuilder& rr_graph_builder,
                 }
             }
         }
+    }
+}
+
+static void load_rr_chan_nodes(RRGraphBuilder& rr_graph_builder,
+                               const int layer,
+                               const int x_coord,
+                               const int y_coord,
+                               const t_rr_type chan_type,
+                               const int cost_index_offset,
+                               const int tracks_per_chan,
+                               const t_chan_details& chan_details_x,
+                               const t_chan_details& chan_details_y) {
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& mutable_device_ctx = g_vpr_ctx.mutable_device();
+
+    int seg_coord = x_coord;
+    int chan_coord = y_coord;
+    int seg_dimension = device_ctx.grid.width() - 2; //-2 for no perim channels
+    if (chan_type == CHANY) {
+        std::swap(seg_coord, chan_coord);
+        seg_dimension = device_ctx.grid.height() - 2;
+    }
+
+    const t_chan_seg_details* seg_details = ((chan_type == CHANX) ? chan_details_x : chan_details_y)[x_coord][y_coord].data();
+
+    for (int track = 0; track < tracks_per_chan; ++track) {
+        if (seg_details[track].length() == 0)
+            continue;
+
+        int start = get_seg_start(seg_details, track, chan_coord, seg_coord);
+        int end = get_seg_end(seg_details, track, start, chan_coord, seg_dimension);
+
+        if (seg_coord > start)
+            continue; /* Only process segments which start at this location */
+
+        RRNodeId node = rr_graph_builder.node_lookup().find_node(layer, x_coord, y_coord, chan_type, track);
+
+        if (!node) {
+            continue;
+        }
 
-        /* Edge arrays have now been built up.  Do everything else.  */
         /* AA: The cost_index should be w.r.t the index of the segment to its **parallel** 
          * segment_inf vector. Note that when building channels, we use the indices
          * w.r.t segment_inf_x and segment_inf_y as computed earlier in 
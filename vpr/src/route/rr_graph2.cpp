@@ -2255,10 +2255,12 @@ static void get_switchblocks_edges(RRGraphBuilder& rr_graph_builder,
 
     /* get coordinate to index into the SB map */
     Switchblock_Lookup sb_coord(tile_x, tile_y, layer, from_side, to_side);
-    if (sb_conn_map->count(sb_coord) > 0) {
+    /* Look the connections up with find() (rather than operator[]): channels are built concurrently */
+    auto sb_conns = sb_conn_map->find(sb_coord);
+    if (sb_conns != sb_conn_map->end()) {
         /* get reference to the connections vector which lists all destination wires for a given source wire
          * at a specific coordinate sb_coord */
-        std::vector<t_switchblock_edge>& conn_vector = (*sb_conn_map)[sb_coord];
+        const std::vector<t_switchblock_edge>& conn_vector = sb_conns->second;
 
         /* go through the connections... */
         for (int iconn = 0; iconn < (int)conn_vector.size(); ++iconn) {
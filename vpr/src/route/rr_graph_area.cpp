@@ -1,4 +1,7 @@
+#include <atomic>
 #include <cmath>
+#include <limits>
+#include <map>
 
 #include "vtr_assert.h"
 #include "vtr_log.h"
@@ -13,6 +16,12 @@
 #include "rr_graph_utils.h"
 #include "rr_graph_area.h"
 
+#ifdef VPR_USE_TBB
+#    include <tbb/combinable.h>
+#    include <tbb/enumerable_thread_specific.h>
+#    include <tbb/parallel_for_each.h>
+#endif
+
 /* Select which transistor area equation to use. As found by Chiasson's and Betz's FPL 2013 paper
  * (Should FPGAs Abandon the Pass Gate?), the traditional transistor area model
  * significantly overpredicts area at smaller process nodes. Their improved area models
@@ -34,7 +43,36 @@ static void count_unidir_routing_transistors(std::vector<t_segment_inf>& segment
                                              const float trans_sram_bit,
                                              bool is_flat);
 
-static float get_cblock_trans(int* num_inputs_to_cblock, int wire_to_ipin_switch, int max_inputs_to_cblock, float trans_sram_bit);
+///@brief Unidirectional routing transistor usage, counted in parallel over the rr nodes
+struct t_unidir_trans_counts {
+    //Number of wires driven through each (switch, fan-in): the area of a combination is only computed once
+    std::map<std::pair<int, int>, size_t> num_muxes;
+
+    //Number of track to connection block buffers
+    size_t num_cblock_bufs = 0;
+
+    //[0..max_inputs_to_cblock]: number of nodes with each number of connection block inputs
+    std::vector<size_t> num_cblocks_with_inputs;
+
+    void combine(const t_unidir_trans_counts& rhs);
+};
+
+///@brief No edge drives the wire
+static constexpr uint64_t NO_MUX_EDGE = std::numeric_limits<uint64_t>::max();
+
+static void count_unidir_wire_fanout(RRNodeId from_rr_node,
+                                     std::vector<std::atomic<uint64_t>>& chan_node_mux_edge,
+                                     std::vector<std::atomic<int>>& num_inputs_to_cblock,
+                                     std::vector<bool>& cblock_counted,
+                                     t_unidir_trans_counts& counts);
+
+static void count_unidir_node_fanin(RRNodeId to_rr_node,
+                                    const std::vector<std::atomic<uint64_t>>& chan_node_mux_edge,
+                                    const std::vector<std::atomic<int>>& num_inputs_to_cblock,
+                                    t_unidir_trans_counts& counts,
+                                    bool is_flat);
+
+static float get_cblock_trans(const std::vector<size_t>& num_cblocks_with_inputs, int wire_to_ipin_switch, float trans_sram_bit);
 
 static float* alloc_and_load_unsharable_switch_trans(int num_switch,
                                                      float trans_sram_bit,
@@ -291,8 +329,13 @@ void count_bidir_routing_transistors(int num_switch, int wire_to_ipin_switch, fl
 
     /* Now add in the input connection block transistors. */
 
-    input_cblock_trans = get_cblock_trans(num_inputs_to_cblock, wire_to_ipin_switch,
-                                          max_inputs_to_cblock, trans_sram_bit);
+    std::vector<size_t> num_cblocks_with_inputs(max_inputs_to_cblock + 1, 0);
+    for (size_t inode = 0; inode < rr_graph.num_nodes(); inode++) {
+        num_cblocks_with_inputs[num_inputs_to_cblock[inode]]++;
+    }
+
+    input_cblock_trans = get_cblock_trans(num_cblocks_with_inputs, wire_to_ipin_switch,
+                                          trans_sram_bit);
 
     delete[] num_inputs_to_cblock;
 
@@ -317,30 +360,32 @@ void count_unidir_routing_transistors(std::vector<t_segment_inf>& /*segment_inf*
     auto& device_ctx = g_vpr_ctx.device();
     const auto& rr_graph = device_ctx.rr_graph;
 
-    bool* cblock_counted;      /* [0..max(device_ctx.grid.width(),device_ctx.grid.height())] -- 0th element unused. */
-    int* num_inputs_to_cblock; /* [0..device_ctx.rr_nodes.size()-1], but all entries not    */
-
-    /* corresponding to IPINs will be 0.           */
-
-    t_rr_type from_rr_type, to_rr_type;
-    int i, j, iseg, iedge, num_edges, maxlen;
-    int max_inputs_to_cblock;
+    int maxlen;
     float input_cblock_trans;
 
     /* August 2014:
      * In a unidirectional architecture all the fanin to a wire segment comes from
      * a single mux. We should count this mux only once as we look at the outgoing
-     * switches of all rr nodes. Thus we keep track of which muxes we have already
-     * counted via the variable below. */
-    std::vector<bool> chan_node_switch_done(rr_graph.num_nodes(), false);
+     * switches of all rr nodes. Thus we record, for each wire, the first edge
+     * (in node and edge order) driving it, and count its mux with the switch of
+     * that edge, whichever thread sees it first. */
+    std::vector<std::atomic<uint64_t>> chan_node_mux_edge(rr_graph.num_nodes());
+    for (auto& mux_edge : chan_node_mux_edge) {
+        mux_edge.store(NO_MUX_EDGE, std::memory_order_relaxed);
+    }
+
+    /* [0..device_ctx.rr_nodes.size()-1], but all entries not corresponding to IPINs will be 0. */
+    std::vector<std::atomic<int>> num_inputs_to_cblock(rr_graph.num_nodes());
+    for (auto& num_inputs : num_inputs_to_cblock) {
+        num_inputs.store(0, std::memory_order_relaxed);
+    }
 
     /* The variable below is an accumulator variable that will add up all the   *
      * transistors in the routing.  Make double so that it doesn't stop         *
      * incrementing once adding a switch makes a change of less than 1 part in  *
-     * 10^7 to the total.  If this still isn't good enough (adding 1 part in    *
-     * 10^15 will still be thrown away), compute the transistor count in        *
-     * "chunks", by adding up inodes 1 to 1000, 1001 to 2000 and then summing   *
-     * the partial sums together.                                               */
+     * 10^7 to the total.  The nodes themselves are counted (in parallel) in    *
+     * integer counts of muxes and buffers, so the total does not depend on the *
+     * order in which the nodes were counted.                                   */
 
     double ntrans;
 
@@ -349,8 +394,6 @@ void count_unidir_routing_transistors(std::vector<t_segment_inf>& /*segment_inf*
 
     float trans_track_to_cblock_buf;
 
-    max_inputs_to_cblock = 0;
-
     /* Assume the buffer below is 4x minimum drive strength (enough to        *
      * drive a fanout of up to 16 pretty nicely) -- should cover a reasonable *
      * wiring C plus the fanout.                                              */
@@ -362,173 +405,243 @@ void count_unidir_routing_transistors(std::vector<t_segment_inf>& /*segment_inf*
         trans_track_to_cblock_buf = 0;
     }
 
-    num_inputs_to_cblock = new int[rr_graph.num_nodes()];
-    for (size_t c = 0; c < rr_graph.num_nodes(); c++)
-        num_inputs_to_cblock[c] = 0;
-
     maxlen = std::max(device_ctx.grid.width(), device_ctx.grid.height());
-    cblock_counted = new bool[maxlen];
-    for (auto k = 0; k < maxlen; k++)
-        cblock_counted[k] = 0;
 
-    ntrans = 0;
-    for (const RRNodeId& from_rr_node : device_ctx.rr_graph.nodes()) {
-        size_t from_node = size_t(from_rr_node);
-        from_rr_type = rr_graph.node_type(from_rr_node);
+    /* First pass, over the driving wires: find the first edge driving each wire, *
+     * and count the connection block inputs and buffers.                         *
+     * Second pass, over the driven nodes: count the wire muxes by (switch,       *
+     * fan-in), and the connection blocks by number of inputs.                    */
+    t_unidir_trans_counts counts;
+#ifdef VPR_USE_TBB
+    tbb::enumerable_thread_specific<std::vector<bool>> thread_cblock_counted(maxlen, false);
+    tbb::combinable<t_unidir_trans_counts> thread_counts;
+
+    tbb::parallel_for_each(rr_graph.nodes().begin(), rr_graph.nodes().end(), [&](RRNodeId from_rr_node) {
+        count_unidir_wire_fanout(from_rr_node, chan_node_mux_edge, num_inputs_to_cblock,
+                                 thread_cblock_counted.local(), thread_counts.local());
+    });
+    tbb::parallel_for_each(rr_graph.nodes().begin(), rr_graph.nodes().end(), [&](RRNodeId to_rr_node) {
+        count_unidir_node_fanin(to_rr_node, chan_node_mux_edge, num_inputs_to_cblock,
+                                thread_counts.local(), is_flat);
+    });
+
+    thread_counts.combine_each([&](const t_unidir_trans_counts& local_counts) {
+        counts.combine(local_counts);
+    });
+#else
+    std::vector<bool> cblock_counted(maxlen, false);
+
+    for (const RRNodeId& from_rr_node : rr_graph.nodes()) {
+        count_unidir_wire_fanout(from_rr_node, chan_node_mux_edge, num_inputs_to_cblock,
+                                 cblock_counted, counts);
+    }
+    for (const RRNodeId& to_rr_node : rr_graph.nodes()) {
+        count_unidir_node_fanin(to_rr_node, chan_node_mux_edge, num_inputs_to_cblock,
+                                counts, is_flat);
+    }
+#endif
+
+    ntrans = counts.num_cblock_bufs * double(trans_track_to_cblock_buf);
+
+    /* Area of the wire muxes and drivers, computed once per (switch, fan-in) */
+    for (const auto& kv : counts.num_muxes) {
+        int switch_index = kv.first.first;
+        int fan_in = kv.first.second;
+        const auto& rr_switch = rr_graph.rr_switch_inf(RRSwitchId(switch_index));
+
+        if (rr_switch.type() == SwitchType::MUX) {
+            /* Each wire segment begins with a multipexer followed by a driver for unidirectional */
+            /* Each multiplexer contains all the fan-in to that routing node */
+            /* Add up area of multiplexer, and area of buffer */
+            /* The buffer size should already have been auto-sized (if required) when
+             * the rr switches were created from the arch switches */
+            ntrans += kv.second * (double(trans_per_mux(fan_in, trans_sram_bit, rr_switch.mux_trans_size)) + rr_switch.buf_size);
+        } else if (rr_switch.type() == SwitchType::BUFFER) {
+            //This is a non-configurable buffer, so there are no mux transistors,
+            //only the buffer area
+            ntrans += kv.second * double(rr_switch.buf_size);
+        } //Electrical shorts contribute no transisitor area
+    }
 
-        switch (from_rr_type) {
-            case CHANX:
-            case CHANY:
-                num_edges = rr_graph.num_edges(RRNodeId(from_node));
+    /* Now add in the input connection block transistors. */
 
-                /* Increment number of inputs per cblock if IPIN */
-                for (iedge = 0; iedge < num_edges; iedge++) {
-                    RRNodeId to_node = rr_graph.edge_sink_node(RRNodeId(from_node), iedge);
-                    to_rr_type = rr_graph.node_type(to_node);
+    input_cblock_trans = get_cblock_trans(counts.num_cblocks_with_inputs, wire_to_ipin_switch,
+                                          trans_sram_bit);
 
-                    /* Ignore any uninitialized rr_graph nodes */
-                    if (!rr_graph.node_is_initialized(to_node)) {
-                        continue;
-                    }
+    ntrans += input_cblock_trans;
 
-                    switch (to_rr_type) {
-                        case CHANX:
-                        case CHANY:
-                            if (!chan_node_switch_done[size_t(to_node)]) {
-                                int switch_index = rr_graph.edge_switch(RRNodeId(from_node), iedge);
-                                auto switch_type = rr_graph.rr_switch_inf(RRSwitchId(switch_index)).type();
-
-                                int fan_in = rr_graph.node_fan_in(to_node);
-
-                                if (rr_graph.rr_switch_inf(RRSwitchId(switch_index)).type() == SwitchType::MUX) {
-                                    /* Each wire segment begins with a multipexer followed by a driver for unidirectional */
-                                    /* Each multiplexer contains all the fan-in to that routing node */
-                                    /* Add up area of multiplexer */
-                                    ntrans += trans_per_mux(fan_in, trans_sram_bit,
-                                                            rr_graph.rr_switch_inf(RRSwitchId(switch_index)).mux_trans_size);
-
-                                    /* Add up area of buffer */
-                                    /* The buffer size should already have been auto-sized (if required) when
-                                     * the rr switches were created from the arch switches */
-                                    ntrans += rr_graph.rr_switch_inf(RRSwitchId(switch_index)).buf_size;
-                                } else if (switch_type == SwitchType::SHORT) {
-                                    ntrans += 0.; //Electrical shorts contribute no transisitor area
-                                } else if (switch_type == SwitchType::BUFFER) {
-                                    if (fan_in != 1) {
-                                        std::string msg = vtr::string_fmt(
-                                            "Uni-directional RR node driven by non-configurable "
-                                            "BUFFER has fan in %d (expected 1)\n",
-                                            fan_in);
-                                        msg += "  " + describe_rr_node(rr_graph, device_ctx.grid, device_ctx.rr_indexed_data, to_node, is_flat);
-                                        VPR_FATAL_ERROR(VPR_ERROR_OTHER, msg.c_str());
-                                    }
-
-                                    //This is a non-configurable buffer, so there are no mux transistors,
-                                    //only the buffer area
-                                    ntrans += rr_graph.rr_switch_inf(RRSwitchId(switch_index)).buf_size;
-                                } else {
-                                    VPR_FATAL_ERROR(VPR_ERROR_OTHER, "Unexpected switch type %d while calculating area of uni-directional routing", switch_type);
-                                }
-                                chan_node_switch_done[size_t(to_node)] = true;
-                            }
+    VTR_LOG("\n");
+    VTR_LOG("Routing area (in minimum width transistor areas)...\n");
+    VTR_LOG("\tTotal routing area: %#g, per logic tile: %#g\n", ntrans, ntrans / (float)(device_ctx.grid.get_num_layers() * device_ctx.grid.width() * device_ctx.grid.height()));
+}
 
-                            break;
+void t_unidir_trans_counts::combine(const t_unidir_trans_counts& rhs) {
+    for (const auto& kv : rhs.num_muxes) {
+        num_muxes[kv.first] += kv.second;
+    }
 
-                        case IPIN:
-                            num_inputs_to_cblock[size_t(to_node)]++;
-                            max_inputs_to_cblock = std::max(max_inputs_to_cblock,
-                                                            num_inputs_to_cblock[size_t(to_node)]);
-                            iseg = seg_index_of_cblock(rr_graph, from_rr_type, size_t(to_node));
+    num_cblock_bufs += rhs.num_cblock_bufs;
 
-                            if (cblock_counted[iseg] == false) {
-                                cblock_counted[iseg] = true;
-                                ntrans += trans_track_to_cblock_buf;
-                            }
-                            break;
+    if (num_cblocks_with_inputs.size() < rhs.num_cblocks_with_inputs.size()) {
+        num_cblocks_with_inputs.resize(rhs.num_cblocks_with_inputs.size(), 0);
+    }
+    for (size_t i = 0; i < rhs.num_cblocks_with_inputs.size(); i++) {
+        num_cblocks_with_inputs[i] += rhs.num_cblocks_with_inputs[i];
+    }
+}
 
-                        case SINK:
-                            break; //ignore virtual sinks
+static void count_unidir_wire_fanout(RRNodeId from_rr_node,
+                                     std::vector<std::atomic<uint64_t>>& chan_node_mux_edge,
+                                     std::vector<std::atomic<int>>& num_inputs_to_cblock,
+                                     std::vector<bool>& cblock_counted,
+                                     t_unidir_trans_counts& counts) {
+    /* Records the edges from wire from_rr_node to other wires, and counts the  *
+     * connection block inputs and buffers it drives.                           */
+    const auto& rr_graph = g_vpr_ctx.device().rr_graph;
 
-                        default:
-                            VPR_ERROR(VPR_ERROR_ROUTE,
-                                      "in count_routing_transistors:\n"
-                                      "\tUnexpected connection from node %d (type %d) to node %d (type %d).\n",
-                                      from_node, from_rr_type, size_t(to_node), to_rr_type);
-                            break;
+    size_t from_node = size_t(from_rr_node);
+    t_rr_type from_rr_type = rr_graph.node_type(from_rr_node);
 
-                    } /* End switch on to_rr_type. */
+    if (from_rr_type != CHANX && from_rr_type != CHANY) {
+        return;
+    }
 
-                } /* End for each edge. */
+    int num_edges = rr_graph.num_edges(from_rr_node);
 
-                /* Reset some flags */
-                if (from_rr_type == CHANX) {
-                    for (i = rr_graph.node_xlow(from_rr_node); i <= rr_graph.node_xhigh(from_rr_node); i++)
-                        cblock_counted[i] = false;
+    /* Increment number of inputs per cblock if IPIN */
+    for (int iedge = 0; iedge < num_edges; iedge++) {
+        RRNodeId to_node = rr_graph.edge_sink_node(from_rr_node, iedge);
+        t_rr_type to_rr_type = rr_graph.node_type(to_node);
 
-                } else { /* CHANY */
-                    for (j = rr_graph.node_ylow(from_rr_node); j <= rr_graph.node_yhigh(from_rr_node);
-                         j++)
-                        cblock_counted[j] = false;
+        /* Ignore any uninitialized rr_graph nodes */
+        if (!rr_graph.node_is_initialized(to_node)) {
+            continue;
+        }
+
+        switch (to_rr_type) {
+            case CHANX:
+            case CHANY: {
+                //Keep the lowest (from node, edge) driving to_node
+                uint64_t mux_edge = (uint64_t(from_node) << 32) | uint64_t(iedge);
+                auto& to_mux_edge = chan_node_mux_edge[size_t(to_node)];
+                uint64_t prev_mux_edge = to_mux_edge.load(std::memory_order_relaxed);
+                while (mux_edge < prev_mux_edge
+                       && !to_mux_edge.compare_exchange_weak(prev_mux_edge, mux_edge, std::memory_order_relaxed)) {
                 }
                 break;
-            case OPIN:
+            }
+
+            case IPIN: {
+                num_inputs_to_cblock[size_t(to_node)].fetch_add(1, std::memory_order_relaxed);
+                int iseg = seg_index_of_cblock(rr_graph, from_rr_type, size_t(to_node));
+
+                if (cblock_counted[iseg] == false) {
+                    cblock_counted[iseg] = true;
+                    counts.num_cblock_bufs++;
+                }
                 break;
+            }
+
+            case SINK:
+                break; //ignore virtual sinks
 
             default:
+                VPR_ERROR(VPR_ERROR_ROUTE,
+                          "in count_routing_transistors:\n"
+                          "\tUnexpected connection from node %d (type %d) to node %d (type %d).\n",
+                          from_node, from_rr_type, size_t(to_node), to_rr_type);
                 break;
 
-        } /* End switch on from_rr_type */
-    }     /* End for all nodes */
+        } /* End switch on to_rr_type. */
 
-    /* Now add in the input connection block transistors. */
+    } /* End for each edge. */
 
-    input_cblock_trans = get_cblock_trans(num_inputs_to_cblock, wire_to_ipin_switch,
-                                          max_inputs_to_cblock, trans_sram_bit);
+    /* Reset some flags */
+    if (from_rr_type == CHANX) {
+        for (int i = rr_graph.node_xlow(from_rr_node); i <= rr_graph.node_xhigh(from_rr_node); i++)
+            cblock_counted[i] = false;
 
-    delete[] cblock_counted;
-    delete[] num_inputs_to_cblock;
+    } else { /* CHANY */
+        for (int j = rr_graph.node_ylow(from_rr_node); j <= rr_graph.node_yhigh(from_rr_node); j++)
+            cblock_counted[j] = false;
+    }
+}
 
-    ntrans += input_cblock_trans;
+static void count_unidir_node_fanin(RRNodeId to_rr_node,
+                                    const std::vector<std::atomic<uint64_t>>& chan_node_mux_edge,
+                                    const std::vector<std::atomic<int>>& num_inputs_to_cblock,
+                                    t_unidir_trans_counts& counts,
+                                    bool is_flat) {
+    /* Counts the mux driving wire to_rr_node (with the switch of the first edge *
+     * driving it), and the connection block inputs of to_rr_node.              */
+    const auto& device_ctx = g_vpr_ctx.device();
+    const auto& rr_graph = device_ctx.rr_graph;
 
-    VTR_LOG("\n");
-    VTR_LOG("Routing area (in minimum width transistor areas)...\n");
-    VTR_LOG("\tTotal routing area: %#g, per logic tile: %#g\n", ntrans, ntrans / (float)(device_ctx.grid.get_num_layers() * device_ctx.grid.width() * device_ctx.grid.height()));
+    size_t num_inputs = num_inputs_to_cblock[size_t(to_rr_node)].load(std::memory_order_relaxed);
+    if (num_inputs >= counts.num_cblocks_with_inputs.size()) {
+        counts.num_cblocks_with_inputs.resize(num_inputs + 1, 0);
+    }
+    counts.num_cblocks_with_inputs[num_inputs]++;
+
+    uint64_t mux_edge = chan_node_mux_edge[size_t(to_rr_node)].load(std::memory_order_relaxed);
+    if (mux_edge == NO_MUX_EDGE) {
+        return;
+    }
+
+    RRNodeId from_node = RRNodeId(mux_edge >> 32);
+    int iedge = int(mux_edge & 0xffffffff);
+    int switch_index = rr_graph.edge_switch(from_node, iedge);
+    auto switch_type = rr_graph.rr_switch_inf(RRSwitchId(switch_index)).type();
+
+    int fan_in = rr_graph.node_fan_in(to_rr_node);
+
+    if (switch_type == SwitchType::BUFFER) {
+        if (fan_in != 1) {
+            std::string msg = vtr::string_fmt(
+                "Uni-directional RR node driven by non-configurable "
+                "BUFFER has fan in %d (expected 1)\n",
+                fan_in);
+            msg += "  " + describe_rr_node(rr_graph, device_ctx.grid, device_ctx.rr_indexed_data, to_rr_node, is_flat);
+            VPR_FATAL_ERROR(VPR_ERROR_OTHER, msg.c_str());
+        }
+    } else if (switch_type != SwitchType::MUX && switch_type != SwitchType::SHORT) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER, "Unexpected switch type %d while calculating area of uni-directional routing", switch_type);
+    }
+
+    counts.num_muxes[{switch_index, fan_in}]++;
 }
 
-static float get_cblock_trans(int* num_inputs_to_cblock, int wire_to_ipin_switch, int max_inputs_to_cblock, float trans_sram_bit) {
+static float get_cblock_trans(const std::vector<size_t>& num_cblocks_with_inputs, int wire_to_ipin_switch, float trans_sram_bit) {
     /* Computes the transistors in the input connection block multiplexers and   *
      * the buffers from connection block outputs to the logic block input pins.  *
-     * For speed, I precompute the number of transistors in the multiplexers of  *
-     * interest.                                                                 */
+     * For speed, I compute the number of transistors in each multiplexer size   *
+     * once, and multiply it by the number of connection blocks of that size.    */
 
-    float* trans_per_cblock; /* [0..max_inputs_to_cblock] */
+    float trans_per_cblock;
     float trans_count;
-    int num_inputs;
 
     auto& device_ctx = g_vpr_ctx.device();
     const auto& rr_graph = device_ctx.rr_graph;
-    trans_per_cblock = new float[(max_inputs_to_cblock + 1)];
 
-    trans_per_cblock[0] = 0.; /* i.e., not an IPIN or no inputs */
+    trans_count = 0.;
 
-    /* With one or more inputs, add the mux and output buffer.  I add the output *
-     * buffer even when the number of inputs = 1 (i.e. no mux) because I assume  *
-     * I need the drivability just for metal capacitance.                        */
+    /* Zero inputs means not an IPIN or no inputs.  With one or more inputs, add *
+     * the mux and output buffer.  I add the output buffer even when the number  *
+     * of inputs = 1 (i.e. no mux) because I assume I need the drivability just  *
+     * for metal capacitance.                                                    */
 
-    for (int i = 1; i <= max_inputs_to_cblock; i++) {
-        trans_per_cblock[i] = trans_per_mux(i, trans_sram_bit,
-                                            rr_graph.rr_switch_inf(RRSwitchId(wire_to_ipin_switch)).mux_trans_size);
-        trans_per_cblock[i] += rr_graph.rr_switch_inf(RRSwitchId(wire_to_ipin_switch)).buf_size;
-    }
+    for (size_t num_inputs = 1; num_inputs < num_cblocks_with_inputs.size(); num_inputs++) {
+        if (num_cblocks_with_inputs[num_inputs] == 0) {
+            continue;
+        }
 
-    trans_count = 0.;
+        trans_per_cblock = trans_per_mux(num_inputs, trans_sram_bit,
+                                         rr_graph.rr_switch_inf(RRSwitchId(wire_to_ipin_switch)).mux_trans_size);
+        trans_per_cblock += rr_graph.rr_switch_inf(RRSwitchId(wire_to_ipin_switch)).buf_size;
 
-    for (const RRNodeId& rr_id : device_ctx.rr_graph.nodes()) {
-        num_inputs = num_inputs_to_cblock[(size_t)rr_id];
-        trans_count += trans_per_cblock[num_inputs];
+        trans_count += num_cblocks_with_inputs[num_inputs] * trans_per_cblock;
     }
 
-    delete[] trans_per_cblock;
     return (trans_count);
 }
 
@@ -0,0 +1,29 @@
+#include "rr_reverse_edges.h"
+
+RRReverseEdges::RRReverseEdges(const t_rr_graph_view& rr_nodes) {
+    size_t num_nodes = rr_nodes.size();
+
+    //Count the fan-in of each node (offset by one, so the prefix sum gives the first edges)
+    first_in_edge_.assign(num_nodes + 1, 0);
+    for (size_t inode = 0; inode < num_nodes; ++inode) {
+        for (RREdgeId edge : rr_nodes.edge_range(RRNodeId(inode))) {
+            ++first_in_edge_[size_t(rr_nodes.edge_sink_node(edge)) + 1];
+        }
+    }
+    for (size_t inode = 0; inode < num_nodes; ++inode) {
+        first_in_edge_[inode + 1] += first_in_edge_[inode];
+    }
+
+    in_edges_.resize(first_in_edge_[num_nodes]);
+    in_nodes_.resize(first_in_edge_[num_nodes]);
+
+    std::vector<size_t> next_in_edge(first_in_edge_.begin(), first_in_edge_.end() - 1);
+    for (size_t inode = 0; inode < num_nodes; ++inode) {
+        for (RREdgeId edge : rr_nodes.edge_range(RRNodeId(inode))) {
+            size_t& next = next_in_edge[size_t(rr_nodes.edge_sink_node(edge))];
+            in_edges_[next] = edge;
+            in_nodes_[next] = RRNodeId(inode);
+            ++next;
+        }
+    }
+}
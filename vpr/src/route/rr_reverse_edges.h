@@ -0,0 +1,41 @@
+#ifndef RR_REVERSE_EDGES_H
+#define RR_REVERSE_EDGES_H
+
+#include <vector>
+
+#include "rr_graph_storage.h"
+#include "vtr_array_view.h"
+
+/**
+ * @brief The fan-in (reverse) adjacency of an RR graph.
+ *
+ * t_rr_graph_storage only stores the edges leaving each node. This records,
+ * for every node, the edges driving it (and the nodes they come from) in a
+ * compressed (CSR) layout, so searches can also expand backward from a sink.
+ *
+ * The edge ids are those of the RR graph the adjacency was built from; it must
+ * be rebuilt if that RR graph changes.
+ */
+class RRReverseEdges {
+  public:
+    explicit RRReverseEdges(const t_rr_graph_view& rr_nodes);
+
+    ///@brief Returns the edges driving node
+    vtr::array_view<const RREdgeId> in_edges(RRNodeId node) const {
+        return vtr::array_view<const RREdgeId>(in_edges_.data() + first_in_edge_[size_t(node)],
+                                               first_in_edge_[size_t(node) + 1] - first_in_edge_[size_t(node)]);
+    }
+
+    ///@brief Returns the nodes driving node, in the same order as in_edges()
+    vtr::array_view<const RRNodeId> in_nodes(RRNodeId node) const {
+        return vtr::array_view<const RRNodeId>(in_nodes_.data() + first_in_edge_[size_t(node)],
+                                               first_in_edge_[size_t(node) + 1] - first_in_edge_[size_t(node)]);
+    }
+
+  private:
+    std::vector<size_t> first_in_edge_; ///<Index of the first in edge of each node; one extra trailing entry
+    std::vector<RREdgeId> in_edges_;
+    std::vector<RRNodeId> in_nodes_;
+};
+
+#endif /* RR_REVERSE_EDGES_H */
@@ -6,7 +6,10 @@
  * The rest of the routing is delegated to child tasks using \ref VirtualNets.
  * They will work with a strictly limited bounding box, so it's necessary
  * that the initial routing provides enough hints while routing to as
- * few sinks as possible. */
+ * few sinks as possible.
+ *
+ * Also holds the spatial sink batching used to order the sinks of high
+ * fanout nets (\see sink_sampling::batch_sinks_by_bin). */
 
 #include <cmath>
 #include <limits>
@@ -15,6 +18,7 @@
 #include "partition_tree.h"
 #include "route_common.h"
 #include "router_lookahead_sampling.h"
+#include "spatial_route_tree_lookup.h"
 
 /** Sink container for geometry operations */
 struct SinkPoint {
@@ -162,3 +166,42 @@ inline void convex_hull_downsample(ParentNetId net_id, const t_bb& net_bb, vtr::
         out.set(point.isink, true);
     }
 }
+
+namespace sink_sampling {
+
+/** Reorder the sinks (pin indices) in [first, last) of a high fanout net into spatial batches:
+ * sinks in the same bin of \p spatial_lookup end up next to each other, and the bins are visited
+ * row by row in alternating direction, so that consecutive batches are neighbours. The relative
+ * order of the sinks of a bin (e.g. decreasing criticality) is kept.
+ *
+ * Routed in this order, each sink finds the routing to the previous ones in or next to its own bin,
+ * so ConnectionRouter::add_high_fanout_route_tree_to_heap() seeds the search from a few nearby
+ * route tree nodes and the search stays small. */
+template<typename SinkIt>
+inline void batch_sinks_by_bin(ParentNetId net_id, const SpatialRouteTreeLookup& spatial_lookup, SinkIt first, SinkIt last) {
+    const auto& route_ctx = g_vpr_ctx.routing();
+    const auto& rr_graph = g_vpr_ctx.device().rr_graph;
+
+    size_t bins_x = spatial_lookup.dim_size(0);
+
+    /* (batch, sink) pairs, to find each sink's bin only once */
+    std::vector<std::pair<size_t, typename std::iterator_traits<SinkIt>::value_type>> batched_sinks;
+    for (SinkIt it = first; it != last; ++it) {
+        RRNodeId rr_sink = route_ctx.net_rr_terminals[net_id][*it];
+        size_t bin_x = grid_to_bin_x(rr_graph.node_xlow(rr_sink), spatial_lookup);
+        size_t bin_y = grid_to_bin_y(rr_graph.node_ylow(rr_sink), spatial_lookup);
+        /* Odd rows are visited right to left */
+        size_t batch = bin_y * bins_x + ((bin_y % 2) ? bins_x - 1 - bin_x : bin_x);
+        batched_sinks.emplace_back(batch, *it);
+    }
+
+    std::stable_sort(batched_sinks.begin(), batched_sinks.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+
+    for (const auto& [batch, sink] : batched_sinks) {
+        *first++ = sink;
+    }
+}
+
+} // namespace sink_sampling
@@ -8,7 +8,9 @@ namespace comm {
 enum class CMD : int {
     NONE=-1,
     GET_PATH_LIST_ID=0,
-    DRAW_PATH_ID=1
+    DRAW_PATH_ID=1,
+    RUN_JOB_ID=2,
+    STOP_DAEMON_ID=3
 };
 
 } // namespace comm
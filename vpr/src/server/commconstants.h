@@ -24,6 +24,8 @@ inline const std::string OPTION_IS_FLAT_ROUTING{"is_flat_routing"};
 inline const std::string OPTION_PATH_ELEMENTS{"path_elements"};
 inline const std::string OPTION_HIGHLIGHT_MODE{"high_light_mode"};
 inline const std::string OPTION_DRAW_PATH_CONTOUR{"draw_path_contour"};
+inline const std::string OPTION_IS_DELTA_RESPONSE{"is_delta_response"};
+inline const std::string OPTION_VPR_ARGS{"vpr_args"};
 
 inline const std::string KEY_SETUP_PATH_LIST{"setup"};
 inline const std::string KEY_HOLD_PATH_LIST{"hold"};
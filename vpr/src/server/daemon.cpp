@@ -0,0 +1,180 @@
+#ifndef NO_SERVER
+
+#include "daemon.h"
+
+#include "commconstants.h"
+#include "gateio.h"
+#include "globals.h"
+#include "telegramoptions.h"
+#include "vpr_api.h"
+#include "vpr_error.h"
+#include "rr_graph.h"
+
+#include "tatum/error.hpp"
+#include "vpr_tatum_error.h"
+#include "vtr_error.h"
+#include "vtr_log.h"
+#include "vtr_util.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <tuple>
+
+namespace server {
+
+/**
+ * @brief The options a routing resource graph is built with (besides the channel width, which create_rr_graph() checks)
+ *
+ * An rr graph is only reused by the next job if both were built from the same key. Only fixed size devices are reused,
+ * as the size of an auto-sized device depends on the design.
+ */
+static auto rr_graph_key(const t_vpr_setup& vpr_setup) {
+    return std::make_tuple(vpr_setup.device_layout,
+                           vpr_setup.clock_modeling,
+                           vpr_setup.RouterOpts.route_type,
+                           vpr_setup.RouterOpts.base_cost_type,
+                           vpr_setup.RouterOpts.custom_3d_sb_fanin_fanout,
+                           vpr_setup.RouterOpts.read_rr_edge_metadata,
+                           vpr_setup.RouterOpts.reorder_rr_graph_nodes_algorithm,
+                           vpr_setup.RouterOpts.reorder_rr_graph_nodes_threshold,
+                           vpr_setup.RouterOpts.reorder_rr_graph_nodes_seed,
+                           vpr_setup.RoutingArch.read_rr_graph_filename);
+}
+
+/**
+ * @brief Task results are embedded in the JSON response as is, so drop the characters which would break it
+ */
+static std::string to_response_string(std::string msg) {
+    std::replace(msg.begin(), msg.end(), '"', '\'');
+    std::replace(msg.begin(), msg.end(), '\n', ' ');
+    return msg;
+}
+
+/**
+ * @brief Implements the design of a RUN_JOB task
+ *
+ * @return The status of the job, or throws the error it failed with
+ */
+static std::string run_job(const Task& task, const t_options& daemon_options, t_vpr_setup& vpr_setup, t_arch& arch) {
+    TelegramOptions telegram_options{task.options(), {comm::OPTION_VPR_ARGS}};
+    if (telegram_options.has_errors()) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER, "%s\n", telegram_options.errors_str().c_str());
+    }
+
+    //The job's command line, with the daemon's architecture
+    std::vector<std::string> args = vtr::split(telegram_options.get_string(comm::OPTION_VPR_ARGS));
+    std::vector<const char*> argv{"vpr", daemon_options.ArchFile.value().c_str()};
+    for (const std::string& arg : args) {
+        argv.push_back(arg.c_str());
+    }
+
+    t_options job_options = read_options_throw(argv.size(), argv.data());
+
+    if (job_options.arch_format.value() != daemon_options.arch_format.value()) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER, "Jobs use the architecture format of the daemon\n");
+    }
+    if (job_options.is_server_mode_enabled.value() || job_options.is_daemon_mode_enabled.value() || job_options.show_graphics.value()) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER, "Jobs can not enable the server, daemon or graphics (--server, --daemon, --disp)\n");
+    }
+    if (job_options.flat_routing.value()) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER, "Jobs can not use flat routing (--flat_routing)\n");
+    }
+    if (job_options.do_power.value() != daemon_options.do_power.value()) {
+        //The pb graphs (which the daemon keeps) hold the power structures
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER, "Jobs use the power analysis setting of the daemon (--power)\n");
+    }
+
+    auto last_rr_graph_key = rr_graph_key(vpr_setup);
+
+    vpr_free_design(vpr_setup);
+    vpr_setup = t_vpr_setup();
+
+    VTR_LOG("\n");
+    VTR_LOG("Running daemon job %d:", task.job_id());
+    for (const char* arg : argv) {
+        VTR_LOG(" %s", arg);
+    }
+    VTR_LOG("\n");
+
+    vpr_init_with_options(&job_options, &vpr_setup, &arch, false);
+
+    if (vpr_setup.device_layout != "auto" && rr_graph_key(vpr_setup) == last_rr_graph_key) {
+        vpr_setup.reuse_rr_graph = true;
+    } else {
+        free_rr_graph();
+    }
+
+    bool flow_succeeded = vpr_flow(vpr_setup, arch);
+
+    return flow_succeeded ? "succeeded" : "unimplementable";
+}
+
+void run_daemon(const t_options& daemon_options, t_vpr_setup& vpr_setup, t_arch& arch) {
+    GateIO& gate_io = g_vpr_ctx.mutable_server().gate_io;
+
+    std::mutex tasks_mutex;
+    std::condition_variable tasks_received;
+    bool has_received_tasks = false;
+
+    gate_io.start(vpr_setup.ServerOpts.port_num, [&]() {
+        {
+            std::lock_guard<std::mutex> lock(tasks_mutex);
+            has_received_tasks = true;
+        }
+        tasks_received.notify_one();
+    });
+
+    VTR_LOG("VPR daemon waiting for jobs on port %d\n", vpr_setup.ServerOpts.port_num);
+
+    bool is_stopped = false;
+    std::vector<TaskPtr> tasks;
+    while (!is_stopped && gate_io.is_running()) {
+        {
+            //The timeout lets the logs of the IO thread be printed while no tasks arrive
+            std::unique_lock<std::mutex> lock(tasks_mutex);
+            tasks_received.wait_for(lock, std::chrono::seconds(1), [&]() { return has_received_tasks; });
+            has_received_tasks = false;
+        }
+
+        gate_io.take_received_tasks(tasks);
+        for (TaskPtr& task : tasks) {
+            if (is_stopped) {
+                task->set_fail("the daemon was stopped");
+            } else if (task->cmd() == comm::CMD::STOP_DAEMON_ID) {
+                is_stopped = true;
+                task->set_success();
+            } else if (task->cmd() == comm::CMD::RUN_JOB_ID) {
+                try {
+                    task->set_success(run_job(*task, daemon_options, vpr_setup, arch));
+                } catch (const tatum::Error& tatum_error) {
+                    VTR_LOG_ERROR("%s\n", format_tatum_error(tatum_error).c_str());
+                    task->set_fail(to_response_string(format_tatum_error(tatum_error)));
+                } catch (const VprError& vpr_error) {
+                    vpr_print_error(vpr_error);
+                    task->set_fail(to_response_string(vpr_error.what()));
+                } catch (const vtr::VtrError& vtr_error) {
+                    VTR_LOG_ERROR("%s:%d %s\n", vtr_error.filename_c_str(), vtr_error.line(), vtr_error.what());
+                    task->set_fail(to_response_string(vtr_error.what()));
+                }
+            } else {
+                task->set_fail("the command is not supported by the daemon");
+            }
+        }
+
+        gate_io.move_tasks_to_send_queue(tasks);
+        gate_io.print_logs();
+    }
+
+    //Give the IO thread time to send the last responses (e.g. of STOP_DAEMON)
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    gate_io.stop();
+    gate_io.print_logs();
+
+    VTR_LOG("VPR daemon stopped\n");
+}
+
+} // namespace server
+
+#endif /* NO_SERVER */
@@ -0,0 +1,36 @@
+#ifndef DAEMON_H
+#define DAEMON_H
+
+#ifndef NO_SERVER
+
+#include "read_options.h"
+#include "vpr_types.h"
+
+namespace server {
+
+/**
+ * @brief Serves batch jobs on the server port until a STOP_DAEMON request is received.
+ *
+ * Each RUN_JOB request implements a design, as a VPR run with the command line of its 'vpr_args' option
+ * (the circuit and the options, without the architecture, which is the daemon's) would. Between jobs only the per-design
+ * state is reset (see @ref vpr_free_design): the architecture is not read again, and the device grid, the
+ * routing resource graph and the router lookahead are kept as long as the jobs that follow use the same
+ * device (a fixed --device, and the same routing resource graph options), so a job only pays for them once.
+ *
+ * Jobs run one at a time in the calling thread, in the order they are received: VPR keeps its state in the
+ * global context, so two designs can not be implemented concurrently in one process. Several daemons (on
+ * different ports) run jobs concurrently, and share the router lookahead through --timing_model_cache_dir.
+ *
+ * The response of a job is "succeeded" or "unimplementable", or the error it failed with.
+ *
+ * @param daemon_options The options VPR was launched with (which name the architecture of every job).
+ * @param vpr_setup The setup of the design implemented last, replaced by the setup of each job.
+ * @param arch The architecture, read when VPR was launched.
+ */
+void run_daemon(const t_options& daemon_options, t_vpr_setup& vpr_setup, t_arch& arch);
+
+} // namespace server
+
+#endif /* NO_SERVER */
+
+#endif /* DAEMON_H */
@@ -6,6 +6,12 @@
 #include "commconstants.h"
 #include "convertutils.h"
 
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
 namespace server {
 
 GateIO::GateIO() {
@@ -16,10 +22,18 @@ GateIO::~GateIO() {
     stop();
 }
 
-void GateIO::start(int port_num) {
+void GateIO::start(int port_num, const std::function<void()>& on_tasks_received) {
     if (!m_is_running.load()) {
         m_port_num = port_num;
+        m_on_tasks_received = on_tasks_received;
         VTR_LOG("starting server");
+        if (pipe(m_wakeup_pipe) == 0) {
+            fcntl(m_wakeup_pipe[0], F_SETFL, O_NONBLOCK);
+            fcntl(m_wakeup_pipe[1], F_SETFL, O_NONBLOCK);
+        } else {
+            VTR_LOG_ERROR("fail to create the server wake-up pipe\n");
+            m_wakeup_pipe[0] = m_wakeup_pipe[1] = -1;
+        }
         m_is_running.store(true);
         m_thread = std::thread(&GateIO::start_listening, this);
     }
@@ -28,110 +42,135 @@ void GateIO::start(int port_num) {
 void GateIO::stop() {
     if (m_is_running.load()) {
         m_is_running.store(false);
+        wake_up();
         if (m_thread.joinable()) {
             m_thread.join();
         }
+        for (int& fd: m_wakeup_pipe) {
+            if (fd != -1) {
+                close(fd);
+                fd = -1;
+            }
+        }
+    }
+}
+
+void GateIO::wake_up() {
+    if (m_wakeup_pipe[1] != -1) {
+        // a full pipe already guarantees a pending wake-up, so a failed write can be ignored
+        const char byte = 0;
+        [[maybe_unused]] ssize_t written = write(m_wakeup_pipe[1], &byte, 1);
     }
 }
 
 void GateIO::take_received_tasks(std::vector<TaskPtr>& tasks) {
-    std::unique_lock<std::mutex> lock(m_tasks_mutex);
-    for (TaskPtr& task: m_received_tasks) {
-        m_logger.queue(LogLevel::Debug, "move task id=", task->job_id(), "for processing");
-        tasks.push_back(std::move(task));
+    std::size_t first = tasks.size();
+    m_received_tasks.take_all(tasks);
+    for (std::size_t i = first; i < tasks.size(); i++) {
+        m_logger.queue(LogLevel::Debug, "move task id=", tasks[i]->job_id(), "for processing");
     }
-    m_received_tasks.clear();
 }
 
 void GateIO::move_tasks_to_send_queue(std::vector<TaskPtr>& tasks) {
-    std::unique_lock<std::mutex> lock(m_tasks_mutex);
     for (TaskPtr& task: tasks) {
         m_logger.queue(LogLevel::Debug, "move task id=", task->job_id(), "finished", (task->has_error() ? "with error" : "successfully"), task->error(), "to send queue");
-        m_send_tasks.push_back(std::move(task));
+        m_send_tasks.push(std::move(task));
+    }
+    if (!tasks.empty()) {
+        wake_up();
     }
     tasks.clear();
 }
 
-GateIO::ActivityStatus GateIO::check_client_connection(sockpp::tcp6_acceptor& tcp_server, std::optional<sockpp::tcp6_socket>& client_opt) {
-    ActivityStatus status = ActivityStatus::WAITING_ACTIVITY;
+void GateIO::accept_clients(sockpp::tcp6_acceptor& tcp_server, std::vector<ClientPtr>& clients, int& next_client_id) {
+    // the acceptor is non-blocking: accept all the pending connections
+    while (true) {
+        sockpp::inet6_address peer;
+        sockpp::tcp6_socket socket = tcp_server.accept(&peer);
+        if (!socket) {
+            break;
+        }
 
-    sockpp::inet6_address peer;
-    sockpp::tcp6_socket client = tcp_server.accept(&peer);
-    if (client) {
-        m_logger.queue(LogLevel::Info, "client", client.address().to_string() , "connection accepted");
-        client.set_non_blocking(true);
-        client_opt = std::move(client);
+        m_logger.queue(LogLevel::Info, "client", socket.address().to_string(), "connection accepted, id=", next_client_id);
+        socket.set_non_blocking(true);
 
-        status = ActivityStatus::CLIENT_ACTIVITY;
+        ClientPtr client = std::make_unique<Client>();
+        client->id = next_client_id++;
+        client->socket = std::move(socket);
+#ifdef ENABLE_CLIENT_ALIVE_TRACKER
+        client->alive_tracker_ptr = std::make_unique<ClientAliveTracker>(std::chrono::milliseconds{5000}, std::chrono::milliseconds{20000});
+#endif
+        clients.push_back(std::move(client));
     }
+}
 
-    return status;
+void GateIO::dispatch_send_tasks(std::vector<ClientPtr>& clients) {
+    std::vector<TaskPtr> tasks;
+    m_send_tasks.take_all(tasks);
+    for (TaskPtr& task: tasks) {
+        auto it = std::find_if(clients.begin(), clients.end(), [&task](const ClientPtr& client) { return client->id == task->client_id(); });
+        if (it != clients.end()) {
+            (*it)->send_tasks.push_back(std::move(task));
+        } else {
+            m_logger.queue(LogLevel::Detail, "drop response to task id=", task->job_id(), "since its client id=", task->client_id(), "is disconnected");
+        }
+    }
 }
 
-GateIO::ActivityStatus GateIO::handle_sending_data(sockpp::tcp6_socket& client) {
+GateIO::ActivityStatus GateIO::handle_sending_data(Client& client) {
     ActivityStatus status = ActivityStatus::WAITING_ACTIVITY;
-    std::unique_lock<std::mutex> lock(m_tasks_mutex);
-
-    if (!m_send_tasks.empty()) {
-        const TaskPtr& task = m_send_tasks.at(0);
-        try {
-            std::size_t bytes_to_send = std::min(CHUNK_MAX_BYTES_NUM, task->response_buffer().size());
-            std::size_t bytes_sent = client.write_n(task->response_buffer().data(), bytes_to_send);
-            if (bytes_sent <= task->orig_reponse_bytes_num()) {
-                task->chop_num_sent_bytes_from_response_buffer(bytes_sent);
-                m_logger.queue(LogLevel::Detail,
-                            "sent chunk:", get_pretty_size_str_from_bytes_num(bytes_sent),
-                            "from", get_pretty_size_str_from_bytes_num(task->orig_reponse_bytes_num()),
-                            "left:", get_pretty_size_str_from_bytes_num(task->response_buffer().size()));
-                status = ActivityStatus::CLIENT_ACTIVITY;
-            }
-        } catch(...) {
+
+    if (!client.send_tasks.empty()) {
+        const TaskPtr& task = client.send_tasks.at(0);
+        std::size_t bytes_to_send = std::min(CHUNK_MAX_BYTES_NUM, task->response_buffer().size());
+        ssize_t bytes_sent = client.socket.write(task->response_buffer().data(), bytes_to_send);
+        if (bytes_sent > 0) {
+            task->chop_num_sent_bytes_from_response_buffer(bytes_sent);
+            m_logger.queue(LogLevel::Detail,
+                        "sent chunk:", get_pretty_size_str_from_bytes_num(bytes_sent),
+                        "from", get_pretty_size_str_from_bytes_num(task->orig_reponse_bytes_num()),
+                        "left:", get_pretty_size_str_from_bytes_num(task->response_buffer().size()));
+            status = ActivityStatus::CLIENT_ACTIVITY;
+        } else if (bytes_sent < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
             m_logger.queue(LogLevel::Detail, "error while writing chunk");
             status = ActivityStatus::COMMUNICATION_PROBLEM;
         }
 
         if (task->is_response_fully_sent()) {
             m_logger.queue(LogLevel::Info, "sent:", task->telegram_header().info(), task->info());
+            client.send_tasks.erase(client.send_tasks.begin());
+            if (!client.send_tasks.empty()) {
+                m_logger.queue(LogLevel::Detail, "left tasks num to send ", client.send_tasks.size());
+            }
         }
     }
 
-    // remove reported tasks
-    std::size_t tasks_num_before_removing = m_send_tasks.size();
-
-    auto partition_iter = std::partition(m_send_tasks.begin(), m_send_tasks.end(),
-                                        [](const TaskPtr& task) { return !task->is_response_fully_sent(); });
-    m_send_tasks.erase(partition_iter, m_send_tasks.end());
-    bool is_removing_took_place = tasks_num_before_removing != m_send_tasks.size();
-    if (!m_send_tasks.empty() && is_removing_took_place) {
-        m_logger.queue(LogLevel::Detail, "left tasks num to send ", m_send_tasks.size());
-    }
-
     return status;
 }
 
-GateIO::ActivityStatus GateIO::handle_receiving_data(sockpp::tcp6_socket& client, comm::TelegramBuffer& telegram_buff, std::string& received_message) {
+GateIO::ActivityStatus GateIO::handle_receiving_data(Client& client, std::string& received_message) {
     ActivityStatus status = ActivityStatus::WAITING_ACTIVITY;
-    std::size_t bytes_actually_received{0};
-    try {
-        bytes_actually_received = client.read_n(&received_message[0], CHUNK_MAX_BYTES_NUM);
-    } catch(...) {
-        m_logger.queue(LogLevel::Error, "fail to receiving");
-        status = ActivityStatus::COMMUNICATION_PROBLEM;
-    }
+    ssize_t bytes_actually_received = client.socket.read(&received_message[0], CHUNK_MAX_BYTES_NUM);
 
-    if ((bytes_actually_received > 0) && (bytes_actually_received <= CHUNK_MAX_BYTES_NUM)) {
+    if (bytes_actually_received > 0) {
         m_logger.queue(LogLevel::Detail, "received chunk:", get_pretty_size_str_from_bytes_num(bytes_actually_received));
-        telegram_buff.append(comm::ByteArray{received_message.c_str(), bytes_actually_received});
+        client.telegram_buff.append(comm::ByteArray{received_message.c_str(), static_cast<std::size_t>(bytes_actually_received)});
         status = ActivityStatus::CLIENT_ACTIVITY;
+    } else if (bytes_actually_received == 0) {
+        m_logger.queue(LogLevel::Info, "client id=", client.id, "disconnected");
+        status = ActivityStatus::COMMUNICATION_PROBLEM;
+    } else if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+        m_logger.queue(LogLevel::Error, "fail to receiving");
+        status = ActivityStatus::COMMUNICATION_PROBLEM;
     }
 
     return status;
 }
 
-GateIO::ActivityStatus GateIO::handle_telegrams(std::vector<comm::TelegramFramePtr>& telegram_frames, comm::TelegramBuffer& telegram_buff) {
+GateIO::ActivityStatus GateIO::handle_telegrams(std::vector<comm::TelegramFramePtr>& telegram_frames, Client& client, bool& has_received_tasks) {
     ActivityStatus status = ActivityStatus::WAITING_ACTIVITY;
     telegram_frames.clear();
-    telegram_buff.take_telegram_frames(telegram_frames);
+    client.telegram_buff.take_telegram_frames(telegram_frames);
     for (const comm::TelegramFramePtr& telegram_frame: telegram_frames) {
         // process received data
         std::string message{telegram_frame->body};
@@ -149,10 +188,11 @@ GateIO::ActivityStatus GateIO::handle_telegrams(std::vector<comm::TelegramFrameP
             std::optional<std::string> options_opt = comm::TelegramParser::try_extract_field_options(message);
             if (job_id_opt && cmd_opt && options_opt) {
                 TaskPtr task = std::make_unique<Task>(job_id_opt.value(), static_cast<comm::CMD>(cmd_opt.value()), options_opt.value());
+                task->set_client_id(client.id);
                 const comm::TelegramHeader& header = telegram_frame->header;
                 m_logger.queue(LogLevel::Info, "received:", header.info(), task->info(/*skipDuration*/true));
-                std::unique_lock<std::mutex> lock(m_tasks_mutex);
-                m_received_tasks.push_back(std::move(task));
+                m_received_tasks.push(std::move(task));
+                has_received_tasks = true;
             } else {
                 m_logger.queue(LogLevel::Error, "broken telegram detected, fail extract options from", message);
             }
@@ -162,21 +202,20 @@ GateIO::ActivityStatus GateIO::handle_telegrams(std::vector<comm::TelegramFrameP
     return status;
 }
 
-GateIO::ActivityStatus GateIO::handle_client_alive_tracker(sockpp::tcp6_socket& client, std::unique_ptr<ClientAliveTracker>& client_alive_tracker_ptr) {
+GateIO::ActivityStatus GateIO::handle_client_alive_tracker(Client& client) {
     ActivityStatus status = ActivityStatus::WAITING_ACTIVITY;
+    std::unique_ptr<ClientAliveTracker>& client_alive_tracker_ptr = client.alive_tracker_ptr; // shortcut
     if (client_alive_tracker_ptr) {
         /// handle sending echo to client
         if (client_alive_tracker_ptr->is_time_to_sent_echo()) {
             comm::TelegramHeader echo_header = comm::TelegramHeader::construct_from_body(comm::ECHO_TELEGRAM_BODY);
             std::string message{echo_header.buffer()};
             message.append(comm::ECHO_TELEGRAM_BODY);
-            try {
-                std::size_t bytes_sent = client.write(message);
-                if (bytes_sent == message.size()) {
-                    m_logger.queue(LogLevel::Detail, "sent", comm::ECHO_TELEGRAM_BODY);
-                    client_alive_tracker_ptr->on_echo_sent();
-                }
-            } catch(...) {
+            ssize_t bytes_sent = client.socket.write(message);
+            if (bytes_sent == static_cast<ssize_t>(message.size())) {
+                m_logger.queue(LogLevel::Detail, "sent", comm::ECHO_TELEGRAM_BODY);
+                client_alive_tracker_ptr->on_echo_sent();
+            } else {
                 m_logger.queue(LogLevel::Debug, "fail to sent", comm::ECHO_TELEGRAM_BODY);
                 status = ActivityStatus::COMMUNICATION_PROBLEM;
             }
@@ -192,10 +231,10 @@ GateIO::ActivityStatus GateIO::handle_client_alive_tracker(sockpp::tcp6_socket&
     return status;
 }
 
-void GateIO::handle_activity_status(ActivityStatus status, std::unique_ptr<ClientAliveTracker>& client_alive_tracker_ptr, bool& is_communication_problem_detected) {
+void GateIO::handle_activity_status(ActivityStatus status, Client& client, bool& is_communication_problem_detected) {
     if (status == ActivityStatus::CLIENT_ACTIVITY) {
-        if (client_alive_tracker_ptr) {
-            client_alive_tracker_ptr->on_client_activity();
+        if (client.alive_tracker_ptr) {
+            client.alive_tracker_ptr->on_client_activity();
         }
     } else if (status == ActivityStatus::COMMUNICATION_PROBLEM) {
         is_communication_problem_detected = true;
@@ -203,14 +242,6 @@ void GateIO::handle_activity_status(ActivityStatus status, std::unique_ptr<Clien
 }
 
 void GateIO::start_listening() {
-#ifdef ENABLE_CLIENT_ALIVE_TRACKER
-    std::unique_ptr<ClientAliveTracker> client_alive_tracker_ptr =
-         std::make_unique<ClientAliveTracker>(std::chrono::milliseconds{5000}, std::chrono::milliseconds{20000});
-#else
-    std::unique_ptr<ClientAliveTracker> client_alive_tracker_ptr;
-#endif
-
-    comm::TelegramBuffer telegram_buff;
     std::vector<comm::TelegramFramePtr> telegram_frames;
 
     sockpp::initialize();
@@ -223,61 +254,103 @@ void GateIO::start_listening() {
         m_logger.queue(LogLevel::Info, "fail to open server, port=", m_port_num);
     }
 
-    std::optional<sockpp::tcp6_socket> client_opt;
+    std::vector<ClientPtr> clients;
+    int next_client_id = 0;
 
     std::string received_message;
     received_message.resize(CHUNK_MAX_BYTES_NUM);
 
+    // poll_fds[0] is the wake-up pipe, poll_fds[1] the acceptor, followed by the clients in order
+    const std::size_t CLIENTS_POLL_FD_OFFSET = 2;
+    std::vector<pollfd> poll_fds;
+
     /// comm event loop
     while(m_is_running.load()) {
-        bool is_communication_problem_detected = false;
+        dispatch_send_tasks(clients);
+
+        poll_fds.clear();
+        poll_fds.push_back({m_wakeup_pipe[0], POLLIN, 0});
+        poll_fds.push_back({tcp_server ? tcp_server.handle() : -1, POLLIN, 0});
+        bool has_alive_trackers = false;
+        for (const ClientPtr& client: clients) {
+            short events = POLLIN;
+            if (!client->send_tasks.empty()) {
+                events |= POLLOUT;
+            }
+            poll_fds.push_back({client->socket.handle(), events, 0});
+            has_alive_trackers |= static_cast<bool>(client->alive_tracker_ptr);
+        }
 
-        if (!client_opt) {
-            ActivityStatus status = check_client_connection(tcp_server, client_opt);
-            if (status == ActivityStatus::CLIENT_ACTIVITY) {
-                if (client_alive_tracker_ptr) {
-                    client_alive_tracker_ptr->reset();
-                }
+        // sleep until some socket is ready or we are woken up (negative fds are ignored by poll)
+        int timeout_ms = has_alive_trackers ? ALIVE_TRACKER_POLL_INTERVAL_MS : -1;
+        if (poll(poll_fds.data(), poll_fds.size(), timeout_ms) < 0 && errno != EINTR) {
+            m_logger.queue(LogLevel::Error, "poll failed, errno=", errno);
+            break;
+        }
+
+        /// drain the wake-up pipe
+        if (poll_fds[0].revents & POLLIN) {
+            char buff[64];
+            while (read(m_wakeup_pipe[0], buff, sizeof(buff)) > 0) {
             }
         }
 
-        if (client_opt) {
-            sockpp::tcp6_socket& client = client_opt.value(); // shortcut
+        bool has_received_tasks = false;
+        std::vector<bool> is_client_disconnected(clients.size(), false);
+        for (std::size_t i = 0; i < clients.size(); i++) {
+            Client& client = *clients[i]; // shortcut
+            short revents = poll_fds[CLIENTS_POLL_FD_OFFSET + i].revents;
+            bool is_communication_problem_detected = false;
 
             /// handle sending
-            ActivityStatus status = handle_sending_data(client);
-            handle_activity_status(status, client_alive_tracker_ptr, is_communication_problem_detected);
+            if (revents & POLLOUT) {
+                ActivityStatus status = handle_sending_data(client);
+                handle_activity_status(status, client, is_communication_problem_detected);
+            }
 
             /// handle receiving
-            status = handle_receiving_data(client, telegram_buff, received_message);
-            handle_activity_status(status, client_alive_tracker_ptr, is_communication_problem_detected);
-
-            /// handle telegrams
-            status = handle_telegrams(telegram_frames, telegram_buff);
-            handle_activity_status(status, client_alive_tracker_ptr, is_communication_problem_detected);
-
-            // forward telegramBuffer errors
-            std::vector<std::string> telegram_buffer_errors;
-            telegram_buff.take_errors(telegram_buffer_errors);
-            for (const std::string& error: telegram_buffer_errors) {
-                m_logger.queue(LogLevel::Info, error);
+            if (revents & (POLLIN | POLLHUP | POLLERR)) {
+                ActivityStatus status = handle_receiving_data(client, received_message);
+                handle_activity_status(status, client, is_communication_problem_detected);
+
+                /// handle telegrams
+                status = handle_telegrams(telegram_frames, client, has_received_tasks);
+                handle_activity_status(status, client, is_communication_problem_detected);
+
+                // forward telegramBuffer errors
+                std::vector<std::string> telegram_buffer_errors;
+                client.telegram_buff.take_errors(telegram_buffer_errors);
+                for (const std::string& error: telegram_buffer_errors) {
+                    m_logger.queue(LogLevel::Info, error);
+                }
             }
 
             /// handle client alive tracker
-            status = handle_client_alive_tracker(client, client_alive_tracker_ptr);
-            handle_activity_status(status, client_alive_tracker_ptr, is_communication_problem_detected);
-
-            /// handle communication problem
-            if (is_communication_problem_detected) {
-                client_opt = std::nullopt;
-                if (!telegram_buff.empty()) {
-                    m_logger.queue(LogLevel::Debug, "clear telegramBuff");
-                    telegram_buff.clear();
-                }
+            ActivityStatus status = handle_client_alive_tracker(client);
+            handle_activity_status(status, client, is_communication_problem_detected);
+
+            is_client_disconnected[i] = is_communication_problem_detected;
+        }
+
+        /// handle communication problems: drop the client along with its pending responses
+        std::size_t num_connected_clients = 0;
+        for (std::size_t i = 0; i < clients.size(); i++) {
+            if (is_client_disconnected[i]) {
+                m_logger.queue(LogLevel::Info, "close client id=", clients[i]->id, "connection");
+            } else {
+                clients[num_connected_clients++] = std::move(clients[i]);
             }
         }
+        clients.resize(num_connected_clients);
 
-        std::this_thread::sleep_for(std::chrono::milliseconds{LOOP_INTERVAL_MS});
+        /// accept new clients once the sockets of the current ones were handled, so poll_fds still match them
+        if (poll_fds[1].revents & POLLIN) {
+            accept_clients(tcp_server, clients, next_client_id);
+        }
+
+        if (has_received_tasks && m_on_tasks_received) {
+            m_on_tasks_received();
+        }
     }
 }
 
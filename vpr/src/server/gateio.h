@@ -4,6 +4,7 @@
 #ifndef NO_SERVER
 
 #include "task.h"
+#include "taskqueue.h"
 #include "telegrambuffer.h"
 
 #include "vtr_log.h"
@@ -15,7 +16,8 @@
 #include <mutex>
 #include <vector>
 #include <utility>
-#include <optional>
+#include <memory>
+#include <functional>
 
 #include "sockpp/tcp6_acceptor.h"
 
@@ -24,19 +26,23 @@ namespace server {
 /**
  * @brief Implements the socket communication layer with the outside world.
  * 
- * Operable only with a single client. As soon as client connection is detected
- * it begins listening on the specified port number for incoming client requests,
- * collects and encapsulates them into tasks (see @ref Task).
+ * It listens on the specified port number for client connections (several clients may be connected at once),
+ * collects the incoming client requests and encapsulates them into tasks (see @ref Task), tagged with the id of the client
+ * they came from.
  * The incoming tasks are extracted and handled by the top-level logic @ref TaskResolver in the main thread.
- * Once the tasks are resolved by the @ref TaskResolver, they are returned to be sent back to the client app as a response.
- * Moving @ref Task across threads happens in @ref server::update.
+ * Once the tasks are resolved by the @ref TaskResolver, they are returned to be sent back to their client as a response.
+ * Moving @ref Task across threads happens in @ref server::update, through lock-free queues (see @ref TaskQueue).
+ *
+ * The IO thread is event driven: it sleeps in poll() until a socket is ready or it is woken up,
+ * rather than checking the sockets at a fixed interval. Queuing responses wakes it up through a pipe,
+ * and receiving requests invokes a callback which lets the main thread know there is work to do.
  * 
  * @note
  * - The GateIO instance should be created and managed from the main thread, while its internal processing 
  *   and IO operations are performed asynchronously in a separate thread.  This separation ensures smooth IO behavior 
  *   and responsiveness of the application.
  * - GateIO is not started automatically upon creation, you have to use the 'start' method with the port number.
- * - The socket is initialized in a non-blocking mode to function properly in a multithreaded environment.
+ * - The sockets are initialized in a non-blocking mode to function properly in a multithreaded environment.
 */
 class GateIO
 {
@@ -138,7 +144,20 @@ class GateIO
         std::atomic<int> m_log_level;
     };
 
-    const int LOOP_INTERVAL_MS = 100;
+    /**
+     * @brief State of a connected client.
+     */
+    struct Client {
+        int id;
+        sockpp::tcp6_socket socket;
+        comm::TelegramBuffer telegram_buff;
+        std::unique_ptr<ClientAliveTracker> alive_tracker_ptr;
+        std::vector<TaskPtr> send_tasks; // responses to this client, in the order they are sent
+    };
+    using ClientPtr = std::unique_ptr<Client>;
+
+    // poll() timeout while the client alive trackers are used, so they get the chance to send echos and detect timeouts
+    const int ALIVE_TRACKER_POLL_INTERVAL_MS = 1000;
 
 public:
     /**
@@ -173,7 +192,7 @@ public:
     /**
      * @brief Moves tasks to the send queue.
      * 
-     * This method moves the tasks to the send queue.
+     * This method moves the tasks to the send queue, and wakes up the IO thread to send them.
      * Each task is moved from the input vector to the send queue, and the input vector
      * remains empty after the operation.
      * 
@@ -193,12 +212,14 @@ public:
      * @brief Starts the server on the specified port number.
      * 
      * This method starts the server to listen for incoming connections on the specified port number.
-     * Once started,the server will continue running in a separate thread and will accept connection only from a single client
+     * Once started, the server will continue running in a separate thread and will accept connections from clients
      * attempting to connect to the specified port.
      * 
      * @param port_num The port number on which the server will listen for incoming connection.
+     * @param on_tasks_received Callback invoked from the IO thread each time new tasks are received, which should
+     *                          schedule @ref server::update in the main thread. It must be thread safe.
      */
-    void start(int port_num);
+    void start(int port_num, const std::function<void()>& on_tasks_received = nullptr);
 
     /**
      * @brief Stops the server and terminates the listening thread.
@@ -217,21 +238,27 @@ private:
 
     std::thread m_thread; // thread to execute socket IO work
 
-    std::mutex m_tasks_mutex; // we used single mutex to guard both vectors m_received_tasks and m_sendTasks
-    std::vector<TaskPtr> m_received_tasks; // tasks from client (requests)
-    std::vector<TaskPtr> m_send_tasks; // tasks to client (responses)
+    TaskQueue m_received_tasks; // tasks from clients (requests)
+    TaskQueue m_send_tasks; // tasks to clients (responses)
+
+    std::function<void()> m_on_tasks_received; // lets the main thread know there are received tasks
+
+    int m_wakeup_pipe[2] = {-1, -1}; // written to wake up the IO thread from poll()
 
     TLogger m_logger;
 
     void start_listening(); // thread worker function
 
+    void wake_up();
+
     /// helper functions to be executed inside startListening
-    ActivityStatus check_client_connection(sockpp::tcp6_acceptor& tcp_server, std::optional<sockpp::tcp6_socket>& client_opt);
-    ActivityStatus handle_sending_data(sockpp::tcp6_socket& client);
-    ActivityStatus handle_receiving_data(sockpp::tcp6_socket& client, comm::TelegramBuffer& telegram_buff, std::string& received_message);
-    ActivityStatus handle_telegrams(std::vector<comm::TelegramFramePtr>& telegram_frames, comm::TelegramBuffer& telegram_buff);
-    ActivityStatus handle_client_alive_tracker(sockpp::tcp6_socket& client, std::unique_ptr<ClientAliveTracker>& client_alive_tracker_ptr);
-    void handle_activity_status(ActivityStatus status, std::unique_ptr<ClientAliveTracker>& client_alive_tracker_ptr, bool& is_communication_problem_detected);
+    void accept_clients(sockpp::tcp6_acceptor& tcp_server, std::vector<ClientPtr>& clients, int& next_client_id);
+    void dispatch_send_tasks(std::vector<ClientPtr>& clients);
+    ActivityStatus handle_sending_data(Client& client);
+    ActivityStatus handle_receiving_data(Client& client, std::string& received_message);
+    ActivityStatus handle_telegrams(std::vector<comm::TelegramFramePtr>& telegram_frames, Client& client, bool& has_received_tasks);
+    ActivityStatus handle_client_alive_tracker(Client& client);
+    void handle_activity_status(ActivityStatus status, Client& client, bool& is_communication_problem_detected);
     ///
 };
 
@@ -9,6 +9,8 @@
 #include "RoutingDelayCalculator.h"
 #include "timing_info.h"
 
+#include <algorithm>
+#include <iomanip>
 #include <sstream>
 
 namespace server {
@@ -31,8 +33,20 @@ static void collect_crit_path_metadata(std::stringstream& ss, const std::vector<
 
 /** 
  * @brief Helper function to calculate critical path timing report with specified parameters.
+ *
+ * The report matches the one of tatum::TimingReporter::report_timing_setup()/report_timing_hold(), but it is
+ * assembled from the cached path reports, and only the paths missing from the cache get reported.
  */
-CritPathsResultPtr calc_critical_path(const std::string& report_type, int crit_path_num, e_timing_report_detail details_level, bool is_flat_routing) {
+CritPathsResultPtr calc_critical_path(const std::string& report_type,
+                                      int crit_path_num,
+                                      e_timing_report_detail details_level,
+                                      bool is_flat_routing,
+                                      CritPathsCache& cache,
+                                      const std::atomic<bool>& is_cancelled) {
+    // same as the tatum::TimingReporter defaults
+    constexpr float UNIT_SCALE = 1e-9;
+    constexpr std::size_t PRECISION = 3;
+
     // shortcuts
     const std::shared_ptr<SetupHoldTimingInfo>& timing_info = g_vpr_ctx.server().timing_info;
     const std::shared_ptr<RoutingDelayCalculator>& routing_delay_calc = g_vpr_ctx.server().routing_delay_calc;
@@ -41,25 +55,60 @@ CritPathsResultPtr calc_critical_path(const std::string& report_type, int crit_p
     auto& atom_ctx = g_vpr_ctx.atom();
     const auto& blk_loc_registry = g_vpr_ctx.placement().blk_loc_registry();
 
-    t_analysis_opts analysis_opts;
-    analysis_opts.timing_report_detail = details_level;
-    analysis_opts.timing_report_npaths = crit_path_num;
-
-    VprTimingGraphResolver resolver(atom_ctx.nlist, atom_ctx.lookup, *timing_ctx.graph, *routing_delay_calc, is_flat_routing, blk_loc_registry);
-    resolver.set_detail_level(analysis_opts.timing_report_detail);
-
-    tatum::TimingReporter timing_reporter(resolver, *timing_ctx.graph, *timing_ctx.constraints);
-
     CritPathsResultPtr result = std::make_shared<CritPathsResult>();
+    if (report_type != comm::KEY_SETUP_PATH_LIST && report_type != comm::KEY_HOLD_PATH_LIST) {
+        return result;
+    }
 
-    std::stringstream ss;
-    if (report_type == comm::KEY_SETUP_PATH_LIST) {
-        timing_reporter.report_timing_setup(result->paths, ss, *timing_info->setup_analyzer(), analysis_opts.timing_report_npaths);
-    } else if (report_type == comm::KEY_HOLD_PATH_LIST) {
-        timing_reporter.report_timing_hold(result->paths, ss, *timing_info->hold_analyzer(), analysis_opts.timing_report_npaths);
+    const std::size_t npaths = std::max(crit_path_num, 0);
+    CritPathsCache::Entry& entry = cache.entry(report_type, details_level, is_flat_routing);
+
+    if (npaths > entry.npaths_requested) {
+        // trace the worst paths again, their first paths are the ones already reported
+        tatum::TimingPathCollector path_collector;
+        if (report_type == comm::KEY_SETUP_PATH_LIST) {
+            entry.paths = path_collector.collect_worst_setup_timing_paths(*timing_ctx.graph, *timing_info->setup_analyzer(), npaths);
+        } else {
+            entry.paths = path_collector.collect_worst_hold_timing_paths(*timing_ctx.graph, *timing_info->hold_analyzer(), npaths);
+        }
+        entry.npaths_requested = npaths;
+        if (entry.path_reports.size() > entry.paths.size()) {
+            entry.path_reports.resize(entry.paths.size());
+        }
     }
 
+    const std::size_t npaths_reported = std::min(npaths, entry.paths.size());
+    if (entry.path_reports.size() < npaths_reported) {
+        VprTimingGraphResolver resolver(atom_ctx.nlist, atom_ctx.lookup, *timing_ctx.graph, *routing_delay_calc, is_flat_routing, blk_loc_registry);
+        resolver.set_detail_level(details_level);
+
+        tatum::TimingReporter timing_reporter(resolver, *timing_ctx.graph, *timing_ctx.constraints, UNIT_SCALE, PRECISION);
+
+        while (entry.path_reports.size() < npaths_reported) {
+            if (is_cancelled.load()) {
+                // the paths reported so far stay cached
+                return result;
+            }
+            std::stringstream path_ss;
+            timing_reporter.report_timing_path(path_ss, entry.paths[entry.path_reports.size()]);
+            entry.path_reports.push_back(path_ss.str());
+        }
+    }
+
+    result->paths.assign(entry.paths.begin(), entry.paths.begin() + npaths_reported);
     if (!result->paths.empty()) {
+        std::stringstream ss;
+        ss << "#Timing report of worst " << npaths_reported << " path(s)\n";
+        ss << "# Unit scale: " << std::setprecision(0) << std::scientific << UNIT_SCALE << " seconds\n";
+        ss << "# Output precision: " << PRECISION << "\n";
+        ss << "\n";
+        for (std::size_t i = 0; i < npaths_reported; i++) {
+            ss << "#Path " << i + 1 << "\n";
+            ss << entry.path_reports[i];
+            ss << "\n";
+        }
+        ss << "#End of timing report\n";
+
         collect_crit_path_metadata(ss, result->paths);
         result->report = ss.str();
     }
@@ -67,6 +116,50 @@ CritPathsResultPtr calc_critical_path(const std::string& report_type, int crit_p
     return result;
 }
 
+std::vector<std::string> split_crit_path_report(const std::string& report) {
+    static const std::string PATH_MARKER{"\n#Path "};
+    static const std::string END_MARKER{"\n#End of timing report"};
+
+    std::vector<std::string> sections;
+
+    // every section but the first starts after the newline ending the previous one
+    std::size_t section_begin = 0;
+    std::size_t pos = report.find(PATH_MARKER);
+    while (pos != std::string::npos) {
+        sections.emplace_back(report, section_begin, pos + 1 - section_begin);
+        section_begin = pos + 1;
+        pos = report.find(PATH_MARKER, section_begin);
+    }
+
+    // the last path ends where the end of the report starts
+    std::size_t end_pos = report.find(END_MARKER, section_begin);
+    if (end_pos != std::string::npos) {
+        sections.emplace_back(report, section_begin, end_pos + 1 - section_begin);
+        section_begin = end_pos + 1;
+    }
+    sections.emplace_back(report, section_begin, std::string::npos);
+
+    return sections;
+}
+
+std::string make_delta_crit_path_report(const std::vector<std::string>& sections, const std::vector<std::string>& prev_sections) {
+    std::string delta_report;
+    for (std::size_t i = 0; i < sections.size(); i++) {
+        const std::string& section = sections[i];
+        bool is_path = (i > 0 && i + 1 < sections.size());
+        bool is_prev_path = (i + 1 < prev_sections.size());
+        if (is_path && is_prev_path && section == prev_sections[i]) {
+            // keep the "#Path N" line only
+            delta_report.append(section, 0, section.find('\n') + 1);
+            delta_report.append("#Unchanged\n\n");
+        } else {
+            delta_report.append(section);
+        }
+    }
+
+    return delta_report;
+}
+
 } // namespace server
 
 #endif /* NO_SERVER */
@@ -6,6 +6,8 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <map>
+#include <atomic>
 
 #include "tatum/report/TimingPath.hpp"
 #include "vpr_types.h"
@@ -36,17 +38,80 @@ struct CritPathsResult {
 };
 using CritPathsResultPtr = std::shared_ptr<CritPathsResult>;
 
+/**
+* @brief Critical paths already traced and reported for the current timing state.
+*
+* The worst N paths start with the worst M < N paths, so the paths traced for the largest path count requested
+* so far (for a given path type, details level and routing flatness) serve all the smaller counts, and only the
+* additional paths need reporting when a larger count is requested.
+*
+* @note Must be cleared whenever the timing state changes.
+*/
+class CritPathsCache {
+public:
+    /**
+    * @brief Paths and their reports (see tatum::TimingReporter::report_timing_path()) for one set of options.
+    */
+    struct Entry {
+        std::size_t npaths_requested = 0; // paths holds all the paths if fewer than this
+        std::vector<tatum::TimingPath> paths;
+        std::vector<std::string> path_reports;
+    };
+
+    /**
+    * @brief Returns the entry of the options, empty if no paths were reported for them yet.
+    */
+    Entry& entry(const std::string& type, e_timing_report_detail details_level, bool is_flat_routing) {
+        return m_entries[type + ";" + std::to_string(static_cast<int>(details_level)) + ";" + std::to_string(is_flat_routing)];
+    }
+
+    void clear() { m_entries.clear(); }
+
+private:
+    std::map<std::string, Entry> m_entries;
+};
+
 /**
 * @brief Calculates the critical path.
 
 * This function calculates the critical path based on the provided parameters.
+* It only reads the timing and routing state, so it may run in another thread as long as that state doesn't change.
 * @param type The type of the critical path. Must be either "setup" or "hold".
 * @param crit_path_num The max number of critical paths to record.
 * @param details_level The level of detail for the timing report. See @ref e_timing_report_detail.
 * @param is_flat_routing Indicates whether flat routing should be used.
+* @param cache The paths reported so far, reused and extended by this calculation.
+* @param is_cancelled Checked between paths: once set, the calculation stops and returns an empty (invalid) result.
 * @return A `CritPathsResultPtr` which is a pointer to the result of the critical path calculation (see @ref CritPathsResult).
 */
-CritPathsResultPtr calc_critical_path(const std::string& type, int crit_path_num, e_timing_report_detail details_level, bool is_flat_routing);
+CritPathsResultPtr calc_critical_path(const std::string& type,
+                                      int crit_path_num,
+                                      e_timing_report_detail details_level,
+                                      bool is_flat_routing,
+                                      CritPathsCache& cache,
+                                      const std::atomic<bool>& is_cancelled);
+
+/**
+* @brief Splits a critical path report into sections.
+*
+* The first section is the report header, followed by one section per path (starting with its "#Path N" line),
+* and the last section holds the end of the report (including its metadata).
+* @param report The report generated by @ref calc_critical_path.
+* @return The report sections, which concatenate back to the report.
+*/
+std::vector<std::string> split_crit_path_report(const std::string& report);
+
+/**
+* @brief Builds a delta critical path report, which only lists the paths that changed since a previous report.
+*
+* The header and the end sections are always included. A path identical to the same path (index) of the previous
+* report is replaced by its "#Path N" line followed by a "#Unchanged" line, so that the client can reuse the path
+* it already has.
+* @param sections The sections of the new report (see @ref split_crit_path_report).
+* @param prev_sections The sections of the previous report.
+* @return The delta report.
+*/
+std::string make_delta_crit_path_report(const std::vector<std::string>& sections, const std::vector<std::string>& prev_sections);
 
 } // namespace server
 
@@ -6,9 +6,23 @@
 #include "globals.h"
 #include "ezgl/application.hpp"
 
+#include <atomic>
+
 namespace server {
 
+static std::atomic<bool> is_update_scheduled{false};
+
+void schedule_update(ezgl::application* app) {
+    if (!is_update_scheduled.exchange(true)) {
+        // g_idle_add() is thread safe and wakes up the main loop
+        g_idle_add(update, app);
+    }
+}
+
 gboolean update(gpointer data) {
+    // clear first, so requests arriving while updating schedule a new run
+    is_update_scheduled.store(false);
+
     const bool is_running = g_vpr_ctx.server().gate_io.is_running();
     if (is_running) {
         // shortcuts
@@ -39,9 +53,9 @@ gboolean update(gpointer data) {
         }
         gate_io.print_logs();
     }
-    
-    // Return TRUE to keep the timer running, or FALSE to stop it
-    return is_running;
+
+    // Return FALSE to remove the idle source, schedule_update() adds a new one when needed
+    return FALSE;
 }
 
 } // namespace server
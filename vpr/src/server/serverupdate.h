@@ -5,17 +5,33 @@
 
 #include <glib.h>
 
+namespace ezgl {
+class application;
+}
+
 namespace server {
 
 /**
  * @brief Main server update callback.
  * 
- * This function is a periodic callback invoked at a fixed interval to manage and handle incoming client requests.
- * It acts as the central control point for processing client interactions and orchestrating server-side operations 
- * within the specified time intervals.
+ * This function is an idle callback of the GTK main loop, scheduled with @ref schedule_update whenever there is
+ * work to do, to manage and handle incoming client requests.
+ * It acts as the central control point for processing client interactions and orchestrating server-side operations.
+ *
+ * @return FALSE, so that the callback runs once per scheduling.
  */
 gboolean update(gpointer);
 
+/**
+ * @brief Schedules a single @ref update run in the main thread.
+ * 
+ * It may be called from any thread (e.g. by @ref GateIO when client requests are received).
+ * Calls made while an update is already pending are merged into it.
+ *
+ * @param app The application passed to @ref update.
+ */
+void schedule_update(ezgl::application* app);
+
 } // namespace server
 
 #endif /* NO_SERVER */
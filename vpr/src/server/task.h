@@ -46,6 +46,22 @@ public:
      */
     comm::CMD cmd() const { return m_cmd; }
 
+    /**
+     * @brief Gets the ID of the client connection the task was received from.
+     * 
+     * The response to the task is sent back to this client only.
+     * 
+     * @return The client ID.
+     */
+    int client_id() const { return m_client_id; }
+
+    /**
+     * @brief Sets the ID of the client connection the task was received from.
+     * 
+     * @param client_id The client ID, assigned by @ref GateIO.
+     */
+    void set_client_id(int client_id) { m_client_id = client_id; }
+
     /**
      * @brief Removes the specified number of bytes from the response buffer.
      * 
@@ -180,6 +196,7 @@ public:
 
 private:
     int m_job_id = -1;
+    int m_client_id = 0;
     comm::CMD m_cmd = comm::CMD::NONE;
     std::string m_options;
     std::string m_result;
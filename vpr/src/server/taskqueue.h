@@ -0,0 +1,82 @@
+#ifndef TASKQUEUE_H
+#define TASKQUEUE_H
+
+#ifndef NO_SERVER
+
+#include "task.h"
+
+#include <atomic>
+#include <algorithm>
+#include <vector>
+
+namespace server {
+
+/**
+ * @brief Lock-free queue used to hand over tasks between the IO thread and the main thread.
+ *
+ * Any number of threads may push tasks concurrently, while the consumer takes all queued tasks at once.
+ * Pushing is a single compare-and-swap on the queue head, and taking is a single exchange,
+ * so neither side ever blocks the other (e.g. the main thread is never stalled by the IO thread sending a large response).
+ * Since the consumer never removes a single node, the queue is not exposed to the ABA problem.
+ */
+class TaskQueue {
+public:
+    TaskQueue() = default;
+    ~TaskQueue() {
+        std::vector<TaskPtr> tasks;
+        take_all(tasks);
+    }
+
+    TaskQueue(const TaskQueue&) = delete;
+    TaskQueue& operator=(const TaskQueue&) = delete;
+
+    /**
+     * @brief Appends a task to the queue.
+     *
+     * @param task The task to be queued. The queue takes ownership of it.
+     */
+    void push(TaskPtr&& task) {
+        Node* node = new Node{std::move(task), m_head.load(std::memory_order_relaxed)};
+        while (!m_head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * @brief Checks if the queue has no tasks.
+     *
+     * @return True if the queue is empty, false otherwise.
+     */
+    bool empty() const { return m_head.load(std::memory_order_acquire) == nullptr; }
+
+    /**
+     * @brief Moves all queued tasks, in the order they were pushed, to the end of the provided vector.
+     *
+     * @param tasks A reference to a vector where the queued tasks will be moved.
+     */
+    void take_all(std::vector<TaskPtr>& tasks) {
+        Node* node = m_head.exchange(nullptr, std::memory_order_acquire);
+        std::size_t first = tasks.size();
+        while (node) {
+            tasks.push_back(std::move(node->task));
+            Node* next = node->next;
+            delete node;
+            node = next;
+        }
+        // the nodes are linked from the most recently pushed one
+        std::reverse(tasks.begin() + first, tasks.end());
+    }
+
+private:
+    struct Node {
+        TaskPtr task;
+        Node* next;
+    };
+
+    std::atomic<Node*> m_head{nullptr};
+};
+
+} // namespace server
+
+#endif /* NO_SERVER */
+
+#endif /* TASKQUEUE_H */
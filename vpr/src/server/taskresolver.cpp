@@ -7,15 +7,24 @@
 #include "pathhelper.h"
 #include "telegramoptions.h"
 #include "gtkcomboboxhelper.h"
+#include "serverupdate.h"
 
 #include <ezgl/application.hpp>
 
+#include <algorithm>
+#include <chrono>
+
 namespace server {
 
+TaskResolver::~TaskResolver() {
+    cancel_path_query();
+}
+
 void TaskResolver::own_task(TaskPtr&& new_task) {
     // pre-process task before adding, where we could quickly detect failure scenarios
+    // tasks of different clients never filter each other
     for (const auto& task: m_tasks) {
-        if (task->cmd() == new_task->cmd()) {
+        if (task->client_id() == new_task->client_id() && task->cmd() == new_task->cmd()) {
             if (task->options_match(new_task)) {
                 std::string msg = "similar task is already in execution, reject new " + new_task->info() + " and waiting for old " + task->info() + " execution";
                 new_task->set_fail(msg);
@@ -59,14 +68,46 @@ std::optional<e_timing_report_detail> TaskResolver::try_get_details_level_enum(c
     return std::nullopt;
 }
 
+void TaskResolver::cancel_path_query() {
+    if (m_path_query.valid()) {
+        m_is_path_query_cancelled.store(true);
+        m_path_query.wait();
+        m_path_query = std::future<CritPathsResultPtr>();
+    }
+}
+
+void TaskResolver::allow_background_tasks() {
+    m_is_background_tasks_allowed = true;
+}
+
+void TaskResolver::stop_background_tasks() {
+    m_is_background_tasks_allowed = false;
+    cancel_path_query();
+    m_crit_paths_cache.clear();
+}
+
+bool TaskResolver::is_path_query_task(const TaskPtr& task) const {
+    return task->client_id() == m_path_query_client_id && task->job_id() == m_path_query_job_id;
+}
+
 bool TaskResolver::update(ezgl::application* app) {
+    // drop the calculation of a task which failed meanwhile (e.g. overridden by a newer one)
+    if (m_path_query.valid()) {
+        bool is_task_pending = std::any_of(m_tasks.begin(), m_tasks.end(), [this](const TaskPtr& task) {
+            return !task->is_finished() && is_path_query_task(task);
+        });
+        if (!is_task_pending) {
+            cancel_path_query();
+        }
+    }
+
     bool has_processed_task = false;
     for (auto& task: m_tasks) {
         if (!task->is_finished()) {
             switch(task->cmd()) {
                 case comm::CMD::GET_PATH_LIST_ID: {
                     process_get_path_list_task(app, task);
-                    has_processed_task = true;
+                    has_processed_task |= task->is_finished();
                     break;
                 } 
                 case comm::CMD::DRAW_PATH_ID: {
@@ -82,27 +123,69 @@ bool TaskResolver::update(ezgl::application* app) {
     return has_processed_task;
 }
 
-void TaskResolver::process_get_path_list_task(ezgl::application*, const TaskPtr& task) {
+void TaskResolver::process_get_path_list_task(ezgl::application* app, const TaskPtr& task) {
+    // a single calculation runs at a time, the other tasks wait for it
+    if (m_path_query.valid() && !is_path_query_task(task)) {
+        return;
+    }
+
     static const std::vector<std::string> keys{comm::OPTION_PATH_NUM, comm::OPTION_PATH_TYPE, comm::OPTION_DETAILS_LEVEL, comm::OPTION_IS_FLAT_ROUTING};
     TelegramOptions options{task->options(), keys};
     if (!options.has_errors()) {
         ServerContext& server_ctx = g_vpr_ctx.mutable_server(); // shortcut
 
-        server_ctx.crit_path_element_indexes.clear(); // reset selection if path list options has changed
-
         // read options
         const int n_critical_path_num = options.get_int(comm::OPTION_PATH_NUM, 1);
         const std::string path_type = options.get_string(comm::OPTION_PATH_TYPE);
         const std::string details_level_str = options.get_string(comm::OPTION_DETAILS_LEVEL);
         const bool is_flat = options.get_bool(comm::OPTION_IS_FLAT_ROUTING, false);
+        const bool is_delta_response = options.get_bool(comm::OPTION_IS_DELTA_RESPONSE, false);
 
         // calculate critical path depending on options and store result in server context
         std::optional<e_timing_report_detail> details_level_opt = try_get_details_level_enum(details_level_str);
         if (details_level_opt) {
-            CritPathsResultPtr crit_paths_result = calc_critical_path(path_type, n_critical_path_num, details_level_opt.value(), is_flat);
+            const e_timing_report_detail details_level = details_level_opt.value();
+            CritPathsResultPtr crit_paths_result;
+            if (m_path_query.valid()) {
+                if (m_path_query.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                    return;
+                }
+                crit_paths_result = m_path_query.get();
+            } else if (m_is_background_tasks_allowed) {
+                // start the calculation in the worker thread, which schedules an update once done
+                m_is_path_query_cancelled.store(false);
+                m_path_query_client_id = task->client_id();
+                m_path_query_job_id = task->job_id();
+                m_path_query = std::async(std::launch::async, [this, app, path_type, n_critical_path_num, details_level, is_flat]() {
+                    CritPathsResultPtr result = calc_critical_path(path_type, n_critical_path_num, details_level, is_flat, m_crit_paths_cache, m_is_path_query_cancelled);
+                    schedule_update(app);
+                    return result;
+                });
+                return;
+            } else {
+                // the flow is running (e.g. events processed while flushing the drawing): the timing state may change
+                // right after this update, so calculate now and without the cache
+                CritPathsCache cache;
+                std::atomic<bool> is_cancelled{false};
+                crit_paths_result = calc_critical_path(path_type, n_critical_path_num, details_level, is_flat, cache, is_cancelled);
+            }
+
+            server_ctx.crit_path_element_indexes.clear(); // reset selection if path list options has changed
             if (crit_paths_result->is_valid()) {
                 server_ctx.crit_paths = std::move(crit_paths_result->paths);
-                task->set_success(std::move(crit_paths_result->report));
+
+                // a delta response only sends the paths that changed since the previous report with the same options
+                std::string report_options = path_type + ";" + details_level_str + ";" + std::to_string(is_flat);
+                std::vector<std::string> report_sections = split_crit_path_report(crit_paths_result->report);
+                std::vector<std::string>& prev_report_sections = server_ctx.crit_path_report_sections[task->client_id()];
+                std::string& prev_report_options = server_ctx.crit_path_report_options[task->client_id()];
+                if (is_delta_response && report_options == prev_report_options) {
+                    task->set_success(make_delta_crit_path_report(report_sections, prev_report_sections));
+                } else {
+                    task->set_success(std::move(crit_paths_result->report));
+                }
+                prev_report_sections = std::move(report_sections);
+                prev_report_options = std::move(report_options);
             } else {
                 std::string msg{"Critical paths report is empty"};
                 VTR_LOG_ERROR(msg.c_str());
@@ -4,10 +4,13 @@
 #ifndef NO_SERVER
 
 #include "task.h"
+#include "pathhelper.h"
 #include "vpr_types.h"
 
 #include <vector>
 #include <optional>
+#include <future>
+#include <atomic>
 
 namespace ezgl {
     class application;
@@ -19,6 +22,12 @@ namespace server {
  * @brief Resolve server task.
  * 
  * Process and resolve server task, store result and status for processed task.
+ *
+ * While the VPR flow is paused in the graphics main loop, critical path lists are calculated in a worker thread,
+ * so that the graphics stay responsive while thousands of paths are traced. The worker reads the timing and routing state
+ * directly, which the pause keeps frozen: the pause is delimited by @ref allow_background_tasks and @ref stop_background_tasks.
+ * Once the worker is done, it schedules a @ref server::update, which posts the result to the task.
+ * Otherwise the critical paths are calculated in the main thread, as part of the update.
 */
 class TaskResolver {
 public:
@@ -27,7 +36,10 @@ public:
      */
     TaskResolver()=default;
 
-    ~TaskResolver()=default;
+    ~TaskResolver();
+
+    TaskResolver(const TaskResolver&) = delete;
+    TaskResolver& operator=(const TaskResolver&) = delete;
 
     int tasks_num() const { return m_tasks.size(); }
 
@@ -60,12 +72,37 @@ public:
     */
     void take_finished_tasks(std::vector<TaskPtr>& tasks);
 
+    /**
+    * @brief Lets the next updates calculate critical paths in a worker thread.
+    *
+    * Must only be called while the timing and routing state cannot change (i.e. the VPR flow is paused).
+    */
+    void allow_background_tasks();
+
+    /**
+    * @brief Stops the critical path calculation running in the worker thread, if any, and drops the cached paths.
+    *
+    * Must be called before the timing or routing state changes (i.e. before the VPR flow resumes). The task whose paths
+    * were being calculated stays queued, and is calculated again on the next update.
+    */
+    void stop_background_tasks();
+
     // helper method used in tests
     const std::vector<TaskPtr>& tasks() const { return m_tasks; }
 
 private:
     std::vector<TaskPtr> m_tasks;
 
+    bool m_is_background_tasks_allowed = false;
+    std::future<CritPathsResultPtr> m_path_query; // critical path calculation running in the worker thread, if valid
+    std::atomic<bool> m_is_path_query_cancelled{false};
+    int m_path_query_client_id = -1; // task of the running calculation
+    int m_path_query_job_id = -1;
+    CritPathsCache m_crit_paths_cache; // only accessed by the worker thread while a calculation runs
+
+    void cancel_path_query();
+    bool is_path_query_task(const TaskPtr& task) const;
+
     void process_get_path_list_task(ezgl::application*, const TaskPtr&);
     void process_draw_critical_path_task(ezgl::application*, const TaskPtr&);
 
@@ -9,7 +9,8 @@ std::optional<std::string> try_compress(const std::string& decompressed) {
     z_stream zs;
     memset(&zs, 0, sizeof(zs));
 
-    if (deflateInit(&zs, Z_BEST_COMPRESSION) != Z_OK) {
+    // text reports compress almost as well at the default level, in a fraction of the time
+    if (deflateInit(&zs, Z_DEFAULT_COMPRESSION) != Z_OK) {
         return std::nullopt;
     }
 
@@ -19,10 +20,11 @@ std::optional<std::string> try_compress(const std::string& decompressed) {
     int ret_code;
     char* result_buffer = new char[BYTES_NUM_IN_32KB];
     std::string result;
+    result.reserve(deflateBound(&zs, decompressed.size()));
 
     do {
         zs.next_out = reinterpret_cast<Bytef*>(result_buffer);
-        zs.avail_out = sizeof(result_buffer);
+        zs.avail_out = BYTES_NUM_IN_32KB;
 
         ret_code = deflate(&zs, Z_FINISH);
 
@@ -59,7 +61,7 @@ std::optional<std::string> try_decompress(const std::string& compressed) {
 
     do {
         zs.next_out = reinterpret_cast<Bytef*>(result_buffer);
-        zs.avail_out = sizeof(result_buffer);
+        zs.avail_out = BYTES_NUM_IN_32KB;
 
         ret_code = inflate(&zs, 0);
 
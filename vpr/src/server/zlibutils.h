@@ -12,7 +12,7 @@ constexpr const int BYTES_NUM_IN_32KB = 32768;
 * @brief Compresses the input sequence using zlib.
 *
 * This function takes a string representing the decompressed data as input
-* and compresses it using zlib. If compression is successful, the compressed
+* and compresses it using zlib, streaming the output 32KB at a time. If compression is successful, the compressed
 * data is returned as an optional string. If compression fails, an empty optional
 * is returned.
 *
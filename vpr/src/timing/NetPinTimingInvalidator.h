@@ -7,8 +7,12 @@
 
 #include "vtr_vec_id_set.h"
 
+#include <cstdint>
+#include <vector>
+
 #ifdef VPR_USE_TBB
-#    include <tbb/concurrent_unordered_set.h>
+#    include <atomic>
+#    include <tbb/enumerable_thread_specific.h>
 #endif
 
 /** Make NetPinTimingInvalidator a virtual class since it does nothing for the general case of non-incremental
@@ -28,7 +32,8 @@ class NetPinTimingInvalidator {
 //
 //For efficiency, it pre-calculates and stores the mapping from ClusterPinId -> tatum::EdgeIds,
 //and tracks whether a particular ClusterPinId has been already invalidated (to avoid the expense
-//of invalidating it multiple times)
+//of invalidating it multiple times). The invalidated pins are accumulated across any number of
+//moves until the next timing update, which then only re-propagates their fanout cones.
 class IncrNetPinTimingInvalidator : public NetPinTimingInvalidator {
   public:
     IncrNetPinTimingInvalidator(const Netlist<>& net_list,
@@ -70,6 +75,13 @@ class IncrNetPinTimingInvalidator : public NetPinTimingInvalidator {
         pin_first_edge_.push_back(timing_edges_.size());
 
         VTR_ASSERT(pin_first_edge_.size() == net_list.pins().size() + 1);
+
+        size_t num_words = (num_pins + PIN_FLAG_WORD_BITS - 1) / PIN_FLAG_WORD_BITS;
+#ifdef VPR_USE_TBB
+        pin_invalidated_ = std::vector<std::atomic<uint64_t>>(num_words);
+#else
+        pin_invalidated_.resize(num_words, 0);
+#endif
     }
 
     //Returns the set of timing edges associated with the specified cluster pin
@@ -83,19 +95,46 @@ class IncrNetPinTimingInvalidator : public NetPinTimingInvalidator {
      * driving the specified pin.
      * Is concurrently safe. */
     void invalidate_connection(ParentPinId pin, TimingInfo* timing_info) {
-        if (invalidated_pins_.count(pin)) return; //Already invalidated
+        size_t word = size_t(pin) / PIN_FLAG_WORD_BITS;
+        uint64_t mask = uint64_t(1) << (size_t(pin) % PIN_FLAG_WORD_BITS);
+#ifdef VPR_USE_TBB
+        //Only the thread setting the flag invalidates the edges. The timing update which reads them
+        //happens after the routing threads are joined, so no ordering is needed here
+        if (pin_invalidated_[word].fetch_or(mask, std::memory_order_relaxed) & mask) return; //Already invalidated
+#else
+        if (pin_invalidated_[word] & mask) return; //Already invalidated
+        pin_invalidated_[word] |= mask;
+#endif
 
         for (tatum::EdgeId edge : pin_timing_edges(pin)) {
             timing_info->invalidate_delay(edge);
         }
 
-        invalidated_pins_.insert(pin);
+#ifdef VPR_USE_TBB
+        invalidated_pins_.local().push_back(pin);
+#else
+        invalidated_pins_.push_back(pin);
+#endif
     }
 
-    /** Resets invalidation state for this class
+    /** Resets invalidation state for this class.
+     * Only the flag words of the invalidated pins are visited (every set flag is listed), so this is
+     * cheap when few connections changed.
      * Not concurrently safe! */
     void reset() {
+#ifdef VPR_USE_TBB
+        for (std::vector<ParentPinId>& thread_invalidated_pins : invalidated_pins_) {
+            for (ParentPinId pin : thread_invalidated_pins) {
+                pin_invalidated_[size_t(pin) / PIN_FLAG_WORD_BITS].store(0, std::memory_order_relaxed);
+            }
+            thread_invalidated_pins.clear();
+        }
+#else
+        for (ParentPinId pin : invalidated_pins_) {
+            pin_invalidated_[size_t(pin) / PIN_FLAG_WORD_BITS] = 0;
+        }
         invalidated_pins_.clear();
+#endif
     }
 
   private:
@@ -130,12 +169,19 @@ class IncrNetPinTimingInvalidator : public NetPinTimingInvalidator {
     std::vector<int> pin_first_edge_; //Indices into timing_edges corresponding
     std::vector<tatum::EdgeId> timing_edges_;
 
-    /** Cache for invalidated pins. Use concurrent set when TBB is turned on, since the
-     * invalidator may be shared between threads */
+    static constexpr size_t PIN_FLAG_WORD_BITS = 64;
+
+    /** Cache for invalidated pins: a dense bitset with a flag per pin for constant-time look-ups,
+     * and the list of pins invalidated since the last reset(). Both are allocated once, and reset()
+     * only clears the flags of the listed pins. When TBB is turned on, the invalidator may be shared
+     * between threads: the flags are set with an atomic fetch_or, and each thread appends to its own
+     * list, so invalidations by different threads don't contend on a shared container */
 #ifdef VPR_USE_TBB
-    tbb::concurrent_unordered_set<ParentPinId> invalidated_pins_;
+    std::vector<std::atomic<uint64_t>> pin_invalidated_;
+    tbb::enumerable_thread_specific<std::vector<ParentPinId>> invalidated_pins_;
 #else
-    vtr::vec_id_set<ParentPinId> invalidated_pins_;
+    std::vector<uint64_t> pin_invalidated_;
+    std::vector<ParentPinId> invalidated_pins_;
 #endif
 };
 
@@ -155,7 +201,7 @@ class NoopNetPinTimingInvalidator : public NetPinTimingInvalidator {
     }
 };
 
-/** Make a NetPinTimingInvalidator depending on update_type. Will return a NoopInvalidator if it's not INCREMENTAL. */
+/** Make a NetPinTimingInvalidator depending on update_type. Will return a NoopInvalidator if it's not (PARALLEL_)INCREMENTAL. */
 inline std::unique_ptr<NetPinTimingInvalidator> make_net_pin_timing_invalidator(
     e_timing_update_type update_type,
     const Netlist<>& net_list,
@@ -167,7 +213,7 @@ inline std::unique_ptr<NetPinTimingInvalidator> make_net_pin_timing_invalidator(
     if (update_type == e_timing_update_type::FULL || update_type == e_timing_update_type::AUTO) {
         return std::make_unique<NoopNetPinTimingInvalidator>();
     } else {
-        VTR_ASSERT(update_type == e_timing_update_type::INCREMENTAL);
+        VTR_ASSERT(update_type == e_timing_update_type::INCREMENTAL || update_type == e_timing_update_type::PARALLEL_INCREMENTAL);
         return std::make_unique<IncrNetPinTimingInvalidator>(net_list, clb_atom_pin_lookup, atom_nlist, atom_lookup, timing_graph, is_flat);
     }
 }
\ No newline at end of file
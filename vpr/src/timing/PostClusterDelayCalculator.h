@@ -1,6 +1,9 @@
 #ifndef POST_CLUSTER_DELAY_CALCULATOR_H
 #define POST_CLUSTER_DELAY_CALCULATOR_H
+#include <cmath>
+
 #include "vtr_linear_map.h"
+#include "vtr_vector.h"
 
 #include "tatum/Time.hpp"
 #include "tatum/TimingGraph.hpp"
@@ -16,6 +19,16 @@
 
 class VprTimingGraphResolver; //Forward declaration
 
+/*
+ * Delay calculator used once the netlist is clustered (i.e. during placement, routing and analysis)
+ *
+ * The delays which don't depend on the placement or routing (primitive delays, setup/hold times,
+ * and the delays of the routing within the clusters) are all computed when the calculator is
+ * constructed, in parallel over the timing edges, and flattened into a contiguous per-edge array.
+ * Only the edges of connections through the inter-cluster routing are then evaluated when queried,
+ * by adding the current net delay, so the queries don't modify the calculator (and are safe to
+ * make from concurrent timing analysis threads).
+ */
 class PostClusterDelayCalculator : public tatum::DelayCalculator {
   public:
     PostClusterDelayCalculator(const AtomNetlist& netlist,
@@ -29,43 +42,62 @@ class PostClusterDelayCalculator : public tatum::DelayCalculator {
     tatum::Time min_edge_delay(const tatum::TimingGraph& tg, tatum::EdgeId edge_id) const override;
     tatum::Time hold_time(const tatum::TimingGraph& tg, tatum::EdgeId edge_id) const override;
 
-    void clear_cache();
-
     void set_tsu_margin_relative(float val);
     void set_tsu_margin_absolute(float val);
 
   private:
     friend VprTimingGraphResolver;
 
+    ///The min and max delays of an edge
+    struct t_edge_delays {
+        tatum::Time min = tatum::Time(NAN);
+        tatum::Time max = tatum::Time(NAN);
+
+        tatum::Time get(DelayType delay_type) const {
+            return (delay_type == DelayType::MAX) ? max : min;
+        }
+    };
+
+    ///The connection through the inter-cluster (or, if is_flat, the global) routing of an edge
+    struct t_routed_connection {
+        ParentPinId src_pin = ParentPinId::INVALID();
+        ParentPinId sink_pin = ParentPinId::INVALID();
+        ParentNetId net = ParentNetId::INVALID();
+        int sink_net_pin_index = -1;
+
+        ///Delays from the primitive source pin to the cluster output pin, and from the
+        ///cluster input pin to the primitive sink pin (zero if is_flat)
+        t_edge_delays driver_clb_delays;
+        t_edge_delays sink_clb_delays;
+    };
+
     //Returns the generic edge delay
     tatum::Time calc_edge_delay(const tatum::TimingGraph& tg, tatum::EdgeId edge_id, DelayType delay_type) const;
 
+    ///Computes the delays of every edge which don't depend on the placement or routing
+    void precompute_edge_delays(const tatum::TimingGraph& tg);
+    void precompute_edge_delays(const tatum::TimingGraph& tg, tatum::EdgeId edge_id);
+
     tatum::Time atom_combinational_delay(const tatum::TimingGraph& tg, tatum::EdgeId edge_id, DelayType delay_type) const;
     tatum::Time atom_clock_to_q_delay(const tatum::TimingGraph& tg, tatum::EdgeId edge_id, DelayType delay_type) const;
-    tatum::Time atom_net_delay(const tatum::TimingGraph& tg, tatum::EdgeId edge_id, DelayType delay_type) const;
-
     tatum::Time atom_setup_time(const tatum::TimingGraph& tg, tatum::EdgeId edge_id) const;
     tatum::Time atom_hold_time(const tatum::TimingGraph& tg, tatum::EdgeId edge_id) const;
 
-    float inter_cluster_delay(ParentNetId net_id, const int driver_net_pin_index, const int sink_net_pin_index) const;
-
-    tatum::Time get_cached_delay(tatum::EdgeId edge, DelayType delay_type) const;
-    void set_cached_delay(tatum::EdgeId edge, DelayType delay_type, tatum::Time delay) const;
-
-    tatum::Time get_driver_clb_cached_delay(tatum::EdgeId edge, DelayType delay_type) const;
-    void set_driver_clb_cached_delay(tatum::EdgeId edge, DelayType delay_type, tatum::Time delay) const;
+    ///Computes the delays within the clusters of the interconnect edge edge_id, and
+    ///finds its connection through the routing (if any)
+    void precompute_atom_net_delays(const tatum::TimingGraph& tg, tatum::EdgeId edge_id);
 
-    tatum::Time get_sink_clb_cached_delay(tatum::EdgeId edge, DelayType delay_type) const;
-    void set_sink_clb_cached_delay(tatum::EdgeId edge, DelayType delay_type, tatum::Time delay) const;
+    ///Recomputes the setup times of the edges after the tsu margins change
+    void update_setup_times();
 
-    tatum::Time get_cached_setup_time(tatum::EdgeId edge) const;
-    void set_cached_setup_time(tatum::EdgeId edge, tatum::Time setup) const;
+    float inter_cluster_delay(ParentNetId net_id, const int driver_net_pin_index, const int sink_net_pin_index) const;
 
-    tatum::Time get_cached_hold_time(tatum::EdgeId edge) const;
-    void set_cached_hold_time(tatum::EdgeId edge, tatum::Time hold) const;
+    ///Returns the delays of each timing corner (see TimingContext::corner_logic_delay_scale)
+    ///for a logic (primitive or intra-cluster) delay
+    tatum::Time logic_delay(float delay) const;
 
-    std::pair<ParentPinId, ParentPinId> get_cached_pins(tatum::EdgeId edge, DelayType delay_type) const;
-    void set_cached_pins(tatum::EdgeId edge, DelayType delay_type, ParentPinId src_pin, ParentPinId sink_pin) const;
+    ///Returns the delays of each timing corner for a routing (inter-cluster) delay
+    tatum::Time routing_delay(float delay) const;
 
   private:
     const AtomNetlist& netlist_;
@@ -78,15 +110,18 @@ class PostClusterDelayCalculator : public tatum::DelayCalculator {
     float tsu_margin_rel_ = 1.0;
     float tsu_margin_abs_ = 0.0e-12;
 
-    mutable vtr::vector<tatum::EdgeId, tatum::Time> edge_min_delay_cache_;
-    mutable vtr::vector<tatum::EdgeId, tatum::Time> edge_max_delay_cache_;
-    mutable vtr::vector<tatum::EdgeId, tatum::Time> driver_clb_min_delay_cache_;
-    mutable vtr::vector<tatum::EdgeId, tatum::Time> driver_clb_max_delay_cache_;
-    mutable vtr::vector<tatum::EdgeId, tatum::Time> sink_clb_min_delay_cache_;
-    mutable vtr::vector<tatum::EdgeId, tatum::Time> sink_clb_max_delay_cache_;
-    mutable vtr::vector<tatum::EdgeId, std::pair<ParentPinId, ParentPinId>> pin_cache_min_;
-    mutable vtr::vector<tatum::EdgeId, std::pair<ParentPinId, ParentPinId>> pin_cache_max_;
+    tatum::Time corner_logic_delay_scale_;
+    tatum::Time corner_routing_delay_scale_;
+
     bool is_flat_;
+
+    ///The delays of the edges which don't go through the routing: the complete delays of the
+    ///primitive and intra-cluster edges, and the setup (max) and hold (min) times of the capture edges
+    vtr::vector<tatum::EdgeId, t_edge_delays> edge_delays_;
+
+    ///The connection through the routing of each edge (with an invalid net for the other edges),
+    ///including its delays within the driver and sink clusters
+    vtr::vector<tatum::EdgeId, t_routed_connection> edge_connections_;
 };
 
 #include "PostClusterDelayCalculator.tpp"
@@ -1,5 +1,7 @@
 #ifndef PRE_CLUSTER_DELAY_CALCULATOR_H
 #define PRE_CLUSTER_DELAY_CALCULATOR_H
+#include <vector>
+
 #include "vtr_assert.h"
 
 #include "tatum/Time.hpp"
@@ -40,6 +42,11 @@ class PreClusterDelayCalculator : public tatum::DelayCalculator {
         } else {
             VTR_ASSERT(edge_type == tatum::EdgeType::INTERCONNECT);
 
+            //Connections within a closed cluster no longer use the inter-cluster routing
+            if (is_intra_cluster_edge(edge_id)) {
+                return tatum::Time(0.);
+            }
+
             //External net delay
             return tatum::Time(inter_cluster_net_delay_);
         }
@@ -75,6 +82,18 @@ class PreClusterDelayCalculator : public tatum::DelayCalculator {
         return setup_time(tg, edge_id);
     }
 
+    ///@brief Marks the interconnect edge_id as a connection within a cluster, with no inter-cluster net delay
+    void set_intra_cluster_edge(tatum::EdgeId edge_id) {
+        if (size_t(edge_id) >= intra_cluster_edges_.size()) {
+            intra_cluster_edges_.resize(size_t(edge_id) + 1, false);
+        }
+        intra_cluster_edges_[size_t(edge_id)] = true;
+    }
+
+    bool is_intra_cluster_edge(tatum::EdgeId edge_id) const {
+        return size_t(edge_id) < intra_cluster_edges_.size() && intra_cluster_edges_[size_t(edge_id)];
+    }
+
   private:
     //TODO: use generic AtomDelayCalc class to avoid code duplication
 
@@ -164,6 +183,9 @@ class PreClusterDelayCalculator : public tatum::DelayCalculator {
     const AtomLookup& netlist_lookup_;
     const float inter_cluster_net_delay_;
     const Prepacker& prepacker_;
+
+    //[edge] Whether each interconnect edge connects two atoms of the same cluster
+    std::vector<bool> intra_cluster_edges_;
 };
 
 #endif
@@ -127,20 +127,16 @@ std::vector<tatum::DelayComponent> VprTimingGraphResolver::interconnect_delay_br
 
     std::vector<tatum::DelayComponent> components;
 
-    // We assume that the delay calculator has already cached all of the relevant delays,
-    // we just retrieve the cached values. This assumption greatly simplifies the calculation
+    // The delay calculator precomputes all of the relevant delays (except the net delays),
+    // we just retrieve the precomputed values. This greatly simplifies the calculation
     // process and avoids us duplicating the complex delay calculation logic from the delay
     // calculator.
     //
     // However note that this does couple this code tightly with the delay calculator implementation.
+    const auto& connection = delay_calc_.edge_connections_[edge];
 
-    //Force delay calculation to ensure results are cached (redundant if already up-to-date)
-    delay_calc_.atom_net_delay(timing_graph_, edge, delay_type);
-
-    ParentPinId src_pin = ParentPinId::INVALID();
-    ParentPinId sink_pin = ParentPinId::INVALID();
-
-    std::tie(src_pin, sink_pin) = delay_calc_.get_cached_pins(edge, delay_type);
+    ParentPinId src_pin = connection.src_pin;
+    ParentPinId sink_pin = connection.sink_pin;
 
     if (!src_pin && !sink_pin && !is_flat_) {
         //Cluster internal
@@ -156,7 +152,7 @@ std::vector<tatum::DelayComponent> VprTimingGraphResolver::interconnect_delay_br
         internal_component.type_name = "intra '";
         internal_component.type_name += cluster_ctx.clb_nlist.block_type(clb_blk)->name;
         internal_component.type_name += "' routing";
-        internal_component.delay = delay_calc_.get_cached_delay(edge, delay_type);
+        internal_component.delay = delay_calc_.edge_delays_[edge].get(delay_type);
         components.push_back(internal_component);
 
     } else {
@@ -202,8 +198,8 @@ std::vector<tatum::DelayComponent> VprTimingGraphResolver::interconnect_delay_br
 
             src_net = (ParentNetId&)tmp_cluster_net;
 
-            driver_clb_delay = delay_calc_.get_driver_clb_cached_delay(edge, delay_type);
-            sink_clb_delay = delay_calc_.get_sink_clb_cached_delay(edge, delay_type);
+            driver_clb_delay = connection.driver_clb_delays.get(delay_type);
+            sink_clb_delay = connection.sink_clb_delays.get(delay_type);
 
             sink_net_pin_index = cluster_ctx.clb_nlist.pin_net_index((ClusterPinId&)sink_pin);
         }
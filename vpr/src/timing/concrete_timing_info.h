@@ -339,7 +339,13 @@ class ConcreteSetupHoldTimingInfo : public SetupHoldTimingInfo {
         {
             auto start_time = Clock::now();
 
-            setup_hold_analyzer_->update_timing();
+            if (full_hold_update_interval_ > 1 && updates_since_full_hold_ + 1 < full_hold_update_interval_) {
+                setup_hold_analyzer_->update_timing_pruned_hold(hold_slack_threshold_);
+                ++updates_since_full_hold_;
+            } else {
+                setup_hold_analyzer_->update_timing();
+                updates_since_full_hold_ = 0;
+            }
 
             sta_wallclock_time = std::chrono::duration_cast<dsec>(Clock::now() - start_time).count();
         }
@@ -373,6 +379,11 @@ class ConcreteSetupHoldTimingInfo : public SetupHoldTimingInfo {
 
     void set_warn_unconstrained(bool val) override { warn_unconstrained_ = val; }
 
+    void set_hold_pruning(size_t full_hold_update_interval, float hold_slack_threshold) override {
+        full_hold_update_interval_ = full_hold_update_interval;
+        hold_slack_threshold_ = hold_slack_threshold;
+    }
+
   private:
     ConcreteSetupTimingInfo<DelayCalc> setup_timing_;
     ConcreteHoldTimingInfo<DelayCalc> hold_timing_;
@@ -380,6 +391,10 @@ class ConcreteSetupHoldTimingInfo : public SetupHoldTimingInfo {
 
     bool warn_unconstrained_ = true;
 
+    size_t full_hold_update_interval_ = 0;
+    float hold_slack_threshold_ = 0.;
+    size_t updates_since_full_hold_ = 0;
+
     typedef std::chrono::duration<double> dsec;
     typedef std::chrono::high_resolution_clock Clock;
 };
@@ -435,6 +450,7 @@ class ConstantTimingInfo : public SetupHoldTimingInfo {
     std::shared_ptr<const tatum::TimingConstraints> timing_constraints() const override { return nullptr; }
 
     void set_warn_unconstrained(bool /*val*/) override {}
+    void set_hold_pruning(size_t /*full_hold_update_interval*/, float /*hold_slack_threshold*/) override {}
 
   public: //Mutators
     void invalidate_delay(const tatum::EdgeId /*edge*/) override {}
@@ -460,6 +476,8 @@ std::unique_ptr<SetupTimingInfo> make_setup_timing_info(std::shared_ptr<DelayCal
 
     if (update_type == e_timing_update_type::FULL || update_type == e_timing_update_type::AUTO) {
         analyzer = tatum::AnalyzerFactory<tatum::SetupAnalysis, tatum::ParallelWalker>::make(*timing_ctx.graph, *timing_ctx.constraints, *delay_calculator);
+    } else if (update_type == e_timing_update_type::PARALLEL_INCREMENTAL) {
+        analyzer = tatum::AnalyzerFactory<tatum::SetupAnalysis, tatum::ParallelIncrWalker>::make(*timing_ctx.graph, *timing_ctx.constraints, *delay_calculator);
     } else {
         VTR_ASSERT(update_type == e_timing_update_type::INCREMENTAL);
         analyzer = tatum::AnalyzerFactory<tatum::SetupAnalysis, tatum::SerialIncrWalker>::make(*timing_ctx.graph, *timing_ctx.constraints, *delay_calculator);
@@ -476,6 +494,8 @@ std::unique_ptr<HoldTimingInfo> make_hold_timing_info(std::shared_ptr<DelayCalc>
     std::shared_ptr<tatum::HoldTimingAnalyzer> analyzer;
     if (update_type == e_timing_update_type::FULL || update_type == e_timing_update_type::AUTO) {
         analyzer = tatum::AnalyzerFactory<tatum::HoldAnalysis, tatum::ParallelWalker>::make(*timing_ctx.graph, *timing_ctx.constraints, *delay_calculator);
+    } else if (update_type == e_timing_update_type::PARALLEL_INCREMENTAL) {
+        analyzer = tatum::AnalyzerFactory<tatum::HoldAnalysis, tatum::ParallelIncrWalker>::make(*timing_ctx.graph, *timing_ctx.constraints, *delay_calculator);
     } else {
         VTR_ASSERT(update_type == e_timing_update_type::INCREMENTAL);
         analyzer = tatum::AnalyzerFactory<tatum::HoldAnalysis, tatum::SerialIncrWalker>::make(*timing_ctx.graph, *timing_ctx.constraints, *delay_calculator);
@@ -492,6 +512,8 @@ std::unique_ptr<SetupHoldTimingInfo> make_setup_hold_timing_info(std::shared_ptr
     std::shared_ptr<tatum::SetupHoldTimingAnalyzer> analyzer;
     if (update_type == e_timing_update_type::FULL || update_type == e_timing_update_type::AUTO) {
         analyzer = tatum::AnalyzerFactory<tatum::SetupHoldAnalysis, tatum::ParallelWalker>::make(*timing_ctx.graph, *timing_ctx.constraints, *delay_calculator);
+    } else if (update_type == e_timing_update_type::PARALLEL_INCREMENTAL) {
+        analyzer = tatum::AnalyzerFactory<tatum::SetupHoldAnalysis, tatum::ParallelIncrWalker>::make(*timing_ctx.graph, *timing_ctx.constraints, *delay_calculator);
     } else {
         VTR_ASSERT(update_type == e_timing_update_type::INCREMENTAL);
         analyzer = tatum::AnalyzerFactory<tatum::SetupHoldAnalysis, tatum::SerialIncrWalker>::make(*timing_ctx.graph, *timing_ctx.constraints, *delay_calculator);
@@ -1,5 +1,12 @@
+#include <cmath>
 #include <cstdio>
+#include <limits>
 
+#ifdef VPR_USE_TBB
+#    include <tbb/parallel_for.h>
+#endif
+
+#include "vtr_array_view.h"
 #include "vtr_memory.h"
 #include "vtr_log.h"
 
@@ -11,25 +18,12 @@
 
 /* This module keeps track of the time delays for signals to arrive at       *
  * each pin in every net after timing-driven routing is complete. It         *
- * achieves this by first constructing the skeleton route tree               *
- * from the traceback. Next, to obtain the completed route tree, it          *
- * calls functions to calculate the resistance, capacitance, and time        *
- * delays associated with each node. Then, it recursively traverses          *
- * the tree, copying the time delay from each node into the                  *
- * net_delay data structure. Essentially, the delays are calculated          *
- * by building the completed route tree from scratch, and is used            *
- * to check against the time delays computed incrementally during           *
- * timing-driven routing.                                                    */
-
-/********************** Variables local to this module ***********************/
-
-/* Unordered map below stores the pair whose key is the pin index (ranging   *
- * from 1 to net fan-out) that corresponds to the rt_node, and whose value   *
- * is the time delay associated with that node. The map will be used to      *
- * store delays while traversing the nodes of the route tree in              *
- * load_one_net_delay_recurr.      */
-
-static std::unordered_map<int, float> ipin_to_Tdel_map;
+ * recursively traverses the route tree of each net, copying the time        *
+ * delay from each sink node into the net_delay data structure. It is used   *
+ * to load the delays of a routing read from a file, and to check against   *
+ * the time delays computed incrementally during timing-driven routing      *
+ * (during which only the delays of the rerouted nets are updated, by        *
+ * update_net_delays_from_route_tree()).                                     */
 
 /*********************** Subroutines local to this module ********************/
 
@@ -37,7 +31,7 @@ static void load_one_net_delay(const Netlist<>& net_list,
                                NetPinsMatrix<float>& net_delay,
                                ParentNetId net_id);
 
-static void load_one_net_delay_recurr(const RouteTreeNode& node, ParentNetId net_id);
+static void load_one_net_delay_recurr(const RouteTreeNode& node, vtr::array_view<float> net_pin_delays);
 
 static void load_one_constant_net_delay(const Netlist<>& net_list,
                                         NetPinsMatrix<float>& net_delay,
@@ -50,60 +44,68 @@ void load_net_delay_from_routing(const Netlist<>& net_list, NetPinsMatrix<float>
      * is the Elmore delay from the net source to the appropriate sink. Both       *
      * the rr_graph and the routing traceback must be completely constructed        *
      * before this routine is called, and the net_delay array must have been        *
-     * allocated.                                                                   */
+     * allocated.                                                                   *
+     * The nets only read their own route tree and write their own row of          *
+     * net_delay, so they are loaded in parallel.                                   */
 
-    for (auto net_id : net_list.nets()) {
+    auto nets = net_list.nets();
+    auto load_net = [&](size_t inet) {
+        ParentNetId net_id = *(nets.begin() + inet);
         if (net_list.net_is_ignored(net_id)) {
             load_one_constant_net_delay(net_list, net_delay, net_id, 0.);
         } else {
             load_one_net_delay(net_list, net_delay, net_id);
         }
+    };
+
+#ifdef VPR_USE_TBB
+    tbb::parallel_for(size_t(0), nets.size(), load_net);
+#else
+    for (size_t inet = 0; inet < nets.size(); inet++) {
+        load_net(inet);
     }
+#endif
 }
 
 static void load_one_net_delay(const Netlist<>& net_list,
                                NetPinsMatrix<float>& net_delay,
                                ParentNetId net_id) {
     /* This routine loads delay values for one net in                            *
-     * net_delay[net_id][1..num_pins-1]. First, from the traceback, it           *
-     * constructs the route tree and computes its values for R, C, and Tdel.     *
-     * Next, it walks the route tree recursively, storing the time delays for    *
-     * each sink into the map ipin_to_Tdel. Then, while looping through the      *
-     * net_delay array we search for the pin index in the map, and               *
-     * correspondingly update the entry in net_delay. Finally, it frees the      *
-     * route tree and clears the ipin_to_Tdel_map associated with that net.      */
+     * net_delay[net_id][1..num_pins-1]. It walks the route tree (whose R, C     *
+     * and Tdel values are up to date) recursively, storing the time delay of    *
+     * each sink into its entry of net_delay. Every sink must be reached.        */
 
-    auto& route_ctx = g_vpr_ctx.mutable_routing();
+    const auto& route_ctx = g_vpr_ctx.routing();
 
     if (!route_ctx.route_trees[net_id]) {
         VPR_FATAL_ERROR(VPR_ERROR_TIMING,
                         "in load_one_net_delay: Route tree for net %lu does not exist.\n", size_t(net_id));
     }
 
-    RouteTree& tree = route_ctx.route_trees[net_id].value();
-    load_one_net_delay_recurr(tree.root(), net_id); // recursively traverse the tree and load entries into the ipin_to_Tdel map
+    vtr::array_view<float> net_pin_delays(net_delay[net_id].data(), net_list.net_pins(net_id).size());
+    for (unsigned int ipin = 1; ipin < net_pin_delays.size(); ipin++) {
+        net_pin_delays[ipin] = std::numeric_limits<float>::quiet_NaN(); // marks the sinks not reached yet
+    }
 
-    for (unsigned int ipin = 1; ipin < net_list.net_pins(net_id).size(); ipin++) {
-        auto itr = ipin_to_Tdel_map.find(ipin);
-        VTR_ASSERT(itr != ipin_to_Tdel_map.end());
+    const RouteTree& tree = route_ctx.route_trees[net_id].value();
+    load_one_net_delay_recurr(tree.root(), net_pin_delays); // recursively traverse the tree and load the sink delays
 
-        net_delay[net_id][ipin] = itr->second; // search for the value of Tdel in the ipin map and load into net_delay
+    for (unsigned int ipin = 1; ipin < net_pin_delays.size(); ipin++) {
+        VTR_ASSERT(!std::isnan(net_pin_delays[ipin]));
     }
-    ipin_to_Tdel_map.clear(); // clear the map
 }
 
-static void load_one_net_delay_recurr(const RouteTreeNode& rt_node, ParentNetId net_id) {
+static void load_one_net_delay_recurr(const RouteTreeNode& rt_node, vtr::array_view<float> net_pin_delays) {
     /* This routine recursively traverses the route tree, and copies the Tdel of the sink_type nodes *
-     * into the map.                                                                                 */
-    if (rt_node.net_pin_index != OPEN) {                        // value of OPEN indicates a non-SINK
-        ipin_to_Tdel_map[rt_node.net_pin_index] = rt_node.Tdel; // add to the map, process current sink-type node
+     * into their net pin's delay.                                                                   */
+    if (rt_node.net_pin_index != OPEN) {                    // value of OPEN indicates a non-SINK
+        net_pin_delays[rt_node.net_pin_index] = rt_node.Tdel; // process current sink-type node
     }
 
     for (auto& child : rt_node.child_nodes()) { // process children
-        load_one_net_delay_recurr(child, net_id);
+        load_one_net_delay_recurr(child, net_pin_delays);
     }
 }
-
 static void load_one_constant_net_delay(const Netlist<>& net_list,
                                         NetPinsMatrix<float>& net_delay,
                                         ParentNetId net_id,
@@ -1,6 +1,8 @@
 #include "read_sdc.h"
 
+#include <algorithm>
 #include <regex>
+#include <unordered_map>
 
 #include "vtr_log.h"
 #include "vtr_assert.h"
@@ -16,6 +18,10 @@
 #include "atom_netlist_utils.h"
 #include "atom_lookup.h"
 
+#if defined(VPR_USE_TBB)
+#    include <tbb/parallel_for.h>
+#endif
+
 void apply_default_timing_constraints(const AtomNetlist& netlist,
                                       const AtomLookup& lookup,
                                       tatum::TimingConstraints& timing_constraints);
@@ -50,6 +56,76 @@ std::map<std::string, AtomPinId> find_netlist_primary_ios(const AtomNetlist& net
 std::string orig_blif_name(std::string name);
 
 std::regex glob_pattern_to_regex(const std::string& glob_pattern);
+bool is_plain_glob_pattern(const std::string& glob_pattern);
+bool glob_match(const char* name, const char* glob_pattern);
+
+//Look-up of netlist objects (e.g. ports, pins) by name, for matching SDC target patterns
+//
+//The names are kept sorted, so the names matching a pattern with only '*' wildcards are found
+//among those sharing its literal prefix (up to the first '*') by binary search, rather than by
+//matching against every name. Other patterns (which may use regex syntax, see
+//glob_pattern_to_regex()) are matched against every name, in parallel if enabled.
+//
+//The matches of each pattern are memoized, since SDC files often repeat the same targets
+//across many constraints.
+template<typename Id>
+class SdcNameIndex {
+  public:
+    SdcNameIndex() = default;
+
+    explicit SdcNameIndex(std::vector<std::pair<std::string, Id>> names)
+        : names_(std::move(names)) {
+        std::sort(names_.begin(), names_.end());
+    }
+
+    //Returns the ids of the objects whose name matches glob_pattern
+    const std::vector<Id>& find_matches(const std::string& glob_pattern) {
+        auto iter = matches_.find(glob_pattern);
+        if (iter != matches_.end()) {
+            return iter->second;
+        }
+
+        std::vector<Id> matches;
+        if (is_plain_glob_pattern(glob_pattern)) {
+            std::string prefix = glob_pattern.substr(0, glob_pattern.find('*'));
+
+            auto first = std::lower_bound(names_.begin(), names_.end(), prefix,
+                                          [](const std::pair<std::string, Id>& name, const std::string& value) {
+                                              return name.first < value;
+                                          });
+            for (auto name_iter = first; name_iter != names_.end() && name_iter->first.compare(0, prefix.size(), prefix) == 0; ++name_iter) {
+                if (glob_match(name_iter->first.c_str(), glob_pattern.c_str())) {
+                    matches.push_back(name_iter->second);
+                }
+            }
+        } else {
+            std::regex pattern_regex = glob_pattern_to_regex(glob_pattern);
+
+            std::vector<char> is_match(names_.size(), false);
+            auto match_name = [&](size_t iname) {
+                is_match[iname] = std::regex_match(names_[iname].first, pattern_regex);
+            };
+#if defined(VPR_USE_TBB)
+            tbb::parallel_for(size_t(0), names_.size(), match_name);
+#else
+            for (size_t iname = 0; iname < names_.size(); ++iname) {
+                match_name(iname);
+            }
+#endif
+            for (size_t iname = 0; iname < names_.size(); ++iname) {
+                if (is_match[iname]) {
+                    matches.push_back(names_[iname].second);
+                }
+            }
+        }
+
+        return matches_.emplace(glob_pattern, std::move(matches)).first->second;
+    }
+
+  private:
+    std::vector<std::pair<std::string, Id>> names_; //Sorted by name
+    std::unordered_map<std::string, std::vector<Id>> matches_;
+};
 
 class SdcParseCallback : public sdcparse::Callback {
   public:
@@ -67,6 +143,8 @@ class SdcParseCallback : public sdcparse::Callback {
     void start_parse() override {
         netlist_clock_drivers_ = find_netlist_logical_clock_drivers(netlist_);
         netlist_primary_ios_ = find_netlist_primary_ios(netlist_);
+
+        primary_io_index_ = SdcNameIndex<AtomPinId>(std::vector<std::pair<std::string, AtomPinId>>(netlist_primary_ios_.begin(), netlist_primary_ios_.end()));
     }
 
     //Sets current filename
@@ -871,21 +949,10 @@ class SdcParseCallback : public sdcparse::Callback {
 
         std::set<AtomPinId> pins;
         for (const auto& port_pattern : port_group.strings) {
-            std::regex port_regex = glob_pattern_to_regex(port_pattern);
-
-            bool found = false;
-            for (const auto& kv : netlist_primary_ios_) {
-                const std::string& io_name = kv.first;
-                if (std::regex_match(io_name, port_regex)) {
-                    found = true;
+            const auto& matching_pins = primary_io_index_.find_matches(port_pattern);
+            pins.insert(matching_pins.begin(), matching_pins.end());
 
-                    AtomPinId pin = kv.second;
-
-                    pins.insert(pin);
-                }
-            }
-
-            if (!found) {
+            if (matching_pins.empty()) {
                 VTR_LOGF_WARN(fname_.c_str(), lineno_,
                               "get_ports target name or pattern '%s' matched no ports\n",
                               port_pattern.c_str());
@@ -968,21 +1035,21 @@ class SdcParseCallback : public sdcparse::Callback {
                       "Expected pin collection via get_pins");
         }
 
-        for (const auto& pin_pattern : pin_group.strings) {
-            std::regex pin_regex = glob_pattern_to_regex(pin_pattern);
-
-            bool found = false;
+        if (!pin_index_) {
+            //Built on first use, since most SDC files never refer to individual pins
+            std::vector<std::pair<std::string, AtomPinId>> pin_names;
+            pin_names.reserve(netlist_.pins().size());
             for (AtomPinId pin : netlist_.pins()) {
-                const std::string& pin_name = netlist_.pin_name(pin);
-
-                if (std::regex_match(pin_name, pin_regex)) {
-                    found = true;
-
-                    pins.insert(pin);
-                }
+                pin_names.emplace_back(netlist_.pin_name(pin), pin);
             }
+            pin_index_ = std::make_unique<SdcNameIndex<AtomPinId>>(std::move(pin_names));
+        }
 
-            if (!found) {
+        for (const auto& pin_pattern : pin_group.strings) {
+            const auto& matching_pins = pin_index_->find_matches(pin_pattern);
+            pins.insert(matching_pins.begin(), matching_pins.end());
+
+            if (matching_pins.empty()) {
                 VTR_LOGF_WARN(fname_.c_str(), lineno_,
                               "get_pins target name or pattern '%s' matched no pins\n",
                               pin_pattern.c_str());
@@ -1047,6 +1114,9 @@ class SdcParseCallback : public sdcparse::Callback {
     std::set<AtomPinId> netlist_clock_drivers_;
     std::map<std::string, AtomPinId> netlist_primary_ios_;
 
+    SdcNameIndex<AtomPinId> primary_io_index_;
+    std::unique_ptr<SdcNameIndex<AtomPinId>> pin_index_;
+
     std::set<std::pair<tatum::DomainId, tatum::DomainId>> disabled_domain_pairs_;
     std::map<std::pair<tatum::DomainId, tatum::DomainId>, float> setup_override_constraints_;
     std::map<std::pair<tatum::DomainId, tatum::DomainId>, float> hold_override_constraints_;
@@ -1331,3 +1401,38 @@ std::regex glob_pattern_to_regex(const std::string& glob_pattern) {
 
     return std::regex(regex_str);
 }
+
+//Returns true if glob_pattern uses no regex syntax (beyond the '*' wildcard and literal '.'
+//handled by glob_pattern_to_regex()), and so can be matched with glob_match()
+bool is_plain_glob_pattern(const std::string& glob_pattern) {
+    return glob_pattern.find_first_of("\\^$|?+()[]{}") == std::string::npos;
+}
+
+//Returns true if name matches glob_pattern, where '*' matches any sequence of characters
+//and every other character matches itself
+bool glob_match(const char* name, const char* glob_pattern) {
+    //Position to resume from if the characters after the last '*' fail to match
+    const char* star_pattern = nullptr;
+    const char* star_name = nullptr;
+
+    while (*name) {
+        if (*glob_pattern == '*') {
+            star_pattern = ++glob_pattern;
+            star_name = name;
+        } else if (*glob_pattern == *name) {
+            ++glob_pattern;
+            ++name;
+        } else if (star_pattern) {
+            //Let the last '*' match one more character
+            glob_pattern = star_pattern;
+            name = ++star_name;
+        } else {
+            return false;
+        }
+    }
+
+    while (*glob_pattern == '*') {
+        ++glob_pattern;
+    }
+    return *glob_pattern == '\0';
+}
@@ -120,16 +120,12 @@ AtomPinId SetupSlackCrit::update_pin_slack(const tatum::NodeId node, const tatum
 
     VTR_ASSERT_SAFE(is_external_tnode(pin, node));
 
-    //Find the worst (least) slack at this node
-    auto tags = analyzer.setup_slacks(node);
-    auto min_tag_iter = find_minimum_tag(tags);
-
-    float new_slack = std::numeric_limits<float>::quiet_NaN();
-    if (min_tag_iter != tags.end()) {
-        new_slack = min_tag_iter->time().value();
-    } else {
-        //No tags (e.g. driven by constant generator)
-        new_slack = std::numeric_limits<float>::infinity();
+    //Find the worst (least) slack at this node, over all timing corners
+    //
+    //No tags (e.g. driven by constant generator) leaves an infinite slack
+    float new_slack = std::numeric_limits<float>::infinity();
+    for (auto& tag : analyzer.setup_slacks(node)) {
+        new_slack = std::min(new_slack, tag.time().min_value());
     }
 
     if (pin_slacks_[pin] != new_slack) {
@@ -235,7 +231,7 @@ bool SetupSlackCrit::incr_update_max_req_and_worst_slack(const tatum::TimingGrap
         for (auto& tag : analyzer.setup_tags(node, tatum::TagType::DATA_REQUIRED)) {
             auto domain_pair = DomainPair(tag.launch_clock_domain(), tag.capture_clock_domain());
 
-            float req = tag.time().value();
+            float req = tag.time().max_value(); //Latest over all timing corners
 
             VTR_ASSERT_SAFE(max_req_.count(domain_pair));
             float prev_req = max_req_[domain_pair];
@@ -259,7 +255,7 @@ bool SetupSlackCrit::incr_update_max_req_and_worst_slack(const tatum::TimingGrap
         for (auto& tag : analyzer.setup_slacks(node)) {
             auto domain_pair = DomainPair(tag.launch_clock_domain(), tag.capture_clock_domain());
 
-            float slack = tag.time().value();
+            float slack = tag.time().min_value(); //Worst over all timing corners
 
             VTR_ASSERT_SAFE_MSG(!std::isnan(slack), "Slack should not be nan");
             VTR_ASSERT_SAFE_MSG(std::isfinite(slack), "Slack should not be infinite");
@@ -308,7 +304,7 @@ void SetupSlackCrit::recompute_max_req_and_worst_slack(const tatum::TimingGraph&
         for (auto& tag : analyzer.setup_tags(node, tatum::TagType::DATA_REQUIRED)) {
             auto domain_pair = DomainPair(tag.launch_clock_domain(), tag.capture_clock_domain());
 
-            float req = tag.time().value();
+            float req = tag.time().max_value();
             if (!max_req_.count(domain_pair) || max_req_[domain_pair] < req) {
                 max_req_[domain_pair] = req;
                 max_req_node_[domain_pair] = node; //Record dominant node to help later  incremental updates
@@ -318,7 +314,7 @@ void SetupSlackCrit::recompute_max_req_and_worst_slack(const tatum::TimingGraph&
         for (auto& tag : analyzer.setup_slacks(node)) {
             auto domain_pair = DomainPair(tag.launch_clock_domain(), tag.capture_clock_domain());
 
-            float slack = tag.time().value();
+            float slack = tag.time().min_value();
 
             VTR_ASSERT_SAFE_MSG(!std::isnan(slack), "Slack should not be nan");
             VTR_ASSERT_SAFE_MSG(std::isfinite(slack), "Slack should not be infinite");
@@ -510,15 +506,14 @@ void HoldSlackCrit::update_pin_slack(const AtomPinId pin, const tatum::HoldTimin
     tatum::NodeId node = netlist_lookup_.atom_pin_tnode(pin);
     VTR_ASSERT(node);
 
-    //Find the worst (least) slack at this node
-    auto tags = analyzer.hold_slacks(node);
-    auto min_tag_iter = find_minimum_tag(tags);
-    if (min_tag_iter != tags.end()) {
-        pin_slacks_[pin] = min_tag_iter->time().value();
-    } else {
-        //No tags (e.g. driven by constant generator)
-        pin_slacks_[pin] = std::numeric_limits<float>::infinity();
+    //Find the worst (least) slack at this node, over all timing corners
+    //
+    //No tags (e.g. driven by constant generator) leaves an infinite slack
+    float new_slack = std::numeric_limits<float>::infinity();
+    for (auto& tag : analyzer.hold_slacks(node)) {
+        new_slack = std::min(new_slack, tag.time().min_value());
     }
+    pin_slacks_[pin] = new_slack;
 }
 
 void HoldSlackCrit::update_criticalities(const tatum::TimingGraph& timing_graph, const tatum::HoldTimingAnalyzer& analyzer) {
@@ -528,7 +523,7 @@ void HoldSlackCrit::update_criticalities(const tatum::TimingGraph& timing_graph,
     float best_slack = -std::numeric_limits<float>::infinity();
     for (tatum::NodeId node : timing_graph.nodes()) {
         for (auto& tag : analyzer.hold_slacks(node)) {
-            float slack = tag.time().value();
+            float slack = tag.time().min_value(); //Worst over all timing corners
             worst_slack = std::min(worst_slack, slack);
             best_slack = std::max(best_slack, slack);
         }
@@ -563,7 +558,7 @@ float HoldSlackCrit::calc_pin_criticality(AtomPinId pin,
     float criticality = 0.;
 
     for (auto tag : analyzer.hold_slacks(node)) {
-        float slack = tag.time().value();
+        float slack = tag.time().min_value();
 
         float tag_criticality = 1. - scale * (slack + shift);
 
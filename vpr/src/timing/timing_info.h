@@ -137,6 +137,15 @@ class HoldTimingInfo : public virtual TimingInfo {
 class SetupHoldTimingInfo : public SetupTimingInfo, public HoldTimingInfo {
   public:
     virtual std::shared_ptr<const tatum::SetupHoldTimingAnalyzer> setup_hold_analyzer() const = 0;
+
+  public:
+    //Mutators
+
+    //Analyze hold fully only on every full_hold_update_interval-th update(). The other
+    //updates re-analyze hold only in the fanin of the endpoints whose hold slack was below
+    //hold_slack_threshold at the last full hold analysis (elsewhere the hold slacks are left
+    //as of that analysis). An interval of 0 or 1 analyzes hold fully on every update().
+    virtual void set_hold_pruning(size_t full_hold_update_interval, float hold_slack_threshold) = 0;
 };
 
 #endif
@@ -307,6 +307,18 @@ void print_setup_timing_summary(const tatum::TimingConstraints& constraints,
 
     VTR_LOG("%ssetup Worst Negative Slack (sWNS): %g ns\n", prefix.c_str(), setup_worst_neg_slack);
     VTR_LOG("%ssetup Total Negative Slack (sTNS): %g ns\n", prefix.c_str(), setup_total_neg_slack);
+    if (tatum::Time::num_lanes() > 1) {
+        //The values above are those of the first timing corner
+        for (size_t icorner = 0; icorner < tatum::Time::num_lanes(); ++icorner) {
+            float corner_wns = 0.;
+            for (tatum::NodeId node : timing_ctx.graph->logical_outputs()) {
+                for (tatum::TimingTag tag : setup_analyzer.setup_slacks(node)) {
+                    corner_wns = std::min(corner_wns, tag.time().lane_value(icorner));
+                }
+            }
+            VTR_LOG("%stiming corner %zu sWNS: %g ns\n", prefix.c_str(), icorner, sec_to_nanosec(corner_wns));
+        }
+    }
     VTR_LOG("\n");
 
     VTR_LOG("%ssetup slack histogram:\n", prefix.c_str());
@@ -754,7 +766,7 @@ float calc_relaxed_criticality(const std::map<DomainPair, float>& domains_max_re
     for (const auto& tag : tags) {
         VTR_ASSERT_MSG(tag.type() == tatum::TagType::SLACK, "Tags must be slacks to calculate criticality");
 
-        float slack = tag.time().value();
+        float slack = tag.time().min_value(); //Worst over all timing corners
 
         auto domain_pair = DomainPair(tag.launch_clock_domain(), tag.capture_clock_domain());
 
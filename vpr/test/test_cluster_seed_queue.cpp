@@ -0,0 +1,92 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "atom_netlist_fwd.h"
+#include "cluster_seed_queue.h"
+#include "vtr_vector.h"
+
+namespace {
+
+// Pops every atom of the queue, in order
+std::vector<AtomBlockId> drain(ClusterSeedQueue& queue) {
+    std::vector<AtomBlockId> order;
+    while (!queue.empty()) {
+        AtomBlockId blk_id = queue.top();
+        order.push_back(blk_id);
+        queue.remove(blk_id);
+    }
+    return order;
+}
+
+// The seed order given by the stable sort of the atoms by descending gain
+std::vector<AtomBlockId> sorted_seeds(const vtr::vector<AtomBlockId, float>& gains) {
+    std::vector<AtomBlockId> seeds(gains.keys().begin(), gains.keys().end());
+    std::stable_sort(seeds.begin(), seeds.end(), [&](AtomBlockId lhs, AtomBlockId rhs) {
+        return gains[lhs] > gains[rhs];
+    });
+    return seeds;
+}
+
+TEST_CASE("cluster_seed_queue_matches_the_stable_sort", "[vpr_pack]") {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> gain_dist(0, 9); //Plenty of ties
+
+    vtr::vector<AtomBlockId, float> gains;
+    for (int i = 0; i < 500; ++i) {
+        gains.push_back(gain_dist(rng) / 4.f);
+    }
+
+    ClusterSeedQueue queue(gains);
+    REQUIRE(queue.size() == gains.size());
+    REQUIRE(drain(queue) == sorted_seeds(gains));
+}
+
+TEST_CASE("cluster_seed_queue_ties_by_atom_id", "[vpr_pack]") {
+    vtr::vector<AtomBlockId, float> gains(4, 1.f);
+    gains[AtomBlockId(2)] = 2.f;
+
+    ClusterSeedQueue queue(gains);
+    std::vector<AtomBlockId> expected = {AtomBlockId(2), AtomBlockId(0), AtomBlockId(1), AtomBlockId(3)};
+    REQUIRE(drain(queue) == expected);
+    REQUIRE(queue.empty());
+}
+
+TEST_CASE("cluster_seed_queue_remove_and_update", "[vpr_pack]") {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> gain_dist(0.f, 1.f);
+
+    vtr::vector<AtomBlockId, float> gains;
+    for (int i = 0; i < 200; ++i) {
+        gains.push_back(gain_dist(rng));
+    }
+    ClusterSeedQueue queue(gains);
+
+    // Absorb some atoms (out of order), and change the gains of others
+    for (size_t i = 0; i < gains.size(); i += 3) {
+        AtomBlockId blk_id(i);
+        queue.remove(blk_id);
+        REQUIRE(!queue.contains(blk_id));
+        queue.remove(blk_id); //No-op
+    }
+    for (size_t i = 1; i < gains.size(); i += 5) {
+        AtomBlockId blk_id(i);
+        if (!queue.contains(blk_id)) continue;
+        gains[blk_id] = gain_dist(rng) * 2.f;
+        queue.update_gain(blk_id, gains[blk_id]);
+        REQUIRE(queue.gain(blk_id) == gains[blk_id]);
+    }
+
+    std::vector<AtomBlockId> expected;
+    for (AtomBlockId blk_id : sorted_seeds(gains)) {
+        if (size_t(blk_id) % 3 != 0) {
+            expected.push_back(blk_id);
+        }
+    }
+    REQUIRE(queue.size() == expected.size());
+    REQUIRE(drain(queue) == expected);
+}
+
+} // namespace
@@ -72,6 +72,7 @@ TEST_CASE("test_compressed_grid", "[vpr_compressed_grid]") {
 
 
     t_physical_tile_type empty_tile;
+    empty_tile.index = 0;
     empty_tile.name = empty_tile_name;
     empty_tile.height = 1;
     empty_tile.width = 1;
@@ -90,6 +91,7 @@ TEST_CASE("test_compressed_grid", "[vpr_compressed_grid]") {
 
     // create an io physical tile and assign its parameters
     t_physical_tile_type io_tile;
+    io_tile.index = 1;
     io_tile.name = io_tile_name;
     io_tile.height = 1;
     io_tile.width = 1;
@@ -105,6 +107,7 @@ TEST_CASE("test_compressed_grid", "[vpr_compressed_grid]") {
 
     // create a small tile and assign its parameters
     t_physical_tile_type small_tile;
+    small_tile.index = 2;
     small_tile.name = small_tile_name;
     small_tile.height = 1;
     small_tile.width = 1;
@@ -120,6 +123,7 @@ TEST_CASE("test_compressed_grid", "[vpr_compressed_grid]") {
 
     // create a small tile and assign its parameters
     t_physical_tile_type tall_tile;
+    tall_tile.index = 3;
     tall_tile.name = tall_tile_name;
     tall_tile.height = 4;
     tall_tile.width = 1;
@@ -135,6 +139,7 @@ TEST_CASE("test_compressed_grid", "[vpr_compressed_grid]") {
     tall_tile.sub_tiles.back().equivalent_sites.push_back(&tall_logical_type);
 
     t_physical_tile_type large_tile;
+    large_tile.index = 4;
     large_tile.name = large_tile_name;
     large_tile.height = 3;
     large_tile.width = 3;
@@ -330,6 +335,17 @@ TEST_CASE("test_compressed_grid", "[vpr_compressed_grid]") {
         REQUIRE(grid_loc == t_physical_tile_loc{98, 98, 0});
     }
 
+    SECTION("Range of the blocks of a column within a range of rows") {
+        const auto& tall_compressed_grid = compressed_grids[tall_logical_type.index];
+
+        // the first tall column (x = 7) has a block on each of its 18 rows
+        REQUIRE(tall_compressed_grid.get_column_block_map(0, 0).size() == 18);
+        REQUIRE(tall_compressed_grid.get_column_block_range(0, 2, 5, 0) == std::make_pair(2, 6));
+        REQUIRE(tall_compressed_grid.get_column_block_range(0, -3, 1, 0) == std::make_pair(0, 2));
+        REQUIRE(tall_compressed_grid.get_column_block_range(0, 16, 40, 0) == std::make_pair(16, 18));
+        REQUIRE(tall_compressed_grid.get_column_block_range(0, 20, 40, 0) == std::make_pair(18, 18));
+        REQUIRE(tall_compressed_grid.get_column_block_range(0, 5, 4, 0) == std::make_pair(5, 5));
+    }
 }
 
 } // namespace
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include <tuple>
+#include <vector>
 #include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_approx.hpp"
 
 #include "route_net.h"
 #include "rr_graph_fwd.h"
@@ -9,18 +11,23 @@
 #include "net_delay.h"
 #include "place_and_route.h"
 #include "timing_place_lookup.h"
+#include "connection_router.h"
+#include "four_ary_heap.h"
+#include "rr_reverse_edges.h"
+#include "vtr_time.h"
 
 static constexpr const char kArchFile[] = "../../vtr_flow/arch/timing/k6_frac_N10_mem32K_40nm.xml";
 static constexpr int kMaxHops = 10;
 
 namespace {
 
-// Route from source_node to sink_node, returning either the delay, or infinity if unroutable.
-static float do_one_route(RRNodeId source_node,
-                          RRNodeId sink_node,
-                          const t_det_routing_arch& det_routing_arch,
-                          const t_router_opts& router_opts,
-                          const std::vector<t_segment_inf>& segment_inf) {
+// Route from source_node to sink_node with the given heap, returning the delay and
+// path cost of the route, or infinity if unroutable.
+static std::pair<float, float> do_one_route(RRNodeId source_node,
+                                            RRNodeId sink_node,
+                                            e_heap_type heap_type,
+                                            const RouterLookahead& router_lookahead,
+                                            const t_router_opts& router_opts) {
     bool is_flat = router_opts.flat_routing;
     auto& device_ctx = g_vpr_ctx.device();
 
@@ -48,16 +55,11 @@ static float do_one_route(RRNodeId source_node,
     route_budgets budgeting_inf(net_list, is_flat);
 
     RouterStats router_stats;
-    auto router_lookahead = make_router_lookahead(det_routing_arch,
-                                                  router_opts.lookahead_type,
-                                                  router_opts.write_router_lookahead,
-                                                  router_opts.read_router_lookahead,
-                                                  segment_inf,
-                                                  is_flat);
 
-    ConnectionRouter<FourAryHeap> router(
+    auto router = make_connection_router(
+        heap_type,
         device_ctx.grid,
-        *router_lookahead,
+        router_lookahead,
         device_ctx.rr_graph.rr_nodes(),
         &device_ctx.rr_graph,
         device_ctx.rr_rc_data,
@@ -72,15 +74,16 @@ static float do_one_route(RRNodeId source_node,
                                      -1,
                                      false,
                                      std::unordered_map<RRNodeId, int>());
-    std::tie(found_path, std::ignore, cheapest) = router.timing_driven_route_connection_from_route_tree(tree.root(),
-                                                                                                        sink_node,
-                                                                                                        cost_params,
-                                                                                                        bounding_box,
-                                                                                                        router_stats,
-                                                                                                        conn_params);
+    std::tie(found_path, std::ignore, cheapest) = router->timing_driven_route_connection_from_route_tree(tree.root(),
+                                                                                                         sink_node,
+                                                                                                         cost_params,
+                                                                                                         bounding_box,
+                                                                                                         router_stats,
+                                                                                                         conn_params);
 
     // Default delay is infinity, which indicates that a route was not found.
     float delay = std::numeric_limits<float>::infinity();
+    float path_cost = std::numeric_limits<float>::infinity();
     if (found_path) {
         // Check that the route goes to the requested sink.
         REQUIRE(RRNodeId(cheapest.index) == sink_node);
@@ -89,11 +92,25 @@ static float do_one_route(RRNodeId source_node,
         vtr::optional<const RouteTreeNode&> rt_node_of_sink;
         std::tie(std::ignore, rt_node_of_sink) = tree.update_from_heap(&cheapest, OPEN, nullptr, router_opts.flat_routing);
         delay = rt_node_of_sink.value().Tdel;
+        path_cost = cheapest.backward_path_cost;
     }
 
     // Reset for the next router call.
-    router.reset_path_costs();
-    return delay;
+    router->reset_path_costs();
+    return std::make_pair(delay, path_cost);
+}
+
+// Build the lookahead the router uses, as configured by router_opts.
+static std::unique_ptr<RouterLookahead> make_test_router_lookahead(const t_det_routing_arch& det_routing_arch,
+                                                                   const t_router_opts& router_opts,
+                                                                   const std::vector<t_segment_inf>& segment_inf) {
+    return make_router_lookahead(det_routing_arch,
+                                 router_opts.lookahead_type,
+                                 router_opts.write_router_lookahead,
+                                 router_opts.read_router_lookahead,
+                                 router_opts.timing_model_cache_dir,
+                                 segment_inf,
+                                 router_opts.flat_routing);
 }
 
 // Find a source and a sink by walking edges.
@@ -124,6 +141,29 @@ std::tuple<RRNodeId, RRNodeId, int> find_source_and_sink() {
     return longest;
 }
 
+// Find up to max_pairs distinct sources with walks of at least min_hops to a sink.
+static std::vector<std::pair<RRNodeId, RRNodeId>> find_sources_and_sinks(size_t max_pairs, int min_hops) {
+    auto& rr_graph = g_vpr_ctx.device().rr_graph;
+
+    std::vector<std::pair<RRNodeId, RRNodeId>> pairs;
+    size_t stride = std::max<size_t>(1, rr_graph.num_nodes() / max_pairs);
+    for (size_t id = 0; id < rr_graph.num_nodes() && pairs.size() < max_pairs; id += stride) {
+        RRNodeId source(id), sink = source;
+        int hops = 0;
+        for (; hops < kMaxHops; hops++) {
+            auto edge = rr_graph.node_first_edge(sink);
+            if (edge == rr_graph.node_last_edge(sink)) {
+                break;
+            }
+            sink = rr_graph.rr_nodes().edge_sink_node(edge);
+        }
+        if (hops >= min_hops && source != sink) {
+            pairs.emplace_back(source, sink);
+        }
+    }
+    return pairs;
+}
+
 // Test that the router can route nets individually, not considering congestion.
 // This is a minimal timing driven routing test that can be used as documentation,
 // and as a starting point for experimentation.
@@ -178,11 +218,15 @@ TEST_CASE("connection_router", "[vpr]") {
     REQUIRE(hops >= 3);
 
     // Find the route
+    auto router_lookahead = make_test_router_lookahead(vpr_setup.RoutingArch,
+                                                       vpr_setup.RouterOpts,
+                                                       vpr_setup.Segments);
     float delay = do_one_route(source_rr_node,
                                sink_rr_node,
-                               vpr_setup.RoutingArch,
-                               vpr_setup.RouterOpts,
-                               vpr_setup.Segments);
+                               router_opts.router_heap,
+                               *router_lookahead,
+                               vpr_setup.RouterOpts)
+                      .first;
 
     // Check that a route was found
     REQUIRE(delay < std::numeric_limits<float>::infinity());
@@ -193,4 +237,246 @@ TEST_CASE("connection_router", "[vpr]") {
                  vpr_setup);
 }
 
+// Compare the heap implementations on the same set of connections.
+//
+// The exact heaps (binary, four_ary and radix) must find routes of the same cost
+// when the search is a plain Dijkstra (astar_fac = 0), since they pop nodes in the
+// same cost order. The time taken by each heap on the A* search is reported as a
+// simple benchmark.
+TEST_CASE("connection_router_heaps", "[vpr]") {
+    auto options = t_options();
+    auto arch = t_arch();
+    auto vpr_setup = t_vpr_setup();
+
+    vpr_install_signal_handler();
+    vpr_initialize_logging();
+
+    const char* argv[] = {
+        "test_vpr",
+        kArchFile,
+        "wire.eblif",
+        "--route_chan_width", "100"};
+    vpr_init(sizeof(argv) / sizeof(argv[0]), argv,
+             &options, &vpr_setup, &arch);
+
+    vpr_create_device_grid(vpr_setup, arch);
+    vpr_setup_clock_networks(vpr_setup, arch);
+    auto det_routing_arch = &vpr_setup.RoutingArch;
+    auto& router_opts = vpr_setup.RouterOpts;
+    t_graph_type graph_directionality;
+
+    if (router_opts.route_type == GLOBAL) {
+        graph_directionality = GRAPH_BIDIR;
+    } else {
+        graph_directionality = (det_routing_arch->directionality == BI_DIRECTIONAL ? GRAPH_BIDIR : GRAPH_UNIDIR);
+    }
+
+    auto chan_width = init_chan(vpr_setup.RouterOpts.fixed_channel_width, arch.Chans, graph_directionality);
+
+    alloc_routing_structs(
+        chan_width,
+        vpr_setup.RouterOpts,
+        &vpr_setup.RoutingArch,
+        vpr_setup.Segments,
+        arch.Directs,
+        arch.num_directs,
+        router_opts.flat_routing);
+
+    auto pairs = find_sources_and_sinks(/*max_pairs=*/50, /*min_hops=*/3);
+    REQUIRE(!pairs.empty());
+
+    auto router_lookahead = make_test_router_lookahead(vpr_setup.RoutingArch,
+                                                       vpr_setup.RouterOpts,
+                                                       vpr_setup.Segments);
+
+    const std::vector<std::pair<e_heap_type, const char*>> exact_heaps = {
+        {e_heap_type::BINARY_HEAP, "binary"},
+        {e_heap_type::FOUR_ARY_HEAP, "four_ary"},
+        {e_heap_type::RADIX_HEAP, "radix"},
+        {e_heap_type::EIGHT_ARY_HEAP, "eight_ary"}};
+
+    // Exact heaps find the same shortest paths
+    t_router_opts dijkstra_opts = router_opts;
+    dijkstra_opts.astar_fac = 0.;
+    for (const auto& pair : pairs) {
+        float ref_cost = do_one_route(pair.first, pair.second, e_heap_type::BINARY_HEAP, *router_lookahead, dijkstra_opts).second;
+        REQUIRE(ref_cost < std::numeric_limits<float>::infinity());
+
+        for (const auto& heap : exact_heaps) {
+            float cost = do_one_route(pair.first, pair.second, heap.first, *router_lookahead, dijkstra_opts).second;
+            CHECK(cost == Catch::Approx(ref_cost));
+        }
+    }
+
+    // Benchmark all heaps on the A* search
+    auto all_heaps = exact_heaps;
+    all_heaps.emplace_back(e_heap_type::BUCKET_HEAP_APPROXIMATION, "bucket");
+    for (const auto& heap : all_heaps) {
+        vtr::Timer timer;
+        for (const auto& pair : pairs) {
+            float delay = do_one_route(pair.first, pair.second, heap.first, *router_lookahead, router_opts).first;
+            CHECK(delay < std::numeric_limits<float>::infinity());
+        }
+        VTR_LOG("Routed %zu connections with the %s heap in %g seconds\n",
+                pairs.size(), heap.second, timer.elapsed_sec());
+    }
+
+    free_routing_structs();
+    vpr_free_all(arch,
+                 vpr_setup);
+}
+
+// Route from source_node to sink_node with the bidirectional search, returning
+// the delay of the route, or infinity if unroutable.
+static float do_one_bidirectional_route(RRNodeId source_node,
+                                        RRNodeId sink_node,
+                                        const RouterLookahead& router_lookahead,
+                                        const RRReverseEdges& reverse_edges,
+                                        const t_router_opts& router_opts) {
+    auto& device_ctx = g_vpr_ctx.device();
+
+    RouteTree tree((RRNodeId(source_node)));
+    update_rr_base_costs(1);
+
+    t_bb bounding_box;
+    bounding_box.xmin = 0;
+    bounding_box.xmax = device_ctx.grid.width() + 1;
+    bounding_box.ymin = 0;
+    bounding_box.ymax = device_ctx.grid.height() + 1;
+    bounding_box.layer_min = 0;
+    bounding_box.layer_max = device_ctx.grid.get_num_layers() - 1;
+
+    t_conn_cost_params cost_params;
+    cost_params.criticality = router_opts.max_criticality;
+    cost_params.astar_fac = router_opts.astar_fac;
+    cost_params.astar_offset = router_opts.astar_offset;
+    cost_params.bend_cost = router_opts.bend_cost;
+
+    ConnectionRouter<FourAryHeap> router(
+        device_ctx.grid,
+        router_lookahead,
+        device_ctx.rr_graph.rr_nodes(),
+        &device_ctx.rr_graph,
+        device_ctx.rr_rc_data,
+        device_ctx.rr_graph.rr_switch(),
+        g_vpr_ctx.mutable_routing().rr_node_route_inf,
+        router_opts.flat_routing);
+
+    RouterStats router_stats;
+    bool found_path;
+    t_heap cheapest;
+    std::tie(found_path, std::ignore, cheapest) = router.timing_driven_route_connection_bidirectional(tree.root(),
+                                                                                                      sink_node,
+                                                                                                      cost_params,
+                                                                                                      bounding_box,
+                                                                                                      reverse_edges,
+                                                                                                      router_stats);
+
+    float delay = std::numeric_limits<float>::infinity();
+    if (found_path) {
+        REQUIRE(RRNodeId(cheapest.index) == sink_node);
+
+        vtr::optional<const RouteTreeNode&> rt_node_of_sink;
+        std::tie(std::ignore, rt_node_of_sink) = tree.update_from_heap(&cheapest, OPEN, nullptr, router_opts.flat_routing);
+        delay = rt_node_of_sink.value().Tdel;
+    }
+
+    router.reset_path_costs();
+    return delay;
+}
+
+// Check that the bidirectional search finds paths as fast as the forward search.
+//
+// With a plain Dijkstra search (astar_fac = 0), purely delay driven (criticality 1)
+// and on an architecture with buffered switches, both searches find shortest
+// delay paths, so the delays must match.
+TEST_CASE("connection_router_bidirectional", "[vpr]") {
+    auto options = t_options();
+    auto arch = t_arch();
+    auto vpr_setup = t_vpr_setup();
+
+    vpr_install_signal_handler();
+    vpr_initialize_logging();
+
+    const char* argv[] = {
+        "test_vpr",
+        kArchFile,
+        "wire.eblif",
+        "--route_chan_width", "100"};
+    vpr_init(sizeof(argv) / sizeof(argv[0]), argv,
+             &options, &vpr_setup, &arch);
+
+    vpr_create_device_grid(vpr_setup, arch);
+    vpr_setup_clock_networks(vpr_setup, arch);
+    auto det_routing_arch = &vpr_setup.RoutingArch;
+    auto& router_opts = vpr_setup.RouterOpts;
+    t_graph_type graph_directionality;
+
+    if (router_opts.route_type == GLOBAL) {
+        graph_directionality = GRAPH_BIDIR;
+    } else {
+        graph_directionality = (det_routing_arch->directionality == BI_DIRECTIONAL ? GRAPH_BIDIR : GRAPH_UNIDIR);
+    }
+
+    auto chan_width = init_chan(vpr_setup.RouterOpts.fixed_channel_width, arch.Chans, graph_directionality);
+
+    alloc_routing_structs(
+        chan_width,
+        vpr_setup.RouterOpts,
+        &vpr_setup.RoutingArch,
+        vpr_setup.Segments,
+        arch.Directs,
+        arch.num_directs,
+        router_opts.flat_routing);
+
+    const auto& rr_graph = g_vpr_ctx.device().rr_graph;
+    RRReverseEdges reverse_edges(rr_graph.rr_nodes().view());
+
+    // Every edge appears exactly once, as an in edge of its sink
+    size_t num_in_edges = 0;
+    size_t num_edges = 0;
+    for (size_t id = 0; id < rr_graph.num_nodes(); id++) {
+        RRNodeId node(id);
+        num_edges += rr_graph.num_edges(node);
+        auto in_edges = reverse_edges.in_edges(node);
+        auto in_nodes = reverse_edges.in_nodes(node);
+        REQUIRE(in_edges.size() == in_nodes.size());
+        for (size_t i = 0; i < in_edges.size(); ++i) {
+            CHECK(rr_graph.rr_nodes().edge_sink_node(in_edges[i]) == node);
+            CHECK(rr_graph.edge_src_node(in_edges[i]) == in_nodes[i]);
+        }
+        num_in_edges += in_edges.size();
+    }
+    CHECK(num_in_edges == num_edges);
+
+    auto pairs = find_sources_and_sinks(/*max_pairs=*/50, /*min_hops=*/3);
+    REQUIRE(!pairs.empty());
+
+    auto router_lookahead = make_test_router_lookahead(vpr_setup.RoutingArch,
+                                                       vpr_setup.RouterOpts,
+                                                       vpr_setup.Segments);
+
+    t_router_opts dijkstra_opts = router_opts;
+    dijkstra_opts.astar_fac = 0.;
+    dijkstra_opts.max_criticality = 1.;
+    dijkstra_opts.bend_cost = 0.;
+    for (const auto& pair : pairs) {
+        float ref_delay = do_one_route(pair.first, pair.second, e_heap_type::FOUR_ARY_HEAP, *router_lookahead, dijkstra_opts).first;
+        REQUIRE(ref_delay < std::numeric_limits<float>::infinity());
+
+        float delay = do_one_bidirectional_route(pair.first, pair.second, *router_lookahead, reverse_edges, dijkstra_opts);
+        CHECK(delay == Catch::Approx(ref_delay));
+    }
+
+    // The A* variant still finds a path for every connection
+    for (const auto& pair : pairs) {
+        float delay = do_one_bidirectional_route(pair.first, pair.second, *router_lookahead, reverse_edges, router_opts);
+        CHECK(delay < std::numeric_limits<float>::infinity());
+    }
+
+    free_routing_structs();
+    vpr_free_all(arch,
+                 vpr_setup);
+}
+
 } // namespace
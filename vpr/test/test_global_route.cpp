@@ -0,0 +1,88 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "global_route.h"
+
+#include <vector>
+
+namespace {
+
+//Returns whether the corridor contains the tile loc
+bool contains(const t_bb& bb, vtr::Point<int> loc) {
+    return bb.xmin <= loc.x() && loc.x() <= bb.xmax && bb.ymin <= loc.y() && loc.y() <= bb.ymax;
+}
+
+TEST_CASE("test_global_route_corridors", "[vpr]") {
+    const int grid_size = 32;
+    std::vector<int> chan_widths(grid_size, 10);
+
+    vtr::vector<ParentNetId, std::vector<vtr::Point<int>>> net_pin_locs;
+    //A two-pin net along the bottom of the device, and a net with sinks in opposite corners
+    net_pin_locs.push_back({{1, 1}, {29, 2}});
+    net_pin_locs.push_back({{16, 16}, {1, 30}, {30, 1}, {17, 17}});
+    //An ignored net
+    net_pin_locs.emplace_back();
+
+    GlobalRouteGuides guides;
+    REQUIRE(!guides.is_enabled());
+    guides.compute(grid_size, grid_size, chan_widths, chan_widths, net_pin_locs);
+    REQUIRE(guides.is_enabled());
+    REQUIRE(guides.num_overused_edges() == 0);
+
+    for (ParentNetId net_id : {ParentNetId(0), ParentNetId(1)}) {
+        const auto& locs = net_pin_locs[net_id];
+        REQUIRE(guides.connection_bb(net_id, 0) == nullptr);
+        for (size_t ipin = 1; ipin < locs.size(); ++ipin) {
+            const t_bb* bb = guides.connection_bb(net_id, ipin);
+            REQUIRE(bb != nullptr);
+            REQUIRE(contains(*bb, locs[0]));
+            REQUIRE(contains(*bb, locs[ipin]));
+            REQUIRE(bb->layer_min == OPEN);
+        }
+    }
+
+    //A straight connection gets a narrow corridor: its gcell row and a margin
+    const t_bb* straight = guides.connection_bb(ParentNetId(0), 1);
+    REQUIRE(straight->ymin == 0);
+    REQUIRE(straight->ymax == (1 + GlobalRouteGuides::CORRIDOR_MARGIN) * GlobalRouteGuides::GCELL_SIZE - 1);
+
+    //The sink next to the driver does not span the net
+    const t_bb* near = guides.connection_bb(ParentNetId(1), 3);
+    REQUIRE(near->xmax - near->xmin < grid_size / 2);
+    REQUIRE(near->ymax - near->ymin < grid_size / 2);
+
+    REQUIRE(guides.connection_bb(ParentNetId(2), 0) == nullptr);
+    REQUIRE(guides.connection_bb(ParentNetId(3), 0) == nullptr);
+
+    guides.clear();
+    REQUIRE(!guides.is_enabled());
+}
+
+TEST_CASE("test_global_route_congestion", "[vpr]") {
+    //Channels of a single wire: each gcell edge can take GCELL_SIZE nets
+    const int grid_size = 24;
+    std::vector<int> chan_widths(grid_size, 1);
+
+    //Twice as many nets along the same row as its gcells can take
+    const int num_nets = 2 * GlobalRouteGuides::GCELL_SIZE;
+    vtr::vector<ParentNetId, std::vector<vtr::Point<int>>> net_pin_locs;
+    for (int i = 0; i < num_nets; ++i) {
+        net_pin_locs.push_back({{0, 10}, {23, 10}});
+    }
+
+    GlobalRouteGuides guides;
+    guides.compute(grid_size, grid_size, chan_widths, chan_widths, net_pin_locs);
+
+    //The negotiation moves some of the nets off the row
+    REQUIRE(guides.num_overused_edges() == 0);
+    int num_detours = 0;
+    for (int i = 0; i < num_nets; ++i) {
+        const t_bb* bb = guides.connection_bb(ParentNetId(i), 1);
+        REQUIRE(bb != nullptr);
+        if (bb->ymax - bb->ymin + 1 > (1 + 2 * GlobalRouteGuides::CORRIDOR_MARGIN) * GlobalRouteGuides::GCELL_SIZE) {
+            ++num_detours;
+        }
+    }
+    REQUIRE(num_detours >= GlobalRouteGuides::GCELL_SIZE);
+}
+
+} // namespace
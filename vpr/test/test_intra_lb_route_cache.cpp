@@ -0,0 +1,44 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "cluster_router.h"
+
+namespace {
+
+TEST_CASE("intra_lb_route_cache_counts_hits_and_misses", "[vpr_pack]") {
+    IntraLbRouteCache cache(1024 * 1024);
+
+    IntraLbRouteCache::t_signature sig_a = {0, 1, 2, 4, 7};
+    IntraLbRouteCache::t_signature sig_b = {0, 1, 2, 4, 9};
+
+    REQUIRE(!cache.is_known_unroutable(sig_a));
+    cache.add_unroutable(IntraLbRouteCache::t_signature(sig_a));
+
+    REQUIRE(cache.is_known_unroutable(sig_a));
+    REQUIRE(!cache.is_known_unroutable(sig_b));
+
+    CHECK(cache.num_hits() == 1);
+    CHECK(cache.num_misses() == 2);
+    CHECK(cache.num_entries() == 1);
+    CHECK(cache.num_evictions() == 0);
+}
+
+TEST_CASE("intra_lb_route_cache_stays_within_budget", "[vpr_pack]") {
+    const size_t max_bytes = 1024;
+    IntraLbRouteCache cache(max_bytes);
+
+    for (int i = 0; i < 100; i++) {
+        cache.add_unroutable({0, 1, 1, i});
+        REQUIRE(cache.num_bytes() <= max_bytes);
+    }
+
+    // Entries were evicted to stay within the budget, but the newest is kept
+    CHECK(cache.num_evictions() > 0);
+    CHECK(cache.num_entries() + cache.num_evictions() == 100);
+    CHECK(cache.is_known_unroutable({0, 1, 1, 99}));
+
+    // A signature larger than the whole budget is never stored
+    cache.add_unroutable(IntraLbRouteCache::t_signature(max_bytes, 0));
+    CHECK(!cache.is_known_unroutable(IntraLbRouteCache::t_signature(max_bytes, 0)));
+}
+
+} // namespace
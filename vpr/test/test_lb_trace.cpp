@@ -0,0 +1,44 @@
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "pack_types.h"
+
+namespace {
+
+// Returns the lb rr nodes of trace in the order next_in_preorder() visits them.
+static std::vector<int> preorder_nodes(const t_lb_trace& trace) {
+    std::vector<int> nodes;
+    for (int irt = trace.empty() ? OPEN : 0; irt != OPEN; irt = trace.next_in_preorder(irt)) {
+        nodes.push_back(trace.nodes[irt].current_node);
+    }
+    return nodes;
+}
+
+TEST_CASE("lb_trace_preorder_matches_depth_first_order", "[vpr_pack]") {
+    t_lb_trace trace;
+    REQUIRE(preorder_nodes(trace).empty());
+
+    // Build 10 -> 11 -> 12, then 10 -> 13, then 11 -> 14
+    int src = trace.add_node(10, OPEN);
+    int a = trace.add_node(11, src);
+    trace.add_node(12, a);
+    trace.add_node(13, src);
+    trace.add_node(14, a);
+
+    // Nodes are stored in the order they were added...
+    REQUIRE(trace.nodes.size() == 5);
+    CHECK(trace.nodes[4].parent == a);
+
+    // ...but visited as a recursive depth-first traversal would, with children in
+    // the order they were added
+    CHECK(preorder_nodes(trace) == std::vector<int>({10, 11, 12, 14, 13}));
+
+    // Clearing keeps the storage for the next route
+    size_t capacity = trace.nodes.capacity();
+    trace.clear();
+    CHECK(trace.empty());
+    CHECK(trace.nodes.capacity() == capacity);
+}
+
+} // namespace
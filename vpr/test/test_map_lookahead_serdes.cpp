@@ -72,4 +72,38 @@ TEST_CASE("round_trip_map_lookahead", "[vpr]") {
 
 #endif
 
+TEST_CASE("quantized_map_lookahead", "[vpr]") {
+    constexpr std::array<size_t, 6> kDim({1, 2, 3, 1, 15, 16});
+
+    t_wire_cost_map cost_map(kDim);
+    for (size_t i = 0; i < cost_map.size(); ++i) {
+        cost_map.get(i) = util::Cost_Entry(1e-10 * (i % 97), 0.5 + i % 89);
+    }
+    cost_map[0][1][2][0][3][4] = util::Cost_Entry(std::numeric_limits<float>::infinity(), std::numeric_limits<float>::quiet_NaN());
+
+    QuantizedWireCostMap quantized_cost_map;
+    quantized_cost_map.quantize(cost_map);
+
+    t_wire_cost_map decoded_cost_map;
+    quantized_cost_map.dequantize(decoded_cost_map);
+
+    for (size_t i = 0; i < kDim.size(); ++i) {
+        REQUIRE(decoded_cost_map.dim_size(i) == kDim[i]);
+    }
+
+    // The error of each value is at most half a quantization step of its slice
+    const float max_delay_error = 0.5 * 1e-10 * 96 / QuantizedWireCostMap::MAX_CODE * 1.01;
+    const float max_cong_error = 0.5 * 88 / QuantizedWireCostMap::MAX_CODE * 1.01;
+    for (size_t i = 0; i < cost_map.size(); ++i) {
+        if (std::isfinite(cost_map.get(i).delay)) {
+            REQUIRE(std::abs(decoded_cost_map.get(i).delay - cost_map.get(i).delay) <= max_delay_error);
+            REQUIRE(std::abs(decoded_cost_map.get(i).congestion - cost_map.get(i).congestion) <= max_cong_error);
+        }
+    }
+
+    util::Cost_Entry special_entry = quantized_cost_map.get(0, 1, 2, 0, 3, 4);
+    REQUIRE(std::isinf(special_entry.delay));
+    REQUIRE(std::isnan(special_entry.congestion));
+}
+
 } // namespace
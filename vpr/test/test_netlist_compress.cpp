@@ -0,0 +1,171 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "atom_netlist.h"
+#include "netlist_utils.h"
+#include "vtr_random.h"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+TEST_CASE("test_compress_ids", "[vpr_netlist]") {
+    vtr::RandState rand_state = 1;
+
+    //Enough ids to be split between several threads
+    const size_t num_ids = 100000;
+
+    vtr::vector_map<AtomBlockId, AtomBlockId> ids;
+    for (size_t i = 0; i < num_ids; ++i) {
+        ids.push_back(vtr::irand(3, rand_state) == 0 ? AtomBlockId::INVALID() : AtomBlockId(i));
+    }
+
+    auto id_map = compress_ids(ids);
+    REQUIRE(id_map.size() == num_ids);
+
+    //Valid ids keep their order, with no gaps
+    size_t num_valid = 0;
+    for (size_t i = 0; i < num_ids; ++i) {
+        if (ids[AtomBlockId(i)]) {
+            REQUIRE(id_map[AtomBlockId(i)] == AtomBlockId(num_valid));
+            ++num_valid;
+        } else {
+            REQUIRE(!id_map[AtomBlockId(i)]);
+        }
+    }
+
+    auto new_ids = clean_and_reorder_ids(id_map);
+    REQUIRE(new_ids.size() == num_valid);
+    REQUIRE(are_contiguous(new_ids));
+
+    vtr::vector_map<AtomBlockId, size_t> values;
+    vtr::vector_map<AtomBlockId, bool> flags;
+    for (size_t i = 0; i < num_ids; ++i) {
+        values.push_back(i);
+        flags.push_back(i % 2 == 0);
+    }
+
+    auto new_values = clean_and_reorder_values(values, id_map);
+    auto new_flags = clean_and_reorder_values(flags, id_map);
+    REQUIRE(new_values.size() == num_valid);
+    REQUIRE(new_flags.size() == num_valid);
+    for (size_t i = 0; i < num_ids; ++i) {
+        AtomBlockId new_id = id_map[AtomBlockId(i)];
+        if (new_id) {
+            REQUIRE(new_values[new_id] == i);
+            REQUIRE(new_flags[new_id] == (i % 2 == 0));
+        }
+    }
+
+    vtr::vector_map<AtomPinId, AtomBlockId> refs;
+    for (size_t i = 0; i < num_ids; ++i) {
+        refs.push_back(AtomBlockId(vtr::irand(num_ids - 1, rand_state)));
+    }
+    auto new_refs = update_all_refs(refs, id_map);
+    REQUIRE(new_refs.size() == num_ids);
+    for (size_t i = 0; i < num_ids; ++i) {
+        REQUIRE(new_refs[AtomPinId(i)] == id_map[refs[AtomPinId(i)]]);
+    }
+}
+
+TEST_CASE("test_netlist_compress", "[vpr_netlist]") {
+    char model_name[] = "names";
+    char in_name[] = "in";
+    char out_name[] = "out";
+
+    t_model_ports in_port;
+    in_port.dir = IN_PORT;
+    in_port.name = in_name;
+    in_port.size = 2;
+
+    t_model_ports out_port;
+    out_port.dir = OUT_PORT;
+    out_port.name = out_name;
+    out_port.size = 1;
+
+    t_model model;
+    model.name = model_name;
+    model.inputs = &in_port;
+    model.outputs = &out_port;
+
+    //A chain of blocks, each reading the outputs of the two previous ones
+    const int num_blocks = 5000;
+    AtomNetlist netlist("test_netlist", "1");
+    std::vector<AtomBlockId> blocks;
+    std::vector<AtomNetId> nets;
+    for (int i = 0; i < num_blocks; ++i) {
+        AtomBlockId blk = netlist.create_block("blk" + std::to_string(i), &model);
+        AtomNetId net = netlist.create_net("net" + std::to_string(i));
+        netlist.create_pin(netlist.create_port(blk, &out_port), 0, net, PinType::DRIVER, i % 7 == 0);
+
+        AtomPortId in = netlist.create_port(blk, &in_port);
+        for (int bit = 0; bit < 2; ++bit) {
+            if (i > bit) {
+                netlist.create_pin(in, bit, nets[i - bit - 1], PinType::SINK);
+            }
+        }
+
+        blocks.push_back(blk);
+        nets.push_back(net);
+    }
+
+    //Remove every third block and every fifth net
+    for (int i = 0; i < num_blocks; ++i) {
+        if (i % 3 == 0) {
+            netlist.remove_block(blocks[i]);
+        }
+    }
+    for (int i = 0; i < num_blocks; ++i) {
+        if (i % 5 == 0) {
+            netlist.remove_net(nets[i]);
+        }
+    }
+
+    //Record the connectivity left, by name
+    auto describe_pin = [&](AtomPinId pin) {
+        if (!pin) return std::string("none");
+        return netlist.block_name(netlist.pin_block(pin)) + "." + netlist.port_name(netlist.pin_port(pin))
+               + "[" + std::to_string(netlist.pin_port_bit(pin)) + "]"
+               + (netlist.pin_is_constant(pin) ? " const" : "");
+    };
+    auto describe_netlist = [&]() {
+        std::vector<std::string> description;
+        for (AtomBlockId blk : netlist.blocks()) {
+            if (!blk) continue;
+            std::string blk_description = netlist.block_name(blk) + ":";
+            for (AtomPinId pin : netlist.block_pins(blk)) {
+                AtomNetId net = netlist.pin_net(pin);
+                if (!net) continue;
+                blk_description += " " + describe_pin(pin) + "@" + netlist.net_name(net);
+            }
+            description.push_back(blk_description);
+        }
+        for (AtomNetId net : netlist.nets()) {
+            if (!net) continue;
+            std::string net_description = netlist.net_name(net) + ":";
+            for (AtomPinId pin : netlist.net_pins(net)) {
+                net_description += " " + describe_pin(pin);
+            }
+            description.push_back(net_description);
+        }
+        return description;
+    };
+    std::vector<std::string> before = describe_netlist();
+
+    netlist.remove_and_compress();
+    REQUIRE(netlist.is_compressed());
+    REQUIRE(netlist.verify());
+
+    REQUIRE(describe_netlist() == before);
+
+    //The pins know their place on their nets
+    for (AtomNetId net : netlist.nets()) {
+        for (AtomPinId pin : netlist.net_pins(net)) {
+            if (!pin) continue;
+            REQUIRE(netlist.pin_net(pin) == net);
+            REQUIRE(netlist.net_pin(net, netlist.pin_net_index(pin)) == pin);
+        }
+    }
+}
+
+} // namespace
@@ -0,0 +1,58 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "atom_netlist_fwd.h"
+#include "pack_types.h"
+
+namespace {
+
+TEST_CASE("atom_epoch_table_behaves_like_a_map", "[vpr_pack]") {
+    t_atom_epoch_table<AtomBlockId, float> table;
+    table.init(8);
+
+    AtomBlockId blk_a(2);
+    AtomBlockId blk_b(5);
+
+    REQUIRE(!table.contains(blk_a));
+    REQUIRE(!table.contains(blk_b));
+
+    // operator[] value-initializes absent entries, as std::map does
+    table[blk_a] += 1.5f;
+    REQUIRE(table.contains(blk_a));
+    REQUIRE(!table.contains(blk_b));
+    REQUIRE(table[blk_a] == 1.5f);
+
+    table[blk_b] = 3.f;
+    REQUIRE(table[blk_b] == 3.f);
+
+    // Cleared entries are gone, and come back as zero rather than their old value
+    table.clear();
+    REQUIRE(!table.contains(blk_a));
+    REQUIRE(!table.contains(blk_b));
+    REQUIRE(table[blk_a] == 0.f);
+    REQUIRE(table.contains(blk_a));
+    REQUIRE(!table.contains(blk_b));
+}
+
+TEST_CASE("pb_gain_stats_clear_resets_every_table", "[vpr_pack]") {
+    t_pb_gain_stats gain_stats;
+    gain_stats.init(4, 3);
+
+    AtomBlockId blk(1);
+    AtomNetId net(2);
+
+    gain_stats.sharinggain[blk]++;
+    gain_stats.atom_failures[blk]++;
+    gain_stats.num_pins_of_net_in_pb[net]++;
+
+    REQUIRE(gain_stats.sharinggain[blk] == 1.f);
+    REQUIRE(gain_stats.atom_failures[blk] == 1);
+    REQUIRE(gain_stats.num_pins_of_net_in_pb[net] == 1);
+
+    gain_stats.clear();
+
+    REQUIRE(!gain_stats.sharinggain.contains(blk));
+    REQUIRE(!gain_stats.atom_failures.contains(blk));
+    REQUIRE(!gain_stats.num_pins_of_net_in_pb.contains(net));
+}
+
+} // namespace
@@ -0,0 +1,157 @@
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "blifparse.hpp"
+#include "parallel_blif_parse.h"
+
+namespace {
+
+using blifparse::LatchType;
+using blifparse::LogicValue;
+
+// Records every callback as a line of text, optionally prefixed by the line number
+class RecordingCallback : public blifparse::Callback {
+  public:
+    explicit RecordingCallback(bool record_lineno)
+        : record_lineno_(record_lineno) {}
+
+    std::vector<std::string> events;
+
+    void start_parse() override { add("start_parse"); }
+    void filename(std::string fname) override { add("filename " + fname); }
+    void lineno(int line_num) override { line_num_ = line_num; }
+
+    void begin_model(std::string model_name) override { add("model " + model_name); }
+    void inputs(std::vector<std::string> inputs) override { add("inputs" + join(inputs)); }
+    void outputs(std::vector<std::string> outputs) override { add("outputs" + join(outputs)); }
+
+    void names(std::vector<std::string> nets, std::vector<std::vector<LogicValue>> so_cover) override {
+        std::string event = "names" + join(nets);
+        for (const auto& row : so_cover) {
+            event += " |";
+            for (LogicValue value : row) {
+                event += std::to_string(int(value));
+            }
+        }
+        add(event);
+    }
+
+    void latch(std::string input, std::string output, LatchType type, std::string control, LogicValue init) override {
+        add("latch " + input + " " + output + " " + std::to_string(int(type)) + " [" + control + "] " + std::to_string(int(init)));
+    }
+
+    void subckt(std::string model, std::vector<std::string> ports, std::vector<std::string> nets) override {
+        std::string event = "subckt " + model;
+        for (size_t i = 0; i < ports.size() && i < nets.size(); ++i) {
+            event += " " + ports[i] + "=" + nets[i];
+        }
+        add(event);
+    }
+
+    void blackbox() override { add("blackbox"); }
+    void end_model() override { add("end"); }
+
+    void conn(std::string src, std::string dst) override { add("conn " + src + " " + dst); }
+    void cname(std::string cell_name) override { add("cname " + cell_name); }
+    void attr(std::string name, std::string value) override { add("attr " + name + " " + value); }
+    void param(std::string name, std::string value) override { add("param " + name + " " + value); }
+
+    void finish_parse() override { add("finish_parse"); }
+
+    void parse_error(const int /*curr_lineno*/, const std::string& /*near_text*/, const std::string& /*msg*/) override {
+        add("parse_error");
+    }
+
+  private:
+    static std::string join(const std::vector<std::string>& strs) {
+        std::string joined;
+        for (const auto& str : strs) {
+            joined += " " + str;
+        }
+        return joined;
+    }
+
+    void add(const std::string& event) {
+        events.push_back(record_lineno_ ? std::to_string(line_num_) + ": " + event : event);
+    }
+
+    bool record_lineno_;
+    int line_num_ = 0;
+};
+
+// Exercises comments, line continuations, cover rows, all the latch forms,
+// the EBLIF extensions and a missing final newline
+const char* TEST_EBLIF =
+    "# leading comment\n"
+    ".model top\n"
+    ".inputs a b \\\n"
+    "  clk\n"
+    ".outputs o q q2 q3 q4\n"
+    ".names a b n1 # trailing comment\n"
+    "11 1\r\n"
+    "0- 1\n"
+    "\n"
+    ".names n1 o\n"
+    "1 1\n"
+    ".latch n1 q re clk 2\n"
+    ".latch n1 q2\n"
+    ".latch n1 q3 3\n"
+    ".latch n1 q4 fe NIL\n"
+    ".subckt adder a=a b=b \\\n"
+    "   cout=c\n"
+    ".cname \"my cell\"\n"
+    ".attr foo \"bar baz\"\n"
+    ".param P 0101\n"
+    ".conn a x#y\n"
+    ".end\n"
+    "\n"
+    ".model adder\n"
+    ".inputs a b\n"
+    ".outputs cout\n"
+    ".blackbox\n"
+    ".end";
+
+TEST_CASE("parallel_blif_parse_matches_libblifparse", "[vpr]") {
+    const std::string filename = "test_parallel_blif_parse.eblif";
+    {
+        std::ofstream file(filename, std::ios::binary);
+        REQUIRE(file.good());
+        file << TEST_EBLIF;
+    }
+
+    RecordingCallback reference(false);
+    blifparse::blif_parse_filename(filename, reference);
+
+    RecordingCallback parallel(false);
+    parallel_blif_parse_filename(filename.c_str(), parallel);
+
+    // libblifparse reports some statements on a later line number (after its
+    // look-ahead), so only the statements themselves are compared
+    CHECK(parallel.events == reference.events);
+
+    // Statements must not depend on where the file is split into chunks
+    RecordingCallback whole_file(true);
+    parallel_blif_parse_filename(filename.c_str(), whole_file);
+    for (size_t chunk_bytes : {1, 7, 64}) {
+        RecordingCallback chunked(true);
+        parallel_blif_parse_filename(filename.c_str(), chunked, chunk_bytes);
+        CHECK(chunked.events == whole_file.events);
+    }
+}
+
+TEST_CASE("parallel_blif_parse_reads_test_netlists", "[vpr]") {
+    for (const char* filename : {"wire.eblif", "unconnected.eblif"}) {
+        RecordingCallback reference(false);
+        blifparse::blif_parse_filename(filename, reference);
+
+        RecordingCallback parallel(false);
+        parallel_blif_parse_filename(filename, parallel);
+
+        CHECK(parallel.events == reference.events);
+    }
+}
+
+} // namespace
@@ -0,0 +1,51 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "globals.h"
+#include "read_place.h"
+#include "vpr_api.h"
+
+namespace {
+
+static constexpr const char kArchFile[] = "../../vtr_flow/arch/timing/k6_frac_N10_mem32K_40nm.xml";
+static constexpr const char kBinaryPlaceFile[] = "test_read_place.place.bin";
+
+// The location of each clustered block
+static std::vector<t_pl_loc> get_block_locs() {
+    const auto& block_locs = g_vpr_ctx.placement().block_locs();
+
+    std::vector<t_pl_loc> locs;
+    for (auto blk_id : g_vpr_ctx.clustering().clb_nlist.blocks()) {
+        locs.push_back(block_locs[blk_id].loc);
+    }
+    return locs;
+}
+
+TEST_CASE("round_trip_binary_place", "[vpr]") {
+    t_vpr_setup vpr_setup;
+    t_arch arch;
+    t_options options;
+    const char* argv[] = {
+        "test_vpr",
+        kArchFile,
+        "wire.eblif",
+        "--route_chan_width",
+        "100",
+        "--write_place_binary",
+        kBinaryPlaceFile};
+    vpr_init(sizeof(argv) / sizeof(argv[0]), argv,
+             &options, &vpr_setup, &arch);
+
+    REQUIRE(vpr_flow(vpr_setup, arch));
+
+    auto placed_block_locs = get_block_locs();
+
+    // The binary placement loads back the placement which was written
+    auto& place_ctx = g_vpr_ctx.mutable_placement();
+    read_place(vpr_setup.FileNameOpts.NetFile.c_str(), kBinaryPlaceFile,
+               place_ctx.mutable_blk_loc_registry(), true, g_vpr_ctx.device().grid);
+    CHECK(get_block_locs() == placed_block_locs);
+
+    vpr_free_all(arch, vpr_setup);
+}
+
+} // namespace
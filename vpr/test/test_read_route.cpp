@@ -0,0 +1,67 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <tuple>
+#include <vector>
+
+#include "globals.h"
+#include "read_route.h"
+#include "vpr_api.h"
+
+namespace {
+
+static constexpr const char kArchFile[] = "../../vtr_flow/arch/timing/k6_frac_N10_mem32K_40nm.xml";
+static constexpr const char kTextRouteFile[] = "test_read_route.route";
+static constexpr const char kBinaryRouteFile[] = "test_read_route.route.bin";
+
+using t_net_route = std::vector<std::tuple<RRNodeId, RRSwitchId, int>>;
+
+// The nodes (with their parent switch and net pin index) of the route tree of each net
+static std::vector<t_net_route> get_net_routes(const Netlist<>& net_list) {
+    const auto& route_ctx = g_vpr_ctx.routing();
+
+    std::vector<t_net_route> net_routes;
+    for (auto net_id : net_list.nets()) {
+        t_net_route& net_route = net_routes.emplace_back();
+        if (!route_ctx.route_trees[net_id]) {
+            continue;
+        }
+        for (auto& rt_node : route_ctx.route_trees[net_id].value().all_nodes()) {
+            net_route.emplace_back(rt_node.inode, rt_node.parent_switch, rt_node.net_pin_index);
+        }
+    }
+    return net_routes;
+}
+
+TEST_CASE("round_trip_binary_route", "[vpr]") {
+    t_vpr_setup vpr_setup;
+    t_arch arch;
+    t_options options;
+    const char* argv[] = {
+        "test_vpr",
+        kArchFile,
+        "wire.eblif",
+        "--route_chan_width",
+        "100",
+        "--route_file",
+        kTextRouteFile};
+    vpr_init(sizeof(argv) / sizeof(argv[0]), argv,
+             &options, &vpr_setup, &arch);
+
+    REQUIRE(vpr_flow(vpr_setup, arch));
+
+    const Netlist<>& net_list = (const Netlist<>&)g_vpr_ctx.clustering().clb_nlist;
+    auto routed_net_routes = get_net_routes(net_list);
+
+    print_route(net_list, vpr_setup.FileNameOpts.PlaceFile.c_str(), kBinaryRouteFile, false);
+
+    // Both the binary and the text routing load back the routing which was written
+    REQUIRE(read_route(kBinaryRouteFile, vpr_setup.RouterOpts, true, false));
+    CHECK(get_net_routes(net_list) == routed_net_routes);
+
+    REQUIRE(read_route(kTextRouteFile, vpr_setup.RouterOpts, true, false));
+    CHECK(get_net_routes(net_list) == routed_net_routes);
+
+    vpr_free_all(arch, vpr_setup);
+}
+
+} // namespace
@@ -0,0 +1,56 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <limits>
+
+#include "router_lookahead_correction.h"
+#include "vtr_math.h"
+
+namespace {
+
+TEST_CASE("test_router_lookahead_correction_buckets", "[vpr]") {
+    REQUIRE(LookaheadCorrection::distance_bucket(0) == 0);
+    REQUIRE(LookaheadCorrection::distance_bucket(1) == 1);
+    REQUIRE(LookaheadCorrection::distance_bucket(3) == 2);
+    REQUIRE(LookaheadCorrection::distance_bucket(4) == 3);
+    REQUIRE(LookaheadCorrection::distance_bucket(1000) == LookaheadCorrection::NUM_DISTANCE_BUCKETS - 1);
+}
+
+TEST_CASE("test_router_lookahead_correction_update", "[vpr]") {
+    LookaheadCorrection correction;
+    REQUIRE(!correction.is_enabled());
+    correction.init(2);
+    REQUIRE(correction.is_enabled());
+    REQUIRE(correction.factor(1, 5) == 1.);
+
+    LookaheadCorrectionSamples samples;
+    for (size_t i = 0; i < LookaheadCorrection::MIN_BUCKET_SAMPLES; ++i) {
+        //Paths twice as expensive as estimated
+        samples.add(1, 5, 1., 2.);
+        //Paths cheaper than estimated do not lower the lookahead
+        samples.add(0, 5, 2., 1.);
+    }
+    //Too few samples to move the factor
+    samples.add(1, 100, 1., 3.);
+
+    LookaheadCorrectionSamples thread_samples;
+    thread_samples.add(0, 0, std::numeric_limits<float>::infinity(), 1.);
+    samples.combine(thread_samples);
+    REQUIRE(samples.num_samples() == 2 * LookaheadCorrection::MIN_BUCKET_SAMPLES + 1);
+
+    correction.update(samples);
+    REQUIRE(vtr::isclose(correction.factor(1, 5), 1.f + LookaheadCorrection::UPDATE_WEIGHT));
+    REQUIRE(correction.factor(1, 6) == correction.factor(1, 5));
+    REQUIRE(correction.factor(0, 5) == 1.);
+    REQUIRE(correction.factor(1, 100) == 1.);
+
+    //The factors converge to the observed ratio
+    for (int i = 0; i < 30; ++i) {
+        correction.update(samples);
+    }
+    REQUIRE(vtr::isclose(correction.factor(1, 5), 2.f));
+
+    correction.clear();
+    REQUIRE(!correction.is_enabled());
+}
+
+} // namespace
@@ -0,0 +1,54 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "routing_demand_map.h"
+#include "vtr_math.h"
+
+namespace {
+
+TEST_CASE("test_routing_demand_map_rudy", "[vpr]") {
+    RoutingDemandMap demand_map;
+    demand_map.init(6, 5, std::vector<int>(5, 2), std::vector<int>(6, 1));
+
+    //A 4 x 2 bounding box: 1/2 CHANX track and 1/4 CHANY track per tile
+    demand_map.add_net(1, 4, 2, 3, 1.);
+    demand_map.update_utilization(1.);
+
+    t_routing_demand_stats stats = demand_map.stats();
+    REQUIRE(vtr::isclose(stats.max_chanx_util, 0.25));
+    REQUIRE(vtr::isclose(stats.max_chany_util, 0.25));
+    REQUIRE(vtr::isclose(stats.avg_chanx_util, 8 * 0.25 / 30));
+    REQUIRE(vtr::isclose(stats.avg_chany_util, 8 * 0.25 / 30));
+    REQUIRE(stats.overused_fraction == 0.);
+
+    //Nothing is over the threshold
+    REQUIRE(demand_map.net_cost(0, 5, 0, 4, 1.) == 0.);
+}
+
+TEST_CASE("test_routing_demand_map_congestion_cost", "[vpr]") {
+    RoutingDemandMap demand_map;
+    demand_map.init(4, 4, std::vector<int>(4, 1), std::vector<int>(4, 1));
+
+    //Two tracks in each direction of a single tile, twice its capacity
+    demand_map.add_net(2, 2, 1, 1, 2.);
+    demand_map.update_utilization(1.);
+
+    t_routing_demand_stats stats = demand_map.stats();
+    REQUIRE(vtr::isclose(stats.max_chanx_util, 2.));
+    REQUIRE(vtr::isclose(stats.overused_fraction, 2. / 32));
+
+    //The overflow of 1 in each direction, weighted by the wirelength of the net
+    REQUIRE(vtr::isclose(demand_map.net_cost(2, 2, 1, 1, 1.), 2.));
+    //A 2 x 2 bounding box averages the overflow over its 4 tiles
+    REQUIRE(vtr::isclose(demand_map.net_cost(2, 3, 0, 1, 1.), 0.5 + 0.5));
+    REQUIRE(demand_map.net_cost(0, 1, 0, 3, 1.) == 0.);
+
+    //The costs are computed against the utilization of the last update
+    demand_map.add_net(2, 2, 1, 1, -2.);
+    REQUIRE(vtr::isclose(demand_map.net_cost(2, 2, 1, 1, 1.), 2.));
+
+    demand_map.update_utilization(1.);
+    REQUIRE(demand_map.net_cost(2, 2, 1, 1, 1.) == 0.);
+    REQUIRE(demand_map.stats().max_chanx_util == 0.);
+}
+
+} // namespace
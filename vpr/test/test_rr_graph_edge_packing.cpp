@@ -0,0 +1,137 @@
+#include <tuple>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "vpr_api.h"
+#include "vpr_signal_handler.h"
+#include "globals.h"
+#include "place_and_route.h"
+#include "router_delay_profiling.h"
+
+static constexpr const char kArchFile[] = "../../vtr_flow/arch/timing/k6_frac_N10_mem32K_40nm.xml";
+
+namespace {
+
+using t_edge = std::tuple<RRNodeId, RRNodeId, short>;
+
+// Collect (source, sink, switch) of every edge, in edge id order.
+static std::vector<t_edge> collect_edges(const t_rr_graph_storage& rr_nodes) {
+    std::vector<t_edge> edges;
+    rr_nodes.for_each_edge([&](RREdgeId edge, RRNodeId src, RRNodeId sink) {
+        REQUIRE(size_t(edge) == edges.size());
+        REQUIRE(rr_nodes.edge_src_node(edge) == src);
+        REQUIRE(rr_nodes.edge_sink_node(edge) == sink);
+        edges.emplace_back(src, sink, rr_nodes.edge_switch(edge));
+    });
+    return edges;
+}
+
+// Build the RR graph of the test architecture (freed by free_rr_graph_test())
+static void build_rr_graph_test(t_options& options, t_arch& arch, t_vpr_setup& vpr_setup) {
+    vpr_install_signal_handler();
+    vpr_initialize_logging();
+
+    const char* argv[] = {
+        "test_vpr",
+        kArchFile,
+        "wire.eblif",
+        "--route_chan_width", "100"};
+    vpr_init(sizeof(argv) / sizeof(argv[0]), argv,
+             &options, &vpr_setup, &arch);
+
+    vpr_create_device_grid(vpr_setup, arch);
+    vpr_setup_clock_networks(vpr_setup, arch);
+    auto det_routing_arch = &vpr_setup.RoutingArch;
+    auto& router_opts = vpr_setup.RouterOpts;
+    t_graph_type graph_directionality;
+
+    if (router_opts.route_type == GLOBAL) {
+        graph_directionality = GRAPH_BIDIR;
+    } else {
+        graph_directionality = (det_routing_arch->directionality == BI_DIRECTIONAL ? GRAPH_BIDIR : GRAPH_UNIDIR);
+    }
+
+    auto chan_width = init_chan(vpr_setup.RouterOpts.fixed_channel_width, arch.Chans, graph_directionality);
+
+    alloc_routing_structs(
+        chan_width,
+        vpr_setup.RouterOpts,
+        &vpr_setup.RoutingArch,
+        vpr_setup.Segments,
+        arch.Directs,
+        arch.num_directs,
+        router_opts.flat_routing);
+}
+
+static void free_rr_graph_test(t_arch& arch, t_vpr_setup& vpr_setup) {
+    free_routing_structs();
+    vpr_free_all(arch,
+                 vpr_setup);
+}
+
+// Check every edge seen through the t_rr_graph_view used by the router, with
+// and without the source node of the edge.
+static void check_view_edges(const t_rr_graph_view& view, const std::vector<t_edge>& unpacked_edges) {
+    for (size_t inode = 0; inode < view.size(); inode++) {
+        RRNodeId src(inode);
+        for (RREdgeId iedge : view.edge_range(src)) {
+            REQUIRE(unpacked_edges[size_t(iedge)] == t_edge(src, view.edge_sink_node(iedge), view.edge_switch(iedge)));
+            REQUIRE(unpacked_edges[size_t(iedge)] == t_edge(src, view.edge_sink_node(src, iedge), view.edge_switch(src, iedge)));
+        }
+    }
+}
+
+// Packing the RR graph edges must not change any edge, as seen through either
+// t_rr_graph_storage or the t_rr_graph_view used by the router.
+TEST_CASE("rr_graph_edge_packing", "[vpr]") {
+    auto options = t_options();
+    auto arch = t_arch();
+    auto vpr_setup = t_vpr_setup();
+    build_rr_graph_test(options, arch, vpr_setup);
+
+    auto& device_ctx = g_vpr_ctx.mutable_device();
+    const t_rr_graph_storage& rr_nodes = device_ctx.rr_graph.rr_nodes();
+    REQUIRE(!rr_nodes.edges_packed());
+
+    auto unpacked_edges = collect_edges(rr_nodes);
+    REQUIRE(!unpacked_edges.empty());
+    size_t unpacked_bytes = rr_nodes.edge_memory_bytes();
+
+    REQUIRE(device_ctx.rr_graph_builder.pack_edges());
+    REQUIRE(rr_nodes.edges_packed());
+    CHECK(rr_nodes.edge_memory_bytes() < unpacked_bytes);
+    CHECK(collect_edges(rr_nodes) == unpacked_edges);
+    check_view_edges(rr_nodes.view(), unpacked_edges);
+
+    free_rr_graph_test(arch, vpr_setup);
+}
+
+// Tiling the edges of a regular fabric must save memory over packing them,
+// without changing any edge.
+TEST_CASE("rr_graph_edge_tiling", "[vpr]") {
+    auto options = t_options();
+    auto arch = t_arch();
+    auto vpr_setup = t_vpr_setup();
+    build_rr_graph_test(options, arch, vpr_setup);
+
+    auto& device_ctx = g_vpr_ctx.mutable_device();
+    const t_rr_graph_storage& rr_nodes = device_ctx.rr_graph.rr_nodes();
+    REQUIRE(!rr_nodes.edges_packed());
+
+    // As --compress_rr_graph_edges tiled does, number the nodes tile by tile first
+    device_ctx.rr_graph_builder.reorder_nodes(TILE_LOCATION, 0, 0);
+    auto unpacked_edges = collect_edges(rr_nodes);
+    REQUIRE(!unpacked_edges.empty());
+
+    REQUIRE(device_ctx.rr_graph_builder.tile_edges());
+    REQUIRE(rr_nodes.edges_tiled());
+    CHECK(rr_nodes.edge_memory_bytes() < unpacked_edges.size() * sizeof(uint32_t));
+    CHECK(rr_nodes.num_edge_pattern_entries() < unpacked_edges.size());
+    CHECK(collect_edges(rr_nodes) == unpacked_edges);
+    check_view_edges(rr_nodes.view(), unpacked_edges);
+
+    free_rr_graph_test(arch, vpr_setup);
+}
+
+} // namespace
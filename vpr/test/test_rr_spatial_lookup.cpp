@@ -0,0 +1,104 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "rr_spatial_lookup.h"
+
+namespace {
+
+// A look-up of a 4x4 grid with a 2x2 block (SOURCE nodes over its footprint), pins and channel tracks
+static void build_lookup(RRSpatialLookup& lookup) {
+    // Resizing drops the nodes, so size the look-up first
+    for (t_rr_type type : {SOURCE, SINK, IPIN, OPIN, CHANX, CHANY}) {
+        lookup.resize_nodes(0, 3, 3, type, LEFT);
+    }
+
+    size_t inode = 0;
+    for (int x = 0; x < 4; ++x) {
+        for (int y = 0; y < 4; ++y) {
+            for (int ptc = 0; ptc < 3; ++ptc) {
+                lookup.add_node(RRNodeId(inode++), 0, y, x, CHANX, ptc);
+                lookup.add_node(RRNodeId(inode++), 0, x, y, CHANY, ptc);
+            }
+            lookup.add_node(RRNodeId(inode++), 0, x, y, IPIN, 0, RIGHT);
+            // A hole in the ptcs of the pins
+            lookup.add_node(RRNodeId(inode++), 0, x, y, OPIN, 2, TOP);
+        }
+    }
+
+    for (int ptc = 0; ptc < 2; ++ptc) {
+        lookup.add_node(RRNodeId(inode++), 0, 1, 1, SOURCE, ptc);
+    }
+    for (int x = 1; x < 3; ++x) {
+        for (int y = 1; y < 3; ++y) {
+            if (x != 1 || y != 1) {
+                lookup.mirror_nodes(0, vtr::Point<int>(1, 1), vtr::Point<int>(x, y), SOURCE, TOP);
+            }
+        }
+    }
+}
+
+// All the queries of the look-up, to compare look-ups
+static std::vector<RRNodeId> query_lookup(const RRSpatialLookup& lookup) {
+    std::vector<RRNodeId> nodes;
+    for (int x = -1; x < 5; ++x) {
+        for (int y = -1; y < 5; ++y) {
+            for (t_rr_type type : {SOURCE, SINK, IPIN, OPIN, CHANX, CHANY}) {
+                for (int ptc = 0; ptc < 4; ++ptc) {
+                    if (type == IPIN || type == OPIN) {
+                        for (e_side side : TOTAL_2D_SIDES) {
+                            nodes.push_back(lookup.find_node(0, x, y, type, ptc, side));
+                        }
+                    } else {
+                        nodes.push_back(lookup.find_node(0, x, y, type, ptc));
+                    }
+                }
+            }
+            for (t_rr_type type : {CHANX, CHANY}) {
+                std::vector<RRNodeId> channel_nodes = lookup.find_channel_nodes(0, x, y, type);
+                nodes.insert(nodes.end(), channel_nodes.begin(), channel_nodes.end());
+            }
+            for (t_rr_type type : {SOURCE, IPIN, OPIN}) {
+                std::vector<RRNodeId> grid_nodes = lookup.find_grid_nodes_at_all_sides(0, x, y, type);
+                nodes.insert(nodes.end(), grid_nodes.begin(), grid_nodes.end());
+            }
+        }
+    }
+    return nodes;
+}
+
+TEST_CASE("compress_rr_spatial_lookup", "[vpr]") {
+    RRSpatialLookup reference;
+    build_lookup(reference);
+    const std::vector<RRNodeId> reference_nodes = query_lookup(reference);
+
+    RRSpatialLookup lookup;
+    build_lookup(lookup);
+    lookup.compress();
+
+    SECTION("Compressed look-up answers the same queries") {
+        REQUIRE(query_lookup(lookup) == reference_nodes);
+        REQUIRE(lookup.memory_usage().bytes < reference.memory_usage().bytes);
+    }
+
+    SECTION("Reordering a compressed look-up") {
+        // Reverse the node ids
+        size_t num_nodes = 4 * 4 * (2 * 3 + 2) + 2;
+        vtr::vector<RRNodeId, RRNodeId> dest_order(num_nodes);
+        for (size_t inode = 0; inode < num_nodes; ++inode) {
+            dest_order[RRNodeId(inode)] = RRNodeId(num_nodes - 1 - inode);
+        }
+        reference.reorder(dest_order);
+        lookup.reorder(dest_order);
+
+        REQUIRE(query_lookup(lookup) == query_lookup(reference));
+    }
+
+    SECTION("Modifying a compressed look-up") {
+        reference.add_node(RRNodeId(1000), 0, 3, 3, SINK, 0);
+        lookup.add_node(RRNodeId(1000), 0, 3, 3, SINK, 0);
+        REQUIRE(lookup.remove_node(RRNodeId(1000), 0, 3, 3, SINK, 0) == reference.remove_node(RRNodeId(1000), 0, 3, 3, SINK, 0));
+
+        REQUIRE(query_lookup(lookup) == query_lookup(reference));
+    }
+}
+
+} // namespace
@@ -112,4 +112,39 @@ TEST_CASE("test_server_taskresolver_cmdSpamAndOverrideOptions", "[vpr]") {
     REQUIRE(task1->options() == "");
 }
 
+TEST_CASE("test_server_taskresolver_cmdFilterPerClient", "[vpr]") {
+    server::TaskResolver resolver;
+    const comm::CMD cmd = comm::CMD::GET_PATH_LIST_ID;
+
+    {
+        server::TaskPtr task0 = std::make_unique<server::Task>(1, cmd, "1");
+        server::TaskPtr task1 = std::make_unique<server::Task>(1, cmd, "1");
+        server::TaskPtr task2 = std::make_unique<server::Task>(2, cmd, "22");
+        server::TaskPtr task3 = std::make_unique<server::Task>(2, cmd, "22");
+        task1->set_client_id(1);
+        task2->set_client_id(1);
+        task3->set_client_id(1);
+
+        resolver.own_task(std::move(task0));
+        resolver.own_task(std::move(task1));
+        resolver.own_task(std::move(task2));
+        resolver.own_task(std::move(task3));
+    }
+
+    std::vector<server::TaskPtr> finished;
+    resolver.take_finished_tasks(finished);
+
+    // the tasks of client 1 filter each other, but never the task of client 0
+    REQUIRE(finished.size() == 2);
+    for (const server::TaskPtr& task: finished) {
+        REQUIRE(task->has_error());
+        REQUIRE(task->client_id() == 1);
+    }
+    REQUIRE(resolver.tasks_num() == 2);
+    REQUIRE(resolver.tasks().at(0)->client_id() == 0);
+    REQUIRE(resolver.tasks().at(0)->job_id() == 1);
+    REQUIRE(resolver.tasks().at(1)->client_id() == 1);
+    REQUIRE(resolver.tasks().at(1)->job_id() == 2);
+}
+
 #endif /* NO_SERVER */
\ No newline at end of file
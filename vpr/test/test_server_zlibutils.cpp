@@ -19,6 +19,24 @@ TEST_CASE("test_server_zlib_utils", "[vpr]")
     REQUIRE(orig == decompressedOpt.value());
 }
 
+TEST_CASE("test_server_zlib_utils_large", "[vpr]")
+{
+    // larger than the 32KB compression buffer
+    std::string orig;
+    for (int i = 0; i < 100000; i++) {
+        orig += "#Path " + std::to_string(i) + "\n";
+    }
+
+    std::optional<std::string> compressedOpt = try_compress(orig);
+    REQUIRE(compressedOpt);
+    REQUIRE(compressedOpt.value().size() < orig.size());
+
+    std::optional<std::string> decompressedOpt = try_decompress(compressedOpt.value());
+    REQUIRE(decompressedOpt);
+
+    REQUIRE(orig == decompressedOpt.value());
+}
+
 #endif /* NO_SERVER */
 
 
@@ -0,0 +1,152 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "vpr_api.h"
+#include "vpr_signal_handler.h"
+#include "globals.h"
+#include "place_delay_model.h"
+#include "timing_place_lookup.h"
+
+#ifdef VPR_USE_TBB
+#    include <tbb/global_control.h>
+#endif
+
+static constexpr const char kArchFile[] = "../../vtr_flow/arch/timing/k6_frac_N10_mem32K_40nm.xml";
+
+namespace {
+
+#ifdef VPR_USE_TBB
+// Computes the delta delay model using at most num_workers threads.
+static vtr::NdMatrix<float, 4> compute_delta_delays_with_workers(t_vpr_setup& vpr_setup, const t_arch& arch, size_t num_workers) {
+    tbb::global_control c(tbb::global_control::max_allowed_parallelism, num_workers);
+
+    auto model = compute_place_delay_model(vpr_setup.PlacerOpts,
+                                           vpr_setup.RouterOpts,
+                                           (const Netlist<>&)g_vpr_ctx.clustering().clb_nlist,
+                                           &vpr_setup.RoutingArch,
+                                           vpr_setup.Segments,
+                                           arch.Chans,
+                                           arch.Directs,
+                                           arch.num_directs,
+                                           /*is_flat=*/false);
+
+    auto delta_model = dynamic_cast<DeltaDelayModel*>(model.get());
+    REQUIRE(delta_model != nullptr);
+    return delta_model->delays();
+}
+
+// The placement delay model is profiled in parallel; check that it matches the serial result.
+TEST_CASE("parallel_delta_delay_model_is_deterministic", "[vpr]") {
+    auto options = t_options();
+    auto arch = t_arch();
+    auto vpr_setup = t_vpr_setup();
+
+    vpr_install_signal_handler();
+    vpr_initialize_logging();
+
+    const char* argv[] = {
+        "test_vpr",
+        kArchFile,
+        "wire.eblif",
+        "--route_chan_width", "100",
+        "--place_delay_model", "delta"};
+    vpr_init(sizeof(argv) / sizeof(argv[0]), argv,
+             &options, &vpr_setup, &arch);
+
+    vpr_create_device_grid(vpr_setup, arch);
+    vpr_setup_clock_networks(vpr_setup, arch);
+
+    auto serial_delays = compute_delta_delays_with_workers(vpr_setup, arch, 1);
+    auto parallel_delays = compute_delta_delays_with_workers(vpr_setup, arch, 4);
+
+    REQUIRE(serial_delays.ndims() == parallel_delays.ndims());
+    for (size_t dim = 0; dim < serial_delays.ndims(); ++dim) {
+        REQUIRE(serial_delays.dim_size(dim) == parallel_delays.dim_size(dim));
+    }
+
+    for (size_t from_layer = 0; from_layer < serial_delays.dim_size(0); ++from_layer) {
+        for (size_t to_layer = 0; to_layer < serial_delays.dim_size(1); ++to_layer) {
+            for (size_t dx = 0; dx < serial_delays.dim_size(2); ++dx) {
+                for (size_t dy = 0; dy < serial_delays.dim_size(3); ++dy) {
+                    CHECK(serial_delays[from_layer][to_layer][dx][dy] == parallel_delays[from_layer][to_layer][dx][dy]);
+                }
+            }
+        }
+    }
+
+    vpr_free_all(arch,
+                 vpr_setup);
+}
+#endif
+
+// The lazy delta delay model computes the entries it is queried for as the delta delay model would.
+TEST_CASE("lazy_delta_delay_model_matches_delta", "[vpr]") {
+    auto options = t_options();
+    auto arch = t_arch();
+    auto vpr_setup = t_vpr_setup();
+
+    vpr_install_signal_handler();
+    vpr_initialize_logging();
+
+    const char* argv[] = {
+        "test_vpr",
+        kArchFile,
+        "wire.eblif",
+        "--route_chan_width", "100",
+        "--place_delay_model", "delta"};
+    vpr_init(sizeof(argv) / sizeof(argv[0]), argv,
+             &options, &vpr_setup, &arch);
+
+    vpr_create_device_grid(vpr_setup, arch);
+    vpr_setup_clock_networks(vpr_setup, arch);
+
+    auto compute_model = [&]() {
+        return compute_place_delay_model(vpr_setup.PlacerOpts,
+                                         vpr_setup.RouterOpts,
+                                         (const Netlist<>&)g_vpr_ctx.clustering().clb_nlist,
+                                         &vpr_setup.RoutingArch,
+                                         vpr_setup.Segments,
+                                         arch.Chans,
+                                         arch.Directs,
+                                         arch.num_directs,
+                                         /*is_flat=*/false);
+    };
+
+    auto model = compute_model();
+    auto delta_model = dynamic_cast<DeltaDelayModel*>(model.get());
+    REQUIRE(delta_model != nullptr);
+    const auto& delays = delta_model->delays();
+
+    vpr_setup.PlacerOpts.delay_model_type = PlaceDelayModelType::DELTA_LAZY;
+    auto lazy = compute_model();
+    auto lazy_model = dynamic_cast<LazyDeltaDelayModel*>(lazy.get());
+    REQUIRE(lazy_model != nullptr);
+
+    size_t num_coarse = lazy_model->num_filled();
+    REQUIRE(num_coarse > 0);
+    REQUIRE(num_coarse <= delays.size());
+
+    //Neighbour averages of empty deltas may differ slightly, the sampled delays may not
+    size_t num_mismatches = 0;
+    for (int from_layer = 0; from_layer < (int)delays.dim_size(0); ++from_layer) {
+        for (int to_layer = 0; to_layer < (int)delays.dim_size(1); ++to_layer) {
+            for (int dx = 0; dx < (int)delays.dim_size(2); ++dx) {
+                for (int dy = 0; dy < (int)delays.dim_size(3); ++dy) {
+                    float delay = lazy_model->delay({0, 0, from_layer}, 0, {dx, dy, to_layer}, 0);
+                    CHECK(delay >= 0.);
+                    //Memoized
+                    CHECK(lazy_model->delay({dx, dy, from_layer}, 0, {0, 0, to_layer}, 0) == delay);
+                    if (delay != delays[from_layer][to_layer][dx][dy]) {
+                        ++num_mismatches;
+                    }
+                }
+            }
+        }
+    }
+    CHECK(lazy_model->num_filled() == delays.size());
+    CHECK(num_mismatches * 4 < delays.size());
+
+    vpr_free_all(arch,
+                 vpr_setup);
+}
+
+} // namespace
@@ -8,6 +8,7 @@
 #include "partition.h"
 #include "region.h"
 #include "place_constraints.h"
+#include "atom_name_matcher.h"
 
 /**
  * This file contains unit tests that check the functionality of all classes related to vpr constraints. These classes include
@@ -582,6 +583,38 @@ TEST_CASE("MacroConstraints", "[vpr]") {
     REQUIRE(mac_first_reg_coord.ymax() == 7);
 }
 
+TEST_CASE("RegexLiteralPrefix", "[vpr]") {
+    REQUIRE(regex_literal_prefix("^core_0/alu.*") == "core_0/alu");
+    REQUIRE(regex_literal_prefix("^core_1?/alu") == "core_");
+    REQUIRE(regex_literal_prefix("^ab+c") == "ab");
+    REQUIRE(regex_literal_prefix("^a|^b") == "");
+    REQUIRE(regex_literal_prefix("core_0/alu") == "");
+}
+
+TEST_CASE("AtomNameMatcher", "[vpr]") {
+    t_model model;
+    AtomNetlist netlist;
+    AtomBlockId alu_0 = netlist.create_block("core_0/alu_0", &model);
+    AtomBlockId alu_1 = netlist.create_block("core_0/alu_1", &model);
+    AtomBlockId fpu_0 = netlist.create_block("core_1/fpu_0", &model);
+    AtomBlockId alu_10 = netlist.create_block("core_10/alu_0", &model);
+
+    AtomNameMatcher matcher(netlist);
+    auto matches = matcher.match({"core_0/alu_1", "^core_0/", "alu_0$", "^core_1", "^core_2", "alu_1"});
+
+    REQUIRE(matches.size() == 6);
+    REQUIRE(matches[0] == std::vector<AtomBlockId>{alu_1});
+    std::vector<AtomBlockId> core_0_atoms = {alu_0, alu_1};
+    REQUIRE(matches[1] == core_0_atoms);
+    std::vector<AtomBlockId> alu_0_atoms = {alu_0, alu_10};
+    REQUIRE(matches[2] == alu_0_atoms);
+    std::vector<AtomBlockId> core_1_atoms = {fpu_0, alu_10};
+    REQUIRE(matches[3] == core_1_atoms);
+    REQUIRE(matches[4].empty());
+    //A pattern which is not an atom name matches the names containing it
+    REQUIRE(matches[5] == std::vector<AtomBlockId>{alu_1});
+}
+
 #if 0
 static constexpr const char kArchFile[] = "test_read_arch_metadata.xml";
 
@@ -223,6 +223,25 @@ TEST_CASE("test_route_flow", "[vpr_noc_xy_routing]") {
         // make sure that size of the found route and golden route match
         compare_routes(golden_path, found_path, noc_model);
     }
+    SECTION("Test case where the links in each direction were precomputed. The routes should be the same as without them.") {
+        XYRouting precomputed_routing_algorithm;
+        precomputed_routing_algorithm.build_direction_links(noc_model);
+
+        std::vector<NocLinkId> golden_path;
+        std::vector<NocLinkId> found_path;
+
+        // route between all pairs of routers
+        for (int start_router = 0; start_router < 16; start_router++) {
+            for (int sink_router = 0; sink_router < 16; sink_router++) {
+                auto traffic_flow_id = NocTrafficFlowId(start_router * 16 + sink_router);
+
+                REQUIRE_NOTHROW(routing_algorithm.route_flow(NocRouterId(start_router), NocRouterId(sink_router), traffic_flow_id, golden_path, noc_model));
+                REQUIRE_NOTHROW(precomputed_routing_algorithm.route_flow(NocRouterId(start_router), NocRouterId(sink_router), traffic_flow_id, found_path, noc_model));
+
+                REQUIRE(found_path == golden_path);
+            }
+        }
+    }
 }
 TEST_CASE("test_route_flow when it fails in a mesh topology.", "[vpr_noc_xy_routing]") {
     /*